@@ -35,6 +35,10 @@
 #define COMMAND_READ_STATUS       0xF0u
 #define COMMAND_READ_DATA         0xF0u
 
+/* Bytes of the sensor data read and of the start command */
+#define READ_BYTES                7u
+#define MEASURE_BYTES             3u
+
 /* SPI clock speed in MHz. Timeouts are based on bytes times clock speed times 2 */
 // cppcheck-suppress misra-c2012-8.9; Defining constants at the start of the module is more maintainable. Violation of 'Advisory' rule does not present a risk.
 static const Uint32_t CLOCK_SPEED = 1u;
@@ -62,6 +66,11 @@ static compensation_t compensation[d_AUAV_MAX_DEVICES][d_AUAV_CHANNEL_COUNT];
 
 static Bool_t conversionComplete[d_AUAV_MAX_DEVICES][d_AUAV_CHANNEL_COUNT];
 
+/* Queued start and read transactions of each sensor channel */
+static d_SPI_PL_Transaction_t measureTransaction[d_AUAV_MAX_DEVICES][d_AUAV_CHANNEL_COUNT];
+static d_SPI_PL_Transaction_t readTransaction[d_AUAV_MAX_DEVICES][d_AUAV_CHANNEL_COUNT];
+static Uint8_t readResponse[d_AUAV_MAX_DEVICES][d_AUAV_CHANNEL_COUNT][READ_BYTES];
+
 /***** Function Declarations ********************************************/
 
 static d_Status_t InitialiseInterface(const Uint32_t device);
@@ -69,6 +78,15 @@ static d_Status_t InitialiseInterface(const Uint32_t device);
 static d_Status_t ReadPressure(const Uint32_t device,
                                const d_AUAV_Channel_t channel);
 
+static void ReadComplete(const Uint32_t spiChannel,
+                         const Uint32_t tag);
+
+static void MeasureComplete(const Uint32_t spiChannel,
+                            const Uint32_t tag);
+
+static void ReadingInvalid(const Uint32_t device,
+                           const d_AUAV_Channel_t channel);
+
 static d_Status_t Measure(const Uint32_t device,
                           const d_AUAV_Channel_t channel,
                           const Uint8_t cmd);
@@ -305,23 +323,8 @@ void d_AUAV_InterruptHandler(const Uint32_t spiChannel, const Uint32_t spiDevice
     Uint32_t channelInt = spiDevice % 2u;
     d_AUAV_Channel_t channel = (d_AUAV_Channel_t)channelInt;
 
-    /* Read the data */
-    d_Status_t status = ReadPressure(device, channel);
-
-    if (status == d_STATUS_SUCCESS)
-    {
-      /* Set conversion complete */
-      conversionComplete[device][channel] = d_TRUE;
-
-      /* If other channel conversion complete then callback */
-      if (conversionComplete[device][((Uint32_t)channel + 1u) & 0x01u] == d_TRUE)
-      {
-        if (callback != NULL)
-        {
-          callback(device);
-        }
-      }
-    }
+    /* Queue the data read, completed in ReadComplete */
+    (void)ReadPressure(device, channel);
   }
 
   return;
@@ -376,7 +379,8 @@ const Uint32_t device             /**< [in]  device number */
 /*********************************************************************//**
   <!-- ReadPressure -->
 
-  Read the absolute and differential pressures.
+  Queue the read of the pressure and temperature of a channel. The data is
+  stored by ReadComplete from the SPI interrupt.
 *************************************************************************/
 static d_Status_t                 /** \return Success or Failure */
 ReadPressure
@@ -386,35 +390,63 @@ const d_AUAV_Channel_t channel
 )
 {
   d_Status_t status;
-  Uint8_t command[7];
-  Uint8_t response[7];
-  Uint32_t rxCount = 0;
-  d_SPI_PL_State_t spiState;
+  d_SPI_PL_Transaction_t * const pTransaction = &readTransaction[device][channel];
 
-  command[0] = COMMAND_READ_SENSOR;
-  for (Uint32_t index = 1u; index < 7u; index++)
+  if ((pTransaction->state == d_SPI_PL_TRANSACTION_QUEUED) || (pTransaction->state == d_SPI_PL_TRANSACTION_ACTIVE))
   {
-    command[index] = 0u;
+    /* Previous read not complete, this data ready is missed */
+    // gcov-jst 1 It is not practical to generate this failure during bench testing.
+    status = d_STATUS_DEVICE_BUSY;
   }
-
-  status = d_SPI_PL_Transfer(d_AUAV_Config[device].spi[channel].spiChannel, d_AUAV_Config[device].spi[channel].spiDevice, &command[0], 7u, NULL, 0u);
-
-  if (status == d_STATUS_SUCCESS)
+  else
   {
-    status = WaitTransferComplete(device, 7u);
-  }
+    pTransaction->device = d_AUAV_Config[device].spi[channel].spiDevice;
+    pTransaction->command[0] = COMMAND_READ_SENSOR;
+    for (Uint32_t index = 1u; index < READ_BYTES; index++)
+    {
+      pTransaction->command[index] = 0u;
+    }
+    pTransaction->cmdCount = READ_BYTES;
+    pTransaction->txBuffer = NULL;
+    pTransaction->dataCount = 0u;
+    pTransaction->rxBuffer = &readResponse[device][channel][0];
+    pTransaction->bufferLength = READ_BYTES;
+    pTransaction->callback = ReadComplete;
+    pTransaction->tag = (device * (Uint32_t)d_AUAV_CHANNEL_COUNT) + (Uint32_t)channel;
+    pTransaction->pNext = NULL;
 
-  if (status == d_STATUS_SUCCESS)
-  {
-    status = d_SPI_PL_Result(d_AUAV_Config[device].spi[channel].spiChannel, &spiState, &response[0], 7u, &rxCount);
+    status = d_SPI_PL_Queue(d_AUAV_Config[device].spi[channel].spiChannel, pTransaction);
   }
 
-  if ((status == d_STATUS_SUCCESS) && (rxCount == 7u))
+  return status;
+}
+
+/*********************************************************************//**
+  <!-- ReadComplete -->
+
+  SPI transaction callback of ReadPressure. Compensate and store the data
+  and call the application when both channels have been read.
+*************************************************************************/
+static void                       /** \return None */
+ReadComplete
+(
+const Uint32_t spiChannel,        /**< [in]  SPI channel number */
+const Uint32_t tag                /**< [in]  Device and sensor channel of the transaction */
+)
+{
+  UNUSED_PARAMETER(spiChannel);
+
+  Uint32_t device = tag / (Uint32_t)d_AUAV_CHANNEL_COUNT;
+  Uint32_t channelInt = tag % (Uint32_t)d_AUAV_CHANNEL_COUNT;
+  d_AUAV_Channel_t channel = (d_AUAV_Channel_t)channelInt;
+  const d_SPI_PL_Transaction_t * const pTransaction = &readTransaction[device][channel];
+
+  if ((pTransaction->state == d_SPI_PL_TRANSACTION_COMPLETE) && (pTransaction->rxCount == READ_BYTES))
   {
     Float32_t pressure;
     Float32_t temperature;
 
-    CompensatePressure(device, channel, &response[0], &pressure, &temperature);
+    CompensatePressure(device, channel, &readResponse[device][channel][0], &pressure, &temperature);
 
     /* Store data in OFP structure */
     if (channel == d_AUAV_CHANNEL_ABSOLUTE)
@@ -429,26 +461,84 @@ const d_AUAV_Channel_t channel
       pOfpDataBlock[device]->differential.temperature = temperature;
       pOfpDataBlock[device]->differential.valid = d_TRUE;
     }
+
+    /* Set conversion complete */
+    conversionComplete[device][channel] = d_TRUE;
+
+    /* If other channel conversion complete then callback */
+    if (conversionComplete[device][((Uint32_t)channel + 1u) & 0x01u] == d_TRUE)
+    {
+      if (callback != NULL)
+      {
+        callback(device);
+      }
+    }
   }
   else
   {
-    if (channel == d_AUAV_CHANNEL_ABSOLUTE)
-    {
-      pOfpDataBlock[device]->absolute.valid = d_FALSE;
-    }
-    else
-    {
-      pOfpDataBlock[device]->differential.valid = d_FALSE;
-    }
+    ReadingInvalid(device, channel);
   }
 
-  return status;
+  return;
+}
+
+/*********************************************************************//**
+  <!-- MeasureComplete -->
+
+  SPI transaction callback of Measure. A start command which was not sent
+  gives no data ready, so the reading of the channel is marked invalid.
+*************************************************************************/
+static void                       /** \return None */
+MeasureComplete
+(
+const Uint32_t spiChannel,        /**< [in]  SPI channel number */
+const Uint32_t tag                /**< [in]  Device and sensor channel of the transaction */
+)
+{
+  UNUSED_PARAMETER(spiChannel);
+
+  Uint32_t device = tag / (Uint32_t)d_AUAV_CHANNEL_COUNT;
+  Uint32_t channelInt = tag % (Uint32_t)d_AUAV_CHANNEL_COUNT;
+  d_AUAV_Channel_t channel = (d_AUAV_Channel_t)channelInt;
+
+  if (measureTransaction[device][channel].state != d_SPI_PL_TRANSACTION_COMPLETE)
+  {
+    // gcov-jst 1 It is not practical to generate this failure during bench testing.
+    ReadingInvalid(device, channel);
+  }
+  ELSE_DO_NOTHING
+
+  return;
+}
+
+/*********************************************************************//**
+  <!-- ReadingInvalid -->
+
+  Mark the reading of a channel invalid.
+*************************************************************************/
+static void                       /** \return None */
+ReadingInvalid
+(
+const Uint32_t device,            /**< [in]  device number */
+const d_AUAV_Channel_t channel
+)
+{
+  if (channel == d_AUAV_CHANNEL_ABSOLUTE)
+  {
+    pOfpDataBlock[device]->absolute.valid = d_FALSE;
+  }
+  else
+  {
+    pOfpDataBlock[device]->differential.valid = d_FALSE;
+  }
+
+  return;
 }
 
 /*********************************************************************//**
   <!-- Measure -->
 
-  Start a measurement.
+  Queue the command to start a measurement.
 *************************************************************************/
 static d_Status_t                 /** \return Success or Failure */
 Measure
@@ -459,32 +549,31 @@ const Uint8_t cmd
 )
 {
   d_Status_t status;
-  Uint8_t command[3];
-  Uint32_t rxCount = 0;
-  d_SPI_PL_State_t spiState;
+  d_SPI_PL_Transaction_t * const pTransaction = &measureTransaction[device][channel];
 
-  command[0] = cmd;
-  command[1] = 0x00u;
-  command[2] = 0x00u;
-
-  status = d_SPI_PL_Transfer(d_AUAV_Config[device].spi[channel].spiChannel, d_AUAV_Config[device].spi[channel].spiDevice, &command[0], 3u, NULL, 0u);
-
-  if (status == d_STATUS_SUCCESS)
+  if ((pTransaction->state == d_SPI_PL_TRANSACTION_QUEUED) || (pTransaction->state == d_SPI_PL_TRANSACTION_ACTIVE))
   {
-    status = WaitTransferComplete(device, 3u);
+    // gcov-jst 1 It is not practical to generate this failure during bench testing.
+    status = d_STATUS_DEVICE_BUSY;
   }
-
-  if (status == d_STATUS_SUCCESS)
+  else
   {
-    Uint8_t response[3];
-    status = d_SPI_PL_Result(d_AUAV_Config[device].spi[channel].spiChannel, &spiState, &response[0], 3u, &rxCount);
-    if ((status == d_STATUS_SUCCESS) && (rxCount != 3u))
-    {
-      status = d_STATUS_FAILURE;
-    }      
+    pTransaction->device = d_AUAV_Config[device].spi[channel].spiDevice;
+    pTransaction->command[0] = cmd;
+    pTransaction->command[1] = 0x00u;
+    pTransaction->command[2] = 0x00u;
+    pTransaction->cmdCount = MEASURE_BYTES;
+    pTransaction->txBuffer = NULL;
+    pTransaction->dataCount = 0u;
+    pTransaction->rxBuffer = NULL;
+    pTransaction->bufferLength = 0u;
+    pTransaction->callback = MeasureComplete;
+    pTransaction->tag = (device * (Uint32_t)d_AUAV_CHANNEL_COUNT) + (Uint32_t)channel;
+    pTransaction->pNext = NULL;
+
+    status = d_SPI_PL_Queue(d_AUAV_Config[device].spi[channel].spiChannel, pTransaction);
   }
 
-
   return status;
 }
 
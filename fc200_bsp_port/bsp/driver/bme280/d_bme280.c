@@ -49,9 +49,14 @@
 
 #define RESET_COMMAND        0xB6u
 
+/* Number of data registers, pressure, temperature and humidity */
+#define DATA_COUNT           (REGISTER_HUM_LSB - REGISTER_PRESS_MSB + 1u)
+
 /* SPI clock speed in MHz. Timeouts are based on bytes * clock speed * 2 */
 static const Uint32_t CLOCK_SPEED = 1;
 
+#if defined d_BME280_COMPENSATION_DOUBLE
+
 // cppcheck-suppress misra-c2012-8.9; Defining constants at the start of the module is more maintainable. Violation of 'Advisory' rule does not present a risk.
 static Float64_t TEMPERATURE_MIN = -40.0;
 // cppcheck-suppress misra-c2012-8.9; Defining constants at the start of the module is more maintainable. Violation of 'Advisory' rule does not present a risk.
@@ -67,37 +72,107 @@ static Float64_t HUMIDITY_MIN = 0.0;
 // cppcheck-suppress misra-c2012-8.9; Defining constants at the start of the module is more maintainable. Violation of 'Advisory' rule does not present a risk.
 static Float64_t HUMIDITY_MAX = 100.0;
 
+#else
+
+/* Limits of the integer compensation outputs, 0.01 DegC, Pa Q24.8 and %rH Q22.10 */
+#define TEMPERATURE_MIN_FIXED  (-4000)
+#define TEMPERATURE_MAX_FIXED  8500
+#define PRESSURE_MIN_FIXED     (30000u * 256u)
+#define PRESSURE_MAX_FIXED     (110000u * 256u)
+#define HUMIDITY_MAX_FIXED     (100u * 1024u)
+
+#endif
+
 /***** Type Definitions *************************************************/
 
+/* Calibration words as stored in the device */
+typedef struct
+{
+  Uint16_t t1;
+  Int16_t t2;
+  Int16_t t3;
+  Uint16_t p1;
+  Int16_t p2;
+  Int16_t p3;
+  Int16_t p4;
+  Int16_t p5;
+  Int16_t p6;
+  Int16_t p7;
+  Int16_t p8;
+  Int16_t p9;
+  Uint8_t h1;
+  Int16_t h2;
+  Uint8_t h3;
+  Int16_t h4;
+  Int16_t h5;
+  Int8_t h6;
+} calibrationRaw_t;
+
+#if defined d_BME280_COMPENSATION_DOUBLE
+
+/* Calibration data of a device, converted for the double precision compensation */
+typedef struct
+{
+  Float64_t t1;
+  Float64_t t2;
+  Float64_t t3;
+  Float64_t p1;
+  Float64_t p2;
+  Float64_t p3;
+  Float64_t p4;
+  Float64_t p5;
+  Float64_t p6;
+  Float64_t p7;
+  Float64_t p8;
+  Float64_t p9;
+  Float64_t h1;
+  Float64_t h2;
+  Float64_t h3;
+  Float64_t h4;
+  Float64_t h5;
+  Float64_t h6;
+  Int32_t tFine;                  /* Fine temperature of the last sample, used by pressure and humidity */
+} calibration_t;
+
+#else
+
+/* Calibration data of a device, pre-scaled for the integer compensation. The
+   names give the scaling applied to the calibration word */
+typedef struct
+{
+  Int32_t t1;
+  Int32_t t1x2;
+  Int32_t t2;
+  Int32_t t3;
+  Int64_t p1;
+  Int64_t p2x4096;
+  Int64_t p3;
+  Int64_t p4x2e35;
+  Int64_t p5x2e17;
+  Int64_t p6;
+  Int64_t p7x16;
+  Int64_t p8;
+  Int64_t p9;
+  Int32_t h1;
+  Int32_t h2;
+  Int32_t h3;
+  Int32_t h4x2e20;
+  Int32_t h5;
+  Int32_t h6;
+  Int32_t tFine;                  /* Fine temperature of the last sample, used by pressure and humidity */
+} calibration_t;
+
+#endif
+
 /***** Variables ********************************************************/
 
 static Bool_t initialised[d_BME280_MAX_INTERFACES] = {d_FALSE, d_FALSE, d_FALSE, d_FALSE};
 
-/* Temperature calibration data */
-static Float64_t compensationT1;
-static Float64_t compensationT2;
-static Float64_t compensationT3;
-
-/* Pressure calibration data */
-static Float64_t compensationP1;
-static Float64_t compensationP2;
-static Float64_t compensationP3;
-static Float64_t compensationP4;
-static Float64_t compensationP5;
-static Float64_t compensationP6;
-static Float64_t compensationP7;
-static Float64_t compensationP8;
-static Float64_t compensationP9;
-
-/* Humidity calibration data */
-static Float64_t compensationH1;
-static Float64_t compensationH2;
-static Float64_t compensationH3;
-static Float64_t compensationH4;
-static Float64_t compensationH5;
-static Float64_t compensationH6;
-
-static Int32_t t_fine;
+static calibration_t calibration[d_BME280_MAX_INTERFACES];
+
+/* Queued read of the data registers of each device */
+static d_SPI_PL_Transaction_t dataTransaction[d_BME280_MAX_INTERFACES];
+static Uint8_t dataBuffer[d_BME280_MAX_INTERFACES][DATA_COUNT];
 
 /***** Function Declarations ********************************************/
 
@@ -114,9 +189,19 @@ static d_Status_t RegisterRead(const Uint32_t device, const Uint8_t address, Uin
 
 static d_Status_t RegisterWrite(const Uint32_t device, const Uint8_t address, Uint8_t value);
 
-static Float64_t CompensateT(Uint32_t adc_T);
-static Float64_t CompensateH(Uint32_t adc_H);
-static Float64_t CompensateP(Uint32_t adc_P);
+static d_Status_t ReadRaw(const Uint32_t device, Uint32_t * const pAdcT, Uint32_t * const pAdcP, Uint32_t * const pAdcH);
+
+static void CalibrationScale(const Uint32_t device, const calibrationRaw_t * const pRaw);
+
+#if defined d_BME280_COMPENSATION_DOUBLE
+static Float64_t CompensateT(const Uint32_t device, Uint32_t adc_T);
+static Float64_t CompensateH(const Uint32_t device, Uint32_t adc_H);
+static Float64_t CompensateP(const Uint32_t device, Uint32_t adc_P);
+#else
+static Int32_t CompensateTFixed(const Uint32_t device, const Uint32_t adc_T);
+static Uint32_t CompensatePFixed(const Uint32_t device, const Uint32_t adc_P);
+static Uint32_t CompensateHFixed(const Uint32_t device, const Uint32_t adc_H);
+#endif
 
 /***** Function Definitions *********************************************/
 
@@ -146,6 +231,10 @@ const Uint8_t ctrl_meas
 
   d_TIMER_Initialise();
 
+  /* A read queued by a previous initialisation would refuse the register transfers */
+  initialised[device] = d_FALSE;
+  (void)d_SPI_PL_Cancel(d_BME280_Config[device].channel, &dataTransaction[device]);
+
   status = d_SPI_PL_Initialise(d_BME280_Config[device].channel);
 
   if (status == d_STATUS_SUCCESS)
@@ -190,6 +279,18 @@ const Uint8_t ctrl_meas
 
   if (status == d_STATUS_SUCCESS)
   {
+    dataTransaction[device].device = d_BME280_Config[device].device;
+    dataTransaction[device].command[0] = REGISTER_PRESS_MSB;
+    dataTransaction[device].cmdCount = 1u;
+    dataTransaction[device].txBuffer = NULL;
+    dataTransaction[device].dataCount = DATA_COUNT;
+    dataTransaction[device].rxBuffer = &dataBuffer[device][0];
+    dataTransaction[device].bufferLength = DATA_COUNT;
+    dataTransaction[device].callback = NULL;
+    dataTransaction[device].tag = device;
+    dataTransaction[device].state = d_SPI_PL_TRANSACTION_IDLE;
+    dataTransaction[device].pNext = NULL;
+
     initialised[device] = d_TRUE;
   }
 
@@ -199,7 +300,11 @@ const Uint8_t ctrl_meas
 /*********************************************************************//**
   <!-- d_BME280_Read -->
 
-  Read the BME280 data.
+  Read the BME280 data. The data registers are read by a queued SPI
+  transaction and the function does not wait for it: the values returned
+  are those read by the transaction queued at the previous call, and the
+  next read is queued before returning. d_STATUS_NOT_READY is returned on
+  the first call and while the previous read is still in progress.
 *************************************************************************/
 d_Status_t
 d_BME280_Read
@@ -247,23 +352,168 @@ Float64_t * const pTemperature  /* Deg C */
     return d_STATUS_INVALID_PARAMETER;
   }
 
-  Uint8_t rawData[REGISTER_HUM_LSB - REGISTER_PRESS_MSB + 1u];
-  d_GEN_MemorySet(&rawData[0], 0u, sizeof(rawData));
+  Uint32_t adcT;
+  Uint32_t adcP;
+  Uint32_t adcH;
 
-  status = DataRead(device, REGISTER_PRESS_MSB, REGISTER_HUM_LSB - REGISTER_PRESS_MSB + 1u, &rawData[0]);
+  status = ReadRaw(device, &adcT, &adcP, &adcH);
 
   if (status == d_STATUS_SUCCESS)
   {
-    Uint32_t rawValue = (((Uint32_t)rawData[3]) << 12u) | (((Uint32_t)rawData[4]) << 4u) | (((Uint32_t)rawData[5]) >> 4u);
-    *pTemperature = CompensateT(rawValue);
+#if defined d_BME280_COMPENSATION_DOUBLE
+    *pTemperature = CompensateT(device, adcT);
+    *pPressure = CompensateP(device, adcP);
+    *pHumidity = CompensateH(device, adcH);
+#else
+    *pTemperature = (Float64_t)CompensateTFixed(device, adcT) / 100.0;
+    *pPressure = (Float64_t)CompensatePFixed(device, adcP) / 256.0;
+    *pHumidity = (Float64_t)CompensateHFixed(device, adcH) / 1024.0;
+#endif
+  }
+  ELSE_DO_NOTHING
 
-    rawValue = ((((Uint32_t)rawData[0]) << 12u) | (((Uint32_t)rawData[1]) << 4u) | (((Uint32_t)rawData[2]) >> 4u));
-    *pPressure = CompensateP(rawValue);
+  return status;
+}
 
-    rawValue = (((Uint32_t)rawData[6]) << 8u) | (Uint32_t)rawData[7];
-    *pHumidity = CompensateH(rawValue);
+/*********************************************************************//**
+  <!-- d_BME280_ReadAll -->
+
+  Read the data of all the configured BME280 devices in one call. The
+  reads of every device are collected and queued again before any data is
+  compensated, so the SPI transfers of all the devices proceed while the
+  compensation runs. The values are in the fixed point units of
+  d_BME280_Data_t and the status of each device is returned in its entry,
+  with the same meaning as for d_BME280_Read. A device not initialised is
+  reported as d_STATUS_NOT_INITIALISED in its entry.
+*************************************************************************/
+d_Status_t                        /** \return Success if all devices are read, otherwise the first failing status */
+d_BME280_ReadAll
+(
+d_BME280_Data_t data[]            /**< [out] Data of each device, d_BME280_Count entries */
+)
+{
+  d_Status_t status = d_STATUS_SUCCESS;
+  Uint32_t adcT[d_BME280_MAX_INTERFACES];
+  Uint32_t adcP[d_BME280_MAX_INTERFACES];
+  Uint32_t adcH[d_BME280_MAX_INTERFACES];
+  Uint32_t device;
+
+  if ((d_BME280_Count == 0u) || (d_BME280_Count > d_BME280_MAX_INTERFACES))
+  {
+    // gcov-jst 3 It is not practical to generate this failure during bench testing.
+    d_ERROR_Logger(d_STATUS_INVALID_CONFIGURATION, d_ERROR_CRITICALITY_CRITICAL_SHUTDOWN, 1, d_BME280_Count, 0, 0);
+    // cppcheck-suppress misra-c2012-15.5; Coding standard allows function to return if parameters are invalid
+    return d_STATUS_INVALID_CONFIGURATION;
   }
-  
+
+  if (data == NULL)
+  {
+    d_ERROR_Logger(d_STATUS_INVALID_PARAMETER, d_ERROR_CRITICALITY_CRITICAL_SHUTDOWN, 1, 0, 0, 0);
+    // cppcheck-suppress misra-c2012-15.5; Coding standard allows function to return if parameters are invalid
+    return d_STATUS_INVALID_PARAMETER;
+  }
+
+  /* Collect the completed reads and queue the next ones */
+  for (device = 0u; device < d_BME280_Count; device++)
+  {
+    if (initialised[device] == d_TRUE)
+    {
+      data[device].status = ReadRaw(device, &adcT[device], &adcP[device], &adcH[device]);
+    }
+    else
+    {
+      data[device].status = d_STATUS_NOT_INITIALISED;
+    }
+  }
+
+  /* Compensate the devices that returned data */
+  for (device = 0u; device < d_BME280_Count; device++)
+  {
+    if (data[device].status == d_STATUS_SUCCESS)
+    {
+#if defined d_BME280_COMPENSATION_DOUBLE
+      data[device].temperature = (Int32_t)(CompensateT(device, adcT[device]) * 100.0);
+      data[device].pressure = (Uint32_t)(CompensateP(device, adcP[device]) * 256.0);
+      data[device].humidity = (Uint32_t)(CompensateH(device, adcH[device]) * 1024.0);
+#else
+      data[device].temperature = CompensateTFixed(device, adcT[device]);
+      data[device].pressure = CompensatePFixed(device, adcP[device]);
+      data[device].humidity = CompensateHFixed(device, adcH[device]);
+#endif
+    }
+    else if (status == d_STATUS_SUCCESS)
+    {
+      status = data[device].status;
+    }
+    else
+    {
+      DO_NOTHING();
+    }
+  }
+
+  return status;
+}
+
+/*********************************************************************//**
+  <!-- ReadRaw -->
+
+  Collect the uncompensated values read by the queued transaction of a
+  device and queue the next read.
+*************************************************************************/
+static d_Status_t                 /** \return Success, or Not Ready while the read is in progress */
+ReadRaw
+(
+const Uint32_t device,            /**< [in]  BME device number */
+Uint32_t * const pAdcT,           /**< [out] Uncompensated temperature */
+Uint32_t * const pAdcP,           /**< [out] Uncompensated pressure */
+Uint32_t * const pAdcH            /**< [out] Uncompensated humidity */
+)
+{
+  d_Status_t status;
+  const Uint32_t channel = d_BME280_Config[device].channel;
+
+  /* Complete the read if its interrupt has not yet been serviced */
+  (void)d_SPI_PL_Poll(channel);
+
+  d_SPI_PL_TransactionState_t readState = dataTransaction[device].state;
+  if ((readState == d_SPI_PL_TRANSACTION_QUEUED) || (readState == d_SPI_PL_TRANSACTION_ACTIVE))
+  {
+    // cppcheck-suppress misra-c2012-15.5; Read still in progress, nothing to return or queue
+    return d_STATUS_NOT_READY;
+  }
+
+  if (readState == d_SPI_PL_TRANSACTION_COMPLETE)
+  {
+    status = d_STATUS_SUCCESS;
+  }
+  else if (readState == d_SPI_PL_TRANSACTION_FAILED)
+  {
+    // gcov-jst 1 It is not practical to generate this failure during bench testing.
+    status = d_STATUS_FAILURE;
+  }
+  else
+  {
+    status = d_STATUS_NOT_READY;
+  }
+
+  if (status == d_STATUS_SUCCESS)
+  {
+    const Uint8_t * const rawData = &dataBuffer[device][0];
+
+    *pAdcT = (((Uint32_t)rawData[3]) << 12u) | (((Uint32_t)rawData[4]) << 4u) | (((Uint32_t)rawData[5]) >> 4u);
+    *pAdcP = (((Uint32_t)rawData[0]) << 12u) | (((Uint32_t)rawData[1]) << 4u) | (((Uint32_t)rawData[2]) >> 4u);
+    *pAdcH = (((Uint32_t)rawData[6]) << 8u) | (Uint32_t)rawData[7];
+  }
+  ELSE_DO_NOTHING
+
+  /* Queue the read for the next call */
+  d_Status_t queueStatus = d_SPI_PL_Queue(channel, &dataTransaction[device]);
+  if (status == d_STATUS_SUCCESS)
+  {
+    status = queueStatus;
+  }
+  ELSE_DO_NOTHING
+
   return status;
 }
 
@@ -325,6 +575,7 @@ const Uint32_t device             /**< [in]  BME device number */
 )
 {
   Uint8_t rawData[26];
+  calibrationRaw_t raw;
 
   /* Read first block of calibration data */
   d_Status_t status = DataRead(device, REGISTER_CALIB0, 26u, &rawData[0]);
@@ -332,52 +583,120 @@ const Uint32_t device             /**< [in]  BME device number */
   if (status == d_STATUS_SUCCESS)
   {
     // cppcheck-suppress misra-c2012-11.3; The ARM processor does not have any alignment restrictions for integers.
-    compensationT1 = (Float64_t)(*(Uint16_t *)&rawData[0]);
+    raw.t1 = *(Uint16_t *)&rawData[0];
     // cppcheck-suppress misra-c2012-11.3; The ARM processor does not have any alignment restrictions for integers.
-    compensationT2 = (Float64_t)(*(Int16_t *)&rawData[2]);
+    raw.t2 = *(Int16_t *)&rawData[2];
     // cppcheck-suppress misra-c2012-11.3; The ARM processor does not have any alignment restrictions for integers.
-    compensationT3 = (Float64_t)(*(Int16_t *)&rawData[4]);
+    raw.t3 = *(Int16_t *)&rawData[4];
 
     // cppcheck-suppress misra-c2012-11.3; The ARM processor does not have any alignment restrictions for integers.
-    compensationP1 = (Float64_t)(*(Uint16_t *)&rawData[6]);
+    raw.p1 = *(Uint16_t *)&rawData[6];
     // cppcheck-suppress misra-c2012-11.3; The ARM processor does not have any alignment restrictions for integers.
-    compensationP2 = (Float64_t)(*(Int16_t *)&rawData[8]);
+    raw.p2 = *(Int16_t *)&rawData[8];
     // cppcheck-suppress misra-c2012-11.3; The ARM processor does not have any alignment restrictions for integers.
-    compensationP3 = (Float64_t)(*(Int16_t *)&rawData[10]);
+    raw.p3 = *(Int16_t *)&rawData[10];
     // cppcheck-suppress misra-c2012-11.3; The ARM processor does not have any alignment restrictions for integers.
-    compensationP4 = (Float64_t)(*(Int16_t *)&rawData[12]);
+    raw.p4 = *(Int16_t *)&rawData[12];
     // cppcheck-suppress misra-c2012-11.3; The ARM processor does not have any alignment restrictions for integers.
-    compensationP5 = (Float64_t)(*(Int16_t *)&rawData[14]);
+    raw.p5 = *(Int16_t *)&rawData[14];
     // cppcheck-suppress misra-c2012-11.3; The ARM processor does not have any alignment restrictions for integers.
-    compensationP6 = (Float64_t)(*(Int16_t *)&rawData[16]);
+    raw.p6 = *(Int16_t *)&rawData[16];
     // cppcheck-suppress misra-c2012-11.3; The ARM processor does not have any alignment restrictions for integers.
-    compensationP7 = (Float64_t)(*(Int16_t *)&rawData[18]);
+    raw.p7 = *(Int16_t *)&rawData[18];
     // cppcheck-suppress misra-c2012-11.3; The ARM processor does not have any alignment restrictions for integers.
-    compensationP8 = (Float64_t)(*(Int16_t *)&rawData[20]);
+    raw.p8 = *(Int16_t *)&rawData[20];
     // cppcheck-suppress misra-c2012-11.3; The ARM processor does not have any alignment restrictions for integers.
-    compensationP9 = (Float64_t)(*(Int16_t *)&rawData[22]);
+    raw.p9 = *(Int16_t *)&rawData[22];
 
-    compensationH1 = (Float64_t)rawData[25];
+    raw.h1 = rawData[25];
 
-    /* Read second block of calibration data */
-    status = DataRead(device, REGISTER_CALIB1, 6u, &rawData[0]);
+    /* Read second block of calibration data, registers 0xE1 to 0xE7 */
+    status = DataRead(device, REGISTER_CALIB1, 7u, &rawData[0]);
   }
 
   if (status == d_STATUS_SUCCESS)
   {
     // cppcheck-suppress misra-c2012-11.3; The ARM processor does not have any alignment restrictions for integers.
-    compensationH2 = (Float64_t)(*(Int16_t *)&rawData[0]);
-    compensationH3 = (Float64_t)rawData[2];
-    Uint16_t temp = ((Uint16_t)rawData[3] << 4) | (rawData[4] & 0x0Fu);
-    compensationH4 = (Float64_t)((Int16_t)temp);
-    temp = ((Uint16_t)rawData[5] << 4) | ((rawData[3] & 0xF0u) >> 4);
-    compensationH5 = (Float64_t)((Int16_t)temp);
-    compensationH6 = (Float64_t)((Int8_t)rawData[5]);
+    raw.h2 = *(Int16_t *)&rawData[0];
+    raw.h3 = rawData[2];
+    /* H4 and H5 are signed 12 bit values sharing register 0xE5 */
+    raw.h4 = (Int16_t)(((Int16_t)((Int8_t)rawData[3]) * 16) | (Int16_t)(rawData[4] & 0x0Fu));
+    raw.h5 = (Int16_t)(((Int16_t)((Int8_t)rawData[5]) * 16) | (Int16_t)(rawData[4] >> 4));
+    raw.h6 = (Int8_t)rawData[6];
+
+    CalibrationScale(device, &raw);
   }
   
   return status;
 }
-  
+
+/*********************************************************************//**
+  <!-- CalibrationScale -->
+
+  Convert the calibration words of a device to the form used by the
+  compensation, once at initialisation.
+*************************************************************************/
+static void
+CalibrationScale
+(
+const Uint32_t device,            /**< [in]  BME device number */
+const calibrationRaw_t * const pRaw /**< [in]  Calibration words read from the device */
+)
+{
+  calibration_t * const pCal = &calibration[device];
+
+#if defined d_BME280_COMPENSATION_DOUBLE
+  pCal->t1 = (Float64_t)pRaw->t1;
+  pCal->t2 = (Float64_t)pRaw->t2;
+  pCal->t3 = (Float64_t)pRaw->t3;
+
+  pCal->p1 = (Float64_t)pRaw->p1;
+  pCal->p2 = (Float64_t)pRaw->p2;
+  pCal->p3 = (Float64_t)pRaw->p3;
+  pCal->p4 = (Float64_t)pRaw->p4;
+  pCal->p5 = (Float64_t)pRaw->p5;
+  pCal->p6 = (Float64_t)pRaw->p6;
+  pCal->p7 = (Float64_t)pRaw->p7;
+  pCal->p8 = (Float64_t)pRaw->p8;
+  pCal->p9 = (Float64_t)pRaw->p9;
+
+  pCal->h1 = (Float64_t)pRaw->h1;
+  pCal->h2 = (Float64_t)pRaw->h2;
+  pCal->h3 = (Float64_t)pRaw->h3;
+  pCal->h4 = (Float64_t)pRaw->h4;
+  pCal->h5 = (Float64_t)pRaw->h5;
+  pCal->h6 = (Float64_t)pRaw->h6;
+#else
+  /* The shifts of the Bosch reference applied to the calibration words are
+     done here as multiplications, as some of the words are negative */
+  pCal->t1 = (Int32_t)pRaw->t1;
+  pCal->t1x2 = (Int32_t)pRaw->t1 * 2;
+  pCal->t2 = (Int32_t)pRaw->t2;
+  pCal->t3 = (Int32_t)pRaw->t3;
+
+  pCal->p1 = (Int64_t)pRaw->p1;
+  pCal->p2x4096 = (Int64_t)pRaw->p2 * 4096;
+  pCal->p3 = (Int64_t)pRaw->p3;
+  pCal->p4x2e35 = (Int64_t)pRaw->p4 * 34359738368;
+  pCal->p5x2e17 = (Int64_t)pRaw->p5 * 131072;
+  pCal->p6 = (Int64_t)pRaw->p6;
+  pCal->p7x16 = (Int64_t)pRaw->p7 * 16;
+  pCal->p8 = (Int64_t)pRaw->p8;
+  pCal->p9 = (Int64_t)pRaw->p9;
+
+  pCal->h1 = (Int32_t)pRaw->h1;
+  pCal->h2 = (Int32_t)pRaw->h2;
+  pCal->h3 = (Int32_t)pRaw->h3;
+  pCal->h4x2e20 = (Int32_t)pRaw->h4 * 1048576;
+  pCal->h5 = (Int32_t)pRaw->h5;
+  pCal->h6 = (Int32_t)pRaw->h6;
+#endif
+
+  pCal->tFine = 0;
+
+  return;
+}
+
 /*********************************************************************//**
   <!-- DataRead -->
 
@@ -554,29 +873,34 @@ const Uint8_t value               /**< [in]  Value to write */
   return status;
 }
 
+#if defined d_BME280_COMPENSATION_DOUBLE
+
 /*********************************************************************//**
   <!-- CompensateT -->
 
   Returns temperature in DegC, Float64_t precision. Output value of 51.23
-  equals 51.23 DegC. t_fine carries fine temperature as global value.
+  equals 51.23 DegC. The fine temperature is kept for the pressure and
+  humidity compensation of the device.
 *************************************************************************/
 static Float64_t
 CompensateT
 (
+const Uint32_t device,
 Uint32_t adc_T
 )
 {
+  calibration_t * const pCal = &calibration[device];
   Float64_t var1;
   Float64_t var2;
   Float64_t var3;
   Float64_t temperature;
   
-  var1 = ((Float64_t)adc_T / 16384.0) - (compensationT1 / 1024.0);
-  var1 = var1 * compensationT2;
-  var2 = (((Float64_t)adc_T) / 131072.0) - (compensationT1 / 8192.0);
-  var2 = var2 * var2 * compensationT3;
+  var1 = ((Float64_t)adc_T / 16384.0) - (pCal->t1 / 1024.0);
+  var1 = var1 * pCal->t2;
+  var2 = (((Float64_t)adc_T) / 131072.0) - (pCal->t1 / 8192.0);
+  var2 = var2 * var2 * pCal->t3;
   var3 = var1 + var2;
-  t_fine = (Int32_t)var3;
+  pCal->tFine = (Int32_t)var3;
   temperature = var3 / 5120.0;
   if (temperature < TEMPERATURE_MIN)
   {
@@ -602,19 +926,21 @@ Uint32_t adc_T
 static Float64_t
 CompensateP
 (
+const Uint32_t device,
 Uint32_t adc_P
 )
 {
+  const calibration_t * const pCal = &calibration[device];
   Float64_t var1;
   Float64_t var2;
   Float64_t pressure;
 
-  var1 = ((Float64_t)t_fine / 2.0) - 64000.0;
-  var2 = var1 * var1 * compensationP6 / 32768.0;
-  var2 = var2 + (var1 * compensationP5 * 2.0);
-  var2 = (var2 / 4.0) + (compensationP4 * 65536.0);
-  var1 = (((compensationP3 * var1 * var1) / 524288.0) + (compensationP2 * var1)) / 524288.0;
-  var1 = (1.0 + (var1 / 32768.0)) * compensationP1;
+  var1 = ((Float64_t)pCal->tFine / 2.0) - 64000.0;
+  var2 = var1 * var1 * pCal->p6 / 32768.0;
+  var2 = var2 + (var1 * pCal->p5 * 2.0);
+  var2 = (var2 / 4.0) + (pCal->p4 * 65536.0);
+  var1 = (((pCal->p3 * var1 * var1) / 524288.0) + (pCal->p2 * var1)) / 524288.0;
+  var1 = (1.0 + (var1 / 32768.0)) * pCal->p1;
   if (var1 <= 0.0)
   {
     pressure = PRESSURE_MIN; /* avoid exception caused by division by zero */
@@ -623,9 +949,9 @@ Uint32_t adc_P
   {
     pressure = 1048576.0 - (Float64_t)adc_P;
     pressure = (pressure - (var2 / 4096.0)) * 6250.0 / var1;
-    var1 = compensationP9 * pressure * pressure / 2147483648.0;
-    var2 = pressure * compensationP8 / 32768.0;
-    pressure = pressure + ((var1 + var2 + compensationP7) / 16.0);
+    var1 = pCal->p9 * pressure * pressure / 2147483648.0;
+    var2 = pressure * pCal->p8 / 32768.0;
+    pressure = pressure + ((var1 + var2 + pCal->p7) / 16.0);
 
     if (pressure > PRESSURE_MAX)
     {
@@ -648,14 +974,17 @@ Uint32_t adc_P
   <!-- CompensateH -->
 
   Returns humidity in %rH as as Float64_t. Output value of 46.332 represents
-  46.332 %rH.
+  46.332 %rH. The H3 term is applied once, as by the datasheet formula and
+  the integer compensation.
 *************************************************************************/
 static Float64_t
 CompensateH
 (
+const Uint32_t device,
 Uint32_t adc_H
 )
 {
+  const calibration_t * const pCal = &calibration[device];
   Float64_t var1;
   Float64_t var2;
   Float64_t var3;
@@ -664,14 +993,14 @@ Uint32_t adc_H
   Float64_t var6;
   Float64_t humidity;
 
-  var1 = (Float64_t)t_fine - 76800.0;
-  var2 = (compensationH4 * 64.0) + ((compensationH5 / 16384.0) * var1);
+  var1 = (Float64_t)pCal->tFine - 76800.0;
+  var2 = (pCal->h4 * 64.0) + ((pCal->h5 / 16384.0) * var1);
   var3 = (Float64_t)adc_H - var2;
-  var4 = compensationH2 / 65536.0;
-  var5 = 1.0 + ((compensationH3 / 67108864.0) * var1);
-  var6 = 1.0 + ((compensationH6 / 67108864.0) * var1 * var5);
-  var6 = var3 * var4 * var5 * var6;
-  humidity = var6 * (1.0 - ((compensationH1 * var6) / 524288.0));
+  var4 = pCal->h2 / 65536.0;
+  var5 = 1.0 + ((pCal->h3 / 67108864.0) * var1);
+  var6 = 1.0 + ((pCal->h6 / 67108864.0) * var1 * var5);
+  var6 = var3 * var4 * var6;
+  humidity = var6 * (1.0 - ((pCal->h1 * var6) / 524288.0));
 
  if (humidity > HUMIDITY_MAX)
   {
@@ -689,3 +1018,145 @@ Uint32_t adc_H
   return humidity;
 }
 
+#else
+
+/*********************************************************************//**
+  <!-- CompensateTFixed -->
+
+  Returns temperature in 0.01 DegC by the Bosch 32 bit integer
+  compensation. Output value of 5123 equals 51.23 DegC. The fine
+  temperature is kept for the pressure and humidity compensation of the
+  device. Right shifts of negative values are arithmetic on the target, as
+  assumed by the Bosch reference.
+*************************************************************************/
+static Int32_t                    /** \return Temperature, 0.01 DegC */
+CompensateTFixed
+(
+const Uint32_t device,            /**< [in]  BME device number */
+const Uint32_t adc_T              /**< [in]  Uncompensated temperature, 20 bits */
+)
+{
+  calibration_t * const pCal = &calibration[device];
+  const Int32_t adcT = (Int32_t)adc_T;
+  Int32_t var1;
+  Int32_t var2;
+  Int32_t temperature;
+
+  var1 = (((adcT >> 3) - pCal->t1x2) * pCal->t2) >> 11;
+  var2 = (adcT >> 4) - pCal->t1;
+  var2 = (((var2 * var2) >> 12) * pCal->t3) >> 14;
+  pCal->tFine = var1 + var2;
+  temperature = ((pCal->tFine * 5) + 128) >> 8;
+
+  if (temperature < TEMPERATURE_MIN_FIXED)
+  {
+    temperature = TEMPERATURE_MIN_FIXED;
+  }
+  else if (temperature > TEMPERATURE_MAX_FIXED)
+  {
+    temperature = TEMPERATURE_MAX_FIXED;
+  }
+  else
+  {
+    /* In range */
+  }
+
+  return temperature;
+}
+
+/*********************************************************************//**
+  <!-- CompensatePFixed -->
+
+  Returns pressure in Pa as Q24.8 by the Bosch 64 bit integer
+  compensation. Output value of 24674867 equals 96386.2 Pa.
+*************************************************************************/
+static Uint32_t                   /** \return Pressure, 1/256 Pa */
+CompensatePFixed
+(
+const Uint32_t device,            /**< [in]  BME device number */
+const Uint32_t adc_P              /**< [in]  Uncompensated pressure, 20 bits */
+)
+{
+  const calibration_t * const pCal = &calibration[device];
+  Int64_t var1;
+  Int64_t var2;
+  Int64_t pressure;
+  Uint32_t result;
+
+  var1 = (Int64_t)pCal->tFine - 128000;
+  var2 = (var1 * var1 * pCal->p6) + (var1 * pCal->p5x2e17) + pCal->p4x2e35;
+  var1 = (((var1 * var1 * pCal->p3) >> 8) + (var1 * pCal->p2x4096));
+  var1 = ((((Int64_t)1 << 47) + var1) * pCal->p1) >> 33;
+
+  if (var1 == 0)
+  {
+    result = PRESSURE_MIN_FIXED; /* avoid exception caused by division by zero */
+  }
+  else
+  {
+    pressure = 1048576 - (Int64_t)adc_P;
+    pressure = (((pressure << 31) - var2) * 3125) / var1;
+    var1 = (pCal->p9 * (pressure >> 13) * (pressure >> 13)) >> 25;
+    var2 = (pCal->p8 * pressure) >> 19;
+    pressure = ((pressure + var1 + var2) >> 8) + pCal->p7x16;
+
+    if (pressure > (Int64_t)PRESSURE_MAX_FIXED)
+    {
+      result = PRESSURE_MAX_FIXED;
+    }
+    else if (pressure < (Int64_t)PRESSURE_MIN_FIXED)
+    {
+      result = PRESSURE_MIN_FIXED;
+    }
+    else
+    {
+      result = (Uint32_t)pressure;
+    }
+  }
+
+  return result;
+}
+
+/*********************************************************************//**
+  <!-- CompensateHFixed -->
+
+  Returns humidity in %rH as Q22.10 by the Bosch 32 bit integer
+  compensation. Output value of 47445 represents 47445/1024 = 46.333 %rH.
+*************************************************************************/
+static Uint32_t                   /** \return Humidity, 1/1024 %rH */
+CompensateHFixed
+(
+const Uint32_t device,            /**< [in]  BME device number */
+const Uint32_t adc_H              /**< [in]  Uncompensated humidity, 16 bits */
+)
+{
+  const calibration_t * const pCal = &calibration[device];
+  Int32_t var1;
+  Int32_t var2;
+  Int32_t var3;
+  Int32_t humidity;
+
+  var1 = pCal->tFine - 76800;
+  var2 = (((((Int32_t)adc_H * 16384) - pCal->h4x2e20) - (pCal->h5 * var1)) + 16384) >> 15;
+  var3 = (((var1 * pCal->h6) >> 10) * (((var1 * pCal->h3) >> 11) + 32768)) >> 10;
+  var3 = (((var3 + 2097152) * pCal->h2) + 8192) >> 14;
+  humidity = var2 * var3;
+  humidity = humidity - (((((humidity >> 15) * (humidity >> 15)) >> 7) * pCal->h1) >> 4);
+
+  if (humidity < 0)
+  {
+    humidity = 0;
+  }
+  else if (humidity > (Int32_t)(HUMIDITY_MAX_FIXED << 12))
+  {
+    humidity = (Int32_t)(HUMIDITY_MAX_FIXED << 12);
+  }
+  else
+  {
+    /* In range */
+  }
+
+  return (Uint32_t)humidity >> 12;
+}
+
+#endif
@@ -24,6 +24,15 @@
 
 /***** Type Definitions *************************************************/
 
+/* Data of one device returned by d_BME280_ReadAll */
+typedef struct
+{
+  Int32_t temperature;            /* 0.01 Deg C */
+  Uint32_t pressure;              /* Pa, Q24.8 (1/256 Pa) */
+  Uint32_t humidity;              /* %rH, Q22.10 (1/1024 %rH) */
+  d_Status_t status;              /* Status of the read of the device */
+} d_BME280_Data_t;
+
 /***** Variables ********************************************************/
 
 /***** Function Declarations ********************************************/
@@ -34,4 +43,7 @@ d_Status_t d_BME280_Initialise(const Uint32_t device, const Uint8_t config, cons
 /* Read the BME280 data */
 d_Status_t d_BME280_Read(const Uint32_t device, Float64_t * const pHumidity, Float64_t * const pPressure, Float64_t * const pTemperature);
 
+/* Read the data of all the BME280 devices */
+d_Status_t d_BME280_ReadAll(d_BME280_Data_t data[]);
+
 #endif /* D_BME280_H */
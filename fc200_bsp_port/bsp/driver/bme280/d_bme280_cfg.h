@@ -26,6 +26,11 @@
 
 #define d_BME280_MAX_INTERFACES  4u
 
+/* The data is compensated by the Bosch integer compensation, with the
+   calibration coefficients scaled at initialisation. Define
+   d_BME280_COMPENSATION_DOUBLE in the build to use the double precision
+   compensation instead */
+
 #define d_BME280_COUNT const Uint32_t d_BME280_Count = (sizeof(d_BME280_Config) / sizeof(d_BME280_Definition_t))
 
 
@@ -123,8 +123,41 @@ static const Uint32_t HILS_MAX_TIMEOUT = 250000;
 /* Minimum time to execute BIT function in microseconds */
 #define MINIMUM_MEMORY_TIME    50000u
 
+/* Internal sample rate, external sync (50Hz) * REG_UP_SCALE (40) */
+#define SAMPLE_CLOCK_HZ     2000u
+
+#if defined d_IMU_ADIS16505_INTEGRATION
+/* Number of samples buffered for d_IMU_Adis16505_Integrate, must be a power of two */
+#define SAMPLE_BUFFER_SIZE  64u
+
+/* Longest gap between data ready interrupts bridged by extending the period of the next sample */
+#define MAX_BRIDGED_PERIODS 8u
+
+/* DIAG_STAT bits that make the sample unusable for integration */
+#define DIAG_STAT_SAMPLE_ERRORS (REG_DIAG_STAT_SPI_ERROR | \
+                                 REG_DIAG_STAT_STANDBY_MODE | \
+                                 REG_DIAG_STAT_SENSOR_FAILURE | \
+                                 REG_DIAG_STAT_GYRO1_FAILURE | \
+                                 REG_DIAG_STAT_GYRO2_FAILURE | \
+                                 REG_DIAG_STAT_ACCEL_FAILURE)
+#endif
+
 /***** Type Definitions *************************************************/
 
+#if defined d_IMU_ADIS16505_INTEGRATION
+/* Sample buffered between the SPI interrupt and d_IMU_Adis16505_Integrate */
+typedef struct
+{
+  Float32_t gyro[d_IMU_ADIS16505_DIMENSIONS];
+  Float32_t accl[d_IMU_ADIS16505_DIMENSIONS];
+  Uint32_t drdyTime;                           /* Timer value at the data ready interrupt */
+  Uint32_t period;                             /* Time covered by the sample in microseconds */
+  Uint32_t lost;                               /* Sample periods bridged by this sample */
+  Uint16_t timeStamp;
+  Uint16_t diagStatus;
+} imuSample_t;
+#endif
+
 /***** Variables ********************************************************/
 
 static d_IMU_Adis16505_Data_t imuData;
@@ -140,12 +173,34 @@ static Uint32_t memoryStartTime;
 
 static Bool_t hilsBusy = d_FALSE;
 static Uint32_t hilsBurstRequestTime;
+
+/* Timer value at the data ready interrupt which requested the burst in progress */
+static Uint32_t burstDrdyTime;
+
+#if defined d_IMU_ADIS16505_INTEGRATION
+/* Samples written by the interrupt handlers at sampleHead and consumed at sampleTail */
+static imuSample_t sampleBuffer[SAMPLE_BUFFER_SIZE];
+static Uint32_t sampleHead = 0u;
+static Uint32_t sampleTail = 0u;
+static Bool_t samplePrevious = d_FALSE;
+static Uint32_t samplePreviousTime;
+
+/* Samples rejected since the last call to d_IMU_Adis16505_Integrate */
+static Uint32_t samplesRejected = 0u;
+#endif
+
 /***** Function Declarations ********************************************/
 
 static void deviceInterruptHandler(Bool_t hils);
 static void deviceInterruptBit(void);
 static void deviceInterruptStream(Bool_t hils);
 static Bool_t parseBurstMessage(const Uint8_t * const pResponse);
+#if defined d_IMU_ADIS16505_INTEGRATION
+static void sampleStore(const Bool_t valid);
+static void crossProduct(const Float32_t a[d_IMU_ADIS16505_DIMENSIONS],
+                         const Float32_t b[d_IMU_ADIS16505_DIMENSIONS],
+                         Float32_t result[d_IMU_ADIS16505_DIMENSIONS]);
+#endif
 static d_Status_t deviceSetup(void);
 static d_Status_t deviceBit(void);
 static d_Status_t registerRead(const Uint32_t channel, Uint16_t * const pValue);
@@ -248,6 +303,9 @@ d_IMU_Adis16505_Data_t * pImuData /**< [in]  Pointer to storage for IMU data */
   initialised = d_FALSE;
   state = IMU_ADIS16505_STATE_INIT;
 
+  /* A burst of a previous initialisation would take the response of the first register read */
+  spiBurstInProgress = d_FALSE;
+
   /* Initialise data structure */
   imuData.validDevice = d_FALSE;
   imuData.valid = d_FALSE;
@@ -343,6 +401,15 @@ d_IMU_Adis16505_Data_t * pImuData /**< [in]  Pointer to storage for IMU data */
 
   if (status == d_STATUS_SUCCESS)
   {
+#if defined d_IMU_ADIS16505_INTEGRATION
+    /* Discard the samples buffered during the BIT */
+    Uint32_t interruptFlags = d_INT_CriticalSectionEnter();
+    sampleTail = sampleHead;
+    samplePrevious = d_FALSE;
+    samplesRejected = 0u;
+    d_INT_CriticalSectionLeave(interruptFlags);
+#endif
+
     initialised = d_TRUE;
     imuData.validDevice = d_TRUE;
     state = IMU_ADIS16505_STATE_STREAM;
@@ -427,6 +494,117 @@ void
   return d_STATUS_SUCCESS;
 }
 
+#if defined d_IMU_ADIS16505_INTEGRATION
+/*********************************************************************//**
+  <!-- d_IMU_Adis16505_Integrate -->
+
+  Integrate the samples buffered since the last call into delta angle and
+  delta velocity. The rotation of the body during the interval is applied
+  with first order coning, rotation and sculling corrections so the
+  increments remain accurate when consumed at a lower rate than the
+  samples. Returns d_STATUS_NO_DATA, with zero increments, if no sample
+  has been buffered.
+*************************************************************************/
+d_Status_t                        /** \return Success or Failure */
+d_IMU_Adis16505_Integrate
+(
+d_IMU_Adis16505_Delta_t * const pDelta  /**< [out] Pointer to storage for the increments */
+)
+{
+  d_Status_t status = d_STATUS_SUCCESS;
+  Float32_t alpha[d_IMU_ADIS16505_DIMENSIONS] = {0.0f, 0.0f, 0.0f};   /* Sum of angle increments */
+  Float32_t nu[d_IMU_ADIS16505_DIMENSIONS] = {0.0f, 0.0f, 0.0f};      /* Sum of velocity increments */
+  Float32_t coning[d_IMU_ADIS16505_DIMENSIONS] = {0.0f, 0.0f, 0.0f};
+  Float32_t sculling[d_IMU_ADIS16505_DIMENSIONS] = {0.0f, 0.0f, 0.0f};
+  Float32_t dAlpha[d_IMU_ADIS16505_DIMENSIONS];
+  Float32_t dNu[d_IMU_ADIS16505_DIMENSIONS];
+  Float32_t cross1[d_IMU_ADIS16505_DIMENSIONS];
+  Float32_t cross2[d_IMU_ADIS16505_DIMENSIONS];
+  Uint32_t totalPeriod = 0u;
+
+  if (pDelta == NULL)
+  {
+    d_ERROR_Logger(d_STATUS_INVALID_PARAMETER, d_ERROR_CRITICALITY_CRITICAL_SHUTDOWN, 1, 0, 0, 0);
+    // cppcheck-suppress misra-c2012-15.5; Coding standard allows function to return if parameters are invalid
+    return d_STATUS_INVALID_PARAMETER;
+  }
+
+  if (initialised != d_TRUE)
+  {
+    d_ERROR_Logger(d_STATUS_NOT_INITIALISED, d_ERROR_CRITICALITY_CRITICAL_SHUTDOWN, 0, 0, 0, 0);
+    // cppcheck-suppress misra-c2012-15.5; Coding standard allows function to return if parameters are invalid
+    return d_STATUS_NOT_INITIALISED;
+  }
+
+  pDelta->samples = 0u;
+  pDelta->lostSamples = 0u;
+  pDelta->diagStatus = 0u;
+
+  /* Samples up to the head are complete, later samples are left for the next call */
+  Uint32_t interruptFlags = d_INT_CriticalSectionEnter();
+  Uint32_t head = sampleHead;
+  pDelta->rejectedSamples = samplesRejected;
+  samplesRejected = 0u;
+  d_INT_CriticalSectionLeave(interruptFlags);
+
+  while (sampleTail != head)
+  {
+    const imuSample_t * const pSample = &sampleBuffer[sampleTail & (SAMPLE_BUFFER_SIZE - 1u)];
+    Float32_t dt = (Float32_t)pSample->period * 1.0e-6f;
+
+    for (Uint32_t index = 0; index < d_IMU_ADIS16505_DIMENSIONS; index++)
+    {
+      dAlpha[index] = pSample->gyro[index] * dt;
+      dNu[index] = pSample->accl[index] * dt;
+    }
+
+    /* Coning 0.5 * (alpha x dAlpha) and sculling 0.5 * (alpha x dNu + nu x dAlpha),
+       using the sums before this sample */
+    crossProduct(alpha, dAlpha, cross1);
+    for (Uint32_t index = 0; index < d_IMU_ADIS16505_DIMENSIONS; index++)
+    {
+      coning[index] = coning[index] + (0.5f * cross1[index]);
+    }
+    crossProduct(alpha, dNu, cross1);
+    crossProduct(nu, dAlpha, cross2);
+    for (Uint32_t index = 0; index < d_IMU_ADIS16505_DIMENSIONS; index++)
+    {
+      sculling[index] = sculling[index] + (0.5f * (cross1[index] + cross2[index]));
+      alpha[index] = alpha[index] + dAlpha[index];
+      nu[index] = nu[index] + dNu[index];
+    }
+
+    totalPeriod = totalPeriod + pSample->period;
+    pDelta->samples++;
+    pDelta->lostSamples = pDelta->lostSamples + pSample->lost;
+    pDelta->diagStatus = pDelta->diagStatus | pSample->diagStatus;
+    pDelta->endTime = pSample->drdyTime;
+    pDelta->timeStamp = pSample->timeStamp;
+
+    /* Release the entry to the interrupt handler */
+    sampleTail++;
+  }
+
+  /* Rotation correction 0.5 * (alpha x nu) */
+  crossProduct(alpha, nu, cross1);
+  for (Uint32_t index = 0; index < d_IMU_ADIS16505_DIMENSIONS; index++)
+  {
+    pDelta->deltaAngle[index] = alpha[index] + coning[index];
+    pDelta->deltaVelocity[index] = nu[index] + (0.5f * cross1[index]) + sculling[index];
+  }
+  pDelta->deltaTime = (Float32_t)totalPeriod * 1.0e-6f;
+
+  if (pDelta->samples == 0u)
+  {
+    status = d_STATUS_NO_DATA;
+  }
+  ELSE_DO_NOTHING
+
+  return status;
+}
+
+#endif
+
 /*********************************************************************//**
   <!-- d_IMU_Adis16505_Bit -->
 
@@ -653,7 +831,12 @@ const Uint32_t channel            /**< [in]  Channel number */
       dataValid = parseBurstMessage(&response[2]);
       spiBurstInProgress = d_FALSE;
     }
+    // gcov-jst 1 It is not practical to generate this failure during bench testing.
+    ELSE_DO_NOTHING
     imuData.valid = dataValid;
+#if defined d_IMU_ADIS16505_INTEGRATION
+    sampleStore(dataValid);
+#endif
   }
   ELSE_DO_NOTHING
 
@@ -744,8 +927,12 @@ Bool_t hils                       /**< [in] HILS operation = d_TRUE */
   if (state == IMU_ADIS16505_STATE_STREAM)
   {
     /* Request burst transfer */
+    /* Timer value read first so the sample time is not delayed by the request */
+    Uint32_t drdyTime = d_TIMER_ReadValueInTicks();
+
     if (hils == d_TRUE)
     {
+      burstDrdyTime = drdyTime;
       burstReadHils();
     }
     else
@@ -754,9 +941,13 @@ Bool_t hils                       /**< [in] HILS operation = d_TRUE */
       command[0] = 0x68u;
       command[1] = 0x00u;
 
+      /* The transfer completes in the SPI interrupt. If the previous burst is still in progress
+         the request is refused and the sample is missed, which sampleStore detects from the
+         interval between data ready interrupts */
       d_Status_t status = d_SPI_PL_Transfer(d_IMU_Adis16505_SpiChannel, IMU_DEVICE, &command[0], 2u, NULL, BURST_BYTES);
       if (status == d_STATUS_SUCCESS)
       {
+        burstDrdyTime = drdyTime;
         spiBurstInProgress = d_TRUE;
       }
       else
@@ -824,7 +1015,7 @@ const Uint8_t * const pResponse
     imuData.temperature = (Float32_t)((Int16_t)itemp) / 10.0f;
 
     imuData.timeStamp = extractFromBuffer(&pResponse[28]);
-    imuData.sampleTime = d_TIMER_ReadValueInTicks();
+    imuData.sampleTime = burstDrdyTime;
     returnValue = d_TRUE;
     imuData.stale = d_FALSE;
   }
@@ -834,6 +1025,99 @@ const Uint8_t * const pResponse
   return returnValue;
 }
 
+#if defined d_IMU_ADIS16505_INTEGRATION
+/*********************************************************************//**
+  <!-- sampleStore -->
+
+  Buffer the sample just parsed for d_IMU_Adis16505_Integrate, or count it
+  as rejected if its checksum failed. The period
+  of the sample is taken from the interval between the data ready
+  interrupts rounded to whole output periods, so interrupt latency does
+  not appear in the integration time. A longer interval means samples were
+  missed, and their periods are added to this sample up to
+  MAX_BRIDGED_PERIODS. Under HILS the measured interval is used as the
+  simulator does not follow the device output rate.
+*************************************************************************/
+static void                       /** \return None */
+sampleStore
+(
+const Bool_t valid                /**< [in]  Sample parsed with a valid checksum */
+)
+{
+  Uint32_t nominal = (((Uint32_t)d_IMU_Adis16505_DecimationRate + 1u) * 1000000u) / SAMPLE_CLOCK_HZ;
+  Uint32_t period = nominal;
+  Uint32_t lost = 0u;
+
+  if (samplePrevious == d_TRUE)
+  {
+    Uint32_t interval = (Uint32_t)(((Uint64_t)(burstDrdyTime - samplePreviousTime) * 1000000uL) / d_TIMER_TICKS_PER_SECOND);
+    if (d_FCU_HilsActive() == d_TRUE)
+    {
+      if (interval < (nominal * MAX_BRIDGED_PERIODS))
+      {
+        period = interval;
+      }
+      // gcov-jst 1 It is not practical to ensure coverage of this path during bench testing.
+      ELSE_DO_NOTHING
+    }
+    else
+    {
+      Uint32_t periods = (interval + (nominal / 2u)) / nominal;
+      if (periods > 1u)
+      {
+        // gcov-jst 1 It is not practical to ensure coverage of this path during bench testing.
+        lost = periods - 1u;
+        if (periods <= MAX_BRIDGED_PERIODS)
+        {
+          period = periods * nominal;
+        }
+        ELSE_DO_NOTHING
+      }
+      ELSE_DO_NOTHING
+    }
+  }
+  ELSE_DO_NOTHING
+
+  if (valid != d_TRUE)
+  {
+    // gcov-jst 1 It is not practical to generate this failure during bench testing.
+    samplesRejected++;
+  }
+  else if ((imuData.diagStatus & DIAG_STAT_SAMPLE_ERRORS) != 0u)
+  {
+    /* The period is bridged by the next sample */
+    // gcov-jst 1 It is not practical to generate this failure during bench testing.
+    samplesRejected++;
+  }
+  else if ((sampleHead - sampleTail) >= SAMPLE_BUFFER_SIZE)
+  {
+    /* Application not consuming the samples, the period is bridged by the next sample */
+    // gcov-jst 1 It is not practical to generate this failure during bench testing.
+    samplesRejected++;
+  }
+  else
+  {
+    imuSample_t * const pSample = &sampleBuffer[sampleHead & (SAMPLE_BUFFER_SIZE - 1u)];
+    for (Uint32_t index = 0; index < d_IMU_ADIS16505_DIMENSIONS; index++)
+    {
+      pSample->gyro[index] = imuData.gyro[index];
+      pSample->accl[index] = imuData.accl[index];
+    }
+    pSample->drdyTime = burstDrdyTime;
+    pSample->period = period;
+    pSample->lost = lost;
+    pSample->timeStamp = imuData.timeStamp;
+    pSample->diagStatus = imuData.diagStatus;
+    sampleHead++;
+
+    samplePrevious = d_TRUE;
+    samplePreviousTime = burstDrdyTime;
+  }
+
+  return;
+}
+#endif
+
 /*********************************************************************//**
   <!-- deviceSetup -->
 
@@ -892,8 +1176,8 @@ void
     /* No filtering */
     (void)registerWrite(REG_FILT_CTRL, 0u);
 
-    /* Decimation for 100Hz sample output */
-    (void)registerWrite(REG_DEC_RATE, 19u);
+    /* Decimation of the sample output, configured for the rate consumed by the application */
+    (void)registerWrite(REG_DEC_RATE, d_IMU_Adis16505_DecimationRate);
 
     /* Set to streaming so data will be received when available */
     state = IMU_ADIS16505_STATE_STREAM;
@@ -1230,6 +1514,28 @@ const Uint8_t * const buffer      /**< [in]  Pointer to buffer */
   return (Uint16_t)((Uint16_t)buffer[0u] << 8u) | buffer[1u];
 }
 
+#if defined d_IMU_ADIS16505_INTEGRATION
+/*********************************************************************//**
+  <!-- crossProduct -->
+
+  Vector cross product, result = a x b.
+*************************************************************************/
+static void                       /** \return None */
+crossProduct
+(
+const Float32_t a[d_IMU_ADIS16505_DIMENSIONS],      /**< [in]  First vector */
+const Float32_t b[d_IMU_ADIS16505_DIMENSIONS],      /**< [in]  Second vector */
+Float32_t result[d_IMU_ADIS16505_DIMENSIONS]        /**< [out] Cross product */
+)
+{
+  result[0] = (a[1] * b[2]) - (a[2] * b[1]);
+  result[1] = (a[2] * b[0]) - (a[0] * b[2]);
+  result[2] = (a[0] * b[1]) - (a[1] * b[0]);
+
+  return;
+}
+#endif
+
 /*********************************************************************//**
   <!-- bcd2 -->
 
@@ -1390,7 +1696,11 @@ void
   (void)d_UART_Receive(HILS_UART, response, BURST_BYTES + 1u, &received);
   if (received >= (BURST_BYTES + 1u))
   {
+#if defined d_IMU_ADIS16505_INTEGRATION
+    sampleStore(parseBurstMessage(&response[3]));
+#else
     (void)parseBurstMessage(&response[3]);
+#endif
     state = IMU_ADIS16505_STATE_STREAM;
   }
   else
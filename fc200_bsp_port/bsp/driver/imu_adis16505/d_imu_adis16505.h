@@ -71,6 +71,23 @@ typedef struct
   Uint16_t bitResultSensor;                    /* The result of the sensor BIT at initialisation */
 } d_IMU_Adis16505_Data_t;
 
+#if defined d_IMU_ADIS16505_INTEGRATION
+/* Increments integrated over the samples consumed by d_IMU_Adis16505_Integrate */
+typedef struct
+{
+  Float32_t deltaAngle[d_IMU_ADIS16505_DIMENSIONS];     /* Coning corrected rotation vector, radians */
+  Float32_t deltaVelocity[d_IMU_ADIS16505_DIMENSIONS];  /* Rotation and sculling corrected velocity change, m/s,
+                                                           in the body frame at the start of the interval */
+  Float32_t deltaTime;                                  /* Sample periods covered by the increments, seconds */
+  Uint32_t samples;                                     /* Samples integrated */
+  Uint32_t lostSamples;                                 /* Sample periods without a usable sample, bridged by the next sample */
+  Uint32_t rejectedSamples;                             /* Samples failing checksum or DIAG_STAT checks, or dropped by a full buffer */
+  Uint32_t endTime;                                     /* Data ready time of the last sample integrated */
+  Uint16_t timeStamp;                                   /* Device time stamp of the last sample integrated */
+  Uint16_t diagStatus;                                  /* DIAG_STAT bits of the samples integrated, ORed */
+} d_IMU_Adis16505_Delta_t;
+#endif
+
 typedef enum
 {
   IMU_ADIS16505_BIT_SENSOR = 0,
@@ -100,6 +117,11 @@ d_Status_t d_IMU_Adis16505_Reset(void);
 /* Read the IMU data */
 d_Status_t d_IMU_Adis16505_Read(void);
 
+#if defined d_IMU_ADIS16505_INTEGRATION
+/* Integrate the samples buffered since the last call */
+d_Status_t d_IMU_Adis16505_Integrate(d_IMU_Adis16505_Delta_t * const pDelta);
+#endif
+
 /* Perform BIT functions */
 d_Status_t d_IMU_Adis16505_Bit(d_IMU_Adis16505_Bit_t test);
 
@@ -29,6 +29,12 @@
 
 /***** Constants ********************************************************/
 
+/* The samples are published by d_IMU_Adis16505_Read as they arrive. The FC200
+   application takes its inertial data from the INS, so the buffering of the
+   samples and their integration by d_IMU_Adis16505_Integrate are only built
+   when d_IMU_ADIS16505_INTEGRATION is defined, by an application using the
+   ADIS16505 as its inertial input */
+
 /***** Type Definitions *************************************************/
 
 /***** Variables ********************************************************/
@@ -40,6 +46,9 @@ extern const d_DISC_IO_t d_IMU_Adis16505_DiscretePower;
 /* Note that the UART transmit pin is used to reset the device only */
 extern const Uint32_t d_IMU_Adis16505_UartChannel;
 
+/* Value of the DEC_RATE register, output rate = 2000Hz / (d_IMU_Adis16505_DecimationRate + 1) */
+extern const Uint16_t d_IMU_Adis16505_DecimationRate;
+
 /***** Function Declarations ********************************************/
 
 #endif /* D_IMU_ADIS16505_CFG_H */
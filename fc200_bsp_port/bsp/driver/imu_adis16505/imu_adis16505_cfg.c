@@ -33,6 +33,10 @@ __attribute__((weak)) const d_DISC_IO_t d_IMU_Adis16505_DiscretePower = d_FCU_IM
 
 __attribute__((weak)) const Uint32_t d_IMU_Adis16505_UartChannel = 8;
 
+/* 100Hz output rate, an application defining d_IMU_ADIS16505_INTEGRATION to integrate
+   the full 2000Hz samples overrides this with 0 */
+__attribute__((weak)) const Uint16_t d_IMU_Adis16505_DecimationRate = 19;
+
 /***** Type Definitions *************************************************/
 
 /***** Variables ********************************************************/
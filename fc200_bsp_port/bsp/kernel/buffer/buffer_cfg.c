@@ -47,7 +47,7 @@
 /* Parameters for the definition macro are:
    name       any arbitrary name unique to the fixed item length buffers
    entrySize  the size in bytes of each entry
-   entries    the maximum number of entries that may be stored */
+   entries    the maximum number of entries that may be stored, a power of two wraps indices by mask */
 
 // cppcheck-suppress misra-c2012-8.2; CppCheck erroneously reports this violation assuming the following line is a function definition.
 d_BUFFER_FIXED(events, sizeof(d_EVENT_LogEvent_t), 20);
@@ -75,8 +75,8 @@ __attribute__((weak)) d_BUFFER_FIXED_COUNT;
 /* Define buffers for variable length items */
 /* Parameters for the definition macro are:
    name       any arbitrary name unique to the variable item length buffers
-   totalSize  the total buffer size in bytes
-   entries    the maximum number of entries that may be stored */
+   totalSize  the total buffer size in bytes, a power of two wraps indices by mask
+   entries    the maximum number of entries that may be stored, a power of two wraps indices by mask */
 
 // cppcheck-suppress misra-c2012-8.2; CppCheck erroneously reports this violation assuming the following line is a function definition.
 d_BUFFER_VAR(msg1, 500, 5);
@@ -42,6 +42,7 @@
 
 static void messageCopyOut(Uint8_t * const pDestination, const Uint8_t * const pSource, const Uint32_t bufferSize, const Uint32_t bufferIndex, const Uint32_t length);
 static void messageCopyIn(Uint8_t * const pDestination, const Uint32_t bufferSize, const Uint32_t bufferIndex, const Uint8_t * const pSource, const Uint32_t length);
+static Uint32_t indexAdvance(const Uint32_t index, const Uint32_t step, const Uint32_t capacity, const Uint32_t mask);
 
 /***** Function Definitions *********************************************/
 
@@ -113,7 +114,8 @@ Uint32_t * const pActual       /**< [out] Pointer to storage for actual number o
 {
   d_Status_t returnValue = d_STATUS_SUCCESS;
   Uint32_t written = 0;
-  Uint32_t readIndex;
+  Uint32_t run;
+  Uint32_t limit;
 
   if (id >= bufferFixedCount)
   {
@@ -137,16 +139,36 @@ Uint32_t * const pActual       /**< [out] Pointer to storage for actual number o
   }
   else
   {
-    readIndex = 0;
+    /* Copy in runs of entries that are contiguous in the buffer */
     while ((written < count) && (d_BUFFER_FixedDef[id].pBufferFixedStatus->entryCount < d_BUFFER_FixedDef[id].entryMax))
     {
+      run = count - written;
+      limit = d_BUFFER_FixedDef[id].entryMax - d_BUFFER_FixedDef[id].pBufferFixedStatus->entryCount;
+      if (run > limit)
+      {
+        run = limit;
+      }
+      else
+      {
+        DO_NOTHING();
+      }
+      limit = d_BUFFER_FixedDef[id].entryMax - d_BUFFER_FixedDef[id].pBufferFixedStatus->indexIn;
+      if (run > limit)
+      {
+        run = limit;
+      }
+      else
+      {
+        DO_NOTHING();
+      }
 // cppcheck-suppress misra-c2012-11.8; Erroneous reporting of removal of pointer data qualification. Implementation does not violate the rule.
       d_GEN_MemoryCopy(&d_BUFFER_FixedDef[id].pBuffer[d_BUFFER_FixedDef[id].pBufferFixedStatus->indexIn * d_BUFFER_FixedDef[id].entrySize],
-                       (const Uint8_t * const)&pData[readIndex * d_BUFFER_FixedDef[id].entrySize],
-                       d_BUFFER_FixedDef[id].entrySize);
-      d_BUFFER_FixedDef[id].pBufferFixedStatus->indexIn = (d_BUFFER_FixedDef[id].pBufferFixedStatus->indexIn + 1u) % d_BUFFER_FixedDef[id].entryMax;
+                       (const Uint8_t * const)&pData[written * d_BUFFER_FixedDef[id].entrySize],
+                       run * d_BUFFER_FixedDef[id].entrySize);
+      d_BUFFER_FixedDef[id].pBufferFixedStatus->indexIn = indexAdvance(d_BUFFER_FixedDef[id].pBufferFixedStatus->indexIn, run,
+                                                                      d_BUFFER_FixedDef[id].entryMax, d_BUFFER_FixedDef[id].entryMask);
       Uint32_t interruptFlags = d_INT_CriticalSectionEnter();
-      d_BUFFER_FixedDef[id].pBufferFixedStatus->entryCount++;
+      d_BUFFER_FixedDef[id].pBufferFixedStatus->entryCount = d_BUFFER_FixedDef[id].pBufferFixedStatus->entryCount + run;
       if (d_BUFFER_FixedDef[id].pBufferFixedStatus->entryCount > d_BUFFER_FixedDef[id].pBufferFixedStatus->highWater)
       {
         d_BUFFER_FixedDef[id].pBufferFixedStatus->highWater = d_BUFFER_FixedDef[id].pBufferFixedStatus->entryCount;
@@ -156,8 +178,7 @@ Uint32_t * const pActual       /**< [out] Pointer to storage for actual number o
         DO_NOTHING();
       }
       d_INT_CriticalSectionLeave(interruptFlags);
-      readIndex++;
-      written++;
+      written = written + run;
     }
     *pActual = written;
     if (written < count)
@@ -189,7 +210,8 @@ Uint32_t * const pActual       /**< [out] Pointer to storage for actual number o
 {
   d_Status_t returnValue = d_STATUS_SUCCESS;
   Uint32_t read = 0u;
-  Uint32_t writeIndex;
+  Uint32_t run;
+  Uint32_t limit;
 
   if (id >= bufferFixedCount)
   {
@@ -213,18 +235,37 @@ Uint32_t * const pActual       /**< [out] Pointer to storage for actual number o
   }
   else
   {
-    writeIndex = 0;
+    /* Copy out runs of entries that are contiguous in the buffer */
     while ((read < count) && (d_BUFFER_FixedDef[id].pBufferFixedStatus->entryCount > 0u))
     {
-      d_GEN_MemoryCopy(&pData[writeIndex * d_BUFFER_FixedDef[id].entrySize],
+      run = count - read;
+      limit = d_BUFFER_FixedDef[id].pBufferFixedStatus->entryCount;
+      if (run > limit)
+      {
+        run = limit;
+      }
+      else
+      {
+        DO_NOTHING();
+      }
+      limit = d_BUFFER_FixedDef[id].entryMax - d_BUFFER_FixedDef[id].pBufferFixedStatus->indexOut;
+      if (run > limit)
+      {
+        run = limit;
+      }
+      else
+      {
+        DO_NOTHING();
+      }
+      d_GEN_MemoryCopy(&pData[read * d_BUFFER_FixedDef[id].entrySize],
                        &d_BUFFER_FixedDef[id].pBuffer[d_BUFFER_FixedDef[id].pBufferFixedStatus->indexOut * d_BUFFER_FixedDef[id].entrySize],
-                       d_BUFFER_FixedDef[id].entrySize);
-      d_BUFFER_FixedDef[id].pBufferFixedStatus->indexOut = (d_BUFFER_FixedDef[id].pBufferFixedStatus->indexOut + 1u) % d_BUFFER_FixedDef[id].entryMax;
+                       run * d_BUFFER_FixedDef[id].entrySize);
+      d_BUFFER_FixedDef[id].pBufferFixedStatus->indexOut = indexAdvance(d_BUFFER_FixedDef[id].pBufferFixedStatus->indexOut, run,
+                                                                       d_BUFFER_FixedDef[id].entryMax, d_BUFFER_FixedDef[id].entryMask);
       Uint32_t interruptFlags = d_INT_CriticalSectionEnter();
-      d_BUFFER_FixedDef[id].pBufferFixedStatus->entryCount--;
+      d_BUFFER_FixedDef[id].pBufferFixedStatus->entryCount = d_BUFFER_FixedDef[id].pBufferFixedStatus->entryCount - run;
       d_INT_CriticalSectionLeave(interruptFlags);
-      writeIndex++;
-      read++;
+      read = read + run;
     }
     *pActual = read;
     if (read < count)
@@ -368,8 +409,10 @@ const Uint32_t length          /**< [in] Length of message to write */
                     length);
       d_BUFFER_VarDef[id].pBufferVarItem[d_BUFFER_VarDef[id].pBufferVarStatus->indexIn].itemIndex = d_BUFFER_VarDef[id].pBufferVarStatus->bufferIndexIn;
       d_BUFFER_VarDef[id].pBufferVarItem[d_BUFFER_VarDef[id].pBufferVarStatus->indexIn].itemSize = length;
-      d_BUFFER_VarDef[id].pBufferVarStatus->bufferIndexIn = (d_BUFFER_VarDef[id].pBufferVarStatus->bufferIndexIn + length) % d_BUFFER_VarDef[id].totalSize;
-      d_BUFFER_VarDef[id].pBufferVarStatus->indexIn = (d_BUFFER_VarDef[id].pBufferVarStatus->indexIn + 1u) % d_BUFFER_VarDef[id].entryMax;
+      d_BUFFER_VarDef[id].pBufferVarStatus->bufferIndexIn = indexAdvance(d_BUFFER_VarDef[id].pBufferVarStatus->bufferIndexIn, length,
+                                                                         d_BUFFER_VarDef[id].totalSize, d_BUFFER_VarDef[id].sizeMask);
+      d_BUFFER_VarDef[id].pBufferVarStatus->indexIn = indexAdvance(d_BUFFER_VarDef[id].pBufferVarStatus->indexIn, 1u,
+                                                                   d_BUFFER_VarDef[id].entryMax, d_BUFFER_VarDef[id].entryMask);
       Uint32_t interruptFlags = d_INT_CriticalSectionEnter();
       d_BUFFER_VarDef[id].pBufferVarStatus->bufferUsedBytes = d_BUFFER_VarDef[id].pBufferVarStatus->bufferUsedBytes + length;
       d_BUFFER_VarDef[id].pBufferVarStatus->entryCount++;
@@ -434,7 +477,8 @@ Uint32_t * const pLength       /**< [out] Pointer to storage for message length
                      d_BUFFER_VarDef[id].totalSize,
                      d_BUFFER_VarDef[id].pBufferVarItem[d_BUFFER_VarDef[id].pBufferVarStatus->indexOut].itemIndex,
                      entrySize);
-      d_BUFFER_VarDef[id].pBufferVarStatus->indexOut = (d_BUFFER_VarDef[id].pBufferVarStatus->indexOut + 1u) % d_BUFFER_VarDef[id].entryMax;
+      d_BUFFER_VarDef[id].pBufferVarStatus->indexOut = indexAdvance(d_BUFFER_VarDef[id].pBufferVarStatus->indexOut, 1u,
+                                                                    d_BUFFER_VarDef[id].entryMax, d_BUFFER_VarDef[id].entryMask);
       Uint32_t interruptFlags = d_INT_CriticalSectionEnter();
       d_BUFFER_VarDef[id].pBufferVarStatus->bufferUsedBytes = d_BUFFER_VarDef[id].pBufferVarStatus->bufferUsedBytes - entrySize;
       d_BUFFER_VarDef[id].pBufferVarStatus->entryCount--;
@@ -502,13 +546,25 @@ const Uint32_t bufferStart,      /**< [in]  Source buffer start index */
 const Uint32_t length            /**< [in]  Length of message to copy */
 )
 {
-  Uint32_t index;
+  /* Copy up to the end of the buffer, then any remainder from the start */
+  Uint32_t first = bufferSize - bufferStart;
+  if (first > length)
+  {
+    first = length;
+  }
+  else
+  {
+    DO_NOTHING();
+  }
 
-  Uint32_t bufferIndex = bufferStart;
-  for (index = 0u; index < length; index++)
+  d_GEN_MemoryCopy(&pDestination[0], &pSource[bufferStart], first);
+  if (first < length)
+  {
+    d_GEN_MemoryCopy(&pDestination[first], &pSource[0], length - first);
+  }
+  else
   {
-    pDestination[index] = pSource[bufferIndex];
-    bufferIndex = (bufferIndex + 1u) % bufferSize;
+    DO_NOTHING();
   }
 
   return;
@@ -529,14 +585,59 @@ const Uint8_t * const pSource,   /**< [in] Source pointer */
 const Uint32_t length            /**< [in] Length of message to copy */
 )
 {
-  Uint32_t index;
+  /* Copy up to the end of the buffer, then any remainder to the start */
+  Uint32_t first = bufferSize - bufferStart;
+  if (first > length)
+  {
+    first = length;
+  }
+  else
+  {
+    DO_NOTHING();
+  }
 
-  Uint32_t bufferIndex = bufferStart;
-  for (index = 0u; index < length; index++)
+  d_GEN_MemoryCopy(&pDestination[bufferStart], &pSource[0], first);
+  if (first < length)
+  {
+    d_GEN_MemoryCopy(&pDestination[0], &pSource[first], length - first);
+  }
+  else
   {
-    pDestination[bufferIndex] = pSource[index];
-    bufferIndex = (bufferIndex + 1u) % bufferSize;
+    DO_NOTHING();
   }
 
   return;
 }
+
+/*********************************************************************//**
+  <!-- indexAdvance -->
+
+  Advance a buffer index by a step no greater than the capacity, wrapping
+  by mask when the capacity is a power of two and by comparison otherwise.
+*************************************************************************/
+static Uint32_t                  /** \return Advanced index */
+indexAdvance
+(
+const Uint32_t index,            /**< [in] Current index */
+const Uint32_t step,             /**< [in] Number of positions to advance */
+const Uint32_t capacity,         /**< [in] Number of positions */
+const Uint32_t mask              /**< [in] Wrap mask, zero if the capacity is not a power of two */
+)
+{
+  Uint32_t next = index + step;
+
+  if (mask != 0u)
+  {
+    next = next & mask;
+  }
+  else if (next >= capacity)
+  {
+    next = next - capacity;
+  }
+  else
+  {
+    DO_NOTHING();
+  }
+
+  return next;
+}
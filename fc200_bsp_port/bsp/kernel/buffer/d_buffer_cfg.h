@@ -31,6 +31,10 @@
 
 /***** Constants ********************************************************/
 
+/* Index wrap mask for a capacity, the capacity less one if it is a power of two, otherwise zero
+   in which case indices are wrapped by comparison */
+#define d_BUFFER_WRAP_MASK(capacity)  (((((capacity) & ((capacity) - 1u)) == 0u) && ((capacity) > 1u)) ? ((capacity) - 1u) : 0u)
+
 /***** Type Definitions *************************************************/
 
 /* Fixed entry link buffers */
@@ -50,6 +54,7 @@ typedef struct
   BufferFixedStatus_t * pBufferFixedStatus;  /* Pointer to status structure */
   Uint32_t entrySize;                        /* Entry size */
   Uint32_t entryMax;                         /* Maximum number of entries */
+  Uint32_t entryMask;                        /* Entry index wrap mask, zero if entryMax is not a power of two */
 } d_BUFFER_FixedDef_t;
 
 /* Variable length buffers */
@@ -79,6 +84,8 @@ typedef struct
   BufferVarItem_t * pBufferVarItem;      /* Pointer to items structure */
   Uint32_t entryMax;                     /* Maximum number of entries */
   Uint32_t totalSize;                    /* Total buffer size */
+  Uint32_t entryMask;                    /* Entry index wrap mask, zero if entryMax is not a power of two */
+  Uint32_t sizeMask;                     /* Buffer index wrap mask, zero if totalSize is not a power of two */
 } d_BUFFER_VarDef_t;
 
 // cppcheck-suppress misra-c2012-8.11; The constant array is defined by configuration data and is unknown to the driver. Violation of 'Advisory' rule does not present a risk.
@@ -99,7 +106,8 @@ static BufferFixedStatus_t (name##_bufferFixedStatus);
   &(name##_buffer)[0][0],         \
   &(name##_bufferFixedStatus),    \
   sizeof((name##_buffer)[0]),     \
-  sizeof(name##_buffer)/ sizeof((name##_buffer)[0])  \
+  sizeof(name##_buffer)/ sizeof((name##_buffer)[0]),  \
+  d_BUFFER_WRAP_MASK(sizeof(name##_buffer)/ sizeof((name##_buffer)[0]))  \
 } 
 
 #define d_BUFFER_FIXED_COUNT const Uint32_t bufferFixedCount = (sizeof(d_BUFFER_FixedDef) / sizeof(d_BUFFER_FixedDef_t))
@@ -117,7 +125,9 @@ static BufferVarItem_t ((name##_bufferVarItem)[entries]);
   &(name##_bufferVarStatus),    \
   &(name##_bufferVarItem[0]),   \
   (sizeof(name##_bufferVarItem) / sizeof(BufferVarItem_t)),   \
-  sizeof(name##_buffer)         \
+  sizeof(name##_buffer),        \
+  d_BUFFER_WRAP_MASK(sizeof(name##_bufferVarItem) / sizeof(BufferVarItem_t)),   \
+  d_BUFFER_WRAP_MASK(sizeof(name##_buffer))  \
 } 
 
 #define d_BUFFER_VAR_COUNT const Uint32_t bufferVarCount = (sizeof(d_BUFFER_VarDef) / sizeof(d_BUFFER_VarDef_t))
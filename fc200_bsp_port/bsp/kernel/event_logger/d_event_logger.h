@@ -87,4 +87,7 @@ d_Status_t d_EVENT_ReadEventMmc(const Uint32_t entryNumber, d_EVENT_LogEvent_t *
 /* Background write of data to MMC. This function should be called by the scheduler periodically. */
 void d_EVENT_ProcessMmc(void);
 
+/* Background write of one quantum of data to MMC. This function should be called by the background dispatcher. */
+Bool_t d_EVENT_ProcessMmcBackground(void);
+
 #endif /* D_EVENT_LOGGER_H */
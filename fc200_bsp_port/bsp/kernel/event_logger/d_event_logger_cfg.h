@@ -42,6 +42,9 @@ typedef d_Status_t(*d_EVENT_LogCritical_t)(d_EVENT_LogEvent_t * const pEvent);
 /* Index to buffer entry for storing events */
 extern const Uint32_t d_EVENT_Fixed_Events_Buffer_Index;
 
+/* Number of events written to MMC in one background quantum */
+extern const Uint32_t d_EVENT_BackgroundEventCount;
+
 /***** Function Declarations ********************************************/
 
 extern const Uint32_t d_EVENT_LogCriticalDevice;
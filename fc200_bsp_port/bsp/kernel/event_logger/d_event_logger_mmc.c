@@ -87,3 +87,18 @@ void
   return;
 }
 
+/*********************************************************************//**
+  <!-- d_EVENT_ProcessMmcBackground -->
+
+  Background write of one quantum of data to MMC
+  This function should be called by the background dispatcher.
+*************************************************************************/
+Bool_t       /** \return d_TRUE if data remains to be written */
+d_EVENT_ProcessMmcBackground
+(
+void
+)
+{
+  /* Write a bounded number of events to MMC */
+  return ProcessMmcEventBackground();
+}
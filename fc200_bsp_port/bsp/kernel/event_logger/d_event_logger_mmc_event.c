@@ -77,6 +77,8 @@ static Bool_t ReadAllocationTableAndVerify(const Uint32_t sector, d_EVENT_Alloca
 
 static void writeEventAllocationTable(void);
 
+static Bool_t drainEvents(const Uint32_t maxEvents);
+
 /***** Function Definitions *********************************************/
 
 /*********************************************************************//**
@@ -274,16 +276,47 @@ ProcessMmcEvent
 (
 void
 )
+{
+  (void)drainEvents(0xFFFFFFFFu);
+
+  return;
+}
+
+/*********************************************************************//**
+  <!-- ProcessMmcEventBackground -->
+
+  Write one background quantum of event data to MMC
+*************************************************************************/
+Bool_t       /** \return d_TRUE if events remain in the buffer */
+ProcessMmcEventBackground
+(
+void
+)
+{
+  return drainEvents(d_EVENT_BackgroundEventCount);
+}
+
+/*********************************************************************//**
+  <!-- drainEvents -->
+
+  Write up to the specified number of buffered events to MMC
+*************************************************************************/
+static Bool_t          /** \return d_TRUE if events remain in the buffer */
+drainEvents
+(
+const Uint32_t maxEvents  /**< [in] Maximum number of events to write */
+)
 {
   d_Status_t status;
   d_EVENT_LogEvent_t event;
   Uint32_t count;
+  Uint32_t written = 0u;
   Bool_t done = d_FALSE;
   Bool_t updated = d_FALSE;
   
   if (initialised == d_TRUE)
   {
-    while (done == d_FALSE)
+    while ((done == d_FALSE) && (written < maxEvents))
     {
       status = d_BUFFER_FixedRead(d_EVENT_Fixed_Events_Buffer_Index, (Uint8_t *)&event, 1, &count);
       if ((status == d_STATUS_SUCCESS) && (count >= 1u))
@@ -318,6 +351,7 @@ void
         ELSE_DO_NOTHING
         
         allocationEventSector.allocation.entryCount++;
+        written++;
         updated = d_TRUE;
       }
       else
@@ -327,7 +361,7 @@ void
     } /* end "while (done == d_FALSE)" */
 
     /* Add event if any events were missed due to buffer queue being full */
-    if (missedEvents > 0u)
+    if ((done == d_TRUE) && (missedEvents > 0u))
     {
       /* At this stage buffer will just have been emptied */
       (void)d_EVENT_Log_Event(d_EVENT_NON_CRITICAL, (const Char_t *)"Missed events due to buffer full", 32u, missedEvents);
@@ -342,8 +376,12 @@ void
     ELSE_DO_NOTHING
     
   } /* end "if (initialisd == d_TRUE)" */
+  else
+  {
+    done = d_TRUE;
+  }
   
-  return;
+  return (done == d_TRUE) ? d_FALSE : d_TRUE;
 }
 
 /*********************************************************************//**
@@ -388,7 +426,10 @@ d_EVENT_AllocationEvent_t * const pAllocation   /**< [out] Pointer to storage fo
 /*********************************************************************//**
   <!-- writeEventAllocationTable -->
 
-  Write the event allocation table to the MMC
+  Write the event allocation table to the MMC. The event sectors are
+  flushed first so that the table never refers to data not yet on the
+  device, and each copy of the table is flushed on its own so that at
+  most one copy can be corrupted by a power loss.
 *************************************************************************/
 static void         /** \return None */
 writeEventAllocationTable
@@ -397,8 +438,12 @@ void
 )
 {
   allocationEventSector.allocation.crc = d_CRC32_Calculate((Uint8_t *)&allocationEventSector.allocation, sizeof(d_EVENT_AllocationEvent_t) - 4u);
+  /* No point in checking if writes successful as cannot log anything if they fail */
+  (void)d_MMC_Flush();
   (void)d_MMC_SectorWrite(LOG_EVENT_ALLOC_SECTOR_1, 1, (Uint8_t *)&allocationEventSector.allocation);
+  (void)d_MMC_Flush();
   (void)d_MMC_SectorWrite(LOG_EVENT_ALLOC_SECTOR_2, 1, (Uint8_t *)&allocationEventSector.allocation);
+  (void)d_MMC_Flush();
 
   return;
 }
@@ -53,4 +53,7 @@ d_Status_t EventMmcClear(void);
 /* Write stored events to MMC */
 void ProcessMmcEvent(void);
 
+/* Write one background quantum of stored events to MMC */
+Bool_t ProcessMmcEventBackground(void);
+
 #endif /* D_EVENT_LOGGER_MMC_EVENT_H */
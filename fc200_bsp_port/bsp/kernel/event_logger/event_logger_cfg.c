@@ -35,6 +35,8 @@
 
 __attribute__((weak)) const Uint32_t d_EVENT_Fixed_Events_Buffer_Index = 0;
 
+__attribute__((weak)) const Uint32_t d_EVENT_BackgroundEventCount = 4;
+
 /***** Type Definitions *************************************************/
 
 /***** Variables ********************************************************/
@@ -94,7 +94,7 @@
 /* This option switches fast seek function. (0:Disable or 1:Enable) */
 
 
-#define FF_USE_EXPAND	0
+#define FF_USE_EXPAND	1
 /* This option switches d_FAT_Expand function. (0:Disable or 1:Enable) */
 
 
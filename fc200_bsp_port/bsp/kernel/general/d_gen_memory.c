@@ -30,7 +30,11 @@
 /*********************************************************************//**
   <!-- d_GEN_MemoryCopy -->
 
-  Fast memory copy.
+  Fast memory copy. When source and destination have the same alignment
+  within a word, bytes are copied up to a word boundary and the bulk is
+  copied in blocks of eight words, loaded and stored together so that the
+  compiler uses LDM/STM. Copies longer than a few kB are better made by
+  d_DMA_Copy.
 *************************************************************************/
 void                              /** \return None */
 d_GEN_MemoryCopy
@@ -40,36 +44,70 @@ const Uint8_t * const pSource,    /**< [in]  Source address */
 const Uint32_t length             /**< [in]  Number of bytes to copy */
 )
 {
-  Uint32_t index;
+  Uint32_t index = 0u;
   
-  /* If source and destination addresses are not word aligned, or small block to copy
-     then use a simple byte copy */
+  /* Small blocks, or source and destination of different alignment, use a simple byte copy */
 // cppcheck-suppress misra-c2012-11.4;  Conversion required by non portable low level software. Violation of 'Advisory' rule does not present a risk.
-  if ((((Pointer_t)pDestination % 4u) != 0u) || (((Pointer_t)pSource % 4u) != 0u) || (length < 16u))
+  if ((length >= 16u) && ((((Pointer_t)pDestination ^ (Pointer_t)pSource) % 4u) == 0u))
   {
-    for (index = 0; index < length; index++)
+    /* Copy bytes up to the first word boundary */
+// cppcheck-suppress misra-c2012-11.4;  Conversion required by non portable low level software. Violation of 'Advisory' rule does not present a risk.
+    while (((Pointer_t)&pDestination[index] % 4u) != 0u)
     {
       pDestination[index] = pSource[index];
+      index++;
     }
-  }
-  else
-  {
-// cppcheck-suppress misra-c2012-11.3;  Validity of pointer conversion is assured by check on line 47. Violation of 'Advisory' rule does not present a risk.
-    Uint32_t * destination32 = (Uint32_t *)pDestination;
-// cppcheck-suppress misra-c2012-11.3;  Validity of pointer conversion is assured by check on line 47. Violation of 'Advisory' rule does not present a risk.
-    const Uint32_t * source32 = (const Uint32_t *)pSource;
-    /* Copy words */
-    for (index = 0; index < (length / 4u); index++)
+
+// cppcheck-suppress misra-c2012-11.3;  Both pointers are word aligned at this point. Violation of 'Advisory' rule does not present a risk.
+    Uint32_t * destination32 = (Uint32_t *)&pDestination[index];
+// cppcheck-suppress misra-c2012-11.3;  Both pointers are word aligned at this point. Violation of 'Advisory' rule does not present a risk.
+    const Uint32_t * source32 = (const Uint32_t *)&pSource[index];
+    Uint32_t words = (length - index) / 4u;
+    Uint32_t word = 0u;
+
+    /* Copy blocks of eight words */
+    while ((words - word) >= 8u)
     {
-      destination32[index] = source32[index];
+      Uint32_t w0 = source32[word];
+      Uint32_t w1 = source32[word + 1u];
+      Uint32_t w2 = source32[word + 2u];
+      Uint32_t w3 = source32[word + 3u];
+      Uint32_t w4 = source32[word + 4u];
+      Uint32_t w5 = source32[word + 5u];
+      Uint32_t w6 = source32[word + 6u];
+      Uint32_t w7 = source32[word + 7u];
+      destination32[word] = w0;
+      destination32[word + 1u] = w1;
+      destination32[word + 2u] = w2;
+      destination32[word + 3u] = w3;
+      destination32[word + 4u] = w4;
+      destination32[word + 5u] = w5;
+      destination32[word + 6u] = w6;
+      destination32[word + 7u] = w7;
+      word += 8u;
     }
-    Uint8_t * destination8 = (Uint8_t *)&destination32[index];
-    const Uint8_t * source8 = (const Uint8_t *)&source32[index];
-    /* Copy any remaining bytes */
-    for (index = 0; index < (length % 4u); index++)
+
+    /* Copy remaining words */
+    while (word < words)
     {
-      destination8[index] = source8[index];
+      destination32[word] = source32[word];
+      word++;
     }
+
+    index += words * 4u;
+  }
+  ELSE_DO_NOTHING
+
+  /* Copy any remaining bytes */
+  Uint8_t * destination8 = &pDestination[index];
+  const Uint8_t * source8 = &pSource[index];
+  Uint32_t remaining = length - index;
+  while (remaining > 0u)
+  {
+    *destination8 = *source8;
+    destination8++;
+    source8++;
+    remaining--;
   }
   
   return;
@@ -78,7 +116,8 @@ const Uint32_t length             /**< [in]  Number of bytes to copy */
 /*********************************************************************//**
   <!-- d_GEN_MemorySet -->
 
-  Set memory to a specific value.
+  Set memory to a specific value. Bytes are set up to a word boundary and
+  the bulk is stored a word at a time in blocks of eight words.
 *************************************************************************/
 void                              /** \return None */
 d_GEN_MemorySet
@@ -88,11 +127,54 @@ const Uint8_t value,              /**< [in]  Value to set */
 const Uint32_t length             /**< [in]  Number of bytes to set */
 )
 {
-  Uint32_t index;
+  Uint32_t index = 0u;
+
+  if (length >= 16u)
+  {
+    /* Set bytes up to the first word boundary */
+// cppcheck-suppress misra-c2012-11.4;  Conversion required by non portable low level software. Violation of 'Advisory' rule does not present a risk.
+    while (((Pointer_t)&pDestination[index] % 4u) != 0u)
+    {
+      pDestination[index] = value;
+      index++;
+    }
+
+// cppcheck-suppress misra-c2012-11.3;  The pointer is word aligned at this point. Violation of 'Advisory' rule does not present a risk.
+    Uint32_t * destination32 = (Uint32_t *)&pDestination[index];
+    const Uint32_t pattern = (Uint32_t)value * 0x01010101u;
+    Uint32_t words = (length - index) / 4u;
+    Uint32_t word = 0u;
+
+    /* Set blocks of eight words */
+    while ((words - word) >= 8u)
+    {
+      destination32[word] = pattern;
+      destination32[word + 1u] = pattern;
+      destination32[word + 2u] = pattern;
+      destination32[word + 3u] = pattern;
+      destination32[word + 4u] = pattern;
+      destination32[word + 5u] = pattern;
+      destination32[word + 6u] = pattern;
+      destination32[word + 7u] = pattern;
+      word += 8u;
+    }
+
+    /* Set remaining words */
+    while (word < words)
+    {
+      destination32[word] = pattern;
+      word++;
+    }
+
+    index += words * 4u;
+  }
+  ELSE_DO_NOTHING
 
-  for (index = 0; index < length; index++)
+  /* Set any remaining bytes */
+  while (index < length)
   {
     pDestination[index] = value;
+    index++;
   }
 
   return;
@@ -101,7 +183,9 @@ const Uint32_t length             /**< [in]  Number of bytes to set */
 /*********************************************************************//**
   <!-- d_GEN_MemoryCompare -->
 
-  Compare two blocks of memory.
+  Compare two blocks of memory. When both blocks have the same alignment
+  within a word, bytes are compared up to a word boundary and the bulk is
+  compared in blocks of eight words, stopping at the first difference.
 *************************************************************************/
 Bool_t                            /** \return Equal True or False */
 d_GEN_MemoryCompare
@@ -113,6 +197,61 @@ const Uint32_t length             /**< [in] Number of bytes to compare */
 {
   Bool_t equal = d_TRUE;
   Uint32_t index = 0;
+
+// cppcheck-suppress misra-c2012-11.4;  Conversion required by non portable low level software. Violation of 'Advisory' rule does not present a risk.
+  if ((length >= 16u) && ((((Pointer_t)pSource_1 ^ (Pointer_t)pSource_2) % 4u) == 0u))
+  {
+    /* Compare bytes up to the first word boundary */
+// cppcheck-suppress misra-c2012-11.4;  Conversion required by non portable low level software. Violation of 'Advisory' rule does not present a risk.
+    while ((((Pointer_t)&pSource_1[index] % 4u) != 0u) && (equal == d_TRUE))
+    {
+      if (pSource_1[index] != pSource_2[index])
+      {
+        equal = d_FALSE;
+      }
+      index++;
+    }
+
+// cppcheck-suppress misra-c2012-11.3;  Both pointers are word aligned at this point. Violation of 'Advisory' rule does not present a risk.
+    const Uint32_t * source32_1 = (const Uint32_t *)&pSource_1[index];
+// cppcheck-suppress misra-c2012-11.3;  Both pointers are word aligned at this point. Violation of 'Advisory' rule does not present a risk.
+    const Uint32_t * source32_2 = (const Uint32_t *)&pSource_2[index];
+    Uint32_t words = (length - index) / 4u;
+    Uint32_t word = 0u;
+
+    /* Compare blocks of eight words, accumulating the differences of each block */
+    while (((words - word) >= 8u) && (equal == d_TRUE))
+    {
+      Uint32_t difference = (source32_1[word] ^ source32_2[word]) |
+                            (source32_1[word + 1u] ^ source32_2[word + 1u]) |
+                            (source32_1[word + 2u] ^ source32_2[word + 2u]) |
+                            (source32_1[word + 3u] ^ source32_2[word + 3u]) |
+                            (source32_1[word + 4u] ^ source32_2[word + 4u]) |
+                            (source32_1[word + 5u] ^ source32_2[word + 5u]) |
+                            (source32_1[word + 6u] ^ source32_2[word + 6u]) |
+                            (source32_1[word + 7u] ^ source32_2[word + 7u]);
+      if (difference != 0u)
+      {
+        equal = d_FALSE;
+      }
+      word += 8u;
+    }
+
+    /* Compare remaining words */
+    while ((word < words) && (equal == d_TRUE))
+    {
+      if (source32_1[word] != source32_2[word])
+      {
+        equal = d_FALSE;
+      }
+      word++;
+    }
+
+    index += words * 4u;
+  }
+  ELSE_DO_NOTHING
+
+  /* Compare any remaining bytes */
   while ((index < length) && (equal == d_TRUE))
   {
     if (pSource_1[index] != pSource_2[index])
@@ -124,4 +263,3 @@ const Uint32_t length             /**< [in] Number of bytes to compare */
   
   return equal;
 }  
-
@@ -37,10 +37,16 @@ d_Status_t d_RAM_CodeCrc(Uint32_t * const pCrc);
 /* Cyclic code CRC processing */
 void d_RAM_CodeCrcCyclic(void);
 
+/* Code CRC processing of one background quantum */
+Bool_t d_RAM_CodeCrcBackground(void);
+
 /* Initialise the stack usage calculation process */
 void d_RAM_StackInitialise(void);
 
 /* Cyclic stack processing */
 void d_RAM_StackCyclic(void);
 
+/* Stack processing of one background quantum */
+Bool_t d_RAM_StackBackground(void);
+
 #endif /* D_RAM_H */
@@ -27,6 +27,10 @@ extern const Uint32_t d_RAM_CyclicExecutionTime;
 extern const Uint32_t d_RAM_CodeCheckTime;
 extern const Uint32_t d_RAM_StackCheckTime;
 
+/* Words processed per background quantum */
+extern const Uint32_t d_RAM_BackgroundCodeWords;
+extern const Uint32_t d_RAM_BackgroundStackWords;
+
 /***** Type Definitions *************************************************/
 
 /***** Variables ********************************************************/
@@ -50,6 +50,8 @@ static Uint32_t currentCrc;
 
 /***** Function Declarations ********************************************/
 
+static Bool_t codeCrcProcess(const Uint32_t iterations);
+
 /***** Function Definitions *********************************************/
 
 /*********************************************************************//**
@@ -125,8 +127,6 @@ d_RAM_CodeCrcCyclic
 void
 )
 {
-  Uint32_t iteration = 0;
-
   /* Ensure the CSC has been initialised */
   if (initialised != d_TRUE)
   {
@@ -134,38 +134,32 @@ void
     // cppcheck-suppress misra-c2012-15.5; Coding standard allows function to return if parameters are invalid
     return;
   }
-  
-  while ((iteration < iterations_per_invocation) &&
-         (pCurrent < pEnd))
-  {
-    d_CRC32_Add(&currentCrc, pCurrent, sizeof (Uint32_t));
 
-    // cppcheck-suppress misra-c2012-18.4;  Operation to move pointer by one word. Violation of 'Advisory' rule does not present a risk.
-    pCurrent = pCurrent + sizeof(Uint32_t);
-    iteration++;
-  }
+  (void)codeCrcProcess(iterations_per_invocation);
 
-  if (pCurrent >= pEnd)
+  return;
+}
+
+/*********************************************************************//**
+  <!-- d_RAM_CodeCrcBackground -->
+
+  Code CRC processing of one background quantum.
+*************************************************************************/
+Bool_t                                      /** \return d_TRUE if the current pass is incomplete */
+d_RAM_CodeCrcBackground
+(
+void
+)
+{
+  /* Ensure the CSC has been initialised */
+  if (initialised != d_TRUE)
   {
-    if (currentCrc != ~expectedCrc)
-    {
-      // gcov-jst 2 It is not practical to generate this failure during bench testing.
-      d_ERROR_Logger(d_STATUS_BIT_FAILURE, d_ERROR_CRITICALITY_CRITICAL_SHUTDOWN, 0, 0, 0, 0);
-      crcState = d_RAM_CRC_FAIL;
-    }
-    else if (crcState != d_RAM_CRC_FAIL)
-    {
-      crcState = d_RAM_CRC_PASS;
-    }
-    else
-    {
-      /* Failed state remains */
-    }
-    pCurrent = pStart;
-    currentCrc = 0xFFFFFFFFu;
+    d_ERROR_Logger(d_STATUS_NOT_INITIALISED, d_ERROR_CRITICALITY_CRITICAL_SHUTDOWN, 0, 0, 0, 0);
+    // cppcheck-suppress misra-c2012-15.5; Coding standard allows function to return if parameters are invalid
+    return d_FALSE;
   }
 
-  return;
+  return codeCrcProcess(d_RAM_BackgroundCodeWords);
 }
 
 /*********************************************************************//**
@@ -200,3 +194,52 @@ d_RAM_CodeCrcState_t * const pCodeCrcState  /**< [out] Pointer to storage status
 
   return status;
 }
+
+/*********************************************************************//**
+  <!-- codeCrcProcess -->
+
+  Add a number of code words to the CRC and check the result at the end
+  of each pass.
+*************************************************************************/
+static Bool_t                               /** \return d_TRUE if the current pass is incomplete */
+codeCrcProcess
+(
+const Uint32_t iterations                   /**< [in] Number of words to process */
+)
+{
+  Uint32_t iteration = 0;
+  Bool_t incomplete = d_TRUE;
+
+  while ((iteration < iterations) &&
+         (pCurrent < pEnd))
+  {
+    d_CRC32_Add(&currentCrc, pCurrent, sizeof (Uint32_t));
+
+    // cppcheck-suppress misra-c2012-18.4;  Operation to move pointer by one word. Violation of 'Advisory' rule does not present a risk.
+    pCurrent = pCurrent + sizeof(Uint32_t);
+    iteration++;
+  }
+
+  if (pCurrent >= pEnd)
+  {
+    if (currentCrc != ~expectedCrc)
+    {
+      // gcov-jst 2 It is not practical to generate this failure during bench testing.
+      d_ERROR_Logger(d_STATUS_BIT_FAILURE, d_ERROR_CRITICALITY_CRITICAL_SHUTDOWN, 0, 0, 0, 0);
+      crcState = d_RAM_CRC_FAIL;
+    }
+    else if (crcState != d_RAM_CRC_FAIL)
+    {
+      crcState = d_RAM_CRC_PASS;
+    }
+    else
+    {
+      /* Failed state remains */
+    }
+    pCurrent = pStart;
+    currentCrc = 0xFFFFFFFFu;
+    incomplete = d_FALSE;
+  }
+
+  return incomplete;
+}
@@ -65,7 +65,7 @@ static Uint32_t iterations_per_invocation;
 /***** Function Declarations ********************************************/
 
 static void stackFill(Uint32_t * const pStart, const Uint32_t length, const Uint32_t startValue);
-static void stackCheck(const stackId_t stackId);
+static Bool_t stackCheck(const stackId_t stackId, const Uint32_t iterations);
 
 /***** Function Definitions *********************************************/
 
@@ -164,13 +164,55 @@ void
     return;
   }
 
-  stackCheck(STACK_MAIN);
-  stackCheck(STACK_IRQ);
-  stackCheck(STACK_SUPERVISOR);
+  (void)stackCheck(STACK_MAIN, iterations_per_invocation);
+  (void)stackCheck(STACK_IRQ, iterations_per_invocation);
+  (void)stackCheck(STACK_SUPERVISOR, iterations_per_invocation);
 
   return;
 }
 
+/*********************************************************************//**
+  <!-- d_RAM_StackBackground -->
+
+  Stack processing of one background quantum.
+*************************************************************************/
+Bool_t                                          /** \return d_TRUE if any stack scan is incomplete */
+d_RAM_StackBackground
+(
+void
+)
+{
+  Bool_t incomplete = d_FALSE;
+
+  /* Ensure the CSC has been initialised */
+  if (initialised != d_TRUE)
+  {
+    d_ERROR_Logger(d_STATUS_NOT_INITIALISED, d_ERROR_CRITICALITY_UNKNOWN, 0, 0, 0, 0);
+    // cppcheck-suppress misra-c2012-15.5; Coding standard allows function to return if parameters are invalid
+    return d_FALSE;
+  }
+
+  if (stackCheck(STACK_MAIN, d_RAM_BackgroundStackWords) == d_TRUE)
+  {
+    incomplete = d_TRUE;
+  }
+  ELSE_DO_NOTHING
+
+  if (stackCheck(STACK_IRQ, d_RAM_BackgroundStackWords) == d_TRUE)
+  {
+    incomplete = d_TRUE;
+  }
+  ELSE_DO_NOTHING
+
+  if (stackCheck(STACK_SUPERVISOR, d_RAM_BackgroundStackWords) == d_TRUE)
+  {
+    incomplete = d_TRUE;
+  }
+  ELSE_DO_NOTHING
+
+  return incomplete;
+}
+
 /*********************************************************************//**
   <!-- d_RAM_StackUsage -->
 
@@ -261,17 +303,18 @@ const Uint32_t startValue                   /**< [in] Pointer to storage for CRC
 
   Perform cyclic stack processing on specified stack.
 *************************************************************************/
-static void                                 /** \return None */
+static Bool_t                               /** \return d_TRUE if the scan is incomplete */
 stackCheck
 (
-const stackId_t stackId                     /**< [in] Stack identifier */
+const stackId_t stackId,                    /**< [in] Stack identifier */
+const Uint32_t iterations                   /**< [in] Number of words to check */
 )
 {
   Uint32_t iteration = 0;
   Bool_t done = d_FALSE;
   Uint32_t value = stackStatus[stackId].startUint + (stackStatus[stackId].scanIndex * sizeof(Uint32_t));
 
-  while ((iteration < iterations_per_invocation) &&
+  while ((iteration < iterations) &&
          (stackStatus[stackId].scanIndex < stackStatus[stackId].wordCount) &&
          (done == d_FALSE))
   {
@@ -307,12 +350,13 @@ const stackId_t stackId                     /**< [in] Stack identifier */
     // gcov-jst 2 It is not practical to generate this failure during bench testing.
     stackStatus[stackId].used = 0u;
     stackStatus[stackId].scanIndex = 0;
+    done = d_TRUE;
   }
   else
   {
     DO_NOTHING();
   }
   
-  return;
+  return (done == d_TRUE) ? d_FALSE : d_TRUE;
 }
 
@@ -30,6 +30,12 @@ __attribute__((weak)) const Uint32_t d_RAM_CodeCheckTime = 60000;
 /* Time in which the stack usage check must be completed */
 __attribute__((weak)) const Uint32_t d_RAM_StackCheckTime = 10000;
 
+/* Number of code words added to the CRC in one background quantum */
+__attribute__((weak)) const Uint32_t d_RAM_BackgroundCodeWords = 1024;
+
+/* Number of words checked per stack in one background quantum */
+__attribute__((weak)) const Uint32_t d_RAM_BackgroundStackWords = 256;
+
 /***** Type Definitions *************************************************/
 
 /***** Variables ********************************************************/
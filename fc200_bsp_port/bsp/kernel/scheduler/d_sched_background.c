@@ -0,0 +1,420 @@
+/*********************************************************************//**
+\file
+\brief
+  Module Title       : Background dispatcher
+
+  Abstract           : Slack-aware dispatcher for background jobs.
+                       The time remaining to the next tick is measured
+                       and the configured jobs are executed, in priority
+                       order, in bounded quanta until only the guard band
+                       remains. Progress and starvation are recorded per
+                       job so that background coverage rates follow the
+                       actual processor load.
+
+  Software Structure : SRS References: 136T-2200-131000-001-D22 SWREQ-74
+                                                                SWREQ-75
+                       SDD References: 136T-2200-131000-001-D22 SWDES-557
+\note
+  CSC ID             : SWDES-79
+*************************************************************************/
+
+/***** Includes *********************************************************/
+
+#include "soc/defines/d_common_types.h"
+#include "soc/defines/d_common_status.h"
+
+#include "kernel/error_handler/d_error_handler.h"
+#include "soc/timer/d_timer.h"
+#include "soc/interrupt_manager/d_int_critical.h"
+#include "kernel/scheduler/d_sched_background_cfg.h"
+#include "kernel/scheduler/d_sched_background.h"
+
+/***** Constants ********************************************************/
+
+/***** Type Definitions *************************************************/
+
+/***** Variables ********************************************************/
+
+static Bool_t initialised = d_FALSE;
+
+/* Frame period in microseconds */
+static Uint32_t framePeriod;
+
+/* Updated by the tick interrupt */
+static volatile Uint32_t frameStartTime;
+static volatile Uint32_t frameCounter;
+
+/* Frame of the foreground work of the main loop and its start time */
+static Uint32_t loopFrame;
+static Uint32_t loopStartTime;
+
+/* Last frame in which the jobs were dispatched */
+static Uint32_t frameDispatched;
+
+static d_SCHED_BackgroundStats_t jobStats[MAX_BACKGROUND_JOBS];
+
+/* Work reported pending by the last quantum of each job */
+static Bool_t jobPending[MAX_BACKGROUND_JOBS];
+
+static d_SCHED_BackgroundSlack_t slackStats;
+
+/***** Function Declarations ********************************************/
+
+static Uint32_t slackRemaining(const Uint32_t start);
+
+static void jobDispatch(const Uint32_t index, const Uint32_t start, const Uint32_t frameSlack);
+
+/***** Function Definitions *********************************************/
+
+/*********************************************************************//**
+  <!-- d_SCHED_BackgroundInitialise -->
+
+  Check the configuration data and initialise the local data.
+*************************************************************************/
+d_Status_t                    /** \return SUCCESS or FAILURE */
+d_SCHED_BackgroundInitialise
+(
+const Uint32_t period         /**< [in] Frame period in microseconds */
+)
+{
+  d_Status_t retval;
+  Uint32_t index;
+
+  retval = d_STATUS_SUCCESS;
+
+  if (d_SCHED_BACKGROUND_JOB_COUNT > MAX_BACKGROUND_JOBS)
+  {
+    // gcov-jst 2 It is not practical to generate this error during bench testing.
+    d_ERROR_Logger(d_STATUS_INVALID_CONFIGURATION, d_ERROR_CRITICALITY_CRITICAL_SHUTDOWN, 0, d_SCHED_BACKGROUND_JOB_COUNT, 0, 0);
+    retval = d_STATUS_INVALID_CONFIGURATION;
+  }
+  else if (period <= d_SCHED_BackgroundGuardBand)
+  {
+    d_ERROR_Logger(d_STATUS_INVALID_PARAMETER, d_ERROR_CRITICALITY_CRITICAL_SHUTDOWN, 1, period, 0, 0);
+    retval = d_STATUS_INVALID_PARAMETER;
+  }
+  else
+  {
+    DO_NOTHING();
+  }
+
+  index = 0u;
+  while ((retval == d_STATUS_SUCCESS) && (index < d_SCHED_BACKGROUND_JOB_COUNT))
+  {
+    if (d_SCHED_BackgroundJobs[index].job == NULL)
+    {
+      // gcov-jst 2 It is not practical to generate this error during bench testing.
+      d_ERROR_Logger(d_STATUS_BAD_DATA, d_ERROR_CRITICALITY_CRITICAL_SHUTDOWN, 2, index, 0, 0);
+      retval = d_STATUS_BAD_DATA;
+    }
+    ELSE_DO_NOTHING
+
+    jobStats[index].quanta = 0u;
+    jobStats[index].cycles = 0u;
+    jobStats[index].starvedFrames = 0u;
+    jobStats[index].consecutiveStarved = 0u;
+    jobStats[index].maxConsecutiveStarved = 0u;
+    jobStats[index].maxQuantumTime = 0u;
+    jobStats[index].longQuanta = 0u;
+    jobPending[index] = d_TRUE;
+
+    index++;
+  }
+
+  if (retval == d_STATUS_SUCCESS)
+  {
+    framePeriod = period;
+    frameStartTime = d_TIMER_ReadValueInTicks();
+    frameCounter = 0u;
+    loopFrame = 0u;
+    loopStartTime = frameStartTime;
+    frameDispatched = 0u;
+
+    slackStats.frames = 0u;
+    slackStats.overrunFrames = 0u;
+    slackStats.lastSlack = 0u;
+    slackStats.minSlack = period;
+
+    initialised = d_TRUE;
+  }
+  ELSE_DO_NOTHING
+
+  return retval;
+}
+
+/*********************************************************************//**
+  <!-- d_SCHED_BackgroundFrameStart -->
+
+  Mark the start of a frame, called from the tick interrupt.
+*************************************************************************/
+void         /** \return None */
+d_SCHED_BackgroundFrameStart
+(
+void
+)
+{
+  frameStartTime = d_TIMER_ReadValueInTicks();
+  frameCounter++;
+
+  return;
+}
+
+/*********************************************************************//**
+  <!-- d_SCHED_BackgroundLoopStart -->
+
+  Record the frame of the foreground work, called by the main loop when it
+  starts the work of a frame.
+*************************************************************************/
+void         /** \return None */
+d_SCHED_BackgroundLoopStart
+(
+void
+)
+{
+  Uint32_t interruptFlags = d_INT_CriticalSectionEnter();
+  loopStartTime = frameStartTime;
+  loopFrame = frameCounter;
+  d_INT_CriticalSectionLeave(interruptFlags);
+
+  return;
+}
+
+/*********************************************************************//**
+  <!-- d_SCHED_BackgroundRun -->
+
+  Run background jobs in the slack remaining before the next tick.
+  Jobs are executed at most once per frame. The slack is that of the frame
+  recorded by d_SCHED_BackgroundLoopStart, so no job is run when the
+  foreground work has overrun into the next frame.
+*************************************************************************/
+void         /** \return None */
+d_SCHED_BackgroundRun
+(
+void
+)
+{
+  Uint32_t index;
+  Uint32_t frame;
+  Uint32_t slack;
+
+  /* Ensure the CSC has been initialised */
+  if (initialised != d_TRUE)
+  {
+    d_ERROR_Logger(d_STATUS_NOT_INITIALISED, d_ERROR_CRITICALITY_UNKNOWN, 0, 0, 0, 0);
+    // cppcheck-suppress misra-c2012-15.5; Coding standard allows function to return if parameters are invalid
+    return;
+  }
+
+  Uint32_t interruptFlags = d_INT_CriticalSectionEnter();
+  frame = frameCounter;
+  d_INT_CriticalSectionLeave(interruptFlags);
+
+  if (loopFrame != frameDispatched)
+  {
+    /* Frames skipped by the main loop have had no slack */
+    slackStats.overrunFrames += (loopFrame - frameDispatched) - 1u;
+    slackStats.frames += loopFrame - frameDispatched;
+    frameDispatched = loopFrame;
+
+    if (frame == loopFrame)
+    {
+      slack = slackRemaining(loopStartTime);
+    }
+    else
+    {
+      /* The next tick has already occurred */
+      slack = 0u;
+    }
+    slackStats.lastSlack = slack;
+    if (slack < slackStats.minSlack)
+    {
+      slackStats.minSlack = slack;
+    }
+    ELSE_DO_NOTHING
+
+    if (slack <= d_SCHED_BackgroundGuardBand)
+    {
+      slackStats.overrunFrames++;
+    }
+    ELSE_DO_NOTHING
+
+    for (index = 0u; index < d_SCHED_BACKGROUND_JOB_COUNT; index++)
+    {
+      jobDispatch(index, loopStartTime, slack);
+    }
+  }
+  ELSE_DO_NOTHING
+
+  return;
+}
+
+/*********************************************************************//**
+  <!-- d_SCHED_BackgroundGetStats -->
+
+  Get the statistics of a background job.
+*************************************************************************/
+d_Status_t                                  /** \return Success or Failure */
+d_SCHED_BackgroundGetStats
+(
+const Uint32_t job,                         /**< [in] Job number, in configuration table order */
+d_SCHED_BackgroundStats_t * const pStats    /**< [out] Pointer to storage for the statistics */
+)
+{
+  /* Ensure the CSC has been initialised */
+  if (initialised != d_TRUE)
+  {
+    d_ERROR_Logger(d_STATUS_NOT_INITIALISED, d_ERROR_CRITICALITY_UNKNOWN, 0, 0, 0, 0);
+    // cppcheck-suppress misra-c2012-15.5; Coding standard allows function to return if parameters are invalid
+    return d_STATUS_NOT_INITIALISED;
+  }
+
+  /* Parameter check */
+  if (job >= d_SCHED_BACKGROUND_JOB_COUNT)
+  {
+    d_ERROR_Logger(d_STATUS_INVALID_PARAMETER, d_ERROR_CRITICALITY_UNKNOWN, 1, job, 0, 0);
+    // cppcheck-suppress misra-c2012-15.5; Coding standard allows function to return if parameters are invalid
+    return d_STATUS_INVALID_PARAMETER;
+  }
+
+  if (pStats == NULL)
+  {
+    d_ERROR_Logger(d_STATUS_INVALID_PARAMETER, d_ERROR_CRITICALITY_UNKNOWN, 2, 0, 0, 0);
+    // cppcheck-suppress misra-c2012-15.5; Coding standard allows function to return if parameters are invalid
+    return d_STATUS_INVALID_PARAMETER;
+  }
+
+  *pStats = jobStats[job];
+
+  return d_STATUS_SUCCESS;
+}
+
+/*********************************************************************//**
+  <!-- d_SCHED_BackgroundGetSlack -->
+
+  Get the slack statistics of the dispatcher.
+*************************************************************************/
+d_Status_t                                  /** \return Success or Failure */
+d_SCHED_BackgroundGetSlack
+(
+d_SCHED_BackgroundSlack_t * const pSlack    /**< [out] Pointer to storage for the statistics */
+)
+{
+  /* Ensure the CSC has been initialised */
+  if (initialised != d_TRUE)
+  {
+    d_ERROR_Logger(d_STATUS_NOT_INITIALISED, d_ERROR_CRITICALITY_UNKNOWN, 0, 0, 0, 0);
+    // cppcheck-suppress misra-c2012-15.5; Coding standard allows function to return if parameters are invalid
+    return d_STATUS_NOT_INITIALISED;
+  }
+
+  /* Parameter check */
+  if (pSlack == NULL)
+  {
+    d_ERROR_Logger(d_STATUS_INVALID_PARAMETER, d_ERROR_CRITICALITY_UNKNOWN, 1, 0, 0, 0);
+    // cppcheck-suppress misra-c2012-15.5; Coding standard allows function to return if parameters are invalid
+    return d_STATUS_INVALID_PARAMETER;
+  }
+
+  *pSlack = slackStats;
+
+  return d_STATUS_SUCCESS;
+}
+
+/*********************************************************************//**
+  <!-- slackRemaining -->
+
+  Time remaining to the next tick.
+*************************************************************************/
+static Uint32_t               /** \return Remaining time in microseconds */
+slackRemaining
+(
+const Uint32_t start          /**< [in] Timer value at the start of the frame */
+)
+{
+  Uint32_t remaining = 0u;
+  Uint32_t elapsed = d_TIMER_ElapsedMicroseconds(start, NULL);
+
+  if (elapsed < framePeriod)
+  {
+    remaining = framePeriod - elapsed;
+  }
+  ELSE_DO_NOTHING
+
+  return remaining;
+}
+
+/*********************************************************************//**
+  <!-- jobDispatch -->
+
+  Execute quanta of a job while slack remains beyond the guard band. A
+  job is counted as starved only if its last quantum reported work pending.
+*************************************************************************/
+static void                   /** \return None */
+jobDispatch
+(
+const Uint32_t index,         /**< [in] Job number */
+const Uint32_t start,         /**< [in] Timer value at the start of the frame */
+const Uint32_t frameSlack     /**< [in] Slack of the frame at entry, zero after an overrun */
+)
+{
+  const d_SCHED_BackgroundJob_t * pJob = &d_SCHED_BackgroundJobs[index];
+  d_SCHED_BackgroundStats_t * pStats = &jobStats[index];
+  Uint32_t quanta = 0u;
+  Bool_t more = d_TRUE;
+  Bool_t starved = d_FALSE;
+
+  while ((more == d_TRUE) && (starved == d_FALSE) &&
+         ((pJob->maxQuantaPerFrame == 0u) || (quanta < pJob->maxQuantaPerFrame)))
+  {
+    /* The configured quantum time is the estimate, a quantum lengthened by
+       an interrupt must not keep the job from running in later frames */
+    if ((frameSlack == 0u) || (slackRemaining(start) < (d_SCHED_BackgroundGuardBand + pJob->quantumTime)))
+    {
+      starved = d_TRUE;
+    }
+    else
+    {
+      Uint32_t quantumStart = d_TIMER_ReadValueInTicks();
+      more = pJob->job();
+      Uint32_t quantumTime = d_TIMER_ElapsedMicroseconds(quantumStart, NULL);
+
+      if (quantumTime > pStats->maxQuantumTime)
+      {
+        pStats->maxQuantumTime = quantumTime;
+      }
+      ELSE_DO_NOTHING
+
+      if (quantumTime > pJob->quantumTime)
+      {
+        pStats->longQuanta++;
+      }
+      ELSE_DO_NOTHING
+
+      pStats->quanta++;
+      quanta++;
+      jobPending[index] = more;
+      if (more == d_FALSE)
+      {
+        pStats->cycles++;
+      }
+      ELSE_DO_NOTHING
+    }
+  }
+
+  if ((starved == d_TRUE) && (jobPending[index] == d_TRUE))
+  {
+    pStats->starvedFrames++;
+    pStats->consecutiveStarved++;
+    if (pStats->consecutiveStarved > pStats->maxConsecutiveStarved)
+    {
+      pStats->maxConsecutiveStarved = pStats->consecutiveStarved;
+    }
+    ELSE_DO_NOTHING
+  }
+  else
+  {
+    pStats->consecutiveStarved = 0u;
+  }
+
+  return;
+}
@@ -0,0 +1,72 @@
+/*********************************************************************//**
+\file
+\brief
+  Module Title       : Background dispatcher
+
+  Abstract           : Slack-aware dispatcher for background jobs.
+
+  Software Structure : SRS References: 136T-2200-131000-001-D22 SWREQ-74
+                                                                SWREQ-75
+                       SDD References: 136T-2200-131000-001-D22 SWDES-557
+\note
+  CSC ID             : SWDES-79
+*************************************************************************/
+
+#ifndef D_SCHED_BACKGROUND_H
+#define D_SCHED_BACKGROUND_H
+
+/***** Includes *********************************************************/
+
+#include "soc/defines/d_common_types.h"
+#include "soc/defines/d_common_status.h"
+
+/***** Constants ********************************************************/
+
+#define MAX_BACKGROUND_JOBS    (Uint32_t)12
+
+/***** Type Definitions *************************************************/
+
+/* Progress and starvation statistics of a background job */
+typedef struct
+{
+  Uint32_t quanta;                 /* Total number of quanta executed */
+  Uint32_t cycles;                 /* Number of times the job reported all work complete */
+  Uint32_t starvedFrames;          /* Frames ended with work pending but insufficient slack, idle jobs are not counted */
+  Uint32_t consecutiveStarved;     /* Current run of starved frames */
+  Uint32_t maxConsecutiveStarved;  /* Longest run of starved frames */
+  Uint32_t maxQuantumTime;         /* Longest measured quantum in microseconds, a statistic only */
+  Uint32_t longQuanta;             /* Quanta that took longer than the configured quantum time */
+} d_SCHED_BackgroundStats_t;
+
+/* Slack statistics of the dispatcher */
+typedef struct
+{
+  Uint32_t frames;                 /* Number of frames dispatched */
+  Uint32_t overrunFrames;          /* Frames with no slack left when the dispatcher was entered, or skipped by the main loop */
+  Uint32_t lastSlack;              /* Slack available at entry of the last frame in microseconds */
+  Uint32_t minSlack;               /* Smallest slack available at entry in microseconds */
+} d_SCHED_BackgroundSlack_t;
+
+/***** Variables ********************************************************/
+
+/***** Function Declarations ********************************************/
+
+/* Check the configuration data and initialise the local data */
+d_Status_t d_SCHED_BackgroundInitialise(const Uint32_t framePeriod);
+
+/* Mark the start of a frame, called from the tick interrupt */
+void d_SCHED_BackgroundFrameStart(void);
+
+/* Record the frame of the foreground work, called when the main loop starts the work of a frame */
+void d_SCHED_BackgroundLoopStart(void);
+
+/* Run background jobs in the slack remaining before the next tick */
+void d_SCHED_BackgroundRun(void);
+
+/* Get the statistics of a background job */
+d_Status_t d_SCHED_BackgroundGetStats(const Uint32_t job, d_SCHED_BackgroundStats_t * const pStats);
+
+/* Get the slack statistics of the dispatcher */
+d_Status_t d_SCHED_BackgroundGetSlack(d_SCHED_BackgroundSlack_t * const pSlack);
+
+#endif /* D_SCHED_BACKGROUND_H */
@@ -0,0 +1,49 @@
+/*********************************************************************//**
+\file
+\brief
+  Module Title       : Background dispatcher configuration
+
+  Abstract           : Slack-aware dispatcher for background jobs.
+
+  Software Structure : SRS References: 136T-2200-131000-001-D22 SWREQ-74
+                                                                SWREQ-75
+                       SDD References: 136T-2200-131000-001-D22 SWDES-557
+\note
+  CSC ID             : SWDES-79
+*************************************************************************/
+
+#ifndef D_SCHED_BACKGROUND_CFG_H
+#define D_SCHED_BACKGROUND_CFG_H
+
+/***** Includes *********************************************************/
+
+#include "soc/defines/d_common_types.h"
+#include "soc/defines/d_common_status.h"
+
+/***** Constants ********************************************************/
+
+/* Time in microseconds before the next tick in which no background job is started */
+extern const Uint32_t d_SCHED_BackgroundGuardBand;
+
+/* Define the number of background jobs, supplied by the application */
+extern const Uint32_t d_SCHED_BACKGROUND_JOB_COUNT;
+
+/***** Type Definitions *************************************************/
+
+/* Background job definition structure, jobs are listed in priority order */
+typedef struct
+{
+  Bool_t (*job)(void);          /* Job function, performs one quantum and returns d_TRUE if more work remains */
+  Uint32_t quantumTime;         /* Worst case execution time of one quantum in microseconds */
+  Uint32_t maxQuantaPerFrame;   /* Maximum quanta executed per frame, 0 for no limit */
+} d_SCHED_BackgroundJob_t;
+
+/***** Variables ********************************************************/
+
+/* This constant needs to be declared after the type definition above */
+// cppcheck-suppress misra-c2012-8.11; Array size is defined by the configuration data of this driver. Violation of the 'Advisory' rule does not present a risk
+extern const d_SCHED_BackgroundJob_t d_SCHED_BackgroundJobs[];
+
+/***** Function Declarations ********************************************/
+
+#endif /* D_SCHED_BACKGROUND_CFG_H */
@@ -20,37 +20,140 @@
 #include "soc/defines/d_common_types.h"
 #include "soc/defines/d_common_status.h"
 #include "kernel/general/d_gen_memory.h"
+#include "kernel/error_handler/d_error_handler.h"
 #include "d_sha256.h"
 
 /***** Constants ********************************************************/
 
 #define TOTAL_LEN_LEN 8u
 
+/* Round functions of FIPS 180-4 section 4.1.2 */
+#define SHA_CH(x, y, z)   ((z) ^ ((x) & ((y) ^ (z))))
+#define SHA_MAJ(x, y, z)  (((x) & (y)) | ((z) & ((x) | (y))))
+#define SHA_BSIG0(x)      (rotateRight((x), 2u) ^ rotateRight((x), 13u) ^ rotateRight((x), 22u))
+#define SHA_BSIG1(x)      (rotateRight((x), 6u) ^ rotateRight((x), 11u) ^ rotateRight((x), 25u))
+#define SHA_SSIG0(x)      (rotateRight((x), 7u) ^ rotateRight((x), 18u) ^ ((x) >> 3u))
+#define SHA_SSIG1(x)      (rotateRight((x), 17u) ^ rotateRight((x), 19u) ^ ((x) >> 10u))
+
+/* Extend the message schedule, held as a window of 16 words, to round r */
+#define SHA_SCHEDULE(r)   (w[(r) & 15u] += SHA_SSIG1(w[((r) + 14u) & 15u]) + w[((r) + 9u) & 15u] + SHA_SSIG0(w[((r) + 1u) & 15u]))
+
+/* One round. The working variables are renamed by the caller instead of being moved. */
+#define SHA_ROUND(a, b, c, d, e, f, g, h, r)                                  \
+  do                                                                          \
+  {                                                                           \
+    Uint32_t temp1 = (h) + SHA_BSIG1(e) + SHA_CH((e), (f), (g)) + k[(r)] + w[(r) & 15u]; \
+    (d) += temp1;                                                             \
+    (h) = temp1 + SHA_BSIG0(a) + SHA_MAJ((a), (b), (c));                      \
+  } while (0)
+
+/* Eight rounds, after which the working variables are back in their original places */
+#define SHA_ROUNDS_8(r)                                                       \
+  do                                                                          \
+  {                                                                           \
+    SHA_ROUND(a, b, c, d, e, f, g, h, (r));                                   \
+    SHA_ROUND(h, a, b, c, d, e, f, g, (r) + 1u);                              \
+    SHA_ROUND(g, h, a, b, c, d, e, f, (r) + 2u);                              \
+    SHA_ROUND(f, g, h, a, b, c, d, e, (r) + 3u);                              \
+    SHA_ROUND(e, f, g, h, a, b, c, d, (r) + 4u);                              \
+    SHA_ROUND(d, e, f, g, h, a, b, c, (r) + 5u);                              \
+    SHA_ROUND(c, d, e, f, g, h, a, b, (r) + 6u);                              \
+    SHA_ROUND(b, c, d, e, f, g, h, a, (r) + 7u);                              \
+  } while (0)
+
 /***** Type Definitions *************************************************/
 
 /***** Variables ********************************************************/
 
+/* Round constants, the first 32 bits of the fractional parts of the cube roots of the first 64 primes 2..311 */
+static const Uint32_t k[64] =
+{
+  0x428a2f98u, 0x71374491u, 0xb5c0fbcfu, 0xe9b5dba5u, 0x3956c25bu, 0x59f111f1u, 0x923f82a4u, 0xab1c5ed5u,
+  0xd807aa98u, 0x12835b01u, 0x243185beu, 0x550c7dc3u, 0x72be5d74u, 0x80deb1feu, 0x9bdc06a7u, 0xc19bf174u,
+  0xe49b69c1u, 0xefbe4786u, 0x0fc19dc6u, 0x240ca1ccu, 0x2de92c6fu, 0x4a7484aau, 0x5cb0a9dcu, 0x76f988dau,
+  0x983e5152u, 0xa831c66du, 0xb00327c8u, 0xbf597fc7u, 0xc6e00bf3u, 0xd5a79147u, 0x06ca6351u, 0x14292967u,
+  0x27b70a85u, 0x2e1b2138u, 0x4d2c6dfcu, 0x53380d13u, 0x650a7354u, 0x766a0abbu, 0x81c2c92eu, 0x92722c85u,
+  0xa2bfe8a1u, 0xa81a664bu, 0xc24b8b70u, 0xc76c51a3u, 0xd192e819u, 0xd6990624u, 0xf40e3585u, 0x106aa070u,
+  0x19a4c116u, 0x1e376c08u, 0x2748774cu, 0x34b0bcb5u, 0x391c0cb3u, 0x4ed8aa4au, 0x5b9cca4fu, 0x682e6ff3u,
+  0x748f82eeu, 0x78a5636fu, 0x84c87814u, 0x8cc70208u, 0x90befffau, 0xa4506cebu, 0xbef9a3f7u, 0xc67178f2u
+};
+
+/* Known answer tests from the NIST SHA-256 examples, the second and third span two chunks */
+typedef struct
+{
+  const Char_t * pMessage;
+  Uint32_t length;
+  Uint8_t hash[SIZE_OF_SHA_256_HASH];
+} knownAnswer_t;
+
+static const knownAnswer_t knownAnswers[] =
+{
+  {
+    "abc", 3u,
+    { 0xbau, 0x78u, 0x16u, 0xbfu, 0x8fu, 0x01u, 0xcfu, 0xeau, 0x41u, 0x41u, 0x40u, 0xdeu, 0x5du, 0xaeu, 0x22u, 0x23u,
+      0xb0u, 0x03u, 0x61u, 0xa3u, 0x96u, 0x17u, 0x7au, 0x9cu, 0xb4u, 0x10u, 0xffu, 0x61u, 0xf2u, 0x00u, 0x15u, 0xadu }
+  },
+  {
+    "abcdbcdecdefdefgefghfghighijhijkijkljklmklmnlmnomnopnopq", 56u,
+    { 0x24u, 0x8du, 0x6au, 0x61u, 0xd2u, 0x06u, 0x38u, 0xb8u, 0xe5u, 0xc0u, 0x26u, 0x93u, 0x0cu, 0x3eu, 0x60u, 0x39u,
+      0xa3u, 0x3cu, 0xe4u, 0x59u, 0x64u, 0xffu, 0x21u, 0x67u, 0xf6u, 0xecu, 0xedu, 0xd4u, 0x19u, 0xdbu, 0x06u, 0xc1u }
+  },
+  {
+    "abcdefghbcdefghicdefghijdefghijkefghijklfghijklmghijklmnhijklmnoijklmnopjklmnopqklmnopqrlmnopqrsmnopqrstnopqrstu", 112u,
+    { 0xcfu, 0x5bu, 0x16u, 0xa7u, 0x78u, 0xafu, 0x83u, 0x80u, 0x03u, 0x6cu, 0xe5u, 0x9eu, 0x7bu, 0x04u, 0x92u, 0x37u,
+      0x0bu, 0x24u, 0x9bu, 0x11u, 0xe8u, 0xf0u, 0x7au, 0x51u, 0xafu, 0xacu, 0x45u, 0x03u, 0x7au, 0xfeu, 0xe9u, 0xd1u }
+  }
+};
+
+/* Background verification */
+static d_SHA256_VerifyState_t verifyState = d_SHA256_VERIFY_IDLE;
+static Sha256_t verifySha;
+static const Uint8_t * pVerifyNext;
+static Uint32_t verifyRemaining;
+static Uint8_t verifyExpected[SIZE_OF_SHA_256_HASH];
+static Uint8_t verifyHash[SIZE_OF_SHA_256_HASH];
+
 /***** Function Declarations ********************************************/
 
 static inline Uint32_t rotateRight(const Uint32_t value, const Uint32_t count);
-static inline void consumeChunk(Uint32_t * const h, const Uint8_t * const p);
+static inline Uint32_t loadBigEndian(const Uint8_t * const p, const Uint32_t index);
+static void consumeChunk(Uint32_t * const hashValue, const Uint8_t * const p);
+static Bool_t hashEqual(const Uint8_t * const pHash1, const Uint8_t * const pHash2);
 
 /***** Function Definitions *********************************************/
 
 /*********************************************************************//**
   <!-- d_SHA256_Initialise -->
 
-  Initialise the CRC32 CSC.
-  This function perfoms no processing and is included for adherence to the
-  coding standard.
+  Initialise the SHA256 CSC. The NIST known answer tests are run to check
+  the calculation.
 *************************************************************************/
-d_Status_t             /** \return result, always success */
+d_Status_t             /** \return d_STATUS_BIT_FAILURE if a known answer test fails */
 d_SHA256_Initialise
 (
 void
 )
 {
-  return d_STATUS_SUCCESS;
+  d_Status_t status = d_STATUS_SUCCESS;
+  Uint8_t hash[SIZE_OF_SHA_256_HASH];
+  Uint32_t index;
+
+  for (index = 0u; index < (sizeof(knownAnswers) / sizeof(knownAnswer_t)); index++)
+  {
+    // cppcheck-suppress misra-c2012-11.3; Conversion of the test message to bytes. Violation of 'Required' rule does not present a risk.
+    d_SHA256_Calculate(hash, (const Uint8_t *)knownAnswers[index].pMessage, knownAnswers[index].length);
+    if (hashEqual(hash, knownAnswers[index].hash) == d_FALSE)
+    {
+      // gcov-jst 2 It is not practical to generate this failure during bench testing.
+      d_ERROR_Logger(d_STATUS_BIT_FAILURE, d_ERROR_CRITICALITY_NON_CRITICAL, index, 0, 0, 0);
+      status = d_STATUS_BIT_FAILURE;
+    }
+    ELSE_DO_NOTHING
+  }
+
+  verifyState = d_SHA256_VERIFY_IDLE;
+
+  return status;
 }
 
 /*********************************************************************//**
@@ -101,44 +204,40 @@ const Uint32_t len                  /**< [in]  Length of the data to add */
 
   const Uint8_t *p = data;
   Uint32_t pindex = 0;
-  
+
   while (lenToProcess > 0u)
   {
-  /*
-     * If the input chunks have sizes that are multiples of the calculation chunk size, no copies are
-     * necessary. We operate directly on the input data instead.
-     */
     if ((sha256->spaceLeft == SIZE_OF_SHA_256_CHUNK) && (lenToProcess >= SIZE_OF_SHA_256_CHUNK))
     {
+      /*
+       * If the input chunks have sizes that are multiples of the calculation chunk size, no copies are
+       * necessary. We operate directly on the input data instead.
+       */
       consumeChunk(sha256->h, &p[pindex]);
       lenToProcess -= SIZE_OF_SHA_256_CHUNK;
       pindex = pindex + SIZE_OF_SHA_256_CHUNK;
-      continue;
     }
     else
     {
-      DO_NOTHING();
-    }
-    
-    /* General case, no particular optimisation. */
-    pindex = 0;
-    const Uint32_t consumed_len = (lenToProcess < sha256->spaceLeft) ? lenToProcess : sha256->spaceLeft;
-    d_GEN_MemoryCopy(&sha256->chunk[sha256->chunkIndex], &p[pindex], consumed_len);
-    sha256->spaceLeft -= consumed_len;
-    lenToProcess -= consumed_len;
-    pindex = pindex + consumed_len;
-    if (sha256->spaceLeft == 0u)
-    {
-      consumeChunk(sha256->h, sha256->chunk);
-      sha256->chunkIndex = 0;
-      sha256->spaceLeft = SIZE_OF_SHA_256_CHUNK;
-    }
-    else
-    {
-      sha256->chunkIndex = sha256->chunkIndex + consumed_len;
+      /* General case, the input is gathered into the chunk buffer. */
+      const Uint32_t consumed_len = (lenToProcess < sha256->spaceLeft) ? lenToProcess : sha256->spaceLeft;
+      d_GEN_MemoryCopy(&sha256->chunk[sha256->chunkIndex], &p[pindex], consumed_len);
+      sha256->spaceLeft -= consumed_len;
+      lenToProcess -= consumed_len;
+      pindex = pindex + consumed_len;
+      if (sha256->spaceLeft == 0u)
+      {
+        consumeChunk(sha256->h, sha256->chunk);
+        sha256->chunkIndex = 0;
+        sha256->spaceLeft = SIZE_OF_SHA_256_CHUNK;
+      }
+      else
+      {
+        sha256->chunkIndex = sha256->chunkIndex + consumed_len;
+      }
     }
   }
-  
+
   return;
 }
 
@@ -230,6 +329,119 @@ const Uint32_t len                   /**< [in]  Data length */
   return;
 }
 
+/*********************************************************************//**
+  <!-- d_SHA256_VerifyStart -->
+
+  Start a background verification of a block of memory against an
+  expected hash. The memory is hashed in slices by
+  d_SHA256_VerifyBackground and the result is given by
+  d_SHA256_VerifyStatus. The memory must not change until the
+  verification completes.
+*************************************************************************/
+d_Status_t                                    /** \return Function status */
+d_SHA256_VerifyStart
+(
+const Uint8_t * const pData,                  /**< [in]  Data to verify */
+const Uint32_t length,                        /**< [in]  Data length */
+const Uint8_t expected[SIZE_OF_SHA_256_HASH]  /**< [in]  Expected hash */
+)
+{
+  if ((pData == NULL) || (expected == NULL))
+  {
+    d_ERROR_Logger(d_STATUS_INVALID_PARAMETER, d_ERROR_CRITICALITY_NON_CRITICAL, 1, 0, 0, 0);
+    // cppcheck-suppress misra-c2012-15.5; Coding standard allows function to return if parameters are invalid
+    return d_STATUS_INVALID_PARAMETER;
+  }
+
+  if (verifyState == d_SHA256_VERIFY_BUSY)
+  {
+    // cppcheck-suppress misra-c2012-15.5; Coding standard allows function to return if parameters are invalid
+    return d_STATUS_DEVICE_BUSY;
+  }
+
+  d_GEN_MemoryCopy(verifyExpected, expected, SIZE_OF_SHA_256_HASH);
+  d_SHA256_Init(&verifySha, verifyHash);
+  pVerifyNext = pData;
+  verifyRemaining = length;
+  verifyState = d_SHA256_VERIFY_BUSY;
+
+  return d_STATUS_SUCCESS;
+}
+
+/*********************************************************************//**
+  <!-- d_SHA256_VerifyBackground -->
+
+  Background verification processing of one quantum. At most
+  d_SHA256_VERIFY_SLICE_BYTES are hashed, the hash is compared with the
+  expected value when all the data has been hashed.
+*************************************************************************/
+Bool_t                                        /** \return d_TRUE if the verification is incomplete */
+d_SHA256_VerifyBackground
+(
+void
+)
+{
+  Bool_t incomplete = d_FALSE;
+
+  if (verifyState == d_SHA256_VERIFY_BUSY)
+  {
+    Uint32_t slice = verifyRemaining;
+    if (slice > d_SHA256_VERIFY_SLICE_BYTES)
+    {
+      slice = d_SHA256_VERIFY_SLICE_BYTES;
+    }
+    ELSE_DO_NOTHING
+
+    d_SHA256_Write(&verifySha, pVerifyNext, slice);
+    pVerifyNext = &pVerifyNext[slice];
+    verifyRemaining = verifyRemaining - slice;
+
+    if (verifyRemaining == 0u)
+    {
+      (void)d_SHA256_Close(&verifySha);
+      if (hashEqual(verifyHash, verifyExpected) == d_TRUE)
+      {
+        verifyState = d_SHA256_VERIFY_PASS;
+      }
+      else
+      {
+        d_ERROR_Logger(d_STATUS_BIT_FAILURE, d_ERROR_CRITICALITY_NON_CRITICAL, verifySha.totalLen, 0, 0, 0);
+        verifyState = d_SHA256_VERIFY_FAIL;
+      }
+    }
+    else
+    {
+      incomplete = d_TRUE;
+    }
+  }
+  ELSE_DO_NOTHING
+
+  return incomplete;
+}
+
+/*********************************************************************//**
+  <!-- d_SHA256_VerifyStatus -->
+
+  Get the state of the background verification.
+*************************************************************************/
+d_Status_t                                    /** \return Function status */
+d_SHA256_VerifyStatus
+(
+d_SHA256_VerifyState_t * const pState         /**< [out] Pointer to storage for the state */
+)
+{
+  if (pState == NULL)
+  {
+    d_ERROR_Logger(d_STATUS_INVALID_PARAMETER, d_ERROR_CRITICALITY_NON_CRITICAL, 1, 0, 0, 0);
+    // cppcheck-suppress misra-c2012-15.5; Coding standard allows function to return if parameters are invalid
+    return d_STATUS_INVALID_PARAMETER;
+  }
+
+  *pState = verifyState;
+
+  return d_STATUS_SUCCESS;
+}
+
 /*********************************************************************//**
   <!-- rotateRight -->
 
@@ -246,105 +458,118 @@ const Uint32_t count          /**< [in]  bits to shift */
   return (value >> count) | (value << (32u - count));
 }
 
+/*********************************************************************//**
+  <!-- loadBigEndian -->
+
+  Load a big-endian word of a chunk.
+*************************************************************************/
+static inline Uint32_t        /** \return Word value */
+loadBigEndian
+(
+const Uint8_t * const p,      /**< [in]  Pointer to the chunk data */
+const Uint32_t index          /**< [in]  Word index */
+)
+{
+  Uint32_t value;
+
+  // cppcheck-suppress misra-c2012-11.4; Conversion necessary to check alignment. Violation of 'Advisory' rule does not present a risk.
+  if (((Uint32_t)p & 3u) == 0u)
+  {
+    /* Aligned, a single load and byte reversal (REV) */
+    // cppcheck-suppress misra-c2012-11.3; Word access to aligned chunk data. Violation of 'Required' rule does not present a risk.
+    value = __builtin_bswap32(((const Uint32_t *)p)[index]);
+  }
+  else
+  {
+    value = ((Uint32_t)p[index * 4u] << 24u) | ((Uint32_t)p[(index * 4u) + 1u] << 16u) |
+            ((Uint32_t)p[(index * 4u) + 2u] << 8u) | (Uint32_t)p[(index * 4u) + 3u];
+  }
+
+  return value;
+}
+
 /*********************************************************************//**
   <!-- consumeChunk -->
 
-   Update a hash value under calculation with a new chunk of data.
+  Update a hash value under calculation with a new chunk of data. The
+  rounds are unrolled eight at a time with the working variables renamed
+  rather than moved, and the message schedule is kept as a window of 16
+  words extended as the rounds proceed.
 *************************************************************************/
-static inline void            /** \return None */
+static void                   /** \return None */
 consumeChunk
 (
-Uint32_t * const h,           /**< [in]  Pointer to the first hash item, of a total of eight */
+Uint32_t * const hashValue,   /**< [in]  Pointer to the first hash item, of a total of eight */
 const Uint8_t * const p       /**< [in]  Pointer to the chunk data, which has a standard length */
 )
 {
-  Uint32_t i;
+  Uint32_t w[16];
   Uint32_t j;
-  Uint32_t ah[8];
+  Uint32_t r;
 
   /* Initialize working variables to current hash value: */
-  for (i = 0; i < 8u; i++)
+  Uint32_t a = hashValue[0];
+  Uint32_t b = hashValue[1];
+  Uint32_t c = hashValue[2];
+  Uint32_t d = hashValue[3];
+  Uint32_t e = hashValue[4];
+  Uint32_t f = hashValue[5];
+  Uint32_t g = hashValue[6];
+  Uint32_t h = hashValue[7];
+
+  for (j = 0u; j < 16u; j++)
   {
-    ah[i] = h[i];
+    w[j] = loadBigEndian(p, j);
   }
 
-  /*
-   * The w-array is really w[64], but since we only need 16 of them at a time, we save stack by
-   * calculating 16 at a time.
-   *
-   * This optimisation was not there initially and the rest of the comments about w[64] are kept in their
-   * initial state.
-   */
-
-  /*
-   * create a 64-entry message schedule array w[0..63] of 32-bit words (The initial values in w[0..63]
-   * don't matter, so many implementations zero them here) copy chunk into first 16 words w[0..15] of the
-   * message schedule array
-   */
-  Uint32_t w[16];
+  SHA_ROUNDS_8(0u);
+  SHA_ROUNDS_8(8u);
 
-  /* Compression function main loop: */
-  for (i = 0; i < 4u; i++)
+  for (r = 16u; r < 64u; r = r + 8u)
   {
-    for (j = 0; j < 16u; j++)
-    {
-      if (i == 0u)
-      {
-        w[j] = ((Uint32_t)p[0u + (j * 4u)] << 24u) | ((Uint32_t)p[1u + (j * 4u)] << 16u) | ((Uint32_t)p[2u + (j * 4u)] << 8u) | (Uint32_t)p[3u + (j * 4u)];
-      }
-      else
-      {
-        /* Extend the first 16 words into the remaining 48 words w[16..63] of the
-         * message schedule array: */
-        const Uint32_t s0 = rotateRight(w[(j + 1u) & 0xfu], 7u) ^ rotateRight(w[(j + 1u) & 0xfu], 18u) ^
-                (w[(j + 1u) & 0xfu] >> 3u);
-        const Uint32_t s1 = rotateRight(w[(j + 14u) & 0xfu], 17u) ^
-                rotateRight(w[(j + 14u) & 0xfu], 19u) ^ (w[(j + 14u) & 0xfu] >> 10u);
-        w[j] = w[j] + s0 + w[(j + 9u) & 0xfu] + s1;
-      }
-      const Uint32_t s1 = rotateRight(ah[4], 6u) ^ rotateRight(ah[4], 11u) ^ rotateRight(ah[4], 25u);
-      const Uint32_t ch = (ah[4] & ah[5]) ^ (~ah[4] & ah[6]);
-
-      /*
-       * Initialize array of round constants:
-       * (first 32 bits of the fractional parts of the cube roots of the first 64 primes 2..311):
-       */
-      static const Uint32_t k[] =
-      {
-        0x428a2f98u, 0x71374491u, 0xb5c0fbcfu, 0xe9b5dba5u, 0x3956c25bu, 0x59f111f1u, 0x923f82a4u,
-        0xab1c5ed5u, 0xd807aa98u, 0x12835b01u, 0x243185beu, 0x550c7dc3u, 0x72be5d74u, 0x80deb1feu,
-        0x9bdc06a7u, 0xc19bf174u, 0xe49b69c1u, 0xefbe4786u, 0x0fc19dc6u, 0x240ca1ccu, 0x2de92c6fu,
-        0x4a7484aau, 0x5cb0a9dcu, 0x76f988dau, 0x983e5152u, 0xa831c66du, 0xb00327c8u, 0xbf597fc7u,
-        0xc6e00bf3u, 0xd5a79147u, 0x06ca6351u, 0x14292967u, 0x27b70a85u, 0x2e1b2138u, 0x4d2c6dfcu,
-        0x53380d13u, 0x650a7354u, 0x766a0abbu, 0x81c2c92eu, 0x92722c85u, 0xa2bfe8a1u, 0xa81a664bu,
-        0xc24b8b70u, 0xc76c51a3u, 0xd192e819u, 0xd6990624u, 0xf40e3585u, 0x106aa070u, 0x19a4c116u,
-        0x1e376c08u, 0x2748774cu, 0x34b0bcb5u, 0x391c0cb3u, 0x4ed8aa4au, 0x5b9cca4fu, 0x682e6ff3u,
-        0x748f82eeu, 0x78a5636fu, 0x84c87814u, 0x8cc70208u, 0x90befffau, 0xa4506cebu, 0xbef9a3f7u,
-        0xc67178f2u
-      };
-
-      const Uint32_t temp1 = ah[7] + s1 + ch + k[(i << 4u) | j] + w[j];
-      const Uint32_t s0 = rotateRight(ah[0], 2) ^ rotateRight(ah[0], 13) ^ rotateRight(ah[0], 22);
-      const Uint32_t maj = (ah[0] & ah[1]) ^ (ah[0] & ah[2]) ^ (ah[1] & ah[2]);
-      const Uint32_t temp2 = s0 + maj;
-
-      ah[7] = ah[6];
-      ah[6] = ah[5];
-      ah[5] = ah[4];
-      ah[4] = ah[3] + temp1;
-      ah[3] = ah[2];
-      ah[2] = ah[1];
-      ah[1] = ah[0];
-      ah[0] = temp1 + temp2;
-    }
+    SHA_SCHEDULE(r);
+    SHA_SCHEDULE(r + 1u);
+    SHA_SCHEDULE(r + 2u);
+    SHA_SCHEDULE(r + 3u);
+    SHA_SCHEDULE(r + 4u);
+    SHA_SCHEDULE(r + 5u);
+    SHA_SCHEDULE(r + 6u);
+    SHA_SCHEDULE(r + 7u);
+    SHA_ROUNDS_8(r);
   }
 
   /* Add the compressed chunk to the current hash value: */
-  for (i = 0; i < 8u; i++)
-  {
-    h[i] += ah[i];
-  }
-  
+  hashValue[0] += a;
+  hashValue[1] += b;
+  hashValue[2] += c;
+  hashValue[3] += d;
+  hashValue[4] += e;
+  hashValue[5] += f;
+  hashValue[6] += g;
+  hashValue[7] += h;
+
   return;
 }
 
+/*********************************************************************//**
+  <!-- hashEqual -->
+
+  Compare two hash values.
+*************************************************************************/
+static Bool_t                       /** \return d_TRUE if the hash values are equal */
+hashEqual
+(
+const Uint8_t * const pHash1,       /**< [in]  First hash */
+const Uint8_t * const pHash2        /**< [in]  Second hash */
+)
+{
+  Uint8_t difference = 0u;
+  Uint32_t index;
+
+  for (index = 0u; index < SIZE_OF_SHA_256_HASH; index++)
+  {
+    difference |= pHash1[index] ^ pHash2[index];
+  }
+
+  return (difference == 0u) ? d_TRUE : d_FALSE;
+}
@@ -31,6 +31,11 @@
 /* Size of the chunks used for the calculations. */
 #define SIZE_OF_SHA_256_CHUNK 64u
 
+/* Bytes hashed by one call of the background verification, a multiple of the chunk size */
+#ifndef d_SHA256_VERIFY_SLICE_BYTES
+#define d_SHA256_VERIFY_SLICE_BYTES 4096u
+#endif
+
 /***** Type Definitions *************************************************/
 
 /* The opaque SHA-256 type, that should be instantiated when using the streaming API. */
@@ -44,6 +49,14 @@ typedef struct
   Uint32_t h[8];
 } Sha256_t;
 
+typedef enum
+{
+  d_SHA256_VERIFY_IDLE = 0,
+  d_SHA256_VERIFY_BUSY,
+  d_SHA256_VERIFY_PASS,
+  d_SHA256_VERIFY_FAIL
+} d_SHA256_VerifyState_t;
+
 /***** Variables ********************************************************/
 
 /***** Function Declarations ********************************************/
@@ -63,4 +76,13 @@ void d_SHA256_Write(Sha256_t * const sha256, const Uint8_t * const data, const U
 /* Conclude a SHA-256 streaming calculation, making the hash value available. */
 Uint8_t *d_SHA256_Close(Sha256_t *sha256);
 
+/* Start a background verification of a block of memory against an expected hash. */
+d_Status_t d_SHA256_VerifyStart(const Uint8_t * const pData, const Uint32_t length, const Uint8_t expected[SIZE_OF_SHA_256_HASH]);
+
+/* Background job hashing the next slice of the block being verified. */
+Bool_t d_SHA256_VerifyBackground(void);
+
+/* Get the state of the background verification. */
+d_Status_t d_SHA256_VerifyStatus(d_SHA256_VerifyState_t * const pState);
+
 #endif /* D_SHA256_H */
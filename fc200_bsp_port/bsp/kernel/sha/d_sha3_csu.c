@@ -0,0 +1,288 @@
+/******[Configuration Header]*****************************************//**
+\file
+\brief
+  Module Title       : SHA3 CSU
+
+  Abstract           : Calculation of 384 bit SHA3 by the configuration
+                       security unit hardware. The data is fed to the
+                       SHA3 engine by the CSU DMA through the secure
+                       stream switch.
+
+  Software Structure : SRS References: 136T-2200-131000-001-D20 SWREQ-320
+                       SDD References: 136T-2200-131000-001-D22 SWDES-13
+\note
+  CSC ID             : SWDES-82
+*************************************************************************/
+
+/***** Includes *********************************************************/
+
+#include "soc/defines/d_common_types.h"
+#include "soc/defines/d_common_status.h"
+#include "kernel/error_handler/d_error_handler.h"
+#include "kernel/general/d_gen_memory.h"
+#include "kernel/general/d_gen_register.h"
+#include "soc/memory_manager/d_memory_cache.h"
+#include "soc/timer/d_timer.h"
+#include "d_sha3_csu.h"
+
+/***** Constants ********************************************************/
+
+#ifdef ENABLE_CSU_SHA3
+
+/* Secure stream switch, SHA3 input from the CSU DMA */
+static const Uint32_t CSU_SSS_CFG = 0xFFCA0008u;
+static const Uint32_t CSU_SSS_CFG_SHA_MASK = 0x0000F000u;
+static const Uint32_t CSU_SSS_CFG_SHA_DMA = 0x00005000u;
+
+/* SHA3 engine */
+static const Uint32_t CSU_SHA_START = 0xFFCA2000u;
+static const Uint32_t CSU_SHA_RESET = 0xFFCA2004u;
+static const Uint32_t CSU_SHA_DONE = 0xFFCA2008u;
+static const Uint32_t CSU_SHA_DIGEST_0 = 0xFFCA2010u;
+
+/* CSU DMA source channel */
+static const Uint32_t CSU_DMA_SRC_ADDR = 0xFFC80000u;
+static const Uint32_t CSU_DMA_SRC_SIZE = 0xFFC80004u;
+static const Uint32_t CSU_DMA_SRC_I_STS = 0xFFC80014u;
+static const Uint32_t CSU_DMA_SRC_ADDR_MSB = 0xFFC80028u;
+static const Uint32_t CSU_DMA_SIZE_LAST_WORD = 0x00000001u;
+static const Uint32_t CSU_DMA_I_STS_DONE = 0x00000002u;
+static const Uint32_t CSU_DMA_SIZE_MAX = 0x1FFFFFFCu;
+
+/* SHA3 block (rate) in bytes, and the padding bytes of FIPS 202 */
+#define SHA3_BLOCK_BYTES  104u
+static const Uint8_t SHA3_PAD_FIRST = 0x06u;
+static const Uint8_t SHA3_PAD_LAST = 0x80u;
+
+/* Fixed part of the timeout of a transfer in microseconds, a microsecond is added per 32 bytes */
+static const Uint32_t TIMEOUT_BASE_US = 1000u;
+
+/***** Type Definitions *************************************************/
+
+/***** Variables ********************************************************/
+
+/* The last partial word of the data followed by the padding, in DMA reachable memory */
+static Uint8_t finalBlock[128] __attribute__((aligned(32)));
+
+/***** Function Declarations ********************************************/
+
+static d_Status_t dmaTransfer(const Uint8_t * const pData, const Uint32_t length, const Bool_t last);
+static d_Status_t waitDone(const Uint32_t address, const Uint32_t mask, const Uint32_t timeoutMicroseconds);
+
+#endif
+
+/***** Function Definitions *********************************************/
+
+/*********************************************************************//**
+  <!-- d_SHA3_Calculate -->
+
+  Calculate the SHA3-384 of a block of memory. The whole words of the
+  data are transferred directly, the remaining bytes and the padding are
+  transferred from a local block marked as the end of the data.
+*************************************************************************/
+d_Status_t                            /** \return Function status */
+d_SHA3_Calculate
+(
+Uint8_t hash[SIZE_OF_SHA3_384_HASH],  /**< [out] Hash result */
+const Uint8_t * const input,          /**< [in]  Data to hash, word aligned */
+const Uint32_t len                    /**< [in]  Data length */
+)
+{
+#ifdef ENABLE_CSU_SHA3
+  d_Status_t status = d_STATUS_SUCCESS;
+
+  // cppcheck-suppress misra-c2012-11.4; Conversion necessary to check alignment. Violation of 'Advisory' rule does not present a risk.
+  if ((hash == NULL) || (input == NULL) || (((Uint32_t)input & 3u) != 0u) || (len > CSU_DMA_SIZE_MAX))
+  {
+    d_ERROR_Logger(d_STATUS_INVALID_PARAMETER, d_ERROR_CRITICALITY_NON_CRITICAL, 1, len, 0, 0);
+    // cppcheck-suppress misra-c2012-15.5; Coding standard allows function to return if parameters are invalid
+    return d_STATUS_INVALID_PARAMETER;
+  }
+
+  Uint32_t bodyLength = len & ~3u;
+  Uint32_t tailLength = len - bodyLength;
+  Uint32_t padLength = SHA3_BLOCK_BYTES - (len % SHA3_BLOCK_BYTES);
+
+  /* Route the DMA to the SHA3 engine, reset it and start a calculation */
+  d_GEN_RegisterWrite(CSU_SSS_CFG, (d_GEN_RegisterRead(CSU_SSS_CFG) & ~CSU_SSS_CFG_SHA_MASK) | CSU_SSS_CFG_SHA_DMA);
+  d_GEN_RegisterWrite(CSU_SHA_RESET, 1u);
+  d_GEN_RegisterWrite(CSU_SHA_RESET, 0u);
+  d_GEN_RegisterWrite(CSU_SHA_START, 1u);
+
+  if (bodyLength > 0u)
+  {
+    status = dmaTransfer(input, bodyLength, d_FALSE);
+  }
+  ELSE_DO_NOTHING
+
+  if (status == d_STATUS_SUCCESS)
+  {
+    /* The tail and padding together are a whole number of words as the padded length is a multiple of the block */
+    d_GEN_MemorySet(finalBlock, 0u, sizeof(finalBlock));
+    d_GEN_MemoryCopy(finalBlock, &input[bodyLength], tailLength);
+    finalBlock[tailLength] = SHA3_PAD_FIRST;
+    finalBlock[(tailLength + padLength) - 1u] |= SHA3_PAD_LAST;
+    status = dmaTransfer(finalBlock, tailLength + padLength, d_TRUE);
+  }
+  // gcov-jst 1 It is not practical to generate this failure during bench testing.
+  ELSE_DO_NOTHING
+
+  if (status == d_STATUS_SUCCESS)
+  {
+    status = waitDone(CSU_SHA_DONE, 1u, TIMEOUT_BASE_US);
+  }
+  // gcov-jst 1 It is not practical to generate this failure during bench testing.
+  ELSE_DO_NOTHING
+
+  if (status == d_STATUS_SUCCESS)
+  {
+    /* The digest registers hold the words in reverse order */
+    Uint32_t index;
+    for (index = 0u; index < (SIZE_OF_SHA3_384_HASH / 4u); index++)
+    {
+      Uint32_t value = d_GEN_RegisterRead(CSU_SHA_DIGEST_0 + (index * 4u));
+      Uint32_t offset = SIZE_OF_SHA3_384_HASH - ((index + 1u) * 4u);
+      hash[offset] = (Uint8_t)value;
+      hash[offset + 1u] = (Uint8_t)(value >> 8u);
+      hash[offset + 2u] = (Uint8_t)(value >> 16u);
+      hash[offset + 3u] = (Uint8_t)(value >> 24u);
+    }
+  }
+  else
+  {
+    // gcov-jst 2 It is not practical to generate this failure during bench testing.
+    d_ERROR_Logger(status, d_ERROR_CRITICALITY_NON_CRITICAL, 2, len, 0, 0);
+    d_GEN_RegisterWrite(CSU_SHA_RESET, 1u);
+  }
+
+  return status;
+#else
+  UNUSED_PARAMETER(hash);
+  UNUSED_PARAMETER(input);
+  UNUSED_PARAMETER(len);
+
+  /* The CSU engine is not included in this build */
+  d_ERROR_Logger(d_STATUS_FAILURE, d_ERROR_CRITICALITY_NON_CRITICAL, 0, 0, 0, 0);
+
+  return d_STATUS_FAILURE;
+#endif
+}
+
+/*********************************************************************//**
+  <!-- d_SHA3_Verify -->
+
+  Verify a block of memory against an expected SHA3-384.
+*************************************************************************/
+d_Status_t                                    /** \return d_STATUS_BIT_FAILURE if the hash differs */
+d_SHA3_Verify
+(
+const Uint8_t * const input,                  /**< [in]  Data to verify, word aligned */
+const Uint32_t len,                           /**< [in]  Data length */
+const Uint8_t expected[SIZE_OF_SHA3_384_HASH] /**< [in]  Expected hash */
+)
+{
+  Uint8_t hash[SIZE_OF_SHA3_384_HASH];
+  d_Status_t status = d_STATUS_INVALID_PARAMETER;
+
+  if (expected != NULL)
+  {
+    status = d_SHA3_Calculate(hash, input, len);
+  }
+  ELSE_DO_NOTHING
+
+  if (status == d_STATUS_SUCCESS)
+  {
+    Uint8_t difference = 0u;
+    Uint32_t index;
+    for (index = 0u; index < SIZE_OF_SHA3_384_HASH; index++)
+    {
+      difference |= hash[index] ^ expected[index];
+    }
+
+    if (difference != 0u)
+    {
+      d_ERROR_Logger(d_STATUS_BIT_FAILURE, d_ERROR_CRITICALITY_NON_CRITICAL, len, 0, 0, 0);
+      status = d_STATUS_BIT_FAILURE;
+    }
+    ELSE_DO_NOTHING
+  }
+  ELSE_DO_NOTHING
+
+  return status;
+}
+
+#ifdef ENABLE_CSU_SHA3
+
+/*********************************************************************//**
+  <!-- dmaTransfer -->
+
+  Transfer a block of memory to the SHA3 engine and wait for the DMA to
+  complete.
+*************************************************************************/
+static d_Status_t                   /** \return Function status */
+dmaTransfer
+(
+const Uint8_t * const pData,        /**< [in]  Data, word aligned */
+const Uint32_t length,              /**< [in]  Length, a multiple of four bytes */
+const Bool_t last                   /**< [in]  d_TRUE if this is the end of the data */
+)
+{
+  Uint32_t size = length;
+
+  if (last == d_TRUE)
+  {
+    size = size | CSU_DMA_SIZE_LAST_WORD;
+  }
+  ELSE_DO_NOTHING
+
+  /* The DMA reads memory directly */
+  // cppcheck-suppress misra-c2012-11.4; Conversion necessary for memory cache function. Violation of 'Advisory' rule does not present a risk.
+  d_MEMORY_DCacheFlushRange((Pointer_t)pData, length);
+
+  d_GEN_RegisterWrite(CSU_DMA_SRC_I_STS, CSU_DMA_I_STS_DONE);
+  // cppcheck-suppress misra-c2012-11.4; Conversion necessary for register write function. Violation of 'Advisory' rule does not present a risk.
+  d_GEN_RegisterWrite(CSU_DMA_SRC_ADDR, (Uint32_t)pData);
+  d_GEN_RegisterWrite(CSU_DMA_SRC_ADDR_MSB, 0u);
+  d_GEN_RegisterWrite(CSU_DMA_SRC_SIZE, size);
+
+  d_Status_t status = waitDone(CSU_DMA_SRC_I_STS, CSU_DMA_I_STS_DONE, TIMEOUT_BASE_US + (length / 32u));
+  d_GEN_RegisterWrite(CSU_DMA_SRC_I_STS, CSU_DMA_I_STS_DONE);
+
+  return status;
+}
+
+/*********************************************************************//**
+  <!-- waitDone -->
+
+  Wait for a status bit to be set.
+*************************************************************************/
+static d_Status_t                   /** \return d_STATUS_TIMEOUT if the bit is not set in time */
+waitDone
+(
+const Uint32_t address,             /**< [in]  Status register address */
+const Uint32_t mask,                /**< [in]  Status bit */
+const Uint32_t timeoutMicroseconds  /**< [in]  Time allowed */
+)
+{
+  d_Status_t status = d_STATUS_SUCCESS;
+  Uint32_t value;
+  Uint32_t elapsedTime;
+  Uint32_t startTime = d_TIMER_ReadValueInTicks();
+
+  do
+  {
+    value = d_GEN_RegisterRead(address);
+    elapsedTime = d_TIMER_ElapsedMicroseconds(startTime, NULL);
+  } while (((value & mask) == 0u) && (elapsedTime < timeoutMicroseconds));
+
+  if ((value & mask) == 0u)
+  {
+    // gcov-jst 1 It is not practical to generate this failure during bench testing.
+    status = d_STATUS_TIMEOUT;
+  }
+  ELSE_DO_NOTHING
+
+  return status;
+}
+
+#endif
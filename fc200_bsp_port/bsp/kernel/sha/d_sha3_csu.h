@@ -0,0 +1,43 @@
+/******[Configuration Header]*****************************************//**
+\file
+\brief
+  Module Title       : SHA3 CSU
+
+  Abstract           : Calculation of 384 bit SHA3 by the configuration
+                       security unit hardware.
+
+  Software Structure : SRS References: 136T-2200-131000-001-D20 SWREQ-320
+                       SDD References: 136T-2200-131000-001-D22 SWDES-13
+\note
+  CSC ID             : SWDES-82
+*************************************************************************/
+
+#ifndef D_SHA3_CSU_H
+#define D_SHA3_CSU_H
+
+/***** Includes *********************************************************/
+
+#include "soc/defines/d_common_types.h"
+#include "soc/defines/d_common_status.h"
+
+/***** Constants ********************************************************/
+
+/* Size of the SHA3-384 sum. This times eight is 384 bits. */
+#define SIZE_OF_SHA3_384_HASH 48u
+
+/***** Type Definitions *************************************************/
+
+/***** Variables ********************************************************/
+
+/***** Function Declarations ********************************************/
+
+/* The CSU engine is used when the build defines ENABLE_CSU_SHA3, otherwise the functions fail. The
+   data must be word aligned and in memory the CSU DMA can reach, which excludes the TCM. */
+
+/* Calculate the SHA3-384 of a block of memory. */
+d_Status_t d_SHA3_Calculate(Uint8_t hash[SIZE_OF_SHA3_384_HASH], const Uint8_t * const input, const Uint32_t len);
+
+/* Verify a block of memory against an expected SHA3-384. */
+d_Status_t d_SHA3_Verify(const Uint8_t * const input, const Uint32_t len, const Uint8_t expected[SIZE_OF_SHA3_384_HASH]);
+
+#endif /* D_SHA3_CSU_H */
@@ -25,83 +25,81 @@
 
 #include "soc/defines/d_common_types.h"
 #include "soc/defines/d_common_status.h"
-#include "soc/timer/d_timer.h"
 #include "soc/interrupt_manager/d_int_irq_handler.h"
+#include "soc/memory_manager/d_memory_cache.h"
 #include "kernel/general/d_gen_memory.h"
 #include "kernel/error_handler/d_error_handler.h"
-#include "soc/interrupt_manager/d_int_critical.h"
 
 #include "d_smi.h"
 
 /***** Constants ********************************************************/
 
-/* Maximum time, in microseconds, to wait for semaphore access */
-// cppcheck-suppress misra-c2012-8.9; Defining constants at the start of the module is more maintainable. Violation of 'Advisory' rule does not present a risk.
-static const Uint32_t TIMEOUT_TIME = 50;
+/* Each direction is a single producer, single consumer ring of records. A record is a length
+   word followed by the message, padded to a word boundary. A record never wraps, the producer
+   writes RECORD_WRAP and continues at the start of the ring. Head and tail are free running
+   byte counts, each written by one side only, so no lock is needed. The rings are in
+   non-cacheable shared memory. */
 
-#define MAX_ENTRIES      50u
-#define TOTAL_SIZE      500u
+#define RING_MASK          (d_SMI_RING_SIZE - 1u)
+#define RECORD_HEADER      4u
+#define RECORD_WRAP        0xFFFFFFFFu
 
-/***** Type Definitions *************************************************/
+/* Identifies the ring layout to the APU, "SMI2" */
+#define RING_MAGIC         0x32494D53u
 
-typedef enum
-{
-  INTERFACE_TRANSMIT = 0,
-  INTERFACE_RECEIVE
-} Interface_t;
+/***** Type Definitions *************************************************/
 
-#pragma pack(1)
-/* Buffer status */
+/* Ring in shared memory, the producer and consumer indices are in separate 32 byte lines */
 typedef struct
 {
-  volatile Uint32_t bufferIndexIn;       /* Index in buffer for next write */
-  volatile Uint32_t bufferUsedBytes;     /* Number of bytes of buffer used */
-  volatile Uint32_t indexIn;             /* Index in entries for next write */
-  volatile Uint32_t indexOut;            /* Index in entries for next read */
-  volatile Uint32_t entryCount;          /* Number of entries in buffer */
-  volatile Uint32_t highWater;           /* Largest number of entries in buffer */
-} BufferVarStatus_t;
-
-/* Item status */
-typedef struct
-{
-  volatile Uint32_t itemIndex;           /* Index in buffer of the message */
-  volatile Uint32_t itemSize;            /* Length of the message */
-} BufferVarItem_t;
+  volatile Uint32_t magic;                /* RING_MAGIC once initialised */
+  volatile Uint32_t head;                 /* Producer, byte count written */
+  volatile Uint32_t messagesIn;           /* Producer, messages written */
+  volatile Uint32_t producerSpare[5];
+  volatile Uint32_t tail;                 /* Consumer, byte count read */
+  volatile Uint32_t messagesOut;          /* Consumer, messages read */
+  volatile Uint32_t consumerSpare[6];
+  volatile Uint8_t buffer[d_SMI_RING_SIZE];
+} Ring_t;
 
-typedef struct
-{
-  volatile Uint32_t user[2]; /* We are not using Bool_t as that gives different size variables between RPU and APU */
-  volatile Uint32_t turn;
-} Semaphore_t;
+/***** Variables ********************************************************/
 
-typedef struct
-{
-  volatile BufferVarStatus_t varStatus;
-  volatile BufferVarItem_t varItems[MAX_ENTRIES];
-  volatile Semaphore_t semaphore;
-  volatile Uint8_t buffer[TOTAL_SIZE];
-} buffer_cfg_t;
-#pragma pack()
+static Ring_t ringTx __attribute__ ((section (".sharedTx"), aligned (32)));
+static Ring_t ringRx __attribute__ ((section (".sharedRx"), aligned (32)));
 
-/***** Variables ********************************************************/
+/* Transmit reservation */
+static Bool_t reserved = d_FALSE;
+static Uint32_t reserveStart;             /* Byte count at the reserved record */
+static Uint32_t reserveLength;            /* Message length reserved */
 
-static buffer_cfg_t bufferTx __attribute__ ((section (".sharedTx")));  \
-static buffer_cfg_t bufferRx __attribute__ ((section (".sharedRx")));
+/* Messages committed since the last doorbell */
+static Uint32_t doorbellPending = 0u;
+
+/* Receive message returned by peek */
+static Bool_t peeked = d_FALSE;
+static Uint32_t peekNext;                 /* Byte count after the peeked record */
+
+/* Transmit message returned by the bridge peek */
+static Bool_t bridgePeeked = d_FALSE;
+static Uint32_t bridgeNext;               /* Byte count after the peeked record */
+
+static d_SMI_Stats_t smiStats;
 
 /***** Function Declarations ********************************************/
 
-static void messageCopyOut(Uint8_t * const pDestination, const volatile Uint8_t * const pSource, const Uint32_t bufferSize, const Uint32_t bufferIndex, const Uint32_t length);
-static void messageCopyIn(volatile Uint8_t * const pDestination, const Uint32_t bufferSize, const Uint32_t bufferIndex, const Uint8_t * const pSource, const Uint32_t length);
-static d_Status_t semaphoreLock(const Interface_t interface);
-static void semaphoreFree(const Interface_t interface);
+static Uint32_t recordSize(const Uint32_t length);
+static Bool_t ringReserve(const Ring_t * const pRing, const Uint32_t length, Uint32_t * const pStart);
+static Uint32_t ringCommit(Ring_t * const pRing, const Uint32_t start, const Uint32_t length);
+static d_Status_t ringPeek(const Ring_t * const pRing, const Uint8_t ** const ppData, Uint32_t * const pLength, Uint32_t * const pNext);
+static void ringConsume(Ring_t * const pRing, const Uint32_t next);
+static void doorbellRing(void);
 
 /***** Function Definitions *********************************************/
 
 /*********************************************************************//**
   <!-- d_SMI_Initialise -->
 
-  Initialise the variable message length buffers.
+  Initialise the shared memory rings.
 *************************************************************************/
 void                      /** \return None */
 d_SMI_Initialise
@@ -109,14 +107,17 @@ d_SMI_Initialise
 void
 )
 {
-  /* Initialise buffers */
+  /* Initialise rings */
+  ringRx.head = 0u;
+  ringRx.messagesIn = 0u;
   d_SMI_ReceiveFlush();
   d_SMI_TransmitFlush();
 
-  /* Initialise semaphores */
-  bufferRx.semaphore.user[0] = d_FALSE;
-  bufferRx.semaphore.user[1] = d_FALSE;
-  bufferRx.semaphore.turn = 0;
+  ringRx.magic = RING_MAGIC;
+  ringTx.magic = RING_MAGIC;
+
+  doorbellPending = 0u;
+  d_GEN_MemorySet((Uint8_t *)&smiStats, 0u, sizeof(smiStats));
 
   return;
 }
@@ -124,7 +125,8 @@ void
 /*********************************************************************//**
   <!-- d_SMI_ReceiveFlush -->
 
-  Flush a variable message length buffer.
+  Discard all received messages. The consumer index is moved to the
+  producer index, so this is safe while the APU is writing.
 *************************************************************************/
 void
 d_SMI_ReceiveFlush
@@ -132,12 +134,13 @@ d_SMI_ReceiveFlush
 void
 )
 {
-  bufferRx.varStatus.bufferIndexIn = 0;
-  bufferRx.varStatus.bufferUsedBytes = 0;
-  bufferRx.varStatus.indexIn = 0;
-  bufferRx.varStatus.indexOut = 0;
-  bufferRx.varStatus.entryCount = 0;
-  bufferRx.varStatus.highWater = 0;
+  Uint32_t head = ringRx.head;
+  Uint32_t messages = ringRx.messagesIn;
+
+  d_dmb();
+  ringRx.tail = head;
+  ringRx.messagesOut = messages;
+  peeked = d_FALSE;
 
   return;
 }
@@ -145,7 +148,8 @@ void
 /*********************************************************************//**
   <!-- d_SMI_TransmitFlush -->
 
-  Flush a variable message length buffer.
+  Discard all transmit messages. Both indices are reset, so the APU must
+  not be reading.
 *************************************************************************/
 void
 d_SMI_TransmitFlush
@@ -153,20 +157,119 @@ d_SMI_TransmitFlush
 void
 )
 {
-  bufferTx.varStatus.bufferIndexIn = 0;
-  bufferTx.varStatus.bufferUsedBytes = 0;
-  bufferTx.varStatus.indexIn = 0;
-  bufferTx.varStatus.indexOut = 0;
-  bufferTx.varStatus.entryCount = 0;
-  bufferTx.varStatus.highWater = 0;
+  ringTx.head = 0u;
+  ringTx.messagesIn = 0u;
+  ringTx.tail = 0u;
+  ringTx.messagesOut = 0u;
+  reserved = d_FALSE;
+  bridgePeeked = d_FALSE;
 
   return;
 }
 
+/*********************************************************************//**
+  <!-- d_SMI_TransmitReserve -->
+
+  Reserve contiguous space for a message in the transmit ring. If the
+  record does not fit before the end of the ring, the space to the end is
+  also reserved and skipped.
+*************************************************************************/
+d_Status_t                     /** \return Function status */
+d_SMI_TransmitReserve
+(
+const Uint32_t length,         /**< [in]  Length of message to reserve */
+Uint8_t ** const ppData        /**< [out] Pointer to storage for the message address */
+)
+{
+  d_Status_t returnValue = d_STATUS_BUFFER_FULL;
+
+  if (ppData == NULL)
+  {
+    d_ERROR_Logger(d_STATUS_INVALID_PARAMETER, d_ERROR_CRITICALITY_CRITICAL_SHUTDOWN, 2, 0, 0, 0);
+    returnValue = d_STATUS_INVALID_PARAMETER;
+  }
+  else if ((length == 0u) || (length > d_SMI_MAX_MESSAGE))
+  {
+    d_ERROR_Logger(d_STATUS_INVALID_PARAMETER, d_ERROR_CRITICALITY_CRITICAL_SHUTDOWN, 3, length, 0, 0);
+    returnValue = d_STATUS_INVALID_PARAMETER;
+  }
+  else
+  {
+    if (ringReserve(&ringTx, length, &reserveStart) == d_TRUE)
+    {
+      reserveLength = length;
+      reserved = d_TRUE;
+// cppcheck-suppress misra-c2012-11.8; The reserved space is not accessed by the APU until it is committed, after a memory barrier. Violation of 'Required' rule does not present a risk.
+      *ppData = (Uint8_t *)&ringTx.buffer[(reserveStart & RING_MASK) + RECORD_HEADER];
+      returnValue = d_STATUS_SUCCESS;
+    }
+    else
+    {
+      smiStats.transmitFull++;
+    }
+  }
+
+  return returnValue;
+}
+
+/*********************************************************************//**
+  <!-- d_SMI_TransmitCommit -->
+
+  Publish the reserved message to the APU. The record is written before
+  the producer index is advanced.
+*************************************************************************/
+d_Status_t                     /** \return Function status */
+d_SMI_TransmitCommit
+(
+const Uint32_t length,         /**< [in] Length of message written */
+const Bool_t urgent            /**< [in] Interrupt the APU immediately */
+)
+{
+  d_Status_t returnValue = d_STATUS_SUCCESS;
+
+  if (reserved == d_FALSE)
+  {
+    returnValue = d_STATUS_FAILURE;
+  }
+  else if ((length == 0u) || (length > reserveLength))
+  {
+    d_ERROR_Logger(d_STATUS_INVALID_PARAMETER, d_ERROR_CRITICALITY_CRITICAL_SHUTDOWN, 1, length, reserveLength, 0);
+    returnValue = d_STATUS_INVALID_PARAMETER;
+  }
+  else
+  {
+    Uint32_t used = ringCommit(&ringTx, reserveStart, length);
+    reserved = d_FALSE;
+
+    smiStats.transmitted++;
+    if (used > smiStats.highWater)
+    {
+      smiStats.highWater = used;
+    }
+    else
+    {
+      DO_NOTHING();
+    }
+
+    doorbellPending++;
+    if ((urgent == d_TRUE) || (doorbellPending >= d_SMI_DOORBELL_BATCH))
+    {
+      doorbellRing();
+    }
+    else
+    {
+      DO_NOTHING();
+    }
+  }
+
+  return returnValue;
+}
+
 /*********************************************************************//**
   <!-- d_SMI_Transmit -->
 
-  Write a variable length message to a buffer.
+  Copy a message to the transmit ring. The APU is interrupted when a
+  batch is complete or by d_SMI_Doorbell.
 *************************************************************************/
 d_Status_t                     /** \return Function status */
 d_SMI_Transmit
@@ -175,54 +278,109 @@ const Uint8_t * const pData,   /**< [in] Pointer to message data */
 const Uint32_t length          /**< [in] Length of message to write */
 )
 {
-  d_Status_t returnValue = d_STATUS_BUFFER_FULL;
+  d_Status_t returnValue;
+  Uint8_t * pMessage;
 
   if (pData == NULL)
   {
     d_ERROR_Logger(d_STATUS_INVALID_PARAMETER, d_ERROR_CRITICALITY_CRITICAL_SHUTDOWN, 2, 0, 0, 0);
     returnValue = d_STATUS_INVALID_PARAMETER;
   }
-  else if (length == 0u)
+  else
+  {
+    returnValue = d_SMI_TransmitReserve(length, &pMessage);
+    if (returnValue == d_STATUS_SUCCESS)
+    {
+      d_GEN_MemoryCopy(pMessage, pData, length);
+      returnValue = d_SMI_TransmitCommit(length, d_FALSE);
+    }
+    else
+    {
+      DO_NOTHING();
+    }
+  }
+
+  return returnValue;
+}
+
+/*********************************************************************//**
+  <!-- d_SMI_Doorbell -->
+
+  Interrupt the APU if any messages have been committed since the last
+  interrupt.
+*************************************************************************/
+void                      /** \return None */
+d_SMI_Doorbell
+(
+void
+)
+{
+  if (doorbellPending > 0u)
+  {
+    doorbellRing();
+  }
+  else
+  {
+    DO_NOTHING();
+  }
+
+  return;
+}
+
+/*********************************************************************//**
+  <!-- d_SMI_Background -->
+
+  Background job ringing the doorbell once per frame.
+*************************************************************************/
+Bool_t                    /** \return Further processing required */
+d_SMI_Background
+(
+void
+)
+{
+  d_SMI_Doorbell();
+
+  return d_FALSE;
+}
+
+/*********************************************************************//**
+  <!-- d_SMI_ReceivePeek -->
+
+  Get a pointer to the oldest received message. The message remains in
+  the ring until d_SMI_ReceiveConsume.
+*************************************************************************/
+d_Status_t                         /** \return Function status */
+d_SMI_ReceivePeek
+(
+const Uint8_t ** const ppData,     /**< [out] Pointer to storage for the message address */
+Uint32_t * const pLength           /**< [out] Pointer to storage for message length */
+)
+{
+  d_Status_t returnValue = d_STATUS_BUFFER_EMPTY;
+
+  if (ppData == NULL)
+  {
+    d_ERROR_Logger(d_STATUS_INVALID_PARAMETER, d_ERROR_CRITICALITY_CRITICAL_SHUTDOWN, 2, 0, 0, 0);
+    returnValue = d_STATUS_INVALID_PARAMETER;
+  }
+  else if (pLength == NULL)
   {
     d_ERROR_Logger(d_STATUS_INVALID_PARAMETER, d_ERROR_CRITICALITY_CRITICAL_SHUTDOWN, 3, 0, 0, 0);
     returnValue = d_STATUS_INVALID_PARAMETER;
   }
   else
   {
-    if ((bufferTx.varStatus.entryCount < MAX_ENTRIES) &&
-        (length <= (TOTAL_SIZE - bufferTx.varStatus.bufferUsedBytes)))
+    returnValue = ringPeek(&ringRx, ppData, pLength, &peekNext);
+    if (returnValue == d_STATUS_SUCCESS)
     {
-      messageCopyIn(&bufferTx.buffer[0],
-                    TOTAL_SIZE,
-                    bufferTx.varStatus.bufferIndexIn,
-                    &pData[0],
-                    length);
-      bufferTx.varItems[bufferTx.varStatus.indexIn].itemIndex = bufferTx.varStatus.bufferIndexIn;
-      bufferTx.varItems[bufferTx.varStatus.indexIn].itemSize = length;
-      bufferTx.varStatus.bufferIndexIn = (bufferTx.varStatus.bufferIndexIn + length) % TOTAL_SIZE;
-      bufferTx.varStatus.indexIn = (bufferTx.varStatus.indexIn + 1u) % MAX_ENTRIES;
-      returnValue = semaphoreLock(INTERFACE_TRANSMIT);
-      if (returnValue == d_STATUS_SUCCESS)
-      {
-        bufferTx.varStatus.bufferUsedBytes = bufferTx.varStatus.bufferUsedBytes + length;
-        bufferTx.varStatus.entryCount++;
-        semaphoreFree(INTERFACE_TRANSMIT);
-        if (bufferTx.varStatus.entryCount > bufferTx.varStatus.highWater)
-        {
-          bufferTx.varStatus.highWater = bufferTx.varStatus.entryCount;
-        }
-        else
-        {
-          DO_NOTHING();
-        }
-        /* Send interrupt to other processor */
-        d_INT_Ipi();
-      }
-      else
-      {
-        /* Semaphore lock failed */
-        semaphoreFree(INTERFACE_TRANSMIT);
-      }
+      peeked = d_TRUE;
+    }
+    else if (returnValue == d_STATUS_DEVICE_ERROR)
+    {
+      // gcov-jst 3 It is not practical to generate this failure during bench testing.
+      d_ERROR_Logger(d_STATUS_DEVICE_ERROR, d_ERROR_CRITICALITY_NON_CRITICAL, 4, 0, ringRx.head, ringRx.tail);
+      smiStats.receiveErrors++;
+      d_SMI_ReceiveFlush();
     }
     else
     {
@@ -233,10 +391,39 @@ const Uint32_t length          /**< [in] Length of message to write */
   return returnValue;
 }
 
+/*********************************************************************//**
+  <!-- d_SMI_ReceiveConsume -->
+
+  Remove the message returned by d_SMI_ReceivePeek, releasing its space
+  to the APU.
+*************************************************************************/
+d_Status_t                     /** \return Function status */
+d_SMI_ReceiveConsume
+(
+void
+)
+{
+  d_Status_t returnValue = d_STATUS_BUFFER_EMPTY;
+
+  if (peeked == d_TRUE)
+  {
+    ringConsume(&ringRx, peekNext);
+    peeked = d_FALSE;
+    smiStats.received++;
+    returnValue = d_STATUS_SUCCESS;
+  }
+  else
+  {
+    DO_NOTHING();
+  }
+
+  return returnValue;
+}
+
 /*********************************************************************//**
   <!-- d_SMI_Receive -->
 
-  Read a variable length message from a buffer.
+  Copy the oldest received message and remove it from the ring.
 *************************************************************************/
 d_Status_t                     /** \return Function status */
 d_SMI_Receive
@@ -245,47 +432,33 @@ Uint8_t * const pData,         /**< [out] Pointer to storage for message data */
 Uint32_t * const pLength       /**< [out] Pointer to storage for message length */
 )
 {
-  d_Status_t returnValue = d_STATUS_BUFFER_EMPTY;
+  d_Status_t returnValue;
+  const Uint8_t * pMessage;
+  Uint32_t length = 0u;
 
   if (pData == NULL)
   {
     d_ERROR_Logger(d_STATUS_INVALID_PARAMETER, d_ERROR_CRITICALITY_CRITICAL_SHUTDOWN, 2, 0, 0, 0);
     returnValue = d_STATUS_INVALID_PARAMETER;
   }
-  if ((returnValue == d_STATUS_BUFFER_EMPTY) && (pLength == NULL))
+  else if (pLength == NULL)
   {
     d_ERROR_Logger(d_STATUS_INVALID_PARAMETER, d_ERROR_CRITICALITY_CRITICAL_SHUTDOWN, 3, 0, 0, 0);
     returnValue = d_STATUS_INVALID_PARAMETER;
   }
-  if (returnValue == d_STATUS_BUFFER_EMPTY)
+  else
   {
-    Uint32_t entrySize = 0u;
-    if (bufferRx.varStatus.entryCount > 0u)
+    returnValue = d_SMI_ReceivePeek(&pMessage, &length);
+    if (returnValue == d_STATUS_SUCCESS)
     {
-      entrySize = bufferRx.varItems[bufferRx.varStatus.indexOut].itemSize;
-      messageCopyOut(&pData[0],
-                     &bufferRx.buffer[0],
-                     TOTAL_SIZE,
-                     bufferRx.varItems[bufferRx.varStatus.indexOut].itemIndex,
-                     entrySize);
-      bufferRx.varStatus.indexOut = (bufferRx.varStatus.indexOut + 1u) % MAX_ENTRIES;
-      returnValue = semaphoreLock(INTERFACE_RECEIVE);
-      if (returnValue == d_STATUS_SUCCESS)
-      {
-        bufferRx.varStatus.bufferUsedBytes = bufferRx.varStatus.bufferUsedBytes - entrySize;
-        bufferRx.varStatus.entryCount--;
-      }
-      semaphoreFree(INTERFACE_RECEIVE);
+      d_GEN_MemoryCopy(pData, pMessage, length);
+      returnValue = d_SMI_ReceiveConsume();
     }
     else
     {
-      DO_NOTHING();
+      length = 0u;
     }
-    *pLength = entrySize;
-  }
-  else
-  {
-    DO_NOTHING();
+    *pLength = length;
   }
 
   return returnValue;
@@ -294,7 +467,7 @@ Uint32_t * const pLength       /**< [out] Pointer to storage for message length
 /*********************************************************************//**
   <!-- d_SMI_ReceiveCount -->
 
-  Read the number of messages in a variable length buffer.
+  Read the number of messages received and not yet consumed.
 *************************************************************************/
 d_Status_t
 d_SMI_ReceiveCount
@@ -311,135 +484,345 @@ Uint32_t * const pCount
   }
   else
   {
-    returnValue = semaphoreLock(INTERFACE_RECEIVE);
+    *pCount = ringRx.messagesIn - ringRx.messagesOut;
+  }
+  
+  return returnValue;
+}
+
+/*********************************************************************//**
+  <!-- d_SMI_BridgeTransmitPeek -->
+
+  Get a pointer to the oldest transmit message, reading the ring as the
+  APU would. Only for a bridge standing in for an absent APU.
+*************************************************************************/
+d_Status_t                         /** \return Function status */
+d_SMI_BridgeTransmitPeek
+(
+const Uint8_t ** const ppData,     /**< [out] Pointer to storage for the message address */
+Uint32_t * const pLength           /**< [out] Pointer to storage for message length */
+)
+{
+  d_Status_t returnValue;
+
+  if (ppData == NULL)
+  {
+    d_ERROR_Logger(d_STATUS_INVALID_PARAMETER, d_ERROR_CRITICALITY_CRITICAL_SHUTDOWN, 2, 0, 0, 0);
+    returnValue = d_STATUS_INVALID_PARAMETER;
+  }
+  else if (pLength == NULL)
+  {
+    d_ERROR_Logger(d_STATUS_INVALID_PARAMETER, d_ERROR_CRITICALITY_CRITICAL_SHUTDOWN, 3, 0, 0, 0);
+    returnValue = d_STATUS_INVALID_PARAMETER;
+  }
+  else
+  {
+    returnValue = ringPeek(&ringTx, ppData, pLength, &bridgeNext);
     if (returnValue == d_STATUS_SUCCESS)
     {
-      *pCount = bufferRx.varStatus.entryCount;
+      bridgePeeked = d_TRUE;
     }
     else
     {
-      *pCount = 0;
+      DO_NOTHING();
     }
-    semaphoreFree(INTERFACE_RECEIVE);
   }
-  
+
   return returnValue;
 }
-  
+
 /*********************************************************************//**
-  <!-- messageCopyOut -->
+  <!-- d_SMI_BridgeTransmitConsume -->
 
-  Copy a message out of the buffer to the application provided memory location.
+  Remove the message returned by d_SMI_BridgeTransmitPeek.
 *************************************************************************/
-static void              /** \return None */
-messageCopyOut
+d_Status_t                     /** \return Function status */
+d_SMI_BridgeTransmitConsume
 (
-Uint8_t * const pDestination,    /**< [out] Destination pointer */
-const volatile Uint8_t * const pSource,   /**< [in]  Source pointer */
-const Uint32_t bufferSize,       /**< [in]  Source buffer size */
-const Uint32_t bufferStart,      /**< [in]  Source buffer start index */
-const Uint32_t length            /**< [in]  Length of message to copy */
+void
 )
 {
-  Uint32_t index;
+  d_Status_t returnValue = d_STATUS_BUFFER_EMPTY;
 
-  Uint32_t bufferIndex = bufferStart;
-  for (index = 0u; index < length; index++)
+  if (bridgePeeked == d_TRUE)
   {
-    pDestination[index] = pSource[bufferIndex];
-    bufferIndex = (bufferIndex + 1u) % bufferSize;
+    ringConsume(&ringTx, bridgeNext);
+    bridgePeeked = d_FALSE;
+    returnValue = d_STATUS_SUCCESS;
+  }
+  else
+  {
+    DO_NOTHING();
   }
 
-  return;
+  return returnValue;
 }
 
 /*********************************************************************//**
-  <!-- messageCopyIn -->
+  <!-- d_SMI_BridgeReceiveWrite -->
 
-  Copy a message into the buffer from the application provided memory location.
+  Write a message to the receive ring as the APU would. Only for a bridge
+  standing in for an absent APU.
 *************************************************************************/
-static void                      /** \return None */
-messageCopyIn
+d_Status_t                     /** \return Function status */
+d_SMI_BridgeReceiveWrite
 (
-volatile Uint8_t * const pDestination,    /**< [out] Destination pointer */
-const Uint32_t bufferSize,       /**< [in] Destination buffer size */
-const Uint32_t bufferStart,      /**< [in] Destination buffer start index */
-const Uint8_t * const pSource,   /**< [in] Source pointer */
-const Uint32_t length            /**< [in] Length of message to copy */
+const Uint8_t * const pData,   /**< [in] Pointer to message data */
+const Uint32_t length          /**< [in] Length of message to write */
 )
 {
-  Uint32_t index;
+  d_Status_t returnValue = d_STATUS_BUFFER_FULL;
+  Uint32_t start;
 
-  Uint32_t bufferIndex = bufferStart;
-  for (index = 0u; index < length; index++)
+  if (pData == NULL)
+  {
+    d_ERROR_Logger(d_STATUS_INVALID_PARAMETER, d_ERROR_CRITICALITY_CRITICAL_SHUTDOWN, 2, 0, 0, 0);
+    returnValue = d_STATUS_INVALID_PARAMETER;
+  }
+  else if ((length == 0u) || (length > d_SMI_MAX_MESSAGE))
+  {
+    d_ERROR_Logger(d_STATUS_INVALID_PARAMETER, d_ERROR_CRITICALITY_CRITICAL_SHUTDOWN, 3, length, 0, 0);
+    returnValue = d_STATUS_INVALID_PARAMETER;
+  }
+  else if (ringReserve(&ringRx, length, &start) == d_TRUE)
   {
-    pDestination[bufferIndex] = pSource[index];
-    bufferIndex = (bufferIndex + 1u) % bufferSize;
+// cppcheck-suppress misra-c2012-11.8; The reserved space is not accessed by the consumer until it is committed, after a memory barrier. Violation of 'Required' rule does not present a risk.
+    d_GEN_MemoryCopy((Uint8_t *)&ringRx.buffer[(start & RING_MASK) + RECORD_HEADER], pData, length);
+    (void)ringCommit(&ringRx, start, length);
+    returnValue = d_STATUS_SUCCESS;
+  }
+  else
+  {
+    DO_NOTHING();
   }
 
-  return;
+  return returnValue;
 }
 
 /*********************************************************************//**
-  <!-- semaphoreLock -->
+  <!-- d_SMI_GetStats -->
 
-  Lock semaphore for exclusive access.
+  Get the interface statistics.
 *************************************************************************/
-static d_Status_t semaphoreLock(const Interface_t interface)
+d_Status_t                         /** \return Function status */
+d_SMI_GetStats
+(
+d_SMI_Stats_t * const pStats       /**< [out] Pointer to storage for the statistics */
+)
 {
-  volatile Semaphore_t * pSemaphore;
   d_Status_t returnValue = d_STATUS_SUCCESS;
-  
-  if (interface == INTERFACE_TRANSMIT)
+
+  if (pStats == NULL)
   {
-    pSemaphore = (volatile Semaphore_t *)&bufferTx.semaphore;
+    d_ERROR_Logger(d_STATUS_INVALID_PARAMETER, d_ERROR_CRITICALITY_CRITICAL_SHUTDOWN, 1, 0, 0, 0);
+    returnValue = d_STATUS_INVALID_PARAMETER;
   }
   else
   {
-    pSemaphore = (volatile Semaphore_t *)&bufferRx.semaphore;
+    *pStats = smiStats;
   }
-  Uint32_t otherInterface = ((Uint32_t)interface + 1u) & 0x01u;
 
-  pSemaphore->user[interface] = d_TRUE;
-  pSemaphore->turn = otherInterface;
+  return returnValue;
+}
 
-  Bool_t timeout = d_FALSE;
-  Uint32_t startTime;
-  (void)d_TIMER_ElapsedMicroseconds(0, &startTime);
-  
-  // cppcheck-suppress knownConditionTrueFalse; The structure pointed to pSemaphore is defined as 'volatile' and may be changed by another processor.
-  while ((pSemaphore->turn == otherInterface) && (pSemaphore->user[otherInterface] == (Uint32_t)d_TRUE) && (timeout == d_FALSE))
+/*********************************************************************//**
+  <!-- recordSize -->
+
+  Size in the ring of the record holding a message.
+*************************************************************************/
+static Uint32_t                /** \return Record size in bytes */
+recordSize
+(
+const Uint32_t length          /**< [in] Message length */
+)
+{
+  return RECORD_HEADER + ((length + 3u) & ~3u);
+}
+
+/*********************************************************************//**
+  <!-- ringReserve -->
+
+  Find space for a record in a ring as the producer. If the record does
+  not fit before the end of the ring, the space to the end is also taken
+  and skipped.
+*************************************************************************/
+static Bool_t                      /** \return Space available */
+ringReserve
+(
+const Ring_t * const pRing,        /**< [in]  Ring */
+const Uint32_t length,             /**< [in]  Message length */
+Uint32_t * const pStart            /**< [out] Pointer to storage for the byte count at the record */
+)
+{
+  Bool_t space = d_FALSE;
+  Uint32_t head = pRing->head;
+  Uint32_t used = head - pRing->tail;
+  Uint32_t size = recordSize(length);
+  Uint32_t padding = 0u;
+
+  if (size > (d_SMI_RING_SIZE - (head & RING_MASK)))
   {
-    Uint32_t elapsedTime = d_TIMER_ElapsedMicroseconds(startTime, NULL);
-    if (elapsedTime > TIMEOUT_TIME)
-    {
-      timeout = d_TRUE;
-      returnValue = d_STATUS_TIMEOUT;
-    }
+    padding = d_SMI_RING_SIZE - (head & RING_MASK);
   }
-  
-  return returnValue;
+  else
+  {
+    DO_NOTHING();
+  }
+
+  if ((padding + size) <= (d_SMI_RING_SIZE - used))
+  {
+    *pStart = head + padding;
+    space = d_TRUE;
+  }
+  else
+  {
+    DO_NOTHING();
+  }
+
+  return space;
 }
 
 /*********************************************************************//**
-  <!-- semaphoreFree -->
+  <!-- ringCommit -->
 
-  Free the semaphore.
+  Publish a record written at a reserved position. The record is written
+  before the producer index is advanced.
 *************************************************************************/
-static void semaphoreFree(const Interface_t interface)
+static Uint32_t                    /** \return Ring bytes used */
+ringCommit
+(
+Ring_t * const pRing,              /**< [in] Ring */
+const Uint32_t start,              /**< [in] Byte count at the record */
+const Uint32_t length              /**< [in] Message length */
+)
 {
-  volatile Semaphore_t * pSemaphore;
+  Uint32_t head = pRing->head;
 
-  if (interface == INTERFACE_TRANSMIT)
+  if (head != start)
   {
-    pSemaphore = &bufferTx.semaphore;
+    /* Record skips the end of the ring */
+// cppcheck-suppress misra-c2012-11.3; Records are word aligned in the ring. Violation of 'Advisory' rule does not present a risk.
+    *(volatile Uint32_t *)&pRing->buffer[head & RING_MASK] = RECORD_WRAP;
   }
   else
   {
-    pSemaphore = &bufferRx.semaphore;
+    DO_NOTHING();
   }
+// cppcheck-suppress misra-c2012-11.3; Records are word aligned in the ring. Violation of 'Advisory' rule does not present a risk.
+  *(volatile Uint32_t *)&pRing->buffer[start & RING_MASK] = length;
+
+  /* Record must be visible before the index */
+  d_dmb();
+  head = start + recordSize(length);
+  pRing->head = head;
+  pRing->messagesIn = pRing->messagesIn + 1u;
+
+  return head - pRing->tail;
+}
+
+/*********************************************************************//**
+  <!-- ringPeek -->
+
+  Get the oldest record of a ring as the consumer, skipping a wrap
+  marker. The consumer index is not changed.
+*************************************************************************/
+static d_Status_t                  /** \return Function status */
+ringPeek
+(
+const Ring_t * const pRing,        /**< [in]  Ring */
+const Uint8_t ** const ppData,     /**< [out] Pointer to storage for the message address */
+Uint32_t * const pLength,          /**< [out] Pointer to storage for message length */
+Uint32_t * const pNext             /**< [out] Pointer to storage for the byte count after the record */
+)
+{
+  d_Status_t returnValue = d_STATUS_BUFFER_EMPTY;
+  Uint32_t tail = pRing->tail;
+  Uint32_t head = pRing->head;
+  Uint32_t length = 0u;
+
+  /* Records must be read after the index */
+  d_dmb();
+  if (head != tail)
+  {
+// cppcheck-suppress misra-c2012-11.3; Records are word aligned in the ring. Violation of 'Advisory' rule does not present a risk.
+    length = *(const volatile Uint32_t *)&pRing->buffer[tail & RING_MASK];
+    if (length == RECORD_WRAP)
+    {
+      tail = tail + (d_SMI_RING_SIZE - (tail & RING_MASK));
+      if (head != tail)
+      {
+// cppcheck-suppress misra-c2012-11.3; Records are word aligned in the ring. Violation of 'Advisory' rule does not present a risk.
+        length = *(const volatile Uint32_t *)&pRing->buffer[0];
+      }
+      else
+      {
+        // gcov-jst 1 It is not practical to generate this failure during bench testing.
+        length = 0u;
+      }
+    }
+    else
+    {
+      DO_NOTHING();
+    }
+
+    if ((length > 0u) && (length <= d_SMI_MAX_MESSAGE) && (recordSize(length) <= (head - tail)))
+    {
+// cppcheck-suppress misra-c2012-11.8; The message is not written by the producer until it is consumed. Violation of 'Required' rule does not present a risk.
+      *ppData = (const Uint8_t *)&pRing->buffer[(tail & RING_MASK) + RECORD_HEADER];
+      *pLength = length;
+      *pNext = tail + recordSize(length);
+      returnValue = d_STATUS_SUCCESS;
+    }
+    else
+    {
+      // gcov-jst 1 It is not practical to generate this failure during bench testing.
+      returnValue = d_STATUS_DEVICE_ERROR;
+    }
+  }
+  else
+  {
+    DO_NOTHING();
+  }
+
+  return returnValue;
+}
+
+/*********************************************************************//**
+  <!-- ringConsume -->
+
+  Release the space of the peeked record to the producer.
+*************************************************************************/
+static void                        /** \return None */
+ringConsume
+(
+Ring_t * const pRing,              /**< [in] Ring */
+const Uint32_t next                /**< [in] Byte count after the record */
+)
+{
+  /* Message must be read before the space is released */
+  d_dmb();
+  pRing->tail = next;
+  pRing->messagesOut = pRing->messagesOut + 1u;
+
+  return;
+}
+
+/*********************************************************************//**
+  <!-- doorbellRing -->
+
+  Interrupt the APU.
+*************************************************************************/
+static void                    /** \return None */
+doorbellRing
+(
+void
+)
+{
+  /* Ring indices must be written before the interrupt */
+  d_dsb();
+  d_INT_Ipi();
+  doorbellPending = 0u;
+  smiStats.doorbells++;
 
-  pSemaphore->user[interface] = d_FALSE;
-  
   return;
 }
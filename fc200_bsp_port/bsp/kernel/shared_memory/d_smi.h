@@ -31,30 +31,84 @@
 
 /***** Constants ********************************************************/
 
+/* Size in bytes of the ring in each direction, must be a power of two */
+#ifndef d_SMI_RING_SIZE
+#define d_SMI_RING_SIZE        4096u
+#endif
+
+/* Number of committed messages after which the APU is interrupted without waiting for d_SMI_Doorbell */
+#ifndef d_SMI_DOORBELL_BATCH
+#define d_SMI_DOORBELL_BATCH   8u
+#endif
+
+/* Largest message, this can always be reserved in an empty ring */
+#define d_SMI_MAX_MESSAGE      ((d_SMI_RING_SIZE / 2u) - 4u)
+
 /***** Type Definitions *************************************************/
 
+typedef struct
+{
+  Uint32_t transmitted;      /**< Messages committed to the APU */
+  Uint32_t transmitFull;     /**< Reservations refused with the ring full */
+  Uint32_t doorbells;        /**< Interrupts raised to the APU */
+  Uint32_t received;         /**< Messages consumed from the APU */
+  Uint32_t receiveErrors;    /**< Corrupt receive records discarded */
+  Uint32_t highWater;        /**< Largest number of transmit ring bytes used */
+} d_SMI_Stats_t;
+
 /***** Macros (Inline Functions) Definitions ****************************/
 
 /***** Variables ********************************************************/
 
 /***** Function Declarations ********************************************/
 
-/* Initialise the variable message length buffers */
+/* Initialise the shared memory rings, call before the APU uses them */
 void d_SMI_Initialise(void);
 
-/* Flush a variable message length/ buffer */
+/* Discard all transmit messages, only while the APU is not reading */
 void d_SMI_TransmitFlush(void);
 
-/* Flush a variable message length/ buffer */
+/* Discard all received messages */
 void d_SMI_ReceiveFlush(void);
 
-/* Write a variable length message to a buffer */
+/* Reserve space for a message in the transmit ring and get a pointer to it.
+   The message is written in place and made visible by d_SMI_TransmitCommit.
+   An uncommitted reservation is discarded by the next reservation. */
+d_Status_t d_SMI_TransmitReserve(const Uint32_t length, Uint8_t ** const ppData);
+
+/* Publish the reserved message, the length may be less than reserved. An urgent
+   message interrupts the APU at once, others wait for a batch or d_SMI_Doorbell. */
+d_Status_t d_SMI_TransmitCommit(const Uint32_t length, const Bool_t urgent);
+
+/* Copy a message to the transmit ring */
 d_Status_t d_SMI_Transmit(const Uint8_t * const pData, const Uint32_t length);
 
-/* Read a variable length message from a buffer */
+/* Interrupt the APU if messages have been committed since the last interrupt, call once per frame */
+void d_SMI_Doorbell(void);
+
+/* Background job ringing the doorbell for messages committed during the frame */
+Bool_t d_SMI_Background(void);
+
+/* Get a pointer to the oldest received message without removing it */
+d_Status_t d_SMI_ReceivePeek(const Uint8_t ** const ppData, Uint32_t * const pLength);
+
+/* Remove the message returned by d_SMI_ReceivePeek */
+d_Status_t d_SMI_ReceiveConsume(void);
+
+/* Copy the oldest received message, the buffer must hold d_SMI_MAX_MESSAGE bytes */
 d_Status_t d_SMI_Receive(Uint8_t * const pData, Uint32_t * const pLength);
 
-/* Read the number of messages in a variable length buffer */
+/* Read the number of messages received */
 d_Status_t d_SMI_ReceiveCount(Uint32_t * const pCount);
 
+/* Access to the APU side of the rings, only for a bridge standing in for an absent APU */
+d_Status_t d_SMI_BridgeTransmitPeek(const Uint8_t ** const ppData, Uint32_t * const pLength);
+
+d_Status_t d_SMI_BridgeTransmitConsume(void);
+
+d_Status_t d_SMI_BridgeReceiveWrite(const Uint8_t * const pData, const Uint32_t length);
+
+/* Get the interface statistics */
+d_Status_t d_SMI_GetStats(d_SMI_Stats_t * const pStats);
+
 #endif /* SMI_H */
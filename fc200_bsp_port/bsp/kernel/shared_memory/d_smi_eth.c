@@ -28,8 +28,30 @@
 
 /***** Constants ********************************************************/
 
+/* A bridge datagram is a header followed by records, each a length word and a message
+   padded to a word boundary. Sequence numbers start at zero when the sender starts. */
+#define BRIDGE_MAGIC        0x31424D53u    /* "SMB1" */
+#define BRIDGE_RECORD_HEADER  4u
+
 /***** Type Definitions *************************************************/
 
+/* State of a reorder slot. A slot is busy while a datagram is copied into or out of it,
+   outside the critical section. */
+typedef enum
+{
+  SLOT_FREE,
+  SLOT_BUSY,
+  SLOT_HELD
+} BridgeSlot_t;
+
+/* Bridge datagram header */
+typedef struct
+{
+  Uint32_t magic;
+  Uint32_t sequence;
+  Uint32_t count;         /* Number of records */
+} BridgeHeader_t;
+
 /* Structure of packet in shared memory message */
 typedef struct
 {
@@ -42,8 +64,32 @@ typedef struct
 
 /***** Variables ********************************************************/
 
-// cppcheck-suppress misra-c2012-8.9; Defining this large variable at the start of the module is more maintainable. Violation of 'Advisory' rule does not present a risk.
-static Uint8_t txBuffer[sizeof(d_ETH_UdpSmiPacket_t)];
+static Bool_t bridgeActive = d_FALSE;
+static Uint32_t bridgePeerAddress;
+static Uint32_t bridgePeerPort;
+static Uint32_t bridgeFlushTime;
+
+/* Transmit datagram being filled */
+static Uint8_t bridgeTxDatagram[d_ETH_MAX_UDP_PACKET_DATA] __attribute__ ((aligned (4)));
+static Uint32_t bridgeTxLength;
+static Uint32_t bridgeTxCount;
+static Uint32_t bridgeTxFirstTime;
+static Uint32_t bridgeTxSequence;
+
+/* Receive sequence and datagrams held for reordering. The indices and slot states are
+   changed in critical sections, the datagrams are copied outside them. Only the context
+   holding the delivery claim writes to the receive ring. */
+static Bool_t bridgeRxDelivering;
+static Bool_t bridgeRxSynchronised;
+static Uint32_t bridgeRxExpected;
+static Uint32_t bridgeRxHeldCount;
+static Uint32_t bridgeRxHeldTime;
+static BridgeSlot_t bridgeRxSlot[d_SMI_ETH_REORDER_WINDOW];
+static Uint32_t bridgeRxHeldSequence[d_SMI_ETH_REORDER_WINDOW];
+static Uint32_t bridgeRxHeldLength[d_SMI_ETH_REORDER_WINDOW];
+static Uint8_t bridgeRxHeldData[d_SMI_ETH_REORDER_WINDOW][d_ETH_MAX_UDP_PACKET_DATA];
+
+static d_SMI_EthBridgeStats_t bridgeStats;
 
 /***** Function Declarations ********************************************/
 
@@ -53,6 +99,19 @@ static void ReceiveCallback(const d_ETH_Ipv4Addr_t sourceAddress,
                             const Uint8_t * const buffer, 
                             const Uint32_t length);
 
+static void BridgeReceiveCallback(const d_ETH_Ipv4Addr_t sourceAddress,
+                                  const Uint16_t sourcePort, 
+                                  const Uint16_t destinationPort, 
+                                  const Uint8_t * const buffer, 
+                                  const Uint32_t length);
+static Bool_t bridgeTransmit(void);
+static void bridgeDatagramSend(void);
+static void bridgeDatagramDeliver(const Uint8_t * const pDatagram, const Uint32_t length);
+static void bridgeDatagramHold(const Uint8_t * const pDatagram, const Uint32_t length, const Uint32_t sequence);
+static Bool_t bridgeDeliveryClaim(void);
+static void bridgeHeldRelease(const Bool_t skipMissing);
+static Uint32_t bridgeRecordSize(const Uint32_t length);
+
 /***** Function Definitions *********************************************/
 
 /*********************************************************************//**
@@ -103,20 +162,29 @@ const Uint32_t length                  /**< [in] data length */
 )
 {
   d_ETH_UdpSmiPacket_t * pPacket;
+  Uint8_t * pMessage;
 
-  // cppcheck-suppress misra-c2012-11.3; The ARM processor does not have any alignment restrictions for integers.
-  *(Uint32_t *)&txBuffer[0] = 0; /* Specifiy ethernet type message */
+  /* Build the message in place in the shared memory ring */
+  if (d_SMI_TransmitReserve(20u + length, &pMessage) == d_STATUS_SUCCESS)
+  {
+    // cppcheck-suppress misra-c2012-11.3; The ARM processor does not have any alignment restrictions for integers.
+    *(Uint32_t *)&pMessage[0] = 0; /* Specifiy ethernet type message */
 
-  // cppcheck-suppress misra-c2012-11.3; The ARM processor does not have any alignment restrictions for integers.
-  pPacket = (d_ETH_UdpSmiPacket_t *)&txBuffer[4];
-  pPacket->ipAddress = sourceAddress;
-  pPacket->sourcePort = sourcePort;
-  pPacket->destinationPort = destinationPort;
-  pPacket->payloadLength = length;
-  d_GEN_MemoryCopy(pPacket->payload, &buffer[0], length);
+    // cppcheck-suppress misra-c2012-11.3; The ARM processor does not have any alignment restrictions for integers.
+    pPacket = (d_ETH_UdpSmiPacket_t *)&pMessage[4];
+    pPacket->ipAddress = sourceAddress;
+    pPacket->sourcePort = sourcePort;
+    pPacket->destinationPort = destinationPort;
+    pPacket->payloadLength = length;
+    d_GEN_MemoryCopy(pPacket->payload, &buffer[0], length);
   
-  /* Send the message to the APU */
-  (void)d_SMI_Transmit(txBuffer, 20u + length);
+    /* Send the message to the APU */
+    (void)d_SMI_TransmitCommit(20u + length, d_FALSE);
+  }
+  else
+  {
+    DO_NOTHING();
+  }
   
   return;
 }
@@ -154,3 +222,557 @@ const Uint32_t length
   return status;
 }
 
+/*********************************************************************//**
+  <!-- d_SMI_EthBridgeStart -->
+
+  Start carrying the shared memory rings over UDP to a peer standing in
+  for the APU.
+*************************************************************************/
+d_Status_t                         /** \return Function status */
+d_SMI_EthBridgeStart
+(
+const Uint32_t peerAddress,        /**< [in] Peer IP address */
+const Uint32_t peerPort,           /**< [in] Peer UDP port */
+const Uint32_t localPort,          /**< [in] Local UDP port receiving from the peer */
+const Uint32_t flushMicroseconds   /**< [in] Longest time a transmit message waits for a full datagram */
+)
+{
+  Uint32_t index;
+
+  bridgeActive = d_FALSE;
+  bridgePeerAddress = peerAddress;
+  bridgePeerPort = peerPort;
+  bridgeFlushTime = flushMicroseconds;
+
+  bridgeTxLength = sizeof(BridgeHeader_t);
+  bridgeTxCount = 0u;
+  bridgeTxSequence = 0u;
+
+  bridgeRxSynchronised = d_FALSE;
+  bridgeRxDelivering = d_FALSE;
+  bridgeRxExpected = 0u;
+  bridgeRxHeldCount = 0u;
+  for (index = 0u; index < d_SMI_ETH_REORDER_WINDOW; index++)
+  {
+    bridgeRxSlot[index] = SLOT_FREE;
+  }
+  d_GEN_MemorySet((Uint8_t *)&bridgeStats, 0u, sizeof(bridgeStats));
+
+  d_Status_t status = d_ETH_UdpListen(localPort, BridgeReceiveCallback);
+  if (status == d_STATUS_SUCCESS)
+  {
+    bridgeActive = d_TRUE;
+  }
+  else
+  {
+    DO_NOTHING();
+  }
+
+  return status;
+}
+
+/*********************************************************************//**
+  <!-- d_SMI_EthBridgeBackground -->
+
+  Background job of the bridge. Sends at most one transmit datagram,
+  delivers held datagrams that are in sequence and gives up on a missing
+  receive datagram once the reorder timeout has passed.
+*************************************************************************/
+Bool_t                    /** \return Further processing required */
+d_SMI_EthBridgeBackground
+(
+void
+)
+{
+  Bool_t more = d_FALSE;
+
+  if (bridgeActive == d_TRUE)
+  {
+    more = bridgeTransmit();
+
+    Uint32_t interruptFlags = d_INT_CriticalSectionEnter();
+    Bool_t timeout = ((bridgeRxHeldCount > 0u) && (d_TIMER_ElapsedMicroseconds(bridgeRxHeldTime, NULL) > d_SMI_ETH_REORDER_TIMEOUT_US)) ? d_TRUE : d_FALSE;
+    d_INT_CriticalSectionLeave(interruptFlags);
+
+    /* Skip the missing datagrams before the next one held on a timeout */
+    if (bridgeDeliveryClaim() == d_TRUE)
+    {
+      bridgeHeldRelease(timeout);
+      bridgeRxDelivering = d_FALSE;
+    }
+    else
+    {
+      DO_NOTHING();
+    }
+  }
+  else
+  {
+    DO_NOTHING();
+  }
+
+  return more;
+}
+
+/*********************************************************************//**
+  <!-- d_SMI_EthBridgeGetStats -->
+
+  Get the bridge statistics.
+*************************************************************************/
+d_Status_t                             /** \return Function status */
+d_SMI_EthBridgeGetStats
+(
+d_SMI_EthBridgeStats_t * const pStats  /**< [out] Pointer to storage for the statistics */
+)
+{
+  d_Status_t returnValue = d_STATUS_SUCCESS;
+
+  if (pStats == NULL)
+  {
+    d_ERROR_Logger(d_STATUS_INVALID_PARAMETER, d_ERROR_CRITICALITY_CRITICAL_SHUTDOWN, 1, 0, 0, 0);
+    returnValue = d_STATUS_INVALID_PARAMETER;
+  }
+  else
+  {
+    *pStats = bridgeStats;
+  }
+
+  return returnValue;
+}
+
+/*********************************************************************//**
+  <!-- BridgeReceiveCallback -->
+
+  Callback function when a bridge datagram is received. Datagrams are
+  delivered in sequence, those ahead of a missing one are held. Only the
+  sequence and slot states are changed in critical sections, datagrams
+  are copied outside them.
+*************************************************************************/
+static void                            /** \return None */
+BridgeReceiveCallback
+(
+const d_ETH_Ipv4Addr_t sourceAddress,  /**< [in] source IP address */
+const Uint16_t sourcePort,             /**< [in] source port number */
+const Uint16_t destinationPort,        /**< [in] destination port number */
+const Uint8_t * const buffer,          /**< [in] packet buffer */
+const Uint32_t length                  /**< [in] data length */
+)
+{
+  BridgeHeader_t header;
+
+  UNUSED_PARAMETER(sourcePort);
+  UNUSED_PARAMETER(destinationPort);
+
+  if ((sourceAddress != bridgePeerAddress) || (length < sizeof(BridgeHeader_t)) || (length > d_ETH_MAX_UDP_PACKET_DATA))
+  {
+    bridgeStats.malformed++;
+  }
+  else
+  {
+    d_GEN_MemoryCopy((Uint8_t *)&header, buffer, sizeof(header));
+    if (header.magic != BRIDGE_MAGIC)
+    {
+      bridgeStats.malformed++;
+    }
+    else
+    {
+      Bool_t deliver = d_FALSE;
+      Bool_t hold = d_FALSE;
+      Uint32_t interruptFlags = d_INT_CriticalSectionEnter();
+
+      /* The peer starts at sequence zero, so zero also resynchronises after a peer restart */
+      Bool_t resynchronise = ((bridgeRxSynchronised == d_FALSE) || (header.sequence == 0u)) ? d_TRUE : d_FALSE;
+      Uint32_t ahead = header.sequence - bridgeRxExpected;
+      if ((resynchronise == d_FALSE) && (ahead >= 0x80000000u))
+      {
+        /* Behind the sequence, already delivered or counted as lost */
+        bridgeStats.duplicates++;
+      }
+      else if ((resynchronise == d_FALSE) && (ahead > 0u) && (ahead < d_SMI_ETH_REORDER_WINDOW))
+      {
+        hold = d_TRUE;
+      }
+      else if (bridgeRxDelivering == d_FALSE)
+      {
+        /* In sequence, resynchronising or too far ahead to hold, delivered directly */
+        bridgeRxDelivering = d_TRUE;
+        deliver = d_TRUE;
+      }
+      else if ((resynchronise == d_FALSE) && (ahead == 0u))
+      {
+        /* This callback has interrupted a delivery, which releases the datagram once held */
+        hold = d_TRUE;
+      }
+      else
+      {
+        // gcov-jst 1 It is not practical to generate this failure during bench testing.
+        bridgeStats.lost++;
+      }
+      d_INT_CriticalSectionLeave(interruptFlags);
+
+      if (hold == d_TRUE)
+      {
+        bridgeDatagramHold(buffer, length, header.sequence);
+      }
+      else if (deliver == d_TRUE)
+      {
+        if ((resynchronise == d_TRUE) || (ahead != 0u))
+        {
+          /* Deliver the datagrams held before the jump, counting the missing ones between them as lost */
+          while (bridgeRxHeldCount > 0u)
+          {
+            bridgeHeldRelease(d_TRUE);
+          }
+        }
+        else
+        {
+          DO_NOTHING();
+        }
+
+        interruptFlags = d_INT_CriticalSectionEnter();
+        if (resynchronise == d_FALSE)
+        {
+          bridgeStats.lost = bridgeStats.lost + (header.sequence - bridgeRxExpected);
+        }
+        else
+        {
+          DO_NOTHING();
+        }
+        bridgeRxSynchronised = d_TRUE;
+        bridgeRxExpected = header.sequence + 1u;
+        d_INT_CriticalSectionLeave(interruptFlags);
+
+        bridgeDatagramDeliver(buffer, length);
+        bridgeHeldRelease(d_FALSE);
+        bridgeRxDelivering = d_FALSE;
+      }
+      else
+      {
+        DO_NOTHING();
+      }
+    }
+  }
+
+  return;
+}
+
+/*********************************************************************//**
+  <!-- bridgeTransmit -->
+
+  Move transmit messages into the datagram being filled, sending it when
+  full or when its oldest message has waited the flush time.
+*************************************************************************/
+static Bool_t             /** \return Further processing required */
+bridgeTransmit
+(
+void
+)
+{
+  Bool_t more = d_FALSE;
+  Bool_t sent = d_FALSE;
+  const Uint8_t * pMessage;
+  Uint32_t length;
+
+  while ((sent == d_FALSE) && (d_SMI_BridgeTransmitPeek(&pMessage, &length) == d_STATUS_SUCCESS))
+  {
+    Uint32_t size = bridgeRecordSize(length);
+    if (size > (d_ETH_MAX_UDP_PACKET_DATA - sizeof(BridgeHeader_t)))
+    {
+      bridgeStats.oversize++;
+      (void)d_SMI_BridgeTransmitConsume();
+    }
+    else if ((bridgeTxLength + size) > d_ETH_MAX_UDP_PACKET_DATA)
+    {
+      /* Datagram full, the message starts the next one */
+      bridgeDatagramSend();
+      sent = d_TRUE;
+      more = d_TRUE;
+    }
+    else
+    {
+      if (bridgeTxCount == 0u)
+      {
+        (void)d_TIMER_ElapsedMicroseconds(0u, &bridgeTxFirstTime);
+      }
+      else
+      {
+        DO_NOTHING();
+      }
+// cppcheck-suppress misra-c2012-11.3; The datagram buffer and records are word aligned. Violation of 'Advisory' rule does not present a risk.
+      *(Uint32_t *)&bridgeTxDatagram[bridgeTxLength] = length;
+      d_GEN_MemoryCopy(&bridgeTxDatagram[bridgeTxLength + BRIDGE_RECORD_HEADER], pMessage, length);
+      bridgeTxLength = bridgeTxLength + size;
+      bridgeTxCount++;
+      (void)d_SMI_BridgeTransmitConsume();
+    }
+  }
+
+  if ((sent == d_FALSE) && (bridgeTxCount > 0u) && (d_TIMER_ElapsedMicroseconds(bridgeTxFirstTime, NULL) >= bridgeFlushTime))
+  {
+    bridgeDatagramSend();
+  }
+  else
+  {
+    DO_NOTHING();
+  }
+
+  return more;
+}
+
+/*********************************************************************//**
+  <!-- bridgeDatagramSend -->
+
+  Send the datagram being filled and start the next.
+*************************************************************************/
+static void               /** \return None */
+bridgeDatagramSend
+(
+void
+)
+{
+  BridgeHeader_t header;
+
+  header.magic = BRIDGE_MAGIC;
+  header.sequence = bridgeTxSequence;
+  header.count = bridgeTxCount;
+  d_GEN_MemoryCopy(bridgeTxDatagram, (const Uint8_t *)&header, sizeof(header));
+
+  if (d_ETH_UdpSend(bridgePeerAddress, bridgePeerPort, bridgeTxDatagram, bridgeTxLength) == d_STATUS_SUCCESS)
+  {
+    bridgeStats.datagramsSent++;
+    bridgeStats.messagesSent = bridgeStats.messagesSent + bridgeTxCount;
+  }
+  else
+  {
+    bridgeStats.sendErrors++;
+  }
+
+  /* The sequence advances even if the send failed, so the peer sees the loss */
+  bridgeTxSequence++;
+  bridgeTxLength = sizeof(BridgeHeader_t);
+  bridgeTxCount = 0u;
+
+  return;
+}
+
+/*********************************************************************//**
+  <!-- bridgeDatagramDeliver -->
+
+  Write the messages of an in sequence datagram to the receive ring.
+*************************************************************************/
+static void                        /** \return None */
+bridgeDatagramDeliver
+(
+const Uint8_t * const pDatagram,   /**< [in] Datagram */
+const Uint32_t length              /**< [in] Datagram length */
+)
+{
+  BridgeHeader_t header;
+  Uint32_t offset = sizeof(BridgeHeader_t);
+  Uint32_t record = 0u;
+  Bool_t valid = d_TRUE;
+
+  d_GEN_MemoryCopy((Uint8_t *)&header, pDatagram, sizeof(header));
+  bridgeStats.datagramsReceived++;
+
+  while ((record < header.count) && (valid == d_TRUE))
+  {
+    Uint32_t messageLength = 0u;
+    if ((offset + BRIDGE_RECORD_HEADER) <= length)
+    {
+      d_GEN_MemoryCopy((Uint8_t *)&messageLength, &pDatagram[offset], BRIDGE_RECORD_HEADER);
+    }
+    else
+    {
+      DO_NOTHING();
+    }
+
+    if ((messageLength == 0u) || (messageLength > (length - offset - BRIDGE_RECORD_HEADER)))
+    {
+      bridgeStats.malformed++;
+      valid = d_FALSE;
+    }
+    else
+    {
+      if (d_SMI_BridgeReceiveWrite(&pDatagram[offset + BRIDGE_RECORD_HEADER], messageLength) == d_STATUS_SUCCESS)
+      {
+        bridgeStats.messagesReceived++;
+      }
+      else
+      {
+        bridgeStats.overflow++;
+      }
+      offset = offset + bridgeRecordSize(messageLength);
+      record++;
+    }
+  }
+
+  return;
+}
+
+/*********************************************************************//**
+  <!-- bridgeDatagramHold -->
+
+  Hold a datagram received ahead of sequence. The slot is reserved in a
+  critical section and the datagram copied to it outside.
+*************************************************************************/
+static void                        /** \return None */
+bridgeDatagramHold
+(
+const Uint8_t * const pDatagram,   /**< [in] Datagram */
+const Uint32_t length,             /**< [in] Datagram length */
+const Uint32_t sequence            /**< [in] Datagram sequence number */
+)
+{
+  Uint32_t slot = sequence % d_SMI_ETH_REORDER_WINDOW;
+  Bool_t reserved = d_FALSE;
+  Uint32_t interruptFlags = d_INT_CriticalSectionEnter();
+
+  if (bridgeRxSlot[slot] == SLOT_FREE)
+  {
+    bridgeRxSlot[slot] = SLOT_BUSY;
+    bridgeRxHeldSequence[slot] = sequence;
+    bridgeRxHeldLength[slot] = length;
+    reserved = d_TRUE;
+  }
+  else
+  {
+    bridgeStats.duplicates++;
+  }
+  d_INT_CriticalSectionLeave(interruptFlags);
+
+  if (reserved == d_TRUE)
+  {
+    d_GEN_MemoryCopy(bridgeRxHeldData[slot], pDatagram, length);
+
+    interruptFlags = d_INT_CriticalSectionEnter();
+    bridgeRxSlot[slot] = SLOT_HELD;
+    if (bridgeRxHeldCount == 0u)
+    {
+      (void)d_TIMER_ElapsedMicroseconds(0u, &bridgeRxHeldTime);
+    }
+    else
+    {
+      DO_NOTHING();
+    }
+    bridgeRxHeldCount++;
+    if (sequence != bridgeRxExpected)
+    {
+      bridgeStats.reordered++;
+    }
+    else
+    {
+      DO_NOTHING();
+    }
+    d_INT_CriticalSectionLeave(interruptFlags);
+  }
+  else
+  {
+    DO_NOTHING();
+  }
+
+  return;
+}
+
+/*********************************************************************//**
+  <!-- bridgeDeliveryClaim -->
+
+  Claim the delivery of datagrams to the receive ring. The claim is
+  released by clearing bridgeRxDelivering.
+*************************************************************************/
+static Bool_t             /** \return Delivery claimed */
+bridgeDeliveryClaim
+(
+void
+)
+{
+  Bool_t claimed = d_FALSE;
+  Uint32_t interruptFlags = d_INT_CriticalSectionEnter();
+
+  if (bridgeRxDelivering == d_FALSE)
+  {
+    bridgeRxDelivering = d_TRUE;
+    claimed = d_TRUE;
+  }
+  else
+  {
+    DO_NOTHING();
+  }
+  d_INT_CriticalSectionLeave(interruptFlags);
+
+  return claimed;
+}
+
+/*********************************************************************//**
+  <!-- bridgeHeldRelease -->
+
+  Deliver the held datagrams that are now in sequence, with the delivery
+  claimed. With skipMissing, the missing datagrams before the next one
+  held are first counted as lost. The sequence is advanced in a critical
+  section before each datagram is copied out of its slot.
+*************************************************************************/
+static void                  /** \return None */
+bridgeHeldRelease
+(
+const Bool_t skipMissing     /**< [in] Skip a gap before the next held datagram */
+)
+{
+  Bool_t skip = skipMissing;
+  Bool_t released = d_FALSE;
+  Bool_t done = d_FALSE;
+
+  while (done == d_FALSE)
+  {
+    Uint32_t interruptFlags = d_INT_CriticalSectionEnter();
+    Uint32_t slot = bridgeRxExpected % d_SMI_ETH_REORDER_WINDOW;
+
+    if ((bridgeRxSlot[slot] == SLOT_HELD) && (bridgeRxHeldSequence[slot] == bridgeRxExpected))
+    {
+      bridgeRxSlot[slot] = SLOT_BUSY;
+      bridgeRxHeldCount--;
+      bridgeRxExpected++;
+      d_INT_CriticalSectionLeave(interruptFlags);
+
+      bridgeDatagramDeliver(bridgeRxHeldData[slot], bridgeRxHeldLength[slot]);
+
+      interruptFlags = d_INT_CriticalSectionEnter();
+      bridgeRxSlot[slot] = SLOT_FREE;
+      skip = d_FALSE;
+      released = d_TRUE;
+    }
+    else if ((skip == d_TRUE) && (bridgeRxHeldCount > 0u))
+    {
+      bridgeStats.lost++;
+      bridgeRxExpected++;
+    }
+    else
+    {
+      /* Datagrams still held wait a further timeout */
+      if ((released == d_TRUE) && (bridgeRxHeldCount > 0u))
+      {
+        (void)d_TIMER_ElapsedMicroseconds(0u, &bridgeRxHeldTime);
+      }
+      else
+      {
+        DO_NOTHING();
+      }
+      done = d_TRUE;
+    }
+    d_INT_CriticalSectionLeave(interruptFlags);
+  }
+
+  return;
+}
+
+/*********************************************************************//**
+  <!-- bridgeRecordSize -->
+
+  Size in a datagram of the record holding a message.
+*************************************************************************/
+static Uint32_t                /** \return Record size in bytes */
+bridgeRecordSize
+(
+const Uint32_t length          /**< [in] Message length */
+)
+{
+  return BRIDGE_RECORD_HEADER + ((length + 3u) & ~3u);
+}
@@ -22,8 +22,33 @@
 
 /***** Constants ********************************************************/
 
+/* Number of datagrams received ahead of a missing one that are held for reordering */
+#ifndef d_SMI_ETH_REORDER_WINDOW
+#define d_SMI_ETH_REORDER_WINDOW      4u
+#endif
+
+/* Time a missing datagram is waited for before it is counted as lost */
+#ifndef d_SMI_ETH_REORDER_TIMEOUT_US
+#define d_SMI_ETH_REORDER_TIMEOUT_US  2000u
+#endif
+
 /***** Type Definitions *************************************************/
 
+typedef struct
+{
+  Uint32_t datagramsSent;      /**< Datagrams sent to the peer */
+  Uint32_t messagesSent;       /**< Transmit messages sent to the peer */
+  Uint32_t sendErrors;         /**< Datagrams refused by the ethernet interface */
+  Uint32_t oversize;           /**< Transmit messages too large for a datagram, discarded */
+  Uint32_t datagramsReceived;  /**< Datagrams delivered in sequence */
+  Uint32_t messagesReceived;   /**< Messages written to the receive ring */
+  Uint32_t reordered;          /**< Datagrams received ahead of sequence and held */
+  Uint32_t duplicates;         /**< Datagrams received twice or too late */
+  Uint32_t lost;               /**< Datagrams missing from the sequence */
+  Uint32_t malformed;          /**< Datagrams with an invalid header or record */
+  Uint32_t overflow;           /**< Messages discarded with the receive ring full */
+} d_SMI_EthBridgeStats_t;
+
 /***** Macros (Inline Functions) Definitions ****************************/
 
 /***** Variables ********************************************************/
@@ -39,4 +64,15 @@ d_Status_t d_SMI_EthPortAdd(const Uint32_t port);
 /* Send packet as received from SMI */
 d_Status_t d_SMI_EthTransmit(const Uint8_t * const buffer, const Uint32_t length);
 
+/* Carry the shared memory rings over UDP to a peer standing in for the APU. Transmit
+   messages are combined into datagrams sent when full or when the oldest message has
+   waited flushMicroseconds. */
+d_Status_t d_SMI_EthBridgeStart(const Uint32_t peerAddress, const Uint32_t peerPort, const Uint32_t localPort, const Uint32_t flushMicroseconds);
+
+/* Background job sending transmit datagrams and resolving missing receive datagrams */
+Bool_t d_SMI_EthBridgeBackground(void);
+
+/* Get the bridge statistics */
+d_Status_t d_SMI_EthBridgeGetStats(d_SMI_EthBridgeStats_t * const pStats);
+
 #endif /* SMI_ETH_H */
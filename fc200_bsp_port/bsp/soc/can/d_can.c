@@ -482,7 +482,7 @@ d_CAN_Message_t * const pMessage  /**< [out] Pointer to storage for received mes
   {
     pMessage->extended = (frame[0] >> 19u) & 0x01u;
     pMessage->id = (frame[0] >> 21u) & 0x7FFu;
-    pMessage->exId = (frame[0] >> 1u) & 0x3FFFu;
+    pMessage->exId = (frame[0] >> 1u) & 0x3FFFFu;
     pMessage->substituteRemoteTxRequest = (frame[0] >> 20u) & 0x01u;;
     pMessage->remoteTxRequest = frame[0] & 0x01u;;
     pMessage->dataLength = (frame[1] >> 28u) & 0x0Fu;
@@ -785,6 +785,59 @@ const Uint32_t value              /**< [in] Value to write */
   return d_STATUS_SUCCESS;
 }
 
+/*********************************************************************//**
+  <!-- d_CAN_ErrorStateGet -->
+
+  Get the error counters and fault confinement state. The error status
+  register flags are cleared once read so each call returns the errors
+  detected since the previous call.
+*************************************************************************/
+d_Status_t                          /** \return Success or Failure */
+d_CAN_ErrorStateGet
+(
+const Uint32_t channel,             /**< [in]  CAN channel number */
+d_CAN_ErrorState_t * const pState   /**< [out] Pointer to storage for the error state */
+)
+{
+  if (channel >= d_CAN_Count)
+  {
+    d_ERROR_Logger(d_STATUS_INVALID_PARAMETER, d_ERROR_CRITICALITY_CRITICAL_SHUTDOWN, 1, channel, 0, 0);
+    // cppcheck-suppress misra-c2012-15.5; Coding standard allows function to return if parameters are invalid
+    return d_STATUS_INVALID_PARAMETER;
+  }
+
+  if (ChannelStatus[channel].initialised != d_TRUE)
+  {
+    d_ERROR_Logger(d_STATUS_NOT_INITIALISED, d_ERROR_CRITICALITY_CRITICAL_SHUTDOWN, 1, channel, 0, 0);
+    // cppcheck-suppress misra-c2012-15.5; Coding standard allows function to return if parameters are invalid
+    return d_STATUS_NOT_INITIALISED;
+  }
+
+  if (pState == NULL)
+  {
+    d_ERROR_Logger(d_STATUS_INVALID_PARAMETER, d_ERROR_CRITICALITY_CRITICAL_SHUTDOWN, 2, 0, 0, 0);
+    // cppcheck-suppress misra-c2012-15.5; Coding standard allows function to return if parameters are invalid
+    return d_STATUS_INVALID_PARAMETER;
+  }
+
+  Uint32_t errorCounters = canReadReg(channel, d_CAN_REGISTER_ECR_OFFSET);
+  Uint32_t errorStatus = canReadReg(channel, d_CAN_REGISTER_ESR_OFFSET);
+  Uint32_t faultState = (canReadReg(channel, d_CAN_REGISTER_SR_OFFSET) & d_CAN_SR_ESTAT_MASK) >> d_CAN_SR_ESTAT_SHIFT;
+
+  /* The error status flags are write one to clear */
+  canWriteReg(channel, d_CAN_REGISTER_ESR_OFFSET, errorStatus);
+
+  pState->txErrorCount = errorCounters & d_CAN_ECR_TEC_MASK;
+  pState->rxErrorCount = (errorCounters & d_CAN_ECR_REC_MASK) >> d_CAN_ECR_REC_SHIFT;
+  pState->errorFlags = errorStatus & (d_CAN_ESR_ACKER_MASK | d_CAN_ESR_BERR_MASK | d_CAN_ESR_STER_MASK | d_CAN_ESR_FMER_MASK | d_CAN_ESR_CRCER_MASK);
+
+  /* Fault confinement state, 1 error active, 2 bus off and 3 error passive */
+  pState->errorPassive = (faultState == 3u) ? d_TRUE : d_FALSE;
+  pState->busOff = (faultState == 2u) ? d_TRUE : d_FALSE;
+
+  return d_STATUS_SUCCESS;
+}
+
 /*********************************************************************/ /**
    <!-- d_CAN_ProgramCanIdFilter -->
 
@@ -112,6 +112,15 @@ typedef struct
   Uint8_t data[8];
 } d_CAN_Message_t;
 
+typedef struct
+{
+  Uint32_t txErrorCount;   /**< Transmit error counter */
+  Uint32_t rxErrorCount;   /**< Receive error counter */
+  Uint32_t errorFlags;     /**< Error status register flags latched since the last call */
+  Bool_t errorPassive;     /**< Controller is error passive */
+  Bool_t busOff;           /**< Controller is bus off */
+} d_CAN_ErrorState_t;
+
 /***** Variables ********************************************************/
 
 /***** Function Declarations ********************************************/
@@ -152,6 +161,9 @@ d_Status_t d_CAN_RegisterRead(const Uint32_t channel, const Uint32_t regOffset,
 /* Write a CAN register */
 d_Status_t d_CAN_RegisterWrite(const Uint32_t channel, const Uint32_t regOffset, const Uint32_t value);
 
+/* Get the error counters and fault confinement state */
+d_Status_t d_CAN_ErrorStateGet(const Uint32_t channel, d_CAN_ErrorState_t * const pState);
+
 /* Program CAN Filtering on a single ID or a range of IDs */
 d_Status_t d_CAN_ProgramCanIdFilter(const Uint32_t channel, Bool_t isSingleIdFilter, const d_CAN_Message_t *const pCanId, const d_CAN_Message_t *const pCanIdRangeEnd);
 
@@ -428,6 +428,63 @@ const Uint32_t channel     /**< [in] DMA channel number */
   return status;
 }
 
+/*********************************************************************//**
+  <!-- d_DMA_TransferStatus -->
+
+  Get the completion status of the last transfer started on a channel.
+  The channel is returned to idle when the transfer has finished, so a
+  channel can be used without its interrupt enabled.
+*************************************************************************/
+d_Status_t                 /** \return Success, busy or hardware error */
+d_DMA_TransferStatus
+(
+const Uint32_t channel     /**< [in] DMA channel number */
+)
+{
+  d_Status_t status = d_STATUS_SUCCESS;
+
+  if (channel >= (Uint32_t)XPAR_XZDMA_NUM_INSTANCES)
+  {
+    d_ERROR_Logger(d_STATUS_INVALID_PARAMETER, d_ERROR_CRITICALITY_CRITICAL_SHUTDOWN, 1, channel, 0, 0);
+    // cppcheck-suppress misra-c2012-15.5; Coding standard allows function to return if parameters are invalid
+    return d_STATUS_INVALID_PARAMETER;
+  }
+
+  if (channelStatus[channel].IsReady != d_TRUE)
+  {
+    d_ERROR_Logger(d_STATUS_NOT_INITIALISED, d_ERROR_CRITICALITY_CRITICAL_SHUTDOWN, 0, channel, 0, 0);
+    // cppcheck-suppress misra-c2012-15.5; Coding standard allows function to return if parameters are invalid
+    return d_STATUS_NOT_INITIALISED;
+  }
+
+  if (channelStatus[channel].ChannelState == d_DMA_STATE_BUSY)
+  {
+    Uint32_t value = dmaReadReg(channel, (XZDMA_CH_STS_OFFSET)) & (XZDMA_STS_ALL_MASK);
+
+    if ((value == XZDMA_STS_DONE_MASK) || (value == XZDMA_STS_DONE_ERR_MASK))
+    {
+      if (value == XZDMA_STS_DONE_ERR_MASK)
+      {
+        // gcov-jst 1 It is not possible to generate this failure during bench testing.
+        status = d_STATUS_HARDWARE_ERROR;
+      }
+      ELSE_DO_NOTHING
+
+      /* Completion interrupts are not needed once the state is read */
+      dmaInterruptDisable(channel, XZDMA_IXR_ALL_INTR_MASK);
+      dmaInterruptClear(channel, XZDMA_IXR_ALL_INTR_MASK);
+      channelStatus[channel].ChannelState = d_DMA_STATE_IDLE;
+    }
+    else
+    {
+      status = d_STATUS_DEVICE_BUSY;
+    }
+  }
+  ELSE_DO_NOTHING
+
+  return status;
+}
+
 /*********************************************************************//**
   <!-- d_DMA_SelfTest -->
 
@@ -51,6 +51,9 @@ d_Status_t d_DMA_SelfTest(const Uint32_t channel);
 /* Test if DMA transfer is complete, function is non-blocking */
 d_DMA_State_t d_DMA_ChannelState(const Uint32_t channel);
 
+/* Get the completion status of the last transfer, function is non-blocking */
+d_Status_t d_DMA_TransferStatus(const Uint32_t channel);
+
 /* Start a DMA PS to PS memory transfer */
 d_Status_t d_DMA_StartMemToMemTransfer(const Uint32_t channel, const Uint8_t * const destination, const Uint8_t * const source, const Uint32_t byteCount);
 
@@ -0,0 +1,665 @@
+/******[Configuration Header]*****************************************//**
+\file
+\brief
+  Module Title       : DMA memory copy
+
+  Abstract           : Memory copy service choosing between the CPU and
+                       a DMA channel according to the length of the copy.
+                       The DMA moves the whole cache lines of the
+                       destination, the CPU copies any partial line at
+                       either end while the DMA runs, so cache maintenance
+                       never touches data outside the destination.
+                       The DMA is used only from thread context with
+                       interrupts enabled: a copy made by an interrupt
+                       handler or inside a critical section is made by the
+                       CPU, so that the handler never spins on the DMA or
+                       takes the channel from the code it interrupted.
+
+  Software Structure : SRS References: 136T-2200-131000-001-D22 SWREQ-146
+                       SDD References: 136T-2200-131000-001-D22 SWDES-120
+\note
+  CSC ID             : SWDES-49
+*************************************************************************/
+
+/***** Includes *********************************************************/
+
+#include "soc/defines/d_common_types.h"
+#include "soc/defines/d_common_status.h"
+#include "soc/defines/d_common_asm.h"
+#include "soc/memory_manager/d_memory_cache.h"
+#include "soc/interrupt_manager/d_int_critical.h"
+#include "soc/timer/d_timer.h"
+#include "kernel/general/d_gen_memory.h"
+#include "kernel/error_handler/d_error_handler.h"
+
+#include "d_dma.h"
+#include "d_dma_copy.h"
+
+/***** Constants ********************************************************/
+
+#define CACHE_LINE_SIZE   32u
+
+/* The tightly coupled memories are seen by the DMA at different addresses, so copies below this use the CPU */
+#define TCM_LOCAL_END     0x00040000u
+
+/* Time allowed for a DMA copy, plus 1 ms per 256 kB */
+#define COPY_TIMEOUT_MS   2u
+
+/* Number of copies timed for each length during calibration */
+#define CALIBRATION_REPEATS       8u
+#define CALIBRATION_FIRST_LENGTH  256u
+
+/* Processor mode and IRQ mask bits of the CPSR. The application runs in
+   system mode, interrupt handlers in IRQ, FIQ or supervisor mode */
+#define CPSR_MODE_MASK    0x1Fu
+#define CPSR_MODE_USER    0x10u
+#define CPSR_MODE_SYSTEM  0x1Fu
+#define CPSR_IRQ_MASKED   0x80u
+
+/* Threshold when the DMA is never faster */
+#define THRESHOLD_NEVER   0xFFFFFFFFu
+
+/***** Type Definitions *************************************************/
+
+/* Part of a copy made by the DMA */
+typedef struct
+{
+  Uint8_t * pDestination;
+  Uint32_t length;
+  Uint32_t startTime;
+} dmaCopy_t;
+
+/***** Variables ********************************************************/
+
+static Bool_t initialised = d_FALSE;
+
+/* Set while a copy owns the channel */
+static Bool_t channelInUse = d_FALSE;
+
+static Uint32_t copyThreshold = d_DMA_COPY_THRESHOLD;
+
+static d_DMA_CopyStats_t copyStats;
+
+/* Asynchronous copy in progress */
+static Bool_t asyncActive = d_FALSE;
+static dmaCopy_t asyncCopy;
+static d_DMA_CopyCallback_t asyncCallback;
+static void * pAsyncContext;
+
+/***** Function Declarations ********************************************/
+
+static Bool_t threadContext(void);
+static Bool_t channelClaim(void);
+static void channelRelease(void);
+static Bool_t dmaCapable(const Uint8_t * const pDestination, const Uint8_t * const pSource, const Uint32_t length);
+static d_Status_t copyStart(Uint8_t * const pDestination, const Uint8_t * const pSource, const Uint32_t length,
+                            dmaCopy_t * const pCopy);
+static d_Status_t copyCheck(const dmaCopy_t * const pCopy);
+static d_Status_t copyWait(const dmaCopy_t * const pCopy);
+
+/***** Function Definitions *********************************************/
+
+/*********************************************************************//**
+  <!-- d_DMA_CopyInitialise -->
+
+  Initialise the DMA channel used for copies. Until this is called all
+  copies are made by the CPU.
+*************************************************************************/
+d_Status_t                 /** \return Function status */
+d_DMA_CopyInitialise
+(
+void
+)
+{
+  d_Status_t status = d_DMA_Initialise(d_DMA_COPY_CHANNEL);
+
+  if (status == d_STATUS_SUCCESS)
+  {
+    initialised = d_TRUE;
+  }
+  // gcov-jst 1 It is not practical to generate this failure during bench testing.
+  ELSE_DO_NOTHING
+
+  return status;
+}
+
+/*********************************************************************//**
+  <!-- d_DMA_Copy -->
+
+  Copy memory. Copies shorter than the threshold, copies involving the
+  tightly coupled memories, copies made from an interrupt handler or with
+  interrupts disabled, and copies made while the channel is in use are
+  made by the CPU. Longer copies are made by the DMA and the function
+  waits for them. A failed DMA copy is repeated by the CPU. The function
+  may be called from interrupt handlers, which always copy by CPU.
+*************************************************************************/
+void                                /** \return None */
+d_DMA_Copy
+(
+Uint8_t * const pDestination,       /**< [out] Destination address */
+const Uint8_t * const pSource,      /**< [in]  Source address */
+const Uint32_t length               /**< [in]  Number of bytes to copy */
+)
+{
+  Bool_t cpuCopy = d_TRUE;
+  dmaCopy_t copy;
+
+  if ((initialised == d_TRUE) && (length >= copyThreshold) && (dmaCapable(pDestination, pSource, length) == d_TRUE))
+  {
+    if (threadContext() != d_TRUE)
+    {
+      copyStats.contextFallbacks++;
+    }
+    else if (channelClaim() == d_TRUE)
+    {
+      d_Status_t status = copyStart(pDestination, pSource, length, &copy);
+      if (status == d_STATUS_SUCCESS)
+      {
+        status = copyWait(&copy);
+      }
+      ELSE_DO_NOTHING
+      channelRelease();
+
+      if (status == d_STATUS_SUCCESS)
+      {
+        copyStats.dmaCopies++;
+        copyStats.dmaBytes += length;
+        cpuCopy = d_FALSE;
+      }
+      else
+      {
+        // gcov-jst 1 It is not practical to generate this failure during bench testing.
+        copyStats.errors++;
+      }
+    }
+    else
+    {
+      copyStats.busyFallbacks++;
+    }
+  }
+  ELSE_DO_NOTHING
+
+  if (cpuCopy == d_TRUE)
+  {
+    d_GEN_MemoryCopy(pDestination, pSource, length);
+    copyStats.cpuCopies++;
+  }
+  ELSE_DO_NOTHING
+
+  return;
+}
+
+/*********************************************************************//**
+  <!-- d_DMA_CopyAsync -->
+
+  Start a copy by DMA and return without waiting. The destination must
+  not be accessed and the source must not be changed until the callback,
+  which is made from d_DMA_CopyPoll. Returns d_STATUS_DEVICE_BUSY if the
+  channel is in use, in which case the caller may copy with d_DMA_Copy.
+  Must not be called from an interrupt handler, which is refused with
+  d_STATUS_INVALID_MODE.
+*************************************************************************/
+d_Status_t                          /** \return Function status */
+d_DMA_CopyAsync
+(
+Uint8_t * const pDestination,       /**< [out] Destination address */
+const Uint8_t * const pSource,      /**< [in]  Source address */
+const Uint32_t length,              /**< [in]  Number of bytes to copy */
+const d_DMA_CopyCallback_t callback, /**< [in] Completion callback, may be NULL */
+void * const pContext               /**< [in]  Parameter passed to the callback */
+)
+{
+  d_Status_t status;
+
+  if (initialised != d_TRUE)
+  {
+    d_ERROR_Logger(d_STATUS_NOT_INITIALISED, d_ERROR_CRITICALITY_NON_CRITICAL, 0, 0, 0, 0);
+    // cppcheck-suppress misra-c2012-15.5; Coding standard allows function to return if parameters are invalid
+    return d_STATUS_NOT_INITIALISED;
+  }
+
+  if ((pDestination == NULL) || (pSource == NULL) || (length < (2u * CACHE_LINE_SIZE)) ||
+      (dmaCapable(pDestination, pSource, length) != d_TRUE))
+  {
+    d_ERROR_Logger(d_STATUS_INVALID_PARAMETER, d_ERROR_CRITICALITY_NON_CRITICAL, 1, length, 0, 0);
+    // cppcheck-suppress misra-c2012-15.5; Coding standard allows function to return if parameters are invalid
+    return d_STATUS_INVALID_PARAMETER;
+  }
+
+  if (threadContext() != d_TRUE)
+  {
+    d_ERROR_Logger(d_STATUS_INVALID_MODE, d_ERROR_CRITICALITY_NON_CRITICAL, 2, 0, 0, 0);
+    // cppcheck-suppress misra-c2012-15.5; Coding standard allows function to return if called in the wrong mode
+    return d_STATUS_INVALID_MODE;
+  }
+
+  if (channelClaim() == d_TRUE)
+  {
+    status = copyStart(pDestination, pSource, length, &asyncCopy);
+    if (status == d_STATUS_SUCCESS)
+    {
+      asyncCallback = callback;
+      pAsyncContext = pContext;
+      asyncActive = d_TRUE;
+      copyStats.dmaCopies++;
+      copyStats.dmaBytes += length;
+    }
+    else
+    {
+      // gcov-jst 2 It is not practical to generate this failure during bench testing.
+      copyStats.errors++;
+      channelRelease();
+    }
+  }
+  else
+  {
+    status = d_STATUS_DEVICE_BUSY;
+  }
+
+  return status;
+}
+
+/*********************************************************************//**
+  <!-- d_DMA_CopyPoll -->
+
+  Check for completion of an asynchronous copy and make its callback.
+*************************************************************************/
+Bool_t                              /** \return d_TRUE while a copy is in progress */
+d_DMA_CopyPoll
+(
+void
+)
+{
+  if (asyncActive == d_TRUE)
+  {
+    d_Status_t status = copyCheck(&asyncCopy);
+    if (status != d_STATUS_DEVICE_BUSY)
+    {
+      if (status != d_STATUS_SUCCESS)
+      {
+        // gcov-jst 1 It is not practical to generate this failure during bench testing.
+        copyStats.errors++;
+      }
+      ELSE_DO_NOTHING
+
+      asyncActive = d_FALSE;
+      channelRelease();
+
+      if (asyncCallback != NULL)
+      {
+        asyncCallback(status, pAsyncContext);
+      }
+      ELSE_DO_NOTHING
+    }
+    ELSE_DO_NOTHING
+  }
+  ELSE_DO_NOTHING
+
+  return asyncActive;
+}
+
+/*********************************************************************//**
+  <!-- d_DMA_CopyCalibrate -->
+
+  Time CPU and DMA copies of lengths from 256 bytes, doubling up to half
+  the scratch area or d_DMA_COPY_CALIBRATION_POINTS lengths, and set the
+  threshold to the shortest length at which the DMA is faster. The times
+  include the cache maintenance of the DMA copy. Table entries for
+  lengths not measured are set to zero. The scratch area must be in
+  DDR or OCM, aligned to a cache line and not in use elsewhere. Must not
+  be called from an interrupt handler.
+*************************************************************************/
+d_Status_t                          /** \return Function status */
+d_DMA_CopyCalibrate
+(
+Uint8_t * const pScratch,           /**< [in] Scratch area used as source and destination */
+const Uint32_t scratchLength,       /**< [in] Length of the scratch area */
+d_DMA_CopyTiming_t pTable[d_DMA_COPY_CALIBRATION_POINTS] /**< [out] Times measured */
+)
+{
+  d_Status_t status = d_STATUS_SUCCESS;
+  Uint32_t half = (scratchLength / 2u) & ~(CACHE_LINE_SIZE - 1u);
+  Uint32_t threshold = THRESHOLD_NEVER;
+  Uint32_t length = CALIBRATION_FIRST_LENGTH;
+  Uint32_t point;
+  Uint32_t repeat;
+  Uint32_t startTime;
+  dmaCopy_t copy;
+
+  if (initialised != d_TRUE)
+  {
+    d_ERROR_Logger(d_STATUS_NOT_INITIALISED, d_ERROR_CRITICALITY_NON_CRITICAL, 0, 0, 0, 0);
+    // cppcheck-suppress misra-c2012-15.5; Coding standard allows function to return if parameters are invalid
+    return d_STATUS_NOT_INITIALISED;
+  }
+
+  // cppcheck-suppress misra-c2012-11.4; Conversion required to check for invalid parameter. Violation of 'Advisory' rule does not present a risk
+  if ((pScratch == NULL) || (pTable == NULL) || (((Pointer_t)pScratch % CACHE_LINE_SIZE) != 0u) ||
+      (half < CALIBRATION_FIRST_LENGTH) || (dmaCapable(pScratch, &pScratch[half], half) != d_TRUE))
+  {
+    d_ERROR_Logger(d_STATUS_INVALID_PARAMETER, d_ERROR_CRITICALITY_NON_CRITICAL, 1, scratchLength, 0, 0);
+    // cppcheck-suppress misra-c2012-15.5; Coding standard allows function to return if parameters are invalid
+    return d_STATUS_INVALID_PARAMETER;
+  }
+
+  if (threadContext() != d_TRUE)
+  {
+    d_ERROR_Logger(d_STATUS_INVALID_MODE, d_ERROR_CRITICALITY_NON_CRITICAL, 2, 0, 0, 0);
+    // cppcheck-suppress misra-c2012-15.5; Coding standard allows function to return if called in the wrong mode
+    return d_STATUS_INVALID_MODE;
+  }
+
+  if (channelClaim() != d_TRUE)
+  {
+    // cppcheck-suppress misra-c2012-15.5; Coding standard allows function to return if the device is in use
+    return d_STATUS_DEVICE_BUSY;
+  }
+
+  for (point = 0u; point < d_DMA_COPY_CALIBRATION_POINTS; point++)
+  {
+    pTable[point].length = 0u;
+    pTable[point].cpuNanoseconds = 0u;
+    pTable[point].dmaNanoseconds = 0u;
+
+    if ((status == d_STATUS_SUCCESS) && (length <= half))
+    {
+      pTable[point].length = length;
+
+      startTime = d_TIMER_ReadValueInTicks();
+      for (repeat = 0u; repeat < CALIBRATION_REPEATS; repeat++)
+      {
+        d_GEN_MemoryCopy(pScratch, &pScratch[half], length);
+      }
+      pTable[point].cpuNanoseconds = (d_TIMER_ElapsedMicroseconds(startTime, NULL) * 1000u) / CALIBRATION_REPEATS;
+
+      startTime = d_TIMER_ReadValueInTicks();
+      repeat = 0u;
+      while ((status == d_STATUS_SUCCESS) && (repeat < CALIBRATION_REPEATS))
+      {
+        status = copyStart(pScratch, &pScratch[half], length, &copy);
+        if (status == d_STATUS_SUCCESS)
+        {
+          status = copyWait(&copy);
+        }
+        ELSE_DO_NOTHING
+        repeat++;
+      }
+      pTable[point].dmaNanoseconds = (d_TIMER_ElapsedMicroseconds(startTime, NULL) * 1000u) / CALIBRATION_REPEATS;
+
+      if ((threshold == THRESHOLD_NEVER) && (pTable[point].dmaNanoseconds < pTable[point].cpuNanoseconds))
+      {
+        threshold = length;
+      }
+      ELSE_DO_NOTHING
+
+      length = length * 2u;
+    }
+    ELSE_DO_NOTHING
+  }
+
+  channelRelease();
+
+  if (status == d_STATUS_SUCCESS)
+  {
+    copyThreshold = threshold;
+  }
+  else
+  {
+    // gcov-jst 1 It is not practical to generate this failure during bench testing.
+    copyStats.errors++;
+  }
+
+  return status;
+}
+
+/*********************************************************************//**
+  <!-- d_DMA_CopyGetThreshold -->
+
+  Get the length from which d_DMA_Copy uses the DMA.
+*************************************************************************/
+Uint32_t                            /** \return Threshold in bytes */
+d_DMA_CopyGetThreshold
+(
+void
+)
+{
+  return copyThreshold;
+}
+
+/*********************************************************************//**
+  <!-- d_DMA_CopySetThreshold -->
+
+  Set the length from which d_DMA_Copy uses the DMA. The DMA is not used
+  for less than two cache lines.
+*************************************************************************/
+void                                /** \return None */
+d_DMA_CopySetThreshold
+(
+const Uint32_t threshold            /**< [in] Threshold in bytes */
+)
+{
+  if (threshold < (2u * CACHE_LINE_SIZE))
+  {
+    copyThreshold = 2u * CACHE_LINE_SIZE;
+  }
+  else
+  {
+    copyThreshold = threshold;
+  }
+
+  return;
+}
+
+/*********************************************************************//**
+  <!-- d_DMA_CopyGetStats -->
+
+  Get the copy statistics.
+*************************************************************************/
+d_Status_t                          /** \return Function status */
+d_DMA_CopyGetStats
+(
+d_DMA_CopyStats_t * const pStats    /**< [out] Pointer to storage for statistics */
+)
+{
+  if (pStats == NULL)
+  {
+    d_ERROR_Logger(d_STATUS_INVALID_PARAMETER, d_ERROR_CRITICALITY_NON_CRITICAL, 0, 0, 0, 0);
+    // cppcheck-suppress misra-c2012-15.5; Coding standard allows function to return if parameters are invalid
+    return d_STATUS_INVALID_PARAMETER;
+  }
+
+  *pStats = copyStats;
+
+  return d_STATUS_SUCCESS;
+}
+
+/*********************************************************************//**
+  <!-- threadContext -->
+
+  Check that the caller may wait for the DMA: the processor is in user or
+  system mode, not in an interrupt handler, and IRQs are not masked by a
+  critical section.
+*************************************************************************/
+static Bool_t                       /** \return d_TRUE in thread context with interrupts enabled */
+threadContext
+(
+void
+)
+{
+  Bool_t thread = d_FALSE;
+  Uint32_t statusRegister = d_mfcpsr();
+  Uint32_t mode = statusRegister & CPSR_MODE_MASK;
+
+  if (((mode == CPSR_MODE_SYSTEM) || (mode == CPSR_MODE_USER)) && ((statusRegister & CPSR_IRQ_MASKED) == 0u))
+  {
+    thread = d_TRUE;
+  }
+  ELSE_DO_NOTHING
+
+  return thread;
+}
+
+/*********************************************************************//**
+  <!-- channelClaim -->
+
+  Claim the DMA channel for a copy.
+*************************************************************************/
+static Bool_t                       /** \return d_TRUE if claimed */
+channelClaim
+(
+void
+)
+{
+  Bool_t claimed = d_FALSE;
+  Uint32_t interruptState = d_INT_CriticalSectionEnter();
+
+  if (channelInUse == d_FALSE)
+  {
+    channelInUse = d_TRUE;
+    claimed = d_TRUE;
+  }
+  ELSE_DO_NOTHING
+
+  d_INT_CriticalSectionLeave(interruptState);
+
+  return claimed;
+}
+
+/*********************************************************************//**
+  <!-- channelRelease -->
+
+  Release the DMA channel.
+*************************************************************************/
+static void                         /** \return None */
+channelRelease
+(
+void
+)
+{
+  channelInUse = d_FALSE;
+
+  return;
+}
+
+/*********************************************************************//**
+  <!-- dmaCapable -->
+
+  Check that a copy can be made by the DMA, which requires both areas to
+  be outside the tightly coupled memories.
+*************************************************************************/
+static Bool_t                       /** \return d_TRUE if the DMA can be used */
+dmaCapable
+(
+const Uint8_t * const pDestination, /**< [in] Destination address */
+const Uint8_t * const pSource,      /**< [in] Source address */
+const Uint32_t length               /**< [in] Number of bytes to copy */
+)
+{
+  Bool_t capable = d_FALSE;
+
+  // cppcheck-suppress misra-c2012-11.4; Conversion required to check the memory region. Violation of 'Advisory' rule does not present a risk
+  if (((Pointer_t)pDestination >= TCM_LOCAL_END) && ((Pointer_t)pSource >= TCM_LOCAL_END) && (length > 0u))
+  {
+    capable = d_TRUE;
+  }
+  ELSE_DO_NOTHING
+
+  return capable;
+}
+
+/*********************************************************************//**
+  <!-- copyStart -->
+
+  Start the DMA on the whole cache lines of the destination and copy the
+  partial lines at either end by CPU while it runs. The DMA driver
+  flushes the source and invalidates the destination lines first.
+*************************************************************************/
+static d_Status_t                   /** \return Function status */
+copyStart
+(
+Uint8_t * const pDestination,       /**< [out] Destination address */
+const Uint8_t * const pSource,      /**< [in]  Source address */
+const Uint32_t length,              /**< [in]  Number of bytes to copy, at least two cache lines */
+dmaCopy_t * const pCopy             /**< [out] Part of the copy made by the DMA */
+)
+{
+  // cppcheck-suppress misra-c2012-11.4; Conversion required to find the cache line boundary. Violation of 'Advisory' rule does not present a risk
+  Uint32_t head = (CACHE_LINE_SIZE - ((Pointer_t)pDestination % CACHE_LINE_SIZE)) % CACHE_LINE_SIZE;
+  Uint32_t dmaLength = ((length - head) / CACHE_LINE_SIZE) * CACHE_LINE_SIZE;
+  Uint32_t tail = head + dmaLength;
+  d_Status_t status;
+
+  pCopy->pDestination = &pDestination[head];
+  pCopy->length = dmaLength;
+  pCopy->startTime = d_TIMER_ReadValueInTicks();
+
+  status = d_DMA_StartMemToMemTransfer(d_DMA_COPY_CHANNEL, &pDestination[head], &pSource[head], dmaLength);
+
+  if (status == d_STATUS_SUCCESS)
+  {
+    d_GEN_MemoryCopy(pDestination, pSource, head);
+    d_GEN_MemoryCopy(&pDestination[tail], &pSource[tail], length - tail);
+  }
+  // gcov-jst 1 It is not practical to generate this failure during bench testing.
+  ELSE_DO_NOTHING
+
+  return status;
+}
+
+/*********************************************************************//**
+  <!-- copyCheck -->
+
+  Check a DMA copy for completion. On completion the destination lines
+  are invalidated again in case they were fetched during the transfer.
+  A copy taking too long is stopped by resetting the channel.
+*************************************************************************/
+static d_Status_t                   /** \return Success, busy or failure */
+copyCheck
+(
+const dmaCopy_t * const pCopy       /**< [in] Copy in progress */
+)
+{
+  d_Status_t status = d_DMA_TransferStatus(d_DMA_COPY_CHANNEL);
+
+  if (status == d_STATUS_SUCCESS)
+  {
+    // cppcheck-suppress misra-c2012-11.4; Conversion required by non portable low level software. Violation of 'Advisory' rule does not present a risk.
+    d_MEMORY_DCacheInvalidateRange((Pointer_t)pCopy->pDestination, pCopy->length);
+  }
+  else if ((status == d_STATUS_DEVICE_BUSY) &&
+           (d_TIMER_ElapsedMilliseconds(pCopy->startTime, NULL) > (COPY_TIMEOUT_MS + (pCopy->length >> 18))))
+  {
+    // gcov-jst 3 It is not practical to generate this failure during bench testing.
+    d_ERROR_Logger(d_STATUS_TIMEOUT, d_ERROR_CRITICALITY_NON_CRITICAL, d_DMA_COPY_CHANNEL, pCopy->length, 0, 0);
+    (void)d_DMA_Initialise(d_DMA_COPY_CHANNEL);
+    status = d_STATUS_TIMEOUT;
+  }
+  else
+  {
+    DO_NOTHING();
+  }
+
+  return status;
+}
+
+/*********************************************************************//**
+  <!-- copyWait -->
+
+  Wait for a DMA copy to complete or time out.
+*************************************************************************/
+static d_Status_t                   /** \return Function status */
+copyWait
+(
+const dmaCopy_t * const pCopy       /**< [in] Copy in progress */
+)
+{
+  d_Status_t status;
+
+  do
+  {
+    status = copyCheck(pCopy);
+  } while (status == d_STATUS_DEVICE_BUSY);
+
+  return status;
+}
+
@@ -0,0 +1,91 @@
+/******[Configuration Header]*****************************************//**
+\file
+\brief
+  Module Title       : DMA memory copy
+
+  Abstract           : Memory copy service choosing between the CPU and
+                       a DMA channel according to the length of the copy.
+
+  Software Structure : SRS References: 136T-2200-131000-001-D22 SWREQ-146
+                       SDD References: 136T-2200-131000-001-D22 SWDES-120
+\note
+  CSC ID             : SWDES-49
+*************************************************************************/
+
+#ifndef D_DMA_COPY_H
+#define D_DMA_COPY_H
+
+/***** Includes *********************************************************/
+
+#include "soc/defines/d_common_types.h"
+#include "soc/defines/d_common_status.h"
+
+/***** Constants ********************************************************/
+
+/* DMA channel reserved for memory copies: entry 8 of d_DMA_Config, after
+   the eight ADMA channels, which is GDMA channel 0 */
+#ifndef d_DMA_COPY_CHANNEL
+#define d_DMA_COPY_CHANNEL      8u
+#endif
+
+/* Length in bytes from which d_DMA_Copy uses the DMA, until replaced by calibration */
+#ifndef d_DMA_COPY_THRESHOLD
+#define d_DMA_COPY_THRESHOLD    4096u
+#endif
+
+/* Number of lengths measured by calibration, from 256 bytes doubling each time */
+#define d_DMA_COPY_CALIBRATION_POINTS  10u
+
+/***** Type Definitions *************************************************/
+
+/* Completion callback of an asynchronous copy */
+typedef void (*d_DMA_CopyCallback_t)(const d_Status_t status, void * const pContext);
+
+/* Calibration result for one length */
+typedef struct
+{
+  Uint32_t length;           /**< Length copied in bytes */
+  Uint32_t cpuNanoseconds;   /**< Time of a CPU copy */
+  Uint32_t dmaNanoseconds;   /**< Time of a DMA copy, including cache maintenance */
+} d_DMA_CopyTiming_t;
+
+typedef struct
+{
+  Uint32_t cpuCopies;        /**< Copies made by the CPU */
+  Uint32_t dmaCopies;        /**< Copies made by the DMA */
+  Uint32_t dmaBytes;         /**< Bytes moved by the DMA */
+  Uint32_t busyFallbacks;    /**< Copies made by the CPU because the DMA was in use */
+  Uint32_t contextFallbacks; /**< Copies made by the CPU because called from an interrupt or critical section */
+  Uint32_t errors;           /**< DMA copies failed or timed out */
+} d_DMA_CopyStats_t;
+
+/***** Variables ********************************************************/
+
+/***** Function Declarations ********************************************/
+
+/* Initialise the DMA channel used for copies */
+d_Status_t d_DMA_CopyInitialise(void);
+
+/* Copy memory, returns when the copy is complete. Interrupt handlers may
+   call it, their copies are always made by the CPU */
+void d_DMA_Copy(Uint8_t * const pDestination, const Uint8_t * const pSource, const Uint32_t length);
+
+/* Start a copy by DMA, the callback is made from d_DMA_CopyPoll when the copy is complete.
+   Not to be called from interrupt handlers */
+d_Status_t d_DMA_CopyAsync(Uint8_t * const pDestination, const Uint8_t * const pSource, const Uint32_t length,
+                           const d_DMA_CopyCallback_t callback, void * const pContext);
+
+/* Check for completion of an asynchronous copy, returns d_TRUE while a copy is in progress */
+Bool_t d_DMA_CopyPoll(void);
+
+/* Measure CPU and DMA copy times and set the threshold to the shortest length the DMA copies faster */
+d_Status_t d_DMA_CopyCalibrate(Uint8_t * const pScratch, const Uint32_t scratchLength,
+                               d_DMA_CopyTiming_t pTable[d_DMA_COPY_CALIBRATION_POINTS]);
+
+/* Get or set the length from which d_DMA_Copy uses the DMA */
+Uint32_t d_DMA_CopyGetThreshold(void);
+void d_DMA_CopySetThreshold(const Uint32_t threshold);
+
+d_Status_t d_DMA_CopyGetStats(d_DMA_CopyStats_t * const pStats);
+
+#endif /* D_DMA_COPY_H */
@@ -43,6 +43,7 @@
 #include "soc/interrupt_manager/d_int_irq_split.h"
 #include "soc/uart/d_uart_ps.h"
 #include "soc/dma/d_dma.h"
+#include "soc/sata/d_sata.h"
 #include "soc/can/d_can.h"
 #include "soc/spi/d_spi.h"
 #include "soc/discrete/d_discrete.h"
@@ -237,7 +238,7 @@ __attribute__((weak)) const d_INT_IrqVectorTable_t IrqVectorTable[MAXIMUM_IRQ] =
      {d_DMA_InterruptHandler, 14},       /* 162 - XPS_ZDMA_CH6_INT_ID */
      {d_DMA_InterruptHandler, 15},       /* 163 - XPS_ZDMA_CH7_INT_ID */
      {NULL, 0},                          /* 164 - */
-     {NULL, 0},                          /* 165 - */
+     {d_SATA_InterruptHandler, 0},       /* 165 - SATA */
      {NULL, 0},                          /* 166 - */
      {NULL, 0},                          /* 167 - */
      {NULL, 0},                          /* 168 - XPS_XMPU_FPD_INT_ID */
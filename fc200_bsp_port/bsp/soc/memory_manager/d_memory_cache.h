@@ -33,13 +33,13 @@
 
 /***** Macros (Inline Functions) Definitions ****************************/
 
-/* memory synchronisation operations */
+/* memory synchronisation operations, which also stop the compiler moving memory accesses across them */
 /* Instruction Synchronisation Barrier */
-#define d_isb() __asm__ __volatile__ ("isb sy")
+#define d_isb() __asm__ __volatile__ ("isb sy" : : : "memory")
 /* Data Synchronisation Barrier */
-#define d_dsb() __asm__ __volatile__("dsb sy")
+#define d_dsb() __asm__ __volatile__("dsb sy" : : : "memory")
 /* Data Memory Barrier */
-#define d_dmb() __asm__ __volatile__("dmb sy")
+#define d_dmb() __asm__ __volatile__("dmb sy" : : : "memory")
 
 /***** Variables ********************************************************/
 
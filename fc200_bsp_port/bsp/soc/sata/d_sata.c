@@ -28,6 +28,7 @@
 #include "kernel/general/d_gen_register.h"
 #include "kernel/general/d_gen_memory.h"
 #include "soc/timer/d_timer.h"
+#include "soc/interrupt_manager/d_int_irq_handler.h"
 
 #include "d_sata.h"
 #include "d_sata_ops.h"
@@ -292,17 +293,15 @@ AhciStartPort
 
   if (returnValue == d_STATUS_SUCCESS)
   {
-    const Uint32_t AHCI_CMD_SLOT_SIZE = 256u;
-    const Uint32_t AHCI_RX_FIS_SIZE = 256u;
-    const Uint32_t AHCI_CMD_TBL_HDR = 0x80u;
-
     d_GEN_MemorySet(dmaMem, 0u, AHCI_PORT_DMA_SIZE);
 
     Uint32_t index = 0;
 
+    // Command list of AHCI_MAX_CMD_SLOTS headers, followed by the received FIS area and
+    // one command table per slot. The slot 0 table is the one used for non-queued commands.
     // cppcheck-suppress misra-c2012-11.3; Conversion between pointers cannot be avoided in this case. Violation of 'Advisory' rule does not present a risk.
     cmdInfo.cmdSlot = (AhchiCmdHdr_t*)&dmaMem[index];
-    index += AHCI_CMD_SLOT_SIZE;
+    index += AHCI_CMD_LIST_SIZE;
 
     // cppcheck-suppress misra-c2012-11.4; Conversion between pointer and integer cannot be avoided in this case. Violation of 'Advisory' rule does not present a risk.
     cmdInfo.rxFis = (Uint32_t)&dmaMem[index];
@@ -480,6 +479,170 @@ const Uint32_t readLength)  /**< [in] the amount of bytes to be read */
   return returnValue;
 }
 
+/*********************************************************************//**
+  <!-- d_SATA_SubmitSg -->
+
+  Submits a queued read or write of a scatter-gather list to the sata device
+  The function returns once the request is issued, the callback is made on completion
+
+*************************************************************************/
+d_Status_t                                /** \return 0 If the request is issued */
+d_SATA_SubmitSg
+(const Uint32_t lba,                      /**< [in] logical block address to start the transfer */
+const d_SATA_SgEntry_t * const pSgList,   /**< [in] list of buffer segments, the total length a multiple of the sector size */
+const Uint32_t sgCount,                   /**< [in] number of entries in the list */
+const Bool_t writeFlag,                   /**< [in] d_TRUE to write, d_FALSE to read */
+const d_SATA_Callback_t callback,         /**< [in] completion callback, may be NULL */
+void * const pContext,                    /**< [in] context passed to the callback */
+Uint32_t * const pTag)                    /**< [out] tag of the request, may be NULL */
+{
+  d_Status_t returnValue;
+
+  if (initialised != d_TRUE)
+  {
+    returnValue = d_STATUS_NOT_INITIALISED;
+  }
+  else
+  {
+    returnValue = d_SATAOP_QueueSubmit(SATA_PORT, lba, pSgList, sgCount, writeFlag, callback, pContext, pTag);
+  }
+
+  return returnValue;
+}
+
+/*********************************************************************//**
+  <!-- d_SATA_ReadAsync -->
+
+  Submits a queued read from the sata device
+  The buffer should be cache line aligned, it must not be accessed until the callback is made
+
+*************************************************************************/
+d_Status_t                            /** \return 0 If the request is issued */
+d_SATA_ReadAsync
+(const Uint32_t lba,                  /**< [in] logical block address to start read */
+Uint8_t * const pBuffer,              /**< [out] buffer to place the read data */
+const Uint32_t readLength,            /**< [in] the amount of bytes to be read */
+const d_SATA_Callback_t callback,     /**< [in] completion callback, may be NULL */
+void * const pContext,                /**< [in] context passed to the callback */
+Uint32_t * const pTag)                /**< [out] tag of the request, may be NULL */
+{
+  d_SATA_SgEntry_t sgEntry;
+  sgEntry.pBuffer = pBuffer;
+  sgEntry.length = readLength;
+
+  return d_SATA_SubmitSg(lba, &sgEntry, 1u, d_FALSE, callback, pContext, pTag);
+}
+
+/*********************************************************************//**
+  <!-- d_SATA_WriteAsync -->
+
+  Submits a queued write to the sata device
+  The buffer must not be modified until the callback is made
+
+*************************************************************************/
+d_Status_t                            /** \return 0 If the request is issued */
+d_SATA_WriteAsync
+(const Uint32_t lba,                  /**< [in] logical block address to start write */
+const Uint8_t * const pBuffer,        /**< [in] buffer containing the data to be written */
+const Uint32_t writeLength,           /**< [in] the amount of bytes to be written */
+const d_SATA_Callback_t callback,     /**< [in] completion callback, may be NULL */
+void * const pContext,                /**< [in] context passed to the callback */
+Uint32_t * const pTag)                /**< [out] tag of the request, may be NULL */
+{
+  d_SATA_SgEntry_t sgEntry;
+  sgEntry.pBuffer = pBuffer;
+  sgEntry.length = writeLength;
+
+  return d_SATA_SubmitSg(lba, &sgEntry, 1u, d_TRUE, callback, pContext, pTag);
+}
+
+/*********************************************************************//**
+  <!-- d_SATA_QueuePoll -->
+
+  Services the request queue: completions, timeouts and error recovery
+
+*************************************************************************/
+Uint32_t                  /** \return The number of requests outstanding */
+d_SATA_QueuePoll
+(void)                    /**< [in] None */
+{
+  Uint32_t outstanding = 0u;
+
+  if (initialised == d_TRUE)
+  {
+    outstanding = d_SATAOP_QueueService(SATA_PORT, d_FALSE);
+  }
+  ELSE_DO_NOTHING
+
+  return outstanding;
+}
+
+/*********************************************************************//**
+  <!-- d_SATA_QueueBackground -->
+
+  Background job polling the request queue. Completions are normally
+  reported by the interrupt handler, so the job asks to run again in the
+  frame only when the poll has finished a request and others remain
+  outstanding. Waiting for the drive leaves the slack to the later jobs.
+
+*************************************************************************/
+Bool_t                    /** \return d_TRUE if the poll finished requests and others remain outstanding */
+d_SATA_QueueBackground
+(void)                    /**< [in] None */
+{
+  Bool_t moreWork = d_FALSE;
+  d_SATA_QueueStats_t before;
+  d_SATA_QueueStats_t after;
+
+  if (d_SATAOP_QueueGetStats(SATA_PORT, &before) == d_STATUS_SUCCESS)
+  {
+    Uint32_t outstanding = d_SATA_QueuePoll();
+    (void)d_SATAOP_QueueGetStats(SATA_PORT, &after);
+
+    if ((outstanding != 0u) &&
+        ((after.completed + after.errors + after.timeouts) != (before.completed + before.errors + before.timeouts)))
+    {
+      moreWork = d_TRUE;
+    }
+    ELSE_DO_NOTHING
+  }
+  ELSE_DO_NOTHING
+
+  return moreWork;
+}
+
+/*********************************************************************//**
+  <!-- d_SATA_InterruptHandler -->
+
+  SATA controller interrupt handler, reports completed requests
+
+*************************************************************************/
+void                        /** \return None */
+d_SATA_InterruptHandler
+(const Uint32_t parameter)  /**< [in] Not used */
+{
+  UNUSED_PARAMETER(parameter);
+
+  if (initialised == d_TRUE)
+  {
+    (void)d_SATAOP_QueueService(SATA_PORT, d_TRUE);
+  }
+  ELSE_DO_NOTHING
+}
+
+/*********************************************************************//**
+  <!-- d_SATA_GetQueueStats -->
+
+  Retrieves the request queue statistics
+
+*************************************************************************/
+d_Status_t                              /** \return 0 If successful */
+d_SATA_GetQueueStats
+(d_SATA_QueueStats_t * const pStats)    /**< [out] Pointer to structure to store the result */
+{
+  return d_SATAOP_QueueGetStats(SATA_PORT, pStats);
+}
+
 /*********************************************************************//**
   <!-- d_SATA_GetDriveInfo -->
 
@@ -565,10 +728,22 @@ d_SATA_Initialise
       returnValue = d_SATAOP_Inquiry(SATA_PORT);
     }
 
+    // Set up the request queue, native command queuing is used if both the controller and drive support it
+    if (returnValue == d_STATUS_SUCCESS)
+    {
+      returnValue = d_SATAOP_QueueInitialise(SATA_PORT);
+    }
+    // gcov-jst 1 It is not practical to generate this failure during bench testing.
+    ELSE_DO_NOTHING
+
     if (returnValue == d_STATUS_SUCCESS)
     {
       initialised = d_TRUE;
+
+      /* Completions of the queued requests are reported by the interrupt */
+      returnValue = d_INT_IrqEnable(d_SATA_INTERRUPT_ID);
     }
+    ELSE_DO_NOTHING
   }
   ELSE_DO_NOTHING
 
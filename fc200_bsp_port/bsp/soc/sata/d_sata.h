@@ -37,6 +37,12 @@
 
 /***** Constants ********************************************************/
 
+/* Interrupt number of the SATA controller */
+#define d_SATA_INTERRUPT_ID     (165u)
+
+/* Maximum number of sectors in one queued request */
+#define d_SATA_MAX_REQUEST_BLOCKS  (0xFFFFu)
+
 /***** Type Definitions *************************************************/
 
 typedef struct
@@ -47,6 +53,7 @@ typedef struct
   Char_t revision[5u];
   Uint32_t capacity; // capacity is measured in sectors
   Uint32_t sectorSize;
+  Uint32_t queueDepth; // native command queue depth of the drive, 0 if not supported
 } d_SATA_DeviceInfo_t;
 
 typedef struct
@@ -58,6 +65,27 @@ typedef struct
   Uint8_t  remainingLifePercentage;
 } d_SATA_SmartInfo_t;
 
+/* Scatter-gather list entry of a queued request */
+typedef struct
+{
+  const Uint8_t * pBuffer;  // segment address, must be 2 byte aligned
+  Uint32_t length;          // segment length in bytes, must be even
+} d_SATA_SgEntry_t;
+
+/* Completion callback of a queued request, called with the tag returned on submission */
+typedef void (*d_SATA_Callback_t)(const Uint32_t tag, const d_Status_t status, void * const pContext);
+
+typedef struct
+{
+  Uint32_t submitted;       // requests issued to the drive
+  Uint32_t completed;       // requests completed successfully
+  Uint32_t errors;          // requests failed by a device or bus error
+  Uint32_t timeouts;        // requests failed by timeout
+  Uint32_t recoveries;      // port recoveries performed
+  Uint32_t queueDepth;      // usable queue depth, 1 when native command queuing is not available
+  Uint32_t maxOutstanding;  // largest number of requests outstanding at once
+} d_SATA_QueueStats_t;
+
 /***** Variables ********************************************************/
 
 /***** Function Declarations ********************************************/
@@ -74,6 +102,28 @@ d_Status_t d_SATA_Read(const Uint32_t lba, Uint8_t * pBuffer, const Uint32_t rea
 
 d_Status_t d_SATA_GetSMARTInfo(d_SATA_SmartInfo_t * pSmartInfo);
 
+// Queued (asynchronous) requests. The callback is made when the request completes, from the
+// SATA interrupt if enabled or from d_SATA_QueuePoll. Read buffers should be cache line aligned.
+d_Status_t d_SATA_ReadAsync(const Uint32_t lba, Uint8_t * const pBuffer, const Uint32_t readLength,
+                            const d_SATA_Callback_t callback, void * const pContext, Uint32_t * const pTag);
+
+d_Status_t d_SATA_WriteAsync(const Uint32_t lba, const Uint8_t * const pBuffer, const Uint32_t writeLength,
+                             const d_SATA_Callback_t callback, void * const pContext, Uint32_t * const pTag);
+
+d_Status_t d_SATA_SubmitSg(const Uint32_t lba, const d_SATA_SgEntry_t * const pSgList, const Uint32_t sgCount, const Bool_t writeFlag,
+                           const d_SATA_Callback_t callback, void * const pContext, Uint32_t * const pTag);
+
+// Services completed requests, timeouts and errors, returns the number of requests outstanding
+Uint32_t d_SATA_QueuePoll(void);
+
+// Background job servicing the request queue, runs again in the frame only while requests are being finished
+Bool_t d_SATA_QueueBackground(void);
+
+// Interrupt handler servicing completed requests, timeouts and errors are left to d_SATA_QueuePoll
+void d_SATA_InterruptHandler(const Uint32_t parameter);
+
+d_Status_t d_SATA_GetQueueStats(d_SATA_QueueStats_t * const pStats);
+
 
 // Function will test if the SATA drive is a Self Encrypting Drive
 Bool_t d_SATA_IsSelfEncryptingDrive(void);
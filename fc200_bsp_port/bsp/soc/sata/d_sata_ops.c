@@ -15,6 +15,7 @@
 #include "kernel/general/d_gen_register.h"        /* Register functions */
 #include "kernel/general/d_gen_memory.h"
 #include "soc/memory_manager/d_memory_cache.h"
+#include "soc/interrupt_manager/d_int_critical.h"
 #include "soc/timer/d_timer.h"
 
 #include "d_sata_ops.h"
@@ -63,6 +64,12 @@ static const Uint32_t SATA_PORT_COUNT = 2u;
 // cppcheck-suppress misra-c2012-8.9; Defining constants at the start of the module is more maintainable. Violation of 'Advisory' rule does not present a risk.
 static const Char_t DEFAULT_PASSWORD[] = "MSIDMSIDMSIDMSID";
 
+/* Time allowed for a queued request to complete */
+#define SATA_QUEUE_TIMEOUT_IN_MSEC  (10000u)
+
+/* Sectors per request when a synchronous transfer is split over the queue */
+#define SATA_SYNC_CHUNK_BLOCKS      (0x800u)
+
 /***** Type Definitions *************************************************/
 
 typedef struct {
@@ -85,6 +92,38 @@ typedef struct {
     Uint32_t reserved05;
 } Discovery0LockingFeatures;
 
+/* Queued request held in a command slot */
+typedef struct
+{
+  d_SATA_Callback_t callback;
+  void * pContext;
+  Uint32_t startTime;   /* timer ticks when issued */
+  Uint32_t prdtCount;   /* scatter-gather entries in the command table */
+  Bool_t writeFlag;
+} SataQueueEntry_t;
+
+/* Request queue, a slot is allocated while its request is built and issued when written to PxCI */
+typedef struct
+{
+  Bool_t initialised;
+  Bool_t ncq;                   /* native command queuing in use, otherwise one DMA command at a time */
+  Bool_t hold;                  /* no new requests, set while non-queued commands are issued */
+  volatile Bool_t errorPending; /* error interrupt seen, recovery is due */
+  Uint32_t port;
+  Uint32_t slotMask;            /* slots usable for requests */
+  volatile Uint32_t allocated;  /* slots in use */
+  volatile Uint32_t issued;     /* slots issued to the controller */
+  SataQueueEntry_t entry[AHCI_MAX_CMD_SLOTS];
+  d_SATA_QueueStats_t stats;
+} SataQueue_t;
+
+/* Completion tracking of a synchronous transfer split over the queue */
+typedef struct
+{
+  volatile Uint32_t pending;
+  volatile d_Status_t status;
+} SataSyncRequest_t;
+
 /***** Variables ********************************************************/
 
 AhciCmdInfo_t cmdInfo;
@@ -95,6 +134,10 @@ Uint8_t __attribute__ ((aligned (1024))) dmaMem[AHCI_PORT_DMA_SIZE]; // DMA memo
 
 d_SATA_DeviceInfo_t d_SATA_DeviceInfo;
 
+static SataQueue_t queue;
+
+static Uint16_t __attribute__ ((aligned (64))) ncqErrorLog[256u];
+
 /***** Function Declarations ********************************************/  
 
 static d_Status_t d_SATAOP_EncTerminateSession(const Uint32_t port);
@@ -136,6 +179,19 @@ Uint32_t value          /**< [in] The value to write to the register */
   d_GEN_RegisterWrite(XPAR_PSU_SATA_S_AXI_BASEADDR + offset, value);
 }
 
+/*********************************************************************//**
+  <!-- AhciCmdTable -->
+
+  Returns the address of the command table of a command slot
+
+*************************************************************************/
+static Uint32_t            /** \return Address of the command table */
+AhciCmdTable
+(const Uint32_t slot)      /**< [in] command slot */
+{
+  return cmdInfo.cmdTbl + (slot * AHCI_CMD_TBL_SIZE);
+}
+
 /*********************************************************************//**
   <!-- AhciFillCmdSlot -->
 
@@ -144,13 +200,15 @@ Uint32_t value          /**< [in] The value to write to the register */
 *************************************************************************/
 static void              /** \return None */
 AhciFillCmdSlot
-(Uint32_t opts)         /**< [in] options to be set in the command slot */
+(const Uint32_t slot,   /**< [in] command slot to fill */
+Uint32_t opts)          /**< [in] options to be set in the command slot */
 {
-  cmdInfo.cmdSlot->opts = opts;
-  cmdInfo.cmdSlot->status = 0u;
-  Uint64_t addr = (Uint64_t)cmdInfo.cmdTbl;
-  cmdInfo.cmdSlot->tbl_addr = (Uint32_t)addr;
-  cmdInfo.cmdSlot->tbl_addr_hi = (Uint32_t)(addr >> 32u);
+  AhchiCmdHdr_t * cmdHdr = &cmdInfo.cmdSlot[slot];
+  cmdHdr->opts = opts;
+  cmdHdr->status = 0u;
+  Uint64_t addr = (Uint64_t)AhciCmdTable(slot);
+  cmdHdr->tbl_addr = (Uint32_t)addr;
+  cmdHdr->tbl_addr_hi = (Uint32_t)(addr >> 32u);
 }
 
 /*********************************************************************//**
@@ -162,21 +220,22 @@ AhciFillCmdSlot
 static Uint32_t                    /** \return The amount of entries in the SG table */
 AhciFillSg
 (
-const Uint8_t * const pBuffer,              /**< [Out] buffer to write the response */
-const Uint32_t bufferSize)      /**< [in] size of the buffer */
+AhciSg_t * ahciSg,                 /**< [out] first scatter-gather entry to fill */
+const Uint8_t * const pBuffer,     /**< [in] buffer for the transfer */
+const Uint32_t bufferSize)         /**< [in] size of the buffer */
 {
   const Uint32_t MAX_DATA_BYTE_COUNT =  (4u*1024u*1024u);
 
   Uint32_t buffLength = bufferSize;
   Uint32_t sgCount = ((buffLength - 1u) / MAX_DATA_BYTE_COUNT) + 1u;
-  AhciSg_t * ahciSg = cmdInfo.cmdTblSg;
+  AhciSg_t * pSg = ahciSg;
   for (Uint32_t i = 0u; i < sgCount; i++)
   {
     // cppcheck-suppress misra-c2012-11.4; Conversion between pointer and integer cannot be avoided in this case. Violation of 'Advisory' rule does not present a risk.
     Uint32_t tmpAddr = (Uint32_t)&pBuffer[MAX_DATA_BYTE_COUNT * i]; // First cast pointer to 32bit integer
     Uint64_t addr = (Uint64_t)tmpAddr; // now cast 32 bit int to 64bit int
-    ahciSg->addr = (Uint32_t)addr;
-    ahciSg->addr_hi = (Uint32_t)(addr >> 32u);
+    pSg->addr = (Uint32_t)addr;
+    pSg->addr_hi = (Uint32_t)(addr >> 32u);
     
     Uint32_t flagSize = (MAX_DATA_BYTE_COUNT - 1u);
     if (buffLength < MAX_DATA_BYTE_COUNT)
@@ -186,9 +245,9 @@ const Uint32_t bufferSize)      /**< [in] size of the buffer */
     // gcov-jst 1 It is not practical to generate this failure during bench testing.
     ELSE_DO_NOTHING
 
-    ahciSg->flags_size = (0x3fffffu & flagSize);
+    pSg->flags_size = (0x3fffffu & flagSize);
 
-    ahciSg++;
+    pSg++;
     buffLength -= MAX_DATA_BYTE_COUNT;
   }
 
@@ -196,13 +255,14 @@ const Uint32_t bufferSize)      /**< [in] size of the buffer */
 }
 
 /*********************************************************************//**
-  <!-- AhciDataIo -->
+  <!-- AhciNonQueuedIo -->
 
-  IO operation for AHCI port
+  IO operation for AHCI port using command slot 0
+  The request queue must be idle
 
 *************************************************************************/
 static d_Status_t               /** \return 0 upon success, error code on failure */
-AhciDataIo
+AhciNonQueuedIo
 (const Uint8_t * const pFis,    /**< [in] pointer to the FIS array */
 const Uint32_t fisLength,       /**< [in] length of the FIS array */
 const Uint8_t * const pBuffer,              /**< [Out] buffer to write the response */
@@ -218,7 +278,7 @@ const Uint32_t port)            /**< [in] Sata port to use */
   Uint32_t sgCount = 0u;
   if (pBuffer != NULL)
   {
-    sgCount = AhciFillSg(pBuffer, bufferSize);
+    sgCount = AhciFillSg(cmdInfo.cmdTblSg, pBuffer, bufferSize);
   }
   ELSE_DO_NOTHING
 
@@ -229,11 +289,12 @@ const Uint32_t port)            /**< [in] Sata port to use */
   }
   ELSE_DO_NOTHING
 
-  AhciFillCmdSlot(opts);
+  AhciFillCmdSlot(0u, opts);
 
   // Ensure data for SATA controller is flushed out of dcache and written to physical memory.
   // cppcheck-suppress misra-c2012-11.4; Conversion from pointer to integer cannot be avoided in this case. Violation of 'Advisory' rule does not present a risk.
-  d_MEMORY_DCacheFlushRange((Pointer_t)cmdInfo.cmdSlot, AHCI_PORT_DMA_SIZE);
+  d_MEMORY_DCacheFlushRange((Pointer_t)cmdInfo.cmdSlot, AHCI_CMD_HDR_SIZE);
+  d_MEMORY_DCacheFlushRange((Pointer_t)cmdInfo.cmdTbl, AHCI_CMD_TBL_HDR + (sgCount * sizeof(AhciSg_t)));
   if (pBuffer != NULL)
   {
     // cppcheck-suppress misra-c2012-11.4; Conversion from pointer to integer cannot be avoided in this case. Violation of 'Advisory' rule does not present a risk.
@@ -270,6 +331,263 @@ const Uint32_t port)            /**< [in] Sata port to use */
   return returnValue;
 }
 
+/*********************************************************************//**
+  <!-- CountSlots -->
+
+  Counts the command slots set in a slot mask
+
+*************************************************************************/
+static Uint32_t           /** \return Number of slots in the mask */
+CountSlots
+(const Uint32_t mask)     /**< [in] slot mask */
+{
+  Uint32_t count = 0u;
+  Uint32_t bits = mask;
+  while (bits != 0u)
+  {
+    bits &= (bits - 1u);
+    count++;
+  }
+
+  return count;
+}
+
+/*********************************************************************//**
+  <!-- QueueComplete -->
+
+  Completes queued requests: read buffers are invalidated in the data
+  cache, the slots are released and the callbacks made
+
+*************************************************************************/
+static void                   /** \return None */
+QueueComplete
+(const Uint32_t slotMask,     /**< [in] slots of the requests to complete */
+const d_Status_t status)      /**< [in] completion status of the requests */
+{
+  SataQueueEntry_t completed[AHCI_MAX_CMD_SLOTS];
+
+  for (Uint32_t slot = 0u; slot < AHCI_MAX_CMD_SLOTS; slot++)
+  {
+    if ((slotMask & ((Uint32_t)1u << slot)) != 0u)
+    {
+      /* The PRDT still describes the buffer of a read, discard any stale lines */
+      if ((status == d_STATUS_SUCCESS) && (queue.entry[slot].writeFlag == d_FALSE))
+      {
+        // cppcheck-suppress misra-c2012-11.4; Conversion between pointer and integer cannot be avoided in this case. Violation of 'Advisory' rule does not present a risk.
+        const AhciSg_t * pSg = (const AhciSg_t *)(AhciCmdTable(slot) + AHCI_CMD_TBL_HDR);
+        for (Uint32_t i = 0u; i < queue.entry[slot].prdtCount; i++)
+        {
+          d_MEMORY_DCacheInvalidateRange((Pointer_t)pSg[i].addr, (pSg[i].flags_size & 0x3fffffu) + 1u);
+        }
+      }
+      ELSE_DO_NOTHING
+
+      completed[slot] = queue.entry[slot];
+    }
+    ELSE_DO_NOTHING
+  }
+
+  Uint32_t interruptState = d_INT_CriticalSectionEnter();
+  queue.allocated &= ~slotMask;
+  if (status == d_STATUS_SUCCESS)
+  {
+    queue.stats.completed += CountSlots(slotMask);
+  }
+  else if (status == d_STATUS_TIMEOUT)
+  {
+    queue.stats.timeouts += CountSlots(slotMask);
+  }
+  else
+  {
+    queue.stats.errors += CountSlots(slotMask);
+  }
+  d_INT_CriticalSectionLeave(interruptState);
+
+  /* Callbacks are made with the slot released so the callback can submit the next request */
+  for (Uint32_t slot = 0u; slot < AHCI_MAX_CMD_SLOTS; slot++)
+  {
+    if (((slotMask & ((Uint32_t)1u << slot)) != 0u) && (completed[slot].callback != NULL))
+    {
+      completed[slot].callback(slot, status, completed[slot].pContext);
+    }
+    ELSE_DO_NOTHING
+  }
+}
+
+/*********************************************************************//**
+  <!-- AhciPortRecover -->
+
+  Recovers the port after a task file error or a request timeout. The
+  command engine is restarted, which aborts every command issued, and the
+  device is reset if it is still busy. After an NCQ error the NCQ command
+  error log is read, the device accepts no further queued commands until
+  it has been read.
+
+*************************************************************************/
+static void                     /** \return None */
+AhciPortRecover
+(const Uint32_t port,           /**< [in] Sata port to use */
+const Bool_t readErrorLog)      /**< [in] read the NCQ command error log */
+{
+  const Uint32_t ENGINE_STOP_TIMEOUT_IN_MSEC = 500u;
+  const Uint32_t LINK_TIMEOUT_IN_MSEC = 200u;
+  const Uint32_t portOffset = port * PORT_REG_OFFSET;
+  Bool_t readLog = readErrorLog;
+
+  /* stop the command engine, this clears PxCI and PxSACT */
+  Uint32_t registerValue = d_SATA_RegisterRead(PxCMD_REGISTER + portOffset);
+  registerValue &= ~PORT_CMD_ST;
+  d_SATA_RegisterWrite(PxCMD_REGISTER + portOffset, registerValue);
+
+  Uint32_t startTime = d_TIMER_ReadValueInTicks();
+  do
+  {
+    registerValue = d_SATA_RegisterRead(PxCMD_REGISTER + portOffset);
+  } while (((registerValue & PORT_CMD_LIST_ON) != 0u) && (d_TIMER_ElapsedMilliseconds(startTime, NULL) < ENGINE_STOP_TIMEOUT_IN_MSEC));
+
+  registerValue = d_SATA_RegisterRead(PxSERR_REGISTER + portOffset);
+  d_SATA_RegisterWrite(PxSERR_REGISTER + portOffset, registerValue);
+  registerValue = d_SATA_RegisterRead(PxIS_REGISTER + portOffset);
+  d_SATA_RegisterWrite(PxIS_REGISTER + portOffset, registerValue);
+  d_SATA_RegisterWrite(IS_REGISTER, (1u << port));
+
+  /* a device still busy is reset, this also clears its NCQ error state */
+  registerValue = d_SATA_RegisterRead(PxTFD_REGISTER + portOffset);
+  if ((registerValue & (PORT_TFD_ATA_BUSY | PORT_TFD_ATA_DRQ)) != 0u)
+  {
+    // gcov-jst 20 It is not practical to generate this failure during bench testing.
+    registerValue = d_SATA_RegisterRead(PxSCTL_REGISTER + portOffset) & ~PORT_SCTL_DET_MASK;
+    d_SATA_RegisterWrite(PxSCTL_REGISTER + portOffset, registerValue | PORT_SCTL_DET_COMRESET);
+    (void)d_TIMER_DelayMilliseconds(1u);
+    d_SATA_RegisterWrite(PxSCTL_REGISTER + portOffset, registerValue);
+
+    startTime = d_TIMER_ReadValueInTicks();
+    do
+    {
+      registerValue = d_SATA_RegisterRead(PxSSTS_REGISTER + portOffset);
+    } while (((registerValue & PORT_SSTS_DET_MASK) != PORT_STS_DET_PHYRDY) && (d_TIMER_ElapsedMilliseconds(startTime, NULL) < LINK_TIMEOUT_IN_MSEC));
+
+    registerValue = d_SATA_RegisterRead(PxSERR_REGISTER + portOffset);
+    d_SATA_RegisterWrite(PxSERR_REGISTER + portOffset, registerValue);
+    readLog = d_FALSE;
+  }
+  ELSE_DO_NOTHING
+
+  registerValue = d_SATA_RegisterRead(PxCMD_REGISTER + portOffset);
+  d_SATA_RegisterWrite(PxCMD_REGISTER + portOffset, registerValue | PORT_CMD_ST);
+  (void)d_SATA_RegisterRead(PxCMD_REGISTER + portOffset); /* flush */
+
+  if (readLog == d_TRUE)
+  {
+    const Uint8_t ATA_CMD_READ_LOG_EXT = 0x2Fu;
+    const Uint8_t NCQ_COMMAND_ERROR_LOG = 0x10u;
+    Uint8_t fis[20u];
+
+    d_GEN_MemorySet(fis, 0u, sizeof(fis));
+    fis[0u] = 0x27u;                  /* Host to device FIS. */
+    fis[1u] = 1u << 7u;               /* Command FIS. */
+    fis[2u] = ATA_CMD_READ_LOG_EXT;   /* Command byte. */
+    fis[4u] = NCQ_COMMAND_ERROR_LOG;  /* Log address */
+    fis[12u] = 1u;                    /* Page count */
+
+    if (AhciNonQueuedIo(fis, sizeof(fis), (Uint8_t*)ncqErrorLog, ATA_SECT_SIZE, d_FALSE, port) == d_STATUS_SUCCESS)
+    {
+      /* Byte 0 holds the tag of the failed command, bytes 2 and 3 the status and error registers */
+      const Uint8_t * pLog = (const Uint8_t *)ncqErrorLog;
+      d_ERROR_Logger(d_STATUS_DEVICE_ERROR, d_ERROR_CRITICALITY_NON_CRITICAL, 1, (Uint32_t)pLog[0u] & 0x1Fu, pLog[2u], pLog[3u]);
+    }
+    else
+    {
+      // gcov-jst 1 It is not practical to generate this failure during bench testing.
+      d_ERROR_Logger(d_STATUS_DEVICE_ERROR, d_ERROR_CRITICALITY_NON_CRITICAL, 2, port, 0, 0);
+    }
+  }
+  ELSE_DO_NOTHING
+
+  queue.stats.recoveries++;
+}
+
+/*********************************************************************//**
+  <!-- QueueHold -->
+
+  Stops new requests being queued and waits for the queue to empty, so a
+  non-queued command can be issued. Required as non-queued commands must
+  not be issued while native queued commands are outstanding.
+
+*************************************************************************/
+static d_Status_t           /** \return 0 upon success, error code on failure */
+QueueHold
+(const Uint32_t port)       /**< [in] Sata port to use */
+{
+  d_Status_t returnValue = d_STATUS_SUCCESS;
+
+  Uint32_t interruptState = d_INT_CriticalSectionEnter();
+  queue.hold = d_TRUE;
+  d_INT_CriticalSectionLeave(interruptState);
+
+  /* Requests that do not complete are timed out by the queue service, which bounds the wait */
+  Uint32_t startTime = d_TIMER_ReadValueInTicks();
+  while ((queue.allocated != 0u) && (d_TIMER_ElapsedMilliseconds(startTime, NULL) < (SATA_QUEUE_TIMEOUT_IN_MSEC * 2u)))
+  {
+    (void)d_SATAOP_QueueService(port, d_FALSE);
+  }
+
+  if (queue.allocated != 0u)
+  {
+    // gcov-jst 2 It is not practical to generate this failure during bench testing.
+    d_ERROR_Logger(d_STATUS_TIMEOUT, d_ERROR_CRITICALITY_NON_CRITICAL, 1, queue.allocated, 0, 0);
+    returnValue = d_STATUS_TIMEOUT;
+  }
+  ELSE_DO_NOTHING
+
+  return returnValue;
+}
+
+/*********************************************************************//**
+  <!-- QueueRelease -->
+
+  Allows requests to be queued again after a non-queued command
+
+*************************************************************************/
+static void                 /** \return None */
+QueueRelease
+(void)                      /**< [in] None */
+{
+  Uint32_t interruptState = d_INT_CriticalSectionEnter();
+  queue.hold = d_FALSE;
+  d_INT_CriticalSectionLeave(interruptState);
+}
+
+/*********************************************************************//**
+  <!-- AhciDataIo -->
+
+  IO operation for AHCI port
+  Outstanding queued requests are completed before the command is issued
+
+*************************************************************************/
+static d_Status_t               /** \return 0 upon success, error code on failure */
+AhciDataIo
+(const Uint8_t * const pFis,    /**< [in] pointer to the FIS array */
+const Uint32_t fisLength,       /**< [in] length of the FIS array */
+const Uint8_t * const pBuffer,              /**< [Out] buffer to write the response */
+const Uint32_t bufferSize,      /**< [in] size of the buffer */
+const Bool_t isWrite,           /**< [in] Transaction read/write flag */
+const Uint32_t port)            /**< [in] Sata port to use */
+{
+  d_Status_t returnValue = QueueHold(port);
+
+  if (returnValue == d_STATUS_SUCCESS)
+  {
+    returnValue = AhciNonQueuedIo(pFis, fisLength, pBuffer, bufferSize, isWrite, port);
+  }
+  // gcov-jst 1 It is not practical to generate this failure during bench testing.
+  ELSE_DO_NOTHING
+
+  QueueRelease();
+
+  return returnValue;
+}
+
 /*********************************************************************//**
   <!-- AtaIdStrCpy -->
 
@@ -554,6 +872,18 @@ d_SATAOP_Inquiry
 
     d_SATA_DeviceInfo.capacity = ExtractCapacity();
     d_SATA_DeviceInfo.sectorSize = ATA_SECT_SIZE;
+
+    /* Word 76 bit 8 indicates native command queuing, word 75 holds the queue depth - 1 */
+    const Uint32_t ATA_ID_SATA_CAPABILITY = 76u;
+    const Uint32_t ATA_ID_QUEUE_DEPTH = 75u;
+    d_SATA_DeviceInfo.queueDepth = 0u;
+    if ((readBuff[ATA_ID_SATA_CAPABILITY] != 0x0000u) && (readBuff[ATA_ID_SATA_CAPABILITY] != 0xFFFFu) &&
+        ((readBuff[ATA_ID_SATA_CAPABILITY] & (Uint16_t)((Uint16_t)1u << 8u)) != 0u))
+    {
+      d_SATA_DeviceInfo.queueDepth = ((Uint32_t)readBuff[ATA_ID_QUEUE_DEPTH] & 0x1Fu) + 1u;
+    }
+    // gcov-jst 1 It is not practical to generate this failure during bench testing.
+    ELSE_DO_NOTHING
   }
   // gcov-jst 1 It is not practical to generate this failure during bench testing.
   ELSE_DO_NOTHING
@@ -583,11 +913,507 @@ d_SATAOP_Flush
   return AhciDataIo(fis, sizeof(fis), NULL, 0u, d_FALSE, port);
 }
 
+/*********************************************************************//**
+  <!-- d_SATAOP_QueueInitialise -->
+
+  Sets up the request queue. Native command queuing is used when both the
+  controller and the drive support it, the queue depth being the smaller
+  of the two. Otherwise requests are issued one at a time as DMA commands.
+  The drive must have been identified by d_SATAOP_Inquiry.
+
+*************************************************************************/
+d_Status_t                    /** \return 0 upon success, error code on failure */
+d_SATAOP_QueueInitialise
+(const Uint32_t port)         /**< [in] Port to perform the operation */
+{
+  if (port >= SATA_PORT_COUNT)
+  {
+    d_ERROR_Logger(d_STATUS_INVALID_PARAMETER, d_ERROR_CRITICALITY_NON_CRITICAL, 1, port, 0, 0);
+    // cppcheck-suppress misra-c2012-15.5; Coding standard allows function to return if parameters are invalid
+    return d_STATUS_INVALID_PARAMETER;
+  }
+  ELSE_DO_NOTHING
+
+  d_GEN_MemorySet((Uint8_t*)&queue, 0u, sizeof(queue));
+  queue.port = port;
+
+  Uint32_t capabilities = d_SATA_RegisterRead(CAP_REGISTER);
+  Uint32_t depth = ((capabilities >> CAP_NCS_SHIFT) & CAP_NCS_MASK) + 1u;
+  if (((capabilities & CAP_SNCQ) != 0u) && (d_SATA_DeviceInfo.queueDepth != 0u))
+  {
+    queue.ncq = d_TRUE;
+    if (d_SATA_DeviceInfo.queueDepth < depth)
+    {
+      depth = d_SATA_DeviceInfo.queueDepth;
+    }
+    // gcov-jst 1 It is not practical to generate this failure during bench testing.
+    ELSE_DO_NOTHING
+  }
+  else
+  {
+    // gcov-jst 2 It is not practical to generate this failure during bench testing.
+    queue.ncq = d_FALSE;
+    depth = 1u;
+  }
+
+  queue.slotMask = (depth >= AHCI_MAX_CMD_SLOTS) ? 0xFFFFFFFFu : (((Uint32_t)1u << depth) - 1u);
+  queue.stats.queueDepth = CountSlots(queue.slotMask);
+
+  /* clear pending status and enable the completion and error interrupts of the port */
+  Uint32_t registerValue = d_SATA_RegisterRead(PxIS_REGISTER + (port * PORT_REG_OFFSET));
+  d_SATA_RegisterWrite(PxIS_REGISTER + (port * PORT_REG_OFFSET), registerValue);
+  d_SATA_RegisterWrite(IS_REGISTER, (1u << port));
+  d_SATA_RegisterWrite(PxIE_REGISTER + (port * PORT_REG_OFFSET), PORT_IS_DHRS | PORT_IS_SDBS | PORT_IS_ERROR_MASK);
+
+  registerValue = d_SATA_RegisterRead(GHC_REGISTER);
+  d_SATA_RegisterWrite(GHC_REGISTER, registerValue | HOST_CONTROL_INETRRUPT_ENABLE);
+  (void)d_SATA_RegisterRead(GHC_REGISTER); /* flush */
+
+  queue.initialised = d_TRUE;
+
+  return d_STATUS_SUCCESS;
+}
+
+/*********************************************************************//**
+  <!-- d_SATAOP_QueueSubmit -->
+
+  SATA operation function to queue a read or write
+  Builds the command, a READ/WRITE FPDMA QUEUED when native command queuing
+  is in use, and the scatter-gather table in a free command slot and
+  issues it without waiting for completion
+
+*************************************************************************/
+d_Status_t                                /** \return 0 upon success, error code on failure */
+d_SATAOP_QueueSubmit
+(const Uint32_t port,                     /**< [in] Port to perform the operation */
+const Uint32_t lba,                       /**< [in] logical block to start the transfer */
+const d_SATA_SgEntry_t * const pSgList,   /**< [in] list of buffer segments */
+const Uint32_t sgCount,                   /**< [in] number of entries in the list */
+const Bool_t writeFlag,                   /**< [in] Flag indicating direction of transaction */
+const d_SATA_Callback_t callback,         /**< [in] completion callback, may be NULL */
+void * const pContext,                    /**< [in] context passed to the callback */
+Uint32_t * const pTag)                    /**< [out] tag of the request, may be NULL */
+{
+  const Uint32_t MAX_DATA_BYTE_COUNT =  (4u*1024u*1024u);
+
+  if ((queue.initialised != d_TRUE) || (port != queue.port))
+  {
+    d_ERROR_Logger(d_STATUS_NOT_INITIALISED, d_ERROR_CRITICALITY_NON_CRITICAL, 1, port, 0, 0);
+    // cppcheck-suppress misra-c2012-15.5; Coding standard allows function to return if parameters are invalid
+    return d_STATUS_NOT_INITIALISED;
+  }
+  ELSE_DO_NOTHING
+
+  if ((pSgList == NULL) || (sgCount == 0u) || (sgCount > AHCI_PRDT_ENTRIES))
+  {
+    d_ERROR_Logger(d_STATUS_INVALID_PARAMETER, d_ERROR_CRITICALITY_NON_CRITICAL, 2, sgCount, 0, 0);
+    // cppcheck-suppress misra-c2012-15.5; Coding standard allows function to return if parameters are invalid
+    return d_STATUS_INVALID_PARAMETER;
+  }
+  ELSE_DO_NOTHING
+
+  /* Segments must be word aligned with an even length, each takes one scatter-gather entry per 4M bytes */
+  Uint32_t totalLength = 0u;
+  Uint32_t prdtCount = 0u;
+  for (Uint32_t i = 0u; i < sgCount; i++)
+  {
+    // cppcheck-suppress misra-c2012-11.4; Conversion between pointer and integer cannot be avoided in this case. Violation of 'Advisory' rule does not present a risk.
+    Uint32_t address = (Uint32_t)pSgList[i].pBuffer;
+    if ((pSgList[i].pBuffer == NULL) || (pSgList[i].length == 0u) || ((pSgList[i].length & 1u) != 0u) || ((address & 1u) != 0u) ||
+        (pSgList[i].length > ((d_SATA_MAX_REQUEST_BLOCKS * ATA_SECT_SIZE) - totalLength)))
+    {
+      d_ERROR_Logger(d_STATUS_INVALID_PARAMETER, d_ERROR_CRITICALITY_NON_CRITICAL, 3, i, address, pSgList[i].length);
+      // cppcheck-suppress misra-c2012-15.5; Coding standard allows function to return if parameters are invalid
+      return d_STATUS_INVALID_PARAMETER;
+    }
+    ELSE_DO_NOTHING
+
+    totalLength += pSgList[i].length;
+    prdtCount += ((pSgList[i].length - 1u) / MAX_DATA_BYTE_COUNT) + 1u;
+  }
+
+  Uint32_t blockCount = totalLength / ATA_SECT_SIZE;
+  if (((totalLength % ATA_SECT_SIZE) != 0u) || (blockCount > d_SATA_DeviceInfo.capacity) || (lba > (d_SATA_DeviceInfo.capacity - blockCount)))
+  {
+    d_ERROR_Logger(d_STATUS_INVALID_PARAMETER, d_ERROR_CRITICALITY_NON_CRITICAL, 4, lba, totalLength, 0);
+    // cppcheck-suppress misra-c2012-15.5; Coding standard allows function to return if parameters are invalid
+    return d_STATUS_INVALID_PARAMETER;
+  }
+  ELSE_DO_NOTHING
+
+  if (prdtCount > AHCI_PRDT_ENTRIES)
+  {
+    d_ERROR_Logger(d_STATUS_LIMIT_EXCEEDED, d_ERROR_CRITICALITY_NON_CRITICAL, 5, prdtCount, 0, 0);
+    // cppcheck-suppress misra-c2012-15.5; Coding standard allows function to return if parameters are invalid
+    return d_STATUS_LIMIT_EXCEEDED;
+  }
+  ELSE_DO_NOTHING
+
+  /* allocate the lowest free slot */
+  d_Status_t returnValue = d_STATUS_SUCCESS;
+  Uint32_t slot = 0u;
+  Uint32_t interruptState = d_INT_CriticalSectionEnter();
+  Uint32_t freeSlots = queue.slotMask & ~queue.allocated;
+  if (queue.hold == d_TRUE)
+  {
+    returnValue = d_STATUS_DEVICE_BUSY;
+  }
+  else if (freeSlots == 0u)
+  {
+    returnValue = d_STATUS_BUFFER_FULL;
+  }
+  else
+  {
+    while ((freeSlots & ((Uint32_t)1u << slot)) == 0u)
+    {
+      slot++;
+    }
+    queue.allocated |= ((Uint32_t)1u << slot);
+  }
+  d_INT_CriticalSectionLeave(interruptState);
+
+  if (returnValue != d_STATUS_SUCCESS)
+  {
+    // cppcheck-suppress misra-c2012-15.5; Function returns as the request cannot be queued
+    return returnValue;
+  }
+  ELSE_DO_NOTHING
+
+  /* construct the FIS */
+  Uint32_t cmdTbl = AhciCmdTable(slot);
+  // cppcheck-suppress misra-c2012-11.4; Conversion between pointer and integer cannot be avoided in this case. Violation of 'Advisory' rule does not present a risk.
+  Uint8_t * fis = (Uint8_t *)cmdTbl;
+  d_GEN_MemorySet(fis, 0u, 20u);
+
+  fis[0u] = 0x27u;      /* Host to device FIS. */
+  fis[1u] = 1u << 7u;   /* Command FIS. */
+  fis[4u] = (lba >> 0u) & 0xffu;
+  fis[5u] = (lba >> 8u) & 0xffu;
+  fis[6u] = (lba >> 16u) & 0xffu;
+  fis[7u] = 1u << 6u;   /* device reg: set LBA mode */
+  fis[8u] = ((lba >> 24u) & 0xffu);
+
+  if (queue.ncq == d_TRUE)
+  {
+    const Uint8_t ATA_CMD_READ_FPDMA_QUEUED = 0x60u;
+    const Uint8_t ATA_CMD_WRITE_FPDMA_QUEUED = 0x61u;
+    fis[2u] = (writeFlag == d_TRUE) ? ATA_CMD_WRITE_FPDMA_QUEUED : ATA_CMD_READ_FPDMA_QUEUED;
+
+    /* Block (sector) count goes in the features registers, the tag in the count register */
+    fis[3u] = (blockCount >> 0u) & 0xffu;
+    fis[11u] = (blockCount >> 8u) & 0xffu;
+    fis[12u] = (Uint8_t)(slot << 3u);
+  }
+  else
+  {
+    // gcov-jst 6 It is not practical to generate this failure during bench testing.
+    const Uint8_t ATA_CMD_READ_EXT     = 0x25u;  /* Read command */
+    const Uint8_t ATA_CMD_WRITE_EXT    = 0x35u;  /* write command */
+    fis[2u] = (writeFlag == d_TRUE) ? ATA_CMD_WRITE_EXT : ATA_CMD_READ_EXT;
+    fis[12u] = (blockCount >> 0u) & 0xffu;
+    fis[13u] = (blockCount >> 8u) & 0xffu;
+  }
+
+  /* scatter-gather table */
+  // cppcheck-suppress misra-c2012-11.4; Conversion between pointer and integer cannot be avoided in this case. Violation of 'Advisory' rule does not present a risk.
+  AhciSg_t * pSg = (AhciSg_t *)(cmdTbl + AHCI_CMD_TBL_HDR);
+  Uint32_t sgIndex = 0u;
+  for (Uint32_t i = 0u; i < sgCount; i++)
+  {
+    sgIndex += AhciFillSg(&pSg[sgIndex], pSgList[i].pBuffer, pSgList[i].length);
+
+    // cppcheck-suppress misra-c2012-11.4; Conversion from pointer to integer cannot be avoided in this case. Violation of 'Advisory' rule does not present a risk.
+    d_MEMORY_DCacheFlushRange((Pointer_t)pSgList[i].pBuffer, pSgList[i].length);
+  }
+
+  Uint32_t opts = (20u >> 2u) | (prdtCount << 16u);
+  if (writeFlag == d_TRUE)
+  {
+    opts |= ((Uint32_t)1u << 6u);
+  }
+  ELSE_DO_NOTHING
+
+  AhciFillCmdSlot(slot, opts);
+
+  // cppcheck-suppress misra-c2012-11.4; Conversion from pointer to integer cannot be avoided in this case. Violation of 'Advisory' rule does not present a risk.
+  d_MEMORY_DCacheFlushRange((Pointer_t)&cmdInfo.cmdSlot[slot], AHCI_CMD_HDR_SIZE);
+  d_MEMORY_DCacheFlushRange((Pointer_t)cmdTbl, AHCI_CMD_TBL_HDR + (prdtCount * sizeof(AhciSg_t)));
+
+  queue.entry[slot].callback = callback;
+  queue.entry[slot].pContext = pContext;
+  queue.entry[slot].prdtCount = prdtCount;
+  queue.entry[slot].writeFlag = writeFlag;
+
+  /* issue, PxSACT is set before PxCI for a queued command */
+  interruptState = d_INT_CriticalSectionEnter();
+  queue.entry[slot].startTime = d_TIMER_ReadValueInTicks();
+  if (queue.ncq == d_TRUE)
+  {
+    d_SATA_RegisterWrite(PxSACT_REGISTER + (port * PORT_REG_OFFSET), ((Uint32_t)1u << slot));
+  }
+  // gcov-jst 1 It is not practical to generate this failure during bench testing.
+  ELSE_DO_NOTHING
+  d_SATA_RegisterWrite(PxCI_REGISTER + (port * PORT_REG_OFFSET), ((Uint32_t)1u << slot));
+  queue.issued |= ((Uint32_t)1u << slot);
+  queue.stats.submitted++;
+  Uint32_t outstanding = CountSlots(queue.issued);
+  if (outstanding > queue.stats.maxOutstanding)
+  {
+    queue.stats.maxOutstanding = outstanding;
+  }
+  ELSE_DO_NOTHING
+  d_INT_CriticalSectionLeave(interruptState);
+
+  if (pTag != NULL)
+  {
+    *pTag = slot;
+  }
+  ELSE_DO_NOTHING
+
+  return d_STATUS_SUCCESS;
+}
+
+/*********************************************************************//**
+  <!-- d_SATAOP_QueueService -->
+
+  SATA operation function to service the request queue
+  Completes the requests the controller has finished with. Outside
+  interrupt context it also recovers the port after an error or a request
+  timeout, failing every request outstanding as the device aborts them.
+
+*************************************************************************/
+Uint32_t                          /** \return The number of requests outstanding */
+d_SATAOP_QueueService
+(const Uint32_t port,             /**< [in] Port to perform the operation */
+const Bool_t interruptContext)    /**< [in] d_TRUE when called from the interrupt handler */
+{
+  if ((queue.initialised != d_TRUE) || (port != queue.port))
+  {
+    // cppcheck-suppress misra-c2012-15.5; Function returns as there is no queue to service
+    return 0u;
+  }
+  ELSE_DO_NOTHING
+
+  const Uint32_t portOffset = port * PORT_REG_OFFSET;
+  Uint32_t done = 0u;
+
+  Uint32_t interruptState = d_INT_CriticalSectionEnter();
+  Uint32_t intStatus = d_SATA_RegisterRead(PxIS_REGISTER + portOffset);
+  d_SATA_RegisterWrite(PxIS_REGISTER + portOffset, intStatus);
+  d_SATA_RegisterWrite(IS_REGISTER, (1u << port));
+
+  if (((intStatus & PORT_IS_ERROR_MASK) != 0u) && (queue.issued != 0u))
+  {
+    /* Completions cannot be trusted once the controller has stopped, all are failed by the recovery */
+    queue.errorPending = d_TRUE;
+  }
+  ELSE_DO_NOTHING
+
+  if (queue.errorPending == d_FALSE)
+  {
+    Uint32_t busy = d_SATA_RegisterRead(PxSACT_REGISTER + portOffset) | d_SATA_RegisterRead(PxCI_REGISTER + portOffset);
+    done = queue.issued & ~busy;
+    queue.issued &= ~done;
+  }
+  ELSE_DO_NOTHING
+  d_INT_CriticalSectionLeave(interruptState);
+
+  if (done != 0u)
+  {
+    QueueComplete(done, d_STATUS_SUCCESS);
+  }
+  ELSE_DO_NOTHING
+
+  if (interruptContext == d_FALSE)
+  {
+    /* The oldest request decides the timeout, so the timer is not read for every slot */
+    Bool_t expired = d_FALSE;
+    Uint32_t now = d_TIMER_ReadValueInTicks();
+    Uint32_t oldestAge = 0u;
+    for (Uint32_t slot = 0u; slot < AHCI_MAX_CMD_SLOTS; slot++)
+    {
+      if (((queue.issued & ((Uint32_t)1u << slot)) != 0u) && ((now - queue.entry[slot].startTime) > oldestAge))
+      {
+        oldestAge = now - queue.entry[slot].startTime;
+      }
+      ELSE_DO_NOTHING
+    }
+
+    if ((oldestAge != 0u) && (d_TIMER_ElapsedMilliseconds(now - oldestAge, NULL) >= SATA_QUEUE_TIMEOUT_IN_MSEC))
+    {
+      // gcov-jst 1 It is not practical to generate this failure during bench testing.
+      expired = d_TRUE;
+    }
+    ELSE_DO_NOTHING
+
+    if ((queue.errorPending == d_TRUE) || (expired == d_TRUE))
+    {
+      // gcov-jst 15 It is not practical to generate this failure during bench testing.
+      interruptState = d_INT_CriticalSectionEnter();
+      Uint32_t failed = queue.issued;
+      Bool_t deviceError = queue.errorPending;
+      Bool_t holdSave = queue.hold;
+      queue.issued = 0u;
+      queue.hold = d_TRUE;
+      d_INT_CriticalSectionLeave(interruptState);
+
+      AhciPortRecover(port, ((deviceError == d_TRUE) && (queue.ncq == d_TRUE)) ? d_TRUE : d_FALSE);
+
+      interruptState = d_INT_CriticalSectionEnter();
+      queue.errorPending = d_FALSE;
+      queue.hold = holdSave;
+      d_INT_CriticalSectionLeave(interruptState);
+
+      QueueComplete(failed, (deviceError == d_TRUE) ? d_STATUS_DEVICE_ERROR : d_STATUS_TIMEOUT);
+    }
+    ELSE_DO_NOTHING
+  }
+  ELSE_DO_NOTHING
+
+  return CountSlots(queue.allocated);
+}
+
+/*********************************************************************//**
+  <!-- d_SATAOP_QueueGetStats -->
+
+  SATA operation function to read the request queue statistics
+
+*************************************************************************/
+d_Status_t                              /** \return 0 upon success, error code on failure */
+d_SATAOP_QueueGetStats
+(const Uint32_t port,                   /**< [in] Port to perform the operation */
+d_SATA_QueueStats_t * const pStats)     /**< [out] pointer to structure for the statistics */
+{
+  d_Status_t returnValue = d_STATUS_SUCCESS;
+
+  if (pStats == NULL)
+  {
+    d_ERROR_Logger(d_STATUS_INVALID_PARAMETER, d_ERROR_CRITICALITY_NON_CRITICAL, 1, 0, 0, 0);
+    returnValue = d_STATUS_INVALID_PARAMETER;
+  }
+  else if ((queue.initialised != d_TRUE) || (port != queue.port))
+  {
+    returnValue = d_STATUS_NOT_INITIALISED;
+  }
+  else
+  {
+    Uint32_t interruptState = d_INT_CriticalSectionEnter();
+    *pStats = queue.stats;
+    d_INT_CriticalSectionLeave(interruptState);
+  }
+
+  return returnValue;
+}
+
+/*********************************************************************//**
+  <!-- SyncRequestCallback -->
+
+  Completion callback of the requests of a synchronous transfer
+
+*************************************************************************/
+static void                   /** \return None */
+SyncRequestCallback
+(const Uint32_t tag,          /**< [in] tag of the completed request */
+const d_Status_t status,      /**< [in] completion status */
+void * const pContext)        /**< [in] synchronous request tracking */
+{
+  UNUSED_PARAMETER(tag);
+  // cppcheck-suppress misra-c2012-11.5; The context is always the tracking structure of the transfer. Violation of 'Advisory' rule does not present a risk.
+  SataSyncRequest_t * pRequest = (SataSyncRequest_t *)pContext;
+
+  Uint32_t interruptState = d_INT_CriticalSectionEnter();
+  if ((status != d_STATUS_SUCCESS) && (pRequest->status == d_STATUS_SUCCESS))
+  {
+    pRequest->status = status;
+  }
+  ELSE_DO_NOTHING
+  pRequest->pending--;
+  d_INT_CriticalSectionLeave(interruptState);
+}
+
+/*********************************************************************//**
+  <!-- QueuedReadWrite -->
+
+  Performs a synchronous read or write through the request queue. The
+  transfer is split into requests of SATA_SYNC_CHUNK_BLOCKS sectors that
+  are kept in flight together, the function returns when all complete.
+
+*************************************************************************/
+static d_Status_t             /** \return 0 upon success, error code on failure */
+QueuedReadWrite
+(const Uint32_t port,         /**< [in] Port to perform the operation */
+const Uint32_t startingLba,   /**< [in] logical block to read */
+const Uint8_t * const pBuffer,  /**< [out] pointer to buffer for the data being read/written */
+const Uint32_t blocks,        /**< [in] the amount of sectors to read/write */
+const Bool_t writeFlag)       /**< [in] Flag indicating direction of transaction */
+{
+  SataSyncRequest_t request;
+  request.pending = 0u;
+  request.status = d_STATUS_SUCCESS;
+
+  d_Status_t returnValue = d_STATUS_SUCCESS;
+  Uint32_t blockCount = blocks;
+  Uint32_t lba = startingLba;
+  Uint32_t index = 0u;
+
+  while ((blockCount > 0u) && (returnValue == d_STATUS_SUCCESS))
+  {
+    Uint32_t blocksInTransaction = (blockCount > SATA_SYNC_CHUNK_BLOCKS) ? SATA_SYNC_CHUNK_BLOCKS : blockCount;
+    d_SATA_SgEntry_t sgEntry;
+    sgEntry.pBuffer = &pBuffer[index];
+    sgEntry.length = blocksInTransaction * ATA_SECT_SIZE;
+
+    Uint32_t interruptState = d_INT_CriticalSectionEnter();
+    request.pending++;
+    d_INT_CriticalSectionLeave(interruptState);
+
+    /* wait for a free slot, the queue service times out requests so this completes */
+    do
+    {
+      returnValue = d_SATAOP_QueueSubmit(port, lba, &sgEntry, 1u, writeFlag, SyncRequestCallback, &request, NULL);
+      if (returnValue == d_STATUS_BUFFER_FULL)
+      {
+        (void)d_SATAOP_QueueService(port, d_FALSE);
+      }
+      ELSE_DO_NOTHING
+    } while (returnValue == d_STATUS_BUFFER_FULL);
+
+    if (returnValue != d_STATUS_SUCCESS)
+    {
+      // gcov-jst 4 It is not practical to generate this failure during bench testing.
+      interruptState = d_INT_CriticalSectionEnter();
+      request.pending--;
+      d_INT_CriticalSectionLeave(interruptState);
+    }
+    ELSE_DO_NOTHING
+
+    index += sgEntry.length;
+    blockCount -= blocksInTransaction;
+    lba += blocksInTransaction;
+  }
+
+  /* wait for the requests in flight */
+  while (request.pending != 0u)
+  {
+    (void)d_SATAOP_QueueService(port, d_FALSE);
+  }
+
+  if (returnValue == d_STATUS_SUCCESS)
+  {
+    returnValue = request.status;
+  }
+  // gcov-jst 1 It is not practical to generate this failure during bench testing.
+  ELSE_DO_NOTHING
+
+  return returnValue;
+}
+
 /*********************************************************************//**
   <!-- d_SATAOP_ReadWrite -->
 
   SATA operation function for Read or write
   Functions constructs the FIS command and performs IO to the device
+  The transfer goes through the request queue once it is initialised
   
 *************************************************************************/
 d_Status_t                    /** \return 0 upon success, error code on failure */
@@ -612,6 +1438,13 @@ const Bool_t writeFlag)       /**< [in] Flag indicating direction of transaction
   }
   ELSE_DO_NOTHING
 
+  if ((queue.initialised == d_TRUE) && (port == queue.port))
+  {
+    // cppcheck-suppress misra-c2012-15.5; Transfer is made by the request queue
+    return QueuedReadWrite(port, startingLba, pBuffer, blockCount, writeFlag);
+  }
+  ELSE_DO_NOTHING
+
   Uint32_t lba = startingLba;
   Uint32_t index = 0;
 
@@ -619,8 +1452,7 @@ const Bool_t writeFlag)       /**< [in] Flag indicating direction of transaction
   {
     const Uint8_t ATA_CMD_READ_EXT     = 0x25u;  // Read command
     const Uint8_t ATA_CMD_WRITE_EXT	  = 0x35u;  // write command
-    const Uint32_t MAX_SATA_BLOCKS_READ_WRITE	= 0x80;
-    Uint32_t blocksInTransaction = (blockCount > MAX_SATA_BLOCKS_READ_WRITE) ? MAX_SATA_BLOCKS_READ_WRITE: blockCount;
+    Uint32_t blocksInTransaction = (blockCount > SATA_SYNC_CHUNK_BLOCKS) ? SATA_SYNC_CHUNK_BLOCKS: blockCount;
     Uint32_t transferSize = blocksInTransaction * ATA_SECT_SIZE;
 
     // construct the FIS
@@ -638,9 +1470,9 @@ const Bool_t writeFlag)       /**< [in] Flag indicating direction of transaction
 
     fis[3u] = 0xe0u; /* features */
     
-    /* Block (sector) count */
-    fis[12u] = (blockCount >> 0u) & 0xffu;
-    fis[13u] = (blockCount >> 8u) & 0xffu;
+    /* Block (sector) count of this transaction */
+    fis[12u] = (blocksInTransaction >> 0u) & 0xffu;
+    fis[13u] = (blocksInTransaction >> 8u) & 0xffu;
 
     returnValue = AhciDataIo(fis, sizeof(fis), &pBuffer[index], transferSize, writeFlag, port);
     if (returnValue != d_STATUS_SUCCESS)
@@ -33,7 +33,15 @@
 
 /***** Constants ********************************************************/
 
-#define AHCI_PORT_DMA_SIZE   (0x17400u)
+// AHCI port DMA memory layout: command list, received FIS area and one command table per slot
+#define AHCI_MAX_CMD_SLOTS   (32u)                                    // command slots in the command list
+#define AHCI_CMD_HDR_SIZE    (32u)                                    // size of a command header
+#define AHCI_CMD_LIST_SIZE   (AHCI_MAX_CMD_SLOTS * AHCI_CMD_HDR_SIZE) // command list, 1K-byte aligned
+#define AHCI_RX_FIS_SIZE     (256u)                                   // received FIS area, 256 byte aligned
+#define AHCI_CMD_TBL_HDR     (0x80u)                                  // command FIS, ATAPI command and reserved area
+#define AHCI_PRDT_ENTRIES    (56u)                                    // scatter-gather entries per command table
+#define AHCI_CMD_TBL_SIZE    (AHCI_CMD_TBL_HDR + (AHCI_PRDT_ENTRIES * 16u)) // command table, 128 byte aligned
+#define AHCI_PORT_DMA_SIZE   (AHCI_CMD_LIST_SIZE + AHCI_RX_FIS_SIZE + (AHCI_MAX_CMD_SLOTS * AHCI_CMD_TBL_SIZE))
 
 #define CAP_REGISTER        ((Uint32_t)0x00u)                 // HBA Capabilities
 #define GHC_REGISTER        ((Uint32_t)0x04u)                 // Global Host control register offset
@@ -50,11 +58,13 @@
 #define PxFB_REGISTER       ((Uint32_t)0x108u)                  // port FIS Base address
 #define PxFBU_REGISTER      ((Uint32_t)0x10Cu)                  // port FIS Base address upper 32bits 
 #define PxIS_REGISTER       ((Uint32_t)0x110u)                  // port Interrupt status
+#define PxIE_REGISTER       ((Uint32_t)0x114u)                  // port Interrupt enable
 #define PxCMD_REGISTER      ((Uint32_t)0x118u)                  // Port Command and status register
 #define PxSSTS_REGISTER     ((Uint32_t)0x128u)                  // port SATA Status register
 #define PxSCTL_REGISTER     ((Uint32_t)0x12Cu)                  // port SATA Control register
 #define PxSERR_REGISTER     ((Uint32_t)0x130u)                  // port SATA Error  and diagnostics
 #define PxTFD_REGISTER      ((Uint32_t)0x120u)                  // port SATA Task File Data
+#define PxSACT_REGISTER     ((Uint32_t)0x134u)                  // port SATA active (NCQ tags outstanding)
 #define PxCI_REGISTER       ((Uint32_t)0x138u)                  // port SATA command issue register
 
 
@@ -96,6 +106,9 @@
 #define CAP_SPM                       ((Uint32_t)1u << 17u)  
 #define CAP_SMPS                      ((Uint32_t)1u << 28u)
 #define CAP_SSS                       ((Uint32_t)1 << 27u)
+#define CAP_SNCQ                      ((Uint32_t)1u << 30u)   // supports native command queuing
+#define CAP_NCS_SHIFT                 (8u)                    // number of command slots - 1
+#define CAP_NCS_MASK                  ((Uint32_t)0x1Fu)
 
 // EM CTRL register bits
 #define EM_CTL_RESET                  ((Uint32_t)1u << 9u)
@@ -115,6 +128,18 @@
 #define PORT_STS_DET_COMINIT        ((Uint32_t)0x01u)
 #define PORT_TFD_ATA_BUSY           ((Uint32_t)1u << 7u)
 #define PORT_TFD_ATA_DRQ            ((Uint32_t)1u << 3u) // Data request i/o
+#define PORT_TFD_ATA_ERR            ((Uint32_t)1u)
+#define PORT_SCTL_DET_MASK          ((Uint32_t)0x0Fu)
+#define PORT_SCTL_DET_COMRESET      ((Uint32_t)0x01u)
+
+// Port interrupt status and enable register (PxIS, PxIE) bits
+#define PORT_IS_DHRS                ((Uint32_t)1u)            // device to host register FIS
+#define PORT_IS_SDBS                ((Uint32_t)1u << 3u)      // set device bits FIS, NCQ completion
+#define PORT_IS_IFS                 ((Uint32_t)1u << 27u)     // interface fatal error
+#define PORT_IS_HBDS                ((Uint32_t)1u << 28u)     // host bus data error
+#define PORT_IS_HBFS                ((Uint32_t)1u << 29u)     // host bus fatal error
+#define PORT_IS_TFES                ((Uint32_t)1u << 30u)     // task file error
+#define PORT_IS_ERROR_MASK          (PORT_IS_IFS | PORT_IS_HBDS | PORT_IS_HBFS | PORT_IS_TFES)
 
 // Port Config register (PCFG) bits
 #define PORT_CONTROL_TPSS_VAL       ((Uint32_t)0x32u << 16u)
@@ -200,6 +225,15 @@ d_Status_t d_SATAOP_ReadWrite(const Uint32_t port, const Uint32_t lba, const Uin
 
 d_Status_t d_SATAOP_Flush(const Uint32_t port);
 
+d_Status_t d_SATAOP_QueueInitialise(const Uint32_t port);
+
+d_Status_t d_SATAOP_QueueSubmit(const Uint32_t port, const Uint32_t lba, const d_SATA_SgEntry_t * const pSgList, const Uint32_t sgCount,
+                                const Bool_t writeFlag, const d_SATA_Callback_t callback, void * const pContext, Uint32_t * const pTag);
+
+Uint32_t d_SATAOP_QueueService(const Uint32_t port, const Bool_t interruptContext);
+
+d_Status_t d_SATAOP_QueueGetStats(const Uint32_t port, d_SATA_QueueStats_t * const pStats);
+
 d_Status_t d_SATAOP_Discovery0(const Uint32_t port, d_SATAENC_SelfEncryptionStatus_t * pLockStatus);
 
 d_Status_t d_SATAOP_EncInitialSetup(const Uint32_t port, const Char_t * const password, const Uint32_t pwdLength);
@@ -28,6 +28,9 @@
 
 /***** Constants ********************************************************/
 
+/* Rate of the global timer in ticks per second, 100MHz / 2^6 */
+#define d_TIMER_TICKS_PER_SECOND  1562500u
+
 /***** Type Definitions *************************************************/
 
 /***** Variables ********************************************************/
@@ -252,6 +252,70 @@ const Uint32_t length   /**< [in] Number of bytes to discard */
   return status;
 }
 
+/*********************************************************************//**
+  <!-- d_UART_RxSequence -->
+
+  Get the receive sequence number of the next character to be read.
+  Arrival timing is only kept for the PL interfaces.
+*************************************************************************/
+d_Status_t                    /** \return Success or Failure */
+d_UART_RxSequence
+(
+const Uint32_t uart,          /**< [in]  UART channel */
+Uint32_t * const pSequence    /**< [out] Sequence number */
+)
+{
+  d_Status_t status;
+
+  if (uart < PL_CHANNEL_OFFSET)
+  {
+    status = d_STATUS_INVALID_MODE;
+  }
+  else if (uart < (PL_CHANNEL_OFFSET + d_UART_PL_MAX_INTERFACES))
+  {
+    status = d_UART_PlRxSequence(uart - PL_CHANNEL_OFFSET, pSequence);
+  }
+  else
+  {
+    d_ERROR_Logger(d_STATUS_INVALID_PARAMETER, d_ERROR_CRITICALITY_CRITICAL_SHUTDOWN, 1, uart, 0, 0);
+    status = d_STATUS_INVALID_PARAMETER;
+  }
+
+  return status;
+}
+
+/*********************************************************************//**
+  <!-- d_UART_ArrivalTicks -->
+
+  Get the timer value at which a received character completed.
+*************************************************************************/
+d_Status_t                    /** \return d_STATUS_NO_DATA if the character is not known */
+d_UART_ArrivalTicks
+(
+const Uint32_t uart,          /**< [in]  UART channel */
+const Uint32_t sequence,      /**< [in]  Sequence number of the character */
+Uint32_t * const pTicks       /**< [out] Timer value in ticks */
+)
+{
+  d_Status_t status;
+
+  if (uart < PL_CHANNEL_OFFSET)
+  {
+    status = d_STATUS_INVALID_MODE;
+  }
+  else if (uart < (PL_CHANNEL_OFFSET + d_UART_PL_MAX_INTERFACES))
+  {
+    status = d_UART_PlArrivalTicks(uart - PL_CHANNEL_OFFSET, sequence, pTicks);
+  }
+  else
+  {
+    d_ERROR_Logger(d_STATUS_INVALID_PARAMETER, d_ERROR_CRITICALITY_CRITICAL_SHUTDOWN, 1, uart, 0, 0);
+    status = d_STATUS_INVALID_PARAMETER;
+  }
+
+  return status;
+}
+
 /*********************************************************************//**
   <!-- d_UART_FlushRx -->
 
@@ -106,6 +106,15 @@ d_Status_t d_UART_Receive(const Uint32_t uart,
 d_Status_t d_UART_Discard(const Uint32_t uart,
                           const Uint32_t length);
 
+/* Get the receive sequence number of the next character to be read */
+d_Status_t d_UART_RxSequence(const Uint32_t uart,
+                             Uint32_t * const pSequence);
+
+/* Get the timer value at which a received character completed, PL interfaces only */
+d_Status_t d_UART_ArrivalTicks(const Uint32_t uart,
+                               const Uint32_t sequence,
+                               Uint32_t * const pTicks);
+
 /* Clear receive buffer */
 d_Status_t d_UART_FlushRx(const Uint32_t uart);
 
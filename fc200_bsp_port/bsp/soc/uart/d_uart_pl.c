@@ -31,6 +31,7 @@
 #include "soc/interrupt_manager/d_int_critical.h"
 #include "soc/interrupt_manager/d_int_irq_handler.h"
 #include "kernel/error_handler/d_error_handler.h"
+#include "soc/timer/d_timer.h"
 #include "sru/fcu/d_fcu_cfg.h"
 
 #include "xparameters.h"
@@ -53,6 +54,18 @@
 
 #define UART_FIFO_SIZE   16u
 
+/* Number of receive arrival marks kept for each interface */
+#define ARRIVAL_MARKS    32u
+
+/* Idle time, in characters, beyond the characters read that marks the start of a new burst */
+#define ARRIVAL_GAP_CHARACTERS  2u
+
+/* Characters after which a continuous burst is re-anchored to the timer */
+#define ARRIVAL_ANCHOR_CHARACTERS  128u
+
+/* Characters of idle time before the receiver raises a character timeout */
+#define CHAR_TIMEOUT_CHARACTERS  4u
+
 /* Register offset addresses */
 #define UART_RBR 0x0000u    /* Receive buffer */
 #define UART_THR 0x0000u    /* Transmit holding */
@@ -131,6 +144,23 @@ typedef struct
   Uint32_t dropped;
 } receiveBuffer_t;
 
+typedef struct
+{
+  Uint32_t sequence;           /* Receive sequence number of the first character of the burst */
+  Uint32_t ticks;              /* Timer value at which that character completed */
+} arrivalMark_t;
+
+typedef struct
+{
+  arrivalMark_t mark[ARRIVAL_MARKS];
+  Uint32_t markIndex;          /* Next mark to write */
+  Uint32_t markCount;          /* Marks written, up to ARRIVAL_MARKS */
+  Uint32_t sequenceIn;         /* Characters placed in the receive buffer */
+  Uint32_t sequenceOut;        /* Characters removed from the receive buffer */
+  Uint32_t lastTicks;          /* Timer value of the last character of the previous burst */
+  Uint32_t characterTicksX16;  /* Character time in timer ticks multiplied by 16 */
+} arrivalTiming_t;
+
 /***** Variables ********************************************************/
 
 /* Transmit buffer */
@@ -139,11 +169,15 @@ static transmitBuffer_t transmitBuffer[d_UART_PL_MAX_INTERFACES];
 /* Receive buffer */
 static receiveBuffer_t receiveBuffer[d_UART_PL_MAX_INTERFACES];
 
+/* Arrival time of received characters */
+static arrivalTiming_t arrivalTiming[d_UART_PL_MAX_INTERFACES];
+
 /***** Function Declarations ********************************************/
 
 static void outputChar(const Uint32_t uart);
 static void inputChar(const Uint32_t uart);
 static void bufferInitialise(const Uint32_t uart);
+static void arrivalRecord(const Uint32_t uart, const Uint32_t sequence, const Uint32_t ticks);
 static Uint8_t uartRegisterRead(const Uint32_t uart, const Uint32_t reg);
 static void uartRegisterWrite(const Uint32_t uart, const Uint32_t reg, const Uint8_t value);
 
@@ -182,6 +216,12 @@ const d_UART_StopBits_t stopBits  /**< [in] Number of stop bits */
   {
     bufferInitialise(uart);
 
+    /* Start bit, data bits, parity and stop bits */
+    Uint32_t characterBits = 1u + ((dataBits == d_UART_DATA_BITS_7) ? 7u : 8u) +
+                             ((parity == d_UART_PARITY_NONE) ? 0u : 1u) +
+                             ((stopBits == d_UART_STOP_BITS_1) ? 1u : 2u);
+    arrivalTiming[uart].characterTicksX16 = (characterBits * d_TIMER_TICKS_PER_SECOND * 16u) / baud;
+
     /* Disable all UART interrupts */
     uartRegisterWrite(uart, UART_IER, 0x00u);
   
@@ -257,6 +297,9 @@ const Uint32_t baud     /**< [in] Baudrate */
 
     bufferInitialise(uart);
 
+    /* Assume ten bit characters until the line characteristics are configured */
+    arrivalTiming[uart].characterTicksX16 = (10u * d_TIMER_TICKS_PER_SECOND * 16u) / baud;
+
     Float32_t fdivisor = ((Float32_t)uartBaudClock / (Float32_t)baud) + 0.5f;
     divisor = (Uint32_t)fdivisor;
   
@@ -512,6 +555,7 @@ const Uint32_t length   /**< [in] Number of bytes to discard */
     discardCount = receiveBuffer[uart].count;
   }
   receiveBuffer[uart].count = receiveBuffer[uart].count - discardCount;
+  arrivalTiming[uart].sequenceOut = arrivalTiming[uart].sequenceOut + discardCount;
   d_INT_CriticalSectionLeave(interruptFlags);
   receiveBuffer[uart].indexOut = (receiveBuffer[uart].indexOut + discardCount) % RECEIVE_BUFFER_LENGTH;
 
@@ -541,6 +585,92 @@ const Uint32_t uart
   return status;
 }
 
+/*********************************************************************//**
+  <!-- d_UART_PlRxSequence -->
+
+  Get the receive sequence number of the next character to be read. The
+  sequence number counts every character placed in the receive buffer.
+*************************************************************************/
+d_Status_t                    /** \return Success or Failure */
+d_UART_PlRxSequence
+(
+const Uint32_t uart,          /**< [in]  UART channel */
+Uint32_t * const pSequence    /**< [out] Sequence number */
+)
+{
+  if (uart >= d_UART_PlCount)
+  {
+    d_ERROR_Logger(d_STATUS_INVALID_PARAMETER, d_ERROR_CRITICALITY_CRITICAL_SHUTDOWN, 1, uart, 0, 0);
+    // cppcheck-suppress misra-c2012-15.5; Coding standard allows function to return if parameters are invalid
+    return d_STATUS_INVALID_PARAMETER;
+  }
+
+  if (pSequence == NULL)
+  {
+    d_ERROR_Logger(d_STATUS_INVALID_PARAMETER, d_ERROR_CRITICALITY_CRITICAL_SHUTDOWN, 2, 0, 0, 0);
+    // cppcheck-suppress misra-c2012-15.5; Coding standard allows function to return if parameters are invalid
+    return d_STATUS_INVALID_PARAMETER;
+  }
+
+  *pSequence = arrivalTiming[uart].sequenceOut;
+
+  return d_STATUS_SUCCESS;
+}
+
+/*********************************************************************//**
+  <!-- d_UART_PlArrivalTicks -->
+
+  Get the timer value at which a received character completed, from the
+  latest arrival mark at or before it.
+*************************************************************************/
+d_Status_t                    /** \return d_STATUS_NO_DATA if the character is not known */
+d_UART_PlArrivalTicks
+(
+const Uint32_t uart,          /**< [in]  UART channel */
+const Uint32_t sequence,      /**< [in]  Sequence number of the character */
+Uint32_t * const pTicks       /**< [out] Timer value in ticks */
+)
+{
+  if (uart >= d_UART_PlCount)
+  {
+    d_ERROR_Logger(d_STATUS_INVALID_PARAMETER, d_ERROR_CRITICALITY_CRITICAL_SHUTDOWN, 1, uart, 0, 0);
+    // cppcheck-suppress misra-c2012-15.5; Coding standard allows function to return if parameters are invalid
+    return d_STATUS_INVALID_PARAMETER;
+  }
+
+  if (pTicks == NULL)
+  {
+    d_ERROR_Logger(d_STATUS_INVALID_PARAMETER, d_ERROR_CRITICALITY_CRITICAL_SHUTDOWN, 2, 0, 0, 0);
+    // cppcheck-suppress misra-c2012-15.5; Coding standard allows function to return if parameters are invalid
+    return d_STATUS_INVALID_PARAMETER;
+  }
+
+  const arrivalTiming_t * const pTiming = &arrivalTiming[uart];
+  d_Status_t status = d_STATUS_NO_DATA;
+  Uint32_t index;
+  Uint64_t interruptFlags = d_INT_CriticalSectionEnter();
+
+  /* The character must have been received, the most recent mark at or before it gives its time */
+  if ((Int32_t)(pTiming->sequenceIn - sequence) > 0)
+  {
+    for (index = 1u; (index <= pTiming->markCount) && (status != d_STATUS_SUCCESS); index++)
+    {
+      const arrivalMark_t * const pMark = &pTiming->mark[(pTiming->markIndex + ARRIVAL_MARKS - index) % ARRIVAL_MARKS];
+      if ((Int32_t)(sequence - pMark->sequence) >= 0)
+      {
+        *pTicks = pMark->ticks + (((sequence - pMark->sequence) * pTiming->characterTicksX16) / 16u);
+        status = d_STATUS_SUCCESS;
+      }
+      ELSE_DO_NOTHING
+    }
+  }
+  ELSE_DO_NOTHING
+
+  d_INT_CriticalSectionLeave(interruptFlags);
+
+  return status;
+}
+
 /*********************************************************************//**
 }
   <!-- d_UART_PlFlushTx -->
@@ -650,6 +780,8 @@ const Uint32_t uart     /**< [in] UART channel */
   Uint32_t registerLsr;
   Uint32_t registerIir;
   Uint32_t sendNowCount;
+  Uint32_t burstTicks;
+  Uint32_t burstSequence;
 
   d_Status_t status = d_FCU_IocAddressCheck(d_UART_PL_Configuration[uart].baseAddress);
   if (status != d_STATUS_SUCCESS)
@@ -698,6 +830,15 @@ const Uint32_t uart     /**< [in] UART channel */
 
     case INTERRUPT_RECEIVE_READY:
     case INTERRUPT_CHAR_TIMEOUT:
+      /* Time the last character completed, a timeout is raised after the line has been idle */
+      burstTicks = d_TIMER_ReadValueInTicks();
+      if ((registerIir & 0x0Eu) == INTERRUPT_CHAR_TIMEOUT)
+      {
+        burstTicks = burstTicks - ((CHAR_TIMEOUT_CHARACTERS * arrivalTiming[uart].characterTicksX16) / 16u);
+      }
+      ELSE_DO_NOTHING
+      burstSequence = arrivalTiming[uart].sequenceIn;
+
       /* Read all characters until buffer full, or FIFO empty */
       registerLsr = uartRegisterRead(uart, UART_LSR);
       while (((registerLsr & 0x01u) != 0u) && (receiveBuffer[uart].count < RECEIVE_BUFFER_LENGTH))
@@ -711,6 +852,7 @@ const Uint32_t uart     /**< [in] UART channel */
         (void)uartRegisterRead(uart, UART_RBR);
         registerLsr = uartRegisterRead(uart, UART_LSR);
       }
+      arrivalRecord(uart, burstSequence, burstTicks);
       break;
 
     // gcov-jst 3 It is not practical to generate this failure during bench testing.
@@ -761,6 +903,7 @@ const Uint32_t uart     /**< [in] UART channel */
   receiveBuffer[uart].buffer[receiveBuffer[uart].indexIn] = uartRegisterRead(uart, UART_RBR);
   receiveBuffer[uart].indexIn = (receiveBuffer[uart].indexIn + 1u) % RECEIVE_BUFFER_LENGTH;
   receiveBuffer[uart].count++;
+  arrivalTiming[uart].sequenceIn++;
   if (receiveBuffer[uart].count > receiveBuffer[uart].maxUsed)
   {
     receiveBuffer[uart].maxUsed = receiveBuffer[uart].count;
@@ -796,6 +939,56 @@ const Uint32_t uart     /**< [in] UART channel */
   receiveBuffer[uart].maxUsed = 0;
   receiveBuffer[uart].dropped = 0;
 
+  arrivalTiming[uart].markIndex = 0;
+  arrivalTiming[uart].markCount = 0;
+  arrivalTiming[uart].sequenceOut = arrivalTiming[uart].sequenceIn;
+
+  return;
+}
+
+/*********************************************************************//**
+  <!-- arrivalRecord -->
+
+  Record the arrival of the characters read by a receive interrupt. A
+  burst that follows an idle line, or that has run on for some time, is
+  given a new mark dated back to its first character; other characters
+  are timed by extrapolation from the previous mark at the character rate.
+*************************************************************************/
+static void             /** \return None */
+arrivalRecord
+(
+const Uint32_t uart,     /**< [in] UART channel */
+const Uint32_t sequence, /**< [in] Sequence number of the first character read */
+const Uint32_t ticks     /**< [in] Timer value at which the last character completed */
+)
+{
+  arrivalTiming_t * const pTiming = &arrivalTiming[uart];
+  Uint32_t count = pTiming->sequenceIn - sequence;
+
+  if (count > 0u)
+  {
+    Uint32_t lineTicks = ((count + ARRIVAL_GAP_CHARACTERS) * pTiming->characterTicksX16) / 16u;
+    Uint32_t lastMark = (pTiming->markIndex + ARRIVAL_MARKS - 1u) % ARRIVAL_MARKS;
+
+    if ((pTiming->markCount == 0u) ||
+        ((ticks - pTiming->lastTicks) > lineTicks) ||
+        ((sequence - pTiming->mark[lastMark].sequence) >= ARRIVAL_ANCHOR_CHARACTERS))
+    {
+      pTiming->mark[pTiming->markIndex].sequence = sequence;
+      pTiming->mark[pTiming->markIndex].ticks = ticks - (((count - 1u) * pTiming->characterTicksX16) / 16u);
+      pTiming->markIndex = (pTiming->markIndex + 1u) % ARRIVAL_MARKS;
+      if (pTiming->markCount < ARRIVAL_MARKS)
+      {
+        pTiming->markCount++;
+      }
+      ELSE_DO_NOTHING
+    }
+    ELSE_DO_NOTHING
+
+    pTiming->lastTicks = ticks;
+  }
+  ELSE_DO_NOTHING
+
   return;
 }
 
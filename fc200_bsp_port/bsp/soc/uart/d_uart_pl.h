@@ -70,6 +70,15 @@ d_Status_t d_UART_PlReceive(const Uint32_t uart,
 d_Status_t d_UART_PlDiscard(const Uint32_t uart,
                             const Uint32_t length);
 
+/* Get the receive sequence number of the next character to be read */
+d_Status_t d_UART_PlRxSequence(const Uint32_t uart,
+                               Uint32_t * const pSequence);
+
+/* Get the timer value at which a received character completed */
+d_Status_t d_UART_PlArrivalTicks(const Uint32_t uart,
+                                 const Uint32_t sequence,
+                                 Uint32_t * const pTicks);
+
 /* Clear receive buffer */
 d_Status_t d_UART_PlFlushRx(const Uint32_t uart);
 
@@ -801,6 +801,74 @@ d_CAN_HOLT_Message_t * const pMessage  /**< [out] Pointer to storage for the rec
   return status;
 }
 
+/*********************************************************************//**
+  <!-- d_CAN_HOLT_ErrorStateGet -->
+
+  Get the error counters and fault confinement state.
+*************************************************************************/
+d_Status_t                               /** \return Status of operation */
+d_CAN_HOLT_ErrorStateGet
+(
+const Uint32_t channel,                  /**< [in]  CAN channel number */
+d_CAN_HOLT_ErrorState_t * const pState   /**< [out] Pointer to storage for the error state */
+)
+{
+  Uint8_t tec = 0u;
+  Uint8_t rec = 0u;
+  Uint8_t err = 0u;
+
+  if (channel >= d_CAN_HOLT_Count)
+  {
+    d_ERROR_Logger(d_STATUS_INVALID_PARAMETER, d_ERROR_CRITICALITY_CRITICAL_SHUTDOWN, 1, channel, 0, 0);
+    // cppcheck-suppress misra-c2012-15.5; Coding standard allows function to return if parameters are invalid
+    return d_STATUS_INVALID_PARAMETER;
+  }
+
+  if (initialised[channel] != d_TRUE)
+  {
+    d_ERROR_Logger(d_STATUS_NOT_INITIALISED, d_ERROR_CRITICALITY_CRITICAL_SHUTDOWN, 1, channel, 0, 0);
+    // cppcheck-suppress misra-c2012-15.5; Coding standard allows function to return if parameters are invalid
+    return d_STATUS_NOT_INITIALISED;
+  }
+
+  if (pState == NULL)
+  {
+    d_ERROR_Logger(d_STATUS_INVALID_PARAMETER, d_ERROR_CRITICALITY_CRITICAL_SHUTDOWN, 2, 0, 0, 0);
+    // cppcheck-suppress misra-c2012-15.5; Coding standard allows function to return if parameters are invalid
+    return d_STATUS_INVALID_PARAMETER;
+  }
+
+  d_Status_t status = registerRead(channel, d_CAN_HOLT_COMMAND_READ_TEC, 1, &tec);
+
+  if (status == d_STATUS_SUCCESS)
+  {
+    status = registerRead(channel, d_CAN_HOLT_COMMAND_READ_REC, 1, &rec);
+  }
+  // gcov-jst 1 It is not practical to generate this failure during bench testing.
+  ELSE_DO_NOTHING
+
+  if (status == d_STATUS_SUCCESS)
+  {
+    status = registerRead(channel, d_CAN_HOLT_COMMAND_READ_ERR, 1, &err);
+  }
+  // gcov-jst 1 It is not practical to generate this failure during bench testing.
+  ELSE_DO_NOTHING
+
+  if (status == d_STATUS_SUCCESS)
+  {
+    pState->txErrorCount = tec;
+    pState->rxErrorCount = rec;
+    pState->errorFlags = (Uint32_t)err & (d_CAN_HOLT_BITERR_MASK | d_CAN_HOLT_FRMERR_MASK | d_CAN_HOLT_CRCERR_MASK |
+                                          d_CAN_HOLT_ACKERR_MASK | d_CAN_HOLT_STUFERR_MASK);
+    pState->errorPassive = ((err & (d_CAN_HOLT_TXERRP_MASK | d_CAN_HOLT_RXERRP_MASK)) != 0u) ? d_TRUE : d_FALSE;
+    pState->busOff = ((err & d_CAN_HOLT_BUSOFF_MASK) != 0u) ? d_TRUE : d_FALSE;
+  }
+  // gcov-jst 1 It is not practical to generate this failure during bench testing.
+  ELSE_DO_NOTHING
+
+  return status;
+}
+
 /*********************************************************************//**
   <!-- d_CAN_HOLT_InterruptEnable -->
 
@@ -112,6 +112,15 @@ typedef struct
   Uint8_t data[8];
 } d_CAN_HOLT_Message_t;
 
+typedef struct
+{
+  Uint32_t txErrorCount;   /**< Transmit error counter */
+  Uint32_t rxErrorCount;   /**< Receive error counter */
+  Uint32_t errorFlags;     /**< Error register bit, form, CRC, acknowledge and stuff error flags */
+  Bool_t errorPassive;     /**< Transmitter or receiver is error passive */
+  Bool_t busOff;           /**< Device is bus off */
+} d_CAN_HOLT_ErrorState_t;
+
 typedef struct
 {
   Bool_t extended;
@@ -157,6 +166,9 @@ d_Status_t d_CAN_HOLT_SendMessage(const Uint32_t channel, const d_CAN_HOLT_Messa
 /* Receive a message frame */
 d_Status_t d_CAN_HOLT_ReceiveMessage(const Uint32_t channel, d_CAN_HOLT_Message_t * const pMessage);
 
+/* Get the error counters and fault confinement state */
+d_Status_t d_CAN_HOLT_ErrorStateGet(const Uint32_t channel, d_CAN_HOLT_ErrorState_t * const pState);
+
 /* Enable CAN Interrupt for channel */
 d_Status_t d_CAN_HOLT_InterruptEnable(const Uint32_t channel, const Uint8_t mask);
 
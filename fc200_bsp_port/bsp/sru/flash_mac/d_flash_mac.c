@@ -5,6 +5,11 @@
 
   Abstract           : Flash MAC device driver.
 
+                       The commands are queued on the PL SPI channel but,
+                       unlike the sensor reads, each call still blocks the
+                       caller until its transaction completes or the
+                       SPI_TRANSACTION_TIMEOUT_USEC timeout expires.
+
   Software Structure : SRS References: 136T-2200-131100-001-D20 SWREQ-177
                                                                 SWREQ-178
                                                                 SWREQ-179
@@ -101,6 +106,7 @@ static d_Status_t writeEnable(const Uint32_t device);
 static Bool_t blockProtected(const Uint32_t device, const Uint32_t address);
 
 static d_Status_t waitForSpiTransactionComplete(const Uint32_t device,
+                                                d_SPI_PL_Transaction_t * const pTransaction,
                                                 const Uint32_t timeoutPeriodInUsec);
 
 static d_Status_t processCommand(const Uint32_t device,
@@ -1070,35 +1076,45 @@ const Uint32_t address            /**< [in] Address to be written */
 /*********************************************************************//**
   <!-- waitForSpiTransactionComplete -->
 
-  Wait for the SPI transaction to complete, function will timeout after specified timeout period and return with error
+  Wait for the queued SPI transaction to complete, function will timeout after specified timeout period,
+  remove the transaction from the queue and return with error
 
 *************************************************************************/
 static d_Status_t                   /** \return function status */
 waitForSpiTransactionComplete
 (
 const Uint32_t device,              /**< [in] Device number */
+d_SPI_PL_Transaction_t * const pTransaction, /**< [in] Queued transaction */
 const Uint32_t timeoutPeriodInUsec  /**< [in] The timeout period in microseconds */
 )
 {
   d_Status_t returnValue;
   Uint32_t startTime;
   Uint32_t elapsedTime;
-  d_SPI_PL_State_t spiStatus;
+  d_SPI_PL_TransactionState_t state;
 
   (void)d_TIMER_ElapsedMicroseconds(0, &startTime);
   do
   {
     elapsedTime = d_TIMER_ElapsedMicroseconds(startTime, NULL);
-    returnValue = d_SPI_PL_Status(d_FLASH_MAC_Config[device].channel, &spiStatus);
-  } while  ((spiStatus != d_SPI_PL_STATUS_COMPLETE) && (returnValue == d_STATUS_SUCCESS) && (elapsedTime < timeoutPeriodInUsec));
+    returnValue = d_SPI_PL_Poll(d_FLASH_MAC_Config[device].channel);
+    state = pTransaction->state;
+  } while  (((state == d_SPI_PL_TRANSACTION_QUEUED) || (state == d_SPI_PL_TRANSACTION_ACTIVE)) &&
+            (returnValue == d_STATUS_SUCCESS) && (elapsedTime < timeoutPeriodInUsec));
 
-  if ((spiStatus != d_SPI_PL_STATUS_COMPLETE) && (returnValue == d_STATUS_SUCCESS))
+  if ((state == d_SPI_PL_TRANSACTION_QUEUED) || (state == d_SPI_PL_TRANSACTION_ACTIVE))
   {
-    /* FLASH response timeout */
-    // gcov-jst 2 It is not practical to generate this failure during bench testing.
+    /* FLASH response timeout, the transaction storage is about to go out of scope */
+    // gcov-jst 3 It is not practical to generate this failure during bench testing.
+    (void)d_SPI_PL_Cancel(d_FLASH_MAC_Config[device].channel, pTransaction);
     d_ERROR_Logger(d_STATUS_TIMEOUT, d_ERROR_CRITICALITY_NON_CRITICAL, 0, 0, 0, 0);
     returnValue = d_STATUS_TIMEOUT;
   }
+  else if (state != d_SPI_PL_TRANSACTION_COMPLETE)
+  {
+    // gcov-jst 1 It is not practical to generate this failure during bench testing.
+    returnValue = d_STATUS_FAILURE;
+  }
   else
   {
     DO_NOTHING();
@@ -1110,7 +1126,8 @@ const Uint32_t timeoutPeriodInUsec  /**< [in] The timeout period in microseconds
 /*********************************************************************//**
   <!-- processCommand -->
 
-  Send SPI command and wait for completion.
+  Queue SPI command and wait for completion. The caller is blocked, polling
+  the channel, until the transaction completes or times out.
 *************************************************************************/
 static d_Status_t                 /** \return function status */
 processCommand
@@ -1124,12 +1141,10 @@ const Uint32_t dataCount
 )
 {
   d_Status_t returnValue;
-  Uint8_t commandBuffer[4];
-  d_SPI_PL_State_t spiStatus;
-  Uint32_t count;
+  d_SPI_PL_Transaction_t transaction;
 
-  commandBuffer[0] = command;
-  Uint32_t commandCount = 1;
+  transaction.command[0] = command;
+  transaction.cmdCount = 1;
   if (address != 0xFFFFFFFFu)
   {
     Uint32_t index;
@@ -1137,25 +1152,30 @@ const Uint32_t dataCount
     for (index = 0u; index < 3u; index++)
     {
       // cppcheck-suppress objectIndex; The individual bytes of the 32 bit address are accessed requiring non-zero index.
-      commandBuffer[index + 1u] = aptr[2u - index];
+      transaction.command[index + 1u] = aptr[2u - index];
     }
-    commandCount = 4;
+    transaction.cmdCount = 4;
   }
   else
   {
     DO_NOTHING();
   }
 
-  returnValue = d_SPI_PL_Transfer(d_FLASH_MAC_Config[device].channel,
-                                  d_FLASH_MAC_Config[device].device,
-                                  &commandBuffer[0],
-                                  commandCount,
-                                  txBuffer,
-                                  dataCount);
+  transaction.device = d_FLASH_MAC_Config[device].device;
+  transaction.txBuffer = txBuffer;
+  transaction.dataCount = dataCount;
+  transaction.rxBuffer = rxBuffer;
+  transaction.bufferLength = dataCount;
+  transaction.callback = NULL;
+  transaction.tag = device;
+  transaction.state = d_SPI_PL_TRANSACTION_IDLE;
+  transaction.pNext = NULL;
+
+  returnValue = d_SPI_PL_Queue(d_FLASH_MAC_Config[device].channel, &transaction);
 
   if (returnValue == d_STATUS_SUCCESS)
   {
-    returnValue = waitForSpiTransactionComplete(device, SPI_TRANSACTION_TIMEOUT_USEC);
+    returnValue = waitForSpiTransactionComplete(device, &transaction, SPI_TRANSACTION_TIMEOUT_USEC);
   }
   else
   {
@@ -1163,16 +1183,5 @@ const Uint32_t dataCount
     DO_NOTHING();
   }
 
-  if (returnValue == d_STATUS_SUCCESS)
-  {
-    returnValue = d_SPI_PL_Result(d_FLASH_MAC_Config[device].channel, &spiStatus, rxBuffer, dataCount, &count);
-  }
-  else
-  {
-    /* Reset SPI channel */
-    // gcov-jst 1 It is not practical to generate this failure during bench testing.
-    (void)d_SPI_PL_Reset(d_FLASH_MAC_Config[device].channel);
-  }
-  
 return returnValue;
 }
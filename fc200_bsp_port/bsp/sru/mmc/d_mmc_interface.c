@@ -22,10 +22,11 @@
 
 #include "soc/defines/d_common_types.h"
 #include "soc/defines/d_common_status.h"
-#include "kernel/date_time/d_date_time.h"
 #include "xparameters.h"
 #include "kernel/error_handler/d_error_handler.h"
 #include "kernel/general/d_gen_memory.h"
+#include "soc/memory_manager/d_memory_cache.h"
+#include "soc/timer/d_timer.h"
 
 #include "xsdps.h"
 #include "xsdps_core.h"
@@ -40,12 +41,15 @@
 #define MMC_READY  0x11111111u
 
 /* NB Cache only used for single sector reads and writes */
-#define CACHE_ENTRIES  8u
+#define CACHE_SET_MASK  (d_MMC_CACHE_SETS - 1u)
 
 #define CMD35   0x2300u
 #define CMD36   0x2400u
 #define CMD38   0x2600u
 
+/* Time allowed for the command and data lines to reset */
+#define LINE_RESET_TIMEOUT_MS  10u
+
 /***** Type Definitions *************************************************/
 
 typedef enum
@@ -57,11 +61,41 @@ typedef enum
 typedef struct
 {
   Bool_t used;
+  Bool_t dirty;
   Uint32_t sector;
-  Uint64_t time;
+  Uint32_t lastUse;
   Uint8_t data[SECTOR_SIZE];
 } sectorCache_t;
-  
+
+typedef enum
+{
+  REQUEST_PENDING = 0,
+  REQUEST_ACTIVE,
+  REQUEST_DONE,
+  REQUEST_CANCELLED
+} requestState_t;
+
+typedef struct
+{
+  requestState_t state;
+  d_Status_t status;
+  Uint32_t tag;
+  Uint32_t sector;
+  Uint32_t count;
+  Bool_t write;
+  Uint32_t sgCount;
+  d_MMC_SgEntry_t sg[d_MMC_SG_MAX];
+  d_MMC_Callback_t callback;
+  void * pContext;
+} mmcRequest_t;
+
+/* Completion of a request made by a synchronous function */
+typedef struct
+{
+  Bool_t done;
+  d_Status_t status;
+} syncRequest_t;
+
 /***** Variables ********************************************************/
 
 static Bool_t initialised = d_FALSE;
@@ -72,13 +106,52 @@ static d_MMC_Instance_t mmcInstance;
 // cppcheck-suppress misra-c2012-8.9; Defining this large variable at the start of the module is more maintainable. Violation of 'Advisory' rule does not present a risk.
 static  __attribute__((aligned(64))) Uint16_t buffer[BUFFER_SIZE];
 
-static sectorCache_t sectorCache[CACHE_ENTRIES];
+/* Sector cache, a sector is held in the set selected by its low order bits */
+static sectorCache_t sectorCache[d_MMC_CACHE_SETS][d_MMC_CACHE_WAYS];
+
+/* Use counter for least recently used replacement */
+static Uint32_t cacheUseCount;
+
+/* Staging buffer for multi-block writes of adjacent dirty sectors */
+// cppcheck-suppress misra-c2012-8.9; Defining this large variable at the start of the module is more maintainable. Violation of 'Advisory' rule does not present a risk.
+static __attribute__((aligned(64))) Uint8_t writeBuffer[d_MMC_CACHE_COALESCE * SECTOR_SIZE];
+
+static d_MMC_CacheStats_t cacheStats;
+
+/* Request queue, the request at the head is the one in progress */
+static mmcRequest_t requestQueue[d_MMC_QUEUE_DEPTH];
+static Uint32_t queueHead;
+static Uint32_t queueCount;
+static Uint32_t nextTag;
+
+/* Timer value when the request in progress was started */
+static Uint32_t activeStartTime;
+
+static d_MMC_QueueStats_t queueStats;
+
+/* ADMA2 descriptor tables, the 64-bit format is used by a version 3 host controller */
+static XSdPs_Adma2Descriptor32 adma2Table32[d_MMC_ADMA_DESCRIPTORS] __attribute__((aligned(32)));
+static XSdPs_Adma2Descriptor64 adma2Table64[d_MMC_ADMA_DESCRIPTORS] __attribute__((aligned(32)));
 
 /***** Function Declarations ********************************************/
 
-static void cacheFlush(void);
-static Uint32_t getNextCacheEntry(const Uint32_t sector);
-static Uint32_t getCacheEntry(const Uint32_t sector);
+static void cacheInvalidate(void);
+static sectorCache_t * getNextCacheEntry(const Uint32_t sector);
+static sectorCache_t * getCacheEntry(const Uint32_t sector);
+static sectorCache_t * getDirtyEntry(const Uint32_t sector);
+static d_Status_t cacheWriteRun(const Uint32_t sector);
+static void cacheDiscardRange(const Uint32_t sector, const Uint32_t count);
+static void cacheOverlayDirty(const mmcRequest_t * const pRequest);
+static d_Status_t queueSubmit(const Uint32_t sector, const Uint32_t count, const d_MMC_SgEntry_t * const pSgList, const Uint32_t sgCount,
+                              const Bool_t writeFlag, const Bool_t writeBack, const d_MMC_Callback_t callback, void * const pContext,
+                              Uint32_t * const pTag);
+static void queueStartHead(void);
+static void queueCheckActive(mmcRequest_t * const pRequest);
+static d_Status_t transferStart(const mmcRequest_t * const pRequest);
+static void transferAbort(void);
+static d_Status_t transferWait(const Uint32_t sector, const Uint32_t count, const Uint8_t * const pBuffer, const Bool_t writeFlag,
+                               const Bool_t writeBack);
+static void syncCallback(const Uint32_t tag, const d_Status_t status, void * const pContext);
 static d_Status_t SectorCheck(const Uint32_t sector, const Pattern_t pattern);
 
 /***** Function Definitions *********************************************/
@@ -153,7 +226,11 @@ d_MMC_Instance_t ** ppMmcInstance   /**< [out] Return pointer to MMC instance st
     ELSE_DO_NOTHING
     
     /* Set all cache entries as unused */
-    cacheFlush();
+    cacheInvalidate();
+
+    /* Nothing can be outstanding on a device that was not ready */
+    queueHead = 0u;
+    queueCount = 0u;
   }
   else
   {
@@ -252,8 +329,9 @@ const Uint32_t sector               /**< [in] Sector to test */
 /*********************************************************************//**
   <!-- d_MMC_SectorRead -->
 
-  Read a sector from the MMC. This wrapper of the Xilinx code is a 
-  blocking function and does not use interrupts.
+  Read a sector from the MMC. This is a blocking function, the read is
+  queued behind any outstanding requests and the queue is serviced until
+  it completes.
   Note that the buffer must be 16 byte aligned for DMA access.
 ************************************************************************/
 d_Status_t                          /** \return Function status */
@@ -266,7 +344,7 @@ Uint8_t * const pBuffer             /**< [out] Pointer to storage for data read
 {
   d_Status_t returnValue = d_STATUS_SUCCESS;
   Bool_t done = d_FALSE;
-  Uint32_t cacheEntry;
+  sectorCache_t * pEntry;
   
   if (initialised != d_TRUE)
   {
@@ -314,32 +392,42 @@ Uint8_t * const pBuffer             /**< [out] Pointer to storage for data read
 
   if (count == 1u)
   {
-    cacheEntry = getCacheEntry(sector);
-    if (cacheEntry < CACHE_ENTRIES)
+    pEntry = getCacheEntry(sector);
+    if (pEntry != NULL)
     {
-      d_GEN_MemoryCopy(pBuffer, &sectorCache[cacheEntry].data[0], SECTOR_SIZE);
+      d_GEN_MemoryCopy(pBuffer, &pEntry->data[0], SECTOR_SIZE);
+      pEntry->lastUse = ++cacheUseCount;
+      cacheStats.readHits++;
       done = d_TRUE;
     }
-    ELSE_DO_NOTHING
+    else
+    {
+      cacheStats.readMisses++;
+    }
   }
   // gcov-jst 1 It is not practical to generate this failure during bench testing.
   ELSE_DO_NOTHING
 
   if (done != d_TRUE)
   {
-    // cppcheck-suppress misra-c2012-11.3; The ARM processor does not have any alignment restrictions for integers. Violation of 'Advisory' rule does not present a risk.
-    Int32_t status  = XSdPs_ReadPolled((XSdPs *)&mmcInstance, sector, count, pBuffer);
-    if (status == XST_SUCCESS)
+    /* Sectors modified in the cache are copied over the data read on completion */
+    d_Status_t status = transferWait(sector, count, pBuffer, d_FALSE, d_FALSE);
+    if (status == d_STATUS_SUCCESS)
     {
       if (count == 1u)
       {
-        cacheEntry = getNextCacheEntry(sector);
-        d_GEN_MemoryCopy(&sectorCache[cacheEntry].data[0], pBuffer, SECTOR_SIZE);
-        sectorCache[cacheEntry].sector = sector;
-        sectorCache[cacheEntry].time = d_DATE_TIME_Timestamp();
-        sectorCache[cacheEntry].used = d_TRUE;
+        pEntry = getNextCacheEntry(sector);
+        if (pEntry != NULL)
+        {
+          d_GEN_MemoryCopy(&pEntry->data[0], pBuffer, SECTOR_SIZE);
+          pEntry->sector = sector;
+          pEntry->lastUse = ++cacheUseCount;
+          pEntry->dirty = d_FALSE;
+          pEntry->used = d_TRUE;
+        }
+        // gcov-jst 1 It is not practical to generate this failure during bench testing.
+        ELSE_DO_NOTHING
       }
-      // gcov-jst 1 It is not practical to generate this failure during bench testing.
       ELSE_DO_NOTHING
     }
     else
@@ -356,8 +444,11 @@ Uint8_t * const pBuffer             /**< [out] Pointer to storage for data read
 /*********************************************************************//**
   <!-- d_MMC_SectorWrite -->
 
-  Write a sector to the MMC. This wrapper of the Xilinx code is a 
-  blocking function and does not use interrupts.
+  Write a sector to the MMC. This is a blocking function, a write to the
+  device is queued behind any outstanding requests and the queue is
+  serviced until it completes.
+  A single sector is written to the cache and reaches the device when it
+  is evicted or on d_MMC_Flush. Multiple sectors are written directly.
   Note that the buffer must be 16 byte aligned for DMA access.
 *************************************************************************/
 d_Status_t                          /** \return Function status */
@@ -414,48 +505,65 @@ const Uint8_t * const pBuffer       /**< [in] Pointer to data to write */
     return d_STATUS_INVALID_PARAMETER;
   }
 
-  // cppcheck-suppress misra-c2012-11.3; The ARM processor does not have any alignment restrictions for integers. Violation of 'Advisory' rule does not present a risk.
-  Int32_t status  = XSdPs_WritePolled((XSdPs *)&mmcInstance, sector, count, pBuffer);
-  if (status == XST_SUCCESS)
+  if (count == 1u)
   {
-    if (count == 1u)
+    sectorCache_t * pEntry = getCacheEntry(sector);
+    if (pEntry != NULL)
     {
-      Uint32_t cacheEntry = getNextCacheEntry(sector);
-      d_GEN_MemoryCopy(&sectorCache[cacheEntry].data[0], pBuffer, SECTOR_SIZE);
-      sectorCache[cacheEntry].sector = sector;
-      sectorCache[cacheEntry].time = d_DATE_TIME_Timestamp();
-      sectorCache[cacheEntry].used = d_TRUE;
+      cacheStats.writeHits++;
+    }
+    else
+    {
+      cacheStats.writeMisses++;
+      pEntry = getNextCacheEntry(sector);
+    }
+
+    if (pEntry != NULL)
+    {
+      d_GEN_MemoryCopy(&pEntry->data[0], pBuffer, SECTOR_SIZE);
+      pEntry->sector = sector;
+      pEntry->lastUse = ++cacheUseCount;
+      pEntry->dirty = d_TRUE;
+      pEntry->used = d_TRUE;
     }
     else
     {
       // gcov-jst 1 It is not practical to generate this failure during bench testing.
-      DO_NOTHING();
+      returnValue = d_STATUS_FAILURE;
     }
   }
   else
   {
-    // gcov-jst 1 It is not practical to generate this failure during bench testing.
-    returnValue = d_STATUS_FAILURE;
+    /* Cached copies of the sectors are discarded when the write is queued */
+    d_Status_t status = transferWait(sector, count, pBuffer, d_TRUE, d_FALSE);
+    if (status != d_STATUS_SUCCESS)
+    {
+      // gcov-jst 1 It is not practical to generate this failure during bench testing.
+      returnValue = d_STATUS_FAILURE;
+    }
   }
   
   return returnValue;
 }
 
 /*********************************************************************//**
-  <!-- d_MMC_Erase -->
+  <!-- d_MMC_Flush -->
 
-  Erase the MMC.
+  Write all modified sectors held in the cache to the device. Adjacent
+  sectors are combined into multi-block writes. This is the point at which
+  data written by d_MMC_SectorWrite is known to be on the device, so a
+  caller committing a structure should flush its data before writing the
+  sectors that refer to it.
 ************************************************************************/
 d_Status_t                          /** \return Function status */
-d_MMC_Erase
+d_MMC_Flush
 (
-const Uint32_t sectorStart,         /**< [in] First sector number to erase */
-const Uint32_t sectorEnd            /**< [in] Last sector number to erase */
+void
 )
 {
-  Int32_t Status;
-
-  d_Status_t status = d_STATUS_SUCCESS;
+  d_Status_t returnValue = d_STATUS_SUCCESS;
+  Uint32_t set;
+  Uint32_t way;
 
   if (initialised != d_TRUE)
   {
@@ -464,203 +572,1187 @@ const Uint32_t sectorEnd            /**< [in] Last sector number to erase */
     return d_STATUS_NOT_INITIALISED;
   }
 
-  /* Send CMD35 start erase command */
-  // cppcheck-suppress misra-c2012-11.3; The ARM processor does not have any alignment restrictions for integers. Violation of 'Advisory' rule does not present a risk.
-  Status = XSdPs_CmdTransfer((XSdPs *)&mmcInstance, CMD35, sectorStart, 0u);
-  if (Status != XST_SUCCESS)
-  {
-    // gcov-jst 1 It is not practical to generate this failure during bench testing.
-    status = d_STATUS_FAILURE;
-  }
-  ELSE_DO_NOTHING
+  cacheStats.flushes++;
 
-  if (status == d_STATUS_SUCCESS)
+  for (set = 0u; set < d_MMC_CACHE_SETS; set++)
   {
-    /* Send CMD36 end erase command */
-    // cppcheck-suppress misra-c2012-11.3; The ARM processor does not have any alignment restrictions for integers. Violation of 'Advisory' rule does not present a risk.
-    Status = XSdPs_CmdTransfer((XSdPs *)&mmcInstance, CMD36, sectorEnd, 0u);
-    if (Status != XST_SUCCESS)
+    for (way = 0u; way < d_MMC_CACHE_WAYS; way++)
     {
-      // gcov-jst 1 It is not practical to generate this failure during bench testing.
-      status = d_STATUS_FAILURE;
+      if ((sectorCache[set][way].used == d_TRUE) && (sectorCache[set][way].dirty == d_TRUE))
+      {
+        /* The run containing the sector is written, so the entry is clean afterwards */
+        if (cacheWriteRun(sectorCache[set][way].sector) != d_STATUS_SUCCESS)
+        {
+          // gcov-jst 1 It is not practical to generate this failure during bench testing.
+          returnValue = d_STATUS_FAILURE;
+        }
+        ELSE_DO_NOTHING
+      }
+      ELSE_DO_NOTHING
     }
   }
-  // gcov-jst 1 It is not practical to generate this failure during bench testing.
-  ELSE_DO_NOTHING
 
-  if (status == d_STATUS_SUCCESS)
+  return returnValue;
+}
+
+/*********************************************************************//**
+  <!-- d_MMC_GetCacheStats -->
+
+  Get the sector cache statistics.
+************************************************************************/
+d_Status_t                          /** \return Function status */
+d_MMC_GetCacheStats
+(
+d_MMC_CacheStats_t * const pStats   /**< [out] Pointer to storage for statistics */
+)
+{
+  if (pStats == NULL)
   {
-    /* Send CMD38 erase command with Trim option */
-    // cppcheck-suppress misra-c2012-11.3; The ARM processor does not have any alignment restrictions for integers. Violation of 'Advisory' rule does not present a risk.
-    Status = XSdPs_CmdTransfer((XSdPs *)&mmcInstance, CMD38, 1u, 0u);
-    if (Status != XST_SUCCESS)
-    {
-      // gcov-jst 1 It is not practical to generate this failure during bench testing.
-      status = d_STATUS_FAILURE;
-    }
+    d_ERROR_Logger(d_STATUS_INVALID_PARAMETER, d_ERROR_CRITICALITY_NON_CRITICAL, 0, 0, 0, 0);
+    // cppcheck-suppress misra-c2012-15.5; Coding standard allows function to return if parameters are invalid
+    return d_STATUS_INVALID_PARAMETER;
   }
-  // gcov-jst 1 It is not practical to generate this failure during bench testing.
-  ELSE_DO_NOTHING
 
-  /* Ensure anything erased is not still in the cache */
-  cacheFlush();
+  *pStats = cacheStats;
 
-  return status;
+  return d_STATUS_SUCCESS;
 }
 
 /*********************************************************************//**
-  <!-- cacheFlush -->
+  <!-- d_MMC_ReadAsync -->
 
-  Mark all cache entries as unused.
+  Queue a read of one or more sectors. The function returns without
+  waiting, the callback reports completion. Sectors modified in the cache
+  are copied over the data read when the request completes.
 ************************************************************************/
-static void                         /** \return None */
-cacheFlush
+d_Status_t                          /** \return Function status */
+d_MMC_ReadAsync
 (
-void
+const Uint32_t sector,              /**< [in] First sector number to read */
+const Uint32_t count,               /**< [in] Number of sectors to read */
+Uint8_t * const pBuffer,            /**< [out] Pointer to storage for data read */
+const d_MMC_Callback_t callback,    /**< [in] Completion callback, may be NULL */
+void * const pContext,              /**< [in] Parameter passed to the callback */
+Uint32_t * const pTag               /**< [out] Tag of the request, may be NULL */
 )
 {
-  Uint32_t index;
-  
-  for (index = 0; index < CACHE_ENTRIES; index++)
-  {
-    sectorCache[index].used = d_FALSE;
-    sectorCache[index].time = 0;
-  }
-  
-  return;
+  d_MMC_SgEntry_t sgEntry;
+
+  sgEntry.pBuffer = pBuffer;
+  sgEntry.length = count * SECTOR_SIZE;
+
+  return d_MMC_SubmitSg(sector, &sgEntry, 1u, d_FALSE, callback, pContext, pTag);
 }
 
 /*********************************************************************//**
-  <!-- getNextCacheEntry -->
+  <!-- d_MMC_WriteAsync -->
 
-  Get empty or oldest cache entry to use next.
-*************************************************************************/
-static Uint32_t                     /** \return Cache entry number */ 
-getNextCacheEntry
+  Queue a write of one or more sectors. The function returns without
+  waiting, the callback reports completion. The write goes directly to
+  the device and cached copies of the sectors are discarded.
+************************************************************************/
+d_Status_t                          /** \return Function status */
+d_MMC_WriteAsync
 (
-const Uint32_t sector               /**< [in] Sector number required */
+const Uint32_t sector,              /**< [in] First sector number to write */
+const Uint32_t count,               /**< [in] Number of sectors to write */
+const Uint8_t * const pBuffer,      /**< [in] Pointer to data to write */
+const d_MMC_Callback_t callback,    /**< [in] Completion callback, may be NULL */
+void * const pContext,              /**< [in] Parameter passed to the callback */
+Uint32_t * const pTag               /**< [out] Tag of the request, may be NULL */
+)
+{
+  d_MMC_SgEntry_t sgEntry;
+
+  sgEntry.pBuffer = pBuffer;
+  sgEntry.length = count * SECTOR_SIZE;
+
+  return d_MMC_SubmitSg(sector, &sgEntry, 1u, d_TRUE, callback, pContext, pTag);
+}
+
+/*********************************************************************//**
+  <!-- d_MMC_SubmitSg -->
+
+  Queue a transfer of consecutive sectors to or from a list of buffers.
+  Each buffer is described by its own ADMA2 descriptors so no copy is
+  made. The list is copied, so it need not remain valid after the call,
+  but the buffers must remain valid until the callback.
+  Returns d_STATUS_BUFFER_FULL if the queue is full.
+************************************************************************/
+d_Status_t                          /** \return Function status */
+d_MMC_SubmitSg
+(
+const Uint32_t sector,              /**< [in] First sector number */
+const d_MMC_SgEntry_t * const pSgList, /**< [in] Buffers in sector order */
+const Uint32_t sgCount,             /**< [in] Number of entries in the list */
+const Bool_t writeFlag,             /**< [in] d_TRUE to write, d_FALSE to read */
+const d_MMC_Callback_t callback,    /**< [in] Completion callback, may be NULL */
+void * const pContext,              /**< [in] Parameter passed to the callback */
+Uint32_t * const pTag               /**< [out] Tag of the request, may be NULL */
 )
 {
+  Uint32_t count = 0u;
+  Uint32_t descriptors = 0u;
   Uint32_t index;
-  Uint32_t latestIndex = 0;
-  Bool_t found = d_FALSE;
 
-  /* Check if there is already an entry for this sector */
-  index = 0;
-  while ((index < CACHE_ENTRIES) && (found == d_FALSE))
+  if (initialised != d_TRUE)
+  {
+    d_ERROR_Logger(d_STATUS_NOT_INITIALISED, d_ERROR_CRITICALITY_CRITICAL_SHUTDOWN, 0, 0, 0, 0);
+    // cppcheck-suppress misra-c2012-15.5; Coding standard allows function to return if parameters are invalid
+    return d_STATUS_NOT_INITIALISED;
+  }
+
+  if (mmcInstance.IsReady != MMC_READY)
+  {
+    // gcov-jst 3 It is not practical to generate this failure during bench testing.
+    d_ERROR_Logger(d_STATUS_DEVICE_NOT_READY, d_ERROR_CRITICALITY_UNKNOWN, 0, 0, 0, 0);
+    // cppcheck-suppress misra-c2012-15.5; Coding standard allows function to return if parameters are invalid
+    return d_STATUS_DEVICE_NOT_READY;
+  }
+
+  if ((pSgList == NULL) || (sgCount == 0u) || (sgCount > d_MMC_SG_MAX))
+  {
+    d_ERROR_Logger(d_STATUS_INVALID_PARAMETER, d_ERROR_CRITICALITY_NON_CRITICAL, 1, sgCount, 0, 0);
+    // cppcheck-suppress misra-c2012-15.5; Coding standard allows function to return if parameters are invalid
+    return d_STATUS_INVALID_PARAMETER;
+  }
+
+  for (index = 0u; index < sgCount; index++)
   {
-    if (sectorCache[index].sector == sector)
+    // cppcheck-suppress misra-c2012-11.4; Conversion required to check for invalid parameter. Violation of 'Advisory' rule does not present a risk
+    if ((pSgList[index].pBuffer == NULL) || (((Pointer_t)pSgList[index].pBuffer & 0x0000000Fu) != 0u) ||
+        (pSgList[index].length == 0u) || ((pSgList[index].length % SECTOR_SIZE) != 0u))
     {
-      found = d_TRUE;
-      latestIndex = index;
+      d_ERROR_Logger(d_STATUS_INVALID_PARAMETER, d_ERROR_CRITICALITY_NON_CRITICAL, 2, index, pSgList[index].length, 0);
+      // cppcheck-suppress misra-c2012-15.5; Coding standard allows function to return if parameters are invalid
+      return d_STATUS_INVALID_PARAMETER;
     }
-    else
+    count += pSgList[index].length / SECTOR_SIZE;
+    descriptors += (pSgList[index].length + (XSDPS_DESC_MAX_LENGTH - 1u)) / XSDPS_DESC_MAX_LENGTH;
+  }
+
+  if ((count > d_MMC_MAX_REQUEST_SECTORS) || (descriptors > d_MMC_ADMA_DESCRIPTORS))
+  {
+    d_ERROR_Logger(d_STATUS_INVALID_PARAMETER, d_ERROR_CRITICALITY_NON_CRITICAL, 3, count, descriptors, 0);
+    // cppcheck-suppress misra-c2012-15.5; Coding standard allows function to return if parameters are invalid
+    return d_STATUS_INVALID_PARAMETER;
+  }
+
+  if ((sector >= mmcInstance.SectorCount) || ((sector + count) > mmcInstance.SectorCount))
+  {
+    d_ERROR_Logger(d_STATUS_INVALID_PARAMETER, d_ERROR_CRITICALITY_NON_CRITICAL, 4, sector, count, 0);
+    // cppcheck-suppress misra-c2012-15.5; Coding standard allows function to return if parameters are invalid
+    return d_STATUS_INVALID_PARAMETER;
+  }
+
+  return queueSubmit(sector, count, pSgList, sgCount, writeFlag, d_FALSE, callback, pContext, pTag);
+}
+
+/*********************************************************************//**
+  <!-- d_MMC_Cancel -->
+
+  Cancel a queued request. The callback is made with d_STATUS_FAILURE
+  before the function returns. A request in progress is aborted, in which
+  case the contents of the sectors it was writing are undefined.
+  Returns d_STATUS_INVALID_PARAMETER if the request is not outstanding,
+  for instance because it has just completed.
+************************************************************************/
+d_Status_t                          /** \return Function status */
+d_MMC_Cancel
+(
+const Uint32_t tag                  /**< [in] Tag returned on submission */
+)
+{
+  d_Status_t returnValue = d_STATUS_INVALID_PARAMETER;
+  mmcRequest_t * pRequest = NULL;
+  Uint32_t index = 0u;
+
+  while ((index < queueCount) && (pRequest == NULL))
+  {
+    mmcRequest_t * pCandidate = &requestQueue[(queueHead + index) % d_MMC_QUEUE_DEPTH];
+    if ((pCandidate->tag == tag) &&
+        ((pCandidate->state == REQUEST_PENDING) || (pCandidate->state == REQUEST_ACTIVE)))
     {
-      index++;
+      pRequest = pCandidate;
     }
+    ELSE_DO_NOTHING
+    index++;
   }
 
-  /* Check for an unused entry */
-  index = 0;
-  while ((index < CACHE_ENTRIES) && (found == d_FALSE))
+  if (pRequest != NULL)
   {
-    if (sectorCache[index].used == d_FALSE)
+    if (pRequest->state == REQUEST_ACTIVE)
     {
-      found = d_TRUE;
-      latestIndex = index;
+      transferAbort();
     }
-    else
+    ELSE_DO_NOTHING
+
+    /* The entry is removed from the queue by the next poll */
+    pRequest->state = REQUEST_CANCELLED;
+    queueStats.cancelled++;
+
+    if (pRequest->callback != NULL)
     {
-      index++;
+      pRequest->callback(tag, d_STATUS_FAILURE, pRequest->pContext);
     }
+    ELSE_DO_NOTHING
+
+    returnValue = d_STATUS_SUCCESS;
   }
+  ELSE_DO_NOTHING
+
+  return returnValue;
+}
+
+/*********************************************************************//**
+  <!-- d_MMC_QueuePoll -->
+
+  Service the request queue. The request in progress is checked for
+  completion, error or timeout, callbacks are made for finished requests
+  and the next request is started. A callback is made with the request
+  removed from the queue, so it can submit further requests.
+************************************************************************/
+Uint32_t                            /** \return Number of requests outstanding */
+d_MMC_QueuePoll
+(
+void
+)
+{
+  Bool_t more = initialised;
 
-  /* Check for the oldest entry */
-  if (found == d_FALSE)
+  while ((more == d_TRUE) && (queueCount > 0u))
   {
-    Uint32_t latestTime = 0xFFFFFFFFu;
-    for (index = 0; index < CACHE_ENTRIES; index++)
+    mmcRequest_t * pRequest = &requestQueue[queueHead];
+
+    if (pRequest->state == REQUEST_ACTIVE)
     {
-      /* Note empty entries have time of zero so they will be oldest */
-      if (sectorCache[index].time < latestTime)
+      queueCheckActive(pRequest);
+      if (pRequest->state == REQUEST_ACTIVE)
       {
-        latestTime = sectorCache[index].time;
-        latestIndex = index;
+        more = d_FALSE;
       }
-      else
+      ELSE_DO_NOTHING
+    }
+    else if (pRequest->state == REQUEST_PENDING)
+    {
+      queueStartHead();
+    }
+    else
+    {
+      mmcRequest_t finished = *pRequest;
+
+      queueHead = (queueHead + 1u) % d_MMC_QUEUE_DEPTH;
+      queueCount--;
+
+      if (finished.state == REQUEST_DONE)
       {
-        DO_NOTHING();
+        if (finished.status == d_STATUS_SUCCESS)
+        {
+          queueStats.completed++;
+        }
+        else if (finished.status == d_STATUS_TIMEOUT)
+        {
+          queueStats.timeouts++;
+        }
+        else
+        {
+          queueStats.errors++;
+        }
+
+        if (finished.callback != NULL)
+        {
+          finished.callback(finished.tag, finished.status, finished.pContext);
+        }
+        ELSE_DO_NOTHING
       }
+      ELSE_DO_NOTHING
     }
   }
 
-  return latestIndex;
+  return queueCount;
 }
 
 /*********************************************************************//**
-  <!-- getCacheEntry -->
+  <!-- d_MMC_QueueBackground -->
 
-  Get cache entry containing specified sector.
-*************************************************************************/
-static Uint32_t                     /** \return Cache entry number */
-getCacheEntry
+  Background job polling the request queue. The job asks to run again in
+  the frame only when the poll has finished a request and others remain
+  outstanding, waiting for the card leaves the slack to the later jobs.
+************************************************************************/
+Bool_t                              /** \return d_TRUE if the poll finished requests and others remain outstanding */
+d_MMC_QueueBackground
 (
-const Uint32_t sector               /**< [in] Sector number to find */
+void
 )
 {
-  Uint32_t index = 0;
-  Bool_t found = d_FALSE;
+  Bool_t moreWork = d_FALSE;
+  const Uint32_t finished = queueStats.completed + queueStats.timeouts + queueStats.errors;
 
-  do
+  if ((d_MMC_QueuePoll() != 0u) &&
+      ((queueStats.completed + queueStats.timeouts + queueStats.errors) != finished))
   {
-    if ((sectorCache[index].used == d_TRUE) && (sectorCache[index].sector == sector))
-    {
-      found = d_TRUE;
-    }
-    else
-    {
-      index++;
-    }
-  } while ((found == d_FALSE) && (index < CACHE_ENTRIES));
-  
-  return index;
+    moreWork = d_TRUE;
+  }
+  ELSE_DO_NOTHING
+
+  return moreWork;
 }
 
 /*********************************************************************//**
-  <!-- SectorCheck -->
+  <!-- d_MMC_GetQueueStats -->
 
-  Write / Read sector test.
-*************************************************************************/
-static d_Status_t                   /** \return BIT result */
-SectorCheck
+  Get the request queue statistics.
+************************************************************************/
+d_Status_t                          /** \return Function status */
+d_MMC_GetQueueStats
 (
-const Uint32_t sector,              /**< [in] Sector to test */
-const Pattern_t pattern             /**< [in] Pattern to write */
+d_MMC_QueueStats_t * const pStats   /**< [out] Pointer to storage for statistics */
 )
 {
-  Uint32_t index;
-  d_Status_t status;
-  d_Status_t returnValue = d_STATUS_SUCCESS;
-
-  /* Write a sector with specified pattern */
-  for (index = 0; index < BUFFER_SIZE; index++)
+  if (pStats == NULL)
   {
-    if (pattern == PATTERN_0)
-    {
-      buffer[index] = (Uint16_t)(index * 3u);
-    }
-    else
-    {
-      buffer[index] = (Uint16_t)~(index * 3u);
-    }
+    d_ERROR_Logger(d_STATUS_INVALID_PARAMETER, d_ERROR_CRITICALITY_NON_CRITICAL, 0, 0, 0, 0);
+    // cppcheck-suppress misra-c2012-15.5; Coding standard allows function to return if parameters are invalid
+    return d_STATUS_INVALID_PARAMETER;
   }
-  
-  status = d_MMC_SectorWrite(sector, 1, (Uint8_t *)buffer);
+
+  *pStats = queueStats;
+
+  return d_STATUS_SUCCESS;
+}
+
+/*********************************************************************//**
+  <!-- d_MMC_Erase -->
+
+  Erase the MMC.
+************************************************************************/
+d_Status_t                          /** \return Function status */
+d_MMC_Erase
+(
+const Uint32_t sectorStart,         /**< [in] First sector number to erase */
+const Uint32_t sectorEnd            /**< [in] Last sector number to erase */
+)
+{
+  Int32_t Status;
+
+  d_Status_t status = d_STATUS_SUCCESS;
+
+  if (initialised != d_TRUE)
+  {
+    d_ERROR_Logger(d_STATUS_NOT_INITIALISED, d_ERROR_CRITICALITY_CRITICAL_SHUTDOWN, 0, 0, 0, 0);
+    // cppcheck-suppress misra-c2012-15.5; Coding standard allows function to return if parameters are invalid
+    return d_STATUS_NOT_INITIALISED;
+  }
+
+  /* Queued requests complete before the erase commands are sent */
+  while (d_MMC_QueuePoll() != 0u)
+  {
+    DO_NOTHING();
+  }
+
+  /* Modified sectors outside the erased range must not be lost */
+  if (d_MMC_Flush() != d_STATUS_SUCCESS)
+  {
+    // gcov-jst 1 It is not practical to generate this failure during bench testing.
+    status = d_STATUS_FAILURE;
+  }
+  ELSE_DO_NOTHING
+
+  if (status == d_STATUS_SUCCESS)
+  {
+    /* Send CMD35 start erase command */
+    // cppcheck-suppress misra-c2012-11.3; The ARM processor does not have any alignment restrictions for integers. Violation of 'Advisory' rule does not present a risk.
+    Status = XSdPs_CmdTransfer((XSdPs *)&mmcInstance, CMD35, sectorStart, 0u);
+    if (Status != XST_SUCCESS)
+    {
+      // gcov-jst 1 It is not practical to generate this failure during bench testing.
+      status = d_STATUS_FAILURE;
+    }
+  }
+  // gcov-jst 1 It is not practical to generate this failure during bench testing.
+  ELSE_DO_NOTHING
+
+  if (status == d_STATUS_SUCCESS)
+  {
+    /* Send CMD36 end erase command */
+    // cppcheck-suppress misra-c2012-11.3; The ARM processor does not have any alignment restrictions for integers. Violation of 'Advisory' rule does not present a risk.
+    Status = XSdPs_CmdTransfer((XSdPs *)&mmcInstance, CMD36, sectorEnd, 0u);
+    if (Status != XST_SUCCESS)
+    {
+      // gcov-jst 1 It is not practical to generate this failure during bench testing.
+      status = d_STATUS_FAILURE;
+    }
+  }
+  // gcov-jst 1 It is not practical to generate this failure during bench testing.
+  ELSE_DO_NOTHING
+
+  if (status == d_STATUS_SUCCESS)
+  {
+    /* Send CMD38 erase command with Trim option */
+    // cppcheck-suppress misra-c2012-11.3; The ARM processor does not have any alignment restrictions for integers. Violation of 'Advisory' rule does not present a risk.
+    Status = XSdPs_CmdTransfer((XSdPs *)&mmcInstance, CMD38, 1u, 0u);
+    if (Status != XST_SUCCESS)
+    {
+      // gcov-jst 1 It is not practical to generate this failure during bench testing.
+      status = d_STATUS_FAILURE;
+    }
+  }
+  // gcov-jst 1 It is not practical to generate this failure during bench testing.
+  ELSE_DO_NOTHING
+
+  /* Ensure anything erased is not still in the cache */
+  cacheInvalidate();
+
+  return status;
+}
+
+/*********************************************************************//**
+  <!-- cacheInvalidate -->
+
+  Mark all cache entries as unused, discarding any modified data.
+************************************************************************/
+static void                         /** \return None */
+cacheInvalidate
+(
+void
+)
+{
+  Uint32_t set;
+  Uint32_t way;
+  
+  for (set = 0u; set < d_MMC_CACHE_SETS; set++)
+  {
+    for (way = 0u; way < d_MMC_CACHE_WAYS; way++)
+    {
+      sectorCache[set][way].used = d_FALSE;
+      sectorCache[set][way].dirty = d_FALSE;
+      sectorCache[set][way].lastUse = 0u;
+    }
+  }
+  
+  return;
+}
+
+/*********************************************************************//**
+  <!-- getNextCacheEntry -->
+
+  Get an entry of the set of the sector to use next. An unused entry is
+  taken first, then the least recently used unmodified entry. If every
+  entry of the set is modified the least recently used one is written
+  back to the device first.
+*************************************************************************/
+static sectorCache_t *              /** \return Cache entry, NULL if write back failed */
+getNextCacheEntry
+(
+const Uint32_t sector               /**< [in] Sector number required */
+)
+{
+  sectorCache_t * pSet = &sectorCache[sector & CACHE_SET_MASK][0];
+  sectorCache_t * pClean = NULL;
+  sectorCache_t * pDirty = NULL;
+  sectorCache_t * pEntry = NULL;
+  Uint32_t way = 0u;
+
+  while ((way < d_MMC_CACHE_WAYS) && (pEntry == NULL))
+  {
+    if (pSet[way].used == d_FALSE)
+    {
+      pEntry = &pSet[way];
+    }
+    else if (pSet[way].dirty == d_FALSE)
+    {
+      if ((pClean == NULL) || (pSet[way].lastUse < pClean->lastUse))
+      {
+        pClean = &pSet[way];
+      }
+      ELSE_DO_NOTHING
+    }
+    else
+    {
+      if ((pDirty == NULL) || (pSet[way].lastUse < pDirty->lastUse))
+      {
+        pDirty = &pSet[way];
+      }
+      ELSE_DO_NOTHING
+    }
+    way++;
+  }
+
+  if (pEntry == NULL)
+  {
+    if (pClean != NULL)
+    {
+      pEntry = pClean;
+    }
+    else
+    {
+      cacheStats.evictions++;
+      if (cacheWriteRun(pDirty->sector) == d_STATUS_SUCCESS)
+      {
+        pEntry = pDirty;
+      }
+      // gcov-jst 1 It is not practical to generate this failure during bench testing.
+      ELSE_DO_NOTHING
+    }
+  }
+  ELSE_DO_NOTHING
+
+  return pEntry;
+}
+
+/*********************************************************************//**
+  <!-- getCacheEntry -->
+
+  Get cache entry containing specified sector.
+*************************************************************************/
+static sectorCache_t *              /** \return Cache entry, NULL if not cached */
+getCacheEntry
+(
+const Uint32_t sector               /**< [in] Sector number to find */
+)
+{
+  sectorCache_t * pSet = &sectorCache[sector & CACHE_SET_MASK][0];
+  sectorCache_t * pEntry = NULL;
+  Uint32_t way = 0u;
+
+  while ((way < d_MMC_CACHE_WAYS) && (pEntry == NULL))
+  {
+    if ((pSet[way].used == d_TRUE) && (pSet[way].sector == sector))
+    {
+      pEntry = &pSet[way];
+    }
+    ELSE_DO_NOTHING
+    way++;
+  }
+  
+  return pEntry;
+}
+
+/*********************************************************************//**
+  <!-- getDirtyEntry -->
+
+  Get cache entry containing specified sector if it is modified.
+*************************************************************************/
+static sectorCache_t *              /** \return Cache entry, NULL if not cached or not modified */
+getDirtyEntry
+(
+const Uint32_t sector               /**< [in] Sector number to find */
+)
+{
+  sectorCache_t * pEntry = getCacheEntry(sector);
+
+  if ((pEntry != NULL) && (pEntry->dirty != d_TRUE))
+  {
+    pEntry = NULL;
+  }
+  ELSE_DO_NOTHING
+
+  return pEntry;
+}
+
+/*********************************************************************//**
+  <!-- cacheWriteRun -->
+
+  Write back a modified sector together with the modified sectors adjacent
+  to it. The run is written from its first sector in multi-block writes of
+  up to d_MMC_CACHE_COALESCE sectors, up to the write holding the sector,
+  so a flush splits a run at the same places whichever of its sectors it
+  finds first. Consecutive sectors fall in consecutive sets, so a run held
+  in the cache is found with one set lookup per sector.
+*************************************************************************/
+static d_Status_t                   /** \return Function status */
+cacheWriteRun
+(
+const Uint32_t sector               /**< [in] Modified sector to write */
+)
+{
+  sectorCache_t * pRun[d_MMC_CACHE_COALESCE];
+  d_Status_t returnValue = d_STATUS_SUCCESS;
+  Uint32_t first = sector;
+  Uint32_t count = d_MMC_CACHE_COALESCE;
+  Uint32_t index;
+
+  /* Find the start of the run, which cannot be longer than the cache */
+  while ((first > 0u) && ((sector - first) < ((d_MMC_CACHE_SETS * d_MMC_CACHE_WAYS) - 1u)) &&
+         (getDirtyEntry(first - 1u) != NULL))
+  {
+    first--;
+  }
+
+  /* A write shorter than the limit reaches the end of the run */
+  while ((returnValue == d_STATUS_SUCCESS) && (first <= sector) && (count == d_MMC_CACHE_COALESCE))
+  {
+    Bool_t more = d_TRUE;
+
+    /* Gather the next part of the run into the staging buffer */
+    count = 0u;
+    while ((more == d_TRUE) && (count < d_MMC_CACHE_COALESCE))
+    {
+      pRun[count] = getDirtyEntry(first + count);
+      if (pRun[count] != NULL)
+      {
+        d_GEN_MemoryCopy(&writeBuffer[count * SECTOR_SIZE], &pRun[count]->data[0], SECTOR_SIZE);
+        count++;
+      }
+      else
+      {
+        more = d_FALSE;
+      }
+    }
+
+    if (count > 0u)
+    {
+      /* The entries stay modified until the write has succeeded */
+      d_Status_t status = transferWait(first, count, writeBuffer, d_TRUE, d_TRUE);
+      if (status == d_STATUS_SUCCESS)
+      {
+        for (index = 0u; index < count; index++)
+        {
+          pRun[index]->dirty = d_FALSE;
+        }
+        cacheStats.deviceWrites++;
+        cacheStats.sectorsWritten += count;
+        first += count;
+      }
+      else
+      {
+        // gcov-jst 1 It is not practical to generate this failure during bench testing.
+        returnValue = d_STATUS_FAILURE;
+      }
+    }
+    ELSE_DO_NOTHING
+  }
+
+  return returnValue;
+}
+
+/*********************************************************************//**
+  <!-- cacheDiscardRange -->
+
+  Discard cached copies of a range of sectors, including modified ones,
+  as the range is being overwritten on the device.
+*************************************************************************/
+static void                         /** \return None */
+cacheDiscardRange
+(
+const Uint32_t sector,              /**< [in] First sector of the range */
+const Uint32_t count                /**< [in] Number of sectors in the range */
+)
+{
+  Uint32_t set;
+  Uint32_t way;
+
+  for (set = 0u; set < d_MMC_CACHE_SETS; set++)
+  {
+    for (way = 0u; way < d_MMC_CACHE_WAYS; way++)
+    {
+      if ((sectorCache[set][way].used == d_TRUE) && ((sectorCache[set][way].sector - sector) < count))
+      {
+        sectorCache[set][way].used = d_FALSE;
+        sectorCache[set][way].dirty = d_FALSE;
+      }
+      ELSE_DO_NOTHING
+    }
+  }
+
+  return;
+}
+
+/*********************************************************************//**
+  <!-- cacheOverlayDirty -->
+
+  Copy sectors modified in the cache over the data read by a request, as
+  they are more recent than the device.
+*************************************************************************/
+static void                         /** \return None */
+cacheOverlayDirty
+(
+const mmcRequest_t * const pRequest /**< [in] Completed read request */
+)
+{
+  Uint32_t set;
+  Uint32_t way;
+
+  for (set = 0u; set < d_MMC_CACHE_SETS; set++)
+  {
+    for (way = 0u; way < d_MMC_CACHE_WAYS; way++)
+    {
+      const sectorCache_t * pEntry = &sectorCache[set][way];
+      if ((pEntry->used == d_TRUE) && (pEntry->dirty == d_TRUE) && ((pEntry->sector - pRequest->sector) < pRequest->count))
+      {
+        /* Find the buffer holding the sector */
+        Uint32_t offset = (pEntry->sector - pRequest->sector) * SECTOR_SIZE;
+        Uint32_t entry = 0u;
+        while (offset >= pRequest->sg[entry].length)
+        {
+          offset -= pRequest->sg[entry].length;
+          entry++;
+        }
+        // cppcheck-suppress misra-c2012-11.8; The buffer of a read request is written by the controller. Violation of 'Required' rule does not present a risk.
+        d_GEN_MemoryCopy((Uint8_t *)&pRequest->sg[entry].pBuffer[offset], &pEntry->data[0], SECTOR_SIZE);
+      }
+      ELSE_DO_NOTHING
+    }
+  }
+
+  return;
+}
+
+/*********************************************************************//**
+  <!-- queueSubmit -->
+
+  Add a validated request to the tail of the queue and start it if the
+  queue was idle.
+*************************************************************************/
+static d_Status_t                   /** \return Function status */
+queueSubmit
+(
+const Uint32_t sector,              /**< [in] First sector number */
+const Uint32_t count,               /**< [in] Number of sectors */
+const d_MMC_SgEntry_t * const pSgList, /**< [in] Buffers in sector order */
+const Uint32_t sgCount,             /**< [in] Number of entries in the list */
+const Bool_t writeFlag,             /**< [in] d_TRUE to write, d_FALSE to read */
+const Bool_t writeBack,             /**< [in] d_TRUE for a write back of the cache */
+const d_MMC_Callback_t callback,    /**< [in] Completion callback, may be NULL */
+void * const pContext,              /**< [in] Parameter passed to the callback */
+Uint32_t * const pTag               /**< [out] Tag of the request, may be NULL */
+)
+{
+  d_Status_t returnValue = d_STATUS_SUCCESS;
+  Uint32_t index;
+
+  if (queueCount >= d_MMC_QUEUE_DEPTH)
+  {
+    returnValue = d_STATUS_BUFFER_FULL;
+  }
+  else
+  {
+    mmcRequest_t * pRequest = &requestQueue[(queueHead + queueCount) % d_MMC_QUEUE_DEPTH];
+
+    pRequest->state = REQUEST_PENDING;
+    pRequest->status = d_STATUS_SUCCESS;
+    pRequest->tag = nextTag;
+    pRequest->sector = sector;
+    pRequest->count = count;
+    pRequest->write = writeFlag;
+    pRequest->sgCount = sgCount;
+    for (index = 0u; index < sgCount; index++)
+    {
+      pRequest->sg[index] = pSgList[index];
+    }
+    pRequest->callback = callback;
+    pRequest->pContext = pContext;
+
+    if (pTag != NULL)
+    {
+      *pTag = nextTag;
+    }
+    ELSE_DO_NOTHING
+    nextTag++;
+
+    queueCount++;
+    queueStats.submitted++;
+    if (queueCount > queueStats.maxOutstanding)
+    {
+      queueStats.maxOutstanding = queueCount;
+    }
+    ELSE_DO_NOTHING
+
+    /* Cached copies are out of date once the write is queued, unless the cache is writing them */
+    if ((writeFlag == d_TRUE) && (writeBack == d_FALSE))
+    {
+      cacheDiscardRange(sector, count);
+    }
+    ELSE_DO_NOTHING
+
+    queueStartHead();
+  }
+
+  return returnValue;
+}
+
+/*********************************************************************//**
+  <!-- queueStartHead -->
+
+  Start the request at the head of the queue if it is pending. A request
+  that fails to start is marked done with the error, for the next poll to
+  report.
+*************************************************************************/
+static void                         /** \return None */
+queueStartHead
+(
+void
+)
+{
+  mmcRequest_t * pRequest = &requestQueue[queueHead];
+
+  if ((queueCount > 0u) && (pRequest->state == REQUEST_PENDING))
+  {
+    d_Status_t status = transferStart(pRequest);
+    if (status == d_STATUS_SUCCESS)
+    {
+      pRequest->state = REQUEST_ACTIVE;
+      activeStartTime = d_TIMER_ReadValueInTicks();
+    }
+    else
+    {
+      // gcov-jst 2 It is not practical to generate this failure during bench testing.
+      pRequest->status = status;
+      pRequest->state = REQUEST_DONE;
+    }
+  }
+  ELSE_DO_NOTHING
+
+  return;
+}
+
+/*********************************************************************//**
+  <!-- queueCheckActive -->
+
+  Check the request in progress for transfer complete, error or timeout.
+*************************************************************************/
+static void                         /** \return None */
+queueCheckActive
+(
+mmcRequest_t * const pRequest       /**< [in] Request in progress */
+)
+{
+  Uint32_t baseAddress = mmcInstance.Config.BaseAddress;
+  Uint16_t interruptStatus = XSdPs_ReadReg16(baseAddress, XSDPS_NORM_INTR_STS_OFFSET);
+  Uint32_t index;
+
+  if ((interruptStatus & XSDPS_INTR_ERR_MASK) != 0u)
+  {
+    // gcov-jst 4 It is not practical to generate this failure during bench testing.
+    d_ERROR_Logger(d_STATUS_DEVICE_ERROR, d_ERROR_CRITICALITY_NON_CRITICAL, pRequest->sector, pRequest->count,
+                   XSdPs_ReadReg16(baseAddress, XSDPS_ERR_INTR_STS_OFFSET), 0);
+    transferAbort();
+    pRequest->status = d_STATUS_DEVICE_ERROR;
+    pRequest->state = REQUEST_DONE;
+  }
+  else if ((interruptStatus & XSDPS_INTR_TC_MASK) != 0u)
+  {
+    XSdPs_WriteReg16(baseAddress, XSDPS_NORM_INTR_STS_OFFSET, XSDPS_INTR_TC_MASK);
+
+    if (pRequest->write == d_FALSE)
+    {
+      /* Discard any lines fetched while the transfer was in progress */
+      if (mmcInstance.Config.IsCacheCoherent == 0u)
+      {
+        for (index = 0u; index < pRequest->sgCount; index++)
+        {
+          // cppcheck-suppress misra-c2012-11.4; Conversion required for cache maintenance. Violation of 'Advisory' rule does not present a risk
+          d_MEMORY_DCacheInvalidateRange((Pointer_t)pRequest->sg[index].pBuffer, pRequest->sg[index].length);
+        }
+      }
+      // gcov-jst 1 It is not practical to generate this failure during bench testing.
+      ELSE_DO_NOTHING
+      cacheOverlayDirty(pRequest);
+    }
+    ELSE_DO_NOTHING
+
+    pRequest->status = d_STATUS_SUCCESS;
+    pRequest->state = REQUEST_DONE;
+  }
+  else if (d_TIMER_ElapsedMilliseconds(activeStartTime, NULL) > (d_MMC_REQUEST_TIMEOUT_MS + (pRequest->count / 32u)))
+  {
+    // gcov-jst 4 It is not practical to generate this failure during bench testing.
+    d_ERROR_Logger(d_STATUS_TIMEOUT, d_ERROR_CRITICALITY_NON_CRITICAL, pRequest->sector, pRequest->count, 0, 0);
+    transferAbort();
+    pRequest->status = d_STATUS_TIMEOUT;
+    pRequest->state = REQUEST_DONE;
+  }
+  else
+  {
+    /* Transfer in progress */
+    DO_NOTHING();
+  }
+
+  return;
+}
+
+/*********************************************************************//**
+  <!-- transferStart -->
+
+  Start a request. The ADMA2 descriptor table describes the buffers of the
+  request directly and the read or write command is sent. The function
+  returns once the command is accepted, the controller reports transfer
+  complete when the card has finished with the data.
+*************************************************************************/
+static d_Status_t                   /** \return Function status */
+transferStart
+(
+const mmcRequest_t * const pRequest /**< [in] Request to start */
+)
+{
+  d_Status_t returnValue = d_STATUS_SUCCESS;
+  Uint32_t descriptor = 0u;
+  Uint32_t index;
+  Uint32_t command;
+  Int32_t status;
+
+  // cppcheck-suppress misra-c2012-11.3; The ARM processor does not have any alignment restrictions for integers. Violation of 'Advisory' rule does not present a risk.
+  status = XSdPs_SetupTransfer((XSdPs *)&mmcInstance);
+  if (status != XST_SUCCESS)
+  {
+    // gcov-jst 1 It is not practical to generate this failure during bench testing.
+    returnValue = d_STATUS_DEVICE_ERROR;
+  }
+  ELSE_DO_NOTHING
+
+  if (returnValue == d_STATUS_SUCCESS)
+  {
+    for (index = 0u; index < pRequest->sgCount; index++)
+    {
+      // cppcheck-suppress misra-c2012-11.4; Conversion required to program the DMA. Violation of 'Advisory' rule does not present a risk
+      Uint32_t address = (Uint32_t)(Pointer_t)pRequest->sg[index].pBuffer;
+      Uint32_t remaining = pRequest->sg[index].length;
+
+      if (mmcInstance.Config.IsCacheCoherent == 0u)
+      {
+        if (pRequest->write == d_TRUE)
+        {
+          d_MEMORY_DCacheFlushRange((Pointer_t)address, remaining);
+        }
+        else
+        {
+          d_MEMORY_DCacheInvalidateRange((Pointer_t)address, remaining);
+        }
+      }
+      // gcov-jst 1 It is not practical to generate this failure during bench testing.
+      ELSE_DO_NOTHING
+
+      /* A length of zero in a descriptor means 64 kB */
+      while (remaining > 0u)
+      {
+        Uint32_t length = (remaining < XSDPS_DESC_MAX_LENGTH) ? remaining : XSDPS_DESC_MAX_LENGTH;
+        if (mmcInstance.HC_Version == XSDPS_HC_SPEC_V3)
+        {
+          adma2Table64[descriptor].Address = address;
+          adma2Table64[descriptor].Length = (Uint16_t)(length & 0xFFFFu);
+          adma2Table64[descriptor].Attribute = (Uint16_t)(XSDPS_DESC_TRAN | XSDPS_DESC_VALID);
+        }
+        else
+        {
+          adma2Table32[descriptor].Address = address;
+          adma2Table32[descriptor].Length = (Uint16_t)(length & 0xFFFFu);
+          adma2Table32[descriptor].Attribute = (Uint16_t)(XSDPS_DESC_TRAN | XSDPS_DESC_VALID);
+        }
+        address += length;
+        remaining -= length;
+        descriptor++;
+      }
+    }
+    if (mmcInstance.HC_Version == XSDPS_HC_SPEC_V3)
+    {
+      adma2Table64[descriptor - 1u].Attribute |= (Uint16_t)XSDPS_DESC_END;
+      // cppcheck-suppress misra-c2012-11.4; Conversion required to program the DMA. Violation of 'Advisory' rule does not present a risk
+      XSdPs_WriteReg(mmcInstance.Config.BaseAddress, XSDPS_ADMA_SAR_OFFSET, (Uint32_t)(Pointer_t)&adma2Table64[0]);
+      d_MEMORY_DCacheFlushRange((Pointer_t)&adma2Table64[0], descriptor * sizeof(XSdPs_Adma2Descriptor64));
+    }
+    else
+    {
+      adma2Table32[descriptor - 1u].Attribute |= (Uint16_t)XSDPS_DESC_END;
+      // cppcheck-suppress misra-c2012-11.4; Conversion required to program the DMA. Violation of 'Advisory' rule does not present a risk
+      XSdPs_WriteReg(mmcInstance.Config.BaseAddress, XSDPS_ADMA_SAR_OFFSET, (Uint32_t)(Pointer_t)&adma2Table32[0]);
+      d_MEMORY_DCacheFlushRange((Pointer_t)&adma2Table32[0], descriptor * sizeof(XSdPs_Adma2Descriptor32));
+    }
+
+    if (pRequest->count == 1u)
+    {
+      mmcInstance.TransferMode = (Uint16_t)(XSDPS_TM_BLK_CNT_EN_MASK | XSDPS_TM_DMA_EN_MASK);
+      command = (pRequest->write == d_TRUE) ? CMD24 : CMD17;
+    }
+    else
+    {
+      mmcInstance.TransferMode = (Uint16_t)(XSDPS_TM_AUTO_CMD12_EN_MASK | XSDPS_TM_BLK_CNT_EN_MASK |
+                                            XSDPS_TM_MUL_SIN_BLK_SEL_MASK | XSDPS_TM_DMA_EN_MASK);
+      command = (pRequest->write == d_TRUE) ? CMD25 : CMD18;
+    }
+    if (pRequest->write == d_FALSE)
+    {
+      mmcInstance.TransferMode |= (Uint16_t)XSDPS_TM_DAT_DIR_SEL_MASK;
+    }
+    ELSE_DO_NOTHING
+
+    /* Standard capacity cards are addressed in bytes, high capacity cards in blocks */
+    Uint32_t argument = pRequest->sector;
+    if (mmcInstance.HCS != 1u)
+    {
+      argument *= SECTOR_SIZE;
+    }
+    ELSE_DO_NOTHING
+
+    /* Returns when the command is complete, the data transfer continues */
+    // cppcheck-suppress misra-c2012-11.3; The ARM processor does not have any alignment restrictions for integers. Violation of 'Advisory' rule does not present a risk.
+    status = XSdPs_CmdTransfer((XSdPs *)&mmcInstance, command, argument, pRequest->count);
+    if (status != XST_SUCCESS)
+    {
+      // gcov-jst 2 It is not practical to generate this failure during bench testing.
+      d_ERROR_Logger(d_STATUS_DEVICE_ERROR, d_ERROR_CRITICALITY_NON_CRITICAL, pRequest->sector, pRequest->count, (Uint32_t)status, 1);
+      returnValue = d_STATUS_DEVICE_ERROR;
+    }
+    ELSE_DO_NOTHING
+  }
+  ELSE_DO_NOTHING
+
+  return returnValue;
+}
+
+/*********************************************************************//**
+  <!-- transferAbort -->
+
+  Abort the transfer in progress. The card is sent a stop command, then
+  the command and data lines of the controller are reset and all
+  interrupt status is cleared.
+*************************************************************************/
+static void                         /** \return None */
+transferAbort
+(
+void
+)
+{
+  Uint32_t baseAddress = mmcInstance.Config.BaseAddress;
+  Uint8_t resetMask = (Uint8_t)(XSDPS_SWRST_CMD_LINE_MASK | XSDPS_SWRST_DAT_LINE_MASK);
+  Uint32_t startTime;
+
+  XSdPs_WriteReg16(baseAddress, XSDPS_ERR_INTR_STS_OFFSET, (Uint16_t)XSDPS_ERROR_INTR_ALL_MASK);
+
+  /* The stop command does not use the data lines */
+  mmcInstance.TransferMode = 0u;
+  // cppcheck-suppress misra-c2012-11.3; The ARM processor does not have any alignment restrictions for integers. Violation of 'Advisory' rule does not present a risk.
+  (void)XSdPs_CmdTransfer((XSdPs *)&mmcInstance, CMD12, 0u, 0u);
+
+  XSdPs_WriteReg8(baseAddress, XSDPS_SW_RST_OFFSET, resetMask);
+  startTime = d_TIMER_ReadValueInTicks();
+  while (((XSdPs_ReadReg8(baseAddress, XSDPS_SW_RST_OFFSET) & resetMask) != 0u) &&
+         (d_TIMER_ElapsedMilliseconds(startTime, NULL) < LINE_RESET_TIMEOUT_MS))
+  {
+    DO_NOTHING();
+  }
+
+  XSdPs_WriteReg16(baseAddress, XSDPS_NORM_INTR_STS_OFFSET, (Uint16_t)XSDPS_NORM_INTR_ALL_MASK);
+  XSdPs_WriteReg16(baseAddress, XSDPS_ERR_INTR_STS_OFFSET, (Uint16_t)XSDPS_ERROR_INTR_ALL_MASK);
+
+  return;
+}
+
+/*********************************************************************//**
+  <!-- transferWait -->
+
+  Queue a transfer of a single buffer and service the queue until it
+  completes. Used by the synchronous functions, it waits for space if the
+  queue is full.
+*************************************************************************/
+static d_Status_t                   /** \return Function status */
+transferWait
+(
+const Uint32_t sector,              /**< [in] First sector number */
+const Uint32_t count,               /**< [in] Number of sectors */
+const Uint8_t * const pBuffer,      /**< [in] Buffer to write or to store data read */
+const Bool_t writeFlag,             /**< [in] d_TRUE to write, d_FALSE to read */
+const Bool_t writeBack              /**< [in] d_TRUE for a write back of the cache */
+)
+{
+  syncRequest_t request;
+  d_MMC_SgEntry_t sgEntry;
+  d_Status_t status;
+
+  request.done = d_FALSE;
+  request.status = d_STATUS_SUCCESS;
+  sgEntry.pBuffer = pBuffer;
+  sgEntry.length = count * SECTOR_SIZE;
+
+  do
+  {
+    status = queueSubmit(sector, count, &sgEntry, 1u, writeFlag, writeBack, syncCallback, &request, NULL);
+    if (status == d_STATUS_BUFFER_FULL)
+    {
+      (void)d_MMC_QueuePoll();
+    }
+    ELSE_DO_NOTHING
+  } while (status == d_STATUS_BUFFER_FULL);
+
+  if (status == d_STATUS_SUCCESS)
+  {
+    /* The queue fails a request that does not complete in time */
+    while (request.done != d_TRUE)
+    {
+      (void)d_MMC_QueuePoll();
+    }
+    status = request.status;
+  }
+  // gcov-jst 1 It is not practical to generate this failure during bench testing.
+  ELSE_DO_NOTHING
+
+  return status;
+}
+
+/*********************************************************************//**
+  <!-- syncCallback -->
+
+  Completion callback of a request made by a synchronous function.
+*************************************************************************/
+static void                         /** \return None */
+syncCallback
+(
+const Uint32_t tag,                 /**< [in] Tag of the request */
+const d_Status_t status,            /**< [in] Completion status */
+void * const pContext               /**< [in] Synchronous request */
+)
+{
+  syncRequest_t * pRequest = (syncRequest_t *)pContext;
+
+  UNUSED_PARAMETER(tag);
+
+  pRequest->status = status;
+  pRequest->done = d_TRUE;
+
+  return;
+}
+
+/*********************************************************************//**
+  <!-- SectorCheck -->
+
+  Write / Read sector test.
+*************************************************************************/
+static d_Status_t                   /** \return BIT result */
+SectorCheck
+(
+const Uint32_t sector,              /**< [in] Sector to test */
+const Pattern_t pattern             /**< [in] Pattern to write */
+)
+{
+  Uint32_t index;
+  d_Status_t status;
+  d_Status_t returnValue = d_STATUS_SUCCESS;
+
+  /* Write a sector with specified pattern */
+  for (index = 0; index < BUFFER_SIZE; index++)
+  {
+    if (pattern == PATTERN_0)
+    {
+      buffer[index] = (Uint16_t)(index * 3u);
+    }
+    else
+    {
+      buffer[index] = (Uint16_t)~(index * 3u);
+    }
+  }
+  
+  status = d_MMC_SectorWrite(sector, 1, (Uint8_t *)buffer);
+
+  if (status == d_STATUS_SUCCESS)
+  {    
+    /* Write to the device and remove from cache */
+    status = d_MMC_Flush();
+    cacheInvalidate();
+  }
+  // gcov-jst 1 It is not practical to generate this failure during bench testing.
+  ELSE_DO_NOTHING
 
   if (status == d_STATUS_SUCCESS)
   {    
-    /* Remove from cache */
-    cacheFlush();
     /* Read back the sector */
     d_GEN_MemorySet((Uint8_t *)buffer, 0, SECTOR_SIZE);
     status = d_MMC_SectorRead(sector, 1, (Uint8_t *)buffer);
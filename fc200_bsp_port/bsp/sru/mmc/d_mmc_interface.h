@@ -30,6 +30,42 @@
 
 /***** Constants ********************************************************/
 
+/* Sector cache geometry, the number of sets must be a power of two */
+#ifndef d_MMC_CACHE_SETS
+#define d_MMC_CACHE_SETS      16u
+#endif
+#ifndef d_MMC_CACHE_WAYS
+#define d_MMC_CACHE_WAYS      4u
+#endif
+
+/* Maximum number of adjacent dirty sectors combined in one multi-block write */
+#ifndef d_MMC_CACHE_COALESCE
+#define d_MMC_CACHE_COALESCE  8u
+#endif
+
+/* Number of requests that can be queued, including the one in progress */
+#ifndef d_MMC_QUEUE_DEPTH
+#define d_MMC_QUEUE_DEPTH     8u
+#endif
+
+/* Maximum number of scatter-gather entries in one queued request */
+#ifndef d_MMC_SG_MAX
+#define d_MMC_SG_MAX          8u
+#endif
+
+/* Number of ADMA2 descriptors, each describes up to 64 kB of one scatter-gather entry */
+#ifndef d_MMC_ADMA_DESCRIPTORS
+#define d_MMC_ADMA_DESCRIPTORS  32u
+#endif
+
+/* Time allowed for a request once started, plus 1 ms per 32 sectors */
+#ifndef d_MMC_REQUEST_TIMEOUT_MS
+#define d_MMC_REQUEST_TIMEOUT_MS  500u
+#endif
+
+/* Maximum number of sectors in one queued request */
+#define d_MMC_MAX_REQUEST_SECTORS  (0xFFFFu)
+
 /***** Type Definitions *************************************************/
 
 typedef struct
@@ -73,6 +109,38 @@ typedef struct
   Uint32_t BlkSize;          /**< Block Size*/
 } d_MMC_Instance_t;
 
+typedef struct
+{
+  Uint32_t readHits;         /**< Single sector reads served from the cache */
+  Uint32_t readMisses;       /**< Single sector reads from the device */
+  Uint32_t writeHits;        /**< Single sector writes to a sector already cached */
+  Uint32_t writeMisses;      /**< Single sector writes allocating a cache entry */
+  Uint32_t evictions;        /**< Dirty entries written back to make room */
+  Uint32_t flushes;          /**< Calls of d_MMC_Flush */
+  Uint32_t deviceWrites;     /**< Write commands issued by the cache */
+  Uint32_t sectorsWritten;   /**< Sectors written by the cache */
+} d_MMC_CacheStats_t;
+
+/* Scatter-gather list entry of a queued request */
+typedef struct
+{
+  const Uint8_t * pBuffer;   /**< Segment address, must be 16 byte aligned */
+  Uint32_t length;           /**< Segment length in bytes, a multiple of the sector size */
+} d_MMC_SgEntry_t;
+
+/* Completion callback of a queued request, called with the tag returned on submission */
+typedef void (*d_MMC_Callback_t)(const Uint32_t tag, const d_Status_t status, void * const pContext);
+
+typedef struct
+{
+  Uint32_t submitted;        /**< Requests queued */
+  Uint32_t completed;        /**< Requests completed successfully */
+  Uint32_t errors;           /**< Requests failed by the controller or card */
+  Uint32_t timeouts;         /**< Requests failed by timeout */
+  Uint32_t cancelled;        /**< Requests cancelled */
+  Uint32_t maxOutstanding;   /**< Largest number of requests outstanding at once */
+} d_MMC_QueueStats_t;
+
 /***** Variables ********************************************************/
 
 /***** Function Declarations ********************************************/
@@ -92,6 +160,35 @@ d_Status_t d_MMC_SectorRead(const Uint32_t sector, const Uint32_t count, Uint8_t
 /* Write one or more sectors */
 d_Status_t d_MMC_SectorWrite(const Uint32_t sector, const Uint32_t count, const Uint8_t * const pBuffer);
 
+/* Write all modified sectors held in the cache to the device */
+d_Status_t d_MMC_Flush(void);
+
+/* Get the sector cache statistics */
+d_Status_t d_MMC_GetCacheStats(d_MMC_CacheStats_t * const pStats);
+
+/* Queued (asynchronous) requests. The callback is made when the request completes, from
+   d_MMC_QueuePoll. Requests are performed in the order submitted. Buffers must remain valid
+   until the callback and read buffers should be cache line aligned. */
+d_Status_t d_MMC_ReadAsync(const Uint32_t sector, const Uint32_t count, Uint8_t * const pBuffer,
+                           const d_MMC_Callback_t callback, void * const pContext, Uint32_t * const pTag);
+
+d_Status_t d_MMC_WriteAsync(const Uint32_t sector, const Uint32_t count, const Uint8_t * const pBuffer,
+                            const d_MMC_Callback_t callback, void * const pContext, Uint32_t * const pTag);
+
+d_Status_t d_MMC_SubmitSg(const Uint32_t sector, const d_MMC_SgEntry_t * const pSgList, const Uint32_t sgCount, const Bool_t writeFlag,
+                          const d_MMC_Callback_t callback, void * const pContext, Uint32_t * const pTag);
+
+/* Cancel a queued request, the callback is made with d_STATUS_FAILURE */
+d_Status_t d_MMC_Cancel(const Uint32_t tag);
+
+/* Service completed requests and timeouts, returns the number of requests outstanding */
+Uint32_t d_MMC_QueuePoll(void);
+
+/* Background job servicing the request queue, runs again in the frame only while requests are being finished */
+Bool_t d_MMC_QueueBackground(void);
+
+d_Status_t d_MMC_GetQueueStats(d_MMC_QueueStats_t * const pStats);
+
 /* Erase one or more sectors */
 d_Status_t d_MMC_Erase(const Uint32_t sectorStart, const Uint32_t sectorEnd);
 
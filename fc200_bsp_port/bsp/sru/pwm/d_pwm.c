@@ -3,7 +3,9 @@
 \brief
    Module Title       : d_pwm.c
 
-  Abstract           : Pulse Width Modulation interface.
+  Abstract           : Pulse Width Modulation interface. Outputs may be
+                       written immediately or queued in a shadow table
+                       and written together by a commit, once per frame.
 
   Software Structure : SRS References: 136T-2200-131000-001-D20 SWREQ-327
                        SDD References: 136T-2200-131000-001-D22 SWDES-554
@@ -20,6 +22,7 @@
 #include "soc/defines/d_common_status.h"           /* Error status */
 #include "kernel/error_handler/d_error_handler.h"  /* Error handler */
 #include "kernel/general/d_gen_register.h"         /* Register functions */
+#include "soc/interrupt_manager/d_int_critical.h"  /* Critical section */
 
 /***** Constants ********************************************************/
 
@@ -56,8 +59,20 @@ static Bool_t initialised = d_FALSE;
 
 static Float32_t valueSpan[d_PWM_MAX_CHANNELS];
 
+/* Register values queued for the next commit and the values last written */
+static Uint32_t shadowValue[d_PWM_MAX_IOCS][d_PWM_MAX_CHANNELS];
+static Uint32_t outputValue[d_PWM_MAX_IOCS][d_PWM_MAX_CHANNELS];
+
+/* Channels whose queued value differs from the value last written */
+static Uint32_t pendingMask[d_PWM_MAX_IOCS];
+
+static d_PWM_CommitStats_t commitStats;
+
 /***** Function Declarations ********************************************/
 
+static Uint32_t outputRegister(const Uint32_t channel, const Float32_t value);
+static void outputWrite(const Uint32_t ioc, const Uint32_t channel, const Uint32_t regValue);
+
 /***** Function Definitions *********************************************/
 
 /*********************************************************************//**
@@ -156,8 +171,6 @@ const Uint32_t channel,           /**< [in] PWM channel */
 const Float32_t value             /**< [in] Value to set */
 )
 {
-  Float32_t outputValue = value;
-
   if (ioc >= d_PWM_CountIoc)
   {
     d_ERROR_Logger(d_STATUS_INVALID_PARAMETER, d_ERROR_CRITICALITY_CRITICAL_SHUTDOWN, 1, ioc, 0, 0);
@@ -169,8 +182,8 @@ const Float32_t value             /**< [in] Value to set */
   {
     // gcov-jst 3 It is not practical to generate this failure during bench testing.
     // cppcheck-suppress misra-c2012-15.5; Coding standard allows function to return if parameters are invalid
-    // cppcheck-suppress misra-c2012-10.4; Adding integer to error code is the most efficient method of implementing this
-    return d_STATUS_OFFLINE_IOCA + ioc;
+    // cppcheck-suppress misra-c2012-10.4; The offline codes descend with the IOC, subtracting it is the most efficient method of implementing this
+    return d_STATUS_OFFLINE_IOCA - (d_Status_t)ioc;
   }
 
   if (channel >= d_PWM_CountChannel)
@@ -187,24 +200,151 @@ const Float32_t value             /**< [in] Value to set */
     return d_STATUS_NOT_INITIALISED;
   }
   
-  if (value < d_PWM_Definition[channel].minimumValue)
+  outputWrite(ioc, channel, outputRegister(channel, value));
+  
+  return d_STATUS_SUCCESS;
+}
+
+/*********************************************************************//**
+  <!-- d_PWM_OutputQueue -->
+
+  Queue a PWM output in the shadow table. The value is scaled by the
+  channel definition as for d_PWM_Output and is written by the next call
+  of d_PWM_Commit, unless it equals the value already set.
+*************************************************************************/
+d_Status_t                        /** \return Status of operation */
+d_PWM_OutputQueue
+(
+const Uint32_t ioc,               /**< [in] IOC number */
+const Uint32_t channel,           /**< [in] PWM channel */
+const Float32_t value             /**< [in] Value to set */
+)
+{
+  if (ioc >= d_PWM_CountIoc)
   {
-    // gcov-jst 2 It is not practical to ensure coverage of this path during bench testing.
-    outputValue = d_PWM_Definition[channel].minimumValue;
-    d_ERROR_Logger(d_STATUS_INVALID_PARAMETER, d_ERROR_CRITICALITY_NON_CRITICAL, 3, (Uint32_t)(value * 1000.0f), 0, 0);
+    d_ERROR_Logger(d_STATUS_INVALID_PARAMETER, d_ERROR_CRITICALITY_CRITICAL_SHUTDOWN, 1, ioc, 0, 0);
+    // cppcheck-suppress misra-c2012-15.5; Coding standard allows function to return if parameters are invalid
+    return d_STATUS_INVALID_PARAMETER;
   }
 
-  if (value > d_PWM_Definition[channel].maximumValue)
+  if (channel >= d_PWM_CountChannel)
   {
-    // gcov-jst 2 It is not practical to ensure coverage of this path during bench testing.
-    outputValue = d_PWM_Definition[channel].maximumValue;
-    d_ERROR_Logger(d_STATUS_INVALID_PARAMETER, d_ERROR_CRITICALITY_NON_CRITICAL, 3, (Uint32_t)(value * 1000.0f), 0, 0);
+    d_ERROR_Logger(d_STATUS_INVALID_PARAMETER, d_ERROR_CRITICALITY_CRITICAL_SHUTDOWN, 2, channel, 0, 0);
+    // cppcheck-suppress misra-c2012-15.5; Coding standard allows function to return if parameters are invalid
+    return d_STATUS_INVALID_PARAMETER;
   }
 
-  Float32_t regValue = (outputValue - d_PWM_Definition[channel].minimumValue) / valueSpan[channel];
-  regValue = (regValue * OUTPUT_REG_SPAN) + MINIMUM_REG_VALUE + 0.05f;
-  d_GEN_RegisterWrite(d_PWM_AddressDefinition[ioc].pwmOutputBaseAddress + (channel * 0x04u), (Uint32_t)regValue);
-  
+  if (initialised != d_TRUE)
+  {
+    d_ERROR_Logger(d_STATUS_NOT_INITIALISED, d_ERROR_CRITICALITY_CRITICAL_SHUTDOWN, 0, 0, 0, 0);
+    // cppcheck-suppress misra-c2012-15.5; Coding standard allows function to return if parameters are invalid
+    return d_STATUS_NOT_INITIALISED;
+  }
+
+  Uint32_t regValue = outputRegister(channel, value);
+  Uint32_t channelMask = 1uL << channel;
+
+  shadowValue[ioc][channel] = regValue;
+
+  if (regValue != outputValue[ioc][channel])
+  {
+    pendingMask[ioc] |= channelMask;
+  }
+  else
+  {
+    /* Cancels any change queued earlier in the frame */
+    pendingMask[ioc] &= ~channelMask;
+    commitStats.unchanged++;
+  }
+
+  return d_STATUS_SUCCESS;
+}
+
+/*********************************************************************//**
+  <!-- d_PWM_Commit -->
+
+  Write all queued PWM outputs. The registers of an IOC are written
+  together with interrupts disabled so that all the changed channels
+  take effect from the same PWM period. Outputs of an IOC that is
+  offline remain queued.
+*************************************************************************/
+d_Status_t                        /** \return Status of operation */
+d_PWM_Commit
+(
+void
+)
+{
+  d_Status_t status = d_STATUS_SUCCESS;
+
+  if (initialised != d_TRUE)
+  {
+    d_ERROR_Logger(d_STATUS_NOT_INITIALISED, d_ERROR_CRITICALITY_CRITICAL_SHUTDOWN, 0, 0, 0, 0);
+    // cppcheck-suppress misra-c2012-15.5; Coding standard allows function to return if parameters are invalid
+    return d_STATUS_NOT_INITIALISED;
+  }
+
+  Bool_t written = d_FALSE;
+
+  for (Uint32_t ioc = 0; ioc < d_PWM_CountIoc; ioc++)
+  {
+    if (pendingMask[ioc] != 0u)
+    {
+      if (d_FCU_IocOnline(ioc) == d_TRUE)
+      {
+        Uint32_t interruptFlags = d_INT_CriticalSectionEnter();
+        for (Uint32_t channel = 0; channel < d_PWM_CountChannel; channel++)
+        {
+          if ((pendingMask[ioc] & (1uL << channel)) != 0u)
+          {
+            outputWrite(ioc, channel, shadowValue[ioc][channel]);
+            commitStats.outputsWritten++;
+          }
+          ELSE_DO_NOTHING
+        }
+        d_INT_CriticalSectionLeave(interruptFlags);
+
+        pendingMask[ioc] = 0u;
+        written = d_TRUE;
+      }
+      else
+      {
+        // gcov-jst 2 It is not practical to generate this failure during bench testing.
+        // cppcheck-suppress misra-c2012-10.4; The offline codes descend with the IOC, subtracting it is the most efficient method of implementing this
+        status = d_STATUS_OFFLINE_IOCA - (d_Status_t)ioc;
+      }
+    }
+    ELSE_DO_NOTHING
+  }
+
+  if (written == d_TRUE)
+  {
+    commitStats.commits++;
+  }
+  ELSE_DO_NOTHING
+
+  return status;
+}
+
+/*********************************************************************//**
+  <!-- d_PWM_GetCommitStats -->
+
+  Get the commit statistics.
+*************************************************************************/
+d_Status_t                          /** \return Status of operation */
+d_PWM_GetCommitStats
+(
+d_PWM_CommitStats_t * const pStats  /**< [out] Statistics */
+)
+{
+  if (pStats == NULL)
+  {
+    d_ERROR_Logger(d_STATUS_INVALID_PARAMETER, d_ERROR_CRITICALITY_NON_CRITICAL, 1, 0, 0, 0);
+    // cppcheck-suppress misra-c2012-15.5; Coding standard allows function to return if parameters are invalid
+    return d_STATUS_INVALID_PARAMETER;
+  }
+
+  *pStats = commitStats;
+
   return d_STATUS_SUCCESS;
 }
 
@@ -232,8 +372,8 @@ Float32_t * const pValue          /**< [out] Value read */
   {
     // gcov-jst 3 It is not practical to generate this failure during bench testing.
     // cppcheck-suppress misra-c2012-15.5; Coding standard allows function to return if parameters are invalid
-    // cppcheck-suppress misra-c2012-10.4; Adding integer to error code is the most efficient method of implementing this
-    return d_STATUS_OFFLINE_IOCA + ioc;
+    // cppcheck-suppress misra-c2012-10.4; The offline codes descend with the IOC, subtracting it is the most efficient method of implementing this
+    return d_STATUS_OFFLINE_IOCA - (d_Status_t)ioc;
   }
 
   if (channel >= d_PWM_CountChannel)
@@ -281,3 +421,57 @@ Float32_t * const pValue          /**< [out] Value read */
   return d_STATUS_SUCCESS;
 }
 
+/*********************************************************************//**
+  <!-- outputRegister -->
+
+  Output register value of a channel value, limited to the range of the
+  channel definition.
+*************************************************************************/
+static Uint32_t                   /** \return Register value */
+outputRegister
+(
+const Uint32_t channel,           /**< [in] PWM channel */
+const Float32_t value             /**< [in] Value to set */
+)
+{
+  Float32_t outputValue = value;
+
+  if (value < d_PWM_Definition[channel].minimumValue)
+  {
+    // gcov-jst 2 It is not practical to ensure coverage of this path during bench testing.
+    outputValue = d_PWM_Definition[channel].minimumValue;
+    d_ERROR_Logger(d_STATUS_INVALID_PARAMETER, d_ERROR_CRITICALITY_NON_CRITICAL, 3, (Uint32_t)(value * 1000.0f), 0, 0);
+  }
+
+  if (value > d_PWM_Definition[channel].maximumValue)
+  {
+    // gcov-jst 2 It is not practical to ensure coverage of this path during bench testing.
+    outputValue = d_PWM_Definition[channel].maximumValue;
+    d_ERROR_Logger(d_STATUS_INVALID_PARAMETER, d_ERROR_CRITICALITY_NON_CRITICAL, 3, (Uint32_t)(value * 1000.0f), 0, 0);
+  }
+
+  Float32_t regValue = (outputValue - d_PWM_Definition[channel].minimumValue) / valueSpan[channel];
+  regValue = (regValue * OUTPUT_REG_SPAN) + MINIMUM_REG_VALUE + 0.05f;
+
+  return (Uint32_t)regValue;
+}
+
+/*********************************************************************//**
+  <!-- outputWrite -->
+
+  Write an output register and record the value written. A queued change
+  to the channel is replaced by the value written.
+*************************************************************************/
+static void
+outputWrite
+(
+const Uint32_t ioc,               /**< [in] IOC number */
+const Uint32_t channel,           /**< [in] PWM channel */
+const Uint32_t regValue           /**< [in] Register value */
+)
+{
+  d_GEN_RegisterWrite(d_PWM_AddressDefinition[ioc].pwmOutputBaseAddress + (channel * 0x04u), regValue);
+  outputValue[ioc][channel] = regValue;
+  shadowValue[ioc][channel] = regValue;
+  pendingMask[ioc] &= ~(1uL << channel);
+}
@@ -24,6 +24,13 @@
 
 /***** Type Definitions *************************************************/
 
+typedef struct
+{
+  Uint32_t commits;         /**< Calls of d_PWM_Commit that wrote at least one output */
+  Uint32_t outputsWritten;  /**< Output registers written by d_PWM_Commit */
+  Uint32_t unchanged;       /**< Queued outputs equal to the value already set */
+} d_PWM_CommitStats_t;
+
 /***** Variables ********************************************************/
 
 /***** Function Declarations ********************************************/
@@ -34,6 +41,15 @@ d_Status_t d_PWM_Initialise(void);
 /* Set the PWM output */
 d_Status_t d_PWM_Output(const Uint32_t ioc, const Uint32_t channel, const Float32_t value);
 
+/* Queue a PWM output, written by d_PWM_Commit */
+d_Status_t d_PWM_OutputQueue(const Uint32_t ioc, const Uint32_t channel, const Float32_t value);
+
+/* Write all queued PWM outputs together */
+d_Status_t d_PWM_Commit(void);
+
+/* Get the commit statistics */
+d_Status_t d_PWM_GetCommitStats(d_PWM_CommitStats_t * const pStats);
+
 /* Read the PWM input */
 d_Status_t d_PWM_Input(const Uint32_t ioc, const Uint32_t channel, Float32_t * const pValue);
 
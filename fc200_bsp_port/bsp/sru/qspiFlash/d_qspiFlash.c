@@ -22,6 +22,7 @@
 #include "soc/defines/d_common_types.h"               /* Common type definitions */
 #include "soc/defines/d_common_status.h"              /* Common status and error definitions */
 #include "kernel/error_handler/d_error_handler.h"     /* Error handler */
+#include "kernel/general/d_gen_memory.h"              /* Memory functions */
 #include "kernel/general/d_gen_register.h"            /* Register functions */
 #include "soc/memory_manager/d_memory_cache.h"        /* Memory Manager: Cache functionality */
 #include "soc/timer/d_timer.h"                        /* Timer driver module */
@@ -36,6 +37,12 @@
 /* Duration of the reset signal in microseconds */
 #define RESET_TIME      10
 
+/* Number of words in a read cache line */
+#define CACHE_PAGE_WORDS  (d_QSPI_CACHE_PAGE_BYTES >> 2u)
+
+/* Largest read made through the cache, larger reads would only displace every line held */
+#define CACHE_READ_BYTES_MAX  (d_QSPI_CACHE_PAGE_BYTES * d_QSPI_CACHE_SETS * d_QSPI_CACHE_WAYS)
+
 /* QSPI module mode */
 typedef enum
 {
@@ -222,6 +229,51 @@ typedef struct
   volatile Uint32_t* pRxBuffer;                 /* Pointer to buffer used for receiving data from flash device */
 } d_QSPIO_handle_t;
 
+typedef enum
+{
+  LINE_INVALID = 0,
+  LINE_FILLING,
+  LINE_VALID
+} lineState_t;
+
+/* Read cache line, the data is first so that it occupies whole data cache lines */
+typedef struct
+{
+  Uint32_t data[CACHE_PAGE_WORDS] __attribute__((aligned(32)));
+  lineState_t state;
+  d_Status_t fillStatus;                        /* Status of the last fill, kept when the fill fails */
+  Uint32_t page;                                /* Flash address divided by the line size */
+  Uint32_t lastUse;
+  Bool_t prefetched;                            /* Fetched ahead of a stream and not yet read */
+} cacheLine_t;
+
+typedef enum
+{
+  REQUEST_PENDING = 0,
+  REQUEST_ACTIVE,
+  REQUEST_DONE
+} requestState_t;
+
+typedef struct
+{
+  requestState_t state;
+  d_Status_t status;
+  Uint32_t tag;
+  Uint32_t qspiAddress;
+  Uint32_t numWords;
+  Uint32_t * pBuffer;
+  cacheLine_t * pLine;                          /* Line being filled, NULL for a read to the caller's buffer */
+  d_QSPI_Callback_t callback;
+  void * pContext;
+} qspiRequest_t;
+
+/* Completion of a request made by a synchronous function */
+typedef struct
+{
+  Bool_t done;
+  d_Status_t status;
+} syncRequest_t;
+
 /***** Variables ********************************************************/
 
 static d_QSPIO_handle_t qspioHandle = {d_QSPI_UNINITIALISED,  /* qspiMode */
@@ -236,9 +288,49 @@ static d_QSPIO_handle_t qspioHandle = {d_QSPI_UNINITIALISED,  /* qspiMode */
                                        0u,                    /* rxedWords */
                                        NULL};                 /* pRxBuffer */
 
+/* Read cache, a page is held in the set selected by its low order bits */
+// cppcheck-suppress misra-c2012-8.9; Defining this large variable at the start of the module is more maintainable. Violation of 'Advisory' rule does not present a risk.
+static cacheLine_t cacheLines[d_QSPI_CACHE_SETS][d_QSPI_CACHE_WAYS];
+
+/* Use counter for least recently used replacement */
+static Uint32_t cacheUseCount;
+
+/* Flash address following the last cached read, a read starting here continues a stream */
+static Uint32_t streamNext;
+
+static d_QSPI_CacheStats_t cacheStats;
+
+/* Request queue, the request at the head is the one in progress */
+static qspiRequest_t requestQueue[d_QSPI_QUEUE_DEPTH];
+static Uint32_t queueHead;
+static Uint32_t queueCount;
+static Uint32_t nextTag;
+
+/* Timer value when the request in progress was started */
+static Uint32_t activeStartTime;
+
+static d_QSPI_QueueStats_t queueStats;
+
 /***** Function Declarations ********************************************/
 
-static d_Status_t performRead(const Uint32_t qspiAddress, const Uint32_t numWordsToRead, Uint32_t * const pReadBuffer);
+static d_Status_t readParameterCheck(const Uint32_t qspiAddress, const Uint32_t numWordsToRead, const Uint32_t * const pReadBuffer,
+                                     const Uint32_t readBufferSizeInWords);
+static d_Status_t cacheRead(const Uint32_t qspiAddress, const Uint32_t numBytes, Uint8_t * const pDestination);
+static void cacheFill(const Uint32_t firstPage, const Uint32_t lastPage, cacheLine_t * pFills[]);
+static Bool_t cacheHeld(const Uint32_t qspiAddress, const Uint32_t numBytes);
+static cacheLine_t * cacheLookup(const Uint32_t page);
+static cacheLine_t * cacheVictim(const Uint32_t page);
+static void cachePrefetch(const Uint32_t firstPage);
+static void cacheDiscardRange(const Uint32_t qspiAddress, const Uint32_t numBytes);
+static d_Status_t queueSubmit(const Uint32_t qspiAddress, const Uint32_t numWords, Uint32_t * const pBuffer, cacheLine_t * const pLine,
+                              const d_QSPI_Callback_t callback, void * const pContext, Uint32_t * const pTag, const Bool_t completed);
+static void queueStartHead(void);
+static void queueCheckActive(qspiRequest_t * const pRequest);
+static void queueDrain(void);
+static void requestFinish(qspiRequest_t * const pRequest, const d_Status_t status);
+static d_Status_t transferWait(const Uint32_t qspiAddress, const Uint32_t numWords, Uint32_t * const pBuffer, cacheLine_t * const pLine);
+static void syncCallback(const Uint32_t tag, const d_Status_t status, void * const pContext);
+static d_Status_t readStart(const qspiRequest_t * const pRequest);
 static d_Status_t readStatusComplete(void);
 static void setToDMAmode(void);
 static void setToIOmode(void);
@@ -285,6 +377,20 @@ void
   qspioHandle.rxedWords = 0u;
   qspioHandle.pRxBuffer = NULL;
 
+  /* Any request in progress is abandoned by the reset */
+  Uint32_t set;
+  Uint32_t way;
+  for (set = 0u; set < d_QSPI_CACHE_SETS; set++)
+  {
+    for (way = 0u; way < d_QSPI_CACHE_WAYS; way++)
+    {
+      cacheLines[set][way].state = LINE_INVALID;
+    }
+  }
+  streamNext = 0xFFFFFFFFu;
+  queueHead = 0u;
+  queueCount = 0u;
+
   /* Select Generic QSPI mode */
   d_GEN_RegisterWrite(QSPI_BASEADDR + GQSPI_SEL_OFFSET, GQSPI_SEL_GQSPI);
 
@@ -318,7 +424,11 @@ void
 /*********************************************************************//**
   <!-- d_QSPI_Read -->
 
-  Read QSPI flash memory with DMA into buffer.
+  Read QSPI flash memory with DMA into buffer. A read no larger than the
+  read cache is made through it a line at a time, larger reads are made
+  directly into the buffer. A read that misses the cache is queued behind
+  the outstanding requests and the queue is serviced until it completes, so
+  the callbacks of earlier queued reads may be made before it returns.
 *************************************************************************/
 d_Status_t                            /** \return QSPI flash read initiation status */
 d_QSPI_Read
@@ -329,73 +439,212 @@ Uint32_t* const pReadBuffer,          /**< [in] Read data will be stored at this
 const Uint32_t readBufferSizeInWords  /**< [in] Read buffer size in words - QSPI module will check sufficiency */
 )
 {
-  d_Status_t status = d_STATUS_SUCCESS;  /* Return parameter: Status of sub-sector read initiation */
+  d_Status_t status = readParameterCheck(qspiAddress, numWordsToRead, pReadBuffer, readBufferSizeInWords);
 
-  /* Out of bounds address and size */
-  Uint32_t numBytesToRead = numWordsToRead << d_QSPI_WORD_SHIFT;
-  if ((qspiAddress + numBytesToRead) > d_QSPI_FLASH_SIZE_IN_BYTES)
+  if (status == d_STATUS_SUCCESS)  /* All checks passed - Read through the cache or directly */
   {
-    d_ERROR_Logger(d_STATUS_INVALID_PARAMETER, d_ERROR_CRITICALITY_CRITICAL_SHUTDOWN, 1, qspiAddress + numBytesToRead, 0, 0);
-    // cppcheck-suppress misra-c2012-15.5; Coding standard allows function to return if parameters are invalid
-    return d_STATUS_INVALID_PARAMETER;
+    Uint32_t numBytesToRead = numWordsToRead << d_QSPI_WORD_SHIFT;
+    if (numBytesToRead <= CACHE_READ_BYTES_MAX)
+    {
+      // cppcheck-suppress misra-c2012-11.3; Conversion to bytes for copying from the cache. Violation of 'Required' rule does not present a risk.
+      status = cacheRead(qspiAddress, numBytesToRead, (Uint8_t *)pReadBuffer);
+    }
+    else
+    {
+      cacheStats.bypassReads++;
+      status = transferWait(qspiAddress, numWordsToRead, pReadBuffer, NULL);
+    }
   }
+  ELSE_DO_NOTHING
 
-  /* Nothing to do - 0 words to read OR bigger than the DMA can handle*/
-  if ((numWordsToRead == 0u) || (numWordsToRead > QSPI_DMA_WORDS_MAX))
+  return (status);
+}
+
+/*********************************************************************//**
+  <!-- d_QSPI_ReadAsync -->
+
+  Queue a read of QSPI flash memory with DMA into buffer. A read held
+  entirely in the cache is copied immediately, once its place in the queue
+  is reserved, and its callback is made by the next poll. The buffer must
+  remain valid until the callback is made.
+*************************************************************************/
+d_Status_t                            /** \return Function status */
+d_QSPI_ReadAsync
+(
+const Uint32_t qspiAddress,           /**< [in] QSPI flash memory start address to read */
+const Uint32_t numWordsToRead,        /**< [in] Number of words to read from QSPI flash memory */
+Uint32_t* const pReadBuffer,          /**< [in] Read data will be stored at this pointer */
+const Uint32_t readBufferSizeInWords, /**< [in] Read buffer size in words - QSPI module will check sufficiency */
+const d_QSPI_Callback_t callback,     /**< [in] Completion callback, may be NULL */
+void * const pContext,                /**< [in] Parameter passed to the callback */
+Uint32_t * const pTag                 /**< [out] Tag of the request, may be NULL */
+)
+{
+  d_Status_t status = readParameterCheck(qspiAddress, numWordsToRead, pReadBuffer, readBufferSizeInWords);
+
+  if (status == d_STATUS_SUCCESS)
   {
-    d_ERROR_Logger(d_STATUS_INVALID_PARAMETER, d_ERROR_CRITICALITY_CRITICAL_SHUTDOWN, 2, numWordsToRead, 0, 0);
-    // cppcheck-suppress misra-c2012-15.5; Coding standard allows function to return if parameters are invalid
-    return d_STATUS_INVALID_PARAMETER;
+    Uint32_t numBytesToRead = numWordsToRead << d_QSPI_WORD_SHIFT;
+    Bool_t held = d_FALSE;
+
+    if (numBytesToRead <= CACHE_READ_BYTES_MAX)
+    {
+      held = cacheHeld(qspiAddress, numBytesToRead);
+    }
+    ELSE_DO_NOTHING
+
+    /* The request is queued before the data is copied, so a full queue leaves the buffer untouched */
+    status = queueSubmit(qspiAddress, numWordsToRead, pReadBuffer, NULL, callback, pContext, pTag, held);
+
+    if ((status == d_STATUS_SUCCESS) && (held == d_TRUE))
+    {
+      /* Every line is valid so the read completes without waiting */
+      // cppcheck-suppress misra-c2012-11.3; Conversion to bytes for copying from the cache. Violation of 'Required' rule does not present a risk.
+      (void)cacheRead(qspiAddress, numBytesToRead, (Uint8_t *)pReadBuffer);
+    }
+    ELSE_DO_NOTHING
   }
+  ELSE_DO_NOTHING
 
-  /* Invalid readBuffer OR not 32 bit aligned address */
-  // cppcheck-suppress misra-c2012-11.4; Conversion necessary to check alignment validity. Violation of 'Advisory' rule does not present a risk.
-  if ((pReadBuffer == NULL) || (((Uint32_t)pReadBuffer & GQSPI_DMA_DST_ADDR_MASK) != (Uint32_t)pReadBuffer))
+  return status;
+}
+
+/*********************************************************************//**
+  <!-- d_QSPI_QueuePoll -->
+
+  Service the request queue. The read in progress is checked for
+  completion, error or timeout, callbacks are made for finished requests
+  and the next request is started. A callback is made with the request
+  removed from the queue, so it can submit further requests.
+************************************************************************/
+Uint32_t                            /** \return Number of requests outstanding */
+d_QSPI_QueuePoll
+(
+void
+)
+{
+  Bool_t more = d_TRUE;
+
+  while ((more == d_TRUE) && (queueCount > 0u))
   {
-    d_ERROR_Logger(d_STATUS_INVALID_PARAMETER, d_ERROR_CRITICALITY_CRITICAL_SHUTDOWN, 3, 0, 0, 0);
-    // cppcheck-suppress misra-c2012-15.5; Coding standard allows function to return if parameters are invalid
-    return d_STATUS_INVALID_PARAMETER;
+    qspiRequest_t * pRequest = &requestQueue[queueHead];
+
+    if (pRequest->state == REQUEST_ACTIVE)
+    {
+      queueCheckActive(pRequest);
+      if (pRequest->state == REQUEST_ACTIVE)
+      {
+        more = d_FALSE;
+      }
+      ELSE_DO_NOTHING
+    }
+    else if (pRequest->state == REQUEST_PENDING)
+    {
+      queueStartHead();
+    }
+    else
+    {
+      qspiRequest_t finished = *pRequest;
+
+      queueHead = (queueHead + 1u) % d_QSPI_QUEUE_DEPTH;
+      queueCount--;
+
+      if (finished.status == d_STATUS_SUCCESS)
+      {
+        queueStats.completed++;
+      }
+      else if (finished.status == d_STATUS_TIMEOUT)
+      {
+        // gcov-jst 2 It is not practical to generate this failure during bench testing.
+        queueStats.timeouts++;
+      }
+      else
+      {
+        // gcov-jst 1 It is not practical to generate this failure during bench testing.
+        queueStats.errors++;
+      }
+
+      if (finished.callback != NULL)
+      {
+        finished.callback(finished.tag, finished.status, finished.pContext);
+      }
+      ELSE_DO_NOTHING
+    }
   }
 
-  /* Inadequate readBuffer size */
-  if (readBufferSizeInWords < numWordsToRead)
+  return queueCount;
+}
+
+/*********************************************************************//**
+  <!-- d_QSPI_QueueBackground -->
+
+  Background job polling the request queue. The job asks to run again in
+  the frame only when the poll has finished a request and others remain
+  outstanding, a read still in flight leaves the slack to the later jobs.
+************************************************************************/
+Bool_t                              /** \return d_TRUE if the poll finished requests and others remain outstanding */
+d_QSPI_QueueBackground
+(
+void
+)
+{
+  Bool_t moreWork = d_FALSE;
+  const Uint32_t finished = queueStats.completed + queueStats.timeouts + queueStats.errors;
+
+  if ((d_QSPI_QueuePoll() != 0u) &&
+      ((queueStats.completed + queueStats.timeouts + queueStats.errors) != finished))
   {
-    d_ERROR_Logger(d_STATUS_INVALID_PARAMETER, d_ERROR_CRITICALITY_CRITICAL_SHUTDOWN, 4, readBufferSizeInWords, 0, 0);
-    // cppcheck-suppress misra-c2012-15.5; Coding standard allows function to return if parameters are invalid
-    return d_STATUS_INVALID_PARAMETER;
+    moreWork = d_TRUE;
   }
+  ELSE_DO_NOTHING
 
-  /* Initialisation check */
-  if (qspioHandle.qspiMode == d_QSPI_UNINITIALISED)
+  return moreWork;
+}
+
+/*********************************************************************//**
+  <!-- d_QSPI_GetQueueStats -->
+
+  Get the request queue statistics.
+************************************************************************/
+d_Status_t                            /** \return Function status */
+d_QSPI_GetQueueStats
+(
+d_QSPI_QueueStats_t * const pStats    /**< [out] Pointer to storage for statistics */
+)
+{
+  if (pStats == NULL)
   {
-    d_ERROR_Logger(d_STATUS_NOT_INITIALISED, d_ERROR_CRITICALITY_CRITICAL_SHUTDOWN, 0, 0, 0, 0);
+    d_ERROR_Logger(d_STATUS_INVALID_PARAMETER, d_ERROR_CRITICALITY_NON_CRITICAL, 0, 0, 0, 0);
     // cppcheck-suppress misra-c2012-15.5; Coding standard allows function to return if parameters are invalid
-    return d_STATUS_NOT_INITIALISED;
+    return d_STATUS_INVALID_PARAMETER;
   }
 
-  /* Transfer in progress check */
-  if (qspioHandle.isBusy == d_TRUE)
-  {
-    // gcov-jst 2 It is not practical to generate this failure during bench testing.
-    status = d_STATUS_DEVICE_BUSY;
-    d_ERROR_Logger(d_STATUS_DEVICE_BUSY, d_ERROR_CRITICALITY_NON_CRITICAL, 0, 0, 0, 0);
-  }
-  else
-  {
-    DO_NOTHING();
-  }
+  *pStats = queueStats;
 
-  if (status == d_STATUS_SUCCESS)  /* All checks passed - Initiate reading */
-  {
-    status = performRead(qspiAddress, numWordsToRead, pReadBuffer);
-  }
-  else
+  return d_STATUS_SUCCESS;
+}
+
+/*********************************************************************//**
+  <!-- d_QSPI_GetCacheStats -->
+
+  Get the read cache statistics.
+************************************************************************/
+d_Status_t                            /** \return Function status */
+d_QSPI_GetCacheStats
+(
+d_QSPI_CacheStats_t * const pStats    /**< [out] Pointer to storage for statistics */
+)
+{
+  if (pStats == NULL)
   {
-    // gcov-jst 1 It is not practical to generate this failure during bench testing.
-    DO_NOTHING();
+    d_ERROR_Logger(d_STATUS_INVALID_PARAMETER, d_ERROR_CRITICALITY_NON_CRITICAL, 0, 0, 0, 0);
+    // cppcheck-suppress misra-c2012-15.5; Coding standard allows function to return if parameters are invalid
+    return d_STATUS_INVALID_PARAMETER;
   }
 
-  return (status);
+  *pStats = cacheStats;
+
+  return d_STATUS_SUCCESS;
 }
 
 /*********************************************************************//**
@@ -456,14 +705,9 @@ const Uint32_t writeBufferSizeInWords /**< [in] Read buffer size in words - QSPI
     return d_STATUS_NOT_INITIALISED;
   }
 
-  /* Transfer in progress check */
-  if (qspioHandle.isBusy == d_TRUE)
-  {
-    // gcov-jst 2 It is not practical to generate this failure during bench testing.
-    status = d_STATUS_DEVICE_BUSY;
-    d_ERROR_Logger(d_STATUS_DEVICE_BUSY, d_ERROR_CRITICALITY_NON_CRITICAL, 2, 0, 0, 0);
-  }
-  ELSE_DO_NOTHING
+  /* Complete queued reads so the controller is free, then discard cached copies of the pages programmed */
+  queueDrain();
+  cacheDiscardRange(qspiAddress, numBytesToWrite);
 
   if (status == d_STATUS_SUCCESS)  /* All checks passed - Initiate reading */
   {
@@ -528,14 +772,9 @@ const Uint32_t qspiAddress  /**< [in] QSPI flash memory address in sub-sector to
     return d_STATUS_NOT_INITIALISED;
   }
 
-  /* Transfer in progress check */
-  if (qspioHandle.isBusy == d_TRUE)
-  {
-    // gcov-jst 2 It is not practical to generate this failure during bench testing.
-    status = d_STATUS_DEVICE_BUSY;
-    d_ERROR_Logger(d_STATUS_DEVICE_BUSY, d_ERROR_CRITICALITY_NON_CRITICAL, 2, 0, 0, 0);
-  }
-  ELSE_DO_NOTHING
+  /* Complete queued reads so the controller is free, then discard cached copies of the sub-sector */
+  queueDrain();
+  cacheDiscardRange(qspiAddress & ~((d_QSPI_SUB_SECTOR_SIZE_WORDS << d_QSPI_WORD_SHIFT) - 1u), d_QSPI_SUB_SECTOR_SIZE_WORDS << d_QSPI_WORD_SHIFT);
 
   if (status == d_STATUS_SUCCESS)  /* All checks passed - Initiate reading */
   {
@@ -690,6 +929,9 @@ Uint32_t * const pValue   /**< [out] pointer to storage for SFDP value */
     return d_STATUS_INVALID_PARAMETER;
   }
 
+  /* Complete queued reads so the controller is free */
+  queueDrain();
+
   chipSelectAssert();
 
   /* Setup and write command to TX FIFO */
@@ -777,99 +1019,754 @@ Uint32_t * const pValue   /**< [out] pointer to storage for SFDP value */
 }
 
 /*********************************************************************//**
-  <!-- d_QSPI_GetQspiModuleStatus -->
+  <!-- readParameterCheck -->
 
-  Get the current QSPI driver module status
+  Check the parameters of a read and that the driver is initialised.
 *************************************************************************/
-static d_Status_t               /** \return status */
-performRead
+static d_Status_t                     /** \return Function status */
+readParameterCheck
 (
-const Uint32_t qspiAddress,     /**< [in] QSPI flash memory start address to read */
-const Uint32_t numWordsToRead,  /**< [in] Number of bytes to read from QSPI flash memory */
-Uint32_t* const pReadBuffer     /**< [in] Read data will be stored at this pointer */
+const Uint32_t qspiAddress,           /**< [in] QSPI flash memory start address to read */
+const Uint32_t numWordsToRead,        /**< [in] Number of words to read from QSPI flash memory */
+const Uint32_t * const pReadBuffer,   /**< [in] Read data will be stored at this pointer */
+const Uint32_t readBufferSizeInWords  /**< [in] Read buffer size in words */
 )
 {
-  d_Status_t status;
-
+  /* Out of bounds address and size */
   Uint32_t numBytesToRead = numWordsToRead << d_QSPI_WORD_SHIFT;
+  if ((qspiAddress + numBytesToRead) > d_QSPI_FLASH_SIZE_IN_BYTES)
+  {
+    d_ERROR_Logger(d_STATUS_INVALID_PARAMETER, d_ERROR_CRITICALITY_CRITICAL_SHUTDOWN, 1, qspiAddress + numBytesToRead, 0, 0);
+    // cppcheck-suppress misra-c2012-15.5; Coding standard allows function to return if parameters are invalid
+    return d_STATUS_INVALID_PARAMETER;
+  }
 
-  qspioHandle.isBusy = d_TRUE;  /* This thread is busy */
-
-  /* Populate the READ command */
-  const Uint32_t READ_COMMAND_4B = 0x0000006Cu; /* 4-byte Quadrature output fast read */
-  status = transferCommand(READ_COMMAND_4B, qspiAddress);
-
-  if (status == d_STATUS_SUCCESS)  /* Command transferred successful - transfer dummy clocks */
+  /* Nothing to do - 0 words to read OR bigger than the DMA can handle*/
+  if ((numWordsToRead == 0u) || (numWordsToRead > QSPI_DMA_WORDS_MAX))
   {
-    status = transferDummyClocks();
+    d_ERROR_Logger(d_STATUS_INVALID_PARAMETER, d_ERROR_CRITICALITY_CRITICAL_SHUTDOWN, 2, numWordsToRead, 0, 0);
+    // cppcheck-suppress misra-c2012-15.5; Coding standard allows function to return if parameters are invalid
+    return d_STATUS_INVALID_PARAMETER;
   }
-  else
+
+  /* Invalid readBuffer OR not 32 bit aligned address */
+  // cppcheck-suppress misra-c2012-11.4; Conversion necessary to check alignment validity. Violation of 'Advisory' rule does not present a risk.
+  if ((pReadBuffer == NULL) || (((Uint32_t)pReadBuffer & GQSPI_DMA_DST_ADDR_MASK) != (Uint32_t)pReadBuffer))
   {
-    // gcov-jst 1 It is not practical to generate this failure during bench testing.
-    DO_NOTHING();
+    d_ERROR_Logger(d_STATUS_INVALID_PARAMETER, d_ERROR_CRITICALITY_CRITICAL_SHUTDOWN, 3, 0, 0, 0);
+    // cppcheck-suppress misra-c2012-15.5; Coding standard allows function to return if parameters are invalid
+    return d_STATUS_INVALID_PARAMETER;
   }
 
-  if (status == d_STATUS_SUCCESS)  /* Command and dummy clocks transferred successful - Initiate Read */
+  /* Inadequate readBuffer size */
+  if (readBufferSizeInWords < numWordsToRead)
   {
-    /* Write address information */
-    qspioHandle.pRxBuffer = pReadBuffer;
-    // cppcheck-suppress misra-c2012-11.4; Conversion necessary for register write function. Violation of 'Advisory' rule does not present a risk.
-    d_GEN_RegisterWrite(QSPI_BASEADDR + GQSPI_DMA_DST_ADDR_OFFSET, (Uint32_t)pReadBuffer);
-    d_GEN_RegisterWrite(QSPI_BASEADDR + GQSPI_DMA_DST_ADDR_MSB_OFFSET, 0u);
+    d_ERROR_Logger(d_STATUS_INVALID_PARAMETER, d_ERROR_CRITICALITY_CRITICAL_SHUTDOWN, 4, readBufferSizeInWords, 0, 0);
+    // cppcheck-suppress misra-c2012-15.5; Coding standard allows function to return if parameters are invalid
+    return d_STATUS_INVALID_PARAMETER;
+  }
 
-    /* Write number of bytes to DMA DST SIZE */
-    d_GEN_RegisterWrite(QSPI_BASEADDR + GQSPI_DMA_DST_SIZE_OFFSET, (numWordsToRead << d_QSPI_WORD_SHIFT));
+  /* Initialisation check */
+  if (qspioHandle.qspiMode == d_QSPI_UNINITIALISED)
+  {
+    d_ERROR_Logger(d_STATUS_NOT_INITIALISED, d_ERROR_CRITICALITY_CRITICAL_SHUTDOWN, 0, 0, 0, 0);
+    // cppcheck-suppress misra-c2012-15.5; Coding standard allows function to return if parameters are invalid
+    return d_STATUS_NOT_INITIALISED;
+  }
 
-    /* Generic FIFO general read setup (for exponent) without the data size */
-    Uint32_t genFifoEntry = GQSPI_GENFIFO_MODE_QUADSPI
-                          | GQSPI_GENFIFO_BUS_LOWER
-                          | GQSPI_GENFIFO_CS_LOWER
-                          | GQSPI_GENFIFO_DATA_XFER
-                          | GQSPI_GENFIFO_RX
-                          | GQSPI_GENFIFO_EXP;
+  return d_STATUS_SUCCESS;
+}
 
-    /* Populate one or more generic FIFO entries for the read */
-    populateGenFifoEntriesWithDataLength(numWordsToRead, &genFifoEntry);
+/*********************************************************************//**
+  <!-- cacheRead -->
+
+  Read through the cache. The read is taken in pieces of up to one line
+  in each set, so that no piece displaces another line of the same read.
+  The fills of the lines missing from a piece are queued together, then
+  each line is copied once filled. The read fails if one of its own fills
+  fails, a line whose prefetch failed is fetched again. A read that follows
+  on from the previous one starts prefetching the lines after it.
+*************************************************************************/
+static d_Status_t                   /** \return Function status */
+cacheRead
+(
+const Uint32_t qspiAddress,         /**< [in] QSPI flash memory start address to read */
+const Uint32_t numBytes,            /**< [in] Number of bytes, no more than the cache holds */
+Uint8_t * const pDestination        /**< [out] Read data will be stored at this pointer */
+)
+{
+  d_Status_t status = d_STATUS_SUCCESS;
+  Uint32_t offset = 0u;
 
-    /* Cache invalidate range */
-    // cppcheck-suppress misra-c2012-11.4; Conversion necessary for memory cache function. Violation of 'Advisory' rule does not present a risk.
-    d_MEMORY_DCacheInvalidateRange((Pointer_t)pReadBuffer, numBytesToRead);
+  while ((offset < numBytes) && (status == d_STATUS_SUCCESS))
+  {
+    Uint32_t firstPage = (qspiAddress + offset) / d_QSPI_CACHE_PAGE_BYTES;
+    Uint32_t lastPage = (qspiAddress + numBytes - 1u) / d_QSPI_CACHE_PAGE_BYTES;
+    if (lastPage >= (firstPage + d_QSPI_CACHE_SETS))
+    {
+      lastPage = firstPage + d_QSPI_CACHE_SETS - 1u;
+    }
+    ELSE_DO_NOTHING
 
-    /* Start the read */
-    qspioHandle.qspiModStatus = d_QSPI_STATUS_READ_BUSY;
-    startGenericFifoCommandExecution();
+    cacheLine_t * fills[d_QSPI_CACHE_SETS];
+    cacheFill(firstPage, lastPage, fills);
 
-    /* Wait for completion */
-    Uint32_t qspiDmaInterruptStatus = 0u;
-    Uint32_t startTime = d_TIMER_ReadValueInTicks();
-    Uint32_t elapsedTime = 0;
-    const Uint32_t MAX_READ_TIME = 1000000;
-    do
+    Uint32_t page = firstPage;
+    while ((page <= lastPage) && (status == d_STATUS_SUCCESS))
     {
-      qspiDmaInterruptStatus = d_GEN_RegisterRead(QSPI_BASEADDR + GQSPI_DMA_DST_I_STS_OFFSET); /* Read DMA interrupt status...*/
-      elapsedTime = d_TIMER_ElapsedMicroseconds(startTime, NULL);
-    } while (((qspiDmaInterruptStatus & GQSPI_DMA_DST_I_STS_DONE_MASK) != GQSPI_DMA_DST_I_STS_DONE_MASK) && (elapsedTime < MAX_READ_TIME));
-    d_GEN_RegisterWrite(QSPI_BASEADDR + GQSPI_DMA_DST_I_STS_OFFSET, qspiDmaInterruptStatus);          /* ...and write to clear */
+      Uint32_t address = qspiAddress + offset;
+      Uint32_t pageOffset = address % d_QSPI_CACHE_PAGE_BYTES;
+      Uint32_t length = d_QSPI_CACHE_PAGE_BYTES - pageOffset;
+      if (length > (numBytes - offset))
+      {
+        length = numBytes - offset;
+      }
+      ELSE_DO_NOTHING
 
-    status = chipSelectDeassert();
+      /* A line found held may still be being prefetched, the request filling it is serviced */
+      cacheLine_t * pLine = fills[page - firstPage];
+      Bool_t ownFill = (pLine != NULL) ? d_TRUE : d_FALSE;
+      if (ownFill == d_FALSE)
+      {
+        pLine = cacheLookup(page);
+      }
+      ELSE_DO_NOTHING
+      while ((pLine != NULL) && (pLine->state == LINE_FILLING))
+      {
+        (void)d_QSPI_QueuePoll();
+      }
 
-    if ((status != d_STATUS_SUCCESS) || ((qspiDmaInterruptStatus & GQSPI_DMA_DST_INTR_ERR_MASK) != 0u)) /* Something went wrong */
-    {
-      // gcov-jst 1 It is not practical to generate this failure during bench testing.
-      qspioHandle.qspiModStatus = d_QSPI_STATUS_ERROR;
-    }
-    else
+      if ((ownFill == d_TRUE) && (pLine->state == LINE_INVALID))
+      {
+        // gcov-jst 1 It is not practical to generate this failure during bench testing.
+        status = pLine->fillStatus;
+      }
+      else if ((pLine == NULL) || (pLine->state != LINE_VALID) || (pLine->page != page))
+      {
+        /* The prefetch failed, the line is fetched again, the access has already been counted */
+        // gcov-jst 5 It is not practical to generate this failure during bench testing.
+        pLine = cacheVictim(page);
+        while (pLine == NULL)
+        {
+          (void)d_QSPI_QueuePoll();
+          pLine = cacheVictim(page);
+        }
+        status = transferWait(page * d_QSPI_CACHE_PAGE_BYTES, CACHE_PAGE_WORDS, pLine->data, pLine);
+      }
+      ELSE_DO_NOTHING
+
+      if (status == d_STATUS_SUCCESS)
+      {
+        cacheUseCount++;
+        pLine->lastUse = cacheUseCount;
+        pLine->prefetched = d_FALSE;
+        // cppcheck-suppress misra-c2012-11.3; Conversion to bytes for copying from the cache. Violation of 'Required' rule does not present a risk.
+        d_GEN_MemoryCopy(&pDestination[offset], &((const Uint8_t *)pLine->data)[pageOffset], length);
+      }
+      // gcov-jst 1 It is not practical to generate this failure during bench testing.
+      ELSE_DO_NOTHING
+
+      offset = offset + length;
+      page++;
+    }
+  }
+
+  if (status == d_STATUS_SUCCESS)
+  {
+    if (qspiAddress == streamNext)
+    {
+      cachePrefetch(((qspiAddress + numBytes - 1u) / d_QSPI_CACHE_PAGE_BYTES) + 1u);
+    }
+    ELSE_DO_NOTHING
+    streamNext = qspiAddress + numBytes;
+  }
+  // gcov-jst 1 It is not practical to generate this failure during bench testing.
+  ELSE_DO_NOTHING
+
+  return status;
+}
+
+/*********************************************************************//**
+  <!-- cacheFill -->
+
+  Count the access to each line of a piece of a read once, as a hit, a
+  prefetch hit or a miss, and queue the fills of the lines missing. The
+  pages are consecutive and no more than the number of sets, so each is
+  in a different set.
+*************************************************************************/
+static void                         /** \return None */
+cacheFill
+(
+const Uint32_t firstPage,           /**< [in] First page of the piece */
+const Uint32_t lastPage,            /**< [in] Last page of the piece */
+cacheLine_t * pFills[]              /**< [out] Line filled for each page from the first, NULL for a page found held */
+)
+{
+  Uint32_t page;
+
+  for (page = firstPage; page <= lastPage; page++)
+  {
+    const cacheLine_t * pFound = cacheLookup(page);
+
+    pFills[page - firstPage] = NULL;
+    if (pFound == NULL)
+    {
+      cacheStats.readMisses++;
+
+      /* Wait for a line to become free if all in the set are being filled */
+      cacheLine_t * pLine = cacheVictim(page);
+      while (pLine == NULL)
+      {
+        // gcov-jst 2 It is not practical to generate this failure during bench testing.
+        (void)d_QSPI_QueuePoll();
+        pLine = cacheVictim(page);
+      }
+      while (queueSubmit(page * d_QSPI_CACHE_PAGE_BYTES, CACHE_PAGE_WORDS, pLine->data, pLine, NULL, NULL, NULL, d_FALSE) ==
+             d_STATUS_BUFFER_FULL)
+      {
+        (void)d_QSPI_QueuePoll();
+      }
+      pFills[page - firstPage] = pLine;
+    }
+    else if (pFound->prefetched == d_TRUE)
+    {
+      cacheStats.prefetchHits++;
+    }
+    else
+    {
+      cacheStats.readHits++;
+    }
+  }
+
+  return;
+}
+
+/*********************************************************************//**
+  <!-- cacheHeld -->
+
+  Check whether every line spanned by a read is held and valid.
+*************************************************************************/
+static Bool_t                       /** \return d_TRUE if the read can be copied from the cache without waiting */
+cacheHeld
+(
+const Uint32_t qspiAddress,         /**< [in] QSPI flash memory start address to read */
+const Uint32_t numBytes             /**< [in] Number of bytes, no more than the cache holds */
+)
+{
+  Uint32_t firstPage = qspiAddress / d_QSPI_CACHE_PAGE_BYTES;
+  Uint32_t lastPage = (qspiAddress + numBytes - 1u) / d_QSPI_CACHE_PAGE_BYTES;
+  Bool_t held = d_TRUE;
+  Uint32_t page;
+
+  for (page = firstPage; page <= lastPage; page++)
+  {
+    const cacheLine_t * pLine = cacheLookup(page);
+    if ((pLine == NULL) || (pLine->state != LINE_VALID))
+    {
+      held = d_FALSE;
+    }
+    ELSE_DO_NOTHING
+  }
+
+  return held;
+}
+
+/*********************************************************************//**
+  <!-- cacheLookup -->
+
+  Find the line holding or filling a page.
+*************************************************************************/
+static cacheLine_t *                /** \return Cache line, or NULL if the page is not held */
+cacheLookup
+(
+const Uint32_t page                 /**< [in] Flash address divided by the line size */
+)
+{
+  cacheLine_t * pFound = NULL;
+  Uint32_t set = page & (d_QSPI_CACHE_SETS - 1u);
+  Uint32_t way;
+
+  for (way = 0u; way < d_QSPI_CACHE_WAYS; way++)
+  {
+    cacheLine_t * pLine = &cacheLines[set][way];
+    if ((pLine->state != LINE_INVALID) && (pLine->page == page))
+    {
+      pFound = pLine;
+    }
+    ELSE_DO_NOTHING
+  }
+
+  return pFound;
+}
+
+/*********************************************************************//**
+  <!-- cacheVictim -->
+
+  Choose the line to be filled with a page, an invalid line if there is one
+  in the set, otherwise the least recently used valid line. A line being
+  filled is never chosen. The line returned is marked as filling.
+*************************************************************************/
+static cacheLine_t *                /** \return Cache line, or NULL if every line in the set is being filled */
+cacheVictim
+(
+const Uint32_t page                 /**< [in] Flash address divided by the line size */
+)
+{
+  cacheLine_t * pVictim = NULL;
+  Uint32_t set = page & (d_QSPI_CACHE_SETS - 1u);
+  Uint32_t way;
+
+  for (way = 0u; way < d_QSPI_CACHE_WAYS; way++)
+  {
+    cacheLine_t * pLine = &cacheLines[set][way];
+    if (pLine->state == LINE_INVALID)
+    {
+      if ((pVictim == NULL) || (pVictim->state != LINE_INVALID))
+      {
+        pVictim = pLine;
+      }
+      ELSE_DO_NOTHING
+    }
+    else if (pLine->state == LINE_VALID)
+    {
+      if ((pVictim == NULL) || ((pVictim->state == LINE_VALID) && (pLine->lastUse < pVictim->lastUse)))
+      {
+        pVictim = pLine;
+      }
+      ELSE_DO_NOTHING
+    }
+    else
+    {
+      DO_NOTHING();
+    }
+  }
+
+  if (pVictim != NULL)
+  {
+    pVictim->state = LINE_FILLING;
+    pVictim->page = page;
+    pVictim->prefetched = d_FALSE;
+    cacheUseCount++;
+    pVictim->lastUse = cacheUseCount;
+  }
+  ELSE_DO_NOTHING
+
+  return pVictim;
+}
+
+/*********************************************************************//**
+  <!-- cachePrefetch -->
+
+  Queue fills of the lines following a sequential stream. Lines already
+  held are skipped and a slot in the queue is always left for the caller.
+*************************************************************************/
+static void                         /** \return None */
+cachePrefetch
+(
+const Uint32_t firstPage            /**< [in] First page to fetch */
+)
+{
+  Uint32_t pageLimit = d_QSPI_FLASH_SIZE_IN_BYTES / d_QSPI_CACHE_PAGE_BYTES;
+  Uint32_t page = firstPage;
+
+  while ((page < (firstPage + d_QSPI_PREFETCH_PAGES)) && (page < pageLimit) && ((queueCount + 1u) < d_QSPI_QUEUE_DEPTH))
+  {
+    if (cacheLookup(page) == NULL)
+    {
+      cacheLine_t * pLine = cacheVictim(page);
+      if (pLine != NULL)
+      {
+        pLine->prefetched = d_TRUE;
+        (void)queueSubmit(page * d_QSPI_CACHE_PAGE_BYTES, CACHE_PAGE_WORDS, pLine->data, pLine, NULL, NULL, NULL, d_FALSE);
+        cacheStats.prefetches++;
+      }
+      // gcov-jst 1 It is not practical to generate this failure during bench testing.
+      ELSE_DO_NOTHING
+    }
+    ELSE_DO_NOTHING
+    page++;
+  }
+
+  return;
+}
+
+/*********************************************************************//**
+  <!-- cacheDiscardRange -->
+
+  Discard lines overlapping a range of flash that is being programmed or
+  erased. The queue must be empty, so that no line is being filled.
+*************************************************************************/
+static void                         /** \return None */
+cacheDiscardRange
+(
+const Uint32_t qspiAddress,         /**< [in] QSPI flash memory start address */
+const Uint32_t numBytes             /**< [in] Number of bytes, greater than zero */
+)
+{
+  Uint32_t firstPage = qspiAddress / d_QSPI_CACHE_PAGE_BYTES;
+  Uint32_t lastPage = (qspiAddress + numBytes - 1u) / d_QSPI_CACHE_PAGE_BYTES;
+  Uint32_t set;
+  Uint32_t way;
+
+  for (set = 0u; set < d_QSPI_CACHE_SETS; set++)
+  {
+    for (way = 0u; way < d_QSPI_CACHE_WAYS; way++)
+    {
+      cacheLine_t * pLine = &cacheLines[set][way];
+      if ((pLine->state != LINE_INVALID) && (pLine->page >= firstPage) && (pLine->page <= lastPage))
+      {
+        pLine->state = LINE_INVALID;
+        cacheStats.invalidations++;
+      }
+      ELSE_DO_NOTHING
+    }
+  }
+
+  /* The stream is restarted by the next read */
+  streamNext = 0xFFFFFFFFu;
+
+  return;
+}
+
+/*********************************************************************//**
+  <!-- queueSubmit -->
+
+  Add a read to the tail of the queue and start it if the queue was idle.
+  A read already completed from the cache is added as done so that its
+  callback is made by the next poll.
+*************************************************************************/
+static d_Status_t                   /** \return Function status */
+queueSubmit
+(
+const Uint32_t qspiAddress,         /**< [in] QSPI flash memory start address to read */
+const Uint32_t numWords,            /**< [in] Number of words to read */
+Uint32_t * const pBuffer,           /**< [in] Buffer to store data read */
+cacheLine_t * const pLine,          /**< [in] Line being filled, NULL for a read to the caller's buffer */
+const d_QSPI_Callback_t callback,   /**< [in] Completion callback, may be NULL */
+void * const pContext,              /**< [in] Parameter passed to the callback */
+Uint32_t * const pTag,              /**< [out] Tag of the request, may be NULL */
+const Bool_t completed              /**< [in] d_TRUE if the read has been made from the cache */
+)
+{
+  d_Status_t returnValue = d_STATUS_SUCCESS;
+
+  if (queueCount >= d_QSPI_QUEUE_DEPTH)
+  {
+    returnValue = d_STATUS_BUFFER_FULL;
+  }
+  else
+  {
+    qspiRequest_t * pRequest = &requestQueue[(queueHead + queueCount) % d_QSPI_QUEUE_DEPTH];
+
+    pRequest->state = REQUEST_PENDING;
+    if (completed == d_TRUE)
     {
+      pRequest->state = REQUEST_DONE;
+    }
+    ELSE_DO_NOTHING
+    pRequest->status = d_STATUS_SUCCESS;
+    pRequest->tag = nextTag;
+    pRequest->qspiAddress = qspiAddress;
+    pRequest->numWords = numWords;
+    pRequest->pBuffer = pBuffer;
+    pRequest->pLine = pLine;
+    pRequest->callback = callback;
+    pRequest->pContext = pContext;
+
+    if (pTag != NULL)
+    {
+      *pTag = nextTag;
+    }
+    ELSE_DO_NOTHING
+    nextTag++;
+
+    queueCount++;
+    queueStats.submitted++;
+    if (queueCount > queueStats.maxOutstanding)
+    {
+      queueStats.maxOutstanding = queueCount;
+    }
+    ELSE_DO_NOTHING
+
+    queueStartHead();
+  }
+
+  return returnValue;
+}
+
+/*********************************************************************//**
+  <!-- queueStartHead -->
+
+  Start the request at the head of the queue if it is pending. A request
+  that fails to start is marked done with the error, for the next poll to
+  report.
+*************************************************************************/
+static void                         /** \return None */
+queueStartHead
+(
+void
+)
+{
+  qspiRequest_t * pRequest = &requestQueue[queueHead];
+
+  if ((queueCount > 0u) && (pRequest->state == REQUEST_PENDING))
+  {
+    d_Status_t status = readStart(pRequest);
+    if (status == d_STATUS_SUCCESS)
+    {
+      pRequest->state = REQUEST_ACTIVE;
+      activeStartTime = d_TIMER_ReadValueInTicks();
+    }
+    else
+    {
+      // gcov-jst 1 It is not practical to generate this failure during bench testing.
+      requestFinish(pRequest, status);
+    }
+  }
+  ELSE_DO_NOTHING
+
+  return;
+}
+
+/*********************************************************************//**
+  <!-- queueCheckActive -->
+
+  Check the read in progress for DMA done, error or timeout.
+*************************************************************************/
+static void                         /** \return None */
+queueCheckActive
+(
+qspiRequest_t * const pRequest      /**< [in] Request in progress */
+)
+{
+  Uint32_t qspiDmaInterruptStatus = d_GEN_RegisterRead(QSPI_BASEADDR + GQSPI_DMA_DST_I_STS_OFFSET);
+
+  if ((qspiDmaInterruptStatus & (GQSPI_DMA_DST_I_STS_DONE_MASK | GQSPI_DMA_DST_INTR_ERR_MASK)) != 0u)
+  {
+    d_GEN_RegisterWrite(QSPI_BASEADDR + GQSPI_DMA_DST_I_STS_OFFSET, qspiDmaInterruptStatus);  /* Write to clear */
+
+    d_Status_t status = chipSelectDeassert();
+
+    if ((status != d_STATUS_SUCCESS) || ((qspiDmaInterruptStatus & GQSPI_DMA_DST_INTR_ERR_MASK) != 0u)) /* Something went wrong */
+    {
+      // gcov-jst 4 It is not practical to generate this failure during bench testing.
+      d_ERROR_Logger(d_STATUS_DEVICE_ERROR, d_ERROR_CRITICALITY_NON_CRITICAL, pRequest->qspiAddress, pRequest->numWords, qspiDmaInterruptStatus, 0);
+      qspioHandle.qspiModStatus = d_QSPI_STATUS_ERROR;
+      status = d_STATUS_DEVICE_ERROR;
+    }
+    else
+    {
+      /* Discard any lines fetched while the transfer was in progress */
+      // cppcheck-suppress misra-c2012-11.4; Conversion necessary for memory cache function. Violation of 'Advisory' rule does not present a risk.
+      d_MEMORY_DCacheInvalidateRange((Pointer_t)pRequest->pBuffer, pRequest->numWords << d_QSPI_WORD_SHIFT);
       qspioHandle.qspiModStatus = d_QSPI_STATUS_READ_COMPLETE;
     }
+
+    requestFinish(pRequest, status);
+  }
+  else if (d_TIMER_ElapsedMilliseconds(activeStartTime, NULL) > d_QSPI_REQUEST_TIMEOUT_MS)
+  {
+    // gcov-jst 5 It is not practical to generate this failure during bench testing.
+    d_ERROR_Logger(d_STATUS_TIMEOUT, d_ERROR_CRITICALITY_NON_CRITICAL, pRequest->qspiAddress, pRequest->numWords, qspiDmaInterruptStatus, 0);
+    qspiReset();
+    qspioHandle.qspiModStatus = d_QSPI_STATUS_READ_FAIL;
+    requestFinish(pRequest, d_STATUS_TIMEOUT);
+  }
+  else
+  {
+    /* Transfer in progress */
+    DO_NOTHING();
+  }
+
+  return;
+}
+
+/*********************************************************************//**
+  <!-- queueDrain -->
+
+  Service the queue until every request has completed, before a command
+  that uses the controller without the queue.
+*************************************************************************/
+static void                         /** \return None */
+queueDrain
+(
+void
+)
+{
+  /* The queue fails a request that does not complete in time */
+  while (d_QSPI_QueuePoll() != 0u)
+  {
+    DO_NOTHING();
+  }
+
+  return;
+}
+
+/*********************************************************************//**
+  <!-- requestFinish -->
+
+  Mark a request done and update the cache line it was filling.
+*************************************************************************/
+static void                         /** \return None */
+requestFinish
+(
+qspiRequest_t * const pRequest,     /**< [in] Request started or in progress */
+const d_Status_t status             /**< [in] Completion status */
+)
+{
+  if (pRequest->pLine != NULL)
+  {
+    if (status == d_STATUS_SUCCESS)
+    {
+      pRequest->pLine->state = LINE_VALID;
+    }
+    else
+    {
+      // gcov-jst 2 It is not practical to generate this failure during bench testing.
+      pRequest->pLine->state = LINE_INVALID;
+      pRequest->pLine->fillStatus = status;
+    }
+  }
+  ELSE_DO_NOTHING
+
+  pRequest->status = status;
+  pRequest->state = REQUEST_DONE;
+  qspioHandle.isBusy = d_FALSE;
+
+  return;
+}
+
+/*********************************************************************//**
+  <!-- transferWait -->
+
+  Queue a read and service the queue until it completes. Used by the
+  synchronous functions, it waits for space if the queue is full.
+*************************************************************************/
+static d_Status_t                   /** \return Function status */
+transferWait
+(
+const Uint32_t qspiAddress,         /**< [in] QSPI flash memory start address to read */
+const Uint32_t numWords,            /**< [in] Number of words to read */
+Uint32_t * const pBuffer,           /**< [in] Buffer to store data read */
+cacheLine_t * const pLine           /**< [in] Line being filled, NULL for a read to the caller's buffer */
+)
+{
+  syncRequest_t request;
+  d_Status_t status;
+
+  request.done = d_FALSE;
+  request.status = d_STATUS_SUCCESS;
+
+  do
+  {
+    status = queueSubmit(qspiAddress, numWords, pBuffer, pLine, syncCallback, &request, NULL, d_FALSE);
+    if (status == d_STATUS_BUFFER_FULL)
+    {
+      (void)d_QSPI_QueuePoll();
+    }
+    ELSE_DO_NOTHING
+  } while (status == d_STATUS_BUFFER_FULL);
+
+  /* The queue fails a request that does not complete in time */
+  while (request.done != d_TRUE)
+  {
+    (void)d_QSPI_QueuePoll();
+  }
+
+  return request.status;
+}
+
+/*********************************************************************//**
+  <!-- syncCallback -->
+
+  Completion callback of a request made by a synchronous function.
+*************************************************************************/
+static void                         /** \return None */
+syncCallback
+(
+const Uint32_t tag,                 /**< [in] Tag of the request */
+const d_Status_t status,            /**< [in] Completion status */
+void * const pContext               /**< [in] Synchronous request */
+)
+{
+  // cppcheck-suppress misra-c2012-11.5; Conversion of the callback context. Violation of 'Advisory' rule does not present a risk.
+  syncRequest_t * pRequest = (syncRequest_t *)pContext;
+
+  UNUSED_PARAMETER(tag);
+
+  pRequest->status = status;
+  pRequest->done = d_TRUE;
+
+  return;
+}
+
+/*********************************************************************//**
+  <!-- readStart -->
+
+  Send the read command and start the DMA of a request. Completion is
+  checked by the queue.
+*************************************************************************/
+static d_Status_t                   /** \return status */
+readStart
+(
+const qspiRequest_t * const pRequest  /**< [in] Request to start */
+)
+{
+  d_Status_t status;
+
+  Uint32_t numBytesToRead = pRequest->numWords << d_QSPI_WORD_SHIFT;
+
+  qspioHandle.isBusy = d_TRUE;  /* This thread is busy */
+
+  /* Populate the READ command */
+  const Uint32_t READ_COMMAND_4B = 0x0000006Cu; /* 4-byte Quadrature output fast read */
+  status = transferCommand(READ_COMMAND_4B, pRequest->qspiAddress);
+
+  if (status == d_STATUS_SUCCESS)  /* Command transferred successful - transfer dummy clocks */
+  {
+    status = transferDummyClocks();
   }
   else
   {
     // gcov-jst 1 It is not practical to generate this failure during bench testing.
-    qspioHandle.qspiModStatus = d_QSPI_STATUS_READ_FAIL; /* Set module status to read fail */
+    DO_NOTHING();
   }
 
-  qspioHandle.isBusy = d_FALSE;  /* Read initiation fail, thread is not busy anymore */
+  if (status == d_STATUS_SUCCESS)  /* Command and dummy clocks transferred successful - Initiate Read */
+  {
+    /* Write address information */
+    qspioHandle.pRxBuffer = pRequest->pBuffer;
+    // cppcheck-suppress misra-c2012-11.4; Conversion necessary for register write function. Violation of 'Advisory' rule does not present a risk.
+    d_GEN_RegisterWrite(QSPI_BASEADDR + GQSPI_DMA_DST_ADDR_OFFSET, (Uint32_t)pRequest->pBuffer);
+    d_GEN_RegisterWrite(QSPI_BASEADDR + GQSPI_DMA_DST_ADDR_MSB_OFFSET, 0u);
+
+    /* Write number of bytes to DMA DST SIZE */
+    d_GEN_RegisterWrite(QSPI_BASEADDR + GQSPI_DMA_DST_SIZE_OFFSET, numBytesToRead);
+
+    /* Generic FIFO general read setup (for exponent) without the data size */
+    Uint32_t genFifoEntry = GQSPI_GENFIFO_MODE_QUADSPI
+                          | GQSPI_GENFIFO_BUS_LOWER
+                          | GQSPI_GENFIFO_CS_LOWER
+                          | GQSPI_GENFIFO_DATA_XFER
+                          | GQSPI_GENFIFO_RX
+                          | GQSPI_GENFIFO_EXP;
+
+    /* Populate one or more generic FIFO entries for the read */
+    populateGenFifoEntriesWithDataLength(pRequest->numWords, &genFifoEntry);
+
+    /* Cache invalidate range */
+    // cppcheck-suppress misra-c2012-11.4; Conversion necessary for memory cache function. Violation of 'Advisory' rule does not present a risk.
+    d_MEMORY_DCacheInvalidateRange((Pointer_t)pRequest->pBuffer, numBytesToRead);
+
+    /* Start the read */
+    qspioHandle.qspiModStatus = d_QSPI_STATUS_READ_BUSY;
+    startGenericFifoCommandExecution();
+  }
+  else
+  {
+    // gcov-jst 1 It is not practical to generate this failure during bench testing.
+    qspioHandle.qspiModStatus = d_QSPI_STATUS_READ_FAIL; /* Set module status to read fail */
+  }
 
   return status;
 }
@@ -47,8 +47,58 @@ typedef enum
 
 #define d_QSPI_SUB_SECTOR_SIZE_WORDS 1024u /* Number of words in sub-sector (singleChip = 4096 bytes = 1024 words) */
 
+/* Read cache line size in bytes, a power of two and a multiple of the 32 byte data cache line */
+#ifndef d_QSPI_CACHE_PAGE_BYTES
+#define d_QSPI_CACHE_PAGE_BYTES  256u
+#endif
+
+/* Read cache geometry, the number of sets must be a power of two */
+#ifndef d_QSPI_CACHE_SETS
+#define d_QSPI_CACHE_SETS        16u
+#endif
+#ifndef d_QSPI_CACHE_WAYS
+#define d_QSPI_CACHE_WAYS        4u
+#endif
+
+/* Number of pages fetched ahead of a sequential stream of cached reads, 0 to disable */
+#ifndef d_QSPI_PREFETCH_PAGES
+#define d_QSPI_PREFETCH_PAGES    4u
+#endif
+
+/* Number of requests that can be queued, including the one in progress */
+#ifndef d_QSPI_QUEUE_DEPTH
+#define d_QSPI_QUEUE_DEPTH       8u
+#endif
+
+/* Time allowed for a read once started */
+#ifndef d_QSPI_REQUEST_TIMEOUT_MS
+#define d_QSPI_REQUEST_TIMEOUT_MS  1000u
+#endif
+
 /***** Type Definitions *************************************************/
 
+typedef struct
+{
+  Uint32_t readHits;         /**< Cache lines read that were already held */
+  Uint32_t readMisses;       /**< Cache lines read that had to be fetched */
+  Uint32_t prefetches;       /**< Cache lines fetched ahead of a sequential stream */
+  Uint32_t prefetchHits;     /**< Reads that found a prefetched line held or being fetched */
+  Uint32_t bypassReads;      /**< Reads larger than the cache made directly to the caller's buffer */
+  Uint32_t invalidations;    /**< Cache lines discarded by program or erase */
+} d_QSPI_CacheStats_t;
+
+/* Completion callback of a queued read, called with the tag returned on submission */
+typedef void (*d_QSPI_Callback_t)(const Uint32_t tag, const d_Status_t status, void * const pContext);
+
+typedef struct
+{
+  Uint32_t submitted;        /**< Requests queued, including prefetches */
+  Uint32_t completed;        /**< Requests completed successfully */
+  Uint32_t errors;           /**< Requests failed by the controller */
+  Uint32_t timeouts;         /**< Requests failed by timeout */
+  Uint32_t maxOutstanding;   /**< Largest number of requests outstanding at once */
+} d_QSPI_QueueStats_t;
+
 /***** Variables ********************************************************/
 
 /***** Function Declarations ********************************************/
@@ -59,6 +109,23 @@ d_Status_t d_QSPI_Initialise(void);
 /* Read QSPI flash memory with DMA into buffer */
 d_Status_t d_QSPI_Read(const Uint32_t qspiAddress, const Uint32_t numWordsToRead, Uint32_t* const pReadBuffer, const Uint32_t readBufferSizeInWords);
 
+/* Queued (asynchronous) read. The callback is made when the read completes, from
+   d_QSPI_QueuePoll. Reads are performed in the order submitted. The buffer must remain
+   valid until the callback and should be cache line aligned. */
+d_Status_t d_QSPI_ReadAsync(const Uint32_t qspiAddress, const Uint32_t numWordsToRead, Uint32_t* const pReadBuffer, const Uint32_t readBufferSizeInWords,
+                            const d_QSPI_Callback_t callback, void * const pContext, Uint32_t * const pTag);
+
+/* Service completed reads and timeouts, returns the number of requests outstanding */
+Uint32_t d_QSPI_QueuePoll(void);
+
+/* Background job servicing the request queue, runs again in the frame only while requests are being finished */
+Bool_t d_QSPI_QueueBackground(void);
+
+d_Status_t d_QSPI_GetQueueStats(d_QSPI_QueueStats_t * const pStats);
+
+/* Get the read cache statistics */
+d_Status_t d_QSPI_GetCacheStats(d_QSPI_CacheStats_t * const pStats);
+
 /* Program QSPI flash memory from buffer */
 d_Status_t d_QSPI_Write(const Uint32_t qspiAddress, const Uint32_t numWordsToWrite, Uint32_t* const pWriteBuffer, const Uint32_t writeBufferSizeInWords);
 
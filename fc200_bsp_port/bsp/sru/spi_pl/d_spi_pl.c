@@ -20,6 +20,7 @@
 
 #include "soc/defines/d_common_status.h"              /* Error status */
 #include "soc/interrupt_manager/d_int_irq_handler.h"  /* Interrupt manager */
+#include "soc/interrupt_manager/d_int_critical.h"     /* Critical sections */
 #include "kernel/error_handler/d_error_handler.h"     /* Error handler */
 #include "kernel/general/d_gen_register.h"            /* Register functions */
 #include "sru/fcu/d_fcu_cfg.h"                            /* FCU CSC */
@@ -33,6 +34,7 @@ typedef struct
 {
   d_SPI_PL_State_t state;
   Uint32_t dataCount;
+  Bool_t abandoned;               /* Transfer of a cancelled transaction still running */
 } spiStatus_t;
 
 /***** Constants ********************************************************/
@@ -60,6 +62,10 @@ static Bool_t initialised[d_SPI_PL_MAX_INTERFACES] =
   d_FALSE, d_FALSE, d_FALSE, d_FALSE, d_FALSE, d_FALSE, d_FALSE, d_FALSE, d_FALSE, d_FALSE
 };
 
+/* Queued transactions of each channel, the head is the active transaction once started */
+static d_SPI_PL_Transaction_t * queueHead[d_SPI_PL_MAX_INTERFACES];
+static d_SPI_PL_Transaction_t * queueTail[d_SPI_PL_MAX_INTERFACES];
+
 /***** Function Declarations ********************************************/
 
 static void DeviceInterrupt(const Uint32_t channel,
@@ -72,6 +78,16 @@ static d_Status_t transfer(const Uint32_t channel,
                            const Uint8_t * const txBuffer,
                            const Uint32_t dataCount);
 
+static Uint32_t receive(const Uint32_t channel,
+                        Uint8_t * const rxBuffer,
+                        const Uint32_t bufferLength);
+
+static void queueStart(const Uint32_t channel);
+
+static void queueComplete(const Uint32_t channel);
+
+static void queueDiscard(const Uint32_t channel);
+
 static Uint32_t spiRegisterRead(const Uint32_t channel,
                                 const Uint32_t regOffset);
 
@@ -102,6 +118,7 @@ const Uint32_t channel            /**< [in]  Channel number */
   }
 
   spiStatus[channel].state = d_SPI_PL_STATUS_READY;
+  spiStatus[channel].abandoned = d_FALSE;
   (void)d_SPI_PL_Reset(channel);
   initialised[channel] = d_TRUE;
   /* Enable channel interrupt */
@@ -210,12 +227,15 @@ const Uint32_t dataCount          /**< [in]  Data byte count */
     return d_STATUS_INVALID_PARAMETER;
   }
 
+  /* Queued transactions may be started from an interrupt */
+  Uint32_t interruptFlags = d_INT_CriticalSectionEnter();
+
   if (spiStatus[channel].state == d_SPI_PL_STATUS_INIT)
   {
     // gcov-jst 1 It is not practical to generate this error during bench testing.
     status = d_STATUS_NOT_INITIALISED;
   }
-  else if (spiStatus[channel].state != d_SPI_PL_STATUS_READY)
+  else if ((spiStatus[channel].state != d_SPI_PL_STATUS_READY) || (queueHead[channel] != NULL))
   {
     status = d_STATUS_DEVICE_BUSY;
   }
@@ -233,6 +253,8 @@ const Uint32_t dataCount          /**< [in]  Data byte count */
     }
   }
 
+  d_INT_CriticalSectionLeave(interruptFlags);
+
   return status;
 }
 
@@ -302,34 +324,13 @@ Uint32_t * const pCount           /**< [out] Received byte count */
 
     if (spiStatus[channel].state == d_SPI_PL_STATUS_COMPLETE)
     {
-      Uint32_t index;
-
-      statusReg = spiRegisterRead(channel, REGISTER_OFFSET_STATUS);
-      Uint32_t rxcount = (statusReg >> 8u) & 0x7Fu;
-      *pCount = spiStatus[channel].dataCount;
-      if (bufferLength < spiStatus[channel].dataCount)
-      {
-  	    spiStatus[channel].dataCount = bufferLength;
-      }
-      ELSE_DO_NOTHING
-      /* Read received data */
-      for (index = 0; index < rxcount; index++)
-      {
-        Uint32_t readVal = spiRegisterRead(channel, REGISTER_OFFSET_FIFO);
-        if (rxBuffer != NULL)
-        {
-          Uint32_t ref = 0;
-          while ((((index * 4u) + ref) < spiStatus[channel].dataCount) && (ref < 4u))
-          {
-            rxBuffer[(index * 4u) + ref] = (Uint8_t)(readVal & 0xFFu);
-            readVal = readVal >> 8u;
-            ref++;
-          }
-        }
-        ELSE_DO_NOTHING
-      }
-      spiStatus[channel].state = d_SPI_PL_STATUS_READY;
+      *pCount = receive(channel, rxBuffer, bufferLength);
       *pStatus = spiStatus[channel].state;
+
+      /* Start the transactions queued while the channel was in use */
+      Uint32_t interruptFlags = d_INT_CriticalSectionEnter();
+      queueStart(channel);
+      d_INT_CriticalSectionLeave(interruptFlags);
     } /* end "if (spiStatus[channel] == d_SPI_PL_STATUS_BUSY)" */
     ELSE_DO_NOTHING
   }
@@ -403,6 +404,238 @@ d_SPI_PL_State_t * const pStatus  /**< [out] Pointer to storage for status */
   return status;
 }
 
+/*********************************************************************//**
+  <!-- d_SPI_PL_Queue -->
+
+  Queue a transaction, or a chain of transactions linked by pNext, to be
+  performed in order after those already queued. Each transaction is
+  started from the interrupt which completes the previous one, so the
+  caller does not wait for the bus. The state of each transaction is its
+  completion token; pNext is cleared when a transaction leaves the queue.
+*************************************************************************/
+d_Status_t                        /** \return Status of operation */
+d_SPI_PL_Queue
+(
+const Uint32_t channel,                       /**< [in]  Channel number */
+d_SPI_PL_Transaction_t * const pTransaction   /**< [in]  First transaction of the chain */
+)
+{
+  if (channel >= d_SPI_PL_Count)
+  {
+    d_ERROR_Logger(d_STATUS_INVALID_PARAMETER, d_ERROR_CRITICALITY_CRITICAL_SHUTDOWN, 1, channel, 0, 0);
+    // cppcheck-suppress misra-c2012-15.5; Coding standard allows function to return if parameters are invalid
+    return d_STATUS_INVALID_PARAMETER;
+  }
+
+  if (initialised[channel] != d_TRUE)
+  {
+    d_ERROR_Logger(d_STATUS_NOT_INITIALISED, d_ERROR_CRITICALITY_CRITICAL_SHUTDOWN, 0, channel, 0, 0);
+    // cppcheck-suppress misra-c2012-15.5; Coding standard allows function to return if parameters are invalid
+    return d_STATUS_NOT_INITIALISED;
+  }
+
+  if (pTransaction == NULL)
+  {
+    d_ERROR_Logger(d_STATUS_INVALID_PARAMETER, d_ERROR_CRITICALITY_CRITICAL_SHUTDOWN, 2, 0, 0, 0);
+    // cppcheck-suppress misra-c2012-15.5; Coding standard allows function to return if parameters are invalid
+    return d_STATUS_INVALID_PARAMETER;
+  }
+
+  /* Check the whole chain before any of it is queued */
+  d_SPI_PL_Transaction_t * pLast = pTransaction;
+  d_SPI_PL_Transaction_t * pCheck = pTransaction;
+  while (pCheck != NULL)
+  {
+    if ((pCheck->device >= d_SPI_PL_MAX_DEVICES) ||
+        (pCheck->cmdCount < 1u) || (pCheck->cmdCount > CMD_COUNT_MAX) ||
+        (pCheck->dataCount > DATA_COUNT_MAX))
+    {
+      d_ERROR_Logger(d_STATUS_INVALID_PARAMETER, d_ERROR_CRITICALITY_CRITICAL_SHUTDOWN, 3, pCheck->device, pCheck->cmdCount, pCheck->dataCount);
+      // cppcheck-suppress misra-c2012-15.5; Coding standard allows function to return if parameters are invalid
+      return d_STATUS_INVALID_PARAMETER;
+    }
+
+    if ((pCheck->state == d_SPI_PL_TRANSACTION_QUEUED) || (pCheck->state == d_SPI_PL_TRANSACTION_ACTIVE))
+    {
+      /* Already queued, the caller must wait for the token */
+      // cppcheck-suppress misra-c2012-15.5; Coding standard allows function to return if parameters are invalid
+      return d_STATUS_DEVICE_BUSY;
+    }
+    pLast = pCheck;
+    pCheck = pCheck->pNext;
+  }
+
+  pCheck = pTransaction;
+  while (pCheck != NULL)
+  {
+    pCheck->rxCount = 0u;
+    pCheck->state = d_SPI_PL_TRANSACTION_QUEUED;
+    pCheck = pCheck->pNext;
+  }
+
+  Uint32_t interruptFlags = d_INT_CriticalSectionEnter();
+  if (queueHead[channel] == NULL)
+  {
+    queueHead[channel] = pTransaction;
+  }
+  else
+  {
+    queueTail[channel]->pNext = pTransaction;
+  }
+  queueTail[channel] = pLast;
+  queueStart(channel);
+  d_INT_CriticalSectionLeave(interruptFlags);
+
+  return d_STATUS_SUCCESS;
+}
+
+/*********************************************************************//**
+  <!-- d_SPI_PL_Poll -->
+
+  Complete the active transaction if the transfer has finished. The
+  interrupt normally does this; polling lets an owner waiting on a token
+  progress with the interrupt masked.
+*************************************************************************/
+d_Status_t                        /** \return Status of operation */
+d_SPI_PL_Poll
+(
+const Uint32_t channel            /**< [in]  Channel number */
+)
+{
+  if (channel >= d_SPI_PL_Count)
+  {
+    d_ERROR_Logger(d_STATUS_INVALID_PARAMETER, d_ERROR_CRITICALITY_CRITICAL_SHUTDOWN, 1, channel, 0, 0);
+    // cppcheck-suppress misra-c2012-15.5; Coding standard allows function to return if parameters are invalid
+    return d_STATUS_INVALID_PARAMETER;
+  }
+
+  if (initialised[channel] != d_TRUE)
+  {
+    d_ERROR_Logger(d_STATUS_NOT_INITIALISED, d_ERROR_CRITICALITY_CRITICAL_SHUTDOWN, 0, channel, 0, 0);
+    // cppcheck-suppress misra-c2012-15.5; Coding standard allows function to return if parameters are invalid
+    return d_STATUS_NOT_INITIALISED;
+  }
+
+  d_Status_t status = d_FCU_IocAddressCheck(d_SPI_PL_Definition[channel].baseAddress);
+  if (status == d_STATUS_SUCCESS)
+  {
+    Uint32_t interruptFlags = d_INT_CriticalSectionEnter();
+    if (spiStatus[channel].abandoned == d_TRUE)
+    {
+      Uint32_t statusReg = spiRegisterRead(channel, REGISTER_OFFSET_STATUS);
+      if ((statusReg & 0x010000u) == 0u)
+      {
+        queueDiscard(channel);
+      }
+      ELSE_DO_NOTHING
+    }
+    else if ((queueHead[channel] != NULL) && (queueHead[channel]->state == d_SPI_PL_TRANSACTION_ACTIVE))
+    {
+      Uint32_t statusReg = spiRegisterRead(channel, REGISTER_OFFSET_STATUS);
+      if ((statusReg & 0x010000u) == 0u)
+      {
+        queueComplete(channel);
+      }
+      ELSE_DO_NOTHING
+    }
+    else
+    {
+      DO_NOTHING();
+    }
+    d_INT_CriticalSectionLeave(interruptFlags);
+  }
+  // gcov-jst 1 It is not practical to generate this failure during bench testing.
+  ELSE_DO_NOTHING
+
+  return status;
+}
+
+/*********************************************************************//**
+  <!-- d_SPI_PL_Cancel -->
+
+  Remove a transaction from the queue, marking it failed. The core cannot
+  stop a transfer, so an active transfer which is still running is
+  abandoned: the channel stays busy until it ends and its data is then
+  discarded by the interrupt, or by d_SPI_PL_Poll, before the next
+  transaction is started. The callback is not called. A transaction which
+  is not queued is left unchanged.
+*************************************************************************/
+d_Status_t                        /** \return Status of operation */
+d_SPI_PL_Cancel
+(
+const Uint32_t channel,                       /**< [in]  Channel number */
+d_SPI_PL_Transaction_t * const pTransaction   /**< [in]  Transaction to remove */
+)
+{
+  if (channel >= d_SPI_PL_Count)
+  {
+    d_ERROR_Logger(d_STATUS_INVALID_PARAMETER, d_ERROR_CRITICALITY_CRITICAL_SHUTDOWN, 1, channel, 0, 0);
+    // cppcheck-suppress misra-c2012-15.5; Coding standard allows function to return if parameters are invalid
+    return d_STATUS_INVALID_PARAMETER;
+  }
+
+  if (pTransaction == NULL)
+  {
+    d_ERROR_Logger(d_STATUS_INVALID_PARAMETER, d_ERROR_CRITICALITY_CRITICAL_SHUTDOWN, 2, 0, 0, 0);
+    // cppcheck-suppress misra-c2012-15.5; Coding standard allows function to return if parameters are invalid
+    return d_STATUS_INVALID_PARAMETER;
+  }
+
+  Uint32_t interruptFlags = d_INT_CriticalSectionEnter();
+
+  d_SPI_PL_Transaction_t * pPrevious = NULL;
+  d_SPI_PL_Transaction_t * pEntry = queueHead[channel];
+  while ((pEntry != NULL) && (pEntry != pTransaction))
+  {
+    pPrevious = pEntry;
+    pEntry = pEntry->pNext;
+  }
+
+  if (pEntry != NULL)
+  {
+    if (pEntry->state == d_SPI_PL_TRANSACTION_ACTIVE)
+    {
+      Uint32_t statusReg = spiRegisterRead(channel, REGISTER_OFFSET_STATUS);
+      if ((statusReg & 0x010000u) == 0u)
+      {
+        /* Finished, discard the data and its end of transfer interrupt */
+        // gcov-jst 2 It is not practical to generate this failure during bench testing.
+        (void)d_SPI_PL_Reset(channel);
+        spiStatus[channel].state = d_SPI_PL_STATUS_READY;
+      }
+      else
+      {
+        // gcov-jst 1 It is not practical to generate this failure during bench testing.
+        spiStatus[channel].abandoned = d_TRUE;
+      }
+    }
+    ELSE_DO_NOTHING
+
+    if (pPrevious == NULL)
+    {
+      queueHead[channel] = pEntry->pNext;
+    }
+    else
+    {
+      pPrevious->pNext = pEntry->pNext;
+    }
+    if (queueTail[channel] == pEntry)
+    {
+      queueTail[channel] = pPrevious;
+    }
+    ELSE_DO_NOTHING
+
+    pEntry->pNext = NULL;
+    pEntry->state = d_SPI_PL_TRANSACTION_FAILED;
+    queueStart(channel);
+  }
+  ELSE_DO_NOTHING
+
+  d_INT_CriticalSectionLeave(interruptFlags);
+
+  return d_STATUS_SUCCESS;
+}
+
 /*********************************************************************//**
   <!-- d_SPI_PL_InterruptHandler -->
 
@@ -455,10 +688,20 @@ const Uint32_t channel            /**< [in]  Channel number */
     DO_NOTHING();
   }
 
-  /* check for end of transmit */
-  if ((isr & 0x01u) != 0u)
+  /* check for end of transmit. The end of a transfer completed by d_SPI_PL_Poll is
+     still flagged, it is stale if the core is busy with the next transfer */
+  if (((isr & 0x01u) != 0u) && ((spiRegisterRead(channel, REGISTER_OFFSET_STATUS) & 0x010000u) == 0u))
   {
-    if (d_SPI_PL_Definition[channel].eventHandler != NULL)
+    if (spiStatus[channel].abandoned == d_TRUE)
+    {
+      // gcov-jst 1 It is not practical to generate this failure during bench testing.
+      queueDiscard(channel);
+    }
+    else if ((queueHead[channel] != NULL) && (queueHead[channel]->state == d_SPI_PL_TRANSACTION_ACTIVE))
+    {
+      queueComplete(channel);
+    }
+    else if (d_SPI_PL_Definition[channel].eventHandler != NULL)
     {
     	d_SPI_PL_Definition[channel].eventHandler(channel);
     }
@@ -574,6 +817,156 @@ const Uint32_t dataCount          /**< [in]  Data byte count */
   return d_STATUS_SUCCESS;
 }
 
+/*********************************************************************//**
+  <!-- receive -->
+
+  Read the received data of a completed transfer from the FIFO and set the
+  channel ready.
+*************************************************************************/
+static Uint32_t                   /** \return Received byte count */
+receive
+(
+const Uint32_t channel,           /**< [in]  Channel number */
+Uint8_t * const rxBuffer,         /**< [out] Storage for received data, may be NULL */
+const Uint32_t bufferLength       /**< [in]  Length of the receive buffer */
+)
+{
+  Uint32_t index;
+
+  Uint32_t statusReg = spiRegisterRead(channel, REGISTER_OFFSET_STATUS);
+  Uint32_t rxcount = (statusReg >> 8u) & 0x7Fu;
+  Uint32_t count = spiStatus[channel].dataCount;
+  if (bufferLength < spiStatus[channel].dataCount)
+  {
+    spiStatus[channel].dataCount = bufferLength;
+  }
+  ELSE_DO_NOTHING
+  /* Read received data */
+  for (index = 0; index < rxcount; index++)
+  {
+    Uint32_t readVal = spiRegisterRead(channel, REGISTER_OFFSET_FIFO);
+    if (rxBuffer != NULL)
+    {
+      Uint32_t ref = 0;
+      while ((((index * 4u) + ref) < spiStatus[channel].dataCount) && (ref < 4u))
+      {
+        rxBuffer[(index * 4u) + ref] = (Uint8_t)(readVal & 0xFFu);
+        readVal = readVal >> 8u;
+        ref++;
+      }
+    }
+    ELSE_DO_NOTHING
+  }
+  spiStatus[channel].state = d_SPI_PL_STATUS_READY;
+  spiStatus[channel].abandoned = d_FALSE;
+
+  return count;
+}
+
+/*********************************************************************//**
+  <!-- queueStart -->
+
+  Start the transaction at the head of the queue if the channel is ready.
+  Called with interrupts disabled.
+*************************************************************************/
+static void                       /** \return None */
+queueStart
+(
+const Uint32_t channel            /**< [in]  Channel number */
+)
+{
+  while ((queueHead[channel] != NULL) &&
+         (queueHead[channel]->state == d_SPI_PL_TRANSACTION_QUEUED) &&
+         (spiStatus[channel].state == d_SPI_PL_STATUS_READY))
+  {
+    d_SPI_PL_Transaction_t * const pTransaction = queueHead[channel];
+
+    if (d_FCU_IocAddressCheck(d_SPI_PL_Definition[channel].baseAddress) == d_STATUS_SUCCESS)
+    {
+      pTransaction->state = d_SPI_PL_TRANSACTION_ACTIVE;
+      (void)transfer(channel, pTransaction->device, &pTransaction->command[0], pTransaction->cmdCount,
+                     pTransaction->txBuffer, pTransaction->dataCount);
+    }
+    else
+    {
+      /* Interface offline, fail the transaction and try the next */
+      // gcov-jst 8 It is not practical to generate this failure during bench testing.
+      queueHead[channel] = pTransaction->pNext;
+      if (queueHead[channel] == NULL)
+      {
+        queueTail[channel] = NULL;
+      }
+      ELSE_DO_NOTHING
+      pTransaction->pNext = NULL;
+      pTransaction->state = d_SPI_PL_TRANSACTION_FAILED;
+      if (pTransaction->callback != NULL)
+      {
+        pTransaction->callback(channel, pTransaction->tag);
+      }
+      ELSE_DO_NOTHING
+    }
+  }
+
+  return;
+}
+
+/*********************************************************************//**
+  <!-- queueComplete -->
+
+  Store the received data of the active transaction, start the next
+  transaction and call the completion callback. Called from the interrupt
+  or with interrupts disabled.
+*************************************************************************/
+static void                       /** \return None */
+queueComplete
+(
+const Uint32_t channel            /**< [in]  Channel number */
+)
+{
+  d_SPI_PL_Transaction_t * const pTransaction = queueHead[channel];
+
+  pTransaction->rxCount = receive(channel, pTransaction->rxBuffer, pTransaction->bufferLength);
+
+  queueHead[channel] = pTransaction->pNext;
+  if (queueHead[channel] == NULL)
+  {
+    queueTail[channel] = NULL;
+  }
+  ELSE_DO_NOTHING
+  pTransaction->pNext = NULL;
+  pTransaction->state = d_SPI_PL_TRANSACTION_COMPLETE;
+
+  /* Keep the bus busy while the callback runs */
+  queueStart(channel);
+
+  if (pTransaction->callback != NULL)
+  {
+    pTransaction->callback(channel, pTransaction->tag);
+  }
+  ELSE_DO_NOTHING
+
+  return;
+}
+
+/*********************************************************************//**
+  <!-- queueDiscard -->
+
+  Discard the received data of a transfer abandoned by d_SPI_PL_Cancel
+  and start the next transaction. Called from the interrupt or with
+  interrupts disabled, once the transfer has ended.
+*************************************************************************/
+static void                       /** \return None */
+queueDiscard
+(
+const Uint32_t channel            /**< [in]  Channel number */
+)
+{
+  (void)receive(channel, NULL, 0u);
+  queueStart(channel);
+
+  return;
+}
+
 /*********************************************************************//**
   <!-- spiRegisterRead -->
 
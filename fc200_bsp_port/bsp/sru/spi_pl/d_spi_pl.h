@@ -34,8 +34,43 @@ typedef enum
   d_SPI_PL_STATUS_COMPLETE
 } d_SPI_PL_State_t;
 
+/* Maximum number of command bytes in a transfer */
+#define d_SPI_PL_COMMAND_MAX  8u
+
+/* Progress of a queued transaction, polled by the owner as the completion token */
+typedef enum
+{
+  d_SPI_PL_TRANSACTION_IDLE = 0,   /* Not queued, owner may modify */
+  d_SPI_PL_TRANSACTION_QUEUED,     /* Waiting for the channel */
+  d_SPI_PL_TRANSACTION_ACTIVE,     /* Transfer in progress */
+  d_SPI_PL_TRANSACTION_COMPLETE,   /* Received data stored, owner may modify */
+  d_SPI_PL_TRANSACTION_FAILED      /* Not performed or cancelled, owner may modify */
+} d_SPI_PL_TransactionState_t;
+
 /***** Type Definitions *************************************************/
 
+/* Called from the interrupt when a transaction completes or fails */
+typedef void (*d_SPI_PL_TransactionCallback_t) (const Uint32_t channel, const Uint32_t tag);
+
+/* Transaction queued with d_SPI_PL_Queue. The storage is owned by the caller and must
+   remain valid until the transaction is complete, failed or cancelled */
+typedef struct d_SPI_PL_Transaction_t
+{
+  Uint32_t device;                                  /* Device select */
+  Uint8_t command[d_SPI_PL_COMMAND_MAX];            /* Command bytes */
+  Uint32_t cmdCount;                                /* Command byte count */
+  const Uint8_t * txBuffer;                         /* Transmit data, NULL to transmit 0xFF */
+  Uint32_t dataCount;                               /* Data byte count */
+  Uint8_t * rxBuffer;                               /* Storage for received data, may be NULL */
+  Uint32_t bufferLength;                            /* Length of the receive buffer */
+  d_SPI_PL_TransactionCallback_t callback;          /* Completion callback, may be NULL */
+  Uint32_t tag;                                     /* Passed to the callback */
+  volatile d_SPI_PL_TransactionState_t state;       /* Completion token */
+  Uint32_t rxCount;                                 /* Received byte count */
+  struct d_SPI_PL_Transaction_t * pNext;            /* Next transaction of a chain, NULL at the end */
+}
+d_SPI_PL_Transaction_t;
+
 /***** Variables ********************************************************/
 
 /***** Function Declarations ********************************************/
@@ -65,6 +100,17 @@ d_Status_t d_SPI_PL_Result(const Uint32_t channel,
 d_Status_t d_SPI_PL_Status(const Uint32_t channel,
                            d_SPI_PL_State_t * const pStatus);
 
+/* Queue a transaction, or a chain of transactions linked by pNext */
+d_Status_t d_SPI_PL_Queue(const Uint32_t channel,
+                          d_SPI_PL_Transaction_t * const pTransaction);
+
+/* Complete the active transaction if the transfer has finished */
+d_Status_t d_SPI_PL_Poll(const Uint32_t channel);
+
+/* Remove a transaction from the queue */
+d_Status_t d_SPI_PL_Cancel(const Uint32_t channel,
+                           d_SPI_PL_Transaction_t * const pTransaction);
+
 /* Interrupt handler */
 void d_SPI_PL_InterruptHandler(const Uint32_t channel);
 
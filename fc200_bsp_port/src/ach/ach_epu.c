@@ -17,15 +17,18 @@
 #define ESC_RAW_CMD_SIGN ((unsigned long long)0x217F5C87D7EC951D) // Raw Command Signature
 #define ESC_RAW_ID (1030)                                         // RAW command ID
 #define SOLONE_CAN_ID (25)                                        // can bus master device ID
-#define ESC_1_STATUS_CAN_ID (0x18040A01U)
-#define ESC_8_STATUS_CAN_ID (0x18040A08U)
-#define NODE_ID_MASK (0x0FU)
+#define ESC_STATUS_DATA_TYPE (0x040AU)                 /* uavcan.equipment.esc.Status */
+#define DATA_TYPE_SHIFT (8U)
+#define DATA_TYPE_MASK (0xFFFFU)
+#define SERVICE_NOT_MESSAGE (0x80U)
+#define NODE_ID_MASK (0x7FU)
 #define TRANSFER_ID_MASK (0x1FU)
 #define TM_UAVCAN_TAIL_TOGGLE (1U << 5)         /* Bit 5 for Toggle */
 #define TM_UAVCAN_TAIL_START_TRANSFER (1U << 7) /* Bit 7 for Start of Transfer */
 #define TM_UAVCAN_TAIL_END_TRANSFER (1U << 6)   /* Bit 6 for End of Transfer */
 #define MAX_FRAMES_TO_READ (48U)                /* Max frames to read */
-#define MAX_SEQ_BUF_LEN (6U)                    /* Max sequence buffer length */
+#define RX_TRANSFERS_PER_NODE (2U)              /* Transfers reassembled at once per node */
+#define RX_TRANSFER_TIMEOUT_MS (20U)            /* Time allowed for all frames of a transfer */
 #define ESC_STATUS_TIMEOUT_MS (100U)            /* ESC status timeout in ms */
 #define CAN_EPU (CAN_CHANNEL_1)                 /* CAN channel for EPU */
 
@@ -70,35 +73,33 @@ typedef enum
     // LOWEST_PRIORITY = 0x1F,
 } can_priority_t;
 
-/* State machine states */
-typedef enum
+/**
+ * @brief Transfer being reassembled, keyed by data type and transfer ID
+ */
+typedef struct
 {
-
-    FIRST_FRAME = 0,
-    SECOND_FRAME = 1,
-    THIRD_FRAME = 2,
-    DECODE_STATUS = 3
-
-} e_esc_parse_state_t;
+    bool active;                              /* Frames of the transfer are being received */
+    uint16_t data_type;                       /* Data type ID of the transfer */
+    uint8_t transfer_id;                      /* Transfer ID from the tail byte */
+    uint8_t toggle;                           /* Toggle bit expected in the next frame */
+    uint8_t length;                           /* Payload bytes received */
+    uint16_t crc_expected;                    /* Transfer CRC carried by the first frame */
+    uint16_t crc;                             /* CRC of the signature and the payload received */
+    uint64_t start_ms;                        /* Time the first frame was received */
+    uint8_t payload[ESC_STATUS_PAYLOAD_SIZE]; /* Payload received */
+} s_esc_rx_transfer_t;
 
 /**
- * @brief State machine context
+ * @brief Reassembly context of a node
  */
 typedef struct
 {
-    e_esc_parse_state_t state; /* Current state of the deframing process */
-    bool is_success;           /* At least one valid set decoded */
-    uint8_t node_id;
-    uint32_t first_frame_can_id;              /* Message ID of first frame */
-    uint32_t transfer_id;                     /* Transfer ID for the current message */
-    can_msg_t frames[3];                      /* Store three frames */
-    uint16_t crc_esc_status;                  /* CRC value for ESC status */
-    uint8_t payload[ESC_STATUS_PAYLOAD_SIZE]; /* Extracted status payload */
-
-} s_esc_deframe_context_t;
-
-static s_esc_deframe_context_t EscStatusContext[MAX_ESCS] = {0}; /* Parsing State Machine Context */
-static can_msg_t CanRxBuffer[MAX_ESCS][MAX_SEQ_BUF_LEN] = {0};   /* CAN RX buffer for each ESC */
+    s_esc_rx_transfer_t transfer[RX_TRANSFERS_PER_NODE];
+    s_esc_rx_stats_t stats;
+} s_esc_rx_node_t;
+
+static s_esc_rx_node_t EscRx[MAX_ESCS] = {0}; /* Transfer reassembly per source node */
+static uint16_t EscStatusCrcSeed = 0U;        /* CRC of the ESC status data type signature */
 s_esc_status_frame_t EscStatus[MAX_ESCS] = {0};                  /* Array to hold ESC status frames */
 std_epu_cmd_t EscRawCmd;                                         /* Raw command structure for ESC */
 s_timer_data_t EscStatusMon[MAX_ESCS] = {0};                     /* Timer to monitor ESC status reception */
@@ -110,11 +111,14 @@ static void convertToRawThrottleData(const uint16_t *input, int count, uint8_t *
 static uint32_t createID_field(can_priority_t prio, uint16_t msg_id, uint8_t source_id);
 static uint8_t createTailbyte(bool tx_start, bool tx_end, bool toggle, uint8_t tf_id);
 static float convert_float16_to_float(uint16_t value);
-static void ach_epu_read_rx_can_frame(e_esc_id_t esc_idx);
-static bool ach_epu_verify_can_frame_sanity(uint32_t can_msg_id, uint8_t tail, e_esc_parse_state_t state);
+static void ach_epu_rx_frame(const can_msg_t *frame, uint64_t now_ms);
+static s_esc_rx_transfer_t *ach_epu_rx_find(s_esc_rx_node_t *node, uint16_t data_type, uint8_t transfer_id);
+static s_esc_rx_transfer_t *ach_epu_rx_alloc(s_esc_rx_node_t *node);
+static bool ach_epu_rx_append(s_esc_rx_transfer_t *transfer, const uint8_t *data, uint8_t len);
+static void ach_epu_rx_complete(e_esc_id_t esc_idx, s_esc_rx_transfer_t *transfer);
+static void ach_epu_rx_expire(e_esc_id_t esc_idx, uint64_t now_ms);
 static void ach_epu_raw_ctrl_cmd(const std_epu_cmd_t *motor);
 static void ach_epu_decode_esc_status(const uint8_t *payload, s_esc_status_frame_t *esc);
-static void ach_epu_can_buffer_update(void);
 
 /**
  * @brief Retrieves the latest valid ESC status for a specified ESC ID.
@@ -122,15 +126,15 @@ static void ach_epu_can_buffer_update(void);
  * Copies the most recently received and decoded EscStatusFrame for the given ESC ID
  * into the output structure, if available.
  *
- * @param[in]  esc_id The ESC identifier (range: 0..NUM_ESCS-1).
+ * @param[in]  esc_id The ESC node identifier (range: ESC_ID_1..ESC_ID_8).
  * @param[out] out    Pointer to EscStatusFrame structure to receive the data.
  */
 bool ach_get_epu_status(uint8_t esc_id, s_esc_status_frame_t *out)
 {
     bool is_valid = false;
 
-    /* Validate pointer and ESC ID range */
-    if ((out != NULL) && (esc_id < NUM_ESCS))
+    /* Validate pointer and ESC ID range, the status is held by node ID */
+    if ((out != NULL) && (esc_id >= ESC_ID_1) && (esc_id < MAX_ESCS))
     {
         /* Return the ESC status valid */
         if (EscStatus[esc_id].valid == true)
@@ -208,16 +212,25 @@ bool ach_epu_init(void)
         return false;
     }
 
-    /* Initialize all motor commands to zero */
+    /* Initialize all motor commands to zero, the commands are indexed from 0 */
+    for (uint8_t i = 0; i < NUM_ESCS; i++)
+    {
+        EscRawCmd.motor_cmd_cval[i] = 0.0f;
+    }
+
+    /* The status monitors are indexed by ESC ID, they start expired so that no
+    status is valid before the first transfer of its ESC is decoded */
     for (e_esc_id_t esc_idx = ESC_ID_1; esc_idx < MAX_ESCS; esc_idx++)
     {
-        EscRawCmd.motor_cmd_cval[esc_idx] = 0.0f;
         timer_start(&EscStatusMon[esc_idx], ESC_STATUS_TIMEOUT_MS);
+        EscStatusMon[esc_idx].state = TIMER_EXPIRED;
     }
 
-    util_memset(&EscStatusContext, 0, sizeof(EscStatusContext)); // Reset deframer context
-    util_memset(&EscStatus, 0, sizeof(EscStatus));               // Reset status content
-    util_memset(&CanRxBuffer, 0, sizeof(CanRxBuffer));           // Reset CAN RX buffer
+    util_memset(&EscRx, 0, sizeof(EscRx));         // Reset reassembly context and counters
+    util_memset(&EscStatus, 0, sizeof(EscStatus)); // Reset status content
+
+    /* The CRC of every ESC status transfer starts with the data type signature */
+    EscStatusCrcSeed = crcAddSignature(0xFFFFU, ESC_STATUS_SIGN);
 
     printf("Successfully opened CAN interface '%d'\n", CAN_EPU);
     return true; // All went well
@@ -235,14 +248,35 @@ void ach_cmd_epu_periodic(void)
     ach_epu_raw_ctrl_cmd(&EscRawCmd);
 }
 
+/**
+ * @brief Retrieves the transfer reassembly counters of an ESC node.
+ *
+ * @param[in]  esc_id The ESC node identifier (range: ESC_ID_1..ESC_ID_8).
+ * @param[out] out    Pointer to the structure to receive the counters.
+ *
+ * @return true if the ESC ID is valid and out is not NULL, false otherwise.
+ */
+bool ach_get_epu_rx_stats(uint8_t esc_id, s_esc_rx_stats_t *out)
+{
+    bool is_valid = false;
+
+    if ((out != NULL) && (esc_id >= ESC_ID_1) && (esc_id < MAX_ESCS))
+    {
+        *out = EscRx[esc_id].stats;
+        is_valid = true;
+    }
+
+    return is_valid;
+}
+
 /**
  * @brief Reads and processes periodic ESC (Electronic Speed Controller) status data from CAN bus
  *
  * This function performs a periodic read operation to update ESC status information by:
- * 1. Reading CAN frames and updating the CAN message buffer for all EPUs
- * 2. Processing CAN messages for each ESC in the system
+ * 1. Reading up to MAX_FRAMES_TO_READ CAN frames and passing each one straight to the
+ *    transfer reassembler
+ * 2. Abandoning transfers whose frames have not all arrived in time
  * 3. Validating the received ESC status data based on timeout monitoring
- * 4. Setting the validity flag for each ESC based on successful data reception
  *
  * The function iterates through all ESCs (ESC_ID_1 to MAX_ESCS) and marks each
  * ESC status as valid only if fresh data is received within the expected timeframe.
@@ -253,23 +287,27 @@ void ach_cmd_epu_periodic(void)
  *
  * @note This function should be called periodically to maintain up-to-date ESC status
  * @note ESC status validity is determined by the EscStatusMon timer for each ESC
- * @see ach_epu_can_buffer_update()
- * @see ach_epu_read_rx_can_frame()
+ * @see ach_epu_rx_frame()
  * @see timer_check_expiry()
  */
 void ach_epu_read_periodic(void)
 {
+    can_msg_t frame = {0};
+    uint16_t frame_count = 0U;
+    uint64_t now_ms = timer_get_system_time_ms();
 
-    /* Read the CAN frames and populate the CAN messages per EPU */
-    ach_epu_can_buffer_update();
+    /* Read Frames until MAX Frame limit to be read per cycle is met or it returns no new message */
+    while ((frame_count < MAX_FRAMES_TO_READ) && (can_read(CAN_EPU, &frame) == CAN_OK))
+    {
+        frame_count++;
+        /* Reassemble in place, the frame is not buffered */
+        ach_epu_rx_frame(&frame, now_ms);
+    }
 
     for (e_esc_id_t esc_idx = ESC_ID_1; esc_idx < MAX_ESCS; esc_idx++)
     {
-        /* Set the ESC status valid flag to false initially */
-        EscStatus[esc_idx].valid = false;
-
-        /* Process the CAN messages for each ESC */
-        ach_epu_read_rx_can_frame(esc_idx);
+        /* Drop transfers that did not complete in time */
+        ach_epu_rx_expire(esc_idx, now_ms);
 
         /* Check if a valid ESC status was decoded */
         if (timer_check_expiry(&EscStatusMon[esc_idx]) == false)
@@ -285,347 +323,233 @@ void ach_epu_read_periodic(void)
 }
 
 /**
- * @brief Updates the CAN buffer by reading incoming CAN messages and distributing them to ESC buffers
+ * @brief Adds a received CAN frame to the transfer it belongs to
  *
- * This function reads CAN frames from the EPU CAN interface up to a maximum limit per cycle
- * and distributes valid ESC status messages into their respective node buffers based on the
- * CAN message ID. The function continues reading until either the maximum frame limit is
- * reached or no new messages are available.
+ * Frames are matched to a transfer of their source node by data type and
+ * transfer ID, so interleaved transfers of different nodes, and up to
+ * RX_TRANSFERS_PER_NODE transfers of the same node, are reassembled
+ * together. The tail byte start, end and toggle bits are checked and the
+ * CRC is accumulated as each frame arrives.
  *
- * @details The function performs the following operations:
- *          - Reads CAN frames from CAN_EPU interface (up to MAX_FRAMES_TO_READ per cycle)
- *          - Validates received messages against ESC status CAN ID range
- *          - Extracts node ID from CAN message ID using NODE_ID_MASK
- *          - Stores valid messages in CanRxBuffer based on node ID
- *          - Uses first-available slot strategy for buffer storage
+ * Frame handling:
+ * - Start of transfer: opens a transfer, taking the CRC from the first two bytes
+ * - Continuation: appended if the toggle bit alternates, otherwise the transfer is dropped
+ * - End of transfer: the length and CRC are checked and the ESC status decoded
  *
- * @note Only CAN messages with IDs in the range [ESC_1_STATUS_CAN_ID, ESC_8_STATUS_CAN_ID]
- *       and node IDs in the range [ESC_ID_1, ESC_ID_8] are processed and stored
- *
- * @note The function uses DLC field of 0 to identify empty buffer slots
- *
- * @param None
- * @return None
+ * @param[in] frame  Received CAN frame
+ * @param[in] now_ms System time in milliseconds
  */
-static void ach_epu_can_buffer_update(void)
+static void ach_epu_rx_frame(const can_msg_t *frame, uint64_t now_ms)
 {
-    can_status_t can_read_status = CAN_OK;
-    uint16_t frame_count = 0U;
-    can_msg_t can_rx_msg[MAX_FRAMES_TO_READ] = {0};
-
-    /* Read Frames until MAX Frame limit to be read per cycle is met or it returns no new message */
-    while ((frame_count < MAX_FRAMES_TO_READ) && (can_read_status == CAN_OK))
+    uint16_t data_type = (uint16_t)((frame->can_msg_id >> DATA_TYPE_SHIFT) & DATA_TYPE_MASK);
+    uint8_t node_id = (uint8_t)(frame->can_msg_id & NODE_ID_MASK);
+    bool is_service = ((frame->can_msg_id & SERVICE_NOT_MESSAGE) != 0U);
+
+    /* Only ESC status messages from the ESC nodes are reassembled */
+    if ((frame->extended_id_flag == true) && (frame->dlc >= 1U) && (frame->dlc <= CAN_FRAME_SIZE) &&
+        (data_type == ESC_STATUS_DATA_TYPE) && (is_service == false) &&
+        (node_id >= ESC_ID_1) && (node_id <= ESC_ID_8))
     {
-        /* Read the CAN Frame */
-        can_read_status = can_read(CAN_EPU, &can_rx_msg[frame_count]);
-        /* Check if read was successful */
-        if (can_read_status == CAN_OK)
-        {
-            /* Increment frame count */
-            frame_count++;
-            /* Determine the Node ID from the CAN message ID */
-        }
-    }
+        s_esc_rx_node_t *node = &EscRx[node_id];
+        uint8_t tail = frame->data[frame->dlc - 1U];
+        uint8_t transfer_id = tail & TRANSFER_ID_MASK;
+        uint8_t len = frame->dlc - 1U;
+        uint8_t toggle = ((tail & TM_UAVCAN_TAIL_TOGGLE) != 0U) ? 1U : 0U;
+        s_esc_rx_transfer_t *transfer = ach_epu_rx_find(node, data_type, transfer_id);
 
-    /* Distribute the read CAN messages into the respective ESC buffers based on Node ID */
-    for (uint16_t i = 0U; i < frame_count; i++)
-    {
-        /* Check if the received message is valid */
-        if ((can_rx_msg[i].can_msg_id >= ESC_1_STATUS_CAN_ID) &&
-            (can_rx_msg[i].can_msg_id <= ESC_8_STATUS_CAN_ID))
+        node->stats.frames++;
+
+        if ((tail & TM_UAVCAN_TAIL_START_TRANSFER) != 0U)
         {
-            /* Extract the node id */
-            uint8_t node_id = (uint8_t)(can_rx_msg[i].can_msg_id & NODE_ID_MASK);
+            if (transfer != NULL)
+            {
+                /* Restarted before the end of the previous transfer with the same ID */
+                node->stats.out_of_order++;
+            }
+            else
+            {
+                transfer = ach_epu_rx_alloc(node);
+            }
 
-            /* if node_id is within valid range */
-            if (node_id >= ESC_ID_1 && node_id <= ESC_ID_8)
+            if (((tail & TM_UAVCAN_TAIL_END_TRANSFER) != 0U) || (toggle != 0U) || (len < 2U))
             {
-                /* Find the next available slot in the ESC's CAN buffer */
-                for (uint8_t j = 0U; j < MAX_SEQ_BUF_LEN; j++)
+                /* ESC status is always a multi-frame transfer, starting with toggle clear */
+                node->stats.out_of_order++;
+                transfer->active = false;
+            }
+            else
+            {
+                transfer->active = true;
+                transfer->data_type = data_type;
+                transfer->transfer_id = transfer_id;
+                transfer->toggle = 0U;
+                transfer->length = 0U;
+                transfer->start_ms = now_ms;
+                transfer->crc_expected = (uint16_t)((uint16_t)frame->data[0] | (uint16_t)((uint16_t)frame->data[1] << 8));
+                transfer->crc = EscStatusCrcSeed;
+
+                if (ach_epu_rx_append(transfer, &frame->data[2], len - 2U) == false)
                 {
-                    if (CanRxBuffer[node_id][j].dlc == 0U)
-                    {
-                        /* Store the CAN message in the buffer */
-                        util_memcpy(&CanRxBuffer[node_id][j], &can_rx_msg[i], sizeof(can_msg_t));
-                        j = MAX_SEQ_BUF_LEN - 1; /* Exit the loop after storing */
-                    }
+                    node->stats.dropped++;
+                    transfer->active = false;
                 }
             }
         }
+        else if (transfer == NULL)
+        {
+            /* Continuation of a transfer that was never started or already closed */
+            node->stats.out_of_order++;
+        }
+        else if (toggle != transfer->toggle)
+        {
+            /* Missing or repeated frame */
+            node->stats.out_of_order++;
+            transfer->active = false;
+        }
+        else if (ach_epu_rx_append(transfer, &frame->data[0], len) == false)
+        {
+            node->stats.dropped++;
+            transfer->active = false;
+        }
+        else if ((tail & TM_UAVCAN_TAIL_END_TRANSFER) != 0U)
+        {
+            ach_epu_rx_complete((e_esc_id_t)node_id, transfer);
+        }
+        else
+        {
+            /* Wait for the next frame */
+        }
     }
 }
 
 /**
- * @brief Reads and processes CAN frames from the receive buffer for ESC status messages
- *
- * This function implements a state machine to deframe multi-frame CAN messages containing
- * ESC (Electronic Speed Controller) status data. It processes up to MAX_SEQ_BUF_LEN frames
- * from the CAN receive buffer, validates frame integrity, reconstructs the payload across
- * multiple frames, and decodes the final ESC status.
- *
- * State Machine Flow:
- * - FIRST_FRAME: Initializes context, extracts CRC and first payload bytes
- * - SECOND_FRAME: Validates continuity and extracts additional payload bytes
- * - THIRD_FRAME: Completes payload reconstruction and validates CRC
- * - DECODE_STATUS: Decodes final ESC status and resets state machine
- *
- * Frame Validation:
- * - Verifies CAN message ID consistency across frames
- * - Validates transfer ID matches across all frames
- * - Performs CRC validation on complete payload
- * - Checks frame sanity using dedicated validation function
+ * @brief Finds the transfer of a node in progress with the given key
  *
- * @param esc_idx ESC index identifying which ESC controller's CAN buffer to process
+ * @param[in] node        Reassembly context of the source node
+ * @param[in] data_type   Data type ID
+ * @param[in] transfer_id Transfer ID
  *
- * @note This function modifies global state including:
- *       - EscStatusContext[esc_idx]: State machine context and frame data
- *       - EscStatus[esc_idx]: Decoded ESC status data
- *       - EscStatusMon[esc_idx]: Timer for status monitoring
- *       - CanRxBuffer[esc_idx]: CAN receive buffer (cleared after processing)
- *
- * @warning Function assumes esc_idx is valid and within array bounds
- * @warning Function processes frames sequentially and clears buffer slots after use
+ * @return Pointer to the transfer, NULL if there is none in progress
  */
-static void ach_epu_read_rx_can_frame(e_esc_id_t esc_idx)
+static s_esc_rx_transfer_t *ach_epu_rx_find(s_esc_rx_node_t *node, uint16_t data_type, uint8_t transfer_id)
 {
-    bool is_valid = true;
-    uint16_t frame_count = 0U;
-    uint8_t tail = 0;
+    s_esc_rx_transfer_t *found = NULL;
 
-    while (frame_count < MAX_SEQ_BUF_LEN)
+    for (uint8_t i = 0U; i < RX_TRANSFERS_PER_NODE; i++)
     {
-        if (CanRxBuffer[esc_idx][frame_count].dlc != 0U)
+        if ((node->transfer[i].active == true) && (node->transfer[i].data_type == data_type) &&
+            (node->transfer[i].transfer_id == transfer_id))
         {
-            /* Run the state machine to deframe CAN messages */
-            switch (EscStatusContext[esc_idx].state)
-            {
-            case FIRST_FRAME:
-            {
-                /* Initialize the validity flag */
-                is_valid = true;
-                /* Reset the first frame MSG ID */
-                EscStatusContext[esc_idx].first_frame_can_id = 0U;
-                /* Initialize the esc status payload to 0 without using memset */
-                util_memset(EscStatusContext[esc_idx].payload, 0, ESC_STATUS_PAYLOAD_SIZE);
-                /* Reset the CRC for ESC status */
-                EscStatusContext[esc_idx].crc_esc_status = 0U;
-                EscStatusContext[esc_idx].is_success = false;
-                EscStatusContext[esc_idx].first_frame_can_id = 0U;
-
-                /* Read the CAN RX Buffer */
-                EscStatusContext[esc_idx].frames[FIRST_FRAME] = CanRxBuffer[esc_idx][frame_count];
-
-                /* Check if the DLC is non-zero */
-                if ((EscStatusContext[esc_idx].frames[FIRST_FRAME].dlc >= 1U))
-                {
-                    /* extract the tail byte */
-                    tail = EscStatusContext[esc_idx].frames[FIRST_FRAME].data[EscStatusContext[esc_idx].frames[FIRST_FRAME].dlc - 1U];
-                    /* Verify CAN frame is correct */
-                    is_valid = ach_epu_verify_can_frame_sanity(EscStatusContext[esc_idx].frames[FIRST_FRAME].can_msg_id, tail, EscStatusContext[esc_idx].state);
-                    /* Check if the message ID is valid */
-                    if (is_valid)
-                    {
-                        /* Get the Node ID */
-                        EscStatusContext[esc_idx].node_id = (uint8_t)(EscStatusContext[esc_idx].frames[FIRST_FRAME].can_msg_id & NODE_ID_MASK);
-                        /* Reset the ESC Status for the particular Node ID to FALSE */
-                        // EscStatus[EscStatusContext.node_id].valid = false;
-                        /* Store the first frame Message ID */
-                        EscStatusContext[esc_idx].first_frame_can_id = EscStatusContext[esc_idx].frames[FIRST_FRAME].can_msg_id;
-                        /* Get the transfer ID */
-                        EscStatusContext[esc_idx].transfer_id = tail & TRANSFER_ID_MASK;
-                        /* Get the CRC */
-                        EscStatusContext[esc_idx].crc_esc_status = (uint16_t)((uint16_t)(EscStatusContext[esc_idx].frames[FIRST_FRAME].data[0]) |
-                                                                              (uint16_t)(EscStatusContext[esc_idx].frames[FIRST_FRAME].data[1] << 8));
-                        /* Store the first byte of the payload */
-                        util_memcpy(&EscStatusContext[esc_idx].payload[0], &EscStatusContext[esc_idx].frames[FIRST_FRAME].data[2], 5U * (sizeof(uint8_t)));
-                        /* Advance to the next state */
-                        EscStatusContext[esc_idx].state = SECOND_FRAME;
-                    }
-                    else
-                    {
-                        EscStatusContext[esc_idx].state = FIRST_FRAME;
-                    }
-                }
-                break;
-            }
-
-            case SECOND_FRAME:
-            {
-                /* Sequential checks for second frame */
-                is_valid = true;
-                /* Read the second consecutive frame from the CAN RX Buffer*/
-                EscStatusContext[esc_idx].frames[SECOND_FRAME] = CanRxBuffer[esc_idx][frame_count];
-
-                /* Check if the DLC is non-zero */
-                if ((EscStatusContext[esc_idx].frames[SECOND_FRAME].dlc >= 1U))
-                {
-                    /* extract the tail byte */
-                    tail = EscStatusContext[esc_idx].frames[SECOND_FRAME].data[EscStatusContext[esc_idx].frames[SECOND_FRAME].dlc - 1U];
-                    /* Verify CAN frame is correct */
-                    is_valid = ach_epu_verify_can_frame_sanity(EscStatusContext[esc_idx].frames[SECOND_FRAME].can_msg_id, tail, EscStatusContext[esc_idx].state);
-                    /* Check if the message ID is equal to previous message ID */
-                    is_valid &= (EscStatusContext[esc_idx].frames[SECOND_FRAME].can_msg_id == EscStatusContext[esc_idx].first_frame_can_id);
-                    /* Check if the transfer ID matches */
-                    is_valid &= (EscStatusContext[esc_idx].transfer_id == (tail & 0x1FU));
-                    /* if all the checks above are valid */
-                    if (is_valid)
-                    {
-                        /* Advance to the next state */
-                        EscStatusContext[esc_idx].state = THIRD_FRAME;
-                        /* Store the fifth byte of the payload */
-                        util_memcpy(&EscStatusContext[esc_idx].payload[5], &EscStatusContext[esc_idx].frames[SECOND_FRAME].data[0], 7U * (sizeof(uint8_t)));
-                    }
-                    else
-                    {
-                        /* Reset state to first frame */
-                        EscStatusContext[esc_idx].state = FIRST_FRAME;
-                    }
-                }
-                break;
-            }
-
-            case THIRD_FRAME:
-            {
-                /* Sequential checks for third frame */
-                is_valid = true;
-                /* Read the third consecutive frame */
-                EscStatusContext[esc_idx].frames[THIRD_FRAME] = CanRxBuffer[esc_idx][frame_count];
-
-                /* Check if the DLC is non-zero */
-                if ((EscStatusContext[esc_idx].frames[THIRD_FRAME].dlc >= 1U))
-                {
-                    /* extract the tail byte */
-                    tail = EscStatusContext[esc_idx].frames[THIRD_FRAME].data[EscStatusContext[esc_idx].frames[THIRD_FRAME].dlc - 1U];
-                    /* Verify CAN frame is correct */
-                    is_valid = ach_epu_verify_can_frame_sanity(EscStatusContext[esc_idx].frames[THIRD_FRAME].can_msg_id, tail, EscStatusContext[esc_idx].state);
-                    /* Check if the message ID is equal to previous message ID */
-                    is_valid &= (EscStatusContext[esc_idx].frames[THIRD_FRAME].can_msg_id == EscStatusContext[esc_idx].first_frame_can_id);
-                    /* Check if the transfer ID matches */
-                    is_valid &= (EscStatusContext[esc_idx].transfer_id == (tail & 0x1FU));
-                    /* if all the checks above are valid */
-                    if (is_valid)
-                    {
-                        /* Store number of relevant bytes received in the third frame */
-                        util_memcpy(&EscStatusContext[esc_idx].payload[12], &EscStatusContext[esc_idx].frames[THIRD_FRAME].data[0], 2U * (sizeof(uint8_t)));
-                        /* Calculate the CRC for the ESC status */
-                        uint16_t SignCrc = crcAddSignature(0xFFFFU, ESC_STATUS_SIGN);
-                        uint16_t CrC_encoded = crcAdd(SignCrc, &EscStatusContext[esc_idx].payload[0], 14);
-
-                        /* Check if the CRC matches */
-                        if (CrC_encoded == EscStatusContext[esc_idx].crc_esc_status)
-                        {
-                            EscStatusContext[esc_idx].is_success = true;
-                        }
-                    }
-                }
-                /* If the frame is valid, advance to decode state */
-                if (EscStatusContext[esc_idx].is_success == true)
-                {
-                    /* Advance to decode state */
-                    EscStatusContext[esc_idx].state = DECODE_STATUS;
-                }
-                else
-                {
-                    /* Reset state to first frame  */
-                    EscStatusContext[esc_idx].state = FIRST_FRAME;
-                    EscStatusContext[esc_idx].first_frame_can_id = 0U;
-                }
-            }
-            break;
-
-            case DECODE_STATUS:
-            {
-                /* Decode the ESC status payload */
-                ach_epu_decode_esc_status(EscStatusContext[esc_idx].payload, &EscStatus[esc_idx]);
-                /* Reload the timer upon successful parsing */
-                timer_reload(&EscStatusMon[esc_idx]);
-
-                /* Reset the state to FIRST_FRAME */
-                EscStatusContext[esc_idx].state = FIRST_FRAME;
-                EscStatusContext[esc_idx].first_frame_can_id = 0U;
-                EscStatusContext[esc_idx].is_success = false;
+            found = &node->transfer[i];
+        }
+    }
 
-                break;
-            }
+    return found;
+}
 
-            default:
-            {
-                EscStatusContext[esc_idx].state = FIRST_FRAME;
-                EscStatusContext[esc_idx].first_frame_can_id = 0U;
-                break;
-            }
-            }
+/**
+ * @brief Allocates a transfer slot of a node for a new transfer
+ *
+ * A free slot is used if there is one, otherwise the oldest transfer in
+ * progress is dropped to make room.
+ *
+ * @param[in] node Reassembly context of the source node
+ *
+ * @return Pointer to the transfer slot
+ */
+static s_esc_rx_transfer_t *ach_epu_rx_alloc(s_esc_rx_node_t *node)
+{
+    s_esc_rx_transfer_t *slot = &node->transfer[0];
 
-            /* Clear the CAN message slot */
-            util_memset(&CanRxBuffer[esc_idx][frame_count], 0, sizeof(can_msg_t));
+    for (uint8_t i = 1U; i < RX_TRANSFERS_PER_NODE; i++)
+    {
+        if ((slot->active == true) &&
+            ((node->transfer[i].active == false) || (node->transfer[i].start_ms < slot->start_ms)))
+        {
+            slot = &node->transfer[i];
         }
+    }
 
-        frame_count++;
+    if (slot->active == true)
+    {
+        node->stats.dropped++;
+        slot->active = false;
     }
+
+    return slot;
 }
 
 /**
- * @brief Verifies the sanity of a CAN frame based on its message ID, tail byte, and parsing state.
- *
- * This function checks if the provided CAN message ID falls within the expected range for ESC status messages.
- * It also validates the tail byte according to the current frame's parsing state (first, second, or third frame)
- * by inspecting the start of transfer, end of transfer, and toggle bits as per the multi-frame transfer protocol.
+ * @brief Appends payload bytes of a frame to a transfer and updates its CRC
  *
- * @param can_msg_id  The CAN message ID to verify.
- * @param tail        The tail byte containing transfer control bits.
- * @param state       The current parsing state (e.g., FIRST_FRAME, SECOND_FRAME, THIRD_FRAME).
+ * @param[in,out] transfer Transfer in progress
+ * @param[in]     data     Payload bytes of the frame, without the tail byte
+ * @param[in]     len      Number of payload bytes
  *
- * @return true if the CAN frame is valid and meets all protocol requirements for the given state, false otherwise.
+ * @return false if the payload would exceed the ESC status size, true otherwise
  */
-static bool ach_epu_verify_can_frame_sanity(uint32_t can_msg_id, uint8_t tail, e_esc_parse_state_t state)
+static bool ach_epu_rx_append(s_esc_rx_transfer_t *transfer, const uint8_t *data, uint8_t len)
 {
-    /* Check validity */
-    bool is_valid = true;
+    bool is_ok = false;
 
-    /* Check if the CAN message ID is in the expected range */
-    is_valid &= ((can_msg_id >= ESC_1_STATUS_CAN_ID) &&
-                 (can_msg_id <= ESC_8_STATUS_CAN_ID));
-
-    /*
-      Check for the following tail byte characteristics:
+    if (((uint16_t)transfer->length + len) <= ESC_STATUS_PAYLOAD_SIZE)
+    {
+        util_memcpy(&transfer->payload[transfer->length], data, len);
+        transfer->crc = crcAdd(transfer->crc, data, (size_t)len);
+        transfer->length = (uint8_t)(transfer->length + len);
+        transfer->toggle ^= 1U;
+        is_ok = true;
+    }
 
-       1. For Multi frame transfer, the start of tx bit is 1 if the current frame
-          is the first frame of the packet, and 0 otherwise.
+    return is_ok;
+}
 
-       2. For Multi frame transfer, the end of tx bit is 1 if the current frame is the
-          last frame of the packet, and 0 otherwise.
+/**
+ * @brief Checks a transfer whose last frame has arrived and decodes the ESC status
+ *
+ * @param[in]     esc_idx  ESC node the transfer came from
+ * @param[in,out] transfer Completed transfer, released on return
+ */
+static void ach_epu_rx_complete(e_esc_id_t esc_idx, s_esc_rx_transfer_t *transfer)
+{
+    if (transfer->length != ESC_STATUS_PAYLOAD_SIZE)
+    {
+        EscRx[esc_idx].stats.dropped++;
+    }
+    else if (transfer->crc != transfer->crc_expected)
+    {
+        EscRx[esc_idx].stats.crc_errors++;
+    }
+    else
+    {
+        /* Decode the ESC status payload */
+        ach_epu_decode_esc_status(transfer->payload, &EscStatus[esc_idx]);
+        /* Reload the timer upon successful parsing */
+        timer_reload(&EscStatusMon[esc_idx]);
+        EscRx[esc_idx].stats.transfers++;
+    }
 
-       3. For Multi frame transfer, the Toggle bit is 0 for the first frame
-          of the packet and is flipped once for each subsequent frame
-    */
+    transfer->active = false;
+}
 
-    if (is_valid == true)
+/**
+ * @brief Drops the transfers of a node that have not completed in time
+ *
+ * @param[in] esc_idx ESC node
+ * @param[in] now_ms  System time in milliseconds
+ */
+static void ach_epu_rx_expire(e_esc_id_t esc_idx, uint64_t now_ms)
+{
+    for (uint8_t i = 0U; i < RX_TRANSFERS_PER_NODE; i++)
     {
-        /* Check if the CAN message ID is valid for the first frame */
-        if (state == FIRST_FRAME)
-        {
-            /* inspect first frame */
-            is_valid &= ((tail & TM_UAVCAN_TAIL_START_TRANSFER) != 0U) &&
-                        ((tail & TM_UAVCAN_TAIL_END_TRANSFER) == 0U) &&
-                        ((tail & TM_UAVCAN_TAIL_TOGGLE) == 0U);
-        }
-        else if (state == SECOND_FRAME)
-        {
-            /* inspect second frame */
-            is_valid &= ((tail & TM_UAVCAN_TAIL_START_TRANSFER) == 0U) &&
-                        ((tail & TM_UAVCAN_TAIL_END_TRANSFER) == 0U) &&
-                        ((tail & TM_UAVCAN_TAIL_TOGGLE) != 0U);
-        }
-        else if (state == THIRD_FRAME)
+        s_esc_rx_transfer_t *transfer = &EscRx[esc_idx].transfer[i];
+
+        if ((transfer->active == true) && ((now_ms - transfer->start_ms) > RX_TRANSFER_TIMEOUT_MS))
         {
-            /* inspect second frame */
-            is_valid &= ((tail & TM_UAVCAN_TAIL_START_TRANSFER) == 0U) &&
-                        ((tail & TM_UAVCAN_TAIL_END_TRANSFER) != 0U) &&
-                        ((tail & TM_UAVCAN_TAIL_TOGGLE) == 0U);
+            EscRx[esc_idx].stats.timeouts++;
+            transfer->active = false;
         }
     }
-
-    return is_valid;
 }
 
 /**
@@ -25,14 +25,20 @@ float ach_get_servo_pos_deg(e_servo_positions_t servo_id);
 bool ach_get_servo_lv_alarm(e_servo_positions_t servo_id);
 void ach_get_servo_device_status(e_servo_positions_t servo_id, float *current, float *temperature);
 
+/* Servo Bus Scheduler Interface Functions */
+bool ach_servo_bus_background(void);
+void ach_get_servo_bus_stats(servo_bus_stats_t *stats);
+bool ach_get_servo_latency(e_servo_positions_t servo_id, servo_latency_t *latency);
+
 /*--------------------------EPU Interface Functions-----------------------------------*/
 /* EPU Command Interface Function */
 void ach_set_epu_cmd(const std_epu_cmd_t *epu_cmd);
 
 /* EPU Status Interface Function */
 bool ach_get_epu_status(uint8_t esc_id, s_esc_status_frame_t *out);
+bool ach_get_epu_rx_stats(uint8_t esc_id, s_esc_rx_stats_t *out);
 
 /*-------------------------Pusher Interface Functions---------------------------------*/
-void ach_set_pusher_pwm(double duty_cycle);
+void ach_set_pusher_pwm(uint16_t duty_cycle_us);
 
 #endif /*!defined(EA_4959470C_1200_470f_9174_EF9362C24B05__INCLUDED_)*/
@@ -9,10 +9,10 @@
 #include "pwm_interface.h"
 #include "gpio_interface.h"
 
-#define PWM_MIN (1000.0f) /*Minimum PWM in usec value for the pusher*/
-#define PWM_MAX (2000.0f) /*Maximum PWM in usec value for the pusher*/
+#define PWM_MIN (1000U) /*Minimum PWM in usec value for the pusher*/
+#define PWM_MAX (2000U) /*Maximum PWM in usec value for the pusher*/
 
-static double DutyCycle_uSec = 0.0f; /*Variable to hold the PWM duty cycle for the pusher*/
+static uint16_t DutyCycle_uSec = PWM_MIN; /*Variable to hold the PWM duty cycle for the pusher*/
 
 /**
  * @brief Initializes the pusher mechanism by configuring and initializing its PWM.
@@ -36,6 +36,9 @@ bool ach_pusher_init(void)
 	/* Configure the PWM For Pusher*/
 	config_status = pwm_configure(GPIO_PUSHER_PWM, PWM_AF_FREQ);
 
+	/* Start the pusher at minimum PWM so it remains inactive (prevents beeping) */
+	init_pwm_status = pwm_set(GPIO_PUSHER_PWM, PWM_MIN) && pwm_commit();
+
 	/* check if configuration and initialization is successful */
 	if ((config_status) && (init_pwm_status))
 	{
@@ -58,10 +61,9 @@ bool ach_pusher_init(void)
  * This function clamps the input duty cycle to the allowed PWM range defined by
  * PWM_MIN and PWM_MAX, then sets the PWM output on the GPIO_PUSHER_PWM pin.
  *
- * @param duty_cycle_us The desired PWM duty cycle in microseconds as a double.
- * @return true if the PWM was set successfully, false otherwise.
+ * @param duty_cycle_us The desired PWM duty cycle in microseconds.
  */
-void ach_set_pusher_pwm(double duty_cycle_us)
+void ach_set_pusher_pwm(uint16_t duty_cycle_us)
 {
 	/* Clamp the PWM Output */
 	if (duty_cycle_us < PWM_MIN)
@@ -81,11 +83,11 @@ void ach_set_pusher_pwm(double duty_cycle_us)
 /**
  * @brief Sets the PWM duty cycle for the pusher in periodic mode.
  *
- * This function configures the PWM output on the pusher's GPIO pin
- * using the specified duty cycle. It is intended to be called periodically
- * to update or maintain the pusher's state.
+ * This function queues the PWM output on the pusher's GPIO pin using the
+ * specified duty cycle. The output is written with the other PWM outputs by
+ * pwm_commit() later in the frame, and only if it has changed.
  *
- * @return true if the PWM was set successfully, false otherwise.
+ * @return true if the PWM was queued successfully, false otherwise.
  */
 bool ach_cmd_pusher_periodic(void)
 {
@@ -9,6 +9,7 @@
 #include "uart_interface.h"
 #include "timer_interface.h"
 #include "generic_util.h"
+#include "soc/timer/d_timer.h"
 
 #define EPS (0.00001f)
 #define MAX_CONFIGURED_SERVO (10)
@@ -21,6 +22,18 @@
 #define COMBINE_BYTES(lowByte, highByte) \
 	((int16_t)(((uint16_t)(highByte) << 8) | ((uint16_t)(lowByte))))
 
+/* Servo bus scheduler */
+#define SERVO_BITS_PER_BYTE (10U)		/* start bit, 8 data bits and stop bit */
+#define SERVO_GAP_BYTES (1U)			/* idle time between frames for the transceiver turnaround */
+#define SERVO_REPLY_DELAY_US (100U)		/* KST response time from the end of a request to the reply */
+#define SERVO_BUS_LOAD_PCT (80U)		/* share of the frame period allocated to the servo bus */
+#define SERVO_CMD_DEADBAND (1)			/* change in 0.1 deg steps below which a command is not resent */
+#define SERVO_CMD_REFRESH_FRAMES (10U)	/* frames after which an unchanged command is resent */
+#define SERVO_STATUS_POLL_EVERY (4U)	/* every 4th poll slot requests the device status */
+#define SERVO_MAX_POLL_SLOTS (16U)
+#define SERVO_PRIMARY_COUNT (6U)		/* leading entries of ServoPriority that are primary surfaces */
+#define SERVO_POSITION_POLL_SEQ_LEN (16U)
+
 typedef enum
 {
 
@@ -50,6 +63,48 @@ typedef union
 	} d;
 } convertor_t;
 
+typedef struct
+{
+	e_servo_positions_t id;
+	ach_servo_kst_cmd_codes_t cmd_code; /* KST_CMD_GET_POSITION or KST_CMD_DEVICE_STATUS */
+} servo_poll_slot_t;
+
+typedef struct
+{
+	e_servo_positions_t id;
+	float position_deg; /* range checked position command */
+} servo_cmd_slot_t;
+
+typedef struct
+{
+	uint32_t baud_rate;
+	uint32_t budget_bytes;		/* bus bytes available in a frame */
+	uint32_t cmd_bytes;			/* cost of a command slot */
+	uint32_t poll_bytes;		/* cost of a poll slot: request, reply delay and reply */
+	servo_cmd_slot_t cmd[MAX_CONFIGURED_SERVO];
+	uint8_t cmd_count;			/* command slots waiting for the bus */
+	servo_poll_slot_t poll[SERVO_MAX_POLL_SLOTS];
+	uint8_t poll_count;			/* poll slots planned in the frame */
+	uint8_t poll_next;			/* next poll slot to send */
+	bool poll_active;			/* a poll is waiting for its reply */
+	servo_poll_slot_t active;	/* slot of the active poll */
+	uint32_t poll_start;		/* timer ticks when the active poll was sent */
+	uint32_t poll_window_us;	/* reply window of the active poll */
+	uint32_t poll_backlog_us;	/* transmit time queued ahead of the active poll */
+	uint32_t backlog_us;		/* transmit time of the commands queued ahead of the next poll */
+	uint32_t frame_bytes;		/* bus bytes allocated in the frame */
+	uint8_t position_seq;		/* index into ServoPositionPollSeq */
+	uint8_t status_seq;			/* index into ServoPriority for status polls */
+	uint32_t poll_seq;			/* poll slots planned since initialisation */
+} servo_bus_t;
+
+typedef struct
+{
+	int16_t last_cmd; /* last position command sent [0.1 deg] */
+	uint32_t age;	  /* frames since the last command was sent */
+	bool sent;		  /* a command has been sent since initialisation */
+} servo_cmd_state_t;
+
 const servo_range_lim_t ServoRangeCheck[MAX_CNTRL_SURFACE] =
 	{{0.0f, 0.0f, false},
 	 {0.0f, 0.0f, false},
@@ -75,6 +130,42 @@ static void ach_cmd_servo_pos_deg(e_servo_positions_t servo_id, float position_d
 static void ach_cmd_req_servo_pos(e_servo_positions_t servo_id);
 static void ach_cmd_req_servo_status(e_servo_positions_t servo_id);
 static void ach_servo_command_msg(e_servo_positions_t servo_id, ach_servo_kst_cmd_codes_t cmd_code, const uint8_t *data);
+static uint32_t ach_servo_bytes_to_us(uint32_t bytes);
+static void ach_servo_plan_commands(void);
+static void ach_servo_plan_polls(void);
+static bool ach_servo_bus_service(void);
+static void ach_servo_receive(void);
+static void ach_servo_poll_complete(bool replied);
+
+/* Servos in command priority order, the primary flight control surfaces first */
+static const e_servo_positions_t ServoPriority[MAX_CONFIGURED_SERVO] = {ELEVATOR_LH,
+																		ELEVATOR_RH,
+																		RUDDER_LH,
+																		RUDDER_RH,
+																		FLAPERON_OUTER_LH,
+																		FLAPERON_OUTER_RH,
+																		FLAPERON_INNER_LH,
+																		FLAPERON_INNER_RH,
+																		FLAP_LH,
+																		FLAP_RH};
+
+/* Position poll sequence, the primary surfaces are polled twice as often */
+static const e_servo_positions_t ServoPositionPollSeq[SERVO_POSITION_POLL_SEQ_LEN] = {ELEVATOR_LH,
+																					  RUDDER_LH,
+																					  FLAPERON_OUTER_LH,
+																					  FLAPERON_INNER_LH,
+																					  ELEVATOR_RH,
+																					  RUDDER_RH,
+																					  FLAPERON_OUTER_RH,
+																					  FLAPERON_INNER_RH,
+																					  ELEVATOR_LH,
+																					  RUDDER_LH,
+																					  FLAPERON_OUTER_LH,
+																					  FLAP_LH,
+																					  ELEVATOR_RH,
+																					  RUDDER_RH,
+																					  FLAPERON_OUTER_RH,
+																					  FLAP_RH};
 
 static servo_s Servo[MAX_CONTROL_SURFACE];
 static std_servo_cmd_t ServoCmd = {0};
@@ -83,6 +174,11 @@ static uint8_t ServoRxPacket[SERVO_BUFFER_SIZE] = {0};
 static s_timer_data_t LowVoltageTimer;
 static e_servo_positions_t ServoLowVoltFaultId = MAX_CNTRL_SURFACE;
 static bool servo_test_in_progress = false;
+static servo_bus_t ServoBus = {0};
+static servo_cmd_state_t ServoCmdState[MAX_CONTROL_SURFACE] = {0};
+static servo_bus_stats_t ServoBusStats = {0};
+static servo_latency_t ServoLatency[MAX_CONTROL_SURFACE] = {0};
+static uint64_t ServoLatencyTotal[MAX_CONTROL_SURFACE] = {0};
 
 /**
  * @brief Retrieves the current position (in degrees) of the specified servo.
@@ -256,6 +352,22 @@ bool ach_servo_init(void)
 	/* Initialize the Low Voltage Timer */
 	timer_reset(&LowVoltageTimer);
 
+	/* Size the slots of a bus frame from the configured baud rate */
+	ServoBus.baud_rate = uart_get_baud_rate(UART_SERVO);
+	ServoBus.budget_bytes = ((ServoBus.baud_rate / SERVO_BITS_PER_BYTE / ACH_SERVO_FRAME_HZ) * SERVO_BUS_LOAD_PCT) / 100U;
+	ServoBus.cmd_bytes = BYTES_PER_MSG + SERVO_GAP_BYTES;
+	ServoBus.poll_bytes = (2U * BYTES_PER_MSG) + SERVO_GAP_BYTES +
+						  (uint32_t)((((uint64_t)SERVO_REPLY_DELAY_US * ServoBus.baud_rate) + ((SERVO_BITS_PER_BYTE * 1000000U) - 1U)) /
+									 (SERVO_BITS_PER_BYTE * 1000000U));
+	ServoBusStats.budget_bytes = ServoBus.budget_bytes;
+
+	for (int i = 0; i < MAX_CONTROL_SURFACE; i++)
+	{
+		ServoCmdState[i].sent = false;
+		ServoCmdState[i].age = 0U;
+		ServoLatency[i].min_us = UINT32_MAX;
+	}
+
 	/* Initialize the UART for Servo Communication */
 	if (true == uart_init(UART_SERVO))
 	{
@@ -268,33 +380,160 @@ bool ach_servo_init(void)
 }
 
 /**
- * @brief Periodically sends position commands to all servos.
+ * @brief Plans the servo bus frame and sends its position commands.
  *
- * This function iterates through all available servos and checks if a position command
- * (in degrees) has been set for each servo. If a non-zero command is present, it sends
- * the corresponding position command to the servo using ach_cmd_servo_pos_deg().
+ * The bus is shared by commands and feedback, so each call plans one frame of
+ * the bus within the byte budget derived from the baud rate and
+ * ACH_SERVO_FRAME_HZ. Command slots are allocated first, primary surfaces
+ * before secondary ones, keeping one poll slot in reserve. The remaining
+ * budget is filled with position and status poll slots, which are sent one at
+ * a time by ach_servo_read_periodic() and ach_servo_bus_background() so that
+ * each reply has the bus to itself.
  *
- * @note Only servos with a non-zero command value will receive a position update.
+ * @note A poll of the previous frame still waiting for its reply keeps the bus
+ *       until the reply arrives or its reply window expires, and the commands
+ *       of the new frame are sent after it. Poll slots of the previous frame
+ *       not yet sent are dropped. Either case is counted as an overrun.
  *
  * @return void
  */
 void ach_cmd_servo_periodic(void)
 {
-	float bounded_cmd = 0.0f;
+	/* Take any reply of the previous frame that has arrived */
+	(void)ach_servo_bus_service();
 
-	/* Iterate through all servos and send position commands */
-	for (e_servo_positions_t id = FLAPERON_OUTER_LH; id < STEERING; id++)
+	if ((ServoBus.poll_active == true) || (ServoBus.poll_next < ServoBus.poll_count) || (ServoBus.cmd_count > 0U))
 	{
-		/* Range check the command to ensure operating Servo within Limits */
-		bounded_cmd = ach_servo_clamp_to_range(id, ServoCmd.servo_cmd_deg[id]);
+		ServoBusStats.overruns++;
+	}
+
+	ServoBus.cmd_count = 0U;
+	ServoBus.poll_count = 0U;
+	ServoBus.poll_next = 0U;
+	ServoBus.backlog_us = 0U;
+	ServoBus.frame_bytes = 0U;
+	ServoBusStats.frames++;
+
+	ach_servo_plan_commands();
+	ach_servo_plan_polls();
+
+	/* Send the commands and start the first poll behind them, once the bus is free */
+	(void)ach_servo_bus_service();
+}
 
-		/* If Servo Test is in Progress stop from commanding the normal commands */
-		if (servo_test_in_progress != true)
+/**
+ * @brief Allocates the command slots of a frame and sends the commands.
+ *
+ * A command is resent when it differs from the last one sent by at least
+ * SERVO_CMD_DEADBAND steps, or when SERVO_CMD_REFRESH_FRAMES have passed
+ * since it was last sent. Primary surfaces, and secondary surfaces overdue for
+ * a refresh, are served first; a changed command that does not fit is
+ * deferred to the next frame. The commands are sent by
+ * ach_servo_bus_service() when no poll is waiting for its reply.
+ */
+static void ach_servo_plan_commands(void)
+{
+	uint32_t remaining = ServoBus.budget_bytes;
+	uint32_t reserve = ServoBus.poll_bytes;
+	uint32_t planned_bytes = 0U;
+
+	for (uint8_t i = 0U; i < MAX_CONFIGURED_SERVO; i++)
+	{
+		if (ServoCmdState[ServoPriority[i]].age < UINT32_MAX)
 		{
-			/* Send the command to set the servo position */
-			ach_cmd_servo_pos_deg(id, bounded_cmd);
+			ServoCmdState[ServoPriority[i]].age++;
 		}
 	}
+
+	/* If Servo Test is in Progress stop from commanding the normal commands */
+	if (servo_test_in_progress != true)
+	{
+		/* First pass: primary and overdue surfaces, second pass: the rest */
+		for (uint8_t pass = 0U; pass < 2U; pass++)
+		{
+			for (uint8_t i = 0U; i < MAX_CONFIGURED_SERVO; i++)
+			{
+				e_servo_positions_t id = ServoPriority[i];
+				servo_cmd_state_t *state = &ServoCmdState[id];
+				bool urgent = (i < SERVO_PRIMARY_COUNT) || (state->age >= SERVO_CMD_REFRESH_FRAMES);
+
+				if (urgent == (pass == 0U))
+				{
+					/* Range check the command to ensure operating Servo within Limits */
+					float bounded_cmd = ach_servo_clamp_to_range(id, ServoCmd.servo_cmd_deg[id]);
+					int16_t counts = (int16_t)(bounded_cmd * 10.0F);
+					int32_t change = (int32_t)counts - (int32_t)state->last_cmd;
+
+					if ((state->sent == true) && (state->age < SERVO_CMD_REFRESH_FRAMES) &&
+						(change < SERVO_CMD_DEADBAND) && (change > -SERVO_CMD_DEADBAND))
+					{
+						ServoBusStats.commands_suppressed++;
+					}
+					else if (remaining >= (ServoBus.cmd_bytes + reserve))
+					{
+						/* Queue the command to set the servo position */
+						ServoBus.cmd[ServoBus.cmd_count].id = id;
+						ServoBus.cmd[ServoBus.cmd_count].position_deg = bounded_cmd;
+						ServoBus.cmd_count++;
+						state->last_cmd = counts;
+						state->age = 0U;
+						state->sent = true;
+						remaining -= ServoBus.cmd_bytes;
+						planned_bytes += ServoBus.cmd_bytes;
+						ServoBusStats.commands_sent++;
+					}
+					else
+					{
+						ServoBusStats.commands_deferred++;
+					}
+				}
+			}
+		}
+	}
+
+	ServoBus.frame_bytes = planned_bytes;
+}
+
+/**
+ * @brief Fills the rest of the frame budget with poll slots.
+ *
+ * Position polls follow ServoPositionPollSeq and every
+ * SERVO_STATUS_POLL_EVERY-th slot requests the device status of the next servo
+ * in turn.
+ */
+static void ach_servo_plan_polls(void)
+{
+	servo_poll_slot_t *slot;
+
+	while ((ServoBus.poll_count < SERVO_MAX_POLL_SLOTS) &&
+		   ((ServoBus.frame_bytes + ServoBus.poll_bytes) <= ServoBus.budget_bytes))
+	{
+		slot = &ServoBus.poll[ServoBus.poll_count];
+
+		if ((ServoBus.poll_seq % SERVO_STATUS_POLL_EVERY) == (SERVO_STATUS_POLL_EVERY - 1U))
+		{
+			slot->id = ServoPriority[ServoBus.status_seq];
+			slot->cmd_code = KST_CMD_DEVICE_STATUS;
+			ServoBus.status_seq = (uint8_t)((ServoBus.status_seq + 1U) % MAX_CONFIGURED_SERVO);
+			ServoBusStats.status_polls++;
+		}
+		else
+		{
+			slot->id = ServoPositionPollSeq[ServoBus.position_seq];
+			slot->cmd_code = KST_CMD_GET_POSITION;
+			ServoBus.position_seq = (uint8_t)((ServoBus.position_seq + 1U) % SERVO_POSITION_POLL_SEQ_LEN);
+			ServoBusStats.position_polls++;
+		}
+
+		ServoBus.poll_seq++;
+		ServoBus.poll_count++;
+		ServoBus.frame_bytes += ServoBus.poll_bytes;
+	}
+
+	if (ServoBus.frame_bytes > ServoBusStats.max_frame_bytes)
+	{
+		ServoBusStats.max_frame_bytes = ServoBus.frame_bytes;
+	}
 }
 
 /**
@@ -485,11 +724,194 @@ static uint8_t ach_servo_compute_checksum(const uint8_t *msg)
 /**
  * @brief Periodically reads and processes servo data from UART.
  *
- * This function handles the periodic reading of servo feedback and status messages
- * from the UART interface. It parses incoming RS485 packets, updates servo status,
- * handles low voltage alarms, and alternates between requesting servo position and
- * status to avoid flooding the servos with requests. The function maintains state
- * across calls to ensure each servo is polled in turn.
+ * This function handles the replies received since the last call and sends
+ * the next poll slot of the frame planned by ach_cmd_servo_periodic() once the
+ * bus is free. Later poll slots are sent by ach_servo_bus_background() in the
+ * slack of the frame.
+ *
+ * @note This function should be called periodically from the main control loop.
+ */
+void ach_servo_read_periodic(void)
+{
+	(void)ach_servo_bus_service();
+}
+
+/**
+ * @brief Background job sending the poll slots of the servo bus frame.
+ *
+ * @return true while poll slots of the frame remain to be completed.
+ */
+bool ach_servo_bus_background(void)
+{
+	return ach_servo_bus_service();
+}
+
+/**
+ * @brief Returns the slot allocation statistics of the servo bus scheduler.
+ *
+ * @param[out] stats Pointer to the statistics, ignored if NULL.
+ */
+void ach_get_servo_bus_stats(servo_bus_stats_t *stats)
+{
+	if (stats != NULL)
+	{
+		*stats = ServoBusStats;
+	}
+}
+
+/**
+ * @brief Returns the round-trip latency statistics of the polls of a servo.
+ *
+ * @param[in]  servo_id The identifier of the servo.
+ * @param[out] latency  Pointer to the statistics.
+ *
+ * @return true if the servo is configured and latency is not NULL, false otherwise.
+ */
+bool ach_get_servo_latency(e_servo_positions_t servo_id, servo_latency_t *latency)
+{
+	bool valid = false;
+
+	if ((latency != NULL) && (servo_id < MAX_CONTROL_SURFACE) && (ServoRangeCheck[servo_id].is_configured == true))
+	{
+		*latency = ServoLatency[servo_id];
+		if (ServoLatency[servo_id].replies > 0U)
+		{
+			latency->mean_us = (uint32_t)(ServoLatencyTotal[servo_id] / ServoLatency[servo_id].replies);
+		}
+		else
+		{
+			latency->min_us = 0U;
+		}
+		valid = true;
+	}
+
+	return valid;
+}
+
+/**
+ * @brief Services the servo bus: handles received replies, sends the commands and the next poll.
+ *
+ * Commands and polls are sent only when the previous poll has been answered
+ * or its reply window has expired, so that nothing collides with a reply on
+ * the half-duplex bus.
+ *
+ * @return true while command or poll slots of the frame remain to be completed.
+ */
+static bool ach_servo_bus_service(void)
+{
+	servo_poll_slot_t *slot;
+
+	ach_servo_receive();
+
+	if ((ServoBus.poll_active == true) &&
+		(d_TIMER_ElapsedMicroseconds(ServoBus.poll_start, NULL) >= ServoBus.poll_window_us))
+	{
+		ach_servo_poll_complete(false);
+	}
+
+	if ((ServoBus.poll_active != true) && (ServoBus.cmd_count > 0U))
+	{
+		for (uint8_t i = 0U; i < ServoBus.cmd_count; i++)
+		{
+			ach_cmd_servo_pos_deg(ServoBus.cmd[i].id, ServoBus.cmd[i].position_deg);
+		}
+		ServoBus.backlog_us = ach_servo_bytes_to_us((uint32_t)ServoBus.cmd_count * ServoBus.cmd_bytes);
+		ServoBus.cmd_count = 0U;
+	}
+
+	if ((ServoBus.poll_active != true) && (ServoBus.poll_next < ServoBus.poll_count))
+	{
+		slot = &ServoBus.poll[ServoBus.poll_next];
+
+		ServoBus.active = *slot;
+		ServoBus.poll_start = d_TIMER_ReadValueInTicks();
+		ServoBus.poll_backlog_us = ServoBus.backlog_us;
+		ServoBus.poll_window_us = ServoBus.backlog_us + ach_servo_bytes_to_us(ServoBus.poll_bytes);
+		ServoBus.backlog_us = 0U;
+		ServoBus.poll_active = true;
+		ServoBus.poll_next++;
+		ServoLatency[slot->id].polls++;
+
+		if (slot->cmd_code == KST_CMD_DEVICE_STATUS)
+		{
+			ach_cmd_req_servo_status(slot->id);
+		}
+		else
+		{
+			ach_cmd_req_servo_pos(slot->id);
+		}
+	}
+
+	return ((ServoBus.poll_active == true) || (ServoBus.poll_next < ServoBus.poll_count) || (ServoBus.cmd_count > 0U));
+}
+
+/**
+ * @brief Closes the active poll slot and records its round-trip time.
+ *
+ * @param[in] replied true if the reply was received, false if the window expired.
+ */
+static void ach_servo_poll_complete(bool replied)
+{
+	e_servo_positions_t id = ServoBus.active.id;
+	servo_latency_t *latency = &ServoLatency[id];
+	uint32_t elapsed_us;
+
+	if (replied == true)
+	{
+		/* The commands queued ahead of the poll are not part of the round trip */
+		elapsed_us = d_TIMER_ElapsedMicroseconds(ServoBus.poll_start, NULL);
+		if (elapsed_us > ServoBus.poll_backlog_us)
+		{
+			elapsed_us -= ServoBus.poll_backlog_us;
+		}
+		else
+		{
+			elapsed_us = 0U;
+		}
+
+		latency->replies++;
+		latency->last_us = elapsed_us;
+		ServoLatencyTotal[id] += elapsed_us;
+		if (elapsed_us < latency->min_us)
+		{
+			latency->min_us = elapsed_us;
+		}
+		if (elapsed_us > latency->max_us)
+		{
+			latency->max_us = elapsed_us;
+		}
+	}
+	else
+	{
+		latency->timeouts++;
+	}
+
+	ServoBus.poll_active = false;
+}
+
+/**
+ * @brief Transmit time of a number of bytes at the servo bus baud rate.
+ *
+ * @param[in] bytes Number of bytes.
+ * @return uint32_t Time in microseconds.
+ */
+static uint32_t ach_servo_bytes_to_us(uint32_t bytes)
+{
+	uint32_t time_us = 0U;
+
+	if (ServoBus.baud_rate > 0U)
+	{
+		time_us = (uint32_t)(((uint64_t)bytes * SERVO_BITS_PER_BYTE * 1000000U) / ServoBus.baud_rate);
+	}
+
+	return time_us;
+}
+
+/**
+ * @brief Reads and processes the servo replies received from the UART.
+ *
+ * It parses incoming RS485 packets, updates servo status and handles low
+ * voltage alarms. A reply matching the active poll slot closes the slot.
  *
  * Message types handled:
  * - Position feedback (auto report, get position)
@@ -498,29 +920,9 @@ static uint8_t ach_servo_compute_checksum(const uint8_t *msg)
  * - Watchdog failsafe (TODO)
  *
  * Low voltage alarms are reset if the warning condition clears and the timer expires.
- * The function uses static variables to track the current servo slot and feedback state.
- *
- * @note This function should be called periodically from the main control loop.
  */
-void ach_servo_read_periodic(void)
+static void ach_servo_receive(void)
 {
-
-	const e_servo_positions_t servo_read_slot[MAX_CONFIGURED_SERVO] = {FLAPERON_OUTER_LH,
-																	   FLAPERON_INNER_LH,
-																	   FLAP_LH,
-																	   FLAP_RH,
-																	   FLAPERON_INNER_RH,
-																	   FLAPERON_OUTER_RH,
-																	   RUDDER_LH,
-																	   RUDDER_RH,
-																	   ELEVATOR_LH,
-																	   ELEVATOR_RH};
-
-	static uint8_t slot_id = 0;
-	static bool pos_feedback = false;
-	// Make sure that message structure is reset
-	util_memset(&ServoMsg, 0, sizeof(kst_rs485_msg_t));
-
 	/* Read the UART Buffer */
 	uint16_t bytes_read = uart_read(UART_SERVO, &ServoRxPacket[0], SERVO_BUFFER_SIZE);
 
@@ -586,28 +988,21 @@ void ach_servo_read_periodic(void)
 					break;
 				}
 
+				/* Close the poll slot when its reply arrives */
+				if ((ServoBus.poll_active == true) && (ServoBus.active.id == idx) &&
+					((uint32_t)ServoMsg.receive_code == ((uint32_t)ServoBus.active.cmd_code + KST_SUCCESS_OFFSET)))
+				{
+					ach_servo_poll_complete(true);
+				}
+
+				/* Reset the message structure once it is handled, a message split
+				   across two reads keeps the ID and code of its first part */
+				util_memset(&ServoMsg, 0, sizeof(kst_rs485_msg_t));
 				// mark msg as read
 				ServoMsg.msg_status = RS485_RETURN_READ;
 			}
 		}
 	}
-
-	if (pos_feedback)
-	{
-		/* Read Position of One Servo at a time */
-		ach_cmd_req_servo_pos(servo_read_slot[slot_id]);
-		/* reset the flag after reading one servo */
-		pos_feedback = false;
-	}
-	else
-	{
-		/* To avoid flooding the Servos with request Command the Servo*/
-		ach_cmd_req_servo_status(servo_read_slot[(slot_id + 1) % 10]);
-		/*  set the flag to read position next time */
-		pos_feedback = true;
-		/* Increment to the next Servo */
-		slot_id = (slot_id + 1) % 10;
-	}
 }
 
 /**
@@ -8,12 +8,19 @@
 #define H_ACH_SERVO
 
 #include "ach_interface.h"
+#include "sys_srv_interface.h"
 
 #define DATA_LEN (4)
 #define MSG_LEN (10)
 #define KST_SUCCESS_OFFSET (0x40)
 #define KST_ERROR_OFFSET (0xC0)
 
+/* Rate at which ach_cmd_servo_periodic is called from ach_cmd_periodic, once
+   a main loop frame, sets the bus budget of a frame */
+#ifndef ACH_SERVO_FRAME_HZ
+#define ACH_SERVO_FRAME_HZ (SYS_FRAME_HZ)
+#endif
+
 /**
  * @brief Command Codes of KST Servo Motor.
  *        Placed in RS485 massage at Byte[3]
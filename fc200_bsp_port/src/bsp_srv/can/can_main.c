@@ -13,13 +13,56 @@
 #include "xcanps.h"
 #include "soc/interrupt_manager/d_int_irq_handler.h"
 #include "sru/fcu/d_fcu.h"
+#include "soc/can/d_can_hw.h"
+#include "soc/timer/d_timer.h"
+#include "timer_interface.h"
+#include "generic_util.h"
 
 // Masks for extracting ID components
 #define CAN_BASE_ID_MASK (0x7FFU)       // 11 bits: 0b11111111111
 #define CAN_EXTENDED_ID_MASK (0x3FFFFU) // 18 bits: 0b111111111111111111
 #define CAN_EXTENDED_BIT_LEN (18)
 
+// All channels are configured for 1 Mbit/s in can_cfg.c and can_holt_cfg.c
+#define CAN_BIT_RATE_BPS (1000000U)
+
+// Frame bits after the CRC that are not stuffed: CRC delimiter, ACK slot and
+// delimiter, end of frame and the intermission before the next frame
+#define CAN_FRAME_FIXED_BITS (13U)
+#define CAN_CRC15_POLY (0x4599U)
+#define CAN_STUFF_RUN (5U)
+
+typedef struct
+{
+    uint16_t crc;   // CRC-15 of the bits before stuffing
+    uint16_t bits;  // Bits on the wire including stuff bits
+    uint8_t level;  // Level of the last bit, 2 before the first bit
+    uint8_t run;    // Number of consecutive bits at that level
+} can_bit_stream_t;
+
+typedef struct
+{
+    uint64_t window_start_ms;
+    uint32_t window_bits;
+    uint32_t window_frames;
+    uint32_t window_writes;
+    uint32_t window_wait_us;
+    uint32_t backlog_us;    // Transmit time of the frames queued at backlog_tick
+    uint32_t backlog_tick;
+    uint16_t id_window_frames[CAN_STATS_MAX_IDS];
+    can_id_stats_t ids[CAN_STATS_MAX_IDS];
+    can_bus_stats_t stats;
+} can_account_t;
+
 static bool CanInitialized[CAN_CHANNEL_MAX];
+static can_account_t CanAccount[CAN_CHANNEL_MAX];
+
+static void can_account_reset(can_channel_t can_ch);
+static void can_account_frame(can_channel_t can_ch, const can_msg_t *ptr_can_msg, bool is_tx);
+static void can_account_id(can_account_t *acc, const can_msg_t *ptr_can_msg, bool is_tx);
+static void can_window_update(can_channel_t can_ch);
+static void can_error_sample(can_channel_t can_ch, can_bus_stats_t *stats);
+static void can_stream_bits(can_bit_stream_t *stream, uint32_t value, uint8_t count);
 
 /**
  * @brief Initialize a CAN channel
@@ -65,6 +108,7 @@ can_status_t can_init(can_channel_t can_ch)
                 if (d_CAN_ModeSet(can_ch, d_CAN_MODE_NORMAL) == d_STATUS_SUCCESS)
                 {
                     CanInitialized[can_ch] = true;
+                    can_account_reset(can_ch);
 //                    d_CAN_InterruptEnable(can_ch, XCANPS_IXR_RXFWMFLL_MASK);
 //                    d_INT_IrqEnable(d_CAN_Config[can_ch].interruptNumber);
                 }
@@ -102,6 +146,7 @@ can_status_t can_init(can_channel_t can_ch)
             if (drv_status == d_STATUS_SUCCESS)
             {
                 CanInitialized[can_ch] = true;
+                can_account_reset(can_ch);
                 status = CAN_OK;
             }
             else
@@ -133,10 +178,12 @@ can_status_t can_init(can_channel_t can_ch)
  *         - CAN_OK: Message sent successfully
  *         - CAN_ERROR: Invalid channel or transmission failure
  *         - CAN_INVALID_MSG_LENGTH: DLC exceeds maximum allowed length
+ *         - CAN_BUSY: Transmit FIFO full, the message was not sent
  *
  * @note For channels >= CAN_CHANNEL_2, the channel number is remapped by
  *       subtracting CAN_CHANNEL_3 before calling the HOLT device driver
  * @note Substitute remote transmission request is not supported and is set to FALSE
+ * @note Frames accepted by the driver are included in the bus accounting
  */
 can_status_t can_write(can_channel_t can_ch, const can_msg_t *ptr_can_msg)
 {
@@ -186,7 +233,16 @@ can_status_t can_write(can_channel_t can_ch, const can_msg_t *ptr_can_msg)
                 drv_status = d_CAN_HOLT_SendMessage(can_ch - CAN_CHANNEL_3, (d_CAN_HOLT_Message_t *)&txMessage);
             }
 
-            if (drv_status != d_STATUS_SUCCESS)
+            if (drv_status == d_STATUS_SUCCESS)
+            {
+                can_account_frame(can_ch, ptr_can_msg, true);
+            }
+            else if (drv_status == d_STATUS_BUFFER_FULL)
+            {
+                CanAccount[can_ch].stats.tx_rejected++;
+                status = CAN_BUSY;
+            }
+            else
             {
                 status = CAN_ERROR;
             }
@@ -238,6 +294,8 @@ can_status_t can_read(can_channel_t can_ch, can_msg_t *ptr_can_msg)
             {
                 ptr_can_msg->data[byte_id] = rxMessage.data[byte_id];
             }
+
+            can_account_frame(can_ch, ptr_can_msg, false);
         }
         else
         {
@@ -248,6 +306,384 @@ can_status_t can_read(can_channel_t can_ch, can_msg_t *ptr_can_msg)
     return status;
 }
 
+/**
+ * @brief Get the bus accounting of a CAN channel
+ *
+ * Completes the accounting window first if it has elapsed, so the figures are
+ * current even when the channel has no traffic.
+ *
+ * @param can_ch    CAN channel identifier
+ * @param ptr_stats Storage for the statistics
+ *
+ * @return can_status_t CAN_OK, CAN_NOT_INITIALIZED if the channel is not open,
+ *         otherwise CAN_ERROR
+ */
+can_status_t can_get_bus_stats(can_channel_t can_ch, can_bus_stats_t *ptr_stats)
+{
+    can_status_t status = CAN_OK;
+
+    if ((can_ch >= CAN_CHANNEL_MAX) || (ptr_stats == NULL))
+    {
+        status = CAN_ERROR;
+    }
+    else if (!CanInitialized[can_ch])
+    {
+        status = CAN_NOT_INITIALIZED;
+    }
+    else
+    {
+        can_window_update(can_ch);
+        *ptr_stats = CanAccount[can_ch].stats;
+    }
+
+    return status;
+}
+
+/**
+ * @brief Get an entry of the per-ID frame rate table of a CAN channel
+ *
+ * Entries are created in the order the IDs are first seen, separately for each
+ * direction. The number of entries is given by can_bus_stats_t::id_count.
+ *
+ * @param can_ch    CAN channel identifier
+ * @param index     Table entry
+ * @param ptr_stats Storage for the entry
+ *
+ * @return can_status_t CAN_OK, or CAN_ERROR if the entry does not exist
+ */
+can_status_t can_get_id_stats(can_channel_t can_ch, uint8_t index, can_id_stats_t *ptr_stats)
+{
+    can_status_t status = CAN_OK;
+
+    if ((can_ch >= CAN_CHANNEL_MAX) || (ptr_stats == NULL) || !CanInitialized[can_ch] ||
+        (index >= CanAccount[can_ch].stats.id_count))
+    {
+        status = CAN_ERROR;
+    }
+    else
+    {
+        can_window_update(can_ch);
+        *ptr_stats = CanAccount[can_ch].ids[index];
+    }
+
+    return status;
+}
+
+/**
+ * @brief Calculate the length of a CAN frame on the wire
+ *
+ * The frame is built bit by bit from the start of frame to the end of the CRC,
+ * computing the CRC-15 and inserting a stuff bit after every five consecutive
+ * bits of the same level, then the fixed length tail is added.
+ *
+ * @param ptr_can_msg CAN message, the ID packed as for can_write
+ *
+ * @return uint16_t Frame length in bits including the intermission, 0 if the
+ *         message is NULL
+ */
+uint16_t can_frame_bits(const can_msg_t *ptr_can_msg)
+{
+    can_bit_stream_t stream = {0U, 0U, 2U, 0U};
+    uint16_t bits = 0U;
+
+    if (ptr_can_msg != NULL)
+    {
+        uint32_t base_id = (ptr_can_msg->can_msg_id >> CAN_EXTENDED_BIT_LEN) & CAN_BASE_ID_MASK;
+        uint32_t remote = ptr_can_msg->is_remote_req ? 1U : 0U;
+        uint8_t dlc = (ptr_can_msg->dlc > CAN_MAX_DLC) ? CAN_MAX_DLC : ptr_can_msg->dlc;
+
+        can_stream_bits(&stream, 0U, 1U); /* Start of frame */
+        can_stream_bits(&stream, base_id, 11U);
+
+        if (ptr_can_msg->extended_id_flag)
+        {
+            can_stream_bits(&stream, 3U, 2U); /* SRR and IDE, recessive */
+            can_stream_bits(&stream, ptr_can_msg->can_msg_id & CAN_EXTENDED_ID_MASK, (uint8_t)CAN_EXTENDED_BIT_LEN);
+            can_stream_bits(&stream, remote, 1U);
+            can_stream_bits(&stream, 0U, 2U); /* r1 and r0 */
+        }
+        else
+        {
+            can_stream_bits(&stream, remote, 1U);
+            can_stream_bits(&stream, 0U, 2U); /* IDE and r0 */
+        }
+
+        can_stream_bits(&stream, dlc, 4U);
+
+        /* A remote frame has no data field whatever the DLC */
+        if (!ptr_can_msg->is_remote_req)
+        {
+            for (uint8_t byte_id = 0; byte_id < dlc; byte_id++)
+            {
+                can_stream_bits(&stream, ptr_can_msg->data[byte_id], 8U);
+            }
+        }
+
+        /* The CRC is stuffed with the rest of the frame */
+        can_stream_bits(&stream, stream.crc, 15U);
+
+        bits = stream.bits + (uint16_t)CAN_FRAME_FIXED_BITS;
+    }
+
+    return bits;
+}
+
+/**
+ * @brief Clear the accounting of a channel when it is initialised
+ */
+static void can_account_reset(can_channel_t can_ch)
+{
+    util_memset(&CanAccount[can_ch], 0, (uint32_t)sizeof(can_account_t));
+    CanAccount[can_ch].window_start_ms = timer_get_system_time_ms();
+    CanAccount[can_ch].backlog_tick = d_TIMER_ReadValueInTicks();
+}
+
+/**
+ * @brief Account a frame sent or received on a channel
+ *
+ * The transmit queue wait is estimated from the frames written earlier that
+ * are still expected to be on the bus, at their stuffed lengths. Frames from
+ * other nodes and lost arbitration are not visible when a frame is written so
+ * the estimate is the wait caused by this node's own queue.
+ */
+static void can_account_frame(can_channel_t can_ch, const can_msg_t *ptr_can_msg, bool is_tx)
+{
+    can_account_t *acc = &CanAccount[can_ch];
+    uint32_t bits = can_frame_bits(ptr_can_msg);
+
+    can_window_update(can_ch);
+
+    acc->window_bits += bits;
+    acc->window_frames++;
+
+    if (is_tx)
+    {
+        uint32_t now_tick;
+        uint32_t elapsed_us = d_TIMER_ElapsedMicroseconds(acc->backlog_tick, &now_tick);
+        uint32_t wait_us = (acc->backlog_us > elapsed_us) ? (acc->backlog_us - elapsed_us) : 0U;
+
+        acc->backlog_us = wait_us + ((bits * 1000U) / (CAN_BIT_RATE_BPS / 1000U));
+        acc->backlog_tick = now_tick;
+
+        acc->window_writes++;
+        acc->window_wait_us += wait_us;
+        acc->stats.tx_frames++;
+        acc->stats.tx_wait_last_us = wait_us;
+        if (wait_us > acc->stats.tx_wait_max_us)
+        {
+            acc->stats.tx_wait_max_us = wait_us;
+        }
+    }
+    else
+    {
+        acc->stats.rx_frames++;
+    }
+
+    can_account_id(acc, ptr_can_msg, is_tx);
+}
+
+/**
+ * @brief Count a frame against its entry of the per-ID table
+ */
+static void can_account_id(can_account_t *acc, const can_msg_t *ptr_can_msg, bool is_tx)
+{
+    uint8_t index = 0U;
+    bool found = false;
+
+    while ((index < acc->stats.id_count) && !found)
+    {
+        const can_id_stats_t *entry = &acc->ids[index];
+
+        if ((entry->can_msg_id == ptr_can_msg->can_msg_id) &&
+            (entry->extended_id_flag == ptr_can_msg->extended_id_flag) && (entry->is_tx == is_tx))
+        {
+            found = true;
+        }
+        else
+        {
+            index++;
+        }
+    }
+
+    if (!found && (acc->stats.id_count < CAN_STATS_MAX_IDS))
+    {
+        acc->ids[index].can_msg_id = ptr_can_msg->can_msg_id;
+        acc->ids[index].extended_id_flag = ptr_can_msg->extended_id_flag;
+        acc->ids[index].is_tx = is_tx;
+        acc->stats.id_count++;
+        found = true;
+    }
+
+    if (found)
+    {
+        acc->ids[index].frames++;
+        acc->id_window_frames[index]++;
+    }
+    else
+    {
+        acc->stats.id_overflow++;
+    }
+}
+
+/**
+ * @brief Complete the accounting window once it has elapsed
+ *
+ * The window is closed on the first access after CAN_STATS_WINDOW_MS, so the
+ * rates are calculated over the actual window length. The error counters are
+ * sampled at the end of each window.
+ */
+static void can_window_update(can_channel_t can_ch)
+{
+    can_account_t *acc = &CanAccount[can_ch];
+    uint64_t now_ms = timer_get_system_time_ms();
+    uint32_t elapsed_ms = (uint32_t)(now_ms - acc->window_start_ms);
+
+    if (elapsed_ms >= CAN_STATS_WINDOW_MS)
+    {
+        float capacity_bits = (float)elapsed_ms * ((float)CAN_BIT_RATE_BPS / 1000.0f);
+
+        acc->stats.utilisation_pct = ((float)acc->window_bits * 100.0f) / capacity_bits;
+        if (acc->stats.utilisation_pct > acc->stats.utilisation_peak_pct)
+        {
+            acc->stats.utilisation_peak_pct = acc->stats.utilisation_pct;
+        }
+
+        acc->stats.frame_rate_hz = (uint16_t)((acc->window_frames * 1000U) / elapsed_ms);
+        acc->stats.tx_wait_mean_us = (acc->window_writes > 0U) ? (acc->window_wait_us / acc->window_writes) : 0U;
+
+        for (uint8_t index = 0U; index < acc->stats.id_count; index++)
+        {
+            acc->ids[index].rate_hz = (uint16_t)(((uint32_t)acc->id_window_frames[index] * 1000U) / elapsed_ms);
+            acc->id_window_frames[index] = 0U;
+        }
+
+        can_error_sample(can_ch, &acc->stats);
+
+        acc->stats.windows++;
+        acc->window_start_ms = now_ms;
+        acc->window_bits = 0U;
+        acc->window_frames = 0U;
+        acc->window_writes = 0U;
+        acc->window_wait_us = 0U;
+    }
+}
+
+/**
+ * @brief Sample the controller error counters and fault confinement state
+ */
+static void can_error_sample(can_channel_t can_ch, can_bus_stats_t *stats)
+{
+    d_Status_t drv_status;
+    uint32_t tec = 0U;
+    uint32_t rec = 0U;
+    uint8_t flags = 0U;
+    bool passive = false;
+    bool off = false;
+
+    if (can_ch <= CAN_CHANNEL_2)
+    {
+        d_CAN_ErrorState_t state;
+
+        drv_status = d_CAN_ErrorStateGet(can_ch, &state);
+        if (drv_status == d_STATUS_SUCCESS)
+        {
+            tec = state.txErrorCount;
+            rec = state.rxErrorCount;
+            flags |= ((state.errorFlags & d_CAN_ESR_BERR_MASK) != 0U) ? CAN_ERR_FLAG_BIT : 0U;
+            flags |= ((state.errorFlags & d_CAN_ESR_STER_MASK) != 0U) ? CAN_ERR_FLAG_STUFF : 0U;
+            flags |= ((state.errorFlags & d_CAN_ESR_FMER_MASK) != 0U) ? CAN_ERR_FLAG_FORM : 0U;
+            flags |= ((state.errorFlags & d_CAN_ESR_CRCER_MASK) != 0U) ? CAN_ERR_FLAG_CRC : 0U;
+            flags |= ((state.errorFlags & d_CAN_ESR_ACKER_MASK) != 0U) ? CAN_ERR_FLAG_ACK : 0U;
+            passive = (state.errorPassive == d_TRUE);
+            off = (state.busOff == d_TRUE);
+        }
+    }
+    else
+    {
+        d_CAN_HOLT_ErrorState_t state;
+
+        drv_status = d_CAN_HOLT_ErrorStateGet(can_ch - CAN_CHANNEL_3, &state);
+        if (drv_status == d_STATUS_SUCCESS)
+        {
+            tec = state.txErrorCount;
+            rec = state.rxErrorCount;
+            flags |= ((state.errorFlags & d_CAN_HOLT_BITERR_MASK) != 0U) ? CAN_ERR_FLAG_BIT : 0U;
+            flags |= ((state.errorFlags & d_CAN_HOLT_STUFERR_MASK) != 0U) ? CAN_ERR_FLAG_STUFF : 0U;
+            flags |= ((state.errorFlags & d_CAN_HOLT_FRMERR_MASK) != 0U) ? CAN_ERR_FLAG_FORM : 0U;
+            flags |= ((state.errorFlags & d_CAN_HOLT_CRCERR_MASK) != 0U) ? CAN_ERR_FLAG_CRC : 0U;
+            flags |= ((state.errorFlags & d_CAN_HOLT_ACKERR_MASK) != 0U) ? CAN_ERR_FLAG_ACK : 0U;
+            passive = (state.errorPassive == d_TRUE);
+            off = (state.busOff == d_TRUE);
+        }
+    }
+
+    if (drv_status == d_STATUS_SUCCESS)
+    {
+        stats->tec_trend = (int16_t)tec - (int16_t)stats->tec;
+        stats->rec_trend = (int16_t)rec - (int16_t)stats->rec;
+        stats->tec = (uint8_t)tec;
+        stats->rec = (uint8_t)rec;
+        if (stats->tec > stats->tec_max)
+        {
+            stats->tec_max = stats->tec;
+        }
+        if (stats->rec > stats->rec_max)
+        {
+            stats->rec_max = stats->rec;
+        }
+
+        stats->error_flags = flags;
+        if (flags != 0U)
+        {
+            stats->error_windows++;
+        }
+
+        if (off && !stats->bus_off)
+        {
+            stats->bus_off_count++;
+        }
+        stats->bus_off = off;
+        stats->error_passive = passive;
+    }
+}
+
+/**
+ * @brief Add bits to a frame, most significant first, with CRC and stuffing
+ */
+static void can_stream_bits(can_bit_stream_t *stream, uint32_t value, uint8_t count)
+{
+    for (uint8_t bit_id = count; bit_id > 0U; bit_id--)
+    {
+        uint8_t level = (uint8_t)((value >> (bit_id - 1U)) & 1U);
+        uint16_t crc_next = (uint16_t)(level ^ ((stream->crc >> 14U) & 1U));
+
+        stream->crc = (uint16_t)((stream->crc << 1U) & 0x7FFFU);
+        if (crc_next != 0U)
+        {
+            stream->crc ^= (uint16_t)CAN_CRC15_POLY;
+        }
+
+        stream->bits++;
+        if (level == stream->level)
+        {
+            stream->run++;
+        }
+        else
+        {
+            stream->level = level;
+            stream->run = 1U;
+        }
+
+        /* A stuff bit of the opposite level starts a new run */
+        if (stream->run == CAN_STUFF_RUN)
+        {
+            stream->bits++;
+            stream->level = (uint8_t)(level ^ 1U);
+            stream->run = 1U;
+        }
+    }
+}
+
 // /* IMPORTANT: CAN Filter Cannot be set once initialized to normal mode - 
 //    Filter settings must be performed in the init and before mode is set to normal*/
 // can_status_t can_set_filter(can_channel_t can_ch, bool is_single_id_filter, 
@@ -13,6 +13,17 @@
 #define CAN_MAX_DLC (8)
 #define CAN_MAX_FILTERS (4)
 
+/* Bus accounting window and size of the per-ID frame rate table */
+#define CAN_STATS_WINDOW_MS (100U)
+#define CAN_STATS_MAX_IDS (16U)
+
+/* Error flags reported by the controller, common to both CAN drivers */
+#define CAN_ERR_FLAG_BIT (0x01U)
+#define CAN_ERR_FLAG_STUFF (0x02U)
+#define CAN_ERR_FLAG_FORM (0x04U)
+#define CAN_ERR_FLAG_CRC (0x08U)
+#define CAN_ERR_FLAG_ACK (0x10U)
+
 typedef struct 
 {
 	uint32_t can_msg_id;
@@ -51,10 +62,49 @@ typedef struct
 	bool   is_single_id_filter;
 } can_filter_cfg_t;
 
+typedef struct
+{
+	uint32_t can_msg_id;
+	bool     extended_id_flag;
+	bool     is_tx;
+	uint16_t rate_hz;          /* Frames per second over the last window */
+	uint32_t frames;           /* Frames since initialisation */
+} can_id_stats_t;
+
+typedef struct
+{
+	uint32_t windows;              /* Accounting windows completed */
+	float    utilisation_pct;      /* Bus load of the last window from the bit-stuffed frame lengths */
+	float    utilisation_peak_pct; /* Highest window bus load */
+	uint16_t frame_rate_hz;        /* Frames per second over the last window, both directions */
+	uint32_t tx_frames;
+	uint32_t rx_frames;
+	uint32_t tx_rejected;          /* Writes refused because the transmit FIFO was full */
+	uint32_t tx_wait_last_us;      /* Estimated transmit queue wait of the last frame written */
+	uint32_t tx_wait_mean_us;      /* Mean estimated wait over the last window */
+	uint32_t tx_wait_max_us;       /* Highest estimated wait */
+	uint8_t  tec;                  /* Transmit error counter at the end of the last window */
+	uint8_t  rec;                  /* Receive error counter at the end of the last window */
+	int16_t  tec_trend;            /* Change in the transmit error counter over the last window */
+	int16_t  rec_trend;            /* Change in the receive error counter over the last window */
+	uint8_t  tec_max;
+	uint8_t  rec_max;
+	uint8_t  error_flags;          /* CAN_ERR_FLAG_x reported in the last window */
+	bool     error_passive;
+	bool     bus_off;
+	uint32_t error_windows;        /* Windows in which the controller reported an error */
+	uint32_t bus_off_count;        /* Transitions to bus off */
+	uint8_t  id_count;             /* Entries in use in the per-ID table */
+	uint32_t id_overflow;          /* Frames whose ID did not fit in the per-ID table */
+} can_bus_stats_t;
+
 
 can_status_t can_init(can_channel_t can_ch);
 can_status_t can_write(can_channel_t can_ch, const can_msg_t *ptr_can_msg);
 can_status_t can_read(can_channel_t can_ch, can_msg_t *ptr_can_msg);
+can_status_t can_get_bus_stats(can_channel_t can_ch, can_bus_stats_t *ptr_stats);
+can_status_t can_get_id_stats(can_channel_t can_ch, uint8_t index, can_id_stats_t *ptr_stats);
+uint16_t can_frame_bits(const can_msg_t *ptr_can_msg);
 
 // can_status_t can_set_filter(can_channel_t can_ch, bool is_single_id_filter, 
 // 	                        const uint32_t *const start_id, const uint32_t *const end_id);
@@ -9,6 +9,12 @@
 #define H_SYS_SRV_INTERFACE
 
 #include "type.h"
+#include "xparameters.h"
+
+/* Main loop tick period in TTC0 timer units, and the rate in Hz at which
+   the periodic tasks of the main loop are called */
+#define SYS_TICK_PERIOD (1000000UL)
+#define SYS_FRAME_HZ ((uint32_t)(XPAR_XTTCPS_0_TTC_CLK_FREQ_HZ / SYS_TICK_PERIOD))
 
 void sys_boot(void);
 void sys_set_tick_period(uint64_t timer_tick_period);
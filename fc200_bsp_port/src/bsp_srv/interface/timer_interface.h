@@ -36,6 +36,8 @@ typedef struct timer_data_s
 
 void timer_init(void);
 uint64_t timer_get_system_time_ms(void);
+uint32_t timer_get_ticks(void);
+uint32_t timer_elapsed_us(uint32_t start_tick);
 void timer_start(s_timer_data_t* ptr_timer_instance, uint64_t period);
 bool timer_check_expiry(s_timer_data_t* ptr_timer_instance);
 void timer_reset(s_timer_data_t* ptr_timer_instance);
@@ -20,4 +20,10 @@ uint16_t uart_read(UART_peripherals_t uart_channel, uint8_t* ptr_rx_data, uint16
 /* Implementation of operation 'uart_write' from interface 'UART_interface' */
 uint16_t uart_write(UART_peripherals_t uart_channel, uint8_t *ptr_tx_data, uint16_t max_buf_data_size);
 
+/* Configured baud rate of a UART peripheral, 0 if the channel is out of range */
+uint32_t uart_get_baud_rate(UART_peripherals_t uart_channel);
+
+/* Timer tick at which a byte of the latest read was received, false if unknown */
+bool uart_get_arrival_tick(UART_peripherals_t uart_channel, uint16_t offset, uint32_t *ptr_tick);
+
 #endif /* H_UART_INTERFACE */
@@ -6,6 +6,14 @@
  ****************************************************/
 
 #include "pwm_main.h"
+#include "sru/pwm/d_pwm.h"
+#include "sru/pwm/d_pwm_cfg.h"
+
+#define PWM_IOC (0U) /* Outputs are on IOC A */
+
+/* Pulse widths at the minimum and maximum of a channel definition */
+#define PWM_PULSE_MIN_US (1000)
+#define PWM_PULSE_MAX_US (2000)
 
 void pwm_init()
 {
@@ -17,9 +25,44 @@ bool pwm_configure(uint16_t channel, uint16_t frequency)
 	return  true;
 }
 
-bool pwm_set(uint16_t channel, double duty_cycle)
+/**
+ * @brief Queue a PWM output for the next commit
+ *
+ * The value is held in the BSP shadow table and only written by pwm_commit(),
+ * so all the outputs set in a frame change together. A value equal to the one
+ * already output is not written again. The pulse width is converted to the
+ * units of the channel definition, whose range spans 1000 to 2000 us, and the
+ * BSP scales it to the output register as it does for an immediate output.
+ *
+ * @param channel       PWM output channel
+ * @param duty_cycle_us Pulse width in microseconds, limited to 1000 to 2000
+ * @return true if the value was queued, false otherwise
+ */
+bool pwm_set(uint16_t channel, uint16_t duty_cycle_us)
 {
-	d_PWM_Output(0u, channel, (Float32_t)duty_cycle);
-	return  true;
-} 
+	bool is_queued = false;
+
+	if (channel < d_PWM_CountChannel)
+	{
+		float fraction = (float)((int32_t)duty_cycle_us - PWM_PULSE_MIN_US) / (float)(PWM_PULSE_MAX_US - PWM_PULSE_MIN_US);
+		/* Interpolated so that the end pulse widths give the exact definition limits */
+		float value = (d_PWM_Definition[channel].minimumValue * (1.0f - fraction)) +
+					  (d_PWM_Definition[channel].maximumValue * fraction);
+
+		is_queued = (d_PWM_OutputQueue(PWM_IOC, channel, value) == d_STATUS_SUCCESS);
+	}
 
+	return is_queued;
+}
+
+/**
+ * @brief Write the PWM outputs queued since the last commit
+ *
+ * Called once per frame at a fixed point in the loop.
+ *
+ * @return true if the outputs were written, false otherwise
+ */
+bool pwm_commit(void)
+{
+	return (d_PWM_Commit() == d_STATUS_SUCCESS);
+}
@@ -13,7 +13,8 @@
 
 void pwm_init();
 bool pwm_configure(uint16_t channel, uint16_t frequency);
-bool pwm_set(uint16_t channel, double duty_cycle);
+bool pwm_set(uint16_t channel, uint16_t duty_cycle_us);
+bool pwm_commit(void);
 
 
 #endif /*!defined(H_PWM_MAIN)*/
@@ -15,6 +15,9 @@
 #include "xscugic.h"
 #include "kernel/general/d_gen_register.h"
 #include "kernel/date_time/d_date_time.h"
+#include "kernel/ram/d_ram_usr.h"
+#include "soc/dma/d_dma_copy.h"
+#include "kernel/scheduler/d_sched_background.h"
 #include "uart_interface.h"
 #include "timer_interface.h"
 
@@ -64,6 +67,10 @@ void sys_boot(void)
 	d_TIMER_Initialise();
 	/* Initialise SW timer with 1 msec tick */
 	timer_init();
+	/* Initialise code CRC and stack checks run by the background dispatcher */
+	d_RAM_Initialise();
+	/* Initialise the DMA channel used for long memory copies */
+	(void)d_DMA_CopyInitialise();
 	fcuInit = d_FCU_Initialise();
 	d_INT_IrqDeviceInitialise();
 
@@ -161,6 +168,8 @@ void sys_boot(void)
  *       - Interrupt priority: 224
  *       - Interrupt trigger: Rising edge
  *       - Interrupt ID: XPS_TTC0_0_INT_ID
+ * @note The background dispatcher is initialised with the same period so
+ *       that it can measure the slack remaining in each frame.
  */
 void sys_set_tick_period(uint64_t timer_tick_period)
 {
@@ -172,6 +181,9 @@ void sys_set_tick_period(uint64_t timer_tick_period)
 	(void)d_TIMER_Start(LOOP_TIMER);
 	(void)d_TIMER_InterruptEnable(LOOP_TIMER, d_TIMER_INTERRUPT_INTERVAL);
 
+	/* Background jobs run in the slack of each tick period */
+	(void)d_SCHED_BackgroundInitialise((uint32_t)(timer_tick_period / (XPAR_XTTCPS_0_TTC_CLK_FREQ_HZ / 1000000U)));
+
 	d_INT_IrqSetPriorityTriggerType(XPS_TTC0_0_INT_ID, 224, d_INT_RISING_EDGE);
 	d_INT_IrqSetPriorityTriggerType(XPAR_FABRIC_SYNCHRONISER_IRQ_INTR, 232, d_INT_RISING_EDGE);
 
@@ -197,10 +209,12 @@ void sys_set_tick_period(uint64_t timer_tick_period)
  * period and resets the tick handler registration flag upon completion.
  *
  * @details The function:
+ *          - Runs the background jobs in the slack remaining before the next tick
  *          - Records the start time using timer ticks
  *          - Blocks execution in a busy-wait loop until TickHandlerRegistered becomes true
  *          - Calculates and stores the elapsed time in milliseconds
  *          - Resets the TickHandlerRegistered flag for subsequent sleep operations
+ *          - Records the frame of the work that follows for the background dispatcher
  *
  * @note This function uses busy-waiting which consumes CPU cycles during sleep.
  *       The global variable ElapsedTicksinMillisec is updated with the sleep duration.
@@ -216,6 +230,9 @@ void sys_set_tick_period(uint64_t timer_tick_period)
 void sys_sleep(void)
 {
 
+	/* Use the remaining frame time for background jobs */
+	d_SCHED_BackgroundRun();
+
 	/* Record start time */
 	uint32_t startTime = d_TIMER_ReadValueInTicks();
 	/* Wait until TaskEventFlag is set to true */
@@ -229,6 +246,9 @@ void sys_sleep(void)
 	/* Reset for next sleep */
 	TaskEventFlag = false;
 
+	/* The work of the frame starts on return */
+	d_SCHED_BackgroundLoopStart();
+
 	return;
 }
 
@@ -258,6 +278,9 @@ void sys_tickHandler(const Uint32_t parameter)
 	/* Update date time in timestamp */
 	d_DATE_TIME_TimestampUpdate();
 
+	/* Mark the start of the frame for the background dispatcher */
+	d_SCHED_BackgroundFrameStart();
+
 	/* Acknowledge the interrupt. */
 	(void)d_TIMER_InterruptStatus(d_TIMER_TTC0_0, &interruptStatus);
 
@@ -48,6 +48,32 @@ uint64_t timer_get_system_time_ms(void)
     return timer_value;
 }
 
+/**
+ * @brief Get the free running timer value in ticks of 640 ns.
+ *
+ * Used to timestamp events more finely than the millisecond system time.
+ *
+ * @return uint32_t
+ */
+uint32_t timer_get_ticks(void)
+{
+    return d_TIMER_ReadValueInTicks();
+}
+
+/**
+ * @brief Get the microseconds elapsed since a tick value.
+ *
+ * The tick counter wraps after about 45 minutes, longer intervals are not measured.
+ *
+ * @param start_tick Tick value at the start of the interval
+ *
+ * @return uint32_t
+ */
+uint32_t timer_elapsed_us(uint32_t start_tick)
+{
+    return d_TIMER_ElapsedMicroseconds(start_tick, NULL);
+}
+
 /**
  * @brief Starts the timer instance with a specified period.
  *
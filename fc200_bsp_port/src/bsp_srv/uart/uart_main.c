@@ -31,6 +31,9 @@ static const uart_config_t UART_Config[UART_MAX_PERIPHERAL] = {
     {18, 500000, d_UART_DATA_BITS_8, d_UART_PARITY_NONE, d_UART_STOP_BITS_1}  /* ADS */
 };
 
+/* Receive sequence number of the first byte returned by the latest read of each channel */
+static uint32_t UART_ReadSequence[UART_MAX_PERIPHERAL];
+
 /**
  * @brief Initializes a UART peripheral with specified configuration parameters
  *
@@ -96,6 +99,9 @@ uint16_t uart_read(UART_peripherals_t uart_channel, uint8_t *ptr_rx_data, uint16
 
         if (bytes_read > 0)
         {
+            /* Remember where the data sits in the receive stream so that its arrival time can be found */
+            (void)d_UART_RxSequence(UART_Config[uart_channel].uart_ch, &UART_ReadSequence[uart_channel]);
+
             /* Discard all data */
             (void)d_UART_Discard(UART_Config[uart_channel].uart_ch, bytes_read);
         }
@@ -159,3 +165,52 @@ uint16_t uart_write(UART_peripherals_t uart_channel, uint8_t *ptr_tx_data, uint1
 
     return (bytes_written);
 }
+
+/**
+ * @brief Returns the configured baud rate of a UART peripheral
+ *
+ * Used by drivers that budget the bus time of a channel.
+ *
+ * @param uart_channel The UART peripheral channel (must be < UART_MAX_PERIPHERAL)
+ *
+ * @return uint32_t Baud rate in bits per second, 0 if the channel is out of range
+ */
+uint32_t uart_get_baud_rate(UART_peripherals_t uart_channel)
+{
+    uint32_t baud_rate = 0;
+
+    if (uart_channel < UART_MAX_PERIPHERAL)
+    {
+        baud_rate = UART_Config[uart_channel].baud_rate;
+    }
+
+    return baud_rate;
+}
+
+/**
+ * @brief Returns the time at which a byte of the latest read was received
+ *
+ * The receive interrupt marks the arrival of each burst of bytes, so a decoder
+ * can timestamp a frame by the byte that started it rather than by the time it
+ * was read.
+ *
+ * @param uart_channel The UART peripheral channel (must be < UART_MAX_PERIPHERAL)
+ * @param offset Offset of the byte in the data returned by the latest uart_read
+ * @param ptr_tick Timer tick (640 ns) at which the byte was received
+ *
+ * @return true if the arrival time is known
+ * @return false if the channel does not timestamp its data or the byte is too old
+ */
+bool uart_get_arrival_tick(UART_peripherals_t uart_channel, uint16_t offset, uint32_t *ptr_tick)
+{
+    bool status = false;
+
+    if ((ptr_tick != NULL) && (uart_channel < UART_MAX_PERIPHERAL))
+    {
+        status = (d_UART_ArrivalTicks(UART_Config[uart_channel].uart_ch,
+                                      UART_ReadSequence[uart_channel] + offset,
+                                      ptr_tick) == d_STATUS_SUCCESS);
+    }
+
+    return status;
+}
@@ -0,0 +1,84 @@
+/******[Configuration Header]*****************************************//**
+\file
+\brief
+  Module Title       : Background dispatcher job definition
+
+  Abstract           : This is the application background job table. Jobs
+                       are listed in priority order, highest first. It
+                       replaces the default table of the BSP.
+
+  Software Structure : SRS References: Document numbers and versions.
+                       SDD References: Document numbers and versions.
+
+*************************************************************************/
+
+/***** Includes *********************************************************/
+
+#include "soc/defines/d_common_types.h"
+#include "kernel/scheduler/d_sched_background_cfg.h"
+
+/* Include here any header files containing job function definitions */
+#include "kernel/event_logger/d_event_logger.h"
+#include "kernel/ram/d_ram.h"
+#include "kernel/sha/d_sha256.h"
+#include "soc/sata/d_sata.h"
+#include "sru/mmc/d_mmc_interface.h"
+#include "sru/qspiFlash/d_qspiFlash.h"
+#include "kernel/shared_memory/d_smi.h"
+#include "kernel/shared_memory/d_smi_eth.h"
+#include "fdr_interface.h"
+#include "ach_interface.h"
+
+/***** Constants ********************************************************/
+
+/* Time in microseconds before the next tick in which no job is started */
+const Uint32_t d_SCHED_BackgroundGuardBand = 500;
+
+/* Job definitions */
+const d_SCHED_BackgroundJob_t d_SCHED_BackgroundJobs[] =
+{
+  {
+    d_SATA_QueueBackground, 50, 0             /* SATA request completion and timeouts, quantum time (us), no quanta limit */
+  },
+  {
+    d_MMC_QueueBackground, 50, 0              /* MMC request completion and timeouts, quantum time (us), no quanta limit */
+  },
+  {
+    d_QSPI_QueueBackground, 20, 0             /* QSPI read completion, prefetch and timeouts, quantum time (us), no quanta limit */
+  },
+  {
+    d_SMI_Background, 5, 1                    /* APU doorbell for messages batched in the frame, quantum time (us), 1 quantum per frame */
+  },
+  {
+    fdr_background, 50, 2                     /* Flight data recorder chunk submission, quantum time (us), 2 quanta per frame */
+  },
+  {
+    d_SMI_EthBridgeBackground, 100, 0         /* SMI over ethernet bridge when started, quantum time (us), no quanta limit */
+  },
+  {
+    d_EVENT_ProcessMmcBackground, 2000, 0     /* Event log drain, quantum time (us), no quanta limit */
+  },
+  {
+    d_RAM_StackBackground, 20, 4              /* Stack check, quantum time (us), 4 quanta per frame */
+  },
+  {
+    ach_servo_bus_background, 20, 0           /* Servo bus poll slots in the rest of the frame, quantum time (us), no quanta limit */
+  },
+  {
+    d_RAM_CodeCrcBackground, 50, 0            /* Code CRC scrub, quantum time (us), no quanta limit */
+  },
+  {
+    d_SHA256_VerifyBackground, 250, 0         /* Image hash verification when started, quantum time (us), no quanta limit */
+  },
+};
+
+/* Number of jobs */
+const Uint32_t d_SCHED_BACKGROUND_JOB_COUNT = (sizeof(d_SCHED_BackgroundJobs) / sizeof(d_SCHED_BackgroundJob_t));
+
+/***** Type Definitions *************************************************/
+
+/***** Variables ********************************************************/
+
+/***** Function Declarations ********************************************/
+
+/***** Function Definitions *********************************************/
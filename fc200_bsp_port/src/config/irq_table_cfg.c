@@ -26,6 +26,7 @@
 #include "soc/dma/d_dma.h"
 #include "soc/can/d_can.h"
 #include "soc/spi/d_spi.h"
+#include "soc/sata/d_sata.h"
 #include "sru/spi_pl/d_spi_pl.h"
 #include "soc/discrete/d_discrete.h"
 #include "driver/gnss/d_gnss_ublox.h"
@@ -223,7 +224,7 @@ const d_INT_IrqVectorTable_t IrqVectorTable[MAXIMUM_IRQ] =
      {d_DMA_InterruptHandler, 14},       /* 162 - XPS_ZDMA_CH6_INT_ID */
      {d_DMA_InterruptHandler, 15},       /* 163 - XPS_ZDMA_CH7_INT_ID */
      {NULL, 0},                          /* 164 - */
-     {NULL, 0},                          /* 165 - */
+     {d_SATA_InterruptHandler, 0},       /* 165 - SATA */
      {NULL, 0},                          /* 166 - */
      {NULL, 0},                          /* 167 - */
      {NULL, 0},                          /* 168 - XPS_XMPU_FPD_INT_ID */
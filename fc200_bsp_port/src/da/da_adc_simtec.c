@@ -6,6 +6,7 @@
  ****************************************************/
 
 #include "da_adc_simtec.h"
+#include "da_latency.h"
 #include "generic_util.h"
 #include "timer_interface.h"
 
@@ -38,6 +39,15 @@ static float AdcMsgRateHz;
 static uint16_t AdcMsgRateCounter;
 static bool Adc9CommTimeout;
 
+/* Arrival time of the start of header of the frame being deframed */
+static uint32_t AdcFrameTick;
+static bool AdcFrameTickValid;
+
+/* Latest published air data, see types_snapshot.h */
+static s_adc_snapshot_t AdcSnapshot __attribute__((aligned(32)));
+/* Set when a label was decoded since the last publication */
+static bool AdcLabelDecoded;
+
 
 typedef enum
 {
@@ -48,9 +58,10 @@ typedef enum
 } adc_deframe_states_t;
 
 /* private function prototypes */
-static void da_ads_parse_data(const uint8_t *ptr_byte);
+static void da_ads_parse_data(const uint8_t *ptr_byte, uint16_t byte_offset);
 static void da_ads_process_data(void);
 static void da_map_adc_data_and_flag(da_ads_label_t label, da_ads_data_t *data);
+static void da_adc_9_publish_snapshot(void);
 
 static uint16_t Status_Label = 0;
 static da_ads_data_t ADC_Data_Pool[MAX_ADC_LABEL_COUNT];
@@ -359,6 +370,20 @@ uint16_t da_get_adc_9_status(void)
 	return (Status_Label);
 }
 
+/**
+ * @brief Retrieves the latest published air data.
+ *
+ * The snapshot holds the air data signals used by the consumers with their
+ * validity. Its sequence changes only when a label was decoded or the link
+ * state changed.
+ *
+ * @return Pointer to the snapshot, unchanged until the next da_periodic()
+ */
+const s_adc_snapshot_t *da_get_adc_9_snapshot(void)
+{
+	return &AdcSnapshot;
+}
+
 /* Operation 'da_ads_init' of Class 'DA_ads' */
 /**
  * @brief Initializes the ADS UART interface.
@@ -404,8 +429,17 @@ bool da_adc_9_init(void)
 void da_adc_9_read_periodic(void)
 {
 	/* SyncableUserCode{7121996B-F893-4085-92C1-FFF4ABC7C697}:MOf5bfT9uu */
+	bool timeout_before = Adc9CommTimeout;
+
 	da_ads_process_data();
 	Adc9CommTimeout = timer_check_expiry(&Adc9MonitorTimer);
+
+	/* Publish once per cycle, after every label of the cycle is decoded */
+	if ((AdcLabelDecoded == true) || (Adc9CommTimeout != timeout_before))
+	{
+		da_adc_9_publish_snapshot();
+		AdcLabelDecoded = false;
+	}
 	/* SyncableUserCode{7121996B-F893-4085-92C1-FFF4ABC7C697} */
 }
 
@@ -438,12 +472,41 @@ static void da_ads_process_data(void)
 		for (byte_id = 0; byte_id < bytes_read; byte_id++)
 		{
 			/*Apply Deframing Logic */
-			da_ads_parse_data(&ADC_RxPacket[byte_id]);
+			da_ads_parse_data(&ADC_RxPacket[byte_id], byte_id);
 		}
 	}
 	/* SyncableUserCode{1CC49295-17BB-4466-8D04-4C79B38942A6} */
 }
 
+/**
+ * @brief Publishes the air data pool as a new snapshot.
+ */
+static void da_adc_9_publish_snapshot(void)
+{
+	s_adc_snapshot_t *snap = &AdcSnapshot;
+	uint32_t valid = 0U;
+
+	valid |= (ADC_Data_Pool[SOH1_CAS].Data_Flag == FLAG_VALID) ? ADC_SNAP_VALID_CAS : 0U;
+	valid |= (ADC_Data_Pool[SOH1_AOA].Data_Flag == FLAG_VALID) ? ADC_SNAP_VALID_AOA : 0U;
+	valid |= (ADC_Data_Pool[SOH1_AOS].Data_Flag == FLAG_VALID) ? ADC_SNAP_VALID_AOS : 0U;
+	valid |= (ADC_Data_Pool[SOH1_SAT].Data_Flag == FLAG_VALID) ? ADC_SNAP_VALID_OAT : 0U;
+	valid |= (ADC_Data_Pool[SOH1_HP].Data_Flag == FLAG_VALID) ? ADC_SNAP_VALID_ALT : 0U;
+	valid |= (Adc9CommTimeout == false) ? ADC_SNAP_VALID_LINK : 0U;
+	valid |= (ADC_Data_Pool[SOH2_HBARO].Data_Flag == FLAG_VALID) ? ADC_SNAP_VALID_BARO : 0U;
+
+	snap->valid = valid;
+	snap->sample_time = ADC_Data_Pool[SOH1_CAS].Sample_Time;
+	snap->cas = ADC_Data_Pool[SOH1_CAS].Data;
+	snap->aoa = ADC_Data_Pool[SOH1_AOA].Data;
+	snap->aos = ADC_Data_Pool[SOH1_AOS].Data;
+	snap->oat = ADC_Data_Pool[SOH1_SAT].Data;
+	snap->alt = ADC_Data_Pool[SOH1_HP].Data;
+	snap->alt_baro = ADC_Data_Pool[SOH2_HBARO].Data;
+	snap->status = Status_Label;
+
+	snap->sequence++;
+}
+
 /* Operation 'da_ads_parse_data' of Class 'DA_ads' */
 /**
  * @brief Parses incoming data bytes according to the ADC deframing state machine.
@@ -454,6 +517,7 @@ static void da_ads_process_data(void)
  * transitions (SOH, HEADER, STATUS, DATA) and updates relevant data pools and flags.
  *
  * @param ptr_byte Pointer to the incoming byte to be parsed. If NULL, the function does nothing.
+ * @param byte_offset Offset of the byte in the latest UART read, used to timestamp the frame.
  *
  * @note
  * - The function uses static variables to maintain state across calls.
@@ -461,7 +525,7 @@ static void da_ads_process_data(void)
  * - Validity of data and labels is checked against predefined tables and flags.
  * - The function is not thread-safe due to static state.
  */
-static void da_ads_parse_data(const uint8_t *ptr_byte)
+static void da_ads_parse_data(const uint8_t *ptr_byte, uint16_t byte_offset)
 {
 	/* SyncableUserCode{9D076C2D-36A0-4c14-98E6-5C59543C1502}:MOf5bfT9uu */
 	static adc_deframe_states_t state = SOH;
@@ -482,6 +546,8 @@ static void da_ads_parse_data(const uint8_t *ptr_byte)
 			if (*ptr_byte >= SOH1 && *ptr_byte <= SOH6)
 			{
 				soh = *ptr_byte;
+				/* The frame is timed from the arrival of its start of header */
+				AdcFrameTickValid = uart_get_arrival_tick(UART_ADS, byte_offset, &AdcFrameTick);
 				byte_count = 0;
 				util_memset(data_buffer, 0, PACKET_SIZE);
 				state = HEADER;
@@ -541,6 +607,7 @@ static void da_ads_parse_data(const uint8_t *ptr_byte)
 				{
 					/* Convert ASCII to Unsigned integer word */
 					util_ascii_hex_to_uword((char *)data_buffer, (uint16_t *)&Status_Label);
+					AdcLabelDecoded = true;
 				}
 
 				/* Reset the state machine */
@@ -576,6 +643,9 @@ static void da_ads_parse_data(const uint8_t *ptr_byte)
 					/* Decode the data Acquired  until now */
 					util_ascii_hex_to_float((uint8_t *)data_buffer, &ADC_Data_Pool[(uint8_t)param_id_ref].Data);
 					ADC_Data_Pool[(uint8_t)param_id_ref].Data_Flag = validity_status;
+					/* Stamp the data with the arrival of its frame */
+					da_latency_stamp(DA_SENSOR_ADC, &ADC_Data_Pool[(uint8_t)param_id_ref].Sample_Time, AdcFrameTickValid, AdcFrameTick);
+					AdcLabelDecoded = true;
 
 					/*-------- Compute Message Data Rate  --------*/
 					/* Increment counter to compute ADC inbound message rate */
@@ -613,6 +683,8 @@ static void da_ads_parse_data(const uint8_t *ptr_byte)
 			if (*ptr_byte >= SOH1 && *ptr_byte <= SOH6)
 			{
 				soh = *ptr_byte;
+				/* The frame is timed from the arrival of its start of header */
+				AdcFrameTickValid = uart_get_arrival_tick(UART_ADS, byte_offset, &AdcFrameTick);
 				byte_count = 0;
 				util_memset(data_buffer, 0, PACKET_SIZE);
 				state = HEADER;
@@ -33,6 +33,7 @@ typedef struct
 {
     float Data;
     da_ads_data_validity_t Data_Flag;
+    s_sample_time_t Sample_Time; /* Arrival time of the frame the data was decoded from */
 
 } da_ads_data_t;
 
@@ -5,6 +5,7 @@
  *  Copyright: LODD (c) 2025
  ****************************************************/
 #include "da_ins_il.h"
+#include "da_latency.h"
 #include "generic_util.h"
 #include "timer_interface.h"
 #include <math.h>
@@ -39,6 +40,18 @@
 
 #define INS_PERIODIC_TIMEOUT (60)
 
+/* Longest sample age that is predicted forward, older data is returned as received */
+#ifndef INS_PREDICTION_MAX_US
+#define INS_PREDICTION_MAX_US (50000U)
+#endif
+
+/* Smallest cosine of pitch at which the Euler angle rates are used for prediction */
+#define INS_PREDICTION_MIN_COS_PITCH (0.1f)
+
+#define TWO_PI_F (6.2831853f)
+#define R2D (57.2957795130823)
+#define EARTH_RADIUS_M (6371000.0) /* Mean earth radius, spherical model */
+
 #define UDD_DATA_OFFSET (26) /* Start of relevant data payload in UDD mode */
 
 /* Enumerated type to run the deframing state machine */
@@ -76,15 +89,28 @@ static s_da_ins_udd_t UddRawData;
  */
 static s_ins_d_scaled_data_t InsProcessedData;
 
+/**
+ * @brief Arrival time of the first byte of the frame being deframed
+ *
+ */
+static uint32_t InsFrameTick;
+static bool InsFrameTickValid;
+
 static s_timer_data_t InsMonitorTimer;
 static s_timer_data_t InsDataRateMon;
 static bool InsCommTimeout;
 
+/**
+ * @brief Latest published INS data, see types_snapshot.h
+ *
+ */
+static s_ins_snapshot_t InsSnapshot __attribute__((aligned(32)));
+
 uint16_t InsMsgRateCounter; /* Counter to track INS inbound message rate */
 float InsMsgRateHz;         /* Calculated INS inbound data rate in Hz */
 
 /* private function prototypes */
-static void da_ins_il_parse_data(const uint8_t *ptr_byte);
+static void da_ins_il_parse_data(const uint8_t *ptr_byte, uint16_t byte_offset);
 static void da_ins_il_process_data(void);
 static void da_ins_il_decode(void);
 
@@ -128,6 +154,8 @@ static void da_ins_il_scale_gnss_pos_std(s_gnss_data_std_t *ptr_gns_pos_std);
 static void da_ins_il_scale_gdop_pdop(s_gdop_pdop_t *ptr_gdop_pdop);
 static void da_ins_il_inspect_att_invalid(void);
 static void da_ins_il_inspect_position_invalid(void);
+static float da_ins_il_prediction_interval(void);
+static void da_ins_il_publish_snapshot(void);
 
 /**
  * @brief Retrieves the Euler angles (roll, pitch, yaw) from the INS system.
@@ -584,6 +612,106 @@ float da_get_ins_msg_rate_hz(void)
     return InsMsgRateHz;
 }
 
+/**
+ * @brief Retrieves the latest published INS data.
+ *
+ * The snapshot holds every INS signal used by the consumers together with
+ * its validity, so one read replaces the per-field getters. Its sequence
+ * changes only when a frame was decoded or the link state changed.
+ *
+ * @return Pointer to the snapshot, unchanged until the next da_periodic()
+ */
+const s_ins_snapshot_t *da_get_ins_il_snapshot(void)
+{
+    return &InsSnapshot;
+}
+
+/**
+ * @brief Retrieves the Euler angles carried forward to the time of the call.
+ *
+ * The latest attitude is integrated over the age of its sample using the body
+ * rates of the same sample, compensating the transport and buffering delay
+ * between the INS and the control instant. Data older than
+ * INS_PREDICTION_MAX_US, or without a known arrival time, is returned as
+ * received.
+ *
+ * @param[out] roll  Pointer to a float where the roll angle will be stored.
+ * @param[out] pitch Pointer to a float where the pitch angle will be stored.
+ * @param[out] yaw   Pointer to a float where the yaw angle will be stored.
+ *
+ * @return true if the Euler angles are valid; false otherwise.
+ */
+bool da_get_ins_il_predicted_euler_angles(float *roll, float *pitch, float *yaw)
+{
+    bool status = da_get_ins_il_euler_angles(roll, pitch, yaw);
+    float dt = da_ins_il_prediction_interval();
+
+    if ((status == true) && (dt > 0.0f) && (0 == InsProcessedData.unit_status_word.s_status_bits.s_gyro_status))
+    {
+        float p = InsProcessedData.scaled_imu_data.gyro_x;
+        float q = InsProcessedData.scaled_imu_data.gyro_y;
+        float r = InsProcessedData.scaled_imu_data.gyro_z;
+        float sin_roll = sinf(*roll);
+        float cos_roll = cosf(*roll);
+        float cos_pitch = cosf(*pitch);
+
+        /* Euler angle rates are singular at +/-90 degrees pitch */
+        if (fabsf(cos_pitch) > INS_PREDICTION_MIN_COS_PITCH)
+        {
+            float qr = (q * sin_roll) + (r * cos_roll);
+
+            *roll = *roll + ((p + ((qr * sinf(*pitch)) / cos_pitch)) * dt);
+            *pitch = *pitch + (((q * cos_roll) - (r * sin_roll)) * dt);
+            *yaw = *yaw + ((qr / cos_pitch) * dt);
+
+            /* Heading is reported in the range 0 to 360 degrees */
+            if (*yaw >= TWO_PI_F)
+            {
+                *yaw = *yaw - TWO_PI_F;
+            }
+            else if (*yaw < 0.0f)
+            {
+                *yaw = *yaw + TWO_PI_F;
+            }
+        }
+    }
+
+    return status;
+}
+
+/**
+ * @brief Retrieves the position carried forward to the time of the call.
+ *
+ * The latest position is moved along the NED velocity of the same sample for
+ * the age of the sample. Data older than INS_PREDICTION_MAX_US, or without a
+ * known arrival time, is returned as received.
+ *
+ * @param[out] latitude     Pointer to a double where the latitude [deg] will be stored.
+ * @param[out] longitude    Pointer to a double where the longitude [deg] will be stored.
+ * @param[out] gps_altitude Pointer to a float where the altitude [m] will be stored.
+ *
+ * @return true if the position is valid; false otherwise.
+ */
+bool da_get_ins_il_predicted_position(double *latitude, double *longitude, float *gps_altitude)
+{
+    bool status = da_get_ins_il_position(latitude, longitude, gps_altitude);
+    float dt = da_ins_il_prediction_interval();
+
+    if ((status == true) && (dt > 0.0f))
+    {
+        double cos_lat = cos(*latitude * D2R);
+
+        *latitude = *latitude + (((double)InsProcessedData.scaled_inertial_vel.vel_n * (double)dt / EARTH_RADIUS_M) * R2D);
+        if (fabs(cos_lat) > 1.0e-6)
+        {
+            *longitude = *longitude + (((double)InsProcessedData.scaled_inertial_vel.vel_e * (double)dt / (EARTH_RADIUS_M * cos_lat)) * R2D);
+        }
+        *gps_altitude = *gps_altitude - (InsProcessedData.scaled_inertial_vel.vel_d * dt);
+    }
+
+    return status;
+}
+
 /**
  * @brief Retrieves the latest valid UDD (User Defined Data) from the IMU message.
  *
@@ -683,6 +811,8 @@ static void da_ins_il_process_data(void)
     /* SyncableUserCode{F102D825-B00A-4f55-9B8C-46FC67A9FBFC}:1Li0sadfbu */
     uint16_t bytes_read;
     uint16_t byte_id;
+    bool decoded = false;
+    bool timeout_before = InsCommTimeout;
 
     /* UART Read IMU Buffer */
     bytes_read = uart_read((uint8_t)UART_INS, &INS_RxPacket[0], IMU_BUFFER_SIZE);
@@ -694,23 +824,93 @@ static void da_ins_il_process_data(void)
         for (byte_id = 0; byte_id < bytes_read; byte_id++)
         {
             /*Apply Deframing Logic */
-            da_ins_il_parse_data(&INS_RxPacket[byte_id]);
+            da_ins_il_parse_data(&INS_RxPacket[byte_id], byte_id);
 
             /* if checksum is verified successfully */
             if (imu_msg.flag == IL_DCODE_CRC_OK)
             {
                 /* Decode the received data */
                 da_ins_il_decode();
-                
+
+                /* Stamp the data with the arrival of its frame */
+                da_latency_stamp(DA_SENSOR_INS, &InsProcessedData.sample_time, InsFrameTickValid, InsFrameTick);
+                decoded = true;
             }
         }
     }
 
     /* Check for timer expiry */
     InsCommTimeout = timer_check_expiry(&InsMonitorTimer);
+
+    /* Publish once per cycle, after every frame of the cycle is decoded */
+    if ((decoded == true) || (InsCommTimeout != timeout_before))
+    {
+        da_ins_il_publish_snapshot();
+    }
     /* SyncableUserCode{F102D825-B00A-4f55-9B8C-46FC67A9FBFC} */
 }
 
+/**
+ * @brief Publishes the decoded INS data as a new snapshot.
+ *
+ * The validity of each signal is evaluated here once, rather than by each
+ * consumer on each read.
+ *
+ * @internal - Private function for the module.
+ */
+static void da_ins_il_publish_snapshot(void)
+{
+    s_ins_snapshot_t *snap = &InsSnapshot;
+    uint32_t valid = 0U;
+
+    valid |= (false == InsProcessedData.attitude_invalid) ? INS_SNAP_VALID_ATT : 0U;
+    valid |= (0 == InsProcessedData.unit_status_word.s_status_bits.s_gyro_status) ? INS_SNAP_VALID_OMG : 0U;
+    valid |= (0 == InsProcessedData.unit_status_word.s_status_bits.s_acc_status) ? INS_SNAP_VALID_ACC : 0U;
+    valid |= (false == InsProcessedData.position_invalid) ? INS_SNAP_VALID_POS : 0U;
+    valid |= (false == InsCommTimeout) ? INS_SNAP_VALID_LINK : 0U;
+
+    snap->valid = valid;
+    snap->sample_time = InsProcessedData.sample_time;
+    snap->lat = InsProcessedData.scaled_position.lat;
+    snap->lon = InsProcessedData.scaled_position.lon;
+    snap->alt_gps = InsProcessedData.scaled_position.alt;
+
+    snap->euler_rpy[0] = InsProcessedData.scaled_euler_angle.roll;
+    snap->euler_rpy[1] = InsProcessedData.scaled_euler_angle.pitch;
+    snap->euler_rpy[2] = InsProcessedData.scaled_euler_angle.yaw;
+    snap->omg_xyz[0] = InsProcessedData.scaled_imu_data.gyro_x;
+    snap->omg_xyz[1] = InsProcessedData.scaled_imu_data.gyro_y;
+    snap->omg_xyz[2] = InsProcessedData.scaled_imu_data.gyro_z;
+    snap->acc_xyz[0] = InsProcessedData.scaled_imu_data.accel_x;
+    snap->acc_xyz[1] = InsProcessedData.scaled_imu_data.accel_y;
+    snap->acc_xyz[2] = InsProcessedData.scaled_imu_data.accel_z;
+    snap->vel_ned[0] = InsProcessedData.scaled_inertial_vel.vel_n;
+    snap->vel_ned[1] = InsProcessedData.scaled_inertial_vel.vel_e;
+    snap->vel_ned[2] = InsProcessedData.scaled_inertial_vel.vel_d;
+
+    snap->eph = InsProcessedData.scaled_h_v_pos_err.eph;
+    snap->epv = InsProcessedData.scaled_h_v_pos_err.epv;
+    snap->pdop = InsProcessedData.scaled_gp_dop.pdop;
+    snap->alt_baro = InsProcessedData.scaled_baro_data.baro_h;
+    snap->temperature = InsProcessedData.scaled_temp.insd_temperature;
+
+    snap->gnss_sat_used = InsProcessedData.no_of_sat_used.num_satellites;
+    snap->gnss_pos_type = InsProcessedData.gnss_info_short.gnss_info1.gnss_info1_bits.position_type;
+    snap->gnss_sol_status = InsProcessedData.gnss_info_short.gnss_info2.gnss_info2_bits.solution_status;
+    snap->gnss_info1 = InsProcessedData.gnss_info_short.gnss_info1.raw_gnss_info1;
+    snap->gnss_info2 = InsProcessedData.gnss_info_short.gnss_info2.raw_gnss_info2;
+    snap->ins_sol_status = InsProcessedData.nav_soln_status.status;
+
+    snap->kf_pos_cov_lla[0] = InsProcessedData.scaled_pos_cov.lat_std;
+    snap->kf_pos_cov_lla[1] = InsProcessedData.scaled_pos_cov.lon_std;
+    snap->kf_pos_cov_lla[2] = InsProcessedData.scaled_pos_cov.alt_std;
+    snap->kf_vel_cov_ned[0] = InsProcessedData.scaled_vel_cov.vel_n_std;
+    snap->kf_vel_cov_ned[1] = InsProcessedData.scaled_vel_cov.vel_e_std;
+    snap->kf_vel_cov_ned[2] = InsProcessedData.scaled_vel_cov.vel_d_std;
+
+    snap->sequence++;
+}
+
 /**
  * @brief State machine chart for da_get_ins_il_parse_data
  *
@@ -759,11 +959,12 @@ static void da_ins_il_process_data(void)
  *   - Resets to STAGE1_HEADER0.
  *
  * @param ptr_byte pointer to single byte of received msg element
+ * @param byte_offset offset of the byte in the latest UART read, used to timestamp the frame
  *
  * @internal - Private function for the module.
  */
 /* Operation 'da_get_ins_il_parse_data' of Class 'DA_ins_d' */
-static void da_ins_il_parse_data(const uint8_t *ptr_byte)
+static void da_ins_il_parse_data(const uint8_t *ptr_byte, uint16_t byte_offset)
 {
     /* SyncableUserCode{A4BAA65C-736D-4612-886A-8E2B615C0D8B}:Nbrlk8aPUZ */
     static ins_deframe_states_t state = STAGE1_HEADER0;
@@ -786,6 +987,8 @@ static void da_ins_il_parse_data(const uint8_t *ptr_byte)
                 state = STAGE2_HEADER1;
                 /* Mark the beginning of decoding new packet */
                 imu_msg.flag = IL_DCODE_PENDING;
+                /* The frame is timed from the arrival of its first header byte */
+                InsFrameTickValid = uart_get_arrival_tick(UART_INS, byte_offset, &InsFrameTick);
                 /* Reset all the intermediate state machine variables */
                 msg_len = 0;
                 payload_len = 0;
@@ -961,6 +1164,8 @@ static void da_ins_il_parse_data(const uint8_t *ptr_byte)
                 state = STAGE2_HEADER1;
                 /* Mark the beginning of decoding new packet */
                 imu_msg.flag = IL_DCODE_PENDING;
+                /* The frame is timed from the arrival of its first header byte */
+                InsFrameTickValid = uart_get_arrival_tick(UART_INS, byte_offset, &InsFrameTick);
                 /* Reset all the intermediate state machine variables */
                 msg_len = 0;
                 payload_len = 0;
@@ -2096,3 +2301,23 @@ static void da_ins_il_inspect_position_invalid(void)
         InsProcessedData.position_invalid = true;
     }
 }
+
+/**
+ * @brief Returns the interval over which the latest INS sample is predicted.
+ *
+ * @return float Age of the sample in seconds, 0 if it is unknown or too old to predict.
+ *
+ * @internal - Private function for the module.
+ */
+static float da_ins_il_prediction_interval(void)
+{
+    float dt = 0.0f;
+    uint32_t age_us;
+
+    if ((da_get_sample_age_us(DA_SENSOR_INS, &age_us) == true) && (age_us <= INS_PREDICTION_MAX_US))
+    {
+        dt = (float)age_us * 1.0e-6f;
+    }
+
+    return dt;
+}
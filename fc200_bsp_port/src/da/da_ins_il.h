@@ -619,6 +619,7 @@ typedef struct
     uint8_t Latency_ms_pos; /* latencies of time stamps in the GNSS receiver’s position */
     uint8_t Latency_ms_vel; /* latencies of time stamps in the GNSS receiver’s velocity */
     s_unscaled_pos_data_t unscaled_pos;
+    s_sample_time_t sample_time; /* Arrival time of the frame the data was decoded from */
 
 } s_ins_d_scaled_data_t;
 
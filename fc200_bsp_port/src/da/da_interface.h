@@ -11,6 +11,8 @@
 #include "types_ins.h"
 #include "types_ads.h"
 #include "types_sbus.h"
+#include "types_latency.h"
+#include "types_snapshot.h"
 
 /* Implementation of operation 'da_init' from interface 'DA_interface' */
 void da_init(void);
@@ -63,6 +65,9 @@ bool da_get_ins_il_accel_invalid(void);
 bool da_get_ins_il_pos_invalid(void);
 
 float da_get_ins_msg_rate_hz(void);
+/* Attitude and position carried forward from the sample arrival to the time of the call */
+bool da_get_ins_il_predicted_euler_angles(float *roll, float *pitch, float *yaw);
+bool da_get_ins_il_predicted_position(double *latitude, double *longitude, float *gps_altitude);
 
 /*--------------------------------ADC 9 GETTERS -------------------------------------*/
 bool da_get_adc_9_data(adc_data_type_t signal_name, float *data);
@@ -92,4 +97,17 @@ float da_get_radalt_msg_rate_hz(void);
 bool da_get_sbus_timeout(void);
 bool da_get_ep_data(rc_input_t *rc_input);
 
+/*--------------------------------- SAMPLE TIMING -----------------------------------*/
+/* Age of the latest sample of a sensor, measured from the arrival of its first byte */
+bool da_get_sample_age_us(da_sensor_t sensor, uint32_t *age_us);
+/* Histogram of the time from arrival of a sample to its decode */
+bool da_get_latency_hist(da_sensor_t sensor, s_latency_hist_t *hist);
+
+/*--------------------------------- SNAPSHOTS ---------------------------------------*/
+/* Latest data of a source with its validity and sequence, see types_snapshot.h.
+   Prefer these to the per-field getters, which remain for the INS prediction. */
+const s_ins_snapshot_t *da_get_ins_il_snapshot(void);
+const s_adc_snapshot_t *da_get_adc_9_snapshot(void);
+const s_radalt_snapshot_t *da_get_radalt_snapshot(void);
+
 #endif /* H_DA_INTERFACE */
@@ -0,0 +1,121 @@
+/****************************************************
+ *  da_latency.c
+ *  Created on: 18-Oct-2025
+ *  Implementation of the Class da_latency
+ *  Copyright: LODD (c) 2025
+ ****************************************************/
+#include "da_latency.h"
+#include "timer_interface.h"
+
+/**
+ * @brief Arrival time of the latest sample of each sensor
+ *
+ */
+static s_sample_time_t SampleTime[DA_SENSOR_MAX];
+
+/**
+ * @brief Decode latency histogram of each sensor
+ *
+ */
+static s_latency_hist_t LatencyHist[DA_SENSOR_MAX];
+
+/**
+ * @brief Stamps a decoded sample with the arrival time of its frame.
+ *
+ * The arrival time is that of the first byte of the frame, as marked by the
+ * receive interrupt. The time from arrival to decode is added to the latency
+ * histogram of the sensor, a sample without a known arrival time is counted
+ * as untimed.
+ *
+ * @param sensor Sensor that produced the sample
+ * @param ptr_time Sample time held with the decoded data, updated
+ * @param arrival_known True if arrival_tick is valid
+ * @param arrival_tick Timer tick at which the first byte of the frame was received
+ */
+void da_latency_stamp(da_sensor_t sensor, s_sample_time_t *ptr_time, bool arrival_known, uint32_t arrival_tick)
+{
+    if ((ptr_time != NULL) && (sensor < DA_SENSOR_MAX))
+    {
+        s_latency_hist_t *hist = &LatencyHist[sensor];
+
+        ptr_time->sequence++;
+        ptr_time->valid = arrival_known;
+
+        if (arrival_known == true)
+        {
+            uint32_t latency_us = timer_elapsed_us(arrival_tick);
+            uint32_t bin = latency_us / LATENCY_HIST_BIN_US;
+
+            if (bin >= LATENCY_HIST_BINS)
+            {
+                bin = LATENCY_HIST_BINS - 1U;
+            }
+
+            ptr_time->arrival_tick = arrival_tick;
+            ptr_time->decode_us = latency_us;
+
+            hist->bins[bin]++;
+            hist->samples++;
+            hist->last_us = latency_us;
+            if (latency_us > hist->max_us)
+            {
+                hist->max_us = latency_us;
+            }
+        }
+        else
+        {
+            hist->untimed++;
+        }
+
+        SampleTime[sensor] = *ptr_time;
+    }
+}
+
+/**
+ * @brief Retrieves the age of the latest sample of a sensor.
+ *
+ * The age is the time since the first byte of the sample's frame was received,
+ * measured when this function is called, so a caller at the control instant
+ * gets the full transport, buffering and scheduling delay of the data.
+ *
+ * @param[in]  sensor Sensor of interest
+ * @param[out] age_us Age of the latest sample in microseconds
+ *
+ * @return true if a timed sample has been decoded; false otherwise.
+ */
+bool da_get_sample_age_us(da_sensor_t sensor, uint32_t *age_us)
+{
+    bool status = false;
+
+    if ((age_us != NULL) && (sensor < DA_SENSOR_MAX))
+    {
+        if (SampleTime[sensor].valid == true)
+        {
+            *age_us = timer_elapsed_us(SampleTime[sensor].arrival_tick);
+            status = true;
+        }
+    }
+
+    return status;
+}
+
+/**
+ * @brief Retrieves the decode latency histogram of a sensor.
+ *
+ * @param[in]  sensor Sensor of interest
+ * @param[out] hist Copy of the histogram
+ *
+ * @return true if the histogram was copied; false if a parameter is invalid.
+ */
+bool da_get_latency_hist(da_sensor_t sensor, s_latency_hist_t *hist)
+{
+    bool status = false;
+
+    if ((hist != NULL) && (sensor < DA_SENSOR_MAX))
+    {
+        *hist = LatencyHist[sensor];
+        status = true;
+    }
+
+    return status;
+}
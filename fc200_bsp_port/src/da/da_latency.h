@@ -0,0 +1,16 @@
+/****************************************************
+ *  da_latency.h
+ *  Created on: 18-Oct-2025
+ *  Implementation of the Class da_latency
+ *  Copyright: LODD (c) 2025
+ ****************************************************/
+#ifndef H_DA_LATENCY
+#define H_DA_LATENCY
+
+#include "da_interface.h"
+#include "types_latency.h"
+
+/* Stamp a decoded sample with the arrival time of its first byte and record its decode latency */
+void da_latency_stamp(da_sensor_t sensor, s_sample_time_t *ptr_time, bool arrival_known, uint32_t arrival_tick);
+
+#endif /* H_DA_LATENCY */
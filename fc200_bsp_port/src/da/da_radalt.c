@@ -5,6 +5,7 @@
  *  Copyright: LODD (c) 2025
  ****************************************************/
 #include "da_radalt.h"
+#include "da_latency.h"
 #include "generic_util.h"
 #include "timer_interface.h"
 
@@ -46,9 +47,10 @@ typedef enum
 } radalt_deframe_states_t;
 
 /* private function prototypes */
-static void da_radalt_parse_data(radalt_msg_s *msg, const uint8_t *ptr_byte);
+static void da_radalt_parse_data(radalt_msg_s *msg, const uint8_t *ptr_byte, uint16_t byte_offset);
 static void da_radalt_process_data(void);
 static void da_radalt_msg_decode(radalt_s *ptr_radalt, const radalt_msg_s *msg);
+static void da_radalt_publish_snapshot(void);
 
 static radalt_s radalt;
 
@@ -60,6 +62,17 @@ static uint16_t RadaltMsgRateCounter;
 
 static bool RadaltCommTimeout;
 
+/**
+ * @brief Latest published radar altimeter data, see types_snapshot.h
+ */
+static s_radalt_snapshot_t RadaltSnapshot __attribute__((aligned(32)));
+
+/**
+ * @brief Arrival time of the packet head of the frame being deframed
+ */
+static uint32_t RadaltFrameTick;
+static bool RadaltFrameTickValid;
+
 /**
  * @brief Actual message structs
  */
@@ -114,6 +127,16 @@ bool da_get_radalt_timeout(void)
     return RadaltCommTimeout;
 }
 
+/**
+ * @brief Retrieves the latest published radar altimeter data.
+ *
+ * @return Pointer to the snapshot, unchanged until the next da_periodic()
+ */
+const s_radalt_snapshot_t *da_get_radalt_snapshot(void)
+{
+    return &RadaltSnapshot;
+}
+
 /* Operation 'da_radalt_init' of Class 'DA_radalt' */
 bool da_radalt_init(void)
 {
@@ -173,6 +196,9 @@ static void da_radalt_process_data(void)
         radalt.counter++;
     }
 
+    bool decoded = false;
+    bool timeout_before = RadaltCommTimeout;
+
     // Make sure that message structure is reset
     util_memset(&radalt_msg, 0, sizeof(us_d1_msg_s));
 
@@ -182,17 +208,22 @@ static void da_radalt_process_data(void)
     {
         for (uint16_t i = 0; i < bytes_read; i++)
         {
-            da_radalt_parse_data(&radalt_msg, &radalt_recv_packet[i]);
+            da_radalt_parse_data(&radalt_msg, &radalt_recv_packet[i], i);
 
             if (radalt_msg.flag == RADALT_DCODE_CRC_OK)
             {
                 da_radalt_msg_decode(&radalt, &radalt_msg);
 
+                // Stamp the data with the arrival of its frame
+                da_latency_stamp(DA_SENSOR_RADALT, &radalt.sample_time, RadaltFrameTickValid, RadaltFrameTick);
+
                 // Reset message flag
                 radalt_msg.flag = 0;
 
                 // Reset radalt status counter
                 radalt.counter = 0;
+
+                decoded = true;
             }
             else
             {
@@ -220,17 +251,38 @@ static void da_radalt_process_data(void)
     /* Check for RADALT timeout counter */
     RadaltCommTimeout = timer_check_expiry(&RadaltMonitorTimer);
 
+    // Publish once per cycle, after every frame of the cycle is decoded
+    if ((decoded == true) || (RadaltCommTimeout != timeout_before))
+    {
+        da_radalt_publish_snapshot();
+    }
+
     return;
     /* SyncableUserCode{64A23C09-6281-48f2-9446-ADC1EF2EBAAB} */
 }
 
+/**
+ * @brief Publishes the decoded radar altimeter data as a new snapshot.
+ */
+static void da_radalt_publish_snapshot(void)
+{
+    RadaltSnapshot.valid = ((radalt.flag == true) ? RADALT_SNAP_VALID_AGL : 0U) |
+                           ((RadaltCommTimeout == false) ? RADALT_SNAP_VALID_LINK : 0U);
+    RadaltSnapshot.sample_time = radalt.sample_time;
+    RadaltSnapshot.agl = radalt.agl;
+    RadaltSnapshot.snr = radalt.snr;
+
+    RadaltSnapshot.sequence++;
+}
+
 /**
  * @brief Processes a byte stream to decode messages from a radar altimeter.
  *
  *  @param msg Pointer to radalt_msg_s structure where the message data will be stored.
  * @param ptr_byte Pointer to the current byte in the byte stream being processed.
+ * @param byte_offset Offset of the byte in the latest UART read, used to timestamp the frame.
  */
-static void da_radalt_parse_data(radalt_msg_s *msg, const uint8_t *ptr_byte)
+static void da_radalt_parse_data(radalt_msg_s *msg, const uint8_t *ptr_byte, uint16_t byte_offset)
 {
 
     /* SyncableUserCode{D30B6B8D-CD96-4839-B73E-AA5EC3FEC7DB}:Nbrlk8aPUZ */
@@ -245,6 +297,8 @@ static void da_radalt_parse_data(radalt_msg_s *msg, const uint8_t *ptr_byte)
             /* Copy the Header */
             msg->us_d1_msg.header = *ptr_byte;
             msg->flag = RADALT_DCODE_PENDING;
+            /* The frame is timed from the arrival of its packet head */
+            RadaltFrameTickValid = uart_get_arrival_tick(UART_RADALT, byte_offset, &RadaltFrameTick);
             state = VERSION_ID;
         }
         else
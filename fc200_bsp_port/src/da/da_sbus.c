@@ -5,6 +5,7 @@
  *  Copyright: LODD (c) 2025
  ****************************************************/
 #include "da_sbus.h"
+#include "da_latency.h"
 #include "uart_interface.h"
 #include "timer_interface.h"
 #include "generic_util.h"
@@ -25,7 +26,7 @@
 
 /* private function prototypes */
 static void da_sbus_process_data(void);
-static void da_sbus_parse_data(uint8_t byte);
+static void da_sbus_parse_data(uint8_t byte, uint16_t byte_offset);
 static void da_sbus_decode(void);
 static void da_sbus_map_ep_input(void);
 
@@ -38,6 +39,8 @@ static s_timer_data_t SbusRssiTimer;
 static uint32_t RssiCounter = 0;
 static bool SbusCommTimeout = false;
 static rc_input_t RcInputEP = {0};
+static uint32_t SbusFrameTick;       /* Arrival time of the header byte of the frame being deframed */
+static bool SbusFrameTickValid;
 
 /**
  * @brief Retrieves the latest decoded SBUS frame if available.
@@ -175,7 +178,7 @@ static void da_sbus_process_data(void)
         /* Parse all the read bytes */
         for (uint16_t byte_index = 0; byte_index < bytes_read; ++byte_index)
         {
-            da_sbus_parse_data(Sbus_Uart_Rx_Pkt[byte_index]);
+            da_sbus_parse_data(Sbus_Uart_Rx_Pkt[byte_index], byte_index);
         }
     }
 
@@ -224,12 +227,13 @@ static void da_sbus_process_data(void)
  * frame (of size SBUS_FRAME_SIZE), it verifies the end byte and triggers frame decoding.
  *
  * @param byte The incoming SBUS data byte to be parsed.
+ * @param byte_offset Offset of the byte in the latest UART read, used to timestamp the frame.
  *
  * @note This function maintains internal static state to track frame boundaries and buffer index.
  *       It calls da_sbus_decode() when a valid SBUS frame is received.
  */
 /* Operation 'da_sbus_parse_data' of Class 'DA_sbus' */
-static void da_sbus_parse_data(uint8_t byte)
+static void da_sbus_parse_data(uint8_t byte, uint16_t byte_offset)
 {
     /* SyncableUserCode{DC7753CD-5354-479d-BA44-5097D3F5DD16}:Nbrlk8aPUZ */
     static bool new_frame_detected = false;
@@ -247,6 +251,8 @@ static void da_sbus_parse_data(uint8_t byte)
             Sbus_Buffer[Sbus_Index++] = byte;
             /* Set new frame detected flag */
             new_frame_detected = true;
+            /* The frame is timed from the arrival of its header byte */
+            SbusFrameTickValid = uart_get_arrival_tick(UART_SBUS, byte_offset, &SbusFrameTick);
         }
     }
     else
@@ -264,6 +270,8 @@ static void da_sbus_parse_data(uint8_t byte)
             {
                 /* Decode the received data */
                 da_sbus_decode();
+                /* Stamp the data with the arrival of its frame */
+                da_latency_stamp(DA_SENSOR_SBUS, &Rc_Input.Sample_Time, SbusFrameTickValid, SbusFrameTick);
             }
             /* Always reset index after full frame */
             Sbus_Index = 0;
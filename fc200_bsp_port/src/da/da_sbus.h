@@ -25,6 +25,7 @@ typedef struct rc_input_s
     int8_t SA, SB, SC, SD, SE, SF;     //!< SBUS Selector Channels
     uint32_t Sbus_Frames_Lost_Counter; //!< Used for GCS SBUS monitoring
     uint32_t Sbus_Counter;             //!< Used for GCS SBUS monitoring
+    s_sample_time_t Sample_Time;       //!< Arrival time of the frame the data was decoded from
 } rc_input_s;
 
 /* Operation 'da_sbus_init' of Class 'DA_sbus' */
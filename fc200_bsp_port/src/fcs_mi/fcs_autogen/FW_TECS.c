@@ -175,7 +175,7 @@ void FW_TECS(const real_T *rtu_FW_TECS_switcher_h_dot_cmd, const real_T
     /* Gain: '<S3>/Gain' incorporates:
      *  Sum: '<S3>/Sum'
      */
-    rtb_Add1 = 0.2 * ((*rtu_FW_TECS_switcher_h_cmd) - rtu_Sensor->pos_lla[2]);
+    rtb_Add1 = RT_REAL64(0.2) * ((*rtu_FW_TECS_switcher_h_cmd) - rtu_Sensor->pos_lla[2]);
 
     /* Switch: '<S11>/Switch2' incorporates:
      *  Constant: '<S3>/Constant3'
@@ -38,7 +38,7 @@ FW_TECS_switcher_TZCE FW_TECS_switcher_PrevZCX;
  *    '<S119>/MATLAB Function1'
  *    '<S127>/MATLAB Function1'
  */
-void FW_TECS_switcher_illvnqr3hx(const real_T rtu_LLA[3], real_T rty_C[9])
+void FW_TECS_switcher_illvnqr3hx(const real64_T rtu_LLA[3], real_T rty_C[9])
 {
   real_T cos_lat;
   real_T cos_long;
@@ -107,23 +107,23 @@ void FW_TECS_switcher_Init(void)
 /* Output and update for referenced model: 'FW_TECS_switcher' */
 void FW_TECS_switcher(const vom_t *rtu_vom_status, const real_T
                       *rtu_Pilot_roll_ch, const real_T *rtu_Pilot_throttle_ch,
-                      const real_T rtu_Sensor_eul_ang[3], const real_T
+                      const real_T rtu_Sensor_eul_ang[3], const real64_T
                       rtu_Sensor_pos_lla[3], const real_T rtu_Sensor_vel_ned[3],
                       const real_T *rtu_Sensor_aspd_cas, const real_T
                       *rtu_Sensor_gspd, const real_T *rtu_Sensor_chi, const
-                      uint8_T *rtu_TECS_mode, const real_T
-                      *rtu_mode_data_ft_data_FT_x, const real_T
+                      uint8_T *rtu_TECS_mode, const real64_T
+                      *rtu_mode_data_ft_data_FT_x, const real64_T
                       *rtu_mode_data_ft_data_FT_y, const real_T
                       *rtu_mode_data_ft_data_FT_Altitude, const real_T
                       *rtu_mode_data_ft_data_FT_Heading, const real_T
                       *rtu_mode_data_ft_data_FT_AirspeedRef, const real_T
                       *rtu_mode_data_loiter_data_loiter_radius, const real_T
-                      *rtu_mode_data_loiter_data_loiter_direction, const real_T *
-                      rtu_mode_data_loiter_data_loiter_Center_Lat, const real_T *
+                      *rtu_mode_data_loiter_data_loiter_direction, const real64_T *
+                      rtu_mode_data_loiter_data_loiter_Center_Lat, const real64_T *
                       rtu_mode_data_loiter_data_loiter_Center_Lon, const real_T *
                       rtu_mode_data_loiter_data_loiter_altitude, const real_T
                       *rtu_mode_data_loiter_data_loiter_AirSpeedRef, const
-                      real_T *rtu_mode_data_bt_data_BT_Hover_Lat, const real_T
+                      real64_T *rtu_mode_data_bt_data_BT_Hover_Lat, const real64_T
                       *rtu_mode_data_bt_data_BT_Hover_Lon, const real_T
                       *rtu_mode_data_bt_data_BT_Altitude, const real_T
                       *rtu_mode_data_bt_data_BT_Heading, const lifter_state_t
@@ -132,8 +132,8 @@ void FW_TECS_switcher(const vom_t *rtu_vom_status, const real_T
                       *rtu_mode_data_fwrth_data_CAS_sp, const real_T
                       *rtu_mode_data_fwrth_data_alt_sp, const boolean_T
                       *rtu_wp_data_wp_list_valid, const uint16_T
-                      *rtu_wp_data_wp_list_count, const real_T
-                      *rtu_wp_data_cur_wp_lat, const real_T
+                      *rtu_wp_data_wp_list_count, const real64_T
+                      *rtu_wp_data_cur_wp_lat, const real64_T
                       *rtu_wp_data_cur_wp_lon, const real_T
                       *rtu_wp_data_cur_wp_alt, const uint16_T
                       *rtu_wp_data_cmd_wp_idx, const boolean_T
@@ -147,55 +147,55 @@ void FW_TECS_switcher(const vom_t *rtu_vom_status, const real_T
                       boolean_T *rty_FWRTH_SM_in_approach_circle_done, boolean_T
                       *rty_FWRTH_SM_in_reduce_speed_alt_done, boolean_T
                       *rty_FWRTH_SM_in_circle_align_done, boolean_T
-                      *rty_FWRTH_SM_in_cross_tangent_point_done, real_T
-                      *rty_FWRTH_SM_in_land_lat, real_T
+                      *rty_FWRTH_SM_in_cross_tangent_point_done, real64_T
+                      *rty_FWRTH_SM_in_land_lat, real64_T
                       *rty_FWRTH_SM_in_land_lon, real_T
                       *rty_FWRTH_SM_in_approach_ang, real_T
                       *rty_WP_SMdata_cur_leg_heading, real_T
                       *rty_WP_SMdata_cur_leg_length, real_T
                       *rty_WP_SMdata_cur_leg_remaining_dist, boolean_T
                       *rty_WP_SMdata_wp_list_valid, boolean_T
-                      *rty_WP_SMdata_last_wp_land, real_T
-                      *rty_WP_SMdata_land_wp_lat, real_T
+                      *rty_WP_SMdata_last_wp_land, real64_T
+                      *rty_WP_SMdata_land_wp_lat, real64_T
                       *rty_WP_SMdata_land_wp_lon, real_T
                       *rty_WP_SMdata_curpos_to_wp_heading, boolean_T
                       *rty_WP_SMdata_WPN_cmd_received)
 {
   real_T rtb_C_pex2miccv0[9];
   real_T rtb_VectorConcatenate[3];
-  real_T rtb_VectorConcatenate1[3];
+  real64_T rtb_VectorConcatenate1[3];
   real_T AC_idx_0;
   real_T AC_idx_0_0;
   real_T AC_idx_1;
   real_T AC_idx_1_0;
-  real_T AC_norm;
-  real_T AC_norm_tmp;
+  real64_T AC_norm;
+  real64_T AC_norm_tmp;
   real_T C_idx_0;
   real_T PB_norm;
-  real_T Vg;
-  real_T Vg_0;
-  real_T absxk;
-  real_T curvature;
-  real_T dir_idx_0;
-  real_T dir_idx_1;
-  real_T rtb_Product1_bkygj4a2su;
-  real_T rtb_Sqrt;
-  real_T rtb_Sqrt_jug5wuieqd;
-  real_T rtb_Sum_imgtnbczew_idx_1;
-  real_T rtb_Sum_imgtnbczew_tmp;
-  real_T rtb_Sum_imgtnbczew_tmp_0;
-  real_T rtb_Sum_lskvbzjz0i;
-  real_T rtb_TrigonometricFunction2_h0qciwy3lv_tmp;
-  real_T rtb_TrigonometricFunction2_i3ecl5ucim;
-  real_T rtb_TrigonometricFunction6_onwcg4eh52;
-  real_T rtb_TrigonometricFunction_paar0fmbpe;
-  real_T rtb_VectorConcatenate1_oigmvxpsrq_idx_0;
+  real64_T Vg;
+  real64_T Vg_0;
+  real64_T absxk;
+  real64_T curvature;
+  real64_T dir_idx_0;
+  real64_T dir_idx_1;
+  real64_T rtb_Product1_bkygj4a2su;
+  real64_T rtb_Sqrt;
+  real64_T rtb_Sqrt_jug5wuieqd;
+  real64_T rtb_Sum_imgtnbczew_idx_1;
+  real64_T rtb_Sum_imgtnbczew_tmp;
+  real64_T rtb_Sum_imgtnbczew_tmp_0;
+  real64_T rtb_Sum_lskvbzjz0i;
+  real64_T rtb_TrigonometricFunction2_h0qciwy3lv_tmp;
+  real64_T rtb_TrigonometricFunction2_i3ecl5ucim;
+  real64_T rtb_TrigonometricFunction6_onwcg4eh52;
+  real64_T rtb_TrigonometricFunction_paar0fmbpe;
+  real64_T rtb_VectorConcatenate1_oigmvxpsrq_idx_0;
   real_T rtb_VectorConcatenate1_oigmvxpsrq_idx_1;
-  real_T rtb_VectorConcatenate1_psilb5rrki_idx_0;
-  real_T rtb_VectorConcatenate1_psilb5rrki_idx_1;
-  real_T scale;
+  real64_T rtb_VectorConcatenate1_psilb5rrki_idx_0;
+  real64_T rtb_VectorConcatenate1_psilb5rrki_idx_1;
+  real64_T scale;
   real_T t;
-  real_T y;
+  real64_T y;
   int32_T i;
   boolean_T rtb_Compare_ag4sp0vjdy;
   boolean_T rtb_Compare_i5bisll1rb;
@@ -226,7 +226,7 @@ void FW_TECS_switcher(const vom_t *rtu_vom_status, const real_T
   /* Product: '<S19>/Product' incorporates:
    *  Constant: '<S19>/e'
    */
-  rtb_Sqrt = rtb_TrigonometricFunction2_i3ecl5ucim * 0.0818191908425;
+  rtb_Sqrt = rtb_TrigonometricFunction2_i3ecl5ucim * RT_REAL64(0.0818191908425);
 
   /* Sqrt: '<S19>/Sqrt' incorporates:
    *  Constant: '<S19>/const'
@@ -239,8 +239,8 @@ void FW_TECS_switcher(const vom_t *rtu_vom_status, const real_T
    *  Abs: '<S20>/Abs'
    *  Product: '<S20>/Product'
    */
-  if (rtb_Sqrt <= 0.001) {
-    rtb_Sqrt = -0.001;
+  if (rtb_Sqrt <= RT_REAL64(0.001)) {
+    rtb_Sqrt = -RT_REAL64(0.001);
   }
 
   /* End of Switch: '<S20>/Switch3' */
@@ -283,7 +283,7 @@ void FW_TECS_switcher(const vom_t *rtu_vom_status, const real_T
    *  Product: '<S97>/Product'
    *  Trigonometry: '<S14>/Trigonometric Function'
    */
-  AC_norm_tmp = curvature * 0.0818191908425;
+  AC_norm_tmp = curvature * RT_REAL64(0.0818191908425);
 
   /* Sqrt: '<S17>/Sqrt' incorporates:
    *  Constant: '<S17>/const'
@@ -305,8 +305,8 @@ void FW_TECS_switcher(const vom_t *rtu_vom_status, const real_T
    *  Product: '<S18>/Product'
    *  Sqrt: '<S17>/Sqrt'
    */
-  if (AC_norm_tmp <= 0.001) {
-    AC_norm = -0.001;
+  if (AC_norm_tmp <= RT_REAL64(0.001)) {
+    AC_norm = -RT_REAL64(0.001);
   }
 
   /* End of Switch: '<S18>/Switch3' */
@@ -387,8 +387,8 @@ void FW_TECS_switcher(const vom_t *rtu_vom_status, const real_T
   rtb_Sum_imgtnbczew_idx_1 = (dir_idx_1 * rtb_Sum_imgtnbczew_tmp_0) -
     (rtb_TrigonometricFunction6_onwcg4eh52 * sin
      (*rtu_mode_data_bt_data_BT_Hover_Lon));
-  dir_idx_0 = (curvature * ((0.993305620009879 * AC_norm) + rtu_Sensor_pos_lla[2]))
-    - (rtb_TrigonometricFunction2_i3ecl5ucim * ((0.993305620009879 * rtb_Sqrt) +
+  dir_idx_0 = (curvature * ((RT_REAL64(0.993305620009879) * AC_norm) + rtu_Sensor_pos_lla[2]))
+    - (rtb_TrigonometricFunction2_i3ecl5ucim * ((RT_REAL64(0.993305620009879) * rtb_Sqrt) +
         rtu_Sensor_pos_lla[2]));
 
   /* Product: '<S13>/Product' */
@@ -424,9 +424,9 @@ void FW_TECS_switcher(const vom_t *rtu_vom_status, const real_T
 
   /*  horizontal ground speed */
   /* '<S12>:1:12' if (Vg<0.01) */
-  if (rtb_TrigonometricFunction2_i3ecl5ucim < 0.01) {
+  if (rtb_TrigonometricFunction2_i3ecl5ucim < RT_REAL64(0.01)) {
     /* '<S12>:1:13' Vg =0.001; */
-    Vg = 0.001;
+    Vg = RT_REAL64(0.001);
   }
 
   /* '<S12>:1:16' vel_dir = vel_NE/Vg; */
@@ -435,7 +435,7 @@ void FW_TECS_switcher(const vom_t *rtu_vom_status, const real_T
   /* '<S12>:1:19' L1_zeta = 0.7; */
   /*  L1 damping ratio */
   /* '<S12>:1:20' L1 = L1_P*L1_zeta/pi*Vg; */
-  rtb_Sqrt = 3.3422538049298023 * Vg;
+  rtb_Sqrt = RT_REAL64(3.3422538049298023) * Vg;
 
   /*  L1 length */
   /* '<S12>:1:22' P = start_pos; */
@@ -475,13 +475,13 @@ void FW_TECS_switcher(const vom_t *rtu_vom_status, const real_T
   /* '<S12>:1:38' AB_dir = (B-A)/norm(B-A); */
   AC_idx_0 = (C_idx_0 + (dir_idx_0 * AC_norm)) - rtb_VectorConcatenate1[0];
   AC_idx_1 = (absxk + (dir_idx_1 * AC_norm)) - rtb_VectorConcatenate1[1];
-  scale = 3.3121686421112381E-170;
+  scale = RT_NRM2_SCALE;
   absxk = fabs(AC_idx_0);
-  if (absxk > 3.3121686421112381E-170) {
+  if (absxk > RT_NRM2_SCALE) {
     AC_norm = 1.0;
     scale = absxk;
   } else {
-    t = absxk / 3.3121686421112381E-170;
+    t = absxk / RT_NRM2_SCALE;
     AC_norm = t * t;
   }
 
@@ -523,26 +523,26 @@ void FW_TECS_switcher(const vom_t *rtu_vom_status, const real_T
                rtb_VectorConcatenate1_oigmvxpsrq_idx_1),
               (rtb_VectorConcatenate1_oigmvxpsrq_idx_0 * AC_idx_0) +
               (rtb_VectorConcatenate1_oigmvxpsrq_idx_1 * AC_idx_1));
-    if (y < -1.5707963267948966) {
-      y = -1.5707963267948966;
+    if (y < -RT_REAL64(1.5707963267948966)) {
+      y = -RT_REAL64(1.5707963267948966);
     }
 
-    if (y > 1.5707963267948966) {
-      y = 1.5707963267948966;
+    if (y > RT_REAL64(1.5707963267948966)) {
+      y = RT_REAL64(1.5707963267948966);
     }
 
     /* Trigonometry: '<S10>/Atan' incorporates:
      *  MATLAB Function: '<S10>/guidance_line'
      */
-    y = atan2(((1.9599999999999997 * (Vg * Vg)) / rtb_Sqrt) * sin(y), 9.81);
+    y = atan2(((RT_REAL64(1.9599999999999997) * (Vg * Vg)) / rtb_Sqrt) * sin(y), RT_REAL64(9.81));
 
     /* Saturate: '<S2>/Saturation2' */
-    if (y > 0.5236) {
+    if (y > RT_REAL64(0.5236)) {
       /* BusAssignment: '<S2>/Bus Assignment2' */
-      y = 0.5236;
-    } else if (y < -0.5236) {
+      y = RT_REAL64(0.5236);
+    } else if (y < -RT_REAL64(0.5236)) {
       /* BusAssignment: '<S2>/Bus Assignment2' */
-      y = -0.5236;
+      y = -RT_REAL64(0.5236);
     } else {
       /* no actions */
     }
@@ -570,8 +570,8 @@ void FW_TECS_switcher(const vom_t *rtu_vom_status, const real_T
   /* Switch: '<S65>/Switch3' incorporates:
    *  Product: '<S65>/Product'
    */
-  if (AC_norm_tmp <= 0.001) {
-    AC_norm = -0.001;
+  if (AC_norm_tmp <= RT_REAL64(0.001)) {
+    AC_norm = -RT_REAL64(0.001);
   }
 
   /* End of Switch: '<S65>/Switch3' */
@@ -593,7 +593,7 @@ void FW_TECS_switcher(const vom_t *rtu_vom_status, const real_T
    *  Product: '<S60>/Product2'
    *  Sum: '<S60>/Sum1'
    */
-  dir_idx_0 = curvature * ((0.993305620009879 * AC_norm) + rtu_Sensor_pos_lla[2]);
+  dir_idx_0 = curvature * ((RT_REAL64(0.993305620009879) * AC_norm) + rtu_Sensor_pos_lla[2]);
 
   /* Gain: '<S5>/Gain' */
   rtb_Product1_bkygj4a2su = 0.017453292519943295 *
@@ -616,7 +616,7 @@ void FW_TECS_switcher(const vom_t *rtu_vom_status, const real_T
    *  Sum: '<S77>/Sum'
    */
   AC_norm = rt_modd(rt_modd(((FW_TECS_switcher_ConstB.Atan2 + (rt_modd(rt_modd
-    (((rtb_Product1_bkygj4a2su + 3.1415926535897931) - -3.1415926535897931) +
+    (((rtb_Product1_bkygj4a2su + RT_REAL64(3.1415926535897931)) - -RT_REAL64(3.1415926535897931)) +
      FW_TECS_switcher_ConstB.Sum1_o5uamo4z5t,
      FW_TECS_switcher_ConstB.Sum1_o5uamo4z5t),
     FW_TECS_switcher_ConstB.Sum1_o5uamo4z5t) - 3.1415926535897931)) -
@@ -674,7 +674,7 @@ void FW_TECS_switcher(const vom_t *rtu_vom_status, const real_T
    *  Constant: '<S5>/AlAin_RTH_land'
    */
   rtb_VectorConcatenate1[1] = rtb_VectorConcatenate1_oigmvxpsrq_idx_0 +
-    0.97080864372042563;
+    RT_REAL64(0.97080864372042563);
 
   /* SignalConversion generated from: '<S44>/Vector Concatenate1' */
   rtb_VectorConcatenate1[2] = *rtu_mode_data_fwrth_data_alt_sp;
@@ -683,7 +683,7 @@ void FW_TECS_switcher(const vom_t *rtu_vom_status, const real_T
    *  Constant: '<S62>/e'
    *  Product: '<S53>/Product'
    */
-  rtb_Sqrt = Vg * 0.0818191908425;
+  rtb_Sqrt = Vg * RT_REAL64(0.0818191908425);
 
   /* Sqrt: '<S62>/Sqrt' incorporates:
    *  Constant: '<S62>/const'
@@ -699,8 +699,8 @@ void FW_TECS_switcher(const vom_t *rtu_vom_status, const real_T
    *  Product: '<S63>/Product'
    *  Sqrt: '<S62>/Sqrt'
    */
-  if (rtb_Sqrt <= 0.001) {
-    scale = -0.001;
+  if (rtb_Sqrt <= RT_REAL64(0.001)) {
+    scale = -RT_REAL64(0.001);
   }
 
   /* End of Switch: '<S63>/Switch3' */
@@ -723,7 +723,7 @@ void FW_TECS_switcher(const vom_t *rtu_vom_status, const real_T
    *  Trigonometry: '<S75>/Trigonometric Function6'
    */
   rtb_TrigonometricFunction6_onwcg4eh52 = cos
-    (rtb_VectorConcatenate1_oigmvxpsrq_idx_0 + 0.97080864372042563);
+    (rtb_VectorConcatenate1_oigmvxpsrq_idx_0 + RT_REAL64(0.97080864372042563));
 
   /* Trigonometry: '<S59>/Trigonometric Function2' incorporates:
    *  Constant: '<S5>/AlAin_RTH_land'
@@ -731,7 +731,7 @@ void FW_TECS_switcher(const vom_t *rtu_vom_status, const real_T
    *  Trigonometry: '<S49>/Trigonometric Function2'
    *  Trigonometry: '<S75>/Trigonometric Function6'
    */
-  Vg_0 = sin(rtb_VectorConcatenate1_oigmvxpsrq_idx_0 + 0.97080864372042563);
+  Vg_0 = sin(rtb_VectorConcatenate1_oigmvxpsrq_idx_0 + RT_REAL64(0.97080864372042563));
 
   /* MATLAB Function: '<S58>/MATLAB Function1' */
   rtb_C_pex2miccv0[0] = (-curvature) * rtb_Sum_imgtnbczew_tmp;
@@ -773,7 +773,7 @@ void FW_TECS_switcher(const vom_t *rtu_vom_status, const real_T
     rtb_Sum_imgtnbczew_tmp);
   dir_idx_1 = (rtb_VectorConcatenate1_psilb5rrki_idx_1 * Vg_0) - (dir_idx_1 *
     rtb_Sum_imgtnbczew_tmp_0);
-  AC_norm = (Vg * ((0.993305620009879 * scale) +
+  AC_norm = (Vg * ((RT_REAL64(0.993305620009879) * scale) +
                    (*rtu_mode_data_fwrth_data_alt_sp))) - dir_idx_0;
 
   /* Product: '<S58>/Product' */
@@ -792,7 +792,7 @@ void FW_TECS_switcher(const vom_t *rtu_vom_status, const real_T
    *  Trigonometry: '<S75>/Trigonometric Function6'
    */
   AC_norm = rtu_Sensor_pos_lla[1] - (rtb_VectorConcatenate1_oigmvxpsrq_idx_0 +
-    0.97080864372042563);
+    RT_REAL64(0.97080864372042563));
 
   /* Trigonometry: '<S68>/Trigonometric Function6' incorporates:
    *  Product: '<S68>/Product'
@@ -815,8 +815,8 @@ void FW_TECS_switcher(const vom_t *rtu_vom_status, const real_T
   /* Switch: '<S54>/Switch3' incorporates:
    *  Product: '<S54>/Product'
    */
-  if (rtb_Sqrt <= 0.001) {
-    AC_norm = -0.001;
+  if (rtb_Sqrt <= RT_REAL64(0.001)) {
+    AC_norm = -RT_REAL64(0.001);
   }
 
   /* End of Switch: '<S54>/Switch3' */
@@ -838,7 +838,7 @@ void FW_TECS_switcher(const vom_t *rtu_vom_status, const real_T
    *  Product: '<S49>/Product2'
    *  Sum: '<S49>/Sum1'
    */
-  dir_idx_0 = Vg * ((0.993305620009879 * AC_norm) +
+  dir_idx_0 = Vg * ((RT_REAL64(0.993305620009879) * AC_norm) +
                     (*rtu_mode_data_fwrth_data_alt_sp));
 
   /* Sqrt: '<S51>/Sqrt' */
@@ -847,8 +847,8 @@ void FW_TECS_switcher(const vom_t *rtu_vom_status, const real_T
   /* Switch: '<S52>/Switch3' incorporates:
    *  Product: '<S52>/Product'
    */
-  if (AC_norm_tmp <= 0.001) {
-    AC_norm = -0.001;
+  if (AC_norm_tmp <= RT_REAL64(0.001)) {
+    AC_norm = -RT_REAL64(0.001);
   }
 
   /* End of Switch: '<S52>/Switch3' */
@@ -881,7 +881,7 @@ void FW_TECS_switcher(const vom_t *rtu_vom_status, const real_T
     (dir_idx_1 * rtb_TrigonometricFunction6_onwcg4eh52);
   dir_idx_1 = (rtb_VectorConcatenate1_psilb5rrki_idx_1 *
                rtb_Sum_imgtnbczew_tmp_0) - (dir_idx_1 * Vg_0);
-  AC_norm = (curvature * ((0.993305620009879 * AC_norm) + rtu_Sensor_pos_lla[2]))
+  AC_norm = (curvature * ((RT_REAL64(0.993305620009879) * AC_norm) + rtu_Sensor_pos_lla[2]))
     - dir_idx_0;
 
   /* Product: '<S47>/Product' */
@@ -914,9 +914,9 @@ void FW_TECS_switcher(const vom_t *rtu_vom_status, const real_T
 
   /*  horizontal ground speed */
   /* '<S45>:1:22' if (Vg<0.01) */
-  if (rtb_TrigonometricFunction2_i3ecl5ucim < 0.01) {
+  if (rtb_TrigonometricFunction2_i3ecl5ucim < RT_REAL64(0.01)) {
     /* '<S45>:1:23' Vg =0.001; */
-    Vg = 0.001;
+    Vg = RT_REAL64(0.001);
   }
 
   /* '<S45>:1:25' vel_dir = vel_NE/Vg; */
@@ -926,7 +926,7 @@ void FW_TECS_switcher(const vom_t *rtu_vom_status, const real_T
   /* '<S45>:1:29' L1_zeta = 0.7; */
   /*  L1 samping ratio */
   /* '<S45>:1:30' L1 = L1_P*L1_zeta/pi*Vg; */
-  rtb_Sqrt = 2.6738030439438414 * Vg;
+  rtb_Sqrt = RT_REAL64(2.6738030439438414) * Vg;
 
   /*  L1 length */
   /*  P = start_pos; */
@@ -943,7 +943,7 @@ void FW_TECS_switcher(const vom_t *rtu_vom_status, const real_T
   /* '<S45>:1:42' if (L1 + a) <= R */
   if ((rtb_Sqrt + AC_norm) <= 150.0) {
     /* '<S45>:1:43' gamma = pi; */
-    AC_norm = 3.1415926535897931;
+    AC_norm = RT_REAL64(3.1415926535897931);
   } else if (AC_norm >= (rtb_Sqrt + 150.0)) {
     /* '<S45>:1:44' elseif a >= (L1 + R) */
     /* '<S45>:1:45' gamma = 0; */
@@ -974,13 +974,13 @@ void FW_TECS_switcher(const vom_t *rtu_vom_status, const real_T
     (-AC_norm);
 
   /* '<S45>:1:69' if ang_in > pi */
-  if (AC_norm > 3.1415926535897931) {
+  if (AC_norm > RT_REAL64(3.1415926535897931)) {
     /* '<S45>:1:70' ang_in = ang_in - 2*pi; */
-    AC_norm -= 6.2831853071795862;
-  } else if (AC_norm < -3.1415926535897931) {
+    AC_norm -= RT_REAL64(6.2831853071795862);
+  } else if (AC_norm < -RT_REAL64(3.1415926535897931)) {
     /* '<S45>:1:71' elseif ang_in < -pi */
     /* '<S45>:1:72' ang_in = ang_in + 2*pi; */
-    AC_norm += 6.2831853071795862;
+    AC_norm += RT_REAL64(6.2831853071795862);
   } else {
     /* no actions */
   }
@@ -991,13 +991,13 @@ void FW_TECS_switcher(const vom_t *rtu_vom_status, const real_T
     rtu_Sensor_vel_ned[0] / Vg);
 
   /* '<S45>:1:69' if ang_in > pi */
-  if (rtb_Sum_imgtnbczew_idx_1 > 3.1415926535897931) {
+  if (rtb_Sum_imgtnbczew_idx_1 > RT_REAL64(3.1415926535897931)) {
     /* '<S45>:1:70' ang_in = ang_in - 2*pi; */
-    rtb_Sum_imgtnbczew_idx_1 -= 6.2831853071795862;
-  } else if (rtb_Sum_imgtnbczew_idx_1 < -3.1415926535897931) {
+    rtb_Sum_imgtnbczew_idx_1 -= RT_REAL64(6.2831853071795862);
+  } else if (rtb_Sum_imgtnbczew_idx_1 < -RT_REAL64(3.1415926535897931)) {
     /* '<S45>:1:71' elseif ang_in < -pi */
     /* '<S45>:1:72' ang_in = ang_in + 2*pi; */
-    rtb_Sum_imgtnbczew_idx_1 += 6.2831853071795862;
+    rtb_Sum_imgtnbczew_idx_1 += RT_REAL64(6.2831853071795862);
   } else {
     /* no actions */
   }
@@ -1071,7 +1071,7 @@ void FW_TECS_switcher(const vom_t *rtu_vom_status, const real_T
    *  Trigonometry: '<S41>/Atan2'
    */
   *rty_FWRTH_SM_in_circle_align_done = ((fabs(rt_modd(rt_modd((((rt_modd(rt_modd
-    (((absxk - 1.5707963267948966) - -3.1415926535897931) +
+    (((absxk - RT_REAL64(1.5707963267948966)) - -RT_REAL64(3.1415926535897931)) +
      FW_TECS_switcher_ConstB.Sum1_ifh4nmipzo,
      FW_TECS_switcher_ConstB.Sum1_ifh4nmipzo),
     FW_TECS_switcher_ConstB.Sum1_ifh4nmipzo) - 3.1415926535897931) - atan2
@@ -1100,7 +1100,7 @@ void FW_TECS_switcher(const vom_t *rtu_vom_status, const real_T
    *  Sum: '<S74>/Sum'
    */
   *rty_FWRTH_SM_in_cross_tangent_point_done = ((fabs(rt_modd(rt_modd(((AC_norm -
-    rtb_Product1_bkygj4a2su) - -3.1415926535897931) +
+    rtb_Product1_bkygj4a2su) - -RT_REAL64(3.1415926535897931)) +
     FW_TECS_switcher_ConstB.Sum1_obqa34fcll,
     FW_TECS_switcher_ConstB.Sum1_obqa34fcll),
     FW_TECS_switcher_ConstB.Sum1_obqa34fcll) - 3.1415926535897931) <=
@@ -1111,13 +1111,13 @@ void FW_TECS_switcher(const vom_t *rtu_vom_status, const real_T
    *  BusAssignment: '<S5>/Bus Assignment'
    *  Constant: '<S5>/AlAin_RTH_land'
    */
-  *rty_FWRTH_SM_in_land_lat = 0.42700150356474043;
+  *rty_FWRTH_SM_in_land_lat = RT_REAL64(0.42700150356474043);
 
   /* SignalConversion generated from: '<Root>/FWRTH_SM_in' incorporates:
    *  BusAssignment: '<S5>/Bus Assignment'
    *  Constant: '<S5>/AlAin_RTH_land'
    */
-  *rty_FWRTH_SM_in_land_lon = 0.97080864372042563;
+  *rty_FWRTH_SM_in_land_lon = RT_REAL64(0.97080864372042563);
 
   /* SignalConversion generated from: '<Root>/FWRTH_SM_in' incorporates:
    *  BusAssignment: '<S5>/Bus Assignment'
@@ -1266,7 +1266,7 @@ void FW_TECS_switcher(const vom_t *rtu_vom_status, const real_T
    *  Constant: '<S133>/e'
    *  Product: '<S125>/Product'
    */
-  rtb_VectorConcatenate1_oigmvxpsrq_idx_0 = rtb_Sum_lskvbzjz0i * 0.0818191908425;
+  rtb_VectorConcatenate1_oigmvxpsrq_idx_0 = rtb_Sum_lskvbzjz0i * RT_REAL64(0.0818191908425);
 
   /* Sqrt: '<S133>/Sqrt' incorporates:
    *  Constant: '<S133>/const'
@@ -1284,8 +1284,8 @@ void FW_TECS_switcher(const vom_t *rtu_vom_status, const real_T
    *  Product: '<S134>/Product'
    *  Sqrt: '<S133>/Sqrt'
    */
-  if (rtb_VectorConcatenate1_oigmvxpsrq_idx_0 <= 0.001) {
-    rtb_Product1_bkygj4a2su = -0.001;
+  if (rtb_VectorConcatenate1_oigmvxpsrq_idx_0 <= RT_REAL64(0.001)) {
+    rtb_Product1_bkygj4a2su = -RT_REAL64(0.001);
   }
 
   /* End of Switch: '<S134>/Switch3' */
@@ -1321,14 +1321,14 @@ void FW_TECS_switcher(const vom_t *rtu_vom_status, const real_T
    *  Product: '<S129>/Product2'
    *  Sum: '<S129>/Sum1'
    */
-  dir_idx_0 = rtb_Sum_lskvbzjz0i * ((0.993305620009879 * rtb_Product1_bkygj4a2su)
+  dir_idx_0 = rtb_Sum_lskvbzjz0i * ((RT_REAL64(0.993305620009879) * rtb_Product1_bkygj4a2su)
     + FW_TECS_switcher_DW.prev_pos_sp_DSTATE[2]);
 
   /* Product: '<S131>/Product' incorporates:
    *  Constant: '<S131>/e'
    */
   rtb_Product1_bkygj4a2su = rtb_TrigonometricFunction_paar0fmbpe *
-    0.0818191908425;
+    RT_REAL64(0.0818191908425);
 
   /* Sqrt: '<S131>/Sqrt' incorporates:
    *  Constant: '<S131>/const'
@@ -1342,8 +1342,8 @@ void FW_TECS_switcher(const vom_t *rtu_vom_status, const real_T
    *  Abs: '<S132>/Abs'
    *  Product: '<S132>/Product'
    */
-  if (rtb_Product1_bkygj4a2su <= 0.001) {
-    rtb_Product1_bkygj4a2su = -0.001;
+  if (rtb_Product1_bkygj4a2su <= RT_REAL64(0.001)) {
+    rtb_Product1_bkygj4a2su = -RT_REAL64(0.001);
   }
 
   /* End of Switch: '<S132>/Switch3' */
@@ -1382,7 +1382,7 @@ void FW_TECS_switcher(const vom_t *rtu_vom_status, const real_T
      (FW_TECS_switcher_DW.cur_pos_sp_DSTATE[1])) - (dir_idx_1 * scale);
   dir_idx_1 = (rtb_VectorConcatenate1_psilb5rrki_idx_1 * sin
                (FW_TECS_switcher_DW.cur_pos_sp_DSTATE[1])) - (dir_idx_1 * absxk);
-  AC_norm = (rtb_TrigonometricFunction_paar0fmbpe * ((0.993305620009879 *
+  AC_norm = (rtb_TrigonometricFunction_paar0fmbpe * ((RT_REAL64(0.993305620009879) *
     rtb_Product1_bkygj4a2su) + FW_TECS_switcher_DW.cur_pos_sp_DSTATE[2])) -
     dir_idx_0;
 
@@ -1415,8 +1415,8 @@ void FW_TECS_switcher(const vom_t *rtu_vom_status, const real_T
   /* Switch: '<S126>/Switch3' incorporates:
    *  Product: '<S126>/Product'
    */
-  if (rtb_VectorConcatenate1_oigmvxpsrq_idx_0 <= 0.001) {
-    rtb_Product1_bkygj4a2su = -0.001;
+  if (rtb_VectorConcatenate1_oigmvxpsrq_idx_0 <= RT_REAL64(0.001)) {
+    rtb_Product1_bkygj4a2su = -RT_REAL64(0.001);
   }
 
   /* End of Switch: '<S126>/Switch3' */
@@ -1440,7 +1440,7 @@ void FW_TECS_switcher(const vom_t *rtu_vom_status, const real_T
    *  Product: '<S121>/Product2'
    *  Sum: '<S121>/Sum1'
    */
-  dir_idx_0 = rtb_Sum_lskvbzjz0i * ((0.993305620009879 * rtb_Product1_bkygj4a2su)
+  dir_idx_0 = rtb_Sum_lskvbzjz0i * ((RT_REAL64(0.993305620009879) * rtb_Product1_bkygj4a2su)
     + FW_TECS_switcher_DW.prev_pos_sp_DSTATE[2]);
 
   /* Sqrt: '<S123>/Sqrt' */
@@ -1449,8 +1449,8 @@ void FW_TECS_switcher(const vom_t *rtu_vom_status, const real_T
   /* Switch: '<S124>/Switch3' incorporates:
    *  Product: '<S124>/Product'
    */
-  if (AC_norm_tmp <= 0.001) {
-    rtb_Product1_bkygj4a2su = -0.001;
+  if (AC_norm_tmp <= RT_REAL64(0.001)) {
+    rtb_Product1_bkygj4a2su = -RT_REAL64(0.001);
   }
 
   /* End of Switch: '<S124>/Switch3' */
@@ -1483,7 +1483,7 @@ void FW_TECS_switcher(const vom_t *rtu_vom_status, const real_T
     (dir_idx_1 * scale);
   dir_idx_1 = (rtb_VectorConcatenate1_psilb5rrki_idx_1 *
                rtb_Sum_imgtnbczew_tmp_0) - (dir_idx_1 * absxk);
-  AC_norm = (curvature * ((0.993305620009879 * rtb_Product1_bkygj4a2su) +
+  AC_norm = (curvature * ((RT_REAL64(0.993305620009879) * rtb_Product1_bkygj4a2su) +
               rtu_Sensor_pos_lla[2])) - dir_idx_0;
 
   /* Product: '<S119>/Product' */
@@ -1510,9 +1510,9 @@ void FW_TECS_switcher(const vom_t *rtu_vom_status, const real_T
 
   /*  horizontal ground speed */
   /* '<S107>:1:13' if (Vg<0.01) */
-  if (rtb_TrigonometricFunction2_i3ecl5ucim < 0.01) {
+  if (rtb_TrigonometricFunction2_i3ecl5ucim < RT_REAL64(0.01)) {
     /* '<S107>:1:14' Vg =0.001; */
-    Vg_0 = 0.001;
+    Vg_0 = RT_REAL64(0.001);
   }
 
   /* '<S107>:1:17' vel_dir = vel_NE/Vg; */
@@ -1521,7 +1521,7 @@ void FW_TECS_switcher(const vom_t *rtu_vom_status, const real_T
   /* '<S107>:1:20' L1_zeta = 0.7; */
   /*  L1 damping ratio */
   /* '<S107>:1:21' L1 = L1_P*L1_zeta/pi*Vg; */
-  rtb_Sum_lskvbzjz0i = 3.3422538049298023 * Vg_0;
+  rtb_Sum_lskvbzjz0i = RT_REAL64(3.3422538049298023) * Vg_0;
 
   /*  L1 length */
   /* '<S107>:1:23' P = start_pos; */
@@ -1565,13 +1565,13 @@ void FW_TECS_switcher(const vom_t *rtu_vom_status, const real_T
   AC_idx_0 = rtb_Product1_bkygj4a2su - rtb_VectorConcatenate1[0];
   rtb_Product1_bkygj4a2su = absxk + (dir_idx_1 * AC_norm);
   AC_idx_1 = rtb_Product1_bkygj4a2su - rtb_VectorConcatenate1[1];
-  scale = 3.3121686421112381E-170;
+  scale = RT_NRM2_SCALE;
   absxk = fabs(AC_idx_0);
-  if (absxk > 3.3121686421112381E-170) {
+  if (absxk > RT_NRM2_SCALE) {
     AC_norm = 1.0;
     scale = absxk;
   } else {
-    t = absxk / 3.3121686421112381E-170;
+    t = absxk / RT_NRM2_SCALE;
     AC_norm = t * t;
   }
 
@@ -1819,7 +1819,7 @@ void FW_TECS_switcher(const vom_t *rtu_vom_status, const real_T
    *  Trigonometry: '<S22>/Trigonometric Function1'
    */
   if (rtb_Compare_i5bisll1rb || ((*rtu_vom_status) != VOM_FLTDIR)) {
-    rtb_Sqrt_jug5wuieqd = (2.0 * ((tan(rtu_Sensor_eul_ang[0]) * 9.80665) /
+    rtb_Sqrt_jug5wuieqd = (2.0 * ((tan(rtu_Sensor_eul_ang[0]) * RT_REAL64(9.80665)) /
       rtb_TrigonometricFunction_paar0fmbpe)) + (*rtu_Sensor_chi);
   } else {
     rtb_Sqrt_jug5wuieqd = FW_TECS_switcher_DW.Delay_DSTATE;
@@ -1853,7 +1853,7 @@ void FW_TECS_switcher(const vom_t *rtu_vom_status, const real_T
        *  Product: '<S22>/Product'
        *  Trigonometry: '<S22>/Trigonometric Function'
        */
-      rtb_Product1_bkygj4a2su = (tan(0.41888 * (*rtu_Pilot_roll_ch)) * 9.80665) /
+      rtb_Product1_bkygj4a2su = (tan(0.41888 * (*rtu_Pilot_roll_ch)) * RT_REAL64(9.80665)) /
         rtb_TrigonometricFunction_paar0fmbpe;
     } else {
       /* Switch: '<S22>/Switch1' incorporates:
@@ -1867,7 +1867,7 @@ void FW_TECS_switcher(const vom_t *rtu_vom_status, const real_T
        *  Sum: '<S25>/Sum'
        */
       rtb_Product1_bkygj4a2su = 0.4 * (rt_modd(rt_modd(((rtb_Sqrt_jug5wuieqd - (*
-        rtu_Sensor_chi)) - -3.1415926535897931) + FW_TECS_switcher_ConstB.Sum1,
+        rtu_Sensor_chi)) - -RT_REAL64(3.1415926535897931)) + FW_TECS_switcher_ConstB.Sum1,
         FW_TECS_switcher_ConstB.Sum1), FW_TECS_switcher_ConstB.Sum1) -
         3.1415926535897931);
     }
@@ -1876,7 +1876,7 @@ void FW_TECS_switcher(const vom_t *rtu_vom_status, const real_T
      *  Constant: '<S22>/Constant1'
      */
     PB_norm = (rtb_Product1_bkygj4a2su * rtb_TrigonometricFunction_paar0fmbpe) /
-      9.80665;
+      RT_REAL64(9.80665);
 
     /* Saturate: '<S3>/Saturation2' */
     if (PB_norm > 0.5236) {
@@ -1913,7 +1913,7 @@ void FW_TECS_switcher(const vom_t *rtu_vom_status, const real_T
    *  Constant: '<S37>/e'
    */
   rtb_Product1_bkygj4a2su = rtb_TrigonometricFunction_paar0fmbpe *
-    0.0818191908425;
+    RT_REAL64(0.0818191908425);
 
   /* Sqrt: '<S37>/Sqrt' incorporates:
    *  Constant: '<S37>/const'
@@ -1927,8 +1927,8 @@ void FW_TECS_switcher(const vom_t *rtu_vom_status, const real_T
    *  Abs: '<S38>/Abs'
    *  Product: '<S38>/Product'
    */
-  if (rtb_Product1_bkygj4a2su <= 0.001) {
-    rtb_Product1_bkygj4a2su = -0.001;
+  if (rtb_Product1_bkygj4a2su <= RT_REAL64(0.001)) {
+    rtb_Product1_bkygj4a2su = -RT_REAL64(0.001);
   }
 
   /* End of Switch: '<S38>/Switch3' */
@@ -1951,7 +1951,7 @@ void FW_TECS_switcher(const vom_t *rtu_vom_status, const real_T
    *  Product: '<S33>/Product2'
    *  Sum: '<S33>/Sum1'
    */
-  dir_idx_0 = rtb_TrigonometricFunction_paar0fmbpe * ((0.993305620009879 *
+  dir_idx_0 = rtb_TrigonometricFunction_paar0fmbpe * ((RT_REAL64(0.993305620009879) *
     rtb_Product1_bkygj4a2su) + (*rtu_mode_data_ft_data_FT_Altitude));
 
   /* Sqrt: '<S35>/Sqrt' */
@@ -1960,8 +1960,8 @@ void FW_TECS_switcher(const vom_t *rtu_vom_status, const real_T
   /* Switch: '<S36>/Switch3' incorporates:
    *  Product: '<S36>/Product'
    */
-  if (AC_norm_tmp <= 0.001) {
-    rtb_Product1_bkygj4a2su = -0.001;
+  if (AC_norm_tmp <= RT_REAL64(0.001)) {
+    rtb_Product1_bkygj4a2su = -RT_REAL64(0.001);
   }
 
   /* End of Switch: '<S36>/Switch3' */
@@ -1997,7 +1997,7 @@ void FW_TECS_switcher(const vom_t *rtu_vom_status, const real_T
   dir_idx_1 = (rtb_VectorConcatenate1_psilb5rrki_idx_1 *
                rtb_Sum_imgtnbczew_tmp_0) - (dir_idx_1 * sin
     (*rtu_mode_data_ft_data_FT_y));
-  AC_norm = (curvature * ((0.993305620009879 * rtb_Product1_bkygj4a2su) +
+  AC_norm = (curvature * ((RT_REAL64(0.993305620009879) * rtb_Product1_bkygj4a2su) +
               rtu_Sensor_pos_lla[2])) - dir_idx_0;
 
   /* Product: '<S31>/Product' */
@@ -2025,9 +2025,9 @@ void FW_TECS_switcher(const vom_t *rtu_vom_status, const real_T
 
   /*  horizontal ground speed */
   /* '<S30>:1:13' if (Vg<0.01) */
-  if (rtb_TrigonometricFunction2_i3ecl5ucim < 0.01) {
+  if (rtb_TrigonometricFunction2_i3ecl5ucim < RT_REAL64(0.01)) {
     /* '<S30>:1:14' Vg =0.001; */
-    rtb_TrigonometricFunction_paar0fmbpe = 0.001;
+    rtb_TrigonometricFunction_paar0fmbpe = RT_REAL64(0.001);
   }
 
   /* '<S30>:1:17' vel_dir = vel_NE/Vg; */
@@ -2036,7 +2036,7 @@ void FW_TECS_switcher(const vom_t *rtu_vom_status, const real_T
   /* '<S30>:1:19' L1_zeta = 0.7; */
   /*  L1 damping ratio */
   /* '<S30>:1:20' L1 = L1_P*L1_zeta/pi*Vg; */
-  rtb_Product1_bkygj4a2su = 3.3422538049298023 *
+  rtb_Product1_bkygj4a2su = RT_REAL64(3.3422538049298023) *
     rtb_TrigonometricFunction_paar0fmbpe;
 
   /*  L1 length */
@@ -2080,13 +2080,13 @@ void FW_TECS_switcher(const vom_t *rtu_vom_status, const real_T
   /* '<S30>:1:38' AB_dir = (B-A)/norm(B-A); */
   AC_idx_0_0 = (C_idx_0 + (dir_idx_0 * AC_norm)) - rtb_VectorConcatenate1[0];
   AC_idx_1_0 = (absxk + (dir_idx_1 * AC_norm)) - rtb_VectorConcatenate1[1];
-  scale = 3.3121686421112381E-170;
+  scale = RT_NRM2_SCALE;
   absxk = fabs(AC_idx_0_0);
-  if (absxk > 3.3121686421112381E-170) {
+  if (absxk > RT_NRM2_SCALE) {
     AC_norm = 1.0;
     scale = absxk;
   } else {
-    t = absxk / 3.3121686421112381E-170;
+    t = absxk / RT_NRM2_SCALE;
     AC_norm = t * t;
   }
 
@@ -2134,27 +2134,27 @@ void FW_TECS_switcher(const vom_t *rtu_vom_status, const real_T
                   (AC_idx_0_0 * rtb_VectorConcatenate1_psilb5rrki_idx_1),
                   (rtb_VectorConcatenate1_psilb5rrki_idx_0 * AC_idx_0_0) +
                   (rtb_VectorConcatenate1_psilb5rrki_idx_1 * AC_idx_1_0));
-    if (absxk < -1.5707963267948966) {
-      absxk = -1.5707963267948966;
+    if (absxk < -RT_REAL64(1.5707963267948966)) {
+      absxk = -RT_REAL64(1.5707963267948966);
     }
 
-    if (absxk > 1.5707963267948966) {
-      absxk = 1.5707963267948966;
+    if (absxk > RT_REAL64(1.5707963267948966)) {
+      absxk = RT_REAL64(1.5707963267948966);
     }
 
     /* Trigonometry: '<S28>/Atan' incorporates:
      *  MATLAB Function: '<S28>/guidance_line'
      */
-    rtb_TrigonometricFunction_paar0fmbpe = atan2(((1.9599999999999997 *
+    rtb_TrigonometricFunction_paar0fmbpe = atan2(((RT_REAL64(1.9599999999999997) *
       (rtb_TrigonometricFunction_paar0fmbpe *
        rtb_TrigonometricFunction_paar0fmbpe)) / rtb_Product1_bkygj4a2su) * sin
-      (absxk), 9.81);
+      (absxk), RT_REAL64(9.81));
 
     /* Saturate: '<S4>/Saturation2' */
-    if (rtb_TrigonometricFunction_paar0fmbpe > 0.5236) {
-      rtb_TrigonometricFunction_paar0fmbpe = 0.5236;
-    } else if (rtb_TrigonometricFunction_paar0fmbpe < -0.5236) {
-      rtb_TrigonometricFunction_paar0fmbpe = -0.5236;
+    if (rtb_TrigonometricFunction_paar0fmbpe > RT_REAL64(0.5236)) {
+      rtb_TrigonometricFunction_paar0fmbpe = RT_REAL64(0.5236);
+    } else if (rtb_TrigonometricFunction_paar0fmbpe < -RT_REAL64(0.5236)) {
+      rtb_TrigonometricFunction_paar0fmbpe = -RT_REAL64(0.5236);
     } else {
       /* no actions */
     }
@@ -2162,19 +2162,19 @@ void FW_TECS_switcher(const vom_t *rtu_vom_status, const real_T
     /* End of Saturate: '<S4>/Saturation2' */
 
     /* MATLAB Function: '<S39>/MATLAB Function' */
-    if (rtb_Sum_imgtnbczew_idx_1 < -3.1415926535897931) {
-      rtb_Sum_imgtnbczew_idx_1 = -3.1415926535897931;
+    if (rtb_Sum_imgtnbczew_idx_1 < -RT_REAL64(3.1415926535897931)) {
+      rtb_Sum_imgtnbczew_idx_1 = -RT_REAL64(3.1415926535897931);
     }
 
-    if (rtb_Sum_imgtnbczew_idx_1 > 3.1415926535897931) {
-      rtb_Sum_imgtnbczew_idx_1 = 3.1415926535897931;
+    if (rtb_Sum_imgtnbczew_idx_1 > RT_REAL64(3.1415926535897931)) {
+      rtb_Sum_imgtnbczew_idx_1 = RT_REAL64(3.1415926535897931);
     }
 
     /* Trigonometry: '<S39>/Atan' incorporates:
      *  MATLAB Function: '<S39>/MATLAB Function'
      */
-    t = atan2(((1.9599999999999997 * (Vg * Vg)) / rtb_Sqrt) * sin
-              (rtb_Sum_imgtnbczew_idx_1), 9.81);
+    t = atan2(((RT_REAL64(1.9599999999999997) * (Vg * Vg)) / rtb_Sqrt) * sin
+              (rtb_Sum_imgtnbczew_idx_1), RT_REAL64(9.81));
 
     /* Saturate: '<S5>/Saturation2' */
     if (t > 0.5236) {
@@ -2210,7 +2210,7 @@ void FW_TECS_switcher(const vom_t *rtu_vom_status, const real_T
   /* Product: '<S87>/Product' incorporates:
    *  Constant: '<S87>/e'
    */
-  AC_norm = rtb_Product1_bkygj4a2su * 0.0818191908425;
+  AC_norm = rtb_Product1_bkygj4a2su * RT_REAL64(0.0818191908425);
 
   /* Sqrt: '<S87>/Sqrt' incorporates:
    *  Constant: '<S87>/const'
@@ -2223,8 +2223,8 @@ void FW_TECS_switcher(const vom_t *rtu_vom_status, const real_T
    *  Abs: '<S88>/Abs'
    *  Product: '<S88>/Product'
    */
-  if (AC_norm <= 0.001) {
-    AC_norm = -0.001;
+  if (AC_norm <= RT_REAL64(0.001)) {
+    AC_norm = -RT_REAL64(0.001);
   }
 
   /* End of Switch: '<S88>/Switch3' */
@@ -2247,7 +2247,7 @@ void FW_TECS_switcher(const vom_t *rtu_vom_status, const real_T
    *  Product: '<S83>/Product2'
    *  Sum: '<S83>/Sum1'
    */
-  dir_idx_0 = rtb_Product1_bkygj4a2su * ((0.993305620009879 * AC_norm) +
+  dir_idx_0 = rtb_Product1_bkygj4a2su * ((RT_REAL64(0.993305620009879) * AC_norm) +
     (*rtu_mode_data_loiter_data_loiter_altitude));
 
   /* Sqrt: '<S85>/Sqrt' */
@@ -2256,8 +2256,8 @@ void FW_TECS_switcher(const vom_t *rtu_vom_status, const real_T
   /* Switch: '<S86>/Switch3' incorporates:
    *  Product: '<S86>/Product'
    */
-  if (AC_norm_tmp <= 0.001) {
-    AC_norm = -0.001;
+  if (AC_norm_tmp <= RT_REAL64(0.001)) {
+    AC_norm = -RT_REAL64(0.001);
   }
 
   /* End of Switch: '<S86>/Switch3' */
@@ -2293,7 +2293,7 @@ void FW_TECS_switcher(const vom_t *rtu_vom_status, const real_T
   dir_idx_1 = (rtb_VectorConcatenate1_psilb5rrki_idx_1 *
                rtb_Sum_imgtnbczew_tmp_0) - (dir_idx_1 * sin
     (*rtu_mode_data_loiter_data_loiter_Center_Lon));
-  AC_norm = (curvature * ((0.993305620009879 * AC_norm) + rtu_Sensor_pos_lla[2]))
+  AC_norm = (curvature * ((RT_REAL64(0.993305620009879) * AC_norm) + rtu_Sensor_pos_lla[2]))
     - dir_idx_0;
 
   /* Product: '<S81>/Product' */
@@ -2333,9 +2333,9 @@ void FW_TECS_switcher(const vom_t *rtu_vom_status, const real_T
 
   /*  horizontal ground speed */
   /* '<S79>:1:22' if (Vg<0.01) */
-  if (rtb_TrigonometricFunction2_i3ecl5ucim < 0.01) {
+  if (rtb_TrigonometricFunction2_i3ecl5ucim < RT_REAL64(0.01)) {
     /* '<S79>:1:23' Vg =0.001; */
-    Vg = 0.001;
+    Vg = RT_REAL64(0.001);
   }
 
   /* '<S79>:1:25' vel_dir = vel_NE/Vg; */
@@ -2345,7 +2345,7 @@ void FW_TECS_switcher(const vom_t *rtu_vom_status, const real_T
   /* '<S79>:1:29' L1_zeta = 0.7; */
   /*  L1 samping ratio */
   /* '<S79>:1:30' L1 = L1_P*L1_zeta/pi*Vg; */
-  rtb_Sqrt = 2.6738030439438414 * Vg;
+  rtb_Sqrt = RT_REAL64(2.6738030439438414) * Vg;
 
   /*  L1 length */
   /*  P = start_pos; */
@@ -2362,7 +2362,7 @@ void FW_TECS_switcher(const vom_t *rtu_vom_status, const real_T
   /* '<S79>:1:42' if (L1 + a) <= R */
   if ((rtb_Sqrt + AC_norm) <= rtb_Sum_imgtnbczew_idx_1) {
     /* '<S79>:1:43' gamma = pi; */
-    AC_norm = 3.1415926535897931;
+    AC_norm = RT_REAL64(3.1415926535897931);
   } else if (AC_norm >= (rtb_Sqrt + rtb_Sum_imgtnbczew_idx_1)) {
     /* '<S79>:1:44' elseif a >= (L1 + R) */
     /* '<S79>:1:45' gamma = 0; */
@@ -2402,13 +2402,13 @@ void FW_TECS_switcher(const vom_t *rtu_vom_status, const real_T
     (((real_T)i) * AC_norm);
 
   /* '<S79>:1:69' if ang_in > pi */
-  if (AC_norm > 3.1415926535897931) {
+  if (AC_norm > RT_REAL64(3.1415926535897931)) {
     /* '<S79>:1:70' ang_in = ang_in - 2*pi; */
-    AC_norm -= 6.2831853071795862;
-  } else if (AC_norm < -3.1415926535897931) {
+    AC_norm -= RT_REAL64(6.2831853071795862);
+  } else if (AC_norm < -RT_REAL64(3.1415926535897931)) {
     /* '<S79>:1:71' elseif ang_in < -pi */
     /* '<S79>:1:72' ang_in = ang_in + 2*pi; */
-    AC_norm += 6.2831853071795862;
+    AC_norm += RT_REAL64(6.2831853071795862);
   } else {
     /* no actions */
   }
@@ -2419,13 +2419,13 @@ void FW_TECS_switcher(const vom_t *rtu_vom_status, const real_T
     rtu_Sensor_vel_ned[0] / Vg);
 
   /* '<S79>:1:69' if ang_in > pi */
-  if (rtb_Sum_imgtnbczew_idx_1 > 3.1415926535897931) {
+  if (rtb_Sum_imgtnbczew_idx_1 > RT_REAL64(3.1415926535897931)) {
     /* '<S79>:1:70' ang_in = ang_in - 2*pi; */
-    rtb_Sum_imgtnbczew_idx_1 -= 6.2831853071795862;
-  } else if (rtb_Sum_imgtnbczew_idx_1 < -3.1415926535897931) {
+    rtb_Sum_imgtnbczew_idx_1 -= RT_REAL64(6.2831853071795862);
+  } else if (rtb_Sum_imgtnbczew_idx_1 < -RT_REAL64(3.1415926535897931)) {
     /* '<S79>:1:71' elseif ang_in < -pi */
     /* '<S79>:1:72' ang_in = ang_in + 2*pi; */
-    rtb_Sum_imgtnbczew_idx_1 += 6.2831853071795862;
+    rtb_Sum_imgtnbczew_idx_1 += RT_REAL64(6.2831853071795862);
   } else {
     /* no actions */
   }
@@ -2442,31 +2442,31 @@ void FW_TECS_switcher(const vom_t *rtu_vom_status, const real_T
     /* BusAssignment: '<S6>/Bus Assignment2' incorporates:
      *  Constant: '<S6>/Constant4'
      */
-    rtb_Product1_bkygj4a2su = -0.43633231299858238;
+    rtb_Product1_bkygj4a2su = -RT_REAL64(0.43633231299858238);
   } else {
-    if (rtb_Sum_imgtnbczew_idx_1 < -3.1415926535897931) {
+    if (rtb_Sum_imgtnbczew_idx_1 < -RT_REAL64(3.1415926535897931)) {
       /* MATLAB Function: '<S78>/MATLAB Function1' */
-      rtb_Sum_imgtnbczew_idx_1 = -3.1415926535897931;
+      rtb_Sum_imgtnbczew_idx_1 = -RT_REAL64(3.1415926535897931);
     }
 
     /* MATLAB Function: '<S78>/MATLAB Function1' */
-    if (rtb_Sum_imgtnbczew_idx_1 > 3.1415926535897931) {
-      rtb_Sum_imgtnbczew_idx_1 = 3.1415926535897931;
+    if (rtb_Sum_imgtnbczew_idx_1 > RT_REAL64(3.1415926535897931)) {
+      rtb_Sum_imgtnbczew_idx_1 = RT_REAL64(3.1415926535897931);
     }
 
     /* Trigonometry: '<S78>/Atan' incorporates:
      *  MATLAB Function: '<S78>/MATLAB Function1'
      */
-    rtb_Product1_bkygj4a2su = atan2(((1.9599999999999997 * (Vg * Vg)) / rtb_Sqrt)
-      * sin(rtb_Sum_imgtnbczew_idx_1), 9.81);
+    rtb_Product1_bkygj4a2su = atan2(((RT_REAL64(1.9599999999999997) * (Vg * Vg)) / rtb_Sqrt)
+      * sin(rtb_Sum_imgtnbczew_idx_1), RT_REAL64(9.81));
 
     /* Saturate: '<S6>/Saturation2' */
-    if (rtb_Product1_bkygj4a2su > 0.5236) {
+    if (rtb_Product1_bkygj4a2su > RT_REAL64(0.5236)) {
       /* BusAssignment: '<S6>/Bus Assignment2' */
-      rtb_Product1_bkygj4a2su = 0.5236;
-    } else if (rtb_Product1_bkygj4a2su < -0.5236) {
+      rtb_Product1_bkygj4a2su = RT_REAL64(0.5236);
+    } else if (rtb_Product1_bkygj4a2su < -RT_REAL64(0.5236)) {
       /* BusAssignment: '<S6>/Bus Assignment2' */
-      rtb_Product1_bkygj4a2su = -0.5236;
+      rtb_Product1_bkygj4a2su = -RT_REAL64(0.5236);
     } else {
       /* no actions */
     }
@@ -2519,8 +2519,8 @@ void FW_TECS_switcher(const vom_t *rtu_vom_status, const real_T
   /* Switch: '<S98>/Switch3' incorporates:
    *  Product: '<S98>/Product'
    */
-  if (AC_norm_tmp <= 0.001) {
-    AC_norm = -0.001;
+  if (AC_norm_tmp <= RT_REAL64(0.001)) {
+    AC_norm = -RT_REAL64(0.001);
   }
 
   /* End of Switch: '<S98>/Switch3' */
@@ -2562,7 +2562,7 @@ void FW_TECS_switcher(const vom_t *rtu_vom_status, const real_T
     FW_TECS_switcher_ConstB.VectorConcatenate[0];
   rtb_Sum_imgtnbczew_idx_1 = (dir_idx_1 * rtb_Sum_imgtnbczew_tmp_0) -
     FW_TECS_switcher_ConstB.VectorConcatenate[1];
-  dir_idx_0 = (curvature * ((0.993305620009879 * AC_norm) + rtu_Sensor_pos_lla[2]))
+  dir_idx_0 = (curvature * ((RT_REAL64(0.993305620009879) * AC_norm) + rtu_Sensor_pos_lla[2]))
     - FW_TECS_switcher_ConstB.VectorConcatenate[2];
 
   /* Product: '<S93>/Product' */
@@ -2595,9 +2595,9 @@ void FW_TECS_switcher(const vom_t *rtu_vom_status, const real_T
 
   /*  horizontal ground speed */
   /* '<S91>:1:22' if (Vg<0.01) */
-  if (rtb_TrigonometricFunction2_i3ecl5ucim < 0.01) {
+  if (rtb_TrigonometricFunction2_i3ecl5ucim < RT_REAL64(0.01)) {
     /* '<S91>:1:23' Vg =0.001; */
-    Vg = 0.001;
+    Vg = RT_REAL64(0.001);
   }
 
   /* '<S91>:1:25' vel_dir = vel_NE/Vg; */
@@ -2607,7 +2607,7 @@ void FW_TECS_switcher(const vom_t *rtu_vom_status, const real_T
   /* '<S91>:1:29' L1_zeta = 0.7; */
   /*  L1 samping ratio */
   /* '<S91>:1:30' L1 = L1_P*L1_zeta/pi*Vg; */
-  rtb_Sqrt = 2.228169203286535 * Vg;
+  rtb_Sqrt = RT_REAL64(2.228169203286535) * Vg;
 
   /*  L1 length */
   /*  P = start_pos; */
@@ -2624,7 +2624,7 @@ void FW_TECS_switcher(const vom_t *rtu_vom_status, const real_T
   /* '<S91>:1:42' if (L1 + a) <= R */
   if ((rtb_Sqrt + AC_norm) <= 200.0) {
     /* '<S91>:1:43' gamma = pi; */
-    AC_norm = 3.1415926535897931;
+    AC_norm = RT_REAL64(3.1415926535897931);
   } else if (AC_norm >= (rtb_Sqrt + 200.0)) {
     /* '<S91>:1:44' elseif a >= (L1 + R) */
     /* '<S91>:1:45' gamma = 0; */
@@ -2655,13 +2655,13 @@ void FW_TECS_switcher(const vom_t *rtu_vom_status, const real_T
     AC_norm;
 
   /* '<S91>:1:67' if ang_in > pi */
-  if (AC_norm > 3.1415926535897931) {
+  if (AC_norm > RT_REAL64(3.1415926535897931)) {
     /* '<S91>:1:68' ang_in = ang_in - 2*pi; */
-    AC_norm -= 6.2831853071795862;
-  } else if (AC_norm < -3.1415926535897931) {
+    AC_norm -= RT_REAL64(6.2831853071795862);
+  } else if (AC_norm < -RT_REAL64(3.1415926535897931)) {
     /* '<S91>:1:69' elseif ang_in < -pi */
     /* '<S91>:1:70' ang_in = ang_in + 2*pi; */
-    AC_norm += 6.2831853071795862;
+    AC_norm += RT_REAL64(6.2831853071795862);
   } else {
     /* no actions */
   }
@@ -2672,13 +2672,13 @@ void FW_TECS_switcher(const vom_t *rtu_vom_status, const real_T
     rtu_Sensor_vel_ned[0] / Vg);
 
   /* '<S91>:1:67' if ang_in > pi */
-  if (rtb_Sum_imgtnbczew_idx_1 > 3.1415926535897931) {
+  if (rtb_Sum_imgtnbczew_idx_1 > RT_REAL64(3.1415926535897931)) {
     /* '<S91>:1:68' ang_in = ang_in - 2*pi; */
-    rtb_Sum_imgtnbczew_idx_1 -= 6.2831853071795862;
-  } else if (rtb_Sum_imgtnbczew_idx_1 < -3.1415926535897931) {
+    rtb_Sum_imgtnbczew_idx_1 -= RT_REAL64(6.2831853071795862);
+  } else if (rtb_Sum_imgtnbczew_idx_1 < -RT_REAL64(3.1415926535897931)) {
     /* '<S91>:1:69' elseif ang_in < -pi */
     /* '<S91>:1:70' ang_in = ang_in + 2*pi; */
-    rtb_Sum_imgtnbczew_idx_1 += 6.2831853071795862;
+    rtb_Sum_imgtnbczew_idx_1 += RT_REAL64(6.2831853071795862);
   } else {
     /* no actions */
   }
@@ -2714,7 +2714,7 @@ void FW_TECS_switcher(const vom_t *rtu_vom_status, const real_T
    *  Switch: '<S8>/Switch'
    */
   if (*rtu_bGPSLossFlag) {
-    AC_norm = -0.43633231299858238;
+    AC_norm = -RT_REAL64(0.43633231299858238);
   } else {
     if (rtb_Compare_ag4sp0vjdy) {
       /* Switch: '<S8>/Switch' incorporates:
@@ -2731,13 +2731,13 @@ void FW_TECS_switcher(const vom_t *rtu_vom_status, const real_T
     /* Trigonometry: '<S8>/Atan2' incorporates:
      *  Switch: '<S8>/Switch'
      */
-    AC_norm = atan2(AC_norm, 9.81);
+    AC_norm = atan2(AC_norm, RT_REAL64(9.81));
 
     /* Saturate: '<S8>/Saturation1' */
-    if (AC_norm > 0.52359877559829882) {
-      AC_norm = 0.52359877559829882;
-    } else if (AC_norm < -0.52359877559829882) {
-      AC_norm = -0.52359877559829882;
+    if (AC_norm > RT_REAL64(0.52359877559829882)) {
+      AC_norm = RT_REAL64(0.52359877559829882);
+    } else if (AC_norm < -RT_REAL64(0.52359877559829882)) {
+      AC_norm = -RT_REAL64(0.52359877559829882);
     } else {
       /* no actions */
     }
@@ -2791,24 +2791,24 @@ void FW_TECS_switcher(const vom_t *rtu_vom_status, const real_T
      *  Constant: '<S90>/Constant'
      *  Product: '<S90>/Product'
      */
-    if (rtb_Sum_imgtnbczew_idx_1 < -3.1415926535897931) {
-      rtb_Sum_imgtnbczew_idx_1 = -3.1415926535897931;
+    if (rtb_Sum_imgtnbczew_idx_1 < -RT_REAL64(3.1415926535897931)) {
+      rtb_Sum_imgtnbczew_idx_1 = -RT_REAL64(3.1415926535897931);
     }
 
-    if (rtb_Sum_imgtnbczew_idx_1 > 3.1415926535897931) {
-      rtb_Sum_imgtnbczew_idx_1 = 3.1415926535897931;
+    if (rtb_Sum_imgtnbczew_idx_1 > RT_REAL64(3.1415926535897931)) {
+      rtb_Sum_imgtnbczew_idx_1 = RT_REAL64(3.1415926535897931);
     }
 
     /* Trigonometry: '<S89>/Atan' incorporates:
      *  MATLAB Function: '<S89>/MATLAB Function'
      */
-    y = atan2(((1.9599999999999997 * (Vg * Vg)) / rtb_Sqrt) * sin
-              (rtb_Sum_imgtnbczew_idx_1), 9.81);
+    y = atan2(((RT_REAL64(1.9599999999999997) * (Vg * Vg)) / rtb_Sqrt) * sin
+              (rtb_Sum_imgtnbczew_idx_1), RT_REAL64(9.81));
 
     /* Saturate: '<S7>/Saturation2' */
-    if (y > 0.5236) {
+    if (y > RT_REAL64(0.5236)) {
       rty_busFW_TECS_switcher->roll_cmd = 0.5236;
-    } else if (y < -0.5236) {
+    } else if (y < -RT_REAL64(0.5236)) {
       rty_busFW_TECS_switcher->roll_cmd = -0.5236;
     } else {
       rty_busFW_TECS_switcher->roll_cmd = y;
@@ -3002,7 +3002,7 @@ void FW_TECS_switcher(const vom_t *rtu_vom_status, const real_T
   /* '<S138>:1:10' C = [-sin_lat * cos_long, -sin_lat * sin_long,  cos_lat;... */
   /* '<S138>:1:11'                    -sin_long,            cos_long,        0;... */
   /* '<S138>:1:12'          -cos_lat * cos_long, -cos_lat * sin_long, -sin_lat]; */
-  rtb_Product1_bkygj4a2su = AC_norm * 0.0818191908425;
+  rtb_Product1_bkygj4a2su = AC_norm * RT_REAL64(0.0818191908425);
 
   /* Sqrt: '<S141>/Sqrt' incorporates:
    *  Constant: '<S141>/const'
@@ -3016,8 +3016,8 @@ void FW_TECS_switcher(const vom_t *rtu_vom_status, const real_T
    *  Abs: '<S142>/Abs'
    *  Product: '<S142>/Product'
    */
-  if (rtb_Product1_bkygj4a2su <= 0.001) {
-    rtb_Product1_bkygj4a2su = -0.001;
+  if (rtb_Product1_bkygj4a2su <= RT_REAL64(0.001)) {
+    rtb_Product1_bkygj4a2su = -RT_REAL64(0.001);
   }
 
   /* End of Switch: '<S142>/Switch3' */
@@ -3039,7 +3039,7 @@ void FW_TECS_switcher(const vom_t *rtu_vom_status, const real_T
    *  Product: '<S137>/Product2'
    *  Sum: '<S137>/Sum1'
    */
-  dir_idx_0 = AC_norm * ((0.993305620009879 * rtb_Product1_bkygj4a2su) +
+  dir_idx_0 = AC_norm * ((RT_REAL64(0.993305620009879) * rtb_Product1_bkygj4a2su) +
     (*rtu_wp_data_cur_wp_alt));
 
   /* Sqrt: '<S139>/Sqrt' */
@@ -3048,8 +3048,8 @@ void FW_TECS_switcher(const vom_t *rtu_vom_status, const real_T
   /* Switch: '<S140>/Switch3' incorporates:
    *  Product: '<S140>/Product'
    */
-  if (AC_norm_tmp <= 0.001) {
-    rtb_Product1_bkygj4a2su = -0.001;
+  if (AC_norm_tmp <= RT_REAL64(0.001)) {
+    rtb_Product1_bkygj4a2su = -RT_REAL64(0.001);
   }
 
   /* End of Switch: '<S140>/Switch3' */
@@ -3073,9 +3073,9 @@ void FW_TECS_switcher(const vom_t *rtu_vom_status, const real_T
   /* '<S110>:1:19' Vg = sqrt(vel_NE(1)^2 + vel_NE(2)^2); */
   /*  horizontal ground speed */
   /* '<S110>:1:20' if (Vg<0.01) */
-  if (rtb_TrigonometricFunction2_i3ecl5ucim < 0.01) {
+  if (rtb_TrigonometricFunction2_i3ecl5ucim < RT_REAL64(0.01)) {
     /* '<S110>:1:21' Vg =0.001; */
-    rtb_TrigonometricFunction2_i3ecl5ucim = 0.001;
+    rtb_TrigonometricFunction2_i3ecl5ucim = RT_REAL64(0.001);
   }
 
   /* '<S110>:1:23' vel_dir = vel_NE/Vg; */
@@ -3085,7 +3085,7 @@ void FW_TECS_switcher(const vom_t *rtu_vom_status, const real_T
   /* '<S110>:1:27' L1_zeta = 0.7; */
   /*  L1 samping ratio */
   /* '<S110>:1:28' L1 = L1_P*L1_zeta/pi*Vg; */
-  rtb_Sqrt = 2.6738030439438414 * rtb_TrigonometricFunction2_i3ecl5ucim;
+  rtb_Sqrt = RT_REAL64(2.6738030439438414) * rtb_TrigonometricFunction2_i3ecl5ucim;
 
   /* MATLAB Function: '<S135>/MATLAB Function1' */
   /*  L1 length */
@@ -3125,7 +3125,7 @@ void FW_TECS_switcher(const vom_t *rtu_vom_status, const real_T
     (dir_idx_1 * Vg);
   dir_idx_1 = (rtb_VectorConcatenate1_psilb5rrki_idx_1 *
                rtb_Sum_imgtnbczew_tmp_0) - (dir_idx_1 * y);
-  AC_norm = (curvature * ((0.993305620009879 * rtb_Product1_bkygj4a2su) +
+  AC_norm = (curvature * ((RT_REAL64(0.993305620009879) * rtb_Product1_bkygj4a2su) +
               rtu_Sensor_pos_lla[2])) - dir_idx_0;
 
   /* Product: '<S135>/Product' */
@@ -3148,7 +3148,7 @@ void FW_TECS_switcher(const vom_t *rtu_vom_status, const real_T
     /* '<S110>:1:40' chi_ao = atan2(-OA(2), -OA(1)); */
     /* '<S110>:1:41' chi_L = chi_ao - sign(curvature)*gamma; */
     curvature = atan2(-rtb_VectorConcatenate1[1], -rtb_VectorConcatenate1[0]) -
-      -3.1415926535897931;
+      -RT_REAL64(3.1415926535897931);
   } else if (AC_norm >= (rtb_Sqrt + 150.0)) {
     /* '<S110>:1:42' elseif a >= (L1 + R) */
     /* '<S110>:1:43' gamma = 0; */
@@ -3200,11 +3200,11 @@ void FW_TECS_switcher(const vom_t *rtu_vom_status, const real_T
      *  Trigonometry: '<S105>/Sin'
      */
     FW_TECS_switcher_DW.Memory1_PreviousInput = (((4.0 * sin(rt_modd(rt_modd
-      (((curvature - (*rtu_Sensor_chi)) - -3.1415926535897931) +
+      (((curvature - (*rtu_Sensor_chi)) - -RT_REAL64(3.1415926535897931)) +
        FW_TECS_switcher_ConstB.Sum1_a4lnrlft1l,
        FW_TECS_switcher_ConstB.Sum1_a4lnrlft1l),
-      FW_TECS_switcher_ConstB.Sum1_a4lnrlft1l) - 3.1415926535897931)) *
-      0.48999999999999994) * (rtb_TrigonometricFunction2_i3ecl5ucim *
+      FW_TECS_switcher_ConstB.Sum1_a4lnrlft1l) - RT_REAL64(3.1415926535897931))) *
+      RT_REAL64(0.48999999999999994)) * (rtb_TrigonometricFunction2_i3ecl5ucim *
       rtb_TrigonometricFunction2_i3ecl5ucim)) / rtb_Sqrt;
   } else {
     /* MATLAB Function: '<S8>/guidance_line1' */
@@ -3212,18 +3212,18 @@ void FW_TECS_switcher(const vom_t *rtu_vom_status, const real_T
                rtb_VectorConcatenate1_oigmvxpsrq_idx_1),
               (rtb_VectorConcatenate1_oigmvxpsrq_idx_0 * AC_idx_0) +
               (rtb_VectorConcatenate1_oigmvxpsrq_idx_1 * AC_idx_1));
-    if (y < -1.5707963267948966) {
-      y = -1.5707963267948966;
+    if (y < -RT_REAL64(1.5707963267948966)) {
+      y = -RT_REAL64(1.5707963267948966);
     }
 
-    if (y > 1.5707963267948966) {
-      y = 1.5707963267948966;
+    if (y > RT_REAL64(1.5707963267948966)) {
+      y = RT_REAL64(1.5707963267948966);
     }
 
     /* Update for Memory: '<S8>/Memory1' incorporates:
      *  MATLAB Function: '<S8>/guidance_line1'
      */
-    FW_TECS_switcher_DW.Memory1_PreviousInput = ((1.9599999999999997 * (Vg_0 *
+    FW_TECS_switcher_DW.Memory1_PreviousInput = ((RT_REAL64(1.9599999999999997) * (Vg_0 *
       Vg_0)) / rtb_Sum_lskvbzjz0i) * sin(y);
   }
 
@@ -27,20 +27,20 @@
 extern void FW_TECS_switcher_Init(void);
 extern void FW_TECS_switcher(const vom_t *rtu_vom_status, const real_T
   *rtu_Pilot_roll_ch, const real_T *rtu_Pilot_throttle_ch, const real_T
-  rtu_Sensor_eul_ang[3], const real_T rtu_Sensor_pos_lla[3], const real_T
+  rtu_Sensor_eul_ang[3], const real64_T rtu_Sensor_pos_lla[3], const real_T
   rtu_Sensor_vel_ned[3], const real_T *rtu_Sensor_aspd_cas, const real_T
   *rtu_Sensor_gspd, const real_T *rtu_Sensor_chi, const uint8_T *rtu_TECS_mode,
-  const real_T *rtu_mode_data_ft_data_FT_x, const real_T
+  const real64_T *rtu_mode_data_ft_data_FT_x, const real64_T
   *rtu_mode_data_ft_data_FT_y, const real_T *rtu_mode_data_ft_data_FT_Altitude,
   const real_T *rtu_mode_data_ft_data_FT_Heading, const real_T
   *rtu_mode_data_ft_data_FT_AirspeedRef, const real_T
   *rtu_mode_data_loiter_data_loiter_radius, const real_T
-  *rtu_mode_data_loiter_data_loiter_direction, const real_T
-  *rtu_mode_data_loiter_data_loiter_Center_Lat, const real_T
+  *rtu_mode_data_loiter_data_loiter_direction, const real64_T
+  *rtu_mode_data_loiter_data_loiter_Center_Lat, const real64_T
   *rtu_mode_data_loiter_data_loiter_Center_Lon, const real_T
   *rtu_mode_data_loiter_data_loiter_altitude, const real_T
-  *rtu_mode_data_loiter_data_loiter_AirSpeedRef, const real_T
-  *rtu_mode_data_bt_data_BT_Hover_Lat, const real_T
+  *rtu_mode_data_loiter_data_loiter_AirSpeedRef, const real64_T
+  *rtu_mode_data_bt_data_BT_Hover_Lat, const real64_T
   *rtu_mode_data_bt_data_BT_Hover_Lon, const real_T
   *rtu_mode_data_bt_data_BT_Altitude, const real_T
   *rtu_mode_data_bt_data_BT_Heading, const lifter_state_t
@@ -48,7 +48,7 @@ extern void FW_TECS_switcher(const vom_t *rtu_vom_status, const real_T
   *rtu_mode_data_fwrth_data_phase, const real_T *rtu_mode_data_fwrth_data_CAS_sp,
   const real_T *rtu_mode_data_fwrth_data_alt_sp, const boolean_T
   *rtu_wp_data_wp_list_valid, const uint16_T *rtu_wp_data_wp_list_count, const
-  real_T *rtu_wp_data_cur_wp_lat, const real_T *rtu_wp_data_cur_wp_lon, const
+  real64_T *rtu_wp_data_cur_wp_lat, const real64_T *rtu_wp_data_cur_wp_lon, const
   real_T *rtu_wp_data_cur_wp_alt, const uint16_T *rtu_wp_data_cmd_wp_idx, const
   boolean_T *rtu_wp_data_last_wp_land, const vom_t *rtu_std_command_vom_cmd,
   const real_T *rtu_std_command_airspeed_cas_cmd, const real_T
@@ -58,12 +58,12 @@ extern void FW_TECS_switcher(const vom_t *rtu_vom_status, const real_T
   *rty_FWRTH_SM_in_approach_circle_done, boolean_T
   *rty_FWRTH_SM_in_reduce_speed_alt_done, boolean_T
   *rty_FWRTH_SM_in_circle_align_done, boolean_T
-  *rty_FWRTH_SM_in_cross_tangent_point_done, real_T *rty_FWRTH_SM_in_land_lat,
-  real_T *rty_FWRTH_SM_in_land_lon, real_T *rty_FWRTH_SM_in_approach_ang, real_T
+  *rty_FWRTH_SM_in_cross_tangent_point_done, real64_T *rty_FWRTH_SM_in_land_lat,
+  real64_T *rty_FWRTH_SM_in_land_lon, real_T *rty_FWRTH_SM_in_approach_ang, real_T
   *rty_WP_SMdata_cur_leg_heading, real_T *rty_WP_SMdata_cur_leg_length, real_T
   *rty_WP_SMdata_cur_leg_remaining_dist, boolean_T *rty_WP_SMdata_wp_list_valid,
-  boolean_T *rty_WP_SMdata_last_wp_land, real_T *rty_WP_SMdata_land_wp_lat,
-  real_T *rty_WP_SMdata_land_wp_lon, real_T *rty_WP_SMdata_curpos_to_wp_heading,
+  boolean_T *rty_WP_SMdata_last_wp_land, real64_T *rty_WP_SMdata_land_wp_lat,
+  real64_T *rty_WP_SMdata_land_wp_lon, real_T *rty_WP_SMdata_curpos_to_wp_heading,
   boolean_T *rty_WP_SMdata_WPN_cmd_received);
 
 /* Model reference registration function */
@@ -37,35 +37,35 @@ const FW_TECS_switcher_TConstB FW_TECS_switcher_ConstB = {
   { 22500.0, 160000.0 },               /* '<S44>/Square' */
   182500.0,                            /* '<S44>/Sum of Elements' */
   427.20018726587654,                  /* '<S44>/Sqrt' */
-  6.7053867095570011E-5,               /* '<S75>/Divide' */
-  0.4141434019159333,                  /* '<S75>/Trigonometric Function1' */
-  0.99999999775188941,                 /* '<S75>/Trigonometric Function2' */
-  0.41414340098489311,                 /* '<S75>/Product' */
-  0.91021164717306147,                 /* '<S75>/Trigonometric Function3' */
-  6.7053867045321848E-5,               /* '<S75>/Trigonometric Function4' */
+  RT_REAL64(6.7053867095570011E-5),    /* '<S75>/Divide' */
+  RT_REAL64(0.4141434019159333),       /* '<S75>/Trigonometric Function1' */
+  RT_REAL64(0.99999999775188941),      /* '<S75>/Trigonometric Function2' */
+  RT_REAL64(0.41414340098489311),      /* '<S75>/Product' */
+  RT_REAL64(0.91021164717306147),      /* '<S75>/Trigonometric Function3' */
+  RT_REAL64(6.7053867045321848E-5),    /* '<S75>/Trigonometric Function4' */
   6.2831853071795862,                  /* '<S76>/Sum1' */
   6.2831853071795862,                  /* '<S77>/Sum1' */
-  0.414139557454227,                   /* '<S95>/Trigonometric Function' */
-  0.03388456348677589,                 /* '<S99>/Product' */
-  0.0011481636426893458,               /* '<S99>/Square' */
-  0.99885183635731067,                 /* '<S99>/Add' */
-  0.9994257532990185,                  /* '<S99>/Sqrt' */
-  0.9994257532990185,                  /* '<S100>/Abs' */
+  RT_REAL64(0.414139557454227),        /* '<S95>/Trigonometric Function' */
+  RT_REAL64(0.03388456348677589),      /* '<S99>/Product' */
+  RT_REAL64(0.0011481636426893458),    /* '<S99>/Square' */
+  RT_REAL64(0.99885183635731067),      /* '<S99>/Add' */
+  RT_REAL64(0.9994257532990185),       /* '<S99>/Sqrt' */
+  RT_REAL64(0.9994257532990185),       /* '<S100>/Abs' */
   1.0,                                 /* '<S100>/Switch1' */
-  0.001,                               /* '<S100>/Product' */
-  0.9994257532990185,                  /* '<S100>/Switch3' */
-  6.38180172858896E+6,                 /* '<S99>/Divide' */
-  6.38180172858896E+6,                 /* '<S95>/Sum' */
-  0.91021339638109977,                 /* '<S95>/Trigonometric Function1' */
-  0.5645887464139302,                  /* '<S95>/Trigonometric Function3' */
-  3.2795839155041194E+6,               /* '<S95>/Product' */
-  0.82537236894794752,                 /* '<S95>/Trigonometric Function2' */
-  4.7944241940640165E+6,               /* '<S95>/Product1' */
-  6.3390795227961745E+6,               /* '<S95>/Product2' */
-  6.3390795227961745E+6,               /* '<S95>/Sum1' */
-  2.62526358823796E+6,                 /* '<S95>/Product3' */
+  RT_REAL64(0.001),                    /* '<S100>/Product' */
+  RT_REAL64(0.9994257532990185),       /* '<S100>/Switch3' */
+  RT_REAL64(6.38180172858896E+6),      /* '<S99>/Divide' */
+  RT_REAL64(6.38180172858896E+6),      /* '<S95>/Sum' */
+  RT_REAL64(0.91021339638109977),      /* '<S95>/Trigonometric Function1' */
+  RT_REAL64(0.5645887464139302),       /* '<S95>/Trigonometric Function3' */
+  RT_REAL64(3.2795839155041194E+6),    /* '<S95>/Product' */
+  RT_REAL64(0.82537236894794752),      /* '<S95>/Trigonometric Function2' */
+  RT_REAL64(4.7944241940640165E+6),    /* '<S95>/Product1' */
+  RT_REAL64(6.3390795227961745E+6),    /* '<S95>/Product2' */
+  RT_REAL64(6.3390795227961745E+6),    /* '<S95>/Sum1' */
+  RT_REAL64(2.62526358823796E+6),      /* '<S95>/Product3' */
 
-  { 3.2795839155041194E+6, 4.7944241940640165E+6, 2.62526358823796E+6 },/* '<S95>/Vector Concatenate' */
+  { RT_REAL64(3.2795839155041194E+6), RT_REAL64(4.7944241940640165E+6), RT_REAL64(2.62526358823796E+6) },/* '<S95>/Vector Concatenate' */
   6.2831853071795862                   /* '<S111>/Sum1' */
 };
 
@@ -22,10 +22,10 @@
 
 /* Block states (default storage) for model 'FW_TECS_switcher' */
 typedef struct {
-  real_T cur_pos_sp_DSTATE[3];         /* '<S106>/cur_pos_sp' */
-  real_T prev_pos_sp_DSTATE[3];        /* '<S106>/prev_pos_sp' */
-  real_T Delay1_DSTATE[3];             /* '<S8>/Delay1' */
-  real_T Delay2_DSTATE[3];             /* '<S8>/Delay2' */
+  real64_T cur_pos_sp_DSTATE[3];       /* '<S106>/cur_pos_sp' */
+  real64_T prev_pos_sp_DSTATE[3];      /* '<S106>/prev_pos_sp' */
+  real64_T Delay1_DSTATE[3];           /* '<S8>/Delay1' */
+  real64_T Delay2_DSTATE[3];           /* '<S8>/Delay2' */
   real_T Delay1_DSTATE_n1as2selwq;     /* '<S23>/Delay1' */
   real_T Delay_DSTATE;                 /* '<S22>/Delay' */
   real_T Delay1_DSTATE_g1oevxsf0d;     /* '<S90>/Delay1' */
@@ -79,38 +79,38 @@ typedef struct {
   const real_T Square[2];              /* '<S44>/Square' */
   const real_T SumofElements;          /* '<S44>/Sum of Elements' */
   const real_T Sqrt;                   /* '<S44>/Sqrt' */
-  const real_T Divide;                 /* '<S75>/Divide' */
-  const real_T TrigonometricFunction1; /* '<S75>/Trigonometric Function1' */
-  const real_T TrigonometricFunction2; /* '<S75>/Trigonometric Function2' */
-  const real_T Product;                /* '<S75>/Product' */
-  const real_T TrigonometricFunction3; /* '<S75>/Trigonometric Function3' */
-  const real_T TrigonometricFunction4; /* '<S75>/Trigonometric Function4' */
+  const real64_T Divide;               /* '<S75>/Divide' */
+  const real64_T TrigonometricFunction1; /* '<S75>/Trigonometric Function1' */
+  const real64_T TrigonometricFunction2; /* '<S75>/Trigonometric Function2' */
+  const real64_T Product;              /* '<S75>/Product' */
+  const real64_T TrigonometricFunction3; /* '<S75>/Trigonometric Function3' */
+  const real64_T TrigonometricFunction4; /* '<S75>/Trigonometric Function4' */
   const real_T Sum1_j0ejptrk3o;        /* '<S76>/Sum1' */
   const real_T Sum1_o5uamo4z5t;        /* '<S77>/Sum1' */
-  const real_T TrigonometricFunction;  /* '<S95>/Trigonometric Function' */
-  const real_T Product_ixlmgikysu;     /* '<S99>/Product' */
-  const real_T Square_hrgnbp0wcl;      /* '<S99>/Square' */
-  const real_T ue2sin2L;               /* '<S99>/Add' */
-  const real_T Sqrt_kipzpqoffo;        /* '<S99>/Sqrt' */
-  const real_T Abs;                    /* '<S100>/Abs' */
-  const real_T Switch1;                /* '<S100>/Switch1' */
-  const real_T Product_jugfhni0ik;     /* '<S100>/Product' */
-  const real_T Switch3;                /* '<S100>/Switch3' */
-  const real_T R_EL;                   /* '<S99>/Divide' */
-  const real_T Sum;                    /* '<S95>/Sum' */
-  const real_T TrigonometricFunction1_cpwo5qs0jf;/* '<S95>/Trigonometric Function1' */
-  const real_T TrigonometricFunction3_g5flhwz4ih;/* '<S95>/Trigonometric Function3' */
-  const real_T Product_pjio240id2;     /* '<S95>/Product' */
-  const real_T TrigonometricFunction2_m40yky3bct;/* '<S95>/Trigonometric Function2' */
-  const real_T Product1;               /* '<S95>/Product1' */
-  const real_T Product2;               /* '<S95>/Product2' */
-  const real_T Sum1_jiwnekazg5;        /* '<S95>/Sum1' */
-  const real_T Product3;               /* '<S95>/Product3' */
-  const real_T VectorConcatenate[3];   /* '<S95>/Vector Concatenate' */
+  const real64_T TrigonometricFunction;  /* '<S95>/Trigonometric Function' */
+  const real64_T Product_ixlmgikysu;   /* '<S99>/Product' */
+  const real64_T Square_hrgnbp0wcl;    /* '<S99>/Square' */
+  const real64_T ue2sin2L;             /* '<S99>/Add' */
+  const real64_T Sqrt_kipzpqoffo;      /* '<S99>/Sqrt' */
+  const real64_T Abs;                  /* '<S100>/Abs' */
+  const real64_T Switch1;              /* '<S100>/Switch1' */
+  const real64_T Product_jugfhni0ik;   /* '<S100>/Product' */
+  const real64_T Switch3;              /* '<S100>/Switch3' */
+  const real64_T R_EL;                 /* '<S99>/Divide' */
+  const real64_T Sum;                  /* '<S95>/Sum' */
+  const real64_T TrigonometricFunction1_cpwo5qs0jf;/* '<S95>/Trigonometric Function1' */
+  const real64_T TrigonometricFunction3_g5flhwz4ih;/* '<S95>/Trigonometric Function3' */
+  const real64_T Product_pjio240id2;   /* '<S95>/Product' */
+  const real64_T TrigonometricFunction2_m40yky3bct;/* '<S95>/Trigonometric Function2' */
+  const real64_T Product1;             /* '<S95>/Product1' */
+  const real64_T Product2;             /* '<S95>/Product2' */
+  const real64_T Sum1_jiwnekazg5;      /* '<S95>/Sum1' */
+  const real64_T Product3;             /* '<S95>/Product3' */
+  const real64_T VectorConcatenate[3]; /* '<S95>/Vector Concatenate' */
   const real_T Sum1_a4lnrlft1l;        /* '<S111>/Sum1' */
 } FW_TECS_switcher_TConstB;
 
-extern void FW_TECS_switcher_illvnqr3hx(const real_T rtu_LLA[3], real_T rty_C[9]);
+extern void FW_TECS_switcher_illvnqr3hx(const real64_T rtu_LLA[3], real_T rty_C[9]);
 
 /* Invariant block signals (default storage) */
 extern const FW_TECS_switcher_TConstB FW_TECS_switcher_ConstB;
@@ -100,8 +100,8 @@ typedef struct {
   boolean_T reduce_speed_alt_done;
   boolean_T circle_align_done;
   boolean_T cross_tangent_point_done;
-  real_T land_lat;
-  real_T land_lon;
+  real64_T land_lat;
+  real64_T land_lon;
   real_T approach_ang;
 } busFWRTH_data_in;
 
@@ -116,8 +116,8 @@ typedef struct {
   real_T cur_leg_remaining_dist;
   boolean_T wp_list_valid;
   boolean_T last_wp_land;
-  real_T land_wp_lat;
-  real_T land_wp_lon;
+  real64_T land_wp_lat;
+  real64_T land_wp_lon;
   real_T curpos_to_wp_heading;
   boolean_T WPN_cmd_received;
 } busWP_SMdata_in;
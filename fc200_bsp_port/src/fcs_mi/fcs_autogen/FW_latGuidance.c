@@ -27,10 +27,10 @@ void FW_latGuidance(const real_T *rtu_FW_TECS_switcher_roll_cmd, const
 {
   real_T sin_lat[9];
   real_T rtb_Product[3];
-  real_T cos_lat;
-  real_T rtb_Sqrt;
-  real_T rtb_Sum_jyf4qwqbhl_idx_0_tmp;
-  real_T rtb_TrigonometricFunction;
+  real64_T cos_lat;
+  real64_T rtb_Sqrt;
+  real64_T rtb_Sum_jyf4qwqbhl_idx_0_tmp;
+  real64_T rtb_TrigonometricFunction;
   int32_T i;
 
   /* Trigonometry: '<S8>/Trigonometric Function' */
@@ -51,7 +51,7 @@ void FW_latGuidance(const real_T *rtu_FW_TECS_switcher_roll_cmd, const
   /* Product: '<S11>/Product' incorporates:
    *  Constant: '<S11>/e'
    */
-  rtb_Sqrt = rtb_TrigonometricFunction * 0.0818191908425;
+  rtb_Sqrt = rtb_TrigonometricFunction * RT_REAL64(0.0818191908425);
 
   /* Sqrt: '<S11>/Sqrt' incorporates:
    *  Constant: '<S11>/const'
@@ -64,8 +64,8 @@ void FW_latGuidance(const real_T *rtu_FW_TECS_switcher_roll_cmd, const
    *  Abs: '<S12>/Abs'
    *  Product: '<S12>/Product'
    */
-  if (rtb_Sqrt <= 0.001) {
-    rtb_Sqrt = -0.001;
+  if (rtb_Sqrt <= RT_REAL64(0.001)) {
+    rtb_Sqrt = -RT_REAL64(0.001);
   }
 
   /* End of Switch: '<S12>/Switch3' */
@@ -109,7 +109,7 @@ void FW_latGuidance(const real_T *rtu_FW_TECS_switcher_roll_cmd, const
     FW_latGuidance_ConstB.VectorConcatenate[0];
   rtb_Sum_jyf4qwqbhl_idx_0_tmp = (rtb_Sum_jyf4qwqbhl_idx_0_tmp * sin
     (rtu_Sensor->pos_lla[1])) - FW_latGuidance_ConstB.VectorConcatenate[1];
-  rtb_TrigonometricFunction = (rtb_TrigonometricFunction * ((0.993305620009879 *
+  rtb_TrigonometricFunction = (rtb_TrigonometricFunction * ((RT_REAL64(0.993305620009879) *
     rtb_Sqrt) + rtu_Sensor->pos_lla[2])) -
     FW_latGuidance_ConstB.VectorConcatenate[2];
 
@@ -144,9 +144,9 @@ void FW_latGuidance(const real_T *rtu_FW_TECS_switcher_roll_cmd, const
 
   /*  horizontal ground speed */
   /* '<S5>:1:22' if (Vg<0.01) */
-  if (cos_lat < 0.01) {
+  if (cos_lat < RT_REAL64(0.01)) {
     /* '<S5>:1:23' Vg =0.001; */
-    cos_lat = 0.001;
+    cos_lat = RT_REAL64(0.001);
   }
 
   /* '<S5>:1:25' vel_dir = vel_NE/Vg; */
@@ -156,7 +156,7 @@ void FW_latGuidance(const real_T *rtu_FW_TECS_switcher_roll_cmd, const
   /* '<S5>:1:29' L1_zeta = 0.7; */
   /*  L1 samping ratio */
   /* '<S5>:1:30' L1 = L1_P*L1_zeta/pi*Vg; */
-  rtb_TrigonometricFunction = 2.228169203286535 * cos_lat;
+  rtb_TrigonometricFunction = RT_REAL64(2.228169203286535) * cos_lat;
 
   /*  L1 length */
   /*  P = start_pos; */
@@ -173,7 +173,7 @@ void FW_latGuidance(const real_T *rtu_FW_TECS_switcher_roll_cmd, const
   /* '<S5>:1:42' if (L1 + a) <= R */
   if ((rtb_TrigonometricFunction + rtb_Sqrt) <= 200.0) {
     /* '<S5>:1:43' gamma = pi; */
-    rtb_Sqrt = 3.1415926535897931;
+    rtb_Sqrt = RT_REAL64(3.1415926535897931);
   } else if (rtb_Sqrt >= (rtb_TrigonometricFunction + 200.0)) {
     /* '<S5>:1:44' elseif a >= (L1 + R) */
     /* '<S5>:1:45' gamma = 0; */
@@ -204,13 +204,13 @@ void FW_latGuidance(const real_T *rtu_FW_TECS_switcher_roll_cmd, const
   rtb_Sqrt = atan2(-rtb_Product[1], -rtb_Product[0]) - rtb_Sqrt;
 
   /* '<S5>:1:67' if ang_in > pi */
-  if (rtb_Sqrt > 3.1415926535897931) {
+  if (rtb_Sqrt > RT_REAL64(3.1415926535897931)) {
     /* '<S5>:1:68' ang_in = ang_in - 2*pi; */
-    rtb_Sqrt -= 6.2831853071795862;
-  } else if (rtb_Sqrt < -3.1415926535897931) {
+    rtb_Sqrt -= RT_REAL64(6.2831853071795862);
+  } else if (rtb_Sqrt < -RT_REAL64(3.1415926535897931)) {
     /* '<S5>:1:69' elseif ang_in < -pi */
     /* '<S5>:1:70' ang_in = ang_in + 2*pi; */
-    rtb_Sqrt += 6.2831853071795862;
+    rtb_Sqrt += RT_REAL64(6.2831853071795862);
   } else {
     /* no actions */
   }
@@ -221,13 +221,13 @@ void FW_latGuidance(const real_T *rtu_FW_TECS_switcher_roll_cmd, const
                     cos_lat);
 
   /* '<S5>:1:67' if ang_in > pi */
-  if (rtb_Sqrt > 3.1415926535897931) {
+  if (rtb_Sqrt > RT_REAL64(3.1415926535897931)) {
     /* '<S5>:1:68' ang_in = ang_in - 2*pi; */
-    rtb_Sqrt -= 6.2831853071795862;
-  } else if (rtb_Sqrt < -3.1415926535897931) {
+    rtb_Sqrt -= RT_REAL64(6.2831853071795862);
+  } else if (rtb_Sqrt < -RT_REAL64(3.1415926535897931)) {
     /* '<S5>:1:69' elseif ang_in < -pi */
     /* '<S5>:1:70' ang_in = ang_in + 2*pi; */
-    rtb_Sqrt += 6.2831853071795862;
+    rtb_Sqrt += RT_REAL64(6.2831853071795862);
   } else {
     /* no actions */
   }
@@ -236,24 +236,24 @@ void FW_latGuidance(const real_T *rtu_FW_TECS_switcher_roll_cmd, const
   /* '<S5>:1:57' eta = max(eta, -pi); */
   /* '<S5>:1:58' eta = min(eta, pi); */
   /* '<S5>:1:60' lat_ax = 4*L1_zeta^2*Vg^2/L1*sin(eta); */
-  if (rtb_Sqrt < -3.1415926535897931) {
-    rtb_Sqrt = -3.1415926535897931;
+  if (rtb_Sqrt < -RT_REAL64(3.1415926535897931)) {
+    rtb_Sqrt = -RT_REAL64(3.1415926535897931);
   }
 
-  if (rtb_Sqrt > 3.1415926535897931) {
-    rtb_Sqrt = 3.1415926535897931;
+  if (rtb_Sqrt > RT_REAL64(3.1415926535897931)) {
+    rtb_Sqrt = RT_REAL64(3.1415926535897931);
   }
 
   /* Trigonometry: '<S2>/Atan' incorporates:
    *  MATLAB Function: '<S2>/MATLAB Function'
    */
-  cos_lat = atan2(((1.9599999999999997 * (cos_lat * cos_lat)) /
-                   rtb_TrigonometricFunction) * sin(rtb_Sqrt), 9.81);
+  cos_lat = atan2(((RT_REAL64(1.9599999999999997) * (cos_lat * cos_lat)) /
+                   rtb_TrigonometricFunction) * sin(rtb_Sqrt), RT_REAL64(9.81));
 
   /* Saturate: '<Root>/Saturation1' */
-  if (cos_lat > 0.52359877559829882) {
+  if (cos_lat > RT_REAL64(0.52359877559829882)) {
     *rty_rollCmd = 0.52359877559829882;
-  } else if (cos_lat < -0.52359877559829882) {
+  } else if (cos_lat < -RT_REAL64(0.52359877559829882)) {
     *rty_rollCmd = -0.52359877559829882;
   } else {
     *rty_rollCmd = cos_lat;
@@ -18,27 +18,27 @@
 
 /* Invariant block signals (default storage) */
 const FW_latGuidance_TConstB FW_latGuidance_ConstB = {
-  0.414139557454227,                   /* '<S9>/Trigonometric Function' */
-  0.03388456348677589,                 /* '<S13>/Product' */
-  0.0011481636426893458,               /* '<S13>/Square' */
-  0.99885183635731067,                 /* '<S13>/Add' */
-  0.9994257532990185,                  /* '<S13>/Sqrt' */
-  0.9994257532990185,                  /* '<S14>/Abs' */
+  RT_REAL64(0.414139557454227),        /* '<S9>/Trigonometric Function' */
+  RT_REAL64(0.03388456348677589),      /* '<S13>/Product' */
+  RT_REAL64(0.0011481636426893458),    /* '<S13>/Square' */
+  RT_REAL64(0.99885183635731067),      /* '<S13>/Add' */
+  RT_REAL64(0.9994257532990185),       /* '<S13>/Sqrt' */
+  RT_REAL64(0.9994257532990185),       /* '<S14>/Abs' */
   1.0,                                 /* '<S14>/Switch1' */
-  0.001,                               /* '<S14>/Product' */
-  0.9994257532990185,                  /* '<S14>/Switch3' */
-  6.38180172858896E+6,                 /* '<S13>/Divide' */
-  6.38180172858896E+6,                 /* '<S9>/Sum' */
-  0.91021339638109977,                 /* '<S9>/Trigonometric Function1' */
-  0.5645887464139302,                  /* '<S9>/Trigonometric Function3' */
-  3.2795839155041194E+6,               /* '<S9>/Product' */
-  0.82537236894794752,                 /* '<S9>/Trigonometric Function2' */
-  4.7944241940640165E+6,               /* '<S9>/Product1' */
-  6.3390795227961745E+6,               /* '<S9>/Product2' */
-  6.3390795227961745E+6,               /* '<S9>/Sum1' */
-  2.62526358823796E+6,                 /* '<S9>/Product3' */
+  RT_REAL64(0.001),                    /* '<S14>/Product' */
+  RT_REAL64(0.9994257532990185),       /* '<S14>/Switch3' */
+  RT_REAL64(6.38180172858896E+6),      /* '<S13>/Divide' */
+  RT_REAL64(6.38180172858896E+6),      /* '<S9>/Sum' */
+  RT_REAL64(0.91021339638109977),      /* '<S9>/Trigonometric Function1' */
+  RT_REAL64(0.5645887464139302),       /* '<S9>/Trigonometric Function3' */
+  RT_REAL64(3.2795839155041194E+6),    /* '<S9>/Product' */
+  RT_REAL64(0.82537236894794752),      /* '<S9>/Trigonometric Function2' */
+  RT_REAL64(4.7944241940640165E+6),    /* '<S9>/Product1' */
+  RT_REAL64(6.3390795227961745E+6),    /* '<S9>/Product2' */
+  RT_REAL64(6.3390795227961745E+6),    /* '<S9>/Sum1' */
+  RT_REAL64(2.62526358823796E+6),      /* '<S9>/Product3' */
 
-  { 3.2795839155041194E+6, 4.7944241940640165E+6, 2.62526358823796E+6 }/* '<S9>/Vector Concatenate' */
+  { RT_REAL64(3.2795839155041194E+6), RT_REAL64(4.7944241940640165E+6), RT_REAL64(2.62526358823796E+6) }/* '<S9>/Vector Concatenate' */
 };
 
 /*
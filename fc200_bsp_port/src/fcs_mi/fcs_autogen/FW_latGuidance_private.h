@@ -21,26 +21,26 @@
 
 /* Invariant block signals for model 'FW_latGuidance' */
 typedef struct {
-  const real_T TrigonometricFunction;  /* '<S9>/Trigonometric Function' */
-  const real_T Product;                /* '<S13>/Product' */
-  const real_T Square;                 /* '<S13>/Square' */
-  const real_T ue2sin2L;               /* '<S13>/Add' */
-  const real_T Sqrt;                   /* '<S13>/Sqrt' */
-  const real_T Abs;                    /* '<S14>/Abs' */
-  const real_T Switch1;                /* '<S14>/Switch1' */
-  const real_T Product_dr12p5kggg;     /* '<S14>/Product' */
-  const real_T Switch3;                /* '<S14>/Switch3' */
-  const real_T R_EL;                   /* '<S13>/Divide' */
-  const real_T Sum;                    /* '<S9>/Sum' */
-  const real_T TrigonometricFunction1; /* '<S9>/Trigonometric Function1' */
-  const real_T TrigonometricFunction3; /* '<S9>/Trigonometric Function3' */
-  const real_T Product_ppym1auoep;     /* '<S9>/Product' */
-  const real_T TrigonometricFunction2; /* '<S9>/Trigonometric Function2' */
-  const real_T Product1;               /* '<S9>/Product1' */
-  const real_T Product2;               /* '<S9>/Product2' */
-  const real_T Sum1;                   /* '<S9>/Sum1' */
-  const real_T Product3;               /* '<S9>/Product3' */
-  const real_T VectorConcatenate[3];   /* '<S9>/Vector Concatenate' */
+  const real64_T TrigonometricFunction;  /* '<S9>/Trigonometric Function' */
+  const real64_T Product;              /* '<S13>/Product' */
+  const real64_T Square;               /* '<S13>/Square' */
+  const real64_T ue2sin2L;             /* '<S13>/Add' */
+  const real64_T Sqrt;                 /* '<S13>/Sqrt' */
+  const real64_T Abs;                  /* '<S14>/Abs' */
+  const real64_T Switch1;              /* '<S14>/Switch1' */
+  const real64_T Product_dr12p5kggg;   /* '<S14>/Product' */
+  const real64_T Switch3;              /* '<S14>/Switch3' */
+  const real64_T R_EL;                 /* '<S13>/Divide' */
+  const real64_T Sum;                  /* '<S9>/Sum' */
+  const real64_T TrigonometricFunction1; /* '<S9>/Trigonometric Function1' */
+  const real64_T TrigonometricFunction3; /* '<S9>/Trigonometric Function3' */
+  const real64_T Product_ppym1auoep;   /* '<S9>/Product' */
+  const real64_T TrigonometricFunction2; /* '<S9>/Trigonometric Function2' */
+  const real64_T Product1;             /* '<S9>/Product1' */
+  const real64_T Product2;             /* '<S9>/Product2' */
+  const real64_T Sum1;                 /* '<S9>/Sum1' */
+  const real64_T Product3;             /* '<S9>/Product3' */
+  const real64_T VectorConcatenate[3]; /* '<S9>/Vector Concatenate' */
 } FW_latGuidance_TConstB;
 
 /* Invariant block signals (default storage) */
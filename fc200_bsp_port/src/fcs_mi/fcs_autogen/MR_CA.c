@@ -190,11 +190,11 @@ void MR_CA(const real_T *rtu_busControllerAltCtrl_forceDes, const real_T
 
   svd_o1pFIz8b(tmp, U, s, V);
   rtb_RateLimiter1 = fabs(s[0]);
-  if (rtb_RateLimiter1 < 4.4501477170144028E-308) {
-    rtb_RateLimiter1 = 4.94065645841247E-324;
+  if (rtb_RateLimiter1 < RT_REALMIN2) {
+    rtb_RateLimiter1 = RT_DENORM_MIN;
   } else {
     (void)frexp(rtb_RateLimiter1, &r);
-    rtb_RateLimiter1 = ldexp(1.0, r - 53);
+    rtb_RateLimiter1 = ldexp(1.0, r - RT_MANT_DIG);
   }
 
   rtb_RateLimiter1 *= 8.0;
@@ -364,7 +364,7 @@ void MR_CA(const real_T *rtu_busControllerAltCtrl_forceDes, const real_T
     /* '<S6>:1:27' F_err = F_d - B*u_a; */
     /* '<S6>:1:28' F_err_norm = norm(F_err); */
     rtb_RateLimiter1 = 0.0;
-    scale = 3.3121686421112381E-170;
+    scale = RT_NRM2_SCALE;
     for (r = 0; r < 4; r++) {
       t = 0.0;
       for (vcol = 0; vcol < 8; vcol++) {
@@ -24,7 +24,7 @@ typedef struct {
   real_T dcm_e2b[9];
   real_T eul_ang[3];
   real_T omg[3];
-  real_T pos_lla[3];
+  real64_T pos_lla[3];
   real_T vel_ned[3];
   real_T accel_b[3];
   real_T aspd_cas;
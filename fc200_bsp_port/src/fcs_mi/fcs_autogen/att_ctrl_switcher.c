@@ -21,7 +21,7 @@
 #include "rt_modd.h"
 #include <math.h>
 #include "look1_binlca.h"
-#include "look1_binlc.h"
+#include "look1_binlcc.h"
 #include "zero_crossing_types.h"
 #include <string.h>
 
@@ -48,6 +48,10 @@ void att_ctrl_switcher_Init(void)
 
   /* InitializeConditions for Delay: '<S45>/Delay' */
   att_ctrl_switcher_DW.icLoad_b1rfgb1u0f = true;
+
+  /* InitializeConditions for Lookup_n-D: '<S11>/1-D Lookup Table' */
+  look1_binlcc_init(&att_ctrl_switcher_DW.uDLookupTable_cache,
+                    att_ctrl_switcher_ConstP.uDLookupTable_bp01Data, 3U);
 }
 
 /* Output and update for referenced model: 'att_ctrl_switcher' */
@@ -510,9 +514,10 @@ void att_ctrl_switcher(const real_T rtu_sensor_eul_ang[3], const real_T
      *  Lookup_n-D: '<S11>/1-D Lookup Table'
      *  Product: '<S11>/Product1'
      */
-    rtb_BusAssignment1_hzqxy3zxod_pitchCmd = look1_binlc(*rtu_sensor_aspd_cas,
+    rtb_BusAssignment1_hzqxy3zxod_pitchCmd = look1_binlcc(*rtu_sensor_aspd_cas,
       att_ctrl_switcher_ConstP.uDLookupTable_bp01Data,
-      att_ctrl_switcher_ConstP.uDLookupTable_tableData, 3U) *
+      att_ctrl_switcher_ConstP.uDLookupTable_tableData,
+      &att_ctrl_switcher_DW.uDLookupTable_cache, 3U) *
       (-rtu_Pilot->pitch_ch);
   }
 
@@ -19,6 +19,7 @@
 #include "rtwtypes.h"
 #include "zero_crossing_types.h"
 #include "att_ctrl_switcher_types.h"
+#include "look1_binlcc.h"
 
 /* Block states (default storage) for model 'att_ctrl_switcher' */
 typedef struct {
@@ -30,6 +31,7 @@ typedef struct {
   real_T Delay_DSTATE_psumudlq5n;      /* '<S34>/Delay' */
   real_T Delay_DSTATE_jzsp25meix;      /* '<S45>/Delay' */
   real_T PrevY;                        /* '<S9>/Rate Limiter' */
+  look1_cache_T uDLookupTable_cache;   /* '<S11>/1-D Lookup Table' */
   uint8_T FixPtUnitDelay2_DSTATE;      /* '<S30>/FixPt Unit Delay2' */
   uint8_T DelayInput1_DSTATE;          /* '<S43>/Delay Input1' */
   boolean_T DelayInput1_DSTATE_nuj420kciy;/* '<S31>/Delay Input1' */
@@ -37,6 +37,7 @@
 #include "FW_throttle.h"
 #include "FW_CA.h"
 #include "transitionHandler.h"
+#include "fcs_profile.h"
 
 const busMode_data controllerMain_rtZbusMode_data = {
   {
@@ -158,14 +159,14 @@ void controllerMain_step(void)
   real_T rtb_velCmdH_y_fn5sqdulrh;
   real_T rtb_hRateCmd_n0d5yq2y1h;
   real_T rtb_hCmd_f0mpth4u0h;
-  real_T rtb_land_lat_fbnpixa3xe;
-  real_T rtb_land_lon_fuvjv0mdij;
+  real64_T rtb_land_lat_fbnpixa3xe;
+  real64_T rtb_land_lon_fuvjv0mdij;
   real_T rtb_approach_ang_baxqfjn0jo;
   real_T rtb_cur_leg_heading_priipbumn4;
   real_T rtb_cur_leg_length_px1a0fpeys;
   real_T rtb_cur_leg_remaining_dist_htjoyldznw;
-  real_T rtb_land_wp_lat_oe3el12bfw;
-  real_T rtb_land_wp_lon_jm2bgprjv1;
+  real64_T rtb_land_wp_lat_oe3el12bfw;
+  real64_T rtb_land_wp_lon_jm2bgprjv1;
   real_T rtb_curpos_to_wp_heading_cisgujy5vn;
   real_T rtb_rollCmd;
   real_T rtb_pitchCmd;
@@ -214,6 +215,8 @@ void controllerMain_step(void)
   real_T rtb_BusAssignment1_ads_1_aoa_tmp;
   real_T rtb_BusAssignment1_ads_1_aos_tmp;
   real_T rtb_BusAssignment1_ads_1_aspd_cas;
+  real64_T rtb_BusAssignment1_pos_lla_lat;
+  real64_T rtb_BusAssignment1_pos_lla_lon;
   real_T rtb_BusAssignment1_cvb352wjyj_gspd;
   real_T rtb_BusAssignment1_h_radar_agl_tmp;
   real_T rtb_BusAssignment1_ins_1_alt_gps_amsl_tmp;
@@ -240,6 +243,10 @@ void controllerMain_step(void)
   real_T rtb_deltafalllimit;
   real_T rtb_engine_ch;
   real_T rtb_engine_ch_bjavj5sodg;
+  real64_T rtb_land_lat_prev;
+  real64_T rtb_land_lon_prev;
+  real64_T rtb_land_wp_lat_prev;
+  real64_T rtb_land_wp_lon_prev;
   real_T rtb_land_wp_lat;
   real_T rtb_land_wp_lon;
   real_T rtb_omega_jjutubfppl;
@@ -356,7 +363,7 @@ void controllerMain_step(void)
   /* SignalConversion generated from: '<S27>/Bus Assignment1' incorporates:
    *  Inport: '<Root>/sensor_in'
    */
-  rtb_BusAssignment1_cvb352wjyj_gspd = controllerMain_U.sensor_in.ins_1.lat;
+  rtb_BusAssignment1_pos_lla_lat = controllerMain_U.sensor_in.ins_1.lat;
 
   /* SignalConversion generated from: '<S28>/Vector Concatenate' incorporates:
    *  Inport: '<Root>/sensor_in'
@@ -368,7 +375,7 @@ void controllerMain_step(void)
   /* SignalConversion generated from: '<S27>/Bus Assignment1' incorporates:
    *  Inport: '<Root>/sensor_in'
    */
-  notch0_gyro_states = controllerMain_U.sensor_in.ins_1.lon;
+  rtb_BusAssignment1_pos_lla_lon = controllerMain_U.sensor_in.ins_1.lon;
 
   /* SignalConversion generated from: '<S28>/Vector Concatenate' incorporates:
    *  Inport: '<Root>/sensor_in'
@@ -669,10 +676,10 @@ void controllerMain_step(void)
   rtb_cross_tangent_point_done = controllerMain_DW.UnitDelay3_4_DSTATE;
 
   /* UnitDelay generated from: '<Root>/Unit Delay3' */
-  rtb_omega_jjutubfppl = controllerMain_DW.UnitDelay3_5_DSTATE;
+  rtb_land_lat_prev = controllerMain_DW.UnitDelay3_5_DSTATE;
 
   /* UnitDelay generated from: '<Root>/Unit Delay3' */
-  rtb_uDLookupTable = controllerMain_DW.UnitDelay3_6_DSTATE;
+  rtb_land_lon_prev = controllerMain_DW.UnitDelay3_6_DSTATE;
 
   /* UnitDelay generated from: '<Root>/Unit Delay3' */
   rtb_approach_ang = controllerMain_DW.UnitDelay3_7_DSTATE;
@@ -693,10 +700,10 @@ void controllerMain_step(void)
   rtb_last_wp_land = controllerMain_DW.UnitDelay4_5_DSTATE;
 
   /* UnitDelay generated from: '<Root>/Unit Delay4' */
-  rtb_land_wp_lat = controllerMain_DW.UnitDelay4_6_DSTATE;
+  rtb_land_wp_lat_prev = controllerMain_DW.UnitDelay4_6_DSTATE;
 
   /* UnitDelay generated from: '<Root>/Unit Delay4' */
-  rtb_land_wp_lon = controllerMain_DW.UnitDelay4_7_DSTATE;
+  rtb_land_wp_lon_prev = controllerMain_DW.UnitDelay4_7_DSTATE;
 
   /* UnitDelay generated from: '<Root>/Unit Delay4' */
   rtb_curpos_to_wp_heading = controllerMain_DW.UnitDelay4_8_DSTATE;
@@ -710,6 +717,7 @@ void controllerMain_step(void)
    *  Inport: '<Root>/std_command'
    *  Inport: '<Root>/wp_data'
    */
+  FCS_PROF_BEGIN(FCS_PROF_STATE_MACHINE);
   system_state_machine(&controllerMain_U.std_command.vom_cmd,
                        &controllerMain_U.std_command.vom_cmd_cnt,
                        &controllerMain_U.std_command.pic_cmd,
@@ -734,11 +742,12 @@ void controllerMain_step(void)
                        &controllerMain_U.extd_cmd.tecs_cmd_cnt,
                        &rtb_Compare_lvr1zt3dde, &rtb_reduce_speed_alt_done,
                        &rtb_circle_align_done, &rtb_cross_tangent_point_done,
-                       &rtb_omega_jjutubfppl, &rtb_uDLookupTable,
+                       &rtb_land_lat_prev, &rtb_land_lon_prev,
                        &rtb_approach_ang, &rtb_cur_leg_heading,
                        &rtb_cur_leg_length, &rtb_cur_leg_remaining_dist,
-                       &rtb_wp_list_valid, &rtb_last_wp_land, &rtb_land_wp_lat,
-                       &rtb_land_wp_lon, &rtb_curpos_to_wp_heading,
+                       &rtb_wp_list_valid, &rtb_last_wp_land,
+                       &rtb_land_wp_lat_prev, &rtb_land_wp_lon_prev,
+                       &rtb_curpos_to_wp_heading,
                        &rtb_WPN_cmd_received,
                        &controllerMain_U.wp_data.wp_list_valid,
                        &controllerMain_B.bInAirFlag,
@@ -757,6 +766,7 @@ void controllerMain_step(void)
                        &controllerMain_B.pic_status,
                        &controllerMain_B.CoG_tracking,
                        &controllerMain_B.dCapturedAlt_m);
+  FCS_PROF_END(FCS_PROF_STATE_MACHINE);
 
   /* RelationalOperator: '<S22>/Compare' incorporates:
    *  Constant: '<S22>/Constant'
@@ -766,6 +776,7 @@ void controllerMain_step(void)
   /* BusCreator generated from: '<Root>/Model3' incorporates:
    *  ModelReference generated from: '<Root>/Model7'
    */
+  FCS_PROF_BEGIN(FCS_PROF_PATH_PLANNER);
   mc_path_planner(&controllerMain_B.BusAssignment.pos_lla[0],
                   &controllerMain_B.vom_status,
                   &controllerMain_B.mode_data.hover_data.hover_y,
@@ -794,6 +805,7 @@ void controllerMain_step(void)
                   &rtb_BusConversion_InsertedFor_Model3_at_inport_0_BusCreator1.posLLA
                   [0],
                   &rtb_BusConversion_InsertedFor_Model3_at_inport_0_BusCreator1.yawCmd);
+  FCS_PROF_END(FCS_PROF_PATH_PLANNER);
 
   /* ModelReference generated from: '<Root>/Model3' */
   posCtrl(&rtb_BusConversion_InsertedFor_Model3_at_inport_0_BusCreator1,
@@ -802,6 +814,7 @@ void controllerMain_step(void)
           &rtb_hCmd, &rtb_hHold, &rtb_init_reset_vel, &rtb_init_reset_hdot);
 
   /* ModelReference generated from: '<Root>/velCtrl_sw_ref' */
+  FCS_PROF_BEGIN(FCS_PROF_VEL_CTRL_SWITCHER);
   vel_ctrl_switcher(&controllerMain_B.BusAssignment.pos_lla[0],
                     &controllerMain_B.BusAssignment.vel_ned[0],
                     &controllerMain_B.BusAssignment.h_radar_agl,
@@ -823,26 +836,32 @@ void controllerMain_step(void)
                     &rtb_hCmd_f0mpth4u0h, &rtb_hHold_kkfp1ixkpi,
                     &rtb_init_reset_vel_oyuizswpb3,
                     &rtb_init_reset_hdot_lay4g5k1gs);
+  FCS_PROF_END(FCS_PROF_VEL_CTRL_SWITCHER);
 
   /* ModelReference generated from: '<Root>/altCtrl_ref' incorporates:
    *  Delay: '<Root>/Delay'
    */
+  FCS_PROF_BEGIN(FCS_PROF_ALT_CTRL);
   altCtrl(&rtb_hRateCmd_n0d5yq2y1h, &rtb_hCmd_f0mpth4u0h, &rtb_hHold_kkfp1ixkpi,
           &rtb_init_reset_hdot_lay4g5k1gs, &controllerMain_B.BusAssignment,
           &controllerMain_DW.Delay_DSTATE.c_erp2,
           &controllerMain_DW.Delay_DSTATE.nu_des[0],
           &controllerMain_DW.Delay_DSTATE.nu_allocated[0], &rtb_altCtrl_ref);
+  FCS_PROF_END(FCS_PROF_ALT_CTRL);
 
   /* ModelReference generated from: '<Root>/Model2' */
+  FCS_PROF_BEGIN(FCS_PROF_VEL_CTRL);
   velCtrl(&controllerMain_B.BusAssignment, &rtb_velCmdH_x_plbsly3dk1,
           &rtb_velCmdH_y_fn5sqdulrh, &rtb_init_reset_vel_oyuizswpb3,
           &rtb_Model2_o1, &rtb_Model2_o2);
+  FCS_PROF_END(FCS_PROF_VEL_CTRL);
 
   /* ModelReference generated from: '<Root>/FW_TECS_switcher_modelref' incorporates:
    *  Inport: '<Root>/std_command'
    *  Inport: '<Root>/wp_data'
    *  Outport: '<Root>/wp_req_idx'
    */
+  FCS_PROF_BEGIN(FCS_PROF_TECS_SWITCHER);
   FW_TECS_switcher(&controllerMain_B.vom_status,
                    &controllerMain_B.BusAssignment_b4zvdvf4m4.roll_ch,
                    &controllerMain_B.BusAssignment_b4zvdvf4m4.throttle_ch,
@@ -898,11 +917,14 @@ void controllerMain_step(void)
                    &rtb_land_wp_lat_oe3el12bfw, &rtb_land_wp_lon_jm2bgprjv1,
                    &rtb_curpos_to_wp_heading_cisgujy5vn,
                    &rtb_WPN_cmd_received_cnz0eax2ri);
+  FCS_PROF_END(FCS_PROF_TECS_SWITCHER);
 
   /* ModelReference generated from: '<Root>/Model9' */
+  FCS_PROF_BEGIN(FCS_PROF_LAT_GUIDANCE);
   FW_latGuidance(&rtb_FW_TECS_switcher_modelref_o1.roll_cmd,
                  &controllerMain_B.BusAssignment, &rtb_omega_jjutubfppl,
                  &rtb_roll_cmd);
+  FCS_PROF_END(FCS_PROF_LAT_GUIDANCE);
 
   /* Saturate: '<S4>/V_d_lim_to_100mps' incorporates:
    *  BusAssignment: '<S27>/Bus Assignment1'
@@ -962,6 +984,7 @@ void controllerMain_step(void)
   /* ModelReference generated from: '<Root>/Model6' incorporates:
    *  Delay: '<Root>/Delay2'
    */
+  FCS_PROF_BEGIN(FCS_PROF_TECS);
   FW_TECS(&rtb_FW_TECS_switcher_modelref_o1.h_dot_cmd,
           &rtb_FW_TECS_switcher_modelref_o1.h_cmd,
           &rtb_FW_TECS_switcher_modelref_o1.V_cmd,
@@ -970,8 +993,10 @@ void controllerMain_step(void)
           &controllerMain_B.BusAssignment, &controllerMain_DW.Delay2_DSTATE,
           &rtb_BusConversion_InsertedFor_Model6_at_inport_8_BusCreator1,
           &rtb_Model6);
+  FCS_PROF_END(FCS_PROF_TECS);
 
   /* ModelReference generated from: '<Root>/Model' */
+  FCS_PROF_BEGIN(FCS_PROF_ATT_CTRL_SWITCHER);
   att_ctrl_switcher(&controllerMain_B.BusAssignment.eul_ang[0],
                     &controllerMain_B.BusAssignment.omg[0],
                     &controllerMain_B.BusAssignment.aspd_cas,
@@ -996,6 +1021,7 @@ void controllerMain_step(void)
                     &controllerMain_B.lifter_state, &rtb_rollCmd, &rtb_pitchCmd,
                     &rtb_yawCmd, &rtb_yawRateCmd, &rtb_yawHold, &rtb_yawFF,
                     &rtb_init_reset);
+  FCS_PROF_END(FCS_PROF_ATT_CTRL_SWITCHER);
 
   /* Lookup_n-D: '<S1>/1-D Lookup Table' */
   rtb_uDLookupTable = look1_plinlc(controllerMain_B.BusAssignment.aspd_cas,
@@ -1121,6 +1147,7 @@ void controllerMain_step(void)
    *  BusAssignment: '<S1>/Bus Assignment'
    *  Delay: '<Root>/Delay1'
    */
+  FCS_PROF_BEGIN(FCS_PROF_ATT_CTRL);
   attCtrl(&rtb_rollCmd, &rtb_pitchCmd, &rtb_yawCmd, &rtb_yawRateCmd,
           &rtb_yawHold, &rtb_yawFF, &rtb_init_reset,
           &controllerMain_B.BusAssignment,
@@ -1129,15 +1156,19 @@ void controllerMain_step(void)
           &rtb_Model4_o1, &rtb_uDLookupTable, &rtb_Model1_o1,
           &rtb_roll_int_n0n0i3aced, &rtb_pitch_int_b2jgrf5nof,
           &rtb_roll_sat_cnnujar2qf, &rtb_pitch_sat_dxrqxisnco);
+  FCS_PROF_END(FCS_PROF_ATT_CTRL);
 
   /* ModelReference generated from: '<Root>/MR_CA_ref' */
+  FCS_PROF_BEGIN(FCS_PROF_MR_CA);
   MR_CA(&rtb_altCtrl_ref.forceDes, &rtb_Model1_o1.momentDes[0],
         &controllerMain_B.vom_status, &controllerMain_B.rampup_phase,
         &controllerMain_B.BusAssignment.aspd_cas, &controllerMain_B.lifter_state,
         &controllerMain_B.mode_data.eFWLifter_Mode,
         &controllerMain_B.BusAssignment_b4zvdvf4m4.throttle_ch, &rtb_MR_CA_ref);
+  FCS_PROF_END(FCS_PROF_MR_CA);
 
   /* ModelReference generated from: '<Root>/Model12' */
+  FCS_PROF_BEGIN(FCS_PROF_FW_ATT_CTRL_SWITCHER);
   FW_attCtrl_switcher(&controllerMain_B.vom_status,
                       &controllerMain_B.BusAssignment_b4zvdvf4m4.engine_ch,
                       &controllerMain_B.BusAssignment.aspd_cas,
@@ -1147,6 +1178,7 @@ void controllerMain_step(void)
                       &controllerMain_B.mode_data.bt_data.BT_PusherThrottle,
                       &controllerMain_B.mode_data.eFWLifter_Mode, &rtb_roll_cmd,
                       &rtb_Model12);
+  FCS_PROF_END(FCS_PROF_FW_ATT_CTRL_SWITCHER);
 
   /* Logic: '<S6>/Logical Operator6' incorporates:
    *  Logic: '<S7>/Logical Operator6'
@@ -1202,6 +1234,7 @@ void controllerMain_step(void)
    *  Delay: '<Root>/Delay3'
    *  ModelReference generated from: '<Root>/Model4'
    */
+  FCS_PROF_BEGIN(FCS_PROF_FW_ATT_CTRL);
   FW_attCtrl(&rtb_Model12.pitch_cmd, &rtb_Model12.roll_cmd,
              &rtb_Model12.roll_reset, &rtb_Model12.pitch_reset,
              &controllerMain_B.BusAssignment,
@@ -1213,11 +1246,15 @@ void controllerMain_step(void)
              &rtb_roll_sat_cvg42to5m1, &rtb_pitch_sat_hd1k1f2mpb,
              &rtb_cur_leg_remaining_dist, &rtb_land_wp_lat, &rtb_land_wp_lon,
              &controllerMain_Y.ctrl_log.fwAttCmd.raw_rollCmd);
+  FCS_PROF_END(FCS_PROF_FW_ATT_CTRL);
 
   /* ModelReference generated from: '<Root>/Model5' */
+  FCS_PROF_BEGIN(FCS_PROF_FW_THROTTLE);
   FW_throttle(&rtb_Model12.pusher_cmd, &rtb_RateLimiter_kbd0fqq3vq);
+  FCS_PROF_END(FCS_PROF_FW_THROTTLE);
 
   /* ModelReference generated from: '<Root>/Model8' */
+  FCS_PROF_BEGIN(FCS_PROF_FW_CA);
   FW_CA(&controllerMain_B.vom_status, &rtb_Model4_o1, &rtb_curpos_to_wp_heading,
         &rtb_cur_leg_length, &rtb_RateLimiter_kbd0fqq3vq,
         &controllerMain_B.BusAssignment,
@@ -1225,12 +1262,15 @@ void controllerMain_step(void)
         &controllerMain_B.BusAssignment_b4zvdvf4m4.pitch_ch,
         &controllerMain_B.BusAssignment_b4zvdvf4m4.yaw_ch,
         &controllerMain_B.BusAssignment_b4zvdvf4m4.engine_ch, &rtb_Model8);
+  FCS_PROF_END(FCS_PROF_FW_CA);
 
   /* Outport: '<Root>/ctrl_log' incorporates:
    *  ModelReference: '<Root>/Model11'
    */
+  FCS_PROF_BEGIN(FCS_PROF_TRANSITION_HANDLER);
   transitionHandler(&rtb_MR_CA_ref, &rtb_Model8, &rtb_Model11_o1,
                     &controllerMain_Y.ctrl_log.controllerCA);
+  FCS_PROF_END(FCS_PROF_TRANSITION_HANDLER);
 
   /* Outport: '<Root>/std_ctrl' incorporates:
    *  BusAssignment: '<S3>/Bus Assignment1'
@@ -1345,7 +1385,7 @@ void controllerMain_step(void)
   controllerMain_Y.ctrl_log.SensorMgmt.static_sensor_voting_out.omg[0] =
     rtb_BusAssignment1_ins_1_omg[0];
   controllerMain_Y.ctrl_log.SensorMgmt.static_sensor_voting_out.pos_lla[0] =
-    rtb_BusAssignment1_cvb352wjyj_gspd;
+    rtb_BusAssignment1_pos_lla_lat;
   controllerMain_Y.ctrl_log.SensorMgmt.static_sensor_voting_out.vel_ned[0] =
     rtb_BusAssignment1_ins_1_v_ned_idx_0;
   controllerMain_Y.ctrl_log.SensorMgmt.static_sensor_voting_out.accel_b[0] =
@@ -1357,7 +1397,7 @@ void controllerMain_step(void)
   controllerMain_Y.ctrl_log.SensorMgmt.static_sensor_voting_out.omg[1] =
     rtb_BusAssignment1_ins_1_omg[1];
   controllerMain_Y.ctrl_log.SensorMgmt.static_sensor_voting_out.pos_lla[1] =
-    notch0_gyro_states;
+    rtb_BusAssignment1_pos_lla_lon;
   controllerMain_Y.ctrl_log.SensorMgmt.static_sensor_voting_out.vel_ned[1] =
     rtb_BusAssignment1_ins_1_v_ned_idx_1;
   controllerMain_Y.ctrl_log.SensorMgmt.static_sensor_voting_out.accel_b[1] =
@@ -68,14 +68,14 @@ typedef struct {
   real_T ud1_3_DSTATE;                 /* '<S16>/ud1' */
   real_T ud1_4_DSTATE;                 /* '<S16>/ud1' */
   real_T ud1_5_DSTATE;                 /* '<S16>/ud1' */
-  real_T UnitDelay3_5_DSTATE;          /* '<Root>/Unit Delay3' */
-  real_T UnitDelay3_6_DSTATE;          /* '<Root>/Unit Delay3' */
+  real64_T UnitDelay3_5_DSTATE;        /* '<Root>/Unit Delay3' */
+  real64_T UnitDelay3_6_DSTATE;        /* '<Root>/Unit Delay3' */
   real_T UnitDelay3_7_DSTATE;          /* '<Root>/Unit Delay3' */
   real_T UnitDelay4_1_DSTATE;          /* '<Root>/Unit Delay4' */
   real_T UnitDelay4_2_DSTATE;          /* '<Root>/Unit Delay4' */
   real_T UnitDelay4_3_DSTATE;          /* '<Root>/Unit Delay4' */
-  real_T UnitDelay4_6_DSTATE;          /* '<Root>/Unit Delay4' */
-  real_T UnitDelay4_7_DSTATE;          /* '<Root>/Unit Delay4' */
+  real64_T UnitDelay4_6_DSTATE;        /* '<Root>/Unit Delay4' */
+  real64_T UnitDelay4_7_DSTATE;        /* '<Root>/Unit Delay4' */
   real_T UnitDelay4_8_DSTATE;          /* '<Root>/Unit Delay4' */
   real_T Delay2_DSTATE;                /* '<Root>/Delay2' */
   real_T omega_DSTATE;                 /* '<S26>/omega' */
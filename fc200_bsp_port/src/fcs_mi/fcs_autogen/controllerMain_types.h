@@ -104,8 +104,8 @@ typedef struct {
   real_T eul_ang[3];
   real_T omg[3];
   real_T acc[3];
-  real_T lat;
-  real_T lon;
+  real64_T lat;
+  real64_T lon;
   real_T alt_gps_amsl;
   real_T v_ned[3];
   boolean_T data_timeout;
@@ -158,7 +158,7 @@ typedef struct {
   uint16_T vom_cmd_cnt;
   pic_t pic_cmd;
   uint16_T pic_cmd_cnt;
-  real_T home_pos_lla[3];
+  real64_T home_pos_lla[3];
   uint8_T home_pos_set;
   real_T airspeed_cas_cmd;
   real_T fwrth_apr_deg;
@@ -202,10 +202,10 @@ typedef struct {
   uint16_T wp_list_count;
 
   /* lat of the current wp output from wp manager */
-  real_T cur_wp_lat;
+  real64_T cur_wp_lat;
 
   /* lon of the current wp output from wp manager */
-  real_T cur_wp_lon;
+  real64_T cur_wp_lon;
 
   /* alt of the current wp output from wp manager */
   real_T cur_wp_alt;
@@ -251,7 +251,7 @@ typedef struct {
   real_T dcm_e2b[9];
   real_T eul_ang[3];
   real_T omg[3];
-  real_T pos_lla[3];
+  real64_T pos_lla[3];
   real_T vel_ned[3];
   real_T accel_b[3];
   real_T aspd_cas;
@@ -301,8 +301,8 @@ typedef struct {
 #define DEFINED_TYPEDEF_FOR_busHover_data_
 
 typedef struct {
-  real_T hover_y;
-  real_T hover_x;
+  real64_T hover_y;
+  real64_T hover_x;
   real_T hover_alt_agl;
   real_T hover_yaw_ref;
   boolean_T hover_yaw_override;
@@ -314,8 +314,8 @@ typedef struct {
 #define DEFINED_TYPEDEF_FOR_busAutotakeoff_data_
 
 typedef struct {
-  real_T takeoff_x;
-  real_T takeoff_y;
+  real64_T takeoff_x;
+  real64_T takeoff_y;
   real_T takeoff_alt_agl;
   real_T takeoff_yaw_ref;
 } busAutotakeoff_data;
@@ -326,8 +326,8 @@ typedef struct {
 #define DEFINED_TYPEDEF_FOR_busAutoland_data_
 
 typedef struct {
-  real_T land_x;
-  real_T land_y;
+  real64_T land_x;
+  real64_T land_y;
   real_T land_yaw_ref;
 } busAutoland_data;
 
@@ -337,8 +337,8 @@ typedef struct {
 #define DEFINED_TYPEDEF_FOR_busRTH_data_
 
 typedef struct {
-  real_T rth_x;
-  real_T rth_y;
+  real64_T rth_x;
+  real64_T rth_y;
   real_T rth_velX;
   real_T rth_velY;
   real_T rth_alt_agl;
@@ -363,8 +363,8 @@ typedef enum {
 #define DEFINED_TYPEDEF_FOR_busFTransition_data_
 
 typedef struct {
-  real_T FT_x;
-  real_T FT_y;
+  real64_T FT_x;
+  real64_T FT_y;
   real_T FT_Altitude;
   real_T FT_Heading;
   real_T FT_AirspeedRef;
@@ -396,8 +396,8 @@ typedef struct {
 typedef struct {
   real_T loiter_radius;
   real_T loiter_direction;
-  real_T loiter_Center_Lat;
-  real_T loiter_Center_Lon;
+  real64_T loiter_Center_Lat;
+  real64_T loiter_Center_Lon;
   real_T loiter_altitude;
   real_T loiter_AirSpeedRef;
 } busLoiter_data;
@@ -408,8 +408,8 @@ typedef struct {
 #define DEFINED_TYPEDEF_FOR_busBTransiton_data_
 
 typedef struct {
-  real_T BT_Hover_Lat;
-  real_T BT_Hover_Lon;
+  real64_T BT_Hover_Lat;
+  real64_T BT_Hover_Lon;
   real_T BT_Altitude;
   real_T BT_Heading;
   real_T BT_PusherThrottle;
@@ -512,7 +512,7 @@ typedef struct {
 #define DEFINED_TYPEDEF_FOR_busWaypointManager_
 
 typedef struct {
-  real_T posLLA[3];
+  real64_T posLLA[3];
   real_T yawCmd;
 } busWaypointManager;
 
@@ -707,8 +707,8 @@ typedef struct {
   real_T mr_vel_sp_X;
   real_T mr_vel_sp_Y;
   boolean_T mr_vel_intg_reset;
-  real_T mr_pos_sp_lat;
-  real_T mr_pos_sp_lon;
+  real64_T mr_pos_sp_lat;
+  real64_T mr_pos_sp_lon;
   real_T mr_thrust_cmd;
   real_T h_rel_takeoff;
   std_sensor_t voter;
@@ -19,31 +19,31 @@
 #include "mc_path_planner_types.h"
 
 /* Output and update for referenced model: 'mc_path_planner' */
-void mc_path_planner(const real_T rtu_sensor_pos_lla[3], const vom_t
-                     *rtu_vom_status, const real_T
-                     *rtu_mode_data_hover_data_hover_y, const real_T
+void mc_path_planner(const real64_T rtu_sensor_pos_lla[3], const vom_t
+                     *rtu_vom_status, const real64_T
+                     *rtu_mode_data_hover_data_hover_y, const real64_T
                      *rtu_mode_data_hover_data_hover_x, const real_T
                      *rtu_mode_data_hover_data_hover_alt_agl, const real_T
-                     *rtu_mode_data_hover_data_hover_yaw_ref, const real_T
-                     *rtu_mode_data_autotakeoff_data_takeoff_x, const real_T
+                     *rtu_mode_data_hover_data_hover_yaw_ref, const real64_T
+                     *rtu_mode_data_autotakeoff_data_takeoff_x, const real64_T
                      *rtu_mode_data_autotakeoff_data_takeoff_y, const real_T
                      *rtu_mode_data_autotakeoff_data_takeoff_alt_agl, const
                      real_T *rtu_mode_data_autotakeoff_data_takeoff_yaw_ref,
-                     const real_T *rtu_mode_data_autoland_data_land_x, const
-                     real_T *rtu_mode_data_autoland_data_land_y, const real_T
-                     *rtu_mode_data_autoland_data_land_yaw_ref, const real_T
-                     *rtu_mode_data_rth_data_rth_x, const real_T
+                     const real64_T *rtu_mode_data_autoland_data_land_x, const
+                     real64_T *rtu_mode_data_autoland_data_land_y, const real_T
+                     *rtu_mode_data_autoland_data_land_yaw_ref, const real64_T
+                     *rtu_mode_data_rth_data_rth_x, const real64_T
                      *rtu_mode_data_rth_data_rth_y, const real_T
                      *rtu_mode_data_rth_data_rth_alt_agl, const real_T
-                     *rtu_mode_data_rth_data_rth_yaw_ref, const real_T
-                     *rtu_mode_data_ft_data_FT_x, const real_T
+                     *rtu_mode_data_rth_data_rth_yaw_ref, const real64_T
+                     *rtu_mode_data_ft_data_FT_x, const real64_T
                      *rtu_mode_data_ft_data_FT_y, const real_T
                      *rtu_mode_data_ft_data_FT_Altitude, const real_T
-                     *rtu_mode_data_ft_data_FT_Heading, const real_T
-                     *rtu_mode_data_bt_data_BT_Hover_Lat, const real_T
+                     *rtu_mode_data_ft_data_FT_Heading, const real64_T
+                     *rtu_mode_data_bt_data_BT_Hover_Lat, const real64_T
                      *rtu_mode_data_bt_data_BT_Hover_Lon, const real_T
                      *rtu_mode_data_bt_data_BT_Altitude, const real_T
-                     *rtu_mode_data_bt_data_BT_Heading, real_T
+                     *rtu_mode_data_bt_data_BT_Heading, real64_T
                      rty_busWaypointManager_posLLA[3], real_T
                      *rty_busWaypointManager_yawCmd)
 {
@@ -43,7 +43,7 @@ typedef enum {
 #define DEFINED_TYPEDEF_FOR_busWaypointManager_
 
 typedef struct {
-  real_T posLLA[3];
+  real64_T posLLA[3];
   real_T yawCmd;
 } busWaypointManager;
 
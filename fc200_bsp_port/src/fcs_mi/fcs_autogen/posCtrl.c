@@ -33,7 +33,7 @@ posCtrl_TZCE posCtrl_PrevZCX;
  *    '<S11>/MATLAB Function1'
  *    '<S19>/MATLAB Function1'
  */
-void posCtrl_i04w0oyqe2(const real_T rtu_LLA[3], real_T rty_C[9])
+void posCtrl_i04w0oyqe2(const real64_T rtu_LLA[3], real_T rty_C[9])
 {
   real_T cos_lat;
   real_T cos_long;
@@ -94,21 +94,21 @@ void posCtrl(const busWaypointManager *rtu_busWptManager, const std_sensor_t
 {
   real_T rtb_C[9];
   real_T rtb_C_0[3];
-  real_T cps;
-  real_T rtb_Product_haif3f5y2j_idx_0_tmp;
-  real_T rtb_Product_haif3f5y2j_tmp;
-  real_T rtb_Product_haif3f5y2j_tmp_0;
+  real64_T cps;
+  real64_T rtb_Product_haif3f5y2j_idx_0_tmp;
+  real64_T rtb_Product_haif3f5y2j_tmp;
+  real64_T rtb_Product_haif3f5y2j_tmp_0;
   real_T rtb_R_idx_0;
   real_T rtb_R_idx_1;
   real_T rtb_R_idx_2;
-  real_T rtb_Sqrt_ii2xp45anb;
-  real_T rtb_Sum1_tmp;
-  real_T rtb_Sum_mnw5bny0bd_idx_0;
-  real_T rtb_Sum_mnw5bny0bd_idx_0_tmp;
-  real_T rtb_Sum_mnw5bny0bd_idx_2;
-  real_T rtb_TrigonometricFunction;
-  real_T sps;
-  real_T sps_tmp;
+  real64_T rtb_Sqrt_ii2xp45anb;
+  real64_T rtb_Sum1_tmp;
+  real64_T rtb_Sum_mnw5bny0bd_idx_0;
+  real64_T rtb_Sum_mnw5bny0bd_idx_0_tmp;
+  real64_T rtb_Sum_mnw5bny0bd_idx_2;
+  real64_T rtb_TrigonometricFunction;
+  real64_T sps;
+  real64_T sps_tmp;
   int32_T i;
   boolean_T rtb_LogicalOperator;
 
@@ -183,7 +183,7 @@ void posCtrl(const busWaypointManager *rtu_busWptManager, const std_sensor_t
    *  Product: '<S25>/Product'
    *  Trigonometry: '<S13>/Trigonometric Function'
    */
-  sps_tmp = cps * 0.0818191908425;
+  sps_tmp = cps * RT_REAL64(0.0818191908425);
 
   /* Sqrt: '<S17>/Sqrt' incorporates:
    *  Constant: '<S17>/const'
@@ -199,8 +199,8 @@ void posCtrl(const busWaypointManager *rtu_busWptManager, const std_sensor_t
    *  Product: '<S18>/Product'
    *  Sqrt: '<S17>/Sqrt'
    */
-  if (sps_tmp <= 0.001) {
-    sps = -0.001;
+  if (sps_tmp <= RT_REAL64(0.001)) {
+    sps = -RT_REAL64(0.001);
   }
 
   /* End of Switch: '<S18>/Switch3' */
@@ -243,7 +243,7 @@ void posCtrl(const busWaypointManager *rtu_busWptManager, const std_sensor_t
   /* Product: '<S15>/Product' incorporates:
    *  Constant: '<S15>/e'
    */
-  rtb_Sqrt_ii2xp45anb = rtb_TrigonometricFunction * 0.0818191908425;
+  rtb_Sqrt_ii2xp45anb = rtb_TrigonometricFunction * RT_REAL64(0.0818191908425);
 
   /* Sqrt: '<S15>/Sqrt' incorporates:
    *  Constant: '<S15>/const'
@@ -256,8 +256,8 @@ void posCtrl(const busWaypointManager *rtu_busWptManager, const std_sensor_t
    *  Abs: '<S16>/Abs'
    *  Product: '<S16>/Product'
    */
-  if (rtb_Sqrt_ii2xp45anb <= 0.001) {
-    rtb_Sqrt_ii2xp45anb = -0.001;
+  if (rtb_Sqrt_ii2xp45anb <= RT_REAL64(0.001)) {
+    rtb_Sqrt_ii2xp45anb = -RT_REAL64(0.001);
   }
 
   /* End of Switch: '<S16>/Switch3' */
@@ -301,9 +301,9 @@ void posCtrl(const busWaypointManager *rtu_busWptManager, const std_sensor_t
   rtb_Product_haif3f5y2j_idx_0_tmp = (rtb_Sum_mnw5bny0bd_idx_0_tmp * sin
     (rtu_busWptManager->posLLA[1])) - (rtb_Product_haif3f5y2j_idx_0_tmp *
     rtb_Product_haif3f5y2j_tmp_0);
-  rtb_Sum_mnw5bny0bd_idx_2 = (rtb_TrigonometricFunction * ((0.993305620009879 *
+  rtb_Sum_mnw5bny0bd_idx_2 = (rtb_TrigonometricFunction * ((RT_REAL64(0.993305620009879) *
     rtb_Sqrt_ii2xp45anb) + rtu_busWptManager->posLLA[2])) - (cps *
-    ((0.993305620009879 * sps) + posCtrl_DW.Delay_DSTATE[2]));
+    ((RT_REAL64(0.993305620009879) * sps) + posCtrl_DW.Delay_DSTATE[2]));
 
   /* Product: '<S11>/Product' */
   for (i = 0; i < 3; i++) {
@@ -331,8 +331,8 @@ void posCtrl(const busWaypointManager *rtu_busWptManager, const std_sensor_t
   /* Switch: '<S26>/Switch3' incorporates:
    *  Product: '<S26>/Product'
    */
-  if (sps_tmp <= 0.001) {
-    rtb_Sqrt_ii2xp45anb = -0.001;
+  if (sps_tmp <= RT_REAL64(0.001)) {
+    rtb_Sqrt_ii2xp45anb = -RT_REAL64(0.001);
   }
 
   /* End of Switch: '<S26>/Switch3' */
@@ -356,7 +356,7 @@ void posCtrl(const busWaypointManager *rtu_busWptManager, const std_sensor_t
    *  Product: '<S21>/Product2'
    *  Sum: '<S21>/Sum1'
    */
-  rtb_Sum_mnw5bny0bd_idx_2 = cps * ((0.993305620009879 * rtb_Sqrt_ii2xp45anb) +
+  rtb_Sum_mnw5bny0bd_idx_2 = cps * ((RT_REAL64(0.993305620009879) * rtb_Sqrt_ii2xp45anb) +
     posCtrl_DW.Delay_DSTATE[2]);
 
   /* Trigonometry: '<S20>/Trigonometric Function' */
@@ -365,7 +365,7 @@ void posCtrl(const busWaypointManager *rtu_busWptManager, const std_sensor_t
   /* Product: '<S23>/Product' incorporates:
    *  Constant: '<S23>/e'
    */
-  rtb_Sqrt_ii2xp45anb = rtb_TrigonometricFunction * 0.0818191908425;
+  rtb_Sqrt_ii2xp45anb = rtb_TrigonometricFunction * RT_REAL64(0.0818191908425);
 
   /* Sqrt: '<S23>/Sqrt' incorporates:
    *  Constant: '<S23>/const'
@@ -378,8 +378,8 @@ void posCtrl(const busWaypointManager *rtu_busWptManager, const std_sensor_t
    *  Abs: '<S24>/Abs'
    *  Product: '<S24>/Product'
    */
-  if (rtb_Sqrt_ii2xp45anb <= 0.001) {
-    rtb_Sqrt_ii2xp45anb = -0.001;
+  if (rtb_Sqrt_ii2xp45anb <= RT_REAL64(0.001)) {
+    rtb_Sqrt_ii2xp45anb = -RT_REAL64(0.001);
   }
 
   /* End of Switch: '<S24>/Switch3' */
@@ -414,7 +414,7 @@ void posCtrl(const busWaypointManager *rtu_busWptManager, const std_sensor_t
   rtb_Product_haif3f5y2j_tmp_0 = (rtb_Product_haif3f5y2j_idx_0_tmp * sin
     (rtu_Sensor->pos_lla[1])) - (rtb_Sum_mnw5bny0bd_idx_0_tmp *
     rtb_Product_haif3f5y2j_tmp_0);
-  rtb_TrigonometricFunction = (rtb_TrigonometricFunction * ((0.993305620009879 *
+  rtb_TrigonometricFunction = (rtb_TrigonometricFunction * ((RT_REAL64(0.993305620009879) *
     rtb_Sqrt_ii2xp45anb) + rtu_Sensor->pos_lla[2])) - rtb_Sum_mnw5bny0bd_idx_2;
 
   /* Product: '<S19>/Product' */
@@ -460,7 +460,7 @@ void posCtrl(const busWaypointManager *rtu_busWptManager, const std_sensor_t
    *  Product: '<Root>/Product1'
    *  Sum: '<S9>/Sum'
    */
-  *rty_busControllerIF_vel_velCmdH_x = 0.2 * (sps - rtb_R_idx_2);
+  *rty_busControllerIF_vel_velCmdH_x = RT_REAL64(0.2) * (sps - rtb_R_idx_2);
 
   /* SignalConversion generated from: '<Root>/busControllerIF_vel' incorporates:
    *  Gain: '<S9>/Gain'
@@ -468,7 +468,7 @@ void posCtrl(const busWaypointManager *rtu_busWptManager, const std_sensor_t
    *  Product: '<Root>/Product1'
    *  Sum: '<S9>/Sum'
    */
-  *rty_busControllerIF_vel_velCmdH_y = 0.2 * (rtb_Sum_mnw5bny0bd_idx_0 -
+  *rty_busControllerIF_vel_velCmdH_y = RT_REAL64(0.2) * (rtb_Sum_mnw5bny0bd_idx_0 -
     rtb_R_idx_1);
 
   /* SignalConversion generated from: '<Root>/busControllerIF_vel' incorporates:
@@ -22,7 +22,7 @@
 
 /* Block states (default storage) for model 'posCtrl' */
 typedef struct {
-  real_T Delay_DSTATE[3];              /* '<Root>/Delay' */
+  real64_T Delay_DSTATE[3];            /* '<Root>/Delay' */
   vom_t Delay1_DSTATE;                 /* '<Root>/Delay1' */
   boolean_T icLoad;                    /* '<Root>/Delay1' */
   boolean_T icLoad_gwql4htcwe;         /* '<Root>/Delay' */
@@ -33,7 +33,7 @@ typedef struct {
   ZCSigState Delay_Reset_ZCE;          /* '<Root>/Delay' */
 } posCtrl_TZCE;
 
-extern void posCtrl_i04w0oyqe2(const real_T rtu_LLA[3], real_T rty_C[9]);
+extern void posCtrl_i04w0oyqe2(const real64_T rtu_LLA[3], real_T rty_C[9]);
 
 /* Block states (default storage) */
 extern posCtrl_TDW posCtrl_DW;
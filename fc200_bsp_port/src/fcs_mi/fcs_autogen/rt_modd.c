@@ -31,7 +31,7 @@ real_T rt_modd(real_T u0, real_T u1)
     yEq = (y == 0.0);
     if ((!yEq) && (u1 > floor(u1))) {
       q = fabs(u0 / u1);
-      yEq = (fabs(q - floor(q + 0.5)) <= (DBL_EPSILON * q));
+      yEq = (fabs(q - floor(q + 0.5)) <= (RT_EPS * q));
     }
 
     if (yEq) {
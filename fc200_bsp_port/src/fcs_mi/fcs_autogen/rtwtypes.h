@@ -53,7 +53,65 @@ typedef double real64_T;
  * Generic type definitions: boolean_T, char_T, byte_T, int_T, uint_T,       *
  *                           real_T, time_T, ulong_T.                        *
  *===========================================================================*/
+
+/* FCS_SINGLE_PRECISION selects single precision for the controller signals so
+ * that they map onto the single precision FPU. Geodetic latitude, longitude and
+ * the states holding them are declared real64_T and keep full precision.
+ *
+ * The generated math calls (sin, cos, atan2, sqrt, ...) are made type generic
+ * by <tgmath.h>, so they resolve to sinf, cosf, atan2f and sqrtf for real_T
+ * arguments and stay double for real64_T arguments. The build must also pass
+ * -fsingle-precision-constant so that the unsuffixed literals of the generated
+ * code do not promote the real_T expressions back to double. That flag also
+ * rounds the literals of the real64_T expressions to float, so those that are
+ * not exact in float are written RT_REAL64(literal): the long double suffix is
+ * not affected by the flag and long double is double on the R5.
+ *
+ * The precision is chosen at build time: the Debug_SinglePrecision
+ * configuration of the target project defines FCS_SINGLE_PRECISION and adds
+ * -fsingle-precision-constant for this folder only, the host build does the
+ * same with its FCS_SINGLE_PRECISION option. Without the define every type and
+ * RT_* limit below is the one the code was generated with, so the Debug and
+ * Release configurations build the generated code unchanged.
+ */
+#ifdef FCS_SINGLE_PRECISION
+#include <tgmath.h>
+
+typedef real32_T real_T;
+#define RT_REAL64(c)     ((real64_T)(c ## L))
+#else
 typedef double real_T;
+#define RT_REAL64(c)     (c)
+#endif
+
+/* Floating point limits of real_T used by the generated norm, scaling, SVD
+ * and pseudo inverse routines. The double values are the ones the code was
+ * generated with; in single precision they would underflow or overflow.
+ */
+#ifdef FCS_SINGLE_PRECISION
+#define RT_EPS           1.1920929E-7F     /* eps                    */
+#define RT_MANT_DIG      24                /* mantissa digits        */
+#define RT_REALMIN2      2.3509887E-38F    /* 2 * realmin            */
+#define RT_DENORM_MIN    1.4E-45F          /* smallest denormal      */
+#define RT_SAFMIN        9.86076132E-32F   /* realmin / eps          */
+#define RT_LASCL_SMLNUM  1.97215226E-31F   /* 2 * realmin / eps      */
+#define RT_LASCL_BIGNUM  5.0706024E+30F    /* eps / (2 * realmin)    */
+#define RT_SVD_SMLNUM    9.09494702E-13F   /* sqrt(realmin) / eps    */
+#define RT_SVD_BIGNUM    1.09951163E+12F   /* eps / sqrt(realmin)    */
+#define RT_NRM2_SCALE    1.29246971E-26F   /* initial scale of xnrm2 */
+#else
+#define RT_EPS           2.2204460492503131E-16
+#define RT_MANT_DIG      53
+#define RT_REALMIN2      4.4501477170144028E-308
+#define RT_DENORM_MIN    4.94065645841247E-324
+#define RT_SAFMIN        1.0020841800044864E-292
+#define RT_LASCL_SMLNUM  2.0041683600089728E-292
+#define RT_LASCL_BIGNUM  4.9896007738368E+291
+#define RT_SVD_SMLNUM    6.7178761075670888E-139
+#define RT_SVD_BIGNUM    1.4885657073574029E+138
+#define RT_NRM2_SCALE    3.3121686421112381E-170
+#endif
+
 typedef double time_T;
 typedef unsigned char boolean_T;
 typedef int int_T;
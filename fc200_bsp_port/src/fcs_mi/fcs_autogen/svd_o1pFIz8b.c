@@ -72,13 +72,13 @@ void svd_o1pFIz8b(const real_T A[32], real_T U[32], real_T s[4], real_T V[16])
   doscale = false;
   anrm = xzlangeM_j4zAURqV(A);
   cscale = anrm;
-  if ((anrm > 0.0) && (anrm < 6.7178761075670888E-139)) {
+  if ((anrm > 0.0) && (anrm < RT_SVD_SMLNUM)) {
     doscale = true;
-    cscale = 6.7178761075670888E-139;
+    cscale = RT_SVD_SMLNUM;
     xzlascl_Alz1u9wU(anrm, cscale, b_A);
-  } else if (anrm > 1.4885657073574029E+138) {
+  } else if (anrm > RT_SVD_BIGNUM) {
     doscale = true;
-    cscale = 1.4885657073574029E+138;
+    cscale = RT_SVD_BIGNUM;
     xzlascl_Alz1u9wU(anrm, cscale, b_A);
   } else {
     /* no actions */
@@ -97,7 +97,7 @@ void svd_o1pFIz8b(const real_T A[32], real_T U[32], real_T s[4], real_T V[16])
       }
 
       b_s[i] = nrm;
-      if (fabs(nrm) >= 1.0020841800044864E-292) {
+      if (fabs(nrm) >= RT_SAFMIN) {
         nrm = 1.0 / nrm;
         qjj = (qq_tmp - i) + 8;
         for (qp1jj = qq; qp1jj <= qjj; qp1jj++) {
@@ -143,7 +143,7 @@ void svd_o1pFIz8b(const real_T A[32], real_T U[32], real_T s[4], real_T V[16])
         }
 
         nrm = e[i];
-        if (fabs(e[i]) >= 1.0020841800044864E-292) {
+        if (fabs(e[i]) >= RT_SAFMIN) {
           nrm = 1.0 / e[i];
           for (qjj = qp1; qjj < 5; qjj++) {
             e[qjj - 1] *= nrm;
@@ -304,12 +304,12 @@ void svd_o1pFIz8b(const real_T A[32], real_T U[32], real_T s[4], real_T V[16])
         exitg1 = 1;
       } else {
         rt = fabs(e[qp1jj - 1]);
-        if (rt <= (2.2204460492503131E-16 * (fabs(b_s[qp1jj - 1]) + fabs
+        if (rt <= (RT_EPS * (fabs(b_s[qp1jj - 1]) + fabs
               (b_s[qp1jj])))) {
           e[qp1jj - 1] = 0.0;
           exitg1 = 1;
-        } else if ((rt <= 1.0020841800044864E-292) || ((qp1 > ((int32_T)((int8_T)
-            20))) && (rt <= (2.2204460492503131E-16 * nrm)))) {
+        } else if ((rt <= RT_SAFMIN) || ((qp1 > ((int32_T)((int8_T)
+            20))) && (rt <= (RT_EPS * nrm)))) {
           e[qp1jj - 1] = 0.0;
           exitg1 = 1;
         } else {
@@ -340,8 +340,8 @@ void svd_o1pFIz8b(const real_T A[32], real_T U[32], real_T s[4], real_T V[16])
           }
 
           ztest = fabs(b_s[qq_tmp - 1]);
-          if ((ztest <= (2.2204460492503131E-16 * rt)) || (ztest <=
-               1.0020841800044864E-292)) {
+          if ((ztest <= (RT_EPS * rt)) || (ztest <=
+               RT_SAFMIN)) {
             b_s[qq_tmp - 1] = 0.0;
             exitg2 = true;
           } else {
@@ -22,6 +22,7 @@
 #include <math.h>
 #include "zero_crossing_types.h"
 #include <string.h>
+#include "fcs_geo.h"
 
 /* Named constants for Chart: '<S1>/fcs_state_machine_stateflow' */
 #define system_state_machine_IN_ARMED  ((uint8_T)1U)
@@ -101,50 +102,50 @@ system_state_machine_TDW system_state_machine_DW;
 system_state_machine_TZCE system_state_machine_PrevZCX;
 
 /* Forward declaration for local functions */
-static void system_state_machine_fj4fquesko(const real_T rtu_sensor_pos_lla[3],
+static void system_state_machine_fj4fquesko(const real64_T rtu_sensor_pos_lla[3],
   const real_T *rtu_sensor_chi, vom_t *rty_vom_status, busMode_data
   *rty_mode_data);
-static void system_state_machine_odhkbmem0z(real_T *TrigonometricFunction,
-  real_T *Add1, real_T *Lat_cfuwhmfptw, real_T *Lon_ikb0u2i02a, real_T
-  *dist_buzfv3hgub, real_T *heading_ieyh5igw0r, const real_T rtu_sensor_pos_lla
+static void system_state_machine_odhkbmem0z(real64_T *TrigonometricFunction,
+  real64_T *Add1, real64_T *Lat_cfuwhmfptw, real64_T *Lon_ikb0u2i02a, real_T
+  *dist_buzfv3hgub, real_T *heading_ieyh5igw0r, const real64_T rtu_sensor_pos_lla
   [3], const real_T *rtu_sensor_chi, vom_t *rty_vom_status, busMode_data
   *rty_mode_data);
-static void system_state_machine_hdnpt4qldm(const real_T rtu_sensor_pos_lla[3],
+static void system_state_machine_hdnpt4qldm(const real64_T rtu_sensor_pos_lla[3],
   const real_T *rtu_sensor_aspd_cas, const real_T *rtu_sensor_chi, vom_t
   *rty_vom_status, busMode_data *rty_mode_data);
-static void system_state_machine_hqecrwkbbn(real_T *TrigonometricFunction,
-  real_T *Add1, real_T *Lat_cfuwhmfptw, real_T *Lon_ikb0u2i02a, real_T
-  *dist_buzfv3hgub, real_T *heading_ieyh5igw0r, const real_T rtu_sensor_pos_lla
+static void system_state_machine_hqecrwkbbn(real64_T *TrigonometricFunction,
+  real64_T *Add1, real64_T *Lat_cfuwhmfptw, real64_T *Lon_ikb0u2i02a, real_T
+  *dist_buzfv3hgub, real_T *heading_ieyh5igw0r, const real64_T rtu_sensor_pos_lla
   [3], const real_T *rtu_sensor_chi, vom_t *rty_vom_status, busMode_data
   *rty_mode_data);
 static void system_state_machine_odubvnrnpm(const real_T rtu_sensor_eul_ang[3],
-  const real_T rtu_sensor_pos_lla[3], vom_t *rty_vom_status, busMode_data
+  const real64_T rtu_sensor_pos_lla[3], vom_t *rty_vom_status, busMode_data
   *rty_mode_data);
 static void system_state_machine_gjywfyiloe(const real_T rtu_sensor_eul_ang[3],
-  const real_T rtu_sensor_pos_lla[3], const real_T *rtu_sensor_aspd_cas, const
+  const real64_T rtu_sensor_pos_lla[3], const real_T *rtu_sensor_aspd_cas, const
   real_T *rtu_sensor_chi, const boolean_T *rtu_wp_data_wp_list_valid, vom_t
   *rty_vom_status, busMode_data *rty_mode_data);
 static void system_state_machine_jgwda1ajrs(const real_T rtu_sensor_eul_ang[3],
-  const real_T rtu_sensor_pos_lla[3], vom_t *rty_vom_status, busMode_data
+  const real64_T rtu_sensor_pos_lla[3], vom_t *rty_vom_status, busMode_data
   *rty_mode_data);
 static void system_state_machine_aeuawg3vfo(const real_T rtu_sensor_eul_ang[3],
-  const real_T rtu_sensor_pos_lla[3], const int8_T *rtu_pilot_input_switch_1,
+  const real64_T rtu_sensor_pos_lla[3], const int8_T *rtu_pilot_input_switch_1,
   const boolean_T *rtu_wp_data_wp_list_valid, vom_t *rty_vom_status,
   busMode_data *rty_mode_data, boolean_T *rty_sFlags_bGPSLoss);
 static void system_state_machine_csj5zj0zmt(const real_T rtu_sensor_eul_ang[3],
-  const real_T rtu_sensor_pos_lla[3], const real_T *rtu_sensor_h_radar_agl,
+  const real64_T rtu_sensor_pos_lla[3], const real_T *rtu_sensor_h_radar_agl,
   const int8_T *rtu_pilot_input_switch_1, vom_t *rty_vom_status, busMode_data
   *rty_mode_data, pic_t *rty_pic_status);
 static void system_state_machine_fks3ydn24b(const real_T rtu_sensor_eul_ang[3],
-  const real_T rtu_sensor_pos_lla[3], const int8_T *rtu_pilot_input_switch_1,
+  const real64_T rtu_sensor_pos_lla[3], const int8_T *rtu_pilot_input_switch_1,
   vom_t *rty_vom_status, busMode_data *rty_mode_data, boolean_T
   *rty_sFlags_bGPSLoss);
 static void system_state_machine_afs03nhl30(const real_T rtu_sensor_eul_ang[3],
-  const real_T rtu_sensor_pos_lla[3], const int8_T *rtu_pilot_input_switch_1,
+  const real64_T rtu_sensor_pos_lla[3], const int8_T *rtu_pilot_input_switch_1,
   vom_t *rty_vom_status, busMode_data *rty_mode_data, boolean_T
   *rty_sFlags_rampup_phase);
 static void system_state_machine_phh325i5jc(const real_T *Gain, const real_T
-  rtu_sensor_eul_ang[3], const real_T rtu_sensor_pos_lla[3], const real_T
+  rtu_sensor_eul_ang[3], const real64_T rtu_sensor_pos_lla[3], const real_T
   *rtu_sensor_aspd_cas, const real_T *rtu_sensor_h_radar_agl, const real_T
   *rtu_sensor_chi, const int8_T *rtu_pilot_input_switch_1, const boolean_T
   *rtu_wp_data_wp_list_valid, vom_t *rty_vom_status, busMode_data *rty_mode_data,
@@ -164,7 +165,7 @@ static void system_state_machine_g0rztozkme(const vom_t *vom_status, boolean_T
 static void system_state_machine_fhrgqlbunr(const boolean_T
   *FixPtRelationalOperator, const boolean_T *FixPtRelationalOperator_cwrqbb5ufj,
   const real_T *Gain, const vom_t *vom_status, const real_T *Switch, const
-  real_T *Switch_kc4btehf20, const real_T rtu_sensor_eul_ang[3], const real_T
+  real_T *Switch_kc4btehf20, const real_T rtu_sensor_eul_ang[3], const real64_T
   rtu_sensor_pos_lla[3], const real_T *rtu_sensor_aspd_cas, const real_T
   *rtu_sensor_h_radar_agl, const real_T *rtu_sensor_chi, const int8_T
   *rtu_pilot_input_switch_1, const real_T *rtu_controllerAltCtrl_forceDes, const
@@ -201,66 +202,12 @@ void system_state_machine_lkpmp3sm0z(real_T rtu_u, real_T *rty_y, const
  *    '<S8>/FlightManagement.FMM.FW_Modes.BackTransition.destinationPoint'
  *    '<S8>/FlightManagement.FMM.FW_Modes.Loiter_Mode.destinationPoint'
  */
-void system_state_machine_mkamotaax2(real_T rtu_Lat, real_T rtu_Lon, real_T
-  rtu_dist, real_T rtu_heading, real_T *rty_latOut, real_T *rty_lonOut)
+void system_state_machine_mkamotaax2(real64_T rtu_Lat, real64_T rtu_Lon, real_T
+  rtu_dist, real_T rtu_heading, real64_T *rty_latOut, real64_T *rty_lonOut)
 {
-  real_T rtb_TrigonometricFunction1_j3qnhe2a3e;
-  real_T rtb_TrigonometricFunction2_gtnsluhxdu;
-  real_T rtb_TrigonometricFunction3;
-  real_T rtb_TrigonometricFunction4;
-  real_T u0;
-
-  /* Trigonometry: '<S55>/Trigonometric Function1' */
-  rtb_TrigonometricFunction1_j3qnhe2a3e = sin(rtu_Lat);
-
-  /* Product: '<S55>/Divide' incorporates:
-   *  Constant: '<S55>/RADIUS_OF_EARTH'
-   */
-  rtb_TrigonometricFunction4 = rtu_dist / 6.371E+6;
-
-  /* Trigonometry: '<S55>/Trigonometric Function2' */
-  rtb_TrigonometricFunction2_gtnsluhxdu = cos(rtb_TrigonometricFunction4);
-
-  /* Trigonometry: '<S55>/Trigonometric Function3' */
-  rtb_TrigonometricFunction3 = cos(rtu_Lat);
-
-  /* Trigonometry: '<S55>/Trigonometric Function4' */
-  rtb_TrigonometricFunction4 = sin(rtb_TrigonometricFunction4);
-
-  /* Sum: '<S55>/Add' incorporates:
-   *  Product: '<S55>/Product'
-   *  Product: '<S55>/Product1'
-   *  Trigonometry: '<S55>/Trigonometric Function5'
-   */
-  u0 = (rtb_TrigonometricFunction1_j3qnhe2a3e *
-        rtb_TrigonometricFunction2_gtnsluhxdu) + ((rtb_TrigonometricFunction3 *
-    rtb_TrigonometricFunction4) * cos(rtu_heading));
-
-  /* Saturate: '<S55>/Saturation' */
-  if (u0 > 1.0) {
-    u0 = 1.0;
-  } else if (u0 < -1.0) {
-    u0 = -1.0;
-  } else {
-    /* no actions */
-  }
-
-  /* Trigonometry: '<S55>/Trigonometric Function' incorporates:
-   *  Saturate: '<S55>/Saturation'
-   */
-  *rty_latOut = asin(u0);
-
-  /* Sum: '<S55>/Add1' incorporates:
-   *  Product: '<S55>/Product2'
-   *  Product: '<S55>/Product3'
-   *  Sum: '<S55>/Add2'
-   *  Trigonometry: '<S55>/Trigonometric Function6'
-   *  Trigonometry: '<S55>/Trigonometric Function7'
-   *  Trigonometry: '<S55>/Trigonometric Function8'
-   */
-  *rty_lonOut = rtu_Lon + atan2((sin(rtu_heading) * rtb_TrigonometricFunction4) *
-    rtb_TrigonometricFunction3, rtb_TrigonometricFunction2_gtnsluhxdu -
-    (rtb_TrigonometricFunction1_j3qnhe2a3e * sin(*rty_latOut)));
+  /* '<S55>' spherical destination point on the geodesy library */
+  fcs_geo_destination_point(rtu_Lat, rtu_Lon, (real64_T)rtu_dist, (real64_T)
+    rtu_heading, rty_latOut, rty_lonOut);
 }
 
 /*
@@ -268,179 +215,22 @@ void system_state_machine_mkamotaax2(real_T rtu_Lat, real_T rtu_Lon, real_T
  *    '<S8>/FlightManagement.FMM.FW_Modes.BackTransition.CurrentDistance_From_LLA'
  *    '<S8>/FlightManagement.FMM.FW_Modes.FTransition.CurrentDistance_From_HoverLLA'
  */
-void system_state_machine_k5j3b5svff(const real_T rtu_LLA1[3], const real_T
+void system_state_machine_k5j3b5svff(const real64_T rtu_LLA1[3], const real64_T
   rtu_LLA2[3], real_T *rty_distance)
 {
-  real_T sin_lat_tmp_0[9];
-  real_T rtb_Product_msrnbt4gnk[3];
-  real_T cos_lat_tmp;
-  real_T cos_long_tmp;
-  real_T rtb_Add_g2vn0y2s5j;
-  real_T rtb_Sqrt_afskj0y53j;
-  real_T rtb_Sqrt_b1kzgfuqba;
-  real_T rtb_Sum_hnwdzvpcji_idx_0_tmp;
-  real_T sin_lat_tmp;
-  real_T sin_long_tmp;
-  int32_T i;
-
-  /* MATLAB Function: '<S47>/MATLAB Function1' incorporates:
-   *  Trigonometry: '<S49>/Trigonometric Function'
-   *  Trigonometry: '<S49>/Trigonometric Function1'
-   *  Trigonometry: '<S49>/Trigonometric Function2'
-   *  Trigonometry: '<S49>/Trigonometric Function3'
-   */
-  /*  LLA as */
-  /*  C as */
-  /*  C_e_n as */
-  /*  Calculate ECEF to NED coordinate transformation matrix using (2.150) */
-  /* MATLAB Function 'pos_NED/ECEF2NED/MATLAB Function1': '<S50>:1' */
-  /* '<S50>:1:6' cos_lat = cos(LLA(1)); */
-  cos_lat_tmp = cos(rtu_LLA1[0]);
-
-  /* '<S50>:1:7' sin_lat = sin(LLA(1)); */
-  sin_lat_tmp = sin(rtu_LLA1[0]);
-
-  /* '<S50>:1:8' cos_long = cos(LLA(2)); */
-  cos_long_tmp = cos(rtu_LLA1[1]);
-
-  /* '<S50>:1:9' sin_long = sin(LLA(2)); */
-  sin_long_tmp = sin(rtu_LLA1[1]);
-
-  /* Product: '<S53>/Product' incorporates:
-   *  Constant: '<S53>/e'
-   */
-  /* '<S50>:1:10' C = [-sin_lat * cos_long, -sin_lat * sin_long,  cos_lat;... */
-  /* '<S50>:1:11'                    -sin_long,            cos_long,        0;... */
-  /* '<S50>:1:12'          -cos_lat * cos_long, -cos_lat * sin_long, -sin_lat]; */
-  rtb_Sqrt_afskj0y53j = sin_lat_tmp * 0.0818191908425;
-
-  /* Sqrt: '<S53>/Sqrt' incorporates:
-   *  Constant: '<S53>/const'
-   *  Math: '<S53>/Square'
-   *  Sum: '<S53>/Add'
-   */
-  rtb_Sqrt_afskj0y53j = sqrt(1.0 - (rtb_Sqrt_afskj0y53j * rtb_Sqrt_afskj0y53j));
-
-  /* Switch: '<S54>/Switch3' incorporates:
-   *  Abs: '<S54>/Abs'
-   *  Product: '<S54>/Product'
-   */
-  if (rtb_Sqrt_afskj0y53j <= 0.001) {
-    rtb_Sqrt_afskj0y53j = -0.001;
-  }
-
-  /* End of Switch: '<S54>/Switch3' */
-
-  /* Product: '<S53>/Divide' incorporates:
-   *  Constant: '<S53>/R_0'
-   */
-  rtb_Sqrt_afskj0y53j = 6.378137E+6 / rtb_Sqrt_afskj0y53j;
-
-  /* Product: '<S49>/Product' incorporates:
-   *  Product: '<S49>/Product1'
-   *  Sum: '<S49>/Sum'
-   */
-  rtb_Sum_hnwdzvpcji_idx_0_tmp = (rtb_Sqrt_afskj0y53j + rtu_LLA1[2]) *
-    cos_lat_tmp;
-
-  /* Trigonometry: '<S48>/Trigonometric Function' */
-  rtb_Add_g2vn0y2s5j = sin(rtu_LLA2[0]);
-
-  /* Product: '<S51>/Product' incorporates:
-   *  Constant: '<S51>/e'
-   */
-  rtb_Sqrt_b1kzgfuqba = rtb_Add_g2vn0y2s5j * 0.0818191908425;
-
-  /* Sqrt: '<S51>/Sqrt' incorporates:
-   *  Constant: '<S51>/const'
-   *  Math: '<S51>/Square'
-   *  Sum: '<S51>/Add'
-   */
-  rtb_Sqrt_b1kzgfuqba = sqrt(1.0 - (rtb_Sqrt_b1kzgfuqba * rtb_Sqrt_b1kzgfuqba));
-
-  /* Switch: '<S52>/Switch3' incorporates:
-   *  Abs: '<S52>/Abs'
-   *  Product: '<S52>/Product'
-   */
-  if (rtb_Sqrt_b1kzgfuqba <= 0.001) {
-    rtb_Sqrt_b1kzgfuqba = -0.001;
-  }
-
-  /* End of Switch: '<S52>/Switch3' */
-
-  /* Product: '<S51>/Divide' incorporates:
-   *  Constant: '<S51>/R_0'
-   */
-  rtb_Sqrt_b1kzgfuqba = 6.378137E+6 / rtb_Sqrt_b1kzgfuqba;
-
-  /* MATLAB Function: '<S47>/MATLAB Function1' */
-  sin_lat_tmp_0[0] = (-sin_lat_tmp) * cos_long_tmp;
-  sin_lat_tmp_0[3] = (-sin_lat_tmp) * sin_long_tmp;
-  sin_lat_tmp_0[6] = cos_lat_tmp;
-  sin_lat_tmp_0[1] = -sin_long_tmp;
-  sin_lat_tmp_0[4] = cos_long_tmp;
-  sin_lat_tmp_0[7] = 0.0;
-  sin_lat_tmp_0[2] = (-cos_lat_tmp) * cos_long_tmp;
-  sin_lat_tmp_0[5] = (-cos_lat_tmp) * sin_long_tmp;
-  sin_lat_tmp_0[8] = -sin_lat_tmp;
-
-  /* Product: '<S48>/Product' incorporates:
-   *  Product: '<S48>/Product1'
-   *  Sum: '<S48>/Sum'
-   *  Trigonometry: '<S48>/Trigonometric Function1'
-   */
-  cos_lat_tmp = (rtb_Sqrt_b1kzgfuqba + rtu_LLA2[2]) * cos(rtu_LLA2[0]);
-
-  /* Sum: '<S46>/Sum' incorporates:
-   *  Constant: '<S48>/1-e^2'
-   *  Constant: '<S49>/1-e^2'
-   *  Product: '<S48>/Product'
-   *  Product: '<S48>/Product1'
-   *  Product: '<S48>/Product2'
-   *  Product: '<S48>/Product3'
-   *  Product: '<S49>/Product'
-   *  Product: '<S49>/Product1'
-   *  Product: '<S49>/Product2'
-   *  Product: '<S49>/Product3'
-   *  Sum: '<S48>/Sum1'
-   *  Sum: '<S49>/Sum1'
-   *  Trigonometry: '<S48>/Trigonometric Function2'
-   *  Trigonometry: '<S48>/Trigonometric Function3'
-   */
-  cos_long_tmp = (cos_lat_tmp * cos(rtu_LLA2[1])) -
-    (rtb_Sum_hnwdzvpcji_idx_0_tmp * cos_long_tmp);
-  sin_long_tmp = (cos_lat_tmp * sin(rtu_LLA2[1])) -
-    (rtb_Sum_hnwdzvpcji_idx_0_tmp * sin_long_tmp);
-  sin_lat_tmp = (rtb_Add_g2vn0y2s5j * ((0.993305620009879 * rtb_Sqrt_b1kzgfuqba)
-    + rtu_LLA2[2])) - (sin_lat_tmp * ((0.993305620009879 * rtb_Sqrt_afskj0y53j)
-    + rtu_LLA1[2]));
-
-  /* Product: '<S47>/Product' */
-  for (i = 0; i < 3; i++) {
-    /* Product: '<S47>/Product' */
-    rtb_Product_msrnbt4gnk[i] = ((sin_lat_tmp_0[i] * cos_long_tmp) +
-      (sin_lat_tmp_0[i + 3] * sin_long_tmp)) + (sin_lat_tmp_0[i + 6] *
-      sin_lat_tmp);
-  }
-
-  /* End of Product: '<S47>/Product' */
-
-  /* Sqrt: '<S40>/Sqrt' incorporates:
-   *  Math: '<S40>/Square'
-   *  Math: '<S40>/Square1'
-   *  Sum: '<S40>/Add'
+  /* '<S46>' ECEF/NED horizontal distance on the geodesy library, the
+   * trigonometry of the waypoint LLA1 is cached across steps
    */
-  *rty_distance = sqrt((rtb_Product_msrnbt4gnk[0] * rtb_Product_msrnbt4gnk[0]) +
-                       (rtb_Product_msrnbt4gnk[1] * rtb_Product_msrnbt4gnk[1]));
+  *rty_distance = (real_T)fcs_geo_distance_from_lla(rtu_LLA1, rtu_LLA2);
 }
 
 /* Function for Chart: '<S1>/fcs_state_machine_stateflow' */
-static void system_state_machine_fj4fquesko(const real_T rtu_sensor_pos_lla[3],
+static void system_state_machine_fj4fquesko(const real64_T rtu_sensor_pos_lla[3],
   const real_T *rtu_sensor_chi, vom_t *rty_vom_status, busMode_data
   *rty_mode_data)
 {
-  real_T Add1_db1a23tfo4;
-  real_T TrigonometricFunction_kveimm1l53;
+  real64_T Add1_db1a23tfo4;
+  real64_T TrigonometricFunction_kveimm1l53;
 
   /* Entry 'BackTransition': '<S8>:2709' */
   /* '<S8>:2709:3' vom_status=vom_t.VOM_B_TRANS; */
@@ -490,9 +280,9 @@ static void system_state_machine_fj4fquesko(const real_T rtu_sensor_pos_lla[3],
 }
 
 /* Function for Chart: '<S1>/fcs_state_machine_stateflow' */
-static void system_state_machine_odhkbmem0z(real_T *TrigonometricFunction,
-  real_T *Add1, real_T *Lat_cfuwhmfptw, real_T *Lon_ikb0u2i02a, real_T
-  *dist_buzfv3hgub, real_T *heading_ieyh5igw0r, const real_T rtu_sensor_pos_lla
+static void system_state_machine_odhkbmem0z(real64_T *TrigonometricFunction,
+  real64_T *Add1, real64_T *Lat_cfuwhmfptw, real64_T *Lon_ikb0u2i02a, real_T
+  *dist_buzfv3hgub, real_T *heading_ieyh5igw0r, const real64_T rtu_sensor_pos_lla
   [3], const real_T *rtu_sensor_chi, vom_t *rty_vom_status, busMode_data
   *rty_mode_data)
 {
@@ -638,12 +428,12 @@ static void system_state_machine_odhkbmem0z(real_T *TrigonometricFunction,
 }
 
 /* Function for Chart: '<S1>/fcs_state_machine_stateflow' */
-static void system_state_machine_hdnpt4qldm(const real_T rtu_sensor_pos_lla[3],
+static void system_state_machine_hdnpt4qldm(const real64_T rtu_sensor_pos_lla[3],
   const real_T *rtu_sensor_aspd_cas, const real_T *rtu_sensor_chi, vom_t
   *rty_vom_status, busMode_data *rty_mode_data)
 {
-  real_T LLA1_daswp04pzd[3];
-  real_T LLA2_cm2j2nf3uy[3];
+  real64_T LLA1_daswp04pzd[3];
+  real64_T LLA2_cm2j2nf3uy[3];
   real_T Sqrt;
 
   /* During 'FTransition': '<S8>:2777' */
@@ -837,9 +627,9 @@ static void system_state_machine_hdnpt4qldm(const real_T rtu_sensor_pos_lla[3],
 }
 
 /* Function for Chart: '<S1>/fcs_state_machine_stateflow' */
-static void system_state_machine_hqecrwkbbn(real_T *TrigonometricFunction,
-  real_T *Add1, real_T *Lat_cfuwhmfptw, real_T *Lon_ikb0u2i02a, real_T
-  *dist_buzfv3hgub, real_T *heading_ieyh5igw0r, const real_T rtu_sensor_pos_lla
+static void system_state_machine_hqecrwkbbn(real64_T *TrigonometricFunction,
+  real64_T *Add1, real64_T *Lat_cfuwhmfptw, real64_T *Lon_ikb0u2i02a, real_T
+  *dist_buzfv3hgub, real_T *heading_ieyh5igw0r, const real64_T rtu_sensor_pos_lla
   [3], const real_T *rtu_sensor_chi, vom_t *rty_vom_status, busMode_data
   *rty_mode_data)
 {
@@ -996,7 +786,7 @@ static void system_state_machine_hqecrwkbbn(real_T *TrigonometricFunction,
 
 /* Function for Chart: '<S1>/fcs_state_machine_stateflow' */
 static void system_state_machine_odubvnrnpm(const real_T rtu_sensor_eul_ang[3],
-  const real_T rtu_sensor_pos_lla[3], vom_t *rty_vom_status, busMode_data
+  const real64_T rtu_sensor_pos_lla[3], vom_t *rty_vom_status, busMode_data
   *rty_mode_data)
 {
   /* Entry Internal 'HOVER': '<S8>:280' */
@@ -1053,15 +843,16 @@ static void system_state_machine_odubvnrnpm(const real_T rtu_sensor_eul_ang[3],
 
 /* Function for Chart: '<S1>/fcs_state_machine_stateflow' */
 static void system_state_machine_gjywfyiloe(const real_T rtu_sensor_eul_ang[3],
-  const real_T rtu_sensor_pos_lla[3], const real_T *rtu_sensor_aspd_cas, const
+  const real64_T rtu_sensor_pos_lla[3], const real_T *rtu_sensor_aspd_cas, const
   real_T *rtu_sensor_chi, const boolean_T *rtu_wp_data_wp_list_valid, vom_t
   *rty_vom_status, busMode_data *rty_mode_data)
 {
-  real_T LLA2[3];
-  real_T Add1;
-  real_T Lat_cfuwhmfptw;
-  real_T Lon_ikb0u2i02a;
-  real_T TrigonometricFunction;
+  real64_T LLA2[3];
+  real64_T Add1;
+  real64_T Lat_cfuwhmfptw;
+  real64_T Lon_ikb0u2i02a;
+  real64_T TrigonometricFunction;
+  real_T distance;
   real_T dist_buzfv3hgub;
   real_T heading_ieyh5igw0r;
   boolean_T guard1;
@@ -1083,7 +874,7 @@ static void system_state_machine_gjywfyiloe(const real_T rtu_sensor_eul_ang[3],
     /* Outputs for Function Call SubSystem: '<S8>/FlightManagement.FMM.FW_Modes.BackTransition.CurrentDistance_From_LLA' */
     /* Simulink Function 'CurrentDistance_From_LLA': '<S8>:2745' */
     system_state_machine_k5j3b5svff(system_state_machine_DW.currentLLA, LLA2,
-      &TrigonometricFunction);
+      &distance);
 
     /* End of Outputs for SubSystem: '<S8>/FlightManagement.FMM.FW_Modes.BackTransition.CurrentDistance_From_LLA' */
     /* '<S8>:2709:19' timecheck= after(60,sec); */
@@ -1105,7 +896,7 @@ static void system_state_machine_gjywfyiloe(const real_T rtu_sensor_eul_ang[3],
         /* Transition: '<S8>:2727' */
         /* Transition: '<S8>:2729' */
         /* '<S8>:2732:1' sf_internal_predicateOutput = distance>700 ||  timecheck==true; */
-      } else if ((TrigonometricFunction > 700.0) || timecheck) {
+      } else if ((distance > 700.0) || timecheck) {
         /* Transition: '<S8>:2732' */
         system_state_machine_DW.is_BackTransition =
           system_state_machine_IN_NO_ACTIVE_CHILD;
@@ -1135,7 +926,7 @@ static void system_state_machine_gjywfyiloe(const real_T rtu_sensor_eul_ang[3],
       /* Transition: '<S8>:2725' */
       /* Transition: '<S8>:2727' */
       /* '<S8>:2732:1' sf_internal_predicateOutput = distance>700 ||  timecheck==true; */
-    } else if ((TrigonometricFunction > 700.0) || timecheck) {
+    } else if ((distance > 700.0) || timecheck) {
       /* Transition: '<S8>:2732' */
       system_state_machine_DW.is_BackTransition =
         system_state_machine_IN_NO_ACTIVE_CHILD;
@@ -1474,7 +1265,7 @@ static void system_state_machine_gjywfyiloe(const real_T rtu_sensor_eul_ang[3],
 
 /* Function for Chart: '<S1>/fcs_state_machine_stateflow' */
 static void system_state_machine_jgwda1ajrs(const real_T rtu_sensor_eul_ang[3],
-  const real_T rtu_sensor_pos_lla[3], vom_t *rty_vom_status, busMode_data
+  const real64_T rtu_sensor_pos_lla[3], vom_t *rty_vom_status, busMode_data
   *rty_mode_data)
 {
   /* Entry 'AUTOLAND': '<S8>:281' */
@@ -1541,7 +1332,7 @@ static void system_state_machine_jgwda1ajrs(const real_T rtu_sensor_eul_ang[3],
 
 /* Function for Chart: '<S1>/fcs_state_machine_stateflow' */
 static void system_state_machine_aeuawg3vfo(const real_T rtu_sensor_eul_ang[3],
-  const real_T rtu_sensor_pos_lla[3], const int8_T *rtu_pilot_input_switch_1,
+  const real64_T rtu_sensor_pos_lla[3], const int8_T *rtu_pilot_input_switch_1,
   const boolean_T *rtu_wp_data_wp_list_valid, vom_t *rty_vom_status,
   busMode_data *rty_mode_data, boolean_T *rty_sFlags_bGPSLoss)
 {
@@ -1805,7 +1596,7 @@ static void system_state_machine_aeuawg3vfo(const real_T rtu_sensor_eul_ang[3],
 
 /* Function for Chart: '<S1>/fcs_state_machine_stateflow' */
 static void system_state_machine_csj5zj0zmt(const real_T rtu_sensor_eul_ang[3],
-  const real_T rtu_sensor_pos_lla[3], const real_T *rtu_sensor_h_radar_agl,
+  const real64_T rtu_sensor_pos_lla[3], const real_T *rtu_sensor_h_radar_agl,
   const int8_T *rtu_pilot_input_switch_1, vom_t *rty_vom_status, busMode_data
   *rty_mode_data, pic_t *rty_pic_status)
 {
@@ -1943,7 +1734,7 @@ static void system_state_machine_csj5zj0zmt(const real_T rtu_sensor_eul_ang[3],
 
 /* Function for Chart: '<S1>/fcs_state_machine_stateflow' */
 static void system_state_machine_fks3ydn24b(const real_T rtu_sensor_eul_ang[3],
-  const real_T rtu_sensor_pos_lla[3], const int8_T *rtu_pilot_input_switch_1,
+  const real64_T rtu_sensor_pos_lla[3], const int8_T *rtu_pilot_input_switch_1,
   vom_t *rty_vom_status, busMode_data *rty_mode_data, boolean_T
   *rty_sFlags_bGPSLoss)
 {
@@ -2080,7 +1871,7 @@ static void system_state_machine_fks3ydn24b(const real_T rtu_sensor_eul_ang[3],
 
 /* Function for Chart: '<S1>/fcs_state_machine_stateflow' */
 static void system_state_machine_afs03nhl30(const real_T rtu_sensor_eul_ang[3],
-  const real_T rtu_sensor_pos_lla[3], const int8_T *rtu_pilot_input_switch_1,
+  const real64_T rtu_sensor_pos_lla[3], const int8_T *rtu_pilot_input_switch_1,
   vom_t *rty_vom_status, busMode_data *rty_mode_data, boolean_T
   *rty_sFlags_rampup_phase)
 {
@@ -2279,7 +2070,7 @@ static void system_state_machine_afs03nhl30(const real_T rtu_sensor_eul_ang[3],
 
 /* Function for Chart: '<S1>/fcs_state_machine_stateflow' */
 static void system_state_machine_phh325i5jc(const real_T *Gain, const real_T
-  rtu_sensor_eul_ang[3], const real_T rtu_sensor_pos_lla[3], const real_T
+  rtu_sensor_eul_ang[3], const real64_T rtu_sensor_pos_lla[3], const real_T
   *rtu_sensor_aspd_cas, const real_T *rtu_sensor_h_radar_agl, const real_T
   *rtu_sensor_chi, const int8_T *rtu_pilot_input_switch_1, const boolean_T
   *rtu_wp_data_wp_list_valid, vom_t *rty_vom_status, busMode_data *rty_mode_data,
@@ -3567,7 +3358,7 @@ static void system_state_machine_g0rztozkme(const vom_t *vom_status, boolean_T
 static void system_state_machine_fhrgqlbunr(const boolean_T
   *FixPtRelationalOperator, const boolean_T *FixPtRelationalOperator_cwrqbb5ufj,
   const real_T *Gain, const vom_t *vom_status, const real_T *Switch, const
-  real_T *Switch_kc4btehf20, const real_T rtu_sensor_eul_ang[3], const real_T
+  real_T *Switch_kc4btehf20, const real_T rtu_sensor_eul_ang[3], const real64_T
   rtu_sensor_pos_lla[3], const real_T *rtu_sensor_aspd_cas, const real_T
   *rtu_sensor_h_radar_agl, const real_T *rtu_sensor_chi, const int8_T
   *rtu_pilot_input_switch_1, const real_T *rtu_controllerAltCtrl_forceDes, const
@@ -4095,7 +3886,7 @@ void system_state_machine_Init(boolean_T *rty_bInAirFlag, vom_t *rty_vom_status,
 void system_state_machine(const vom_t *rtu_std_command_vom_cmd, const uint16_T
   *rtu_std_command_vom_cmd_cnt, const pic_t *rtu_std_command_pic_cmd, const
   uint16_T *rtu_std_command_pic_cmd_cnt, const real_T rtu_sensor_eul_ang[3],
-  const real_T rtu_sensor_pos_lla[3], const real_T rtu_sensor_vel_ned[3], const
+  const real64_T rtu_sensor_pos_lla[3], const real_T rtu_sensor_vel_ned[3], const
   real_T *rtu_sensor_aspd_cas, const real_T *rtu_sensor_h_radar_agl, const
   real_T *rtu_sensor_chi, const real_T *rtu_pilot_input_throttle_ch, const
   real_T *rtu_pilot_input_arm_ch, const int8_T *rtu_pilot_input_switch_1, const
@@ -4108,15 +3899,15 @@ void system_state_machine(const vom_t *rtu_std_command_vom_cmd, const uint16_T
   *rtu_FWRTH_SM_in_approach_circle_done, const boolean_T
   *rtu_FWRTH_SM_in_reduce_speed_alt_done, const boolean_T
   *rtu_FWRTH_SM_in_circle_align_done, const boolean_T
-  *rtu_FWRTH_SM_in_cross_tangent_point_done, const real_T
-  *rtu_FWRTH_SM_in_land_lat, const real_T *rtu_FWRTH_SM_in_land_lon, const
+  *rtu_FWRTH_SM_in_cross_tangent_point_done, const real64_T
+  *rtu_FWRTH_SM_in_land_lat, const real64_T *rtu_FWRTH_SM_in_land_lon, const
   real_T *rtu_FWRTH_SM_in_approach_ang, const real_T
   *rtu_WP_SMdata_in_cur_leg_heading, const real_T
   *rtu_WP_SMdata_in_cur_leg_length, const real_T
   *rtu_WP_SMdata_in_cur_leg_remaining_dist, const boolean_T
   *rtu_WP_SMdata_in_wp_list_valid, const boolean_T
-  *rtu_WP_SMdata_in_last_wp_land, const real_T *rtu_WP_SMdata_in_land_wp_lat,
-  const real_T *rtu_WP_SMdata_in_land_wp_lon, const real_T
+  *rtu_WP_SMdata_in_last_wp_land, const real64_T *rtu_WP_SMdata_in_land_wp_lat,
+  const real64_T *rtu_WP_SMdata_in_land_wp_lon, const real_T
   *rtu_WP_SMdata_in_curpos_to_wp_heading, const boolean_T
   *rtu_WP_SMdata_in_WPN_cmd_received, const boolean_T *rtu_wp_data_wp_list_valid,
   boolean_T *rty_bInAirFlag, vom_t *rty_vom_status, busMode_data *rty_mode_data,
@@ -4131,12 +3922,18 @@ void system_state_machine(const vom_t *rtu_std_command_vom_cmd, const uint16_T
   pic_t *rty_pic_status, uint8_T *rty_CoG_tracking, real_T *rty_h_rel_takeoff)
 {
   real_T sin_lat[9];
-  real_T rtb_Product_invsy3i2yj[3];
-  real_T rtb_Sqrt;
+  real64_T rtb_Divide;
+  real64_T rtb_Product_invsy3i2yj[3];
+  real64_T rtb_Sqrt;
   real_T rtb_Sum_be4knqil4l_idx_0;
+  real64_T rtb_Sum_ecef_idx_0;
+  real64_T rtb_Sum_ecef_idx_1;
+  real64_T rtb_Sum_ecef_idx_2;
   real_T rtb_Sum_evx323najj;
+  real64_T rtb_Sum_lla;
   real_T rtb_Switch;
   real_T rtb_Switch_pjqesw53bu;
+  real64_T rtb_TrigonometricFunction;
   real_T rtb_TrigonometricFunction2;
   real_T rtb_alt;
   int32_T i;
@@ -4221,12 +4018,12 @@ void system_state_machine(const vom_t *rtu_std_command_vom_cmd, const uint16_T
    *  Constant: '<S6>/AlAin_Runway'
    *  Delay: '<S6>/Delay One Step1'
    */
-  system_state_machine_B.sLLA[0] = 0.42700150356474043;
-  system_state_machine_B.sLLA[1] = 0.97080864372042563;
+  system_state_machine_B.sLLA[0] = RT_REAL64(0.42700150356474043);
+  system_state_machine_B.sLLA[1] = RT_REAL64(0.97080864372042563);
   system_state_machine_B.sLLA[2] = system_state_machine_DW.DelayOneStep1_DSTATE;
 
   /* Sum: '<S10>/Add' */
-  rtb_TrigonometricFunction2 = 0.97080864372042563 - rtu_sensor_pos_lla[1];
+  rtb_Sum_lla = RT_REAL64(0.97080864372042563) - rtu_sensor_pos_lla[1];
 
   /* Trigonometry: '<S10>/Trigonometric Function6' incorporates:
    *  Product: '<S10>/Product'
@@ -4240,10 +4037,10 @@ void system_state_machine(const vom_t *rtu_std_command_vom_cmd, const uint16_T
    *  Trigonometry: '<S10>/Trigonometric Function4'
    *  Trigonometry: '<S10>/Trigonometric Function5'
    */
-  system_state_machine_B.TrigonometricFunction6 = atan2(0.91021164717306147 *
-    sin(rtb_TrigonometricFunction2), (cos(rtu_sensor_pos_lla[0]) *
-    0.4141434019159333) - ((sin(rtu_sensor_pos_lla[0]) * 0.91021164717306147) *
-    cos(rtb_TrigonometricFunction2)));
+  system_state_machine_B.TrigonometricFunction6 = atan2(RT_REAL64(0.91021164717306147) *
+    sin(rtb_Sum_lla), (cos(rtu_sensor_pos_lla[0]) *
+    RT_REAL64(0.4141434019159333)) - ((sin(rtu_sensor_pos_lla[0]) * RT_REAL64(0.91021164717306147)) *
+    cos(rtb_Sum_lla)));
 
   /* Sum: '<S27>/Sum' */
   /*  LLA as */
@@ -4258,29 +4055,29 @@ void system_state_machine(const vom_t *rtu_std_command_vom_cmd, const uint16_T
   /* '<S28>:1:10' C = [-sin_lat * cos_long, -sin_lat * sin_long,  cos_lat;... */
   /* '<S28>:1:11'                    -sin_long,            cos_long,        0;... */
   /* '<S28>:1:12'          -cos_lat * cos_long, -cos_lat * sin_long, -sin_lat]; */
-  rtb_TrigonometricFunction2 = rtu_sensor_pos_lla[2] + 6.3818017966873543E+6;
+  rtb_Sum_lla = rtu_sensor_pos_lla[2] + RT_REAL64(6.3818017966873543E+6);
 
   /* Trigonometry: '<S26>/Trigonometric Function' */
-  rtb_Switch_pjqesw53bu = sin(rtu_sensor_pos_lla[0]);
+  rtb_TrigonometricFunction = sin(rtu_sensor_pos_lla[0]);
 
   /* Product: '<S29>/Product' incorporates:
    *  Constant: '<S29>/e'
    */
-  rtb_Sum_evx323najj = rtb_Switch_pjqesw53bu * 0.0818191908425;
+  rtb_Divide = rtb_TrigonometricFunction * RT_REAL64(0.0818191908425);
 
   /* Sqrt: '<S29>/Sqrt' incorporates:
    *  Constant: '<S29>/const'
    *  Math: '<S29>/Square'
    *  Sum: '<S29>/Add'
    */
-  rtb_Sum_evx323najj = sqrt(1.0 - (rtb_Sum_evx323najj * rtb_Sum_evx323najj));
+  rtb_Divide = sqrt(1.0 - (rtb_Divide * rtb_Divide));
 
   /* Switch: '<S30>/Switch3' incorporates:
    *  Abs: '<S30>/Abs'
    *  Product: '<S30>/Product'
    */
-  if (rtb_Sum_evx323najj <= 0.001) {
-    rtb_Sum_evx323najj = -0.001;
+  if (rtb_Divide <= RT_REAL64(0.001)) {
+    rtb_Divide = -RT_REAL64(0.001);
   }
 
   /* End of Switch: '<S30>/Switch3' */
@@ -4288,7 +4085,7 @@ void system_state_machine(const vom_t *rtu_std_command_vom_cmd, const uint16_T
   /* Product: '<S29>/Divide' incorporates:
    *  Constant: '<S29>/R_0'
    */
-  rtb_Sum_evx323najj = 6.378137E+6 / rtb_Sum_evx323najj;
+  rtb_Divide = 6.378137E+6 / rtb_Divide;
 
   /* Product: '<S26>/Product' incorporates:
    *  Product: '<S26>/Product1'
@@ -4296,7 +4093,7 @@ void system_state_machine(const vom_t *rtu_std_command_vom_cmd, const uint16_T
    *  Trigonometry: '<S26>/Trigonometric Function1'
    *  Trigonometry: '<S26>/Trigonometric Function3'
    */
-  rtb_Sqrt = (rtb_Sum_evx323najj + rtu_sensor_pos_lla[2]) * cos
+  rtb_Sqrt = (rtb_Divide + rtu_sensor_pos_lla[2]) * cos
     (rtu_sensor_pos_lla[0]);
   rtb_Product_invsy3i2yj[0] = rtb_Sqrt * cos(rtu_sensor_pos_lla[1]);
 
@@ -4329,20 +4126,20 @@ void system_state_machine(const vom_t *rtu_std_command_vom_cmd, const uint16_T
    *  Trigonometry: '<S27>/Trigonometric Function2'
    *  Trigonometry: '<S27>/Trigonometric Function3'
    */
-  rtb_Sum_be4knqil4l_idx_0 = rtb_Product_invsy3i2yj[0] -
-    ((rtb_TrigonometricFunction2 * 0.91021164717306147) * 0.56463230775490036);
-  rtb_TrigonometricFunction2 = (rtb_Sqrt * sin(rtu_sensor_pos_lla[1])) -
-    ((rtb_TrigonometricFunction2 * 0.91021164717306147) * 0.825342569506369);
-  rtb_Sum_evx323najj = (rtb_Switch_pjqesw53bu * ((0.993305620009879 *
-    rtb_Sum_evx323najj) + rtu_sensor_pos_lla[2])) - (0.4141434019159333 *
-    (rtu_sensor_pos_lla[2] + 6.3390795904386919E+6));
+  rtb_Sum_ecef_idx_0 = rtb_Product_invsy3i2yj[0] -
+    ((rtb_Sum_lla * RT_REAL64(0.91021164717306147)) * RT_REAL64(0.56463230775490036));
+  rtb_Sum_ecef_idx_1 = (rtb_Sqrt * sin(rtu_sensor_pos_lla[1])) -
+    ((rtb_Sum_lla * RT_REAL64(0.91021164717306147)) * RT_REAL64(0.825342569506369));
+  rtb_Sum_ecef_idx_2 = (rtb_TrigonometricFunction * ((RT_REAL64(0.993305620009879) *
+    rtb_Divide) + rtu_sensor_pos_lla[2])) - (RT_REAL64(0.4141434019159333) *
+    (rtu_sensor_pos_lla[2] + RT_REAL64(6.3390795904386919E+6)));
 
   /* Product: '<S25>/Product' */
   for (i = 0; i < 3; i++) {
     /* Product: '<S25>/Product' */
-    rtb_Product_invsy3i2yj[i] = ((sin_lat[i] * rtb_Sum_be4knqil4l_idx_0) +
-      (sin_lat[i + 3] * rtb_TrigonometricFunction2)) + (sin_lat[i + 6] *
-      rtb_Sum_evx323najj);
+    rtb_Product_invsy3i2yj[i] = ((sin_lat[i] * rtb_Sum_ecef_idx_0) +
+      (sin_lat[i + 3] * rtb_Sum_ecef_idx_1)) + (sin_lat[i + 6] *
+      rtb_Sum_ecef_idx_2);
   }
 
   /* End of Product: '<S25>/Product' */
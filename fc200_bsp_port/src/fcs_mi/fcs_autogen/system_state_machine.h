@@ -34,7 +34,7 @@ extern void system_state_machine_Init(boolean_T *rty_bInAirFlag, vom_t
 extern void system_state_machine(const vom_t *rtu_std_command_vom_cmd, const
   uint16_T *rtu_std_command_vom_cmd_cnt, const pic_t *rtu_std_command_pic_cmd,
   const uint16_T *rtu_std_command_pic_cmd_cnt, const real_T rtu_sensor_eul_ang[3],
-  const real_T rtu_sensor_pos_lla[3], const real_T rtu_sensor_vel_ned[3], const
+  const real64_T rtu_sensor_pos_lla[3], const real_T rtu_sensor_vel_ned[3], const
   real_T *rtu_sensor_aspd_cas, const real_T *rtu_sensor_h_radar_agl, const
   real_T *rtu_sensor_chi, const real_T *rtu_pilot_input_throttle_ch, const
   real_T *rtu_pilot_input_arm_ch, const int8_T *rtu_pilot_input_switch_1, const
@@ -47,15 +47,15 @@ extern void system_state_machine(const vom_t *rtu_std_command_vom_cmd, const
   *rtu_FWRTH_SM_in_approach_circle_done, const boolean_T
   *rtu_FWRTH_SM_in_reduce_speed_alt_done, const boolean_T
   *rtu_FWRTH_SM_in_circle_align_done, const boolean_T
-  *rtu_FWRTH_SM_in_cross_tangent_point_done, const real_T
-  *rtu_FWRTH_SM_in_land_lat, const real_T *rtu_FWRTH_SM_in_land_lon, const
+  *rtu_FWRTH_SM_in_cross_tangent_point_done, const real64_T
+  *rtu_FWRTH_SM_in_land_lat, const real64_T *rtu_FWRTH_SM_in_land_lon, const
   real_T *rtu_FWRTH_SM_in_approach_ang, const real_T
   *rtu_WP_SMdata_in_cur_leg_heading, const real_T
   *rtu_WP_SMdata_in_cur_leg_length, const real_T
   *rtu_WP_SMdata_in_cur_leg_remaining_dist, const boolean_T
   *rtu_WP_SMdata_in_wp_list_valid, const boolean_T
-  *rtu_WP_SMdata_in_last_wp_land, const real_T *rtu_WP_SMdata_in_land_wp_lat,
-  const real_T *rtu_WP_SMdata_in_land_wp_lon, const real_T
+  *rtu_WP_SMdata_in_last_wp_land, const real64_T *rtu_WP_SMdata_in_land_wp_lat,
+  const real64_T *rtu_WP_SMdata_in_land_wp_lon, const real_T
   *rtu_WP_SMdata_in_curpos_to_wp_heading, const boolean_T
   *rtu_WP_SMdata_in_WPN_cmd_received, const boolean_T *rtu_wp_data_wp_list_valid,
   boolean_T *rty_bInAirFlag, vom_t *rty_vom_status, busMode_data *rty_mode_data,
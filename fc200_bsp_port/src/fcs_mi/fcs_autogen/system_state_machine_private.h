@@ -29,7 +29,7 @@ typedef struct {
   failure_flag_t
     BusConversion_InsertedFor_fcs_state_machine_stateflow_nqsisctbxb;
   real_T Max;                          /* '<S9>/Max' */
-  real_T sLLA[3];                      /* '<S1>/Reshape1' */
+  real64_T sLLA[3];                    /* '<S1>/Reshape1' */
   real_T TrigonometricFunction6;       /* '<S10>/Trigonometric Function6' */
   real_T Add4;                         /* '<S15>/Add4' */
   vom_t Switch_d533txexjk;             /* '<S14>/Switch' */
@@ -51,7 +51,7 @@ typedef struct {
   real_T rampup_timer;                 /* '<S1>/fcs_state_machine_stateflow' */
   real_T bRTH2LandingFlag;             /* '<S1>/fcs_state_machine_stateflow' */
   real_T bRecoverGPS;                  /* '<S1>/fcs_state_machine_stateflow' */
-  real_T currentLLA[3];                /* '<S1>/fcs_state_machine_stateflow' */
+  real64_T currentLLA[3];              /* '<S1>/fcs_state_machine_stateflow' */
   real_T bL2RTH_LinkLossFlag;          /* '<S1>/fcs_state_machine_stateflow' */
   real_T TimerEPIPLoss;                /* '<S1>/fcs_state_machine_stateflow' */
   vom_t UnitDelay1_DSTATE_jsa3d2gsdq;  /* '<S1>/Unit Delay1' */
@@ -135,10 +135,10 @@ typedef struct {
 
 extern void system_state_machine_lkpmp3sm0z(real_T rtu_u, real_T *rty_y, const
   system_state_machine_mxmu1gefao_TConstB *localC);
-extern void system_state_machine_mkamotaax2(real_T rtu_Lat, real_T rtu_Lon,
-  real_T rtu_dist, real_T rtu_heading, real_T *rty_latOut, real_T *rty_lonOut);
-extern void system_state_machine_k5j3b5svff(const real_T rtu_LLA1[3], const
-  real_T rtu_LLA2[3], real_T *rty_distance);
+extern void system_state_machine_mkamotaax2(real64_T rtu_Lat, real64_T rtu_Lon,
+  real_T rtu_dist, real_T rtu_heading, real64_T *rty_latOut, real64_T *rty_lonOut);
+extern void system_state_machine_k5j3b5svff(const real64_T rtu_LLA1[3], const
+  real64_T rtu_LLA2[3], real_T *rty_distance);
 
 /* Invariant block signals (default storage) */
 extern const system_state_machine_TConstB system_state_machine_ConstB;
@@ -59,8 +59,8 @@ typedef struct {
 #define DEFINED_TYPEDEF_FOR_busHover_data_
 
 typedef struct {
-  real_T hover_y;
-  real_T hover_x;
+  real64_T hover_y;
+  real64_T hover_x;
   real_T hover_alt_agl;
   real_T hover_yaw_ref;
   boolean_T hover_yaw_override;
@@ -72,8 +72,8 @@ typedef struct {
 #define DEFINED_TYPEDEF_FOR_busAutotakeoff_data_
 
 typedef struct {
-  real_T takeoff_x;
-  real_T takeoff_y;
+  real64_T takeoff_x;
+  real64_T takeoff_y;
   real_T takeoff_alt_agl;
   real_T takeoff_yaw_ref;
 } busAutotakeoff_data;
@@ -84,8 +84,8 @@ typedef struct {
 #define DEFINED_TYPEDEF_FOR_busAutoland_data_
 
 typedef struct {
-  real_T land_x;
-  real_T land_y;
+  real64_T land_x;
+  real64_T land_y;
   real_T land_yaw_ref;
 } busAutoland_data;
 
@@ -95,8 +95,8 @@ typedef struct {
 #define DEFINED_TYPEDEF_FOR_busRTH_data_
 
 typedef struct {
-  real_T rth_x;
-  real_T rth_y;
+  real64_T rth_x;
+  real64_T rth_y;
   real_T rth_velX;
   real_T rth_velY;
   real_T rth_alt_agl;
@@ -121,8 +121,8 @@ typedef enum {
 #define DEFINED_TYPEDEF_FOR_busFTransition_data_
 
 typedef struct {
-  real_T FT_x;
-  real_T FT_y;
+  real64_T FT_x;
+  real64_T FT_y;
   real_T FT_Altitude;
   real_T FT_Heading;
   real_T FT_AirspeedRef;
@@ -154,8 +154,8 @@ typedef struct {
 typedef struct {
   real_T loiter_radius;
   real_T loiter_direction;
-  real_T loiter_Center_Lat;
-  real_T loiter_Center_Lon;
+  real64_T loiter_Center_Lat;
+  real64_T loiter_Center_Lon;
   real_T loiter_altitude;
   real_T loiter_AirSpeedRef;
 } busLoiter_data;
@@ -166,8 +166,8 @@ typedef struct {
 #define DEFINED_TYPEDEF_FOR_busBTransiton_data_
 
 typedef struct {
-  real_T BT_Hover_Lat;
-  real_T BT_Hover_Lon;
+  real64_T BT_Hover_Lat;
+  real64_T BT_Hover_Lon;
   real_T BT_Altitude;
   real_T BT_Heading;
   real_T BT_PusherThrottle;
@@ -252,8 +252,8 @@ typedef struct {
   boolean_T reduce_speed_alt_done;
   boolean_T circle_align_done;
   boolean_T cross_tangent_point_done;
-  real_T land_lat;
-  real_T land_lon;
+  real64_T land_lat;
+  real64_T land_lon;
   real_T approach_ang;
 } busFWRTH_data_in;
 
@@ -268,8 +268,8 @@ typedef struct {
   real_T cur_leg_remaining_dist;
   boolean_T wp_list_valid;
   boolean_T last_wp_land;
-  real_T land_wp_lat;
-  real_T land_wp_lon;
+  real64_T land_wp_lat;
+  real64_T land_wp_lon;
   real_T curpos_to_wp_heading;
   boolean_T WPN_cmd_received;
 } busWP_SMdata_in;
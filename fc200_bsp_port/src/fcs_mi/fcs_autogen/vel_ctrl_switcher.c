@@ -41,7 +41,7 @@ void vel_ctrl_switcher_Init(void)
 }
 
 /* Output and update for referenced model: 'vel_ctrl_switcher' */
-void vel_ctrl_switcher(const real_T rtu_Sensor_pos_lla[3], const real_T
+void vel_ctrl_switcher(const real64_T rtu_Sensor_pos_lla[3], const real_T
   rtu_Sensor_vel_ned[3], const real_T *rtu_Sensor_h_radar_agl, const pilot_ext_t
   *rtu_Pilot, const real_T *rtu_ctrlIF_vel_velCmdH_x, const real_T
   *rtu_ctrlIF_vel_velCmdH_y, const real_T *rtu_ctrlIF_vel_hRateCmd, const vom_t *
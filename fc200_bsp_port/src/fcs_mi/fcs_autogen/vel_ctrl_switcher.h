@@ -25,7 +25,7 @@
 #include <string.h>
 
 extern void vel_ctrl_switcher_Init(void);
-extern void vel_ctrl_switcher(const real_T rtu_Sensor_pos_lla[3], const real_T
+extern void vel_ctrl_switcher(const real64_T rtu_Sensor_pos_lla[3], const real_T
   rtu_Sensor_vel_ned[3], const real_T *rtu_Sensor_h_radar_agl, const pilot_ext_t
   *rtu_Pilot, const real_T *rtu_ctrlIF_vel_velCmdH_x, const real_T
   *rtu_ctrlIF_vel_velCmdH_y, const real_T *rtu_ctrlIF_vel_hRateCmd, const vom_t *
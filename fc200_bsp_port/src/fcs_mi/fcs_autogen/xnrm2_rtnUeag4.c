@@ -23,7 +23,7 @@ real_T xnrm2_rtnUeag4(int32_T n, const real_T x[32], int32_T ix0)
   int32_T k;
   int32_T kend;
   y = 0.0;
-  scale = 3.3121686421112381E-170;
+  scale = RT_NRM2_SCALE;
   kend = ix0 + n;
   for (k = ix0; k < kend; k++) {
     absxk = fabs(x[k - 1]);
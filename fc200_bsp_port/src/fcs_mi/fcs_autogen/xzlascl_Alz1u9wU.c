@@ -27,13 +27,13 @@ void xzlascl_Alz1u9wU(real_T cfrom, real_T cto, real_T A[32])
   ctoc = cto;
   notdone = true;
   while (notdone) {
-    cfrom1 = cfromc * 2.0041683600089728E-292;
-    cto1 = ctoc / 4.9896007738368E+291;
+    cfrom1 = cfromc * RT_LASCL_SMLNUM;
+    cto1 = ctoc / RT_LASCL_BIGNUM;
     if ((fabs(cfrom1) > fabs(ctoc)) && (ctoc != 0.0)) {
-      mul = 2.0041683600089728E-292;
+      mul = RT_LASCL_SMLNUM;
       cfromc = cfrom1;
     } else if (fabs(cto1) > fabs(cfromc)) {
-      mul = 4.9896007738368E+291;
+      mul = RT_LASCL_BIGNUM;
       ctoc = cto1;
     } else {
       mul = ctoc / cfromc;
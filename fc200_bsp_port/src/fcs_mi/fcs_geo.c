@@ -0,0 +1,78 @@
+/****************************************************
+ *  fcs_geo.c
+ *  Created on: 18-Oct-2025
+ *  Geodesy functions of the flight management chart
+ *  Copyright: LODD (c) 2025
+ ****************************************************/
+
+#include "fcs_geo.h"
+#include <stddef.h>
+
+/* Reference points of the waypoints, the hover and back transition points */
+static geo_cache_t fcs_geo_cache;
+
+/**
+ * @brief Destination point of the chart's destinationPoint function.
+ *
+ * The start point is the vehicle position when a mode is entered, which
+ * is not used again, so it is computed in place and kept out of the
+ * waypoint cache.
+ *
+ * @param[in]  lat      Latitude of the start point (rad)
+ * @param[in]  lon      Longitude of the start point (rad)
+ * @param[in]  dist     Distance to travel (m)
+ * @param[in]  heading  Initial heading (rad), clockwise from north
+ * @param[out] lat_out  Latitude of the destination (rad)
+ * @param[out] lon_out  Longitude of the destination (rad)
+ */
+void fcs_geo_destination_point(double lat, double lon, double dist, double heading,
+                               double *lat_out, double *lon_out)
+{
+    geo_point_t start = {0};
+
+    if ((lat_out != NULL) && (lon_out != NULL))
+    {
+        geo_point_set(&start, lat, lon);
+        geo_destination(&start, dist, heading, lat_out, lon_out);
+    }
+}
+
+/**
+ * @brief Horizontal distance of the chart's CurrentDistance_From_LLA function.
+ *
+ * The reference is a waypoint, such as the hover point of the forward
+ * transition or the point where the back transition started, and stays
+ * the same while the vehicle position lla changes every step. Its point
+ * is keyed on its coordinates in the waypoint cache.
+ *
+ * @param[in] lla_ref  Latitude, longitude and altitude of the waypoint
+ * @param[in] lla      Latitude, longitude and altitude of the vehicle
+ *
+ * @return Distance (m)
+ */
+double fcs_geo_distance_from_lla(const double lla_ref[3], const double lla[3])
+{
+    double dist = 0.0;
+
+    if ((lla_ref != NULL) && (lla != NULL))
+    {
+        dist = geo_distance(geo_cache_point(&fcs_geo_cache, lla_ref[0], lla_ref[1]), lla[0], lla[1]);
+    }
+
+    return dist;
+}
+
+/**
+ * @brief Lookups and misses of the waypoint cache.
+ *
+ * @param[out] lookups  Reference points looked up
+ * @param[out] misses   Lookups that computed a point
+ */
+void fcs_geo_cache_stats(uint32_t *lookups, uint32_t *misses)
+{
+    if ((lookups != NULL) && (misses != NULL))
+    {
+        *lookups = fcs_geo_cache.lookups;
+        *misses = fcs_geo_cache.misses;
+    }
+}
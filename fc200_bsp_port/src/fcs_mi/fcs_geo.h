@@ -0,0 +1,40 @@
+/****************************************************
+ *  fcs_geo.h
+ *  Created on: 18-Oct-2025
+ *  Geodesy functions of the flight management chart
+ *  Copyright: LODD (c) 2025
+ ****************************************************/
+
+#ifndef H_FCS_GEO
+#define H_FCS_GEO
+
+#include "geo_util.h"
+
+/*
+The destinationPoint and CurrentDistance_From_LLA functions of the
+flight management chart on the geodesy library. The chart's Simulink
+Function subsystems in system_state_machine.c call them in place of
+their generated ECEF/NED code. The reference points of the waypoints
+are cached by their coordinates.
+Angles in radians, distances and altitudes in metres.
+*/
+
+/*
+Point at dist along heading from lat, lon on the chart's spherical
+earth model.
+*/
+void fcs_geo_destination_point(double lat, double lon, double dist, double heading,
+                               double *lat_out, double *lon_out);
+
+/*
+Horizontal distance from the waypoint lla_ref to lla. The trigonometry
+of the waypoint is evaluated on its first use only.
+*/
+double fcs_geo_distance_from_lla(const double lla_ref[3], const double lla[3]);
+
+/*
+Lookups and misses of the waypoint cache since start up.
+*/
+void fcs_geo_cache_stats(uint32_t *lookups, uint32_t *misses);
+
+#endif /* H_FCS_GEO */
@@ -0,0 +1,529 @@
+/****************************************************
+ *  fcs_input_sel.c
+ *  Created on: 18-Oct-2025
+ *  Selection of the redundant sensor inputs of the FCS step
+ *  Copyright: LODD (c) 2025
+ ****************************************************/
+
+#include "fcs_input_sel.h"
+#include <stddef.h>
+#include <math.h>
+
+#define SEL_MAX_ELEMENTS (3U)
+#define SEL_PI (3.14159265358979)
+#define SEL_TWO_PI (6.28318530717959)
+#define SEL_EARTH_RADIUS_M (6371000.0)
+#define SEL_NO_LIMIT (1.0e30)
+
+/* Voting parameters of a signal group, the limits apply to each element */
+typedef struct
+{
+    uint8_t elements;
+    uint8_t wrap_mask;                      // elements that are angles wrapping at 2 pi
+    double tolerance[SEL_MAX_ELEMENTS];     // largest difference between agreeing channels
+    double rate_limit[SEL_MAX_ELEMENTS];    // largest change of a channel between frames
+} sel_group_cfg_t;
+
+/* Signal group of one channel for one frame */
+typedef struct
+{
+    double value[SEL_MAX_ELEMENTS];
+    double rate[SEL_MAX_ELEMENTS];          // derivative used to align the sample to the control instant
+    double age_s;                           // age of the sample, 0 if unknown
+    uint8_t fault;                          // FCS_SEL_FAULT_ bits
+} sel_sample_t;
+
+/* Voting state of a signal group */
+typedef struct
+{
+    double last[FCS_SEL_CHANNELS][SEL_MAX_ELEMENTS];  // previous sample of each channel
+    bool last_valid[FCS_SEL_CHANNELS];
+    double output[SEL_MAX_ELEMENTS];                  // selected value, held when no channel is usable
+    uint8_t miscompare_frames;
+    int8_t selected;
+} sel_group_state_t;
+
+/* Limits per frame of 10 ms, angles in radians */
+static const sel_group_cfg_t NAV_CFG[FCS_SEL_NAV_GROUPS] = {
+    {3U, 0x04U, {0.087, 0.087, 0.087}, {0.1, 0.1, 0.1}},          /* FCS_SEL_NAV_ATT, yaw wraps */
+    {3U, 0x00U, {0.1, 0.1, 0.1}, {3.0, 3.0, 3.0}},                /* FCS_SEL_NAV_OMG [rad/s] */
+    {3U, 0x00U, {2.0, 2.0, 2.0}, {50.0, 50.0, 50.0}},             /* FCS_SEL_NAV_ACC [m/s^2] */
+    {3U, 0x00U, {5.0e-6, 5.0e-6, 20.0}, {1.6e-6, 1.6e-6, 5.0}},   /* FCS_SEL_NAV_POS [rad, rad, m] */
+    {3U, 0x00U, {2.0, 2.0, 2.0}, {3.0, 3.0, 3.0}},                /* FCS_SEL_NAV_VEL [m/s] */
+    {2U, 0x00U, {SEL_NO_LIMIT, SEL_NO_LIMIT, 0.0}, {SEL_NO_LIMIT, SEL_NO_LIMIT, 0.0}}, /* FCS_SEL_NAV_ACCURACY, not compared */
+};
+
+static const sel_group_cfg_t ADS_CFG[FCS_SEL_ADS_GROUPS] = {
+    {1U, 0x00U, {5.0, 0.0, 0.0}, {10.0, 0.0, 0.0}},               /* FCS_SEL_ADS_AOA [deg] */
+    {1U, 0x00U, {5.0, 0.0, 0.0}, {10.0, 0.0, 0.0}},               /* FCS_SEL_ADS_AOS [deg] */
+    {1U, 0x00U, {3.0, 0.0, 0.0}, {5.0, 0.0, 0.0}},                /* FCS_SEL_ADS_CAS [m/s] */
+    {1U, 0x00U, {20.0, 0.0, 0.0}, {10.0, 0.0, 0.0}},              /* FCS_SEL_ADS_BARO [m] */
+};
+
+static sel_group_state_t NavState[FCS_SEL_NAV_GROUPS];
+static sel_group_state_t AdsState[FCS_SEL_ADS_GROUPS];
+static fcs_sel_status_t SelStatus;
+
+static bool sel_all_finite(const double *v, uint8_t n);
+static double sel_difference(const sel_group_cfg_t *cfg, uint8_t i, double a, double b);
+static double sel_distance(const sel_group_cfg_t *cfg, const double *a, const double *b);
+static void sel_align(const sel_group_cfg_t *cfg, const sel_sample_t *s, double *aligned);
+static void sel_monitor(const sel_group_cfg_t *cfg, sel_group_state_t *state, uint8_t ch, sel_sample_t *s);
+static bool sel_vote(const sel_group_cfg_t *cfg, sel_group_state_t *state, sel_sample_t s[FCS_SEL_CHANNELS]);
+static uint8_t sel_base_fault(bool present, bool age_known, uint32_t age_us);
+
+/**
+ * @brief Initializes the selection state.
+ *
+ * Every group starts with no channel selected and a zero output, which is
+ * what the controller inputs hold before the first frame.
+ */
+void fcs_sel_init(void)
+{
+    sel_group_state_t empty = {0};
+    fcs_sel_status_t empty_status = {0};
+
+    empty.selected = FCS_SEL_HELD;
+
+    for (uint8_t g = 0U; g < FCS_SEL_NAV_GROUPS; g++)
+    {
+        NavState[g] = empty;
+    }
+    for (uint8_t g = 0U; g < FCS_SEL_ADS_GROUPS; g++)
+    {
+        AdsState[g] = empty;
+    }
+    SelStatus = empty_status;
+}
+
+/**
+ * @brief Votes the navigation channels into one validated input set.
+ *
+ * Each signal group is checked per channel for presence, age, non-finite
+ * values and rate of change, then the usable channels are compared after
+ * aligning them to the control instant. Agreeing channels keep the
+ * current selection, channel 0 having priority; a persistent disagreement
+ * selects the mid value of the channels and the last output. A group no
+ * channel can supply is held and flagged invalid. A channel flagged
+ * invalid by its source is used, flagged invalid, only when no healthy
+ * channel exists.
+ *
+ * @param[in]  in  Channel inputs of the frame
+ * @param[out] out Selected input set
+ */
+void fcs_sel_nav(const fcs_sel_nav_in_t in[FCS_SEL_CHANNELS], nav_data_t *out)
+{
+    sel_sample_t s[FCS_SEL_NAV_GROUPS][FCS_SEL_CHANNELS];
+    bool valid[FCS_SEL_NAV_GROUPS];
+    bool any_present = false;
+
+    if ((in == NULL) || (out == NULL))
+    {
+        return;
+    }
+
+    /* Arrange the channels by signal group */
+    for (uint8_t ch = 0U; ch < FCS_SEL_CHANNELS; ch++)
+    {
+        const nav_data_t *d = &in[ch].data;
+        uint8_t fault = sel_base_fault(in[ch].present, in[ch].age_known, in[ch].age_us);
+        double age_s = (in[ch].age_known == true) ? ((double)in[ch].age_us * 1.0e-6) : 0.0;
+        double cos_lat = cos((double)d->lat);
+
+        any_present = any_present || in[ch].present;
+
+        for (uint8_t g = 0U; g < FCS_SEL_NAV_GROUPS; g++)
+        {
+            s[g][ch] = (sel_sample_t){{0.0, 0.0, 0.0}, {0.0, 0.0, 0.0}, age_s, fault};
+        }
+
+        for (uint8_t i = 0U; i < 3U; i++)
+        {
+            s[FCS_SEL_NAV_ATT][ch].value[i] = (double)d->eul_ang[i];
+            s[FCS_SEL_NAV_ATT][ch].rate[i] = (double)d->omg[i];
+            s[FCS_SEL_NAV_OMG][ch].value[i] = (double)d->omg[i];
+            s[FCS_SEL_NAV_ACC][ch].value[i] = (double)d->acc[i];
+            s[FCS_SEL_NAV_VEL][ch].value[i] = (double)d->v_ned[i];
+        }
+
+        s[FCS_SEL_NAV_POS][ch].value[0] = d->lat;
+        s[FCS_SEL_NAV_POS][ch].value[1] = d->lon;
+        s[FCS_SEL_NAV_POS][ch].value[2] = (double)d->alt_gps_amsl;
+        s[FCS_SEL_NAV_POS][ch].rate[0] = (double)d->v_ned[0] / SEL_EARTH_RADIUS_M;
+        s[FCS_SEL_NAV_POS][ch].rate[1] = (fabs(cos_lat) > 1.0e-6) ? ((double)d->v_ned[1] / (SEL_EARTH_RADIUS_M * cos_lat)) : 0.0;
+        s[FCS_SEL_NAV_POS][ch].rate[2] = -(double)d->v_ned[2];
+
+        s[FCS_SEL_NAV_ACCURACY][ch].value[0] = (double)d->eph;
+        s[FCS_SEL_NAV_ACCURACY][ch].value[1] = (double)d->epv;
+
+        s[FCS_SEL_NAV_ATT][ch].fault |= (d->att_invalid != 0U) ? FCS_SEL_FAULT_SOURCE : 0U;
+        s[FCS_SEL_NAV_OMG][ch].fault |= (d->omg_invalid != 0U) ? FCS_SEL_FAULT_SOURCE : 0U;
+        s[FCS_SEL_NAV_ACC][ch].fault |= (d->acc_invalid != 0U) ? FCS_SEL_FAULT_SOURCE : 0U;
+        s[FCS_SEL_NAV_POS][ch].fault |= (d->pos_invalid != 0U) ? FCS_SEL_FAULT_SOURCE : 0U;
+    }
+
+    for (uint8_t g = 0U; g < FCS_SEL_NAV_GROUPS; g++)
+    {
+        valid[g] = sel_vote(&NAV_CFG[g], &NavState[g], s[g]);
+
+        SelStatus.nav_selected[g] = NavState[g].selected;
+        for (uint8_t ch = 0U; ch < FCS_SEL_CHANNELS; ch++)
+        {
+            SelStatus.nav_fault[ch][g] = s[g][ch].fault;
+        }
+    }
+
+    for (uint8_t i = 0U; i < 3U; i++)
+    {
+        out->eul_ang[i] = (real_T)NavState[FCS_SEL_NAV_ATT].output[i];
+        out->omg[i] = (real_T)NavState[FCS_SEL_NAV_OMG].output[i];
+        out->acc[i] = (real_T)NavState[FCS_SEL_NAV_ACC].output[i];
+        out->v_ned[i] = (real_T)NavState[FCS_SEL_NAV_VEL].output[i];
+    }
+    out->lat = NavState[FCS_SEL_NAV_POS].output[0];
+    out->lon = NavState[FCS_SEL_NAV_POS].output[1];
+    out->alt_gps_amsl = (real_T)NavState[FCS_SEL_NAV_POS].output[2];
+    out->eph = (real_T)NavState[FCS_SEL_NAV_ACCURACY].output[0];
+    out->epv = (real_T)NavState[FCS_SEL_NAV_ACCURACY].output[1];
+
+    out->data_timeout = (any_present == false) ? 1U : 0U;
+    out->att_invalid = (valid[FCS_SEL_NAV_ATT] == false) ? 1U : 0U;
+    out->omg_invalid = (valid[FCS_SEL_NAV_OMG] == false) ? 1U : 0U;
+    out->acc_invalid = (valid[FCS_SEL_NAV_ACC] == false) ? 1U : 0U;
+    out->pos_invalid = (valid[FCS_SEL_NAV_POS] == false) ? 1U : 0U;
+}
+
+/**
+ * @brief Votes the air data channels into one validated input set.
+ *
+ * The air data signals are voted as in fcs_sel_nav, each as its own group.
+ * They are not aligned for latency as no rates are available for them.
+ *
+ * @param[in]  in  Channel inputs of the frame
+ * @param[out] out Selected input set
+ */
+void fcs_sel_ads(const fcs_sel_ads_in_t in[FCS_SEL_CHANNELS], ads_data_t *out)
+{
+    sel_sample_t s[FCS_SEL_ADS_GROUPS][FCS_SEL_CHANNELS];
+    bool valid[FCS_SEL_ADS_GROUPS];
+
+    if ((in == NULL) || (out == NULL))
+    {
+        return;
+    }
+
+    for (uint8_t ch = 0U; ch < FCS_SEL_CHANNELS; ch++)
+    {
+        const ads_data_t *d = &in[ch].data;
+        uint8_t fault = sel_base_fault(in[ch].present, in[ch].age_known, in[ch].age_us);
+
+        for (uint8_t g = 0U; g < FCS_SEL_ADS_GROUPS; g++)
+        {
+            s[g][ch] = (sel_sample_t){{0.0, 0.0, 0.0}, {0.0, 0.0, 0.0}, 0.0, fault};
+        }
+
+        s[FCS_SEL_ADS_AOA][ch].value[0] = (double)d->aoa;
+        s[FCS_SEL_ADS_AOS][ch].value[0] = (double)d->aos;
+        s[FCS_SEL_ADS_CAS][ch].value[0] = (double)d->aspd_cas;
+        s[FCS_SEL_ADS_BARO][ch].value[0] = (double)d->alt_baro_amsl;
+
+        s[FCS_SEL_ADS_AOA][ch].fault |= (d->aoa_invalid != 0U) ? FCS_SEL_FAULT_SOURCE : 0U;
+        s[FCS_SEL_ADS_AOS][ch].fault |= (d->aos_invalid != 0U) ? FCS_SEL_FAULT_SOURCE : 0U;
+        s[FCS_SEL_ADS_CAS][ch].fault |= (d->aspd_cas_invalid != 0U) ? FCS_SEL_FAULT_SOURCE : 0U;
+        s[FCS_SEL_ADS_BARO][ch].fault |= (d->baro_invalid != 0U) ? FCS_SEL_FAULT_SOURCE : 0U;
+    }
+
+    for (uint8_t g = 0U; g < FCS_SEL_ADS_GROUPS; g++)
+    {
+        valid[g] = sel_vote(&ADS_CFG[g], &AdsState[g], s[g]);
+
+        SelStatus.ads_selected[g] = AdsState[g].selected;
+        for (uint8_t ch = 0U; ch < FCS_SEL_CHANNELS; ch++)
+        {
+            SelStatus.ads_fault[ch][g] = s[g][ch].fault;
+        }
+    }
+
+    out->aoa = (real_T)AdsState[FCS_SEL_ADS_AOA].output[0];
+    out->aos = (real_T)AdsState[FCS_SEL_ADS_AOS].output[0];
+    out->aspd_cas = (real_T)AdsState[FCS_SEL_ADS_CAS].output[0];
+    out->alt_baro_amsl = (real_T)AdsState[FCS_SEL_ADS_BARO].output[0];
+
+    out->aoa_invalid = (valid[FCS_SEL_ADS_AOA] == false) ? 1U : 0U;
+    out->aos_invalid = (valid[FCS_SEL_ADS_AOS] == false) ? 1U : 0U;
+    out->aspd_cas_invalid = (valid[FCS_SEL_ADS_CAS] == false) ? 1U : 0U;
+    out->baro_invalid = (valid[FCS_SEL_ADS_BARO] == false) ? 1U : 0U;
+}
+
+/**
+ * @brief Returns the selection state of the latest frame.
+ *
+ * @param[out] status Copy of the selection state
+ */
+void fcs_sel_get_status(fcs_sel_status_t *status)
+{
+    if (status != NULL)
+    {
+        *status = SelStatus;
+    }
+}
+
+/**
+ * @brief Checks that every element of a vector is finite.
+ *
+ * The elements are combined without an early exit so that the check costs
+ * the same whatever the data.
+ */
+static bool sel_all_finite(const double *v, uint8_t n)
+{
+    uint8_t finite = 1U;
+
+    for (uint8_t i = 0U; i < n; i++)
+    {
+        finite &= (isfinite(v[i]) != 0) ? 1U : 0U;
+    }
+
+    return (finite != 0U);
+}
+
+/**
+ * @brief Absolute difference of an element, the short way round for angles.
+ */
+static double sel_difference(const sel_group_cfg_t *cfg, uint8_t i, double a, double b)
+{
+    double d = a - b;
+
+    if ((cfg->wrap_mask & (uint8_t)(1U << i)) != 0U)
+    {
+        d = fmod(d + SEL_PI, SEL_TWO_PI);
+        if (d < 0.0)
+        {
+            d += SEL_TWO_PI;
+        }
+        d -= SEL_PI;
+    }
+
+    return fabs(d);
+}
+
+/**
+ * @brief Largest element difference of two vectors relative to the tolerance.
+ *
+ * @return double 1.0 or less when the vectors agree.
+ */
+static double sel_distance(const sel_group_cfg_t *cfg, const double *a, const double *b)
+{
+    double distance = 0.0;
+
+    for (uint8_t i = 0U; i < cfg->elements; i++)
+    {
+        double d = sel_difference(cfg, i, a[i], b[i]) / cfg->tolerance[i];
+        if (d > distance)
+        {
+            distance = d;
+        }
+    }
+
+    return distance;
+}
+
+/**
+ * @brief Carries a sample forward over its age using its rate.
+ */
+static void sel_align(const sel_group_cfg_t *cfg, const sel_sample_t *s, double *aligned)
+{
+    bool use_rate = sel_all_finite(s->rate, cfg->elements);
+
+    for (uint8_t i = 0U; i < cfg->elements; i++)
+    {
+        aligned[i] = s->value[i] + ((use_rate == true) ? (s->rate[i] * s->age_s) : 0.0);
+    }
+}
+
+/**
+ * @brief Applies the finite value and rate of change monitors to a channel.
+ *
+ * A sample that steps by more than the rate limit is rejected for one frame.
+ * It becomes the reference for the next frame, so a genuine step, such as a
+ * position reset of the source, is accepted one frame late.
+ */
+static void sel_monitor(const sel_group_cfg_t *cfg, sel_group_state_t *state, uint8_t ch, sel_sample_t *s)
+{
+    if ((s->fault & (FCS_SEL_FAULT_ABSENT | FCS_SEL_FAULT_STALE)) != 0U)
+    {
+        /* Do not rate check the first sample after an outage */
+        state->last_valid[ch] = false;
+    }
+    else if (sel_all_finite(s->value, cfg->elements) == false)
+    {
+        s->fault |= FCS_SEL_FAULT_NONFINITE;
+    }
+    else
+    {
+        if (state->last_valid[ch] == true)
+        {
+            bool step = false;
+            for (uint8_t i = 0U; i < cfg->elements; i++)
+            {
+                step = step || (sel_difference(cfg, i, s->value[i], state->last[ch][i]) > cfg->rate_limit[i]);
+            }
+            if (step == true)
+            {
+                s->fault |= FCS_SEL_FAULT_RATE;
+                SelStatus.rate_rejections++;
+            }
+        }
+
+        for (uint8_t i = 0U; i < cfg->elements; i++)
+        {
+            state->last[ch][i] = s->value[i];
+        }
+        state->last_valid[ch] = true;
+    }
+}
+
+/**
+ * @brief Selects the output of a signal group from the channel samples.
+ *
+ * @return true if the output comes from a healthy channel.
+ */
+static bool sel_vote(const sel_group_cfg_t *cfg, sel_group_state_t *state, sel_sample_t s[FCS_SEL_CHANNELS])
+{
+    double aligned[FCS_SEL_CHANNELS][SEL_MAX_ELEMENTS];
+    bool healthy[FCS_SEL_CHANNELS];
+    uint8_t healthy_count = 0U;
+    int8_t choice = FCS_SEL_HELD;
+    bool valid = false;
+
+    for (uint8_t ch = 0U; ch < FCS_SEL_CHANNELS; ch++)
+    {
+        sel_monitor(cfg, state, ch, &s[ch]);
+        sel_align(cfg, &s[ch], aligned[ch]);
+        healthy[ch] = (s[ch].fault == 0U);
+        healthy_count += (healthy[ch] == true) ? 1U : 0U;
+    }
+
+    if (healthy_count > 1U)
+    {
+        bool agree = true;
+
+        /* Consistency monitor over every pair of healthy channels */
+        for (uint8_t a = 0U; a < FCS_SEL_CHANNELS; a++)
+        {
+            for (uint8_t b = a + 1U; b < FCS_SEL_CHANNELS; b++)
+            {
+                if ((healthy[a] == true) && (healthy[b] == true) &&
+                    (sel_distance(cfg, aligned[a], aligned[b]) > 1.0))
+                {
+                    agree = false;
+                }
+            }
+        }
+
+        if (agree == true)
+        {
+            state->miscompare_frames = 0U;
+        }
+        else if (state->miscompare_frames < FCS_SEL_MISCOMPARE_FRAMES)
+        {
+            state->miscompare_frames++;
+            SelStatus.miscompares += (state->miscompare_frames == FCS_SEL_MISCOMPARE_FRAMES) ? 1U : 0U;
+        }
+        else
+        {
+            /* Miscompare already declared */
+        }
+
+        if (state->miscompare_frames >= FCS_SEL_MISCOMPARE_FRAMES)
+        {
+            /* Mid value: the channel nearest the others and the last output */
+            double best = SEL_NO_LIMIT;
+            for (uint8_t a = 0U; a < FCS_SEL_CHANNELS; a++)
+            {
+                if (healthy[a] == true)
+                {
+                    double sum = sel_distance(cfg, aligned[a], state->output);
+                    for (uint8_t b = 0U; b < FCS_SEL_CHANNELS; b++)
+                    {
+                        sum += ((healthy[b] == true) && (b != a)) ? sel_distance(cfg, aligned[a], aligned[b]) : 0.0;
+                    }
+                    if (sum < best)
+                    {
+                        best = sum;
+                        choice = (int8_t)a;
+                    }
+                    s[a].fault |= FCS_SEL_FAULT_MISCOMPARE;
+                }
+            }
+        }
+        else if ((state->selected != FCS_SEL_HELD) && (healthy[state->selected] == true))
+        {
+            /* Keep the current channel while the channels agree */
+            choice = state->selected;
+        }
+        else
+        {
+            /* Otherwise take the healthy channel of highest priority */
+        }
+        valid = true;
+    }
+    else
+    {
+        state->miscompare_frames = 0U;
+    }
+
+    /* Priority order for a single healthy channel, then for one flagged invalid by its source */
+    for (uint8_t ch = 0U; (ch < FCS_SEL_CHANNELS) && (choice == FCS_SEL_HELD); ch++)
+    {
+        if (healthy[ch] == true)
+        {
+            choice = (int8_t)ch;
+            valid = true;
+        }
+    }
+    for (uint8_t ch = 0U; (ch < FCS_SEL_CHANNELS) && (choice == FCS_SEL_HELD); ch++)
+    {
+        if (s[ch].fault == FCS_SEL_FAULT_SOURCE)
+        {
+            choice = (int8_t)ch;
+        }
+    }
+
+    if (choice != FCS_SEL_HELD)
+    {
+        for (uint8_t i = 0U; i < cfg->elements; i++)
+        {
+            state->output[i] = s[choice].value[i];
+        }
+    }
+    else
+    {
+        SelStatus.held_frames++;
+    }
+    state->selected = choice;
+
+    return valid;
+}
+
+/**
+ * @brief Faults that apply to every signal group of a channel.
+ */
+static uint8_t sel_base_fault(bool present, bool age_known, uint32_t age_us)
+{
+    uint8_t fault = 0U;
+
+    if (present == false)
+    {
+        fault = FCS_SEL_FAULT_ABSENT;
+    }
+    else if ((age_known == true) && (age_us > FCS_SEL_MAX_AGE_US))
+    {
+        fault = FCS_SEL_FAULT_STALE;
+    }
+    else
+    {
+        /* Channel usable */
+    }
+
+    return fault;
+}
@@ -0,0 +1,101 @@
+/****************************************************
+ *  fcs_input_sel.h
+ *  Created on: 18-Oct-2025
+ *  Selection of the redundant sensor inputs of the FCS step
+ *  Copyright: LODD (c) 2025
+ ****************************************************/
+
+#ifndef H_FCS_INPUT_SEL
+#define H_FCS_INPUT_SEL
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "controllerMain_types.h"
+
+/* Number of redundant channels of each sensor type, channel 0 has priority */
+#define FCS_SEL_CHANNELS (2U)
+
+/* Samples older than this are not selected */
+#ifndef FCS_SEL_MAX_AGE_US
+#define FCS_SEL_MAX_AGE_US (100000U)
+#endif
+
+/* Consecutive frames of disagreement before the channels are declared to miscompare */
+#ifndef FCS_SEL_MISCOMPARE_FRAMES
+#define FCS_SEL_MISCOMPARE_FRAMES (5U)
+#endif
+
+/* Signal groups of the navigation input, each is voted as a whole */
+typedef enum
+{
+    FCS_SEL_NAV_ATT = 0,   // eul_ang
+    FCS_SEL_NAV_OMG,       // omg
+    FCS_SEL_NAV_ACC,       // acc
+    FCS_SEL_NAV_POS,       // lat, lon, alt_gps_amsl
+    FCS_SEL_NAV_VEL,       // v_ned
+    FCS_SEL_NAV_ACCURACY,  // eph, epv
+    FCS_SEL_NAV_GROUPS
+} fcs_sel_nav_group_t;
+
+/* Signal groups of the air data input */
+typedef enum
+{
+    FCS_SEL_ADS_AOA = 0,   // aoa
+    FCS_SEL_ADS_AOS,       // aos
+    FCS_SEL_ADS_CAS,       // aspd_cas
+    FCS_SEL_ADS_BARO,      // alt_baro_amsl
+    FCS_SEL_ADS_GROUPS
+} fcs_sel_ads_group_t;
+
+/* Fault bits of a signal group of a channel */
+#define FCS_SEL_FAULT_ABSENT      (0x01U)  // channel not fitted or its source timed out
+#define FCS_SEL_FAULT_SOURCE      (0x02U)  // signal flagged invalid by the source
+#define FCS_SEL_FAULT_STALE       (0x04U)  // sample older than FCS_SEL_MAX_AGE_US
+#define FCS_SEL_FAULT_NONFINITE   (0x08U)  // NaN or infinity in the signal
+#define FCS_SEL_FAULT_RATE        (0x10U)  // change since the previous frame above the rate limit
+#define FCS_SEL_FAULT_MISCOMPARE  (0x20U)  // persistent disagreement with the other channels
+
+/* Selected channel of a group when no channel can be used and the last output is held */
+#define FCS_SEL_HELD (-1)
+
+/* One channel of navigation input */
+typedef struct
+{
+    nav_data_t data;   // as decoded, lat and lon in radians
+    bool present;      // channel fitted and its source not timed out
+    bool age_known;    // age_us is valid
+    uint32_t age_us;   // time since the sample arrived
+} fcs_sel_nav_in_t;
+
+/* One channel of air data input */
+typedef struct
+{
+    ads_data_t data;
+    bool present;
+    bool age_known;
+    uint32_t age_us;
+} fcs_sel_ads_in_t;
+
+/* Selection state of the latest frame */
+typedef struct
+{
+    uint8_t nav_fault[FCS_SEL_CHANNELS][FCS_SEL_NAV_GROUPS];  // FCS_SEL_FAULT_ bits
+    int8_t nav_selected[FCS_SEL_NAV_GROUPS];                  // channel used or FCS_SEL_HELD
+    uint8_t ads_fault[FCS_SEL_CHANNELS][FCS_SEL_ADS_GROUPS];
+    int8_t ads_selected[FCS_SEL_ADS_GROUPS];
+    uint32_t rate_rejections;                                 // samples rejected by the rate limits
+    uint32_t miscompares;                                     // miscompares declared
+    uint32_t held_frames;                                     // group outputs held for lack of a usable channel
+} fcs_sel_status_t;
+
+void fcs_sel_init(void);
+
+/* Vote the navigation channels into one validated input set */
+void fcs_sel_nav(const fcs_sel_nav_in_t in[FCS_SEL_CHANNELS], nav_data_t *out);
+
+/* Vote the air data channels into one validated input set */
+void fcs_sel_ads(const fcs_sel_ads_in_t in[FCS_SEL_CHANNELS], ads_data_t *out);
+
+void fcs_sel_get_status(fcs_sel_status_t *status);
+
+#endif /* H_FCS_INPUT_SEL */
@@ -12,10 +12,23 @@
 #include "mavlink_io_types.h"
 #include "mavlink_io_interface.h"
 #include "math.h"
+#include "fcs_profile.h"
+#include "fcs_input_sel.h"
 
 #define DEG2RAD 0.0174532925
 #define RAD2DEG 57.29577951
 
+/* Source selection reported when no channel of the group can be used */
+#define SELECTION_NONE (0xFFU)
+
+/* Sensor channels of the frame, voted into the controller inputs */
+static fcs_sel_nav_in_t NavIn[FCS_SEL_CHANNELS];
+static fcs_sel_ads_in_t AdsIn[FCS_SEL_CHANNELS];
+
+/* Sequence of the last snapshot staged from each source */
+static uint32_t InsSequence;
+static uint32_t AdcSequence;
+
 /**
  * @brief Initializes the Flight Control module.
  *
@@ -28,6 +41,7 @@
 void fcs_mi_init(void)
 {
     controllerMain_initialize();
+    fcs_sel_init();
 }
 
 void fcs_mi_get_fcs_dscr(
@@ -45,15 +59,20 @@ void fcs_mi_get_fcs_dscr(
     uint8_t *loiter_on,
     uint8_t *cog_track_on)
 {
+    fcs_sel_status_t sel_status;
+
+    fcs_sel_get_status(&sel_status);
+
     *vom_status = controllerMain_Y.fcs_state.vom_status;
     *safety_status = controllerMain_Y.fcs_state.safety_state;
     *pic_status = controllerMain_Y.fcs_state.pic_status;
     *in_air_status = controllerMain_Y.fcs_state.inAir_flag;
     *ep_loss = controllerMain_U.failure_flags.ep_data_loss;
     *ip_loss = controllerMain_U.failure_flags.ip_data_loss;
-    *gnss_loss = controllerMain_U.failure_flags.gps_loss; // TODO: get it from the voter of FCS module
-    *ins_selection = 0;                                   // TODO
-    *adc_selection = 0;                                   // TODO
+    *gnss_loss = controllerMain_U.failure_flags.gps_loss;
+    // the attitude group stands for the navigation source and the airspeed group for the air data source
+    *ins_selection = (sel_status.nav_selected[FCS_SEL_NAV_ATT] == FCS_SEL_HELD) ? SELECTION_NONE : (uint8_t)sel_status.nav_selected[FCS_SEL_NAV_ATT];
+    *adc_selection = (sel_status.ads_selected[FCS_SEL_ADS_CAS] == FCS_SEL_HELD) ? SELECTION_NONE : (uint8_t)sel_status.ads_selected[FCS_SEL_ADS_CAS];
     *current_waypoint_idx = controllerMain_Y.wp_req_idx;
     *tecs_on = controllerMain_Y.fcs_state.tecs_mode;
     *loiter_on = controllerMain_Y.fcs_state.loiter_mode;
@@ -154,135 +173,115 @@ int fcs_mi_get_act_cmd(
 
 static void update_fcs_input_ins_1(void)
 {
-    /* get Euler Angles */
-    float eul_ang[3];
-    float omg[3];
-    float acc[3];
-    double lat, lon;
-    float alt;
-    float v_ned[3];
-    float eph, epv;
+    const s_ins_snapshot_t *ins = da_get_ins_il_snapshot();
+    nav_data_t *nav = &NavIn[0].data;
 
-    /* get Euler Angle */
-    da_get_ins_il_euler_angles(&eul_ang[0], &eul_ang[1], &eul_ang[2]);
-    for (int i = 0; i < 3; ++i)
+    /* Restage the INS data only when a new snapshot was published */
+    if (ins->sequence != InsSequence)
     {
-        if (!isnan(eul_ang[i]) && !isinf(eul_ang[i]))
-        {
-            controllerMain_U.sensor_in.ins_1.eul_ang[i] = eul_ang[i];
-        }
-    }
+        InsSequence = ins->sequence;
 
-    /* get Angular Velocity */
-    da_get_ins_il_angular_velocity(&omg[0], &omg[1], &omg[2]);
-    for (int i = 0; i < 3; ++i)
-    {
-        if (!isnan(omg[i]) && !isinf(omg[i]))
+        for (int i = 0; i < 3; ++i)
         {
-            controllerMain_U.sensor_in.ins_1.omg[i] = omg[i];
+            nav->eul_ang[i] = ins->euler_rpy[i];
+            nav->omg[i] = ins->omg_xyz[i];
+            nav->acc[i] = ins->acc_xyz[i];
+            nav->v_ned[i] = ins->vel_ned[i];
         }
+        nav->lat = ins->lat * DEG2RAD;
+        nav->lon = ins->lon * DEG2RAD;
+        nav->alt_gps_amsl = ins->alt_gps;
+        nav->eph = ins->eph;
+        nav->epv = ins->epv;
+
+        /* INS-D attitude, gyro, accelerometer and GNSS validity, values are range and rate checked by the selection */
+        nav->att_invalid = ((ins->valid & INS_SNAP_VALID_ATT) == 0U);
+        nav->omg_invalid = ((ins->valid & INS_SNAP_VALID_OMG) == 0U);
+        nav->acc_invalid = ((ins->valid & INS_SNAP_VALID_ACC) == 0U);
+        nav->pos_invalid = ((ins->valid & INS_SNAP_VALID_POS) == 0U);
+        nav->data_timeout = ((ins->valid & INS_SNAP_VALID_LINK) == 0U);
+        NavIn[0].present = ((ins->valid & INS_SNAP_VALID_LINK) != 0U);
     }
 
-    /* get Accelerometer Data */
-    da_get_ins_il_accelerometer_data(&acc[0], &acc[1], &acc[2]);
-    for (int i = 0; i < 3; ++i)
-    {
-        if (!isnan(acc[i]) && !isinf(acc[i]))
-        {
-            controllerMain_U.sensor_in.ins_1.acc[i] = acc[i];
-        }
-    }
-
-    /* get position data */
-    da_get_ins_il_position(&lat, &lon, &alt);
-
-    if (!isnan(lat) && !isinf(lat))
-    {
-        controllerMain_U.sensor_in.ins_1.lat = lat * DEG2RAD;
-    }
-
-    if (!isnan(lon) && !isinf(lon))
-    {
-        controllerMain_U.sensor_in.ins_1.lon = lon * DEG2RAD;
-    }
-
-    if (!isnan(alt) && !isinf(alt))
-    {
-        controllerMain_U.sensor_in.ins_1.alt_gps_amsl = alt;
-    }
+#ifdef FCS_MI_INS_PREDICTION
+    /* Attitude and position are carried forward from the INS sample time to this step on every step */
+    float eul_ang[3];
+    double lat, lon;
+    float alt;
 
-    /* get Inertial Velocity */
-    da_get_ins_il_inertial_velocity(&v_ned[0], &v_ned[1], &v_ned[2]);
+    da_get_ins_il_predicted_euler_angles(&eul_ang[0], &eul_ang[1], &eul_ang[2]);
     for (int i = 0; i < 3; ++i)
     {
-        if (!isnan(v_ned[i]) && !isinf(v_ned[i]))
-        {
-            controllerMain_U.sensor_in.ins_1.v_ned[i] = v_ned[i];
-        }
-    }
-
-    /* get INS-D timeout data */
-    controllerMain_U.sensor_in.ins_1.data_timeout = da_get_ins_il_timeout();
-
-    /* get INS-D attitude validity */
-    controllerMain_U.sensor_in.ins_1.att_invalid = da_get_ins_il_att_invalid();
-
-    /* get INS-D gyro sensor validity */
-    controllerMain_U.sensor_in.ins_1.omg_invalid = da_get_ins_il_omg_invalid();
-
-    /* get INS-D accelerometer sensor validity */
-    controllerMain_U.sensor_in.ins_1.acc_invalid = da_get_ins_il_accel_invalid();
-
-    /* get estimated horizontal and veritical position error */
-    da_get_ins_il_eph_epv_data(&eph, &epv);
-
-    if (!isnan(eph) && !isinf(eph))
-    {
-        controllerMain_U.sensor_in.ins_1.eph = eph;
-    }
-    if (!isnan(epv) && !isinf(epv))
-    {
-        controllerMain_U.sensor_in.ins_1.epv = epv;
+        nav->eul_ang[i] = eul_ang[i];
     }
-
-    /* get INS-D GNSS validity */
-    controllerMain_U.sensor_in.ins_1.pos_invalid = da_get_ins_il_pos_invalid() || da_get_ins_il_timeout();
-
-    /* TODO: temporary solution until enabling the voter */
-    controllerMain_U.failure_flags.gps_loss = controllerMain_U.sensor_in.ins_1.pos_invalid;
+    da_get_ins_il_predicted_position(&lat, &lon, &alt);
+    nav->lat = lat * DEG2RAD;
+    nav->lon = lon * DEG2RAD;
+    nav->alt_gps_amsl = alt;
+#endif
+
+    /* The sample ages on every step */
+    NavIn[0].age_known = da_get_sample_age_us(DA_SENSOR_INS, &NavIn[0].age_us);
 }
 
 static void update_fcs_input_ins_2(void)
 {
-    // TODO: need to fill in
+    /* No second INS is fitted, the channel stays absent */
+    NavIn[1].present = false;
+    NavIn[1].age_known = false;
 }
 
-// static void update_fcs_input_ads_2(void);
 static void update_fcs_input_ads_1(void)
 {
-    float cas = 0.0;
-    bool valid = da_get_adc_9_cas(&cas);
+    const s_adc_snapshot_t *adc = da_get_adc_9_snapshot();
+    ads_data_t *ads = &AdsIn[0].data;
 
-    if (!isnan(cas) && !isinf(cas))
+    /* Restage the air data only when a new snapshot was published */
+    if (adc->sequence != AdcSequence)
     {
-        controllerMain_U.sensor_in.ads_1.aspd_cas = cas;
+        AdcSequence = adc->sequence;
+
+        ads->aspd_cas = adc->cas;
+        ads->aspd_cas_invalid = ((adc->valid & ADC_SNAP_VALID_CAS) == 0U);
+        ads->aoa = adc->aoa;
+        ads->aoa_invalid = ((adc->valid & ADC_SNAP_VALID_AOA) == 0U);
+        ads->aos = adc->aos;
+        ads->aos_invalid = ((adc->valid & ADC_SNAP_VALID_AOS) == 0U);
+
+        /* The barometric altitude of the air data computer is corrected with its QNH
+           setting, the pressure altitude is referenced to the standard atmosphere */
+        ads->alt_baro_amsl = adc->alt_baro;
+        ads->baro_invalid = ((adc->valid & ADC_SNAP_VALID_BARO) == 0U);
+
+        AdsIn[0].present = ((adc->valid & ADC_SNAP_VALID_LINK) != 0U);
     }
 
-    controllerMain_U.sensor_in.ads_1.aspd_cas_invalid = valid;
+    AdsIn[0].age_known = da_get_sample_age_us(DA_SENSOR_ADC, &AdsIn[0].age_us);
 }
 
 static void update_fcs_input_ads_2(void)
 {
-    // TODO: need to fill in
+    /* No second air data computer is fitted, the channel stays absent */
+    AdsIn[1].present = false;
+    AdsIn[1].age_known = false;
+}
+
+/* Vote the sensor channels into the inputs read by the controller */
+static void update_fcs_input_selection(void)
+{
+    fcs_sel_nav(NavIn, &controllerMain_U.sensor_in.ins_1);
+    fcs_sel_ads(AdsIn, &controllerMain_U.sensor_in.ads_1);
+
+    controllerMain_U.failure_flags.gps_loss = controllerMain_U.sensor_in.ins_1.pos_invalid;
 }
 
 static void update_fcs_input_radalt(void)
 {
-    float alt_radalt;
-    float radalt_snr;
-    if (da_get_radalt_data(&alt_radalt, &radalt_snr))
+    const s_radalt_snapshot_t *radalt = da_get_radalt_snapshot();
+
+    if ((radalt->valid & RADALT_SNAP_VALID_AGL) != 0U)
     {
-        controllerMain_U.sensor_in.h_radar_agl = alt_radalt;
+        controllerMain_U.sensor_in.h_radar_agl = radalt->agl;
     }
 }
 
@@ -414,8 +413,19 @@ static void update_fcs_output_epu(void)
 static void update_fcs_output_pusher(void)
 {
     double duty_cycle = controllerMain_Y.std_ctrl.pusher_pwm_cmd;
+    uint16_t duty_cycle_us = 0U;
 
-    ach_set_pusher_pwm(duty_cycle);
+    /* Round to whole microseconds, the pusher limits the range */
+    if (duty_cycle >= 65535.0)
+    {
+        duty_cycle_us = 65535U;
+    }
+    else if (duty_cycle > 0.0)
+    {
+        duty_cycle_us = (uint16_t)(duty_cycle + 0.5);
+    }
+
+    ach_set_pusher_pwm(duty_cycle_us);
 }
 
 /*
@@ -434,6 +444,8 @@ void fcs_mi_set_gcs_data(mavio_in_t *mavio_in)
  * This function is intended to be called at regular intervals (periodically)
  * to execute the main control step for the MI FCS (Flight Control System).
  * It delegates the periodic processing to the controllerMain_step() function.
+ * With FCS_PROFILE defined the step and its model references are timed,
+ * see fcs_profile.h.
  *
  * @note Ensure that this function is invoked with the required timing constraints
  *       for correct controller operation.
@@ -448,6 +460,8 @@ void fcs_mi_periodic(void)
 
     update_fcs_input_ads_2();
 
+    update_fcs_input_selection();
+
     update_fcs_input_radalt();
 
     update_fcs_input_ep();
@@ -458,7 +472,9 @@ void fcs_mi_periodic(void)
 
     update_fcs_input_wp_list();
 
+    FCS_PROF_BEGIN(FCS_PROF_STEP);
     controllerMain_step();
+    FCS_PROF_END(FCS_PROF_STEP);
 
     update_fcs_output_servos();
 
@@ -0,0 +1,215 @@
+/****************************************************
+ *  fcs_profile.c
+ *  Created on: 18-Oct-2025
+ *  Execution time instrumentation of the FCS step
+ *  Copyright: LODD (c) 2025
+ ****************************************************/
+
+#include "type.h"
+#include "fcs_profile.h"
+#include "soc/timer/d_timer.h"
+#include "generic_util.h"
+
+#define PROF_NS_PER_TICK 640U // free running timer at 1.5625 MHz
+
+// log-linear histogram, 8 bins per power of two of the time in ticks
+#define PROF_SUB_BINS 8U
+#define PROF_BINS 104U // up to 32768 ticks (about 21 ms)
+
+typedef struct
+{
+    uint32_t start;
+    uint32_t count;
+    uint32_t last;
+    uint32_t min;
+    uint32_t max;
+    uint64_t total;
+    uint32_t hist[PROF_BINS];
+} prof_section_t;
+
+static prof_section_t prof_sections[FCS_PROF_COUNT];
+
+/**
+ * @brief Histogram bin of an execution time.
+ *
+ * @param ticks Execution time in timer ticks
+ * @return Bin index
+ */
+static uint32_t prof_bin(uint32_t ticks)
+{
+    uint32_t bin;
+    uint32_t octave;
+
+    if (ticks < PROF_SUB_BINS)
+    {
+        bin = ticks;
+    }
+    else
+    {
+        octave = 31U - (uint32_t)__builtin_clz(ticks);
+        bin = ((octave - 2U) * PROF_SUB_BINS) + ((ticks >> (octave - 3U)) & (PROF_SUB_BINS - 1U));
+    }
+
+    if (bin >= PROF_BINS)
+    {
+        bin = PROF_BINS - 1U;
+    }
+
+    return bin;
+}
+
+/**
+ * @brief Upper edge of a histogram bin.
+ *
+ * @param bin Bin index
+ * @return Execution time in timer ticks
+ */
+static uint32_t prof_bin_limit(uint32_t bin)
+{
+    uint32_t limit;
+    uint32_t shift;
+
+    if (bin < PROF_SUB_BINS)
+    {
+        limit = bin + 1U;
+    }
+    else
+    {
+        shift = (bin / PROF_SUB_BINS) - 1U;
+        limit = ((PROF_SUB_BINS + (bin % PROF_SUB_BINS)) + 1U) << shift;
+    }
+
+    return limit;
+}
+
+/**
+ * @brief Marks the start of an instrumented section.
+ *
+ * @param id Section
+ */
+void fcs_profile_begin(fcs_prof_id_t id)
+{
+    if (id < FCS_PROF_COUNT)
+    {
+        prof_sections[id].start = d_TIMER_ReadValueInTicks();
+    }
+}
+
+/**
+ * @brief Marks the end of an instrumented section and records its time.
+ *
+ * @param id Section
+ */
+void fcs_profile_end(fcs_prof_id_t id)
+{
+    prof_section_t *section;
+    uint32_t ticks;
+
+    if (id < FCS_PROF_COUNT)
+    {
+        section = &prof_sections[id];
+        ticks = d_TIMER_ReadValueInTicks() - section->start;
+
+        if ((section->count == 0U) || (ticks < section->min))
+        {
+            section->min = ticks;
+        }
+        if (ticks > section->max)
+        {
+            section->max = ticks;
+        }
+        section->last = ticks;
+        section->total += ticks;
+        section->count++;
+        section->hist[prof_bin(ticks)]++;
+    }
+}
+
+/**
+ * @brief Clears the statistics of all sections.
+ */
+void fcs_profile_reset(void)
+{
+    (void)util_memset(prof_sections, 0, sizeof(prof_sections));
+}
+
+/**
+ * @brief Gets the execution time statistics of a section.
+ *
+ * @param id Section
+ * @param stats Pointer to storage for the statistics
+ * @return 0 on success, -1 if the parameters are invalid
+ */
+int fcs_profile_get(fcs_prof_id_t id, fcs_prof_stats_t *stats)
+{
+    const prof_section_t *section;
+    int ret = -1;
+
+    if ((id < FCS_PROF_COUNT) && (stats != NULL))
+    {
+        section = &prof_sections[id];
+        stats->count = section->count;
+        stats->last_ns = section->last * PROF_NS_PER_TICK;
+        stats->min_ns = section->min * PROF_NS_PER_TICK;
+        stats->max_ns = section->max * PROF_NS_PER_TICK;
+        stats->mean_ns = (section->count != 0U) ? (uint32_t)((section->total * PROF_NS_PER_TICK) / section->count) : 0U;
+        ret = 0;
+    }
+
+    return ret;
+}
+
+/**
+ * @brief Execution time percentile of a section.
+ *
+ * The result is the upper edge of the histogram bin holding the percentile,
+ * within 1/8 of the value above 8 timer ticks.
+ *
+ * @param id Section
+ * @param permille Fraction of samples, 0 to 1000
+ * @return Execution time in ns, 0 if there are no samples
+ */
+uint32_t fcs_profile_percentile(fcs_prof_id_t id, uint16_t permille)
+{
+    const prof_section_t *section;
+    uint32_t target;
+    uint32_t sum = 0U;
+    uint32_t bin;
+    uint32_t ns = 0U;
+
+    if ((id < FCS_PROF_COUNT) && (prof_sections[id].count != 0U))
+    {
+        section = &prof_sections[id];
+        if (permille > 1000U)
+        {
+            permille = 1000U;
+        }
+        target = (uint32_t)(((uint64_t)section->count * permille + 999U) / 1000U);
+        if (target == 0U)
+        {
+            target = 1U;
+        }
+
+        for (bin = 0U; bin < PROF_BINS; bin++)
+        {
+            sum += section->hist[bin];
+            if (sum >= target)
+            {
+                break;
+            }
+        }
+
+        if (bin >= PROF_BINS)
+        {
+            bin = PROF_BINS - 1U;
+        }
+
+        ns = prof_bin_limit(bin) * PROF_NS_PER_TICK;
+        if (ns > (section->max * PROF_NS_PER_TICK))
+        {
+            ns = section->max * PROF_NS_PER_TICK;
+        }
+    }
+
+    return ns;
+}
@@ -0,0 +1,69 @@
+/****************************************************
+ *  fcs_profile.h
+ *  Created on: 18-Oct-2025
+ *  Execution time instrumentation of the FCS step
+ *  Copyright: LODD (c) 2025
+ ****************************************************/
+
+#ifndef H_FCS_PROFILE
+#define H_FCS_PROFILE
+
+#include <stdint.h>
+
+/* Instrumented sections of the FCS step */
+typedef enum
+{
+    FCS_PROF_STEP = 0,              // controllerMain_step
+    FCS_PROF_STATE_MACHINE,         // system_state_machine
+    FCS_PROF_PATH_PLANNER,          // mc_path_planner
+    FCS_PROF_VEL_CTRL_SWITCHER,     // vel_ctrl_switcher
+    FCS_PROF_ALT_CTRL,              // altCtrl
+    FCS_PROF_VEL_CTRL,              // velCtrl
+    FCS_PROF_TECS_SWITCHER,         // FW_TECS_switcher
+    FCS_PROF_LAT_GUIDANCE,          // FW_latGuidance
+    FCS_PROF_TECS,                  // FW_TECS
+    FCS_PROF_ATT_CTRL_SWITCHER,     // att_ctrl_switcher
+    FCS_PROF_ATT_CTRL,              // attCtrl
+    FCS_PROF_MR_CA,                 // MR_CA
+    FCS_PROF_FW_ATT_CTRL_SWITCHER,  // FW_attCtrl_switcher
+    FCS_PROF_FW_ATT_CTRL,           // FW_attCtrl
+    FCS_PROF_FW_THROTTLE,           // FW_throttle
+    FCS_PROF_FW_CA,                 // FW_CA
+    FCS_PROF_TRANSITION_HANDLER,    // transitionHandler
+    FCS_PROF_COUNT
+} fcs_prof_id_t;
+
+/* Execution time statistics of a section */
+typedef struct
+{
+    uint32_t count;    // number of samples
+    uint32_t last_ns;  // last execution time (ns)
+    uint32_t min_ns;   // minimum execution time (ns)
+    uint32_t max_ns;   // maximum execution time (ns)
+    uint32_t mean_ns;  // mean execution time (ns)
+} fcs_prof_stats_t;
+
+/*
+Hooks placed around the instrumented sections. They compile to nothing
+unless FCS_PROFILE is defined for the build.
+*/
+#ifdef FCS_PROFILE
+#define FCS_PROF_BEGIN(id) fcs_profile_begin(id)
+#define FCS_PROF_END(id) fcs_profile_end(id)
+#else
+#define FCS_PROF_BEGIN(id)
+#define FCS_PROF_END(id)
+#endif
+
+void fcs_profile_begin(fcs_prof_id_t id);
+void fcs_profile_end(fcs_prof_id_t id);
+
+void fcs_profile_reset(void);
+
+// get the statistics of a section, returns 0 on success
+int fcs_profile_get(fcs_prof_id_t id, fcs_prof_stats_t *stats);
+
+// execution time (ns) not exceeded by the given fraction of samples, permille 0 to 1000
+uint32_t fcs_profile_percentile(fcs_prof_id_t id, uint16_t permille);
+
+#endif /*!defined(H_FCS_PROFILE)*/
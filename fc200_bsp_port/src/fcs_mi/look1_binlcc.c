@@ -0,0 +1,123 @@
+/****************************************************
+ *  look1_binlcc.c
+ *  Created on: 18-Oct-2025
+ *  Cached-segment variant of look1_binlc for the FCS
+ *  table lookups. Hand written, not generated code
+ *  Copyright: LODD (c) 2025
+ ****************************************************/
+
+/*
+ * The interval used by the previous lookup is checked first, then its
+ * neighbours, and only then is the binary search of look1_binlc run. Evenly
+ * spaced breakpoints start from a computed index instead of the previous one.
+ * The interval found is always the one look1_binlc finds and the fraction and
+ * interpolation use the same expressions, so the output is bit-identical.
+ */
+
+#include <math.h>
+#include "look1_binlcc.h"
+#include "rtwtypes.h"
+
+void look1_binlcc_init(look1_cache_T *cache, const real_T bp0[], uint32_T
+  maxIndex)
+{
+  real_T spacing;
+  uint32_T idx;
+
+  /* Breakpoints are evenly spaced if every interval matches the first one
+     to within rounding of the breakpoint values, a few units of real_T
+     epsilon of their magnitude. A table taken as evenly spaced only
+     starts from the computed interval, the neighbour checks and the binary
+     search still find the interval look1_binlc finds. */
+  spacing = bp0[1U] - bp0[0U];
+  cache->evenlySpaced = (spacing > 0.0);
+  for (idx = 1U; (idx < maxIndex) && cache->evenlySpaced; idx++) {
+    cache->evenlySpaced = (fabs((bp0[idx + 1U] - bp0[idx]) - spacing) <=
+      ((4.0 * RT_EPS) * (fabs(bp0[idx + 1U]) + fabs(bp0[0U]))));
+  }
+
+  cache->bpInvSpacing = cache->evenlySpaced ? (1.0 / spacing) : 0.0;
+  cache->prevIndex = 0U;
+}
+
+real_T look1_binlcc(real_T u0, const real_T bp0[], const real_T table[],
+                    look1_cache_T *cache, uint32_T maxIndex)
+{
+  real_T frac;
+  real_T yL_0d0;
+  uint32_T bpIdx;
+  uint32_T iLeft;
+  uint32_T iRght;
+  boolean_T found;
+
+  /* Column-major Lookup 1-D
+     Search method: 'cached segment, binary fallback'
+     Interpolation method: 'Linear point-slope'
+     Extrapolation method: 'Clip'
+     Use last breakpoint for index at or above upper limit: 'off'
+   */
+  if (u0 <= bp0[0U]) {
+    iLeft = 0U;
+    frac = 0.0;
+  } else if (u0 < bp0[maxIndex]) {
+    /* Starting interval */
+    if (cache->evenlySpaced) {
+      iLeft = (uint32_T)((u0 - bp0[0U]) * cache->bpInvSpacing);
+    } else {
+      iLeft = cache->prevIndex;
+    }
+
+    if (iLeft > (maxIndex - 1U)) {
+      iLeft = maxIndex - 1U;
+    }
+
+    /* Check the starting interval and its neighbours */
+    found = true;
+    if (u0 < bp0[iLeft]) {
+      if ((iLeft > 0U) && (u0 >= bp0[iLeft - 1U])) {
+        iLeft--;
+      } else {
+        found = false;
+      }
+    } else if (u0 >= bp0[iLeft + 1U]) {
+      if (((iLeft + 2U) <= maxIndex) && (u0 < bp0[iLeft + 2U])) {
+        iLeft++;
+      } else {
+        found = false;
+      }
+    } else {
+      /* u0 is in the starting interval */
+    }
+
+    if (!found) {
+      /* Binary Search */
+      bpIdx = (maxIndex >> ((uint32_T)1U));
+      iLeft = 0U;
+      iRght = maxIndex;
+      while ((iRght - iLeft) > ((uint32_T)1U)) {
+        if (u0 < bp0[bpIdx]) {
+          iRght = bpIdx;
+        } else {
+          iLeft = bpIdx;
+        }
+
+        bpIdx = ((iRght + iLeft) >> ((uint32_T)1U));
+      }
+    }
+
+    frac = (u0 - bp0[iLeft]) / (bp0[iLeft + 1U] - bp0[iLeft]);
+  } else {
+    iLeft = maxIndex - 1U;
+    frac = 1.0;
+  }
+
+  cache->prevIndex = iLeft;
+
+  /* Column-major Interpolation 1-D
+     Interpolation method: 'Linear point-slope'
+     Use last breakpoint for index at or above upper limit: 'off'
+     Overflow mode: 'wrapping'
+   */
+  yL_0d0 = table[iLeft];
+  return ((table[iLeft + 1U] - yL_0d0) * frac) + yL_0d0;
+}
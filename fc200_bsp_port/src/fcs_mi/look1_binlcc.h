@@ -0,0 +1,25 @@
+/****************************************************
+ *  look1_binlcc.h
+ *  Created on: 18-Oct-2025
+ *  Cached-segment variant of look1_binlc for the FCS
+ *  table lookups. Hand written, not generated code
+ *  Copyright: LODD (c) 2025
+ ****************************************************/
+
+#ifndef look1_binlcc_h_
+#define look1_binlcc_h_
+#include "rtwtypes.h"
+
+/* Per call site lookup state, set up once by look1_binlcc_init */
+typedef struct {
+  real_T bpInvSpacing;                 /* 1 / breakpoint spacing, evenly spaced tables */
+  uint32_T prevIndex;                  /* Interval found by the previous lookup */
+  boolean_T evenlySpaced;              /* Breakpoints are evenly spaced */
+} look1_cache_T;
+
+extern void look1_binlcc_init(look1_cache_T *cache, const real_T bp0[], uint32_T
+  maxIndex);
+extern real_T look1_binlcc(real_T u0, const real_T bp0[], const real_T table[],
+  look1_cache_T *cache, uint32_T maxIndex);
+
+#endif                                 /* look1_binlcc_h_ */
@@ -0,0 +1,141 @@
+/****************************************************
+ *  fdr_interface.h
+ *  Created on: 18-Oct-2025
+ *  Implementation of the Interface fdr_interface
+ *  Copyright: LODD (c) 2025
+ ****************************************************/
+
+#ifndef H_FDR_INTERFACE
+#define H_FDR_INTERFACE
+
+#include "type.h"
+#include "types_epu.h"
+
+#define FDR_NUM_SERVOS 13U  // servo_id 1 (AILERON_L) to 13 (STEERING)
+#define FDR_NUM_MOTORS 8U   // lifter motors commanded by the FCS
+#define FDR_NUM_ACS 12U     // control surfaces commanded by the FCS
+
+/* Validity flags of the sources of a record */
+#define FDR_VALID_INS_ATT (1U << 0)
+#define FDR_VALID_INS_OMG (1U << 1)
+#define FDR_VALID_INS_ACC (1U << 2)
+#define FDR_VALID_INS_POS (1U << 3)
+#define FDR_VALID_INS_VEL (1U << 4)
+#define FDR_VALID_ADC_CAS (1U << 5)
+#define FDR_VALID_ADC_AOA (1U << 6)
+#define FDR_VALID_ADC_AOS (1U << 7)
+#define FDR_VALID_ADC_OAT (1U << 8)
+#define FDR_VALID_ADC_ALT (1U << 9)
+#define FDR_VALID_RADALT (1U << 10)
+#define FDR_VALID_SBUS (1U << 11)
+#define FDR_VALID_FCS_CMD (1U << 12)
+
+/*
+Record captured on every call of fdr_periodic. The layout is stored on
+disk, so any change to it must increment FDR_VERSION. Fields are ordered
+so that the record has no padding and its size is a multiple of 8.
+*/
+typedef struct
+{
+    uint32_t time_ms;     // system time (ms)
+    uint16_t valid;       // FDR_VALID_* flags
+    uint16_t adc_status;  // ADC status word
+
+    // INS
+    double ins_lat;         // deg
+    double ins_lon;         // deg
+    float ins_alt_gps;      // m
+    float ins_euler_rpy[3]; // rad
+    float ins_omg_xyz[3];   // rad/s
+    float ins_acc_xyz[3];   // m/s/s
+    float ins_vel_ned[3];   // m/s
+
+    // ADC
+    float adc_cas; // m/s
+    float adc_aoa; // deg
+    float adc_aos; // deg
+    float adc_oat; // degC
+    float adc_alt; // m
+
+    // radar altimeter
+    float radalt_agl; // m
+    float radalt_snr; // dB
+
+    // SBUS
+    float rc_axis[8]; // roll, pitch, yaw, throttle, slider r/l, knob r/l [-1, 1]
+
+    // ESC telemetry
+    int32_t esc_rpm[NUM_ESCS];
+    float esc_voltage[NUM_ESCS];     // V
+    float esc_current[NUM_ESCS];     // A
+    float esc_temperature[NUM_ESCS]; // degC
+
+    // servo telemetry
+    float servo_pos_deg[FDR_NUM_SERVOS];
+
+    // FCS outputs
+    float fcs_motor_cmd[FDR_NUM_MOTORS];
+    float fcs_servo_cmd[FDR_NUM_ACS]; // deg
+    float fcs_pusher_cmd;
+
+    uint8_t rc_sw[6];  // SBUS switch a to f positions
+    uint8_t rc_flags;  // SBUS bit 0 link lost, bit 1 data timeout
+    uint8_t rc_rssi;   // SBUS RSSI (%)
+    uint8_t esc_valid; // bit per ESC
+    uint8_t fcs_vom_status;
+    uint8_t fcs_safety_status;
+    uint8_t fcs_pic_status;
+    uint8_t fcs_in_air_status;
+    uint8_t spare[3];
+} fdr_record_t;
+
+/*
+Header at the start of every chunk. The CRC covers the records of the
+chunk followed by the header up to the crc field, so a chunk torn by a
+power loss is rejected by a reader.
+*/
+typedef struct
+{
+    uint32_t magic;         // FDR_MAGIC
+    uint16_t version;       // FDR_VERSION
+    uint16_t record_size;   // sizeof(fdr_record_t)
+    uint32_t segment;       // recording segment, one per file, increasing
+    uint32_t sequence;      // chunk number within the segment
+    uint32_t record_count;  // records in the chunk
+    uint32_t first_time_ms; // time of the first record
+    uint32_t dropped;       // records dropped since the recorder started
+    uint32_t crc;           // CRC-32
+} fdr_chunk_header_t;
+
+#define FDR_MAGIC 0x31524446U // "FDR1"
+#define FDR_VERSION 1U
+
+typedef enum
+{
+    FDR_STATE_DISABLED = 0, // no storage or initialisation failed
+    FDR_STATE_RECORDING,
+    FDR_STATE_STOPPED       // write error, recording abandoned
+} e_fdr_state_t;
+
+typedef struct
+{
+    e_fdr_state_t state;
+    uint32_t segment;        // current segment
+    uint32_t records;        // records captured
+    uint32_t dropped;        // records dropped with both buffers busy
+    uint32_t chunks_written; // chunks completed by the drive
+    uint32_t write_errors;   // chunks failed by the drive
+    uint32_t busy_retries;   // submissions deferred with the drive queue full
+} fdr_stats_t;
+
+void fdr_init(void);
+
+// captures a record, call once per loop
+void fdr_periodic(void);
+
+// background job: submits full chunks to the drive, returns true if more work remains
+bool fdr_background(void);
+
+void fdr_get_stats(fdr_stats_t *stats);
+
+#endif /*!defined(H_FDR_INTERFACE)*/
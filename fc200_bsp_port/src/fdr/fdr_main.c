@@ -0,0 +1,526 @@
+/****************************************************
+ *  fdr_main.c
+ *  Created on: 18-Oct-2025
+ *  Implementation of the Class fdr_main
+ *  Copyright: LODD (c) 2025
+ ****************************************************/
+
+/*
+On-board flight data recorder.
+
+Records are captured at the loop rate into one of two chunk buffers. A
+full buffer is closed with its header and CRC and written by the
+background job as a single queued SATA request, while the other buffer
+fills. The files are created and allocated contiguously at
+initialisation, so recording needs no file system access: chunks are
+written straight to the sectors of the current file and the recorder
+moves to the file holding the oldest segment when one is full.
+*/
+
+#include <stddef.h>
+#include "fdr_main.h"
+#include "da_interface.h"
+#include "ach_interface.h"
+#include "fcs_mi_interface.h"
+#include "timer_interface.h"
+#include "generic_util.h"
+#include "kernel/crc32/d_crc32.h"
+#include "kernel/fat_fs/d_ff.h"
+#include "soc/sata/d_sata.h"
+
+#define FDR_SECTOR_SIZE 512U
+#define FDR_CHUNK_SIZE (64U * 1024U) // bytes written per request
+#define FDR_CHUNK_SECTORS (FDR_CHUNK_SIZE / FDR_SECTOR_SIZE)
+#define FDR_FILE_SIZE (64UL * 1024UL * 1024UL)
+#define FDR_FILE_CHUNKS (FDR_FILE_SIZE / FDR_CHUNK_SIZE)
+#define FDR_MAX_FILES 16U // files in rotation, FDR00.BIN to FDR15.BIN
+#define FDR_NUM_BUFFERS 2U
+#define FDR_RECORDS_PER_CHUNK ((FDR_CHUNK_SIZE - sizeof(fdr_chunk_header_t)) / sizeof(fdr_record_t))
+#define FDR_LINKMAP_SIZE 4U // link map of a file in a single fragment
+
+typedef enum
+{
+    FDR_BUF_FREE = 0, // available for filling
+    FDR_BUF_FILLING,  // records being added
+    FDR_BUF_READY,    // closed, waiting for submission
+    FDR_BUF_WRITING   // write request outstanding
+} e_fdr_buf_state_t;
+
+typedef struct
+{
+    volatile e_fdr_buf_state_t state;
+    uint32_t count; // records in the chunk
+    uint32_t crc;   // running CRC of the records
+    uint32_t lba;   // destination sector, set when closed
+} fdr_buffer_t;
+
+static uint8_t fdr_chunk[FDR_NUM_BUFFERS][FDR_CHUNK_SIZE] __attribute__((aligned(64)));
+static fdr_buffer_t fdr_buffers[FDR_NUM_BUFFERS];
+static uint32_t fdr_fill_idx;   // buffer being filled
+static uint32_t fdr_submit_idx; // next buffer to submit
+
+static uint32_t fdr_file_lba[FDR_MAX_FILES];     // first sector of each file
+static uint32_t fdr_file_segment[FDR_MAX_FILES]; // segment held by each file
+static bool fdr_file_used[FDR_MAX_FILES];        // file holds a segment
+static uint32_t fdr_file_idx;                    // file of the current segment
+static uint32_t fdr_sequence;                    // next chunk of the current segment
+
+static d_FAT_Fs_t fdr_fs;
+static fdr_stats_t fdr_stats;
+
+static void fdr_file_name(uint32_t slot, char *name);
+static bool fdr_prepare_file(uint32_t slot);
+static uint32_t fdr_next_segment(void);
+static void fdr_start_segment(uint32_t segment);
+static void fdr_capture(fdr_record_t *record);
+static void fdr_buffer_close(fdr_buffer_t *buf, uint8_t *data);
+static void fdr_write_done(const Uint32_t tag, const d_Status_t status, void *const pContext);
+
+/**
+ * @brief Initialises the recorder.
+ *
+ * Mounts the drive and allocates the files of the rotation. This may take
+ * some time on the first start with a new drive, so it is done before
+ * the loop starts. The recorder stays disabled if any step fails.
+ */
+void fdr_init(void)
+{
+    uint32_t slot;
+    bool ok = true;
+
+    (void)util_memset(&fdr_stats, 0, sizeof(fdr_stats));
+    (void)util_memset(fdr_buffers, 0, sizeof(fdr_buffers));
+    fdr_stats.state = FDR_STATE_DISABLED;
+    fdr_fill_idx = 0U;
+    fdr_submit_idx = 0U;
+    fdr_sequence = 0U;
+    (void)util_memset(fdr_file_used, 0, sizeof(fdr_file_used));
+
+    if (d_FAT_Mount(&fdr_fs, "0:", 1U) != d_FAT_OK)
+    {
+        ok = false;
+    }
+
+    for (slot = 0U; (ok == true) && (slot < FDR_MAX_FILES); slot++)
+    {
+        ok = fdr_prepare_file(slot);
+    }
+
+    if (ok == true)
+    {
+        fdr_start_segment(fdr_next_segment());
+        fdr_stats.state = FDR_STATE_RECORDING;
+    }
+}
+
+/**
+ * @brief Captures a record into the chunk being filled.
+ *
+ * When both buffers are waiting for the drive the record is dropped and
+ * counted, so the cost per call stays bounded whatever the drive does.
+ */
+void fdr_periodic(void)
+{
+    fdr_buffer_t *buf;
+    uint8_t *data;
+    fdr_record_t record;
+
+    if (fdr_stats.state != FDR_STATE_RECORDING)
+    {
+        return;
+    }
+
+    buf = &fdr_buffers[fdr_fill_idx];
+    data = fdr_chunk[fdr_fill_idx];
+
+    if (buf->state == FDR_BUF_FREE)
+    {
+        buf->state = FDR_BUF_FILLING;
+        buf->count = 0U;
+        buf->crc = 0xFFFFFFFFU;
+    }
+
+    if (buf->state != FDR_BUF_FILLING)
+    {
+        fdr_stats.dropped++;
+        return;
+    }
+
+    fdr_capture(&record);
+
+    if (buf->count == 0U)
+    {
+        ((fdr_chunk_header_t *)data)->first_time_ms = record.time_ms;
+    }
+
+    data += sizeof(fdr_chunk_header_t) + (buf->count * sizeof(fdr_record_t));
+    (void)util_memcpy(data, &record, sizeof(record));
+    d_CRC32_Add(&buf->crc, data, sizeof(record));
+    buf->count++;
+    fdr_stats.records++;
+
+    if (buf->count >= FDR_RECORDS_PER_CHUNK)
+    {
+        fdr_buffer_close(buf, fdr_chunk[fdr_fill_idx]);
+        fdr_fill_idx = (fdr_fill_idx + 1U) % FDR_NUM_BUFFERS;
+    }
+}
+
+/**
+ * @brief Background job submitting closed chunks to the drive.
+ *
+ * Each call submits at most one chunk, which is a short operation as the
+ * transfer is made by the drive. A submission refused because the drive
+ * queue is full is retried on the next call.
+ *
+ * @return true if another chunk is waiting
+ */
+bool fdr_background(void)
+{
+    fdr_buffer_t *buf;
+    d_Status_t status;
+    bool more = false;
+
+    if (fdr_stats.state == FDR_STATE_RECORDING)
+    {
+        buf = &fdr_buffers[fdr_submit_idx];
+        if (buf->state == FDR_BUF_READY)
+        {
+            buf->state = FDR_BUF_WRITING;
+            status = d_SATA_WriteAsync(buf->lba, fdr_chunk[fdr_submit_idx], FDR_CHUNK_SIZE,
+                                       fdr_write_done, buf, NULL);
+            if (status == d_STATUS_SUCCESS)
+            {
+                fdr_submit_idx = (fdr_submit_idx + 1U) % FDR_NUM_BUFFERS;
+                more = (fdr_buffers[fdr_submit_idx].state == FDR_BUF_READY);
+            }
+            else if ((status == d_STATUS_BUFFER_FULL) || (status == d_STATUS_DEVICE_BUSY))
+            {
+                buf->state = FDR_BUF_READY;
+                fdr_stats.busy_retries++;
+            }
+            else
+            {
+                fdr_stats.write_errors++;
+                fdr_stats.state = FDR_STATE_STOPPED;
+            }
+        }
+    }
+
+    return more;
+}
+
+/**
+ * @brief Gets the recorder statistics.
+ *
+ * @param stats Pointer to storage for the statistics
+ */
+void fdr_get_stats(fdr_stats_t *stats)
+{
+    if (stats != NULL)
+    {
+        *stats = fdr_stats;
+    }
+}
+
+/**
+ * @brief Name of a file of the rotation, "0:FDRnn.BIN".
+ *
+ * @param slot File number
+ * @param name Storage for the name, at least 12 characters
+ */
+static void fdr_file_name(uint32_t slot, char *name)
+{
+    (void)util_memcpy(name, "0:FDR00.BIN", 12U);
+    name[5] = (char)('0' + ((slot / 10U) % 10U));
+    name[6] = (char)('0' + (slot % 10U));
+}
+
+/**
+ * @brief Makes sure a file of the rotation exists in a single fragment.
+ *
+ * A file of the right size in one fragment, from an earlier start, is
+ * kept. Otherwise the file is recreated with its clusters allocated
+ * contiguously, which leaves the sectors unwritten.
+ *
+ * @param slot File number
+ * @return true if the file is ready for recording
+ */
+static bool fdr_prepare_file(uint32_t slot)
+{
+    d_FAT_File_t file;
+    char name[12];
+    Uint32_t linkmap[FDR_LINKMAP_SIZE];
+    bool ok = false;
+
+    fdr_file_name(slot, name);
+
+    if (d_FAT_Open(&file, name, FA_READ | FA_WRITE | FA_OPEN_ALWAYS) == d_FAT_OK)
+    {
+        if (file.obj.objsize == FDR_FILE_SIZE)
+        {
+            linkmap[0] = FDR_LINKMAP_SIZE;
+            file.cltbl = linkmap;
+            ok = (d_FAT_LSeek(&file, d_FAT_CREATE_LINKMAP) == d_FAT_OK);
+            file.cltbl = NULL;
+        }
+        (void)d_FAT_Close(&file);
+    }
+
+    if ((ok == false) && (d_FAT_Open(&file, name, FA_WRITE | FA_CREATE_ALWAYS) == d_FAT_OK))
+    {
+        ok = (d_FAT_Expand(&file, FDR_FILE_SIZE, 1U) == d_FAT_OK);
+        if (d_FAT_Close(&file) != d_FAT_OK)
+        {
+            ok = false;
+        }
+    }
+
+    if (ok == true)
+    {
+        fdr_file_lba[slot] = fdr_fs.database + ((file.obj.sclust - 2U) * fdr_fs.csize);
+    }
+
+    return ok;
+}
+
+/**
+ * @brief First segment of this start.
+ *
+ * The first chunk of every file is read to find the segment it holds
+ * and the last segment recorded. The new segment skips one number: with
+ * two chunks in flight at a power loss, a segment whose first chunk was
+ * lost may still have its second chunk on the drive, and reusing its
+ * number would let a reader join that chunk to the new recording.
+ *
+ * @return Segment number
+ */
+static uint32_t fdr_next_segment(void)
+{
+    const fdr_chunk_header_t *header = (const fdr_chunk_header_t *)fdr_chunk[0];
+    uint32_t slot;
+    uint32_t last = 0U;
+    bool found = false;
+
+    for (slot = 0U; slot < FDR_MAX_FILES; slot++)
+    {
+        if ((d_SATA_Read(fdr_file_lba[slot], fdr_chunk[0], FDR_SECTOR_SIZE) == d_STATUS_SUCCESS) &&
+            (header->magic == FDR_MAGIC))
+        {
+            fdr_file_segment[slot] = header->segment;
+            fdr_file_used[slot] = true;
+            if ((found == false) || (header->segment > last))
+            {
+                last = header->segment;
+                found = true;
+            }
+        }
+    }
+
+    return (found == true) ? (last + 2U) : 0U;
+}
+
+/**
+ * @brief Starts a segment in the file holding the oldest recording.
+ *
+ * A file never written is taken first, otherwise the file with the
+ * lowest segment number is overwritten.
+ *
+ * @param segment Segment number
+ */
+static void fdr_start_segment(uint32_t segment)
+{
+    uint32_t slot;
+    uint32_t oldest = 0U;
+
+    for (slot = 0U; slot < FDR_MAX_FILES; slot++)
+    {
+        if (fdr_file_used[slot] == false)
+        {
+            oldest = slot;
+            break;
+        }
+        if (fdr_file_segment[slot] < fdr_file_segment[oldest])
+        {
+            oldest = slot;
+        }
+    }
+
+    fdr_file_idx = oldest;
+    fdr_file_segment[oldest] = segment;
+    fdr_file_used[oldest] = true;
+    fdr_stats.segment = segment;
+    fdr_sequence = 0U;
+}
+
+/**
+ * @brief Assembles a record from the sensor, actuator and FCS data.
+ *
+ * @param record Record to fill
+ */
+static void fdr_capture(fdr_record_t *record)
+{
+    rc_input_t rc_input;
+    s_esc_status_frame_t esc;
+    uint16_t valid = 0U;
+    uint8_t unused_u8;
+    uint16_t unused_u16;
+    uint32_t i;
+
+    (void)util_memset(record, 0, sizeof(*record));
+    (void)util_memset(&rc_input, 0, sizeof(rc_input));
+    record->time_ms = (uint32_t)timer_get_system_time_ms();
+
+    const s_ins_snapshot_t *ins = da_get_ins_il_snapshot();
+    const s_adc_snapshot_t *adc = da_get_adc_9_snapshot();
+    const s_radalt_snapshot_t *radalt = da_get_radalt_snapshot();
+    bool ins_link = ((ins->valid & INS_SNAP_VALID_LINK) != 0U);
+
+    for (i = 0U; i < 3U; i++)
+    {
+        record->ins_euler_rpy[i] = ins->euler_rpy[i];
+        record->ins_omg_xyz[i] = ins->omg_xyz[i];
+        record->ins_acc_xyz[i] = ins->acc_xyz[i];
+        record->ins_vel_ned[i] = ins->vel_ned[i];
+    }
+    record->ins_lat = ins->lat;
+    record->ins_lon = ins->lon;
+    record->ins_alt_gps = ins->alt_gps;
+    valid |= ((ins->valid & INS_SNAP_VALID_ATT) != 0U) ? FDR_VALID_INS_ATT : 0U;
+    valid |= (((ins->valid & INS_SNAP_VALID_OMG) != 0U) && ins_link) ? FDR_VALID_INS_OMG : 0U;
+    valid |= (((ins->valid & INS_SNAP_VALID_ACC) != 0U) && ins_link) ? FDR_VALID_INS_ACC : 0U;
+    valid |= (((ins->valid & INS_SNAP_VALID_POS) != 0U) && ins_link) ? FDR_VALID_INS_POS : 0U;
+    valid |= ins_link ? FDR_VALID_INS_VEL : 0U;
+
+    record->adc_cas = adc->cas;
+    record->adc_aoa = adc->aoa;
+    record->adc_aos = adc->aos;
+    record->adc_oat = adc->oat;
+    record->adc_alt = adc->alt;
+    record->adc_status = adc->status;
+    valid |= ((adc->valid & ADC_SNAP_VALID_CAS) != 0U) ? FDR_VALID_ADC_CAS : 0U;
+    valid |= ((adc->valid & ADC_SNAP_VALID_AOA) != 0U) ? FDR_VALID_ADC_AOA : 0U;
+    valid |= ((adc->valid & ADC_SNAP_VALID_AOS) != 0U) ? FDR_VALID_ADC_AOS : 0U;
+    valid |= ((adc->valid & ADC_SNAP_VALID_OAT) != 0U) ? FDR_VALID_ADC_OAT : 0U;
+    valid |= ((adc->valid & ADC_SNAP_VALID_ALT) != 0U) ? FDR_VALID_ADC_ALT : 0U;
+
+    if ((radalt->valid & RADALT_SNAP_VALID_AGL) != 0U)
+    {
+        record->radalt_agl = radalt->agl;
+        record->radalt_snr = radalt->snr;
+        valid |= FDR_VALID_RADALT;
+    }
+
+    if (da_get_ep_data(&rc_input))
+    {
+        valid |= FDR_VALID_SBUS;
+    }
+    record->rc_axis[0] = rc_input.axis_r;
+    record->rc_axis[1] = rc_input.axis_p;
+    record->rc_axis[2] = rc_input.axis_y;
+    record->rc_axis[3] = rc_input.axis_t;
+    record->rc_axis[4] = rc_input.slider_r;
+    record->rc_axis[5] = rc_input.slider_l;
+    record->rc_axis[6] = rc_input.knob_r;
+    record->rc_axis[7] = rc_input.knob_l;
+    record->rc_sw[0] = (uint8_t)rc_input.sw_a;
+    record->rc_sw[1] = (uint8_t)rc_input.sw_b;
+    record->rc_sw[2] = (uint8_t)rc_input.sw_c;
+    record->rc_sw[3] = (uint8_t)rc_input.sw_d;
+    record->rc_sw[4] = (uint8_t)rc_input.sw_e;
+    record->rc_sw[5] = (uint8_t)rc_input.sw_f;
+    record->rc_flags = (rc_input.link_lost ? 1U : 0U) | (rc_input.data_timeout ? 2U : 0U);
+    record->rc_rssi = (uint8_t)rc_input.rssi;
+
+    for (i = 0U; i < NUM_ESCS; i++)
+    {
+        /* Motor ID starts from 1 (ESC_1) to 8 (ESC_8) */
+        (void)util_memset(&esc, 0, sizeof(esc));
+        if (ach_get_epu_status((uint8_t)(i + 1U), &esc))
+        {
+            record->esc_valid |= (uint8_t)(1U << i);
+        }
+        record->esc_rpm[i] = esc.rpm;
+        record->esc_voltage[i] = esc.voltage_f16;
+        record->esc_current[i] = esc.current_f16;
+        record->esc_temperature[i] = esc.temperature_f16;
+    }
+
+    for (i = 0U; i < FDR_NUM_SERVOS; i++)
+    {
+        /* Servo starts from servo_id = 1 (AILERON_L) to 13 (STEERING) */
+        record->servo_pos_deg[i] = ach_get_servo_pos_deg((e_servo_positions_t)(i + 1U));
+    }
+
+    if (fcs_mi_get_act_cmd(record->fcs_motor_cmd, record->fcs_servo_cmd, &record->fcs_pusher_cmd,
+                           FDR_NUM_MOTORS, FDR_NUM_ACS) == 0)
+    {
+        valid |= FDR_VALID_FCS_CMD;
+    }
+    fcs_mi_get_fcs_dscr(&record->fcs_vom_status, &record->fcs_safety_status, &record->fcs_pic_status,
+                        &record->fcs_in_air_status, &unused_u8, &unused_u8, &unused_u8, &unused_u8,
+                        &unused_u8, &unused_u16, &unused_u8, &unused_u8, &unused_u8);
+
+    record->valid = valid;
+}
+
+/**
+ * @brief Closes a full chunk and assigns its place on the drive.
+ *
+ * The segment moves to the file holding the oldest recording when the
+ * current file is full.
+ *
+ * @param buf  Buffer to close
+ * @param data Chunk data of the buffer
+ */
+static void fdr_buffer_close(fdr_buffer_t *buf, uint8_t *data)
+{
+    fdr_chunk_header_t *header = (fdr_chunk_header_t *)data;
+    uint32_t crc;
+
+    if (fdr_sequence >= FDR_FILE_CHUNKS)
+    {
+        fdr_start_segment(fdr_stats.segment + 1U);
+    }
+
+    header->magic = FDR_MAGIC;
+    header->version = FDR_VERSION;
+    header->record_size = (uint16_t)sizeof(fdr_record_t);
+    header->segment = fdr_stats.segment;
+    header->sequence = fdr_sequence;
+    header->record_count = buf->count;
+    header->dropped = fdr_stats.dropped;
+
+    crc = buf->crc;
+    d_CRC32_Add(&crc, data, offsetof(fdr_chunk_header_t, crc));
+    header->crc = ~crc;
+
+    buf->lba = fdr_file_lba[fdr_file_idx] + (fdr_sequence * FDR_CHUNK_SECTORS);
+    fdr_sequence++;
+    buf->state = FDR_BUF_READY;
+}
+
+/**
+ * @brief Completion callback of a chunk write, releases the buffer.
+ *
+ * @param tag      Request tag
+ * @param status   Completion status
+ * @param pContext Buffer written
+ */
+static void fdr_write_done(const Uint32_t tag, const d_Status_t status, void *const pContext)
+{
+    fdr_buffer_t *buf = (fdr_buffer_t *)pContext;
+
+    UNUSED_PARAMETER(tag);
+
+    if (status == d_STATUS_SUCCESS)
+    {
+        fdr_stats.chunks_written++;
+    }
+    else
+    {
+        fdr_stats.write_errors++;
+    }
+
+    buf->state = FDR_BUF_FREE;
+}
@@ -0,0 +1,13 @@
+/****************************************************
+ *  fdr_main.h
+ *  Created on: 18-Oct-2025
+ *  Implementation of the Class fdr_main
+ *  Copyright: LODD (c) 2025
+ ****************************************************/
+
+#ifndef H_FDR_MAIN
+#define H_FDR_MAIN
+
+#include "fdr_interface.h"
+
+#endif /*!defined(H_FDR_MAIN)*/
@@ -7,8 +7,7 @@
 #include "udp_interface.h"
 #include "mavlink_io.h"
 #include "fcs_mi_interface.h"
-
-#define ONE_MSEC (1000000UL)
+#include "fdr_interface.h"
 
 
 Int32_t main()
@@ -34,8 +33,11 @@ Int32_t main()
     /* Initialise Flight Control System */
     fcs_mi_init();
 
-    /* Set tick period to 1000 timer units (1 ms)*/
-	sys_set_tick_period(ONE_MSEC);
+    /* Initialise the Flight Data Recorder */
+    fdr_init();
+
+    /* Set tick period of the main loop, SYS_FRAME_HZ */
+	sys_set_tick_period(SYS_TICK_PERIOD);
 
     /* Initialize default MAVLINK IO */
     mav_io_init();
@@ -57,9 +59,15 @@ Int32_t main()
         /* Issue commands to the actuators periodically */
         ach_cmd_periodic();
 
+        /* Write the PWM outputs set this frame together */
+        (void)pwm_commit();
+
         /* Run Periodic Actuator Control Hub read */
         ach_read_periodic();
 
+        /* Capture the flight data record */
+        fdr_periodic();
+
         /* tx the outbound mavlink message */
         mavlink_io_send_periodic();
 
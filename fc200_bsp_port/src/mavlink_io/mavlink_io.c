@@ -17,6 +17,7 @@
 #include "da_interface.h"
 #include "ach_interface.h"
 #include "gpio_interface.h"
+#include "can_interface.h"
 #include "mavlink_io/serdes/serdes_ss_log.h"
 
 #ifndef OPS_GIT_HASH_BYTES
@@ -41,6 +42,7 @@
 #define RATE_EPU_DATA (LOOP_RATE / 2U)
 #define RATE_BATT_DATA (LOOP_RATE / 2U)
 #define RATE_ECBU_DATA (LOOP_RATE / 2U)
+#define RATE_CAN_DATA (LOOP_RATE / 1U)
 #define MSG_RX_BUF_LEN (10 * MAVLINK_MAX_PACKET_LEN)
 
 #define SLOT1 (0U)
@@ -53,6 +55,7 @@
 #define SLOT8 (7U)
 #define SLOT9 (8U)
 #define SLOT10 (9U)
+#define SLOT11 (10U)
 
 #define MAX_GIT_SHORT_HASH_LEN (8)
 
@@ -106,6 +109,7 @@ static void send_gcs_tr_data(const mavio_in_t *mavio_in);
 // static void send_gcs_adc_9_data(const mavio_in_t *mavio_in);
 static void send_gcs_act_kst_data(const mavio_in_t *mavio_in);
 static void send_gcs_epu_tmotor_data(const mavio_in_t *mavio_in);
+static void send_gcs_can_data(void);
 // static void send_gcs_batt_data(const mavio_in_t *mavio_in);
 // static void send_gcs_ecbu_data(const mavio_in_t *mavio_in);
 static void send_gcs_wp_info(mavio_in_t *mavio_in, mavio_out_t *mavio_out);
@@ -116,6 +120,8 @@ static void check_gcs_comm_timer_expiry(void);
 
 // gather data from various sources and put them in MavioIn to be sent to GCS
 static void mav_io_gather_data(mavio_in_t *mavio_in);
+static void mav_io_gather_ins(mavio_in_t *mavio_in);
+static void mav_io_gather_adc(mavio_in_t *mavio_in);
 
 // Mission handling
 void mavio_mission_init(mavio_wp_list_t *wp_list);
@@ -309,14 +315,15 @@ void send_log_data(void)
     SerdesLog.ins1_gnss_h_acc = (uint16_t)(MavioIn.ins_data[0].gnss_h_accuracy * 100.0f);
     SerdesLog.ins1_gnss_v_acc = (uint16_t)(MavioIn.ins_data[0].gnss_v_accuracy * 100.0f);
     SerdesLog.ins1_gnss_sol_type = MavioIn.ins_data[0].gnss_sol_type;
-    uint8_t ins_sol_status;
-    da_get_ins_il_ins_sol_status(&ins_sol_status);
-    SerdesLog.ins1_ins_sol_status = ins_sol_status;
-    uint8_t gnss_info1, gnss_info2;
-    da_get_ins_il_gnss_info(&gnss_info1, &gnss_info2);
-    SerdesLog.ins1_gnss_info1 = gnss_info1;
-    SerdesLog.ins1_gnss_info2 = gnss_info2;
-    da_get_ins_il_kf_cov(SerdesLog.ins1_kf_pos_cov_lla, SerdesLog.ins1_kf_vel_cov_ned);
+    const s_ins_snapshot_t *ins = da_get_ins_il_snapshot();
+    SerdesLog.ins1_ins_sol_status = ins->ins_sol_status;
+    SerdesLog.ins1_gnss_info1 = ins->gnss_info1;
+    SerdesLog.ins1_gnss_info2 = ins->gnss_info2;
+    for (int i = 0; i < 3; i++)
+    {
+        SerdesLog.ins1_kf_pos_cov_lla[i] = ins->kf_pos_cov_lla[i];
+        SerdesLog.ins1_kf_vel_cov_ned[i] = ins->kf_vel_cov_ned[i];
+    }
     SerdesLog.ins1_flags = 0;
     SerdesLog.ins1_flags |= MavioIn.ins_data[0].data_timeout;
     SerdesLog.ins1_flags |= (MavioIn.ins_data[0].ins_healthy << 1);
@@ -400,103 +407,55 @@ GCS
 *************************************************************
 *************************************************************/
 
-static void mav_io_gather_data(mavio_in_t *mavio_in)
+/*
+ Copy the INS snapshot into the telemetry data when a new one was published
+*/
+static void mav_io_gather_ins(mavio_in_t *mavio_in)
 {
-    /* Update FCS data */
-    float eul_ang[3];
-    float omg[3];
-    float acc[3];
-    double lat, lon;
-    float alt;
-    float v_ned[3];
-    float eph, epv;
+    static uint32_t ins_sequence = 0U;
+    const s_ins_snapshot_t *ins = da_get_ins_il_snapshot();
+    bool timeout = ((ins->valid & INS_SNAP_VALID_LINK) == 0U);
     uint8_t gnss_sat_used = 0;
 
-    fcs_mi_get_fcs_dscr(
-        &mavio_in->vom_status,
-        &mavio_in->safety_status,
-        &mavio_in->pic_status,
-        &mavio_in->in_air_status,
-        &mavio_in->ep_data_loss,
-        &mavio_in->ip_data_loss,
-        &mavio_in->gnss_loss,
-        &mavio_in->ins_selection,
-        &mavio_in->adc_selection,
-        &mavio_in->current_waypoint_idx,
-        &mavio_in->tecs_on,
-        &mavio_in->loiter_on,
-        &mavio_in->cog_track_on);
-
-    fcs_mi_get_fcs_cont(
-        mavio_in->euler_rpy,
-        mavio_in->omg_xyz,
-        mavio_in->acc_xyz,
-        &mavio_in->latitude,
-        &mavio_in->longitude,
-        &mavio_in->alt_gps_amsl,
-        mavio_in->vel_ned,
-        &mavio_in->aspd_cas,
-        &mavio_in->alt_radalt_filt);
-
-    fcs_mi_get_fbctrl(&mavio_in->fbctrl_data);
-
-    fcs_mi_get_act_cmd(
-        mavio_in->motor_cmd,   // Motor commands in RPM (PoC) or normalized [0,1] (SS)
-        mavio_in->servo_cmd,   // Servo commands in degrees
-        &mavio_in->pusher_cmd, // Pusher command in RPM, PWM (SS)
-        MAVIO_NUM_MOTORS,
-        MAVIO_NUM_SERVOS);
-
-    /* Update EP data */
-    da_get_ep_data(&mavio_in->rc_input);
-
-    /* Update Radalt data */
-    da_get_radalt_data(&mavio_in->radalt_agl, &mavio_in->radalt_snr);
-    mavio_in->radalt_timeout = da_get_radalt_timeout();
-
-    /* Update INSD data */
-    da_get_ins_il_euler_angles(&eul_ang[0], &eul_ang[1], &eul_ang[2]);
-    da_get_ins_il_angular_velocity(&omg[0], &omg[1], &omg[2]);
-    da_get_ins_il_accelerometer_data(&acc[0], &acc[1], &acc[2]);
-    da_get_ins_il_inertial_velocity(&v_ned[0], &v_ned[1], &v_ned[2]);
-    da_get_ins_il_position(&lat, &lon, &alt);
-    da_get_ins_il_eph_epv_data(&eph, &epv);
-
-    da_get_ins_il_kf_cov(mavio_in->ins_data[0].kf_pos_cov_lla, mavio_in->ins_data[0].kf_vel_cov_ned);
+    if (ins->sequence == ins_sequence)
+    {
+        return;
+    }
+    ins_sequence = ins->sequence;
 
     for (int i = 0; i < 3; i++)
     {
-        mavio_in->ins_data[0].euler_rpy[i] = eul_ang[i];
-        mavio_in->ins_data[0].omg[i] = omg[i];
-        mavio_in->ins_data[0].acc[i] = acc[i];
-        mavio_in->ins_data[0].vel_ned[i] = v_ned[i];
+        mavio_in->ins_data[0].euler_rpy[i] = ins->euler_rpy[i];
+        mavio_in->ins_data[0].omg[i] = ins->omg_xyz[i];
+        mavio_in->ins_data[0].acc[i] = ins->acc_xyz[i];
+        mavio_in->ins_data[0].vel_ned[i] = ins->vel_ned[i];
+        mavio_in->ins_data[0].kf_pos_cov_lla[i] = ins->kf_pos_cov_lla[i];
+        mavio_in->ins_data[0].kf_vel_cov_ned[i] = ins->kf_vel_cov_ned[i];
     }
 
-    mavio_in->ins_data[0].latitude = (int32_t)(lat * POS_LAT_LONG_SCALING);
-    mavio_in->ins_data[0].longitude = (int32_t)(lon * POS_LAT_LONG_SCALING);
-    mavio_in->ins_data[0].alt_amsl = alt;
+    mavio_in->ins_data[0].latitude = (int32_t)(ins->lat * POS_LAT_LONG_SCALING);
+    mavio_in->ins_data[0].longitude = (int32_t)(ins->lon * POS_LAT_LONG_SCALING);
+    mavio_in->ins_data[0].alt_amsl = ins->alt_gps;
 
-    mavio_in->ins_data[0].att_invalid = (da_get_ins_il_att_invalid() ? 1 : 0);
-    mavio_in->ins_data[0].pos_invalid = (da_get_ins_il_pos_invalid() ? 1 : 0);
-    mavio_in->ins_data[0].data_timeout = (da_get_ins_il_timeout() ? 1 : 0);
+    mavio_in->ins_data[0].att_invalid = (((ins->valid & INS_SNAP_VALID_ATT) == 0U) ? 1 : 0);
+    mavio_in->ins_data[0].pos_invalid = (((ins->valid & INS_SNAP_VALID_POS) == 0U) ? 1 : 0);
+    mavio_in->ins_data[0].data_timeout = (timeout ? 1 : 0);
 
     /* Get the GNSS Sat Used only if the timeout is not set on INS */
-    if (da_get_ins_il_timeout() != true)
+    if (timeout != true)
     {
-        da_get_ins_il_gnss_sat_used(&gnss_sat_used);
+        gnss_sat_used = ins->gnss_sat_used;
     }
 
     mavio_in->ins_data[0].gnss_sat_used = gnss_sat_used;
 
-    uint8_t pos_type, sol_status;
-    da_get_ins_il_gnss_sol_status(&pos_type, &sol_status);
-    if ((sol_status > 0) || (gnss_sat_used < 4))
+    if ((ins->gnss_sol_status > 0) || (gnss_sat_used < 4))
     {
         mavio_in->ins_data[0].gnss_sol_type = GPS_FIX_TYPE_NO_FIX;
     }
     else
     {
-        switch (pos_type)
+        switch (ins->gnss_pos_type)
         {
         case 0: // Single point solution
             mavio_in->ins_data[0].gnss_sol_type = GPS_FIX_TYPE_3D_FIX;
@@ -519,22 +478,21 @@ static void mav_io_gather_data(mavio_in_t *mavio_in)
         }
     }
 
-    da_get_ins_il_gnss_dop(&mavio_in->ins_data[0].gnss_hdop);
-
-    mavio_in->ins_data[0].gnss_h_accuracy = eph;
-    mavio_in->ins_data[0].gnss_v_accuracy = epv;
-    da_get_ins_il_temperature(&mavio_in->ins_data[0].temp);
+    mavio_in->ins_data[0].gnss_hdop = ins->pdop;
+    mavio_in->ins_data[0].gnss_h_accuracy = ins->eph;
+    mavio_in->ins_data[0].gnss_v_accuracy = ins->epv;
+    mavio_in->ins_data[0].temp = ins->temperature;
 
     for (int i = 0; i < 3; i++)
     {
-        mavio_in->ins_data[1].euler_rpy[i] = eul_ang[i];
-        mavio_in->ins_data[1].omg[i] = omg[i];
-        mavio_in->ins_data[1].acc[i] = acc[i];
-        mavio_in->ins_data[1].vel_ned[i] = v_ned[i];
+        mavio_in->ins_data[1].euler_rpy[i] = ins->euler_rpy[i];
+        mavio_in->ins_data[1].omg[i] = ins->omg_xyz[i];
+        mavio_in->ins_data[1].acc[i] = ins->acc_xyz[i];
+        mavio_in->ins_data[1].vel_ned[i] = ins->vel_ned[i];
     }
-    mavio_in->ins_data[1].latitude = (int32_t)(lat * POS_LAT_LONG_SCALING);
-    mavio_in->ins_data[1].longitude = (int32_t)(lon * POS_LAT_LONG_SCALING);
-    mavio_in->ins_data[1].alt_amsl = alt;
+    mavio_in->ins_data[1].latitude = mavio_in->ins_data[0].latitude;
+    mavio_in->ins_data[1].longitude = mavio_in->ins_data[0].longitude;
+    mavio_in->ins_data[1].alt_amsl = ins->alt_gps;
 
     mavio_in->ins_data[1].att_invalid = 1;
     mavio_in->ins_data[1].pos_invalid = 1;
@@ -543,25 +501,86 @@ static void mav_io_gather_data(mavio_in_t *mavio_in)
     mavio_in->ins_data[1].gnss_sat_used = 0;
     mavio_in->ins_data[1].gnss_h_accuracy = 0;
     mavio_in->ins_data[1].gnss_v_accuracy = 0;
+}
 
-    /* Update ADS-9 data*/
-    float tmp;
-    bool valid = da_get_adc_9_cas(&tmp);
-    mavio_in->adc_data[0].aspd_cas = tmp;
-    mavio_in->adc_data[0].aspd_cas_invalid = !valid;
-    mavio_in->adc_data[0].data_timeout = (da_get_adc_9_timeout() ? 1 : 0);
+/*
+ Copy the air data snapshot into the telemetry data when a new one was published
+*/
+static void mav_io_gather_adc(mavio_in_t *mavio_in)
+{
+    static uint32_t adc_sequence = 0U;
+    const s_adc_snapshot_t *adc = da_get_adc_9_snapshot();
+
+    if (adc->sequence == adc_sequence)
+    {
+        return;
+    }
+    adc_sequence = adc->sequence;
+
+    mavio_in->adc_data[0].aspd_cas = adc->cas;
+    mavio_in->adc_data[0].aspd_cas_invalid = ((adc->valid & ADC_SNAP_VALID_CAS) == 0U);
+    mavio_in->adc_data[0].data_timeout = (((adc->valid & ADC_SNAP_VALID_LINK) == 0U) ? 1 : 0);
+    mavio_in->adc_data[0].oat_celsius = adc->oat;
+    mavio_in->adc_data[0].alt_baro_amsl = adc->alt_baro;
+    mavio_in->adc_data[0].aoa = adc->aoa;
+    mavio_in->adc_data[0].aos = adc->aos;
+}
+
+static void mav_io_gather_data(mavio_in_t *mavio_in)
+{
+    /* Update FCS data */
+    fcs_mi_get_fcs_dscr(
+        &mavio_in->vom_status,
+        &mavio_in->safety_status,
+        &mavio_in->pic_status,
+        &mavio_in->in_air_status,
+        &mavio_in->ep_data_loss,
+        &mavio_in->ip_data_loss,
+        &mavio_in->gnss_loss,
+        &mavio_in->ins_selection,
+        &mavio_in->adc_selection,
+        &mavio_in->current_waypoint_idx,
+        &mavio_in->tecs_on,
+        &mavio_in->loiter_on,
+        &mavio_in->cog_track_on);
 
-    da_get_adc_9_oat(&tmp);
-    mavio_in->adc_data[0].oat_celsius = tmp;
+    fcs_mi_get_fcs_cont(
+        mavio_in->euler_rpy,
+        mavio_in->omg_xyz,
+        mavio_in->acc_xyz,
+        &mavio_in->latitude,
+        &mavio_in->longitude,
+        &mavio_in->alt_gps_amsl,
+        mavio_in->vel_ned,
+        &mavio_in->aspd_cas,
+        &mavio_in->alt_radalt_filt);
 
-    da_get_adc_9_alt(&tmp);
-    mavio_in->adc_data[0].alt_baro_amsl = tmp;
+    fcs_mi_get_fbctrl(&mavio_in->fbctrl_data);
 
-    da_get_adc_9_aoa(&tmp);
-    mavio_in->adc_data[0].aoa = tmp;
+    fcs_mi_get_act_cmd(
+        mavio_in->motor_cmd,   // Motor commands in RPM (PoC) or normalized [0,1] (SS)
+        mavio_in->servo_cmd,   // Servo commands in degrees
+        &mavio_in->pusher_cmd, // Pusher command in RPM, PWM (SS)
+        MAVIO_NUM_MOTORS,
+        MAVIO_NUM_SERVOS);
+
+    /* Update EP data */
+    da_get_ep_data(&mavio_in->rc_input);
 
-    da_get_adc_9_aos(&tmp);
-    mavio_in->adc_data[0].aos = tmp;
+    /* Update Radalt data */
+    const s_radalt_snapshot_t *radalt = da_get_radalt_snapshot();
+    if ((radalt->valid & RADALT_SNAP_VALID_AGL) != 0U)
+    {
+        mavio_in->radalt_agl = radalt->agl;
+        mavio_in->radalt_snr = radalt->snr;
+    }
+    mavio_in->radalt_timeout = ((radalt->valid & RADALT_SNAP_VALID_LINK) == 0U);
+
+    /* Update INSD data */
+    mav_io_gather_ins(mavio_in);
+
+    /* Update ADS-9 data*/
+    mav_io_gather_adc(mavio_in);
 
     /* Update Second ADC data*/
     mavio_in->adc_data[1].aspd_cas = 0;
@@ -656,6 +675,11 @@ static void send_mavlink_msg_gcs(void)
         send_gcs_epu_tmotor_data(&MavioIn);
     }
 
+    if ((counter + SLOT11) % (RATE_CAN_DATA) == 0)
+    {
+        send_gcs_can_data();
+    }
+
     //    }
     //    if (counter % (RATE_BATT_DATA) == 0)
     //    {
@@ -865,11 +889,9 @@ static void send_gcs_ins_il_data(const mavio_in_t *mavio_in)
     ins_il.gnss_n_sat = mavio_in->ins_data[0].gnss_sat_used;
     ins_il.gnss_fix_type = mavio_in->ins_data[0].gnss_sol_type;
     ins_il.temp = (int8_t)(mavio_in->ins_data[0].temp);
-    da_get_ins_il_alt_baro(&ins_il.alt_baro);
+    ins_il.alt_baro = da_get_ins_il_snapshot()->alt_baro;
     ins_il.gnss_pdop = (uint8_t)(mavio_in->ins_data[0].gnss_hdop * 10.0f);
-    uint8_t ins_sol_status;
-    da_get_ins_il_ins_sol_status(&ins_sol_status);
-    ins_il.ins_sol_status = ins_sol_status;
+    ins_il.ins_sol_status = da_get_ins_il_snapshot()->ins_sol_status;
     ins_il.validity = mavio_in->ins_data[0].data_timeout ? LDE_INS_TIMEOUT : 0;
 
     mavlink_msg_ldm_ins_il_encode(MavioSystem.sys_id, MavioSystem.comp_id,
@@ -946,6 +968,56 @@ static void send_gcs_epu_tmotor_data(const mavio_in_t *mavio_in)
     send_msg_over_gcs_link(&send_msg);
 }
 
+/*
+ * CAN bus accounting of each open channel as DEBUG_VECT messages, the name
+ * giving the channel number:
+ *   CANn_BUS  utilisation %, peak utilisation %, frames per second
+ *   CANn_TXW  estimated transmit queue wait last, mean and max in us
+ *   CANn_ERR  TEC, REC, error flags (CAN_ERR_FLAG_x, 0x40 error passive, 0x80 bus off)
+ *   CANn_ETR  TEC change, REC change over the last window, bus off count
+ */
+static void send_gcs_can_data(void)
+{
+    char name[MAVLINK_MSG_DEBUG_VECT_FIELD_NAME_LEN];
+    uint64_t time_usec = timer_get_system_time_ms() * 1000U;
+    can_bus_stats_t stats;
+
+    for (uint8_t ch = 0; ch < (uint8_t)CAN_CHANNEL_MAX; ch++)
+    {
+        if (can_get_bus_stats((can_channel_t)ch, &stats) == CAN_OK)
+        {
+            uint8_t flags = stats.error_flags;
+            flags |= stats.error_passive ? 0x40U : 0U;
+            flags |= stats.bus_off ? 0x80U : 0U;
+
+            util_memset(name, 0, sizeof(name));
+            util_memcpy(name, "CAN1_BUS", 8U);
+            name[3] = (char)('1' + ch);
+            mavlink_msg_debug_vect_pack(MavioSystem.sys_id, MavioSystem.comp_id, &send_msg, name, time_usec,
+                                        stats.utilisation_pct, stats.utilisation_peak_pct,
+                                        (float)stats.frame_rate_hz);
+            send_msg_over_gcs_link(&send_msg);
+
+            util_memcpy(&name[5], "TXW", 3U);
+            mavlink_msg_debug_vect_pack(MavioSystem.sys_id, MavioSystem.comp_id, &send_msg, name, time_usec,
+                                        (float)stats.tx_wait_last_us, (float)stats.tx_wait_mean_us,
+                                        (float)stats.tx_wait_max_us);
+            send_msg_over_gcs_link(&send_msg);
+
+            util_memcpy(&name[5], "ERR", 3U);
+            mavlink_msg_debug_vect_pack(MavioSystem.sys_id, MavioSystem.comp_id, &send_msg, name, time_usec,
+                                        (float)stats.tec, (float)stats.rec, (float)flags);
+            send_msg_over_gcs_link(&send_msg);
+
+            util_memcpy(&name[5], "ETR", 3U);
+            mavlink_msg_debug_vect_pack(MavioSystem.sys_id, MavioSystem.comp_id, &send_msg, name, time_usec,
+                                        (float)stats.tec_trend, (float)stats.rec_trend,
+                                        (float)stats.bus_off_count);
+            send_msg_over_gcs_link(&send_msg);
+        }
+    }
+}
+
 // static void send_gcs_batt_data(const mavio_in_t *mavio_in)
 // {
 //     /* TODO: need to define new mavlink message*/
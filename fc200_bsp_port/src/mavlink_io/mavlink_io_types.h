@@ -149,11 +149,11 @@ typedef struct
 
     /* dual INS data */
     mavio_ins_data_t ins_data[2];
-    uint8_t ins_selection; // 0: INS1, 1: INS2
+    uint8_t ins_selection; // 0: INS1, 1: INS2, 0xFF: none usable
 
     /* dual ADC data */
     mavio_adc_data_t adc_data[2];
-    uint8_t adc_selection; // 0: ADC1, 1: ADC2
+    uint8_t adc_selection; // 0: ADC1, 1: ADC2, 0xFF: none usable
 
     /* radalt data */
     float radalt_agl; // in meters
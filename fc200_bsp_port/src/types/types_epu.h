@@ -59,6 +59,19 @@ typedef struct
 
 } s_esc_status_frame_t;
 
+/**
+ * @brief ESC status transfer reassembly counters of a node
+ */
+typedef struct
+{
+    uint32_t frames;       // frames received from the node
+    uint32_t transfers;    // transfers completed and decoded
+    uint32_t crc_errors;   // completed transfers failing the CRC
+    uint32_t out_of_order; // frames with an unexpected start or toggle bit
+    uint32_t timeouts;     // transfers not completed in time
+    uint32_t dropped;      // transfers dropped for length or lack of a free slot
+} s_esc_rx_stats_t;
+
 /**
  * @brief Electric Motor Data Structure
  */
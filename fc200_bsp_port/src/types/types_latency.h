@@ -0,0 +1,47 @@
+#ifndef H_TYPES_LATENCY
+#define H_TYPES_LATENCY
+
+#include "type.h"
+
+/* Number of bins of a latency histogram, the last bin holds every longer latency */
+#define LATENCY_HIST_BINS (12U)
+
+/* Width of a latency histogram bin */
+#define LATENCY_HIST_BIN_US (1000U)
+
+/**
+ * @brief   Sensors whose samples are timestamped on arrival
+ */
+typedef enum
+{
+    DA_SENSOR_INS = 0,
+    DA_SENSOR_ADC,
+    DA_SENSOR_RADALT,
+    DA_SENSOR_SBUS,
+    DA_SENSOR_MAX
+} da_sensor_t;
+
+/**
+ * @brief   Arrival time of a decoded sample
+ */
+typedef struct
+{
+    uint32_t arrival_tick; //!< Timer tick at which the first byte of the frame was received  [640 ns]
+    uint32_t decode_us;    //!< Time from arrival of the first byte to decode                  [us]
+    uint32_t sequence;     //!< Samples decoded                                                [ ]
+    bool     valid;        //!< Set when the arrival time of the sample is known               [ ]
+} s_sample_time_t;
+
+/**
+ * @brief   Histogram of the time from arrival of a sample to its decode
+ */
+typedef struct
+{
+    uint32_t bins[LATENCY_HIST_BINS]; //!< Samples per LATENCY_HIST_BIN_US of latency         [ ]
+    uint32_t samples;                 //!< Samples recorded                                   [ ]
+    uint32_t untimed;                 //!< Samples decoded without a known arrival time       [ ]
+    uint32_t max_us;                  //!< Largest latency recorded                           [us]
+    uint32_t last_us;                 //!< Latency of the latest sample                       [us]
+} s_latency_hist_t;
+
+#endif /* H_TYPES_LATENCY */
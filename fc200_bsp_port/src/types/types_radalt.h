@@ -3,6 +3,7 @@
 
 
 #include "type.h"
+#include "types_latency.h"
 
 /**
  * @brief Radalt Data Abstraction Structure
@@ -19,6 +20,7 @@ typedef struct radalt_s
     float    vD;       //!< Measured vertical velocity               [m/s]
     float    snr;      //!< Signal to Noise Ratio                    [dB]
     float    offset;   //!< Antenna Distance to Ground               [m]
+    s_sample_time_t sample_time; //!< Arrival time of the frame the data was decoded from
 } radalt_s;
 
 /**
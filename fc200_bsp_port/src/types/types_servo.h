@@ -87,4 +87,34 @@ typedef struct
     float servo_cmd_deg[MAX_CNTRL_SURFACE]; //!< Commanded degrees for each servo [deg]
 } std_servo_cmd_t;
 
+/**
+ * @brief Round-trip latency of the feedback polls of a servo
+ */
+typedef struct
+{
+    uint32_t polls;    //!< Position and status polls sent
+    uint32_t replies;  //!< Replies received within the slot window
+    uint32_t timeouts; //!< Polls with no reply within the slot window
+    uint32_t last_us;  //!< Last round-trip time                [us]
+    uint32_t min_us;   //!< Minimum round-trip time             [us]
+    uint32_t max_us;   //!< Maximum round-trip time             [us]
+    uint32_t mean_us;  //!< Mean round-trip time                [us]
+} servo_latency_t;
+
+/**
+ * @brief Slot allocation statistics of the servo bus scheduler
+ */
+typedef struct
+{
+    uint32_t frames;              //!< Frames planned
+    uint32_t budget_bytes;        //!< Bus budget of a frame             [bytes]
+    uint32_t max_frame_bytes;     //!< Largest bus load planned in a frame [bytes]
+    uint32_t commands_sent;       //!< Position commands sent
+    uint32_t commands_suppressed; //!< Commands unchanged within the deadband
+    uint32_t commands_deferred;   //!< Changed commands left for a later frame
+    uint32_t position_polls;      //!< Position poll slots planned
+    uint32_t status_polls;        //!< Status poll slots planned
+    uint32_t overruns;            //!< Frames whose poll slots had not finished by the next frame
+} servo_bus_stats_t;
+
 #endif // TYPES_SERVO_H
\ No newline at end of file
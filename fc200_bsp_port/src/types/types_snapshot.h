@@ -0,0 +1,95 @@
+#ifndef H_TYPES_SNAPSHOT
+#define H_TYPES_SNAPSHOT
+
+#include "type.h"
+#include "types_latency.h"
+
+/*
+ * Each data acquisition source publishes its latest data as one snapshot
+ * after the frames of the cycle are decoded. A snapshot is rebuilt only
+ * when a frame is decoded or the link state changes, and its sequence is
+ * then incremented, so a consumer holding the sequence of its last read
+ * can skip the work when nothing is new. Snapshots are published and read
+ * in the main loop and do not change until the next da_periodic().
+ */
+
+/* Validity bits of the INS snapshot, set when the signal can be used */
+#define INS_SNAP_VALID_ATT  (0x0001U) //!< Attitude solution valid
+#define INS_SNAP_VALID_OMG  (0x0002U) //!< Gyros healthy
+#define INS_SNAP_VALID_ACC  (0x0004U) //!< Accelerometers healthy
+#define INS_SNAP_VALID_POS  (0x0008U) //!< Position solution valid
+#define INS_SNAP_VALID_LINK (0x0010U) //!< Frames received within the timeout
+
+/* Validity bits of the air data snapshot */
+#define ADC_SNAP_VALID_CAS  (0x0001U) //!< Calibrated airspeed valid
+#define ADC_SNAP_VALID_AOA  (0x0002U) //!< Angle of attack valid
+#define ADC_SNAP_VALID_AOS  (0x0004U) //!< Angle of sideslip valid
+#define ADC_SNAP_VALID_OAT  (0x0008U) //!< Static air temperature valid
+#define ADC_SNAP_VALID_ALT  (0x0010U) //!< Pressure altitude valid
+#define ADC_SNAP_VALID_LINK (0x0020U) //!< Frames received within the timeout
+#define ADC_SNAP_VALID_BARO (0x0040U) //!< Barometric altitude valid
+
+/* Validity bits of the radar altimeter snapshot */
+#define RADALT_SNAP_VALID_AGL  (0x0001U) //!< Height above ground valid
+#define RADALT_SNAP_VALID_LINK (0x0002U) //!< Frames received within the timeout
+
+/**
+ * @brief   INS data published per decoded frame
+ */
+typedef struct
+{
+    uint32_t sequence;            //!< Incremented on each publication, 0 before the first     [ ]
+    uint32_t valid;               //!< INS_SNAP_VALID_ bits                                    [ ]
+    s_sample_time_t sample_time;  //!< Arrival time of the frame                               [ ]
+    double   lat;                 //!< Latitude                                                [deg]
+    double   lon;                 //!< Longitude                                               [deg]
+    float    alt_gps;             //!< GNSS altitude above mean sea level                      [m]
+    float    euler_rpy[3];        //!< Roll, pitch and heading                                 [rad]
+    float    omg_xyz[3];          //!< Body angular rates                                      [rad/s]
+    float    acc_xyz[3];          //!< Body accelerations                                      [m/s^2]
+    float    vel_ned[3];          //!< Inertial velocity                                       [m/s]
+    float    eph;                 //!< Horizontal position error                               [m]
+    float    epv;                 //!< Vertical position error                                 [m]
+    float    pdop;                //!< Position dilution of precision                          [ ]
+    float    alt_baro;            //!< Barometric altitude                                     [m]
+    float    temperature;         //!< Unit temperature                                        [degC]
+    uint8_t  gnss_sat_used;       //!< Satellites used in the solution                         [ ]
+    uint8_t  gnss_pos_type;       //!< GNSS position type of GNSS info 1                       [ ]
+    uint8_t  gnss_sol_status;     //!< GNSS solution status of GNSS info 2                     [ ]
+    uint8_t  gnss_info1;          //!< GNSS info 1 as received                                 [ ]
+    uint8_t  gnss_info2;          //!< GNSS info 2 as received                                 [ ]
+    uint8_t  ins_sol_status;      //!< Navigation solution status                              [ ]
+    uint8_t  kf_pos_cov_lla[3];   //!< Kalman filter position standard deviations              [ ]
+    uint8_t  kf_vel_cov_ned[3];   //!< Kalman filter velocity standard deviations              [ ]
+} s_ins_snapshot_t;
+
+/**
+ * @brief   Air data published per cycle in which labels were decoded
+ */
+typedef struct
+{
+    uint32_t sequence;            //!< Incremented on each publication, 0 before the first     [ ]
+    uint32_t valid;               //!< ADC_SNAP_VALID_ bits                                    [ ]
+    s_sample_time_t sample_time;  //!< Arrival time of the airspeed label                      [ ]
+    float    cas;                 //!< Calibrated airspeed, as reported by the ADC
+    float    aoa;                 //!< Angle of attack, as reported by the ADC
+    float    aos;                 //!< Angle of sideslip, as reported by the ADC
+    float    oat;                 //!< Static air temperature, as reported by the ADC
+    float    alt;                 //!< Pressure altitude, as reported by the ADC
+    float    alt_baro;            //!< Barometric altitude corrected with the QNH setting of the ADC
+    uint16_t status;              //!< Status label of the air data computer                   [ ]
+} s_adc_snapshot_t;
+
+/**
+ * @brief   Radar altimeter data published per decoded frame
+ */
+typedef struct
+{
+    uint32_t sequence;            //!< Incremented on each publication, 0 before the first     [ ]
+    uint32_t valid;               //!< RADALT_SNAP_VALID_ bits                                 [ ]
+    s_sample_time_t sample_time;  //!< Arrival time of the frame                               [ ]
+    float    agl;                 //!< Height above ground level                               [m]
+    float    snr;                 //!< Signal to noise ratio                                   [dB]
+} s_radalt_snapshot_t;
+
+#endif /* H_TYPES_SNAPSHOT */
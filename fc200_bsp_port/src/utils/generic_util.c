@@ -7,6 +7,7 @@
  */
 
 #include "generic_util.h"
+#include "soc/dma/d_dma_copy.h"
 
 /******************************************************************************
  * @brief   Converts an ASCII hexadecimal string to a float value.
@@ -154,7 +155,7 @@ bool util_ascii_hex_to_uword(const char *hex_string, uint16_t *ptr_int_data)
  * @param num   Number of bytes to be set.
  * @return      The original pointer 'ptr'.
  */
-void *util_memset(void *ptr, int value, uint16_t num)
+void *util_memset(void *ptr, int value, uint32_t num)
 {
     unsigned char *p = ptr;
     while (num--)
@@ -169,21 +170,20 @@ void *util_memset(void *ptr, int value, uint16_t num)
  * !!Compliant to MISRA 2012 and Part of our configuration control!!
  *
  * This function copies 'num' bytes from the memory area pointed to by 'src'
- * to the memory area pointed to by 'dest'.
+ * to the memory area pointed to by 'dest'. Short copies are made by the CPU
+ * a word at a time where the alignment allows, long copies by DMA. The DMA
+ * path waits for the transfer, so it is not used from interrupt handlers,
+ * inside critical sections or while another copy holds the channel: those
+ * copies are made by the CPU whatever their length.
  *
  * @param dest Pointer to the destination memory area.
  * @param src  Pointer to the source memory area.
  * @param num  Number of bytes to copy.
  * @return     The original pointer 'dest'.
  */
-void *util_memcpy(void *dest, const void *src, uint16_t num)
+void *util_memcpy(void *dest, const void *src, uint32_t num)
 {
-    unsigned char *d = dest;
-    const unsigned char *s = src;
-    while (num--)
-    {
-        *d++ = *s++;
-    }
+    d_DMA_Copy((uint8_t *)dest, (const uint8_t *)src, num);
     return dest;
 }
 
@@ -203,7 +203,7 @@ void *util_memcpy(void *dest, const void *src, uint16_t num)
  *             to be less than, equal to, or greater than the first 'num'
  *             bytes of 'ptr2'.
  */
-int util_memcmp(const void *ptr1, const void *ptr2, uint16_t num)
+int util_memcmp(const void *ptr1, const void *ptr2, uint32_t num)
 {
     const unsigned char *p1 = ptr1;
     const unsigned char *p2 = ptr2;
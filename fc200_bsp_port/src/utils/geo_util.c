@@ -0,0 +1,246 @@
+/*
+ * ***************************************************
+ * File: geo_util.c
+ *
+ * Created: 2025-10-18
+ * ***************************************************
+ */
+
+#include <math.h>
+#include <stddef.h>
+
+#include "geo_util.h"
+#include "math_util.h"
+
+/******************************************************************************
+ * @brief   Offset of a position from the reference point in the local
+ *          tangent plane.
+ *
+ * @param[in]  from     Reference point with cached terms
+ * @param[in]  lat      Latitude of the position (rad)
+ * @param[in]  lon      Longitude of the position (rad)
+ * @param[out] north    North offset (m)
+ * @param[out] east     East offset (m)
+ *
+ * @return    None
+ ******************************************************************************/
+static void geo_ltp_offset(const geo_point_t *from, double lat, double lon, double *north, double *east)
+{
+    double d_lat = lat - from->lat;
+
+    /* East scale at the mid latitude, cos(lat + d_lat / 2) to first order */
+    *north = d_lat * from->r_north;
+    *east = wrap_pi(lon - from->lon) * (from->r_east - (0.5 * d_lat * from->r_prime * from->sin_lat));
+}
+
+/******************************************************************************
+ * @brief   Sets the reference point and its cached terms.
+ *
+ * The trigonometric terms and radii of curvature are recomputed only when
+ * the position differs from the one already held, so the call can be made
+ * every step with a waypoint that changes rarely.
+ *
+ * @param[in,out] point  Reference point
+ * @param[in]     lat    Latitude (rad)
+ * @param[in]     lon    Longitude (rad)
+ *
+ * @return    None
+ ******************************************************************************/
+void geo_point_set(geo_point_t *point, double lat, double lon)
+{
+    double w;
+    double sqrt_w;
+
+    if (point != NULL)
+    {
+        if ((point->valid == false) || (point->lat != lat) || (point->lon != lon))
+        {
+            point->lat = lat;
+            point->lon = lon;
+            point->sin_lat = sin(lat);
+            point->cos_lat = cos(lat);
+
+            w = 1.0 - (GEO_WGS84_E2 * point->sin_lat * point->sin_lat);
+            sqrt_w = sqrt(w);
+            point->r_prime = GEO_WGS84_A / sqrt_w;
+            point->r_north = (GEO_WGS84_A * (1.0 - GEO_WGS84_E2)) / (w * sqrt_w);
+            point->r_east = point->r_prime * point->cos_lat;
+            point->valid = true;
+        }
+    }
+}
+
+/******************************************************************************
+ * @brief   Reference point of a waypoint from the cache.
+ *
+ * The point with the same latitude and longitude is returned if the cache
+ * holds one. Otherwise the least recently used point is set to the position,
+ * so its trigonometry is evaluated once per waypoint rather than per call.
+ *
+ * @param[in,out] cache  Cache of reference points
+ * @param[in]     lat    Latitude of the waypoint (rad)
+ * @param[in]     lon    Longitude of the waypoint (rad)
+ *
+ * @return    Reference point of the waypoint
+ ******************************************************************************/
+const geo_point_t *geo_cache_point(geo_cache_t *cache, double lat, double lon)
+{
+    uint32_t i;
+    uint32_t oldest = 0U;
+    geo_point_t *point = NULL;
+
+    cache->lookups++;
+
+    for (i = 0U; (i < GEO_CACHE_POINTS) && (point == NULL); i++)
+    {
+        if ((cache->point[i].valid == true) && (cache->point[i].lat == lat) && (cache->point[i].lon == lon))
+        {
+            point = &cache->point[i];
+            cache->last_use[i] = cache->lookups;
+        }
+        else if ((cache->lookups - cache->last_use[i]) > (cache->lookups - cache->last_use[oldest]))
+        {
+            oldest = i;
+        }
+        else
+        {
+            /* older point already found */
+        }
+    }
+
+    if (point == NULL)
+    {
+        cache->misses++;
+        point = &cache->point[oldest];
+        cache->last_use[oldest] = cache->lookups;
+        geo_point_set(point, lat, lon);
+    }
+
+    return point;
+}
+
+/******************************************************************************
+ * @brief   Horizontal distance from the reference point to a position.
+ *
+ * Within GEO_LTP_RANGE the distance is taken in the local tangent plane of
+ * the WGS84 ellipsoid, which needs no trigonometry. Beyond it the haversine
+ * central angle is scaled by the radius of curvature of the ellipsoid along
+ * the bearing at the reference point.
+ *
+ * @param[in]  from     Reference point with cached terms
+ * @param[in]  lat      Latitude of the position (rad)
+ * @param[in]  lon      Longitude of the position (rad)
+ *
+ * @return    Distance (m)
+ ******************************************************************************/
+double geo_distance(const geo_point_t *from, double lat, double lon)
+{
+    double north;
+    double east;
+    double dist;
+    double s_lat;
+    double s_lon;
+    double h;
+    double n2;
+    double e2;
+
+    geo_ltp_offset(from, lat, lon, &north, &east);
+    dist = sqrt((north * north) + (east * east));
+
+    if (dist > GEO_LTP_RANGE)
+    {
+        s_lat = sin(0.5 * (lat - from->lat));
+        s_lon = sin(0.5 * wrap_pi(lon - from->lon));
+        h = (s_lat * s_lat) + (from->cos_lat * cos(lat) * s_lon * s_lon);
+        if (h > 1.0)
+        {
+            h = 1.0;
+        }
+        n2 = north * north;
+        e2 = east * east;
+        dist = 2.0 * asin(sqrt(h)) * ((n2 + e2) / ((n2 / from->r_north) + (e2 / from->r_prime)));
+    }
+
+    return dist;
+}
+
+/******************************************************************************
+ * @brief   Bearing from the reference point to a position.
+ *
+ * @param[in]  from     Reference point with cached terms
+ * @param[in]  lat      Latitude of the position (rad)
+ * @param[in]  lon      Longitude of the position (rad)
+ *
+ * @return    Bearing (rad), -pi to pi, clockwise from north
+ ******************************************************************************/
+double geo_bearing(const geo_point_t *from, double lat, double lon)
+{
+    double north;
+    double east;
+    double bearing;
+    double d_lon;
+    double cos_lat;
+
+    geo_ltp_offset(from, lat, lon, &north, &east);
+
+    if (((north * north) + (east * east)) > (GEO_LTP_RANGE * GEO_LTP_RANGE))
+    {
+        d_lon = lon - from->lon;
+        cos_lat = cos(lat);
+        /* Spherical bearing with its components scaled by the radii of
+         * curvature, as the tangent plane bearing is on the ellipsoid */
+        bearing = atan2(sin(d_lon) * cos_lat * from->r_prime,
+                        ((from->cos_lat * sin(lat)) - (from->sin_lat * cos_lat * cos(d_lon))) * from->r_north);
+    }
+    else
+    {
+        /* The plane bearing is the one at the mid point, the convergence
+         * of the meridians turns it back to the start */
+        bearing = wrap_pi(atan2(east, north) - (0.5 * wrap_pi(lon - from->lon) * from->sin_lat));
+    }
+
+    return bearing;
+}
+
+/******************************************************************************
+ * @brief   Destination point from the reference point.
+ *
+ * Great circle on a sphere of radius GEO_EARTH_RADIUS, the same model as
+ * the destinationPoint function of the flight management chart.
+ *
+ * @param[in]  from     Reference point with cached terms
+ * @param[in]  dist     Distance to travel (m)
+ * @param[in]  heading  Initial heading (rad), clockwise from north
+ * @param[out] lat      Latitude of the destination (rad)
+ * @param[out] lon      Longitude of the destination (rad)
+ *
+ * @return    None
+ ******************************************************************************/
+void geo_destination(const geo_point_t *from, double dist, double heading, double *lat, double *lon)
+{
+    double ang;
+    double cos_ang;
+    double sin_ang;
+    double u;
+
+    ang = dist / GEO_EARTH_RADIUS;
+    cos_ang = cos(ang);
+    sin_ang = sin(ang);
+
+    u = (from->sin_lat * cos_ang) + (from->cos_lat * sin_ang * cos(heading));
+    if (u > 1.0)
+    {
+        u = 1.0;
+    }
+    else if (u < -1.0)
+    {
+        u = -1.0;
+    }
+    else
+    {
+        /* in range */
+    }
+
+    *lat = asin(u);
+    *lon = from->lon + atan2(sin(heading) * sin_ang * from->cos_lat, cos_ang - (from->sin_lat * sin(*lat)));
+}
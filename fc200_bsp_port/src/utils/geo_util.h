@@ -0,0 +1,83 @@
+/*
+ * ***************************************************
+ * File: geo_util.h
+ *
+ * Created: 2025-10-18
+ * ***************************************************
+ */
+#ifndef H_GEO_UTIL
+#define H_GEO_UTIL
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#define GEO_EARTH_RADIUS 6371000.0  // mean earth radius (m), spherical model
+#define GEO_WGS84_A 6378137.0       // WGS84 semi-major axis (m)
+#define GEO_WGS84_E2 0.00669437999014 // WGS84 first eccentricity squared
+#define GEO_LTP_RANGE 5000.0        // local tangent plane limit (m)
+#define GEO_CACHE_POINTS 8U         // reference points held by a geo_cache_t
+
+/*
+Reference point with cached trigonometric terms.
+Angles in radians. The cached terms are refreshed by geo_point_set
+only when the latitude or longitude change, so a waypoint costs its
+trigonometry once when it is committed rather than on every step.
+*/
+typedef struct
+{
+    double lat;     // latitude (rad)
+    double lon;     // longitude (rad)
+    double sin_lat; // sin(lat)
+    double cos_lat; // cos(lat)
+    double r_north; // meridian radius of curvature (m)
+    double r_east;  // prime vertical radius of curvature x cos(lat) (m)
+    double r_prime; // prime vertical radius of curvature (m)
+    bool valid;     // cached terms are set
+} geo_point_t;
+
+/*
+Reference points of the waypoints in use, keyed on their coordinates.
+A point is looked up by its latitude and longitude, so each waypoint
+keeps its cached terms while the vehicle position moves. The least
+recently used point is replaced when the table is full.
+*/
+typedef struct
+{
+    geo_point_t point[GEO_CACHE_POINTS];
+    uint32_t last_use[GEO_CACHE_POINTS]; // lookup count at the last use
+    uint32_t lookups;                    // lookups made
+    uint32_t misses;                     // lookups that computed a point
+} geo_cache_t;
+
+/*
+Sets the reference point, recomputing the cached terms if the
+position changed.
+*/
+void geo_point_set(geo_point_t *point, double lat, double lon);
+
+/*
+Reference point at lat, lon from the cache, computed on a miss.
+*/
+const geo_point_t *geo_cache_point(geo_cache_t *cache, double lat, double lon);
+
+/*
+Horizontal distance (m) from the reference point to lat, lon.
+Local tangent plane on the WGS84 ellipsoid within GEO_LTP_RANGE,
+haversine with the radius of curvature along the
+bearing beyond.
+*/
+double geo_distance(const geo_point_t *from, double lat, double lon);
+
+/*
+Bearing (rad, -pi to pi, clockwise from north) from the reference
+point to lat, lon. Same range switch-over as geo_distance.
+*/
+double geo_bearing(const geo_point_t *from, double lat, double lon);
+
+/*
+Point at distance dist (m) along heading (rad) from the reference
+point on a sphere of radius GEO_EARTH_RADIUS.
+*/
+void geo_destination(const geo_point_t *from, double dist, double heading, double *lat, double *lon);
+
+#endif /* H_GEO_UTIL */
@@ -0,0 +1,265 @@
+/****************************************************
+ *  fcs_log.c
+ *  FCS inputs and outputs of the SerdesLog frame
+ *  for the FCS host tools
+ *  Copyright: LODD (c) 2025
+ ****************************************************/
+
+/*
+The scalings follow send_log_data in mavlink_io.c and the staging
+follows fcs_mi_periodic in fcs_mi_main.c. Fields that the log does not
+carry are left as the target leaves them: the second INS and air data
+channels are absent, the angles of attack and sideslip and the baro
+altitude are invalid. The gyro and accelerometer validity of the INS and
+the sample ages are not logged, they are taken as valid and unknown.
+*/
+
+#include <stdint.h>
+#include <string.h>
+
+#include "controllerMain.h"
+#include "fcs_input_sel.h"
+#include "math_util.h"
+#include "fcs_log.h"
+
+#define DEG2RAD 0.0174532925        // as fcs_mi_main.c
+#define RAD2DEG 57.29577951         // as fcs_mi_main.c
+#define RAD2DEG_F 57.2957f          // as mavlink_io.c
+
+/* LDE_STATUS flags of the lodd MAVLink dialect */
+#define LOG_STATUS_ARMED            (1U)
+#define LOG_STATUS_IN_AIR           (2U)
+#define LOG_STATUS_PIC_MODE         (4U)
+#define LOG_STATUS_IP_LINK_LOSS     (32U)
+#define LOG_STATUS_RC_LINK_LOSS     (64U)
+#define LOG_STATUS_GPS_LOSS         (128U)
+
+/* ins1_flags, ads_flags and pilot_flags bits */
+#define LOG_INS_TIMEOUT             (0x01U)
+#define LOG_INS_ATT_INVALID         (0x40U)
+#define LOG_INS_POS_INVALID         (0x80U)
+#define LOG_ADS_TIMEOUT             (0x01U)
+#define LOG_ADS_CAS_INVALID         (0x02U)
+
+static fcs_sel_nav_in_t NavIn[FCS_SEL_CHANNELS];
+static fcs_sel_ads_in_t AdsIn[FCS_SEL_CHANNELS];
+
+/*
+Float to integer conversions of the target. The VFP conversion to a 32 bit
+integer saturates, the result is then truncated to the field width.
+*/
+static int32_t log_s32(float value)
+{
+    int32_t result;
+
+    if (value >= 2147483647.0f)
+    {
+        result = INT32_MAX;
+    }
+    else if (value <= -2147483648.0f)
+    {
+        result = INT32_MIN;
+    }
+    else
+    {
+        result = (int32_t)value;
+    }
+
+    return result;
+}
+
+static uint16_t log_u16(float value)
+{
+    uint16_t result;
+
+    if (value <= 0.0f)
+    {
+        result = 0U;
+    }
+    else if (value >= 4294967295.0f)
+    {
+        result = UINT16_MAX;
+    }
+    else
+    {
+        result = (uint16_t)(uint32_t)value;
+    }
+
+    return result;
+}
+
+/*
+The pilot switches are logged as (int8_t)(sw * 1000.0f), which wraps for
+the switch positions -1, 0 and 1. The position is the one that logs as
+the given value.
+*/
+static int8_t log_switch(int8_t logged)
+{
+    int8_t position;
+    int8_t result = 0;
+
+    for (position = -1; position <= 1; position++)
+    {
+        if ((int8_t)log_s32((float)position * 1000.0f) == logged)
+        {
+            result = position;
+        }
+    }
+
+    return result;
+}
+
+void fcs_log_init(void)
+{
+    memset(NavIn, 0, sizeof(NavIn));
+    memset(AdsIn, 0, sizeof(AdsIn));
+    fcs_sel_init();
+}
+
+static void stage_ins_1(const serdes_ss_log_t *frame)
+{
+    nav_data_t *nav = &NavIn[0].data;
+
+    for (int i = 0; i < 3; ++i)
+    {
+        nav->eul_ang[i] = ((double)frame->ins1_euler_rpy[i] / 100.0) * DEG2RAD;
+        nav->omg[i] = frame->ins1_omg[i];
+        nav->acc[i] = frame->ins1_acc[i];
+        nav->v_ned[i] = (double)frame->ins1_vel_ned[i] / 100.0;
+    }
+    nav->lat = ((double)frame->ins1_lat * 1e-7) * DEG2RAD;
+    nav->lon = ((double)frame->ins1_lon * 1e-7) * DEG2RAD;
+    nav->alt_gps_amsl = frame->ins1_alt_amsl;
+    nav->eph = (double)frame->ins1_gnss_h_acc / 100.0;
+    nav->epv = (double)frame->ins1_gnss_v_acc / 100.0;
+
+    nav->att_invalid = ((frame->ins1_flags & LOG_INS_ATT_INVALID) != 0U);
+    nav->omg_invalid = false;
+    nav->acc_invalid = false;
+    nav->pos_invalid = ((frame->ins1_flags & LOG_INS_POS_INVALID) != 0U);
+    nav->data_timeout = ((frame->ins1_flags & LOG_INS_TIMEOUT) != 0U);
+    NavIn[0].present = ((frame->ins1_flags & LOG_INS_TIMEOUT) == 0U);
+    NavIn[0].age_known = false;
+
+    /* No second INS is fitted, the channel stays absent */
+    NavIn[1].present = false;
+    NavIn[1].age_known = false;
+}
+
+static void stage_ads_1(const serdes_ss_log_t *frame)
+{
+    ads_data_t *ads = &AdsIn[0].data;
+
+    ads->aspd_cas = (double)frame->ads_aspd_cas / 100.0;
+    ads->aspd_cas_invalid = ((frame->ads_flags & LOG_ADS_CAS_INVALID) != 0U);
+
+    /* Angles of attack and sideslip and baro altitude are not provided by the air data computer */
+    ads->aoa_invalid = true;
+    ads->aos_invalid = true;
+    ads->baro_invalid = true;
+
+    AdsIn[0].present = ((frame->ads_flags & LOG_ADS_TIMEOUT) == 0U);
+    AdsIn[0].age_known = false;
+
+    /* No second air data computer is fitted, the channel stays absent */
+    AdsIn[1].present = false;
+    AdsIn[1].age_known = false;
+}
+
+void fcs_log_stage_inputs(const serdes_ss_log_t *frame)
+{
+    stage_ins_1(frame);
+    stage_ads_1(frame);
+
+    fcs_sel_nav(NavIn, &controllerMain_U.sensor_in.ins_1);
+    fcs_sel_ads(AdsIn, &controllerMain_U.sensor_in.ads_1);
+    controllerMain_U.failure_flags.gps_loss = controllerMain_U.sensor_in.ins_1.pos_invalid;
+
+    if (frame->radalt_flags == 0U)
+    {
+        controllerMain_U.sensor_in.h_radar_agl = frame->radalt_alt_raw;
+    }
+
+    controllerMain_U.pilot_ext.roll_ch = (double)frame->pilot_roll[0] / 1000.0;
+    controllerMain_U.pilot_ext.pitch_ch = (double)frame->pilot_pitch[0] / 1000.0;
+    controllerMain_U.pilot_ext.throttle_ch = (double)frame->pilot_thrust[0] / 1000.0;
+    controllerMain_U.pilot_ext.yaw_ch = (double)frame->pilot_yaw[0] / 1000.0;
+    controllerMain_U.pilot_ext.engine_ch = (((double)frame->pilot_pusher[0] / 1000.0) + 1.0) * 0.5; // input range is [0,1]
+    controllerMain_U.pilot_ext.arm_ch = (double)frame->pilot_arm_ch[0] / 1000.0;
+    controllerMain_U.pilot_ext.switch_1 = log_switch(frame->pilot_sw_b[0]);
+    controllerMain_U.failure_flags.ep_data_loss = (frame->pilot_flags[0] != 0);
+
+    controllerMain_U.pilot_int.roll_ch = (double)frame->pilot_roll[1] / 1000.0;
+    controllerMain_U.pilot_int.pitch_ch = (double)frame->pilot_pitch[1] / 1000.0;
+    controllerMain_U.pilot_int.throttle_ch = (double)frame->pilot_thrust[1] / 1000.0;
+    controllerMain_U.pilot_int.yaw_ch = (double)frame->pilot_yaw[1] / 1000.0;
+    controllerMain_U.pilot_int.engine_ch = (((double)frame->pilot_pusher[1] / 1000.0) + 1.0) * 0.5; // input range is [0,1]
+    controllerMain_U.failure_flags.ip_data_loss = (frame->pilot_flags[1] != 0);
+}
+
+void fcs_log_pack_outputs(serdes_ss_log_t *frame)
+{
+    const busController *pt_log = &controllerMain_Y.ctrl_log;
+
+    frame->fcs_vom_status = (uint8_t)controllerMain_Y.fcs_state.vom_status;
+    frame->fcs_status_flags = 0U;
+    frame->fcs_status_flags |= (controllerMain_Y.fcs_state.safety_state == 1) ? LOG_STATUS_ARMED : 0U;
+    frame->fcs_status_flags |= (controllerMain_Y.fcs_state.pic_status == 1) ? LOG_STATUS_PIC_MODE : 0U;
+    frame->fcs_status_flags |= (controllerMain_Y.fcs_state.inAir_flag == 1) ? LOG_STATUS_IN_AIR : 0U;
+    frame->fcs_status_flags |= (controllerMain_U.failure_flags.ep_data_loss == 1) ? LOG_STATUS_RC_LINK_LOSS : 0U;
+    frame->fcs_status_flags |= (controllerMain_U.failure_flags.ip_data_loss == 1) ? LOG_STATUS_IP_LINK_LOSS : 0U;
+    frame->fcs_status_flags |= (controllerMain_U.failure_flags.gps_loss == 1) ? LOG_STATUS_GPS_LOSS : 0U;
+
+    for (int i = 0; i < 3; i++)
+    {
+        frame->fcs_euler_rpy[i] = (int16_t)log_s32(wrap_pif((float)pt_log->SensorMgmt.static_sensor_voting_out.eul_ang[i]) * RAD2DEG_F * 100.0f);
+        frame->fcs_omg_xyz[i] = (float)pt_log->SensorMgmt.static_sensor_voting_out.omg[i];
+        frame->fcs_acc_xyz[i] = (float)pt_log->SensorMgmt.static_sensor_voting_out.accel_b[i];
+        frame->fcs_vel_ned[i] = (int16_t)log_s32((float)pt_log->SensorMgmt.static_sensor_voting_out.vel_ned[i] * 100.0f);
+    }
+    frame->fcs_lat = (int32_t)(pt_log->SensorMgmt.static_sensor_voting_out.pos_lla[0] * RAD2DEG * 1E7);
+    frame->fcs_lon = (int32_t)(pt_log->SensorMgmt.static_sensor_voting_out.pos_lla[1] * RAD2DEG * 1E7);
+    frame->fcs_alt_gps_amsl = (float)pt_log->SensorMgmt.static_sensor_voting_out.pos_lla[2];
+    frame->fcs_alt_radalt_filt = (float)pt_log->SensorMgmt.rad_alt_out;
+    frame->fcs_aspd_cas = (float)pt_log->SensorMgmt.static_sensor_voting_out.aspd_cas;
+
+    // FCS FB Controller Data
+    frame->fcs_mr_eul_rpy_d[0] = (int16_t)log_s32(wrap_pif((float)pt_log->controllerAttCtrl.rollCmd) * RAD2DEG_F * 100.0f);
+    frame->fcs_mr_eul_rpy_d[1] = (int16_t)log_s32(wrap_pif((float)pt_log->controllerAttCtrl.pitchCmd) * RAD2DEG_F * 100.0f);
+    frame->fcs_mr_eul_rpy_d[2] = (int16_t)log_s32(wrap_pif((float)pt_log->controllerIF_att.yawCmd) * RAD2DEG_F * 100.0f);
+    frame->fcs_mr_yawrate_d = (float)pt_log->controllerAttCtrl.yawRateCmd;
+    frame->fcs_mr_yaw_hold = (int8_t)pt_log->controllerIF_att.yawHold;
+    for (int i = 0; i < 4; i++)
+    {
+        frame->fcs_ca_nu_des[i] = (float)pt_log->controllerCA.nu_des[i];
+        frame->fcs_ca_nu_alloc[i] = (float)pt_log->controllerCA.nu_allocated[i];
+    }
+    frame->fcs_ca_cerp[0] = log_u16((float)pt_log->controllerCA.c_erp1 * 1000.0f);
+    frame->fcs_ca_cerp[1] = log_u16((float)pt_log->controllerCA.c_erp2 * 1000.0f);
+    frame->fcs_ca_cerp[2] = log_u16((float)pt_log->controllerCA.c_erp3 * 1000.0f);
+    frame->fcs_mr_h_d = (float)pt_log->controllerAltCtrl.hCmd;
+    frame->fcs_mr_hdot_d = (float)pt_log->controllerAltCtrl.hDotCmd;
+    frame->fcs_mr_h_hold = (float)pt_log->controllerAltCtrl.hHold;
+    frame->fcs_mr_vel_ne_d[0] = (int16_t)log_s32((float)pt_log->controllerVelCtrl.velCmd[0] * 100.0f);
+    frame->fcs_mr_vel_ne_d[1] = (int16_t)log_s32((float)pt_log->controllerVelCtrl.velCmd[1] * 100.0f);
+
+    frame->fcs_fw_roll_d = (int16_t)log_s32((float)pt_log->fwAttCmd.rollCmd * RAD2DEG_F * 100.0f);
+    frame->fcs_fw_pitch_d = (int16_t)log_s32((float)pt_log->fwAttCmd.pitchCmd * RAD2DEG_F * 100.0f);
+    frame->fcs_fw_h_d = (float)pt_log->controllerAltCtrl.hCmd;
+    frame->fcs_fw_cas_d = log_u16((float)pt_log->controllerTECS.vel_cmd * 100.0f);
+    frame->fcs_mr_pit_intg = (float)pt_log->IntegratorCF.MR_IntData.pitch_int;
+    frame->fcs_mr_pit_intg_sat = (int8_t)pt_log->IntegratorCF.MR_IntData.pitch_sat;
+    frame->fcs_fw_pit_intg = (float)pt_log->IntegratorCF.FW_IntData.pitch_int;
+    frame->fcs_fw_pit_intg_sat = (int8_t)pt_log->IntegratorCF.FW_IntData.pitch_sat;
+
+    // Actuator Commands
+    for (int i = 0; i < 8; i++)
+    {
+        frame->cmd_rotor_cval[i] = log_u16((float)controllerMain_Y.std_ctrl.lifter_cval_cmd[i] * 1000.0f);
+    }
+    for (int i = 0; i < 12; i++)
+    {
+        frame->cmd_servo_deg[i] = log_u16((float)controllerMain_Y.std_ctrl.acs_servo_deg_cmd[i] * 100.0f);
+    }
+    frame->cmd_pusher_pwm = log_u16((float)controllerMain_Y.std_ctrl.pusher_pwm_cmd);
+}
@@ -0,0 +1,28 @@
+/****************************************************
+ *  fcs_log.h
+ *  FCS inputs and outputs of the SerdesLog frame
+ *  for the FCS host tools
+ *  Copyright: LODD (c) 2025
+ ****************************************************/
+
+#ifndef H_FCS_LOG
+#define H_FCS_LOG
+
+#include "serdes_ss_log.h"
+
+/* Largest framed SerdesLog message */
+#define FCS_LOG_FRAME_SIZE (1024U)
+
+void fcs_log_init(void);
+
+/*
+Stage the controller inputs of a frame as fcs_mi_periodic does, the INS
+and air data through the input selection, the radar altitude and the
+pilot inputs with their link loss flags
+*/
+void fcs_log_stage_inputs(const serdes_ss_log_t *frame);
+
+/* Pack the controller outputs into the FCS and command fields as send_log_data does */
+void fcs_log_pack_outputs(serdes_ss_log_t *frame);
+
+#endif /* H_FCS_LOG */
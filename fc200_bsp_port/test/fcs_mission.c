@@ -0,0 +1,376 @@
+/****************************************************
+ *  fcs_mission.c
+ *  Closed loop host run of the FCS autogen code
+ *  Copyright: LODD (c) 2025
+ ****************************************************/
+
+/*
+Flies a scripted mission with controllerMain_step in the loop and writes
+the trajectory as CSV. The aircraft is a point mass with first order
+attitude and heading response, driven by the attitude, heading and force
+commands of the controller. The model and the trajectory are double in
+every build, so that the runs of the double and the FCS_SINGLE_PRECISION
+builds of the autogen code can be compared by fcs_precision_compare.
+
+With a log file the run is also written as SerdesLog frames, one per
+step as the target sends them, and the mode commands to a command file
+for fcs_replay. The controller inputs are then staged from the frames,
+with the log scalings and the input selection, so that fcs_replay
+reproduces the run from the log.
+
+    fcs_mission <mission> <trajectory.csv> [<log> <commands>]
+*/
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "controllerMain.h"
+#include "math_util.h"
+#include "fcs_log.h"
+
+#define STEP_S          0.01        // controller sample time (s)
+#define LOG_DECIMATION  10U         // steps per trajectory row
+#define GRAVITY         9.81        // m/s^2
+#define MASS_KG         67.45       // mass of the state machine thresholds (kg)
+#define ATT_TAU_S       0.15        // roll and pitch response time constant (s)
+#define YAW_TAU_S       0.5         // heading response time constant (s)
+#define YAW_RATE_MAX    0.5         // heading rate limit (rad/s)
+#define DRAG_PER_S      0.3         // linear drag over mass (1/s)
+#define EARTH_RADIUS    6378137.0   // m
+#define ARM_TIME_S      2.5         // arm knob raised after the startup command (s)
+#define MAX_COMMANDS    8U
+#define RAD2DEG_F       57.2957f    // as mavlink_io.c
+
+/* Home is the runway the state machine returns to */
+#define HOME_LAT        0.42700150356474043 // rad
+#define HOME_LON        0.97080864372042563 // rad
+#define HOME_ALT        500.0               // m AMSL
+
+/* Mode command sent at a time into the mission */
+typedef struct
+{
+    double t_s;
+    vom_t vom;
+} mission_cmd_t;
+
+/* Scripted mission, starting on the ground at an offset from home */
+typedef struct
+{
+    const char *name;
+    double start_north;     // m
+    double start_east;      // m
+    double duration_s;
+    mission_cmd_t cmd[MAX_COMMANDS];
+    unsigned int cmd_count;
+} mission_t;
+
+/* Simulated aircraft */
+typedef struct
+{
+    double lat;         // rad
+    double lon;         // rad
+    double alt;         // m AMSL
+    double v_ned[3];    // m/s
+    double eul[3];      // roll, pitch, yaw (rad)
+    double omg[3];      // body rates (rad/s)
+    double thrust;      // N
+    int on_ground;
+} plant_t;
+
+/*
+Take-off, hover, return to home and the automatic landing at home.
+The short mission returns from the north east, the long one from the
+south west with a longer cruise leg.
+*/
+static const mission_t missions[] =
+{
+    {
+        "rth_short", 150.0, 120.0, 130.0,
+        {{1.0, VOM_READY}, {2.0, VOM_STARTUP}, {3.0, VOM_TAKEOFF}, {30.0, VOM_HOVER}, {40.0, VOM_MR_RTH}},
+        5U
+    },
+    {
+        "rth_long", -450.0, -600.0, 200.0,
+        {{1.0, VOM_READY}, {2.0, VOM_STARTUP}, {3.0, VOM_TAKEOFF}, {25.0, VOM_HOVER}, {30.0, VOM_MR_RTH}},
+        5U
+    },
+};
+
+static void plant_init(plant_t *p, const mission_t *m)
+{
+    memset(p, 0, sizeof(*p));
+    p->lat = HOME_LAT + (m->start_north / EARTH_RADIUS);
+    p->lon = HOME_LON + (m->start_east / (EARTH_RADIUS * cos(HOME_LAT)));
+    p->alt = HOME_ALT;
+    p->on_ground = 1;
+}
+
+/* Advance the aircraft one step with the commands of the last controller step */
+static void plant_step(plant_t *p)
+{
+    const busController *log = &controllerMain_Y.ctrl_log;
+    double roll_cmd = (double)log->controllerAttCtrl.rollCmd;
+    double pitch_cmd = (double)log->controllerAttCtrl.pitchCmd;
+    double yaw_err = remainder((double)log->controllerIF_att.yawCmd - p->eul[2], 2.0 * M_PI);
+    double force = (double)log->controllerAltCtrl.forceDes;
+    double cr, sr, cp, sp, cy, sy;
+    double acc[3];
+    int i;
+
+    if ((controllerMain_Y.fcs_state.safety_state != AC_ARMED) || (force < 0.0))
+    {
+        force = 0.0;
+    }
+    p->thrust = force;
+
+    if (p->on_ground)
+    {
+        p->omg[0] = 0.0;
+        p->omg[1] = 0.0;
+        p->omg[2] = 0.0;
+    }
+    else
+    {
+        p->omg[0] = (roll_cmd - p->eul[0]) / ATT_TAU_S;
+        p->omg[1] = (pitch_cmd - p->eul[1]) / ATT_TAU_S;
+        p->omg[2] = fmax(-YAW_RATE_MAX, fmin(YAW_RATE_MAX, yaw_err / YAW_TAU_S));
+    }
+    for (i = 0; i < 3; i++)
+    {
+        p->eul[i] += p->omg[i] * STEP_S;
+    }
+    p->eul[2] = remainder(p->eul[2], 2.0 * M_PI);
+
+    cr = cos(p->eul[0]);
+    sr = sin(p->eul[0]);
+    cp = cos(p->eul[1]);
+    sp = sin(p->eul[1]);
+    cy = cos(p->eul[2]);
+    sy = sin(p->eul[2]);
+
+    // thrust along the body -z axis
+    acc[0] = (-(force / MASS_KG) * ((cy * sp * cr) + (sy * sr))) - (DRAG_PER_S * p->v_ned[0]);
+    acc[1] = (-(force / MASS_KG) * ((sy * sp * cr) - (cy * sr))) - (DRAG_PER_S * p->v_ned[1]);
+    acc[2] = (-(force / MASS_KG) * (cp * cr)) + GRAVITY - (DRAG_PER_S * p->v_ned[2]);
+
+    for (i = 0; i < 3; i++)
+    {
+        p->v_ned[i] += acc[i] * STEP_S;
+    }
+    p->lat += (p->v_ned[0] / EARTH_RADIUS) * STEP_S;
+    p->lon += (p->v_ned[1] / (EARTH_RADIUS * cos(p->lat))) * STEP_S;
+    p->alt -= p->v_ned[2] * STEP_S;
+
+    p->on_ground = (p->alt <= HOME_ALT) ? 1 : 0;
+    if (p->on_ground)
+    {
+        p->alt = HOME_ALT;
+        p->v_ned[0] = 0.0;
+        p->v_ned[1] = 0.0;
+        p->v_ned[2] = 0.0;
+        p->eul[0] = 0.0;
+        p->eul[1] = 0.0;
+    }
+}
+
+static void set_nav(nav_data_t *nav, const plant_t *p)
+{
+    int i;
+
+    for (i = 0; i < 3; i++)
+    {
+        nav->eul_ang[i] = (real_T)p->eul[i];
+        nav->omg[i] = (real_T)p->omg[i];
+        nav->v_ned[i] = (real_T)p->v_ned[i];
+        nav->acc[i] = 0.0;
+    }
+    nav->acc[2] = (real_T)(p->on_ground ? -GRAVITY : -(p->thrust / MASS_KG));
+    nav->lat = p->lat;
+    nav->lon = p->lon;
+    nav->alt_gps_amsl = (real_T)p->alt;
+    nav->eph = 1.0;
+    nav->epv = 1.5;
+}
+
+/* Sensor inputs as the selection stage hands them to the controller */
+static void set_sensors(const plant_t *p)
+{
+    sensor_t *s = &controllerMain_U.sensor_in;
+
+    set_nav(&s->ins_1, p);
+    set_nav(&s->ins_2, p);
+    s->ads_1.aspd_cas = (real_T)sqrt((p->v_ned[0] * p->v_ned[0]) + (p->v_ned[1] * p->v_ned[1]));
+    s->ads_1.alt_baro_amsl = (real_T)p->alt;
+    s->ads_2 = s->ads_1;
+    s->h_radar_agl = (real_T)(p->alt - HOME_ALT);
+}
+
+/* Sensor and pilot inputs of a log frame, scaled as send_log_data does */
+static void log_inputs(serdes_ss_log_t *frame, const plant_t *p, double arm_ch)
+{
+    double acc_d = p->on_ground ? -GRAVITY : -(p->thrust / MASS_KG);
+
+    for (int i = 0; i < 3; i++)
+    {
+        frame->ins1_euler_rpy[i] = (int16_t)(wrap_pif((float)p->eul[i]) * RAD2DEG_F * 100.0f);
+        frame->ins1_omg[i] = (float)p->omg[i];
+        frame->ins1_acc[i] = 0.0f;
+        frame->ins1_vel_ned[i] = (int16_t)((float)p->v_ned[i] * 100.0f);
+    }
+    frame->ins1_acc[2] = (float)acc_d;
+    frame->ins1_lat = (int32_t)(p->lat * (180.0 / M_PI) * 1.0e7);
+    frame->ins1_lon = (int32_t)(p->lon * (180.0 / M_PI) * 1.0e7);
+    frame->ins1_alt_amsl = (float)p->alt;
+    frame->ins1_gnss_h_acc = 100U;
+    frame->ins1_gnss_v_acc = 150U;
+    frame->ins1_flags = 0U;
+
+    frame->ads_aspd_cas = (int16_t)((float)sqrt((p->v_ned[0] * p->v_ned[0]) + (p->v_ned[1] * p->v_ned[1])) * 100.0f);
+    frame->ads_flags = 0U;
+
+    frame->radalt_alt_raw = (float)(p->alt - HOME_ALT);
+    frame->radalt_flags = 0U;
+
+    frame->pilot_arm_ch[0] = (int16_t)((float)arm_ch * 1000.0f);
+    frame->pilot_pusher[0] = -1000;
+    frame->pilot_pusher[1] = -1000;
+}
+
+static void set_commands(void)
+{
+    controllerMain_U.std_command.home_pos_lla[0] = HOME_LAT;
+    controllerMain_U.std_command.home_pos_lla[1] = HOME_LON;
+    controllerMain_U.std_command.home_pos_lla[2] = HOME_ALT;
+    controllerMain_U.std_command.home_pos_set = 1U;
+    controllerMain_U.std_command.airspeed_cas_cmd = 25.0;
+    controllerMain_U.std_command.fwrth_apr_deg = 135.0;
+    controllerMain_U.std_command.pic_cmd = INTERNAL;
+    controllerMain_U.std_command.pic_cmd_cnt = 1U;
+}
+
+static void write_row(FILE *out, double t, const plant_t *p)
+{
+    int i;
+
+    fprintf(out, "%.2f,%d,%d,%.4f,%.4f,%.4f,%.4f,%.4f,%.4f,%.6f,%.6f,%.6f,%.3f",
+            t, (int)controllerMain_Y.fcs_state.vom_status, (int)controllerMain_Y.fcs_state.inAir_flag,
+            (p->lat - HOME_LAT) * EARTH_RADIUS, (p->lon - HOME_LON) * EARTH_RADIUS * cos(HOME_LAT),
+            p->alt - HOME_ALT, p->v_ned[0], p->v_ned[1], p->v_ned[2], p->eul[0], p->eul[1], p->eul[2], p->thrust);
+    for (i = 0; i < 8; i++)
+    {
+        fprintf(out, ",%.5f", (double)controllerMain_Y.std_ctrl.lifter_cval_cmd[i]);
+    }
+    fprintf(out, "\n");
+}
+
+int main(int argc, char *argv[])
+{
+    const mission_t *m = NULL;
+    plant_t plant;
+    serdes_ss_log_t frame;
+    uint8_t buffer[FCS_LOG_FRAME_SIZE];
+    FILE *out;
+    FILE *log = NULL;
+    FILE *cmd_log = NULL;
+    unsigned int next_cmd = 0U;
+    unsigned int steps;
+    unsigned int k;
+    size_t i;
+
+    if ((argc != 3) && (argc != 5))
+    {
+        fprintf(stderr, "usage: %s <mission> <trajectory.csv> [<log> <commands>]\n", argv[0]);
+        return 2;
+    }
+    for (i = 0U; i < (sizeof(missions) / sizeof(missions[0])); i++)
+    {
+        if (strcmp(argv[1], missions[i].name) == 0)
+        {
+            m = &missions[i];
+        }
+    }
+    if (m == NULL)
+    {
+        fprintf(stderr, "unknown mission %s\n", argv[1]);
+        return 2;
+    }
+    out = fopen(argv[2], "w");
+    if (out == NULL)
+    {
+        perror(argv[2]);
+        return 2;
+    }
+    if (argc == 5)
+    {
+        log = fopen(argv[3], "wb");
+        cmd_log = fopen(argv[4], "w");
+        if ((log == NULL) || (cmd_log == NULL))
+        {
+            perror("log");
+            return 2;
+        }
+    }
+
+    plant_init(&plant, m);
+    controllerMain_initialize();
+    fcs_log_init();
+    memset(&frame, 0, sizeof(frame));
+    set_commands();
+
+    fprintf(out, "t,vom,in_air,north,east,alt,vn,ve,vd,roll,pitch,yaw,thrust,"
+                 "cval0,cval1,cval2,cval3,cval4,cval5,cval6,cval7\n");
+
+    steps = (unsigned int)(m->duration_s / STEP_S);
+    for (k = 0U; k < steps; k++)
+    {
+        double t = k * STEP_S;
+
+        if ((next_cmd < m->cmd_count) && (t >= m->cmd[next_cmd].t_s))
+        {
+            controllerMain_U.std_command.vom_cmd = m->cmd[next_cmd].vom;
+            controllerMain_U.std_command.vom_cmd_cnt++;
+            if (cmd_log != NULL)
+            {
+                fprintf(cmd_log, "%u vom %d\n", (unsigned int)((t * 1000.0) + 0.5), (int)m->cmd[next_cmd].vom);
+            }
+            next_cmd++;
+        }
+        if (log == NULL)
+        {
+            controllerMain_U.pilot_ext.arm_ch = (t >= ARM_TIME_S) ? 1.0 : 0.0;
+            set_sensors(&plant);
+            controllerMain_step();
+        }
+        else
+        {
+            frame.logger_time_ms = (uint32_t)((t * 1000.0) + 0.5);
+            log_inputs(&frame, &plant, (t >= ARM_TIME_S) ? 1.0 : 0.0);
+            fcs_log_stage_inputs(&frame);
+            controllerMain_step();
+            fcs_log_pack_outputs(&frame);
+
+            int len = serdes_pack_ss_log(&frame, buffer, sizeof(buffer));
+            if (len > 0)
+            {
+                fwrite(buffer, 1U, (size_t)len, log);
+            }
+        }
+        plant_step(&plant);
+
+        if ((k % LOG_DECIMATION) == 0U)
+        {
+            write_row(out, t, &plant);
+        }
+    }
+
+    fclose(out);
+    if (log != NULL)
+    {
+        fclose(log);
+        fclose(cmd_log);
+    }
+
+    return 0;
+}
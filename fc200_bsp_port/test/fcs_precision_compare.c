@@ -0,0 +1,234 @@
+/****************************************************
+ *  fcs_precision_compare.c
+ *  Compares the trajectories of the double and the
+ *  single precision builds of the FCS autogen code
+ *  Copyright: LODD (c) 2025
+ ****************************************************/
+
+/*
+Reads two trajectories written by fcs_mission for the same mission, the
+reference from the double build and the other from the
+FCS_SINGLE_PRECISION build, prints the largest differences and checks
+them against the error bounds below.
+
+    fcs_precision_compare <double.csv> <single.csv>
+*/
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "test_common.h"
+
+#define MAX_ROWS        40000U
+#define CVAL_COUNT      8U
+#define MAX_MODE_CHANGES 32U
+
+/* Error bounds of the single precision trajectory */
+#define BOUND_POS_M         0.1     // horizontal position (m)
+#define BOUND_ALT_M         0.25    // altitude (m)
+#define BOUND_VEL_MPS       0.25    // velocity (m/s)
+#define BOUND_ATT_RAD       0.01    // roll and pitch (rad)
+#define BOUND_YAW_RAD       0.01    // heading (rad)
+#define BOUND_THRUST_N      20.0    // thrust (N)
+#define BOUND_CVAL          0.05    // lifter command (normalised)
+#define BOUND_MODE_TIME_S   1.0     // time of a mode change (s)
+#define BOUND_LANDING_M     0.01    // landing point (m)
+
+typedef struct
+{
+    double t;
+    int vom;
+    int in_air;
+    double north;
+    double east;
+    double alt;
+    double v_ned[3];
+    double eul[3];
+    double thrust;
+    double cval[CVAL_COUNT];
+} row_t;
+
+typedef struct
+{
+    row_t *row;
+    unsigned int count;
+} trajectory_t;
+
+static int read_trajectory(const char *path, trajectory_t *traj)
+{
+    char line[1024];
+    FILE *in = fopen(path, "r");
+
+    if (in == NULL)
+    {
+        perror(path);
+        return -1;
+    }
+
+    traj->row = calloc(MAX_ROWS, sizeof(row_t));
+    traj->count = 0U;
+
+    // header
+    if ((traj->row == NULL) || (fgets(line, sizeof(line), in) == NULL))
+    {
+        fclose(in);
+        return -1;
+    }
+
+    while ((traj->count < MAX_ROWS) && (fgets(line, sizeof(line), in) != NULL))
+    {
+        row_t *r = &traj->row[traj->count];
+        int n = sscanf(line, "%lf,%d,%d,%lf,%lf,%lf,%lf,%lf,%lf,%lf,%lf,%lf,%lf,%lf,%lf,%lf,%lf,%lf,%lf,%lf,%lf",
+                       &r->t, &r->vom, &r->in_air, &r->north, &r->east, &r->alt,
+                       &r->v_ned[0], &r->v_ned[1], &r->v_ned[2], &r->eul[0], &r->eul[1], &r->eul[2], &r->thrust,
+                       &r->cval[0], &r->cval[1], &r->cval[2], &r->cval[3],
+                       &r->cval[4], &r->cval[5], &r->cval[6], &r->cval[7]);
+        if (n != 21)
+        {
+            fprintf(stderr, "%s: bad row %u\n", path, traj->count + 2U);
+            fclose(in);
+            return -1;
+        }
+        traj->count++;
+    }
+
+    fclose(in);
+
+    return 0;
+}
+
+/* Keep the largest absolute difference and the time it was seen */
+static void track(double diff, double t, double *max, double *t_max)
+{
+    diff = fabs(diff);
+    if (diff > *max)
+    {
+        *max = diff;
+        *t_max = t;
+    }
+}
+
+/* Mode changes of a trajectory, as (time, mode) pairs */
+static unsigned int mode_changes(const trajectory_t *traj, double *t, int *vom)
+{
+    unsigned int count = 0U;
+    unsigned int i;
+
+    for (i = 1U; (i < traj->count) && (count < MAX_MODE_CHANGES); i++)
+    {
+        if (traj->row[i].vom != traj->row[i - 1U].vom)
+        {
+            t[count] = traj->row[i].t;
+            vom[count] = traj->row[i].vom;
+            count++;
+        }
+    }
+
+    return count;
+}
+
+int main(int argc, char *argv[])
+{
+    trajectory_t ref;
+    trajectory_t sgl;
+    double max_pos = 0.0, t_pos = 0.0;
+    double max_alt = 0.0, t_alt = 0.0;
+    double max_vel = 0.0, t_vel = 0.0;
+    double max_att = 0.0, t_att = 0.0;
+    double max_yaw = 0.0, t_yaw = 0.0;
+    double max_thrust = 0.0, t_thrust = 0.0;
+    double max_cval = 0.0, t_cval = 0.0;
+    double ref_mode_t[MAX_MODE_CHANGES], sgl_mode_t[MAX_MODE_CHANGES];
+    int ref_mode[MAX_MODE_CHANGES], sgl_mode[MAX_MODE_CHANGES];
+    unsigned int ref_modes, sgl_modes;
+    double max_mode_t = 0.0;
+    const row_t *ref_end;
+    const row_t *sgl_end;
+    unsigned int i, j;
+
+    if (argc != 3)
+    {
+        fprintf(stderr, "usage: %s <double.csv> <single.csv>\n", argv[0]);
+        return 2;
+    }
+    if ((read_trajectory(argv[1], &ref) != 0) || (read_trajectory(argv[2], &sgl) != 0))
+    {
+        return 2;
+    }
+
+    TEST_CHECK(ref.count > 0U);
+    TEST_CHECK_EQUAL(sgl.count, ref.count);
+    if ((ref.count == 0U) || (sgl.count != ref.count))
+    {
+        return TEST_RESULT();
+    }
+
+    for (i = 0U; i < ref.count; i++)
+    {
+        const row_t *a = &ref.row[i];
+        const row_t *b = &sgl.row[i];
+
+        track(hypot(a->north - b->north, a->east - b->east), a->t, &max_pos, &t_pos);
+        track(a->alt - b->alt, a->t, &max_alt, &t_alt);
+        for (j = 0U; j < 3U; j++)
+        {
+            track(a->v_ned[j] - b->v_ned[j], a->t, &max_vel, &t_vel);
+        }
+        track(a->eul[0] - b->eul[0], a->t, &max_att, &t_att);
+        track(a->eul[1] - b->eul[1], a->t, &max_att, &t_att);
+        track(remainder(a->eul[2] - b->eul[2], 2.0 * M_PI), a->t, &max_yaw, &t_yaw);
+        track(a->thrust - b->thrust, a->t, &max_thrust, &t_thrust);
+        for (j = 0U; j < CVAL_COUNT; j++)
+        {
+            track(a->cval[j] - b->cval[j], a->t, &max_cval, &t_cval);
+        }
+    }
+
+    ref_modes = mode_changes(&ref, ref_mode_t, ref_mode);
+    sgl_modes = mode_changes(&sgl, sgl_mode_t, sgl_mode);
+    TEST_CHECK_EQUAL(sgl_modes, ref_modes);
+    for (i = 0U; (i < ref_modes) && (i < sgl_modes); i++)
+    {
+        TEST_CHECK_EQUAL(sgl_mode[i], ref_mode[i]);
+        if (fabs(sgl_mode_t[i] - ref_mode_t[i]) > max_mode_t)
+        {
+            max_mode_t = fabs(sgl_mode_t[i] - ref_mode_t[i]);
+        }
+    }
+
+    ref_end = &ref.row[ref.count - 1U];
+    sgl_end = &sgl.row[sgl.count - 1U];
+
+    printf("                 max difference   at (s)   bound\n");
+    printf("position (m)     %14.4f  %7.2f  %6.3f\n", max_pos, t_pos, BOUND_POS_M);
+    printf("altitude (m)     %14.4f  %7.2f  %6.3f\n", max_alt, t_alt, BOUND_ALT_M);
+    printf("velocity (m/s)   %14.4f  %7.2f  %6.3f\n", max_vel, t_vel, BOUND_VEL_MPS);
+    printf("roll/pitch (rad) %14.6f  %7.2f  %6.3f\n", max_att, t_att, BOUND_ATT_RAD);
+    printf("heading (rad)    %14.6f  %7.2f  %6.3f\n", max_yaw, t_yaw, BOUND_YAW_RAD);
+    printf("thrust (N)       %14.4f  %7.2f  %6.3f\n", max_thrust, t_thrust, BOUND_THRUST_N);
+    printf("lifter cval      %14.6f  %7.2f  %6.3f\n", max_cval, t_cval, BOUND_CVAL);
+    printf("mode change (s)  %14.2f           %6.3f\n", max_mode_t, BOUND_MODE_TIME_S);
+    printf("landing (m)      %14.4f           %6.3f\n",
+           hypot(ref_end->north - sgl_end->north, ref_end->east - sgl_end->east), BOUND_LANDING_M);
+
+    TEST_CHECK(max_pos <= BOUND_POS_M);
+    TEST_CHECK(max_alt <= BOUND_ALT_M);
+    TEST_CHECK(max_vel <= BOUND_VEL_MPS);
+    TEST_CHECK(max_att <= BOUND_ATT_RAD);
+    TEST_CHECK(max_yaw <= BOUND_YAW_RAD);
+    TEST_CHECK(max_thrust <= BOUND_THRUST_N);
+    TEST_CHECK(max_cval <= BOUND_CVAL);
+    TEST_CHECK(max_mode_t <= BOUND_MODE_TIME_S);
+    TEST_CHECK(hypot(ref_end->north - sgl_end->north, ref_end->east - sgl_end->east) <= BOUND_LANDING_M);
+
+    // both runs finish landed
+    TEST_CHECK_EQUAL(ref_end->in_air, 0);
+    TEST_CHECK_EQUAL(sgl_end->in_air, 0);
+
+    free(ref.row);
+    free(sgl.row);
+
+    return TEST_RESULT();
+}
@@ -0,0 +1,155 @@
+/****************************************************
+ *  fcs_profile_host.c
+ *  Execution time instrumentation of the FCS step
+ *  on the host
+ *  Copyright: LODD (c) 2025
+ ****************************************************/
+
+/*
+Host implementation of fcs_profile.h for the FCS host tools. The sections
+are timed with the monotonic clock and every sample is kept, so the
+percentiles are exact rather than taken from the histogram of the target
+implementation.
+*/
+
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "fcs_profile.h"
+
+typedef struct
+{
+    uint64_t start;
+    uint32_t *samples;  // execution times (ns)
+    uint32_t count;
+    uint32_t capacity;
+    uint64_t total;
+    uint32_t last;
+    uint32_t min;
+    uint32_t max;
+    int sorted;
+} prof_section_t;
+
+static prof_section_t prof_sections[FCS_PROF_COUNT];
+
+static uint64_t prof_now_ns(void)
+{
+    struct timespec now;
+
+    clock_gettime(CLOCK_MONOTONIC, &now);
+
+    return ((uint64_t)now.tv_sec * 1000000000U) + (uint64_t)now.tv_nsec;
+}
+
+static int prof_compare(const void *a, const void *b)
+{
+    uint32_t x = *(const uint32_t *)a;
+    uint32_t y = *(const uint32_t *)b;
+
+    return (x > y) - (x < y);
+}
+
+void fcs_profile_begin(fcs_prof_id_t id)
+{
+    if (id < FCS_PROF_COUNT)
+    {
+        prof_sections[id].start = prof_now_ns();
+    }
+}
+
+void fcs_profile_end(fcs_prof_id_t id)
+{
+    prof_section_t *section;
+    uint32_t ns;
+
+    if (id < FCS_PROF_COUNT)
+    {
+        section = &prof_sections[id];
+        ns = (uint32_t)(prof_now_ns() - section->start);
+
+        if (section->count == section->capacity)
+        {
+            uint32_t capacity = (section->capacity == 0U) ? 4096U : (2U * section->capacity);
+            uint32_t *samples = realloc(section->samples, capacity * sizeof(uint32_t));
+
+            if (samples == NULL)
+            {
+                return;
+            }
+            section->samples = samples;
+            section->capacity = capacity;
+        }
+
+        if ((section->count == 0U) || (ns < section->min))
+        {
+            section->min = ns;
+        }
+        if (ns > section->max)
+        {
+            section->max = ns;
+        }
+        section->last = ns;
+        section->total += ns;
+        section->samples[section->count++] = ns;
+        section->sorted = 0;
+    }
+}
+
+void fcs_profile_reset(void)
+{
+    for (int i = 0; i < FCS_PROF_COUNT; i++)
+    {
+        free(prof_sections[i].samples);
+    }
+    memset(prof_sections, 0, sizeof(prof_sections));
+}
+
+int fcs_profile_get(fcs_prof_id_t id, fcs_prof_stats_t *stats)
+{
+    const prof_section_t *section;
+    int ret = -1;
+
+    if ((id < FCS_PROF_COUNT) && (stats != NULL))
+    {
+        section = &prof_sections[id];
+        stats->count = section->count;
+        stats->last_ns = section->last;
+        stats->min_ns = section->min;
+        stats->max_ns = section->max;
+        stats->mean_ns = (section->count != 0U) ? (uint32_t)(section->total / section->count) : 0U;
+        ret = 0;
+    }
+
+    return ret;
+}
+
+/* Nearest rank percentile of the recorded samples */
+uint32_t fcs_profile_percentile(fcs_prof_id_t id, uint16_t permille)
+{
+    prof_section_t *section;
+    uint32_t rank;
+    uint32_t ns = 0U;
+
+    if ((id < FCS_PROF_COUNT) && (prof_sections[id].count != 0U))
+    {
+        section = &prof_sections[id];
+        if (section->sorted == 0)
+        {
+            qsort(section->samples, section->count, sizeof(uint32_t), prof_compare);
+            section->sorted = 1;
+        }
+        if (permille > 1000U)
+        {
+            permille = 1000U;
+        }
+        rank = (uint32_t)(((uint64_t)section->count * permille + 999U) / 1000U);
+        if (rank == 0U)
+        {
+            rank = 1U;
+        }
+        ns = section->samples[rank - 1U];
+    }
+
+    return ns;
+}
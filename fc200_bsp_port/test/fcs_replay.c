@@ -0,0 +1,470 @@
+/****************************************************
+ *  fcs_replay.c
+ *  Replay of a SerdesLog recording through the
+ *  FCS autogen code on the host
+ *  Copyright: LODD (c) 2025
+ ****************************************************/
+
+/*
+Reads a recording of SerdesLog frames, one frame per FCS step as
+send_log_data sends them, and runs controllerMain_step on the logged
+inputs of each frame. The outputs of each step are packed as the target
+packs them and compared with the logged outputs, and the execution time
+of the step and of each model reference is reported as percentiles.
+
+The log does not carry the GCS commands. They are read from a command
+file when one is given, one command per line as
+
+    <logger_time_ms> vom <vom_t value>
+    <logger_time_ms> pic <pic_t value>
+
+and applied to the first frame logged at or after that time. Without a
+command file a mode or pilot in command change in the log is commanded
+in the step it was logged, unless the replay is already in that mode.
+Transitions that the state machine delays, such as the take-off after
+the motor ramp up, then happen later than in the log.
+
+The largest difference of each output is printed and the exit status is
+1 if any is above its tolerance, or with --exact if any output differs
+at all, as for a log written by the same build. With --report the
+differences are only reported, as for a log written by a build of the
+other precision.
+
+    fcs_replay [--exact | --report] <log> [commands]
+*/
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "controllerMain.h"
+#include "serdes_deframe.h"
+#include "fcs_profile.h"
+#include "fcs_log.h"
+
+#define LOG_STATUS_ARMED    (1U)    // LDE_STATUS flags of the lodd MAVLink dialect
+#define LOG_STATUS_IN_AIR   (2U)
+#define LOG_STATUS_PIC_MODE (4U)
+
+/* Compared outputs, in the units of the target after the log scaling */
+typedef enum
+{
+    OUT_VOM = 0,
+    OUT_ARMED,
+    OUT_IN_AIR,
+    OUT_PIC,
+    OUT_MR_EUL_D,
+    OUT_MR_YAWRATE_D,
+    OUT_MR_YAW_HOLD,
+    OUT_CA_NU_DES,
+    OUT_CA_NU_ALLOC,
+    OUT_CA_CERP,
+    OUT_MR_H_D,
+    OUT_MR_HDOT_D,
+    OUT_MR_VEL_NE_D,
+    OUT_FW_ATT_D,
+    OUT_FW_CAS_D,
+    OUT_ROTOR_CVAL,
+    OUT_SERVO_DEG,
+    OUT_PUSHER_PWM,
+    OUT_COUNT
+} output_t;
+
+typedef struct
+{
+    const char *name;
+    unsigned int width;     // values of the output
+    double tolerance;       // largest difference accepted
+} output_def_t;
+
+typedef struct
+{
+    double max;             // largest difference
+    unsigned long frame;    // frame of the largest difference
+    unsigned long over;     // frames above the tolerance
+} output_diff_t;
+
+#define MAX_VALUES 16U
+#define MAX_COMMANDS 256U
+
+/* GCS command of the command file */
+typedef struct
+{
+    unsigned long time_ms;
+    int pic;                // pic_cmd, otherwise vom_cmd
+    int value;
+} command_t;
+
+static command_t commands[MAX_COMMANDS];
+static unsigned int command_count;
+static unsigned int next_command;
+
+static const output_def_t outputs[OUT_COUNT] =
+{
+    {"vom_status", 1U, 0.0},
+    {"armed", 1U, 0.0},
+    {"in_air", 1U, 0.0},
+    {"pic", 1U, 0.0},
+    {"mr_eul_rpy_d (deg)", 3U, 0.05},
+    {"mr_yawrate_d (rad/s)", 1U, 0.005},
+    {"mr_yaw_hold", 1U, 0.0},
+    {"ca_nu_des (N, Nm)", 4U, 1.0},
+    {"ca_nu_alloc (N, Nm)", 4U, 1.0},
+    {"ca_cerp", 3U, 0.002},
+    {"mr_h_d (m)", 1U, 0.05},
+    {"mr_hdot_d (m/s)", 1U, 0.05},
+    {"mr_vel_ne_d (m/s)", 2U, 0.05},
+    {"fw_roll_pitch_d (deg)", 2U, 0.05},
+    {"fw_cas_d (m/s)", 1U, 0.05},
+    {"rotor_cval", 8U, 0.005},
+    {"servo_deg", 12U, 0.05},
+    {"pusher_pwm", 1U, 1.0},
+};
+
+static const char *const sections[FCS_PROF_COUNT] =
+{
+    "controllerMain_step",
+    "system_state_machine",
+    "mc_path_planner",
+    "vel_ctrl_switcher",
+    "altCtrl",
+    "velCtrl",
+    "FW_TECS_switcher",
+    "FW_latGuidance",
+    "FW_TECS",
+    "att_ctrl_switcher",
+    "attCtrl",
+    "MR_CA",
+    "FW_attCtrl_switcher",
+    "FW_attCtrl",
+    "FW_throttle",
+    "FW_CA",
+    "transitionHandler",
+};
+
+/* Values of an output of a frame */
+static unsigned int output_values(const serdes_ss_log_t *f, output_t out, double *v)
+{
+    unsigned int i;
+
+    switch (out)
+    {
+    case OUT_VOM:
+        v[0] = f->fcs_vom_status;
+        break;
+    case OUT_ARMED:
+        v[0] = ((f->fcs_status_flags & LOG_STATUS_ARMED) != 0U);
+        break;
+    case OUT_IN_AIR:
+        v[0] = ((f->fcs_status_flags & LOG_STATUS_IN_AIR) != 0U);
+        break;
+    case OUT_PIC:
+        v[0] = ((f->fcs_status_flags & LOG_STATUS_PIC_MODE) != 0U);
+        break;
+    case OUT_MR_EUL_D:
+        for (i = 0U; i < 3U; i++)
+        {
+            v[i] = f->fcs_mr_eul_rpy_d[i] / 100.0;
+        }
+        break;
+    case OUT_MR_YAWRATE_D:
+        v[0] = f->fcs_mr_yawrate_d;
+        break;
+    case OUT_MR_YAW_HOLD:
+        v[0] = f->fcs_mr_yaw_hold;
+        break;
+    case OUT_CA_NU_DES:
+        for (i = 0U; i < 4U; i++)
+        {
+            v[i] = f->fcs_ca_nu_des[i];
+        }
+        break;
+    case OUT_CA_NU_ALLOC:
+        for (i = 0U; i < 4U; i++)
+        {
+            v[i] = f->fcs_ca_nu_alloc[i];
+        }
+        break;
+    case OUT_CA_CERP:
+        for (i = 0U; i < 3U; i++)
+        {
+            v[i] = f->fcs_ca_cerp[i] / 1000.0;
+        }
+        break;
+    case OUT_MR_H_D:
+        v[0] = f->fcs_mr_h_d;
+        break;
+    case OUT_MR_HDOT_D:
+        v[0] = f->fcs_mr_hdot_d;
+        break;
+    case OUT_MR_VEL_NE_D:
+        v[0] = f->fcs_mr_vel_ne_d[0] / 100.0;
+        v[1] = f->fcs_mr_vel_ne_d[1] / 100.0;
+        break;
+    case OUT_FW_ATT_D:
+        v[0] = f->fcs_fw_roll_d / 100.0;
+        v[1] = f->fcs_fw_pitch_d / 100.0;
+        break;
+    case OUT_FW_CAS_D:
+        v[0] = f->fcs_fw_cas_d / 100.0;
+        break;
+    case OUT_ROTOR_CVAL:
+        for (i = 0U; i < 8U; i++)
+        {
+            v[i] = f->cmd_rotor_cval[i] / 1000.0;
+        }
+        break;
+    case OUT_SERVO_DEG:
+        for (i = 0U; i < 12U; i++)
+        {
+            v[i] = f->cmd_servo_deg[i] / 100.0;
+        }
+        break;
+    case OUT_PUSHER_PWM:
+    default:
+        v[0] = f->cmd_pusher_pwm;
+        break;
+    }
+
+    return outputs[out].width;
+}
+
+static int read_commands(const char *path)
+{
+    char line[128];
+    char kind[8];
+    FILE *in = fopen(path, "r");
+
+    if (in == NULL)
+    {
+        perror(path);
+        return -1;
+    }
+    while ((command_count < MAX_COMMANDS) && (fgets(line, sizeof(line), in) != NULL))
+    {
+        command_t *c = &commands[command_count];
+
+        if (sscanf(line, "%lu %7s %d", &c->time_ms, kind, &c->value) == 3)
+        {
+            c->pic = (strcmp(kind, "pic") == 0);
+            command_count++;
+        }
+    }
+    fclose(in);
+
+    return 0;
+}
+
+/* Commands of the GCS from the command file, up to the time of the frame */
+static void file_commands(const serdes_ss_log_t *frame)
+{
+    while ((next_command < command_count) && (commands[next_command].time_ms <= frame->logger_time_ms))
+    {
+        const command_t *c = &commands[next_command];
+
+        if (c->pic != 0)
+        {
+            controllerMain_U.std_command.pic_cmd = (pic_t)c->value;
+            controllerMain_U.std_command.pic_cmd_cnt++;
+        }
+        else
+        {
+            controllerMain_U.std_command.vom_cmd = (vom_t)c->value;
+            controllerMain_U.std_command.vom_cmd_cnt++;
+        }
+        next_command++;
+    }
+}
+
+/* Commands of the GCS, taken from the mode and pilot in command changes of the log */
+static void inferred_commands(const serdes_ss_log_t *frame, const serdes_ss_log_t *previous)
+{
+    uint16_t pic = frame->fcs_status_flags & LOG_STATUS_PIC_MODE;
+
+    if (((previous == NULL) || (frame->fcs_vom_status != previous->fcs_vom_status)) &&
+        (frame->fcs_vom_status != (uint8_t)controllerMain_Y.fcs_state.vom_status))
+    {
+        controllerMain_U.std_command.vom_cmd = (vom_t)frame->fcs_vom_status;
+        controllerMain_U.std_command.vom_cmd_cnt++;
+    }
+
+    if (((previous == NULL) || (pic != (previous->fcs_status_flags & LOG_STATUS_PIC_MODE))) &&
+        ((pic != 0U) != (controllerMain_Y.fcs_state.pic_status == INTERNAL)))
+    {
+        controllerMain_U.std_command.pic_cmd = (pic != 0U) ? INTERNAL : EXTERNAL;
+        controllerMain_U.std_command.pic_cmd_cnt++;
+    }
+}
+
+static void compare(const serdes_ss_log_t *logged, const serdes_ss_log_t *replayed, unsigned long frame,
+                    double tolerance_scale, output_diff_t *diff)
+{
+    double a[MAX_VALUES];
+    double b[MAX_VALUES];
+    unsigned int n;
+    unsigned int i;
+    int out;
+
+    for (out = 0; out < OUT_COUNT; out++)
+    {
+        int over = 0;
+
+        n = output_values(logged, (output_t)out, a);
+        (void)output_values(replayed, (output_t)out, b);
+        for (i = 0U; i < n; i++)
+        {
+            double d = fabs(a[i] - b[i]);
+
+            if (d > diff[out].max)
+            {
+                diff[out].max = d;
+                diff[out].frame = frame;
+            }
+            if (d > (outputs[out].tolerance * tolerance_scale))
+            {
+                over = 1;
+            }
+        }
+        if (over != 0)
+        {
+            diff[out].over++;
+        }
+    }
+}
+
+static void report_timing(void)
+{
+    fcs_prof_stats_t stats;
+    int id;
+
+    printf("\nsection                  count    mean     p50     p90     p99   p99.9     max (us)\n");
+    for (id = 0; id < FCS_PROF_COUNT; id++)
+    {
+        if ((fcs_profile_get((fcs_prof_id_t)id, &stats) == 0) && (stats.count != 0U))
+        {
+            printf("%-22s %7u %7.2f %7.2f %7.2f %7.2f %7.2f %7.2f\n", sections[id], stats.count,
+                   stats.mean_ns / 1000.0,
+                   fcs_profile_percentile((fcs_prof_id_t)id, 500U) / 1000.0,
+                   fcs_profile_percentile((fcs_prof_id_t)id, 900U) / 1000.0,
+                   fcs_profile_percentile((fcs_prof_id_t)id, 990U) / 1000.0,
+                   fcs_profile_percentile((fcs_prof_id_t)id, 999U) / 1000.0,
+                   stats.max_ns / 1000.0);
+        }
+    }
+}
+
+int main(int argc, char *argv[])
+{
+    static uint8_t buffer[FCS_LOG_FRAME_SIZE];
+    serdes_ss_log_t frame;
+    serdes_ss_log_t previous;
+    serdes_ss_log_t replayed;
+    output_diff_t diff[OUT_COUNT];
+    const char *path = NULL;
+    const char *command_path = NULL;
+    double tolerance_scale = 1.0;
+    int report_only = 0;
+    unsigned long frames = 0UL;
+    unsigned long rejected = 0UL;
+    int failed = 0;
+    int byte;
+    int out;
+    FILE *in;
+
+    for (int i = 1; i < argc; i++)
+    {
+        if (strcmp(argv[i], "--exact") == 0)
+        {
+            tolerance_scale = 0.0;
+        }
+        else if (strcmp(argv[i], "--report") == 0)
+        {
+            report_only = 1;
+        }
+        else if (path == NULL)
+        {
+            path = argv[i];
+        }
+        else
+        {
+            command_path = argv[i];
+        }
+    }
+    if (path == NULL)
+    {
+        fprintf(stderr, "usage: %s [--exact | --report] <log> [commands]\n", argv[0]);
+        return 2;
+    }
+    if ((command_path != NULL) && (read_commands(command_path) != 0))
+    {
+        return 2;
+    }
+    in = fopen(path, "rb");
+    if (in == NULL)
+    {
+        perror(path);
+        return 2;
+    }
+
+    memset(diff, 0, sizeof(diff));
+    memset(&previous, 0, sizeof(previous));
+    controllerMain_initialize();
+    fcs_log_init();
+    fcs_profile_reset();
+
+    // as update_fcs_input_gcs_cmd
+    controllerMain_U.std_command.airspeed_cas_cmd = 25.0;
+    controllerMain_U.std_command.fwrth_apr_deg = 135.0;
+
+    while ((byte = fgetc(in)) != EOF)
+    {
+        if (serdes_deframe((uint8_t)byte, buffer, sizeof(buffer)) != SERDES_SS_LOG_ID)
+        {
+            continue;
+        }
+        if (serdes_unpack_ss_log(buffer, sizeof(buffer), &frame) != 0)
+        {
+            rejected++;
+            continue;
+        }
+
+        if (command_path != NULL)
+        {
+            file_commands(&frame);
+        }
+        else
+        {
+            inferred_commands(&frame, (frames == 0UL) ? NULL : &previous);
+        }
+        fcs_log_stage_inputs(&frame);
+
+        FCS_PROF_BEGIN(FCS_PROF_STEP);
+        controllerMain_step();
+        FCS_PROF_END(FCS_PROF_STEP);
+
+        replayed = frame;
+        fcs_log_pack_outputs(&replayed);
+        compare(&frame, &replayed, frames, tolerance_scale, diff);
+
+        previous = frame;
+        frames++;
+    }
+    fclose(in);
+
+    printf("%lu frames replayed, %lu rejected\n\n", frames, rejected);
+    printf("output                   max difference   at frame   frames over %s\n",
+           (tolerance_scale == 0.0) ? "0" : "tolerance");
+    for (out = 0; out < OUT_COUNT; out++)
+    {
+        printf("%-22s %16.6f %10lu %13lu\n", outputs[out].name, diff[out].max, diff[out].frame, diff[out].over);
+        if ((diff[out].over != 0UL) && (report_only == 0))
+        {
+            failed = 1;
+        }
+    }
+
+    report_timing();
+
+    return ((frames == 0UL) || (failed != 0)) ? 1 : 0;
+}
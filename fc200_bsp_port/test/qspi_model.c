@@ -0,0 +1,582 @@
+/*********************************************************************//**
+\file
+\brief
+  Module Title       : QSPI controller and flash model
+
+  Abstract           : Host model of the generic QSPI controller and of
+                       the flash device, see qspi_model.h.
+*************************************************************************/
+
+/***** Includes *********************************************************/
+
+#include <stdint.h>
+#include <string.h>
+
+#include "host_stubs.h"
+#include "qspi_model.h"
+
+/***** Constants ********************************************************/
+
+#define QSPI_BASEADDR        0xFF0F0000u
+#define REGISTER_SPAN        0x00000900u
+
+/* Register offsets */
+#define CFG_OFFSET           0x100u
+#define ISR_OFFSET           0x104u
+#define TXD_OFFSET           0x11Cu
+#define RXD_OFFSET           0x120u
+#define GENFIFO_OFFSET       0x140u
+#define FIFO_CTRL_OFFSET     0x14Cu
+#define DMA_DST_ADDR_OFFSET  0x800u
+#define DMA_DST_SIZE_OFFSET  0x804u
+#define DMA_DST_STS_OFFSET   0x808u
+#define DMA_DST_I_STS_OFFSET 0x814u
+
+/* Register fields */
+#define CFG_MODE_MASK        0xC0000000u
+#define CFG_MODE_DMA         0x80000000u
+#define CFG_START            0x10000000u
+#define ISR_RXEMPTY          0x00000800u
+#define ISR_TXEMPTY          0x00000100u
+#define ISR_GENFIFOEMPTY     0x00000080u
+#define FIFO_CTRL_RST_RX     0x00000004u
+#define FIFO_CTRL_RST_TX     0x00000002u
+#define FIFO_CTRL_RST_GEN    0x00000001u
+#define DMA_DST_STS_WTC      0x0000E000u
+#define DMA_I_STS_DONE       0x00000002u
+#define DMA_I_STS_ERROR      0x00000004u
+
+/* Generic FIFO entry fields */
+#define GENFIFO_IMMEDIATE    0x000000FFu
+#define GENFIFO_DATA_XFER    0x00000100u
+#define GENFIFO_EXP          0x00000200u
+#define GENFIFO_CS_LOWER     0x00001000u
+#define GENFIFO_TX           0x00010000u
+#define GENFIFO_RX           0x00020000u
+
+/* Flash commands */
+#define COMMAND_WRITE_STATUS 0x01u
+#define COMMAND_READ_STATUS  0x05u
+#define COMMAND_WRITE_ENABLE 0x06u
+#define COMMAND_PROGRAM_4B   0x12u
+#define COMMAND_ERASE_4K_4B  0x21u
+#define COMMAND_SFDP         0x5Au
+#define COMMAND_READ_QUAD_4B 0x6Cu
+
+/* Flash status register */
+#define STATUS_BUSY          0x01u
+#define STATUS_WRITE_ENABLE  0x02u
+#define STATUS_QUAD_ENABLE   0x40u
+
+#define PAGE_BYTES           256u
+#define SUB_SECTOR_BYTES     4096u
+
+#define FIFO_WORDS           256u
+#define COMMAND_BYTES_MAX    (5u + PAGE_BYTES)
+
+/* Time taken by each poll of a status register */
+#define REGISTER_READ_TIME   1u
+
+/* Default timing, a quad read at about 37 MB/s, 0.3 ms to program a page and 50 ms to erase a sub-sector */
+#define COMMAND_TIME         1u
+#define BYTES_PER_US         37u
+#define PROGRAM_TIME         300u
+#define ERASE_TIME           50000u
+
+/***** Type Definitions *************************************************/
+
+typedef struct
+{
+  Bool_t active;
+  Bool_t fail;
+  Bool_t hang;
+  Uint32_t address;
+  Uint32_t destination;
+  Uint32_t length;
+  Uint64_t finish;
+} qspiTransfer_t;
+
+/***** Variables ********************************************************/
+
+qspiModel_Stats_t qspiModel_Stats;
+
+static Uint8_t image[QSPI_MODEL_BYTES];
+
+static Uint32_t registers[REGISTER_SPAN / 4u];
+
+static Uint32_t commandTime;
+static Uint32_t bytesPerMicrosecond;
+static Uint32_t programTime;
+static Uint32_t eraseTime;
+
+static Uint32_t failAddress;
+static Bool_t failArmed;
+static Uint32_t hangAddress;
+static Bool_t hangArmed;
+
+/* Controller FIFOs */
+static Uint32_t txFifo[FIFO_WORDS];
+static Uint32_t txCount;
+static Uint32_t genFifo[FIFO_WORDS];
+static Uint32_t genCount;
+static Uint32_t rxFifo[FIFO_WORDS];
+static Uint32_t rxHead;
+static Uint32_t rxCount;
+
+/* Bytes sent to the device since the chip select was asserted */
+static Uint8_t command[COMMAND_BYTES_MAX];
+static Uint32_t commandLength;
+static Bool_t selected;
+
+/* Device state */
+static Uint8_t statusNonVolatile;
+static Bool_t writeEnabled;
+static Uint64_t busyUntil;
+
+static qspiTransfer_t transfer;
+static Uint32_t dmaInterruptStatus;
+
+/* Serial flash discoverable parameters header, the rest reads as erased */
+static const Uint8_t sfdpTable[16] =
+{
+  0x53u, 0x46u, 0x44u, 0x50u, 0x06u, 0x01u, 0x01u, 0xFFu,
+  0x00u, 0x06u, 0x01u, 0x10u, 0x30u, 0x00u, 0x00u, 0xFFu
+};
+
+/***** Function Declarations ********************************************/
+
+static Uint32_t modelRead(const Uint32_t address);
+static void modelWrite(const Uint32_t address, const Uint32_t value);
+
+/***** Function Definitions *********************************************/
+
+void qspiModel_Reset(void)
+{
+  memset(image, 0xFF, sizeof(image));
+  memset(registers, 0, sizeof(registers));
+  memset(&qspiModel_Stats, 0, sizeof(qspiModel_Stats));
+  memset(&transfer, 0, sizeof(transfer));
+  qspiModel_SetTiming(COMMAND_TIME, BYTES_PER_US, PROGRAM_TIME, ERASE_TIME);
+  failArmed = d_FALSE;
+  hangArmed = d_FALSE;
+  txCount = 0u;
+  genCount = 0u;
+  rxHead = 0u;
+  rxCount = 0u;
+  commandLength = 0u;
+  selected = d_FALSE;
+  statusNonVolatile = 0u;
+  writeEnabled = d_FALSE;
+  busyUntil = 0u;
+  dmaInterruptStatus = 0u;
+
+  host_RegisterSetModel(modelRead, modelWrite);
+}
+
+void qspiModel_SetTiming(const Uint32_t commandMicroseconds, const Uint32_t rate, const Uint32_t program,
+                         const Uint32_t erase)
+{
+  commandTime = commandMicroseconds;
+  bytesPerMicrosecond = rate;
+  programTime = program;
+  eraseTime = erase;
+}
+
+Uint8_t * qspiModel_Image(void)
+{
+  return image;
+}
+
+Uint8_t qspiModel_StatusRegister(void)
+{
+  Uint8_t status = statusNonVolatile;
+
+  if (writeEnabled == d_TRUE)
+  {
+    status |= STATUS_WRITE_ENABLE;
+  }
+  ELSE_DO_NOTHING
+  if (host_TimerMicroseconds() < busyUntil)
+  {
+    status |= STATUS_BUSY;
+  }
+  ELSE_DO_NOTHING
+
+  return status;
+}
+
+void qspiModel_FailRead(const Uint32_t address)
+{
+  failAddress = address;
+  failArmed = d_TRUE;
+}
+
+void qspiModel_HangRead(const Uint32_t address)
+{
+  hangAddress = address;
+  hangArmed = d_TRUE;
+}
+
+Bool_t qspiModel_Busy(void)
+{
+  return transfer.active;
+}
+
+/* Complete the DMA transfer in progress if its time has come */
+static void transferUpdate(void)
+{
+  if ((transfer.active == d_TRUE) && (transfer.hang == d_FALSE) && (host_TimerMicroseconds() >= transfer.finish))
+  {
+    transfer.active = d_FALSE;
+    if (transfer.fail == d_TRUE)
+    {
+      dmaInterruptStatus |= DMA_I_STS_ERROR;
+    }
+    else
+    {
+      Uint8_t * pDestination = (Uint8_t *)(uintptr_t)transfer.destination;
+
+      for (Uint32_t i = 0u; i < transfer.length; i++)
+      {
+        Uint32_t address = transfer.address + i;
+        pDestination[i] = (address < QSPI_MODEL_BYTES) ? image[address] : 0xFFu;
+      }
+      qspiModel_Stats.bytesRead += transfer.length;
+      dmaInterruptStatus |= DMA_I_STS_DONE;
+    }
+  }
+  ELSE_DO_NOTHING
+}
+
+/* Address of a command with a four byte address, most significant byte first */
+static Uint32_t commandAddress(void)
+{
+  return ((Uint32_t)command[1] << 24u) | ((Uint32_t)command[2] << 16u) | ((Uint32_t)command[3] << 8u) |
+         (Uint32_t)command[4];
+}
+
+/* Write enable is required by the commands that change the device, and is cleared by them */
+static Bool_t writeEnableTake(void)
+{
+  Bool_t enabled = writeEnabled;
+
+  if (enabled == d_FALSE)
+  {
+    qspiModel_Stats.protocolErrors++;
+  }
+  ELSE_DO_NOTHING
+  writeEnabled = d_FALSE;
+
+  return enabled;
+}
+
+/* The command sent while the chip select was asserted takes effect when it is de-asserted */
+static void commandComplete(void)
+{
+  if (commandLength == 0u)
+  {
+    return;
+  }
+  ELSE_DO_NOTHING
+
+  if ((host_TimerMicroseconds() < busyUntil) && (command[0] != COMMAND_READ_STATUS))
+  {
+    /* Only the status can be read while the device is busy */
+    qspiModel_Stats.protocolErrors++;
+  }
+  else if (command[0] == COMMAND_WRITE_ENABLE)
+  {
+    writeEnabled = d_TRUE;
+  }
+  else if ((command[0] == COMMAND_WRITE_STATUS) && (commandLength >= 2u))
+  {
+    if (writeEnableTake() == d_TRUE)
+    {
+      statusNonVolatile = command[1] & (Uint8_t)~(STATUS_BUSY | STATUS_WRITE_ENABLE);
+      busyUntil = host_TimerMicroseconds() + programTime;
+    }
+    ELSE_DO_NOTHING
+  }
+  else if ((command[0] == COMMAND_PROGRAM_4B) && (commandLength >= 5u))
+  {
+    if (writeEnableTake() == d_TRUE)
+    {
+      Uint32_t address = commandAddress();
+      Uint32_t page = address & ~(PAGE_BYTES - 1u);
+
+      /* Bits are only cleared, and the address wraps within the page */
+      for (Uint32_t i = 5u; i < commandLength; i++)
+      {
+        Uint32_t target = page + ((address + i - 5u) & (PAGE_BYTES - 1u));
+        if (target < QSPI_MODEL_BYTES)
+        {
+          image[target] &= command[i];
+        }
+        ELSE_DO_NOTHING
+      }
+      qspiModel_Stats.programCommands++;
+      busyUntil = host_TimerMicroseconds() + programTime;
+    }
+    ELSE_DO_NOTHING
+  }
+  else if ((command[0] == COMMAND_ERASE_4K_4B) && (commandLength >= 5u))
+  {
+    if (writeEnableTake() == d_TRUE)
+    {
+      Uint32_t address = commandAddress() & ~(SUB_SECTOR_BYTES - 1u);
+      if (address < QSPI_MODEL_BYTES)
+      {
+        memset(&image[address], 0xFF, SUB_SECTOR_BYTES);
+      }
+      ELSE_DO_NOTHING
+      qspiModel_Stats.eraseCommands++;
+      busyUntil = host_TimerMicroseconds() + eraseTime;
+    }
+    ELSE_DO_NOTHING
+  }
+  else
+  {
+    /* Reads take effect as their data is received */
+    DO_NOTHING();
+  }
+
+  commandLength = 0u;
+}
+
+/* Bytes received from the device, by DMA or into the receive FIFO */
+static void receive(const Uint32_t length, Uint32_t * const pDmaLength)
+{
+  Bool_t dma = ((registers[CFG_OFFSET / 4u] & CFG_MODE_MASK) == CFG_MODE_DMA) ? d_TRUE : d_FALSE;
+
+  if ((dma == d_TRUE) && (command[0] == COMMAND_READ_QUAD_4B) && (commandLength == 5u))
+  {
+    *pDmaLength += length;
+  }
+  else if ((dma == d_FALSE) && (command[0] == COMMAND_READ_STATUS) && (rxCount < FIFO_WORDS))
+  {
+    qspiModel_Stats.statusReads++;
+    rxFifo[(rxHead + rxCount) % FIFO_WORDS] = qspiModel_StatusRegister();
+    rxCount++;
+  }
+  else if ((dma == d_FALSE) && (command[0] == COMMAND_SFDP) && (commandLength == 5u) && (rxCount < FIFO_WORDS))
+  {
+    Uint32_t address = ((Uint32_t)command[1] << 16u) | ((Uint32_t)command[2] << 8u) | (Uint32_t)command[3];
+    Uint32_t word = 0u;
+
+    for (Uint32_t i = 0u; i < 4u; i++)
+    {
+      Uint32_t byte = ((address + i) < sizeof(sfdpTable)) ? sfdpTable[address + i] : 0xFFu;
+      word |= byte << (8u * i);
+    }
+    rxFifo[(rxHead + rxCount) % FIFO_WORDS] = word;
+    rxCount++;
+  }
+  else
+  {
+    qspiModel_Stats.protocolErrors++;
+  }
+}
+
+/* Bytes sent to the device, each transmit FIFO word carries up to four */
+static void transmit(const Uint32_t length)
+{
+  Uint32_t words = (length + 3u) / 4u;
+
+  if (words > txCount)
+  {
+    qspiModel_Stats.protocolErrors++;
+    words = txCount;
+  }
+  ELSE_DO_NOTHING
+
+  for (Uint32_t i = 0u; (i < length) && (i < (words * 4u)); i++)
+  {
+    if (commandLength < COMMAND_BYTES_MAX)
+    {
+      command[commandLength] = (Uint8_t)(txFifo[i / 4u] >> (8u * (i % 4u)));
+      commandLength++;
+    }
+    ELSE_DO_NOTHING
+  }
+
+  memmove(txFifo, &txFifo[words], (txCount - words) * sizeof(txFifo[0]));
+  txCount -= words;
+}
+
+/* Execute the generic FIFO entries */
+static void genFifoStart(void)
+{
+  Uint32_t dmaLength = 0u;
+
+  for (Uint32_t index = 0u; index < genCount; index++)
+  {
+    Uint32_t entry = genFifo[index];
+
+    if (entry == 0u)
+    {
+      /* Dummy entry ending a receive in IO mode */
+      DO_NOTHING();
+    }
+    else if ((entry & GENFIFO_DATA_XFER) == 0u)
+    {
+      if ((entry & GENFIFO_CS_LOWER) != 0u)
+      {
+        /* A new command may not be started while a DMA transfer is in progress */
+        transferUpdate();
+        if (transfer.active == d_TRUE)
+        {
+          qspiModel_Stats.protocolErrors++;
+        }
+        ELSE_DO_NOTHING
+        selected = d_TRUE;
+        commandLength = 0u;
+      }
+      else
+      {
+        commandComplete();
+        selected = d_FALSE;
+      }
+    }
+    else
+    {
+      Uint32_t length = ((entry & GENFIFO_EXP) != 0u) ? (1u << (entry & GENFIFO_IMMEDIATE)) : (entry & GENFIFO_IMMEDIATE);
+
+      if (selected == d_FALSE)
+      {
+        qspiModel_Stats.protocolErrors++;
+      }
+      else if ((entry & GENFIFO_TX) != 0u)
+      {
+        transmit(length);
+      }
+      else if ((entry & GENFIFO_RX) != 0u)
+      {
+        receive(length, &dmaLength);
+      }
+      else
+      {
+        /* Dummy clocks */
+        DO_NOTHING();
+      }
+    }
+  }
+  genCount = 0u;
+
+  if (dmaLength > 0u)
+  {
+    Uint32_t address = commandAddress();
+
+    if (dmaLength != registers[DMA_DST_SIZE_OFFSET / 4u])
+    {
+      qspiModel_Stats.protocolErrors++;
+    }
+    ELSE_DO_NOTHING
+    qspiModel_Stats.readCommands++;
+    transfer.active = d_TRUE;
+    transfer.address = address;
+    transfer.destination = registers[DMA_DST_ADDR_OFFSET / 4u];
+    transfer.length = dmaLength;
+    transfer.fail = ((failArmed == d_TRUE) && (failAddress == address)) ? d_TRUE : d_FALSE;
+    transfer.hang = ((hangArmed == d_TRUE) && (hangAddress == address)) ? d_TRUE : d_FALSE;
+    failArmed = (transfer.fail == d_TRUE) ? d_FALSE : failArmed;
+    hangArmed = (transfer.hang == d_TRUE) ? d_FALSE : hangArmed;
+    transfer.finish = host_TimerMicroseconds() + commandTime + (dmaLength / bytesPerMicrosecond);
+  }
+  ELSE_DO_NOTHING
+}
+
+static Uint32_t modelRead(const Uint32_t address)
+{
+  Uint32_t offset = address - QSPI_BASEADDR;
+  Uint32_t value = 0u;
+
+  if (offset == ISR_OFFSET)
+  {
+    /* The generic FIFO is executed when started, so it and the transmit FIFO are always empty when polled */
+    host_TimerAdvance(REGISTER_READ_TIME);
+    value = ISR_GENFIFOEMPTY | ISR_TXEMPTY | ((rxCount == 0u) ? ISR_RXEMPTY : 0u);
+  }
+  else if (offset == RXD_OFFSET)
+  {
+    if (rxCount > 0u)
+    {
+      value = rxFifo[rxHead];
+      rxHead = (rxHead + 1u) % FIFO_WORDS;
+      rxCount--;
+    }
+    ELSE_DO_NOTHING
+  }
+  else if (offset == DMA_DST_I_STS_OFFSET)
+  {
+    host_TimerAdvance(REGISTER_READ_TIME);
+    transferUpdate();
+    value = dmaInterruptStatus;
+  }
+  else if (offset < REGISTER_SPAN)
+  {
+    value = registers[offset / 4u];
+  }
+  ELSE_DO_NOTHING
+
+  return value;
+}
+
+static void modelWrite(const Uint32_t address, const Uint32_t value)
+{
+  Uint32_t offset = address - QSPI_BASEADDR;
+
+  if (offset == CFG_OFFSET)
+  {
+    registers[offset / 4u] = value & ~CFG_START;
+    if ((value & CFG_START) != 0u)
+    {
+      genFifoStart();
+    }
+    ELSE_DO_NOTHING
+  }
+  else if (offset == TXD_OFFSET)
+  {
+    if (txCount < FIFO_WORDS)
+    {
+      txFifo[txCount] = value;
+      txCount++;
+    }
+    ELSE_DO_NOTHING
+  }
+  else if (offset == GENFIFO_OFFSET)
+  {
+    if (genCount < FIFO_WORDS)
+    {
+      genFifo[genCount] = value;
+      genCount++;
+    }
+    ELSE_DO_NOTHING
+  }
+  else if (offset == FIFO_CTRL_OFFSET)
+  {
+    rxCount = ((value & FIFO_CTRL_RST_RX) != 0u) ? 0u : rxCount;
+    txCount = ((value & FIFO_CTRL_RST_TX) != 0u) ? 0u : txCount;
+    genCount = ((value & FIFO_CTRL_RST_GEN) != 0u) ? 0u : genCount;
+  }
+  else if (offset == DMA_DST_STS_OFFSET)
+  {
+    /* Clearing the status abandons the transfer in progress, as the driver's reset does */
+    if (((value & DMA_DST_STS_WTC) != 0u) && (transfer.active == d_TRUE))
+    {
+      qspiModel_Stats.aborts++;
+      transfer.active = d_FALSE;
+      selected = d_FALSE;
+      commandLength = 0u;
+    }
+    ELSE_DO_NOTHING
+  }
+  else if (offset == DMA_DST_I_STS_OFFSET)
+  {
+    dmaInterruptStatus &= ~value;
+  }
+  else if (offset < REGISTER_SPAN)
+  {
+    registers[offset / 4u] = value;
+  }
+  ELSE_DO_NOTHING
+}
@@ -0,0 +1,75 @@
+/*********************************************************************//**
+\file
+\brief
+  Module Title       : QSPI controller and flash model
+
+  Abstract           : Register model of the generic QSPI controller and
+                       of the flash device behind it, installed with
+                       host_RegisterSetModel. The generic FIFO entries are
+                       executed when the driver starts the FIFO: the bytes
+                       sent make up the flash command, a receive in DMA
+                       mode copies the flash contents to the destination
+                       address when the transfer completes, and one in IO
+                       mode fills the receive FIFO. The device implements
+                       the read, program, erase, status and SFDP commands
+                       used by the driver, with the times taken measured
+                       on the timer model of the host stubs. A command
+                       started while a DMA transfer is still in progress,
+                       or a program or erase without write enable, is
+                       counted as a protocol error.
+*************************************************************************/
+
+#ifndef QSPI_MODEL_H
+#define QSPI_MODEL_H
+
+/***** Includes *********************************************************/
+
+#include "soc/defines/d_common_types.h"
+
+/***** Constants ********************************************************/
+
+/* Size of the flash image, reads beyond it return erased bytes */
+#define QSPI_MODEL_BYTES        0x00100000u
+
+/***** Type Definitions *************************************************/
+
+typedef struct
+{
+  Uint32_t readCommands;     // quad output fast reads
+  Uint32_t bytesRead;
+  Uint32_t programCommands;
+  Uint32_t eraseCommands;
+  Uint32_t statusReads;
+  Uint32_t aborts;           // DMA transfers abandoned by a controller reset
+  Uint32_t protocolErrors;   // commands the device or controller would not accept
+} qspiModel_Stats_t;
+
+/***** Variables ********************************************************/
+
+extern qspiModel_Stats_t qspiModel_Stats;
+
+/***** Function Declarations ********************************************/
+
+/* Erased flash with quad mode not yet enabled, default timing and no fault, installs the register model */
+void qspiModel_Reset(void);
+
+/* Times in microseconds of a read command, of a page program and of a sub-sector erase, and the read rate */
+void qspiModel_SetTiming(const Uint32_t command, const Uint32_t bytesPerMicrosecond, const Uint32_t program,
+                         const Uint32_t erase);
+
+/* Contents of the flash image */
+Uint8_t * qspiModel_Image(void);
+
+/* Status register of the device */
+Uint8_t qspiModel_StatusRegister(void);
+
+/* The next read from this address ends with a DMA error */
+void qspiModel_FailRead(const Uint32_t address);
+
+/* The next read from this address never completes */
+void qspiModel_HangRead(const Uint32_t address);
+
+/* A DMA transfer has been started and has not completed or been abandoned */
+Bool_t qspiModel_Busy(void);
+
+#endif /* QSPI_MODEL_H */
@@ -0,0 +1,364 @@
+/*********************************************************************//**
+\file
+\brief
+  Module Title       : SD controller and card model
+
+  Abstract           : Host implementation of the XSdPs driver functions
+                       used by the MMC interface, see sd_model.h.
+*************************************************************************/
+
+/***** Includes *********************************************************/
+
+#include <stdint.h>
+#include <string.h>
+
+#include "xparameters.h"
+#include "xsdps.h"
+#include "xsdps_core.h"
+#include "host_stubs.h"
+#include "sd_model.h"
+
+/***** Constants ********************************************************/
+
+/* Ready value of a Xilinx driver instance */
+#define COMPONENT_IS_READY  0x11111111u
+
+/* Time taken by a read of a controller register */
+#define REGISTER_READ_TIME  1u
+
+/* Default timing, a card at 25 MB/s taking 2 ms to program a write */
+#define COMMAND_TIME        100u
+#define SECTOR_TIME         20u
+#define WRITE_BUSY_TIME     2000u
+
+/***** Type Definitions *************************************************/
+
+typedef struct
+{
+  Bool_t active;
+  Bool_t write;
+  Bool_t fail;
+  Bool_t hang;
+  Uint32_t sector;
+  Uint32_t count;
+  Uint64_t finish;
+} sdTransfer_t;
+
+/***** Variables ********************************************************/
+
+sdModel_Stats_t sdModel_Stats;
+
+static Uint8_t card[SD_MODEL_SECTORS][SD_MODEL_SECTOR_SIZE];
+
+static XSdPs_Config config =
+{
+  XPAR_XSDPS_0_DEVICE_ID, XPAR_XSDPS_0_BASEADDR, 200000000u, 1u, 0u, 4u, 0u, 0u, 1u
+};
+
+static Uint32_t commandTime;
+static Uint32_t sectorTime;
+static Uint32_t writeBusyTime;
+static Bool_t failNext;
+static Bool_t hangNext;
+
+static sdTransfer_t transfer;
+static Uint32_t admaAddress;
+static Uint8_t hostVersion;
+static Uint16_t normalStatus;
+static Uint16_t errorStatus;
+
+/***** Function Definitions *********************************************/
+
+void sdModel_Reset(void)
+{
+  memset(card, 0, sizeof(card));
+  memset(&sdModel_Stats, 0, sizeof(sdModel_Stats));
+  memset(&transfer, 0, sizeof(transfer));
+  sdModel_SetTiming(COMMAND_TIME, SECTOR_TIME, WRITE_BUSY_TIME);
+  failNext = d_FALSE;
+  hangNext = d_FALSE;
+  normalStatus = 0u;
+  errorStatus = 0u;
+  hostVersion = XSDPS_HC_SPEC_V3;
+}
+
+void sdModel_SetTiming(const Uint32_t command, const Uint32_t sector, const Uint32_t writeBusy)
+{
+  commandTime = command;
+  sectorTime = sector;
+  writeBusyTime = writeBusy;
+}
+
+Uint8_t * sdModel_Sector(const Uint32_t sector)
+{
+  return &card[sector % SD_MODEL_SECTORS][0];
+}
+
+void sdModel_FailNext(void)
+{
+  failNext = d_TRUE;
+}
+
+void sdModel_HangNext(void)
+{
+  hangNext = d_TRUE;
+}
+
+Bool_t sdModel_Busy(void)
+{
+  return transfer.active;
+}
+
+/* Move the data of the transfer through the descriptor table, returns d_FALSE if the table does not match it */
+static Bool_t admaCopy(void)
+{
+  Uint32_t remaining = transfer.count * SD_MODEL_SECTOR_SIZE;
+  Uint8_t * pCard = &card[transfer.sector][0];
+  Bool_t end = d_FALSE;
+  Uint32_t index = 0u;
+
+  while ((end == d_FALSE) && (remaining > 0u) && (index < d_MMC_ADMA_DESCRIPTORS))
+  {
+    Uint16_t attribute;
+    Uint32_t length;
+    Uint8_t * pBuffer;
+
+    if (hostVersion == XSDPS_HC_SPEC_V3)
+    {
+      const XSdPs_Adma2Descriptor64 * pTable = (const XSdPs_Adma2Descriptor64 *)(uintptr_t)admaAddress;
+      attribute = pTable[index].Attribute;
+      length = pTable[index].Length;
+      pBuffer = (Uint8_t *)(uintptr_t)pTable[index].Address;
+    }
+    else
+    {
+      const XSdPs_Adma2Descriptor32 * pTable = (const XSdPs_Adma2Descriptor32 *)(uintptr_t)admaAddress;
+      attribute = pTable[index].Attribute;
+      length = pTable[index].Length;
+      pBuffer = (Uint8_t *)(uintptr_t)pTable[index].Address;
+    }
+
+    if ((attribute & (XSDPS_DESC_VALID | XSDPS_DESC_TRAN)) != (XSDPS_DESC_VALID | XSDPS_DESC_TRAN))
+    {
+      return d_FALSE;
+    }
+    ELSE_DO_NOTHING
+
+    /* A length of zero means 64 kB */
+    length = (length == 0u) ? XSDPS_DESC_MAX_LENGTH : length;
+    length = (length < remaining) ? length : remaining;
+    if (transfer.write == d_TRUE)
+    {
+      memcpy(pCard, pBuffer, length);
+    }
+    else
+    {
+      memcpy(pBuffer, pCard, length);
+    }
+    pCard += length;
+    remaining -= length;
+    end = ((attribute & XSDPS_DESC_END) != 0u) ? d_TRUE : d_FALSE;
+    index++;
+  }
+
+  return ((remaining == 0u) && (end == d_TRUE)) ? d_TRUE : d_FALSE;
+}
+
+/* Complete the transfer in progress if its time has come */
+static void transferUpdate(void)
+{
+  if ((transfer.active == d_TRUE) && (transfer.hang == d_FALSE) && (host_TimerMicroseconds() >= transfer.finish))
+  {
+    transfer.active = d_FALSE;
+    if (transfer.fail == d_TRUE)
+    {
+      /* Data CRC error */
+      errorStatus |= 0x0020u;
+      normalStatus |= XSDPS_INTR_ERR_MASK;
+    }
+    else if (admaCopy() == d_TRUE)
+    {
+      if (transfer.write == d_TRUE)
+      {
+        sdModel_Stats.sectorsWritten += transfer.count;
+      }
+      else
+      {
+        sdModel_Stats.sectorsRead += transfer.count;
+      }
+      normalStatus |= XSDPS_INTR_TC_MASK;
+    }
+    else
+    {
+      /* ADMA error */
+      sdModel_Stats.protocolErrors++;
+      errorStatus |= 0x0200u;
+      normalStatus |= XSDPS_INTR_ERR_MASK;
+    }
+  }
+  ELSE_DO_NOTHING
+}
+
+XSdPs_Config * XSdPs_LookupConfig(u16 DeviceId)
+{
+  return (DeviceId == XPAR_XSDPS_0_DEVICE_ID) ? &config : NULL;
+}
+
+s32 XSdPs_CfgInitialize(XSdPs * InstancePtr, XSdPs_Config * ConfigPtr, u32 EffectiveAddr)
+{
+  memset(InstancePtr, 0, sizeof(*InstancePtr));
+  InstancePtr->Config = *ConfigPtr;
+  InstancePtr->Config.BaseAddress = EffectiveAddr;
+  InstancePtr->HC_Version = hostVersion;
+  InstancePtr->IsReady = COMPONENT_IS_READY;
+
+  return XST_SUCCESS;
+}
+
+/* A high capacity card, addressed in blocks */
+s32 XSdPs_CardInitialize(XSdPs * InstancePtr)
+{
+  InstancePtr->HCS = 1u;
+  InstancePtr->SectorCount = SD_MODEL_SECTORS;
+  InstancePtr->BlkSize = SD_MODEL_SECTOR_SIZE;
+
+  return XST_SUCCESS;
+}
+
+s32 XSdPs_SetupTransfer(XSdPs * InstancePtr)
+{
+  return (transfer.active == d_TRUE) ? XST_FAILURE : XST_SUCCESS;
+}
+
+s32 XSdPs_CmdTransfer(XSdPs * InstancePtr, u32 Cmd, u32 Arg, u32 BlkCnt)
+{
+  Uint16_t mode = InstancePtr->TransferMode;
+  Bool_t write = ((Cmd == CMD24) || (Cmd == CMD25)) ? d_TRUE : d_FALSE;
+  Bool_t multiple = ((Cmd == CMD18) || (Cmd == CMD25)) ? d_TRUE : d_FALSE;
+
+  if (Cmd == CMD12)
+  {
+    sdModel_Stats.stopCommands++;
+    return XST_SUCCESS;
+  }
+  ELSE_DO_NOTHING
+
+  if ((Cmd != CMD17) && (Cmd != CMD18) && (Cmd != CMD24) && (Cmd != CMD25))
+  {
+    return XST_FAILURE;
+  }
+  ELSE_DO_NOTHING
+
+  /* The transfer mode must agree with the command */
+  if ((transfer.active == d_TRUE) || (BlkCnt == 0u) || ((Arg + BlkCnt) > SD_MODEL_SECTORS) ||
+      ((multiple == d_FALSE) && (BlkCnt != 1u)) ||
+      ((mode & XSDPS_TM_DMA_EN_MASK) == 0u) ||
+      (((mode & XSDPS_TM_DAT_DIR_SEL_MASK) != 0u) == (write == d_TRUE)) ||
+      (((mode & XSDPS_TM_MUL_SIN_BLK_SEL_MASK) != 0u) != (multiple == d_TRUE)) ||
+      ((multiple == d_TRUE) && ((mode & XSDPS_TM_AUTO_CMD12_EN_MASK) == 0u)))
+  {
+    sdModel_Stats.protocolErrors++;
+    return XST_FAILURE;
+  }
+  ELSE_DO_NOTHING
+
+  if (write == d_TRUE)
+  {
+    sdModel_Stats.writeCommands++;
+    if (BlkCnt > sdModel_Stats.maxWriteSectors)
+    {
+      sdModel_Stats.maxWriteSectors = BlkCnt;
+    }
+    ELSE_DO_NOTHING
+  }
+  else
+  {
+    sdModel_Stats.readCommands++;
+  }
+
+  transfer.active = d_TRUE;
+  transfer.write = write;
+  transfer.sector = Arg;
+  transfer.count = BlkCnt;
+  transfer.fail = failNext;
+  transfer.hang = hangNext;
+  transfer.finish = host_TimerMicroseconds() + commandTime + (BlkCnt * sectorTime) +
+                    ((write == d_TRUE) ? writeBusyTime : 0u);
+  failNext = d_FALSE;
+  hangNext = d_FALSE;
+
+  return XST_SUCCESS;
+}
+
+u8 XSdPs_ReadReg8(u32 BaseAddress, u32 RegOffset)
+{
+  host_TimerAdvance(REGISTER_READ_TIME);
+
+  /* The line resets complete at once */
+  return 0u;
+}
+
+void XSdPs_WriteReg8(u32 BaseAddress, u32 RegOffset, u8 Data)
+{
+  if ((RegOffset == XSDPS_SW_RST_OFFSET) && ((Data & XSDPS_SWRST_DAT_LINE_MASK) != 0u))
+  {
+    sdModel_Stats.lineResets++;
+    transfer.active = d_FALSE;
+  }
+  ELSE_DO_NOTHING
+}
+
+u16 XSdPs_ReadReg16(u32 BaseAddress, u32 RegOffset)
+{
+  Uint16_t value = 0u;
+
+  host_TimerAdvance(REGISTER_READ_TIME);
+  transferUpdate();
+
+  if (RegOffset == XSDPS_NORM_INTR_STS_OFFSET)
+  {
+    value = normalStatus;
+  }
+  else if (RegOffset == XSDPS_ERR_INTR_STS_OFFSET)
+  {
+    value = errorStatus;
+  }
+  ELSE_DO_NOTHING
+
+  return value;
+}
+
+/* Interrupt status bits are cleared by writing one, the error summary clears with the error bits */
+void XSdPs_WriteReg16(u32 BaseAddress, u32 RegOffset, u16 Data)
+{
+  if (RegOffset == XSDPS_NORM_INTR_STS_OFFSET)
+  {
+    normalStatus &= (Uint16_t)~(Data & (Uint16_t)~XSDPS_INTR_ERR_MASK);
+  }
+  else if (RegOffset == XSDPS_ERR_INTR_STS_OFFSET)
+  {
+    errorStatus &= (Uint16_t)~Data;
+    if (errorStatus == 0u)
+    {
+      normalStatus &= (Uint16_t)~XSDPS_INTR_ERR_MASK;
+    }
+    ELSE_DO_NOTHING
+  }
+  ELSE_DO_NOTHING
+}
+
+u32 XSdPs_ReadReg(u32 BaseAddress, u32 RegOffset)
+{
+  host_TimerAdvance(REGISTER_READ_TIME);
+
+  return (RegOffset == XSDPS_ADMA_SAR_OFFSET) ? admaAddress : 0u;
+}
+
+void XSdPs_WriteReg(u32 BaseAddress, u32 RegOffset, u32 Data)
+{
+  if (RegOffset == XSDPS_ADMA_SAR_OFFSET)
+  {
+    admaAddress = Data;
+  }
+  ELSE_DO_NOTHING
+}
@@ -0,0 +1,67 @@
+/*********************************************************************//**
+\file
+\brief
+  Module Title       : SD controller and card model
+
+  Abstract           : Model of the SD host controller and of the card
+                       behind the XSdPs driver functions used by the MMC
+                       interface. Read and write commands walk the ADMA2
+                       descriptor table set up by the interface and move
+                       the data between the buffers and a card image when
+                       the transfer completes. A transfer takes a command
+                       time, a time per sector and, for a write, the time
+                       the card stays busy programming, all measured on
+                       the timer model of the host stubs.
+*************************************************************************/
+
+#ifndef SD_MODEL_H
+#define SD_MODEL_H
+
+/***** Includes *********************************************************/
+
+#include "soc/defines/d_common_types.h"
+
+/***** Constants ********************************************************/
+
+#define SD_MODEL_SECTOR_SIZE  512u
+#define SD_MODEL_SECTORS      8192u
+
+/***** Type Definitions *************************************************/
+
+typedef struct
+{
+  Uint32_t readCommands;     // CMD17 and CMD18
+  Uint32_t writeCommands;    // CMD24 and CMD25
+  Uint32_t sectorsRead;
+  Uint32_t sectorsWritten;
+  Uint32_t stopCommands;     // CMD12 sent by the interface
+  Uint32_t lineResets;
+  Uint32_t protocolErrors;   // commands inconsistent with the transfer mode or descriptors
+  Uint32_t maxWriteSectors;  // largest write command
+} sdModel_Stats_t;
+
+/***** Variables ********************************************************/
+
+extern sdModel_Stats_t sdModel_Stats;
+
+/***** Function Declarations ********************************************/
+
+/* Blank card, default timing and no fault */
+void sdModel_Reset(void);
+
+/* Times in microseconds of a command, of each sector and of the card busy after a write */
+void sdModel_SetTiming(const Uint32_t command, const Uint32_t sector, const Uint32_t writeBusy);
+
+/* Contents of a sector of the card */
+Uint8_t * sdModel_Sector(const Uint32_t sector);
+
+/* The next data transfer ends with a data error */
+void sdModel_FailNext(void);
+
+/* The next data transfer never completes */
+void sdModel_HangNext(void);
+
+/* Data transfers started and not yet completed or aborted */
+Bool_t sdModel_Busy(void);
+
+#endif /* SD_MODEL_H */
@@ -0,0 +1,264 @@
+/*********************************************************************//**
+\file
+\brief
+  Module Title       : Host stubs
+
+  Abstract           : Host implementations of the error logger, the
+                       critical sections and the global timer used by the
+                       modules under test, with the register access
+                       functions passed on to the model of the test.
+*************************************************************************/
+
+/***** Includes *********************************************************/
+
+#include <stdio.h>
+#include <string.h>
+
+#include "soc/defines/d_common_types.h"
+#include "soc/defines/d_common_status.h"
+#include "kernel/error_handler/d_error_handler.h"
+#include "soc/interrupt_manager/d_int_critical.h"
+#include "soc/timer/d_timer.h"
+#include "soc/timer/d_timer_counter.h"
+#include "soc/dma/d_dma_copy.h"
+#include "soc/memory_manager/d_memory_cache.h"
+#include "kernel/general/d_gen_register.h"
+#include "host_stubs.h"
+
+/***** Constants ********************************************************/
+
+/* The global timer runs at d_TIMER_TICKS_PER_SECOND, 25 ticks per 16 microseconds */
+#define TICKS_PER_16_US  25u
+
+/* Status register of code running in system mode with interrupts enabled */
+#define CPSR_SYSTEM_MODE  0x1Fu
+
+/***** Variables ********************************************************/
+
+Uint32_t host_ErrorCount;
+d_Status_t host_ErrorLast;
+
+Int32_t host_CriticalDepth;
+
+Uint32_t host_Cpsr = CPSR_SYSTEM_MODE;
+
+/* Time of the timer model in sixteenths of a microsecond */
+static Uint64_t timeSixteenths;
+
+static host_TimerHook_t timerHook;
+static Uint32_t readCost;
+
+static host_RegisterRead_t registerRead;
+static host_RegisterWrite_t registerWrite;
+
+/* Set while the hook runs so that timer reads in the hook do not recurse */
+static Bool_t inHook;
+
+/***** Function Definitions *********************************************/
+
+void host_Reset(void)
+{
+  host_ErrorCount = 0u;
+  host_ErrorLast = d_STATUS_SUCCESS;
+  host_CriticalDepth = 0;
+  host_Cpsr = CPSR_SYSTEM_MODE;
+  timeSixteenths = 0u;
+  timerHook = NULL;
+  readCost = 0u;
+  inHook = d_FALSE;
+  registerRead = NULL;
+  registerWrite = NULL;
+}
+
+void host_TimerAdvance(const Uint32_t microseconds)
+{
+  timeSixteenths += (Uint64_t)microseconds * 16u;
+
+  if ((timerHook != NULL) && (inHook == d_FALSE))
+  {
+    inHook = d_TRUE;
+    timerHook();
+    inHook = d_FALSE;
+  }
+}
+
+Uint64_t host_TimerMicroseconds(void)
+{
+  return timeSixteenths / 16u;
+}
+
+void host_TimerSetHook(const host_TimerHook_t hook)
+{
+  timerHook = hook;
+}
+
+void host_TimerSetReadCost(const Uint32_t microseconds)
+{
+  readCost = microseconds;
+}
+
+void host_RegisterSetModel(const host_RegisterRead_t read, const host_RegisterWrite_t write)
+{
+  registerRead = read;
+  registerWrite = write;
+}
+
+void d_ERROR_LogRaw(const Char_t * const eModule, const Uint32_t eLine, const d_Status_t eType,
+                    const d_ERROR_Criticality_t eCriticality, const Uint32_t eData0, const Uint32_t eData1,
+                    const Uint32_t eData2, const Uint32_t eData3)
+{
+  (void)eModule;
+  (void)eLine;
+  (void)eCriticality;
+  (void)eData0;
+  (void)eData1;
+  (void)eData2;
+  (void)eData3;
+
+  host_ErrorCount++;
+  host_ErrorLast = eType;
+}
+
+Uint32_t d_INT_CriticalSectionEnter(void)
+{
+  host_CriticalDepth++;
+  return 0u;
+}
+
+void d_INT_CriticalSectionLeave(Uint32_t statusRegister)
+{
+  (void)statusRegister;
+  host_CriticalDepth--;
+}
+
+void d_TIMER_Initialise(void)
+{
+}
+
+Uint32_t d_TIMER_ReadValueInTicks(void)
+{
+  if (readCost != 0u)
+  {
+    host_TimerAdvance(readCost);
+  }
+  ELSE_DO_NOTHING
+
+  return (Uint32_t)((timeSixteenths * TICKS_PER_16_US) / 256u);
+}
+
+Uint32_t d_TIMER_ElapsedMicroseconds(const Uint32_t start, Uint32_t * const now)
+{
+  Uint32_t current = d_TIMER_ReadValueInTicks();
+
+  if (now != NULL)
+  {
+    *now = current;
+  }
+  ELSE_DO_NOTHING
+
+  return (Uint32_t)(((Uint64_t)(Uint32_t)(current - start) * 16u) / TICKS_PER_16_US);
+}
+
+Uint32_t d_TIMER_ElapsedMilliseconds(const Uint32_t start, Uint32_t * const now)
+{
+  return d_TIMER_ElapsedMicroseconds(start, now) / 1000u;
+}
+
+d_Status_t d_TIMER_DelayMicroseconds(const Uint32_t delay)
+{
+  host_TimerAdvance(delay);
+  return d_STATUS_SUCCESS;
+}
+
+d_Status_t d_TIMER_DelayMilliseconds(const Uint32_t delay)
+{
+  host_TimerAdvance(delay * 1000u);
+  return d_STATUS_SUCCESS;
+}
+
+void d_GEN_RegisterWrite(const Uint32_t Addr, const Uint32_t Value)
+{
+  if (registerWrite != NULL)
+  {
+    registerWrite(Addr, Value);
+  }
+  ELSE_DO_NOTHING
+}
+
+void d_GEN_RegisterWriteMask(const Uint32_t Addr, const Uint32_t Mask, const Uint32_t Value)
+{
+  d_GEN_RegisterWrite(Addr, (d_GEN_RegisterRead(Addr) & ~Mask) | (Value & Mask));
+}
+
+Uint32_t d_GEN_RegisterRead(Uint32_t Addr)
+{
+  Uint32_t value = 0u;
+
+  if (registerRead != NULL)
+  {
+    value = registerRead(Addr);
+  }
+  ELSE_DO_NOTHING
+
+  return value;
+}
+
+Uint64_t d_GEN_RegisterRead64(const Uint32_t address)
+{
+  return (Uint64_t)d_GEN_RegisterRead(address) | ((Uint64_t)d_GEN_RegisterRead(address + 4u) << 32u);
+}
+
+void d_GEN_RegisterWrite64(const Uint32_t address, const Uint64_t value)
+{
+  d_GEN_RegisterWrite(address, (Uint32_t)value);
+  d_GEN_RegisterWrite(address + 4u, (Uint32_t)(value >> 32u));
+}
+
+/* The counter timers are not modelled, the global timer is the only time source */
+d_Status_t d_TIMER_Configure(const d_Timer_t timer, const Bool_t prescalerEnable, const Uint32_t prescalerValue)
+{
+  (void)timer;
+  (void)prescalerEnable;
+  (void)prescalerValue;
+  return d_STATUS_SUCCESS;
+}
+
+d_Status_t d_TIMER_Options(const d_Timer_t timer, const Bool_t intervalMode)
+{
+  (void)timer;
+  (void)intervalMode;
+  return d_STATUS_SUCCESS;
+}
+
+d_Status_t d_TIMER_Interval(const d_Timer_t timer, const Uint32_t interval)
+{
+  (void)timer;
+  (void)interval;
+  return d_STATUS_SUCCESS;
+}
+
+d_Status_t d_TIMER_Start(const d_Timer_t timer)
+{
+  (void)timer;
+  return d_STATUS_SUCCESS;
+}
+
+/* Copies made by the DMA engine on the target are plain copies on the host,
+   unless the test links the DMA copy service itself */
+__attribute__((weak)) void d_DMA_Copy(Uint8_t * const pDestination, const Uint8_t * const pSource, const Uint32_t length)
+{
+  memcpy(pDestination, pSource, length);
+}
+
+/* Host memory is coherent, the data cache maintenance has nothing to do */
+void d_MEMORY_DCacheInvalidateRange(const Pointer_t address, Uint32_t length)
+{
+  (void)address;
+  (void)length;
+}
+
+void d_MEMORY_DCacheFlushRange(const Pointer_t address, Uint32_t length)
+{
+  (void)address;
+  (void)length;
+}
@@ -0,0 +1,66 @@
+/*********************************************************************//**
+\file
+\brief
+  Module Title       : Host stubs
+
+  Abstract           : Host implementations of the error logger, the
+                       critical sections and the global timer used by the
+                       modules under test. The timer is a model that only
+                       advances when a test moves it on, and a hook lets
+                       the test raise its tick interrupt on the way.
+                       Register accesses go to a model installed by the
+                       test, the data cache maintenance does nothing and
+                       DMA copies are made by the CPU unless the test
+                       links the DMA copy service.
+*************************************************************************/
+
+#ifndef HOST_STUBS_H
+#define HOST_STUBS_H
+
+/***** Includes *********************************************************/
+
+#include "soc/defines/d_common_types.h"
+#include "soc/defines/d_common_status.h"
+
+/***** Type Definitions *************************************************/
+
+/* Called by the timer model each time the time moves on */
+typedef void (*host_TimerHook_t)(void);
+
+/* Register model, called for each register access by integer address */
+typedef Uint32_t (*host_RegisterRead_t)(const Uint32_t address);
+typedef void (*host_RegisterWrite_t)(const Uint32_t address, const Uint32_t value);
+
+/***** Variables ********************************************************/
+
+/* Number of errors logged and the type of the last one */
+extern Uint32_t host_ErrorCount;
+extern d_Status_t host_ErrorLast;
+
+/* Critical sections currently entered */
+extern Int32_t host_CriticalDepth;
+
+/* Current program status register read by d_mfcpsr, system mode after a reset */
+extern Uint32_t host_Cpsr;
+
+/***** Function Declarations ********************************************/
+
+/* Set the timer model to zero and clear the error count */
+void host_Reset(void);
+
+/* Move the timer model on by a number of microseconds */
+void host_TimerAdvance(const Uint32_t microseconds);
+
+/* Microseconds since the last reset */
+Uint64_t host_TimerMicroseconds(void);
+
+/* Install the hook called each time the timer moves on, NULL for none */
+void host_TimerSetHook(const host_TimerHook_t hook);
+
+/* Time in microseconds taken by each read of the timer, 0 by default */
+void host_TimerSetReadCost(const Uint32_t microseconds);
+
+/* Install the register model, reads give zero and writes are ignored without one */
+void host_RegisterSetModel(const host_RegisterRead_t read, const host_RegisterWrite_t write);
+
+#endif /* HOST_STUBS_H */
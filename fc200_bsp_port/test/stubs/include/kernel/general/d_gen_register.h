@@ -0,0 +1,37 @@
+/*********************************************************************//**
+\file
+\brief
+  Module Title       : Host replacement of the register access functions
+
+  Abstract           : Register accesses by integer address are passed to
+                       the register model installed by the test with
+                       host_RegisterSetModel. Accesses by pointer are
+                       plain memory accesses as on the target.
+*************************************************************************/
+
+#ifndef D_GEN_REGISTER_H
+#define D_GEN_REGISTER_H
+
+/***** Includes *********************************************************/
+
+#include "soc/defines/d_common_types.h"
+
+/***** Function Declarations ********************************************/
+
+void d_GEN_RegisterWrite(const Uint32_t Addr, const Uint32_t Value);
+
+void d_GEN_RegisterWriteMask(const Uint32_t Addr, const Uint32_t Mask, const Uint32_t Value);
+
+Uint32_t d_GEN_RegisterRead(Uint32_t Addr);
+
+Uint64_t d_GEN_RegisterRead64(const Uint32_t address);
+
+void d_GEN_RegisterWrite64(const Uint32_t address, const Uint64_t value);
+
+/***** Macros (Inline Functions) Definitions ****************************/
+
+#define d_GEN_RegisterWriteP(Addr, Value)            (*(Addr) = (Value))
+#define d_GEN_RegisterWriteMaskP(Addr, Mask, Value)  (*(Addr) = ((*(Addr) & ~(Mask)) | ((Value) & (Mask))))
+#define d_GEN_RegisterReadP(Addr)                    (*(Addr))
+
+#endif /* D_GEN_REGISTER_H */
@@ -0,0 +1,33 @@
+/*********************************************************************//**
+\file
+\brief
+  Module Title       : Host replacement of the assembler macros
+
+  Abstract           : The coprocessor accesses of soc/defines/d_common_asm.h
+                       have no meaning on the host, they read as zero and
+                       writes are ignored. The status register is the
+                       variable host_Cpsr of the host stubs, in system
+                       mode with interrupts enabled after host_Reset, so
+                       that a test can run code as an interrupt handler.
+*************************************************************************/
+
+#ifndef D_ASM_H
+#define D_ASM_H
+
+/***** Includes *********************************************************/
+
+#include "soc/defines/d_common_types.h"
+
+/***** Variables ********************************************************/
+
+extern Uint32_t host_Cpsr;
+
+/***** Macros (Inline Functions) Definitions ****************************/
+
+#define d_mfcp(rn)     (0U)
+#define d_mtcp(rn, v)  ((void)(v))
+#define d_mfcpsr()     (host_Cpsr)
+#define d_mtcpsr(v)    ((void)(host_Cpsr = (v)))
+#define d_getsp()      (0U)
+
+#endif /* D_ASM_H */
@@ -0,0 +1,26 @@
+/*********************************************************************//**
+\file
+\brief
+  Module Title       : Host replacement of the critical section functions
+
+  Abstract           : Critical sections are counted by the host stubs so
+                       that tests can check they are balanced.
+*************************************************************************/
+
+#ifndef D_INT_CRITICAL_H
+#define D_INT_CRITICAL_H
+
+/***** Includes *********************************************************/
+
+#include "soc/defines/d_common_types.h"
+
+/***** Function Declarations ********************************************/
+
+Uint32_t d_INT_CriticalSectionEnter(void);
+
+void d_INT_CriticalSectionLeave(Uint32_t statusRegister);
+
+#define d_INT_IrqNestedEnable()
+#define d_INT_IrqNestedDisable()
+
+#endif /* D_INT_CRITICAL_H */
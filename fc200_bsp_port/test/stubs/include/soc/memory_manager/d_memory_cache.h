@@ -0,0 +1,30 @@
+/*********************************************************************//**
+\file
+\brief
+  Module Title       : Host replacement of the memory cache functions
+
+  Abstract           : The barriers are host memory fences, so that the
+                       shared memory rings can be tested between threads.
+                       Cache maintenance has no effect on the host.
+*************************************************************************/
+
+#ifndef D_MEMORY_CACHE_H
+#define D_MEMORY_CACHE_H
+
+/***** Includes *********************************************************/
+
+#include "soc/defines/d_common_types.h"
+
+/***** Macros (Inline Functions) Definitions ****************************/
+
+#define d_isb() __atomic_thread_fence(__ATOMIC_SEQ_CST)
+#define d_dsb() __atomic_thread_fence(__ATOMIC_SEQ_CST)
+#define d_dmb() __atomic_thread_fence(__ATOMIC_SEQ_CST)
+
+/***** Function Declarations ********************************************/
+
+void d_MEMORY_DCacheInvalidateRange(const Pointer_t address, Uint32_t length);
+
+void d_MEMORY_DCacheFlushRange(const Pointer_t address, Uint32_t length);
+
+#endif /* D_MEMORY_CACHE_H */
@@ -0,0 +1,19 @@
+/*********************************************************************//**
+\file
+\brief
+  Module Title       : Host replacement of the Xilinx PS CAN driver header
+
+  Abstract           : The CAN service includes the XCanPs header for the
+                       interrupt masks of the controller. Only the receive
+                       FIFO watermark mask it refers to is defined, the
+                       controller itself is replaced by the test.
+*************************************************************************/
+
+#ifndef XCANPS_H
+#define XCANPS_H
+
+/***** Constants ********************************************************/
+
+#define XCANPS_IXR_RXFWMFLL_MASK  0x00008000U
+
+#endif /* XCANPS_H */
@@ -0,0 +1,16 @@
+/*********************************************************************//**
+\file
+\brief
+  Module Title       : Host replacement of xclockps_hw.h
+
+  Abstract           : Nothing from this Xilinx header is used by the
+                       modules under test, the host build only needs it
+                       to exist.
+*************************************************************************/
+
+#ifndef XCLOCKPS_HW_H
+#define XCLOCKPS_HW_H
+
+#include "xparameters.h"
+
+#endif /* XCLOCKPS_HW_H */
@@ -0,0 +1,25 @@
+/*********************************************************************//**
+\file
+\brief
+  Module Title       : Host replacement of the Xilinx types
+
+  Abstract           : The fixed width types of the standalone BSP used by
+                       the modules under test.
+*************************************************************************/
+
+#ifndef XIL_TYPES_H
+#define XIL_TYPES_H
+
+/***** Includes *********************************************************/
+
+#include <stdint.h>
+
+/***** Type Definitions *************************************************/
+
+typedef uint8_t u8;
+typedef uint16_t u16;
+typedef uint32_t u32;
+typedef uint64_t u64;
+typedef int32_t s32;
+
+#endif /* XIL_TYPES_H */
@@ -0,0 +1,34 @@
+/*********************************************************************//**
+\file
+\brief
+  Module Title       : Host replacement of the Xilinx parameters
+
+  Abstract           : Base addresses of the peripherals used by the
+                       modules under test. They are only seen by the
+                       register model, nothing is mapped at them.
+*************************************************************************/
+
+#ifndef XPARAMETERS_H
+#define XPARAMETERS_H
+
+/***** Includes *********************************************************/
+
+#include <stdio.h>
+
+#include "xil_types.h"
+
+/***** Constants ********************************************************/
+
+#define XPAR_PSU_SATA_S_AXI_BASEADDR    0xFD0C0000U
+#define XPAR_PSU_SERDES_S_AXI_BASEADDR  0xFD400000U
+#define XPAR_PSU_SIOU_S_AXI_BASEADDR    0xFD3D0000U
+#define XPAR_XSDPS_0_DEVICE_ID          0U
+#define XPAR_XSDPS_0_BASEADDR           0xFF170000U
+#define XPAR_XTTCPS_0_TTC_CLK_FREQ_HZ   100000000U
+
+/***** Macros (Inline Functions) Definitions ****************************/
+
+/* The standalone BSP output goes to the host console */
+#define xil_printf  printf
+
+#endif /* XPARAMETERS_H */
@@ -0,0 +1,16 @@
+/*********************************************************************//**
+\file
+\brief
+  Module Title       : Host replacement of xparameters_ps.h
+
+  Abstract           : Nothing from this Xilinx header is used by the
+                       modules under test, the host build only needs it
+                       to exist.
+*************************************************************************/
+
+#ifndef XPARAMETERS_PS_H
+#define XPARAMETERS_PS_H
+
+#include "xparameters.h"
+
+#endif /* XPARAMETERS_PS_H */
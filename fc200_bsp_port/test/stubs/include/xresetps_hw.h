@@ -0,0 +1,16 @@
+/*********************************************************************//**
+\file
+\brief
+  Module Title       : Host replacement of xresetps_hw.h
+
+  Abstract           : Nothing from this Xilinx header is used by the
+                       modules under test, the host build only needs it
+                       to exist.
+*************************************************************************/
+
+#ifndef XRESETPS_HW_H
+#define XRESETPS_HW_H
+
+#include "xparameters.h"
+
+#endif /* XRESETPS_HW_H */
@@ -0,0 +1,96 @@
+/*********************************************************************//**
+\file
+\brief
+  Module Title       : Host replacement of the Xilinx SD driver
+
+  Abstract           : The parts of the XSdPs driver used by the MMC
+                       interface. The driver instance has the layout of
+                       the MMC instance, which the interface passes to the
+                       driver. The functions are provided by the SD
+                       controller model of the test.
+*************************************************************************/
+
+#ifndef XSDPS_H
+#define XSDPS_H
+
+/***** Includes *********************************************************/
+
+#include "xil_types.h"
+#include "sru/mmc/d_mmc_interface.h"
+
+/***** Constants ********************************************************/
+
+#define XST_SUCCESS  0L
+#define XST_FAILURE  1L
+
+/* Registers */
+#define XSDPS_SW_RST_OFFSET          0x2FU
+#define XSDPS_NORM_INTR_STS_OFFSET   0x30U
+#define XSDPS_ERR_INTR_STS_OFFSET    0x32U
+#define XSDPS_ADMA_SAR_OFFSET        0x58U
+
+/* Interrupt status */
+#define XSDPS_INTR_TC_MASK           0x0002U
+#define XSDPS_INTR_ERR_MASK          0x8000U
+#define XSDPS_NORM_INTR_ALL_MASK     0x81FFU
+#define XSDPS_ERROR_INTR_ALL_MASK    0xF3FFU
+
+/* Software reset */
+#define XSDPS_SWRST_CMD_LINE_MASK    0x02U
+#define XSDPS_SWRST_DAT_LINE_MASK    0x04U
+
+/* Transfer mode */
+#define XSDPS_TM_DMA_EN_MASK         0x0001U
+#define XSDPS_TM_BLK_CNT_EN_MASK     0x0002U
+#define XSDPS_TM_AUTO_CMD12_EN_MASK  0x0004U
+#define XSDPS_TM_DAT_DIR_SEL_MASK    0x0010U
+#define XSDPS_TM_MUL_SIN_BLK_SEL_MASK 0x0020U
+
+/* ADMA2 descriptor attributes */
+#define XSDPS_DESC_VALID             0x0001U
+#define XSDPS_DESC_END               0x0002U
+#define XSDPS_DESC_TRAN              0x0020U
+#define XSDPS_DESC_MAX_LENGTH        65536U
+
+#define XSDPS_HC_SPEC_V3             0x02U
+
+/* Commands */
+#define CMD12  0x0C00U
+#define CMD17  0x1100U
+#define CMD18  0x1200U
+#define CMD24  0x1800U
+#define CMD25  0x1900U
+
+/***** Type Definitions *************************************************/
+
+typedef d_MMC_Config_t XSdPs_Config;
+typedef d_MMC_Instance_t XSdPs;
+
+typedef struct __attribute__((packed))
+{
+  u16 Attribute;
+  u16 Length;
+  u32 Address;
+} XSdPs_Adma2Descriptor32;
+
+typedef struct __attribute__((packed))
+{
+  u16 Attribute;
+  u16 Length;
+  u64 Address;
+} XSdPs_Adma2Descriptor64;
+
+/***** Function Declarations ********************************************/
+
+XSdPs_Config * XSdPs_LookupConfig(u16 DeviceId);
+s32 XSdPs_CfgInitialize(XSdPs * InstancePtr, XSdPs_Config * ConfigPtr, u32 EffectiveAddr);
+s32 XSdPs_CardInitialize(XSdPs * InstancePtr);
+
+u8 XSdPs_ReadReg8(u32 BaseAddress, u32 RegOffset);
+void XSdPs_WriteReg8(u32 BaseAddress, u32 RegOffset, u8 Data);
+u16 XSdPs_ReadReg16(u32 BaseAddress, u32 RegOffset);
+void XSdPs_WriteReg16(u32 BaseAddress, u32 RegOffset, u16 Data);
+u32 XSdPs_ReadReg(u32 BaseAddress, u32 RegOffset);
+void XSdPs_WriteReg(u32 BaseAddress, u32 RegOffset, u32 Data);
+
+#endif /* XSDPS_H */
@@ -0,0 +1,22 @@
+/*********************************************************************//**
+\file
+\brief
+  Module Title       : Host replacement of the Xilinx SD driver core
+
+  Abstract           : Command functions of the XSdPs driver, provided by
+                       the SD controller model of the test.
+*************************************************************************/
+
+#ifndef XSDPS_CORE_H
+#define XSDPS_CORE_H
+
+/***** Includes *********************************************************/
+
+#include "xsdps.h"
+
+/***** Function Declarations ********************************************/
+
+s32 XSdPs_SetupTransfer(XSdPs * InstancePtr);
+s32 XSdPs_CmdTransfer(XSdPs * InstancePtr, u32 Cmd, u32 Arg, u32 BlkCnt);
+
+#endif /* XSDPS_CORE_H */
@@ -0,0 +1,15 @@
+/*********************************************************************//**
+\file
+\brief
+  Module Title       : Host replacement of the Xilinx PS UART driver header
+
+  Abstract           : The UART drivers include the XUartPs header, the PL
+                       driver defines the baud rate error limit it takes
+                       from it itself. Nothing is defined, the PS UARTs
+                       are replaced by the test.
+*************************************************************************/
+
+#ifndef XUARTPS_H
+#define XUARTPS_H
+
+#endif /* XUARTPS_H */
@@ -0,0 +1,650 @@
+/*********************************************************************//**
+\file
+\brief
+  Module Title       : ESC status reassembly test
+
+  Abstract           : Feeds DroneCAN ESC status transfers of the eight
+                       ESC nodes to the reassembler of ach_epu.c through
+                       the CAN read interface. The transfers are encoded
+                       here, with their CRC from a reference calculation,
+                       and the decoded status of each node is checked
+                       against the last one sent. Transfers are
+                       interleaved across nodes and within a node, left
+                       incomplete to expire, and made to overrun the
+                       transfer slots of a node. The fuzz test then sends
+                       long streams of transfers in which frames are
+                       dropped, repeated, reordered, truncated or
+                       corrupted, mixed with frames of other data types,
+                       services, nodes and random identifiers. No status
+                       may be decoded that was not sent by its node beyond
+                       the rate of undetected errors of the 16 bit CRC,
+                       the counters must account for every frame of an
+                       ESC node, and a clean stream must be decoded again
+                       as soon as the faults stop. The test is built with
+                       the address and undefined behaviour sanitizers.
+*************************************************************************/
+
+/***** Includes *********************************************************/
+
+#include <stdarg.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "ach_interface.h"
+#include "ach_epu.h"
+#include "can_interface.h"
+#include "host_stubs.h"
+#include "test_common.h"
+
+/***** Constants ********************************************************/
+
+#define ESC_STATUS_DATA_TYPE    0x040Au
+#define ESC_STATUS_SIGNATURE    0xA9AF28AEA2FBB254uLL
+#define ESC_STATUS_PRIORITY     0x10u
+
+#define TAIL_START              0x80u
+#define TAIL_END                0x40u
+#define TAIL_TOGGLE             0x20u
+
+#define FRAMES_PER_TRANSFER     3u
+#define QUEUE_FRAMES            4096u
+
+/* Transfers of each node remembered for the check of decoded statuses */
+#define HISTORY                 64u
+
+#define FUZZ_ROUNDS             20000u
+
+/***** Type Definitions *************************************************/
+
+typedef struct
+{
+  Uint8_t payload[ESC_STATUS_PAYLOAD_SIZE];
+  Uint8_t transferId;
+} Transfer_t;
+
+typedef struct
+{
+  can_msg_t frames[FRAMES_PER_TRANSFER];
+  Uint32_t next;
+} Pending_t;
+
+/***** Variables ********************************************************/
+
+static can_msg_t queue[QUEUE_FRAMES];
+static Uint32_t queueHead;
+static Uint32_t queueTail;
+
+/* Payloads sent by each node, the latest at history[node][(sent - 1) % HISTORY] */
+static Uint8_t history[MAX_ESCS][HISTORY][ESC_STATUS_PAYLOAD_SIZE];
+static Uint32_t sent[MAX_ESCS];
+static Uint8_t transferIds[MAX_ESCS];
+
+/* Frames of an ESC node with the ESC status data type put on the bus */
+static Uint32_t nodeFrames[MAX_ESCS];
+
+static Uint32_t randomState = 1034u;
+
+/***** Function Definitions *********************************************/
+
+static Uint32_t randomNumber(const Uint32_t range)
+{
+  randomState = (randomState * 1664525u) + 1013904223u;
+
+  return (randomState >> 8u) % range;
+}
+
+/* Console of the flight software, its printf is printf_ */
+int printf_(const char * format, ...)
+{
+  va_list args;
+  int count;
+
+  va_start(args, format);
+  count = vfprintf(stdout, format, args);
+  va_end(args);
+
+  return count;
+}
+
+can_status_t can_init(can_channel_t can_ch)
+{
+  return CAN_OK;
+}
+
+can_status_t can_write(can_channel_t can_ch, const can_msg_t * ptr_can_msg)
+{
+  return CAN_OK;
+}
+
+can_status_t can_read(can_channel_t can_ch, can_msg_t * ptr_can_msg)
+{
+  can_status_t status = CAN_NO_NEW_DATA;
+
+  if (queueTail != queueHead)
+  {
+    *ptr_can_msg = queue[queueTail % QUEUE_FRAMES];
+    queueTail++;
+    status = CAN_OK;
+  }
+  ELSE_DO_NOTHING
+
+  return status;
+}
+
+static Bool_t isStatusFrame(const can_msg_t * const pFrame)
+{
+  Uint32_t node = pFrame->can_msg_id & 0x7Fu;
+
+  return ((pFrame->extended_id_flag == true) && (pFrame->dlc >= 1u) && (pFrame->dlc <= CAN_FRAME_SIZE) &&
+          (((pFrame->can_msg_id >> 8u) & 0xFFFFu) == ESC_STATUS_DATA_TYPE) && ((pFrame->can_msg_id & 0x80u) == 0u) &&
+          (node >= ESC_ID_1) && (node <= ESC_ID_8)) ? d_TRUE : d_FALSE;
+}
+
+static void queueFrame(const can_msg_t * const pFrame)
+{
+  if (isStatusFrame(pFrame) == d_TRUE)
+  {
+    nodeFrames[pFrame->can_msg_id & 0x7Fu]++;
+  }
+  ELSE_DO_NOTHING
+  queue[queueHead % QUEUE_FRAMES] = *pFrame;
+  queueHead++;
+}
+
+/* The reassembler reads at most 48 frames a call, as many calls as the frames need */
+static void readAll(void)
+{
+  while (queueTail != queueHead)
+  {
+    ach_epu_read_periodic();
+  }
+}
+
+/* CRC-16-CCITT of the data type signature and the payload, as the DroneCAN specification gives it */
+static Uint16_t transferCrc(const Uint8_t * const pPayload)
+{
+  Uint16_t crc = 0xFFFFu;
+  Uint8_t bytes[8u + ESC_STATUS_PAYLOAD_SIZE];
+
+  for (Uint32_t i = 0u; i < 8u; i++)
+  {
+    bytes[i] = (Uint8_t)(ESC_STATUS_SIGNATURE >> (8u * i));
+  }
+  memcpy(&bytes[8], pPayload, ESC_STATUS_PAYLOAD_SIZE);
+
+  for (Uint32_t i = 0u; i < sizeof(bytes); i++)
+  {
+    crc ^= (Uint16_t)((Uint16_t)bytes[i] << 8u);
+    for (Uint32_t bit = 0u; bit < 8u; bit++)
+    {
+      crc = ((crc & 0x8000u) != 0u) ? (Uint16_t)((crc << 1u) ^ 0x1021u) : (Uint16_t)(crc << 1u);
+    }
+  }
+
+  return crc;
+}
+
+/* The three frames of a transfer: CRC and 5 bytes, 7 bytes, 2 bytes, each with its tail byte */
+static void encode(const Uint32_t node, const Uint8_t * const pPayload, const Uint8_t transferId,
+                   can_msg_t frames[FRAMES_PER_TRANSFER])
+{
+  static const Uint8_t lengths[FRAMES_PER_TRANSFER] = {5u, 7u, 2u};
+  static const Uint8_t tails[FRAMES_PER_TRANSFER] = {TAIL_START, TAIL_TOGGLE, TAIL_END};
+  Uint16_t crc = transferCrc(pPayload);
+  Uint32_t offset = 0u;
+
+  for (Uint32_t i = 0u; i < FRAMES_PER_TRANSFER; i++)
+  {
+    Uint32_t length = 0u;
+
+    memset(&frames[i], 0, sizeof(can_msg_t));
+    frames[i].can_msg_id = (ESC_STATUS_PRIORITY << 24u) | (ESC_STATUS_DATA_TYPE << 8u) | node;
+    frames[i].extended_id_flag = true;
+    if (i == 0u)
+    {
+      frames[i].data[0] = (Uint8_t)crc;
+      frames[i].data[1] = (Uint8_t)(crc >> 8u);
+      length = 2u;
+    }
+    ELSE_DO_NOTHING
+    memcpy(&frames[i].data[length], &pPayload[offset], lengths[i]);
+    offset += lengths[i];
+    length += lengths[i];
+    frames[i].data[length] = (Uint8_t)(tails[i] | (transferId & 0x1Fu));
+    frames[i].dlc = (Uint8_t)(length + 1u);
+  }
+}
+
+/* A new status of a node with random contents, recorded in its history */
+static void newTransfer(const Uint32_t node, can_msg_t frames[FRAMES_PER_TRANSFER])
+{
+  Uint8_t * pPayload = history[node][sent[node] % HISTORY];
+
+  for (Uint32_t i = 0u; i < ESC_STATUS_PAYLOAD_SIZE; i++)
+  {
+    pPayload[i] = (Uint8_t)randomNumber(256u);
+  }
+  /* The RPM, throttle and index identify the payload in the decoded status */
+  pPayload[10] = (Uint8_t)sent[node];
+  pPayload[11] = (Uint8_t)(sent[node] >> 8u);
+  pPayload[12] = (Uint8_t)((pPayload[12] & 0xC0u) | (node & 0x3Fu));
+  sent[node]++;
+  encode(node, pPayload, transferIds[node], frames);
+  transferIds[node] = (Uint8_t)((transferIds[node] + 1u) & 0x1Fu);
+}
+
+static void sendTransfer(const Uint32_t node)
+{
+  can_msg_t frames[FRAMES_PER_TRANSFER];
+
+  newTransfer(node, frames);
+  for (Uint32_t i = 0u; i < FRAMES_PER_TRANSFER; i++)
+  {
+    queueFrame(&frames[i]);
+  }
+}
+
+/* Field by field comparison of a decoded status with a payload */
+static Bool_t statusMatches(const s_esc_status_frame_t * const pStatus, const Uint8_t * const pPayload)
+{
+  Int32_t rpm = (Int32_t)pPayload[10] | ((Int32_t)pPayload[11] << 8u) | ((Int32_t)((pPayload[12] >> 6u) & 0x03u) << 16u);
+  Uint32_t raw = (Uint32_t)pPayload[0] | ((Uint32_t)pPayload[1] << 8u) | ((Uint32_t)pPayload[2] << 16u) |
+                 ((Uint32_t)pPayload[3] << 24u);
+
+  return ((pStatus->status_bits.raw_status == raw) && (pStatus->rpm == rpm) &&
+          (pStatus->throttle == (Uint8_t)(((pPayload[12] & 0x3Fu) << 1u) | ((pPayload[13] & 0x80u) >> 7u))) &&
+          (pStatus->index == (Uint8_t)((pPayload[13] & 0x7Cu) >> 2u))) ? d_TRUE : d_FALSE;
+}
+
+/* The decoded status of a node is one it sent, or the latest when latestOnly */
+static Bool_t statusSent(const Uint32_t node, const Bool_t latestOnly)
+{
+  s_esc_status_frame_t status;
+  Uint32_t count = (sent[node] < HISTORY) ? sent[node] : HISTORY;
+  Bool_t found = d_FALSE;
+
+  (void)ach_get_epu_status((Uint8_t)node, &status);
+  if (sent[node] == 0u)
+  {
+    // cppcheck-suppress misra-c2012-15.5; The test returns early
+    return d_FALSE;
+  }
+  for (Uint32_t i = 0u; (i < ((latestOnly == d_TRUE) ? 1u : count)) && (found == d_FALSE); i++)
+  {
+    found = statusMatches(&status, history[node][(sent[node] - 1u - i) % HISTORY]);
+  }
+
+  return found;
+}
+
+static void statsTotal(s_esc_rx_stats_t * const pTotal, s_esc_rx_stats_t nodes[MAX_ESCS])
+{
+  memset(pTotal, 0, sizeof(s_esc_rx_stats_t));
+  for (Uint32_t node = ESC_ID_1; node <= ESC_ID_8; node++)
+  {
+    (void)ach_get_epu_rx_stats((Uint8_t)node, &nodes[node]);
+    pTotal->frames += nodes[node].frames;
+    pTotal->transfers += nodes[node].transfers;
+    pTotal->crc_errors += nodes[node].crc_errors;
+    pTotal->out_of_order += nodes[node].out_of_order;
+    pTotal->timeouts += nodes[node].timeouts;
+    pTotal->dropped += nodes[node].dropped;
+  }
+}
+
+static void reset(void)
+{
+  host_Reset();
+  host_TimerAdvance(1000000u);
+  memset(sent, 0, sizeof(sent));
+  memset(nodeFrames, 0, sizeof(nodeFrames));
+  queueHead = 0u;
+  queueTail = 0u;
+  TEST_CHECK(ach_epu_init() == true);
+}
+
+/* A status with known values decodes to them */
+static void testDecode(void)
+{
+  static const Uint8_t payload[ESC_STATUS_PAYLOAD_SIZE] =
+  {
+    0x05u, 0x00u, 0x34u, 0x12u,   // overvoltage and overcurrent, encoder value 0x1234
+    0x00u, 0x52u,                 // 48 V
+    0x40u, 0x4Au,                 // 12.5 A
+    0xB0u, 0x5Cu,                 // 300 K
+    0x39u, 0x30u, 0x0Au, 0x80u    // 12345 rpm, throttle 0x15, index 0
+  };
+  can_msg_t frames[FRAMES_PER_TRANSFER];
+  s_esc_status_frame_t status;
+  s_esc_rx_stats_t stats;
+
+  reset();
+  /* No status is valid before the first transfer */
+  ach_epu_read_periodic();
+  TEST_CHECK(ach_get_epu_status(ESC_ID_3, &status) == false);
+
+  encode(ESC_ID_3, payload, 7u, frames);
+  for (Uint32_t i = 0u; i < FRAMES_PER_TRANSFER; i++)
+  {
+    queueFrame(&frames[i]);
+  }
+  readAll();
+
+  TEST_CHECK(ach_get_epu_status(ESC_ID_3, &status) == true);
+  TEST_CHECK_EQUAL(status.status_bits.overvoltage, 1u);
+  TEST_CHECK_EQUAL(status.status_bits.overcurrent, 1u);
+  TEST_CHECK_EQUAL(status.status_bits.encoder_value, 0x1234u);
+  TEST_CHECK_NEAR(status.voltage_f16, 48.0, 1.0e-6);
+  TEST_CHECK_NEAR(status.current_f16, 12.5, 1.0e-6);
+  TEST_CHECK_NEAR(status.temperature_f16, 26.85, 1.0e-4);
+  TEST_CHECK_EQUAL(status.rpm, 12345);
+  TEST_CHECK_EQUAL(status.throttle, 0x15u);
+  TEST_CHECK_EQUAL(status.index, 0u);
+  TEST_CHECK(ach_get_epu_rx_stats(ESC_ID_3, &stats) == true);
+  TEST_CHECK_EQUAL(stats.frames, 3u);
+  TEST_CHECK_EQUAL(stats.transfers, 1u);
+
+  /* The status lapses when no transfer follows */
+  host_TimerAdvance(150000u);
+  ach_epu_read_periodic();
+  TEST_CHECK(ach_get_epu_status(ESC_ID_3, &status) == false);
+  TEST_CHECK(ach_get_epu_status(ESC_ID_2, &status) == false);
+  TEST_CHECK(ach_get_epu_rx_stats(0u, &stats) == false);
+  TEST_CHECK(ach_get_epu_rx_stats(MAX_ESCS, &stats) == false);
+}
+
+/* Frames of all nodes, and two transfers of a node, interleaved at random keep their order within a transfer */
+static void testInterleaved(void)
+{
+  static Pending_t pending[MAX_ESCS][2];
+  s_esc_rx_stats_t total;
+  s_esc_rx_stats_t nodes[MAX_ESCS];
+  Uint32_t transfers = 0u;
+  Uint32_t mismatches = 0u;
+
+  reset();
+  for (Uint32_t round = 0u; round < 500u; round++)
+  {
+    Uint32_t remaining = 0u;
+
+    for (Uint32_t node = ESC_ID_1; node <= ESC_ID_8; node++)
+    {
+      for (Uint32_t slot = 0u; slot < 2u; slot++)
+      {
+        newTransfer(node, pending[node][slot].frames);
+        pending[node][slot].next = 0u;
+        remaining += FRAMES_PER_TRANSFER;
+        transfers++;
+      }
+    }
+    while (remaining > 0u)
+    {
+      Pending_t * pPending = &pending[ESC_ID_1 + randomNumber(NUM_ESCS)][randomNumber(2u)];
+
+      if (pPending->next < FRAMES_PER_TRANSFER)
+      {
+        queueFrame(&pPending->frames[pPending->next]);
+        pPending->next++;
+        remaining--;
+      }
+      ELSE_DO_NOTHING
+    }
+    readAll();
+    for (Uint32_t node = ESC_ID_1; node <= ESC_ID_8; node++)
+    {
+      /* Either transfer of the round may have completed last */
+      if (statusSent(node, d_FALSE) == d_FALSE)
+      {
+        mismatches++;
+      }
+      ELSE_DO_NOTHING
+    }
+  }
+
+  statsTotal(&total, nodes);
+  TEST_CHECK_EQUAL(total.transfers, transfers);
+  TEST_CHECK_EQUAL(total.frames, transfers * FRAMES_PER_TRANSFER);
+  TEST_CHECK_EQUAL(total.crc_errors + total.out_of_order + total.timeouts + total.dropped, 0u);
+  TEST_CHECK_EQUAL(mismatches, 0u);
+}
+
+/* A transfer left incomplete expires, a third transfer of a node drops the oldest */
+static void testIncomplete(void)
+{
+  can_msg_t frames[3][FRAMES_PER_TRANSFER];
+  s_esc_rx_stats_t stats;
+
+  reset();
+  newTransfer(ESC_ID_5, frames[0]);
+  queueFrame(&frames[0][0]);
+  queueFrame(&frames[0][1]);
+  readAll();
+  host_TimerAdvance(25000u);
+  ach_epu_read_periodic();
+  queueFrame(&frames[0][2]);
+  readAll();
+  (void)ach_get_epu_rx_stats(ESC_ID_5, &stats);
+  TEST_CHECK_EQUAL(stats.timeouts, 1u);
+  TEST_CHECK_EQUAL(stats.out_of_order, 1u);
+  TEST_CHECK_EQUAL(stats.transfers, 0u);
+
+  for (Uint32_t i = 0u; i < 3u; i++)
+  {
+    newTransfer(ESC_ID_6, frames[i]);
+    queueFrame(&frames[i][0]);
+    readAll();
+    host_TimerAdvance(1000u);
+  }
+  for (Uint32_t i = 0u; i < 3u; i++)
+  {
+    queueFrame(&frames[i][1]);
+    queueFrame(&frames[i][2]);
+  }
+  readAll();
+  (void)ach_get_epu_rx_stats(ESC_ID_6, &stats);
+  TEST_CHECK_EQUAL(stats.dropped, 1u);
+  TEST_CHECK_EQUAL(stats.transfers, 2u);
+  TEST_CHECK(statusSent(ESC_ID_6, d_TRUE) == d_TRUE);
+}
+
+/* One fault applied to the frames of a transfer before they are queued */
+static void faultyTransfer(const Uint32_t node)
+{
+  can_msg_t frames[FRAMES_PER_TRANSFER + 1u];
+  Uint32_t count = FRAMES_PER_TRANSFER;
+  Uint32_t which = randomNumber(FRAMES_PER_TRANSFER);
+  can_msg_t * pFrame = &frames[which];
+
+  newTransfer(node, frames);
+  switch (randomNumber(10u))
+  {
+    case 0u:
+      /* Dropped */
+      memmove(pFrame, pFrame + 1, (FRAMES_PER_TRANSFER - which - 1u) * sizeof(can_msg_t));
+      count--;
+      break;
+    case 1u:
+      /* Repeated */
+      memmove(pFrame + 1, pFrame, (FRAMES_PER_TRANSFER - which) * sizeof(can_msg_t));
+      count++;
+      break;
+    case 2u:
+    {
+      /* Swapped with the next */
+      can_msg_t swap = frames[which];
+      Uint32_t other = (which + 1u) % FRAMES_PER_TRANSFER;
+
+      frames[which] = frames[other];
+      frames[other] = swap;
+      break;
+    }
+    case 3u:
+      /* Truncated or lengthened, the length may be outside the CAN range */
+      pFrame->dlc = (Uint8_t)randomNumber(16u);
+      break;
+    case 4u:
+      /* Tail byte bit error */
+      pFrame->data[(pFrame->dlc - 1u) & 7u] ^= (Uint8_t)(1u << randomNumber(8u));
+      break;
+    case 5u:
+      /* Identifier bit error */
+      pFrame->can_msg_id ^= 1uL << randomNumber(29u);
+      break;
+    case 6u:
+      /* Standard identifier */
+      pFrame->extended_id_flag = false;
+      break;
+    default:
+      /* Payload or CRC bit errors */
+      for (Uint32_t flips = randomNumber(3u) + 1u; flips > 0u; flips--)
+      {
+        pFrame->data[randomNumber(pFrame->dlc - 1u)] ^= (Uint8_t)(1u << randomNumber(8u));
+      }
+      break;
+  }
+  for (Uint32_t i = 0u; i < count; i++)
+  {
+    queueFrame(&frames[i]);
+  }
+}
+
+/* A frame that is not part of an ESC status transfer, or one of an ESC node with a random payload */
+static void strayFrame(void)
+{
+  can_msg_t frame;
+
+  memset(&frame, 0, sizeof(frame));
+  frame.extended_id_flag = (randomNumber(4u) != 0u) ? true : false;
+  frame.dlc = (Uint8_t)randomNumber(CAN_FRAME_SIZE + 1u);
+  for (Uint32_t i = 0u; i < CAN_FRAME_SIZE; i++)
+  {
+    frame.data[i] = (Uint8_t)randomNumber(256u);
+  }
+  switch (randomNumber(4u))
+  {
+    case 0u:
+      frame.can_msg_id = (Uint32_t)randomNumber(0x20000000u);
+      break;
+    case 1u:
+      /* A service of the ESC status type */
+      frame.can_msg_id = (ESC_STATUS_DATA_TYPE << 8u) | 0x80u | (ESC_ID_1 + randomNumber(NUM_ESCS));
+      break;
+    case 2u:
+      /* ESC status from a node that is not an ESC */
+      frame.can_msg_id = (ESC_STATUS_DATA_TYPE << 8u) | (9u + randomNumber(119u));
+      break;
+    default:
+      /* ESC status frame of an ESC node with random contents */
+      frame.can_msg_id = (ESC_STATUS_PRIORITY << 24u) | (ESC_STATUS_DATA_TYPE << 8u) | (ESC_ID_1 + randomNumber(NUM_ESCS));
+      break;
+  }
+  queueFrame(&frame);
+}
+
+static void testFuzz(void)
+{
+  s_esc_rx_stats_t total;
+  s_esc_rx_stats_t nodes[MAX_ESCS];
+  s_esc_rx_stats_t cleanBefore[MAX_ESCS];
+  s_esc_rx_stats_t cleanAfter[MAX_ESCS];
+  Uint32_t faulty = 0u;
+  Uint32_t mismatches = 0u;
+  Uint32_t frameMismatches = 0u;
+  Uint32_t stale = 0u;
+
+  reset();
+  for (Uint32_t round = 0u; round < FUZZ_ROUNDS; round++)
+  {
+    for (Uint32_t node = ESC_ID_1; node <= ESC_ID_8; node++)
+    {
+      if (randomNumber(4u) == 0u)
+      {
+        faultyTransfer(node);
+        faulty++;
+      }
+      else
+      {
+        sendTransfer(node);
+      }
+      if (randomNumber(3u) == 0u)
+      {
+        strayFrame();
+      }
+      ELSE_DO_NOTHING
+    }
+    readAll();
+    /* Some transfers are left incomplete by the faults */
+    host_TimerAdvance(randomNumber(8000u));
+
+    for (Uint32_t node = ESC_ID_1; node <= ESC_ID_8; node++)
+    {
+      s_esc_status_frame_t status;
+
+      if ((ach_get_epu_status((Uint8_t)node, &status) == true) && (statusSent(node, d_FALSE) == d_FALSE))
+      {
+        mismatches++;
+        printf("round %u node %u rpm %d thr %u idx %u raw %08x sent %u\n", round, node, status.rpm, status.throttle, status.index, status.status_bits.raw_status, sent[node]);
+      }
+      ELSE_DO_NOTHING
+    }
+  }
+
+  statsTotal(&total, nodes);
+  for (Uint32_t node = ESC_ID_1; node <= ESC_ID_8; node++)
+  {
+    if (nodes[node].frames != nodeFrames[node])
+    {
+      frameMismatches++;
+    }
+    ELSE_DO_NOTHING
+  }
+  printf("  %u transfers, %u with a fault: %u decoded, %u CRC errors, %u out of order, %u timeouts, %u dropped, "
+         "%u wrong statuses\n", FUZZ_ROUNDS * NUM_ESCS, faulty, total.transfers, total.crc_errors, total.out_of_order,
+         total.timeouts, total.dropped, mismatches);
+
+  TEST_CHECK_EQUAL(frameMismatches, 0u);
+  /* Every transfer without a fault is decoded, unless a fault of another transfer of its node broke it */
+  TEST_CHECK(total.transfers >= (((FUZZ_ROUNDS * NUM_ESCS) - faulty) * 9u) / 10u);
+  TEST_CHECK(total.crc_errors > 0u);
+  /* Undetected errors at no more than four times the 1 in 65536 of the CRC */
+  TEST_CHECK(mismatches <= (1u + ((4u * total.crc_errors) / 65536u)));
+
+  /* A clean stream is decoded from its first transfer once the faults stop */
+  host_TimerAdvance(30000u);
+  ach_epu_read_periodic();
+  statsTotal(&total, cleanBefore);
+  for (Uint32_t round = 0u; round < 10u; round++)
+  {
+    for (Uint32_t node = ESC_ID_1; node <= ESC_ID_8; node++)
+    {
+      sendTransfer(node);
+    }
+    readAll();
+    for (Uint32_t node = ESC_ID_1; node <= ESC_ID_8; node++)
+    {
+      if (statusSent(node, d_TRUE) == d_FALSE)
+      {
+        stale++;
+      }
+      ELSE_DO_NOTHING
+    }
+  }
+  statsTotal(&total, cleanAfter);
+  TEST_CHECK_EQUAL(stale, 0u);
+  for (Uint32_t node = ESC_ID_1; node <= ESC_ID_8; node++)
+  {
+    TEST_CHECK_EQUAL(cleanAfter[node].transfers - cleanBefore[node].transfers, 10u);
+  }
+}
+
+int main(void)
+{
+  testDecode();
+  testInterleaved();
+  testIncomplete();
+  testFuzz();
+
+  TEST_CHECK_EQUAL(host_ErrorCount, 0u);
+
+  return TEST_RESULT();
+}
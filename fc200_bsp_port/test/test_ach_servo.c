@@ -0,0 +1,534 @@
+/*********************************************************************//**
+\file
+\brief
+  Module Title       : Servo bus scheduler test
+
+  Abstract           : Runs the RS485 servo bus scheduler against a model
+                       of the half-duplex bus and of the KST servos on it.
+                       Every byte the flight computer sends and every
+                       reply is placed on the bus timeline at the servo
+                       UART baud rate, and a transmission that overlaps
+                       another is counted as a collision. The servos take
+                       their position commands and answer the position
+                       and status polls after a reply delay, the replies
+                       are delivered to the UART a byte at a time as they
+                       arrive. The main loop is played at the frame rate
+                       of the scheduler, with the background job given
+                       the rest of each frame, and the test is built for
+                       each main loop rate. The bus is run with the
+                       background job given most of the frame, where no
+                       frame may overrun, starved so that polls planned
+                       are left unsent at the end of the frame, and with
+                       a servo that does not answer.
+*************************************************************************/
+
+/***** Includes *********************************************************/
+
+#include <math.h>
+#include <stdarg.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "ach_interface.h"
+#include "ach_servo.h"
+#include "uart_interface.h"
+#include "host_stubs.h"
+#include "test_common.h"
+
+/***** Constants ********************************************************/
+
+/* Configured baud of UART_SERVO */
+#define SERVO_BAUD        512000u
+
+#define FRAME_US          (1000000u / ACH_SERVO_FRAME_HZ)
+
+/* Background quantum of the servo bus job */
+#define QUANTUM_US        20u
+
+/* Transmit time of a byte in nanoseconds, start bit, 8 data bits and stop bit */
+#define BYTE_NS           ((10u * 1000000000u) / SERVO_BAUD)
+
+#define FRAME_BYTES       10u
+#define SERVO_IDS         14u
+#define INTERVALS_MAX     512u
+#define REPLIES_MAX       64u
+
+/* Frames after which the scheduler resends an unchanged command */
+#define SERVO_CMD_REFRESH_TEST_FRAMES 10u
+
+/* Frames the commands are held for at the end of a scenario: two refresh
+   intervals, then 100 ms of polls for the feedback of every servo */
+#define SETTLE_FRAMES     ((2u * SERVO_CMD_REFRESH_TEST_FRAMES) + (ACH_SERVO_FRAME_HZ / 10u))
+
+/***** Type Definitions *************************************************/
+
+typedef struct
+{
+  Uint64_t start;   // ns
+  Uint64_t end;     // ns
+} Interval_t;
+
+typedef struct
+{
+  Uint64_t start;   // ns at which the first byte starts
+  Uint8_t bytes[FRAME_BYTES];
+  Uint32_t delivered;
+} Reply_t;
+
+typedef struct
+{
+  Bool_t fitted;
+  Bool_t silent;         // takes commands but never answers
+  Float32_t minDeg;      // range the commands are limited to
+  Float32_t maxDeg;
+  Uint32_t replyDelayUs;
+  Int16_t position;      // 0.1 deg
+  Uint32_t commands;
+  Uint32_t polls;
+} ServoModel_t;
+
+typedef struct
+{
+  e_servo_positions_t id;
+  Float32_t minDeg;
+  Float32_t maxDeg;
+} Fitted_t;
+
+typedef struct
+{
+  const Char_t * pName;
+  Uint32_t frames;
+  Uint32_t backgroundPct; // share of the frame left to the background jobs
+  Bool_t silentServo;
+  Bool_t starved;         // the background cannot send every poll planned
+} Scenario_t;
+
+/***** Variables ********************************************************/
+
+static const Fitted_t fitted[] =
+{
+  {FLAPERON_OUTER_LH, FLAPERON_OUT_LH_MIN, FLAPERON_OUT_LH_MAX},
+  {FLAPERON_INNER_LH, FLAPERON_IN_LH_MIN, FLAPERON_IN_LH_MAX},
+  {FLAP_LH, FLAP_LH_MIN, FLAP_LH_MAX},
+  {FLAP_RH, FLAP_RH_MIN, FLAP_RH_MAX},
+  {FLAPERON_INNER_RH, FLAPERON_IN_RH_MIN, FLAPERON_IN_RH_MAX},
+  {FLAPERON_OUTER_RH, FLAPERON_OUT_RH_MIN, FLAPERON_OUT_RH_MAX},
+  {RUDDER_LH, RUDDER_LH_MIN, RUDDER_LH_MAX},
+  {RUDDER_RH, RUDDER_RH_MIN, RUDDER_RH_MAX},
+  {ELEVATOR_LH, ELEVATOR_LH_MIN, ELEVATOR_LH_MAX},
+  {ELEVATOR_RH, ELEVATOR_RH_MIN, ELEVATOR_RH_MAX}
+};
+
+static ServoModel_t servos[SERVO_IDS];
+
+/* Transmissions of the flight computer and of the servos still of interest */
+static Interval_t sent[INTERVALS_MAX];
+static Uint32_t sentCount;
+static Interval_t answered[INTERVALS_MAX];
+static Uint32_t answeredCount;
+
+static Reply_t replies[REPLIES_MAX];
+static Uint32_t replyHead;
+static Uint32_t replyTail;
+
+/* End of the bytes queued in the UART transmitter */
+static Uint64_t transmitEnd;
+
+static Uint32_t collisions;
+static Uint32_t protocolErrors;
+
+static Uint32_t randomState = 485u;
+
+/***** Function Definitions *********************************************/
+
+static Uint32_t randomNumber(const Uint32_t range)
+{
+  randomState = (randomState * 1664525u) + 1013904223u;
+
+  return (randomState >> 8u) % range;
+}
+
+static Uint64_t nowNs(void)
+{
+  return host_TimerMicroseconds() * 1000u;
+}
+
+static Uint8_t checksum(const Uint8_t * const pFrame)
+{
+  Uint8_t sum = 0u;
+
+  for (Uint32_t i = 1u; i < (FRAME_BYTES - 2u); i++)
+  {
+    sum = (Uint8_t)(sum + pFrame[i]);
+  }
+
+  return sum;
+}
+
+/* Records a transmission, counting those it overlaps on the bus */
+static void busTransmit(Interval_t * const pList, Uint32_t * const pCount, const Uint64_t start, const Uint64_t end)
+{
+  const Interval_t * lists[2] = {sent, answered};
+  const Uint32_t counts[2] = {sentCount, answeredCount};
+  Uint32_t kept = 0u;
+
+  for (Uint32_t list = 0u; list < 2u; list++)
+  {
+    for (Uint32_t i = 0u; i < counts[list]; i++)
+    {
+      if ((start < lists[list][i].end) && (lists[list][i].start < end))
+      {
+        collisions++;
+      }
+      ELSE_DO_NOTHING
+    }
+  }
+
+  /* Transmissions over before the previous frame cannot overlap a later one */
+  for (Uint32_t i = 0u; i < *pCount; i++)
+  {
+    if ((pList[i].end + (2u * FRAME_US * 1000u)) > start)
+    {
+      pList[kept] = pList[i];
+      kept++;
+    }
+    ELSE_DO_NOTHING
+  }
+  if (kept < INTERVALS_MAX)
+  {
+    pList[kept].start = start;
+    pList[kept].end = end;
+    kept++;
+  }
+  ELSE_DO_NOTHING
+  *pCount = kept;
+}
+
+static void servoReply(const Uint8_t id, const Uint8_t code, const Uint64_t requestEnd)
+{
+  ServoModel_t * pServo = &servos[id];
+  Reply_t * pReply = &replies[replyHead % REPLIES_MAX];
+  Uint64_t start = requestEnd + ((Uint64_t)pServo->replyDelayUs * 1000u);
+
+  pReply->start = start;
+  pReply->delivered = 0u;
+  pReply->bytes[0] = 0xFEu;
+  pReply->bytes[1] = 0xCAu;
+  pReply->bytes[2] = id;
+  pReply->bytes[3] = (Uint8_t)(code + KST_SUCCESS_OFFSET);
+  if (code == (Uint8_t)KST_CMD_DEVICE_STATUS)
+  {
+    /* 1.2 A at 41 DegC */
+    pReply->bytes[4] = 120u;
+    pReply->bytes[5] = 0u;
+    pReply->bytes[6] = 41u;
+  }
+  else
+  {
+    pReply->bytes[4] = (Uint8_t)((Uint16_t)pServo->position & 0xFFu);
+    pReply->bytes[5] = (Uint8_t)((Uint16_t)pServo->position >> 8u);
+    pReply->bytes[6] = 0u;
+  }
+  pReply->bytes[7] = 0u;
+  pReply->bytes[8] = checksum(pReply->bytes);
+  pReply->bytes[9] = 0x0Au;
+  replyHead++;
+
+  busTransmit(answered, &answeredCount, start, start + (FRAME_BYTES * BYTE_NS));
+}
+
+bool uart_init(UART_peripherals_t uart_channel)
+{
+  return true;
+}
+
+uint32_t uart_get_baud_rate(UART_peripherals_t uart_channel)
+{
+  return (uart_channel == UART_SERVO) ? SERVO_BAUD : 0u;
+}
+
+bool uart_get_arrival_tick(UART_peripherals_t uart_channel, uint16_t offset, uint32_t * ptr_tick)
+{
+  return false;
+}
+
+/* The frame goes on the bus behind the bytes already queued, a poll is answered after the reply delay */
+uint16_t uart_write(UART_peripherals_t uart_channel, uint8_t * ptr_tx_data, uint16_t max_buf_data_size)
+{
+  Uint64_t start = (transmitEnd > nowNs()) ? transmitEnd : nowNs();
+  Uint64_t end = start + (FRAME_BYTES * BYTE_NS);
+  Uint8_t id = ptr_tx_data[2];
+  Uint8_t code = ptr_tx_data[3];
+
+  if ((uart_channel != UART_SERVO) || (max_buf_data_size != FRAME_BYTES) || (ptr_tx_data[0] != 0xFEu) ||
+      (ptr_tx_data[1] != 0xCAu) || (ptr_tx_data[8] != checksum(ptr_tx_data)) || (ptr_tx_data[9] != 0x0Au) ||
+      (id >= SERVO_IDS) || (servos[id].fitted == d_FALSE))
+  {
+    protocolErrors++;
+    // cppcheck-suppress misra-c2012-15.5; The test model returns early
+    return 0u;
+  }
+
+  transmitEnd = end;
+  busTransmit(sent, &sentCount, start, end);
+
+  if (code == (Uint8_t)KST_CMD_SET_POSITION)
+  {
+    servos[id].position = (Int16_t)((Uint16_t)ptr_tx_data[4] | ((Uint16_t)ptr_tx_data[5] << 8u));
+    servos[id].commands++;
+  }
+  else if ((code == (Uint8_t)KST_CMD_GET_POSITION) || (code == (Uint8_t)KST_CMD_DEVICE_STATUS))
+  {
+    servos[id].polls++;
+    if (servos[id].silent == d_FALSE)
+    {
+      servoReply(id, code, end);
+    }
+    ELSE_DO_NOTHING
+  }
+  else
+  {
+    protocolErrors++;
+  }
+
+  return max_buf_data_size;
+}
+
+/* The bytes of the replies that have arrived */
+uint16_t uart_read(UART_peripherals_t uart_channel, uint8_t * ptr_rx_data, uint16_t max_buf_data_size)
+{
+  Uint64_t now = nowNs();
+  uint16_t count = 0u;
+
+  while ((replyTail != replyHead) && (count < max_buf_data_size))
+  {
+    Reply_t * pReply = &replies[replyTail % REPLIES_MAX];
+
+    while ((pReply->delivered < FRAME_BYTES) &&
+           ((pReply->start + ((Uint64_t)(pReply->delivered + 1u) * BYTE_NS)) <= now) && (count < max_buf_data_size))
+    {
+      ptr_rx_data[count] = pReply->bytes[pReply->delivered];
+      pReply->delivered++;
+      count++;
+    }
+    if (pReply->delivered < FRAME_BYTES)
+    {
+      break;
+    }
+    ELSE_DO_NOTHING
+    replyTail++;
+  }
+
+  return count;
+}
+
+/* Console of the flight software, its printf is printf_ */
+int printf_(const char * format, ...)
+{
+  va_list args;
+  int count;
+
+  va_start(args, format);
+  count = vfprintf(stdout, format, args);
+  va_end(args);
+
+  return count;
+}
+
+/* Commanded angle of a servo in a frame, a slow sine different for each surface */
+static Float32_t commandDeg(const Uint32_t id, const Uint32_t frame)
+{
+  return (Float32_t)(20.0 * sin(((Float64_t)frame * 0.01) + (Float64_t)id));
+}
+
+static void commandsSet(const Uint32_t frame, const Bool_t moving)
+{
+  std_servo_cmd_t command;
+
+  memset(&command, 0, sizeof(command));
+  for (Uint32_t id = 0u; id < MAX_CNTRL_SURFACE; id++)
+  {
+    command.servo_cmd_deg[id] = commandDeg(id, (moving == d_TRUE) ? frame : 0u);
+  }
+  ach_set_servo_cmd_deg(&command);
+}
+
+/* One main loop frame: the commands after the frame work, the reads, then the background job in the slack */
+static void frameRun(const Uint32_t frame, const Uint32_t workUs, const Bool_t moving)
+{
+  Uint64_t frameEnd = ((Uint64_t)frame + 1u) * FRAME_US;
+
+  host_TimerAdvance((Uint32_t)(((Uint64_t)frame * FRAME_US) - host_TimerMicroseconds()));
+  host_TimerAdvance(workUs / 2u);
+  commandsSet(frame, moving);
+  ach_cmd_servo_periodic();
+  ach_servo_read_periodic();
+  host_TimerAdvance(workUs - (workUs / 2u));
+
+  while ((host_TimerMicroseconds() + QUANTUM_US) <= frameEnd)
+  {
+    (void)ach_servo_bus_background();
+    host_TimerAdvance(QUANTUM_US);
+  }
+}
+
+static void servosReset(const Bool_t silentServo)
+{
+  memset(servos, 0, sizeof(servos));
+  for (Uint32_t i = 0u; i < (sizeof(fitted) / sizeof(fitted[0])); i++)
+  {
+    ServoModel_t * pServo = &servos[fitted[i].id];
+
+    pServo->fitted = d_TRUE;
+    pServo->minDeg = fitted[i].minDeg;
+    pServo->maxDeg = fitted[i].maxDeg;
+    /* Within the 100 us response time of the KST servos */
+    pServo->replyDelayUs = 40u + randomNumber(60u);
+  }
+  servos[FLAP_RH].silent = silentServo;
+}
+
+/* Command after the range limit of the servo, in the 0.1 deg steps sent */
+static Int16_t commandSteps(const Uint32_t id, const Uint32_t frame)
+{
+  Float32_t command = commandDeg(id, frame);
+
+  command = (command < servos[id].minDeg) ? servos[id].minDeg : command;
+  command = (command > servos[id].maxDeg) ? servos[id].maxDeg : command;
+
+  return (Int16_t)(command * 10.0f);
+}
+
+static void scenarioRun(const Scenario_t * const pScenario, Uint32_t * const pFrame)
+{
+  servo_bus_stats_t before;
+  servo_bus_stats_t after;
+  servo_latency_t latencyBefore[SERVO_IDS];
+  servo_latency_t latency;
+  Uint32_t collisionsBefore = collisions;
+  Uint32_t polls = 0u;
+  Uint32_t replies = 0u;
+  Uint32_t timeouts = 0u;
+  Uint32_t silentTimeouts = 0u;
+  Uint32_t silentReplies = 0u;
+  Uint32_t positionErrors = 0u;
+  Uint32_t overruns;
+  Uint32_t workUs = (FRAME_US * (100u - pScenario->backgroundPct)) / 100u;
+
+  servosReset(pScenario->silentServo);
+  (void)ach_servo_init();
+  ach_get_servo_bus_stats(&before);
+  for (Uint32_t id = 0u; id < SERVO_IDS; id++)
+  {
+    (void)ach_get_servo_latency((e_servo_positions_t)id, &latencyBefore[id]);
+  }
+
+  for (Uint32_t i = 0u; i < pScenario->frames; i++)
+  {
+    frameRun(*pFrame, workUs, d_TRUE);
+    (*pFrame)++;
+  }
+
+  /* Commands held for the refresh interval reach every servo, and its feedback follows */
+  for (Uint32_t i = 0u; i < SETTLE_FRAMES; i++)
+  {
+    frameRun(*pFrame, workUs, d_FALSE);
+    (*pFrame)++;
+  }
+
+  /* The last poll is answered or times out here, not in the next scenario,
+     which starts with the next whole frame */
+  while (ach_servo_bus_background() == true)
+  {
+    host_TimerAdvance(QUANTUM_US);
+  }
+  *pFrame = (Uint32_t)(host_TimerMicroseconds() / FRAME_US) + 1u;
+  ach_get_servo_bus_stats(&after);
+
+  for (Uint32_t i = 0u; i < (sizeof(fitted) / sizeof(fitted[0])); i++)
+  {
+    e_servo_positions_t id = fitted[i].id;
+
+    (void)ach_get_servo_latency(id, &latency);
+    polls += latency.polls - latencyBefore[id].polls;
+    replies += latency.replies - latencyBefore[id].replies;
+    timeouts += latency.timeouts - latencyBefore[id].timeouts;
+    if (servos[id].silent == d_TRUE)
+    {
+      silentReplies += latency.replies - latencyBefore[id].replies;
+      silentTimeouts += latency.timeouts - latencyBefore[id].timeouts;
+    }
+    else if (fabsf(ach_get_servo_pos_deg(id) - ((Float32_t)commandSteps(id, 0u) / 10.0f)) > 0.001f)
+    {
+      positionErrors++;
+    }
+    ELSE_DO_NOTHING
+    if (servos[id].position != commandSteps(id, 0u))
+    {
+      positionErrors++;
+    }
+    ELSE_DO_NOTHING
+  }
+
+  printf("  %-20s %8u %8u %8u %8u %8u %8u\n", pScenario->pName, after.commands_sent - before.commands_sent, polls,
+         replies, timeouts, after.overruns - before.overruns, collisions - collisionsBefore);
+
+  TEST_CHECK_EQUAL(collisions - collisionsBefore, 0u);
+  TEST_CHECK_EQUAL(positionErrors, 0u);
+  TEST_CHECK(after.max_frame_bytes <= after.budget_bytes);
+  TEST_CHECK_EQUAL(polls, replies + timeouts);
+  TEST_CHECK(replies > 0u);
+  TEST_CHECK_EQUAL(silentReplies, 0u);
+  TEST_CHECK_EQUAL(timeouts, silentTimeouts);
+  TEST_CHECK((pScenario->silentServo == d_FALSE) || (silentTimeouts > 0u));
+
+  /* With the background given most of the frame every poll planned is
+     completed within it, also when a servo does not answer. Starved, the
+     background cannot send all the polls planned from the bus budget and
+     those left at the end of a frame are dropped, one overrun a frame at
+     most. The commands of the frame are sent ahead of the polls and still
+     reach every servo. */
+  overruns = after.overruns - before.overruns;
+  if (pScenario->starved == d_TRUE)
+  {
+    TEST_CHECK(overruns <= (pScenario->frames + SETTLE_FRAMES));
+  }
+  else
+  {
+    TEST_CHECK_EQUAL(overruns, 0u);
+  }
+}
+
+int main(void)
+{
+  static const Scenario_t scenarios[] =
+  {
+    {"background 70%", 500u, 70u, d_FALSE, d_FALSE},
+    {"background 10%", 500u, 10u, d_FALSE, d_TRUE},
+    {"background 5%", 500u, 5u, d_FALSE, d_TRUE},
+    {"servo not answering", 500u, 70u, d_TRUE, d_FALSE}
+  };
+  servo_bus_stats_t stats;
+  Uint32_t frame = 1u;
+
+  host_Reset();
+
+  /* The frame budget follows the main loop rate */
+  servosReset(d_FALSE);
+  (void)ach_servo_init();
+  ach_get_servo_bus_stats(&stats);
+  TEST_CHECK_EQUAL(stats.budget_bytes, ((SERVO_BAUD / 10u / ACH_SERVO_FRAME_HZ) * 80u) / 100u);
+
+  printf("%u Hz frames, %u baud, %u byte budget\n", ACH_SERVO_FRAME_HZ, SERVO_BAUD, stats.budget_bytes);
+  printf("  %-20s %8s %8s %8s %8s %8s %8s\n", "", "commands", "polls", "replies", "timeouts", "overruns",
+         "collide");
+  for (Uint32_t i = 0u; i < (sizeof(scenarios) / sizeof(scenarios[0])); i++)
+  {
+    scenarioRun(&scenarios[i], &frame);
+  }
+
+  TEST_CHECK_EQUAL(protocolErrors, 0u);
+  TEST_CHECK_EQUAL(host_ErrorCount, 0u);
+
+  return TEST_RESULT();
+}
@@ -0,0 +1,580 @@
+/*********************************************************************//**
+\file
+\brief
+  Module Title       : BME280 compensation accuracy and benchmark
+
+  Abstract           : Runs the BME280 driver against a register model of
+                       the PL SPI core and the device, and compares the
+                       compensated data with the Bosch double precision
+                       formulas evaluated by the test. The test is built
+                       once with the integer compensation of the driver
+                       and once with d_BME280_COMPENSATION_DOUBLE.
+
+                       Two calibration sets are used. For each, the
+                       temperature ADC value is swept over the range
+                       giving -40 to 85 DegC while the pressure ADC value
+                       covers the full 20 bit range and the humidity ADC
+                       value covers the full 16 bit range several times.
+                       The largest differences from the formulas are
+                       printed and checked against the bounds of the
+                       build: the double build reproduces the formulas,
+                       the integer build stays within the output step and
+                       the truncations of the Bosch integer formulas.
+                       The time per d_BME280_Read is then measured on the
+                       host, the SPI model being the same in both builds.
+*************************************************************************/
+
+/***** Includes *********************************************************/
+
+#include <math.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "soc/interrupt_manager/d_int_irq_handler.h"
+#include "sru/fcu/d_fcu_cfg.h"
+#include "sru/spi_pl/d_spi_pl.h"
+#include "sru/spi_pl/d_spi_pl_cfg.h"
+#include "driver/bme280/d_bme280.h"
+#include "driver/bme280/d_bme280_cfg.h"
+#include "host_stubs.h"
+#include "test_common.h"
+
+/***** Constants ********************************************************/
+
+#define CHANNEL            0u
+#define DEVICE             1u
+#define SPI_BASE           0x00400000u
+#define SPI_CLOCK_HZ       1000000u
+
+/* SPI core registers */
+#define REG_STATUS         0x0000u
+#define REG_CTRL           0x0004u
+#define REG_CMD0           0x0008u
+#define REG_IRQ            0x0010u
+#define REG_FIFO           0x0100u
+
+/* Device registers */
+#define BME_CALIB0         0x88u
+#define BME_ID             0xD0u
+#define BME_CALIB1         0xE1u
+#define BME_CTRL_HUM       0xF2u
+#define BME_CTRL_MEAS      0xF4u
+#define BME_CONFIG         0xF5u
+#define BME_DATA           0xF7u
+
+/* Settings written by the test at initialisation */
+#define SETTING_CONFIG     0xA0u
+#define SETTING_CTRL_HUM   0x01u
+#define SETTING_CTRL_MEAS  0x27u
+
+/* Time between reads, longer than the data transfer */
+#define READ_PERIOD_US     100u
+
+/* Reads of the sweep of each calibration set */
+#define SWEEP_READS        262144u
+
+/* Odd steps, so that the ADC values cover their range evenly */
+#define STEP_PRESSURE      40503u
+#define STEP_HUMIDITY      2417u
+
+#define BENCH_READS        200000u
+
+/* Limits of the compensation outputs */
+#define TEMPERATURE_MIN    (-40.0)
+#define TEMPERATURE_MAX    85.0
+#define PRESSURE_MIN       30000.0
+#define PRESSURE_MAX       110000.0
+#define HUMIDITY_MIN       0.0
+#define HUMIDITY_MAX       100.0
+
+/* Largest differences from the formulas allowed for the build */
+#if defined d_BME280_COMPENSATION_DOUBLE
+#define COMPENSATION_NAME  "double"
+#define BOUND_TEMPERATURE  1.0e-9
+#define BOUND_PRESSURE     1.0e-9
+#define BOUND_HUMIDITY     1.0e-9
+#else
+#define COMPENSATION_NAME  "integer"
+#define BOUND_TEMPERATURE  0.01
+#define BOUND_PRESSURE     1.0
+#define BOUND_HUMIDITY     0.01
+#endif
+
+/***** Type Definitions *************************************************/
+
+/* Calibration words of a device */
+typedef struct
+{
+  Uint16_t t1;
+  Int16_t t2;
+  Int16_t t3;
+  Uint16_t p1;
+  Int16_t p2;
+  Int16_t p3;
+  Int16_t p4;
+  Int16_t p5;
+  Int16_t p6;
+  Int16_t p7;
+  Int16_t p8;
+  Int16_t p9;
+  Uint8_t h1;
+  Int16_t h2;
+  Uint8_t h3;
+  Int16_t h4;
+  Int16_t h5;
+  Int8_t h6;
+} calibration_t;
+
+/* Output of the formulas, before the limits are applied */
+typedef struct
+{
+  Float64_t temperature;
+  Float64_t pressure;
+  Float64_t humidity;
+} reference_t;
+
+/***** Variables ********************************************************/
+
+const d_SPI_PL_Definition_t d_SPI_PL_Definition[] =
+{
+  { SPI_BASE, SPI_CLOCK_HZ, 121u, d_TRUE, NULL, NULL }
+};
+
+d_SPI_PL_COUNT;
+
+const d_BME280_Definition_t d_BME280_Config[] =
+{
+  { CHANNEL, DEVICE }
+};
+
+d_BME280_COUNT;
+
+/* The example of the Bosch datasheet, with the humidity words of a device */
+static const calibration_t calibrationDatasheet =
+{
+  27504u, 26435, -1000,
+  36477u, -10685, 3024, 2855, 140, -7, 15500, -14600, 6000,
+  75u, 362, 0u, 313, 50, 30
+};
+
+/* A second device, with the signs of p4, p5, t3 and h6 changed and h3 set */
+static const calibration_t calibrationDevice =
+{
+  28485u, 26735, 50,
+  36738u, -10635, 3024, -6980, -4, -7, 9900, -10230, 4285,
+  75u, 359, 12u, 340, 45, -20
+};
+
+/* SPI core */
+static Uint32_t coreCommand;
+static Uint32_t coreFifo[8];
+static Uint32_t coreFifoCount;
+static Uint32_t coreFifoOut;
+static Bool_t coreBusy;
+static Uint32_t coreDataCount;
+static Uint64_t coreEndUs;
+static Uint32_t coreIrq;
+
+/* Device registers, by address */
+static Uint8_t deviceRegister[256];
+
+/* Reads of the benchmark, kept so that they are not optimised out */
+static volatile Float64_t benchSink;
+
+/***** Function Definitions *********************************************/
+
+d_Status_t d_FCU_IocAddressCheck(const Uint32_t address)
+{
+  return d_STATUS_SUCCESS;
+}
+
+d_Status_t d_INT_IrqEnable(const Uint32_t irq)
+{
+  return d_STATUS_SUCCESS;
+}
+
+/* The core starts a transfer when its control register is written. The
+   first command byte is the register address, its top bit set for a read */
+static void coreStart(const Uint32_t control)
+{
+  const Uint32_t cmdCount = ((control >> 16u) & 0x7u) + 1u;
+  const Uint8_t address = (Uint8_t)(coreCommand & 0xFFu);
+
+  coreDataCount = control >> 20u;
+  coreBusy = d_TRUE;
+  coreEndUs = host_TimerMicroseconds() + (((Uint64_t)(cmdCount + coreDataCount) * 8u * 1000000u) / SPI_CLOCK_HZ);
+
+  if (((address & 0x80u) == 0u) && (cmdCount == 2u))
+  {
+    deviceRegister[address | 0x80u] = (Uint8_t)((coreCommand >> 8u) & 0xFFu);
+  }
+  ELSE_DO_NOTHING
+}
+
+/* The registers read are those of the end of the transfer, the command
+   response being excluded from the FIFO */
+static void coreUpdate(void)
+{
+  if ((coreBusy == d_TRUE) && (coreEndUs <= host_TimerMicroseconds()))
+  {
+    const Uint8_t address = (Uint8_t)(coreCommand & 0xFFu);
+
+    coreFifoCount = (coreDataCount + 3u) / 4u;
+    coreFifoOut = 0u;
+    for (Uint32_t word = 0u; word < coreFifoCount; word++)
+    {
+      coreFifo[word] = 0u;
+      for (Uint32_t byte = 0u; byte < 4u; byte++)
+      {
+        const Uint32_t index = (word * 4u) + byte;
+        if (index < coreDataCount)
+        {
+          coreFifo[word] |= (Uint32_t)deviceRegister[(address + index) & 0xFFu] << (byte * 8u);
+        }
+        ELSE_DO_NOTHING
+      }
+    }
+    coreBusy = d_FALSE;
+    coreIrq |= 0x01u;
+  }
+  ELSE_DO_NOTHING
+}
+
+static Uint32_t modelRead(const Uint32_t address)
+{
+  Uint32_t value = 0u;
+
+  switch (address - SPI_BASE)
+  {
+    case REG_STATUS:
+      coreUpdate();
+      value = ((coreBusy == d_TRUE) ? 0x10000u : 0u) | ((coreFifoCount - coreFifoOut) << 8u);
+      break;
+
+    case REG_IRQ:
+      value = coreIrq;
+      break;
+
+    case REG_FIFO:
+      if (coreFifoOut < coreFifoCount)
+      {
+        value = coreFifo[coreFifoOut];
+        coreFifoOut++;
+      }
+      ELSE_DO_NOTHING
+      break;
+
+    default:
+      break;
+  }
+
+  return value;
+}
+
+static void modelWrite(const Uint32_t address, const Uint32_t value)
+{
+  switch (address - SPI_BASE)
+  {
+    case REG_CMD0:
+      coreCommand = value;
+      break;
+
+    case REG_CTRL:
+      coreStart(value);
+      break;
+
+    case REG_IRQ:
+      coreIrq = value;
+      break;
+
+    default:
+      /* Transmit data and the second command word */
+      break;
+  }
+}
+
+static void wordSet(const Uint32_t address, const Uint16_t value)
+{
+  deviceRegister[address] = (Uint8_t)(value & 0xFFu);
+  deviceRegister[address + 1u] = (Uint8_t)(value >> 8u);
+}
+
+/* Calibration registers as stored in the device, H4 and H5 sharing 0xE5 */
+static void calibrationSet(const calibration_t * const pCal)
+{
+  wordSet(BME_CALIB0 + 0u, pCal->t1);
+  wordSet(BME_CALIB0 + 2u, (Uint16_t)pCal->t2);
+  wordSet(BME_CALIB0 + 4u, (Uint16_t)pCal->t3);
+  wordSet(BME_CALIB0 + 6u, pCal->p1);
+  wordSet(BME_CALIB0 + 8u, (Uint16_t)pCal->p2);
+  wordSet(BME_CALIB0 + 10u, (Uint16_t)pCal->p3);
+  wordSet(BME_CALIB0 + 12u, (Uint16_t)pCal->p4);
+  wordSet(BME_CALIB0 + 14u, (Uint16_t)pCal->p5);
+  wordSet(BME_CALIB0 + 16u, (Uint16_t)pCal->p6);
+  wordSet(BME_CALIB0 + 18u, (Uint16_t)pCal->p7);
+  wordSet(BME_CALIB0 + 20u, (Uint16_t)pCal->p8);
+  wordSet(BME_CALIB0 + 22u, (Uint16_t)pCal->p9);
+  deviceRegister[BME_CALIB0 + 25u] = pCal->h1;
+
+  wordSet(BME_CALIB1, (Uint16_t)pCal->h2);
+  deviceRegister[BME_CALIB1 + 2u] = pCal->h3;
+  deviceRegister[BME_CALIB1 + 3u] = (Uint8_t)(((Uint16_t)pCal->h4 >> 4u) & 0xFFu);
+  deviceRegister[BME_CALIB1 + 4u] = (Uint8_t)(((Uint16_t)pCal->h4 & 0x0Fu) | (((Uint16_t)pCal->h5 & 0x0Fu) << 4u));
+  deviceRegister[BME_CALIB1 + 5u] = (Uint8_t)(((Uint16_t)pCal->h5 >> 4u) & 0xFFu);
+  deviceRegister[BME_CALIB1 + 6u] = (Uint8_t)pCal->h6;
+}
+
+/* Data registers, pressure and temperature 20 bits left aligned, humidity 16 bits */
+static void dataSet(const Uint32_t adcT, const Uint32_t adcP, const Uint32_t adcH)
+{
+  deviceRegister[BME_DATA + 0u] = (Uint8_t)(adcP >> 12u);
+  deviceRegister[BME_DATA + 1u] = (Uint8_t)((adcP >> 4u) & 0xFFu);
+  deviceRegister[BME_DATA + 2u] = (Uint8_t)((adcP & 0x0Fu) << 4u);
+  deviceRegister[BME_DATA + 3u] = (Uint8_t)(adcT >> 12u);
+  deviceRegister[BME_DATA + 4u] = (Uint8_t)((adcT >> 4u) & 0xFFu);
+  deviceRegister[BME_DATA + 5u] = (Uint8_t)((adcT & 0x0Fu) << 4u);
+  deviceRegister[BME_DATA + 6u] = (Uint8_t)(adcH >> 8u);
+  deviceRegister[BME_DATA + 7u] = (Uint8_t)(adcH & 0xFFu);
+}
+
+/* The double precision formulas of the Bosch datasheet */
+static reference_t reference(const calibration_t * const pCal, const Uint32_t adcT, const Uint32_t adcP, const Uint32_t adcH)
+{
+  reference_t out;
+  Float64_t var1;
+  Float64_t var2;
+  Float64_t tFine;
+
+  var1 = (((Float64_t)adcT / 16384.0) - ((Float64_t)pCal->t1 / 1024.0)) * (Float64_t)pCal->t2;
+  var2 = ((Float64_t)adcT / 131072.0) - ((Float64_t)pCal->t1 / 8192.0);
+  var2 = var2 * var2 * (Float64_t)pCal->t3;
+  tFine = (Float64_t)(Int32_t)(var1 + var2);
+  out.temperature = (var1 + var2) / 5120.0;
+
+  var1 = (tFine / 2.0) - 64000.0;
+  var2 = var1 * var1 * (Float64_t)pCal->p6 / 32768.0;
+  var2 = var2 + (var1 * (Float64_t)pCal->p5 * 2.0);
+  var2 = (var2 / 4.0) + ((Float64_t)pCal->p4 * 65536.0);
+  var1 = ((((Float64_t)pCal->p3 * var1 * var1) / 524288.0) + ((Float64_t)pCal->p2 * var1)) / 524288.0;
+  var1 = (1.0 + (var1 / 32768.0)) * (Float64_t)pCal->p1;
+  if (var1 <= 0.0)
+  {
+    out.pressure = PRESSURE_MIN;
+  }
+  else
+  {
+    Float64_t pressure = 1048576.0 - (Float64_t)adcP;
+    pressure = (pressure - (var2 / 4096.0)) * 6250.0 / var1;
+    var1 = (Float64_t)pCal->p9 * pressure * pressure / 2147483648.0;
+    var2 = pressure * (Float64_t)pCal->p8 / 32768.0;
+    out.pressure = pressure + ((var1 + var2 + (Float64_t)pCal->p7) / 16.0);
+  }
+
+  var1 = tFine - 76800.0;
+  var1 = ((Float64_t)adcH - (((Float64_t)pCal->h4 * 64.0) + (((Float64_t)pCal->h5 / 16384.0) * var1))) *
+         ((Float64_t)pCal->h2 / 65536.0 * (1.0 + ((Float64_t)pCal->h6 / 67108864.0 * var1 * (1.0 + ((Float64_t)pCal->h3 / 67108864.0 * var1)))));
+  out.humidity = var1 * (1.0 - ((Float64_t)pCal->h1 * var1 / 524288.0));
+
+  return out;
+}
+
+static Bool_t inRange(const Float64_t value, const Float64_t minimum, const Float64_t maximum)
+{
+  return ((value > minimum) && (value < maximum)) ? d_TRUE : d_FALSE;
+}
+
+static void startUp(const calibration_t * const pCal)
+{
+  host_Reset();
+  host_RegisterSetModel(modelRead, modelWrite);
+  host_TimerSetReadCost(1u);
+
+  memset(deviceRegister, 0, sizeof(deviceRegister));
+  deviceRegister[BME_ID] = 0x60u;
+  calibrationSet(pCal);
+  coreBusy = d_FALSE;
+  coreFifoCount = 0u;
+  coreFifoOut = 0u;
+  coreIrq = 0u;
+
+  TEST_CHECK_EQUAL(d_BME280_Initialise(0u, SETTING_CONFIG, SETTING_CTRL_HUM, SETTING_CTRL_MEAS), d_STATUS_SUCCESS);
+  TEST_CHECK_EQUAL(deviceRegister[BME_CONFIG], SETTING_CONFIG);
+  TEST_CHECK_EQUAL(deviceRegister[BME_CTRL_HUM], SETTING_CTRL_HUM);
+  TEST_CHECK_EQUAL(deviceRegister[BME_CTRL_MEAS], SETTING_CTRL_MEAS);
+}
+
+/* Temperature ADC values of the range of the compensation, the
+   temperature rising with the ADC value */
+static void temperatureRange(const calibration_t * const pCal, Uint32_t * const pLow, Uint32_t * const pHigh)
+{
+  *pLow = 0u;
+  *pHigh = 0u;
+  for (Uint32_t adcT = 0u; adcT < 0x100000u; adcT++)
+  {
+    const Float64_t temperature = reference(pCal, adcT, 0u, 0u).temperature;
+    if ((*pLow == 0u) && (temperature >= TEMPERATURE_MIN))
+    {
+      *pLow = adcT;
+    }
+    ELSE_DO_NOTHING
+    if (temperature <= TEMPERATURE_MAX)
+    {
+      *pHigh = adcT;
+    }
+    ELSE_DO_NOTHING
+  }
+}
+
+/* Sweep of one calibration set */
+static void testSweep(const char * const name, const calibration_t * const pCal)
+{
+  Float64_t humidity;
+  Float64_t pressure;
+  Float64_t temperature;
+  Uint32_t adcLow;
+  Uint32_t adcHigh;
+  Uint32_t compared[3] = { 0u, 0u, 0u };
+  Uint32_t ready = 0u;
+  Float64_t errorMax[3];
+
+  startUp(pCal);
+  temperatureRange(pCal, &adcLow, &adcHigh);
+  TEST_CHECK(adcHigh > adcLow);
+
+  /* The first read only queues the transfer */
+  TEST_CHECK_EQUAL(d_BME280_Read(0u, &humidity, &pressure, &temperature), d_STATUS_NOT_READY);
+
+  errorMax[0] = 0.0;
+  errorMax[1] = 0.0;
+  errorMax[2] = 0.0;
+  for (Uint32_t i = 0u; i < SWEEP_READS; i++)
+  {
+    const Uint32_t adcT = adcLow + (Uint32_t)(((Uint64_t)i * (adcHigh - adcLow)) / (SWEEP_READS - 1u));
+    const Uint32_t adcP = (i * STEP_PRESSURE) & 0xFFFFFu;
+    const Uint32_t adcH = (i * STEP_HUMIDITY) & 0xFFFFu;
+    const reference_t expected = reference(pCal, adcT, adcP, adcH);
+
+    dataSet(adcT, adcP, adcH);
+    host_TimerAdvance(READ_PERIOD_US);
+    if (d_BME280_Read(0u, &humidity, &pressure, &temperature) == d_STATUS_SUCCESS)
+    {
+      ready++;
+      errorMax[0] = fmax(errorMax[0], fabs(temperature - expected.temperature));
+      compared[0]++;
+      if (inRange(expected.pressure, PRESSURE_MIN, PRESSURE_MAX) == d_TRUE)
+      {
+        errorMax[1] = fmax(errorMax[1], fabs(pressure - expected.pressure));
+        compared[1]++;
+      }
+      ELSE_DO_NOTHING
+      if (inRange(expected.humidity, HUMIDITY_MIN, HUMIDITY_MAX) == d_TRUE)
+      {
+        errorMax[2] = fmax(errorMax[2], fabs(humidity - expected.humidity));
+        compared[2]++;
+      }
+      ELSE_DO_NOTHING
+    }
+    ELSE_DO_NOTHING
+  }
+
+  printf("%-10s adc_T %6u..%6u  reads %6u  compared T %6u P %6u H %6u\n",
+         name, adcLow, adcHigh, ready, compared[0], compared[1], compared[2]);
+  printf("           max difference  %.6f DegC  %.6f Pa  %.6f %%rH\n", errorMax[0], errorMax[1], errorMax[2]);
+
+  TEST_CHECK_EQUAL(ready, SWEEP_READS);
+  TEST_CHECK(compared[1] > (SWEEP_READS / 4u));
+  TEST_CHECK(compared[2] > (SWEEP_READS / 4u));
+  TEST_CHECK(errorMax[0] <= BOUND_TEMPERATURE);
+  TEST_CHECK(errorMax[1] <= BOUND_PRESSURE);
+  TEST_CHECK(errorMax[2] <= BOUND_HUMIDITY);
+  TEST_CHECK_EQUAL(host_ErrorCount, 0u);
+}
+
+/* Outputs beyond the range of the compensation are limited */
+static void testLimits(void)
+{
+  Float64_t humidity;
+  Float64_t pressure;
+  Float64_t temperature;
+
+  startUp(&calibrationDatasheet);
+  (void)d_BME280_Read(0u, &humidity, &pressure, &temperature);
+
+  dataSet(0xFFFFFu, 0u, 0xFFFFu);
+  host_TimerAdvance(READ_PERIOD_US);
+  TEST_CHECK_EQUAL(d_BME280_Read(0u, &humidity, &pressure, &temperature), d_STATUS_SUCCESS);
+  TEST_CHECK_NEAR(temperature, TEMPERATURE_MAX, 1.0e-9);
+  TEST_CHECK_NEAR(pressure, PRESSURE_MAX, 1.0e-9);
+  TEST_CHECK_NEAR(humidity, HUMIDITY_MAX, 1.0e-9);
+
+  dataSet(0u, 0xFFFFFu, 0u);
+  host_TimerAdvance(READ_PERIOD_US);
+  TEST_CHECK_EQUAL(d_BME280_Read(0u, &humidity, &pressure, &temperature), d_STATUS_SUCCESS);
+  TEST_CHECK_NEAR(temperature, TEMPERATURE_MIN, 1.0e-9);
+  TEST_CHECK_NEAR(pressure, PRESSURE_MIN, 1.0e-9);
+  TEST_CHECK_NEAR(humidity, HUMIDITY_MIN, 1.0e-9);
+  TEST_CHECK_EQUAL(host_ErrorCount, 0u);
+}
+
+/* The fixed point data of d_BME280_ReadAll is that returned by d_BME280_Read */
+static void testReadAll(void)
+{
+  d_BME280_Data_t data[1];
+  Float64_t humidity;
+  Float64_t pressure;
+  Float64_t temperature;
+
+  startUp(&calibrationDevice);
+  dataSet(519888u, 415148u, 30372u);
+  TEST_CHECK_EQUAL(d_BME280_ReadAll(data), d_STATUS_NOT_READY);
+  TEST_CHECK_EQUAL(data[0].status, d_STATUS_NOT_READY);
+  host_TimerAdvance(READ_PERIOD_US);
+  TEST_CHECK_EQUAL(d_BME280_ReadAll(data), d_STATUS_SUCCESS);
+  TEST_CHECK_EQUAL(data[0].status, d_STATUS_SUCCESS);
+  host_TimerAdvance(READ_PERIOD_US);
+  TEST_CHECK_EQUAL(d_BME280_Read(0u, &humidity, &pressure, &temperature), d_STATUS_SUCCESS);
+
+  TEST_CHECK_NEAR((Float64_t)data[0].temperature / 100.0, temperature, 0.01);
+  TEST_CHECK_NEAR((Float64_t)data[0].pressure / 256.0, pressure, 1.0 / 256.0);
+  TEST_CHECK_NEAR((Float64_t)data[0].humidity / 1024.0, humidity, 1.0 / 1024.0);
+  TEST_CHECK_EQUAL(host_ErrorCount, 0u);
+}
+
+/* Time per read, the collection of the data, its compensation and the queueing of the next read */
+static void benchmark(void)
+{
+  Float64_t humidity;
+  Float64_t pressure;
+  Float64_t temperature;
+  Float64_t sum = 0.0;
+  Float64_t start;
+  Float64_t readNs;
+
+  startUp(&calibrationDatasheet);
+  dataSet(519888u, 415148u, 30372u);
+  (void)d_BME280_Read(0u, &humidity, &pressure, &temperature);
+
+  start = testSeconds();
+  for (Uint32_t i = 0u; i < BENCH_READS; i++)
+  {
+    host_TimerAdvance(READ_PERIOD_US);
+    (void)d_BME280_Read(0u, &humidity, &pressure, &temperature);
+    sum += humidity + pressure + temperature;
+  }
+  readNs = ((testSeconds() - start) * 1.0e9) / (Float64_t)BENCH_READS;
+  benchSink = sum;
+
+  printf("ns per d_BME280_Read, %s compensation, host with the SPI model: %.1f\n", COMPENSATION_NAME, readNs);
+}
+
+int main(void)
+{
+  printf("BME280 %s compensation against the double formulas\n", COMPENSATION_NAME);
+  testSweep("datasheet", &calibrationDatasheet);
+  testSweep("device", &calibrationDevice);
+  testLimits();
+  testReadAll();
+  benchmark();
+
+  return TEST_RESULT();
+}
@@ -0,0 +1,572 @@
+/*********************************************************************//**
+\file
+\brief
+  Module Title       : Buffer and memory routine test
+
+  Abstract           : Property tests of d_GEN_MemorySet,
+                       d_GEN_MemoryCompare and the d_BUFFER fixed and
+                       variable length buffers against models of their
+                       original byte at a time implementations. Random
+                       sequences of writes, reads and flushes are applied
+                       to buffers whose capacities are and are not powers
+                       of two, and every result, count, high water mark
+                       and byte read is compared with the model. The
+                       bytes per second of the routines and of a buffer
+                       write and read are measured for sizes 1 to 4096.
+*************************************************************************/
+
+/***** Includes *********************************************************/
+
+#include <stdio.h>
+#include <string.h>
+
+#include "soc/defines/d_common_types.h"
+#include "soc/defines/d_common_status.h"
+#include "kernel/general/d_gen_memory.h"
+#include "kernel/buffer/d_buffer_cfg.h"
+#include "kernel/buffer/d_buffer.h"
+#include "host_stubs.h"
+#include "test_common.h"
+
+/***** Constants ********************************************************/
+
+#define FIXED_BUFFERS     4u
+#define VAR_BUFFERS       3u
+
+/* Largest fixed and variable buffers in bytes, and largest benchmark message */
+#define FIXED_BYTES_MAX   512u
+#define VAR_BYTES_MAX     8192u
+#define MESSAGE_MAX       4096u
+
+#define RANDOM_OPERATIONS 200000u
+
+/* Bytes moved for each entry of the benchmark table */
+#define BENCH_BYTES       (4u * 1024u * 1024u)
+
+/* Variable buffer used by the benchmark */
+#define BENCH_BUFFER      2u
+
+/***** Type Definitions *************************************************/
+
+/* Fixed item buffer as originally implemented: an item at a time, indices wrapped by modulo */
+typedef struct
+{
+  Uint8_t data[FIXED_BYTES_MAX];
+  Uint32_t entrySize;
+  Uint32_t entryMax;
+  Uint32_t indexIn;
+  Uint32_t indexOut;
+  Uint32_t count;
+  Uint32_t highWater;
+} FixedModel_t;
+
+/* Variable length buffer as originally implemented: a byte at a time, indices wrapped by modulo */
+typedef struct
+{
+  Uint8_t data[VAR_BYTES_MAX];
+  Uint32_t itemIndex[16];
+  Uint32_t itemSize[16];
+  Uint32_t totalSize;
+  Uint32_t entryMax;
+  Uint32_t bufferIndexIn;
+  Uint32_t usedBytes;
+  Uint32_t indexIn;
+  Uint32_t indexOut;
+  Uint32_t count;
+  Uint32_t highWater;
+} VarModel_t;
+
+/***** Variables ********************************************************/
+
+/* Buffers under test: capacities that are powers of two wrap by mask, the others by comparison */
+d_BUFFER_FIXED(bytes64, 1u, 64u);
+d_BUFFER_FIXED(triples, 3u, 100u);
+d_BUFFER_FIXED(records, 20u, 20u);
+d_BUFFER_FIXED(words128, 4u, 128u);
+
+const d_BUFFER_FixedDef_t d_BUFFER_FixedDef[] =
+{
+  d_BUFFER_FIXED_ENTRY(bytes64),
+  d_BUFFER_FIXED_ENTRY(triples),
+  d_BUFFER_FIXED_ENTRY(records),
+  d_BUFFER_FIXED_ENTRY(words128),
+};
+
+d_BUFFER_FIXED_COUNT;
+
+d_BUFFER_VAR(msg256, 256u, 16u);
+d_BUFFER_VAR(msg500, 500u, 5u);
+d_BUFFER_VAR(msg8k, VAR_BYTES_MAX, 8u);
+
+const d_BUFFER_VarDef_t d_BUFFER_VarDef[] =
+{
+  d_BUFFER_VAR_ENTRY(msg256),
+  d_BUFFER_VAR_ENTRY(msg500),
+  d_BUFFER_VAR_ENTRY(msg8k),
+};
+
+d_BUFFER_VAR_COUNT;
+
+static FixedModel_t fixedModel[FIXED_BUFFERS];
+static VarModel_t varModel[VAR_BUFFERS];
+
+static Uint8_t source[VAR_BYTES_MAX] __attribute__((aligned(64)));
+static Uint8_t result[VAR_BYTES_MAX] __attribute__((aligned(64)));
+static Uint8_t expected[VAR_BYTES_MAX] __attribute__((aligned(64)));
+
+static Uint32_t randomState = 2025u;
+
+/* Operations whose result differs from the model */
+static Uint32_t differences;
+
+/* Results of the benchmark loops, kept so that they are not optimised out */
+static volatile Uint32_t benchSink;
+
+/***** Function Definitions *********************************************/
+
+static Uint32_t randomNumber(const Uint32_t range)
+{
+  randomState = (randomState * 1664525u) + 1013904223u;
+
+  return (randomState >> 8u) % range;
+}
+
+static void randomFill(Uint8_t * const pData, const Uint32_t length)
+{
+  for (Uint32_t i = 0u; i < length; i++)
+  {
+    pData[i] = (Uint8_t)randomNumber(256u);
+  }
+}
+
+static void differs(const Char_t * const operation, const Uint32_t id, const Uint32_t step)
+{
+  if (differences < 10u)
+  {
+    printf("%s of buffer %u differs from the model at operation %u\n", operation, id, step);
+  }
+  ELSE_DO_NOTHING
+  differences++;
+}
+
+/* The original byte loops */
+static void setModel(Uint8_t * const pDestination, const Uint8_t value, const Uint32_t length)
+{
+  for (Uint32_t i = 0u; i < length; i++)
+  {
+    pDestination[i] = value;
+  }
+}
+
+static Bool_t compareModel(const Uint8_t * const pSource_1, const Uint8_t * const pSource_2, const Uint32_t length)
+{
+  Bool_t equal = d_TRUE;
+
+  for (Uint32_t i = 0u; (i < length) && (equal == d_TRUE); i++)
+  {
+    if (pSource_1[i] != pSource_2[i])
+    {
+      equal = d_FALSE;
+    }
+    ELSE_DO_NOTHING
+  }
+
+  return equal;
+}
+
+static d_Status_t fixedModelWrite(FixedModel_t * const pModel, const Uint8_t * const pData, const Uint32_t count,
+                                  Uint32_t * const pActual)
+{
+  Uint32_t written = 0u;
+
+  if ((count == 0u) || (count > pModel->entryMax))
+  {
+    return d_STATUS_INVALID_PARAMETER;
+  }
+  ELSE_DO_NOTHING
+
+  while ((written < count) && (pModel->count < pModel->entryMax))
+  {
+    for (Uint32_t b = 0u; b < pModel->entrySize; b++)
+    {
+      pModel->data[(pModel->indexIn * pModel->entrySize) + b] = pData[(written * pModel->entrySize) + b];
+    }
+    pModel->indexIn = (pModel->indexIn + 1u) % pModel->entryMax;
+    pModel->count++;
+    pModel->highWater = (pModel->count > pModel->highWater) ? pModel->count : pModel->highWater;
+    written++;
+  }
+  *pActual = written;
+
+  return (written < count) ? d_STATUS_BUFFER_FULL : d_STATUS_SUCCESS;
+}
+
+static d_Status_t fixedModelRead(FixedModel_t * const pModel, Uint8_t * const pData, const Uint32_t count,
+                                 Uint32_t * const pActual)
+{
+  Uint32_t read = 0u;
+
+  if ((count == 0u) || (count > pModel->entryMax))
+  {
+    return d_STATUS_INVALID_PARAMETER;
+  }
+  ELSE_DO_NOTHING
+
+  while ((read < count) && (pModel->count > 0u))
+  {
+    for (Uint32_t b = 0u; b < pModel->entrySize; b++)
+    {
+      pData[(read * pModel->entrySize) + b] = pModel->data[(pModel->indexOut * pModel->entrySize) + b];
+    }
+    pModel->indexOut = (pModel->indexOut + 1u) % pModel->entryMax;
+    pModel->count--;
+    read++;
+  }
+  *pActual = read;
+
+  return (read < count) ? d_STATUS_BUFFER_EMPTY : d_STATUS_SUCCESS;
+}
+
+static d_Status_t varModelWrite(VarModel_t * const pModel, const Uint8_t * const pData, const Uint32_t length)
+{
+  if (length == 0u)
+  {
+    return d_STATUS_INVALID_PARAMETER;
+  }
+  ELSE_DO_NOTHING
+
+  if ((pModel->count >= pModel->entryMax) || (length > (pModel->totalSize - pModel->usedBytes)))
+  {
+    return d_STATUS_BUFFER_FULL;
+  }
+  ELSE_DO_NOTHING
+
+  Uint32_t index = pModel->bufferIndexIn;
+  for (Uint32_t i = 0u; i < length; i++)
+  {
+    pModel->data[index] = pData[i];
+    index = (index + 1u) % pModel->totalSize;
+  }
+  pModel->itemIndex[pModel->indexIn] = pModel->bufferIndexIn;
+  pModel->itemSize[pModel->indexIn] = length;
+  pModel->bufferIndexIn = index;
+  pModel->indexIn = (pModel->indexIn + 1u) % pModel->entryMax;
+  pModel->usedBytes += length;
+  pModel->count++;
+  pModel->highWater = (pModel->count > pModel->highWater) ? pModel->count : pModel->highWater;
+
+  return d_STATUS_SUCCESS;
+}
+
+static d_Status_t varModelRead(VarModel_t * const pModel, Uint8_t * const pData, Uint32_t * const pLength)
+{
+  *pLength = 0u;
+  if (pModel->count == 0u)
+  {
+    return d_STATUS_BUFFER_EMPTY;
+  }
+  ELSE_DO_NOTHING
+
+  Uint32_t index = pModel->itemIndex[pModel->indexOut];
+  *pLength = pModel->itemSize[pModel->indexOut];
+  for (Uint32_t i = 0u; i < *pLength; i++)
+  {
+    pData[i] = pModel->data[index];
+    index = (index + 1u) % pModel->totalSize;
+  }
+  pModel->indexOut = (pModel->indexOut + 1u) % pModel->entryMax;
+  pModel->usedBytes -= *pLength;
+  pModel->count--;
+
+  return d_STATUS_SUCCESS;
+}
+
+static void fixedModelFlush(const Uint32_t id)
+{
+  fixedModel[id].indexIn = 0u;
+  fixedModel[id].indexOut = 0u;
+  fixedModel[id].count = 0u;
+  fixedModel[id].highWater = 0u;
+}
+
+static void varModelFlush(const Uint32_t id)
+{
+  varModel[id].bufferIndexIn = 0u;
+  varModel[id].usedBytes = 0u;
+  varModel[id].indexIn = 0u;
+  varModel[id].indexOut = 0u;
+  varModel[id].count = 0u;
+  varModel[id].highWater = 0u;
+}
+
+/* d_GEN_MemorySet and d_GEN_MemoryCompare against the byte loops, for every alignment and short lengths */
+static void memoryProperties(void)
+{
+  static Uint8_t block1[256u + 16u] __attribute__((aligned(8)));
+  static Uint8_t block2[256u + 16u] __attribute__((aligned(8)));
+  static Uint8_t model[256u + 16u] __attribute__((aligned(8)));
+  Uint32_t setFailures = 0u;
+  Uint32_t compareFailures = 0u;
+
+  for (Uint32_t offset = 0u; offset < 8u; offset++)
+  {
+    for (Uint32_t length = 0u; length <= 256u; length++)
+    {
+      Uint8_t value = (Uint8_t)randomNumber(256u);
+
+      memset(block1, 0x5A, sizeof(block1));
+      memset(model, 0x5A, sizeof(model));
+      d_GEN_MemorySet(&block1[offset], value, length);
+      setModel(&model[offset], value, length);
+      if (memcmp(block1, model, sizeof(block1)) != 0)
+      {
+        setFailures++;
+      }
+      ELSE_DO_NOTHING
+
+      /* Equal blocks, then a single byte changed at a random place, with the second block at every offset */
+      for (Uint32_t offset2 = 0u; offset2 < 8u; offset2++)
+      {
+        randomFill(&block1[offset], length);
+        memcpy(&block2[offset2], &block1[offset], length);
+        if (d_GEN_MemoryCompare(&block1[offset], &block2[offset2], length) != compareModel(&block1[offset], &block2[offset2], length))
+        {
+          compareFailures++;
+        }
+        ELSE_DO_NOTHING
+        if (length > 0u)
+        {
+          block2[offset2 + randomNumber(length)] ^= (Uint8_t)(1u << randomNumber(8u));
+          if (d_GEN_MemoryCompare(&block1[offset], &block2[offset2], length) != compareModel(&block1[offset], &block2[offset2], length))
+          {
+            compareFailures++;
+          }
+          ELSE_DO_NOTHING
+        }
+        ELSE_DO_NOTHING
+      }
+    }
+  }
+
+  TEST_CHECK_EQUAL(setFailures, 0u);
+  TEST_CHECK_EQUAL(compareFailures, 0u);
+}
+
+/* Random operations on every fixed buffer, with the same operations applied to its model */
+static void fixedProperties(void)
+{
+  d_BUFFER_FixedInitialise();
+  for (Uint32_t id = 0u; id < FIXED_BUFFERS; id++)
+  {
+    memset(&fixedModel[id], 0, sizeof(fixedModel[id]));
+    fixedModel[id].entrySize = d_BUFFER_FixedDef[id].entrySize;
+    fixedModel[id].entryMax = d_BUFFER_FixedDef[id].entryMax;
+  }
+  TEST_CHECK(d_BUFFER_FixedDef[0].entryMask == 63u);
+  TEST_CHECK(d_BUFFER_FixedDef[1].entryMask == 0u);
+
+  for (Uint32_t step = 0u; step < RANDOM_OPERATIONS; step++)
+  {
+    Uint32_t id = randomNumber(FIXED_BUFFERS);
+    FixedModel_t * pModel = &fixedModel[id];
+    Uint32_t operation = randomNumber(100u);
+    /* Counts from zero to one over the capacity, mostly within it */
+    Uint32_t count = (randomNumber(20u) == 0u) ? randomNumber(pModel->entryMax + 2u) : (1u + randomNumber(pModel->entryMax / 2u));
+    Uint32_t actual = 0xFFFFFFFFu;
+    Uint32_t modelActual = 0xFFFFFFFFu;
+    Uint32_t bufferCount;
+
+    if (operation < 48u)
+    {
+      randomFill(source, count * pModel->entrySize);
+      if ((d_BUFFER_FixedWrite(id, source, count, &actual) != fixedModelWrite(pModel, source, count, &modelActual)) ||
+          (actual != modelActual))
+      {
+        differs("write", id, step);
+      }
+      ELSE_DO_NOTHING
+    }
+    else if (operation < 98u)
+    {
+      memset(result, 0, sizeof(result));
+      memset(expected, 0, sizeof(expected));
+      if ((d_BUFFER_FixedRead(id, result, count, &actual) != fixedModelRead(pModel, expected, count, &modelActual)) ||
+          (actual != modelActual) || (memcmp(result, expected, sizeof(result)) != 0))
+      {
+        differs("read", id, step);
+      }
+      ELSE_DO_NOTHING
+    }
+    else
+    {
+      (void)d_BUFFER_FixedFlush(id);
+      fixedModelFlush(id);
+    }
+
+    (void)d_BUFFER_FixedCount(id, &bufferCount);
+    if ((bufferCount != pModel->count) || (d_BUFFER_FixedDef[id].pBufferFixedStatus->highWater != pModel->highWater))
+    {
+      differs("count", id, step);
+    }
+    ELSE_DO_NOTHING
+  }
+}
+
+/* Random operations on every variable length buffer, with the same operations applied to its model */
+static void varProperties(void)
+{
+  d_BUFFER_VarInitialise();
+  for (Uint32_t id = 0u; id < VAR_BUFFERS; id++)
+  {
+    memset(&varModel[id], 0, sizeof(varModel[id]));
+    varModel[id].totalSize = d_BUFFER_VarDef[id].totalSize;
+    varModel[id].entryMax = d_BUFFER_VarDef[id].entryMax;
+  }
+  TEST_CHECK(d_BUFFER_VarDef[0].sizeMask == 255u);
+  TEST_CHECK(d_BUFFER_VarDef[0].entryMask == 15u);
+  TEST_CHECK(d_BUFFER_VarDef[1].sizeMask == 0u);
+  TEST_CHECK(d_BUFFER_VarDef[1].entryMask == 0u);
+
+  for (Uint32_t step = 0u; step < RANDOM_OPERATIONS; step++)
+  {
+    Uint32_t id = randomNumber(VAR_BUFFERS);
+    VarModel_t * pModel = &varModel[id];
+    Uint32_t operation = randomNumber(100u);
+    /* Lengths from zero to the whole buffer, mostly short */
+    Uint32_t length = (randomNumber(10u) == 0u) ? randomNumber(pModel->totalSize + 1u) : randomNumber(pModel->totalSize / 4u);
+    Uint32_t bufferLength = 0xFFFFFFFFu;
+    Uint32_t modelLength = 0xFFFFFFFFu;
+    Uint32_t bufferCount;
+
+    if (operation < 50u)
+    {
+      randomFill(source, length);
+      if (d_BUFFER_VarWrite(id, source, length) != varModelWrite(pModel, source, length))
+      {
+        differs("write", id, step);
+      }
+      ELSE_DO_NOTHING
+    }
+    else if (operation < 99u)
+    {
+      memset(result, 0, sizeof(result));
+      memset(expected, 0, sizeof(expected));
+      if ((d_BUFFER_VarRead(id, result, &bufferLength) != varModelRead(pModel, expected, &modelLength)) ||
+          (bufferLength != modelLength) || (memcmp(result, expected, sizeof(result)) != 0))
+      {
+        differs("read", id, step);
+      }
+      ELSE_DO_NOTHING
+    }
+    else
+    {
+      (void)d_BUFFER_VarFlush(id);
+      varModelFlush(id);
+    }
+
+    (void)d_BUFFER_VarCount(id, &bufferCount);
+    if ((bufferCount != pModel->count) || (d_BUFFER_VarDef[id].pBufferVarStatus->highWater != pModel->highWater) ||
+        (d_BUFFER_VarDef[id].pBufferVarStatus->bufferUsedBytes != pModel->usedBytes))
+    {
+      differs("count", id, step);
+    }
+    ELSE_DO_NOTHING
+  }
+}
+
+/* Bytes per second of the routines and of the byte loops they replace, sizes 1 to 4096 */
+static void benchmark(void)
+{
+  VarModel_t * pModel = &varModel[BENCH_BUFFER];
+  Uint32_t length;
+
+  printf("MB/s      size   set bytes  MemorySet  compare bytes  MemoryCompare  buffer bytes  d_BUFFER\n");
+  randomFill(source, sizeof(source));
+  memcpy(expected, source, sizeof(expected));
+  d_BUFFER_VarInitialise();
+  varModelFlush(BENCH_BUFFER);
+
+  for (Uint32_t size = 1u; size <= MESSAGE_MAX; size *= 2u)
+  {
+    Uint32_t repeats = BENCH_BYTES / size;
+    Float64_t rate[6];
+    Float64_t start;
+
+    start = testSeconds();
+    for (Uint32_t i = 0u; i < repeats; i++)
+    {
+      setModel(result, (Uint8_t)i, size);
+      benchSink = result[i % size];
+    }
+    rate[0] = (Float64_t)(repeats * size) / ((testSeconds() - start) * 1.0e6);
+
+    start = testSeconds();
+    for (Uint32_t i = 0u; i < repeats; i++)
+    {
+      d_GEN_MemorySet(result, (Uint8_t)i, size);
+      benchSink = result[i % size];
+    }
+    rate[1] = (Float64_t)(repeats * size) / ((testSeconds() - start) * 1.0e6);
+
+    start = testSeconds();
+    for (Uint32_t i = 0u; i < repeats; i++)
+    {
+      benchSink = compareModel(source, expected, size);
+    }
+    rate[2] = (Float64_t)(repeats * size) / ((testSeconds() - start) * 1.0e6);
+
+    start = testSeconds();
+    for (Uint32_t i = 0u; i < repeats; i++)
+    {
+      benchSink = d_GEN_MemoryCompare(source, expected, size);
+    }
+    rate[3] = (Float64_t)(repeats * size) / ((testSeconds() - start) * 1.0e6);
+
+    /* A message written and read back, the buffer position moving on so that messages wrap */
+    start = testSeconds();
+    for (Uint32_t i = 0u; i < repeats; i++)
+    {
+      (void)varModelWrite(pModel, source, size);
+      (void)varModelRead(pModel, result, &length);
+      benchSink = length;
+    }
+    rate[4] = (Float64_t)(repeats * size) / ((testSeconds() - start) * 1.0e6);
+
+    start = testSeconds();
+    for (Uint32_t i = 0u; i < repeats; i++)
+    {
+      (void)d_BUFFER_VarWrite(BENCH_BUFFER, source, size);
+      (void)d_BUFFER_VarRead(BENCH_BUFFER, result, &length);
+      benchSink = length;
+    }
+    rate[5] = (Float64_t)(repeats * size) / ((testSeconds() - start) * 1.0e6);
+
+    printf("        %6u %11.0f %10.0f %14.0f %14.0f %13.0f %9.0f\n", size, rate[0], rate[1], rate[2], rate[3],
+           rate[4], rate[5]);
+
+    /* Beyond a few words the word and block loops leave the byte loops behind */
+    if (size >= 256u)
+    {
+      TEST_CHECK(rate[1] > rate[0]);
+      TEST_CHECK(rate[3] > rate[2]);
+      TEST_CHECK(rate[5] > rate[4]);
+    }
+    ELSE_DO_NOTHING
+  }
+}
+
+int main(void)
+{
+  host_Reset();
+
+  memoryProperties();
+  fixedProperties();
+  varProperties();
+  printf("%u operations differ from the model\n", differences);
+  TEST_CHECK_EQUAL(differences, 0u);
+  TEST_CHECK_EQUAL(host_CriticalDepth, 0);
+
+  benchmark();
+
+  return TEST_RESULT();
+}
@@ -0,0 +1,984 @@
+/*********************************************************************//**
+\file
+\brief
+  Module Title       : CAN bus accounting replay test
+
+  Abstract           : Replays a CAN trace through the bus accounting of
+                       the CAN service, can_main.c, with the PS CAN and
+                       HOLT drivers replaced by a model of their transmit
+                       FIFO and receive path. Frames sent by this node are
+                       written with can_write at their trace time, frames
+                       from other nodes are read with can_read. At every
+                       accounting window the statistics are compared with
+                       a reference calculated here from the trace: the
+                       bus utilisation from the bit-stuffed frame lengths,
+                       the frame rates overall and per ID, the transmit
+                       queue wait and the error counter trends of a
+                       scripted controller error history.
+
+                       The trace is a candump log, one frame a line:
+                         (<seconds>.<microseconds>) <interface> <id>#<data> [T|R]
+                       with a 3 digit ID for a standard frame and 8 digits
+                       for an extended one, R<n> as the data of a remote
+                       frame and T marking a frame this node transmitted.
+                       A capture is replayed by giving its file name, with
+                       no argument the test generates the EPU network
+                       traffic of the flight software, the 100 Hz raw
+                       command and the status and node status of the
+                       eight ESCs, and replays it on a PS CAN and a HOLT
+                       channel. The frame length calculation is also
+                       checked against a hand worked frame and the stuff
+                       bit bounds of the CAN specification, and the
+                       transmit FIFO is filled to check the rejection
+                       count and the queue wait of a burst.
+*************************************************************************/
+
+/***** Includes *********************************************************/
+
+#include <stdarg.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "can_interface.h"
+#include "soc/can/d_can.h"
+#include "sru/can_holt/d_can_holt.h"
+#include "sru/fcu/d_fcu.h"
+#include "host_stubs.h"
+#include "test_common.h"
+
+/***** Constants ********************************************************/
+
+#define WINDOW_US            (CAN_STATS_WINDOW_MS * 1000u)
+
+/* All channels run at 1 Mbit/s, a bit takes a microsecond */
+#define BIT_US               1u
+
+#define RECORDS_MAX          200000u
+
+/* Transmit FIFO depth of the PS CAN controller and of the HOLT HI-3110 */
+#define PS_TX_FIFO           64u
+#define HOLT_TX_FIFO         8u
+
+/* The estimate is made from timer ticks, each read may lose a microsecond */
+#define WAIT_TOLERANCE_US    2u
+
+/* Generated EPU traffic: DroneCAN identifiers as the EPU actuator builds them */
+#define EPU_TRACE_SECONDS    2u
+#define EPU_COMMAND_ID       0x08040619u    /* High priority raw command 1030 from node 25 */
+#define EPU_STATUS_ID        0x10040A00u    /* ESC status 1034 from node n, n added */
+#define EPU_NODE_STATUS_ID   0x18015500u    /* Node status 341 from node n, n added */
+#define EPU_COMMAND_US       10000u
+#define EPU_STATUS_US        10000u
+#define EPU_NODE_STATUS_US   1000000u
+
+/***** Type Definitions *************************************************/
+
+typedef struct
+{
+  Uint64_t timeUs;
+  can_msg_t frame;
+  Bool_t isTx;
+} Record_t;
+
+/* Error state of the controller reported at the end of a window */
+typedef struct
+{
+  Uint8_t tec;
+  Uint8_t rec;
+  Uint8_t flags;        /* CAN_ERR_FLAG_x */
+  Bool_t passive;
+  Bool_t busOff;
+} ErrorStep_t;
+
+typedef struct
+{
+  Uint32_t canMsgId;
+  Bool_t extended;
+  Bool_t isTx;
+  Uint32_t frames;
+  Uint32_t windowFrames;
+} ReferenceId_t;
+
+/***** Variables ********************************************************/
+
+static Record_t records[RECORDS_MAX];
+static Uint32_t recordCount;
+
+/* The receive path holds the frame the replay is about to read */
+static Bool_t rxPending;
+static can_msg_t rxFrame;
+
+/* Transmit FIFO of the driver model, the times its frames leave the bus */
+static Uint64_t txFifoEnd[PS_TX_FIFO];
+static Uint32_t txFifoCount;
+static Uint32_t txFifoDepth;
+static can_msg_t txLast;
+
+/* Driver and driver channel the replay expects the CAN service to use */
+static Bool_t expectHolt;
+static Uint32_t expectChannel;
+static Uint32_t driverChannelErrors;
+
+static Uint32_t errorSamples;
+static const ErrorStep_t * errorScript;
+static Uint32_t errorScriptLength;
+
+/* A transmit error burst, error passive, bus off and recovery */
+static const ErrorStep_t epuErrors[] =
+{
+  {  0u, 0u, 0u, d_FALSE, d_FALSE },
+  {  0u, 0u, 0u, d_FALSE, d_FALSE },
+  {  8u, 1u, CAN_ERR_FLAG_BIT, d_FALSE, d_FALSE },
+  { 64u, 2u, CAN_ERR_FLAG_BIT | CAN_ERR_FLAG_ACK, d_FALSE, d_FALSE },
+  { 136u, 2u, CAN_ERR_FLAG_ACK, d_TRUE, d_FALSE },
+  { 255u, 3u, CAN_ERR_FLAG_ACK | CAN_ERR_FLAG_FORM, d_TRUE, d_TRUE },
+  { 255u, 3u, 0u, d_TRUE, d_TRUE },
+  {  0u, 0u, 0u, d_FALSE, d_FALSE },
+  {  0u, 9u, CAN_ERR_FLAG_CRC | CAN_ERR_FLAG_STUFF, d_FALSE, d_FALSE },
+  {  0u, 4u, 0u, d_FALSE, d_FALSE },
+  {  0u, 131u, CAN_ERR_FLAG_CRC, d_TRUE, d_FALSE },
+  {  0u, 0u, 0u, d_FALSE, d_FALSE }
+};
+
+static Uint32_t randomState = 1043u;
+
+/***** Function Definitions *********************************************/
+
+static Uint32_t randomNumber(const Uint32_t range)
+{
+  randomState = (randomState * 1664525u) + 1013904223u;
+
+  return (randomState >> 8u) % range;
+}
+
+/* Console of the flight software, its printf is printf_ */
+int printf_(const char * format, ...)
+{
+  va_list args;
+  int count;
+
+  va_start(args, format);
+  count = vfprintf(stdout, format, args);
+  va_end(args);
+
+  return count;
+}
+
+/* Length of a frame from the bits of the frame written out one by one, as the
+   CAN specification describes it: the CRC-15 over the start of frame to the
+   data, then a stuff bit after five bits of the same level up to the CRC end */
+static Uint32_t referenceBits(const can_msg_t * const pFrame)
+{
+  Uint8_t bits[160];
+  Uint32_t count = 0u;
+  Uint32_t crc = 0u;
+  Uint32_t stuff = 0u;
+  Uint32_t run = 1u;
+  Uint8_t level;
+  Uint32_t dlc = (pFrame->dlc > CAN_MAX_DLC) ? CAN_MAX_DLC : pFrame->dlc;
+  Uint32_t fields[16][2];
+  Uint32_t fieldCount = 0u;
+
+  fields[fieldCount][0] = 0u;                                        fields[fieldCount++][1] = 1u;
+  fields[fieldCount][0] = (pFrame->can_msg_id >> 18u) & 0x7FFu;     fields[fieldCount++][1] = 11u;
+  if (pFrame->extended_id_flag == true)
+  {
+    fields[fieldCount][0] = 3u;                                      fields[fieldCount++][1] = 2u;
+    fields[fieldCount][0] = pFrame->can_msg_id & 0x3FFFFu;          fields[fieldCount++][1] = 18u;
+  }
+  ELSE_DO_NOTHING
+  fields[fieldCount][0] = (pFrame->is_remote_req == true) ? 1u : 0u; fields[fieldCount++][1] = 1u;
+  fields[fieldCount][0] = 0u;                                        fields[fieldCount++][1] = 2u;
+  fields[fieldCount][0] = dlc;                                       fields[fieldCount++][1] = 4u;
+
+  for (Uint32_t field = 0u; field < fieldCount; field++)
+  {
+    for (Uint32_t bit = fields[field][1]; bit > 0u; bit--)
+    {
+      bits[count++] = (Uint8_t)((fields[field][0] >> (bit - 1u)) & 1u);
+    }
+  }
+  for (Uint32_t byte = 0u; (pFrame->is_remote_req == false) && (byte < dlc); byte++)
+  {
+    for (Uint32_t bit = 8u; bit > 0u; bit--)
+    {
+      bits[count++] = (Uint8_t)((pFrame->data[byte] >> (bit - 1u)) & 1u);
+    }
+  }
+
+  for (Uint32_t i = 0u; i < count; i++)
+  {
+    Uint32_t next = bits[i] ^ ((crc >> 14u) & 1u);
+
+    crc = (crc << 1u) & 0x7FFFu;
+    crc ^= (next != 0u) ? 0x4599u : 0u;
+  }
+  for (Uint32_t bit = 15u; bit > 0u; bit--)
+  {
+    bits[count++] = (Uint8_t)((crc >> (bit - 1u)) & 1u);
+  }
+
+  level = bits[0];
+  for (Uint32_t i = 1u; i < count; i++)
+  {
+    if (bits[i] == level)
+    {
+      run++;
+    }
+    else
+    {
+      level = bits[i];
+      run = 1u;
+    }
+    if (run == 5u)
+    {
+      /* The stuff bit has the opposite level and starts the next run */
+      stuff++;
+      level ^= 1u;
+      run = 1u;
+    }
+    ELSE_DO_NOTHING
+  }
+
+  /* CRC delimiter, acknowledge slot and delimiter, end of frame and intermission */
+  return count + stuff + 13u;
+}
+
+Uint32_t d_FCU_SlotNumber(void)
+{
+  return 0u;
+}
+
+Int32_t d_FCU_GetMaster(void)
+{
+  return 0;
+}
+
+static void checkDriver(const Bool_t holt, const Uint32_t channel)
+{
+  if ((holt != expectHolt) || (channel != expectChannel))
+  {
+    driverChannelErrors++;
+  }
+  ELSE_DO_NOTHING
+}
+
+static d_Status_t modelSend(const Bool_t extended, const Uint32_t id, const Uint32_t exId, const Bool_t remote,
+                            const Uint32_t dataLength, const Uint8_t * const pData)
+{
+  Uint64_t now = host_TimerMicroseconds();
+  Uint64_t start = now;
+  d_Status_t status = d_STATUS_SUCCESS;
+
+  /* Frames leave the FIFO in order, one after the other */
+  while ((txFifoCount > 0u) && (txFifoEnd[0] <= now))
+  {
+    memmove(&txFifoEnd[0], &txFifoEnd[1], (txFifoCount - 1u) * sizeof(Uint64_t));
+    txFifoCount--;
+  }
+
+  memset(&txLast, 0, sizeof(txLast));
+  txLast.extended_id_flag = (extended == d_TRUE) ? true : false;
+  txLast.can_msg_id = (id << 18u) | exId;
+  txLast.is_remote_req = (remote == d_TRUE) ? true : false;
+  txLast.dlc = (Uint8_t)dataLength;
+  memcpy(txLast.data, pData, CAN_MAX_DLC);
+
+  if (txFifoCount == txFifoDepth)
+  {
+    status = d_STATUS_BUFFER_FULL;
+  }
+  else
+  {
+    if ((txFifoCount > 0u) && (txFifoEnd[txFifoCount - 1u] > start))
+    {
+      start = txFifoEnd[txFifoCount - 1u];
+    }
+    ELSE_DO_NOTHING
+    txFifoEnd[txFifoCount] = start + ((Uint64_t)referenceBits(&txLast) * BIT_US);
+    txFifoCount++;
+  }
+
+  return status;
+}
+
+d_Status_t d_CAN_Initialise(const Uint32_t channel)
+{
+  return d_STATUS_SUCCESS;
+}
+
+d_Status_t d_CAN_ModeSet(const Uint32_t channel, const d_CAN_Mode_t mode)
+{
+  return d_STATUS_SUCCESS;
+}
+
+d_Status_t d_CAN_SendMessage(const Uint32_t channel, const d_CAN_Message_t * const pMessage)
+{
+  checkDriver(d_FALSE, channel);
+
+  return modelSend(pMessage->extended, pMessage->id, pMessage->exId, pMessage->remoteTxRequest,
+                   pMessage->dataLength, pMessage->data);
+}
+
+d_Status_t d_CAN_ReceiveMessage(const Uint32_t channel, d_CAN_Message_t * const pMessage)
+{
+  d_Status_t status = d_STATUS_NO_DATA;
+
+  checkDriver(d_FALSE, channel);
+  if (rxPending == d_TRUE)
+  {
+    /* The controller splits the identifier as the driver reads it from the FIFO */
+    pMessage->extended = (rxFrame.extended_id_flag == true) ? d_TRUE : d_FALSE;
+    pMessage->id = (rxFrame.can_msg_id >> 18u) & 0x7FFu;
+    pMessage->exId = rxFrame.can_msg_id & 0x3FFFFu;
+    pMessage->substituteRemoteTxRequest = pMessage->extended;
+    pMessage->remoteTxRequest = (rxFrame.is_remote_req == true) ? d_TRUE : d_FALSE;
+    pMessage->dataLength = rxFrame.dlc;
+    memcpy(pMessage->data, rxFrame.data, CAN_MAX_DLC);
+    rxPending = d_FALSE;
+    status = d_STATUS_SUCCESS;
+  }
+  ELSE_DO_NOTHING
+
+  return status;
+}
+
+static ErrorStep_t errorStep(void)
+{
+  ErrorStep_t step = { 0u, 0u, 0u, d_FALSE, d_FALSE };
+
+  if (errorSamples < errorScriptLength)
+  {
+    step = errorScript[errorSamples];
+  }
+  ELSE_DO_NOTHING
+  errorSamples++;
+
+  return step;
+}
+
+d_Status_t d_CAN_ErrorStateGet(const Uint32_t channel, d_CAN_ErrorState_t * const pState)
+{
+  ErrorStep_t step = errorStep();
+
+  checkDriver(d_FALSE, channel);
+  pState->txErrorCount = step.tec;
+  pState->rxErrorCount = step.rec;
+  pState->errorFlags = (((step.flags & CAN_ERR_FLAG_BIT) != 0u) ? d_CAN_ESR_BERR_MASK : 0u) |
+                       (((step.flags & CAN_ERR_FLAG_STUFF) != 0u) ? d_CAN_ESR_STER_MASK : 0u) |
+                       (((step.flags & CAN_ERR_FLAG_FORM) != 0u) ? d_CAN_ESR_FMER_MASK : 0u) |
+                       (((step.flags & CAN_ERR_FLAG_CRC) != 0u) ? d_CAN_ESR_CRCER_MASK : 0u) |
+                       (((step.flags & CAN_ERR_FLAG_ACK) != 0u) ? d_CAN_ESR_ACKER_MASK : 0u);
+  pState->errorPassive = step.passive;
+  pState->busOff = step.busOff;
+
+  return d_STATUS_SUCCESS;
+}
+
+d_Status_t d_CAN_HOLT_Initialise(const Uint32_t channel)
+{
+  return d_STATUS_SUCCESS;
+}
+
+d_Status_t d_CAN_HOLT_ModeSet(const Uint32_t channel, const d_CAN_HOLT_Mode_t mode)
+{
+  return d_STATUS_SUCCESS;
+}
+
+d_Status_t d_CAN_HOLT_FilterDisable(const Uint32_t channel)
+{
+  return d_STATUS_SUCCESS;
+}
+
+d_Status_t d_CAN_HOLT_SendMessage(const Uint32_t channel, const d_CAN_HOLT_Message_t * const pMessage)
+{
+  checkDriver(d_TRUE, channel);
+
+  return modelSend(pMessage->extended, pMessage->id, pMessage->exId, pMessage->remoteTxRequest,
+                   pMessage->dataLength, pMessage->data);
+}
+
+d_Status_t d_CAN_HOLT_ReceiveMessage(const Uint32_t channel, d_CAN_HOLT_Message_t * const pMessage)
+{
+  d_Status_t status = d_STATUS_NO_DATA;
+
+  checkDriver(d_TRUE, channel);
+  if (rxPending == d_TRUE)
+  {
+    pMessage->extended = (rxFrame.extended_id_flag == true) ? d_TRUE : d_FALSE;
+    pMessage->id = (rxFrame.can_msg_id >> 18u) & 0x7FFu;
+    pMessage->exId = rxFrame.can_msg_id & 0x3FFFFu;
+    pMessage->substituteRemoteTxRequest = pMessage->extended;
+    pMessage->remoteTxRequest = (rxFrame.is_remote_req == true) ? d_TRUE : d_FALSE;
+    pMessage->dataLength = rxFrame.dlc;
+    memcpy(pMessage->data, rxFrame.data, CAN_MAX_DLC);
+    rxPending = d_FALSE;
+    status = d_STATUS_SUCCESS;
+  }
+  ELSE_DO_NOTHING
+
+  return status;
+}
+
+d_Status_t d_CAN_HOLT_ErrorStateGet(const Uint32_t channel, d_CAN_HOLT_ErrorState_t * const pState)
+{
+  ErrorStep_t step = errorStep();
+
+  checkDriver(d_TRUE, channel);
+  pState->txErrorCount = step.tec;
+  pState->rxErrorCount = step.rec;
+  pState->errorFlags = (((step.flags & CAN_ERR_FLAG_BIT) != 0u) ? d_CAN_HOLT_BITERR_MASK : 0u) |
+                       (((step.flags & CAN_ERR_FLAG_STUFF) != 0u) ? d_CAN_HOLT_STUFERR_MASK : 0u) |
+                       (((step.flags & CAN_ERR_FLAG_FORM) != 0u) ? d_CAN_HOLT_FRMERR_MASK : 0u) |
+                       (((step.flags & CAN_ERR_FLAG_CRC) != 0u) ? d_CAN_HOLT_CRCERR_MASK : 0u) |
+                       (((step.flags & CAN_ERR_FLAG_ACK) != 0u) ? d_CAN_HOLT_ACKERR_MASK : 0u);
+  pState->errorPassive = step.passive;
+  pState->busOff = step.busOff;
+
+  return d_STATUS_SUCCESS;
+}
+
+static void addRecord(const Uint64_t timeUs, const Uint32_t id, const Uint32_t dlc, const Bool_t isTx)
+{
+  if (recordCount < RECORDS_MAX)
+  {
+    Record_t * pRecord = &records[recordCount];
+
+    memset(pRecord, 0, sizeof(Record_t));
+    pRecord->timeUs = timeUs;
+    pRecord->frame.can_msg_id = id;
+    pRecord->frame.extended_id_flag = true;
+    pRecord->frame.dlc = (Uint8_t)dlc;
+    for (Uint32_t i = 0u; i < dlc; i++)
+    {
+      pRecord->frame.data[i] = (Uint8_t)randomNumber(256u);
+    }
+    pRecord->isTx = isTx;
+    recordCount++;
+  }
+  ELSE_DO_NOTHING
+}
+
+/* A three frame transfer of 14 payload bytes sent back to back from a time */
+static Uint64_t addTransfer(const Uint64_t timeUs, const Uint32_t id, const Bool_t isTx, const Bool_t backToBack)
+{
+  static const Uint32_t lengths[3] = {8u, 8u, 3u};
+  Uint64_t time = timeUs;
+
+  for (Uint32_t i = 0u; i < 3u; i++)
+  {
+    addRecord(time, id, lengths[i], isTx);
+    if (backToBack == d_TRUE)
+    {
+      time += (Uint64_t)referenceBits(&records[recordCount - 1u].frame) * BIT_US;
+    }
+    ELSE_DO_NOTHING
+  }
+
+  return time;
+}
+
+static int compareRecords(const Record_t * const pA, const Record_t * const pB)
+{
+  return (pA->timeUs < pB->timeUs) ? -1 : ((pA->timeUs > pB->timeUs) ? 1 : 0);
+}
+
+/* The EPU network: the raw command written at the frame rate in one go, each
+   ESC streaming its status at 100 Hz and its node status at 1 Hz */
+static void generateEpuTrace(void)
+{
+  recordCount = 0u;
+
+  for (Uint64_t time = 0u; time < ((Uint64_t)EPU_TRACE_SECONDS * 1000000u); time += EPU_COMMAND_US)
+  {
+    (void)addTransfer(time + 500u, EPU_COMMAND_ID, d_TRUE, d_FALSE);
+  }
+  for (Uint32_t node = 1u; node <= 8u; node++)
+  {
+    for (Uint64_t time = (Uint64_t)node * 1100u; time < ((Uint64_t)EPU_TRACE_SECONDS * 1000000u);
+         time += EPU_STATUS_US + randomNumber(40u) - 20u)
+    {
+      (void)addTransfer(time, EPU_STATUS_ID + node, d_FALSE, d_TRUE);
+    }
+    for (Uint64_t time = (Uint64_t)node * 3700u; time < ((Uint64_t)EPU_TRACE_SECONDS * 1000000u);
+         time += EPU_NODE_STATUS_US)
+    {
+      addRecord(time, EPU_NODE_STATUS_ID + node, 8u, d_FALSE);
+    }
+  }
+
+  /* Stable order, so the frames of a command written together stay in order */
+  for (Uint32_t i = 1u; i < recordCount; i++)
+  {
+    Record_t record = records[i];
+    Uint32_t j = i;
+
+    while ((j > 0u) && (compareRecords(&records[j - 1u], &record) > 0))
+    {
+      records[j] = records[j - 1u];
+      j--;
+    }
+    records[j] = record;
+  }
+}
+
+static void writeTrace(FILE * const pFile)
+{
+  for (Uint32_t i = 0u; i < recordCount; i++)
+  {
+    const can_msg_t * pFrame = &records[i].frame;
+    Uint64_t time = 1697000000000000uLL + records[i].timeUs;
+
+    fprintf(pFile, "(%llu.%06llu) can0 ", (unsigned long long)(time / 1000000u),
+            (unsigned long long)(time % 1000000u));
+    fprintf(pFile, (pFrame->extended_id_flag == true) ? "%08X#" : "%03X#", (unsigned int)pFrame->can_msg_id);
+    if (pFrame->is_remote_req == true)
+    {
+      fprintf(pFile, "R%u", (unsigned int)pFrame->dlc);
+    }
+    else
+    {
+      for (Uint32_t byte = 0u; byte < pFrame->dlc; byte++)
+      {
+        fprintf(pFile, "%02X", (unsigned int)pFrame->data[byte]);
+      }
+    }
+    fprintf(pFile, (records[i].isTx == d_TRUE) ? " T\n" : " R\n");
+  }
+}
+
+/* Reads a candump log, the times made relative to the first frame */
+static Bool_t readTrace(FILE * const pFile)
+{
+  char line[256];
+  Uint64_t firstUs = 0u;
+  Bool_t isOk = d_TRUE;
+
+  recordCount = 0u;
+  while ((fgets(line, sizeof(line), pFile) != NULL) && (recordCount < RECORDS_MAX))
+  {
+    unsigned long long seconds = 0u;
+    char fraction[8] = "";
+    char frameText[64] = "";
+    char direction[4] = "R";
+    char * pHash;
+    Record_t * pRecord = &records[recordCount];
+    Uint64_t microseconds = 0u;
+    unsigned int id = 0u;
+
+    if (sscanf(line, " (%llu.%6[0-9]) %*s %63s %3s", &seconds, fraction, frameText, direction) < 3)
+    {
+      continue;
+    }
+    pHash = strchr(frameText, '#');
+    if ((pHash == NULL) || (sscanf(frameText, "%x", &id) != 1))
+    {
+      isOk = d_FALSE;
+      continue;
+    }
+
+    /* The fraction is in microseconds when it has its 6 digits, shorter ones are padded */
+    for (Uint32_t digit = 0u; digit < 6u; digit++)
+    {
+      Bool_t present = (digit < strlen(fraction)) ? d_TRUE : d_FALSE;
+
+      microseconds = (microseconds * 10u) + ((present == d_TRUE) ? (Uint64_t)(fraction[digit] - '0') : 0u);
+    }
+    microseconds += (Uint64_t)seconds * 1000000u;
+    if (recordCount == 0u)
+    {
+      firstUs = microseconds;
+    }
+    ELSE_DO_NOTHING
+
+    memset(pRecord, 0, sizeof(Record_t));
+    pRecord->timeUs = microseconds - firstUs;
+    pRecord->frame.can_msg_id = id;
+    pRecord->frame.extended_id_flag = ((pHash - frameText) > 3) ? true : false;
+    pRecord->isTx = (direction[0] == 'T') ? d_TRUE : d_FALSE;
+    if (pHash[1] == 'R')
+    {
+      pRecord->frame.is_remote_req = true;
+      pRecord->frame.dlc = (pHash[2] != '\0') ? (Uint8_t)(pHash[2] - '0') : 0u;
+    }
+    else
+    {
+      for (const char * pData = &pHash[1]; (pData[0] != '\0') && (pData[1] != '\0') && (pRecord->frame.dlc < CAN_MAX_DLC);
+           pData += 2)
+      {
+        unsigned int byte = 0u;
+
+        (void)sscanf(pData, "%2x", &byte);
+        pRecord->frame.data[pRecord->frame.dlc] = (Uint8_t)byte;
+        pRecord->frame.dlc++;
+      }
+    }
+    recordCount++;
+  }
+
+  return isOk;
+}
+
+static void resetModel(const Uint32_t fifoDepth, const ErrorStep_t * const pScript, const Uint32_t scriptLength)
+{
+  host_Reset();
+  rxPending = d_FALSE;
+  txFifoCount = 0u;
+  txFifoDepth = fifoDepth;
+  errorSamples = 0u;
+  errorScript = pScript;
+  errorScriptLength = scriptLength;
+  driverChannelErrors = 0u;
+}
+
+static void advanceTo(const Uint64_t timeUs)
+{
+  Uint64_t now = host_TimerMicroseconds();
+
+  if (timeUs > now)
+  {
+    host_TimerAdvance((Uint32_t)(timeUs - now));
+  }
+  ELSE_DO_NOTHING
+}
+
+/* Replays the trace on a channel and compares every window with the reference */
+static void replay(const char * const pName, const can_channel_t channel, const ErrorStep_t * const pScript,
+                   const Uint32_t scriptLength)
+{
+  static ReferenceId_t ids[CAN_STATS_MAX_IDS];
+  Bool_t holt = (channel > CAN_CHANNEL_2) ? d_TRUE : d_FALSE;
+  can_bus_stats_t stats;
+  Uint32_t idCount = 0u;
+  Uint32_t idOverflow = 0u;
+  Uint32_t windowBits = 0u;
+  Uint32_t windowFrames = 0u;
+  Uint32_t windowWrites = 0u;
+  Uint32_t windowWaitUs = 0u;
+  Uint64_t backlogEndUs = 0u;
+  Uint32_t waitMaxUs = 0u;
+  Uint32_t txFrames = 0u;
+  Uint32_t rxFrames = 0u;
+  Uint32_t windows = 0u;
+  Uint32_t busOffCount = 0u;
+  Uint32_t errorWindows = 0u;
+  Uint8_t tecMax = 0u;
+  Uint8_t recMax = 0u;
+  const ErrorStep_t noErrors = { 0u, 0u, 0u, d_FALSE, d_FALSE };
+  ErrorStep_t previous = noErrors;
+  Uint32_t failures[8] = {0u};
+  float utilisationSum = 0.0f;
+  float utilisationPeak = 0.0f;
+  Uint32_t record = 0u;
+
+  resetModel(holt == d_TRUE ? HOLT_TX_FIFO : PS_TX_FIFO, pScript, scriptLength);
+  expectHolt = holt;
+  expectChannel = (holt == d_TRUE) ? (Uint32_t)(channel - CAN_CHANNEL_3) : (Uint32_t)channel;
+  memset(ids, 0, sizeof(ids));
+  TEST_CHECK_EQUAL(can_init(channel), CAN_OK);
+
+  while ((record < recordCount) || (windowFrames > 0u))
+  {
+    Uint64_t windowEnd = ((Uint64_t)windows + 1u) * WINDOW_US;
+
+    /* The frames of the window */
+    for (; (record < recordCount) && (records[record].timeUs < windowEnd); record++)
+    {
+      const Record_t * pRecord = &records[record];
+      Uint32_t bits = referenceBits(&pRecord->frame);
+      Uint32_t index = 0u;
+
+      advanceTo(pRecord->timeUs);
+      if (pRecord->isTx == d_TRUE)
+      {
+        Uint32_t wait = (backlogEndUs > pRecord->timeUs) ? (Uint32_t)(backlogEndUs - pRecord->timeUs) : 0u;
+
+        if (can_write(channel, &pRecord->frame) != CAN_OK)
+        {
+          failures[0]++;
+          continue;
+        }
+        if ((txLast.can_msg_id != pRecord->frame.can_msg_id) || (txLast.dlc != pRecord->frame.dlc))
+        {
+          failures[1]++;
+        }
+        ELSE_DO_NOTHING
+        (void)can_get_bus_stats(channel, &stats);
+        if ((stats.tx_wait_last_us + WAIT_TOLERANCE_US < wait) || (stats.tx_wait_last_us > wait + WAIT_TOLERANCE_US))
+        {
+          failures[2]++;
+        }
+        ELSE_DO_NOTHING
+        backlogEndUs = ((backlogEndUs > pRecord->timeUs) ? backlogEndUs : pRecord->timeUs) + ((Uint64_t)bits * BIT_US);
+        waitMaxUs = (wait > waitMaxUs) ? wait : waitMaxUs;
+        windowWrites++;
+        windowWaitUs += wait;
+        txFrames++;
+      }
+      else
+      {
+        can_msg_t read;
+
+        memset(&read, 0, sizeof(read));
+        rxFrame = pRecord->frame;
+        rxPending = d_TRUE;
+        if ((can_read(channel, &read) != CAN_OK) || (read.can_msg_id != pRecord->frame.can_msg_id) ||
+            (read.extended_id_flag != pRecord->frame.extended_id_flag) || (read.dlc != pRecord->frame.dlc) ||
+            (memcmp(read.data, pRecord->frame.data, pRecord->frame.dlc) != 0))
+        {
+          failures[3]++;
+        }
+        ELSE_DO_NOTHING
+        rxFrames++;
+      }
+      windowBits += bits;
+      windowFrames++;
+
+      while ((index < idCount) && ((ids[index].canMsgId != pRecord->frame.can_msg_id) ||
+                                   (ids[index].extended != (pRecord->frame.extended_id_flag ? d_TRUE : d_FALSE)) ||
+                                   (ids[index].isTx != pRecord->isTx)))
+      {
+        index++;
+      }
+      if ((index == idCount) && (idCount < CAN_STATS_MAX_IDS))
+      {
+        ids[index].canMsgId = pRecord->frame.can_msg_id;
+        ids[index].extended = pRecord->frame.extended_id_flag ? d_TRUE : d_FALSE;
+        ids[index].isTx = pRecord->isTx;
+        idCount++;
+      }
+      ELSE_DO_NOTHING
+      if (index < idCount)
+      {
+        ids[index].frames++;
+        ids[index].windowFrames++;
+      }
+      else
+      {
+        idOverflow++;
+      }
+    }
+
+    /* The window closes on the first access after it has elapsed */
+    advanceTo(windowEnd);
+    TEST_CHECK_EQUAL(can_get_bus_stats(channel, &stats), CAN_OK);
+    windows++;
+    {
+      ErrorStep_t step = (windows <= scriptLength) ? pScript[windows - 1u] : noErrors;
+      float utilisation = ((float)windowBits * 100.0f) / (float)(WINDOW_US / BIT_US);
+      Uint32_t meanWait = (windowWrites > 0u) ? (windowWaitUs / windowWrites) : 0u;
+
+      if ((stats.windows != windows) || (stats.frame_rate_hz != ((windowFrames * 1000u) / CAN_STATS_WINDOW_MS)) ||
+          ((stats.utilisation_pct - utilisation) > 1.0e-3f) || ((utilisation - stats.utilisation_pct) > 1.0e-3f))
+      {
+        failures[4]++;
+      }
+      ELSE_DO_NOTHING
+      if ((stats.tx_wait_mean_us + WAIT_TOLERANCE_US < meanWait) || (stats.tx_wait_mean_us > meanWait + WAIT_TOLERANCE_US))
+      {
+        failures[5]++;
+      }
+      ELSE_DO_NOTHING
+
+      busOffCount += ((step.busOff == d_TRUE) && (previous.busOff == d_FALSE)) ? 1u : 0u;
+      errorWindows += (step.flags != 0u) ? 1u : 0u;
+      tecMax = (step.tec > tecMax) ? step.tec : tecMax;
+      recMax = (step.rec > recMax) ? step.rec : recMax;
+      if ((stats.tec != step.tec) || (stats.rec != step.rec) || (stats.tec_trend != ((Int32_t)step.tec - (Int32_t)previous.tec)) ||
+          (stats.rec_trend != ((Int32_t)step.rec - (Int32_t)previous.rec)) || (stats.error_flags != step.flags) ||
+          (stats.bus_off != (step.busOff == d_TRUE)) || (stats.error_passive != (step.passive == d_TRUE)) ||
+          (stats.bus_off_count != busOffCount) || (stats.error_windows != errorWindows) || (stats.tec_max != tecMax) ||
+          (stats.rec_max != recMax))
+      {
+        failures[6]++;
+      }
+      ELSE_DO_NOTHING
+      previous = step;
+
+      for (Uint32_t index = 0u; index < idCount; index++)
+      {
+        can_id_stats_t idStats;
+
+        if ((can_get_id_stats(channel, (Uint8_t)index, &idStats) != CAN_OK) ||
+            (idStats.can_msg_id != ids[index].canMsgId) || (idStats.frames != ids[index].frames) ||
+            (idStats.rate_hz != ((ids[index].windowFrames * 1000u) / CAN_STATS_WINDOW_MS)) ||
+            (idStats.is_tx != (ids[index].isTx == d_TRUE)))
+        {
+          failures[7]++;
+        }
+        ELSE_DO_NOTHING
+        ids[index].windowFrames = 0u;
+      }
+
+      utilisationSum += utilisation;
+      utilisationPeak = (utilisation > utilisationPeak) ? utilisation : utilisationPeak;
+    }
+    windowBits = 0u;
+    windowFrames = 0u;
+    windowWrites = 0u;
+    windowWaitUs = 0u;
+  }
+
+  (void)can_get_bus_stats(channel, &stats);
+  printf("  %s: %u frames sent, %u received in %u windows, utilisation mean %.1f%% peak %.1f%%, wait max %u us, "
+         "%u IDs, %u frames over the ID table\n", pName, txFrames, rxFrames, windows,
+         (windows > 0u) ? (double)(utilisationSum / (float)windows) : 0.0, (double)utilisationPeak, waitMaxUs,
+         idCount, idOverflow);
+
+  TEST_CHECK_EQUAL(failures[0], 0u);   /* Writes refused */
+  TEST_CHECK_EQUAL(failures[1], 0u);   /* Frames written to the driver unlike the trace */
+  TEST_CHECK_EQUAL(failures[2], 0u);   /* Queue wait of a frame */
+  TEST_CHECK_EQUAL(failures[3], 0u);   /* Frames read unlike the trace */
+  TEST_CHECK_EQUAL(failures[4], 0u);   /* Window utilisation and frame rate */
+  TEST_CHECK_EQUAL(failures[5], 0u);   /* Window mean queue wait */
+  TEST_CHECK_EQUAL(failures[6], 0u);   /* Error counters and trends */
+  TEST_CHECK_EQUAL(failures[7], 0u);   /* Per-ID counts and rates */
+  TEST_CHECK_EQUAL(stats.tx_frames, txFrames);
+  TEST_CHECK_EQUAL(stats.rx_frames, rxFrames);
+  TEST_CHECK_EQUAL(stats.id_count, idCount);
+  TEST_CHECK_EQUAL(stats.id_overflow, idOverflow);
+  TEST_CHECK((stats.tx_wait_max_us + WAIT_TOLERANCE_US >= waitMaxUs) && (stats.tx_wait_max_us <= waitMaxUs + WAIT_TOLERANCE_US));
+  TEST_CHECK_NEAR(stats.utilisation_peak_pct, utilisationPeak, 1.0e-3);
+  TEST_CHECK_EQUAL(driverChannelErrors, 0u);
+}
+
+/* Frame lengths against a hand worked frame, the reference and the stuff bit bounds */
+static void testFrameBits(void)
+{
+  can_msg_t frame;
+  Uint32_t mismatches = 0u;
+  Uint32_t outOfBounds = 0u;
+
+  /* Standard ID 0 with no data: 34 dominant bits with a CRC of 0, a stuff bit
+     after each 5 of them, and the 13 bit tail */
+  memset(&frame, 0, sizeof(frame));
+  TEST_CHECK_EQUAL(can_frame_bits(&frame), 34u + 6u + 13u);
+  TEST_CHECK_EQUAL(referenceBits(&frame), 34u + 6u + 13u);
+  TEST_CHECK_EQUAL(can_frame_bits(NULL), 0u);
+
+  for (Uint32_t i = 0u; i < 100000u; i++)
+  {
+    Uint32_t bits;
+    Uint32_t stuffed;
+
+    memset(&frame, 0, sizeof(frame));
+    frame.extended_id_flag = (randomNumber(2u) != 0u) ? true : false;
+    frame.can_msg_id = (frame.extended_id_flag == true) ? randomNumber(0x20000000u) : (randomNumber(0x800u) << 18u);
+    frame.is_remote_req = (randomNumber(8u) == 0u) ? true : false;
+    frame.dlc = (Uint8_t)randomNumber(CAN_MAX_DLC + 1u);
+    /* Long runs of one level, where stuffing matters most, as often as random data */
+    for (Uint32_t byte = 0u; byte < CAN_MAX_DLC; byte++)
+    {
+      frame.data[byte] = (randomNumber(2u) != 0u) ? (Uint8_t)randomNumber(256u) : ((randomNumber(2u) != 0u) ? 0xFFu : 0x00u);
+    }
+
+    bits = can_frame_bits(&frame);
+    if (bits != referenceBits(&frame))
+    {
+      mismatches++;
+    }
+    ELSE_DO_NOTHING
+
+    /* Stuffed part from the start of frame to the CRC, 34 or 54 bits and the data */
+    stuffed = ((frame.extended_id_flag == true) ? 54u : 34u) + ((frame.is_remote_req == true) ? 0u : (8u * frame.dlc));
+    if ((bits < (stuffed + 13u)) || (bits > (stuffed + 13u + ((stuffed - 1u) / 4u))))
+    {
+      outOfBounds++;
+    }
+    ELSE_DO_NOTHING
+  }
+  TEST_CHECK_EQUAL(mismatches, 0u);
+  TEST_CHECK_EQUAL(outOfBounds, 0u);
+}
+
+/* A burst written faster than the bus takes it fills the FIFO */
+static void testFifoFull(void)
+{
+  can_bus_stats_t stats;
+  can_msg_t frame;
+  Uint32_t busy = 0u;
+  Uint32_t expectedWait = 0u;
+
+  resetModel(PS_TX_FIFO, NULL, 0u);
+  expectHolt = d_FALSE;
+  expectChannel = CAN_CHANNEL_2;
+  TEST_CHECK_EQUAL(can_init(CAN_CHANNEL_2), CAN_OK);
+
+  memset(&frame, 0, sizeof(frame));
+  frame.can_msg_id = EPU_COMMAND_ID;
+  frame.extended_id_flag = true;
+  frame.dlc = 8u;
+  for (Uint32_t i = 0u; i < (PS_TX_FIFO + 16u); i++)
+  {
+    frame.data[0] = (Uint8_t)i;
+    if (can_write(CAN_CHANNEL_2, &frame) == CAN_BUSY)
+    {
+      busy++;
+    }
+    else if (i < (PS_TX_FIFO - 1u))
+    {
+      expectedWait += can_frame_bits(&frame) * BIT_US;
+    }
+    ELSE_DO_NOTHING
+  }
+
+  (void)can_get_bus_stats(CAN_CHANNEL_2, &stats);
+  TEST_CHECK_EQUAL(busy, 16u);
+  TEST_CHECK_EQUAL(stats.tx_rejected, 16u);
+  TEST_CHECK_EQUAL(stats.tx_frames, PS_TX_FIFO);
+  /* The last frame accepted waits for all the others */
+  TEST_CHECK_EQUAL(stats.tx_wait_max_us, expectedWait);
+
+  /* Once the bus has taken the queue a frame goes straight out */
+  host_TimerAdvance(expectedWait + 1000u);
+  TEST_CHECK_EQUAL(can_write(CAN_CHANNEL_2, &frame), CAN_OK);
+  (void)can_get_bus_stats(CAN_CHANNEL_2, &stats);
+  TEST_CHECK_EQUAL(stats.tx_wait_last_us, 0u);
+  TEST_CHECK_EQUAL(driverChannelErrors, 0u);
+}
+
+int main(int argc, char *argv[])
+{
+  FILE * pTrace;
+
+  testFrameBits();
+  testFifoFull();
+
+  if (argc > 1)
+  {
+    /* A captured trace, replayed on a PS CAN channel */
+    pTrace = fopen(argv[1], "r");
+    TEST_CHECK(pTrace != NULL);
+    if (pTrace != NULL)
+    {
+      TEST_CHECK(readTrace(pTrace) == d_TRUE);
+      (void)fclose(pTrace);
+      replay(argv[1], CAN_CHANNEL_1, NULL, 0u);
+    }
+    ELSE_DO_NOTHING
+  }
+  else
+  {
+    /* The generated EPU traffic, written as a candump log and read back */
+    generateEpuTrace();
+    pTrace = tmpfile();
+    TEST_CHECK(pTrace != NULL);
+    if (pTrace != NULL)
+    {
+      Uint32_t generated = recordCount;
+
+      writeTrace(pTrace);
+      rewind(pTrace);
+      TEST_CHECK(readTrace(pTrace) == d_TRUE);
+      (void)fclose(pTrace);
+      TEST_CHECK_EQUAL(recordCount, generated);
+      replay("EPU traffic on PS CAN", CAN_CHANNEL_1, epuErrors, (Uint32_t)(sizeof(epuErrors) / sizeof(epuErrors[0])));
+      replay("EPU traffic on HOLT CAN", CAN_CHANNEL_4, epuErrors, (Uint32_t)(sizeof(epuErrors) / sizeof(epuErrors[0])));
+    }
+    ELSE_DO_NOTHING
+  }
+
+  TEST_CHECK_EQUAL(host_ErrorCount, 0u);
+
+  return TEST_RESULT();
+}
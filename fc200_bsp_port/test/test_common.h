@@ -0,0 +1,91 @@
+/*********************************************************************//**
+\file
+\brief
+  Module Title       : Host test checks
+
+  Abstract           : Check macros shared by the host tests. A failed
+                       check is reported with its location and the test
+                       carries on, TEST_RESULT gives the exit status.
+                       The benchmarks of the tests time themselves with
+                       testSeconds.
+*************************************************************************/
+
+#ifndef TEST_COMMON_H
+#define TEST_COMMON_H
+
+/***** Includes *********************************************************/
+
+#include <stdio.h>
+#include <time.h>
+
+/***** Variables ********************************************************/
+
+static unsigned int testChecks;
+static unsigned int testFailures;
+
+/***** Macros (Inline Functions) Definitions ****************************/
+
+#define TEST_CHECK(condition) \
+  do \
+  { \
+    testChecks++; \
+    if (!(condition)) \
+    { \
+      testFailures++; \
+      printf("%s:%d: check failed: %s\n", __FILE__, __LINE__, #condition); \
+    } \
+  } while (0)
+
+/* Check with the values of both sides printed on failure */
+#define TEST_CHECK_EQUAL(actual, expected) \
+  do \
+  { \
+    long long testActual = (long long)(actual); \
+    long long testExpected = (long long)(expected); \
+    testChecks++; \
+    if (testActual != testExpected) \
+    { \
+      testFailures++; \
+      printf("%s:%d: check failed: %s == %s (%lld != %lld)\n", __FILE__, __LINE__, #actual, #expected, \
+             testActual, testExpected); \
+    } \
+  } while (0)
+
+#define TEST_CHECK_NEAR(actual, expected, tolerance) \
+  do \
+  { \
+    double testActual = (double)(actual); \
+    double testExpected = (double)(expected); \
+    double testError = testActual - testExpected; \
+    testChecks++; \
+    if ((testError > (double)(tolerance)) || (testError < -(double)(tolerance))) \
+    { \
+      testFailures++; \
+      printf("%s:%d: check failed: %s ~ %s (%g, %g, tolerance %g)\n", __FILE__, __LINE__, #actual, \
+             #expected, testActual, testExpected, (double)(tolerance)); \
+    } \
+  } while (0)
+
+/***** Function Definitions *********************************************/
+
+/* Print the summary and give the exit status of the test */
+static int testResult(void)
+{
+  printf("%u checks, %u failed\n", testChecks, testFailures);
+
+  return (testFailures == 0u) ? 0 : 1;
+}
+
+#define TEST_RESULT() testResult()
+
+/* Host monotonic time in seconds, for the benchmarks */
+static double testSeconds(void)
+{
+  struct timespec now;
+
+  clock_gettime(CLOCK_MONOTONIC, &now);
+
+  return (double)now.tv_sec + ((double)now.tv_nsec * 1.0e-9);
+}
+
+#endif /* TEST_COMMON_H */
@@ -0,0 +1,438 @@
+/*********************************************************************//**
+\file
+\brief
+  Module Title       : Memory copy test
+
+  Abstract           : Checks d_GEN_MemoryCopy for every alignment of
+                       source and destination, and the DMA copy service
+                       against a model of the DMA channel: the DMA moves
+                       only whole cache lines of the destination, copies
+                       made by an interrupt handler or inside a critical
+                       section go to the CPU, and so do copies made while
+                       the channel is in use. The CPU copy variants are
+                       timed for a range of lengths and alignments, which
+                       gives the CPU half of the threshold tuning table.
+                       The DMA half is measured on the target by
+                       d_DMA_CopyCalibrate.
+*************************************************************************/
+
+/***** Includes *********************************************************/
+
+#include <stdio.h>
+#include <string.h>
+
+#include "soc/defines/d_common_types.h"
+#include "soc/defines/d_common_status.h"
+#include "soc/dma/d_dma.h"
+#include "soc/dma/d_dma_copy.h"
+#include "kernel/general/d_gen_memory.h"
+#include "host_stubs.h"
+#include "test_common.h"
+
+/***** Constants ********************************************************/
+
+#define CACHE_LINE_SIZE   32u
+#define BUFFER_SIZE       (64u * 1024u)
+#define GUARD             64u
+
+/* Polls of the channel status before the model completes a transfer */
+#define DMA_POLLS         20u
+
+/* Processor modes of the status register */
+#define CPSR_SYSTEM       0x1Fu
+#define CPSR_IRQ          0x12u
+#define CPSR_SUPERVISOR   0x13u
+#define CPSR_IRQ_MASKED   0x80u
+
+/* Bytes copied for each entry of the benchmark table */
+#define BENCH_BYTES       (8u * 1024u * 1024u)
+
+/***** Type Definitions *************************************************/
+
+typedef void (*copyFunction_t)(Uint8_t * const pDestination, const Uint8_t * const pSource, const Uint32_t length);
+
+/***** Variables ********************************************************/
+
+static Uint8_t source[BUFFER_SIZE + (2u * GUARD)] __attribute__((aligned(64)));
+static Uint8_t destination[BUFFER_SIZE + (2u * GUARD)] __attribute__((aligned(64)));
+static Uint8_t isrDestination[BUFFER_SIZE + (2u * GUARD)] __attribute__((aligned(64)));
+
+/* DMA channel model */
+static Bool_t dmaBusy;
+static Uint8_t * dmaDestination;
+static const Uint8_t * dmaSource;
+static Uint32_t dmaLength;
+static Uint32_t dmaPolls;
+static Uint32_t dmaStarts;
+static Uint32_t dmaUnaligned;
+
+/* Called once from the next poll of a busy channel, as an interrupt taken while the copy waits */
+static void (*interruptHook)(void);
+
+/* Callbacks of asynchronous copies */
+static Uint32_t asyncCallbacks;
+static d_Status_t asyncStatus;
+
+/* Results of the benchmark loops, kept so that they are not optimised out */
+static volatile Uint8_t benchSink;
+
+/***** Function Definitions *********************************************/
+
+d_Status_t d_DMA_Initialise(const Uint32_t channel)
+{
+  dmaBusy = d_FALSE;
+
+  return d_STATUS_SUCCESS;
+}
+
+/* The DMA must be given whole cache lines of the destination */
+d_Status_t d_DMA_StartMemToMemTransfer(const Uint32_t channel, const Uint8_t * const pDestination,
+                                       const Uint8_t * const pSource, const Uint32_t byteCount)
+{
+  if (dmaBusy == d_TRUE)
+  {
+    return d_STATUS_DEVICE_BUSY;
+  }
+  ELSE_DO_NOTHING
+
+  if ((((Pointer_t)pDestination % CACHE_LINE_SIZE) != 0u) || ((byteCount % CACHE_LINE_SIZE) != 0u))
+  {
+    dmaUnaligned++;
+  }
+  ELSE_DO_NOTHING
+
+  dmaDestination = (Uint8_t *)pDestination;
+  dmaSource = pSource;
+  dmaLength = byteCount;
+  dmaPolls = DMA_POLLS;
+  dmaBusy = d_TRUE;
+  dmaStarts++;
+
+  return d_STATUS_SUCCESS;
+}
+
+/* The data arrives when the transfer completes */
+d_Status_t d_DMA_TransferStatus(const Uint32_t channel)
+{
+  d_Status_t status = d_STATUS_SUCCESS;
+
+  if (dmaBusy == d_TRUE)
+  {
+    if (interruptHook != NULL)
+    {
+      void (*hook)(void) = interruptHook;
+      interruptHook = NULL;
+      hook();
+    }
+    ELSE_DO_NOTHING
+
+    if (dmaPolls > 0u)
+    {
+      dmaPolls--;
+      status = d_STATUS_DEVICE_BUSY;
+    }
+    else
+    {
+      memcpy(dmaDestination, dmaSource, dmaLength);
+      dmaBusy = d_FALSE;
+    }
+  }
+  ELSE_DO_NOTHING
+
+  return status;
+}
+
+static void asyncDone(const d_Status_t status, void * const pContext)
+{
+  asyncCallbacks++;
+  asyncStatus = status;
+}
+
+static void fillSource(void)
+{
+  for (Uint32_t i = 0u; i < sizeof(source); i++)
+  {
+    source[i] = (Uint8_t)((i * 7u) + (i >> 8u) + 1u);
+  }
+}
+
+/* Check a copy of length bytes from source offset to destination offset, and that nothing else changed */
+static Bool_t copyGood(const Uint8_t * const pBuffer, const Uint32_t destinationOffset, const Uint32_t sourceOffset,
+                       const Uint32_t length)
+{
+  Bool_t good = d_TRUE;
+
+  for (Uint32_t i = 0u; i < (BUFFER_SIZE + (2u * GUARD)); i++)
+  {
+    Bool_t inside = ((i >= destinationOffset) && (i < (destinationOffset + length))) ? d_TRUE : d_FALSE;
+    Uint8_t expected = (inside == d_TRUE) ? source[sourceOffset + (i - destinationOffset)] : 0xA5u;
+    if (pBuffer[i] != expected)
+    {
+      good = d_FALSE;
+    }
+    ELSE_DO_NOTHING
+  }
+
+  return good;
+}
+
+/* d_GEN_MemoryCopy for all alignments of source and destination within a word pair, short and long */
+static void cpuCopyAlignments(void)
+{
+  static const Uint32_t lengths[] = {0u, 1u, 3u, 15u, 16u, 17u, 31u, 32u, 33u, 63u, 64u, 65u, 100u, 1000u, 4099u};
+  Uint32_t failures = 0u;
+
+  for (Uint32_t d = 0u; d < 8u; d++)
+  {
+    for (Uint32_t s = 0u; s < 8u; s++)
+    {
+      for (Uint32_t l = 0u; l < (sizeof(lengths) / sizeof(lengths[0])); l++)
+      {
+        memset(destination, 0xA5, sizeof(destination));
+        d_GEN_MemoryCopy(&destination[GUARD + d], &source[GUARD + s], lengths[l]);
+        if (copyGood(destination, GUARD + d, GUARD + s, lengths[l]) != d_TRUE)
+        {
+          failures++;
+        }
+        ELSE_DO_NOTHING
+      }
+    }
+  }
+  TEST_CHECK_EQUAL(failures, 0u);
+}
+
+/* DMA copies at every offset within a cache line: the partial lines at each end are copied by the CPU */
+static void dmaCopyAlignments(void)
+{
+  d_DMA_CopyStats_t before;
+  d_DMA_CopyStats_t after;
+  Uint32_t failures = 0u;
+  Uint32_t starts = dmaStarts;
+
+  (void)d_DMA_CopyGetStats(&before);
+  for (Uint32_t d = 0u; d < CACHE_LINE_SIZE; d += 3u)
+  {
+    for (Uint32_t s = 0u; s < CACHE_LINE_SIZE; s += 5u)
+    {
+      Uint32_t length = 4096u + (d * 7u) + s;
+      memset(destination, 0xA5, sizeof(destination));
+      d_DMA_Copy(&destination[GUARD + d], &source[GUARD + s], length);
+      if (copyGood(destination, GUARD + d, GUARD + s, length) != d_TRUE)
+      {
+        failures++;
+      }
+      ELSE_DO_NOTHING
+    }
+  }
+  (void)d_DMA_CopyGetStats(&after);
+
+  TEST_CHECK_EQUAL(failures, 0u);
+  TEST_CHECK_EQUAL(dmaUnaligned, 0u);
+  TEST_CHECK_EQUAL(dmaStarts - starts, after.dmaCopies - before.dmaCopies);
+  TEST_CHECK_EQUAL(after.dmaCopies - before.dmaCopies, 77u);
+  TEST_CHECK_EQUAL(after.cpuCopies, before.cpuCopies);
+}
+
+/* A long copy made with the processor in a given state goes to the CPU, without touching the channel */
+static void cpuContext(const Uint32_t cpsr)
+{
+  d_DMA_CopyStats_t before;
+  d_DMA_CopyStats_t after;
+  Uint32_t starts = dmaStarts;
+
+  (void)d_DMA_CopyGetStats(&before);
+  host_Cpsr = cpsr;
+  memset(destination, 0xA5, sizeof(destination));
+  d_DMA_Copy(&destination[GUARD], &source[GUARD], BUFFER_SIZE);
+  host_Cpsr = CPSR_SYSTEM;
+  (void)d_DMA_CopyGetStats(&after);
+
+  TEST_CHECK(copyGood(destination, GUARD, GUARD, BUFFER_SIZE) == d_TRUE);
+  TEST_CHECK_EQUAL(dmaStarts, starts);
+  TEST_CHECK_EQUAL(after.cpuCopies - before.cpuCopies, 1u);
+  TEST_CHECK_EQUAL(after.contextFallbacks - before.contextFallbacks, 1u);
+}
+
+/* Interrupt handler copying a long message while the copy it interrupted waits for the DMA */
+static void copyingHandler(void)
+{
+  Uint32_t saved = host_Cpsr;
+
+  host_Cpsr = CPSR_IRQ;
+  memset(isrDestination, 0xA5, sizeof(isrDestination));
+  d_DMA_Copy(&isrDestination[GUARD], &source[GUARD + 8u], BUFFER_SIZE / 2u);
+  host_Cpsr = saved;
+}
+
+static void interruptDuringCopy(void)
+{
+  d_DMA_CopyStats_t before;
+  d_DMA_CopyStats_t after;
+  Uint32_t starts = dmaStarts;
+
+  (void)d_DMA_CopyGetStats(&before);
+  memset(destination, 0xA5, sizeof(destination));
+  interruptHook = copyingHandler;
+  d_DMA_Copy(&destination[GUARD], &source[GUARD], BUFFER_SIZE);
+  (void)d_DMA_CopyGetStats(&after);
+
+  TEST_CHECK(interruptHook == NULL);
+  TEST_CHECK(copyGood(destination, GUARD, GUARD, BUFFER_SIZE) == d_TRUE);
+  TEST_CHECK(copyGood(isrDestination, GUARD, GUARD + 8u, BUFFER_SIZE / 2u) == d_TRUE);
+  TEST_CHECK_EQUAL(dmaStarts - starts, 1u);
+  TEST_CHECK_EQUAL(after.dmaCopies - before.dmaCopies, 1u);
+  TEST_CHECK_EQUAL(after.contextFallbacks - before.contextFallbacks, 1u);
+}
+
+/* A copy made while an asynchronous copy holds the channel goes to the CPU */
+static void channelBusy(void)
+{
+  d_DMA_CopyStats_t before;
+  d_DMA_CopyStats_t after;
+
+  /* Not from an interrupt handler */
+  host_Cpsr = CPSR_IRQ;
+  TEST_CHECK_EQUAL(d_DMA_CopyAsync(&destination[GUARD], &source[GUARD], BUFFER_SIZE, asyncDone, NULL),
+                   d_STATUS_INVALID_MODE);
+  host_Cpsr = CPSR_SYSTEM;
+
+  memset(destination, 0xA5, sizeof(destination));
+  memset(isrDestination, 0xA5, sizeof(isrDestination));
+  (void)d_DMA_CopyGetStats(&before);
+  TEST_CHECK_EQUAL(d_DMA_CopyAsync(&destination[GUARD], &source[GUARD], BUFFER_SIZE, asyncDone, NULL),
+                   d_STATUS_SUCCESS);
+  TEST_CHECK_EQUAL(d_DMA_CopyAsync(&isrDestination[GUARD], &source[GUARD], BUFFER_SIZE, asyncDone, NULL),
+                   d_STATUS_DEVICE_BUSY);
+  d_DMA_Copy(&isrDestination[GUARD], &source[GUARD + 1u], BUFFER_SIZE);
+  (void)d_DMA_CopyGetStats(&after);
+  TEST_CHECK_EQUAL(after.busyFallbacks - before.busyFallbacks, 1u);
+  TEST_CHECK(copyGood(isrDestination, GUARD, GUARD + 1u, BUFFER_SIZE) == d_TRUE);
+
+  while (d_DMA_CopyPoll() == d_TRUE)
+  {
+  }
+  TEST_CHECK_EQUAL(asyncCallbacks, 1u);
+  TEST_CHECK_EQUAL(asyncStatus, d_STATUS_SUCCESS);
+  TEST_CHECK(copyGood(destination, GUARD, GUARD, BUFFER_SIZE) == d_TRUE);
+}
+
+/* util_memcpy before it moved to d_DMA_Copy */
+static void byteCopy(Uint8_t * const pDestination, const Uint8_t * const pSource, const Uint32_t length)
+{
+  for (Uint32_t i = 0u; i < length; i++)
+  {
+    pDestination[i] = pSource[i];
+  }
+}
+
+/* d_GEN_MemoryCopy before the change: words only when both ends are word aligned */
+static void wordCopy(Uint8_t * const pDestination, const Uint8_t * const pSource, const Uint32_t length)
+{
+  Uint32_t index;
+
+  if ((((Pointer_t)pDestination % 4u) != 0u) || (((Pointer_t)pSource % 4u) != 0u) || (length < 16u))
+  {
+    for (index = 0u; index < length; index++)
+    {
+      pDestination[index] = pSource[index];
+    }
+  }
+  else
+  {
+    Uint32_t * destination32 = (Uint32_t *)pDestination;
+    const Uint32_t * source32 = (const Uint32_t *)pSource;
+    for (index = 0u; index < (length / 4u); index++)
+    {
+      destination32[index] = source32[index];
+    }
+    for (index = 0u; index < (length % 4u); index++)
+    {
+      pDestination[(length & ~3u) + index] = pSource[(length & ~3u) + index];
+    }
+  }
+}
+
+static void libraryCopy(Uint8_t * const pDestination, const Uint8_t * const pSource, const Uint32_t length)
+{
+  (void)memcpy(pDestination, pSource, length);
+}
+
+/* Megabytes per second of one copy function */
+static Float64_t copyRate(const copyFunction_t copy, const Uint32_t length, const Uint32_t destinationOffset,
+                          const Uint32_t sourceOffset)
+{
+  Uint32_t repeats = BENCH_BYTES / length;
+  Float64_t start = testSeconds();
+
+  for (Uint32_t i = 0u; i < repeats; i++)
+  {
+    copy(&destination[GUARD + destinationOffset], &source[GUARD + sourceOffset], length);
+    benchSink = destination[GUARD + destinationOffset + (i % length)];
+  }
+
+  return ((Float64_t)repeats * (Float64_t)length) / ((testSeconds() - start) * 1.0e6);
+}
+
+/* The CPU half of the threshold table: MB/s of each variant by length and alignment */
+static void benchmark(void)
+{
+  static const Uint32_t lengths[] = {16u, 64u, 256u, 1024u, 4096u, 16384u, 65536u - 64u};
+  static const Uint32_t offsets[3][2] = {{0u, 0u}, {1u, 1u}, {1u, 3u}};
+  static const Char_t * const alignment[3] = {"aligned", "same misalignment", "different alignment"};
+
+  printf("CPU copy, MB/s        length   byte loop   old word   d_GEN_MemoryCopy   memcpy\n");
+  for (Uint32_t a = 0u; a < 3u; a++)
+  {
+    printf("%s\n", alignment[a]);
+    for (Uint32_t l = 0u; l < (sizeof(lengths) / sizeof(lengths[0])); l++)
+    {
+      Uint32_t d = offsets[a][0];
+      Uint32_t s = offsets[a][1];
+      Float64_t bytes = copyRate(byteCopy, lengths[l], d, s);
+      Float64_t word = copyRate(wordCopy, lengths[l], d, s);
+      Float64_t current = copyRate(d_GEN_MemoryCopy, lengths[l], d, s);
+      Float64_t library = copyRate(libraryCopy, lengths[l], d, s);
+
+      printf("                      %6u %11.0f %10.0f %18.0f %8.0f\n", lengths[l], bytes, word, current, library);
+
+      /* With the same misalignment the old routine fell back to bytes, the new one copies words */
+      if ((a == 1u) && (lengths[l] >= 1024u))
+      {
+        TEST_CHECK(current > (1.5 * word));
+      }
+      ELSE_DO_NOTHING
+    }
+  }
+  printf("The DMA times of the table are measured on the target by d_DMA_CopyCalibrate\n");
+}
+
+int main(void)
+{
+  host_Reset();
+  fillSource();
+
+  cpuCopyAlignments();
+
+  /* Until the channel is initialised every copy is made by the CPU */
+  memset(destination, 0xA5, sizeof(destination));
+  d_DMA_Copy(&destination[GUARD], &source[GUARD], BUFFER_SIZE);
+  TEST_CHECK(copyGood(destination, GUARD, GUARD, BUFFER_SIZE) == d_TRUE);
+  TEST_CHECK_EQUAL(dmaStarts, 0u);
+
+  TEST_CHECK_EQUAL(d_DMA_CopyInitialise(), d_STATUS_SUCCESS);
+  dmaCopyAlignments();
+
+  /* Interrupt handlers in IRQ or supervisor mode, and critical sections, copy by CPU */
+  cpuContext(CPSR_IRQ);
+  cpuContext(CPSR_SUPERVISOR);
+  cpuContext(CPSR_SYSTEM | CPSR_IRQ_MASKED);
+  interruptDuringCopy();
+  channelBusy();
+
+  TEST_CHECK_EQUAL(host_ErrorCount, 1u);
+  TEST_CHECK_EQUAL(host_ErrorLast, d_STATUS_INVALID_MODE);
+
+  benchmark();
+
+  return TEST_RESULT();
+}
@@ -0,0 +1,379 @@
+/*********************************************************************//**
+\file
+\brief
+  Module Title       : FCS input selection fault injection test
+
+  Abstract           : Feeds two channels of air data and navigation
+                       input to the selection with faults injected into
+                       them: a channel absent, a stale sample, a signal
+                       flagged invalid by its source, NaN and infinity, a
+                       step above the rate limit and a persistent
+                       disagreement between the channels. The selected
+                       channel, the fault bits, the validity flags of the
+                       output and the counters are checked frame by frame,
+                       as is the yaw comparison across the wrap at pi.
+*************************************************************************/
+
+/***** Includes *********************************************************/
+
+#include <math.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "soc/defines/d_common_types.h"
+#include "fcs_input_sel.h"
+#include "test_common.h"
+
+/***** Constants ********************************************************/
+
+/* Healthy air data of both channels, in the units of the selection */
+#define AOA_DEG   4.0
+#define AOS_DEG   -1.0
+#define CAS_MPS   30.0
+#define BARO_M    350.0
+
+/***** Variables ********************************************************/
+
+static fcs_sel_ads_in_t adsIn[FCS_SEL_CHANNELS];
+static ads_data_t adsOut;
+static fcs_sel_nav_in_t navIn[FCS_SEL_CHANNELS];
+static nav_data_t navOut;
+static fcs_sel_status_t status;
+
+/***** Function Definitions *********************************************/
+
+/* Both air data channels present, fresh and agreeing */
+static void adsHealthy(void)
+{
+  for (Uint32_t ch = 0u; ch < FCS_SEL_CHANNELS; ch++)
+  {
+    memset(&adsIn[ch], 0, sizeof(adsIn[ch]));
+    adsIn[ch].data.aoa = (real_T)AOA_DEG;
+    adsIn[ch].data.aos = (real_T)AOS_DEG;
+    adsIn[ch].data.aspd_cas = (real_T)CAS_MPS;
+    adsIn[ch].data.alt_baro_amsl = (real_T)BARO_M;
+    adsIn[ch].present = true;
+    adsIn[ch].age_known = true;
+    adsIn[ch].age_us = 5000u;
+  }
+}
+
+/* One frame of air data selection */
+static void adsFrame(void)
+{
+  fcs_sel_ads(adsIn, &adsOut);
+  fcs_sel_get_status(&status);
+}
+
+/* Starts a case from a clean selection state and one healthy frame */
+static void adsStart(void)
+{
+  fcs_sel_init();
+  adsHealthy();
+  adsFrame();
+}
+
+static void testHealthy(void)
+{
+  adsStart();
+
+  for (Uint32_t g = 0u; g < FCS_SEL_ADS_GROUPS; g++)
+  {
+    TEST_CHECK_EQUAL(status.ads_selected[g], 0);
+    TEST_CHECK_EQUAL(status.ads_fault[0][g], 0u);
+    TEST_CHECK_EQUAL(status.ads_fault[1][g], 0u);
+  }
+  TEST_CHECK_NEAR(adsOut.aoa, AOA_DEG, 1.0e-6);
+  TEST_CHECK_NEAR(adsOut.aos, AOS_DEG, 1.0e-6);
+  TEST_CHECK_NEAR(adsOut.aspd_cas, CAS_MPS, 1.0e-6);
+  TEST_CHECK_NEAR(adsOut.alt_baro_amsl, BARO_M, 1.0e-4);
+  TEST_CHECK_EQUAL(adsOut.aoa_invalid, 0u);
+  TEST_CHECK_EQUAL(adsOut.aos_invalid, 0u);
+  TEST_CHECK_EQUAL(adsOut.aspd_cas_invalid, 0u);
+  TEST_CHECK_EQUAL(adsOut.baro_invalid, 0u);
+  TEST_CHECK_EQUAL(status.held_frames, 0u);
+
+  /* No inputs: nothing is written */
+  fcs_sel_ads(NULL, &adsOut);
+  fcs_sel_nav(navIn, NULL);
+}
+
+/* A missing channel is replaced by the other, and taken back when it returns */
+static void testAbsent(void)
+{
+  adsStart();
+
+  adsIn[0].present = false;
+  adsIn[1].data.aspd_cas = (real_T)(CAS_MPS + 1.0);
+  adsFrame();
+  TEST_CHECK_EQUAL(status.ads_fault[0][FCS_SEL_ADS_CAS], FCS_SEL_FAULT_ABSENT);
+  TEST_CHECK_EQUAL(status.ads_selected[FCS_SEL_ADS_CAS], 1);
+  TEST_CHECK_NEAR(adsOut.aspd_cas, CAS_MPS + 1.0, 1.0e-6);
+  TEST_CHECK_EQUAL(adsOut.aspd_cas_invalid, 0u);
+
+  /* The selection stays on channel 1 while the channels agree */
+  adsIn[0].present = true;
+  adsFrame();
+  TEST_CHECK_EQUAL(status.ads_fault[0][FCS_SEL_ADS_CAS], 0u);
+  TEST_CHECK_EQUAL(status.ads_selected[FCS_SEL_ADS_CAS], 1);
+
+  /* Both absent: the output is held and flagged invalid */
+  adsIn[0].present = false;
+  adsIn[1].present = false;
+  adsIn[1].data.aspd_cas = (real_T)0.0;
+  adsFrame();
+  TEST_CHECK_EQUAL(status.ads_selected[FCS_SEL_ADS_CAS], FCS_SEL_HELD);
+  TEST_CHECK_NEAR(adsOut.aspd_cas, CAS_MPS + 1.0, 1.0e-6);
+  TEST_CHECK_EQUAL(adsOut.aspd_cas_invalid, 1u);
+  TEST_CHECK_EQUAL(status.held_frames, FCS_SEL_ADS_GROUPS);
+}
+
+/* Old samples are not selected, samples of unknown age are */
+static void testStale(void)
+{
+  adsStart();
+
+  adsIn[0].age_us = FCS_SEL_MAX_AGE_US + 1u;
+  adsFrame();
+  TEST_CHECK_EQUAL(status.ads_fault[0][FCS_SEL_ADS_AOA], FCS_SEL_FAULT_STALE);
+  TEST_CHECK_EQUAL(status.ads_selected[FCS_SEL_ADS_AOA], 1);
+
+  adsIn[0].age_us = FCS_SEL_MAX_AGE_US;
+  adsIn[1].age_us = FCS_SEL_MAX_AGE_US + 1u;
+  adsFrame();
+  TEST_CHECK_EQUAL(status.ads_fault[0][FCS_SEL_ADS_AOA], 0u);
+  TEST_CHECK_EQUAL(status.ads_fault[1][FCS_SEL_ADS_AOA], FCS_SEL_FAULT_STALE);
+  TEST_CHECK_EQUAL(status.ads_selected[FCS_SEL_ADS_AOA], 0);
+
+  adsIn[1].age_known = false;
+  adsFrame();
+  TEST_CHECK_EQUAL(status.ads_fault[1][FCS_SEL_ADS_AOA], 0u);
+}
+
+/* A signal flagged invalid by its source is used only when nothing better exists */
+static void testSourceInvalid(void)
+{
+  adsStart();
+
+  adsIn[0].data.aoa_invalid = 1u;
+  adsIn[1].data.aoa = (real_T)(AOA_DEG + 0.5);
+  adsFrame();
+  TEST_CHECK_EQUAL(status.ads_fault[0][FCS_SEL_ADS_AOA], FCS_SEL_FAULT_SOURCE);
+  TEST_CHECK_EQUAL(status.ads_selected[FCS_SEL_ADS_AOA], 1);
+  TEST_CHECK_NEAR(adsOut.aoa, AOA_DEG + 0.5, 1.0e-6);
+  TEST_CHECK_EQUAL(adsOut.aoa_invalid, 0u);
+
+  /* The other groups of the channel are not affected */
+  TEST_CHECK_EQUAL(status.ads_fault[0][FCS_SEL_ADS_AOS], 0u);
+  TEST_CHECK_EQUAL(status.ads_selected[FCS_SEL_ADS_AOS], 0);
+
+  /* Both flagged: channel 0 is passed on, flagged invalid */
+  adsIn[1].data.aoa_invalid = 1u;
+  adsFrame();
+  TEST_CHECK_EQUAL(status.ads_selected[FCS_SEL_ADS_AOA], 0);
+  TEST_CHECK_NEAR(adsOut.aoa, AOA_DEG, 1.0e-6);
+  TEST_CHECK_EQUAL(adsOut.aoa_invalid, 1u);
+  TEST_CHECK_EQUAL(status.held_frames, 0u);
+
+  /* A flagged channel that is also absent is not used */
+  adsIn[0].present = false;
+  adsFrame();
+  TEST_CHECK_EQUAL(status.ads_selected[FCS_SEL_ADS_AOA], 1);
+  TEST_CHECK_EQUAL(adsOut.aoa_invalid, 1u);
+}
+
+/* NaN and infinity are rejected, the last output is held when both channels carry them */
+static void testNonFinite(void)
+{
+  adsStart();
+
+  adsIn[0].data.aos = (real_T)NAN;
+  adsFrame();
+  TEST_CHECK_EQUAL(status.ads_fault[0][FCS_SEL_ADS_AOS], FCS_SEL_FAULT_NONFINITE);
+  TEST_CHECK_EQUAL(status.ads_selected[FCS_SEL_ADS_AOS], 1);
+  TEST_CHECK(isfinite(adsOut.aos));
+
+  adsIn[1].data.aos = (real_T)INFINITY;
+  adsFrame();
+  TEST_CHECK_EQUAL(status.ads_fault[1][FCS_SEL_ADS_AOS], FCS_SEL_FAULT_NONFINITE);
+  TEST_CHECK_EQUAL(status.ads_selected[FCS_SEL_ADS_AOS], FCS_SEL_HELD);
+  TEST_CHECK_NEAR(adsOut.aos, AOS_DEG, 1.0e-6);
+  TEST_CHECK_EQUAL(adsOut.aos_invalid, 1u);
+  TEST_CHECK_EQUAL(status.held_frames, 1u);
+
+  /* A source flag does not let a non-finite value through */
+  adsIn[0].data.aos_invalid = 1u;
+  adsIn[1].data.aos_invalid = 1u;
+  adsFrame();
+  TEST_CHECK_EQUAL(status.ads_selected[FCS_SEL_ADS_AOS], FCS_SEL_HELD);
+  TEST_CHECK(isfinite(adsOut.aos));
+
+  /* The last finite value stays the reference of the rate check */
+  adsHealthy();
+  adsFrame();
+  TEST_CHECK_EQUAL(status.ads_fault[0][FCS_SEL_ADS_AOS], 0u);
+  TEST_CHECK_EQUAL(status.ads_selected[FCS_SEL_ADS_AOS], 0);
+  TEST_CHECK_EQUAL(adsOut.aos_invalid, 0u);
+}
+
+/* A step above the rate limit is rejected for one frame, then miscompares */
+static void testRateStep(void)
+{
+  Uint32_t frame;
+
+  adsStart();
+
+  adsIn[0].data.alt_baro_amsl = (real_T)(BARO_M + 50.0);
+  adsFrame();
+  TEST_CHECK_EQUAL(status.ads_fault[0][FCS_SEL_ADS_BARO], FCS_SEL_FAULT_RATE);
+  TEST_CHECK_EQUAL(status.rate_rejections, 1u);
+  TEST_CHECK_EQUAL(status.ads_selected[FCS_SEL_ADS_BARO], 1);
+  TEST_CHECK_NEAR(adsOut.alt_baro_amsl, BARO_M, 1.0e-4);
+
+  /* The step is accepted a frame late, it is outside the 20 m tolerance */
+  for (frame = 1u; frame < FCS_SEL_MISCOMPARE_FRAMES; frame++)
+  {
+    adsFrame();
+    TEST_CHECK_EQUAL(status.ads_fault[0][FCS_SEL_ADS_BARO], 0u);
+    TEST_CHECK_EQUAL(status.ads_selected[FCS_SEL_ADS_BARO], 1);
+    TEST_CHECK_EQUAL(status.miscompares, 0u);
+  }
+  adsFrame();
+  TEST_CHECK_EQUAL(status.miscompares, 1u);
+  TEST_CHECK_EQUAL(status.ads_fault[0][FCS_SEL_ADS_BARO], FCS_SEL_FAULT_MISCOMPARE);
+  TEST_CHECK_EQUAL(status.ads_fault[1][FCS_SEL_ADS_BARO], FCS_SEL_FAULT_MISCOMPARE);
+
+  /* Mid value: the channel that kept to the previous output */
+  TEST_CHECK_EQUAL(status.ads_selected[FCS_SEL_ADS_BARO], 1);
+  TEST_CHECK_NEAR(adsOut.alt_baro_amsl, BARO_M, 1.0e-4);
+  TEST_CHECK_EQUAL(adsOut.baro_invalid, 0u);
+  TEST_CHECK_EQUAL(status.rate_rejections, 1u);
+}
+
+/* A persistent drift of one channel, declared after FCS_SEL_MISCOMPARE_FRAMES frames */
+static void testMiscompare(void)
+{
+  Uint32_t frame;
+
+  adsStart();
+
+  /* Channel 0 drifts within the rate limit to 6 deg off channel 1 */
+  adsIn[0].data.aoa = (real_T)(AOA_DEG + 6.0);
+  for (frame = 0u; frame < (FCS_SEL_MISCOMPARE_FRAMES - 1u); frame++)
+  {
+    adsFrame();
+    TEST_CHECK_EQUAL(status.ads_selected[FCS_SEL_ADS_AOA], 0);
+    TEST_CHECK_EQUAL(status.ads_fault[0][FCS_SEL_ADS_AOA], 0u);
+  }
+  TEST_CHECK_NEAR(adsOut.aoa, AOA_DEG + 6.0, 1.0e-6);
+
+  /* Once declared, the output goes to the channel nearest it */
+  adsIn[1].data.aoa = (real_T)(AOA_DEG + 0.5);
+  adsFrame();
+  TEST_CHECK_EQUAL(status.miscompares, 1u);
+  TEST_CHECK_EQUAL(status.ads_fault[1][FCS_SEL_ADS_AOA], FCS_SEL_FAULT_MISCOMPARE);
+  TEST_CHECK_EQUAL(status.ads_selected[FCS_SEL_ADS_AOA], 0);
+
+  /* Channel 0 moves away from the output, channel 1 is now nearer */
+  adsIn[0].data.aoa = (real_T)(AOA_DEG + 14.0);
+  adsFrame();
+  TEST_CHECK_EQUAL(status.ads_selected[FCS_SEL_ADS_AOA], 1);
+  TEST_CHECK_NEAR(adsOut.aoa, AOA_DEG + 0.5, 1.0e-6);
+  TEST_CHECK_EQUAL(status.miscompares, 1u);
+
+  /* Agreement clears the miscompare, the selection stays on channel 1 */
+  adsIn[0].data.aoa = (real_T)(AOA_DEG + 5.0);
+  adsFrame();
+  TEST_CHECK_EQUAL(status.ads_fault[0][FCS_SEL_ADS_AOA], 0u);
+  TEST_CHECK_EQUAL(status.ads_fault[1][FCS_SEL_ADS_AOA], 0u);
+  TEST_CHECK_EQUAL(status.ads_selected[FCS_SEL_ADS_AOA], 1);
+
+  /* A disagreement shorter than the declaration time is not declared */
+  adsIn[0].data.aoa = (real_T)(AOA_DEG + 7.0);
+  for (frame = 0u; frame < (FCS_SEL_MISCOMPARE_FRAMES - 1u); frame++)
+  {
+    adsFrame();
+  }
+  adsIn[0].data.aoa = (real_T)(AOA_DEG + 2.0);
+  adsFrame();
+  TEST_CHECK_EQUAL(status.miscompares, 1u);
+  TEST_CHECK_EQUAL(status.ads_selected[FCS_SEL_ADS_AOA], 1);
+}
+
+/* Both navigation channels level at a heading, yaw in radians */
+static void navHeading(const Float64_t yaw0, const Float64_t yaw1)
+{
+  for (Uint32_t ch = 0u; ch < FCS_SEL_CHANNELS; ch++)
+  {
+    memset(&navIn[ch], 0, sizeof(navIn[ch]));
+    navIn[ch].data.lat = 0.9;
+    navIn[ch].data.lon = 0.2;
+    navIn[ch].data.alt_gps_amsl = (real_T)BARO_M;
+    navIn[ch].data.eph = (real_T)2.0;
+    navIn[ch].data.epv = (real_T)3.0;
+    navIn[ch].present = true;
+    navIn[ch].age_known = true;
+    navIn[ch].age_us = 4000u;
+  }
+  navIn[0].data.eul_ang[2] = (real_T)yaw0;
+  navIn[1].data.eul_ang[2] = (real_T)yaw1;
+}
+
+/* Headings either side of pi agree, and crossing pi is not a step */
+static void testYawWrap(void)
+{
+  fcs_sel_init();
+
+  for (Uint32_t frame = 0u; frame < (2u * FCS_SEL_MISCOMPARE_FRAMES); frame++)
+  {
+    navHeading(3.13, -3.13);
+    fcs_sel_nav(navIn, &navOut);
+  }
+  fcs_sel_get_status(&status);
+  TEST_CHECK_EQUAL(status.nav_fault[0][FCS_SEL_NAV_ATT], 0u);
+  TEST_CHECK_EQUAL(status.nav_fault[1][FCS_SEL_NAV_ATT], 0u);
+  TEST_CHECK_EQUAL(status.nav_selected[FCS_SEL_NAV_ATT], 0);
+  TEST_CHECK_EQUAL(status.miscompares, 0u);
+  TEST_CHECK_EQUAL(navOut.att_invalid, 0u);
+  TEST_CHECK_EQUAL(navOut.data_timeout, 0u);
+
+  navHeading(-3.12, -3.13);
+  fcs_sel_nav(navIn, &navOut);
+  fcs_sel_get_status(&status);
+  TEST_CHECK_EQUAL(status.nav_fault[0][FCS_SEL_NAV_ATT], 0u);
+  TEST_CHECK_EQUAL(status.rate_rejections, 0u);
+  TEST_CHECK_NEAR(navOut.eul_ang[2], -3.12, 1.0e-6);
+
+  /* Channel 1 turns away within the rate limit to half a turn off channel 0 */
+  for (Uint32_t frame = 1u; frame <= 40u; frame++)
+  {
+    navHeading(-3.12, -3.12 + (0.08 * (Float64_t)frame));
+    fcs_sel_nav(navIn, &navOut);
+  }
+  fcs_sel_get_status(&status);
+  TEST_CHECK_EQUAL(status.rate_rejections, 0u);
+  TEST_CHECK_EQUAL(status.miscompares, 1u);
+  TEST_CHECK_EQUAL(status.nav_selected[FCS_SEL_NAV_ATT], 0);
+
+  /* Both navigation channels lost */
+  navIn[0].present = false;
+  navIn[1].present = false;
+  fcs_sel_nav(navIn, &navOut);
+  TEST_CHECK_EQUAL(navOut.data_timeout, 1u);
+  TEST_CHECK_EQUAL(navOut.att_invalid, 1u);
+  TEST_CHECK_EQUAL(navOut.pos_invalid, 1u);
+}
+
+int main(void)
+{
+  testHealthy();
+  testAbsent();
+  testStale();
+  testSourceInvalid();
+  testNonFinite();
+  testRateStep();
+  testMiscompare();
+  testYawWrap();
+
+  return TEST_RESULT();
+}
@@ -0,0 +1,736 @@
+/*********************************************************************//**
+\file
+\brief
+  Module Title       : Flight data recorder test
+
+  Abstract           : Runs the flight data recorder against a model of
+                       the drive, backed by a disk image file, and of the
+                       file system. The chunks submitted are checked for
+                       their place on the drive, header and CRC, and the
+                       image is read back as a reader of the recording
+                       would. The recorder is started on a new drive, on a
+                       drive left by an earlier recording that wrapped
+                       round the files, and with the drive busy or
+                       failing. Half an hour is recorded at the loop rate
+                       on a drive with a write time and periodic stalls,
+                       and the power is lost with chunks in flight to
+                       check that torn chunks are rejected by their CRC.
+                       The ESC telemetry of all eight motors and the SBUS
+                       data without a frame are checked in the records.
+*************************************************************************/
+
+/***** Includes *********************************************************/
+
+#include <stdarg.h>
+#include <stddef.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "fdr_interface.h"
+#include "da_interface.h"
+#include "ach_interface.h"
+#include "fcs_mi_interface.h"
+#include "can_interface.h"
+#include "kernel/crc32/d_crc32.h"
+#include "kernel/fat_fs/d_ff.h"
+#include "soc/sata/d_sata.h"
+#include "host_stubs.h"
+#include "test_common.h"
+
+/***** Constants ********************************************************/
+
+/* Layout of the recorder files */
+#define FILES            16u
+#define SECTOR_SIZE      512u
+#define CHUNK_SIZE       (64u * 1024u)
+#define CHUNK_SECTORS    (CHUNK_SIZE / SECTOR_SIZE)
+#define FILE_CHUNKS      1024u
+#define RECORDS_PER_CHUNK ((CHUNK_SIZE - sizeof(fdr_chunk_header_t)) / sizeof(fdr_record_t))
+
+/* File system of the drive model, 64K byte clusters after the data base sector */
+#define DATA_BASE        4096u
+#define CLUSTER_SECTORS  128u
+#define FILE_CLUSTERS    ((FILE_CHUNKS * CHUNK_SIZE) / (CLUSTER_SECTORS * SECTOR_SIZE))
+
+/* Disk image in the working directory, sparse where nothing was written */
+#define IMAGE_NAME       "test_fdr.img"
+
+#define MAX_PENDING      8u
+
+/* Loop period of the recorder and the time to fill a chunk, microseconds */
+#define LOOP_PERIOD      10000u
+#define CHUNK_PERIOD     (RECORDS_PER_CHUNK * LOOP_PERIOD)
+
+/* Chunks of an earlier recording in each file of a wrapped drive */
+#define OLD_CHUNKS       4u
+
+/* Sustained recording: half an hour at the loop rate, on a drive taking
+   3 ms a chunk and stalling for half a chunk period every 64 writes */
+#define SUSTAINED_LOOPS  180000u
+#define WRITE_TIME       3000u
+#define STALL_EVERY      64u
+#define STALL_TIME       (CHUNK_PERIOD / 2u)
+
+/***** Type Definitions *************************************************/
+
+typedef struct
+{
+  Uint32_t lba;
+  const Uint8_t * pData;
+  Uint64_t completeAt;
+  d_SATA_Callback_t callback;
+  void * pContext;
+} PendingWrite_t;
+
+/***** Variables ********************************************************/
+
+extern s_esc_status_frame_t EscStatus[MAX_ESCS];
+
+/* Drive model: the image file and the files created on it */
+static FILE * image;
+static Bool_t fileExists[FILES];
+static Uint32_t badChunks;
+
+/* Writes in flight, completed in order by the drive */
+static PendingWrite_t pending[MAX_PENDING];
+static Uint32_t pendingCount;
+static Uint32_t writeCount;
+static Uint64_t driveFreeAt;
+static d_Status_t writeStatus;
+static d_Status_t completionStatus;
+
+/* Time the drive takes for a chunk, and its stalls */
+static Uint32_t writeTime;
+static Uint32_t stallEvery;
+static Uint32_t stallTime;
+
+/* Last record of the last chunk written */
+static fdr_record_t lastRecord;
+
+/* Chunk read back from the image, or made for an earlier recording */
+static Uint8_t chunkData[CHUNK_SIZE];
+
+/* Chunks read back whose time does not follow the chunk before */
+static Uint32_t timeGaps;
+
+/***** Function Definitions *********************************************/
+
+static Uint32_t fileLba(const Uint32_t file)
+{
+  return DATA_BASE + (file * FILE_CLUSTERS * CLUSTER_SECTORS);
+}
+
+static Uint32_t chunkLba(const Uint32_t file, const Uint32_t chunk)
+{
+  return fileLba(file) + (chunk * CHUNK_SECTORS);
+}
+
+static void imageWrite(const Uint32_t lba, const Uint8_t * const pData, const Uint32_t length)
+{
+  (void)fseek(image, (long)lba * (long)SECTOR_SIZE, SEEK_SET);
+  TEST_CHECK_EQUAL(fwrite(pData, 1u, length, image), length);
+}
+
+/* Sectors never written read as zero */
+static void imageRead(const Uint32_t lba, Uint8_t * const pData, const Uint32_t length)
+{
+  size_t count;
+
+  (void)fseek(image, (long)lba * (long)SECTOR_SIZE, SEEK_SET);
+  count = fread(pData, 1u, length, image);
+  memset(&pData[count], 0, length - count);
+}
+
+/* CRC of a chunk as the recorder makes it: the records, then the header up to the crc field */
+static Uint32_t chunkCrc(const Uint8_t * const pChunk, const Uint32_t records)
+{
+  Uint32_t crc = 0xFFFFFFFFu;
+
+  d_CRC32_Add(&crc, &pChunk[sizeof(fdr_chunk_header_t)], records * sizeof(fdr_record_t));
+  d_CRC32_Add(&crc, pChunk, offsetof(fdr_chunk_header_t, crc));
+
+  return ~crc;
+}
+
+/* Read a chunk back from the image as a reader would, d_TRUE if its header and CRC are good */
+static Bool_t readChunk(const Uint32_t file, const Uint32_t chunk, fdr_chunk_header_t * const pHeader)
+{
+  imageRead(chunkLba(file, chunk), chunkData, CHUNK_SIZE);
+  memcpy(pHeader, chunkData, sizeof(*pHeader));
+
+  return ((pHeader->magic == FDR_MAGIC) && (pHeader->version == FDR_VERSION) &&
+          (pHeader->record_size == sizeof(fdr_record_t)) && (pHeader->record_count <= RECORDS_PER_CHUNK) &&
+          (pHeader->crc == chunkCrc(chunkData, pHeader->record_count))) ? d_TRUE : d_FALSE;
+}
+
+/* Chunks of a segment that a reader recovers from a file: good chunks in sequence from the first */
+static Uint32_t scanFile(const Uint32_t file, const Uint32_t segment)
+{
+  fdr_chunk_header_t header;
+  Uint32_t chunks = 0u;
+  Uint32_t lastTime = 0u;
+
+  while ((chunks < FILE_CHUNKS) && (readChunk(file, chunks, &header) == d_TRUE) && (header.segment == segment) &&
+         (header.sequence == chunks))
+  {
+    if ((chunks > 0u) && ((header.first_time_ms - lastTime) < (CHUNK_PERIOD / 1000u)))
+    {
+      timeGaps++;
+    }
+    ELSE_DO_NOTHING
+    lastTime = header.first_time_ms;
+    chunks++;
+  }
+
+  return chunks;
+}
+
+/* Write a full chunk of an earlier recording to the image */
+static void writeOldChunk(const Uint32_t file, const Uint32_t chunk, const Uint32_t segment)
+{
+  fdr_chunk_header_t * pHeader = (fdr_chunk_header_t *)chunkData;
+
+  memset(chunkData, (int)(0x40u + file), sizeof(chunkData));
+  memset(pHeader, 0, sizeof(*pHeader));
+  pHeader->magic = FDR_MAGIC;
+  pHeader->version = FDR_VERSION;
+  pHeader->record_size = sizeof(fdr_record_t);
+  pHeader->segment = segment;
+  pHeader->sequence = chunk;
+  pHeader->record_count = RECORDS_PER_CHUNK;
+  pHeader->crc = chunkCrc(chunkData, RECORDS_PER_CHUNK);
+  imageWrite(chunkLba(file, chunk), chunkData, CHUNK_SIZE);
+}
+
+d_FAT_Result_t d_FAT_Mount(d_FAT_Fs_t * fs, const TCHAR * path, Uint8_t opt)
+{
+  memset(fs, 0, sizeof(*fs));
+  fs->database = DATA_BASE;
+  fs->csize = CLUSTER_SECTORS;
+
+  return d_FAT_OK;
+}
+
+/* Files are named 0:FDRnn.BIN, an existing file is a single fragment of the full size */
+d_FAT_Result_t d_FAT_Open(d_FAT_File_t * fp, const TCHAR * path, Uint8_t mode)
+{
+  Uint32_t file = ((Uint32_t)(path[5] - '0') * 10u) + (Uint32_t)(path[6] - '0');
+
+  memset(fp, 0, sizeof(*fp));
+  if (file >= FILES)
+  {
+    return d_FAT_NO_FILE;
+  }
+
+  fp->obj.sclust = 2u + (file * FILE_CLUSTERS);
+  if (((mode & FA_CREATE_ALWAYS) == 0u) && (fileExists[file] == d_TRUE))
+  {
+    fp->obj.objsize = FILE_CHUNKS * CHUNK_SIZE;
+  }
+  ELSE_DO_NOTHING
+
+  return d_FAT_OK;
+}
+
+d_FAT_Result_t d_FAT_LSeek(d_FAT_File_t * fp, d_FAT_FSIZE_t ofs)
+{
+  return (ofs == d_FAT_CREATE_LINKMAP) ? d_FAT_OK : d_FAT_INVALID_PARAMETER;
+}
+
+d_FAT_Result_t d_FAT_Expand(d_FAT_File_t * fp, d_FAT_FSIZE_t szf, Uint8_t opt)
+{
+  fileExists[(fp->obj.sclust - 2u) / FILE_CLUSTERS] = d_TRUE;
+  fp->obj.objsize = szf;
+
+  return d_FAT_OK;
+}
+
+d_FAT_Result_t d_FAT_Close(d_FAT_File_t * fp)
+{
+  return d_FAT_OK;
+}
+
+d_Status_t d_SATA_Read(const Uint32_t lba, Uint8_t * pBuffer, const Uint32_t readLength)
+{
+  imageRead(lba, pBuffer, readLength);
+
+  return d_STATUS_SUCCESS;
+}
+
+/* Checks a chunk and queues it, the data reaches the image when the drive completes the write */
+d_Status_t d_SATA_WriteAsync(const Uint32_t lba, const Uint8_t * const pBuffer, const Uint32_t writeLength,
+                             const d_SATA_Callback_t callback, void * const pContext, Uint32_t * const pTag)
+{
+  const fdr_chunk_header_t * pHeader = (const fdr_chunk_header_t *)pBuffer;
+  Uint32_t file = (lba - DATA_BASE) / (FILE_CLUSTERS * CLUSTER_SECTORS);
+  Uint32_t chunk = (lba - fileLba(file)) / CHUNK_SECTORS;
+  Uint64_t now = host_TimerMicroseconds();
+
+  if ((writeStatus != d_STATUS_SUCCESS) || (pendingCount >= MAX_PENDING))
+  {
+    return (writeStatus != d_STATUS_SUCCESS) ? writeStatus : d_STATUS_BUFFER_FULL;
+  }
+  ELSE_DO_NOTHING
+
+  if ((writeLength != CHUNK_SIZE) || (file >= FILES) || (((lba - fileLba(file)) % CHUNK_SECTORS) != 0u) ||
+      (pHeader->magic != FDR_MAGIC) || (pHeader->version != FDR_VERSION) || (pHeader->record_size != sizeof(fdr_record_t)) ||
+      (pHeader->sequence != chunk) || (pHeader->record_count != RECORDS_PER_CHUNK) ||
+      (pHeader->crc != chunkCrc(pBuffer, pHeader->record_count)))
+  {
+    badChunks++;
+  }
+  ELSE_DO_NOTHING
+
+  memcpy(&lastRecord, &pBuffer[sizeof(fdr_chunk_header_t) + ((pHeader->record_count - 1u) * sizeof(fdr_record_t))],
+         sizeof(lastRecord));
+
+  /* The drive writes one chunk at a time */
+  writeCount++;
+  driveFreeAt = ((driveFreeAt > now) ? driveFreeAt : now) + writeTime;
+  if ((stallEvery != 0u) && ((writeCount % stallEvery) == 0u))
+  {
+    driveFreeAt += stallTime;
+  }
+  ELSE_DO_NOTHING
+
+  pending[pendingCount].lba = lba;
+  pending[pendingCount].pData = pBuffer;
+  pending[pendingCount].completeAt = driveFreeAt;
+  pending[pendingCount].callback = callback;
+  pending[pendingCount].pContext = pContext;
+  pendingCount++;
+
+  return d_STATUS_SUCCESS;
+}
+
+/* Complete the writes whose time has come, a successful write puts the chunk on the image */
+static void driveComplete(void)
+{
+  Uint32_t done = 0u;
+
+  while ((done < pendingCount) && (pending[done].completeAt <= host_TimerMicroseconds()))
+  {
+    if (completionStatus == d_STATUS_SUCCESS)
+    {
+      imageWrite(pending[done].lba, pending[done].pData, CHUNK_SIZE);
+    }
+    ELSE_DO_NOTHING
+    pending[done].callback(done, completionStatus, pending[done].pContext);
+    done++;
+  }
+
+  memmove(pending, &pending[done], (pendingCount - done) * sizeof(pending[0]));
+  pendingCount -= done;
+}
+
+/* Power lost with writes in flight: the sectors given of the first write reach the image and
+   the second write may have completed first, the other writes are lost */
+static void drivePowerLoss(const Uint32_t firstSector, const Uint32_t sectors, const Bool_t secondDone)
+{
+  if (pendingCount > 0u)
+  {
+    imageWrite(pending[0].lba + firstSector, &pending[0].pData[firstSector * SECTOR_SIZE], sectors * SECTOR_SIZE);
+  }
+  ELSE_DO_NOTHING
+  if ((pendingCount > 1u) && (secondDone == d_TRUE))
+  {
+    imageWrite(pending[1].lba, pending[1].pData, CHUNK_SIZE);
+  }
+  ELSE_DO_NOTHING
+
+  pendingCount = 0u;
+}
+
+/* Data acquisition, air data and INS with a radar altimeter out of range and no SBUS frame */
+static s_ins_snapshot_t insSnapshot;
+static s_adc_snapshot_t adcSnapshot;
+static s_radalt_snapshot_t radaltSnapshot;
+
+const s_ins_snapshot_t * da_get_ins_il_snapshot(void)
+{
+  return &insSnapshot;
+}
+
+const s_adc_snapshot_t * da_get_adc_9_snapshot(void)
+{
+  return &adcSnapshot;
+}
+
+const s_radalt_snapshot_t * da_get_radalt_snapshot(void)
+{
+  return &radaltSnapshot;
+}
+
+/* As the SBUS driver: without a frame only the data timeout flag is written */
+bool da_get_ep_data(rc_input_t * rc_input)
+{
+  rc_input->data_timeout = true;
+
+  return false;
+}
+
+float ach_get_servo_pos_deg(e_servo_positions_t servo_id)
+{
+  return 1.5f * (float)servo_id;
+}
+
+int fcs_mi_get_act_cmd(float * motor_cmd, float * servo_cmd, float * pusher_cmd, uint8_t motor_count, uint8_t servo_count)
+{
+  for (uint8_t i = 0u; i < motor_count; i++)
+  {
+    motor_cmd[i] = 0.1f * (float)i;
+  }
+  for (uint8_t i = 0u; i < servo_count; i++)
+  {
+    servo_cmd[i] = -(float)i;
+  }
+  *pusher_cmd = 0.5f;
+
+  return 0;
+}
+
+void fcs_mi_get_fcs_dscr(uint8_t * vom_status, uint8_t * safety_status, uint8_t * pic_status, uint8_t * in_air_status,
+                         uint8_t * a, uint8_t * b, uint8_t * c, uint8_t * d, uint8_t * e, uint16_t * f,
+                         uint8_t * g, uint8_t * h, uint8_t * i)
+{
+  *vom_status = 3u;
+  *safety_status = 0u;
+  *pic_status = 1u;
+  *in_air_status = 1u;
+}
+
+/* The ESC telemetry is decoded by ach_epu.c, its CAN bus is quiet */
+can_status_t can_init(can_channel_t can_ch)
+{
+  return CAN_OK;
+}
+
+can_status_t can_write(can_channel_t can_ch, const can_msg_t * ptr_can_msg)
+{
+  return CAN_OK;
+}
+
+can_status_t can_read(can_channel_t can_ch, can_msg_t * ptr_can_msg)
+{
+  return CAN_NO_NEW_DATA;
+}
+
+/* Console of the flight software, its printf is printf_ */
+int printf_(const char * format, ...)
+{
+  va_list args;
+  int count;
+
+  va_start(args, format);
+  count = vfprintf(stdout, format, args);
+  va_end(args);
+
+  return count;
+}
+
+/* One loop of the application: capture, submit and let the drive finish its writes */
+static void loop(const Bool_t driveRuns)
+{
+  host_TimerAdvance(LOOP_PERIOD);
+  fdr_periodic();
+  while (fdr_background() == true)
+  {
+  }
+  if (driveRuns == d_TRUE)
+  {
+    driveComplete();
+  }
+  ELSE_DO_NOTHING
+}
+
+/* Record until a number of chunks more have been written */
+static void recordChunks(const Uint32_t chunks)
+{
+  fdr_stats_t stats;
+
+  fdr_get_stats(&stats);
+  Uint32_t target = stats.chunks_written + chunks;
+  while ((stats.chunks_written < target) && (stats.state == FDR_STATE_RECORDING))
+  {
+    loop(d_TRUE);
+    fdr_get_stats(&stats);
+  }
+}
+
+static void driveReset(void)
+{
+  image = freopen(IMAGE_NAME, "w+b", image);
+  memset(fileExists, 0, sizeof(fileExists));
+  pendingCount = 0u;
+  writeCount = 0u;
+  driveFreeAt = 0u;
+  writeTime = 0u;
+  stallEvery = 0u;
+  stallTime = 0u;
+  writeStatus = d_STATUS_SUCCESS;
+  completionStatus = d_STATUS_SUCCESS;
+}
+
+/* Drive left by a recording that wrapped round the files, file 6 holding the oldest segment */
+static void driveWrapped(void)
+{
+  driveReset();
+  for (Uint32_t file = 0u; file < FILES; file++)
+  {
+    fileExists[file] = d_TRUE;
+    for (Uint32_t chunk = 0u; chunk < OLD_CHUNKS; chunk++)
+    {
+      writeOldChunk(file, chunk, 40u + ((file + 10u) % FILES));
+    }
+  }
+}
+
+/* Half an hour at the loop rate: nothing is dropped while the drive stalls for less than a chunk period */
+static void sustained(void)
+{
+  fdr_stats_t stats;
+  Float64_t busy = 0.0;
+
+  driveReset();
+  writeTime = WRITE_TIME;
+  stallEvery = STALL_EVERY;
+  stallTime = STALL_TIME;
+  timeGaps = 0u;
+  fdr_init();
+
+  for (Uint32_t i = 0u; i < SUSTAINED_LOOPS; i++)
+  {
+    host_TimerAdvance(LOOP_PERIOD);
+    Float64_t start = testSeconds();
+    fdr_periodic();
+    while (fdr_background() == true)
+    {
+    }
+    busy += testSeconds() - start;
+    driveComplete();
+  }
+
+  fdr_get_stats(&stats);
+  TEST_CHECK_EQUAL(stats.state, FDR_STATE_RECORDING);
+  TEST_CHECK_EQUAL(stats.records, SUSTAINED_LOOPS);
+  TEST_CHECK_EQUAL(stats.dropped, 0u);
+  TEST_CHECK_EQUAL(stats.busy_retries, 0u);
+  TEST_CHECK_EQUAL(stats.write_errors, 0u);
+  TEST_CHECK(stats.chunks_written >= ((SUSTAINED_LOOPS / RECORDS_PER_CHUNK) - 1u));
+
+  /* The first file is full and the recording goes on in the next, every chunk reads back in sequence */
+  TEST_CHECK_EQUAL(stats.segment, 1u);
+  TEST_CHECK_EQUAL(scanFile(0u, 0u), FILE_CHUNKS);
+  TEST_CHECK_EQUAL(scanFile(1u, 1u), stats.chunks_written - FILE_CHUNKS);
+  TEST_CHECK_EQUAL(timeGaps, 0u);
+  TEST_CHECK_EQUAL(badChunks, 0u);
+
+  printf("sustained: %u records in %u chunks of %u, %.1f KB/s, recorder %.2f us a loop on the host\n",
+         stats.records, stats.chunks_written, (Uint32_t)RECORDS_PER_CHUNK,
+         ((Float64_t)sizeof(fdr_record_t) * 1.0e6) / ((Float64_t)LOOP_PERIOD * 1024.0),
+         (busy * 1.0e6) / (Float64_t)SUSTAINED_LOOPS);
+}
+
+/* Power lost with two chunks in flight over an older recording, the first of them torn */
+static void powerLoss(const Uint32_t firstSector, const Uint32_t sectors)
+{
+  fdr_chunk_header_t header;
+  fdr_stats_t stats;
+
+  /* Segment 57 in file 6, two chunks written and the next two in flight */
+  driveWrapped();
+  fdr_init();
+  recordChunks(2u);
+  for (Uint32_t i = 0u; i < (2u * RECORDS_PER_CHUNK); i++)
+  {
+    loop(d_FALSE);
+  }
+  TEST_CHECK_EQUAL(pendingCount, 2u);
+  drivePowerLoss(firstSector, sectors, d_TRUE);
+
+  /* The chunks written are recovered and the torn chunk fails its CRC, where the reader stops */
+  TEST_CHECK_EQUAL(scanFile(6u, 57u), 2u);
+  TEST_CHECK(readChunk(6u, 2u, &header) == d_FALSE);
+
+  /* The chunk that completed after it is good but stands alone */
+  TEST_CHECK(readChunk(6u, 3u, &header) == d_TRUE);
+  TEST_CHECK_EQUAL(header.segment, 57u);
+  TEST_CHECK_EQUAL(header.sequence, 3u);
+
+  /* On restart the segment skips a number, so that chunk is never joined to the new recording */
+  fdr_init();
+  fdr_get_stats(&stats);
+  TEST_CHECK_EQUAL(stats.segment, 59u);
+  recordChunks(1u);
+  TEST_CHECK(readChunk(7u, 0u, &header) == d_TRUE);
+  TEST_CHECK_EQUAL(header.segment, 59u);
+  TEST_CHECK_EQUAL(scanFile(6u, 57u), 2u);
+}
+
+int main(void)
+{
+  fdr_chunk_header_t header;
+  fdr_stats_t stats;
+  Uint8_t byte;
+
+  host_Reset();
+  host_TimerSetReadCost(1u);
+  image = fopen(IMAGE_NAME, "w+b");
+  if (image == NULL)
+  {
+    printf("cannot create %s\n", IMAGE_NAME);
+    return 1;
+  }
+
+  insSnapshot.valid = INS_SNAP_VALID_ATT | INS_SNAP_VALID_OMG | INS_SNAP_VALID_LINK;
+  insSnapshot.lat = 51.5;
+  insSnapshot.lon = -1.25;
+  insSnapshot.euler_rpy[2] = 1.0f;
+  adcSnapshot.valid = ADC_SNAP_VALID_CAS;
+  adcSnapshot.cas = 30.0f;
+  radaltSnapshot.agl = 1000.0f;
+
+  for (Uint32_t id = ESC_ID_1; id <= ESC_ID_8; id++)
+  {
+    EscStatus[id].rpm = (int32_t)(1000u * id);
+    EscStatus[id].voltage_f16 = 48.0f;
+    EscStatus[id].valid = true;
+  }
+
+  /* New drive: the files are created and recording starts with segment 0 in the first file */
+  driveReset();
+  fdr_init();
+  fdr_get_stats(&stats);
+  TEST_CHECK_EQUAL(stats.state, FDR_STATE_RECORDING);
+  TEST_CHECK_EQUAL(stats.segment, 0u);
+  for (Uint32_t file = 0u; file < FILES; file++)
+  {
+    TEST_CHECK(fileExists[file] == d_TRUE);
+  }
+
+  recordChunks(3u);
+  TEST_CHECK_EQUAL(scanFile(0u, 0u), 3u);
+  TEST_CHECK(readChunk(0u, 2u, &header) == d_TRUE);
+  TEST_CHECK_EQUAL(header.segment, 0u);
+  TEST_CHECK_EQUAL(header.sequence, 2u);
+  TEST_CHECK_EQUAL(badChunks, 0u);
+
+  /* Record contents: every ESC is reported, the SBUS fields are zero without a frame */
+  TEST_CHECK_EQUAL(lastRecord.esc_valid, 0xFFu);
+  for (Uint32_t i = 0u; i < NUM_ESCS; i++)
+  {
+    TEST_CHECK_EQUAL(lastRecord.esc_rpm[i], 1000u * (i + 1u));
+    TEST_CHECK_NEAR(lastRecord.esc_voltage[i], 48.0, 1.0e-6);
+  }
+  for (Uint32_t i = 0u; i < 8u; i++)
+  {
+    TEST_CHECK_NEAR(lastRecord.rc_axis[i], 0.0, 0.0);
+  }
+  TEST_CHECK_EQUAL(lastRecord.rc_rssi, 0u);
+  TEST_CHECK_EQUAL(lastRecord.rc_flags, 2u);
+  TEST_CHECK_EQUAL(lastRecord.valid & FDR_VALID_SBUS, 0u);
+  TEST_CHECK_EQUAL(lastRecord.valid & FDR_VALID_INS_OMG, FDR_VALID_INS_OMG);
+  TEST_CHECK_EQUAL(lastRecord.valid & FDR_VALID_RADALT, 0u);
+  TEST_CHECK_NEAR(lastRecord.ins_lat, 51.5, 0.0);
+  TEST_CHECK_NEAR(lastRecord.servo_pos_deg[12], 1.5 * 13.0, 1.0e-6);
+
+  /* An ESC whose telemetry stopped is not reported, and its values are not carried from another */
+  EscStatus[ESC_ID_8].valid = false;
+  recordChunks(2u);
+  TEST_CHECK_EQUAL(lastRecord.esc_valid, 0x7Fu);
+  TEST_CHECK_EQUAL(lastRecord.esc_rpm[7], 0u);
+  EscStatus[ESC_ID_8].valid = true;
+
+  /* Restart on a drive that wrapped: the new segment skips a number and overwrites the oldest file */
+  driveWrapped();
+  fdr_init();
+  fdr_get_stats(&stats);
+  TEST_CHECK_EQUAL(stats.state, FDR_STATE_RECORDING);
+  TEST_CHECK_EQUAL(stats.segment, 57u);
+  recordChunks(1u);
+  TEST_CHECK(readChunk(6u, 0u, &header) == d_TRUE);
+  TEST_CHECK_EQUAL(header.segment, 57u);
+  TEST_CHECK(readChunk(9u, 0u, &header) == d_TRUE);
+  TEST_CHECK_EQUAL(header.segment, 43u);
+
+  /* Once the file is full the next oldest file is taken */
+  recordChunks(FILE_CHUNKS);
+  fdr_get_stats(&stats);
+  TEST_CHECK_EQUAL(stats.segment, 58u);
+  TEST_CHECK_EQUAL(scanFile(6u, 57u), FILE_CHUNKS);
+  TEST_CHECK(readChunk(7u, 0u, &header) == d_TRUE);
+  TEST_CHECK_EQUAL(header.segment, 58u);
+  TEST_CHECK(readChunk(5u, 0u, &header) == d_TRUE);
+  TEST_CHECK_EQUAL(header.segment, 55u);
+  TEST_CHECK_EQUAL(badChunks, 0u);
+
+  /* A file whose first chunk is not a recording is used before any other */
+  driveWrapped();
+  memset(chunkData, 0, sizeof(chunkData));
+  imageWrite(fileLba(3u), chunkData, SECTOR_SIZE);
+  fdr_init();
+  recordChunks(1u);
+  TEST_CHECK(readChunk(3u, 0u, &header) == d_TRUE);
+  TEST_CHECK_EQUAL(header.segment, 57u);
+
+  /* Drive queue full: submissions are retried, records are dropped once both buffers wait */
+  driveReset();
+  fdr_init();
+  writeStatus = d_STATUS_BUFFER_FULL;
+  for (Uint32_t i = 0u; i < (3u * RECORDS_PER_CHUNK); i++)
+  {
+    loop(d_TRUE);
+  }
+  fdr_get_stats(&stats);
+  TEST_CHECK(stats.busy_retries > 0u);
+  TEST_CHECK_EQUAL(stats.dropped, RECORDS_PER_CHUNK);
+  TEST_CHECK_EQUAL(stats.chunks_written, 0u);
+  writeStatus = d_STATUS_SUCCESS;
+  recordChunks(3u);
+  TEST_CHECK(readChunk(0u, 1u, &header) == d_TRUE);
+  TEST_CHECK_EQUAL(header.dropped, 0u);
+  /* One more record is lost by the loop that captures before the drive takes the buffers */
+  TEST_CHECK(readChunk(0u, 2u, &header) == d_TRUE);
+  TEST_CHECK_EQUAL(header.dropped, RECORDS_PER_CHUNK + 1u);
+  TEST_CHECK_EQUAL(badChunks, 0u);
+
+  /* A failed write is counted and recording goes on, a refused one stops it */
+  completionStatus = d_STATUS_DEVICE_ERROR;
+  for (Uint32_t i = 0u; i < RECORDS_PER_CHUNK; i++)
+  {
+    loop(d_TRUE);
+  }
+  fdr_get_stats(&stats);
+  TEST_CHECK(stats.write_errors >= 1u);
+  TEST_CHECK_EQUAL(stats.state, FDR_STATE_RECORDING);
+  completionStatus = d_STATUS_SUCCESS;
+  writeStatus = d_STATUS_DEVICE_ERROR;
+  for (Uint32_t i = 0u; i < RECORDS_PER_CHUNK; i++)
+  {
+    loop(d_TRUE);
+  }
+  fdr_get_stats(&stats);
+  TEST_CHECK_EQUAL(stats.state, FDR_STATE_STOPPED);
+
+  /* Recording at the loop rate on a drive with a write time and stalls */
+  sustained();
+
+  /* Power loss: the header and first records of the torn chunk reached the drive and the rest
+     holds the older recording, then the other way round */
+  powerLoss(0u, 40u);
+  powerLoss(40u, CHUNK_SECTORS - 40u);
+
+  /* A single bit in error in a record is found by the CRC */
+  imageRead(chunkLba(6u, 1u) + 50u, &byte, 1u);
+  byte ^= 0x10u;
+  imageWrite(chunkLba(6u, 1u) + 50u, &byte, 1u);
+  TEST_CHECK(readChunk(6u, 1u, &header) == d_FALSE);
+  TEST_CHECK_EQUAL(scanFile(6u, 57u), 1u);
+
+  TEST_CHECK_EQUAL(host_CriticalDepth, 0);
+
+  (void)fclose(image);
+  (void)remove(IMAGE_NAME);
+
+  return TEST_RESULT();
+}
@@ -0,0 +1,360 @@
+/*********************************************************************//**
+\file
+\brief
+  Module Title       : Geodesy library test
+
+  Abstract           : Checks the distance and bearing of the geodesy
+                       library against Vincenty's inverse solution on the
+                       WGS84 ellipsoid, from 1 m to 200 km in all
+                       directions and at two latitudes, on both sides of
+                       the switch-over from the local tangent plane to the
+                       haversine. The chart functions of the state
+                       machine, which call fcs_geo, are compared with the
+                       generated ECEF/NED and destination point code they
+                       replace, and the waypoint cache is checked to
+                       compute a waypoint once while the vehicle moves.
+                       The calls per second of the generated and the
+                       library distance are measured.
+*************************************************************************/
+
+/***** Includes *********************************************************/
+
+#include <math.h>
+#include <stdio.h>
+
+#include "soc/defines/d_common_types.h"
+#include "geo_util.h"
+#include "fcs_geo.h"
+#include "system_state_machine_private.h"
+#include "test_common.h"
+
+/***** Constants ********************************************************/
+
+#define DEG              (3.14159265358979323846 / 180.0)
+
+/* WGS84 flattening and semi-minor axis for the reference solution */
+#define WGS84_F          (1.0 / 298.257223563)
+#define WGS84_B          (GEO_WGS84_A * (1.0 - WGS84_F))
+
+#define BEARINGS         16u
+#define BENCH_CALLS      2000000u
+
+/***** Variables ********************************************************/
+
+/* Ranges of the accuracy checks (m) */
+static const Float64_t ranges[] =
+{
+  1.0, 10.0, 100.0, 1000.0, 4900.0, 5100.0, 10000.0, 20000.0, 50000.0, 100000.0, 200000.0
+};
+
+/* Results of the benchmark loops, kept so that they are not optimised out */
+static volatile Float64_t benchSink;
+
+/***** Function Definitions *********************************************/
+
+/* Vincenty's inverse solution, geodesic distance (m) and initial azimuth (rad) on WGS84 */
+static void vincenty(const Float64_t lat1, const Float64_t lon1, const Float64_t lat2, const Float64_t lon2,
+                     Float64_t * const pDistance, Float64_t * const pAzimuth)
+{
+  Float64_t u1 = atan((1.0 - WGS84_F) * tan(lat1));
+  Float64_t u2 = atan((1.0 - WGS84_F) * tan(lat2));
+  Float64_t l = lon2 - lon1;
+  Float64_t lambda = l;
+  Float64_t sinSigma = 0.0;
+  Float64_t cosSigma = 1.0;
+  Float64_t sigma = 0.0;
+  Float64_t cos2Alpha = 1.0;
+  Float64_t cos2SigmaM = 0.0;
+
+  for (Uint32_t i = 0u; i < 200u; i++)
+  {
+    Float64_t sinLambda = sin(lambda);
+    Float64_t cosLambda = cos(lambda);
+    Float64_t a = cos(u2) * sinLambda;
+    Float64_t b = (cos(u1) * sin(u2)) - (sin(u1) * cos(u2) * cosLambda);
+    Float64_t sinAlpha;
+    Float64_t c;
+    Float64_t previous = lambda;
+
+    sinSigma = sqrt((a * a) + (b * b));
+    cosSigma = (sin(u1) * sin(u2)) + (cos(u1) * cos(u2) * cosLambda);
+    sigma = atan2(sinSigma, cosSigma);
+    sinAlpha = (cos(u1) * cos(u2) * sinLambda) / sinSigma;
+    cos2Alpha = 1.0 - (sinAlpha * sinAlpha);
+    cos2SigmaM = cosSigma - ((2.0 * sin(u1) * sin(u2)) / cos2Alpha);
+    c = (WGS84_F / 16.0) * cos2Alpha * (4.0 + (WGS84_F * (4.0 - (3.0 * cos2Alpha))));
+    lambda = l + ((1.0 - c) * WGS84_F * sinAlpha *
+                  (sigma + (c * sinSigma * (cos2SigmaM + (c * cosSigma * (-1.0 + (2.0 * cos2SigmaM * cos2SigmaM)))))));
+    if (fabs(lambda - previous) < 1.0e-13)
+    {
+      break;
+    }
+  }
+
+  Float64_t uu = cos2Alpha * ((GEO_WGS84_A * GEO_WGS84_A) - (WGS84_B * WGS84_B)) / (WGS84_B * WGS84_B);
+  Float64_t a = 1.0 + ((uu / 16384.0) * (4096.0 + (uu * (-768.0 + (uu * (320.0 - (175.0 * uu)))))));
+  Float64_t b = (uu / 1024.0) * (256.0 + (uu * (-128.0 + (uu * (74.0 - (47.0 * uu))))));
+  Float64_t deltaSigma = b * sinSigma *
+                         (cos2SigmaM + ((b / 4.0) * ((cosSigma * (-1.0 + (2.0 * cos2SigmaM * cos2SigmaM))) -
+                                                     ((b / 6.0) * cos2SigmaM * (-3.0 + (4.0 * sinSigma * sinSigma)) *
+                                                      (-3.0 + (4.0 * cos2SigmaM * cos2SigmaM))))));
+
+  *pDistance = WGS84_B * a * (sigma - deltaSigma);
+  *pAzimuth = atan2(cos(u2) * sin(lambda), (cos(u1) * sin(u2)) - (sin(u1) * cos(u2) * cos(lambda)));
+}
+
+/* A point at a range and bearing from a start point, on the spherical model of geo_destination */
+static void pointAt(const Float64_t lat, const Float64_t lon, const Float64_t range, const Float64_t bearing,
+                    Float64_t * const pLat, Float64_t * const pLon)
+{
+  geo_point_t start = {0};
+
+  geo_point_set(&start, lat, lon);
+  geo_destination(&start, range, bearing, pLat, pLon);
+}
+
+/* The generated CurrentDistance_From_LLA subsystem: the ECEF difference of
+   the two points rotated into the NED frame at the first, horizontal norm */
+static Float64_t ecefNedDistance(const Float64_t lla1[3], const Float64_t lla2[3])
+{
+  Float64_t ecef[2][3];
+  const Float64_t * const lla[2] = {lla1, lla2};
+
+  for (Uint32_t p = 0u; p < 2u; p++)
+  {
+    Float64_t e = sin(lla[p][0]) * 0.0818191908425;
+    Float64_t rn = GEO_WGS84_A / sqrt(1.0 - (e * e));
+
+    ecef[p][0] = (rn + lla[p][2]) * cos(lla[p][0]) * cos(lla[p][1]);
+    ecef[p][1] = (rn + lla[p][2]) * cos(lla[p][0]) * sin(lla[p][1]);
+    ecef[p][2] = ((0.993305620009879 * rn) + lla[p][2]) * sin(lla[p][0]);
+  }
+
+  Float64_t dx = ecef[1][0] - ecef[0][0];
+  Float64_t dy = ecef[1][1] - ecef[0][1];
+  Float64_t dz = ecef[1][2] - ecef[0][2];
+  Float64_t north = (-sin(lla1[0]) * cos(lla1[1]) * dx) - (sin(lla1[0]) * sin(lla1[1]) * dy) + (cos(lla1[0]) * dz);
+  Float64_t east = (-sin(lla1[1]) * dx) + (cos(lla1[1]) * dy);
+
+  return sqrt((north * north) + (east * east));
+}
+
+/* The generated destinationPoint subsystem, spherical earth of radius 6371 km */
+static void sphericalDestination(const Float64_t lat, const Float64_t lon, const Float64_t dist,
+                                 const Float64_t heading, Float64_t * const pLat, Float64_t * const pLon)
+{
+  Float64_t delta = dist / 6.371E+6;
+  Float64_t sinLat = (sin(lat) * cos(delta)) + (cos(lat) * sin(delta) * cos(heading));
+
+  sinLat = (sinLat > 1.0) ? 1.0 : ((sinLat < -1.0) ? -1.0 : sinLat);
+  *pLat = asin(sinLat);
+  *pLon = lon + atan2(sin(heading) * sin(delta) * cos(lat), cos(delta) - (sin(lat) * sin(*pLat)));
+}
+
+/* Largest distance and bearing errors against the reference over all ranges and bearings */
+static void accuracy(const Float64_t lat, const Float64_t lon)
+{
+  geo_point_t from = {0};
+
+  geo_point_set(&from, lat, lon);
+
+  printf("reference point %.4f, %.4f deg\n", lat / DEG, lon / DEG);
+  printf("  range m     distance error m   relative    bearing error deg\n");
+  for (Uint32_t r = 0u; r < (sizeof(ranges) / sizeof(ranges[0])); r++)
+  {
+    Float64_t maxError = 0.0;
+    Float64_t maxBearingError = 0.0;
+
+    for (Uint32_t k = 0u; k < BEARINGS; k++)
+    {
+      Float64_t bearing = ((Float64_t)k * 360.0 / BEARINGS) * DEG;
+      Float64_t lat2;
+      Float64_t lon2;
+      Float64_t reference;
+      Float64_t azimuth;
+
+      pointAt(lat, lon, ranges[r], bearing, &lat2, &lon2);
+      vincenty(lat, lon, lat2, lon2, &reference, &azimuth);
+
+      Float64_t error = fabs(geo_distance(&from, lat2, lon2) - reference);
+      Float64_t bearingError = fabs(remainder(geo_bearing(&from, lat2, lon2) - azimuth, 2.0 * M_PI));
+
+      maxError = (error > maxError) ? error : maxError;
+      maxBearingError = (bearingError > maxBearingError) ? bearingError : maxBearingError;
+    }
+
+    printf("  %9.0f   %14.6f   %9.2e   %12.6f\n", ranges[r], maxError, maxError / ranges[r],
+           maxBearingError / DEG);
+
+    /* Tangent plane to 5 km, haversine with the radius along the bearing beyond */
+    if (ranges[r] <= GEO_LTP_RANGE)
+    {
+      TEST_CHECK(maxError < (0.001 + (ranges[r] * 5.0e-6)));
+      TEST_CHECK(maxBearingError < (0.0001 * DEG));
+    }
+    else
+    {
+      TEST_CHECK((maxError / ranges[r]) < 2.0e-4);
+      TEST_CHECK(maxBearingError < (0.005 * DEG));
+    }
+  }
+}
+
+/* The chart functions of the state machine against the generated code they replace */
+static void chartFunctions(void)
+{
+  Float64_t home[3] = {24.4539 * DEG, 55.6 * DEG, 30.0};
+  Float64_t maxError = 0.0;
+
+  for (Uint32_t r = 0u; r < (sizeof(ranges) / sizeof(ranges[0])); r++)
+  {
+    if (ranges[r] <= 20000.0)
+    {
+      for (Uint32_t k = 0u; k < BEARINGS; k++)
+      {
+        Float64_t bearing = ((Float64_t)k * 360.0 / BEARINGS) * DEG;
+        Float64_t vehicle[3] = {0.0, 0.0, 30.0};
+        real_T chart;
+
+        pointAt(home[0], home[1], ranges[r], bearing, &vehicle[0], &vehicle[1]);
+        system_state_machine_k5j3b5svff(home, vehicle, &chart);
+
+        Float64_t error = fabs(ecefNedDistance(home, vehicle) - chart);
+        maxError = (error > maxError) ? error : maxError;
+      }
+    }
+  }
+  printf("CurrentDistance_From_LLA to 20 km: largest difference to the ECEF/NED subsystem %.3f m\n", maxError);
+  TEST_CHECK(maxError < 0.32);
+
+  /* destinationPoint is the same spherical model */
+  for (Uint32_t k = 0u; k < BEARINGS; k++)
+  {
+    Float64_t heading = ((Float64_t)k * 360.0 / BEARINGS) * DEG;
+    Float64_t latChart;
+    Float64_t lonChart;
+    Float64_t latGenerated;
+    Float64_t lonGenerated;
+
+    system_state_machine_mkamotaax2(home[0], home[1], 500.0, heading, &latChart, &lonChart);
+    sphericalDestination(home[0], home[1], 500.0, heading, &latGenerated, &lonGenerated);
+    TEST_CHECK_NEAR(latChart, latGenerated, 1.0e-14);
+    TEST_CHECK_NEAR(lonChart, lonGenerated, 1.0e-14);
+  }
+}
+
+/* A waypoint is computed on its first use only while the vehicle moves */
+static void waypointCache(void)
+{
+  geo_cache_t cache = {0};
+  Float64_t waypoint[GEO_CACHE_POINTS + 1u][2];
+
+  for (Uint32_t w = 0u; w <= GEO_CACHE_POINTS; w++)
+  {
+    waypoint[w][0] = (24.0 + (0.01 * (Float64_t)w)) * DEG;
+    waypoint[w][1] = 55.0 * DEG;
+  }
+
+  /* One waypoint, the vehicle moving every step */
+  for (Uint32_t step = 0u; step < 1000u; step++)
+  {
+    const geo_point_t * pPoint = geo_cache_point(&cache, waypoint[0][0], waypoint[0][1]);
+    TEST_CHECK(pPoint->lat == waypoint[0][0]);
+    benchSink = geo_distance(pPoint, waypoint[0][0] + ((Float64_t)step * 1.0e-7), waypoint[0][1]);
+  }
+  TEST_CHECK_EQUAL(cache.lookups, 1000u);
+  TEST_CHECK_EQUAL(cache.misses, 1u);
+
+  /* As many waypoints as the cache holds, used in turn, are each computed once */
+  for (Uint32_t step = 0u; step < 1000u; step++)
+  {
+    Uint32_t w = step % GEO_CACHE_POINTS;
+    const geo_point_t * pPoint = geo_cache_point(&cache, waypoint[w][0], waypoint[w][1]);
+    TEST_CHECK(pPoint->lat == waypoint[w][0]);
+  }
+  TEST_CHECK_EQUAL(cache.misses, GEO_CACHE_POINTS);
+
+  /* A new waypoint replaces the least recently used one */
+  (void)geo_cache_point(&cache, waypoint[GEO_CACHE_POINTS][0], waypoint[GEO_CACHE_POINTS][1]);
+  TEST_CHECK_EQUAL(cache.misses, GEO_CACHE_POINTS + 1u);
+  (void)geo_cache_point(&cache, waypoint[GEO_CACHE_POINTS - 1u][0], waypoint[GEO_CACHE_POINTS - 1u][1]);
+  TEST_CHECK_EQUAL(cache.misses, GEO_CACHE_POINTS + 1u);
+  (void)geo_cache_point(&cache, waypoint[0][0], waypoint[0][1]);
+  TEST_CHECK_EQUAL(cache.misses, GEO_CACHE_POINTS + 2u);
+
+  /* The chart function keys its cache on the waypoint, not on the vehicle */
+  Uint32_t lookups;
+  Uint32_t misses;
+  Uint32_t lookupsBefore;
+  Uint32_t missesBefore;
+  Float64_t hover[3] = {24.5 * DEG, 55.5 * DEG, 100.0};
+
+  fcs_geo_cache_stats(&lookupsBefore, &missesBefore);
+  for (Uint32_t step = 0u; step < 500u; step++)
+  {
+    Float64_t vehicle[3] = {hover[0] + ((Float64_t)step * 1.0e-7), hover[1], 100.0};
+    benchSink = fcs_geo_distance_from_lla(hover, vehicle);
+  }
+  fcs_geo_cache_stats(&lookups, &misses);
+  TEST_CHECK_EQUAL(lookups - lookupsBefore, 500u);
+  TEST_CHECK_EQUAL(misses - missesBefore, 1u);
+}
+
+/* Calls per second of the generated subsystem and of the chart function on the library */
+static void benchmark(void)
+{
+  Float64_t home[3] = {24.4539 * DEG, 55.6 * DEG, 30.0};
+  Float64_t vehicle[3] = {0.0, 0.0, 30.0};
+  Float64_t farLat;
+  Float64_t farLon;
+  geo_point_t from = {0};
+  Float64_t sum = 0.0;
+  real_T chart;
+
+  pointAt(home[0], home[1], 1500.0, 1.0, &vehicle[0], &vehicle[1]);
+  pointAt(home[0], home[1], 50000.0, 1.0, &farLat, &farLon);
+  geo_point_set(&from, home[0], home[1]);
+
+  Float64_t start = testSeconds();
+  for (Uint32_t i = 0u; i < BENCH_CALLS; i++)
+  {
+    vehicle[0] += 1.0e-12;
+    sum += ecefNedDistance(home, vehicle);
+  }
+  Float64_t generatedRate = BENCH_CALLS / (testSeconds() - start);
+
+  start = testSeconds();
+  for (Uint32_t i = 0u; i < BENCH_CALLS; i++)
+  {
+    vehicle[0] += 1.0e-12;
+    system_state_machine_k5j3b5svff(home, vehicle, &chart);
+    sum += chart;
+  }
+  Float64_t chartRate = BENCH_CALLS / (testSeconds() - start);
+
+  start = testSeconds();
+  for (Uint32_t i = 0u; i < BENCH_CALLS; i++)
+  {
+    farLat += 1.0e-12;
+    sum += geo_distance(&from, farLat, farLon);
+  }
+  Float64_t haversineRate = BENCH_CALLS / (testSeconds() - start);
+  benchSink = sum;
+
+  printf("distance, calls per second\n");
+  printf("  generated ECEF/NED subsystem:        %10.0f\n", generatedRate);
+  printf("  chart function, cached waypoint:     %10.0f\n", chartRate);
+  printf("  geo_distance, haversine, 50 km:      %10.0f\n", haversineRate);
+  TEST_CHECK(chartRate > generatedRate);
+}
+
+int main(void)
+{
+  accuracy(24.4539 * DEG, 55.6 * DEG);
+  accuracy(60.0 * DEG, -150.0 * DEG);
+  chartFunctions();
+  waypointCache();
+  benchmark();
+
+  return TEST_RESULT();
+}
@@ -0,0 +1,858 @@
+/*********************************************************************//**
+\file
+\brief
+  Module Title       : ADIS16505 sample timing and integration test
+
+  Abstract           : Runs the ADIS16505 driver on the PL SPI driver
+                       against a register model of the SPI core with the
+                       IMU behind it. The model clocks each transfer at
+                       the configured SPI rate, raises data ready at the
+                       2 kHz output rate of the device and serves the
+                       interrupts after a random latency, or after the
+                       critical sections of the driver. The device
+                       answers register accesses and bursts with the
+                       mean rates and specific forces of a known motion
+                       over each sample period.
+
+                       The timing case checks that every data ready
+                       produces one sample of the nominal period and that
+                       the integrated time covers the data ready times
+                       exactly. The fault case drops data ready edges,
+                       corrupts checksums and holds the interrupt off
+                       past the next data ready, and checks the
+                       lost and rejected counts and the bridged time. The
+                       accuracy case integrates a coning and sculling
+                       motion at 100 Hz and compares the attitude and
+                       velocity with the motion, and with the plain sums
+                       of the samples.
+*************************************************************************/
+
+/***** Includes *********************************************************/
+
+#include <math.h>
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "soc/timer/d_timer.h"
+#include "soc/discrete/d_discrete.h"
+#include "soc/uart/d_uart.h"
+#include "soc/interrupt_manager/d_int_irq_handler.h"
+#include "sru/fcu/d_fcu.h"
+#include "sru/fcu/d_fcu_cfg.h"
+#include "sru/spi_pl/d_spi_pl.h"
+#include "sru/spi_pl/d_spi_pl_cfg.h"
+#include "driver/imu_adis16505/d_imu_adis16505.h"
+#include "driver/imu_adis16505/d_imu_adis16505_cfg.h"
+#include "host_stubs.h"
+#include "test_common.h"
+
+/***** Constants ********************************************************/
+
+#define IMU_CHANNEL        1u
+#define SPI_BASE           0x00400000u
+#define SPI_CLOCK_HZ       1000000u
+
+/* SPI core registers */
+#define REG_STATUS         0x0000u
+#define REG_CTRL           0x0004u
+#define REG_CMD0           0x0008u
+#define REG_CMD1           0x000Cu
+#define REG_IRQ            0x0010u
+#define REG_FIFO           0x0100u
+
+#define IRQ_TRANSFER       0x00001u
+#define IRQ_DEVICE         0x10000u
+
+/* Device registers and commands */
+#define DEV_DIAG_STAT      0x02u
+#define DEV_RANG_MDL       0x5Eu
+#define DEV_DEC_RATE       0x64u
+#define DEV_PROD_ID        0x72u
+#define DEV_BURST          0x68u
+#define BURST_BYTES        34u
+
+/* Output rate with DEC_RATE 0 */
+#define DR_PERIOD_US       500u
+
+/* Interrupt latencies */
+#define DR_LATENCY_US      20u
+#define SPI_LATENCY_US     10u
+
+#define CONTROL_US         10000u
+
+#define RESOLUTION_GYRO    ((0.025 * 3.14159265358979 / 180.0) / 65536.0)
+#define RESOLUTION_ACCL    ((78.3 / 32000.0) / 65536.0)
+
+/* The motion: body rates about x and y turning at CONE_HZ about a steady z rate,
+   specific force along y in phase with the x rate */
+#define CONE_RATE          1.0
+#define CONE_HZ            10.0
+#define YAW_RATE           0.2
+#define SCULL_ACCL         3.0
+#define GRAVITY            9.80665
+
+#define TRUTH_STEP_US      5u
+
+/***** Type Definitions *************************************************/
+
+typedef struct
+{
+  Float64_t w;
+  Float64_t x;
+  Float64_t y;
+  Float64_t z;
+} quaternion_t;
+
+/* Sample of the device, kept by its time stamp */
+typedef struct
+{
+  Uint64_t drUs;              /* Data ready time */
+  Float64_t gyro[3];          /* Mean over the period ending at drUs, as encoded */
+  Float64_t accl[3];
+} deviceSample_t;
+
+/***** Variables ********************************************************/
+
+/* The test integrates the full output rate, as an application consuming the deltas does */
+const Uint16_t d_IMU_Adis16505_DecimationRate = 0u;
+
+const d_SPI_PL_Definition_t d_SPI_PL_Definition[] =
+{
+  { 0x00800000u, 22000000u, 126u, d_TRUE, NULL, NULL },
+  { SPI_BASE, SPI_CLOCK_HZ, 125u, d_FALSE, d_IMU_Adis16505_InterruptHandlerSpi, d_IMU_Adis16505_InterruptHandlerDevice }
+};
+
+d_SPI_PL_COUNT;
+
+/* SPI core */
+static Uint32_t coreCommand[2];
+static Uint32_t coreFifo[64];
+static Uint32_t coreFifoCount;
+static Uint32_t coreFifoOut;
+static Bool_t coreBusy;
+static Uint64_t coreEndUs;
+static Uint32_t coreBytes;
+static Uint8_t coreRx[8u + 256u];
+static Uint32_t coreIrq;
+static Bool_t irqPending;
+static Uint64_t irqDueUs;
+static Uint32_t transfers;
+static Uint64_t busyUs;
+
+/* Device */
+static Uint8_t deviceRegisters[128];
+static Uint16_t deviceResponse;
+static Uint64_t nextDrUs;
+static Uint16_t sampleIndex;
+static deviceSample_t samples[65536];
+
+/* Faults injected, one in so many data ready edges, 0 for none */
+static Uint32_t dropEvery;
+static Uint32_t corruptEvery;
+static Uint32_t heldEvery;
+static Uint32_t dropped;
+static Uint32_t corrupted;
+static Uint32_t held;
+static Uint32_t merged;
+
+/* Sample age: data ready to the sample being buffered */
+static Uint64_t burstDrUs;
+static Uint64_t ageMaxUs;
+
+static Uint32_t randomState = 16505u;
+
+/* Truth integrator */
+static Uint64_t truthUs;
+static quaternion_t truthAttitude;
+static Float64_t truthVelocity[3];
+
+/***** Function Definitions *********************************************/
+
+static Uint32_t randomNumber(const Uint32_t range)
+{
+  randomState = (randomState * 1664525u) + 1013904223u;
+
+  return (randomState >> 8u) % range;
+}
+
+/* The IMU is powered and the HILS is not used */
+d_Status_t d_FCU_IocAddressCheck(const Uint32_t address)
+{
+  return d_STATUS_SUCCESS;
+}
+
+Bool_t d_FCU_HilsActive(void)
+{
+  return d_FALSE;
+}
+
+d_Status_t d_INT_IrqEnable(const Uint32_t irq)
+{
+  return d_STATUS_SUCCESS;
+}
+
+d_Status_t d_UART_Configure(const Uint32_t uart, const Uint32_t baud, const d_UART_DataBits_t dataBits,
+                            const d_UART_Parity_t parity, const d_UART_StopBits_t stopBits)
+{
+  return d_STATUS_SUCCESS;
+}
+
+d_Status_t d_UART_Transmit(const Uint32_t uart, const Uint8_t * const buffer, const Uint32_t length)
+{
+  return d_STATUS_SUCCESS;
+}
+
+d_Status_t d_UART_Receive(const Uint32_t uart, Uint8_t * const buffer, const Uint32_t length, Uint32_t * const pBytesRead)
+{
+  *pBytesRead = 0u;
+
+  return d_STATUS_SUCCESS;
+}
+
+d_Status_t d_UART_FlushRx(const Uint32_t uart)
+{
+  return d_STATUS_SUCCESS;
+}
+
+d_Status_t d_DISC_SetAsOutputPin(const d_DISC_IO_t pin)
+{
+  return d_STATUS_SUCCESS;
+}
+
+d_Status_t d_DISC_SetPin(const d_DISC_IO_t pin)
+{
+  return d_STATUS_SUCCESS;
+}
+
+d_Status_t d_DISC_ClearPin(const d_DISC_IO_t pin)
+{
+  return d_STATUS_SUCCESS;
+}
+
+/* Body rate and specific force of the motion */
+static void motionAt(const Float64_t seconds, Float64_t gyro[3], Float64_t accl[3])
+{
+  Float64_t phase = 2.0 * 3.14159265358979 * CONE_HZ * seconds;
+
+  gyro[0] = CONE_RATE * cos(phase);
+  gyro[1] = CONE_RATE * sin(phase);
+  gyro[2] = YAW_RATE;
+  accl[0] = 0.0;
+  accl[1] = SCULL_ACCL * cos(phase);
+  accl[2] = -GRAVITY;
+}
+
+/* Mean of the motion over a period, from its integral */
+static void motionMean(const Float64_t t0, const Float64_t t1, Float64_t gyro[3], Float64_t accl[3])
+{
+  Float64_t omega = 2.0 * 3.14159265358979 * CONE_HZ;
+  Float64_t dt = t1 - t0;
+  Float64_t sinDiff = sin(omega * t1) - sin(omega * t0);
+  Float64_t cosDiff = cos(omega * t1) - cos(omega * t0);
+
+  gyro[0] = CONE_RATE * sinDiff / (omega * dt);
+  gyro[1] = -CONE_RATE * cosDiff / (omega * dt);
+  gyro[2] = YAW_RATE;
+  accl[0] = 0.0;
+  accl[1] = SCULL_ACCL * sinDiff / (omega * dt);
+  accl[2] = -GRAVITY;
+}
+
+static quaternion_t quaternionMultiply(const quaternion_t a, const quaternion_t b)
+{
+  quaternion_t q;
+
+  q.w = (a.w * b.w) - (a.x * b.x) - (a.y * b.y) - (a.z * b.z);
+  q.x = (a.w * b.x) + (a.x * b.w) + (a.y * b.z) - (a.z * b.y);
+  q.y = (a.w * b.y) - (a.x * b.z) + (a.y * b.w) + (a.z * b.x);
+  q.z = (a.w * b.z) + (a.x * b.y) - (a.y * b.x) + (a.z * b.w);
+
+  return q;
+}
+
+/* Rotation by a rotation vector */
+static quaternion_t quaternionFromVector(const Float64_t v[3])
+{
+  Float64_t angle = sqrt((v[0] * v[0]) + (v[1] * v[1]) + (v[2] * v[2]));
+  Float64_t s = (angle > 1.0e-12) ? (sin(0.5 * angle) / angle) : 0.5;
+  quaternion_t q = { cos(0.5 * angle), v[0] * s, v[1] * s, v[2] * s };
+
+  return q;
+}
+
+/* Angle of the rotation between two attitudes */
+static Float64_t quaternionAngle(const quaternion_t a, const quaternion_t b)
+{
+  quaternion_t c = { a.w, -a.x, -a.y, -a.z };
+  quaternion_t r = quaternionMultiply(c, b);
+
+  return 2.0 * atan2(sqrt((r.x * r.x) + (r.y * r.y) + (r.z * r.z)), fabs(r.w));
+}
+
+/* Body vector into the reference frame */
+static void quaternionRotate(const quaternion_t q, const Float64_t v[3], Float64_t out[3])
+{
+  quaternion_t p = { 0.0, v[0], v[1], v[2] };
+  quaternion_t c = { q.w, -q.x, -q.y, -q.z };
+  quaternion_t r = quaternionMultiply(quaternionMultiply(q, p), c);
+
+  out[0] = r.x;
+  out[1] = r.y;
+  out[2] = r.z;
+}
+
+/* Integrate the motion in fine steps to a time, the specific force
+   rotated by the attitude at the middle of each step */
+static void truthAdvance(const Uint64_t toUs)
+{
+  while (truthUs < toUs)
+  {
+    Float64_t t = (Float64_t)truthUs * 1.0e-6;
+    Float64_t dt = (Float64_t)TRUTH_STEP_US * 1.0e-6;
+    Float64_t gyro[3];
+    Float64_t accl[3];
+    Float64_t rotation[3];
+    Float64_t force[3];
+    quaternion_t mid;
+
+    motionMean(t, t + dt, gyro, accl);
+    for (Uint32_t axis = 0u; axis < 3u; axis++)
+    {
+      rotation[axis] = 0.5 * gyro[axis] * dt;
+    }
+    mid = quaternionMultiply(truthAttitude, quaternionFromVector(rotation));
+    for (Uint32_t axis = 0u; axis < 3u; axis++)
+    {
+      rotation[axis] = gyro[axis] * dt;
+    }
+    truthAttitude = quaternionMultiply(truthAttitude, quaternionFromVector(rotation));
+
+    motionAt(t + (0.5 * dt), gyro, accl);
+    quaternionRotate(mid, accl, force);
+    for (Uint32_t axis = 0u; axis < 3u; axis++)
+    {
+      truthVelocity[axis] += force[axis] * dt;
+    }
+    truthUs += TRUTH_STEP_US;
+  }
+}
+
+static void truthStart(const Uint64_t atUs)
+{
+  quaternion_t identity = { 1.0, 0.0, 0.0, 0.0 };
+
+  truthUs = atUs;
+  truthAttitude = identity;
+  memset(truthVelocity, 0, sizeof(truthVelocity));
+}
+
+static void put16(Uint8_t * const pData, const Uint32_t value)
+{
+  pData[0] = (Uint8_t)((value >> 8u) & 0xFFu);
+  pData[1] = (Uint8_t)(value & 0xFFu);
+}
+
+/* Burst of the latest sample: DIAG_STAT, gyros and accelerometers low word first, temperature, time stamp, checksum */
+static void burstEncode(Uint8_t * const pData)
+{
+  const deviceSample_t * const pSample = &samples[sampleIndex];
+  Uint16_t checksum = 0u;
+
+  memset(pData, 0, BURST_BYTES);
+  for (Uint32_t axis = 0u; axis < 3u; axis++)
+  {
+    Int32_t gyro = (Int32_t)lround(pSample->gyro[axis] / RESOLUTION_GYRO);
+    Int32_t accl = (Int32_t)lround(pSample->accl[axis] / RESOLUTION_ACCL);
+
+    put16(&pData[2u + (axis * 4u)], (Uint32_t)gyro & 0xFFFFu);
+    put16(&pData[4u + (axis * 4u)], (Uint32_t)gyro >> 16u);
+    put16(&pData[14u + (axis * 4u)], (Uint32_t)accl & 0xFFFFu);
+    put16(&pData[16u + (axis * 4u)], (Uint32_t)accl >> 16u);
+  }
+  put16(&pData[26], 250u);
+  put16(&pData[28], sampleIndex);
+  for (Uint32_t index = 0u; index < (BURST_BYTES - 4u); index++)
+  {
+    checksum = (Uint16_t)(checksum + pData[index]);
+  }
+  if ((corruptEvery != 0u) && (randomNumber(corruptEvery) == 0u))
+  {
+    checksum = (Uint16_t)(checksum + 1u);
+    corrupted++;
+  }
+  ELSE_DO_NOTHING
+  put16(&pData[BURST_BYTES - 4u], checksum);
+}
+
+/* The device side of a transfer: 16 bit frames, a read answers in the next frame */
+static void deviceTransfer(const Uint8_t * const pCommand, const Uint32_t dataCount, Uint8_t * const pRx)
+{
+  put16(pRx, deviceResponse);
+
+  if ((pCommand[0] == DEV_BURST) && (dataCount == BURST_BYTES))
+  {
+    burstEncode(&pRx[2]);
+    burstDrUs = samples[sampleIndex].drUs;
+  }
+  else if ((pCommand[0] & 0x80u) != 0u)
+  {
+    deviceRegisters[pCommand[0] & 0x7Fu] = pCommand[1];
+  }
+  else
+  {
+    Uint32_t address = pCommand[0] & 0x7Eu;
+    deviceResponse = (Uint16_t)(((Uint32_t)deviceRegisters[address + 1u] << 8u) | deviceRegisters[address]);
+  }
+}
+
+/* The core starts a transfer when its control register is written */
+static void coreStart(const Uint32_t control)
+{
+  Uint32_t dataCount = control >> 20u;
+  Uint32_t cmdCount = ((control >> 16u) & 0x7u) + 1u;
+  Uint8_t command[8];
+
+  memcpy(command, coreCommand, sizeof(command));
+  memset(coreRx, 0xFF, sizeof(coreRx));
+  deviceTransfer(command, dataCount, coreRx);
+
+  coreBytes = cmdCount + dataCount;
+  coreBusy = d_TRUE;
+  coreEndUs = host_TimerMicroseconds() + (((Uint64_t)coreBytes * 8u * 1000000u) / SPI_CLOCK_HZ);
+  busyUs += coreEndUs - host_TimerMicroseconds();
+  transfers++;
+}
+
+/* The received bytes go into the FIFO packed four to a word */
+static void coreComplete(void)
+{
+  coreFifoCount = (coreBytes + 3u) / 4u;
+  coreFifoOut = 0u;
+  for (Uint32_t word = 0u; word < coreFifoCount; word++)
+  {
+    coreFifo[word] = (Uint32_t)coreRx[word * 4u] | ((Uint32_t)coreRx[(word * 4u) + 1u] << 8u) |
+                     ((Uint32_t)coreRx[(word * 4u) + 2u] << 16u) | ((Uint32_t)coreRx[(word * 4u) + 3u] << 24u);
+  }
+  coreBusy = d_FALSE;
+  coreIrq |= IRQ_TRANSFER;
+}
+
+/* The transfer ends on time whether or not the processor is in an interrupt */
+static void coreUpdate(void)
+{
+  if ((coreBusy == d_TRUE) && (coreEndUs <= host_TimerMicroseconds()))
+  {
+    coreComplete();
+    if ((irqPending != d_TRUE) || (irqDueUs < coreEndUs))
+    {
+      irqDueUs = coreEndUs + randomNumber(SPI_LATENCY_US);
+    }
+    ELSE_DO_NOTHING
+    irqPending = d_TRUE;
+  }
+  ELSE_DO_NOTHING
+}
+
+static Uint32_t modelRead(const Uint32_t address)
+{
+  Uint32_t value = 0u;
+
+  switch (address - SPI_BASE)
+  {
+    case REG_STATUS:
+      coreUpdate();
+      value = ((coreBusy == d_TRUE) ? 0x10000u : 0u) | ((coreFifoCount - coreFifoOut) << 8u);
+      break;
+
+    case REG_IRQ:
+      value = coreIrq;
+      break;
+
+    case REG_FIFO:
+      if (coreFifoOut < coreFifoCount)
+      {
+        value = coreFifo[coreFifoOut];
+        coreFifoOut++;
+      }
+      ELSE_DO_NOTHING
+      break;
+
+    default:
+      break;
+  }
+
+  return value;
+}
+
+static void modelWrite(const Uint32_t address, const Uint32_t value)
+{
+  switch (address - SPI_BASE)
+  {
+    case REG_CMD0:
+      coreCommand[0] = value;
+      break;
+
+    case REG_CMD1:
+      coreCommand[1] = value;
+      break;
+
+    case REG_CTRL:
+      coreStart(value);
+      break;
+
+    case REG_IRQ:
+      coreIrq = value;
+      break;
+
+    default:
+      /* Transmit data */
+      break;
+  }
+}
+
+/* Data ready: the device latches the sample of the period just ended */
+static void dataReady(void)
+{
+  Float64_t t1 = (Float64_t)nextDrUs * 1.0e-6;
+  deviceSample_t * pSample;
+
+  sampleIndex++;
+  pSample = &samples[sampleIndex];
+  pSample->drUs = nextDrUs;
+  motionMean(t1 - ((Float64_t)DR_PERIOD_US * 1.0e-6), t1, pSample->gyro, pSample->accl);
+  for (Uint32_t axis = 0u; axis < 3u; axis++)
+  {
+    pSample->gyro[axis] = (Float64_t)lround(pSample->gyro[axis] / RESOLUTION_GYRO) * RESOLUTION_GYRO;
+    pSample->accl[axis] = (Float64_t)lround(pSample->accl[axis] / RESOLUTION_ACCL) * RESOLUTION_ACCL;
+  }
+
+  if ((dropEvery != 0u) && (randomNumber(dropEvery) == 0u))
+  {
+    /* The edge is missed by the interrupt controller */
+    dropped++;
+  }
+  else
+  {
+    /* An edge not yet served merges with the new one */
+    merged += ((coreIrq & IRQ_DEVICE) != 0u) ? 1u : 0u;
+    coreIrq |= IRQ_DEVICE;
+  }
+  nextDrUs += DR_PERIOD_US;
+}
+
+/* Events up to the current time in order. The interrupt is held off by
+   critical sections, and data ready edges arriving while it is held off
+   merge into the pending one */
+static void timerHook(void)
+{
+  Uint64_t now = host_TimerMicroseconds();
+  Bool_t more = d_TRUE;
+
+  while (more == d_TRUE)
+  {
+    if ((coreBusy == d_TRUE) && (coreEndUs <= nextDrUs) && (coreEndUs <= now))
+    {
+      coreUpdate();
+    }
+    else if (nextDrUs <= now)
+    {
+      Uint64_t drUs = nextDrUs;
+
+      dataReady();
+      if ((heldEvery != 0u) && (randomNumber(heldEvery) == 0u))
+      {
+        /* The application holds the interrupt off past the next data ready */
+        irqDueUs = drUs + DR_PERIOD_US + 100u;
+        held++;
+      }
+      else if ((irqPending != d_TRUE) || (irqDueUs < drUs))
+      {
+        irqDueUs = drUs + randomNumber(DR_LATENCY_US);
+      }
+      ELSE_DO_NOTHING
+      irqPending = d_TRUE;
+    }
+    else if ((irqPending == d_TRUE) && (irqDueUs <= now) && (host_CriticalDepth == 0))
+    {
+      Bool_t completion = ((coreIrq & IRQ_TRANSFER) != 0u) ? d_TRUE : d_FALSE;
+
+      irqPending = d_FALSE;
+      d_SPI_PL_InterruptHandler(IMU_CHANNEL);
+      if ((completion == d_TRUE) && (burstDrUs != 0u))
+      {
+        ageMaxUs = ((now - burstDrUs) > ageMaxUs) ? (now - burstDrUs) : ageMaxUs;
+        burstDrUs = 0u;
+      }
+      ELSE_DO_NOTHING
+    }
+    else
+    {
+      more = d_FALSE;
+    }
+  }
+}
+
+/* Power up of the device model and the driver initialisation with its BIT */
+static void startUp(void)
+{
+  d_IMU_Adis16505_Data_t data;
+
+  host_Reset();
+  host_RegisterSetModel(modelRead, modelWrite);
+  host_TimerSetHook(timerHook);
+  host_TimerSetReadCost(1u);
+
+  memset(deviceRegisters, 0, sizeof(deviceRegisters));
+  deviceRegisters[DEV_PROD_ID] = 0x79u;
+  deviceRegisters[DEV_PROD_ID + 1u] = 0x40u;
+  deviceRegisters[DEV_RANG_MDL] = 0x07u;
+  deviceRegisters[DEV_DEC_RATE] = 0x13u;
+  deviceResponse = 0u;
+  nextDrUs = DR_PERIOD_US;
+  coreBusy = d_FALSE;
+  coreFifoCount = 0u;
+  coreFifoOut = 0u;
+  coreIrq = 0u;
+  irqPending = d_FALSE;
+  burstDrUs = 0u;
+  dropEvery = 0u;
+  corruptEvery = 0u;
+  heldEvery = 0u;
+
+  TEST_CHECK_EQUAL(d_IMU_Adis16505_Initialise(&data), d_STATUS_SUCCESS);
+  TEST_CHECK_EQUAL(d_IMU_Adis16505_State(), IMU_ADIS16505_STATE_STREAM);
+  TEST_CHECK_EQUAL(data.model, 7u);
+
+  /* DEC_RATE written from the configuration, the output rate is 2 kHz */
+  TEST_CHECK_EQUAL(deviceRegisters[DEV_DEC_RATE], 0u);
+}
+
+/* Runs the streaming for a time and integrates at the control rate */
+static void stream(const Uint32_t controls, void (* const consume)(const d_IMU_Adis16505_Delta_t * const pDelta))
+{
+  d_IMU_Adis16505_Delta_t delta;
+
+  for (Uint32_t control = 0u; control < controls; control++)
+  {
+    for (Uint32_t us = 0u; us < CONTROL_US; us++)
+    {
+      host_TimerAdvance(1u);
+    }
+    (void)d_IMU_Adis16505_Integrate(&delta);
+    consume(&delta);
+  }
+}
+
+/* Totals over a run */
+static Uint32_t totalSamples;
+static Uint32_t totalLost;
+static Uint32_t totalRejected;
+static Uint64_t totalTimeUs;
+static Uint64_t firstStartUs;
+static Uint64_t lastEndUs;
+static Uint32_t periodMismatches;
+static Uint32_t minSamples;
+static Uint32_t maxSamples;
+
+static void runStart(void)
+{
+  d_IMU_Adis16505_Delta_t delta;
+
+  /* Samples since the initialisation are discarded, the run starts at the last of them */
+  for (Uint32_t us = 0u; us < CONTROL_US; us++)
+  {
+    host_TimerAdvance(1u);
+  }
+  (void)d_IMU_Adis16505_Integrate(&delta);
+  firstStartUs = samples[delta.timeStamp].drUs;
+  lastEndUs = firstStartUs;
+  totalSamples = 0u;
+  totalLost = 0u;
+  totalRejected = 0u;
+  totalTimeUs = 0u;
+  periodMismatches = 0u;
+  minSamples = 0xFFFFFFFFu;
+  maxSamples = 0u;
+  dropped = 0u;
+  corrupted = 0u;
+  held = 0u;
+  merged = 0u;
+  ageMaxUs = 0u;
+  busyUs = 0u;
+}
+
+static void consumeTiming(const d_IMU_Adis16505_Delta_t * const pDelta)
+{
+  Uint64_t endUs = samples[pDelta->timeStamp].drUs;
+
+  totalSamples += pDelta->samples;
+  totalLost += pDelta->lostSamples;
+  totalRejected += pDelta->rejectedSamples;
+  totalTimeUs += (Uint64_t)lround((Float64_t)pDelta->deltaTime * 1.0e6);
+
+  /* The time of each call is the span of its data ready times */
+  periodMismatches += (llabs((long long)lround((Float64_t)pDelta->deltaTime * 1.0e6) - (long long)(endUs - lastEndUs)) > 1) ? 1u : 0u;
+  minSamples = (pDelta->samples < minSamples) ? pDelta->samples : minSamples;
+  maxSamples = (pDelta->samples > maxSamples) ? pDelta->samples : maxSamples;
+  lastEndUs = endUs;
+}
+
+/* Every data ready gives a sample of the nominal period */
+static void testTiming(void)
+{
+  startUp();
+  runStart();
+  stream(200u, consumeTiming);
+
+  printf("timing: %u samples in %.3f s, %u to %u per control step, burst %u us, bus busy %.1f%%, "
+         "data ready to sample buffered max %u us\n",
+         totalSamples, (Float64_t)totalTimeUs * 1.0e-6, minSamples, maxSamples,
+         ((BURST_BYTES + 2u) * 8u * 1000000u) / SPI_CLOCK_HZ,
+         (100.0 * (Float64_t)busyUs) / ((Float64_t)(lastEndUs - firstStartUs)), (Uint32_t)ageMaxUs);
+
+  TEST_CHECK_EQUAL(totalLost, 0u);
+  TEST_CHECK_EQUAL(totalRejected, 0u);
+  TEST_CHECK_EQUAL(periodMismatches, 0u);
+  TEST_CHECK_EQUAL(totalSamples, (lastEndUs - firstStartUs) / DR_PERIOD_US);
+  TEST_CHECK(minSamples >= ((CONTROL_US / DR_PERIOD_US) - 1u));
+  TEST_CHECK(maxSamples <= ((CONTROL_US / DR_PERIOD_US) + 1u));
+  TEST_CHECK(ageMaxUs < DR_PERIOD_US);
+  TEST_CHECK_EQUAL(host_ErrorCount, 0u);
+}
+
+/* Dropped edges, bad checksums and held off interrupts are counted and their time bridged */
+static void testFaults(void)
+{
+  startUp();
+  runStart();
+  dropEvery = 50u;
+  corruptEvery = 70u;
+  heldEvery = 90u;
+  stream(500u, consumeTiming);
+  dropEvery = 0u;
+  corruptEvery = 0u;
+  heldEvery = 0u;
+
+  printf("faults: %u edges dropped, %u checksums corrupted, %u interrupts held off merging %u edges; "
+         "%u lost, %u rejected, %u integrated\n",
+         dropped, corrupted, held, merged, totalLost, totalRejected, totalSamples);
+
+  TEST_CHECK(dropped > 0u);
+  TEST_CHECK(corrupted > 0u);
+  TEST_CHECK(held > 0u);
+  TEST_CHECK(merged > 0u);
+  TEST_CHECK_EQUAL(totalRejected, corrupted);
+
+  /* Each edge gives a sample or a lost period, merged edges are served by one burst */
+  TEST_CHECK_EQUAL(totalLost, dropped + corrupted + merged);
+  TEST_CHECK_EQUAL(totalSamples + totalLost, (lastEndUs - firstStartUs) / DR_PERIOD_US);
+
+  /* The bridged periods keep the integrated time on the data ready times */
+  TEST_CHECK_EQUAL(periodMismatches, 0u);
+  TEST_CHECK_EQUAL(totalTimeUs, lastEndUs - firstStartUs);
+  TEST_CHECK_EQUAL(host_ErrorCount, 0u);
+}
+
+/* Attitude and velocity from the increments, and from the plain sums of the samples */
+static quaternion_t attitudeCorrected;
+static quaternion_t attitudePlain;
+static Float64_t velocityCorrected[3];
+static Float64_t velocityPlain[3];
+static Float64_t velocityErrorMax[2];
+static Float64_t attitudeErrorMax[2];
+static Uint16_t lastTimeStamp;
+
+static void consumeAccuracy(const d_IMU_Adis16505_Delta_t * const pDelta)
+{
+  Float64_t angle[3];
+  Float64_t velocity[3];
+  Float64_t plainAngle[3] = { 0.0, 0.0, 0.0 };
+  Float64_t plainVelocity[3] = { 0.0, 0.0, 0.0 };
+  Float64_t rotated[3];
+  Float64_t error;
+
+  /* The plain sums of the samples of the call */
+  for (Uint16_t index = (Uint16_t)(lastTimeStamp + 1u); index != (Uint16_t)(pDelta->timeStamp + 1u); index++)
+  {
+    for (Uint32_t axis = 0u; axis < 3u; axis++)
+    {
+      plainAngle[axis] += samples[index].gyro[axis] * ((Float64_t)DR_PERIOD_US * 1.0e-6);
+      plainVelocity[axis] += samples[index].accl[axis] * ((Float64_t)DR_PERIOD_US * 1.0e-6);
+    }
+  }
+  lastTimeStamp = pDelta->timeStamp;
+
+  /* The velocity change is in the body frame at the start of the call */
+  for (Uint32_t axis = 0u; axis < 3u; axis++)
+  {
+    angle[axis] = (Float64_t)pDelta->deltaAngle[axis];
+    velocity[axis] = (Float64_t)pDelta->deltaVelocity[axis];
+  }
+  quaternionRotate(attitudeCorrected, velocity, rotated);
+  for (Uint32_t axis = 0u; axis < 3u; axis++)
+  {
+    velocityCorrected[axis] += rotated[axis];
+  }
+  quaternionRotate(attitudePlain, plainVelocity, rotated);
+  for (Uint32_t axis = 0u; axis < 3u; axis++)
+  {
+    velocityPlain[axis] += rotated[axis];
+  }
+  attitudeCorrected = quaternionMultiply(attitudeCorrected, quaternionFromVector(angle));
+  attitudePlain = quaternionMultiply(attitudePlain, quaternionFromVector(plainAngle));
+
+  truthAdvance(samples[pDelta->timeStamp].drUs);
+  error = quaternionAngle(attitudeCorrected, truthAttitude);
+  attitudeErrorMax[0] = (error > attitudeErrorMax[0]) ? error : attitudeErrorMax[0];
+  error = quaternionAngle(attitudePlain, truthAttitude);
+  attitudeErrorMax[1] = (error > attitudeErrorMax[1]) ? error : attitudeErrorMax[1];
+  error = sqrt(pow(velocityCorrected[0] - truthVelocity[0], 2.0) + pow(velocityCorrected[1] - truthVelocity[1], 2.0) +
+               pow(velocityCorrected[2] - truthVelocity[2], 2.0));
+  velocityErrorMax[0] = (error > velocityErrorMax[0]) ? error : velocityErrorMax[0];
+  error = sqrt(pow(velocityPlain[0] - truthVelocity[0], 2.0) + pow(velocityPlain[1] - truthVelocity[1], 2.0) +
+               pow(velocityPlain[2] - truthVelocity[2], 2.0));
+  velocityErrorMax[1] = (error > velocityErrorMax[1]) ? error : velocityErrorMax[1];
+}
+
+/* Coning and sculling motion integrated at 100 Hz for 10 s */
+static void testAccuracy(void)
+{
+  quaternion_t identity = { 1.0, 0.0, 0.0, 0.0 };
+  d_IMU_Adis16505_Delta_t delta;
+
+  startUp();
+  for (Uint32_t us = 0u; us < CONTROL_US; us++)
+  {
+    host_TimerAdvance(1u);
+  }
+  (void)d_IMU_Adis16505_Integrate(&delta);
+  lastTimeStamp = delta.timeStamp;
+  truthStart(samples[delta.timeStamp].drUs);
+  attitudeCorrected = identity;
+  attitudePlain = identity;
+  memset(velocityCorrected, 0, sizeof(velocityCorrected));
+  memset(velocityPlain, 0, sizeof(velocityPlain));
+  memset(attitudeErrorMax, 0, sizeof(attitudeErrorMax));
+  memset(velocityErrorMax, 0, sizeof(velocityErrorMax));
+
+  stream(1000u, consumeAccuracy);
+
+  printf("accuracy over 10 s: attitude error max %.6f deg corrected, %.4f deg plain sums; "
+         "velocity error max %.4f m/s corrected, %.4f m/s plain sums\n",
+         attitudeErrorMax[0] * 180.0 / 3.14159265358979, attitudeErrorMax[1] * 180.0 / 3.14159265358979,
+         velocityErrorMax[0], velocityErrorMax[1]);
+
+  TEST_CHECK(attitudeErrorMax[0] < (attitudeErrorMax[1] / 10.0));
+  TEST_CHECK(velocityErrorMax[0] < (velocityErrorMax[1] / 10.0));
+  TEST_CHECK_EQUAL(host_ErrorCount, 0u);
+}
+
+int main(void)
+{
+  testTiming();
+  testFaults();
+  testAccuracy();
+
+  return TEST_RESULT();
+}
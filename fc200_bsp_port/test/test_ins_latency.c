@@ -0,0 +1,684 @@
+/*********************************************************************//**
+\file
+\brief
+  Module Title       : INS sample age and prediction replay
+
+  Abstract           : Replays an INS data stream with synthetic delays
+                       through the PL UART driver, the UART service and
+                       the INS decoder of the flight software. The UART is
+                       a register model of the 16550 core with its 16 byte
+                       FIFO, receive trigger and character timeout, served
+                       by an interrupt that runs after a random latency.
+                       The INS sends user defined data frames of a known
+                       manoeuvre at a rate a little off the 100 Hz of the
+                       flight software, with jitter, so the age of the
+                       data at the control instant covers the whole frame
+                       period. The reads of the flight software are late
+                       by a random scheduling delay, and now and then by
+                       an overrun of the previous frame.
+
+                       At each control instant the age of the latest
+                       sample is checked against the arrival of the first
+                       byte of its frame. The attitude and position as
+                       received and as predicted to the control instant
+                       are compared with the manoeuvre at that instant.
+*************************************************************************/
+
+/***** Includes *********************************************************/
+
+#include <math.h>
+#include <stdarg.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "soc/uart/d_uart.h"
+#include "soc/uart/d_uart_pl.h"
+#include "soc/uart/d_uart_pl_cfg.h"
+#include "soc/interrupt_manager/d_int_irq_handler.h"
+#include "sru/fcu/d_fcu_cfg.h"
+#include "da_ins_il.h"
+#include "host_stubs.h"
+#include "test_common.h"
+
+/***** Constants ********************************************************/
+
+/* The INS is on UART 26, the PL interfaces follow the two PS UARTs */
+#define INS_PL_UART        24u
+#define UART_BASE          0x00300000u
+#define UART_CLOCK_HZ      73728000u
+
+#define INS_BAUD           460800.0
+#define CHARACTER_US       (10.0e6 / INS_BAUD)
+
+/* 16550 registers, the divisor latch is at the receive buffer and interrupt enable */
+#define REG_RBR            0x00u
+#define REG_IER            0x04u
+#define REG_IIR            0x08u
+#define REG_LCR            0x0Cu
+#define REG_LSR            0x14u
+
+#define FIFO_SIZE          16u
+#define CHAR_TIMEOUT       4.0
+
+/* User defined data frame: header, type, identifier, length, payload and checksum */
+#define UDD_PAYLOAD        150u
+#define UDD_DATA           26u
+#define FRAME_BYTES        (UDD_PAYLOAD + 8u)
+
+#define FRAMES             3000u
+
+/* The INS clock runs 0.2% slow of the flight software, each frame is sent with up to 300 us of jitter */
+#define INS_PERIOD_US      10020.0
+#define INS_JITTER_US      300u
+
+#define FCU_FRAME_US       10000u
+
+/* Interrupt latency, mostly short, sometimes behind another interrupt or a critical section */
+#define ISR_LATENCY_US     20u
+#define ISR_BLOCKED_US     200u
+
+#define DEG_TO_RAD         (3.14159265358979 / 180.0)
+#define EARTH_RADIUS_M     6371000.0
+
+/***** Type Definitions *************************************************/
+
+typedef struct
+{
+  Float64_t roll;             /* Euler angles, degrees */
+  Float64_t pitch;
+  Float64_t yaw;
+  Float64_t p;                /* Body rates, degrees per second */
+  Float64_t q;
+  Float64_t r;
+  Float64_t latitude;         /* Degrees */
+  Float64_t longitude;
+  Float64_t altitude;         /* Metres */
+} truth_t;
+
+typedef struct
+{
+  Float64_t sampleUs;         /* Time of the data in the frame */
+  Float64_t firstByteUs;      /* Time the first byte of the frame completed */
+} frameRecord_t;
+
+typedef struct
+{
+  Float64_t sumSquares;
+  Float64_t maximum;
+  Uint32_t count;
+} errorStats_t;
+
+/***** Variables ********************************************************/
+
+const d_UART_PL_Configuration_t d_UART_PL_Configuration[] =
+{
+  [INS_PL_UART] = { UART_BASE, UART_CLOCK_HZ, 0u }
+};
+
+d_UART_PL_COUNT;
+
+static frameRecord_t frames[FRAMES];
+static Uint32_t framesSent;
+
+/* Frame on the wire */
+static Uint8_t wireFrame[FRAME_BYTES];
+static Uint32_t wireIndex;
+static Bool_t wireActive;
+static Float64_t wireStartUs;
+
+/* UART model */
+static Uint8_t fifo[FIFO_SIZE];
+static Uint32_t fifoIn;
+static Uint32_t fifoCount;
+static Uint32_t fifoOverruns;
+static Float64_t lastActivityUs;
+static Uint32_t registerIer;
+static Uint32_t registerLcr;
+static Bool_t isrPending;
+static Uint64_t isrDueUs;
+
+static Bool_t consoleQuiet;
+static Uint32_t randomState = 1045u;
+
+/***** Function Definitions *********************************************/
+
+static Uint32_t randomNumber(const Uint32_t range)
+{
+  randomState = (randomState * 1664525u) + 1013904223u;
+
+  return (randomState >> 8u) % range;
+}
+
+/* Console of the flight software, its printf is printf_ */
+int printf_(const char * format, ...)
+{
+  va_list args;
+  int count = 0;
+
+  if (consoleQuiet == d_FALSE)
+  {
+    va_start(args, format);
+    count = vfprintf(stdout, format, args);
+    va_end(args);
+  }
+  ELSE_DO_NOTHING
+
+  return count;
+}
+
+d_Status_t d_FCU_IocAddressCheck(const Uint32_t address)
+{
+  return d_STATUS_SUCCESS;
+}
+
+d_Status_t d_INT_IrqEnable(const Uint32_t irq)
+{
+  return d_STATUS_SUCCESS;
+}
+
+/* The PS UARTs are not used */
+d_Status_t d_UART_PsConfigure(const Uint32_t uart, const Uint32_t baud, const d_UART_DataBits_t dataBits,
+                              const d_UART_Parity_t parity, const d_UART_StopBits_t stopBits)
+{
+  return d_STATUS_INVALID_MODE;
+}
+
+d_Status_t d_UART_PsSetBaudRate(const Uint32_t uart, const Uint32_t baud)
+{
+  return d_STATUS_INVALID_MODE;
+}
+
+d_Status_t d_UART_PsTransmit(const Uint32_t uart, const Uint8_t * const buffer, const Uint32_t length)
+{
+  return d_STATUS_INVALID_MODE;
+}
+
+d_Status_t d_UART_PsReceive(const Uint32_t uart, Uint8_t * const buffer, const Uint32_t length,
+                            Uint32_t * const pBytesRead)
+{
+  return d_STATUS_INVALID_MODE;
+}
+
+d_Status_t d_UART_PsDiscard(const Uint32_t uart, const Uint32_t length)
+{
+  return d_STATUS_INVALID_MODE;
+}
+
+d_Status_t d_UART_PsFlushRx(const Uint32_t uart)
+{
+  return d_STATUS_INVALID_MODE;
+}
+
+d_Status_t d_UART_PsFlushTx(const Uint32_t uart)
+{
+  return d_STATUS_INVALID_MODE;
+}
+
+d_Status_t d_UART_PsLoopback(const Uint32_t uart, const Bool_t enable)
+{
+  return d_STATUS_INVALID_MODE;
+}
+
+/* Interrupt identification of the 16550, receive data first, then the character timeout */
+static Uint32_t interruptIdentification(void)
+{
+  Float64_t now = (Float64_t)host_TimerMicroseconds();
+  Uint32_t iir = 0x01u;
+
+  if (((registerIer & 0x01u) != 0u) && (fifoCount >= 4u))
+  {
+    iir = 0x04u;
+  }
+  else if (((registerIer & 0x01u) != 0u) && (fifoCount > 0u) && (now >= (lastActivityUs + (CHAR_TIMEOUT * CHARACTER_US))))
+  {
+    iir = 0x0Cu;
+  }
+  else if ((registerIer & 0x02u) != 0u)
+  {
+    iir = 0x02u;
+  }
+  else
+  {
+    /* No interrupt */
+  }
+
+  return iir;
+}
+
+static Uint32_t modelRead(const Uint32_t address)
+{
+  Uint32_t value = 0u;
+
+  switch (address - UART_BASE)
+  {
+    case REG_RBR:
+      if (fifoCount > 0u)
+      {
+        value = fifo[(fifoIn + FIFO_SIZE - fifoCount) % FIFO_SIZE];
+        fifoCount--;
+        lastActivityUs = (Float64_t)host_TimerMicroseconds();
+      }
+      ELSE_DO_NOTHING
+      break;
+
+    case REG_IER:
+      value = registerIer;
+      break;
+
+    case REG_IIR:
+      value = interruptIdentification();
+      break;
+
+    case REG_LSR:
+      /* Transmitter always empty */
+      value = 0x60u | ((fifoCount > 0u) ? 0x01u : 0x00u);
+      break;
+
+    default:
+      break;
+  }
+
+  return value;
+}
+
+static void modelWrite(const Uint32_t address, const Uint32_t value)
+{
+  switch (address - UART_BASE)
+  {
+    case REG_IER:
+      if ((registerLcr & 0x80u) == 0u)
+      {
+        registerIer = value;
+      }
+      ELSE_DO_NOTHING
+      break;
+
+    case REG_LCR:
+      registerLcr = value;
+      break;
+
+    default:
+      /* Transmitted data, divisor, FIFO and modem control */
+      break;
+  }
+}
+
+/* The manoeuvre: rolling and pitching oscillations in a turn, climbing north east */
+static void truthAt(const Float64_t microseconds, truth_t * const pTruth)
+{
+  Float64_t t = microseconds * 1.0e-6;
+  Float64_t rollRate;
+  Float64_t pitchRate;
+  Float64_t yawRate = 20.0;
+  Float64_t roll;
+  Float64_t pitch;
+
+  pTruth->roll = 30.0 * sin(2.0 * 3.14159265358979 * 0.5 * t);
+  pTruth->pitch = 10.0 * sin((2.0 * 3.14159265358979 * 0.3 * t) + 0.5);
+  pTruth->yaw = fmod(90.0 + (yawRate * t), 360.0);
+  rollRate = 30.0 * 2.0 * 3.14159265358979 * 0.5 * cos(2.0 * 3.14159265358979 * 0.5 * t);
+  pitchRate = 10.0 * 2.0 * 3.14159265358979 * 0.3 * cos((2.0 * 3.14159265358979 * 0.3 * t) + 0.5);
+
+  /* Body rates from the Euler angle rates */
+  roll = pTruth->roll * DEG_TO_RAD;
+  pitch = pTruth->pitch * DEG_TO_RAD;
+  pTruth->p = rollRate - (yawRate * sin(pitch));
+  pTruth->q = (pitchRate * cos(roll)) + (yawRate * sin(roll) * cos(pitch));
+  pTruth->r = (-pitchRate * sin(roll)) + (yawRate * cos(roll) * cos(pitch));
+
+  /* 30 m/s north, 10 m/s east and 2 m/s up, on the spherical earth of the prediction */
+  pTruth->latitude = 52.0 + ((30.0 * t / EARTH_RADIUS_M) / DEG_TO_RAD);
+  pTruth->longitude = -1.0 + ((10.0 * t / (EARTH_RADIUS_M * cos(52.0 * DEG_TO_RAD))) / DEG_TO_RAD);
+  pTruth->altitude = 100.0 + (2.0 * t);
+}
+
+static void put16(Uint8_t * const pData, const Int32_t value)
+{
+  pData[0] = (Uint8_t)((Uint32_t)value & 0xFFu);
+  pData[1] = (Uint8_t)(((Uint32_t)value >> 8u) & 0xFFu);
+}
+
+static void put32(Uint8_t * const pData, const Int32_t value)
+{
+  put16(pData, (Int32_t)((Uint32_t)value & 0xFFFFu));
+  put16(&pData[2], (Int32_t)((Uint32_t)value >> 16u));
+}
+
+/* User defined data frame of the manoeuvre at a time, as the INS is configured */
+static void encodeFrame(const Float64_t sampleUs, Uint8_t * const pFrame)
+{
+  Uint8_t * const pPayload = &pFrame[6];
+  Uint8_t * const pData = &pPayload[UDD_DATA];
+  Uint16_t checksum = 0u;
+  truth_t truth;
+
+  truthAt(sampleUs, &truth);
+  memset(pFrame, 0, FRAME_BYTES);
+
+  pFrame[0] = 0xAAu;
+  pFrame[1] = 0x55u;
+  pFrame[2] = 0x01u;
+  pFrame[3] = 0x95u;
+  put16(&pFrame[4], (Int32_t)(UDD_PAYLOAD + 6u));
+  pPayload[0] = 25u;
+
+  /* Heading, pitch and roll in 0.01 degrees */
+  put16(&pData[0], (Int32_t)lround(truth.yaw * 100.0) % 36000);
+  put16(&pData[2], (Int32_t)lround(truth.pitch * 100.0));
+  put16(&pData[4], (Int32_t)lround(truth.roll * 100.0));
+
+  /* Gyros in 0.02 degrees per second, the INS is mounted with x and y swapped and z up */
+  put16(&pData[6], (Int32_t)lround(truth.q / 0.02));
+  put16(&pData[8], (Int32_t)lround(truth.p / 0.02));
+  put16(&pData[10], (Int32_t)lround(-truth.r / 0.02));
+  put16(&pData[16], 2000);
+
+  /* Position in 1e-7 degrees and centimetres, velocity east, north and up in cm/s */
+  put32(&pData[26], (Int32_t)lround(truth.latitude * 1.0e7));
+  put32(&pData[30], (Int32_t)lround(truth.longitude * 1.0e7));
+  put32(&pData[34], (Int32_t)lround(truth.altitude * 100.0));
+  put32(&pData[38], 1000);
+  put32(&pData[42], 3000);
+  put32(&pData[46], 200);
+
+  /* Satellites used and GNSS standard deviations in mm */
+  pData[60] = 12u;
+  put16(&pData[109], 100);
+  put16(&pData[111], 100);
+  put16(&pData[113], 150);
+
+  for (Uint32_t index = 2u; index < (FRAME_BYTES - 2u); index++)
+  {
+    checksum = (Uint16_t)(checksum + pFrame[index]);
+  }
+  put16(&pFrame[FRAME_BYTES - 2u], (Int32_t)checksum);
+}
+
+/* Characters that have completed on the wire go into the FIFO */
+static void wireStep(const Float64_t now, Float64_t * const pNextSampleUs)
+{
+  if ((wireActive == d_FALSE) && (framesSent < FRAMES) && (now >= *pNextSampleUs))
+  {
+    wireStartUs = *pNextSampleUs;
+    encodeFrame(wireStartUs, wireFrame);
+    frames[framesSent].sampleUs = wireStartUs;
+    frames[framesSent].firstByteUs = wireStartUs + CHARACTER_US;
+    framesSent++;
+    wireIndex = 0u;
+    wireActive = d_TRUE;
+
+    /* The frames keep to the INS clock, the jitter does not accumulate */
+    *pNextSampleUs = 1000.0 + ((Float64_t)framesSent * INS_PERIOD_US) + (Float64_t)randomNumber(INS_JITTER_US);
+  }
+  ELSE_DO_NOTHING
+
+  while ((wireActive == d_TRUE) && ((wireStartUs + ((Float64_t)(wireIndex + 1u) * CHARACTER_US)) <= now))
+  {
+    if (fifoCount < FIFO_SIZE)
+    {
+      fifo[fifoIn] = wireFrame[wireIndex];
+      fifoIn = (fifoIn + 1u) % FIFO_SIZE;
+      fifoCount++;
+    }
+    else
+    {
+      fifoOverruns++;
+    }
+    lastActivityUs = wireStartUs + ((Float64_t)(wireIndex + 1u) * CHARACTER_US);
+    wireIndex++;
+    wireActive = (wireIndex < FRAME_BYTES) ? d_TRUE : d_FALSE;
+  }
+}
+
+/* The interrupt is taken after a latency, if it is still raised */
+static void interruptStep(const Uint64_t now)
+{
+  if (interruptIdentification() != 0x01u)
+  {
+    if (isrPending == d_FALSE)
+    {
+      isrPending = d_TRUE;
+      isrDueUs = now + ((randomNumber(5u) == 0u) ? randomNumber(ISR_BLOCKED_US) : randomNumber(ISR_LATENCY_US));
+    }
+    else if (now >= isrDueUs)
+    {
+      d_UART_PlInterruptHandler(INS_PL_UART);
+      isrPending = d_FALSE;
+    }
+    else
+    {
+      /* Waiting */
+    }
+  }
+  else
+  {
+    isrPending = d_FALSE;
+  }
+}
+
+static void errorAdd(errorStats_t * const pStats, const Float64_t error)
+{
+  pStats->sumSquares += error * error;
+  pStats->maximum = (error > pStats->maximum) ? error : pStats->maximum;
+  pStats->count++;
+}
+
+static Float64_t errorRms(const errorStats_t * const pStats)
+{
+  return (pStats->count > 0u) ? sqrt(pStats->sumSquares / (Float64_t)pStats->count) : 0.0;
+}
+
+static Float64_t angleDifference(const Float64_t angle, const Float64_t reference)
+{
+  Float64_t difference = fmod(angle - reference, 360.0);
+
+  if (difference > 180.0)
+  {
+    difference -= 360.0;
+  }
+  else if (difference < -180.0)
+  {
+    difference += 360.0;
+  }
+  else
+  {
+    /* In range */
+  }
+
+  return difference;
+}
+
+static Float64_t attitudeError(const Float32_t * const pEuler, const truth_t * const pTruth)
+{
+  Float64_t roll = angleDifference((Float64_t)pEuler[0] / DEG_TO_RAD, pTruth->roll);
+  Float64_t pitch = angleDifference((Float64_t)pEuler[1] / DEG_TO_RAD, pTruth->pitch);
+  Float64_t yaw = angleDifference((Float64_t)pEuler[2] / DEG_TO_RAD, pTruth->yaw);
+
+  return sqrt((roll * roll) + (pitch * pitch) + (yaw * yaw));
+}
+
+static Float64_t positionError(const Float64_t latitude, const Float64_t longitude, const Float32_t altitude,
+                               const truth_t * const pTruth)
+{
+  Float64_t north = (latitude - pTruth->latitude) * DEG_TO_RAD * EARTH_RADIUS_M;
+  Float64_t east = (longitude - pTruth->longitude) * DEG_TO_RAD * EARTH_RADIUS_M * cos(pTruth->latitude * DEG_TO_RAD);
+  Float64_t up = (Float64_t)altitude - pTruth->altitude;
+
+  return sqrt((north * north) + (east * east) + (up * up));
+}
+
+static void testReplay(void)
+{
+  Float64_t nextSampleUs = 1000.0;
+  Uint64_t frameStartUs = 0u;
+  Uint64_t readUs = 0u;
+  Uint64_t controlUs = 0u;
+  Bool_t readDone = d_TRUE;
+  Bool_t controlDone = d_TRUE;
+  Uint32_t decoded = 0u;
+  Float64_t decodeMaxUs = 0.0;
+  Float64_t ageMinUs = 1.0e9;
+  Float64_t ageMaxUs = 0.0;
+  Float64_t ageErrorMaxUs = 0.0;
+  Uint32_t ageUnknown = 0u;
+  errorStats_t attitudeRaw = { 0.0, 0.0, 0u };
+  errorStats_t attitudePredicted = { 0.0, 0.0, 0u };
+  errorStats_t positionRaw = { 0.0, 0.0, 0u };
+  errorStats_t positionPredicted = { 0.0, 0.0, 0u };
+  s_latency_hist_t hist;
+  Uint32_t binTotal = 0u;
+
+  consoleQuiet = d_TRUE;
+  TEST_CHECK(da_ins_il_init() == true);
+
+  while ((framesSent < FRAMES) || (wireActive == d_TRUE) || (decoded < framesSent))
+  {
+    Uint64_t now = host_TimerMicroseconds();
+
+    wireStep((Float64_t)now, &nextSampleUs);
+    interruptStep(now);
+
+    /* The flight software frame: the read is late by its scheduling, the control instant follows */
+    if (now >= (frameStartUs + FCU_FRAME_US))
+    {
+      frameStartUs += FCU_FRAME_US;
+      readUs = frameStartUs + 200u + randomNumber(300u) + ((randomNumber(10u) == 0u) ? randomNumber(3000u) : 0u);
+      controlUs = readUs + 300u + randomNumber(1200u);
+      readDone = d_FALSE;
+      controlDone = d_FALSE;
+    }
+    ELSE_DO_NOTHING
+
+    if ((readDone == d_FALSE) && (now >= readUs))
+    {
+      da_ins_il_read_periodic();
+      (void)da_get_latency_hist(DA_SENSOR_INS, &hist);
+      for (; decoded < hist.samples; decoded++)
+      {
+        Float64_t latency = (Float64_t)now - frames[decoded].firstByteUs;
+        decodeMaxUs = (latency > decodeMaxUs) ? latency : decodeMaxUs;
+      }
+      readDone = d_TRUE;
+    }
+    ELSE_DO_NOTHING
+
+    if ((controlDone == d_FALSE) && (now >= controlUs) && (decoded > 0u))
+    {
+      Float64_t trueAge = (Float64_t)now - frames[decoded - 1u].firstByteUs;
+      Uint32_t age;
+      Float32_t euler[3];
+      Float64_t latitude;
+      Float64_t longitude;
+      Float32_t altitude;
+      truth_t truth;
+
+      truthAt((Float64_t)now, &truth);
+
+      if (da_get_sample_age_us(DA_SENSOR_INS, &age) == true)
+      {
+        Float64_t error = fabs((Float64_t)age - trueAge);
+        ageErrorMaxUs = (error > ageErrorMaxUs) ? error : ageErrorMaxUs;
+      }
+      else
+      {
+        ageUnknown++;
+      }
+      ageMinUs = (trueAge < ageMinUs) ? trueAge : ageMinUs;
+      ageMaxUs = (trueAge > ageMaxUs) ? trueAge : ageMaxUs;
+
+      TEST_CHECK(da_get_ins_il_euler_angles(&euler[0], &euler[1], &euler[2]) == true);
+      errorAdd(&attitudeRaw, attitudeError(euler, &truth));
+      TEST_CHECK(da_get_ins_il_predicted_euler_angles(&euler[0], &euler[1], &euler[2]) == true);
+      errorAdd(&attitudePredicted, attitudeError(euler, &truth));
+
+      TEST_CHECK(da_get_ins_il_position(&latitude, &longitude, &altitude) == true);
+      errorAdd(&positionRaw, positionError(latitude, longitude, altitude, &truth));
+      TEST_CHECK(da_get_ins_il_predicted_position(&latitude, &longitude, &altitude) == true);
+      errorAdd(&positionPredicted, positionError(latitude, longitude, altitude, &truth));
+
+      controlDone = d_TRUE;
+    }
+    ELSE_DO_NOTHING
+
+    host_TimerAdvance(1u);
+  }
+  consoleQuiet = d_FALSE;
+
+  (void)da_get_latency_hist(DA_SENSOR_INS, &hist);
+  for (Uint32_t bin = 0u; bin < LATENCY_HIST_BINS; bin++)
+  {
+    binTotal += hist.bins[bin];
+  }
+
+  printf("  %u frames, sample age at the control instant %.1f to %.1f ms, measured to within %.0f us\n",
+         framesSent, ageMinUs / 1000.0, ageMaxUs / 1000.0, ageErrorMaxUs);
+  printf("  attitude error: as received rms %.3f max %.3f deg, predicted rms %.4f max %.4f deg\n",
+         errorRms(&attitudeRaw), attitudeRaw.maximum, errorRms(&attitudePredicted), attitudePredicted.maximum);
+  printf("  position error: as received rms %.3f max %.3f m, predicted rms %.4f max %.4f m\n",
+         errorRms(&positionRaw), positionRaw.maximum, errorRms(&positionPredicted), positionPredicted.maximum);
+  printf("  decode latency: max %.0f us, histogram max %u us, 1 ms bins", decodeMaxUs, hist.max_us);
+  for (Uint32_t bin = 0u; bin < LATENCY_HIST_BINS; bin++)
+  {
+    printf(" %u", hist.bins[bin]);
+  }
+  printf("\n");
+
+  /* Every frame is decoded and timed */
+  TEST_CHECK_EQUAL(fifoOverruns, 0u);
+  TEST_CHECK_EQUAL(hist.samples, FRAMES);
+  TEST_CHECK_EQUAL(hist.untimed, 0u);
+  TEST_CHECK_EQUAL(binTotal, hist.samples);
+  TEST_CHECK_EQUAL(ageUnknown, 0u);
+
+  /* The age is measured to within a character time and the timer resolution */
+  TEST_CHECK(ageErrorMaxUs <= (CHARACTER_US + 2.0));
+  TEST_CHECK(fabs((Float64_t)hist.max_us - decodeMaxUs) <= (CHARACTER_US + 2.0));
+
+  /* The age covers the frame period, so the data as received is late by up to a frame */
+  TEST_CHECK((ageMaxUs - ageMinUs) > 8000.0);
+  TEST_CHECK(attitudeRaw.maximum > 0.5);
+  TEST_CHECK(positionRaw.maximum > 0.2);
+
+  /* Predicted, the error is left by the angular acceleration over the age and the quantisation of the data */
+  TEST_CHECK(errorRms(&attitudePredicted) < (errorRms(&attitudeRaw) / 20.0));
+  TEST_CHECK(attitudePredicted.maximum < 0.05);
+  TEST_CHECK(errorRms(&positionPredicted) < (errorRms(&positionRaw) / 10.0));
+  TEST_CHECK(positionPredicted.maximum < 0.05);
+}
+
+/* Data older than the prediction limit is returned as received */
+static void testStale(void)
+{
+  Float32_t raw[3];
+  Float32_t predicted[3];
+  Float64_t rawPosition[2];
+  Float64_t predictedPosition[2];
+  Float32_t rawAltitude;
+  Float32_t predictedAltitude;
+
+  host_TimerAdvance(20000u);
+  (void)da_get_ins_il_euler_angles(&raw[0], &raw[1], &raw[2]);
+  (void)da_get_ins_il_predicted_euler_angles(&predicted[0], &predicted[1], &predicted[2]);
+  TEST_CHECK(raw[0] != predicted[0]);
+
+  host_TimerAdvance(40000u);
+  (void)da_get_ins_il_predicted_euler_angles(&predicted[0], &predicted[1], &predicted[2]);
+  TEST_CHECK(memcmp(raw, predicted, sizeof(raw)) == 0);
+  (void)da_get_ins_il_position(&rawPosition[0], &rawPosition[1], &rawAltitude);
+  (void)da_get_ins_il_predicted_position(&predictedPosition[0], &predictedPosition[1], &predictedAltitude);
+  TEST_CHECK((rawPosition[0] == predictedPosition[0]) && (rawPosition[1] == predictedPosition[1]));
+  TEST_CHECK(rawAltitude == predictedAltitude);
+}
+
+int main(void)
+{
+  host_Reset();
+  host_RegisterSetModel(modelRead, modelWrite);
+
+  testReplay();
+  testStale();
+
+  TEST_CHECK_EQUAL(host_ErrorCount, 0u);
+
+  return TEST_RESULT();
+}
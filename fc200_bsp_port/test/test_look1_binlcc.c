@@ -0,0 +1,192 @@
+/*********************************************************************//**
+\file
+\brief
+  Module Title       : Cached-segment table lookup test
+
+  Abstract           : Checks that look1_binlcc gives results bit-identical
+                       to the generated look1_binlc it replaces, for tables
+                       of 2 to 256 breakpoints with even and uneven
+                       spacing, and inputs that jump across the table,
+                       follow a slow trajectory, sit on and next to the
+                       breakpoints or lie outside the table. The lookups
+                       per second of both are measured for a slow
+                       trajectory and for random inputs. The test is built
+                       in double and in single precision.
+*************************************************************************/
+
+/***** Includes *********************************************************/
+
+#include <math.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "soc/defines/d_common_types.h"
+#include "rtwtypes.h"
+#include "look1_binlc.h"
+#include "look1_binlcc.h"
+#include "test_common.h"
+
+/***** Constants ********************************************************/
+
+#define MAX_BREAKPOINTS  256u
+#define RANDOM_INPUTS    200000u
+#define TRAJECTORY_STEPS 200000u
+#define BENCH_LOOKUPS    5000000u
+
+/***** Variables ********************************************************/
+
+static const Uint32_t tableSizes[] = {2u, 3u, 4u, 5u, 8u, 16u, 64u, 256u};
+
+static real_T breakpoints[MAX_BREAKPOINTS];
+static real_T table[MAX_BREAKPOINTS];
+
+static Uint32_t randomState = 12345u;
+
+/* Lookups that differ from look1_binlc, and lookups made */
+static Uint32_t mismatches;
+static Uint32_t lookups;
+
+/* Results of the benchmark loops, kept so that they are not optimised out */
+static volatile real_T benchSink;
+
+/***** Function Definitions *********************************************/
+
+/* Uniform in [0, 1) from a fixed sequence */
+static Float64_t randomUnit(void)
+{
+  randomState = (randomState * 1664525u) + 1013904223u;
+
+  return (Float64_t)(randomState >> 8u) / 16777216.0;
+}
+
+/* Breakpoints from 0 to 40 m/s, evenly spaced or with random intervals */
+static void makeTable(const Uint32_t size, const Bool_t even)
+{
+  Float64_t position = 0.0;
+
+  for (Uint32_t i = 0u; i < size; i++)
+  {
+    breakpoints[i] = (even == d_TRUE) ? (real_T)((40.0 * (Float64_t)i) / (Float64_t)(size - 1u)) : (real_T)position;
+    table[i] = (real_T)((randomUnit() * 20.0) - 10.0);
+    position += 0.05 + (randomUnit() * 2.0);
+  }
+}
+
+/* Look up one input with both routines and compare the bits of the results */
+static void compare(const real_T u, look1_cache_T * const pCache, const Uint32_t maxIndex)
+{
+  real_T generated = look1_binlc(u, breakpoints, table, maxIndex);
+  real_T cached = look1_binlcc(u, breakpoints, table, pCache, maxIndex);
+
+  lookups++;
+  if (memcmp(&generated, &cached, sizeof(real_T)) != 0)
+  {
+    if (mismatches < 10u)
+    {
+      printf("mismatch at u = %.17g: %.17g != %.17g\n", (Float64_t)u, (Float64_t)generated, (Float64_t)cached);
+    }
+    mismatches++;
+  }
+}
+
+static void identical(const Uint32_t size, const Bool_t even)
+{
+  look1_cache_T cache;
+  Uint32_t maxIndex = size - 1u;
+  real_T low;
+  real_T high;
+
+  makeTable(size, even);
+  look1_binlcc_init(&cache, breakpoints, maxIndex);
+  /* Two breakpoints are always evenly spaced */
+  TEST_CHECK((cache.evenlySpaced != 0u) == ((even == d_TRUE) || (size == 2u)));
+  low = breakpoints[0];
+  high = breakpoints[maxIndex];
+
+  /* Random jumps over the table and beyond both ends */
+  for (Uint32_t i = 0u; i < RANDOM_INPUTS; i++)
+  {
+    compare((real_T)(((Float64_t)low - 5.0) + (randomUnit() * (((Float64_t)high - (Float64_t)low) + 10.0))), &cache,
+            maxIndex);
+  }
+
+  /* A slow trajectory up and down the table */
+  for (Uint32_t i = 0u; i < TRAJECTORY_STEPS; i++)
+  {
+    Float64_t phase = (Float64_t)i * (2.0 * M_PI / 20000.0);
+    compare((real_T)((Float64_t)low + (((Float64_t)high - (Float64_t)low) * (0.5 - (0.55 * cos(phase))))), &cache,
+            maxIndex);
+  }
+
+  /* On each breakpoint and the neighbouring representable values */
+  for (Uint32_t i = 0u; i <= maxIndex; i++)
+  {
+    compare(breakpoints[i], &cache, maxIndex);
+    compare(nextafter(breakpoints[i], (real_T)-1.0e30), &cache, maxIndex);
+    compare(nextafter(breakpoints[i], (real_T)1.0e30), &cache, maxIndex);
+    compare(breakpoints[maxIndex - i], &cache, maxIndex);
+  }
+}
+
+/* Lookups per second of both routines over one sequence of inputs */
+static void benchmark(const Uint32_t size, const Bool_t slow)
+{
+  static real_T inputs[BENCH_LOOKUPS];
+  look1_cache_T cache;
+  Uint32_t maxIndex = size - 1u;
+  real_T sum = (real_T)0.0;
+
+  makeTable(size, d_FALSE);
+  look1_binlcc_init(&cache, breakpoints, maxIndex);
+  for (Uint32_t i = 0u; i < BENCH_LOOKUPS; i++)
+  {
+    Float64_t position = (slow == d_TRUE) ? (0.5 - (0.5 * cos((Float64_t)i * (2.0 * M_PI / 100000.0)))) : randomUnit();
+    inputs[i] = (real_T)((Float64_t)breakpoints[maxIndex] * position);
+  }
+
+  Float64_t start = testSeconds();
+  for (Uint32_t i = 0u; i < BENCH_LOOKUPS; i++)
+  {
+    sum += look1_binlc(inputs[i], breakpoints, table, maxIndex);
+  }
+  Float64_t binaryRate = BENCH_LOOKUPS / (testSeconds() - start);
+
+  start = testSeconds();
+  for (Uint32_t i = 0u; i < BENCH_LOOKUPS; i++)
+  {
+    sum += look1_binlcc(inputs[i], breakpoints, table, &cache, maxIndex);
+  }
+  Float64_t cachedRate = BENCH_LOOKUPS / (testSeconds() - start);
+  benchSink = sum;
+
+  printf("  %3u breakpoints, %-10s %12.0f %12.0f\n", size, (slow == d_TRUE) ? "trajectory" : "random", binaryRate,
+         cachedRate);
+
+  /* On a slow trajectory over a large table the cached interval saves the search */
+  if ((slow == d_TRUE) && (size >= 64u))
+  {
+    TEST_CHECK(cachedRate > binaryRate);
+  }
+}
+
+int main(void)
+{
+  for (Uint32_t s = 0u; s < (sizeof(tableSizes) / sizeof(tableSizes[0])); s++)
+  {
+    identical(tableSizes[s], d_TRUE);
+    identical(tableSizes[s], d_FALSE);
+  }
+  printf("%s precision: %u lookups, %u differ from look1_binlc\n",
+         (sizeof(real_T) == sizeof(Float32_t)) ? "single" : "double", lookups, mismatches);
+  TEST_CHECK_EQUAL(mismatches, 0u);
+
+  printf("lookups per second          look1_binlc look1_binlcc\n");
+  benchmark(4u, d_TRUE);
+  benchmark(4u, d_FALSE);
+  benchmark(64u, d_TRUE);
+  benchmark(64u, d_FALSE);
+  benchmark(256u, d_TRUE);
+  benchmark(256u, d_FALSE);
+
+  return TEST_RESULT();
+}
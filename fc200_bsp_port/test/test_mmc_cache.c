@@ -0,0 +1,259 @@
+/*********************************************************************//**
+\file
+\brief
+  Module Title       : MMC sector cache test
+
+  Abstract           : Runs the MMC interface against the SD controller
+                       and card model. Single sector writes are checked to
+                       stay in the cache until a flush or an eviction,
+                       adjacent modified sectors to reach the card in one
+                       multi-block write, and multi-sector reads and writes
+                       to see the cached data. The time the caller is
+                       blocked per logged event is measured for the event
+                       log pattern, one sector rewritten as events are
+                       added to it, with a flush after every event as a
+                       write-through cache would make and with a flush at
+                       each commit of the log.
+*************************************************************************/
+
+/***** Includes *********************************************************/
+
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "soc/defines/d_common_types.h"
+#include "sru/mmc/d_mmc_interface.h"
+#include "host_stubs.h"
+#include "sd_model.h"
+#include "test_common.h"
+
+/***** Constants ********************************************************/
+
+#define SECTOR_SIZE        SD_MODEL_SECTOR_SIZE
+
+/* Event log pattern: events added to the current sector, the log committed every few events */
+#define EVENT_SIZE         64u
+#define EVENTS_PER_SECTOR  (SECTOR_SIZE / EVENT_SIZE)
+#define EVENT_COUNT        512u
+#define EVENTS_PER_COMMIT  32u
+#define LOG_FIRST_SECTOR   1024u
+
+/***** Variables ********************************************************/
+
+static __attribute__((aligned(64))) Uint8_t sectorData[SECTOR_SIZE];
+static __attribute__((aligned(64))) Uint8_t multiData[16u * SECTOR_SIZE];
+
+/***** Function Definitions *********************************************/
+
+static void fillPattern(Uint8_t * const pBuffer, const Uint32_t length, const Uint32_t seed)
+{
+  for (Uint32_t i = 0u; i < length; i++)
+  {
+    pBuffer[i] = (Uint8_t)((i * 7u) + (i >> 9u) + seed);
+  }
+}
+
+/* Check a sector of the card against the pattern it was written with */
+static Bool_t cardHolds(const Uint32_t sector, const Uint32_t seed)
+{
+  Uint8_t expected[SECTOR_SIZE];
+
+  fillPattern(expected, SECTOR_SIZE, seed);
+
+  return (memcmp(sdModel_Sector(sector), expected, SECTOR_SIZE) == 0) ? d_TRUE : d_FALSE;
+}
+
+static d_Status_t writeSector(const Uint32_t sector, const Uint32_t seed)
+{
+  fillPattern(sectorData, SECTOR_SIZE, seed);
+
+  return d_MMC_SectorWrite(sector, 1u, sectorData);
+}
+
+/* Log a number of events with a flush every commitEvents, returns the mean time blocked per event */
+static Uint64_t eventLog(const Uint32_t commitEvents)
+{
+  static __attribute__((aligned(64))) Uint8_t currentSector[SECTOR_SIZE];
+  Uint64_t blocked = 0u;
+  Bool_t ok = d_TRUE;
+
+  memset(currentSector, 0, sizeof(currentSector));
+  for (Uint32_t event = 0u; event < EVENT_COUNT; event++)
+  {
+    Uint32_t sector = LOG_FIRST_SECTOR + (event / EVENTS_PER_SECTOR);
+    Uint64_t start;
+
+    memset(&currentSector[(event % EVENTS_PER_SECTOR) * EVENT_SIZE], (int)(event + 1u), EVENT_SIZE);
+
+    start = host_TimerMicroseconds();
+    ok = ((d_MMC_SectorWrite(sector, 1u, currentSector) == d_STATUS_SUCCESS) && (ok == d_TRUE)) ? d_TRUE : d_FALSE;
+    if (((event + 1u) % commitEvents) == 0u)
+    {
+      ok = ((d_MMC_Flush() == d_STATUS_SUCCESS) && (ok == d_TRUE)) ? d_TRUE : d_FALSE;
+    }
+    ELSE_DO_NOTHING
+    blocked += host_TimerMicroseconds() - start;
+
+    if (((event + 1u) % EVENTS_PER_SECTOR) == 0u)
+    {
+      memset(currentSector, 0, sizeof(currentSector));
+    }
+    ELSE_DO_NOTHING
+  }
+  TEST_CHECK(ok == d_TRUE);
+
+  /* Every event is on the card */
+  for (Uint32_t event = 0u; event < EVENT_COUNT; event++)
+  {
+    const Uint8_t * pEvent = sdModel_Sector(LOG_FIRST_SECTOR + (event / EVENTS_PER_SECTOR)) +
+                             ((event % EVENTS_PER_SECTOR) * EVENT_SIZE);
+    TEST_CHECK_EQUAL(pEvent[0], (Uint8_t)(event + 1u));
+    TEST_CHECK_EQUAL(pEvent[EVENT_SIZE - 1u], (Uint8_t)(event + 1u));
+  }
+
+  return blocked / EVENT_COUNT;
+}
+
+int main(void)
+{
+  d_MMC_CacheStats_t stats;
+  d_MMC_Instance_t * pInstance = NULL;
+  Uint32_t sectors = 0u;
+
+  host_Reset();
+  sdModel_Reset();
+
+  TEST_CHECK_EQUAL(d_MMC_Initialise(&pInstance), d_STATUS_SUCCESS);
+  TEST_CHECK(pInstance != NULL);
+  TEST_CHECK_EQUAL(d_MMC_SectorCount(&sectors), d_STATUS_SUCCESS);
+  TEST_CHECK_EQUAL(sectors, SD_MODEL_SECTORS);
+
+  /* A single sector write stays in the cache and is read back from it */
+  TEST_CHECK_EQUAL(writeSector(10u, 1u), d_STATUS_SUCCESS);
+  TEST_CHECK_EQUAL(sdModel_Stats.writeCommands, 0u);
+  TEST_CHECK(cardHolds(10u, 0u) == d_FALSE);
+  memset(sectorData, 0, sizeof(sectorData));
+  TEST_CHECK_EQUAL(d_MMC_SectorRead(10u, 1u, sectorData), d_STATUS_SUCCESS);
+  TEST_CHECK_EQUAL(sdModel_Stats.readCommands, 0u);
+  TEST_CHECK_EQUAL(sectorData[5], (Uint8_t)(35u + 1u));
+  (void)d_MMC_GetCacheStats(&stats);
+  TEST_CHECK_EQUAL(stats.writeMisses, 1u);
+  TEST_CHECK_EQUAL(stats.readHits, 1u);
+
+  /* Rewriting the sector is a hit, the flush writes it once */
+  TEST_CHECK_EQUAL(writeSector(10u, 2u), d_STATUS_SUCCESS);
+  TEST_CHECK_EQUAL(d_MMC_Flush(), d_STATUS_SUCCESS);
+  TEST_CHECK_EQUAL(sdModel_Stats.writeCommands, 1u);
+  TEST_CHECK(cardHolds(10u, 2u) == d_TRUE);
+  TEST_CHECK_EQUAL(d_MMC_Flush(), d_STATUS_SUCCESS);
+  TEST_CHECK_EQUAL(sdModel_Stats.writeCommands, 1u);
+  (void)d_MMC_GetCacheStats(&stats);
+  TEST_CHECK_EQUAL(stats.writeHits, 1u);
+  TEST_CHECK_EQUAL(stats.flushes, 2u);
+
+  /* Adjacent sectors written in any order reach the card in one multi-block write */
+  host_Reset();
+  sdModel_Reset();
+  static const Uint32_t order[8] = { 103u, 100u, 107u, 101u, 106u, 102u, 105u, 104u };
+  for (Uint32_t i = 0u; i < 8u; i++)
+  {
+    TEST_CHECK_EQUAL(writeSector(order[i], order[i]), d_STATUS_SUCCESS);
+  }
+  TEST_CHECK_EQUAL(sdModel_Stats.writeCommands, 0u);
+  TEST_CHECK_EQUAL(d_MMC_Flush(), d_STATUS_SUCCESS);
+  TEST_CHECK_EQUAL(sdModel_Stats.writeCommands, 1u);
+  TEST_CHECK_EQUAL(sdModel_Stats.maxWriteSectors, d_MMC_CACHE_COALESCE);
+  for (Uint32_t sector = 100u; sector < 108u; sector++)
+  {
+    TEST_CHECK(cardHolds(sector, sector) == d_TRUE);
+  }
+
+  /* A longer run is split at the coalescing limit */
+  for (Uint32_t sector = 200u; sector < 210u; sector++)
+  {
+    TEST_CHECK_EQUAL(writeSector(sector, sector), d_STATUS_SUCCESS);
+  }
+  TEST_CHECK_EQUAL(d_MMC_Flush(), d_STATUS_SUCCESS);
+  TEST_CHECK_EQUAL(sdModel_Stats.writeCommands, 3u);
+  TEST_CHECK_EQUAL(sdModel_Stats.sectorsWritten, 18u);
+  TEST_CHECK(cardHolds(200u, 200u) == d_TRUE);
+  TEST_CHECK(cardHolds(209u, 209u) == d_TRUE);
+  TEST_CHECK_EQUAL(sdModel_Stats.protocolErrors, 0u);
+
+  /* A full set of modified sectors evicts its least recently used one */
+  host_Reset();
+  sdModel_Reset();
+  (void)d_MMC_GetCacheStats(&stats);
+  Uint32_t evictions = stats.evictions;
+  for (Uint32_t way = 0u; way <= d_MMC_CACHE_WAYS; way++)
+  {
+    Uint32_t sector = 3000u + (way * d_MMC_CACHE_SETS);
+    TEST_CHECK_EQUAL(writeSector(sector, sector), d_STATUS_SUCCESS);
+  }
+  (void)d_MMC_GetCacheStats(&stats);
+  TEST_CHECK_EQUAL(stats.evictions, evictions + 1u);
+  TEST_CHECK_EQUAL(sdModel_Stats.writeCommands, 1u);
+  TEST_CHECK(cardHolds(3000u, 3000u) == d_TRUE);
+  TEST_CHECK(cardHolds(3000u + d_MMC_CACHE_SETS, 3000u + d_MMC_CACHE_SETS) == d_FALSE);
+  TEST_CHECK_EQUAL(d_MMC_Flush(), d_STATUS_SUCCESS);
+  for (Uint32_t way = 0u; way <= d_MMC_CACHE_WAYS; way++)
+  {
+    Uint32_t sector = 3000u + (way * d_MMC_CACHE_SETS);
+    TEST_CHECK(cardHolds(sector, sector) == d_TRUE);
+  }
+
+  /* A multi-sector read sees a sector modified in the cache */
+  host_Reset();
+  sdModel_Reset();
+  for (Uint32_t sector = 400u; sector < 410u; sector++)
+  {
+    fillPattern(sdModel_Sector(sector), SECTOR_SIZE, sector);
+  }
+  TEST_CHECK_EQUAL(writeSector(405u, 77u), d_STATUS_SUCCESS);
+  TEST_CHECK_EQUAL(d_MMC_SectorRead(400u, 10u, multiData), d_STATUS_SUCCESS);
+  TEST_CHECK_EQUAL(sdModel_Stats.readCommands, 1u);
+  fillPattern(sectorData, SECTOR_SIZE, 77u);
+  TEST_CHECK(memcmp(&multiData[5u * SECTOR_SIZE], sectorData, SECTOR_SIZE) == 0);
+  fillPattern(sectorData, SECTOR_SIZE, 404u);
+  TEST_CHECK(memcmp(&multiData[4u * SECTOR_SIZE], sectorData, SECTOR_SIZE) == 0);
+  TEST_CHECK(cardHolds(405u, 405u) == d_TRUE);
+
+  /* A multi-sector write replaces the cached copy, which is not written back over it */
+  fillPattern(multiData, 4u * SECTOR_SIZE, 99u);
+  TEST_CHECK_EQUAL(d_MMC_SectorWrite(403u, 4u, multiData), d_STATUS_SUCCESS);
+  TEST_CHECK_EQUAL(sdModel_Stats.writeCommands, 1u);
+  TEST_CHECK_EQUAL(d_MMC_Flush(), d_STATUS_SUCCESS);
+  TEST_CHECK_EQUAL(sdModel_Stats.writeCommands, 1u);
+  TEST_CHECK(memcmp(sdModel_Sector(405u), &multiData[2u * SECTOR_SIZE], SECTOR_SIZE) == 0);
+  TEST_CHECK_EQUAL(d_MMC_SectorRead(405u, 1u, sectorData), d_STATUS_SUCCESS);
+  TEST_CHECK(memcmp(sectorData, &multiData[2u * SECTOR_SIZE], SECTOR_SIZE) == 0);
+
+  /* The built in test writes the card and reads it back */
+  TEST_CHECK_EQUAL(d_MMC_Bit(500u), d_STATUS_SUCCESS);
+  TEST_CHECK_EQUAL(sdModel_Stats.writeCommands, 3u);
+
+  /* Event log: a flush per event, as a write-through cache, against a flush per commit */
+  host_Reset();
+  sdModel_Reset();
+  Uint64_t writeThrough = eventLog(1u);
+  Uint32_t writeThroughCommands = sdModel_Stats.writeCommands;
+  sdModel_Reset();
+  Uint64_t writeBack = eventLog(EVENTS_PER_COMMIT);
+  Uint32_t writeBackCommands = sdModel_Stats.writeCommands;
+
+  printf("event log, %u events of %u bytes\n", EVENT_COUNT, EVENT_SIZE);
+  printf("  flush per event:      %5u write commands, %5u us blocked per event\n",
+         writeThroughCommands, (Uint32_t)writeThrough);
+  printf("  flush per %2u events:  %5u write commands, %5u us blocked per event\n",
+         EVENTS_PER_COMMIT, writeBackCommands, (Uint32_t)writeBack);
+  TEST_CHECK_EQUAL(writeThroughCommands, EVENT_COUNT);
+  TEST_CHECK_EQUAL(writeBackCommands, EVENT_COUNT / EVENTS_PER_COMMIT);
+  TEST_CHECK((writeBack * 20u) < writeThrough);
+  TEST_CHECK_EQUAL(sdModel_Stats.protocolErrors, 0u);
+
+  TEST_CHECK_EQUAL(host_ErrorCount, 0u);
+  TEST_CHECK_EQUAL(host_CriticalDepth, 0);
+
+  return TEST_RESULT();
+}
@@ -0,0 +1,298 @@
+/*********************************************************************//**
+\file
+\brief
+  Module Title       : MMC request queue test
+
+  Abstract           : Runs the queued MMC transfers against the SD
+                       controller and card model. A main loop writing a
+                       block every frame is timed with the synchronous
+                       writes, which wait for the card to finish
+                       programming, and with queued writes serviced once
+                       per frame. Queue order, scatter-gather, a full
+                       queue, cancellation, card errors and timeouts are
+                       then checked, and a write back of the sector cache
+                       that fails is checked to leave its sectors cached
+                       and modified.
+*************************************************************************/
+
+/***** Includes *********************************************************/
+
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "soc/defines/d_common_types.h"
+#include "sru/mmc/d_mmc_interface.h"
+#include "host_stubs.h"
+#include "sd_model.h"
+#include "test_common.h"
+
+/***** Constants ********************************************************/
+
+#define SECTOR_SIZE     SD_MODEL_SECTOR_SIZE
+
+/* Main loop: a block of sectors written every frame */
+#define FRAME_TIME      5000u
+#define FRAME_COUNT     100u
+#define BLOCK_SECTORS   8u
+#define LOOP_SECTOR     2048u
+
+#define REQUESTS        (d_MMC_QUEUE_DEPTH + 1u)
+
+/***** Type Definitions *************************************************/
+
+typedef struct
+{
+  Uint32_t completions;
+  Uint32_t tag;
+  d_Status_t status;
+  Uint32_t order;
+} Request_t;
+
+/***** Variables ********************************************************/
+
+static __attribute__((aligned(64))) Uint8_t blockData[REQUESTS][BLOCK_SECTORS * SECTOR_SIZE];
+static __attribute__((aligned(64))) Uint8_t sectorData[SECTOR_SIZE];
+
+static Request_t request[REQUESTS];
+static Uint32_t completionCount;
+
+/***** Function Definitions *********************************************/
+
+static void fillPattern(Uint8_t * const pBuffer, const Uint32_t length, const Uint32_t seed)
+{
+  for (Uint32_t i = 0u; i < length; i++)
+  {
+    pBuffer[i] = (Uint8_t)((i * 13u) + (i >> 9u) + seed);
+  }
+}
+
+static void requestCallback(const Uint32_t tag, const d_Status_t status, void * const pContext)
+{
+  Request_t * pRequest = (Request_t *)pContext;
+
+  pRequest->completions++;
+  pRequest->tag = tag;
+  pRequest->status = status;
+  pRequest->order = completionCount++;
+}
+
+static void requestReset(void)
+{
+  memset(request, 0, sizeof(request));
+  completionCount = 0u;
+}
+
+/* Run the main loop, returns the longest time a frame spent in the MMC interface */
+static Uint64_t mainLoop(const Bool_t queued)
+{
+  Uint64_t worst = 0u;
+
+  for (Uint32_t frame = 0u; frame < FRAME_COUNT; frame++)
+  {
+    Uint8_t * pBlock = blockData[frame % 2u];
+    Uint32_t sector = LOOP_SECTOR + (frame * BLOCK_SECTORS);
+    Uint64_t start = host_TimerMicroseconds();
+
+    if (queued == d_TRUE)
+    {
+      /* The buffer written two frames ago has been released by its callback */
+      (void)d_MMC_QueuePoll();
+      TEST_CHECK((frame < 2u) || (request[frame % 2u].completions == 1u));
+      request[frame % 2u].completions = 0u;
+      fillPattern(pBlock, BLOCK_SECTORS * SECTOR_SIZE, frame);
+      TEST_CHECK_EQUAL(d_MMC_WriteAsync(sector, BLOCK_SECTORS, pBlock, requestCallback, &request[frame % 2u], NULL),
+                       d_STATUS_SUCCESS);
+    }
+    else
+    {
+      fillPattern(pBlock, BLOCK_SECTORS * SECTOR_SIZE, frame);
+      TEST_CHECK_EQUAL(d_MMC_SectorWrite(sector, BLOCK_SECTORS, pBlock), d_STATUS_SUCCESS);
+    }
+
+    Uint64_t spent = host_TimerMicroseconds() - start;
+    worst = (spent > worst) ? spent : worst;
+
+    /* The rest of the frame */
+    if (spent < FRAME_TIME)
+    {
+      host_TimerAdvance((Uint32_t)(FRAME_TIME - spent));
+    }
+    ELSE_DO_NOTHING
+  }
+
+  while (d_MMC_QueuePoll() != 0u)
+  {
+  }
+
+  /* Every block is on the card */
+  for (Uint32_t frame = 0u; frame < FRAME_COUNT; frame++)
+  {
+    fillPattern(blockData[2], BLOCK_SECTORS * SECTOR_SIZE, frame);
+    for (Uint32_t i = 0u; i < BLOCK_SECTORS; i++)
+    {
+      TEST_CHECK(memcmp(sdModel_Sector(LOOP_SECTOR + (frame * BLOCK_SECTORS) + i), &blockData[2][i * SECTOR_SIZE],
+                        SECTOR_SIZE) == 0);
+    }
+  }
+
+  return worst;
+}
+
+int main(void)
+{
+  d_MMC_QueueStats_t queueStats;
+  d_MMC_CacheStats_t cacheStats;
+  d_MMC_SgEntry_t sg[3];
+  Uint32_t tag[REQUESTS];
+
+  host_Reset();
+  sdModel_Reset();
+  TEST_CHECK_EQUAL(d_MMC_Initialise(NULL), d_STATUS_SUCCESS);
+
+  /* Main loop stall: the synchronous write waits for the card, the queued one does not */
+  requestReset();
+  Uint64_t syncWorst = mainLoop(d_FALSE);
+  sdModel_Reset();
+  requestReset();
+  Uint64_t queuedWorst = mainLoop(d_TRUE);
+  printf("main loop writing %u sectors per %u us frame, longest time in the MMC interface per frame\n",
+         BLOCK_SECTORS, FRAME_TIME);
+  printf("  synchronous:  %5u us\n", (Uint32_t)syncWorst);
+  printf("  queued:       %5u us\n", (Uint32_t)queuedWorst);
+  TEST_CHECK(syncWorst > 2000u);
+  TEST_CHECK(queuedWorst < 50u);
+  TEST_CHECK_EQUAL(sdModel_Stats.protocolErrors, 0u);
+
+  /* Requests complete in order, a full queue refuses the next one */
+  sdModel_Reset();
+  requestReset();
+  for (Uint32_t i = 0u; i < REQUESTS; i++)
+  {
+    fillPattern(blockData[i], BLOCK_SECTORS * SECTOR_SIZE, 100u + i);
+    d_Status_t status = d_MMC_WriteAsync(i * BLOCK_SECTORS, BLOCK_SECTORS, blockData[i], requestCallback, &request[i], &tag[i]);
+    TEST_CHECK_EQUAL(status, (i < d_MMC_QUEUE_DEPTH) ? d_STATUS_SUCCESS : d_STATUS_BUFFER_FULL);
+  }
+  while (d_MMC_QueuePoll() != 0u)
+  {
+  }
+  for (Uint32_t i = 0u; i < d_MMC_QUEUE_DEPTH; i++)
+  {
+    TEST_CHECK_EQUAL(request[i].completions, 1u);
+    TEST_CHECK_EQUAL(request[i].status, d_STATUS_SUCCESS);
+    TEST_CHECK_EQUAL(request[i].tag, tag[i]);
+    TEST_CHECK_EQUAL(request[i].order, i);
+    TEST_CHECK(memcmp(sdModel_Sector(i * BLOCK_SECTORS), blockData[i], SECTOR_SIZE) == 0);
+  }
+  TEST_CHECK_EQUAL(request[d_MMC_QUEUE_DEPTH].completions, 0u);
+  (void)d_MMC_GetQueueStats(&queueStats);
+  TEST_CHECK_EQUAL(queueStats.maxOutstanding, d_MMC_QUEUE_DEPTH);
+
+  /* A scatter-gather read fills each buffer with its own sectors */
+  requestReset();
+  memset(blockData, 0, sizeof(blockData));
+  sg[0].pBuffer = blockData[0];
+  sg[0].length = 2u * SECTOR_SIZE;
+  sg[1].pBuffer = blockData[1];
+  sg[1].length = 5u * SECTOR_SIZE;
+  sg[2].pBuffer = blockData[2];
+  sg[2].length = SECTOR_SIZE;
+  TEST_CHECK_EQUAL(d_MMC_SubmitSg(BLOCK_SECTORS, sg, 3u, d_FALSE, requestCallback, &request[0], NULL), d_STATUS_SUCCESS);
+  while (d_MMC_QueuePoll() != 0u)
+  {
+  }
+  TEST_CHECK_EQUAL(request[0].status, d_STATUS_SUCCESS);
+  TEST_CHECK(memcmp(blockData[0], sdModel_Sector(BLOCK_SECTORS), SECTOR_SIZE) == 0);
+  TEST_CHECK(memcmp(blockData[1], sdModel_Sector(BLOCK_SECTORS + 2u), SECTOR_SIZE) == 0);
+  TEST_CHECK(memcmp(&blockData[1][4u * SECTOR_SIZE], sdModel_Sector(BLOCK_SECTORS + 6u), SECTOR_SIZE) == 0);
+  TEST_CHECK(memcmp(blockData[2], sdModel_Sector(BLOCK_SECTORS + 7u), SECTOR_SIZE) == 0);
+
+  /* Cancelling the request in progress stops the card, a pending one never starts */
+  sdModel_Reset();
+  requestReset();
+  fillPattern(blockData[0], BLOCK_SECTORS * SECTOR_SIZE, 1u);
+  TEST_CHECK_EQUAL(d_MMC_WriteAsync(100u, BLOCK_SECTORS, blockData[0], requestCallback, &request[0], &tag[0]), d_STATUS_SUCCESS);
+  TEST_CHECK_EQUAL(d_MMC_WriteAsync(200u, BLOCK_SECTORS, blockData[0], requestCallback, &request[1], &tag[1]), d_STATUS_SUCCESS);
+  TEST_CHECK_EQUAL(d_MMC_WriteAsync(300u, BLOCK_SECTORS, blockData[0], requestCallback, &request[2], &tag[2]), d_STATUS_SUCCESS);
+  TEST_CHECK_EQUAL(d_MMC_Cancel(tag[1]), d_STATUS_SUCCESS);
+  TEST_CHECK_EQUAL(request[1].completions, 1u);
+  TEST_CHECK_EQUAL(request[1].status, d_STATUS_FAILURE);
+  TEST_CHECK_EQUAL(d_MMC_Cancel(tag[0]), d_STATUS_SUCCESS);
+  TEST_CHECK_EQUAL(request[0].status, d_STATUS_FAILURE);
+  TEST_CHECK_EQUAL(sdModel_Stats.stopCommands, 1u);
+  TEST_CHECK_EQUAL(sdModel_Stats.lineResets, 1u);
+  TEST_CHECK(sdModel_Busy() == d_FALSE);
+  TEST_CHECK_EQUAL(d_MMC_Cancel(tag[0]), d_STATUS_INVALID_PARAMETER);
+  while (d_MMC_QueuePoll() != 0u)
+  {
+  }
+  TEST_CHECK_EQUAL(request[0].completions, 1u);
+  TEST_CHECK_EQUAL(request[1].completions, 1u);
+  TEST_CHECK_EQUAL(request[2].status, d_STATUS_SUCCESS);
+  TEST_CHECK_EQUAL(sdModel_Stats.writeCommands, 2u);
+  TEST_CHECK(memcmp(sdModel_Sector(200u), blockData[0], SECTOR_SIZE) != 0);
+  TEST_CHECK(memcmp(sdModel_Sector(300u), blockData[0], SECTOR_SIZE) == 0);
+
+  /* A card error fails the request, the next one goes ahead */
+  requestReset();
+  host_ErrorCount = 0u;
+  sdModel_FailNext();
+  TEST_CHECK_EQUAL(d_MMC_WriteAsync(400u, 1u, blockData[0], requestCallback, &request[0], NULL), d_STATUS_SUCCESS);
+  TEST_CHECK_EQUAL(d_MMC_WriteAsync(401u, 1u, blockData[0], requestCallback, &request[1], NULL), d_STATUS_SUCCESS);
+  while (d_MMC_QueuePoll() != 0u)
+  {
+  }
+  TEST_CHECK_EQUAL(request[0].status, d_STATUS_DEVICE_ERROR);
+  TEST_CHECK_EQUAL(request[1].status, d_STATUS_SUCCESS);
+  TEST_CHECK_EQUAL(host_ErrorCount, 1u);
+
+  /* A card that never finishes is timed out */
+  requestReset();
+  sdModel_HangNext();
+  Uint64_t start = host_TimerMicroseconds();
+  TEST_CHECK_EQUAL(d_MMC_WriteAsync(500u, 1u, blockData[0], requestCallback, &request[0], NULL), d_STATUS_SUCCESS);
+  while (d_MMC_QueuePoll() != 0u)
+  {
+  }
+  TEST_CHECK_EQUAL(request[0].status, d_STATUS_TIMEOUT);
+  TEST_CHECK((host_TimerMicroseconds() - start) > (d_MMC_REQUEST_TIMEOUT_MS * 1000u));
+  TEST_CHECK((host_TimerMicroseconds() - start) < ((d_MMC_REQUEST_TIMEOUT_MS + 10u) * 1000u));
+  TEST_CHECK(sdModel_Busy() == d_FALSE);
+  (void)d_MMC_GetQueueStats(&queueStats);
+  TEST_CHECK_EQUAL(queueStats.timeouts, 1u);
+  TEST_CHECK_EQUAL(queueStats.errors, 1u);
+  TEST_CHECK_EQUAL(queueStats.cancelled, 2u);
+
+  /* A failed write back leaves the sector cached and modified, the next flush writes it */
+  sdModel_Reset();
+  (void)d_MMC_GetCacheStats(&cacheStats);
+  Uint32_t readHits = cacheStats.readHits;
+  fillPattern(sectorData, SECTOR_SIZE, 42u);
+  TEST_CHECK_EQUAL(d_MMC_SectorWrite(600u, 1u, sectorData), d_STATUS_SUCCESS);
+  sdModel_FailNext();
+  TEST_CHECK_EQUAL(d_MMC_Flush(), d_STATUS_FAILURE);
+  TEST_CHECK_EQUAL(sdModel_Stats.sectorsWritten, 0u);
+  memset(sectorData, 0, sizeof(sectorData));
+  TEST_CHECK_EQUAL(d_MMC_SectorRead(600u, 1u, sectorData), d_STATUS_SUCCESS);
+  TEST_CHECK_EQUAL(sdModel_Stats.readCommands, 0u);
+  TEST_CHECK_EQUAL(sectorData[1], (Uint8_t)(13u + 42u));
+  TEST_CHECK_EQUAL(d_MMC_Flush(), d_STATUS_SUCCESS);
+  TEST_CHECK_EQUAL(sdModel_Stats.writeCommands, 2u);
+  TEST_CHECK_EQUAL(sdModel_Stats.sectorsWritten, 1u);
+  TEST_CHECK_EQUAL(sdModel_Sector(600u)[1], (Uint8_t)(13u + 42u));
+
+  /* The sector written back stays in the cache, clean */
+  memset(sectorData, 0, sizeof(sectorData));
+  TEST_CHECK_EQUAL(d_MMC_SectorRead(600u, 1u, sectorData), d_STATUS_SUCCESS);
+  TEST_CHECK_EQUAL(sdModel_Stats.readCommands, 0u);
+  TEST_CHECK_EQUAL(sectorData[1], (Uint8_t)(13u + 42u));
+  TEST_CHECK_EQUAL(d_MMC_Flush(), d_STATUS_SUCCESS);
+  TEST_CHECK_EQUAL(sdModel_Stats.writeCommands, 2u);
+  (void)d_MMC_GetCacheStats(&cacheStats);
+  TEST_CHECK_EQUAL(cacheStats.readHits, readHits + 2u);
+
+  TEST_CHECK_EQUAL(sdModel_Stats.protocolErrors, 0u);
+  TEST_CHECK_EQUAL(host_CriticalDepth, 0);
+
+  return TEST_RESULT();
+}
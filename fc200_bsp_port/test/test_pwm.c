@@ -0,0 +1,472 @@
+/*********************************************************************//**
+\file
+\brief
+  Module Title       : PWM output queue test
+
+  Abstract           : Runs the PWM driver and the PWM service of the
+                       flight software against a register model of the
+                       IOC pulse outputs. The channels are given
+                       different definitions, in normalised units, in
+                       degrees and in microseconds, so the scaling of the
+                       queued outputs is checked against the immediate
+                       outputs and against the pulse width given to the
+                       service for every channel. Each register write
+                       takes time on the AXI bus to the IOC, interrupts
+                       preempt the CPU when they are enabled, and the IOC
+                       takes the output registers at the start of each
+                       period of the 200 Hz pulse train. A period that
+                       starts with some channels of a frame updated and
+                       others not is a torn update; it is counted for
+                       outputs committed once per frame and for the same
+                       outputs written one at a time through the frame.
+                       Change suppression, an offline IOC and the
+                       parameter checks are also tested.
+*************************************************************************/
+
+/***** Includes *********************************************************/
+
+#include <stdarg.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "sru/pwm/d_pwm.h"
+#include "sru/pwm/d_pwm_cfg.h"
+#include "sru/fcu/d_fcu.h"
+#include "pwm_interface.h"
+#include "host_stubs.h"
+#include "test_common.h"
+
+/***** Constants ********************************************************/
+
+#define INPUT_BASE_A       0x00100000u
+#define OUTPUT_BASE_A      0x00110000u
+#define INPUT_BASE_B       0x00200000u
+#define OUTPUT_BASE_B      0x00210000u
+#define ENABLE_OFFSET      0x20u
+
+#define CHANNELS           8u
+
+/* Register values of the minimum and maximum outputs */
+#define REG_MINIMUM        177u
+#define REG_MAXIMUM        1824u
+
+/* Output period of the pusher and main loop frame */
+#define PERIOD_US          5000u
+#define FRAME_US           10000u
+
+/* Time of a register write across the AXI bus to the IOC */
+#define WRITE_US           2u
+
+/* An interrupt preempts the CPU for this long, once in this many microseconds on average */
+#define INTERRUPT_US       150u
+#define INTERRUPT_EVERY_US 400u
+
+#define FRAMES             2000u
+
+/***** Type Definitions *************************************************/
+
+/***** Variables ********************************************************/
+
+/* The channel definitions of the test replace the weak default table */
+const d_PWM_AddressDefinition_t d_PWM_AddressDefinition[] =
+{
+  { INPUT_BASE_A, OUTPUT_BASE_A },
+  { INPUT_BASE_B, OUTPUT_BASE_B }
+};
+
+const d_PWM_Definition_t d_PWM_Definition[] =
+{
+  { -1.0f, 1.0f, 0.0f },
+  { 0.0f, 1.0f, 0.0f },
+  { -30.0f, 30.0f, 0.0f },
+  { 1000.0f, 2000.0f, 1000.0f },
+  { -1.0f, 1.0f, -1.0f },
+  { 0.1f, 0.7f, 0.4f },
+  { -250.0f, 250.0f, 0.0f },
+  { 0.0f, 100.0f, 50.0f }
+};
+
+d_PWM_COUNT_IOC;
+d_PWM_COUNT_CHANNEL;
+
+static Uint32_t outputRegisters[d_FCU_IOC_COUNT][d_PWM_MAX_CHANNELS];
+static Uint32_t enableRegisters[d_FCU_IOC_COUNT];
+static Uint32_t registerWrites;
+static Uint32_t writesOutsideSection;
+static Bool_t iocOnline[d_FCU_IOC_COUNT] = { d_TRUE, d_TRUE };
+
+/* Output registers taken by the IOC at the start of the current period */
+static Uint32_t periodOutputs[d_PWM_MAX_CHANNELS];
+static Uint64_t nextPeriodUs;
+
+/* Register values of the outputs of each frame, to recognise a torn period */
+static Uint32_t frameOutputs[2][CHANNELS];
+static Uint32_t frameIndex;
+static Uint32_t periods;
+static Uint32_t tornPeriods;
+static Uint32_t interrupts;
+
+static Bool_t interruptsModelled;
+static Uint32_t randomState = 1044u;
+
+/***** Function Definitions *********************************************/
+
+static Uint32_t randomNumber(const Uint32_t range)
+{
+  randomState = (randomState * 1664525u) + 1013904223u;
+
+  return (randomState >> 8u) % range;
+}
+
+/* Console of the flight software, its printf is printf_ */
+int printf_(const char * format, ...)
+{
+  va_list args;
+  int count;
+
+  va_start(args, format);
+  count = vfprintf(stdout, format, args);
+  va_end(args);
+
+  return count;
+}
+
+Bool_t d_FCU_IocOnline(const d_FCU_Ioc_t ioc)
+{
+  return iocOnline[ioc];
+}
+
+/* A period is torn when its outputs are neither all from the last frame nor all from the one before */
+static void periodStart(void)
+{
+  Bool_t current = d_TRUE;
+  Bool_t previous = d_TRUE;
+
+  memcpy(periodOutputs, outputRegisters[d_FCU_IOC_A], sizeof(periodOutputs));
+  for (Uint32_t channel = 0u; channel < CHANNELS; channel++)
+  {
+    current = (periodOutputs[channel] == frameOutputs[frameIndex & 1u][channel]) ? current : d_FALSE;
+    previous = (periodOutputs[channel] == frameOutputs[(frameIndex + 1u) & 1u][channel]) ? previous : d_FALSE;
+  }
+  periods++;
+  if ((current == d_FALSE) && (previous == d_FALSE))
+  {
+    tornPeriods++;
+  }
+  ELSE_DO_NOTHING
+}
+
+/* Interrupts preempt the CPU while they are enabled, the IOC starts its periods whatever the CPU does */
+static void timerHook(void)
+{
+  if ((interruptsModelled == d_TRUE) && (host_CriticalDepth == 0) && (randomNumber(INTERRUPT_EVERY_US / WRITE_US) == 0u))
+  {
+    interrupts++;
+    host_TimerAdvance(INTERRUPT_US);
+  }
+  ELSE_DO_NOTHING
+
+  while (host_TimerMicroseconds() >= nextPeriodUs)
+  {
+    periodStart();
+    nextPeriodUs += PERIOD_US;
+  }
+}
+
+static Uint32_t modelRead(const Uint32_t address)
+{
+  return 0u;
+}
+
+static void modelWrite(const Uint32_t address, const Uint32_t value)
+{
+  Uint32_t ioc = (address >= OUTPUT_BASE_B) ? d_FCU_IOC_B : d_FCU_IOC_A;
+  Uint32_t base = (ioc == d_FCU_IOC_B) ? OUTPUT_BASE_B : OUTPUT_BASE_A;
+
+  if ((address >= base) && (address < (base + ENABLE_OFFSET)))
+  {
+    outputRegisters[ioc][(address - base) / 4u] = value;
+    registerWrites++;
+    if (host_CriticalDepth == 0)
+    {
+      writesOutsideSection++;
+    }
+    ELSE_DO_NOTHING
+  }
+  else if (address == (base + ENABLE_OFFSET))
+  {
+    enableRegisters[ioc] = value;
+  }
+  else
+  {
+    /* Input resolution */
+  }
+
+  host_TimerAdvance(WRITE_US);
+}
+
+/* Register value of a fraction of the output range, as the IOC was calibrated */
+static Uint32_t expectedRegister(const Float32_t fraction)
+{
+  return REG_MINIMUM + (Uint32_t)((fraction * (Float32_t)(REG_MAXIMUM - REG_MINIMUM)) + 0.05f);
+}
+
+static Float32_t channelValue(const Uint32_t channel, const Float32_t fraction)
+{
+  return d_PWM_Definition[channel].minimumValue +
+         (fraction * (d_PWM_Definition[channel].maximumValue - d_PWM_Definition[channel].minimumValue));
+}
+
+static void testInitialise(void)
+{
+  TEST_CHECK_EQUAL(d_PWM_OutputQueue(d_FCU_IOC_A, 0u, 0.0f), d_STATUS_NOT_INITIALISED);
+  TEST_CHECK_EQUAL(d_PWM_Commit(), d_STATUS_NOT_INITIALISED);
+  host_ErrorCount = 0u;
+
+  TEST_CHECK_EQUAL(d_PWM_Initialise(), d_STATUS_SUCCESS);
+  TEST_CHECK_EQUAL(enableRegisters[d_FCU_IOC_A], 0xFFFFu);
+  TEST_CHECK_EQUAL(enableRegisters[d_FCU_IOC_B], 0xFFFFu);
+  for (Uint32_t channel = 0u; channel < CHANNELS; channel++)
+  {
+    Float32_t fraction = (d_PWM_Definition[channel].defaultValue - d_PWM_Definition[channel].minimumValue) /
+                         (d_PWM_Definition[channel].maximumValue - d_PWM_Definition[channel].minimumValue);
+
+    TEST_CHECK_EQUAL(outputRegisters[d_FCU_IOC_A][channel], expectedRegister(fraction));
+    TEST_CHECK_EQUAL(outputRegisters[d_FCU_IOC_B][channel], expectedRegister(fraction));
+  }
+  TEST_CHECK_EQUAL(host_ErrorCount, 0u);
+}
+
+/* Queued outputs are scaled by the channel definition as the immediate outputs are */
+static void testScaling(void)
+{
+  Uint32_t mismatches = 0u;
+  Uint32_t limitErrors = 0u;
+
+  for (Uint32_t channel = 0u; channel < CHANNELS; channel++)
+  {
+    for (Uint32_t step = 0u; step <= 1000u; step++)
+    {
+      Float32_t value = channelValue(channel, (Float32_t)step / 1000.0f);
+      Uint32_t immediate;
+
+      (void)d_PWM_Output(d_FCU_IOC_B, channel, value);
+      immediate = outputRegisters[d_FCU_IOC_B][channel];
+      (void)d_PWM_OutputQueue(d_FCU_IOC_A, channel, value);
+      (void)d_PWM_Commit();
+      if (outputRegisters[d_FCU_IOC_A][channel] != immediate)
+      {
+        mismatches++;
+      }
+      ELSE_DO_NOTHING
+    }
+
+    /* The limits of every definition reach the ends of the register range */
+    (void)d_PWM_OutputQueue(d_FCU_IOC_A, channel, d_PWM_Definition[channel].minimumValue);
+    (void)d_PWM_Commit();
+    limitErrors += (outputRegisters[d_FCU_IOC_A][channel] != REG_MINIMUM) ? 1u : 0u;
+    (void)d_PWM_OutputQueue(d_FCU_IOC_A, channel, d_PWM_Definition[channel].maximumValue);
+    (void)d_PWM_Commit();
+    limitErrors += (outputRegisters[d_FCU_IOC_A][channel] != REG_MAXIMUM) ? 1u : 0u;
+  }
+  TEST_CHECK_EQUAL(mismatches, 0u);
+  TEST_CHECK_EQUAL(limitErrors, 0u);
+  TEST_CHECK_EQUAL(host_ErrorCount, 0u);
+
+  /* Values beyond the definition are limited to it and logged */
+  (void)d_PWM_OutputQueue(d_FCU_IOC_A, 2u, 45.0f);
+  (void)d_PWM_Commit();
+  TEST_CHECK_EQUAL(outputRegisters[d_FCU_IOC_A][2], REG_MAXIMUM);
+  (void)d_PWM_OutputQueue(d_FCU_IOC_A, 3u, 900.0f);
+  (void)d_PWM_Commit();
+  TEST_CHECK_EQUAL(outputRegisters[d_FCU_IOC_A][3], REG_MINIMUM);
+  TEST_CHECK_EQUAL(host_ErrorCount, 2u);
+  host_ErrorCount = 0u;
+}
+
+/* The pulse width given to the service gives the same register whatever the units of the channel */
+static void testService(void)
+{
+  Uint32_t mismatches = 0u;
+
+  for (Uint32_t channel = 0u; channel < CHANNELS; channel++)
+  {
+    for (Uint32_t width = 1000u; width <= 2000u; width++)
+    {
+      Uint32_t expected = expectedRegister((Float32_t)(width - 1000u) / 1000.0f);
+      Uint32_t actual;
+
+      TEST_CHECK(pwm_set((uint16_t)channel, (uint16_t)width) == true);
+      TEST_CHECK(pwm_commit() == true);
+      actual = outputRegisters[d_FCU_IOC_A][channel];
+      /* Within a count, the definitions differ in their rounding */
+      if ((actual + 1u < expected) || (actual > expected + 1u))
+      {
+        mismatches++;
+      }
+      ELSE_DO_NOTHING
+    }
+  }
+  TEST_CHECK_EQUAL(mismatches, 0u);
+  TEST_CHECK(pwm_set(CHANNELS, 1500u) == false);
+  TEST_CHECK_EQUAL(host_ErrorCount, 0u);
+}
+
+/* Only changed outputs are written, a change undone in the same frame is not */
+static void testChangeSuppression(void)
+{
+  d_PWM_CommitStats_t before;
+  d_PWM_CommitStats_t after;
+  Uint32_t writes;
+
+  (void)d_PWM_OutputQueue(d_FCU_IOC_A, 0u, 0.0f);
+  (void)d_PWM_OutputQueue(d_FCU_IOC_A, 1u, 0.5f);
+  (void)d_PWM_Commit();
+  (void)d_PWM_GetCommitStats(&before);
+  writes = registerWrites;
+
+  (void)d_PWM_OutputQueue(d_FCU_IOC_A, 0u, 0.0f);
+  (void)d_PWM_OutputQueue(d_FCU_IOC_A, 1u, 0.9f);
+  (void)d_PWM_OutputQueue(d_FCU_IOC_A, 1u, 0.5f);
+  TEST_CHECK_EQUAL(d_PWM_Commit(), d_STATUS_SUCCESS);
+  (void)d_PWM_GetCommitStats(&after);
+  TEST_CHECK_EQUAL(registerWrites, writes);
+  TEST_CHECK_EQUAL(after.commits, before.commits);
+  TEST_CHECK_EQUAL(after.unchanged - before.unchanged, 2u);
+
+  (void)d_PWM_OutputQueue(d_FCU_IOC_A, 1u, 0.6f);
+  (void)d_PWM_OutputQueue(d_FCU_IOC_A, 2u, 10.0f);
+  TEST_CHECK_EQUAL(registerWrites, writes);
+  (void)d_PWM_Commit();
+  (void)d_PWM_GetCommitStats(&after);
+  TEST_CHECK_EQUAL(registerWrites - writes, 2u);
+  TEST_CHECK_EQUAL(after.commits - before.commits, 1u);
+  TEST_CHECK_EQUAL(after.outputsWritten - before.outputsWritten, 2u);
+  TEST_CHECK_EQUAL(d_PWM_GetCommitStats(NULL), d_STATUS_INVALID_PARAMETER);
+  host_ErrorCount = 0u;
+}
+
+/* Outputs of an IOC that is offline stay queued until it is back */
+static void testOffline(void)
+{
+  Uint32_t expected = expectedRegister(0.25f);
+
+  (void)d_PWM_OutputQueue(d_FCU_IOC_B, 4u, channelValue(4u, 0.25f));
+  (void)d_PWM_OutputQueue(d_FCU_IOC_A, 4u, channelValue(4u, 0.25f));
+  iocOnline[d_FCU_IOC_B] = d_FALSE;
+  TEST_CHECK_EQUAL(d_PWM_Commit(), d_STATUS_OFFLINE_IOCB);
+  TEST_CHECK_EQUAL(outputRegisters[d_FCU_IOC_A][4], expected);
+  TEST_CHECK(outputRegisters[d_FCU_IOC_B][4] != expected);
+
+  iocOnline[d_FCU_IOC_B] = d_TRUE;
+  TEST_CHECK_EQUAL(d_PWM_Commit(), d_STATUS_SUCCESS);
+  TEST_CHECK_EQUAL(outputRegisters[d_FCU_IOC_B][4], expected);
+
+  TEST_CHECK_EQUAL(d_PWM_OutputQueue(d_FCU_IOC_COUNT, 0u, 0.0f), d_STATUS_INVALID_PARAMETER);
+  TEST_CHECK_EQUAL(d_PWM_OutputQueue(d_FCU_IOC_A, CHANNELS, 0.0f), d_STATUS_INVALID_PARAMETER);
+  host_ErrorCount = 0u;
+}
+
+/* New outputs for all channels every frame, committed together or written one at a time through the frame */
+static void runFrames(const Bool_t commit, Uint32_t * const pTorn, Uint32_t * const pPeriods)
+{
+  Uint32_t writesOutside = writesOutsideSection;
+
+  nextPeriodUs = host_TimerMicroseconds() + PERIOD_US;
+  periods = 0u;
+  tornPeriods = 0u;
+  interruptsModelled = d_TRUE;
+  memcpy(frameOutputs[0], outputRegisters[d_FCU_IOC_A], sizeof(frameOutputs[0]));
+  memcpy(frameOutputs[1], outputRegisters[d_FCU_IOC_A], sizeof(frameOutputs[1]));
+
+  for (frameIndex = 0u; frameIndex < FRAMES; frameIndex++)
+  {
+    Uint64_t frameStart = host_TimerMicroseconds();
+
+    /* The frame starts at a random point of the period, and every channel changes */
+    for (Uint32_t channel = 0u; channel < CHANNELS; channel++)
+    {
+      Float32_t fraction = (Float32_t)((frameIndex * 7u) + (channel * 13u) + 1u) / 200.0f;
+
+      fraction -= (Float32_t)(Uint32_t)fraction;
+      frameOutputs[frameIndex & 1u][channel] = expectedRegister(fraction);
+    }
+
+    for (Uint32_t channel = 0u; channel < CHANNELS; channel++)
+    {
+      Float32_t fraction = (Float32_t)(frameOutputs[frameIndex & 1u][channel] - REG_MINIMUM) /
+                           (Float32_t)(REG_MAXIMUM - REG_MINIMUM);
+      Float32_t value = channelValue(channel, fraction);
+
+      /* The actuators compute their outputs through the first part of the frame */
+      host_TimerAdvance(200u + randomNumber(400u));
+      if (commit == d_TRUE)
+      {
+        (void)d_PWM_OutputQueue(d_FCU_IOC_A, channel, value);
+      }
+      else
+      {
+        (void)d_PWM_Output(d_FCU_IOC_A, channel, value);
+      }
+      /* Rounding of the value may move the register by a count, the model takes what was written */
+      frameOutputs[frameIndex & 1u][channel] = (commit == d_TRUE) ? frameOutputs[frameIndex & 1u][channel] :
+                                               outputRegisters[d_FCU_IOC_A][channel];
+    }
+    if (commit == d_TRUE)
+    {
+      (void)d_PWM_Commit();
+      memcpy(frameOutputs[frameIndex & 1u], outputRegisters[d_FCU_IOC_A], sizeof(frameOutputs[0]));
+    }
+    ELSE_DO_NOTHING
+
+    host_TimerAdvance((Uint32_t)((frameStart + FRAME_US + randomNumber(PERIOD_US)) - host_TimerMicroseconds()));
+  }
+  interruptsModelled = d_FALSE;
+
+  if (commit == d_TRUE)
+  {
+    /* The committed writes are made with interrupts disabled */
+    TEST_CHECK_EQUAL(writesOutsideSection - writesOutside, 0u);
+  }
+  ELSE_DO_NOTHING
+  *pTorn = tornPeriods;
+  *pPeriods = periods;
+}
+
+static void testTornPeriods(void)
+{
+  Uint32_t tornCommit;
+  Uint32_t periodsCommit;
+  Uint32_t tornImmediate;
+  Uint32_t periodsImmediate;
+
+  host_TimerSetHook(timerHook);
+  runFrames(d_FALSE, &tornImmediate, &periodsImmediate);
+  runFrames(d_TRUE, &tornCommit, &periodsCommit);
+  host_TimerSetHook(NULL);
+
+  printf("  %u frames, %u interrupts: written one at a time %u of %u periods torn, committed %u of %u\n", FRAMES,
+         interrupts, tornImmediate, periodsImmediate, tornCommit, periodsCommit);
+
+  /* A period can only start inside the 8 back to back writes of a commit, 16 us in every 10 ms frame */
+  TEST_CHECK(tornCommit <= ((periodsCommit * 8u * WRITE_US * 4u) / PERIOD_US) + 1u);
+  TEST_CHECK(tornImmediate > (periodsImmediate / 10u));
+  TEST_CHECK_EQUAL(host_CriticalDepth, 0);
+}
+
+int main(void)
+{
+  host_Reset();
+  host_RegisterSetModel(modelRead, modelWrite);
+
+  testInitialise();
+  testScaling();
+  testService();
+  testChangeSuppression();
+  testOffline();
+  testTornPeriods();
+
+  TEST_CHECK_EQUAL(host_ErrorCount, 0u);
+
+  return TEST_RESULT();
+}
@@ -0,0 +1,487 @@
+/*********************************************************************//**
+\file
+\brief
+  Module Title       : QSPI flash read cache and queue test
+
+  Abstract           : Runs the QSPI flash driver against the controller
+                       and flash model. The metadata read of a sub-sector
+                       is checked to go through the cache and to hit on
+                       a second read, a stream of small reads to be
+                       served by the prefetches, and program and erase to
+                       keep the cache coherent. A blocking read is checked
+                       to wait behind an outstanding queued read, a
+                       queued read from the cache to leave the buffer
+                       untouched when the queue is full, a failed line
+                       fill to be counted once and retried, and a read
+                       that never completes to time out and leave the
+                       driver usable. A random mix of reads, programs and
+                       erases is checked against the flash image. The
+                       simulated bus time of the reads is reported.
+*************************************************************************/
+
+/***** Includes *********************************************************/
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "soc/defines/d_common_types.h"
+#include "sru/qspiFlash/d_qspiFlash.h"
+#include "host_stubs.h"
+#include "qspi_model.h"
+#include "test_common.h"
+
+/***** Constants ********************************************************/
+
+/* Address and size of the metadata read by d_META_Initialise */
+#define METADATA_ADDRESS   0x00010000u
+#define METADATA_WORDS     1024u
+
+#define PAGE_BYTES         d_QSPI_CACHE_PAGE_BYTES
+#define PAGE_WORDS         (PAGE_BYTES / 4u)
+#define CACHE_WORDS        (d_QSPI_CACHE_SETS * d_QSPI_CACHE_WAYS * PAGE_WORDS)
+
+/* Stream of small reads */
+#define STREAM_ADDRESS     0x00020000u
+#define STREAM_BYTES       0x00010000u
+#define STREAM_READ_WORDS  16u
+
+/* Window of the random operations */
+#define RANDOM_ADDRESS     0x00040000u
+#define RANDOM_BYTES       0x00040000u
+#define RANDOM_OPERATIONS  20000u
+#define RANDOM_READ_WORDS  6000u
+#define ASYNC_READ_WORDS   1024u
+
+/***** Type Definitions *************************************************/
+
+typedef struct
+{
+  Bool_t pending;
+  Bool_t done;
+  d_Status_t status;
+  Uint32_t address;
+  Uint32_t words;
+} asyncRead_t;
+
+/***** Variables ********************************************************/
+
+static __attribute__((aligned(64))) Uint32_t readData[RANDOM_READ_WORDS];
+static __attribute__((aligned(64))) Uint32_t writeData[d_QSPI_SUB_SECTOR_SIZE_WORDS];
+static __attribute__((aligned(64))) Uint32_t asyncData[d_QSPI_QUEUE_DEPTH][ASYNC_READ_WORDS];
+
+static asyncRead_t asyncReads[d_QSPI_QUEUE_DEPTH];
+
+/* Reads whose data differed from the flash image when they completed */
+static Uint32_t asyncMismatches;
+
+/***** Function Definitions *********************************************/
+
+/* The flash holds a pattern that differs from page to page */
+static void imageFill(void)
+{
+  Uint8_t * pImage = qspiModel_Image();
+
+  for (Uint32_t address = 0u; address < QSPI_MODEL_BYTES; address++)
+  {
+    pImage[address] = (Uint8_t)((address * 13u) + (address >> 8u) + 1u);
+  }
+}
+
+static Bool_t imageHolds(const Uint32_t address, const Uint32_t * const pData, const Uint32_t words)
+{
+  return (memcmp(&qspiModel_Image()[address], pData, words * 4u) == 0) ? d_TRUE : d_FALSE;
+}
+
+static Uint32_t cacheAccesses(void)
+{
+  d_QSPI_CacheStats_t stats;
+
+  (void)d_QSPI_GetCacheStats(&stats);
+
+  return stats.readHits + stats.prefetchHits + stats.readMisses;
+}
+
+static Uint32_t pagesSpanned(const Uint32_t address, const Uint32_t words)
+{
+  return (((address + (words * 4u)) - 1u) / PAGE_BYTES) - (address / PAGE_BYTES) + 1u;
+}
+
+static void queueWait(void)
+{
+  while (d_QSPI_QueuePoll() != 0u)
+  {
+    DO_NOTHING();
+  }
+}
+
+/* The data of a queued read is checked when its callback is made */
+static void asyncComplete(const Uint32_t tag, const d_Status_t status, void * const pContext)
+{
+  asyncRead_t * pRead = (asyncRead_t *)pContext;
+  Uint32_t slot = (Uint32_t)(pRead - asyncReads);
+
+  (void)tag;
+  pRead->pending = d_FALSE;
+  pRead->done = d_TRUE;
+  pRead->status = status;
+  if ((status != d_STATUS_SUCCESS) || (imageHolds(pRead->address, asyncData[slot], pRead->words) == d_FALSE))
+  {
+    asyncMismatches++;
+  }
+  ELSE_DO_NOTHING
+}
+
+static d_Status_t asyncSubmit(const Uint32_t slot, const Uint32_t address, const Uint32_t words)
+{
+  asyncReads[slot].pending = d_TRUE;
+  asyncReads[slot].done = d_FALSE;
+  asyncReads[slot].address = address;
+  asyncReads[slot].words = words;
+
+  d_Status_t status = d_QSPI_ReadAsync(address, words, asyncData[slot], ASYNC_READ_WORDS, asyncComplete,
+                                       &asyncReads[slot], NULL);
+  if (status != d_STATUS_SUCCESS)
+  {
+    asyncReads[slot].pending = d_FALSE;
+  }
+  ELSE_DO_NOTHING
+
+  return status;
+}
+
+/* The metadata sub-sector is read through the cache, the second read is served from it */
+static void testMetadata(void)
+{
+  d_QSPI_CacheStats_t stats;
+  Uint64_t start;
+
+
+  start = host_TimerMicroseconds();
+  TEST_CHECK_EQUAL(d_QSPI_Read(METADATA_ADDRESS, METADATA_WORDS, readData, METADATA_WORDS), d_STATUS_SUCCESS);
+  Uint64_t cold = host_TimerMicroseconds() - start;
+  TEST_CHECK(imageHolds(METADATA_ADDRESS, readData, METADATA_WORDS) == d_TRUE);
+  (void)d_QSPI_GetCacheStats(&stats);
+  TEST_CHECK_EQUAL(stats.readMisses, (METADATA_WORDS * 4u) / PAGE_BYTES);
+  TEST_CHECK_EQUAL(stats.bypassReads, 0u);
+  Uint32_t readCommands = qspiModel_Stats.readCommands;
+
+  memset(readData, 0, sizeof(readData));
+  start = host_TimerMicroseconds();
+  TEST_CHECK_EQUAL(d_QSPI_Read(METADATA_ADDRESS, METADATA_WORDS, readData, METADATA_WORDS), d_STATUS_SUCCESS);
+  Uint64_t warm = host_TimerMicroseconds() - start;
+  TEST_CHECK(imageHolds(METADATA_ADDRESS, readData, METADATA_WORDS) == d_TRUE);
+  (void)d_QSPI_GetCacheStats(&stats);
+  TEST_CHECK_EQUAL(stats.readHits, (METADATA_WORDS * 4u) / PAGE_BYTES);
+  TEST_CHECK_EQUAL(qspiModel_Stats.readCommands, readCommands);
+
+  /* An unaligned read of the same size spans one more line */
+  queueWait();
+  Uint32_t accesses = cacheAccesses();
+  TEST_CHECK_EQUAL(d_QSPI_Read(METADATA_ADDRESS + 0x1010u, METADATA_WORDS, readData, METADATA_WORDS), d_STATUS_SUCCESS);
+  TEST_CHECK(imageHolds(METADATA_ADDRESS + 0x1010u, readData, METADATA_WORDS) == d_TRUE);
+  TEST_CHECK_EQUAL(cacheAccesses() - accesses, pagesSpanned(METADATA_ADDRESS + 0x1010u, METADATA_WORDS));
+
+  printf("  metadata read: %llu us from the flash, %llu us from the cache\n", (unsigned long long)cold,
+         (unsigned long long)warm);
+}
+
+/* Sequential small reads are served by the prefetched lines */
+static void testStream(void)
+{
+  d_QSPI_CacheStats_t before;
+  d_QSPI_CacheStats_t after;
+  Bool_t intact = d_TRUE;
+
+  queueWait();
+  (void)d_QSPI_GetCacheStats(&before);
+
+  Uint64_t start = host_TimerMicroseconds();
+  for (Uint32_t address = STREAM_ADDRESS; address < (STREAM_ADDRESS + STREAM_BYTES); address += STREAM_READ_WORDS * 4u)
+  {
+    TEST_CHECK_EQUAL(d_QSPI_Read(address, STREAM_READ_WORDS, readData, STREAM_READ_WORDS), d_STATUS_SUCCESS);
+    intact = ((imageHolds(address, readData, STREAM_READ_WORDS) == d_TRUE) && (intact == d_TRUE)) ? d_TRUE : d_FALSE;
+    /* The caller does a little work between reads */
+    host_TimerAdvance(2u);
+  }
+  Uint64_t elapsed = host_TimerMicroseconds() - start;
+  queueWait();
+  (void)d_QSPI_GetCacheStats(&after);
+
+  TEST_CHECK(intact == d_TRUE);
+  TEST_CHECK_EQUAL(after.readMisses - before.readMisses, 1u);
+  TEST_CHECK_EQUAL(after.prefetchHits - before.prefetchHits, (STREAM_BYTES / PAGE_BYTES) - 1u);
+
+  printf("  stream of %u byte reads: %.2f us per read\n", STREAM_READ_WORDS * 4u,
+         (double)elapsed / (double)(STREAM_BYTES / (STREAM_READ_WORDS * 4u)));
+}
+
+/* Program and erase discard the lines they overlap */
+static void testCoherency(void)
+{
+  d_QSPI_CacheStats_t stats;
+  const Uint32_t address = METADATA_ADDRESS;
+
+  TEST_CHECK_EQUAL(d_QSPI_Read(address, PAGE_WORDS, readData, PAGE_WORDS), d_STATUS_SUCCESS);
+
+  TEST_CHECK_EQUAL(d_QSPI_EraseSubSector4K(address), d_STATUS_SUCCESS);
+  TEST_CHECK_EQUAL(d_QSPI_Read(address, PAGE_WORDS, readData, PAGE_WORDS), d_STATUS_SUCCESS);
+  TEST_CHECK_EQUAL(readData[0], 0xFFFFFFFFu);
+  TEST_CHECK_EQUAL(readData[PAGE_WORDS - 1u], 0xFFFFFFFFu);
+
+  for (Uint32_t i = 0u; i < d_QSPI_SUB_SECTOR_SIZE_WORDS; i++)
+  {
+    writeData[i] = 0xA5000000u + i;
+  }
+  TEST_CHECK_EQUAL(d_QSPI_Write(address, d_QSPI_SUB_SECTOR_SIZE_WORDS, writeData, d_QSPI_SUB_SECTOR_SIZE_WORDS),
+                   d_STATUS_SUCCESS);
+  TEST_CHECK(imageHolds(address, writeData, d_QSPI_SUB_SECTOR_SIZE_WORDS) == d_TRUE);
+  TEST_CHECK_EQUAL(d_QSPI_Read(address, d_QSPI_SUB_SECTOR_SIZE_WORDS, readData, d_QSPI_SUB_SECTOR_SIZE_WORDS),
+                   d_STATUS_SUCCESS);
+  TEST_CHECK(memcmp(readData, writeData, sizeof(writeData)) == 0);
+
+  (void)d_QSPI_GetCacheStats(&stats);
+  TEST_CHECK(stats.invalidations >= 2u);
+}
+
+/* A blocking read is queued behind an outstanding queued read, whose callback is made first */
+static void testQueuedBehind(void)
+{
+  queueWait();
+  TEST_CHECK_EQUAL(asyncSubmit(0u, 0x00030000u, PAGE_WORDS), d_STATUS_SUCCESS);
+
+  Uint32_t errors = host_ErrorCount;
+  Uint64_t start = host_TimerMicroseconds();
+  TEST_CHECK_EQUAL(d_QSPI_Read(0x00030000u, CACHE_WORDS + 1u, readData, RANDOM_READ_WORDS), d_STATUS_SUCCESS);
+  TEST_CHECK(host_TimerMicroseconds() > start);
+  TEST_CHECK_EQUAL(host_ErrorCount, errors);
+  TEST_CHECK(imageHolds(0x00030000u, readData, CACHE_WORDS + 1u) == d_TRUE);
+  TEST_CHECK(asyncReads[0].done == d_TRUE);
+  TEST_CHECK_EQUAL(asyncReads[0].status, d_STATUS_SUCCESS);
+  TEST_CHECK_EQUAL(d_QSPI_QueuePoll(), 0u);
+}
+
+/* A queued read held in the cache reserves its place before copying, a full queue leaves the buffer untouched */
+static void testAsyncFull(void)
+{
+  const Uint32_t held = 0x00031000u;
+  d_QSPI_CacheStats_t before;
+  d_QSPI_CacheStats_t after;
+
+  queueWait();
+  TEST_CHECK_EQUAL(d_QSPI_Read(held, PAGE_WORDS, readData, PAGE_WORDS), d_STATUS_SUCCESS);
+  queueWait();
+
+  for (Uint32_t slot = 0u; slot < (d_QSPI_QUEUE_DEPTH - 1u); slot++)
+  {
+    TEST_CHECK_EQUAL(asyncSubmit(slot, 0x00032000u + (slot * ASYNC_READ_WORDS * 4u), ASYNC_READ_WORDS), d_STATUS_SUCCESS);
+  }
+  TEST_CHECK_EQUAL(asyncSubmit(d_QSPI_QUEUE_DEPTH - 1u, 0x00036000u, 1u), d_STATUS_SUCCESS);
+
+  /* The queue is full, the held read must not copy */
+  (void)d_QSPI_GetCacheStats(&before);
+  memset(readData, 0x5A, PAGE_BYTES);
+  TEST_CHECK_EQUAL(d_QSPI_ReadAsync(held, PAGE_WORDS, readData, PAGE_WORDS, NULL, NULL, NULL), d_STATUS_BUFFER_FULL);
+  TEST_CHECK_EQUAL(readData[0], 0x5A5A5A5Au);
+  TEST_CHECK_EQUAL(readData[PAGE_WORDS - 1u], 0x5A5A5A5Au);
+  (void)d_QSPI_GetCacheStats(&after);
+  TEST_CHECK_EQUAL(after.readHits, before.readHits);
+
+  queueWait();
+  for (Uint32_t slot = 0u; slot < d_QSPI_QUEUE_DEPTH; slot++)
+  {
+    TEST_CHECK(asyncReads[slot].done == d_TRUE);
+  }
+
+  /* With room in the queue the read is copied at once and its callback made by the next poll */
+  Uint32_t readCommands = qspiModel_Stats.readCommands;
+  TEST_CHECK_EQUAL(asyncSubmit(0u, held, PAGE_WORDS), d_STATUS_SUCCESS);
+  TEST_CHECK(imageHolds(held, asyncData[0], PAGE_WORDS) == d_TRUE);
+  TEST_CHECK(asyncReads[0].done == d_FALSE);
+  TEST_CHECK_EQUAL(d_QSPI_QueuePoll(), 0u);
+  TEST_CHECK(asyncReads[0].done == d_TRUE);
+  TEST_CHECK_EQUAL(qspiModel_Stats.readCommands, readCommands);
+}
+
+/* A prefetched line whose fill fails is counted once and fetched again */
+static void testFailedFill(void)
+{
+  const Uint32_t address = 0x00037000u;
+  d_QSPI_QueueStats_t queueStats;
+
+  queueWait();
+  TEST_CHECK_EQUAL(d_QSPI_Read(address, PAGE_WORDS, readData, PAGE_WORDS), d_STATUS_SUCCESS);
+
+  /* The second read continues the stream, the first prefetch fails */
+  qspiModel_FailRead(address + (2u * PAGE_BYTES));
+  TEST_CHECK_EQUAL(d_QSPI_Read(address + PAGE_BYTES, PAGE_WORDS, readData, PAGE_WORDS), d_STATUS_SUCCESS);
+
+  Uint32_t errors = host_ErrorCount;
+  Uint32_t accesses = cacheAccesses();
+  TEST_CHECK_EQUAL(d_QSPI_Read(address + (2u * PAGE_BYTES), PAGE_WORDS, readData, PAGE_WORDS), d_STATUS_SUCCESS);
+  TEST_CHECK(imageHolds(address + (2u * PAGE_BYTES), readData, PAGE_WORDS) == d_TRUE);
+  TEST_CHECK_EQUAL(cacheAccesses() - accesses, 1u);
+  TEST_CHECK_EQUAL(host_ErrorCount, errors + 1u);
+  (void)d_QSPI_GetQueueStats(&queueStats);
+  TEST_CHECK_EQUAL(queueStats.errors, 1u);
+}
+
+/* A read that never completes times out, the controller is reset and the next read succeeds */
+static void testTimeout(void)
+{
+  const Uint32_t address = 0x00038000u;
+  d_QSPI_QueueStats_t queueStats;
+
+  queueWait();
+  qspiModel_HangRead(address);
+  Uint64_t start = host_TimerMicroseconds();
+  TEST_CHECK_EQUAL(d_QSPI_Read(address, PAGE_WORDS, readData, PAGE_WORDS), d_STATUS_TIMEOUT);
+  TEST_CHECK(host_TimerMicroseconds() >= (start + (d_QSPI_REQUEST_TIMEOUT_MS * 1000u)));
+  TEST_CHECK_EQUAL(qspiModel_Stats.aborts, 1u);
+  TEST_CHECK(qspiModel_Busy() == d_FALSE);
+  (void)d_QSPI_GetQueueStats(&queueStats);
+  TEST_CHECK_EQUAL(queueStats.timeouts, 1u);
+
+  TEST_CHECK_EQUAL(d_QSPI_Read(address, PAGE_WORDS, readData, PAGE_WORDS), d_STATUS_SUCCESS);
+  TEST_CHECK(imageHolds(address, readData, PAGE_WORDS) == d_TRUE);
+}
+
+/* A read larger than the cache is made directly into the buffer */
+static void testBypass(void)
+{
+  d_QSPI_CacheStats_t before;
+  d_QSPI_CacheStats_t after;
+
+  queueWait();
+  (void)d_QSPI_GetCacheStats(&before);
+  TEST_CHECK_EQUAL(d_QSPI_Read(RANDOM_ADDRESS, CACHE_WORDS + 1u, readData, RANDOM_READ_WORDS), d_STATUS_SUCCESS);
+  TEST_CHECK(imageHolds(RANDOM_ADDRESS, readData, CACHE_WORDS + 1u) == d_TRUE);
+  (void)d_QSPI_GetCacheStats(&after);
+  TEST_CHECK_EQUAL(after.bypassReads, before.bypassReads + 1u);
+  TEST_CHECK_EQUAL(after.readMisses, before.readMisses);
+}
+
+/* Random reads, queued reads, programs and erases against the flash image */
+static void testRandom(void)
+{
+  Uint32_t syncReads = 0u;
+  Uint32_t syncMismatches = 0u;
+  Uint32_t queuedBehind = 0u;
+  Uint32_t failures = 0u;
+
+  srand(39u);
+  queueWait();
+  Uint32_t errors = host_ErrorCount;
+  asyncMismatches = 0u;
+
+  for (Uint32_t operation = 0u; operation < RANDOM_OPERATIONS; operation++)
+  {
+    Uint32_t choice = (Uint32_t)rand() % 100u;
+    Uint32_t outstanding = 0u;
+
+    for (Uint32_t slot = 0u; slot < d_QSPI_QUEUE_DEPTH; slot++)
+    {
+      outstanding += (asyncReads[slot].pending == d_TRUE) ? 1u : 0u;
+    }
+
+    if (choice < 50u)
+    {
+      /* Mostly small reads, some larger than the cache */
+      Uint32_t words = ((Uint32_t)rand() % 8u == 0u) ? (1u + ((Uint32_t)rand() % RANDOM_READ_WORDS))
+                                                     : (1u + ((Uint32_t)rand() % 300u));
+      Uint32_t address = RANDOM_ADDRESS + (((Uint32_t)rand() % ((RANDOM_BYTES - (words * 4u)) / 4u)) * 4u);
+      d_Status_t status = d_QSPI_Read(address, words, readData, RANDOM_READ_WORDS);
+
+      if (status == d_STATUS_SUCCESS)
+      {
+        syncReads++;
+        queuedBehind += (outstanding != 0u) ? 1u : 0u;
+        syncMismatches += (imageHolds(address, readData, words) == d_TRUE) ? 0u : 1u;
+      }
+      else
+      {
+        failures++;
+      }
+    }
+    else if (choice < 80u)
+    {
+      Uint32_t slot = (Uint32_t)rand() % d_QSPI_QUEUE_DEPTH;
+
+      if (asyncReads[slot].pending == d_FALSE)
+      {
+        Uint32_t words = 1u + ((Uint32_t)rand() % ASYNC_READ_WORDS);
+        Uint32_t address = RANDOM_ADDRESS + (((Uint32_t)rand() % ((RANDOM_BYTES - (words * 4u)) / 4u)) * 4u);
+        d_Status_t status = asyncSubmit(slot, address, words);
+        failures += ((status == d_STATUS_SUCCESS) || (status == d_STATUS_BUFFER_FULL)) ? 0u : 1u;
+      }
+      ELSE_DO_NOTHING
+    }
+    else if (choice < 90u)
+    {
+      (void)d_QSPI_QueuePoll();
+    }
+    else if (choice < 97u)
+    {
+      /* Program part of a page, clearing bits only */
+      Uint32_t page = RANDOM_ADDRESS + (((Uint32_t)rand() % (RANDOM_BYTES / PAGE_BYTES)) * PAGE_BYTES);
+      Uint32_t words = 1u + ((Uint32_t)rand() % PAGE_WORDS);
+
+      for (Uint32_t i = 0u; i < words; i++)
+      {
+        writeData[i] = (Uint32_t)rand() | (Uint32_t)rand() << 16u;
+      }
+      failures += (d_QSPI_Write(page, words, writeData, words) == d_STATUS_SUCCESS) ? 0u : 1u;
+    }
+    else
+    {
+      Uint32_t address = RANDOM_ADDRESS + ((Uint32_t)rand() % RANDOM_BYTES);
+      failures += (d_QSPI_EraseSubSector4K(address) == d_STATUS_SUCCESS) ? 0u : 1u;
+    }
+
+    /* Time passes between operations */
+    host_TimerAdvance((Uint32_t)rand() % 20u);
+  }
+  queueWait();
+
+  printf("  random: %u reads, %u made while queued reads were outstanding\n", syncReads, queuedBehind);
+  TEST_CHECK_EQUAL(syncMismatches, 0u);
+  TEST_CHECK_EQUAL(asyncMismatches, 0u);
+  TEST_CHECK_EQUAL(failures, 0u);
+  TEST_CHECK(syncReads > 0u);
+  TEST_CHECK(queuedBehind > 0u);
+  TEST_CHECK_EQUAL(host_ErrorCount, errors);
+}
+
+int main(void)
+{
+  d_QSPI_CacheStats_t stats;
+  Uint32_t sfdp = 0u;
+
+  host_Reset();
+  qspiModel_Reset();
+  imageFill();
+
+  /* Initialisation enables quad mode on a new device */
+  TEST_CHECK_EQUAL(d_QSPI_Initialise(), d_STATUS_SUCCESS);
+  TEST_CHECK((qspiModel_StatusRegister() & 0x40u) != 0u);
+  TEST_CHECK_EQUAL(d_QSPI_SfdpWord(0u, &sfdp), d_STATUS_SUCCESS);
+  TEST_CHECK_EQUAL(sfdp, 0x50444653u);
+
+  testMetadata();
+  testStream();
+  testCoherency();
+  testQueuedBehind();
+  testAsyncFull();
+  testFailedFill();
+  testTimeout();
+  testBypass();
+  testRandom();
+
+  (void)d_QSPI_GetCacheStats(&stats);
+  printf("  cache: %u hits, %u prefetch hits, %u misses, %u prefetches, %u bypass reads\n", stats.readHits,
+         stats.prefetchHits, stats.readMisses, stats.prefetches, stats.bypassReads);
+  TEST_CHECK_EQUAL(qspiModel_Stats.protocolErrors, 0u);
+
+  return TEST_RESULT();
+}
@@ -0,0 +1,760 @@
+/*********************************************************************//**
+\file
+\brief
+  Module Title       : SATA request queue simulation
+
+  Abstract           : Runs the SATA operations against a model of the
+                       AHCI controller and drive. The model decodes the
+                       command list and the scatter-gather tables written
+                       by the driver, moves the data to and from a disk
+                       image and completes each command after a fixed
+                       command latency and the transfer time of a shared
+                       link, with native command queuing overlapping the
+                       latency of the commands in flight. The throughput
+                       and the time the CPU is held in the driver are
+                       compared for non-queued, queued synchronous and
+                       queued asynchronous transfers, then device errors,
+                       timeouts and a full queue are checked.
+*************************************************************************/
+
+/***** Includes *********************************************************/
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "soc/defines/d_common_types.h"
+#include "soc/sata/d_sata_ops.h"
+#include "host_stubs.h"
+#include "test_common.h"
+
+/***** Constants ********************************************************/
+
+#define PORT               0u
+#define DISK_SECTORS       65536u
+#define DRIVE_QUEUE_DEPTH  32u
+
+/* Drive command latency and link transfer rate */
+#define COMMAND_LATENCY    50u     // microseconds
+#define LINK_BYTES_PER_US  500u
+
+/* Transfers of the throughput comparison */
+#define TEST_BYTES         (8u * 1024u * 1024u)
+#define RECORD_BYTES       (64u * 1024u)
+#define RECORD_COUNT       (TEST_BYTES / RECORD_BYTES)
+
+/* Application work between two polls of the queue */
+#define APPLICATION_WORK   200u
+
+#define ATA_CMD_READ_EXT            0x25u
+#define ATA_CMD_WRITE_EXT           0x35u
+#define ATA_CMD_READ_LOG_EXT        0x2Fu
+#define ATA_CMD_READ_FPDMA_QUEUED   0x60u
+#define ATA_CMD_WRITE_FPDMA_QUEUED  0x61u
+#define ATA_CMD_ID_ATA              0xECu
+
+/* Task file status of an idle drive, and with the error bit set */
+#define TFD_READY          0x50u
+#define TFD_ERROR          0x51u
+
+/***** Type Definitions *************************************************/
+
+typedef struct
+{
+  Bool_t active;
+  Bool_t queued;
+  Bool_t dropped;     // never completes, as a command lost by the drive
+  Uint8_t command;
+  Uint32_t lba;
+  Uint32_t blocks;
+  Uint64_t finish;    // completion time (us)
+} HbaCommand_t;
+
+typedef struct
+{
+  Uint32_t cap;
+  Uint32_t ghc;
+  Uint32_t pxIs;
+  Uint32_t pxIe;
+  Uint32_t pxCmd;
+  Uint32_t pxTfd;
+  Uint32_t pxSerr;
+  Uint32_t pxSctl;
+  Uint32_t pxSact;
+  Uint32_t pxCi;
+  Uint32_t identifyDepth;   // queue depth reported by IDENTIFY DEVICE, 0 for none
+  Uint64_t linkFree;        // time the link finishes the transfers scheduled (us)
+  Bool_t halted;            // stopped by a task file error until the engine is restarted
+  Uint32_t failedTag;
+  Bool_t badLbaSet;
+  Uint32_t badLba;
+  Bool_t dropNext;
+  Uint32_t protocolErrors;  // commands built inconsistently by the driver
+  Uint32_t readLogCount;
+  Uint32_t maxPrdtCount;
+  HbaCommand_t command[AHCI_MAX_CMD_SLOTS];
+} HbaModel_t;
+
+/* Tracking of the asynchronous requests */
+typedef struct
+{
+  Uint32_t completions;
+  d_Status_t status;
+  Uint32_t tag;
+} Request_t;
+
+/***** Variables ********************************************************/
+
+static HbaModel_t hba;
+static Uint8_t * disk;
+
+static Uint8_t __attribute__ ((aligned (64))) writeData[TEST_BYTES];
+static Uint8_t __attribute__ ((aligned (64))) readData[TEST_BYTES];
+
+static Request_t request[RECORD_COUNT];
+static Uint32_t callbackErrors;
+
+/* Time spent in the driver by the asynchronous transfers */
+static Uint64_t driverTime;
+
+/***** Function Definitions *********************************************/
+
+/* Command table of a slot, as addressed by its command header */
+static Uint8_t * commandTable(const Uint32_t slot)
+{
+  return (Uint8_t *)(uintptr_t)cmdInfo.cmdSlot[slot].tbl_addr;
+}
+
+/* Copy between a buffer of the model and the memory described by the scatter-gather table of a slot */
+static void prdtCopy(const Uint32_t slot, Uint8_t * const data, const Uint32_t bytes, const Bool_t toMemory)
+{
+  const AhciSg_t * pSg = (const AhciSg_t *)(commandTable(slot) + AHCI_CMD_TBL_HDR);
+  Uint32_t entries = cmdInfo.cmdSlot[slot].opts >> 16u;
+  Uint32_t offset = 0u;
+
+  for (Uint32_t i = 0u; (i < entries) && (offset < bytes); i++)
+  {
+    Uint8_t * pMemory = (Uint8_t *)(uintptr_t)pSg[i].addr;
+    Uint32_t length = (pSg[i].flags_size & 0x3fffffu) + 1u;
+
+    if (length > (bytes - offset))
+    {
+      length = bytes - offset;
+    }
+    ELSE_DO_NOTHING
+
+    if (toMemory == d_TRUE)
+    {
+      memcpy(pMemory, &data[offset], length);
+    }
+    else
+    {
+      memcpy(&data[offset], pMemory, length);
+    }
+    offset += length;
+  }
+}
+
+/* IDENTIFY DEVICE data, strings are held as big endian words */
+static void identifyData(Uint8_t * const page)
+{
+  static const Char_t MODEL[] = "HOST AHCI MODEL";
+  Uint16_t id[256u];
+
+  memset(id, 0, sizeof(id));
+  for (Uint32_t i = 0u; i < 40u; i++)
+  {
+    Uint16_t high = (i < (sizeof(MODEL) - 1u)) ? (Uint8_t)MODEL[i] : (Uint16_t)' ';
+    i++;
+    Uint16_t low = (i < (sizeof(MODEL) - 1u)) ? (Uint8_t)MODEL[i] : (Uint16_t)' ';
+    id[27u + (i / 2u)] = (Uint16_t)((high << 8u) | low);
+  }
+  for (Uint32_t i = 0u; i < 10u; i++)
+  {
+    id[10u + i] = 0x3030u + (Uint16_t)i;
+  }
+  id[23u] = 0x3130u;
+  id[24u] = 0x2020u;
+  id[49u] = (Uint16_t)1u << 9u;
+  id[83u] = 0x4000u | ((Uint16_t)1u << 10u);
+  id[100u] = (Uint16_t)(DISK_SECTORS & 0xFFFFu);
+  id[101u] = (Uint16_t)(DISK_SECTORS >> 16u);
+  if (hba.identifyDepth != 0u)
+  {
+    id[75u] = (Uint16_t)(hba.identifyDepth - 1u);
+    id[76u] = (Uint16_t)1u << 8u;
+  }
+  ELSE_DO_NOTHING
+
+  memcpy(page, id, ATA_SECT_SIZE);
+}
+
+/* Decode a command issued in a slot and schedule its completion */
+static void hbaIssue(const Uint32_t slot)
+{
+  const AhchiCmdHdr_t * pHeader = &cmdInfo.cmdSlot[slot];
+  const Uint8_t * fis = commandTable(slot);
+  const AhciSg_t * pSg = (const AhciSg_t *)(fis + AHCI_CMD_TBL_HDR);
+  HbaCommand_t * pCommand = &hba.command[slot];
+  Uint32_t entries = pHeader->opts >> 16u;
+  Uint32_t prdtBytes = 0u;
+  Bool_t write = d_FALSE;
+
+  if (fis != (const Uint8_t *)(uintptr_t)(cmdInfo.cmdTbl + (slot * AHCI_CMD_TBL_SIZE)))
+  {
+    hba.protocolErrors++;
+  }
+  ELSE_DO_NOTHING
+
+  memset(pCommand, 0, sizeof(HbaCommand_t));
+  pCommand->command = fis[2u];
+  pCommand->lba = (Uint32_t)fis[4u] | ((Uint32_t)fis[5u] << 8u) | ((Uint32_t)fis[6u] << 16u) | ((Uint32_t)fis[8u] << 24u);
+
+  switch (pCommand->command)
+  {
+    case ATA_CMD_READ_FPDMA_QUEUED:
+    case ATA_CMD_WRITE_FPDMA_QUEUED:
+      pCommand->queued = d_TRUE;
+      pCommand->blocks = (Uint32_t)fis[3u] | ((Uint32_t)fis[11u] << 8u);
+      write = (pCommand->command == ATA_CMD_WRITE_FPDMA_QUEUED) ? d_TRUE : d_FALSE;
+      if ((((Uint32_t)fis[12u] >> 3u) != slot) || ((hba.pxSact & ((Uint32_t)1u << slot)) == 0u))
+      {
+        hba.protocolErrors++;
+      }
+      ELSE_DO_NOTHING
+      break;
+
+    case ATA_CMD_READ_EXT:
+    case ATA_CMD_WRITE_EXT:
+      pCommand->blocks = (Uint32_t)fis[12u] | ((Uint32_t)fis[13u] << 8u);
+      write = (pCommand->command == ATA_CMD_WRITE_EXT) ? d_TRUE : d_FALSE;
+      break;
+
+    case ATA_CMD_ID_ATA:
+    case ATA_CMD_READ_LOG_EXT:
+      pCommand->blocks = 1u;
+      break;
+
+    default:
+      pCommand->blocks = 0u;
+      break;
+  }
+
+  for (Uint32_t i = 0u; i < entries; i++)
+  {
+    prdtBytes += (pSg[i].flags_size & 0x3fffffu) + 1u;
+  }
+  if ((prdtBytes != (pCommand->blocks * ATA_SECT_SIZE)) || ((pCommand->lba + pCommand->blocks) > DISK_SECTORS) ||
+      (((pHeader->opts & ((Uint32_t)1u << 6u)) != 0u) != (write == d_TRUE)))
+  {
+    hba.protocolErrors++;
+  }
+  ELSE_DO_NOTHING
+  if (entries > hba.maxPrdtCount)
+  {
+    hba.maxPrdtCount = entries;
+  }
+  ELSE_DO_NOTHING
+
+  // The latency of the commands in flight overlaps, the transfers share the link
+  Uint64_t start = host_TimerMicroseconds() + COMMAND_LATENCY;
+  if (hba.linkFree > start)
+  {
+    start = hba.linkFree;
+  }
+  ELSE_DO_NOTHING
+  pCommand->finish = start + ((pCommand->blocks * ATA_SECT_SIZE) / LINK_BYTES_PER_US);
+  hba.linkFree = pCommand->finish;
+
+  pCommand->dropped = hba.dropNext;
+  hba.dropNext = d_FALSE;
+  pCommand->active = d_TRUE;
+}
+
+/* Complete the commands whose time has come, called each time the timer moves on */
+static void hbaUpdate(void)
+{
+  Uint64_t now = host_TimerMicroseconds();
+
+  for (Uint32_t slot = 0u; (slot < AHCI_MAX_CMD_SLOTS) && (hba.halted == d_FALSE); slot++)
+  {
+    HbaCommand_t * pCommand = &hba.command[slot];
+    Uint32_t bytes = pCommand->blocks * ATA_SECT_SIZE;
+
+    if ((pCommand->active == d_FALSE) || (pCommand->dropped == d_TRUE) || (pCommand->finish > now))
+    {
+      continue;
+    }
+    ELSE_DO_NOTHING
+
+    if ((hba.badLbaSet == d_TRUE) && (hba.badLba >= pCommand->lba) && (hba.badLba < (pCommand->lba + pCommand->blocks)))
+    {
+      // uncorrectable sector, the controller stops with a task file error
+      hba.badLbaSet = d_FALSE;
+      hba.halted = d_TRUE;
+      hba.failedTag = slot;
+      hba.pxTfd = TFD_ERROR;
+      hba.pxIs |= PORT_IS_TFES;
+      continue;
+    }
+    ELSE_DO_NOTHING
+
+    switch (pCommand->command)
+    {
+      case ATA_CMD_READ_FPDMA_QUEUED:
+      case ATA_CMD_READ_EXT:
+        prdtCopy(slot, &disk[pCommand->lba * ATA_SECT_SIZE], bytes, d_TRUE);
+        break;
+
+      case ATA_CMD_WRITE_FPDMA_QUEUED:
+      case ATA_CMD_WRITE_EXT:
+        prdtCopy(slot, &disk[pCommand->lba * ATA_SECT_SIZE], bytes, d_FALSE);
+        break;
+
+      case ATA_CMD_ID_ATA:
+      {
+        Uint8_t page[ATA_SECT_SIZE];
+        identifyData(page);
+        prdtCopy(slot, page, ATA_SECT_SIZE, d_TRUE);
+        break;
+      }
+
+      case ATA_CMD_READ_LOG_EXT:
+      {
+        // NCQ command error log, tag of the failed command, status and error
+        Uint8_t page[ATA_SECT_SIZE];
+        memset(page, 0, sizeof(page));
+        page[0u] = (Uint8_t)hba.failedTag;
+        page[2u] = TFD_ERROR;
+        page[3u] = 0x40u;
+        prdtCopy(slot, page, ATA_SECT_SIZE, d_TRUE);
+        hba.readLogCount++;
+        break;
+      }
+
+      default:
+        break;
+    }
+
+    pCommand->active = d_FALSE;
+    hba.pxCi &= ~((Uint32_t)1u << slot);
+    hba.pxSact &= ~((Uint32_t)1u << slot);
+    hba.pxIs |= (pCommand->queued == d_TRUE) ? PORT_IS_SDBS : PORT_IS_DHRS;
+  }
+}
+
+static Uint32_t hbaRead(const Uint32_t address)
+{
+  Uint32_t value = 0u;
+
+  switch (address - XPAR_PSU_SATA_S_AXI_BASEADDR)
+  {
+    case CAP_REGISTER:    value = hba.cap; break;
+    case GHC_REGISTER:    value = hba.ghc; break;
+    case IS_REGISTER:     value = (hba.pxIs != 0u) ? 1u : 0u; break;
+    case PxIS_REGISTER:   value = hba.pxIs; break;
+    case PxIE_REGISTER:   value = hba.pxIe; break;
+    case PxCMD_REGISTER:  value = hba.pxCmd | (((hba.pxCmd & PORT_CMD_ST) != 0u) ? PORT_CMD_LIST_ON : 0u); break;
+    case PxTFD_REGISTER:  value = hba.pxTfd; break;
+    case PxSERR_REGISTER: value = hba.pxSerr; break;
+    case PxSSTS_REGISTER: value = PORT_STS_DET_PHYRDY; break;
+    case PxSCTL_REGISTER: value = hba.pxSctl; break;
+    case PxSACT_REGISTER: value = hba.pxSact; break;
+    case PxCI_REGISTER:   value = hba.pxCi; break;
+    default:              break;
+  }
+
+  return value;
+}
+
+static void hbaWrite(const Uint32_t address, const Uint32_t value)
+{
+  switch (address - XPAR_PSU_SATA_S_AXI_BASEADDR)
+  {
+    case GHC_REGISTER:    hba.ghc = value; break;
+    case PxIS_REGISTER:   hba.pxIs &= ~value; break;
+    case PxIE_REGISTER:   hba.pxIe = value; break;
+    case PxSERR_REGISTER: hba.pxSerr &= ~value; break;
+    case PxSCTL_REGISTER: hba.pxSctl = value; break;
+    case PxSACT_REGISTER: hba.pxSact |= value; break;
+
+    case PxCMD_REGISTER:
+      if (((hba.pxCmd & PORT_CMD_ST) != 0u) && ((value & PORT_CMD_ST) == 0u))
+      {
+        // stopping the command engine aborts every command issued
+        memset(hba.command, 0, sizeof(hba.command));
+        hba.pxCi = 0u;
+        hba.pxSact = 0u;
+        hba.pxTfd = TFD_READY;
+        hba.halted = d_FALSE;
+        hba.linkFree = host_TimerMicroseconds();
+      }
+      ELSE_DO_NOTHING
+      hba.pxCmd = value & ~PORT_CMD_LIST_ON;
+      break;
+
+    case PxCI_REGISTER:
+      for (Uint32_t slot = 0u; slot < AHCI_MAX_CMD_SLOTS; slot++)
+      {
+        if (((value & ((Uint32_t)1u << slot)) != 0u) && ((hba.pxCi & ((Uint32_t)1u << slot)) == 0u))
+        {
+          hba.pxCi |= ((Uint32_t)1u << slot);
+          hbaIssue(slot);
+        }
+        ELSE_DO_NOTHING
+      }
+      break;
+
+    default:
+      break;
+  }
+}
+
+/* Controller and port state left by d_SATA_Initialise, with the command list laid out in dmaMem */
+static void hbaReset(const Uint32_t identifyDepth)
+{
+  memset(&hba, 0, sizeof(hba));
+  hba.cap = CAP_SNCQ | ((AHCI_MAX_CMD_SLOTS - 1u) << CAP_NCS_SHIFT);
+  hba.pxCmd = PORT_CMD_ST | PORT_CMD_FRE;
+  hba.pxTfd = TFD_READY;
+  hba.identifyDepth = identifyDepth;
+
+  memset(dmaMem, 0, sizeof(dmaMem));
+  cmdInfo.cmdSlot = (AhchiCmdHdr_t *)&dmaMem[0];
+  cmdInfo.rxFis = (Uint32_t)(uintptr_t)&dmaMem[AHCI_CMD_LIST_SIZE];
+  cmdInfo.cmdTbl = (Uint32_t)(uintptr_t)&dmaMem[AHCI_CMD_LIST_SIZE + AHCI_RX_FIS_SIZE];
+  cmdInfo.cmdTblSg = (AhciSg_t *)&dmaMem[AHCI_CMD_LIST_SIZE + AHCI_RX_FIS_SIZE + AHCI_CMD_TBL_HDR];
+}
+
+static void fillPattern(Uint8_t * const pBuffer, const Uint32_t length, const Uint32_t seed)
+{
+  for (Uint32_t i = 0u; i < length; i++)
+  {
+    pBuffer[i] = (Uint8_t)((i * 31u) + (i >> 9u) + seed);
+  }
+}
+
+static void requestCallback(const Uint32_t tag, const d_Status_t status, void * const pContext)
+{
+  Request_t * pRequest = (Request_t *)pContext;
+
+  if ((pRequest < &request[0]) || (pRequest >= &request[RECORD_COUNT]) || (tag != pRequest->tag))
+  {
+    callbackErrors++;
+  }
+  else
+  {
+    pRequest->completions++;
+    pRequest->status = status;
+  }
+}
+
+static d_Status_t submitTimed(const Uint32_t lba, const d_SATA_SgEntry_t * const pSg, const Uint32_t sgCount,
+                              const Bool_t writeFlag, Request_t * const pRequest)
+{
+  Uint64_t start = host_TimerMicroseconds();
+  d_Status_t status = d_SATAOP_QueueSubmit(PORT, lba, pSg, sgCount, writeFlag, requestCallback, pRequest, &pRequest->tag);
+  driverTime += host_TimerMicroseconds() - start;
+
+  return status;
+}
+
+static Uint32_t serviceTimed(void)
+{
+  Uint64_t start = host_TimerMicroseconds();
+  Uint32_t outstanding = d_SATAOP_QueueService(PORT, d_FALSE);
+  driverTime += host_TimerMicroseconds() - start;
+
+  return outstanding;
+}
+
+/* Transfer the test data in records, each a queued request, with application work between polls */
+static Uint64_t asyncTransfer(const Uint32_t lba, Uint8_t * const pData, const Bool_t writeFlag)
+{
+  Uint64_t start = host_TimerMicroseconds();
+  Uint32_t next = 0u;
+  Uint32_t outstanding = 0u;
+
+  memset(request, 0, sizeof(request));
+  driverTime = 0u;
+
+  while ((next < RECORD_COUNT) || (outstanding != 0u))
+  {
+    d_Status_t status = d_STATUS_SUCCESS;
+    while ((next < RECORD_COUNT) && (status == d_STATUS_SUCCESS))
+    {
+      d_SATA_SgEntry_t sg = {&pData[next * RECORD_BYTES], RECORD_BYTES};
+      status = submitTimed(lba + ((next * RECORD_BYTES) / ATA_SECT_SIZE), &sg, 1u, writeFlag, &request[next]);
+      if (status == d_STATUS_SUCCESS)
+      {
+        next++;
+      }
+      ELSE_DO_NOTHING
+    }
+    TEST_CHECK((status == d_STATUS_SUCCESS) || (status == d_STATUS_BUFFER_FULL));
+
+    outstanding = serviceTimed();
+    host_TimerAdvance(APPLICATION_WORK);
+  }
+
+  for (Uint32_t i = 0u; i < RECORD_COUNT; i++)
+  {
+    TEST_CHECK_EQUAL(request[i].completions, 1u);
+    TEST_CHECK_EQUAL(request[i].status, d_STATUS_SUCCESS);
+  }
+
+  return host_TimerMicroseconds() - start;
+}
+
+static void report(const char * const mode, const Uint64_t elapsed, const Uint64_t blocked)
+{
+  printf("%-24s %8.1f MB/s  %6.1f ms  CPU in driver %5.1f %%\n", mode,
+         (double)TEST_BYTES / (double)elapsed, (double)elapsed / 1000.0, (100.0 * (double)blocked) / (double)elapsed);
+}
+
+int main(void)
+{
+  d_SATA_QueueStats_t stats;
+  Uint64_t start;
+  Uint64_t syncTime;
+  Uint64_t queuedSyncTime;
+  Uint64_t asyncTime;
+  Uint32_t lba;
+
+  disk = calloc(DISK_SECTORS, ATA_SECT_SIZE);
+  if (disk == NULL)
+  {
+    return 2;
+  }
+
+  host_Reset();
+  host_RegisterSetModel(hbaRead, hbaWrite);
+  host_TimerSetHook(hbaUpdate);
+  /* Each poll of the timer takes a microsecond so the wait loops see the time move on */
+  host_TimerSetReadCost(1u);
+  hbaReset(DRIVE_QUEUE_DEPTH);
+
+  /* Identification, made before the queue is set up */
+  TEST_CHECK_EQUAL(d_SATAOP_Inquiry(PORT), d_STATUS_SUCCESS);
+  TEST_CHECK_EQUAL(d_SATA_DeviceInfo.capacity, DISK_SECTORS);
+  TEST_CHECK_EQUAL(d_SATA_DeviceInfo.queueDepth, DRIVE_QUEUE_DEPTH);
+  TEST_CHECK(strcmp(d_SATA_DeviceInfo.product, "HOST AHCI MODEL") == 0);
+
+  /* Non-queued transfers, one record at a time */
+  fillPattern(writeData, TEST_BYTES, 1u);
+  start = host_TimerMicroseconds();
+  for (Uint32_t i = 0u; i < RECORD_COUNT; i++)
+  {
+    TEST_CHECK_EQUAL(d_SATAOP_ReadWrite(PORT, (i * RECORD_BYTES) / ATA_SECT_SIZE, &writeData[i * RECORD_BYTES], RECORD_BYTES, d_TRUE),
+                     d_STATUS_SUCCESS);
+  }
+  syncTime = host_TimerMicroseconds() - start;
+  TEST_CHECK_EQUAL(d_SATAOP_ReadWrite(PORT, 0u, readData, TEST_BYTES, d_FALSE), d_STATUS_SUCCESS);
+  TEST_CHECK(memcmp(readData, writeData, TEST_BYTES) == 0);
+
+  /* Queue with the depth of the drive */
+  TEST_CHECK_EQUAL(d_SATAOP_QueueInitialise(PORT), d_STATUS_SUCCESS);
+  TEST_CHECK_EQUAL(d_SATAOP_QueueGetStats(PORT, &stats), d_STATUS_SUCCESS);
+  TEST_CHECK_EQUAL(stats.queueDepth, DRIVE_QUEUE_DEPTH);
+
+  /* Synchronous transfer through the queue, split in requests kept in flight together */
+  lba = TEST_BYTES / ATA_SECT_SIZE;
+  fillPattern(writeData, TEST_BYTES, 2u);
+  start = host_TimerMicroseconds();
+  TEST_CHECK_EQUAL(d_SATAOP_ReadWrite(PORT, lba, writeData, TEST_BYTES, d_TRUE), d_STATUS_SUCCESS);
+  queuedSyncTime = host_TimerMicroseconds() - start;
+  memset(readData, 0, TEST_BYTES);
+  TEST_CHECK_EQUAL(d_SATAOP_ReadWrite(PORT, lba, readData, TEST_BYTES, d_FALSE), d_STATUS_SUCCESS);
+  TEST_CHECK(memcmp(readData, writeData, TEST_BYTES) == 0);
+
+  /* Asynchronous records, the application runs while they are in flight */
+  lba = 2u * (TEST_BYTES / ATA_SECT_SIZE);
+  fillPattern(writeData, TEST_BYTES, 3u);
+  asyncTime = asyncTransfer(lba, writeData, d_TRUE);
+  Uint64_t asyncDriverTime = driverTime;
+  memset(readData, 0, TEST_BYTES);
+  (void)asyncTransfer(lba, readData, d_FALSE);
+  TEST_CHECK(memcmp(readData, writeData, TEST_BYTES) == 0);
+  TEST_CHECK_EQUAL(callbackErrors, 0u);
+
+  TEST_CHECK_EQUAL(d_SATAOP_QueueGetStats(PORT, &stats), d_STATUS_SUCCESS);
+  printf("requests %u, completed %u, most outstanding %u\n", stats.submitted, stats.completed, stats.maxOutstanding);
+  report("non-queued 64K records", syncTime, syncTime);
+  report("queued synchronous", queuedSyncTime, queuedSyncTime);
+  report("queued 64K records", asyncTime, asyncDriverTime);
+
+  TEST_CHECK_EQUAL(stats.completed, stats.submitted);
+  TEST_CHECK(stats.maxOutstanding > 1u);
+  TEST_CHECK(stats.maxOutstanding <= DRIVE_QUEUE_DEPTH);
+
+  /* Queuing hides the command latency, and the records leave the CPU to the application */
+  TEST_CHECK((syncTime * 10u) >= (asyncTime * 12u));
+  TEST_CHECK((queuedSyncTime * 10u) <= (syncTime * 9u));
+  TEST_CHECK((asyncDriverTime * 10u) < asyncTime);
+
+  /* Scatter-gather list, the 6M byte segment takes two table entries */
+  {
+    static const Uint32_t LENGTH[3u] = {ATA_SECT_SIZE, 4096u, 6u * 1024u * 1024u};
+    d_SATA_SgEntry_t sg[3u] = {{&writeData[0], LENGTH[0]}, {&writeData[4096u], LENGTH[1]}, {&writeData[65536u], LENGTH[2]}};
+    Uint32_t offset = 0u;
+
+    memset(request, 0, sizeof(request));
+    lba = 1000u;
+    TEST_CHECK_EQUAL(d_SATAOP_QueueSubmit(PORT, lba, sg, 3u, d_TRUE, requestCallback, &request[0], &request[0].tag), d_STATUS_SUCCESS);
+    while (d_SATAOP_QueueService(PORT, d_FALSE) != 0u)
+    {
+    }
+    TEST_CHECK_EQUAL(request[0].completions, 1u);
+    TEST_CHECK_EQUAL(request[0].status, d_STATUS_SUCCESS);
+    TEST_CHECK_EQUAL(hba.maxPrdtCount, 4u);
+    for (Uint32_t i = 0u; i < 3u; i++)
+    {
+      TEST_CHECK(memcmp(&disk[(lba * ATA_SECT_SIZE) + offset], sg[i].pBuffer, LENGTH[i]) == 0);
+      offset += LENGTH[i];
+    }
+  }
+
+  /* Requests the driver refuses */
+  {
+    d_SATA_SgEntry_t odd = {writeData, 511u};
+    d_SATA_SgEntry_t partial = {writeData, 256u};
+    d_SATA_SgEntry_t beyond = {writeData, 2u * ATA_SECT_SIZE};
+    Uint32_t errors = host_ErrorCount;
+
+    TEST_CHECK_EQUAL(d_SATAOP_QueueSubmit(PORT, 0u, &odd, 1u, d_TRUE, NULL, NULL, NULL), d_STATUS_INVALID_PARAMETER);
+    TEST_CHECK_EQUAL(d_SATAOP_QueueSubmit(PORT, 0u, &partial, 1u, d_TRUE, NULL, NULL, NULL), d_STATUS_INVALID_PARAMETER);
+    TEST_CHECK_EQUAL(d_SATAOP_QueueSubmit(PORT, DISK_SECTORS - 1u, &beyond, 1u, d_TRUE, NULL, NULL, NULL), d_STATUS_INVALID_PARAMETER);
+    TEST_CHECK_EQUAL(d_SATAOP_QueueSubmit(PORT, 0u, &beyond, 0u, d_TRUE, NULL, NULL, NULL), d_STATUS_INVALID_PARAMETER);
+    TEST_CHECK_EQUAL(host_ErrorCount, errors + 4u);
+  }
+
+  /* Full queue, the requests are issued faster than the drive completes them */
+  {
+    d_Status_t status = d_STATUS_SUCCESS;
+    Uint32_t submitted = 0u;
+
+    memset(request, 0, sizeof(request));
+    while ((status == d_STATUS_SUCCESS) && (submitted < RECORD_COUNT))
+    {
+      d_SATA_SgEntry_t sg = {&writeData[submitted * RECORD_BYTES], RECORD_BYTES};
+      status = d_SATAOP_QueueSubmit(PORT, submitted * (RECORD_BYTES / ATA_SECT_SIZE), &sg, 1u, d_TRUE, requestCallback,
+                                    &request[submitted], &request[submitted].tag);
+      if (status == d_STATUS_SUCCESS)
+      {
+        TEST_CHECK_EQUAL(request[submitted].tag, submitted);
+        submitted++;
+      }
+      ELSE_DO_NOTHING
+    }
+    TEST_CHECK_EQUAL(status, d_STATUS_BUFFER_FULL);
+    TEST_CHECK_EQUAL(submitted, DRIVE_QUEUE_DEPTH);
+    while (d_SATAOP_QueueService(PORT, d_FALSE) != 0u)
+    {
+    }
+    for (Uint32_t i = 0u; i < submitted; i++)
+    {
+      TEST_CHECK_EQUAL(request[i].completions, 1u);
+    }
+  }
+
+  /* Device error on the third of eight requests: the port is recovered, the NCQ error log is read
+     and the requests still in flight are failed */
+  {
+    Uint32_t succeeded = 0u;
+    Uint32_t failed = 0u;
+
+    TEST_CHECK_EQUAL(d_SATAOP_QueueGetStats(PORT, &stats), d_STATUS_SUCCESS);
+    Uint32_t errorsBefore = stats.errors;
+    Uint32_t recoveriesBefore = stats.recoveries;
+
+    memset(request, 0, sizeof(request));
+    hba.badLbaSet = d_TRUE;
+    hba.badLba = (2u * (RECORD_BYTES / ATA_SECT_SIZE)) + 7u;
+    for (Uint32_t i = 0u; i < 8u; i++)
+    {
+      d_SATA_SgEntry_t sg = {&readData[i * RECORD_BYTES], RECORD_BYTES};
+      TEST_CHECK_EQUAL(d_SATAOP_QueueSubmit(PORT, i * (RECORD_BYTES / ATA_SECT_SIZE), &sg, 1u, d_FALSE, requestCallback,
+                                            &request[i], &request[i].tag), d_STATUS_SUCCESS);
+    }
+    while (d_SATAOP_QueueService(PORT, d_FALSE) != 0u)
+    {
+    }
+    for (Uint32_t i = 0u; i < 8u; i++)
+    {
+      TEST_CHECK_EQUAL(request[i].completions, 1u);
+      if (request[i].status == d_STATUS_SUCCESS)
+      {
+        succeeded++;
+      }
+      else
+      {
+        TEST_CHECK_EQUAL(request[i].status, d_STATUS_DEVICE_ERROR);
+        failed++;
+      }
+    }
+    TEST_CHECK_EQUAL(request[0].status, d_STATUS_SUCCESS);
+    TEST_CHECK_EQUAL(request[1].status, d_STATUS_SUCCESS);
+    TEST_CHECK_EQUAL(request[2].status, d_STATUS_DEVICE_ERROR);
+    TEST_CHECK_EQUAL(succeeded + failed, 8u);
+    TEST_CHECK_EQUAL(hba.readLogCount, 1u);
+    TEST_CHECK_EQUAL(host_ErrorLast, d_STATUS_DEVICE_ERROR);
+
+    TEST_CHECK_EQUAL(d_SATAOP_QueueGetStats(PORT, &stats), d_STATUS_SUCCESS);
+    TEST_CHECK_EQUAL(stats.errors, errorsBefore + failed);
+    TEST_CHECK_EQUAL(stats.recoveries, recoveriesBefore + 1u);
+  }
+
+  /* A request the drive never completes is timed out and the port recovered */
+  {
+    d_SATA_SgEntry_t sg = {readData, RECORD_BYTES};
+
+    memset(request, 0, sizeof(request));
+    hba.dropNext = d_TRUE;
+    TEST_CHECK_EQUAL(d_SATAOP_QueueSubmit(PORT, 0u, &sg, 1u, d_FALSE, requestCallback, &request[0], &request[0].tag), d_STATUS_SUCCESS);
+    host_TimerAdvance(1000u);
+    TEST_CHECK_EQUAL(d_SATAOP_QueueService(PORT, d_FALSE), 1u);
+    TEST_CHECK_EQUAL(request[0].completions, 0u);
+    host_TimerAdvance(10u * 1000u * 1000u);
+    TEST_CHECK_EQUAL(d_SATAOP_QueueService(PORT, d_FALSE), 0u);
+    TEST_CHECK_EQUAL(request[0].completions, 1u);
+    TEST_CHECK_EQUAL(request[0].status, d_STATUS_TIMEOUT);
+    TEST_CHECK_EQUAL(hba.readLogCount, 1u);
+
+    TEST_CHECK_EQUAL(d_SATAOP_QueueGetStats(PORT, &stats), d_STATUS_SUCCESS);
+    TEST_CHECK_EQUAL(stats.timeouts, 1u);
+    TEST_CHECK_EQUAL(stats.recoveries, 2u);
+
+    /* The port works again */
+    memset(readData, 0, ATA_SECT_SIZE);
+    TEST_CHECK_EQUAL(d_SATAOP_ReadWrite(PORT, 1000u, readData, ATA_SECT_SIZE, d_FALSE), d_STATUS_SUCCESS);
+    TEST_CHECK(memcmp(readData, &disk[1000u * ATA_SECT_SIZE], ATA_SECT_SIZE) == 0);
+  }
+
+  /* A drive with a shallower queue than the controller limits the queue depth */
+  hbaReset(8u);
+  TEST_CHECK_EQUAL(d_SATAOP_Inquiry(PORT), d_STATUS_SUCCESS);
+  TEST_CHECK_EQUAL(d_SATAOP_QueueInitialise(PORT), d_STATUS_SUCCESS);
+  TEST_CHECK_EQUAL(d_SATAOP_QueueGetStats(PORT, &stats), d_STATUS_SUCCESS);
+  TEST_CHECK_EQUAL(stats.queueDepth, 8u);
+  {
+    d_SATA_SgEntry_t sg = {writeData, RECORD_BYTES};
+    Uint32_t submitted = 0u;
+
+    while (d_SATAOP_QueueSubmit(PORT, 0u, &sg, 1u, d_TRUE, NULL, NULL, NULL) == d_STATUS_SUCCESS)
+    {
+      submitted++;
+    }
+    TEST_CHECK_EQUAL(submitted, 8u);
+    while (d_SATAOP_QueueService(PORT, d_FALSE) != 0u)
+    {
+    }
+  }
+
+  TEST_CHECK_EQUAL(hba.protocolErrors, 0u);
+  TEST_CHECK_EQUAL(host_CriticalDepth, 0);
+
+  free(disk);
+
+  return TEST_RESULT();
+}
@@ -0,0 +1,280 @@
+/*********************************************************************//**
+\file
+\brief
+  Module Title       : Background dispatcher simulation
+
+  Abstract           : Runs the background dispatcher against a simulated
+                       main loop and tick interrupt. The foreground load
+                       of each frame follows a synthetic profile with
+                       light and heavy frames, frames that leave less than
+                       the guard band and a frame that overruns into the
+                       next tick. One quantum of the scrub job is
+                       lengthened as if preempted by an interrupt.
+*************************************************************************/
+
+/***** Includes *********************************************************/
+
+#include <math.h>
+#include <stdio.h>
+
+#include "soc/defines/d_common_types.h"
+#include "kernel/scheduler/d_sched_background_cfg.h"
+#include "kernel/scheduler/d_sched_background.h"
+#include "host_stubs.h"
+#include "test_common.h"
+
+/***** Constants ********************************************************/
+
+#define FRAME_PERIOD     10000u
+#define GUARD_BAND       500u
+#define FRAMES           400u
+
+/* Frame in which one scrub quantum is preempted, and its length */
+#define PREEMPTED_FRAME  60u
+#define PREEMPTED_TIME   6000u
+
+/* Frame whose foreground work overruns into the next tick */
+#define OVERRUN_FRAME    70u
+
+enum
+{
+  JOB_POLLER = 0,
+  JOB_RECORDER,
+  JOB_SCRUB,
+  JOB_IDLE,
+  JOB_COUNT
+};
+
+/***** Variables ********************************************************/
+
+static Uint64_t nextTick;
+static Bool_t tickFlag;
+static Uint32_t frame;
+
+/* Quanta executed by each job in each frame */
+static Uint32_t frameQuanta[FRAMES + 2u][JOB_COUNT];
+
+/* Smallest time to the next tick seen at the start of a quantum of each job */
+static Uint64_t minStartSlack[JOB_COUNT];
+
+/***** Function Declarations ********************************************/
+
+static Bool_t poller(void);
+static Bool_t recorder(void);
+static Bool_t scrub(void);
+static Bool_t idle(void);
+
+/***** Constants ********************************************************/
+
+const Uint32_t d_SCHED_BackgroundGuardBand = GUARD_BAND;
+
+const d_SCHED_BackgroundJob_t d_SCHED_BackgroundJobs[] =
+{
+  {poller, 50, 0},
+  {recorder, 50, 2},
+  {scrub, 100, 0},
+  {idle, 5, 0},
+};
+
+const Uint32_t d_SCHED_BACKGROUND_JOB_COUNT = (sizeof(d_SCHED_BackgroundJobs) / sizeof(d_SCHED_BackgroundJob_t));
+
+/***** Function Definitions *********************************************/
+
+/* Tick interrupt of the simulated main loop */
+static void tick(void)
+{
+  if (host_TimerMicroseconds() >= nextTick)
+  {
+    d_SCHED_BackgroundFrameStart();
+    tickFlag = d_TRUE;
+    nextTick += FRAME_PERIOD;
+  }
+  ELSE_DO_NOTHING
+}
+
+/* Move the time on, stopping at each tick so that the interrupt is taken on time */
+static void run(const Uint32_t microseconds)
+{
+  Uint64_t end = host_TimerMicroseconds() + microseconds;
+
+  while (nextTick <= end)
+  {
+    host_TimerAdvance((Uint32_t)(nextTick - host_TimerMicroseconds()));
+  }
+  host_TimerAdvance((Uint32_t)(end - host_TimerMicroseconds()));
+}
+
+static void quantumStart(const Uint32_t job)
+{
+  Uint64_t slack = nextTick - host_TimerMicroseconds();
+
+  if (slack < minStartSlack[job])
+  {
+    minStartSlack[job] = slack;
+  }
+
+  frameQuanta[frame][job]++;
+}
+
+/* Queue poller, nothing finished so it never asks to run again */
+static Bool_t poller(void)
+{
+  quantumStart(JOB_POLLER);
+  run(10u);
+
+  return d_FALSE;
+}
+
+/* Rate limited job that always has work */
+static Bool_t recorder(void)
+{
+  quantumStart(JOB_RECORDER);
+  run(40u);
+
+  return d_TRUE;
+}
+
+/* Best effort job that always has work, one quantum is preempted */
+static Bool_t scrub(void)
+{
+  static Bool_t preempted = d_FALSE;
+
+  quantumStart(JOB_SCRUB);
+  if ((frame == PREEMPTED_FRAME) && (preempted == d_FALSE))
+  {
+    preempted = d_TRUE;
+    run(PREEMPTED_TIME);
+  }
+  else
+  {
+    run(90u);
+  }
+
+  return d_TRUE;
+}
+
+/* Job with no work to do */
+static Bool_t idle(void)
+{
+  quantumStart(JOB_IDLE);
+  run(2u);
+
+  return d_FALSE;
+}
+
+/* Foreground time of a frame in microseconds */
+static Uint32_t foregroundLoad(const Uint32_t index)
+{
+  Uint32_t load;
+
+  if (index == OVERRUN_FRAME)
+  {
+    load = FRAME_PERIOD + 3000u;
+  }
+  else if ((index % 50u) == 45u)
+  {
+    /* Leaves less than the guard band */
+    load = FRAME_PERIOD - 300u;
+  }
+  else
+  {
+    /* Between 1 ms and 7 ms over a period of 100 frames */
+    load = 4000u + (Uint32_t)(3000.0 * sin((6.283185307 * (double)index) / 100.0));
+  }
+
+  return load;
+}
+
+int main(void)
+{
+  d_SCHED_BackgroundStats_t stats[JOB_COUNT];
+  d_SCHED_BackgroundSlack_t slack;
+  Uint32_t job;
+  Uint32_t index;
+
+  host_Reset();
+  for (job = 0u; job < JOB_COUNT; job++)
+  {
+    minStartSlack[job] = FRAME_PERIOD;
+  }
+
+  TEST_CHECK_EQUAL(d_SCHED_BackgroundInitialise(FRAME_PERIOD), d_STATUS_SUCCESS);
+  nextTick = FRAME_PERIOD;
+  host_TimerSetHook(tick);
+
+  /* Wait for the first tick, as the main loop does */
+  run(FRAME_PERIOD);
+  tickFlag = d_FALSE;
+
+  for (frame = 1u; frame <= FRAMES; frame++)
+  {
+    d_SCHED_BackgroundLoopStart();
+    run(foregroundLoad(frame));
+    d_SCHED_BackgroundRun();
+    if (tickFlag == d_FALSE)
+    {
+      run((Uint32_t)(nextTick - host_TimerMicroseconds()));
+    }
+    tickFlag = d_FALSE;
+  }
+
+  for (job = 0u; job < JOB_COUNT; job++)
+  {
+    TEST_CHECK_EQUAL(d_SCHED_BackgroundGetStats(job, &stats[job]), d_STATUS_SUCCESS);
+  }
+  TEST_CHECK_EQUAL(d_SCHED_BackgroundGetSlack(&slack), d_STATUS_SUCCESS);
+
+  printf("frames %u, overrun %u, min slack %u us\n", slack.frames, slack.overrunFrames, slack.minSlack);
+  printf("job       quanta  cycles  starved  max run  max quantum  long quanta\n");
+  for (job = 0u; job < JOB_COUNT; job++)
+  {
+    static const char * const names[JOB_COUNT] = {"poller", "recorder", "scrub", "idle"};
+    printf("%-8s  %6u  %6u  %7u  %7u  %11u  %11u\n", names[job], stats[job].quanta, stats[job].cycles,
+           stats[job].starvedFrames, stats[job].maxConsecutiveStarved, stats[job].maxQuantumTime,
+           stats[job].longQuanta);
+  }
+
+  /* No quantum was started inside the guard band, to the resolution of the timer */
+  for (job = 0u; job < JOB_COUNT; job++)
+  {
+    TEST_CHECK((minStartSlack[job] + 1u) >= (GUARD_BAND + d_SCHED_BackgroundJobs[job].quantumTime));
+  }
+
+  /* The preempted quantum is recorded but the job keeps running in the following frames */
+  TEST_CHECK(stats[JOB_SCRUB].maxQuantumTime >= PREEMPTED_TIME);
+  TEST_CHECK_EQUAL(stats[JOB_SCRUB].longQuanta, 1u);
+  for (index = PREEMPTED_FRAME + 1u; index < (PREEMPTED_FRAME + 20u); index++)
+  {
+    TEST_CHECK((index == OVERRUN_FRAME) || (frameQuanta[index][JOB_SCRUB] > 0u));
+  }
+
+  /* The frame that overran has no jobs dispatched, and is counted */
+  for (job = 0u; job < JOB_COUNT; job++)
+  {
+    TEST_CHECK_EQUAL(frameQuanta[OVERRUN_FRAME][job], 0u);
+  }
+  TEST_CHECK(slack.overrunFrames >= 1u);
+  TEST_CHECK_EQUAL(slack.minSlack, 0u);
+
+  /* The rate limited job gets its quanta in every frame with slack beyond the guard band */
+  for (index = 1u; index <= FRAMES; index++)
+  {
+    if ((index != OVERRUN_FRAME) && ((index % 50u) != 45u))
+    {
+      TEST_CHECK_EQUAL(frameQuanta[index][JOB_RECORDER], 2u);
+    }
+    ELSE_DO_NOTHING
+  }
+
+  /* Jobs with no work pending are not starved by the frames without slack */
+  TEST_CHECK_EQUAL(stats[JOB_POLLER].starvedFrames, 0u);
+  TEST_CHECK_EQUAL(stats[JOB_IDLE].starvedFrames, 0u);
+
+  /* The scrub coverage follows the load, light frames do more than heavy frames */
+  TEST_CHECK(frameQuanta[75][JOB_SCRUB] > (2u * frameQuanta[25][JOB_SCRUB]));
+
+  TEST_CHECK_EQUAL(host_CriticalDepth, 0);
+  TEST_CHECK_EQUAL(host_ErrorCount, 0u);
+
+  return TEST_RESULT();
+}
@@ -0,0 +1,407 @@
+/*********************************************************************//**
+\file
+\brief
+  Module Title       : SHA-256 test
+
+  Abstract           : Checks the unrolled SHA-256 against the NIST known
+                       answers, including the empty message and a million
+                       repetitions of 'a', and checks that a message
+                       written in pieces of every length from 1 to 130
+                       bytes, from aligned and misaligned addresses, gives
+                       the hash of a single write. The background
+                       verification is run slice by slice to a pass and to
+                       a failure. The megabytes per second of the hash are
+                       measured against a model of the original rolled
+                       compression function, which gives the same hashes.
+*************************************************************************/
+
+/***** Includes *********************************************************/
+
+#include <stdio.h>
+#include <string.h>
+
+#include "soc/defines/d_common_types.h"
+#include "soc/defines/d_common_status.h"
+#include "kernel/sha/d_sha256.h"
+#include "host_stubs.h"
+#include "test_common.h"
+
+/***** Constants ********************************************************/
+
+#define MESSAGE_BYTES     (256u * 1024u)
+#define PIECE_MAX         130u
+
+/* Bytes hashed for each benchmark measurement */
+#define BENCH_BYTES       (64u * 1024u * 1024u)
+
+/***** Type Definitions *************************************************/
+
+typedef struct
+{
+  const Char_t * pMessage;
+  Uint32_t repeat;
+  Uint8_t hash[SIZE_OF_SHA_256_HASH];
+} KnownAnswer_t;
+
+/***** Variables ********************************************************/
+
+/* FIPS 180-2 appendix B and the empty message */
+static const KnownAnswer_t knownAnswers[] =
+{
+  {
+    "", 1u,
+    { 0xe3u, 0xb0u, 0xc4u, 0x42u, 0x98u, 0xfcu, 0x1cu, 0x14u, 0x9au, 0xfbu, 0xf4u, 0xc8u, 0x99u, 0x6fu, 0xb9u, 0x24u,
+      0x27u, 0xaeu, 0x41u, 0xe4u, 0x64u, 0x9bu, 0x93u, 0x4cu, 0xa4u, 0x95u, 0x99u, 0x1bu, 0x78u, 0x52u, 0xb8u, 0x55u }
+  },
+  {
+    "abc", 1u,
+    { 0xbau, 0x78u, 0x16u, 0xbfu, 0x8fu, 0x01u, 0xcfu, 0xeau, 0x41u, 0x41u, 0x40u, 0xdeu, 0x5du, 0xaeu, 0x22u, 0x23u,
+      0xb0u, 0x03u, 0x61u, 0xa3u, 0x96u, 0x17u, 0x7au, 0x9cu, 0xb4u, 0x10u, 0xffu, 0x61u, 0xf2u, 0x00u, 0x15u, 0xadu }
+  },
+  {
+    "abcdbcdecdefdefgefghfghighijhijkijkljklmklmnlmnomnopnopq", 1u,
+    { 0x24u, 0x8du, 0x6au, 0x61u, 0xd2u, 0x06u, 0x38u, 0xb8u, 0xe5u, 0xc0u, 0x26u, 0x93u, 0x0cu, 0x3eu, 0x60u, 0x39u,
+      0xa3u, 0x3cu, 0xe4u, 0x59u, 0x64u, 0xffu, 0x21u, 0x67u, 0xf6u, 0xecu, 0xedu, 0xd4u, 0x19u, 0xdbu, 0x06u, 0xc1u }
+  },
+  {
+    "abcdefghbcdefghicdefghijdefghijkefghijklfghijklmghijklmnhijklmnoijklmnopjklmnopqklmnopqrlmnopqrsmnopqrstnopqrstu", 1u,
+    { 0xcfu, 0x5bu, 0x16u, 0xa7u, 0x78u, 0xafu, 0x83u, 0x80u, 0x03u, 0x6cu, 0xe5u, 0x9eu, 0x7bu, 0x04u, 0x92u, 0x37u,
+      0x0bu, 0x24u, 0x9bu, 0x11u, 0xe8u, 0xf0u, 0x7au, 0x51u, 0xafu, 0xacu, 0x45u, 0x03u, 0x7au, 0xfeu, 0xe9u, 0xd1u }
+  },
+  {
+    "aaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaa", 10000u,
+    { 0xcdu, 0xc7u, 0x6eu, 0x5cu, 0x99u, 0x14u, 0xfbu, 0x92u, 0x81u, 0xa1u, 0xc7u, 0xe2u, 0x84u, 0xd7u, 0x3eu, 0x67u,
+      0xf1u, 0x80u, 0x9au, 0x48u, 0xa4u, 0x97u, 0x20u, 0x0eu, 0x04u, 0x6du, 0x39u, 0xccu, 0xc7u, 0x11u, 0x2cu, 0xd0u }
+  }
+};
+
+/* Round constants of the model of the original */
+static const Uint32_t roundConstants[64] =
+{
+  0x428a2f98u, 0x71374491u, 0xb5c0fbcfu, 0xe9b5dba5u, 0x3956c25bu, 0x59f111f1u, 0x923f82a4u, 0xab1c5ed5u,
+  0xd807aa98u, 0x12835b01u, 0x243185beu, 0x550c7dc3u, 0x72be5d74u, 0x80deb1feu, 0x9bdc06a7u, 0xc19bf174u,
+  0xe49b69c1u, 0xefbe4786u, 0x0fc19dc6u, 0x240ca1ccu, 0x2de92c6fu, 0x4a7484aau, 0x5cb0a9dcu, 0x76f988dau,
+  0x983e5152u, 0xa831c66du, 0xb00327c8u, 0xbf597fc7u, 0xc6e00bf3u, 0xd5a79147u, 0x06ca6351u, 0x14292967u,
+  0x27b70a85u, 0x2e1b2138u, 0x4d2c6dfcu, 0x53380d13u, 0x650a7354u, 0x766a0abbu, 0x81c2c92eu, 0x92722c85u,
+  0xa2bfe8a1u, 0xa81a664bu, 0xc24b8b70u, 0xc76c51a3u, 0xd192e819u, 0xd6990624u, 0xf40e3585u, 0x106aa070u,
+  0x19a4c116u, 0x1e376c08u, 0x2748774cu, 0x34b0bcb5u, 0x391c0cb3u, 0x4ed8aa4au, 0x5b9cca4fu, 0x682e6ff3u,
+  0x748f82eeu, 0x78a5636fu, 0x84c87814u, 0x8cc70208u, 0x90befffau, 0xa4506cebu, 0xbef9a3f7u, 0xc67178f2u
+};
+
+/* One spare byte in front, so that the message can start at an odd address */
+static Uint8_t message[MESSAGE_BYTES + 8u] __attribute__((aligned(64)));
+
+static Uint32_t randomState = 256u;
+
+/* Results of the benchmark loops, kept so that they are not optimised out */
+static volatile Uint8_t benchSink;
+
+/***** Function Definitions *********************************************/
+
+static Uint32_t randomNumber(const Uint32_t range)
+{
+  randomState = (randomState * 1664525u) + 1013904223u;
+
+  return (randomState >> 8u) % range;
+}
+
+static Uint32_t modelRotate(const Uint32_t value, const Uint32_t count)
+{
+  return (value >> count) | (value << (32u - count));
+}
+
+/* The compression function as originally implemented: four passes of a 16 round loop, the variables moved each round */
+static void modelConsumeChunk(Uint32_t * const h, const Uint8_t * const p)
+{
+  Uint32_t ah[8];
+  Uint32_t w[16];
+
+  for (Uint32_t i = 0u; i < 8u; i++)
+  {
+    ah[i] = h[i];
+  }
+
+  for (Uint32_t i = 0u; i < 4u; i++)
+  {
+    for (Uint32_t j = 0u; j < 16u; j++)
+    {
+      if (i == 0u)
+      {
+        w[j] = ((Uint32_t)p[j * 4u] << 24u) | ((Uint32_t)p[1u + (j * 4u)] << 16u) | ((Uint32_t)p[2u + (j * 4u)] << 8u) |
+               (Uint32_t)p[3u + (j * 4u)];
+      }
+      else
+      {
+        const Uint32_t s0 = modelRotate(w[(j + 1u) & 0xfu], 7u) ^ modelRotate(w[(j + 1u) & 0xfu], 18u) ^
+                            (w[(j + 1u) & 0xfu] >> 3u);
+        const Uint32_t s1 = modelRotate(w[(j + 14u) & 0xfu], 17u) ^ modelRotate(w[(j + 14u) & 0xfu], 19u) ^
+                            (w[(j + 14u) & 0xfu] >> 10u);
+        w[j] = w[j] + s0 + w[(j + 9u) & 0xfu] + s1;
+      }
+      const Uint32_t s1 = modelRotate(ah[4], 6u) ^ modelRotate(ah[4], 11u) ^ modelRotate(ah[4], 25u);
+      const Uint32_t ch = (ah[4] & ah[5]) ^ (~ah[4] & ah[6]);
+      const Uint32_t temp1 = ah[7] + s1 + ch + roundConstants[(i << 4u) | j] + w[j];
+      const Uint32_t s0 = modelRotate(ah[0], 2u) ^ modelRotate(ah[0], 13u) ^ modelRotate(ah[0], 22u);
+      const Uint32_t maj = (ah[0] & ah[1]) ^ (ah[0] & ah[2]) ^ (ah[1] & ah[2]);
+      const Uint32_t temp2 = s0 + maj;
+
+      ah[7] = ah[6];
+      ah[6] = ah[5];
+      ah[5] = ah[4];
+      ah[4] = ah[3] + temp1;
+      ah[3] = ah[2];
+      ah[2] = ah[1];
+      ah[1] = ah[0];
+      ah[0] = temp1 + temp2;
+    }
+  }
+
+  for (Uint32_t i = 0u; i < 8u; i++)
+  {
+    h[i] += ah[i];
+  }
+}
+
+/* Hash of a message with the original compression function */
+static void modelCalculate(Uint8_t hash[SIZE_OF_SHA_256_HASH], const Uint8_t * const pData, const Uint32_t length)
+{
+  Uint32_t h[8] = {0x6a09e667u, 0xbb67ae85u, 0x3c6ef372u, 0xa54ff53au, 0x510e527fu, 0x9b05688cu, 0x1f83d9abu,
+                   0x5be0cd19u};
+  Uint8_t chunk[2u * SIZE_OF_SHA_256_CHUNK];
+  Uint32_t whole = length & ~(SIZE_OF_SHA_256_CHUNK - 1u);
+  Uint32_t tail = length - whole;
+  Uint32_t padded = ((tail + 1u + 8u) <= SIZE_OF_SHA_256_CHUNK) ? SIZE_OF_SHA_256_CHUNK : (2u * SIZE_OF_SHA_256_CHUNK);
+  Uint64_t bits = (Uint64_t)length * 8u;
+
+  for (Uint32_t offset = 0u; offset < whole; offset += SIZE_OF_SHA_256_CHUNK)
+  {
+    modelConsumeChunk(h, &pData[offset]);
+  }
+
+  memset(chunk, 0, sizeof(chunk));
+  memcpy(chunk, &pData[whole], tail);
+  chunk[tail] = 0x80u;
+  for (Uint32_t i = 0u; i < 8u; i++)
+  {
+    chunk[padded - 1u - i] = (Uint8_t)(bits >> (8u * i));
+  }
+  for (Uint32_t offset = 0u; offset < padded; offset += SIZE_OF_SHA_256_CHUNK)
+  {
+    modelConsumeChunk(h, &chunk[offset]);
+  }
+
+  for (Uint32_t i = 0u; i < 8u; i++)
+  {
+    hash[i * 4u] = (Uint8_t)(h[i] >> 24u);
+    hash[(i * 4u) + 1u] = (Uint8_t)(h[i] >> 16u);
+    hash[(i * 4u) + 2u] = (Uint8_t)(h[i] >> 8u);
+    hash[(i * 4u) + 3u] = (Uint8_t)h[i];
+  }
+}
+
+static void testKnownAnswers(void)
+{
+  Sha256_t sha;
+  Uint8_t hash[SIZE_OF_SHA_256_HASH];
+
+  TEST_CHECK_EQUAL(d_SHA256_Initialise(), d_STATUS_SUCCESS);
+
+  for (Uint32_t index = 0u; index < (sizeof(knownAnswers) / sizeof(KnownAnswer_t)); index++)
+  {
+    const KnownAnswer_t * pAnswer = &knownAnswers[index];
+    Uint32_t length = (Uint32_t)strlen(pAnswer->pMessage);
+
+    d_SHA256_Init(&sha, hash);
+    for (Uint32_t repeat = 0u; repeat < pAnswer->repeat; repeat++)
+    {
+      d_SHA256_Write(&sha, (const Uint8_t *)pAnswer->pMessage, length);
+    }
+    TEST_CHECK(d_SHA256_Close(&sha) == hash);
+    TEST_CHECK(memcmp(hash, pAnswer->hash, SIZE_OF_SHA_256_HASH) == 0);
+
+    if (pAnswer->repeat == 1u)
+    {
+      memset(hash, 0, sizeof(hash));
+      d_SHA256_Calculate(hash, (const Uint8_t *)pAnswer->pMessage, length);
+      TEST_CHECK(memcmp(hash, pAnswer->hash, SIZE_OF_SHA_256_HASH) == 0);
+      modelCalculate(hash, (const Uint8_t *)pAnswer->pMessage, length);
+      TEST_CHECK(memcmp(hash, pAnswer->hash, SIZE_OF_SHA_256_HASH) == 0);
+    }
+    ELSE_DO_NOTHING
+  }
+}
+
+/* Messages written in pieces, which the original lost after a whole chunk, give the hash of one write */
+static void testPieces(void)
+{
+  Sha256_t sha;
+  Uint8_t single[SIZE_OF_SHA_256_HASH];
+  Uint8_t pieces[SIZE_OF_SHA_256_HASH];
+  Uint8_t model[SIZE_OF_SHA_256_HASH];
+  Uint32_t failures = 0u;
+
+  for (Uint32_t offset = 0u; offset < 4u; offset++)
+  {
+    const Uint8_t * pData = &message[offset];
+
+    /* Fixed piece sizes, then random ones, over messages of up to three chunks and a long one */
+    for (Uint32_t piece = 1u; piece <= PIECE_MAX; piece++)
+    {
+      Uint32_t length = (piece < 64u) ? (piece * 3u) : ((piece * 7u) + offset);
+
+      d_SHA256_Calculate(single, pData, length);
+      modelCalculate(model, pData, length);
+      d_SHA256_Init(&sha, pieces);
+      for (Uint32_t written = 0u; written < length; written += piece)
+      {
+        d_SHA256_Write(&sha, &pData[written], ((length - written) < piece) ? (length - written) : piece);
+      }
+      (void)d_SHA256_Close(&sha);
+      if ((memcmp(single, pieces, SIZE_OF_SHA_256_HASH) != 0) || (memcmp(single, model, SIZE_OF_SHA_256_HASH) != 0))
+      {
+        failures++;
+      }
+      ELSE_DO_NOTHING
+    }
+
+    for (Uint32_t trial = 0u; trial < 200u; trial++)
+    {
+      Uint32_t length = randomNumber(MESSAGE_BYTES / 4u);
+      Uint32_t written = 0u;
+
+      d_SHA256_Calculate(single, pData, length);
+      d_SHA256_Init(&sha, pieces);
+      while (written < length)
+      {
+        Uint32_t piece = randomNumber(4u * SIZE_OF_SHA_256_CHUNK) + 1u;
+
+        piece = ((length - written) < piece) ? (length - written) : piece;
+        d_SHA256_Write(&sha, &pData[written], piece);
+        written += piece;
+      }
+      (void)d_SHA256_Close(&sha);
+      modelCalculate(model, pData, length);
+      if ((memcmp(single, pieces, SIZE_OF_SHA_256_HASH) != 0) || (memcmp(single, model, SIZE_OF_SHA_256_HASH) != 0))
+      {
+        failures++;
+      }
+      ELSE_DO_NOTHING
+    }
+  }
+
+  TEST_CHECK_EQUAL(failures, 0u);
+}
+
+/* Runs a background verification to its end, returning the number of calls */
+static Uint32_t verifyRun(const Uint8_t * const pData, const Uint32_t length, const Uint8_t expected[SIZE_OF_SHA_256_HASH])
+{
+  d_SHA256_VerifyState_t state = d_SHA256_VERIFY_IDLE;
+  Uint32_t calls = 0u;
+  Bool_t incomplete;
+
+  TEST_CHECK_EQUAL(d_SHA256_VerifyStart(pData, length, expected), d_STATUS_SUCCESS);
+  TEST_CHECK_EQUAL(d_SHA256_VerifyStart(pData, length, expected), d_STATUS_DEVICE_BUSY);
+  do
+  {
+    (void)d_SHA256_VerifyStatus(&state);
+    TEST_CHECK_EQUAL(state, d_SHA256_VERIFY_BUSY);
+    incomplete = d_SHA256_VerifyBackground();
+    calls++;
+  } while ((incomplete == d_TRUE) && (calls <= (length / d_SHA256_VERIFY_SLICE_BYTES) + 1u));
+
+  /* Nothing more is done once the verification has completed */
+  TEST_CHECK_EQUAL(d_SHA256_VerifyBackground(), d_FALSE);
+
+  return calls;
+}
+
+static void testVerify(void)
+{
+  Uint8_t expected[SIZE_OF_SHA_256_HASH];
+  d_SHA256_VerifyState_t state = d_SHA256_VERIFY_BUSY;
+  Uint32_t length = MESSAGE_BYTES - 123u;
+  Uint32_t slices = (length + d_SHA256_VERIFY_SLICE_BYTES - 1u) / d_SHA256_VERIFY_SLICE_BYTES;
+
+  host_Reset();
+  (void)d_SHA256_Initialise();
+  (void)d_SHA256_VerifyStatus(&state);
+  TEST_CHECK_EQUAL(state, d_SHA256_VERIFY_IDLE);
+  TEST_CHECK_EQUAL(d_SHA256_VerifyBackground(), d_FALSE);
+
+  d_SHA256_Calculate(expected, &message[1], length);
+  TEST_CHECK_EQUAL(verifyRun(&message[1], length, expected), slices);
+  (void)d_SHA256_VerifyStatus(&state);
+  TEST_CHECK_EQUAL(state, d_SHA256_VERIFY_PASS);
+  TEST_CHECK_EQUAL(host_ErrorCount, 0u);
+
+  /* A byte changed in the last slice */
+  message[length - 1u] ^= 0x01u;
+  TEST_CHECK_EQUAL(verifyRun(&message[1], length, expected), slices);
+  message[length - 1u] ^= 0x01u;
+  (void)d_SHA256_VerifyStatus(&state);
+  TEST_CHECK_EQUAL(state, d_SHA256_VERIFY_FAIL);
+  TEST_CHECK_EQUAL(host_ErrorCount, 1u);
+  TEST_CHECK_EQUAL(host_ErrorLast, d_STATUS_BIT_FAILURE);
+
+  /* The empty block completes on the first call */
+  d_SHA256_Calculate(expected, message, 0u);
+  TEST_CHECK_EQUAL(verifyRun(message, 0u, expected), 1u);
+  (void)d_SHA256_VerifyStatus(&state);
+  TEST_CHECK_EQUAL(state, d_SHA256_VERIFY_PASS);
+
+  TEST_CHECK_EQUAL(d_SHA256_VerifyStart(NULL, length, expected), d_STATUS_INVALID_PARAMETER);
+  TEST_CHECK_EQUAL(d_SHA256_VerifyStart(message, length, NULL), d_STATUS_INVALID_PARAMETER);
+  TEST_CHECK_EQUAL(d_SHA256_VerifyStatus(NULL), d_STATUS_INVALID_PARAMETER);
+}
+
+static Float64_t benchRate(const Bool_t model, const Uint32_t length)
+{
+  Uint8_t hash[SIZE_OF_SHA_256_HASH];
+  Uint32_t repeats = BENCH_BYTES / length;
+
+  Float64_t start = testSeconds();
+  for (Uint32_t i = 0u; i < repeats; i++)
+  {
+    if (model == d_TRUE)
+    {
+      modelCalculate(hash, message, length);
+    }
+    else
+    {
+      d_SHA256_Calculate(hash, message, length);
+    }
+    benchSink ^= hash[0];
+  }
+
+  return ((Float64_t)repeats * (Float64_t)length) / ((testSeconds() - start) * 1.0e6);
+}
+
+static void benchmark(void)
+{
+  static const Uint32_t lengths[] = {64u, 1024u, d_SHA256_VERIFY_SLICE_BYTES, MESSAGE_BYTES};
+
+  printf("  %10s %12s %12s\n", "bytes", "rolled MB/s", "MB/s");
+  for (Uint32_t i = 0u; i < (sizeof(lengths) / sizeof(lengths[0])); i++)
+  {
+    Float64_t rolled = benchRate(d_TRUE, lengths[i]);
+    Float64_t unrolled = benchRate(d_FALSE, lengths[i]);
+
+    printf("  %10u %12.1f %12.1f\n", lengths[i], rolled, unrolled);
+  }
+}
+
+int main(void)
+{
+  for (Uint32_t i = 0u; i < sizeof(message); i++)
+  {
+    message[i] = (Uint8_t)randomNumber(256u);
+  }
+
+  host_Reset();
+  testKnownAnswers();
+  testPieces();
+  testVerify();
+  benchmark();
+
+  return TEST_RESULT();
+}
@@ -0,0 +1,344 @@
+/*********************************************************************//**
+\file
+\brief
+  Module Title       : Shared memory interface ring test
+
+  Abstract           : Runs the producer and the consumer of each shared
+                       memory ring in separate threads. The RPU side uses
+                       the in-place and the copying interfaces, the APU
+                       side is played by the bridge functions. Every
+                       message carries its sequence number and a pattern
+                       derived from it, and the consumer checks that each
+                       arrives once, in order, with its length and
+                       contents intact. The messages per second of each
+                       interface are measured. For the ordering checks an
+                       interval timer makes the threads give up the
+                       processor at arbitrary points, as on a single core
+                       host they would otherwise only switch when the ring
+                       is full or empty. The rates are measured without
+                       the timer. The test is
+                       also built with a 256 byte ring, so that the rings
+                       wrap and fill continually.
+*************************************************************************/
+
+/***** Includes *********************************************************/
+
+#include <pthread.h>
+#include <sched.h>
+#include <signal.h>
+#include <stdio.h>
+#include <string.h>
+#include <sys/time.h>
+
+#include "soc/defines/d_common_types.h"
+#include "soc/defines/d_common_status.h"
+#include "soc/interrupt_manager/d_int_irq_handler.h"
+#include "kernel/shared_memory/d_smi.h"
+#include "host_stubs.h"
+#include "test_common.h"
+
+/***** Constants ********************************************************/
+
+#define MESSAGES          400000u
+
+/* Message lengths run from the sequence number word to a quarter of the largest message */
+#define LENGTH_MIN        4u
+#define LENGTH_SPAN       ((d_SMI_MAX_MESSAGE / 4u) - LENGTH_MIN)
+
+/* Every nth message is committed urgently */
+#define URGENT_INTERVAL   16u
+
+/* Period of the timer preempting the threads */
+#define PREEMPT_US        20
+
+/***** Type Definitions *************************************************/
+
+typedef enum
+{
+  DIRECTION_TRANSMIT,
+  DIRECTION_RECEIVE
+} Direction_t;
+
+typedef struct
+{
+  Direction_t direction;
+  Bool_t inPlace;
+  Uint32_t messages;
+  /* Results of the consumer */
+  Uint32_t received;
+  Uint32_t outOfOrder;
+  Uint32_t corrupt;
+  Uint32_t producerWaits;
+  Uint32_t consumerWaits;
+  /* Set by a consumer that cannot continue */
+  volatile Bool_t stopped;
+} Run_t;
+
+/***** Variables ********************************************************/
+
+/* Interrupts raised to the APU, only the transmit producer raises them */
+static Uint32_t ipiCount;
+
+/***** Function Definitions *********************************************/
+
+void d_INT_Ipi(void)
+{
+  ipiCount++;
+}
+
+/* The interrupted thread gives up the processor to the other end of the ring */
+static void preempt(int signalNumber)
+{
+  (void)sched_yield();
+}
+
+static void preemptTimer(const Bool_t enable)
+{
+  struct itimerval timer = {{0, 0}, {0, 0}};
+  struct sigaction action;
+
+  memset(&action, 0, sizeof(action));
+  action.sa_handler = preempt;
+  action.sa_flags = SA_RESTART;
+  (void)sigaction(SIGALRM, &action, NULL);
+  if (enable == d_TRUE)
+  {
+    timer.it_interval.tv_usec = PREEMPT_US;
+    timer.it_value.tv_usec = PREEMPT_US;
+  }
+  ELSE_DO_NOTHING
+  (void)setitimer(ITIMER_REAL, &timer, NULL);
+}
+
+static Uint32_t messageLength(const Uint32_t sequence)
+{
+  return LENGTH_MIN + ((sequence * 37u) % (LENGTH_SPAN + 1u));
+}
+
+static void messageFill(Uint8_t * const pData, const Uint32_t sequence)
+{
+  Uint32_t length = messageLength(sequence);
+
+  memcpy(pData, &sequence, sizeof(sequence));
+  for (Uint32_t i = sizeof(sequence); i < length; i++)
+  {
+    pData[i] = (Uint8_t)((sequence + i) * 31u);
+  }
+}
+
+/* The message must be the next in sequence, with the length and pattern of its sequence number */
+static void messageCheck(Run_t * const pRun, const Uint8_t * const pData, const Uint32_t length)
+{
+  Uint32_t sequence;
+  Bool_t intact = d_TRUE;
+
+  memcpy(&sequence, pData, sizeof(sequence));
+  if (sequence != pRun->received)
+  {
+    pRun->outOfOrder++;
+  }
+  ELSE_DO_NOTHING
+
+  if (length != messageLength(sequence))
+  {
+    intact = d_FALSE;
+  }
+  else
+  {
+    for (Uint32_t i = sizeof(sequence); i < length; i++)
+    {
+      if (pData[i] != (Uint8_t)((sequence + i) * 31u))
+      {
+        intact = d_FALSE;
+      }
+      ELSE_DO_NOTHING
+    }
+  }
+  if (intact == d_FALSE)
+  {
+    pRun->corrupt++;
+  }
+  ELSE_DO_NOTHING
+  pRun->received++;
+}
+
+/* Writes the messages to the ring, waiting while it is full */
+static void * producer(void * pArgument)
+{
+  Run_t * pRun = (Run_t *)pArgument;
+  Uint8_t message[d_SMI_MAX_MESSAGE];
+  Uint8_t * pMessage;
+  d_Status_t status;
+
+  for (Uint32_t sequence = 0u; sequence < pRun->messages; sequence++)
+  {
+    Uint32_t length = messageLength(sequence);
+
+    do
+    {
+      if (pRun->direction == DIRECTION_RECEIVE)
+      {
+        messageFill(message, sequence);
+        status = d_SMI_BridgeReceiveWrite(message, length);
+      }
+      else if (pRun->inPlace == d_TRUE)
+      {
+        status = d_SMI_TransmitReserve(length, &pMessage);
+        if (status == d_STATUS_SUCCESS)
+        {
+          messageFill(pMessage, sequence);
+          status = d_SMI_TransmitCommit(length, ((sequence % URGENT_INTERVAL) == 0u) ? d_TRUE : d_FALSE);
+        }
+        ELSE_DO_NOTHING
+      }
+      else
+      {
+        messageFill(message, sequence);
+        status = d_SMI_Transmit(message, length);
+      }
+
+      if (status == d_STATUS_BUFFER_FULL)
+      {
+        pRun->producerWaits++;
+        (void)sched_yield();
+      }
+      ELSE_DO_NOTHING
+    } while ((status == d_STATUS_BUFFER_FULL) && (pRun->stopped == d_FALSE));
+  }
+
+  return NULL;
+}
+
+/* Reads the messages from the ring, waiting while it is empty */
+static void * consumer(void * pArgument)
+{
+  Run_t * pRun = (Run_t *)pArgument;
+  Uint8_t message[d_SMI_MAX_MESSAGE];
+  const Uint8_t * pMessage;
+  Uint32_t length;
+  d_Status_t status;
+
+  while ((pRun->received < pRun->messages) && (pRun->stopped == d_FALSE))
+  {
+    if (pRun->direction == DIRECTION_TRANSMIT)
+    {
+      status = d_SMI_BridgeTransmitPeek(&pMessage, &length);
+      if (status == d_STATUS_SUCCESS)
+      {
+        messageCheck(pRun, pMessage, length);
+        (void)d_SMI_BridgeTransmitConsume();
+      }
+      ELSE_DO_NOTHING
+    }
+    else if (pRun->inPlace == d_TRUE)
+    {
+      status = d_SMI_ReceivePeek(&pMessage, &length);
+      if (status == d_STATUS_SUCCESS)
+      {
+        messageCheck(pRun, pMessage, length);
+        (void)d_SMI_ReceiveConsume();
+      }
+      ELSE_DO_NOTHING
+    }
+    else
+    {
+      status = d_SMI_Receive(message, &length);
+      if (status == d_STATUS_SUCCESS)
+      {
+        messageCheck(pRun, message, length);
+      }
+      ELSE_DO_NOTHING
+    }
+
+    if (status == d_STATUS_BUFFER_EMPTY)
+    {
+      pRun->consumerWaits++;
+      (void)sched_yield();
+    }
+    else if (status != d_STATUS_SUCCESS)
+    {
+      /* A corrupt record has been discarded with the rest of the ring, the test cannot complete */
+      printf("consumer status %d after %u messages\n", status, pRun->received);
+      pRun->corrupt++;
+      pRun->stopped = d_TRUE;
+    }
+    ELSE_DO_NOTHING
+  }
+
+  return NULL;
+}
+
+/* Passes the messages through one ring with a thread at each end */
+static void run(const Direction_t direction, const Bool_t inPlace, const Bool_t preempted, const Char_t * const name)
+{
+  Run_t ringRun = {direction, inPlace, MESSAGES, 0u, 0u, 0u, 0u, 0u, d_FALSE};
+  sigset_t alarm;
+  d_SMI_Stats_t stats;
+  pthread_t producerThread;
+  pthread_t consumerThread;
+  Uint32_t remaining = 1u;
+
+  host_Reset();
+  d_SMI_Initialise();
+  ipiCount = 0u;
+
+  Float64_t start = testSeconds();
+  TEST_CHECK_EQUAL(pthread_create(&consumerThread, NULL, consumer, &ringRun), 0);
+  TEST_CHECK_EQUAL(pthread_create(&producerThread, NULL, producer, &ringRun), 0);
+  /* The timer signal is taken by whichever of the two threads is running */
+  (void)sigemptyset(&alarm);
+  (void)sigaddset(&alarm, SIGALRM);
+  (void)pthread_sigmask(SIG_BLOCK, &alarm, NULL);
+  preemptTimer(preempted);
+  (void)pthread_join(producerThread, NULL);
+  (void)pthread_join(consumerThread, NULL);
+  preemptTimer(d_FALSE);
+  (void)pthread_sigmask(SIG_UNBLOCK, &alarm, NULL);
+  Float64_t seconds = testSeconds() - start;
+
+  printf("  %-26s %10.0f %10u %10u\n", name, (Float64_t)ringRun.received / seconds, ringRun.producerWaits,
+         ringRun.consumerWaits);
+
+  TEST_CHECK_EQUAL(ringRun.received, MESSAGES);
+  TEST_CHECK_EQUAL(ringRun.outOfOrder, 0u);
+  TEST_CHECK_EQUAL(ringRun.corrupt, 0u);
+  TEST_CHECK_EQUAL(host_ErrorCount, 0u);
+
+  (void)d_SMI_GetStats(&stats);
+  if (direction == DIRECTION_TRANSMIT)
+  {
+    /* Each interrupt follows an urgent message or a batch, the remainder waits for the doorbell */
+    TEST_CHECK_EQUAL(stats.transmitted, MESSAGES);
+    TEST_CHECK_EQUAL(stats.doorbells, ipiCount);
+    TEST_CHECK(ipiCount <= ((inPlace == d_TRUE) ? ((MESSAGES / URGENT_INTERVAL) + (MESSAGES / d_SMI_DOORBELL_BATCH))
+                                                : (MESSAGES / d_SMI_DOORBELL_BATCH)));
+    TEST_CHECK(stats.highWater <= d_SMI_RING_SIZE);
+    TEST_CHECK(d_SMI_BridgeTransmitPeek(&(const Uint8_t *){NULL}, &remaining) == d_STATUS_BUFFER_EMPTY);
+  }
+  else
+  {
+    TEST_CHECK_EQUAL(stats.received, MESSAGES);
+    TEST_CHECK_EQUAL(stats.receiveErrors, 0u);
+    (void)d_SMI_ReceiveCount(&remaining);
+    TEST_CHECK_EQUAL(remaining, 0u);
+  }
+}
+
+int main(void)
+{
+  printf("%u byte rings, %u messages of %u to %u bytes\n", d_SMI_RING_SIZE, MESSAGES, LENGTH_MIN,
+         LENGTH_MIN + LENGTH_SPAN);
+  /* Ordering with the threads preempted, then throughput with the threads switching only when they wait */
+  for (Uint32_t pass = 0u; pass < 2u; pass++)
+  {
+    Bool_t preempted = (pass == 0u) ? d_TRUE : d_FALSE;
+
+    printf("  %-26s messages/s  full waits empty waits\n", (preempted == d_TRUE) ? "preempted" : "not preempted");
+    run(DIRECTION_TRANSMIT, d_TRUE, preempted, "transmit reserve/commit");
+    run(DIRECTION_TRANSMIT, d_FALSE, preempted, "transmit copy");
+    run(DIRECTION_RECEIVE, d_TRUE, preempted, "receive peek/consume");
+    run(DIRECTION_RECEIVE, d_FALSE, preempted, "receive copy");
+  }
+
+  return TEST_RESULT();
+}
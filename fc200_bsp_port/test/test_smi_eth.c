@@ -0,0 +1,507 @@
+/*********************************************************************//**
+\file
+\brief
+  Module Title       : Shared memory ethernet bridge test
+
+  Abstract           : Runs the bridge over UDP sockets on the loopback
+                       interface against a peer in the test. The peer
+                       checks the sequence, packing and flush time of the
+                       transmit datagrams and the messages they carry. It
+                       sends receive datagrams in order, out of order,
+                       twice, with gaps and after a restart, and the
+                       messages from the receive ring and the bridge
+                       statistics are checked. The memory copy is
+                       replaced so that a copy made in a critical section
+                       is detected, and so that a datagram can arrive
+                       while another is being delivered, as it would from
+                       an interrupt.
+*************************************************************************/
+
+/***** Includes *********************************************************/
+
+#include <arpa/inet.h>
+#include <fcntl.h>
+#include <netinet/in.h>
+#include <stdio.h>
+#include <string.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include "soc/defines/d_common_types.h"
+#include "soc/defines/d_common_status.h"
+#include "soc/interrupt_manager/d_int_irq_handler.h"
+#include "kernel/general/d_gen_memory.h"
+#include "sru/ethernet/d_eth_interface.h"
+#include "kernel/shared_memory/d_smi.h"
+#include "kernel/shared_memory/d_smi_eth.h"
+#include "host_stubs.h"
+#include "test_common.h"
+
+/***** Constants ********************************************************/
+
+#define BRIDGE_PORT       47001u
+#define PEER_PORT         47002u
+#define FLUSH_US          1000u
+
+#define BRIDGE_MAGIC      0x31424D53u
+#define HEADER_SIZE       12u
+
+/* Messages sent in the transmit test */
+#define TX_MESSAGES       2000u
+
+/* Messages in each receive datagram */
+#define RX_PER_DATAGRAM   3u
+
+/***** Variables ********************************************************/
+
+static int bridgeSocket = -1;
+static int peerSocket = -1;
+static d_ETH_UdpReceiveFunc_t bridgeCallback;
+static Uint32_t loopback;
+
+/* Copies made in a critical section, and the largest */
+static Uint32_t criticalCopies;
+static Uint32_t criticalCopyMax;
+
+/* Deliver the next datagram from the socket during the next large copy, as an interrupt would */
+static Bool_t nestOnCopy;
+static Uint32_t nestedDeliveries;
+
+/* Next message expected by the peer and by the receive ring */
+static Uint32_t peerExpected;
+static Uint32_t peerDatagrams;
+static Uint32_t peerErrors;
+static Uint32_t ringExpected;
+
+/* Messages read from the receive ring that were the next in sequence */
+static Uint32_t ringReceived;
+
+/***** Function Declarations ********************************************/
+
+static void ethTick(void);
+static void ringRead(void);
+
+/***** Function Definitions *********************************************/
+
+void d_INT_Ipi(void)
+{
+}
+
+void d_GEN_MemoryCopy(Uint8_t * const pDestination, const Uint8_t * const pSource, const Uint32_t length)
+{
+  if (host_CriticalDepth > 0)
+  {
+    criticalCopies++;
+    criticalCopyMax = (length > criticalCopyMax) ? length : criticalCopyMax;
+  }
+  ELSE_DO_NOTHING
+
+  /* Deliveries to the receive ring are the copies of messages, larger than the headers */
+  if ((nestOnCopy == d_TRUE) && (length > HEADER_SIZE))
+  {
+    nestOnCopy = d_FALSE;
+    nestedDeliveries++;
+    ethTick();
+  }
+  ELSE_DO_NOTHING
+
+  memcpy(pDestination, pSource, length);
+}
+
+void d_GEN_MemorySet(Uint8_t * const pDestination, const Uint8_t value, const Uint32_t length)
+{
+  memset(pDestination, value, length);
+}
+
+d_Status_t d_ETH_UdpListen(const Uint32_t localPort, d_ETH_UdpReceiveFunc_t receiveCallback)
+{
+  struct sockaddr_in address;
+
+  memset(&address, 0, sizeof(address));
+  address.sin_family = AF_INET;
+  address.sin_port = htons((Uint16_t)localPort);
+  address.sin_addr.s_addr = loopback;
+  bridgeSocket = socket(AF_INET, SOCK_DGRAM, 0);
+  (void)fcntl(bridgeSocket, F_SETFL, O_NONBLOCK);
+  if (bind(bridgeSocket, (struct sockaddr *)&address, sizeof(address)) != 0)
+  {
+    return d_STATUS_FAILURE;
+  }
+  bridgeCallback = receiveCallback;
+
+  return d_STATUS_SUCCESS;
+}
+
+d_Status_t d_ETH_UdpSend(const Uint32_t destinationAddress, const Uint32_t destinationPort,
+                         const Uint8_t * const message, const Uint32_t length)
+{
+  struct sockaddr_in address;
+
+  memset(&address, 0, sizeof(address));
+  address.sin_family = AF_INET;
+  address.sin_port = htons((Uint16_t)destinationPort);
+  address.sin_addr.s_addr = destinationAddress;
+
+  return (sendto(bridgeSocket, message, length, 0, (struct sockaddr *)&address, sizeof(address)) == (ssize_t)length) ?
+         d_STATUS_SUCCESS : d_STATUS_FAILURE;
+}
+
+/* Passes one datagram waiting at the bridge socket to the bridge, as the ethernet tick does. Each
+   datagram has its own buffer, as each has its own pbuf, so that a nested call leaves the outer alone. */
+static void ethTick(void)
+{
+  Uint8_t datagram[2048];
+  struct sockaddr_in source;
+  socklen_t sourceLength = sizeof(source);
+
+  ssize_t length = recvfrom(bridgeSocket, datagram, sizeof(datagram), 0, (struct sockaddr *)&source, &sourceLength);
+  if (length >= 0)
+  {
+    bridgeCallback(source.sin_addr.s_addr, ntohs(source.sin_port), BRIDGE_PORT, datagram, (Uint32_t)length);
+  }
+  ELSE_DO_NOTHING
+}
+
+/* Passes the waiting datagrams to the bridge, reading the receive ring after each as the application would */
+static void ethTickAll(void)
+{
+  usleep(1000);
+  for (Uint32_t i = 0u; i < 64u; i++)
+  {
+    ethTick();
+    ringRead();
+  }
+}
+
+static Uint32_t messageLength(const Uint32_t sequence)
+{
+  return 4u + ((sequence * 53u) % 300u);
+}
+
+static void messageFill(Uint8_t * const pData, const Uint32_t sequence)
+{
+  memcpy(pData, &sequence, sizeof(sequence));
+  for (Uint32_t i = sizeof(sequence); i < messageLength(sequence); i++)
+  {
+    pData[i] = (Uint8_t)(sequence ^ (i * 7u));
+  }
+}
+
+static Bool_t messageValid(const Uint8_t * const pData, const Uint32_t length, const Uint32_t sequence)
+{
+  Uint8_t expected[400];
+
+  messageFill(expected, sequence);
+
+  return ((length == messageLength(sequence)) && (memcmp(pData, expected, length) == 0)) ? d_TRUE : d_FALSE;
+}
+
+/* Reads the transmit datagrams at the peer, checking their sequence and messages */
+static void peerReceive(void)
+{
+  Uint8_t datagram[2048];
+  ssize_t length;
+
+  while ((length = recv(peerSocket, datagram, sizeof(datagram), MSG_DONTWAIT)) >= 0)
+  {
+    Uint32_t header[3];
+    Uint32_t offset = HEADER_SIZE;
+
+    memcpy(header, datagram, sizeof(header));
+    if ((header[0] != BRIDGE_MAGIC) || (header[1] != peerDatagrams) || (length > (ssize_t)d_ETH_MAX_UDP_PACKET_DATA))
+    {
+      peerErrors++;
+    }
+    ELSE_DO_NOTHING
+    for (Uint32_t record = 0u; record < header[2]; record++)
+    {
+      Uint32_t messageSize;
+
+      memcpy(&messageSize, &datagram[offset], sizeof(messageSize));
+      if (((offset + 4u + messageSize) > (Uint32_t)length) ||
+          (messageValid(&datagram[offset + 4u], messageSize, peerExpected) == d_FALSE))
+      {
+        peerErrors++;
+        break;
+      }
+      ELSE_DO_NOTHING
+      offset += 4u + ((messageSize + 3u) & ~3u);
+      peerExpected++;
+    }
+    peerDatagrams++;
+  }
+}
+
+/* Sends a receive datagram from the peer holding the messages from first */
+static void peerSend(const Uint32_t sequence, const Uint32_t first, const Uint32_t count)
+{
+  Uint8_t datagram[2048];
+  Uint32_t header[3] = {BRIDGE_MAGIC, sequence, count};
+  Uint32_t offset = HEADER_SIZE;
+  struct sockaddr_in address;
+
+  memcpy(datagram, header, sizeof(header));
+  for (Uint32_t i = 0u; i < count; i++)
+  {
+    Uint32_t length = messageLength(first + i);
+
+    memcpy(&datagram[offset], &length, sizeof(length));
+    messageFill(&datagram[offset + 4u], first + i);
+    offset += 4u + ((length + 3u) & ~3u);
+  }
+
+  memset(&address, 0, sizeof(address));
+  address.sin_family = AF_INET;
+  address.sin_port = htons(BRIDGE_PORT);
+  address.sin_addr.s_addr = loopback;
+  (void)sendto(peerSocket, datagram, offset, 0, (struct sockaddr *)&address, sizeof(address));
+}
+
+/* Sends the datagram of a sequence number, each carrying RX_PER_DATAGRAM messages */
+static void peerSendSequence(const Uint32_t sequence)
+{
+  peerSend(sequence, sequence * RX_PER_DATAGRAM, RX_PER_DATAGRAM);
+}
+
+/* Reads the receive ring, counting the messages that are the next in sequence */
+static void ringRead(void)
+{
+  Uint8_t message[d_SMI_MAX_MESSAGE];
+  Uint32_t length;
+
+  while (d_SMI_Receive(message, &length) == d_STATUS_SUCCESS)
+  {
+    Uint32_t sequence;
+
+    memcpy(&sequence, message, sizeof(sequence));
+    if (sequence >= ringExpected)
+    {
+      /* Messages of datagrams counted as lost are skipped */
+      ringExpected = sequence;
+    }
+    ELSE_DO_NOTHING
+    if (messageValid(message, length, ringExpected) == d_TRUE)
+    {
+      ringReceived++;
+    }
+    ELSE_DO_NOTHING
+    ringExpected++;
+  }
+}
+
+/* Messages received since the last call */
+static Uint32_t ringNew(void)
+{
+  static Uint32_t counted;
+  Uint32_t count;
+
+  ringRead();
+  count = ringReceived - counted;
+  counted = ringReceived;
+
+  return count;
+}
+
+static void background(void)
+{
+  for (Uint32_t i = 0u; i < 8u; i++)
+  {
+    (void)d_SMI_EthBridgeBackground();
+  }
+}
+
+static d_SMI_EthBridgeStats_t stats(void)
+{
+  d_SMI_EthBridgeStats_t bridgeStats;
+
+  (void)d_SMI_EthBridgeGetStats(&bridgeStats);
+
+  return bridgeStats;
+}
+
+/* Transmit messages are packed into full datagrams, and a part filled one waits for the flush time */
+static void transmit(void)
+{
+  Uint8_t message[400];
+  Uint32_t sent = 0u;
+
+  while (sent < TX_MESSAGES)
+  {
+    messageFill(message, sent);
+    if (d_SMI_Transmit(message, messageLength(sent)) == d_STATUS_SUCCESS)
+    {
+      sent++;
+    }
+    else
+    {
+      background();
+      peerReceive();
+    }
+  }
+  /* The last datagram is only part filled */
+  background();
+  peerReceive();
+  TEST_CHECK(peerExpected < TX_MESSAGES);
+  host_TimerAdvance(FLUSH_US / 2u);
+  background();
+  peerReceive();
+  TEST_CHECK(peerExpected < TX_MESSAGES);
+  host_TimerAdvance(FLUSH_US);
+  background();
+  usleep(1000);
+  peerReceive();
+
+  TEST_CHECK_EQUAL(peerExpected, TX_MESSAGES);
+  TEST_CHECK_EQUAL(peerErrors, 0u);
+  TEST_CHECK_EQUAL(stats().messagesSent, TX_MESSAGES);
+  TEST_CHECK_EQUAL(stats().datagramsSent, peerDatagrams);
+  /* Average message record about 160 bytes, about nine to a datagram */
+  printf("%u messages in %u datagrams\n", TX_MESSAGES, peerDatagrams);
+  TEST_CHECK(peerDatagrams < (TX_MESSAGES / 6u));
+}
+
+static void receiveOrdered(void)
+{
+  for (Uint32_t sequence = 0u; sequence < 20u; sequence++)
+  {
+    peerSendSequence(sequence);
+  }
+  ethTickAll();
+  TEST_CHECK_EQUAL(ringNew(), 20u * RX_PER_DATAGRAM);
+  TEST_CHECK_EQUAL(stats().datagramsReceived, 20u);
+  TEST_CHECK_EQUAL(stats().messagesReceived, 20u * RX_PER_DATAGRAM);
+}
+
+/* 20, 22, 23, 21, 24 delivered in order, then 22 again is a duplicate */
+static void receiveReordered(void)
+{
+  peerSendSequence(20u);
+  peerSendSequence(22u);
+  peerSendSequence(23u);
+  ethTickAll();
+  TEST_CHECK_EQUAL(ringNew(), RX_PER_DATAGRAM);
+  TEST_CHECK_EQUAL(stats().reordered, 2u);
+
+  peerSendSequence(21u);
+  peerSendSequence(24u);
+  peerSendSequence(22u);
+  ethTickAll();
+  TEST_CHECK_EQUAL(ringNew(), 4u * RX_PER_DATAGRAM);
+  TEST_CHECK_EQUAL(stats().duplicates, 1u);
+  TEST_CHECK_EQUAL(stats().lost, 0u);
+}
+
+/* 25 and 26 missing: 27 is held until the timeout, then 25 and 26 are lost */
+static void receiveTimeout(void)
+{
+  peerSendSequence(27u);
+  ethTickAll();
+  background();
+  TEST_CHECK_EQUAL(ringNew(), 0u);
+  host_TimerAdvance(d_SMI_ETH_REORDER_TIMEOUT_US + 1u);
+  background();
+  TEST_CHECK_EQUAL(ringNew(), RX_PER_DATAGRAM);
+  TEST_CHECK_EQUAL(stats().lost, 2u);
+}
+
+/* 29 held, then 28 + window + 1 is too far ahead: 28 and the gap after 29 are lost at once */
+static void receiveBeyondWindow(void)
+{
+  Uint32_t far = 28u + d_SMI_ETH_REORDER_WINDOW + 1u;
+
+  peerSendSequence(29u);
+  peerSendSequence(far);
+  ethTickAll();
+  TEST_CHECK_EQUAL(ringNew(), 2u * RX_PER_DATAGRAM);
+  TEST_CHECK_EQUAL(stats().lost, 2u + 1u + (far - 30u));
+}
+
+/* The peer restarts at sequence zero */
+static void receiveRestart(void)
+{
+  Uint32_t lost = stats().lost;
+
+  ringExpected = 0u;
+  peerSendSequence(0u);
+  peerSendSequence(1u);
+  ethTickAll();
+  TEST_CHECK_EQUAL(ringNew(), 2u * RX_PER_DATAGRAM);
+  TEST_CHECK_EQUAL(stats().lost, lost);
+}
+
+/* Datagrams arriving while others are delivered are held and released by the delivery in progress */
+static void receiveNested(void)
+{
+  Uint32_t expected = 2u;
+
+  for (Uint32_t round = 0u; round < 50u; round++)
+  {
+    /* In sequence, or with the held datagram released by the interrupted delivery */
+    peerSendSequence(expected);
+    peerSendSequence((round % 2u) == 0u ? expected + 1u : expected + 2u);
+    if ((round % 2u) != 0u)
+    {
+      peerSendSequence(expected + 1u);
+    }
+    ELSE_DO_NOTHING
+    nestOnCopy = d_TRUE;
+    ethTickAll();
+    background();
+    expected += ((round % 2u) == 0u) ? 2u : 3u;
+  }
+  TEST_CHECK_EQUAL(nestedDeliveries, 50u);
+  TEST_CHECK_EQUAL(ringNew(), (expected - 2u) * RX_PER_DATAGRAM);
+  TEST_CHECK_EQUAL(stats().duplicates, 1u);
+}
+
+static void receiveMalformed(void)
+{
+  Uint32_t header[3] = {0x12345678u, 100u, 1u};
+  struct sockaddr_in address;
+  Uint32_t malformed = stats().malformed;
+
+  memset(&address, 0, sizeof(address));
+  address.sin_family = AF_INET;
+  address.sin_port = htons(BRIDGE_PORT);
+  address.sin_addr.s_addr = loopback;
+  (void)sendto(peerSocket, header, sizeof(header), 0, (struct sockaddr *)&address, sizeof(address));
+  (void)sendto(peerSocket, header, 8u, 0, (struct sockaddr *)&address, sizeof(address));
+  ethTickAll();
+  TEST_CHECK_EQUAL(stats().malformed, malformed + 2u);
+}
+
+int main(void)
+{
+  struct sockaddr_in address;
+
+  host_Reset();
+  loopback = inet_addr("127.0.0.1");
+  memset(&address, 0, sizeof(address));
+  address.sin_family = AF_INET;
+  address.sin_port = htons(PEER_PORT);
+  address.sin_addr.s_addr = loopback;
+  peerSocket = socket(AF_INET, SOCK_DGRAM, 0);
+  TEST_CHECK_EQUAL(bind(peerSocket, (struct sockaddr *)&address, sizeof(address)), 0);
+
+  d_SMI_Initialise();
+  TEST_CHECK_EQUAL(d_SMI_EthBridgeStart(loopback, PEER_PORT, BRIDGE_PORT, FLUSH_US), d_STATUS_SUCCESS);
+
+  transmit();
+  receiveOrdered();
+  receiveReordered();
+  receiveTimeout();
+  receiveBeyondWindow();
+  receiveRestart();
+  receiveNested();
+  receiveMalformed();
+
+  printf("%u copies in critical sections, largest %u bytes\n", criticalCopies, criticalCopyMax);
+  TEST_CHECK_EQUAL(criticalCopies, 0u);
+  TEST_CHECK_EQUAL(host_CriticalDepth, 0);
+  TEST_CHECK_EQUAL(host_ErrorCount, 0u);
+
+  (void)close(bridgeSocket);
+  (void)close(peerSocket);
+
+  return TEST_RESULT();
+}
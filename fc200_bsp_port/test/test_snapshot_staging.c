@@ -0,0 +1,516 @@
+/*********************************************************************//**
+\file
+\brief
+  Module Title       : INS snapshot staging benchmark
+
+  Abstract           : Decodes INS frames through the PL UART driver, the
+                       UART service and the INS decoder of the flight
+                       software, then stages the navigation input of the
+                       FCS as fcs_mi does, from the snapshot, and as it
+                       did before the snapshot, from the chain of per
+                       field getters. Both stagings must give the same
+                       input after each frame and after a link timeout,
+                       and the snapshot must only be republished when a
+                       frame is decoded or the link state changes.
+
+                       The cost of each staging is then measured: the
+                       getter chain, the snapshot with a new sequence on
+                       every step and the snapshot with the sequence
+                       unchanged. The UART is a register model of the
+                       16550 core whose FIFO holds a whole frame.
+*************************************************************************/
+
+/***** Includes *********************************************************/
+
+#include <math.h>
+#include <stdarg.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "soc/uart/d_uart.h"
+#include "soc/uart/d_uart_pl.h"
+#include "soc/uart/d_uart_pl_cfg.h"
+#include "soc/interrupt_manager/d_int_irq_handler.h"
+#include "sru/fcu/d_fcu_cfg.h"
+#include "da_ins_il.h"
+#include "da_interface.h"
+#include "fcs_input_sel.h"
+#include "host_stubs.h"
+#include "test_common.h"
+
+/***** Constants ********************************************************/
+
+/* The INS is on the PL UART 24, as in test_ins_latency */
+#define INS_PL_UART        24u
+#define UART_BASE          0x00300000u
+#define UART_CLOCK_HZ      73728000u
+
+/* 16550 registers */
+#define REG_RBR            0x00u
+#define REG_IER            0x04u
+#define REG_IIR            0x08u
+#define REG_LCR            0x0Cu
+#define REG_LSR            0x14u
+
+/* User defined data frame: header, type, identifier, length, payload and checksum */
+#define UDD_PAYLOAD        150u
+#define UDD_DATA           26u
+#define FRAME_BYTES        (UDD_PAYLOAD + 8u)
+
+#define FRAMES             200u
+#define FRAME_US           10000u
+
+#define BENCH_STAGINGS     2000000u
+
+#define DEG2RAD            0.0174532925
+
+/***** Variables ********************************************************/
+
+const d_UART_PL_Configuration_t d_UART_PL_Configuration[] =
+{
+  [INS_PL_UART] = { UART_BASE, UART_CLOCK_HZ, 0u }
+};
+
+d_UART_PL_COUNT;
+
+/* Receive FIFO of the model, large enough for a frame */
+static Uint8_t fifo[FRAME_BYTES];
+static Uint32_t fifoOut;
+static Uint32_t fifoCount;
+static Uint32_t registerIer;
+static Uint32_t registerLcr;
+
+static Bool_t consoleQuiet;
+
+/* Sequence of the last snapshot staged, as kept by fcs_mi */
+static Uint32_t stagedSequence;
+
+/* Stagings of the benchmark, kept so that they are not optimised out */
+static volatile Float64_t benchSink;
+
+/***** Function Definitions *********************************************/
+
+/* Console of the flight software, its printf is printf_ */
+int printf_(const char * format, ...)
+{
+  va_list args;
+  int count = 0;
+
+  if (consoleQuiet == d_FALSE)
+  {
+    va_start(args, format);
+    count = vfprintf(stdout, format, args);
+    va_end(args);
+  }
+  ELSE_DO_NOTHING
+
+  return count;
+}
+
+d_Status_t d_FCU_IocAddressCheck(const Uint32_t address)
+{
+  return d_STATUS_SUCCESS;
+}
+
+d_Status_t d_INT_IrqEnable(const Uint32_t irq)
+{
+  return d_STATUS_SUCCESS;
+}
+
+/* The PS UARTs are not used */
+d_Status_t d_UART_PsConfigure(const Uint32_t uart, const Uint32_t baud, const d_UART_DataBits_t dataBits,
+                              const d_UART_Parity_t parity, const d_UART_StopBits_t stopBits)
+{
+  return d_STATUS_INVALID_MODE;
+}
+
+d_Status_t d_UART_PsSetBaudRate(const Uint32_t uart, const Uint32_t baud)
+{
+  return d_STATUS_INVALID_MODE;
+}
+
+d_Status_t d_UART_PsTransmit(const Uint32_t uart, const Uint8_t * const buffer, const Uint32_t length)
+{
+  return d_STATUS_INVALID_MODE;
+}
+
+d_Status_t d_UART_PsReceive(const Uint32_t uart, Uint8_t * const buffer, const Uint32_t length,
+                            Uint32_t * const pBytesRead)
+{
+  return d_STATUS_INVALID_MODE;
+}
+
+d_Status_t d_UART_PsDiscard(const Uint32_t uart, const Uint32_t length)
+{
+  return d_STATUS_INVALID_MODE;
+}
+
+d_Status_t d_UART_PsFlushRx(const Uint32_t uart)
+{
+  return d_STATUS_INVALID_MODE;
+}
+
+d_Status_t d_UART_PsFlushTx(const Uint32_t uart)
+{
+  return d_STATUS_INVALID_MODE;
+}
+
+d_Status_t d_UART_PsLoopback(const Uint32_t uart, const Bool_t enable)
+{
+  return d_STATUS_INVALID_MODE;
+}
+
+static Uint32_t modelRead(const Uint32_t address)
+{
+  Uint32_t value = 0u;
+
+  switch (address - UART_BASE)
+  {
+    case REG_RBR:
+      if (fifoCount > 0u)
+      {
+        value = fifo[fifoOut];
+        fifoOut++;
+        fifoCount--;
+      }
+      ELSE_DO_NOTHING
+      break;
+
+    case REG_IER:
+      value = registerIer;
+      break;
+
+    case REG_IIR:
+      /* Receive data available, else transmitter empty, else no interrupt */
+      if (((registerIer & 0x01u) != 0u) && (fifoCount > 0u))
+      {
+        value = 0x04u;
+      }
+      else if ((registerIer & 0x02u) != 0u)
+      {
+        value = 0x02u;
+      }
+      else
+      {
+        value = 0x01u;
+      }
+      break;
+
+    case REG_LSR:
+      value = 0x60u | ((fifoCount > 0u) ? 0x01u : 0x00u);
+      break;
+
+    default:
+      break;
+  }
+
+  return value;
+}
+
+static void modelWrite(const Uint32_t address, const Uint32_t value)
+{
+  switch (address - UART_BASE)
+  {
+    case REG_IER:
+      if ((registerLcr & 0x80u) == 0u)
+      {
+        registerIer = value;
+      }
+      ELSE_DO_NOTHING
+      break;
+
+    case REG_LCR:
+      registerLcr = value;
+      break;
+
+    default:
+      /* Transmitted data, divisor, FIFO and modem control */
+      break;
+  }
+}
+
+static void put16(Uint8_t * const pData, const Int32_t value)
+{
+  pData[0] = (Uint8_t)((Uint32_t)value & 0xFFu);
+  pData[1] = (Uint8_t)(((Uint32_t)value >> 8u) & 0xFFu);
+}
+
+static void put32(Uint8_t * const pData, const Int32_t value)
+{
+  put16(pData, (Int32_t)((Uint32_t)value & 0xFFFFu));
+  put16(&pData[2], (Int32_t)((Uint32_t)value >> 16u));
+}
+
+/* User defined data frame whose every signal changes from frame to frame */
+static void encodeFrame(const Uint32_t frame, Uint8_t * const pFrame)
+{
+  Uint8_t * const pPayload = &pFrame[6];
+  Uint8_t * const pData = &pPayload[UDD_DATA];
+  Int32_t n = (Int32_t)frame;
+  Uint16_t checksum = 0u;
+
+  memset(pFrame, 0, FRAME_BYTES);
+
+  pFrame[0] = 0xAAu;
+  pFrame[1] = 0x55u;
+  pFrame[2] = 0x01u;
+  pFrame[3] = 0x95u;
+  put16(&pFrame[4], (Int32_t)(UDD_PAYLOAD + 6u));
+  pPayload[0] = 25u;
+
+  /* Heading, pitch and roll, gyros and accelerometers */
+  put16(&pData[0], (n * 37) % 36000);
+  put16(&pData[2], (n % 900) - 450);
+  put16(&pData[4], 1200 - (n % 2400));
+  put16(&pData[6], n - 100);
+  put16(&pData[8], 50 - n);
+  put16(&pData[10], 3 * n);
+  put16(&pData[12], n);
+  put16(&pData[14], -n);
+  put16(&pData[16], 2000 + n);
+
+  /* Position, velocity east, north and up */
+  put32(&pData[26], 520000000 + (n * 271));
+  put32(&pData[30], -10000000 + (n * 89));
+  put32(&pData[34], 10000 + (n * 20));
+  put32(&pData[38], 1000 + n);
+  put32(&pData[42], 3000 - n);
+  put32(&pData[46], 200 + (n % 7));
+
+  /* Satellites used and GNSS standard deviations */
+  pData[60] = 12u;
+  put16(&pData[109], 100 + n);
+  put16(&pData[111], 100 + n);
+  put16(&pData[113], 150 + n);
+
+  for (Uint32_t index = 2u; index < (FRAME_BYTES - 2u); index++)
+  {
+    checksum = (Uint16_t)(checksum + pFrame[index]);
+  }
+  put16(&pFrame[FRAME_BYTES - 2u], (Int32_t)checksum);
+}
+
+/* A frame arrives, is taken by the interrupt and decoded by the read of the next cycle */
+static void receiveFrame(const Uint32_t frame)
+{
+  encodeFrame(frame, fifo);
+  fifoOut = 0u;
+  fifoCount = FRAME_BYTES;
+  host_TimerAdvance(FRAME_US);
+  d_UART_PlInterruptHandler(INS_PL_UART);
+  da_ins_il_read_periodic();
+}
+
+/* The staging of the INS input before the snapshot, one getter per signal */
+static void stageGetters(fcs_sel_nav_in_t * const pIn)
+{
+  nav_data_t *nav = &pIn->data;
+  float eul_ang[3];
+  float omg[3];
+  float acc[3];
+  double lat, lon;
+  float alt;
+  float v_ned[3];
+  float eph, epv;
+
+  da_get_ins_il_euler_angles(&eul_ang[0], &eul_ang[1], &eul_ang[2]);
+  da_get_ins_il_angular_velocity(&omg[0], &omg[1], &omg[2]);
+  da_get_ins_il_accelerometer_data(&acc[0], &acc[1], &acc[2]);
+  da_get_ins_il_inertial_velocity(&v_ned[0], &v_ned[1], &v_ned[2]);
+
+  for (int i = 0; i < 3; ++i)
+  {
+    nav->eul_ang[i] = eul_ang[i];
+    nav->omg[i] = omg[i];
+    nav->acc[i] = acc[i];
+    nav->v_ned[i] = v_ned[i];
+  }
+
+  da_get_ins_il_position(&lat, &lon, &alt);
+  nav->lat = lat * DEG2RAD;
+  nav->lon = lon * DEG2RAD;
+  nav->alt_gps_amsl = alt;
+
+  da_get_ins_il_eph_epv_data(&eph, &epv);
+  nav->eph = eph;
+  nav->epv = epv;
+
+  nav->att_invalid = da_get_ins_il_att_invalid();
+  nav->omg_invalid = da_get_ins_il_omg_invalid();
+  nav->acc_invalid = da_get_ins_il_accel_invalid();
+  nav->pos_invalid = da_get_ins_il_pos_invalid();
+
+  nav->data_timeout = da_get_ins_il_timeout();
+  pIn->present = !da_get_ins_il_timeout();
+}
+
+/* The staging of fcs_mi, restaged only on a new snapshot */
+static void stageSnapshot(fcs_sel_nav_in_t * const pIn)
+{
+  const s_ins_snapshot_t *ins = da_get_ins_il_snapshot();
+  nav_data_t *nav = &pIn->data;
+
+  if (ins->sequence != stagedSequence)
+  {
+    stagedSequence = ins->sequence;
+
+    for (int i = 0; i < 3; ++i)
+    {
+      nav->eul_ang[i] = ins->euler_rpy[i];
+      nav->omg[i] = ins->omg_xyz[i];
+      nav->acc[i] = ins->acc_xyz[i];
+      nav->v_ned[i] = ins->vel_ned[i];
+    }
+    nav->lat = ins->lat * DEG2RAD;
+    nav->lon = ins->lon * DEG2RAD;
+    nav->alt_gps_amsl = ins->alt_gps;
+    nav->eph = ins->eph;
+    nav->epv = ins->epv;
+
+    nav->att_invalid = ((ins->valid & INS_SNAP_VALID_ATT) == 0U);
+    nav->omg_invalid = ((ins->valid & INS_SNAP_VALID_OMG) == 0U);
+    nav->acc_invalid = ((ins->valid & INS_SNAP_VALID_ACC) == 0U);
+    nav->pos_invalid = ((ins->valid & INS_SNAP_VALID_POS) == 0U);
+    nav->data_timeout = ((ins->valid & INS_SNAP_VALID_LINK) == 0U);
+    pIn->present = ((ins->valid & INS_SNAP_VALID_LINK) != 0U);
+  }
+}
+
+/* The two stagings agree on every signal and flag */
+static Bool_t sameInput(const fcs_sel_nav_in_t * const pA, const fcs_sel_nav_in_t * const pB)
+{
+  const nav_data_t *a = &pA->data;
+  const nav_data_t *b = &pB->data;
+  Bool_t same = (pA->present == pB->present) ? d_TRUE : d_FALSE;
+
+  for (Uint32_t i = 0u; i < 3u; i++)
+  {
+    same = ((a->eul_ang[i] == b->eul_ang[i]) && (a->omg[i] == b->omg[i]) && (a->acc[i] == b->acc[i]) &&
+            (a->v_ned[i] == b->v_ned[i])) ? same : d_FALSE;
+  }
+  same = ((a->lat == b->lat) && (a->lon == b->lon) && (a->alt_gps_amsl == b->alt_gps_amsl) &&
+          (a->eph == b->eph) && (a->epv == b->epv)) ? same : d_FALSE;
+  same = ((a->att_invalid == b->att_invalid) && (a->omg_invalid == b->omg_invalid) &&
+          (a->acc_invalid == b->acc_invalid) && (a->pos_invalid == b->pos_invalid) &&
+          (a->data_timeout == b->data_timeout)) ? same : d_FALSE;
+
+  return same;
+}
+
+static void testStaging(void)
+{
+  const s_ins_snapshot_t *ins = da_get_ins_il_snapshot();
+  fcs_sel_nav_in_t getters;
+  fcs_sel_nav_in_t snapshot;
+  Uint32_t mismatches = 0u;
+  Uint32_t sequence;
+  Float64_t previousYaw = -1.0;
+  Uint32_t yawChanges = 0u;
+
+  memset(&getters, 0, sizeof(getters));
+  memset(&snapshot, 0, sizeof(snapshot));
+
+  consoleQuiet = d_TRUE;
+  TEST_CHECK(da_ins_il_init() == true);
+
+  for (Uint32_t frame = 1u; frame <= FRAMES; frame++)
+  {
+    sequence = ins->sequence;
+    receiveFrame(frame);
+    TEST_CHECK_EQUAL(ins->sequence, sequence + 1u);
+
+    stageGetters(&getters);
+    stageSnapshot(&snapshot);
+    mismatches += (sameInput(&getters, &snapshot) == d_TRUE) ? 0u : 1u;
+    yawChanges += (snapshot.data.eul_ang[2] != previousYaw) ? 1u : 0u;
+    previousYaw = snapshot.data.eul_ang[2];
+
+    /* A cycle with no frame publishes nothing and restages nothing */
+    host_TimerAdvance(1000u);
+    sequence = ins->sequence;
+    da_ins_il_read_periodic();
+    TEST_CHECK_EQUAL(ins->sequence, sequence);
+  }
+  TEST_CHECK_EQUAL(mismatches, 0u);
+  TEST_CHECK_EQUAL(yawChanges, FRAMES);
+  TEST_CHECK(snapshot.present == true);
+  TEST_CHECK_EQUAL(snapshot.data.data_timeout, 0u);
+
+  /* The link times out: one publication, with the link flagged down */
+  host_TimerAdvance(1000000u);
+  sequence = ins->sequence;
+  da_ins_il_read_periodic();
+  TEST_CHECK_EQUAL(ins->sequence, sequence + 1u);
+  da_ins_il_read_periodic();
+  TEST_CHECK_EQUAL(ins->sequence, sequence + 1u);
+
+  stageGetters(&getters);
+  stageSnapshot(&snapshot);
+  TEST_CHECK(sameInput(&getters, &snapshot) == d_TRUE);
+  TEST_CHECK(snapshot.present == false);
+  TEST_CHECK_EQUAL(snapshot.data.data_timeout, 1u);
+
+  /* And recovers with the next frame */
+  receiveFrame(FRAMES + 1u);
+  stageGetters(&getters);
+  stageSnapshot(&snapshot);
+  TEST_CHECK(sameInput(&getters, &snapshot) == d_TRUE);
+  TEST_CHECK(snapshot.present == true);
+  consoleQuiet = d_FALSE;
+}
+
+/* Time per staging of the getter chain and of the snapshot, new and unchanged */
+static void benchmark(void)
+{
+  fcs_sel_nav_in_t in;
+  Float64_t sum = 0.0;
+  Float64_t start;
+  Float64_t gettersNs;
+  Float64_t newNs;
+  Float64_t unchangedNs;
+
+  memset(&in, 0, sizeof(in));
+
+  start = testSeconds();
+  for (Uint32_t i = 0u; i < BENCH_STAGINGS; i++)
+  {
+    stageGetters(&in);
+    sum += in.data.eul_ang[2];
+  }
+  gettersNs = ((testSeconds() - start) * 1.0e9) / (Float64_t)BENCH_STAGINGS;
+
+  /* A new snapshot on every step, as with the INS and the FCS both at 100 Hz */
+  start = testSeconds();
+  for (Uint32_t i = 0u; i < BENCH_STAGINGS; i++)
+  {
+    stagedSequence = ~da_get_ins_il_snapshot()->sequence;
+    stageSnapshot(&in);
+    sum += in.data.eul_ang[2];
+  }
+  newNs = ((testSeconds() - start) * 1.0e9) / (Float64_t)BENCH_STAGINGS;
+
+  start = testSeconds();
+  for (Uint32_t i = 0u; i < BENCH_STAGINGS; i++)
+  {
+    stageSnapshot(&in);
+    sum += in.data.eul_ang[2];
+  }
+  unchangedNs = ((testSeconds() - start) * 1.0e9) / (Float64_t)BENCH_STAGINGS;
+  benchSink = sum;
+
+  printf("ns per INS staging     getters  snapshot new  snapshot unchanged\n");
+  printf("                       %7.1f  %12.1f  %18.1f\n", gettersNs, newNs, unchangedNs);
+}
+
+int main(void)
+{
+  host_Reset();
+  host_RegisterSetModel(modelRead, modelWrite);
+
+  testStaging();
+  benchmark();
+
+  TEST_CHECK_EQUAL(host_ErrorCount, 0u);
+
+  return TEST_RESULT();
+}
@@ -0,0 +1,843 @@
+/*********************************************************************//**
+\file
+\brief
+  Module Title       : PL SPI transaction queue simulation
+
+  Abstract           : Runs the queued transactions of the PL SPI driver
+                       against a register model of the SPI core. The model
+                       clocks each transfer at the channel rate, answers
+                       with bytes tagged by the transfer number, raises the
+                       end of transfer and device interrupts and counts
+                       transfers started while the core is still busy.
+
+                       The cases check that chains run back to back in
+                       order with their callbacks, that direct transfers
+                       and the queue exclude each other, that polling
+                       completes a transaction without the interrupt, and
+                       that a cancelled transaction, queued or active,
+                       never lets the next one start on a busy core or
+                       receive the data of the abandoned transfer. The
+                       AUAV driver is run on the same channel to check its
+                       queued start commands report a failure.
+
+                       A second channel, excluding the command response,
+                       carries a BME280 and a flash MAC device answering
+                       from register files. The model time for which the
+                       CPU is held by a BME280 read, an AUAV read and a
+                       flash MAC read, in the caller and in the interrupt,
+                       is then compared with that of the busy-wait of the
+                       same transfers used before the queue. The model
+                       charges time for the timer reads of the waits only,
+                       not for the register accesses of the drivers.
+*************************************************************************/
+
+/***** Includes *********************************************************/
+
+#include <stdio.h>
+#include <string.h>
+
+#include "soc/interrupt_manager/d_int_irq_handler.h"
+#include "sru/fcu/d_fcu_cfg.h"
+#include "sru/spi_pl/d_spi_pl.h"
+#include "sru/spi_pl/d_spi_pl_cfg.h"
+#include "driver/auav/d_auav.h"
+#include "driver/auav/d_auav_cfg.h"
+#include "driver/bme280/d_bme280.h"
+#include "driver/bme280/d_bme280_cfg.h"
+#include "sru/flash_mac/d_flash_mac.h"
+#include "sru/flash_mac/d_flash_mac_cfg.h"
+#include "soc/timer/d_timer.h"
+#include "host_stubs.h"
+#include "test_common.h"
+
+/***** Constants ********************************************************/
+
+#define CHANNEL            0u
+#define CHANNEL_SENSOR     1u
+#define CHANNEL_COUNT      2u
+#define SPI_BASE           0x00400000u
+#define SPI_STRIDE         0x00010000u
+#define SPI_CLOCK_HZ       1000000u
+
+/* SPI core registers */
+#define REG_STATUS         0x0000u
+#define REG_CTRL           0x0004u
+#define REG_CMD0           0x0008u
+#define REG_CMD1           0x000Cu
+#define REG_IRQ            0x0010u
+#define REG_FIFO           0x0100u
+
+#define IRQ_TRANSFER       0x00001u
+#define IRQ_DEVICE         0x10000u
+
+/* Control register bit excluding the command response from the FIFO */
+#define CTRL_EXCLUDE       0x80u
+
+/* Devices of the first channel, the AUAV channels are devices 2 and 3 */
+#define DEVICE_TEST        0u
+#define DEVICE_AUAV        2u
+
+/* Devices of the second channel */
+#define DEVICE_FLASH       0u
+#define DEVICE_BME280      1u
+
+/* BME280 registers and settings */
+#define BME_ID             0xD0u
+#define BME_DATA           0xF7u
+#define SETTING_CONFIG     0xA0u
+#define SETTING_CTRL_HUM   0x01u
+#define SETTING_CTRL_MEAS  0x27u
+
+/* Flash MAC commands and the size of the reads measured */
+#define FLASH_STATUS       0x05u
+#define FLASH_READ         0x03u
+#define FLASH_READ_BYTES   16u
+
+/* Reads per sensor of the blocked time measurement */
+#define BLOCKED_READS      16u
+
+/* Timeout of the busy-wait, well above the longest transfer measured */
+#define BUSY_WAIT_US       1000u
+
+#define LOG_SIZE           256u
+#define CALLBACK_MAX       16u
+
+/***** Type Definitions *************************************************/
+
+/* Transfer performed by a core */
+typedef struct
+{
+  Uint32_t channel;
+  Uint32_t device;
+  Uint8_t command;
+  Uint64_t startUs;
+  Uint64_t endUs;
+} transfer_t;
+
+/* SPI core of a channel */
+typedef struct
+{
+  Uint32_t command[2];
+  Uint32_t fifo[72];
+  Uint32_t fifoCount;
+  Uint32_t fifoOut;
+  Bool_t busy;
+  Bool_t exclude;
+  Uint32_t cmdCount;
+  Uint32_t bytes;
+  Uint32_t irq;
+  Uint32_t transfer;
+} core_t;
+
+/***** Variables ********************************************************/
+
+const d_SPI_PL_Definition_t d_SPI_PL_Definition[] =
+{
+  { SPI_BASE, SPI_CLOCK_HZ, 121u, d_FALSE, NULL, d_AUAV_InterruptHandler },
+  { SPI_BASE + SPI_STRIDE, SPI_CLOCK_HZ, 122u, d_TRUE, NULL, NULL }
+};
+
+d_SPI_PL_COUNT;
+
+/* Start commands are sent to both channels of sensor 0 */
+const d_AUAV_Config_t d_AUAV_Config[] =
+{
+  { { { CHANNEL, DEVICE_AUAV }, { CHANNEL, DEVICE_AUAV + 1u } }, 24.884f }
+};
+
+d_AUAV_COUNT;
+
+const d_BME280_Definition_t d_BME280_Config[] =
+{
+  { CHANNEL_SENSOR, DEVICE_BME280 }
+};
+
+d_BME280_COUNT;
+
+const d_FLASH_MAC_Definition_t d_FLASH_MAC_Config[] =
+{
+  { CHANNEL_SENSOR, DEVICE_FLASH }
+};
+
+d_FLASH_MAC_COUNT;
+
+static void auavReady(const Uint32_t device);
+
+const d_AUAV_IrqHandler callback = auavReady;
+
+static core_t core[CHANNEL_COUNT];
+static Uint32_t overlaps;
+
+/* Registers of the devices of the second channel, by command byte */
+static Uint8_t sensorRegister[d_SPI_PL_MAX_DEVICES][256];
+
+/* Model time spent in the interrupt handlers */
+static Uint64_t interruptUs;
+
+/* Interrupt line, held off by critical sections and by the test */
+static Bool_t interruptsEnabled;
+
+/* Interface taken offline by the test */
+static Bool_t offline;
+
+static transfer_t transferLog[LOG_SIZE];
+static Uint32_t transferCount;
+
+static Uint32_t callbackTags[CALLBACK_MAX];
+static Uint32_t callbackCount;
+
+static Uint32_t auavReadyCount;
+
+/* Data block of the AUAV, kept by the driver from its first initialisation */
+static d_AUAV_DataBlock_t auavBlock;
+
+static d_SPI_PL_Transaction_t transactions[4];
+static Uint8_t rxData[4][32];
+
+/***** Function Definitions *********************************************/
+
+d_Status_t d_FCU_IocAddressCheck(const Uint32_t address)
+{
+  return (offline == d_TRUE) ? d_STATUS_DEVICE_NOT_READY : d_STATUS_SUCCESS;
+}
+
+d_Status_t d_INT_IrqEnable(const Uint32_t irq)
+{
+  return d_STATUS_SUCCESS;
+}
+
+static void auavReady(const Uint32_t device)
+{
+  auavReadyCount++;
+}
+
+/* Byte of the response of a transfer, tagged with the transfer number */
+static Uint8_t responseByte(const Uint32_t transfer, const Uint32_t index)
+{
+  return (Uint8_t)(((transfer & 0x0Fu) << 4u) | (index & 0x0Fu));
+}
+
+/* Byte of the response of the second channel, from the register file of
+   the device at the first command byte on */
+static Uint8_t sensorByte(const core_t * const pCore, const Uint32_t device, const Uint32_t index)
+{
+  return sensorRegister[device][(pCore->command[0] + index - pCore->cmdCount) & 0xFFu];
+}
+
+/* A core starts a transfer when its control register is written. A write
+   of two command bytes with the top address bit clear sets a register of
+   the second channel */
+static void coreStart(const Uint32_t channel, const Uint32_t control)
+{
+  core_t * const pCore = &core[channel];
+  Uint32_t dataCount = control >> 20u;
+  transfer_t * const pTransfer = &transferLog[transferCount % LOG_SIZE];
+
+  if (pCore->busy == d_TRUE)
+  {
+    overlaps++;
+  }
+  ELSE_DO_NOTHING
+
+  pCore->cmdCount = ((control >> 16u) & 0x7u) + 1u;
+  pCore->bytes = pCore->cmdCount + dataCount;
+  pCore->exclude = ((control & CTRL_EXCLUDE) != 0u) ? d_TRUE : d_FALSE;
+  pCore->busy = d_TRUE;
+  pCore->transfer = transferCount;
+  pTransfer->channel = channel;
+  pTransfer->device = (control >> 5u) & 0x3u;
+  pTransfer->command = (Uint8_t)(pCore->command[0] & 0xFFu);
+  pTransfer->startUs = host_TimerMicroseconds();
+  pTransfer->endUs = pTransfer->startUs + (((Uint64_t)pCore->bytes * 8u * 1000000u) / SPI_CLOCK_HZ);
+  transferCount++;
+
+  if ((channel == CHANNEL_SENSOR) && (pCore->cmdCount == 2u) && ((pTransfer->command & 0x80u) == 0u))
+  {
+    sensorRegister[pTransfer->device][pTransfer->command | 0x80u] = (Uint8_t)((pCore->command[0] >> 8u) & 0xFFu);
+  }
+  ELSE_DO_NOTHING
+}
+
+/* The response goes into the FIFO packed four bytes to a word */
+static void coreUpdate(const Uint32_t channel)
+{
+  core_t * const pCore = &core[channel];
+  const transfer_t * const pTransfer = &transferLog[pCore->transfer % LOG_SIZE];
+
+  if ((pCore->busy == d_TRUE) && (pTransfer->endUs <= host_TimerMicroseconds()))
+  {
+    const Uint32_t first = (pCore->exclude == d_TRUE) ? pCore->cmdCount : 0u;
+
+    pCore->fifoCount = (pCore->bytes - first + 3u) / 4u;
+    pCore->fifoOut = 0u;
+    for (Uint32_t word = 0u; word < pCore->fifoCount; word++)
+    {
+      pCore->fifo[word] = 0u;
+      for (Uint32_t byte = 0u; byte < 4u; byte++)
+      {
+        const Uint32_t index = first + (word * 4u) + byte;
+        const Uint8_t value = (channel == CHANNEL_SENSOR) ? sensorByte(pCore, pTransfer->device, index) :
+                                                            responseByte(pCore->transfer, index);
+        pCore->fifo[word] |= (Uint32_t)value << (byte * 8u);
+      }
+    }
+    pCore->busy = d_FALSE;
+    pCore->irq |= IRQ_TRANSFER;
+  }
+  ELSE_DO_NOTHING
+}
+
+static Uint32_t modelRead(const Uint32_t address)
+{
+  const Uint32_t channel = (address - SPI_BASE) / SPI_STRIDE;
+  core_t * const pCore = &core[channel];
+  Uint32_t value = 0u;
+
+  switch ((address - SPI_BASE) % SPI_STRIDE)
+  {
+    case REG_STATUS:
+      coreUpdate(channel);
+      value = ((pCore->busy == d_TRUE) ? 0x10000u : 0u) | ((pCore->fifoCount - pCore->fifoOut) << 8u);
+      break;
+
+    case REG_IRQ:
+      value = pCore->irq;
+      break;
+
+    case REG_FIFO:
+      if (pCore->fifoOut < pCore->fifoCount)
+      {
+        value = pCore->fifo[pCore->fifoOut];
+        pCore->fifoOut++;
+      }
+      ELSE_DO_NOTHING
+      break;
+
+    default:
+      break;
+  }
+
+  return value;
+}
+
+static void modelWrite(const Uint32_t address, const Uint32_t value)
+{
+  const Uint32_t channel = (address - SPI_BASE) / SPI_STRIDE;
+  core_t * const pCore = &core[channel];
+
+  switch ((address - SPI_BASE) % SPI_STRIDE)
+  {
+    case REG_CMD0:
+      pCore->command[0] = value;
+      break;
+
+    case REG_CMD1:
+      pCore->command[1] = value;
+      break;
+
+    case REG_CTRL:
+      coreStart(channel, value);
+      break;
+
+    case REG_IRQ:
+      pCore->irq = value;
+      break;
+
+    default:
+      /* Transmit data */
+      break;
+  }
+}
+
+/* The transfers end on time and their interrupts are served as soon as they are allowed */
+static void timerHook(void)
+{
+  for (Uint32_t channel = 0u; channel < CHANNEL_COUNT; channel++)
+  {
+    coreUpdate(channel);
+
+    if ((core[channel].irq != 0u) && (interruptsEnabled == d_TRUE) && (host_CriticalDepth == 0))
+    {
+      const Uint64_t startUs = host_TimerMicroseconds();
+      d_SPI_PL_InterruptHandler(channel);
+      interruptUs += host_TimerMicroseconds() - startUs;
+    }
+    ELSE_DO_NOTHING
+  }
+}
+
+static void run(const Uint32_t microseconds)
+{
+  for (Uint32_t us = 0u; us < microseconds; us++)
+  {
+    host_TimerAdvance(1u);
+  }
+}
+
+static void transactionCallback(const Uint32_t channel, const Uint32_t tag)
+{
+  if (callbackCount < CALLBACK_MAX)
+  {
+    callbackTags[callbackCount] = tag;
+  }
+  ELSE_DO_NOTHING
+  callbackCount++;
+}
+
+/* Transaction of a command byte and a number of data bytes, tagged with its index */
+static d_SPI_PL_Transaction_t * transactionSet(const Uint32_t index, const Uint32_t dataCount)
+{
+  d_SPI_PL_Transaction_t * const pTransaction = &transactions[index];
+
+  memset(pTransaction, 0, sizeof(*pTransaction));
+  memset(rxData[index], 0, sizeof(rxData[index]));
+  pTransaction->device = DEVICE_TEST;
+  pTransaction->command[0] = (Uint8_t)(0x10u + index);
+  pTransaction->cmdCount = 1u;
+  pTransaction->dataCount = dataCount;
+  pTransaction->rxBuffer = rxData[index];
+  pTransaction->bufferLength = sizeof(rxData[index]);
+  pTransaction->callback = transactionCallback;
+  pTransaction->tag = index;
+
+  return pTransaction;
+}
+
+/* Transfer of a transaction in the log, LOG_SIZE if it was not performed */
+static Uint32_t transferOf(const Uint32_t index)
+{
+  Uint32_t transfer = LOG_SIZE;
+
+  for (Uint32_t entry = 0u; entry < transferCount; entry++)
+  {
+    if (transferLog[entry].command == (0x10u + index))
+    {
+      transfer = entry;
+    }
+    ELSE_DO_NOTHING
+  }
+
+  return transfer;
+}
+
+/* The transaction received the response of its own transfer */
+static Bool_t responseOwn(const Uint32_t index)
+{
+  Uint32_t transfer = transferOf(index);
+  Bool_t own = (transfer < LOG_SIZE) ? d_TRUE : d_FALSE;
+
+  for (Uint32_t byte = 0u; (own == d_TRUE) && (byte < transactions[index].rxCount); byte++)
+  {
+    own = (rxData[index][byte] == responseByte(transfer, byte)) ? d_TRUE : d_FALSE;
+  }
+
+  return own;
+}
+
+static void startUp(void)
+{
+  host_Reset();
+  host_RegisterSetModel(modelRead, modelWrite);
+  host_TimerSetHook(timerHook);
+  host_TimerSetReadCost(1u);
+
+  memset(core, 0, sizeof(core));
+  memset(sensorRegister, 0, sizeof(sensorRegister));
+  sensorRegister[DEVICE_BME280][BME_ID] = 0x60u;
+  overlaps = 0u;
+  interruptUs = 0u;
+  interruptsEnabled = d_TRUE;
+  offline = d_FALSE;
+  transferCount = 0u;
+  callbackCount = 0u;
+
+  TEST_CHECK_EQUAL(d_SPI_PL_Initialise(CHANNEL), d_STATUS_SUCCESS);
+}
+
+/* A chain and a later transaction run back to back in order */
+static void testChain(void)
+{
+  startUp();
+
+  d_SPI_PL_Transaction_t * const pFirst = transactionSet(0u, 8u);
+  transactionSet(1u, 3u);
+  transactionSet(2u, 16u);
+  transactionSet(3u, 1u);
+  transactions[0].pNext = &transactions[1];
+  transactions[1].pNext = &transactions[2];
+
+  TEST_CHECK_EQUAL(d_SPI_PL_Queue(CHANNEL, pFirst), d_STATUS_SUCCESS);
+  TEST_CHECK_EQUAL(d_SPI_PL_Queue(CHANNEL, &transactions[3]), d_STATUS_SUCCESS);
+  TEST_CHECK_EQUAL(d_SPI_PL_Queue(CHANNEL, &transactions[3]), d_STATUS_DEVICE_BUSY);
+  run(400u);
+
+  TEST_CHECK_EQUAL(transferCount, 4u);
+  TEST_CHECK_EQUAL(callbackCount, 4u);
+  for (Uint32_t index = 0u; index < 4u; index++)
+  {
+    TEST_CHECK_EQUAL(transactions[index].state, d_SPI_PL_TRANSACTION_COMPLETE);
+    TEST_CHECK_EQUAL(transactions[index].rxCount, transactions[index].dataCount + 1u);
+    TEST_CHECK(transactions[index].pNext == NULL);
+    TEST_CHECK_EQUAL(callbackTags[index], index);
+    TEST_CHECK_EQUAL(transferOf(index), index);
+    TEST_CHECK(responseOwn(index) == d_TRUE);
+  }
+
+  /* Each transfer is started by the interrupt of the previous one */
+  for (Uint32_t entry = 1u; entry < transferCount; entry++)
+  {
+    TEST_CHECK(transferLog[entry].startUs <= (transferLog[entry - 1u].endUs + 1u));
+  }
+  TEST_CHECK_EQUAL(overlaps, 0u);
+  TEST_CHECK_EQUAL(host_ErrorCount, 0u);
+}
+
+/* Direct transfers are refused while the queue is in use, queued work waits for a direct result */
+static void testDirect(void)
+{
+  Uint8_t command[2] = { 0x20u, 0x00u };
+  Uint8_t response[2];
+  d_SPI_PL_State_t state;
+  Uint32_t count;
+
+  startUp();
+
+  TEST_CHECK_EQUAL(d_SPI_PL_Transfer(CHANNEL, DEVICE_TEST, command, 2u, NULL, 0u), d_STATUS_SUCCESS);
+  TEST_CHECK_EQUAL(d_SPI_PL_Queue(CHANNEL, transactionSet(0u, 2u)), d_STATUS_SUCCESS);
+  run(100u);
+
+  /* The direct transfer has ended, the transaction waits for its result to be read */
+  TEST_CHECK_EQUAL(transactions[0].state, d_SPI_PL_TRANSACTION_QUEUED);
+  TEST_CHECK_EQUAL(transferCount, 1u);
+  TEST_CHECK_EQUAL(d_SPI_PL_Result(CHANNEL, &state, response, sizeof(response), &count), d_STATUS_SUCCESS);
+  TEST_CHECK_EQUAL(state, d_SPI_PL_STATUS_READY);
+  TEST_CHECK_EQUAL(count, 2u);
+  TEST_CHECK_EQUAL(response[1], responseByte(0u, 1u));
+  TEST_CHECK_EQUAL(transactions[0].state, d_SPI_PL_TRANSACTION_ACTIVE);
+
+  TEST_CHECK_EQUAL(d_SPI_PL_Transfer(CHANNEL, DEVICE_TEST, command, 2u, NULL, 0u), d_STATUS_DEVICE_BUSY);
+  run(100u);
+  TEST_CHECK_EQUAL(transactions[0].state, d_SPI_PL_TRANSACTION_COMPLETE);
+  TEST_CHECK(responseOwn(0u) == d_TRUE);
+  TEST_CHECK_EQUAL(d_SPI_PL_Transfer(CHANNEL, DEVICE_TEST, command, 2u, NULL, 0u), d_STATUS_SUCCESS);
+  run(100u);
+  TEST_CHECK_EQUAL(d_SPI_PL_Result(CHANNEL, &state, response, sizeof(response), &count), d_STATUS_SUCCESS);
+  TEST_CHECK_EQUAL(overlaps, 0u);
+  TEST_CHECK_EQUAL(host_ErrorCount, 0u);
+}
+
+/* Polling completes a transaction with the interrupt held off */
+static void testPoll(void)
+{
+  startUp();
+  interruptsEnabled = d_FALSE;
+
+  TEST_CHECK_EQUAL(d_SPI_PL_Queue(CHANNEL, transactionSet(0u, 4u)), d_STATUS_SUCCESS);
+  TEST_CHECK_EQUAL(d_SPI_PL_Queue(CHANNEL, transactionSet(1u, 4u)), d_STATUS_SUCCESS);
+  run(20u);
+  TEST_CHECK_EQUAL(d_SPI_PL_Poll(CHANNEL), d_STATUS_SUCCESS);
+  TEST_CHECK_EQUAL(transactions[0].state, d_SPI_PL_TRANSACTION_ACTIVE);
+  run(40u);
+  TEST_CHECK_EQUAL(d_SPI_PL_Poll(CHANNEL), d_STATUS_SUCCESS);
+  TEST_CHECK_EQUAL(transactions[0].state, d_SPI_PL_TRANSACTION_COMPLETE);
+  TEST_CHECK_EQUAL(transactions[1].state, d_SPI_PL_TRANSACTION_ACTIVE);
+  TEST_CHECK(responseOwn(0u) == d_TRUE);
+
+  /* The end of the polled transfer is still flagged, it must not complete the next one */
+  interruptsEnabled = d_TRUE;
+  run(100u);
+  TEST_CHECK_EQUAL(transactions[1].state, d_SPI_PL_TRANSACTION_COMPLETE);
+  TEST_CHECK(responseOwn(1u) == d_TRUE);
+  TEST_CHECK_EQUAL(callbackCount, 2u);
+  TEST_CHECK_EQUAL(overlaps, 0u);
+  TEST_CHECK_EQUAL(host_ErrorCount, 0u);
+}
+
+/* A queued transaction is removed without its callback */
+static void testCancelQueued(void)
+{
+  startUp();
+
+  transactionSet(0u, 8u);
+  transactionSet(1u, 8u);
+  transactionSet(2u, 8u);
+  transactions[0].pNext = &transactions[1];
+  transactions[1].pNext = &transactions[2];
+  TEST_CHECK_EQUAL(d_SPI_PL_Queue(CHANNEL, &transactions[0]), d_STATUS_SUCCESS);
+  run(10u);
+  TEST_CHECK_EQUAL(d_SPI_PL_Cancel(CHANNEL, &transactions[1]), d_STATUS_SUCCESS);
+  TEST_CHECK_EQUAL(transactions[1].state, d_SPI_PL_TRANSACTION_FAILED);
+  TEST_CHECK(transactions[1].pNext == NULL);
+  run(300u);
+
+  TEST_CHECK_EQUAL(transactions[0].state, d_SPI_PL_TRANSACTION_COMPLETE);
+  TEST_CHECK_EQUAL(transactions[2].state, d_SPI_PL_TRANSACTION_COMPLETE);
+  TEST_CHECK_EQUAL(transferCount, 2u);
+  TEST_CHECK_EQUAL(callbackCount, 2u);
+  TEST_CHECK_EQUAL(callbackTags[1], 2u);
+  TEST_CHECK(responseOwn(2u) == d_TRUE);
+
+  /* Cancelling a transaction no longer queued leaves it unchanged */
+  TEST_CHECK_EQUAL(d_SPI_PL_Cancel(CHANNEL, &transactions[0]), d_STATUS_SUCCESS);
+  TEST_CHECK_EQUAL(transactions[0].state, d_SPI_PL_TRANSACTION_COMPLETE);
+  TEST_CHECK_EQUAL(overlaps, 0u);
+  TEST_CHECK_EQUAL(host_ErrorCount, 0u);
+}
+
+/* An active transfer cancelled while the core is busy holds the queue until it ends */
+static void testCancelActiveBusy(void)
+{
+  startUp();
+
+  transactionSet(0u, 16u);
+  transactionSet(1u, 4u);
+  transactions[0].pNext = &transactions[1];
+  TEST_CHECK_EQUAL(d_SPI_PL_Queue(CHANNEL, &transactions[0]), d_STATUS_SUCCESS);
+  run(40u);
+  TEST_CHECK_EQUAL(d_SPI_PL_Cancel(CHANNEL, &transactions[0]), d_STATUS_SUCCESS);
+  TEST_CHECK_EQUAL(transactions[0].state, d_SPI_PL_TRANSACTION_FAILED);
+  TEST_CHECK_EQUAL(transactions[1].state, d_SPI_PL_TRANSACTION_QUEUED);
+  TEST_CHECK_EQUAL(transferCount, 1u);
+
+  /* The end of the abandoned transfer starts the next one */
+  run(200u);
+  TEST_CHECK_EQUAL(transferCount, 2u);
+  TEST_CHECK(transferLog[1].startUs >= transferLog[0].endUs);
+  TEST_CHECK_EQUAL(transactions[1].state, d_SPI_PL_TRANSACTION_COMPLETE);
+  TEST_CHECK_EQUAL(transactions[1].rxCount, 5u);
+  TEST_CHECK(responseOwn(1u) == d_TRUE);
+  TEST_CHECK_EQUAL(callbackCount, 1u);
+  TEST_CHECK_EQUAL(callbackTags[0], 1u);
+  TEST_CHECK_EQUAL(overlaps, 0u);
+
+  /* With the interrupt held off the abandoned transfer is discarded by polling */
+  transactionSet(2u, 16u);
+  transactionSet(3u, 4u);
+  transactions[2].pNext = &transactions[3];
+  interruptsEnabled = d_FALSE;
+  TEST_CHECK_EQUAL(d_SPI_PL_Queue(CHANNEL, &transactions[2]), d_STATUS_SUCCESS);
+  run(40u);
+  TEST_CHECK_EQUAL(d_SPI_PL_Cancel(CHANNEL, &transactions[2]), d_STATUS_SUCCESS);
+  TEST_CHECK_EQUAL(d_SPI_PL_Poll(CHANNEL), d_STATUS_SUCCESS);
+  TEST_CHECK_EQUAL(transactions[3].state, d_SPI_PL_TRANSACTION_QUEUED);
+  run(200u);
+  TEST_CHECK_EQUAL(d_SPI_PL_Poll(CHANNEL), d_STATUS_SUCCESS);
+  TEST_CHECK_EQUAL(transactions[3].state, d_SPI_PL_TRANSACTION_ACTIVE);
+  run(100u);
+  TEST_CHECK_EQUAL(d_SPI_PL_Poll(CHANNEL), d_STATUS_SUCCESS);
+  TEST_CHECK_EQUAL(transactions[3].state, d_SPI_PL_TRANSACTION_COMPLETE);
+  TEST_CHECK(responseOwn(3u) == d_TRUE);
+  interruptsEnabled = d_TRUE;
+  run(10u);
+
+  TEST_CHECK_EQUAL(callbackCount, 2u);
+  TEST_CHECK_EQUAL(overlaps, 0u);
+  TEST_CHECK_EQUAL(host_ErrorCount, 0u);
+}
+
+/* An active transfer which has ended but not been served is discarded at once */
+static void testCancelActiveIdle(void)
+{
+  startUp();
+  interruptsEnabled = d_FALSE;
+
+  transactionSet(0u, 4u);
+  transactionSet(1u, 4u);
+  transactions[0].pNext = &transactions[1];
+  TEST_CHECK_EQUAL(d_SPI_PL_Queue(CHANNEL, &transactions[0]), d_STATUS_SUCCESS);
+  run(100u);
+  TEST_CHECK_EQUAL(transactions[0].state, d_SPI_PL_TRANSACTION_ACTIVE);
+  TEST_CHECK_EQUAL(d_SPI_PL_Cancel(CHANNEL, &transactions[0]), d_STATUS_SUCCESS);
+  TEST_CHECK_EQUAL(transactions[0].state, d_SPI_PL_TRANSACTION_FAILED);
+  TEST_CHECK_EQUAL(transactions[1].state, d_SPI_PL_TRANSACTION_ACTIVE);
+
+  /* The interrupt of the abandoned transfer was cleared, the next completes on its own */
+  interruptsEnabled = d_TRUE;
+  run(10u);
+  TEST_CHECK_EQUAL(transactions[1].state, d_SPI_PL_TRANSACTION_ACTIVE);
+  run(100u);
+  TEST_CHECK_EQUAL(transactions[1].state, d_SPI_PL_TRANSACTION_COMPLETE);
+  TEST_CHECK(responseOwn(1u) == d_TRUE);
+  TEST_CHECK_EQUAL(callbackCount, 1u);
+  TEST_CHECK_EQUAL(overlaps, 0u);
+  TEST_CHECK_EQUAL(host_ErrorCount, 0u);
+}
+
+/* The AUAV start commands are queued and a start not sent marks the readings invalid */
+static void testAuav(void)
+{
+  Uint32_t first;
+
+  startUp();
+  auavReadyCount = 0u;
+
+  TEST_CHECK_EQUAL(d_AUAV_Initialise(0u, &auavBlock), d_STATUS_SUCCESS);
+  TEST_CHECK_EQUAL(overlaps, 0u);
+
+  first = transferCount;
+  TEST_CHECK_EQUAL(d_AUAV_Start(0u), d_STATUS_SUCCESS);
+  run(100u);
+  TEST_CHECK_EQUAL(transferCount, first + 2u);
+  TEST_CHECK_EQUAL(transferLog[first].device, DEVICE_AUAV);
+  TEST_CHECK_EQUAL(transferLog[first].command, 0xAAu);
+  TEST_CHECK_EQUAL(transferLog[first + 1u].device, DEVICE_AUAV + 1u);
+  TEST_CHECK_EQUAL(transferLog[first + 1u].command, 0xAAu);
+
+  /* Data ready of both channels queues their reads */
+  core[CHANNEL].irq |= (IRQ_DEVICE << DEVICE_AUAV) | (IRQ_DEVICE << (DEVICE_AUAV + 1u));
+  run(200u);
+  TEST_CHECK_EQUAL(transferCount, first + 4u);
+  TEST_CHECK(auavBlock.absolute.valid == d_TRUE);
+  TEST_CHECK(auavBlock.differential.valid == d_TRUE);
+  TEST_CHECK_EQUAL(auavReadyCount, 1u);
+
+  /* With the interface offline the start commands fail */
+  offline = d_TRUE;
+  TEST_CHECK_EQUAL(d_AUAV_Start(0u), d_STATUS_SUCCESS);
+  offline = d_FALSE;
+  run(100u);
+  TEST_CHECK_EQUAL(transferCount, first + 4u);
+  TEST_CHECK(auavBlock.absolute.valid == d_FALSE);
+  TEST_CHECK(auavBlock.differential.valid == d_FALSE);
+
+  /* The next start is sent */
+  TEST_CHECK_EQUAL(d_AUAV_Start(0u), d_STATUS_SUCCESS);
+  run(100u);
+  TEST_CHECK_EQUAL(transferCount, first + 6u);
+  TEST_CHECK_EQUAL(overlaps, 0u);
+  TEST_CHECK_EQUAL(host_ErrorCount, 0u);
+}
+
+/* Model time for which the CPU waits on a direct transfer, the way the
+   drivers read before the queue */
+static Uint64_t busyWait(const Uint32_t channel, const Uint32_t device, const Uint8_t * const pCommand,
+                         const Uint32_t cmdCount, const Uint32_t dataCount)
+{
+  const Uint64_t startUs = host_TimerMicroseconds();
+  d_SPI_PL_State_t state = d_SPI_PL_STATUS_BUSY;
+  Uint8_t response[32];
+  Uint32_t count;
+  Uint32_t startTime;
+
+  TEST_CHECK_EQUAL(d_SPI_PL_Transfer(channel, device, pCommand, cmdCount, NULL, dataCount), d_STATUS_SUCCESS);
+  (void)d_TIMER_ElapsedMicroseconds(0u, &startTime);
+  while ((state != d_SPI_PL_STATUS_COMPLETE) && (d_TIMER_ElapsedMicroseconds(startTime, NULL) < BUSY_WAIT_US))
+  {
+    (void)d_SPI_PL_Status(channel, &state);
+  }
+  TEST_CHECK_EQUAL(state, d_SPI_PL_STATUS_COMPLETE);
+  TEST_CHECK_EQUAL(d_SPI_PL_Result(channel, &state, response, sizeof(response), &count), d_STATUS_SUCCESS);
+
+  return host_TimerMicroseconds() - startUs;
+}
+
+/* Model time spent in the interrupt handlers while the test runs the bus */
+static Uint64_t runInterrupt(const Uint32_t microseconds)
+{
+  const Uint64_t startUs = interruptUs;
+
+  run(microseconds);
+
+  return interruptUs - startUs;
+}
+
+/* The BME280 and AUAV reads hold the CPU for less than a tenth of the
+   busy-wait of their transfers, the flash MAC still waits for the whole
+   of its transfers */
+static void testBlockedTime(void)
+{
+  static const Uint8_t bmeCommand[1] = { BME_DATA };
+  static const Uint8_t auavCommand[7] = { 0u };
+  static const Uint8_t flashStatusCommand[1] = { FLASH_STATUS };
+  static const Uint8_t flashReadCommand[4] = { FLASH_READ, 0x00u, 0x10u, 0x00u };
+  Uint8_t flashData[FLASH_READ_BYTES];
+  Float64_t humidity;
+  Float64_t pressure;
+  Float64_t temperature;
+  Uint64_t startUs;
+  Uint64_t bmeQueued = 0u;
+  Uint64_t bmeBusy = 0u;
+  Uint64_t auavQueued = 0u;
+  Uint64_t auavBusy = 0u;
+  Uint64_t flashQueued = 0u;
+  Uint64_t flashBusy = 0u;
+
+  startUp();
+
+  TEST_CHECK_EQUAL(d_BME280_Initialise(0u, SETTING_CONFIG, SETTING_CTRL_HUM, SETTING_CTRL_MEAS), d_STATUS_SUCCESS);
+  TEST_CHECK_EQUAL(d_FLASH_MAC_Initialise(), d_STATUS_SUCCESS);
+  TEST_CHECK_EQUAL(d_AUAV_Initialise(0u, &auavBlock), d_STATUS_SUCCESS);
+
+  /* BME280, each read collects the data of the read queued by the previous one */
+  TEST_CHECK_EQUAL(d_BME280_Read(0u, &humidity, &pressure, &temperature), d_STATUS_NOT_READY);
+  for (Uint32_t read = 0u; read < BLOCKED_READS; read++)
+  {
+    bmeQueued += runInterrupt(100u);
+    startUs = host_TimerMicroseconds();
+    TEST_CHECK_EQUAL(d_BME280_Read(0u, &humidity, &pressure, &temperature), d_STATUS_SUCCESS);
+    bmeQueued += host_TimerMicroseconds() - startUs;
+  }
+  run(100u);
+  for (Uint32_t read = 0u; read < BLOCKED_READS; read++)
+  {
+    bmeBusy += busyWait(CHANNEL_SENSOR, DEVICE_BME280, bmeCommand, 1u, 8u);
+  }
+
+  /* AUAV, the data ready interrupt of each channel queues the read completed
+     by the end of transfer interrupt, two reads per pass */
+  for (Uint32_t read = 0u; read < BLOCKED_READS; read++)
+  {
+    TEST_CHECK_EQUAL(d_AUAV_Start(0u), d_STATUS_SUCCESS);
+    run(100u);
+    auavBlock.absolute.valid = d_FALSE;
+    auavBlock.differential.valid = d_FALSE;
+    core[CHANNEL].irq |= (IRQ_DEVICE << DEVICE_AUAV) | (IRQ_DEVICE << (DEVICE_AUAV + 1u));
+    auavQueued += runInterrupt(200u);
+    TEST_CHECK(auavBlock.absolute.valid == d_TRUE);
+    TEST_CHECK(auavBlock.differential.valid == d_TRUE);
+  }
+  for (Uint32_t read = 0u; read < BLOCKED_READS; read++)
+  {
+    auavBusy += busyWait(CHANNEL, DEVICE_AUAV, auavCommand, sizeof(auavCommand), 0u);
+    auavBusy += busyWait(CHANNEL, DEVICE_AUAV + 1u, auavCommand, sizeof(auavCommand), 0u);
+  }
+
+  /* Flash MAC, the status read and the data read are both waited for */
+  for (Uint32_t read = 0u; read < BLOCKED_READS; read++)
+  {
+    startUs = host_TimerMicroseconds();
+    TEST_CHECK_EQUAL(d_FLASH_MAC_Read(0u, 0x1000u, FLASH_READ_BYTES, flashData, sizeof(flashData)), d_STATUS_SUCCESS);
+    flashQueued += host_TimerMicroseconds() - startUs;
+    flashQueued += runInterrupt(10u);
+  }
+  for (Uint32_t read = 0u; read < BLOCKED_READS; read++)
+  {
+    flashBusy += busyWait(CHANNEL_SENSOR, DEVICE_FLASH, flashStatusCommand, 1u, 1u);
+    flashBusy += busyWait(CHANNEL_SENSOR, DEVICE_FLASH, flashReadCommand, 4u, FLASH_READ_BYTES);
+  }
+
+  printf("Model us blocked per read   queued  busy-wait\n");
+  printf("  d_BME280_Read           %8.1f %10.1f\n", (Float64_t)bmeQueued / BLOCKED_READS, (Float64_t)bmeBusy / BLOCKED_READS);
+  printf("  AUAV read               %8.1f %10.1f\n", (Float64_t)auavQueued / (2u * BLOCKED_READS), (Float64_t)auavBusy / (2u * BLOCKED_READS));
+  printf("  d_FLASH_MAC_Read        %8.1f %10.1f\n", (Float64_t)flashQueued / BLOCKED_READS, (Float64_t)flashBusy / BLOCKED_READS);
+
+  TEST_CHECK((bmeQueued * 10u) < bmeBusy);
+  TEST_CHECK((auavQueued * 10u) < auavBusy);
+  TEST_CHECK((flashQueued * 10u) >= (flashBusy * 9u));
+  TEST_CHECK_EQUAL(overlaps, 0u);
+  TEST_CHECK_EQUAL(host_ErrorCount, 0u);
+}
+
+int main(void)
+{
+  testChain();
+  testDirect();
+  testPoll();
+  testCancelQueued();
+  testCancelActiveBusy();
+  testCancelActiveIdle();
+  testAuav();
+  testBlockedTime();
+
+  return TEST_RESULT();
+}